@@ -5,11 +5,15 @@
 #ifndef V8_LIBPLATFORM_LIBPLATFORM_H_
 #define V8_LIBPLATFORM_LIBPLATFORM_H_
 
+#include "libplatform/v8-tracing.h"
 #include "v8-platform.h"  // NOLINT(build/include)
 
 namespace v8 {
 namespace platform {
 
+enum class IdleTaskSupport { kDisabled, kEnabled };
+enum class NumaSupport { kDisabled, kEnabled };
+
 /**
  * Returns a new instance of the default v8::Platform implementation.
  *
@@ -17,8 +21,17 @@ namespace platform {
  * is the number of worker threads to allocate for background jobs. If a value
  * of zero is passed, a suitable default based on the current number of
  * processors online will be chosen.
+ * If |idle_task_support| is enabled then the platform will accept idle
+ * tasks (IdleTasksEnabled will return true) and will rely on the embedder
+ * calling v8::platform::RunIdleTasks to process the idle tasks.
+ * If |numa_support| is enabled then the worker threads are spread over the
+ * NUMA nodes of the machine, and background tasks run on the node of the
+ * thread that posted them.
  */
-v8::Platform* CreateDefaultPlatform(int thread_pool_size = 0);
+v8::Platform* CreateDefaultPlatform(
+    int thread_pool_size = 0,
+    IdleTaskSupport idle_task_support = IdleTaskSupport::kDisabled,
+    NumaSupport numa_support = NumaSupport::kDisabled);
 
 
 /**
@@ -31,6 +44,38 @@ v8::Platform* CreateDefaultPlatform(int thread_pool_size = 0);
  */
 bool PumpMessageLoop(v8::Platform* platform, v8::Isolate* isolate);
 
+/**
+ * Runs pending idle tasks for the given isolate for at most
+ * |idle_time_in_seconds| seconds.
+ *
+ * The caller has to make sure that this is called from the right thread.
+ * This call does not block if no task is pending. The |platform| has to be
+ * created using |CreateDefaultPlatform| with idle task support enabled.
+ */
+void RunIdleTasks(v8::Platform* platform, v8::Isolate* isolate,
+                  double idle_time_in_seconds);
+
+/**
+ * Attempts to set the tracing controller for the given platform.
+ *
+ * The |platform| has to be created using |CreateDefaultPlatform|. The
+ * platform takes ownership of |tracing_controller|.
+ */
+void SetTracingController(
+    v8::Platform* platform,
+    v8::platform::tracing::TracingController* tracing_controller);
+
+/**
+ * Schedules a task to be invoked on a background thread after
+ * |delay_in_seconds|. Delayed tasks are handed to the worker threads by the
+ * first call to |PumpMessageLoop| or |RunIdleTasks| after their deadline, for
+ * any isolate. The |platform| has to be created using |CreateDefaultPlatform|
+ * and takes ownership of |task|.
+ */
+void CallDelayedOnBackgroundThread(
+    v8::Platform* platform, v8::Task* task,
+    v8::Platform::ExpectedRuntime expected_runtime, double delay_in_seconds);
+
 
 }  // namespace platform
 }  // namespace v8
@@ -0,0 +1,263 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_LIBPLATFORM_V8_TRACING_H_
+#define V8_LIBPLATFORM_V8_TRACING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace v8 {
+namespace platform {
+namespace tracing {
+
+const int kTraceMaxNumArgs = 2;
+
+/**
+ * A single trace event, as recorded by the TRACE_EVENT* macros.
+ */
+class TraceObject {
+ public:
+  union ArgValue {
+    bool as_bool;
+    uint64_t as_uint;
+    int64_t as_int;
+    double as_double;
+    const void* as_pointer;
+    const char* as_string;
+  };
+
+  TraceObject() : parameter_copy_storage_(NULL) {}
+  ~TraceObject();
+
+  void Initialize(char phase, const uint8_t* category_enabled_flag,
+                  const char* name, const char* scope, uint64_t id,
+                  uint64_t bind_id, int num_args, const char** arg_names,
+                  const uint8_t* arg_types, const uint64_t* arg_values,
+                  unsigned int flags);
+  void UpdateDuration();
+
+  int pid() const { return pid_; }
+  int tid() const { return tid_; }
+  char phase() const { return phase_; }
+  const uint8_t* category_enabled_flag() const {
+    return category_enabled_flag_;
+  }
+  const char* name() const { return name_; }
+  const char* scope() const { return scope_; }
+  uint64_t id() const { return id_; }
+  uint64_t bind_id() const { return bind_id_; }
+  int num_args() const { return num_args_; }
+  const char** arg_names() { return arg_names_; }
+  const uint8_t* arg_types() const { return arg_types_; }
+  const ArgValue* arg_values() const { return arg_values_; }
+  unsigned int flags() const { return flags_; }
+  // Timestamp and duration in microseconds.
+  int64_t ts() const { return ts_; }
+  uint64_t duration() const { return duration_; }
+
+ private:
+  int pid_;
+  int tid_;
+  char phase_;
+  const char* name_;
+  const char* scope_;
+  const uint8_t* category_enabled_flag_;
+  uint64_t id_;
+  uint64_t bind_id_;
+  int num_args_;
+  const char* arg_names_[kTraceMaxNumArgs];
+  uint8_t arg_types_[kTraceMaxNumArgs];
+  ArgValue arg_values_[kTraceMaxNumArgs];
+  // Owns the names and string arguments of events with TRACE_EVENT_FLAG_COPY.
+  char* parameter_copy_storage_;
+  unsigned int flags_;
+  int64_t ts_;
+  uint64_t duration_;
+
+  // Disallow copy and assign
+  TraceObject(const TraceObject&) = delete;
+  void operator=(const TraceObject&) = delete;
+};
+
+/**
+ * Receives the trace events of a TraceBuffer when it is flushed.
+ */
+class TraceWriter {
+ public:
+  TraceWriter() {}
+  virtual ~TraceWriter() {}
+  virtual void AppendTraceEvent(TraceObject* trace_event) = 0;
+  virtual void Flush() = 0;
+
+  /**
+   * Returns a writer that emits the Chrome JSON trace format, as understood
+   * by chrome://tracing, to |stream|. The document is completed when the
+   * writer is deleted.
+   */
+  static TraceWriter* CreateJSONTraceWriter(std::ostream& stream);
+
+ private:
+  // Disallow copy and assign
+  TraceWriter(const TraceWriter&) = delete;
+  void operator=(const TraceWriter&) = delete;
+};
+
+/**
+ * A fixed size chunk of trace events. Slots are claimed without locking.
+ */
+class TraceBufferChunk {
+ public:
+  static const size_t kChunkSize = 64;
+
+  explicit TraceBufferChunk(uint32_t seq);
+
+  void Reset(uint32_t new_seq);
+  bool IsFull() const;
+  // Claims the next free slot of the chunk and returns it, or returns NULL if
+  // the chunk is full.
+  TraceObject* AddTraceEvent(size_t* event_index);
+  TraceObject* GetEventAt(size_t index) { return &chunk_[index]; }
+  // The number of events in the chunk.
+  size_t size() const;
+
+  uint32_t seq() const { return seq_; }
+
+ private:
+  volatile int32_t next_free_;
+  TraceObject chunk_[kChunkSize];
+  uint32_t seq_;
+
+  // Disallow copy and assign
+  TraceBufferChunk(const TraceBufferChunk&) = delete;
+  void operator=(const TraceBufferChunk&) = delete;
+};
+
+/**
+ * Stores trace events until they are flushed to a TraceWriter.
+ */
+class TraceBuffer {
+ public:
+  TraceBuffer() {}
+  virtual ~TraceBuffer() {}
+
+  // Returns a slot for a new trace event and stores its handle in |handle|,
+  // or returns NULL if the buffer is full.
+  virtual TraceObject* AddTraceEvent(uint64_t* handle) = 0;
+  virtual TraceObject* GetEventByHandle(uint64_t handle) = 0;
+  // Passes the recorded events to the writer and empties the buffer.
+  virtual bool Flush() = 0;
+
+  static const size_t kRingBufferChunks = 1024;
+
+  /**
+   * Returns a buffer of |max_chunks| chunks that overwrites its oldest events
+   * when it is full. The buffer takes ownership of |trace_writer|.
+   */
+  static TraceBuffer* CreateTraceBufferRingBuffer(size_t max_chunks,
+                                                  TraceWriter* trace_writer);
+
+ private:
+  // Disallow copy and assign
+  TraceBuffer(const TraceBuffer&) = delete;
+  void operator=(const TraceBuffer&) = delete;
+};
+
+/**
+ * Selects the categories that are recorded. Categories starting with
+ * "disabled-by-default-" are recorded only if they are explicitly included.
+ */
+class TraceConfig {
+ public:
+  typedef std::vector<std::string> StringList;
+
+  static TraceConfig* CreateDefaultTraceConfig();
+  /**
+   * Returns a config that records the comma separated categories in
+   * |category_list|. Categories prefixed with '-' are excluded, and "*"
+   * includes all categories that are enabled by default.
+   */
+  static TraceConfig* CreateTraceConfigFromCategoryList(
+      const char* category_list);
+
+  TraceConfig() : include_all_(false) {}
+
+  void AddIncludedCategory(const char* included_category);
+  void AddExcludedCategory(const char* excluded_category);
+
+  bool IsCategoryGroupEnabled(const char* category_group) const;
+
+ private:
+  bool IsCategoryEnabled(const std::string& category) const;
+
+  bool include_all_;
+  StringList included_categories_;
+  StringList excluded_categories_;
+
+  // Disallow copy and assign
+  TraceConfig(const TraceConfig&) = delete;
+  void operator=(const TraceConfig&) = delete;
+};
+
+/**
+ * The tracing backend of the default platform. Install it with
+ * v8::platform::SetTracingController.
+ */
+class TracingController {
+ public:
+  enum Mode { DISABLED = 0, RECORDING_MODE };
+
+  // The pointer returned from GetCategoryGroupEnabled() points to a value
+  // with zero or more of the following bits. Used in this class only.
+  // The TRACE_EVENT macros should only use the value as a bool.
+  enum CategoryGroupEnabledFlags {
+    // Category group enabled for the recording mode.
+    ENABLED_FOR_RECORDING = 1 << 0,
+  };
+
+  TracingController();
+  ~TracingController();
+
+  // Takes ownership of |trace_buffer|.
+  void Initialize(TraceBuffer* trace_buffer);
+
+  const uint8_t* GetCategoryGroupEnabled(const char* category_group);
+  static const char* GetCategoryGroupName(const uint8_t* category_enabled_flag);
+  uint64_t AddTraceEvent(char phase, const uint8_t* category_enabled_flag,
+                         const char* name, const char* scope, uint64_t id,
+                         uint64_t bind_id, int32_t num_args,
+                         const char** arg_names, const uint8_t* arg_types,
+                         const uint64_t* arg_values, unsigned int flags);
+  void UpdateTraceEventDuration(const uint8_t* category_enabled_flag,
+                                const char* name, uint64_t handle);
+
+  // Takes ownership of |trace_config|. Categories can be changed by starting
+  // tracing again with a different config.
+  void StartTracing(TraceConfig* trace_config);
+  // Stops recording and flushes the recorded events to the trace writer.
+  void StopTracing();
+
+ private:
+  const uint8_t* GetCategoryGroupEnabledInternal(const char* category_group);
+  void UpdateCategoryGroupEnabledFlag(size_t category_index);
+  void UpdateCategoryGroupEnabledFlags();
+
+  TraceBuffer* trace_buffer_;
+  TraceConfig* trace_config_;
+  Mode mode_;
+
+  // Disallow copy and assign
+  TracingController(const TracingController&) = delete;
+  void operator=(const TracingController&) = delete;
+};
+
+}  // namespace tracing
+}  // namespace platform
+}  // namespace v8
+
+#endif  // V8_LIBPLATFORM_V8_TRACING_H_
@@ -48,6 +48,36 @@ class V8_EXPORT FastAccessorBuilder {
   void operator=(const FastAccessorBuilder&) = delete;
 };
 
+// Allow the embedder to provide a C function that optimized code can call
+// directly instead of a FunctionTemplate's callback, with unboxed arguments
+// and without setting up a FunctionCallbackInfo or a handle scope.
+class V8_EXPORT FastApiFunction {
+ public:
+  enum Type { kVoid, kInt32, kFloat64 };
+
+  static const int kMaxArgumentCount = 8;
+
+  /**
+   * Registers |c_function| as fast variant of the callback of
+   * |function_template|. It returns |return_type| and takes
+   * |argument_count| arguments of the given |argument_types|, which are
+   * kInt32 or kFloat64. Calls whose arguments are not known to match these
+   * types, and calls from code that is not optimized, use the regular
+   * callback, which has to behave the same. Functions that take or return
+   * kFloat64 values are currently always called through the callback.
+   *
+   * The C function must not call into V8, allocate JavaScript objects or
+   * throw. It does not see the receiver. Only templates without a signature
+   * are supported.
+   */
+  static void Set(Local<FunctionTemplate> function_template,
+                  const void* c_function, Type return_type,
+                  int argument_count, const Type* argument_types);
+
+ private:
+  FastApiFunction() = delete;
+};
+
 }  // namespace experimental
 }  // namespace v8
 
@@ -14,6 +14,7 @@
 namespace v8 {
 
 class HeapGraphNode;
+class OutputStream;
 struct HeapStatsUpdate;
 
 typedef uint32_t SnapshotObjectId;
@@ -206,6 +207,38 @@ class V8_EXPORT CpuProfiler {
    */
   CpuProfile* StopProfiling(Local<String> title);
 
+  /**
+   * Starts collecting a continuous CPU profile which, unlike the profiles
+   * above, is not kept in memory but streamed to |stream|. Samples are taken
+   * every 10ms, or at the sampling interval if that is longer, unless other
+   * profiles are already being collected. Every |interval_ms| milliseconds,
+   * the samples of the past interval are aggregated into a compact profile,
+   * written to |stream| and discarded. Only one continuous profile can be
+   * collected at a time, and it does not affect the other profiles.
+   *
+   * The profile of each interval is a single JSON object terminated by
+   * EndOfStream:
+   *
+   *   {"startTime": <microseconds>, "endTime": <microseconds>,
+   *    "nodes": [<id>, <parent id>, <function name>, <script resource name>,
+   *              <line>, <column>, <hit count>, ...],
+   *    "strings": [...]}
+   *
+   * Nodes form the top-down call tree, with the root having parent id 0,
+   * and refer to names by their indexes in "strings".
+   *
+   * The intervals are written from the profiler thread, except for the last
+   * one, which is written from StopContinuousProfiling. |stream| must stay
+   * alive until then.
+   */
+  void StartContinuousProfiling(OutputStream* stream, int interval_ms);
+
+  /**
+   * Stops collecting the continuous CPU profile and writes the profile of
+   * the last, possibly shorter, interval.
+   */
+  void StopContinuousProfiling();
+
   /**
    * Force collection of a sample. Must be called on the VM thread.
    * Recording the forced sample does not contribute to the aggregated
@@ -493,6 +526,40 @@ class V8_EXPORT AllocationProfile {
      * List of self allocations done by this node in the call-graph.
      */
     std::vector<Allocation> allocations;
+
+    /**
+     * Estimated numbers of objects allocated by this node that are still
+     * live and survived garbage collections: element i counts the objects
+     * which survived more than i garbage collections, so the last element
+     * counts the objects that survived at least kMaxSurvivedGCs of them.
+     */
+    std::vector<unsigned int> survivors;
+  };
+
+  /**
+   * Estimated number of bytes allocated by a function in one heap space
+   * during an interval of the allocation timeline.
+   */
+  struct TimelineEntry {
+    /**
+     * Start of the interval in milliseconds since sampling was started.
+     */
+    double start_time;
+
+    /**
+     * Name, script and start position of the function that allocated, see
+     * Node.
+     */
+    Local<String> name;
+    int script_id;
+    int start_position;
+
+    /**
+     * Name of the heap space, as in HeapSpaceStatistics.
+     */
+    const char* space_name;
+
+    size_t size;
   };
 
   /**
@@ -502,10 +569,17 @@ class V8_EXPORT AllocationProfile {
    */
   virtual Node* GetRootNode() = 0;
 
+  /**
+   * Returns the allocation timeline ordered by start time, which is only
+   * recorded with HeapProfiler::kSamplingRecordTimeline.
+   */
+  virtual const std::vector<TimelineEntry>& GetTimeline() = 0;
+
   virtual ~AllocationProfile() {}
 
   static const int kNoLineNumberInfo = Message::kNoLineNumberInfo;
   static const int kNoColumnNumberInfo = Message::kNoColumnInfo;
+  static const int kMaxSurvivedGCs = 4;
 };
 
 
@@ -524,6 +598,18 @@ class V8_EXPORT HeapProfiler {
   typedef RetainedObjectInfo* (*WrapperInfoCallback)(uint16_t class_id,
                                                      Local<Value> wrapper);
 
+  enum SamplingFlags {
+    kSamplingNoFlags = 0,
+    // Keeps counting sampled objects in the allocations of the profile after
+    // they have been garbage collected, so that the profile shows where the
+    // program allocates rather than where it retains memory.
+    kSamplingIncludeObjectsCollectedByGC = 1 << 0,
+    // Records how many bytes every function allocates in every space per
+    // interval of --sampling-heap-profiler-timeline-interval milliseconds.
+    // The intervals are also emitted as trace counters.
+    kSamplingRecordTimeline = 1 << 1,
+  };
+
   /** Returns the number of snapshots taken. */
   int GetSnapshotCount();
 
@@ -578,6 +664,16 @@ class V8_EXPORT HeapProfiler {
       ActivityControl* control = NULL,
       ObjectNameResolver* global_object_name_resolver = NULL);
 
+  /**
+   * Takes a heap snapshot, serializes it to |stream| like
+   * HeapSnapshot::Serialize does and deletes it right away, so that the
+   * snapshot is not kept in memory next to its serialized form. Returns
+   * false if taking the snapshot was aborted through |control|.
+   */
+  bool WriteHeapSnapshot(
+      OutputStream* stream, ActivityControl* control = NULL,
+      ObjectNameResolver* global_object_name_resolver = NULL);
+
   /**
    * Starts tracking of heap objects population statistics. After calling
    * this method, all heap objects relocations done by the garbage collector
@@ -637,10 +733,13 @@ class V8_EXPORT HeapProfiler {
    * Objects allocated before the sampling is started will not be included in
    * the profile.
    *
+   * |flags| is a combination of SamplingFlags.
+   *
    * Returns false if a sampling heap profiler is already running.
    */
   bool StartSamplingHeapProfiler(uint64_t sample_interval = 512 * 1024,
-                                 int stack_depth = 16);
+                                 int stack_depth = 16,
+                                 SamplingFlags flags = kSamplingNoFlags);
 
   /**
    * Stops the sampling heap profile and discards the current profile.
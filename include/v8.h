@@ -69,6 +69,7 @@ namespace v8 {
 
 class AccessorSignature;
 class Array;
+class ArrayBuffer;
 class Boolean;
 class BooleanObject;
 class Context;
@@ -1164,10 +1165,28 @@ class V8_EXPORT ScriptCompiler {
       BufferOwned
     };
 
+    // Why a consumed cache was rejected.
+    enum RejectReason {
+      kNotRejected,
+      // The cache was produced by a different V8 build or snapshot.
+      kMagicNumberMismatch,
+      kVersionMismatch,
+      // The cache was produced for a different source string.
+      kSourceMismatch,
+      kCpuFeaturesMismatch,
+      // Flags that affect the generated code differ.
+      kFlagsMismatch,
+      // The cache has been corrupted.
+      kChecksumMismatch,
+      // The parser cache does not match the source string.
+      kInvalidParserCache
+    };
+
     CachedData()
         : data(NULL),
           length(0),
           rejected(false),
+          reject_reason(kNotRejected),
           buffer_policy(BufferNotOwned) {}
 
     // If buffer_policy is BufferNotOwned, the caller keeps the ownership of
@@ -1182,6 +1201,8 @@ class V8_EXPORT ScriptCompiler {
     const uint8_t* data;
     int length;
     bool rejected;
+    // Set together with {rejected}.
+    RejectReason reject_reason;
     BufferPolicy buffer_policy;
 
    private:
@@ -1285,6 +1306,12 @@ class V8_EXPORT ScriptCompiler {
     enum Encoding { ONE_BYTE, TWO_BYTE, UTF8 };
 
     StreamedSource(ExternalSourceStream* source_stream, Encoding encoding);
+    /**
+     * Creates a source from a script that is already completely in memory,
+     * |length| bytes in the given encoding. The buffer is not copied at once
+     * and must stay alive and unchanged until the streaming task has run.
+     */
+    StreamedSource(const uint8_t* data, size_t length, Encoding encoding);
     ~StreamedSource();
 
     // Ownership of the CachedData or its buffers is *not* transferred to the
@@ -1375,6 +1402,19 @@ class V8_EXPORT ScriptCompiler {
       Isolate* isolate, StreamedSource* source,
       CompileOptions options = kNoCompileOptions);
 
+  /**
+   * Like StartStreamingScript, but parses the source as an ES6 module. The
+   * result is compiled with Compile below. Several modules can be streamed
+   * at the same time, each by its own task, so that the main thread only has
+   * to finish their compilation.
+   *
+   * This is an unfinished experimental feature with the same restrictions as
+   * CompileModule. Do not use.
+   */
+  static ScriptStreamingTask* StartStreamingModule(
+      Isolate* isolate, StreamedSource* source,
+      CompileOptions options = kNoCompileOptions);
+
   /**
    * Compiles a streamed script (bound to current context).
    *
@@ -1411,6 +1451,19 @@ class V8_EXPORT ScriptCompiler {
    */
   static uint32_t CachedDataVersionTag();
 
+  /**
+   * Creates a code cache for an unbound script that has already been run.
+   * Unlike kProduceCodeCache, the cache also contains the functions that
+   * were compiled lazily while running the script, so that consuming it
+   * skips parsing and compiling for the startup path of the script. It can
+   * be called at any time after the script has run.
+   *
+   * Returns NULL if no cache could be created. The caller takes ownership of
+   * the result.
+   */
+  static CachedData* CreateCodeCache(Local<UnboundScript> unbound_script,
+                                     Local<String> source);
+
   /**
    * Compile an ES6 module.
    *
@@ -1688,6 +1741,22 @@ class V8_EXPORT JSON {
   static V8_WARN_UNUSED_RESULT MaybeLocal<Value> Parse(
       Local<Context> context, Local<String> json_string);
 
+  /**
+   * Tries to parse the UTF-8 encoded JSON text produced by |source_stream|
+   * and returns it as value if successful. The chunks are decoded as they
+   * are read, so the embedder never has to assemble the whole text into one
+   * string. As with ScriptCompiler::StreamedSource, V8 takes ownership of
+   * the chunks and frees them once they are decoded. GetMoreData is called
+   * on the calling thread and may block until more data arrives.
+   *
+   * \param source_stream The stream supplying the text.
+   * 
+eturn The corresponding value if successfully parsed.
+   */
+  static V8_WARN_UNUSED_RESULT MaybeLocal<Value> ParseStreaming(
+      Local<Context> context,
+      ScriptCompiler::ExternalSourceStream* source_stream);
+
   /**
    * Tries to stringify the JSON-serializable object |json_object| and returns
    * it as string if successful.
@@ -1699,6 +1768,161 @@ class V8_EXPORT JSON {
       Local<Context> context, Local<Object> json_object);
 };
 
+/**
+ * Value serialization compatible with the HTML structured clone algorithm.
+ * The serialized form is a compact binary format that can be handed to
+ * another isolate, possibly on another thread, and read back with a
+ * ValueDeserializer. Unlike JSON, it preserves undefined, doubles, dates,
+ * sparse arrays, cyclic and shared references, ArrayBuffers and typed arrays.
+ *
+ * WARNING: This API is under development, and changes (including incompatible
+ * changes to the API or wire format) may occur without notice until this
+ * warning is removed.
+ */
+class V8_EXPORT ValueSerializer {
+ public:
+  class V8_EXPORT Delegate {
+   public:
+    virtual ~Delegate() {}
+
+    /**
+     * Handles the case where a DataCloneError would be thrown in the
+     * structured clone spec. Other V8 embedders may throw some other
+     * appropriate exception type.
+     */
+    virtual void ThrowDataCloneError(Local<String> message) = 0;
+
+    /**
+     * The embedder overrides this method to write some kind of host object
+     * (an object with internal fields), if possible, using the Write* methods
+     * of the serializer. If not, a suitable exception should be thrown and
+     * Nothing<bool>() returned.
+     */
+    virtual Maybe<bool> WriteHostObject(Isolate* isolate, Local<Object> object);
+  };
+
+  explicit ValueSerializer(Isolate* isolate);
+  ValueSerializer(Isolate* isolate, Delegate* delegate);
+  ~ValueSerializer();
+
+  /**
+   * Writes out a header, which includes the format version.
+   */
+  void WriteHeader();
+
+  /**
+   * Serializes a JavaScript value into the buffer.
+   */
+  V8_WARN_UNUSED_RESULT Maybe<bool> WriteValue(Local<Context> context,
+                                               Local<Value> value);
+
+  /**
+   * Returns the stored data. This serializer should not be used once the
+   * buffer is released. The contents are undefined if a previous write has
+   * failed.
+   */
+  std::vector<uint8_t> ReleaseBuffer();
+
+  /**
+   * Marks an ArrayBuffer as having its contents transferred out of band.
+   * Pass the corresponding ArrayBuffer in the deserializing context to
+   * ValueDeserializer::TransferArrayBuffer. The serializer does not neuter
+   * the buffer; the embedder is expected to externalize and neuter it once
+   * the value has been written, so that the backing store can be adopted by
+   * the receiving isolate without a copy.
+   */
+  void TransferArrayBuffer(uint32_t transfer_id,
+                           Local<ArrayBuffer> array_buffer);
+
+  /**
+   * Write raw data in various common formats to the buffer.
+   * Note that integer types are written in base-128 varint format, not with a
+   * binary copy. For use during an override of Delegate::WriteHostObject.
+   */
+  void WriteUint32(uint32_t value);
+  void WriteUint64(uint64_t value);
+  void WriteDouble(double value);
+  void WriteRawBytes(const void* source, size_t length);
+
+ private:
+  ValueSerializer(const ValueSerializer&) = delete;
+  void operator=(const ValueSerializer&) = delete;
+
+  struct PrivateData;
+  PrivateData* private_;
+};
+
+
+/**
+ * Deserializes values from data written with ValueSerializer, or a compatible
+ * implementation.
+ *
+ * WARNING: This API is under development, and changes (including incompatible
+ * changes to the API or wire format) may occur without notice until this
+ * warning is removed.
+ */
+class V8_EXPORT ValueDeserializer {
+ public:
+  class V8_EXPORT Delegate {
+   public:
+    virtual ~Delegate() {}
+
+    /**
+     * The embedder overrides this method to read some kind of host object, if
+     * possible, using the Read* methods of the deserializer. If not, a
+     * suitable exception should be thrown and MaybeLocal<Object>() returned.
+     */
+    virtual MaybeLocal<Object> ReadHostObject(Isolate* isolate);
+  };
+
+  ValueDeserializer(Isolate* isolate, const uint8_t* data, size_t size);
+  ValueDeserializer(Isolate* isolate, const uint8_t* data, size_t size,
+                    Delegate* delegate);
+  ~ValueDeserializer();
+
+  /**
+   * Reads and validates a header (including the format version).
+   * May, for example, reject an invalid or unsupported wire format.
+   */
+  V8_WARN_UNUSED_RESULT Maybe<bool> ReadHeader(Local<Context> context);
+
+  /**
+   * Deserializes a JavaScript value from the buffer.
+   */
+  V8_WARN_UNUSED_RESULT MaybeLocal<Value> ReadValue(Local<Context> context);
+
+  /**
+   * Accepts the array buffer corresponding to the one passed previously to
+   * ValueSerializer::TransferArrayBuffer.
+   */
+  void TransferArrayBuffer(uint32_t transfer_id,
+                           Local<ArrayBuffer> array_buffer);
+
+  /**
+   * Reads the underlying wire format version. Likely mostly to be useful to
+   * legacy code reading old wire format versions. Must be called after
+   * ReadHeader.
+   */
+  uint32_t GetWireFormatVersion() const;
+
+  /**
+   * Reads raw data in various common formats to the buffer.
+   * Note that integer types are read in base-128 varint format, not with a
+   * binary copy. For use during an override of Delegate::ReadHostObject.
+   */
+  V8_WARN_UNUSED_RESULT bool ReadUint32(uint32_t* value);
+  V8_WARN_UNUSED_RESULT bool ReadUint64(uint64_t* value);
+  V8_WARN_UNUSED_RESULT bool ReadDouble(double* value);
+  V8_WARN_UNUSED_RESULT bool ReadRawBytes(size_t length, const void** data);
+
+ private:
+  ValueDeserializer(const ValueDeserializer&) = delete;
+  void operator=(const ValueDeserializer&) = delete;
+
+  struct PrivateData;
+  PrivateData* private_;
+};
+
 
 /**
  * A map whose keys are referenced weakly. It is similar to JavaScript WeakMap
@@ -2415,6 +2639,16 @@ class V8_EXPORT String : public Name {
   static V8_WARN_UNUSED_RESULT MaybeLocal<String> NewExternalOneByte(
       Isolate* isolate, ExternalOneByteStringResource* resource);
 
+  /**
+   * Creates a new string from the UTF-8 data defined in the given resource,
+   * which is owned by V8 afterwards as for NewExternalOneByte. If the data is
+   * ASCII, the string uses the resource without copying it. Otherwise the
+   * data is decoded into a new string and the resource is disposed right
+   * away.
+   */
+  static V8_WARN_UNUSED_RESULT MaybeLocal<String> NewExternalUtf8(
+      Isolate* isolate, ExternalOneByteStringResource* resource);
+
   /**
    * Associate an external string resource with this string by transforming it
    * in place so that existing references to this string in the JavaScript heap
@@ -3020,6 +3254,18 @@ class V8_EXPORT Object : public Value {
 
   static Local<Object> New(Isolate* isolate);
 
+  /**
+   * Creates a JavaScript object with the given properties, which behaves as
+   * if the properties were added one after the other with
+   * CreateDataProperty. |prototype_or_null| is the prototype of the object,
+   * or undefined for Object.prototype. Objects created with the same
+   * prototype and the same list of names share their map, so creating many
+   * of them is much cheaper than setting their properties one by one.
+   */
+  static Local<Object> New(Isolate* isolate, Local<Value> prototype_or_null,
+                           Local<Name>* names, Local<Value>* values,
+                           size_t length);
+
   V8_INLINE static Object* Cast(Value* obj);
 
  private:
@@ -3053,6 +3299,13 @@ class V8_EXPORT Array : public Object {
    */
   static Local<Array> New(Isolate* isolate, int length = 0);
 
+  /**
+   * Creates a JavaScript array containing the given |elements|, without
+   * going through the generic element stores.
+   */
+  static Local<Array> New(Isolate* isolate, Local<Value>* elements,
+                          size_t length);
+
   V8_INLINE static Array* Cast(Value* obj);
  private:
   Array();
@@ -3480,6 +3733,9 @@ class V8_EXPORT ArrayBuffer : public Object {
    public:
     virtual ~Allocator() {}
 
+    enum class AllocationMode { kNormal, kReservation };
+    enum class Protection { kNoAccess, kReadWrite };
+
     /**
      * Allocate |length| bytes. Return NULL if allocation is not successful.
      * Memory should be initialized to zeroes.
@@ -3496,6 +3752,46 @@ class V8_EXPORT ArrayBuffer : public Object {
      * That memory is guaranteed to be previously allocated by |Allocate|.
      */
     virtual void Free(void* data, size_t length) = 0;
+
+    /**
+     * Free |count| memory blocks at once, where |data[i]| points to a block
+     * of size |length[i]|. V8 calls this method instead of |Free| when it
+     * releases the backing stores of array buffers that died in a garbage
+     * collection. The default implementation calls |Free| for every block.
+     */
+    virtual void FreeBatch(void** data, size_t* length, size_t count) {
+      for (size_t i = 0; i < count; i++) Free(data[i], length[i]);
+    }
+
+    /**
+     * Returns true if |Free| and |FreeBatch| may be called on a background
+     * thread, concurrently with allocations on the isolate's thread. V8 then
+     * releases the backing stores of dead array buffers off the main thread.
+     */
+    virtual bool IsThreadSafe() const { return false; }
+
+    /**
+     * Reserves |length| bytes of address space without making them
+     * accessible, for buffers that may grow in place. Accessible parts are
+     * committed with |SetProtection|. Returns NULL if reservations are not
+     * supported, which is the default.
+     */
+    virtual void* Reserve(size_t length);
+
+    /**
+     * Frees a block of size |length| that was either allocated with
+     * |Allocate| (kNormal, which calls |Free|) or reserved with |Reserve|
+     * (kReservation).
+     */
+    virtual void Free(void* data, size_t length, AllocationMode mode);
+
+    /**
+     * Changes the protection of |length| bytes at |data| inside a block
+     * returned by |Reserve|. kReadWrite commits zero-initialized memory,
+     * kNoAccess decommits it.
+     */
+    virtual void SetProtection(void* data, size_t length,
+                               Protection protection);
   };
 
   /**
@@ -3980,6 +4276,11 @@ class V8_EXPORT Date : public Object {
    * time configuration changes would be reflected in the Date
    * object.
    *
+   * The timezone transitions are computed once per process and shared
+   * by all isolates. This notification recomputes them, but only the
+   * given isolate picks them up, so it has to be sent to every isolate
+   * that should see the change.
+   *
    * This API should not be called more than needed as it will
    * negatively impact the performance of date operations.
    */
@@ -4497,6 +4798,10 @@ class V8_EXPORT FunctionTemplate : public Template {
       Local<Value> data = Local<Value>(),
       Local<Signature> signature = Local<Signature>(), int length = 0);
 
+  /** Get a template included in the snapshot by index. */
+  static MaybeLocal<FunctionTemplate> FromSnapshot(Isolate* isolate,
+                                                   size_t index);
+
   /**
    * Creates a function template with a fast handler. If a fast handler is set,
    * the callback cannot be null.
@@ -4672,6 +4977,10 @@ class V8_EXPORT ObjectTemplate : public Template {
       Local<FunctionTemplate> constructor = Local<FunctionTemplate>());
   static V8_DEPRECATED("Use isolate version", Local<ObjectTemplate> New());
 
+  /** Get a template included in the snapshot by index. */
+  static MaybeLocal<ObjectTemplate> FromSnapshot(Isolate* isolate,
+                                                 size_t index);
+
   /** Creates a new instance of this template.*/
   V8_DEPRECATE_SOON("Use maybe version", Local<Object> NewInstance());
   V8_WARN_UNUSED_RESULT MaybeLocal<Object> NewInstance(Local<Context> context);
@@ -5098,6 +5407,63 @@ class PromiseRejectMessage {
 
 typedef void (*PromiseRejectCallback)(PromiseRejectMessage message);
 
+// --- Deoptimization Callback ---
+enum DeoptimizationType {
+  kDeoptimizationEager = 0,
+  kDeoptimizationLazy = 1,
+  kDeoptimizationSoft = 2
+};
+
+class DeoptimizationEvent {
+ public:
+  DeoptimizationEvent(Local<Function> function, DeoptimizationType type,
+                      const char* reason, int position, int deopt_count,
+                      bool is_deopt_loop)
+      : function_(function),
+        type_(type),
+        reason_(reason),
+        position_(position),
+        deopt_count_(deopt_count),
+        is_deopt_loop_(is_deopt_loop) {}
+
+  V8_INLINE Local<Function> GetFunction() const { return function_; }
+  V8_INLINE DeoptimizationType GetType() const { return type_; }
+
+  /**
+   * The reason for the deoptimization, e.g. "wrong map".
+   */
+  V8_INLINE const char* GetReason() const { return reason_; }
+
+  /**
+   * The source position of the deoptimization point in the script of the
+   * function, or Message::kNoColumnInfo if it is not known, e.g. because
+   * it lies in a function that was inlined into the deoptimized one.
+   */
+  V8_INLINE int GetPosition() const { return position_; }
+
+  /**
+   * The number of deoptimizations of the function since it was last
+   * allowed to be optimized again.
+   */
+  V8_INLINE int GetDeoptCount() const { return deopt_count_; }
+
+  /**
+   * Whether the function has been deoptimized too often, which usually
+   * means that it keeps getting optimized and deoptimized again.
+   */
+  V8_INLINE bool IsDeoptLoop() const { return is_deopt_loop_; }
+
+ private:
+  Local<Function> function_;
+  DeoptimizationType type_;
+  const char* reason_;
+  int position_;
+  int deopt_count_;
+  bool is_deopt_loop_;
+};
+
+typedef void (*DeoptimizationCallback)(DeoptimizationEvent event);
+
 // --- Microtasks Callbacks ---
 typedef void (*MicrotasksCompletedCallback)(Isolate*);
 typedef void (*MicrotaskCallback)(void* data);
@@ -5209,6 +5575,17 @@ typedef void (*GCCallback)(GCType type, GCCallbackFlags flags);
 
 typedef void (*InterruptCallback)(Isolate* isolate, void* data);
 
+/**
+ * Callback invoked when the old generation is about to reach its size limit.
+ * Returns the new size limit in bytes. Returning a value that is not larger
+ * than current_heap_limit keeps the limit. In that case the callback may still
+ * reduce memory usage, e.g. by dropping caches; V8 fails with an out of
+ * memory error if that does not help. initial_heap_limit is the limit that
+ * was configured at isolate creation.
+ */
+typedef size_t (*NearHeapLimitCallback)(void* data, size_t current_heap_limit,
+                                        size_t initial_heap_limit);
+
 
 /**
  * Collection of V8 heap information.
@@ -5228,6 +5605,12 @@ class V8_EXPORT HeapStatistics {
   size_t malloced_memory() { return malloced_memory_; }
   size_t does_zap_garbage() { return does_zap_garbage_; }
 
+  /**
+   * Live bytes that the last full garbage collection with context heap
+   * accounting enabled could not attribute to any context.
+   */
+  size_t shared_live_heap_size() { return shared_live_heap_size_; }
+
  private:
   size_t total_heap_size_;
   size_t total_heap_size_executable_;
@@ -5237,12 +5620,28 @@ class V8_EXPORT HeapStatistics {
   size_t heap_size_limit_;
   size_t malloced_memory_;
   bool does_zap_garbage_;
+  size_t shared_live_heap_size_;
 
   friend class V8;
   friend class Isolate;
 };
 
 
+/**
+ * Memory attributed to a context, see Context::GetHeapStatistics.
+ */
+class V8_EXPORT ContextHeapStatistics {
+ public:
+  ContextHeapStatistics();
+  size_t live_heap_size() { return live_heap_size_; }
+
+ private:
+  size_t live_heap_size_;
+
+  friend class Context;
+};
+
+
 class V8_EXPORT HeapSpaceStatistics {
  public:
   HeapSpaceStatistics();
@@ -5263,6 +5662,40 @@ class V8_EXPORT HeapSpaceStatistics {
 };
 
 
+/**
+ * Describes the garbage collection work performed by
+ * Isolate::IdleNotificationBudget().
+ */
+class V8_EXPORT IdleGarbageCollectionResult {
+ public:
+  IdleGarbageCollectionResult();
+  bool performed_scavenge() { return performed_scavenge_; }
+  bool performed_marking_step() { return performed_marking_step_; }
+  bool performed_marking_finalization() {
+    return performed_marking_finalization_;
+  }
+  bool performed_sweeping() { return performed_sweeping_; }
+  bool performed_full_gc() { return performed_full_gc_; }
+  /**
+   * The part of the budget that was not used. Negative if V8 overshot the
+   * budget.
+   */
+  int64_t remaining_budget_in_microseconds() {
+    return remaining_budget_in_microseconds_;
+  }
+
+ private:
+  bool performed_scavenge_;
+  bool performed_marking_step_;
+  bool performed_marking_finalization_;
+  bool performed_sweeping_;
+  bool performed_full_gc_;
+  int64_t remaining_budget_in_microseconds_;
+
+  friend class Isolate;
+};
+
+
 class V8_EXPORT HeapObjectStatistics {
  public:
   HeapObjectStatistics();
@@ -5281,6 +5714,89 @@ class V8_EXPORT HeapObjectStatistics {
 };
 
 
+/**
+ * Sizes in bytes of the objects found live by the last full garbage
+ * collection that recorded heap object statistics, grouped into categories
+ * that do not overlap. See Isolate::SetHeapObjectStatisticsEnabled.
+ */
+class V8_EXPORT HeapCompositionStatistics {
+ public:
+  HeapCompositionStatistics();
+  /** Strings and the string table. */
+  size_t string_size() { return string_size_; }
+  /** Machine code and bytecode. */
+  size_t code_size() { return code_size_; }
+  /** Type feedback vectors, allocation sites and type feedback info. */
+  size_t feedback_size() { return feedback_size_; }
+  /** Maps with their descriptor arrays and code caches. */
+  size_t map_size() { return map_size_; }
+  /** JavaScript arrays and all other fixed arrays, e.g. elements. */
+  size_t array_size() { return array_size_; }
+  size_t other_size() { return other_size_; }
+  size_t total_size() {
+    return string_size_ + code_size_ + feedback_size_ + map_size_ +
+           array_size_ + other_size_;
+  }
+
+ private:
+  size_t string_size_;
+  size_t code_size_;
+  size_t feedback_size_;
+  size_t map_size_;
+  size_t array_size_;
+  size_t other_size_;
+
+  friend class Isolate;
+};
+
+
+/**
+ * Statistics of a runtime call counter, which counts the calls of a runtime
+ * function, a C++ builtin, API callbacks, garbage collections or a phase of
+ * parsing and compiling. The time is the time spent in the counted calls,
+ * less the time spent in calls counted by other counters.
+ */
+class V8_EXPORT RuntimeCallCounterStatistics {
+ public:
+  RuntimeCallCounterStatistics();
+  const char* counter_name() { return counter_name_; }
+  int64_t call_count() { return call_count_; }
+  double time_in_ms() { return time_in_ms_; }
+
+ private:
+  const char* counter_name_;
+  int64_t call_count_;
+  double time_in_ms_;
+
+  friend class Isolate;
+};
+
+
+/**
+ * Receives the counters collected with --block-coverage, see
+ * Isolate::VisitBlockCoverage. Positions are source positions in the script
+ * with the given id. The visitor must not call into V8.
+ */
+class V8_EXPORT BlockCoverageVisitor {
+ public:
+  virtual ~BlockCoverageVisitor() {}
+
+  /**
+   * Called for every function with the number of times it was invoked.
+   * Functions that were never compiled are reported with a count of zero.
+   */
+  virtual void VisitFunction(int script_id, int start_position,
+                             int end_position, uint32_t count) = 0;
+
+  /**
+   * Called for every counted block of the last visited function with the
+   * number of times it was entered. Blocks are identified by the position of
+   * their first statement.
+   */
+  virtual void VisitBlock(int script_id, int position, uint32_t count) = 0;
+};
+
+
 class RetainedObjectInfo;
 
 
@@ -5420,9 +5936,24 @@ enum class MemoryPressureLevel { kNone, kModerate, kCritical };
  * Before the first call to the TraceWrappersFrom function TracePrologue will be
  * called. When the garbage collection cycle is finished, TraceEpilogue will be
  * called.
+ *
+ * With --incremental-marking-wrappers, tracing starts with incremental
+ * marking instead. V8 then hands found wrappers to RegisterV8References and
+ * lets the embedder trace in slices through AdvanceTracing, calling
+ * EnterFinalPause before the atomic pause. The embedder has to keep track of
+ * references it creates from already traced objects between the slices.
  */
 class EmbedderHeapTracer {
  public:
+  enum ForceCompletionAction { FORCE_COMPLETION, DO_NOT_FORCE_COMPLETION };
+
+  struct AdvanceTracingActions {
+    explicit AdvanceTracingActions(ForceCompletionAction force_completion_)
+        : force_completion(force_completion_) {}
+
+    ForceCompletionAction force_completion;
+  };
+
   /**
    * V8 will call this method at the beginning of the gc cycle.
    */
@@ -5435,6 +5966,37 @@ class EmbedderHeapTracer {
    */
   virtual void TraceWrappersFrom(
       const std::vector<std::pair<void*, void*> >& internal_fields) = 0;
+  /**
+   * V8 will call this method with internal fields of found wrappers. Tracers
+   * that trace incrementally are expected to store them and trace from them
+   * in AdvanceTracing. The default implementation traces synchronously by
+   * calling TraceWrappersFrom.
+   */
+  virtual void RegisterV8References(
+      const std::vector<std::pair<void*, void*> >& internal_fields) {
+    TraceWrappersFrom(internal_fields);
+  }
+  /**
+   * V8 will call this method to trace from the registered wrappers until
+   * |deadline_in_ms|, measured by Platform::MonotonicallyIncreasingTime in
+   * milliseconds. With FORCE_COMPLETION, the embedder has to finish tracing
+   * regardless of the deadline. Returns true if there is tracing work left.
+   */
+  virtual bool AdvanceTracing(double deadline_in_ms,
+                              AdvanceTracingActions actions) {
+    return false;
+  }
+  /**
+   * V8 will call this method at the beginning of the atomic pause, after
+   * which all remaining tracing is done with FORCE_COMPLETION.
+   */
+  virtual void EnterFinalPause() {}
+  /**
+   * V8 will call this method when it aborts incremental marking. The
+   * embedder should drop registered wrappers and its marking state. No
+   * TraceEpilogue follows.
+   */
+  virtual void AbortTracing() {}
   /**
    * V8 will call this method at the end of the gc cycle. Allocation is *not*
    * allowed in the TraceEpilogue.
@@ -5466,7 +6028,9 @@ class V8_EXPORT Isolate {
           counter_lookup_callback(NULL),
           create_histogram_callback(NULL),
           add_histogram_sample_callback(NULL),
-          array_buffer_allocator(NULL) {}
+          array_buffer_allocator(NULL),
+          external_references(NULL),
+          max_background_tasks(0) {}
 
     /**
      * The optional entry_hook allows the host application to provide the
@@ -5514,6 +6078,22 @@ class V8_EXPORT Isolate {
      * store of ArrayBuffers.
      */
     ArrayBuffer::Allocator* array_buffer_allocator;
+
+    /**
+     * Specifies an optional nullptr-terminated array of raw addresses in the
+     * embedder that V8 can match against during serialization and use for
+     * deserialization. This array and its content must stay valid for the
+     * entire lifetime of the isolate.
+     */
+    intptr_t* external_references;
+
+    /**
+     * The maximal number of background tasks that the isolate runs at the
+     * same time, shared by the garbage collector and the compilers. Limiting
+     * it keeps many isolates from overwhelming the platform's worker threads.
+     * 0 means the number of background threads of the platform.
+     */
+    int max_background_tasks;
   };
 
 
@@ -5785,6 +6365,63 @@ class V8_EXPORT Isolate {
   bool GetHeapObjectStatisticsAtLastGC(HeapObjectStatistics* object_statistics,
                                        size_t type_index);
 
+  /**
+   * Enables or disables heap object statistics. While enabled, every full
+   * garbage collection counts the objects it found live by type, see
+   * GetHeapObjectStatisticsAtLastGC and GetHeapCompositionStatisticsAtLastGC.
+   * This adds a pass over the live objects to the garbage collection pause.
+   * Enabled by default with --track-gc-object-stats.
+   */
+  void SetHeapObjectStatisticsEnabled(bool enabled);
+
+  /**
+   * Get the composition of the heap at the last full garbage collection.
+   *
+   * \param composition_statistics The HeapCompositionStatistics object to
+   *   fill in. All sizes are zero until a full garbage collection ran with
+   *   heap object statistics enabled.
+   * \returns true on success, false if heap object statistics are disabled.
+   */
+  bool GetHeapCompositionStatisticsAtLastGC(
+      HeapCompositionStatistics* composition_statistics);
+
+  /**
+   * Returns the number of runtime call counters.
+   */
+  size_t NumberOfRuntimeCallCounters();
+
+  /**
+   * Get the statistics of a runtime call counter since the isolate was
+   * created or the counters were last reset. The counters are only updated
+   * when V8 runs with --runtime-call-stats, which adds a timer to every
+   * counted call.
+   *
+   * \param counter_statistics The RuntimeCallCounterStatistics object to fill
+   *   in.
+   * \param index The index of the counter, which ranges from 0 to
+   *   NumberOfRuntimeCallCounters() - 1.
+   * \returns true on success.
+   */
+  bool GetRuntimeCallCounterStatistics(
+      RuntimeCallCounterStatistics* counter_statistics, size_t index);
+
+  /**
+   * Resets all runtime call counters to zero.
+   */
+  void ResetRuntimeCallCounters();
+
+  /**
+   * Reports the function and block counters of all user scripts to
+   * |visitor|. The counters are only collected when V8 runs with
+   * --block-coverage.
+   */
+  void VisitBlockCoverage(BlockCoverageVisitor* visitor);
+
+  /**
+   * Resets all function and block counters to zero.
+   */
+  void ResetBlockCoverage();
+
   /**
    * Get a call stack sample from the isolate.
    * \param state Execution state.
@@ -6038,6 +6675,13 @@ class V8_EXPORT Isolate {
    */
   void SetPromiseRejectCallback(PromiseRejectCallback callback);
 
+  /**
+   * Set callback to notify about deoptimizations of optimized functions.
+   * The callback is invoked after the deoptimized frames have been
+   * rebuilt. Pass NULL to remove the callback.
+   */
+  void SetDeoptimizationCallback(DeoptimizationCallback callback);
+
   /**
    * Experimental: Runs the Microtask Work Queue until empty
    * Any exceptions thrown by microtask callbacks are swallowed.
@@ -6127,12 +6771,54 @@ class V8_EXPORT Isolate {
   V8_DEPRECATED("use IdleNotificationDeadline()",
                 bool IdleNotification(int idle_time_in_ms));
 
+  /**
+   * Like IdleNotificationDeadline() but for embedders that know exactly how
+   * much time they can spare. V8 performs garbage collection work (scavenges,
+   * incremental marking steps, finalization of marking and of sweeping)
+   * that is estimated to fit into budget_in_microseconds and reports the
+   * performed work and the unused budget in |result|.
+   *
+   * If next_deadline_in_seconds is non-zero, no work is started that is
+   * expected to run past it. It uses the same timebase as
+   * MonotonicallyIncreasingTime().
+   *
+   * Returns true if the embedder should stop calling idle notifications
+   * until real work has been done.
+   */
+  bool IdleNotificationBudget(int64_t budget_in_microseconds,
+                              IdleGarbageCollectionResult* result,
+                              double next_deadline_in_seconds = 0.0);
+
   /**
    * Optional notification that the system is running low on memory.
    * V8 uses these notifications to attempt to free memory.
    */
   void LowMemoryNotification();
 
+  /**
+   * Sets the callback that is invoked when the old generation comes close to
+   * its size limit. Passing nullptr removes the callback.
+   */
+  void SetNearHeapLimitCallback(NearHeapLimitCallback callback, void* data);
+
+  /**
+   * Applies the max_old_space_size and max_executable_size limits of
+   * |constraints| to a running isolate. Zero values leave the corresponding
+   * limit unchanged. The remaining constraints can only be configured at
+   * isolate creation.
+   */
+  void SetHeapLimits(const ResourceConstraints& constraints);
+
+  /**
+   * Enables or disables attribution of live memory to contexts. While
+   * enabled, every full garbage collection attributes the objects it found
+   * live to the context that created them: JavaScript objects to the context
+   * of their constructor, functions and contexts to their native context.
+   * All other objects, e.g. strings and code, are counted as shared. See
+   * Context::GetHeapStatistics and HeapStatistics::shared_live_heap_size.
+   */
+  void SetContextHeapAccountingEnabled(bool enabled);
+
   /**
    * Optional notification that a context has been disposed. V8 uses
    * these notifications to guide the GC heuristic. Returns the number
@@ -6156,6 +6842,23 @@ class V8_EXPORT Isolate {
    */
   void IsolateInBackgroundNotification();
 
+  /**
+   * Returns a profile of the functions that have been optimized in this
+   * isolate, for SetOptimizationProfile in a later process. Functions are
+   * identified by name and length of their script and their position in
+   * it, so the profile does not refer to any context. The caller owns the
+   * result.
+   */
+  ScriptCompiler::CachedData* CreateOptimizationProfile();
+
+  /**
+   * Makes V8 optimize the functions of a profile created by
+   * CreateOptimizationProfile as soon as they run, instead of waiting until
+   * they have been found to be hot. Returns false and ignores the profile if
+   * it is invalid. The data is copied.
+   */
+  bool SetOptimizationProfile(const uint8_t* data, int length);
+
   /**
    * Allows the host application to provide the address of a function that is
    * notified each time code is added, moved or removed.
@@ -6319,6 +7022,26 @@ class V8_EXPORT StartupData {
   int raw_size;
 };
 
+/**
+ * Callback to serialize the internal field of an embedder object. The
+ * callback is called for every internal field that holds an aligned pointer,
+ * see Object::SetAlignedPointerInInternalField, of the objects included in a
+ * context snapshot. It returns the serialized payload, or { NULL, 0 } to
+ * clear the field. The data array has to be allocated with new[], V8 takes
+ * ownership of it.
+ */
+typedef StartupData (*SerializeInternalFieldsCallback)(Local<Object> holder,
+                                                       int index);
+
+/**
+ * Callback to restore the internal field of an embedder object from the
+ * payload that the SerializeInternalFieldsCallback returned when the context
+ * was serialized. The payload is only valid during the callback.
+ */
+typedef void (*DeserializeInternalFieldsCallback)(Local<Object> holder,
+                                                  int index,
+                                                  StartupData payload);
+
 
 /**
  * EntropySource is used as a callback function when v8 needs a source
@@ -6397,7 +7120,9 @@ class V8_EXPORT V8 {
   /**
    * Bootstrap an isolate and a context from the cold startup blob, run the
    * warm-up script to trigger code compilation. The side effects are then
-   * discarded. The resulting startup snapshot will include compiled code.
+   * discarded. The resulting startup snapshot will include compiled code,
+   * and the type feedback that does not refer to the warm-up context, i.e.
+   * megamorphic inline caches and the call counts of megamorphic calls.
    * Returns { NULL, 0 } on failure.
    * The caller acquires ownership of the data array in the return value.
    * The argument startup blob is untouched.
@@ -6700,6 +7425,103 @@ class V8_EXPORT V8 {
   friend class Context;
 };
 
+/**
+ * A pool of isolates that are created ahead of time on background threads of
+ * the platform, for embedders that need a fresh isolate on short notice.
+ * Initializing an isolate, which includes deserializing the startup
+ * snapshot, then happens off the critical path.
+ */
+class V8_EXPORT IsolatePool {
+ public:
+  /**
+   * Creates a pool that keeps |size| initialized isolates ready. The create
+   * params, and everything they point to, must outlive the pool.
+   */
+  IsolatePool(const Isolate::CreateParams& params, size_t size);
+
+  /**
+   * Waits for pending isolate creations to finish and disposes the isolates
+   * that were not acquired.
+   */
+  ~IsolatePool();
+
+  /**
+   * Returns an initialized isolate and starts creating its replacement in
+   * the background. If no isolate is ready, one is created on the calling
+   * thread. The caller owns the isolate and has to dispose it.
+   */
+  Isolate* Acquire();
+
+ private:
+  void* data_;
+
+  // Disallow copying and assigning.
+  IsolatePool(const IsolatePool&);
+  void operator=(const IsolatePool&);
+};
+
+
+/**
+ * Helper class to create a snapshot data blob.
+ */
+class V8_EXPORT SnapshotCreator {
+ public:
+  enum class FunctionCodeHandling { kClear, kKeep };
+
+  /**
+   * Create and enter an isolate, and set it up for serialization.
+   * The isolate is either created from scratch or from an existing snapshot.
+   * The caller keeps ownership of the argument snapshot.
+   * \param existing_blob existing snapshot from which to create this one.
+   * \param external_references a null-terminated array of external references
+   *        that must be equivalent to CreateParams::external_references.
+   */
+  SnapshotCreator(intptr_t* external_references = NULL,
+                  StartupData* existing_blob = NULL);
+
+  ~SnapshotCreator();
+
+  /**
+   * \returns the isolate prepared by the snapshot creator.
+   */
+  Isolate* GetIsolate();
+
+  /**
+   * Add a context to be included in the snapshot blob. The first context
+   * added is the one that Context::New() deserializes, the others can be
+   * deserialized with Context::FromSnapshot().
+   * \returns the index of the context in the snapshot blob.
+   */
+  size_t AddContext(Local<Context> context);
+
+  /**
+   * Add a template to be included in the snapshot blob.
+   * \returns the index of the template in the snapshot blob.
+   */
+  size_t AddTemplate(Local<Template> template_obj);
+
+  /**
+   * Creates a snapshot data blob.
+   * This must not be called from within a handle scope.
+   * \param function_code_handling whether to include compiled function code
+   *        in the snapshot.
+   * \param internal_fields_serializer an optional callback to serialize the
+   *        internal fields of the embedder objects in the added contexts.
+   * \returns { nullptr, 0 } on failure, and a startup snapshot on success. The
+   *        caller acquires ownership of the data array in the return value.
+   */
+  StartupData CreateBlob(
+      FunctionCodeHandling function_code_handling,
+      SerializeInternalFieldsCallback internal_fields_serializer = NULL);
+
+ private:
+  void* data_;
+
+  // Disallow copying and assigning.
+  SnapshotCreator(const SnapshotCreator&);
+  void operator=(const SnapshotCreator&);
+};
+
 
 /**
  * A simple Maybe type, representing an object which may or may not have a
@@ -6727,6 +7549,13 @@ class Maybe {
     return has_value ? value : default_value;
   }
 
+  // Stores the value in |out| and returns true unless the Maybe<> is nothing,
+  // in which case |out| is left untouched.
+  V8_WARN_UNUSED_RESULT V8_INLINE bool To(T* out) const {
+    if (V8_LIKELY(IsJust())) *out = value;
+    return IsJust();
+  }
+
   V8_INLINE bool operator==(const Maybe& other) const {
     return (IsJust() == other.IsJust()) &&
            (!IsJust() || FromJust() == other.FromJust());
@@ -6988,6 +7817,29 @@ class V8_EXPORT Context {
       Local<ObjectTemplate> global_template = Local<ObjectTemplate>(),
       Local<Value> global_object = Local<Value>());
 
+  /**
+   * Create a new context from a (non-default) context snapshot. There
+   * is no way to provide a global object template since we do not create
+   * a new global object from template, but we can reuse a global object.
+   *
+   * \param isolate See v8::Context::New.
+   *
+   * \param context_snapshot_index The index of the context snapshot to
+   * deserialize from, as returned by SnapshotCreator::AddContext().
+   *
+   * \param internal_fields_deserializer An optional callback to restore the
+   * internal fields that SnapshotCreator::CreateBlob() serialized.
+   *
+   * \param extensions See v8::Context::New.
+   *
+   * \param global_object See v8::Context::New.
+   */
+  static MaybeLocal<Context> FromSnapshot(
+      Isolate* isolate, size_t context_snapshot_index,
+      DeserializeInternalFieldsCallback internal_fields_deserializer = NULL,
+      ExtensionConfiguration* extensions = NULL,
+      Local<Value> global_object = Local<Value>());
+
   /**
    * Sets the security token for the context.  To access an object in
    * another context, the security tokens must match.
@@ -7094,6 +7946,15 @@ class V8_EXPORT Context {
    */
   size_t EstimatedSize();
 
+  /**
+   * Get the live bytes attributed to this context by the last full garbage
+   * collection that ran with context heap accounting enabled, see
+   * Isolate::SetContextHeapAccountingEnabled. The size is measured in
+   * kilobyte granularity. Returns false if no such garbage collection has
+   * happened since the context was created.
+   */
+  bool GetHeapStatistics(ContextHeapStatistics* statistics);
+
   /**
    * Stack-allocated class which sets the execution context for all
    * operations executed within a local scope.
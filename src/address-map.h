@@ -164,10 +164,6 @@ class BackReferenceMap : public AddressMapBase {
     SetValue(entry, b.bitfield());
   }
 
-  void AddSourceString(String* string) {
-    Add(string, BackReference::SourceReference());
-  }
-
   void AddGlobalProxy(HeapObject* global_proxy) {
     Add(global_proxy, BackReference::GlobalProxyReference());
   }
@@ -124,5 +124,39 @@ FastAccessorBuilder::ValueId FastAccessorBuilder::Call(
   return FromApi(this)->Call(callback, value_id);
 }
 
+
+void FastApiFunction::Set(Local<FunctionTemplate> function_template,
+                          const void* c_function, Type return_type,
+                          int argument_count, const Type* argument_types) {
+  i::Handle<i::FunctionTemplateInfo> info =
+      Utils::OpenHandle(*function_template);
+  i::Isolate* isolate = info->GetIsolate();
+  Utils::ApiCheck(!info->instantiated(), "v8::FastApiFunction::Set",
+                  "FunctionTemplate already instantiated");
+  Utils::ApiCheck(info->call_code()->IsCallHandlerInfo(),
+                  "v8::FastApiFunction::Set",
+                  "FunctionTemplate has no callback");
+  Utils::ApiCheck(info->signature()->IsUndefined(), "v8::FastApiFunction::Set",
+                  "FunctionTemplate has a signature");
+  Utils::ApiCheck(0 <= argument_count && argument_count <= kMaxArgumentCount,
+                  "v8::FastApiFunction::Set", "Too many arguments");
+  int signature =
+      i::CallHandlerInfo::FastReturnTypeBits::encode(return_type) |
+      i::CallHandlerInfo::FastArgumentCountBits::encode(argument_count);
+  for (int i = 0; i < argument_count; i++) {
+    Utils::ApiCheck(
+        argument_types[i] == kInt32 || argument_types[i] == kFloat64,
+        "v8::FastApiFunction::Set", "Invalid argument type");
+    signature |= argument_types[i]
+                 << i::CallHandlerInfo::FastArgumentTypeShift(i);
+  }
+  i::HandleScope scope(isolate);
+  i::Handle<i::CallHandlerInfo> call_code(
+      i::CallHandlerInfo::cast(info->call_code()), isolate);
+  call_code->set_fast_c_function(
+      *FromCData(isolate, const_cast<void*>(c_function)));
+  call_code->set_fast_c_signature(i::Smi::FromInt(signature));
+}
+
 }  // namespace experimental
 }  // namespace v8
@@ -266,8 +266,47 @@ MaybeHandle<JSObject> ConfigureInstance(Isolate* isolate, Handle<JSObject> obj,
   return obj;
 }
 
+MaybeHandle<JSObject> ProbeInstantiationsCache(Isolate* isolate,
+                                               uint32_t serial_number) {
+  DCHECK_LT(0u, serial_number);
+  if (serial_number <= ApiNatives::kFastTemplateInstantiationsCacheSize) {
+    FixedArray* fast_cache =
+        isolate->native_context()->fast_template_instantiations_cache();
+    if (serial_number > static_cast<uint32_t>(fast_cache->length())) {
+      return MaybeHandle<JSObject>();
+    }
+    Object* object = fast_cache->get(serial_number - 1);
+    if (object->IsUndefined()) return MaybeHandle<JSObject>();
+    return handle(JSObject::cast(object), isolate);
+  }
+  UnseededNumberDictionary* cache =
+      isolate->native_context()->template_instantiations_cache();
+  int entry = cache->FindEntry(serial_number);
+  if (entry == UnseededNumberDictionary::kNotFound) {
+    return MaybeHandle<JSObject>();
+  }
+  return handle(JSObject::cast(cache->ValueAt(entry)), isolate);
+}
+
 void CacheTemplateInstantiation(Isolate* isolate, uint32_t serial_number,
                                 Handle<JSObject> object) {
+  DCHECK_LT(0u, serial_number);
+  if (serial_number <= ApiNatives::kFastTemplateInstantiationsCacheSize) {
+    Handle<FixedArray> fast_cache =
+        isolate->fast_template_instantiations_cache();
+    int length = fast_cache->length();
+    if (serial_number > static_cast<uint32_t>(length)) {
+      int new_length = Max(static_cast<int>(serial_number), 2 * length);
+      new_length =
+          Min(new_length, ApiNatives::kFastTemplateInstantiationsCacheSize);
+      fast_cache = isolate->factory()->CopyFixedArrayAndGrow(
+          fast_cache, new_length - length);
+      isolate->native_context()->set_fast_template_instantiations_cache(
+          *fast_cache);
+    }
+    fast_cache->set(serial_number - 1, *object);
+    return;
+  }
   auto cache = isolate->template_instantiations_cache();
   auto new_cache =
       UnseededNumberDictionary::AtNumberPut(cache, serial_number, object);
@@ -275,6 +314,15 @@ void CacheTemplateInstantiation(Isolate* isolate, uint32_t serial_number,
 }
 
 void UncacheTemplateInstantiation(Isolate* isolate, uint32_t serial_number) {
+  DCHECK_LT(0u, serial_number);
+  if (serial_number <= ApiNatives::kFastTemplateInstantiationsCacheSize) {
+    FixedArray* fast_cache =
+        isolate->native_context()->fast_template_instantiations_cache();
+    DCHECK_LE(serial_number, static_cast<uint32_t>(fast_cache->length()));
+    DCHECK(!fast_cache->get(serial_number - 1)->IsUndefined());
+    fast_cache->set_undefined(serial_number - 1);
+    return;
+  }
   auto cache = isolate->template_instantiations_cache();
   int entry = cache->FindEntry(serial_number);
   DCHECK(entry != UnseededNumberDictionary::kNotFound);
@@ -295,11 +343,7 @@ MaybeHandle<JSObject> InstantiateObject(Isolate* isolate,
       static_cast<uint32_t>(Smi::cast(info->serial_number())->value());
   if (serial_number) {
     // Probe cache.
-    auto cache = isolate->template_instantiations_cache();
-    int entry = cache->FindEntry(serial_number);
-    if (entry != UnseededNumberDictionary::kNotFound) {
-      Object* boilerplate = cache->ValueAt(entry);
-      result = handle(JSObject::cast(boilerplate), isolate);
+    if (ProbeInstantiationsCache(isolate, serial_number).ToHandle(&result)) {
       return isolate->factory()->CopyJSObject(result);
     }
   }
@@ -337,11 +381,9 @@ MaybeHandle<JSFunction> InstantiateFunction(Isolate* isolate,
       static_cast<uint32_t>(Smi::cast(data->serial_number())->value());
   if (serial_number) {
     // Probe cache.
-    auto cache = isolate->template_instantiations_cache();
-    int entry = cache->FindEntry(serial_number);
-    if (entry != UnseededNumberDictionary::kNotFound) {
-      Object* element = cache->ValueAt(entry);
-      return handle(JSFunction::cast(element), isolate);
+    Handle<JSObject> result;
+    if (ProbeInstantiationsCache(isolate, serial_number).ToHandle(&result)) {
+      return Handle<JSFunction>::cast(result);
     }
   }
   // Enter a new scope.  Recursion could otherwise create a lot of handles.
@@ -18,6 +18,10 @@ class TemplateInfo;
 class ApiNatives {
  public:
   static const int kInitialFunctionCacheSize = 256;
+  // Instantiations of templates with serial numbers up to this bound are
+  // cached in a FixedArray indexed by the serial number, the others in a
+  // dictionary.
+  static const int kFastTemplateInstantiationsCacheSize = 1024;
 
   MUST_USE_RESULT static MaybeHandle<JSFunction> InstantiateFunction(
       Handle<FunctionTemplateInfo> data);
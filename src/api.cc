@@ -15,15 +15,19 @@
 #include "include/v8-experimental.h"
 #include "include/v8-profiler.h"
 #include "include/v8-testing.h"
+#include "include/v8-util.h"
 #include "src/accessors.h"
 #include "src/api-experimental.h"
 #include "src/api-natives.h"
 #include "src/assert-scope.h"
 #include "src/background-parsing-task.h"
+#include "src/background-task-budget.h"
 #include "src/base/functional.h"
+#include "src/base/platform/condition-variable.h"
 #include "src/base/platform/platform.h"
 #include "src/base/platform/time.h"
 #include "src/base/utils/random-number-generator.h"
+#include "src/block-coverage.h"
 #include "src/bootstrapper.h"
 #include "src/char-predicates-inl.h"
 #include "src/code-stubs.h"
@@ -37,6 +41,7 @@
 #include "src/execution.h"
 #include "src/gdb-jit.h"
 #include "src/global-handles.h"
+#include "src/heap/object-stats.h"
 #include "src/icu_util.h"
 #include "src/isolate-inl.h"
 #include "src/json-parser.h"
@@ -56,6 +61,8 @@
 #include "src/runtime-profiler.h"
 #include "src/runtime/runtime.h"
 #include "src/simulator.h"
+#include "src/snapshot/builtin-serializer.h"
+#include "src/snapshot/code-serializer.h"
 #include "src/snapshot/natives.h"
 #include "src/snapshot/snapshot.h"
 #include "src/startup-data-util.h"
@@ -63,6 +70,7 @@
 #include "src/unicode-inl.h"
 #include "src/v8.h"
 #include "src/v8threads.h"
+#include "src/value-serializer.h"
 #include "src/version.h"
 #include "src/vm-state-inl.h"
 
@@ -352,6 +360,7 @@ class ArrayBufferAllocator : public v8::ArrayBuffer::Allocator {
   }
   virtual void* AllocateUninitialized(size_t length) { return malloc(length); }
   virtual void Free(void* data, size_t) { free(data); }
+  virtual bool IsThreadSafe() const { return true; }
 };
 
 bool RunExtraCode(Isolate* isolate, Local<Context> context,
@@ -382,21 +391,89 @@ bool RunExtraCode(Isolate* isolate, Local<Context> context,
   return true;
 }
 
-StartupData SerializeIsolateAndContext(
-    Isolate* isolate, Persistent<Context>* context,
-    i::Snapshot::Metadata metadata,
-    i::StartupSerializer::FunctionCodeHandling function_code_handling) {
-  if (context->IsEmpty()) return {NULL, 0};
+// The state of a SnapshotCreator. V8::CreateSnapshotDataBlob() and
+// V8::WarmUpSnapshotDataBlob() use it directly, as they also know whether
+// the snapshot embeds a script.
+class SnapshotCreatorData {
+ public:
+  // Sets up the newly allocated {internal_isolate} for serialization, either
+  // from scratch or from an existing snapshot, and enters it.
+  SnapshotCreatorData(i::Isolate* internal_isolate,
+                      intptr_t* external_references,
+                      StartupData* existing_snapshot)
+      : isolate_(reinterpret_cast<Isolate*>(internal_isolate)),
+        contexts_(isolate_),
+        templates_(isolate_),
+        created_(false) {
+    DCHECK(internal_isolate->serializer_enabled());
+    internal_isolate->set_array_buffer_allocator(&allocator_);
+    internal_isolate->set_api_external_references(external_references);
+    isolate_->Enter();
+    if (existing_snapshot) {
+      internal_isolate->set_snapshot_blob(existing_snapshot);
+      i::Snapshot::Initialize(internal_isolate);
+    } else {
+      internal_isolate->Init(NULL);
+    }
+    // Anything else but a vanilla context cannot be recreated from scratch.
+    metadata_.set_embeds_script(true);
+  }
 
-  i::Isolate* internal_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  ~SnapshotCreatorData() {
+    contexts_.Clear();
+    templates_.Clear();
+    isolate_->Exit();
+    isolate_->Dispose();
+  }
+
+  static SnapshotCreatorData* cast(void* data) {
+    return reinterpret_cast<SnapshotCreatorData*>(data);
+  }
+
+  StartupData CreateBlob(
+      i::StartupSerializer::FunctionCodeHandling function_code_handling,
+      SerializeInternalFieldsCallback internal_fields_serializer);
+
+  ArrayBufferAllocator allocator_;
+  Isolate* isolate_;
+  PersistentValueVector<Context> contexts_;
+  PersistentValueVector<Template> templates_;
+  i::Snapshot::Metadata metadata_;
+  bool created_;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(SnapshotCreatorData);
+};
+
+StartupData SnapshotCreatorData::CreateBlob(
+    i::StartupSerializer::FunctionCodeHandling function_code_handling,
+    SerializeInternalFieldsCallback internal_fields_serializer) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(isolate_);
+  DCHECK(!created_);
+  created_ = true;
+  if (contexts_.IsEmpty()) return {NULL, 0};
+
+  {
+    // The templates become part of the startup snapshot, and the contexts
+    // refer to them through the partial snapshot cache.
+    i::HandleScope scope(isolate);
+    int num_templates = static_cast<int>(templates_.Size());
+    i::Handle<i::FixedArray> templates =
+        isolate->factory()->NewFixedArray(num_templates, i::TENURED);
+    for (int i = 0; i < num_templates; i++) {
+      templates->set(i, *v8::Utils::OpenHandle(*templates_.Get(i)));
+    }
+    isolate->heap()->SetSerializedTemplates(*templates);
+    templates_.Clear();
+  }
 
   // If we don't do this then we end up with a stray root pointing at the
   // context even after we have disposed of the context.
-  internal_isolate->heap()->CollectAllAvailableGarbage("mksnapshot");
+  isolate->heap()->CollectAllAvailableGarbage("mksnapshot");
 
   // GC may have cleared weak cells, so compact any WeakFixedArrays
   // found on the heap.
-  i::HeapIterator iterator(internal_isolate->heap(),
+  i::HeapIterator iterator(isolate->heap(),
                            i::HeapIterator::kFilterUnreachable);
   for (i::HeapObject* o = iterator.next(); o != NULL; o = iterator.next()) {
     if (o->IsPrototypeInfo()) {
@@ -414,24 +491,124 @@ StartupData SerializeIsolateAndContext(
     }
   }
 
-  i::Object* raw_context = *v8::Utils::OpenPersistent(*context);
-  context->Reset();
-
-  i::SnapshotByteSink snapshot_sink;
-  i::StartupSerializer ser(internal_isolate, &snapshot_sink,
-                           function_code_handling);
-  ser.SerializeStrongReferences();
+  // Builtins that are deserialized on their first call are replaced by
+  // placeholders in the startup snapshot. This is the last allocation.
+  i::List<i::Code*> lazy_builtin_placeholders;
+  if (i::FLAG_lazy_deserialization) {
+    i::BuiltinSerializer::CreatePlaceholders(isolate,
+                                             &lazy_builtin_placeholders);
+  }
+
+  // The contexts must not be reachable from handles or global handles, which
+  // are roots of the startup snapshot.
+  i::DisallowHeapAllocation no_gc_from_here_on;
+  int num_contexts = static_cast<int>(contexts_.Size());
+  i::List<i::Object*> contexts(num_contexts);
+  for (int i = 0; i < num_contexts; i++) {
+    i::HandleScope scope(isolate);
+    i::Handle<i::Context> context = v8::Utils::OpenHandle(*contexts_.Get(i));
+    contexts.Add(*context);
+  }
+  contexts_.Clear();
+
+  i::SnapshotByteSink startup_sink;
+  i::StartupSerializer startup_serializer(
+      isolate, &startup_sink, function_code_handling,
+      i::FLAG_lazy_deserialization ? &lazy_builtin_placeholders : NULL);
+  startup_serializer.SerializeStrongReferences();
+
+  // Serialize each context with a new partial serializer.
+  i::List<i::SnapshotData*> context_snapshots(num_contexts);
+  for (int i = 0; i < num_contexts; i++) {
+    i::SnapshotByteSink context_sink;
+    i::PartialSerializer context_serializer(isolate, &startup_serializer,
+                                            &context_sink,
+                                            internal_fields_serializer);
+    context_serializer.Serialize(&contexts[i]);
+    context_snapshots.Add(new i::SnapshotData(context_serializer));
+  }
+
+  // Serialize each lazily deserialized builtin on its own.
+  i::List<i::SnapshotData*> builtin_snapshots(i::Builtins::builtin_count);
+  for (int i = 0; i < i::Builtins::builtin_count; i++) {
+    i::Code* builtin =
+        isolate->builtins()->builtin(static_cast<i::Builtins::Name>(i));
+    if (lazy_builtin_placeholders.is_empty() ||
+        lazy_builtin_placeholders[i] == NULL) {
+      builtin_snapshots.Add(NULL);
+      continue;
+    }
+    i::SnapshotByteSink builtin_sink;
+    i::BuiltinSerializer builtin_serializer(isolate, &startup_serializer,
+                                            &builtin_sink);
+    builtin_serializer.Serialize(builtin);
+    builtin_snapshots.Add(new i::SnapshotData(builtin_serializer));
+  }
 
-  i::SnapshotByteSink context_sink;
-  i::PartialSerializer context_ser(internal_isolate, &ser, &context_sink);
-  context_ser.Serialize(&raw_context);
-  ser.SerializeWeakReferencesAndDeferred();
+  startup_serializer.SerializeWeakReferencesAndDeferred();
+  i::SnapshotData startup_snapshot(startup_serializer);
+  StartupData result = i::Snapshot::CreateSnapshotBlob(
+      &startup_snapshot, &builtin_snapshots, &context_snapshots, metadata_);
 
-  return i::Snapshot::CreateSnapshotBlob(ser, context_ser, metadata);
+  for (i::SnapshotData* builtin_snapshot : builtin_snapshots) {
+    delete builtin_snapshot;
+  }
+  for (i::SnapshotData* context_snapshot : context_snapshots) {
+    delete context_snapshot;
+  }
+  return result;
 }
 
 }  // namespace
 
+SnapshotCreator::SnapshotCreator(intptr_t* external_references,
+                                 StartupData* existing_snapshot) {
+  data_ = new SnapshotCreatorData(new i::Isolate(true), external_references,
+                                  existing_snapshot);
+}
+
+SnapshotCreator::~SnapshotCreator() {
+  SnapshotCreatorData* data = SnapshotCreatorData::cast(data_);
+  DCHECK(data->created_);
+  delete data;
+}
+
+Isolate* SnapshotCreator::GetIsolate() {
+  return SnapshotCreatorData::cast(data_)->isolate_;
+}
+
+size_t SnapshotCreator::AddContext(Local<Context> context) {
+  DCHECK(!context.IsEmpty());
+  SnapshotCreatorData* data = SnapshotCreatorData::cast(data_);
+  DCHECK(!data->created_);
+  Isolate* isolate = data->isolate_;
+  CHECK_EQ(isolate, context->GetIsolate());
+  size_t index = data->contexts_.Size();
+  data->contexts_.Append(context);
+  return index;
+}
+
+size_t SnapshotCreator::AddTemplate(Local<Template> template_obj) {
+  DCHECK(!template_obj.IsEmpty());
+  SnapshotCreatorData* data = SnapshotCreatorData::cast(data_);
+  DCHECK(!data->created_);
+  DCHECK_EQ(reinterpret_cast<i::Isolate*>(data->isolate_),
+            Utils::OpenHandle(*template_obj)->GetIsolate());
+  size_t index = data->templates_.Size();
+  data->templates_.Append(template_obj);
+  return index;
+}
+
+StartupData SnapshotCreator::CreateBlob(
+    SnapshotCreator::FunctionCodeHandling function_code_handling,
+    SerializeInternalFieldsCallback internal_fields_serializer) {
+  return SnapshotCreatorData::cast(data_)->CreateBlob(
+      function_code_handling == FunctionCodeHandling::kKeep
+          ? i::StartupSerializer::KEEP_FUNCTION_CODE
+          : i::StartupSerializer::CLEAR_FUNCTION_CODE,
+      internal_fields_serializer);
+}
+
 StartupData V8::CreateSnapshotDataBlob(const char* embedded_source) {
   // Create a new isolate and a new context from scratch, optionally run
   // a script to embed, and serialize to create a snapshot blob.
@@ -440,33 +617,21 @@ StartupData V8::CreateSnapshotDataBlob(const char* embedded_source) {
   base::ElapsedTimer timer;
   timer.Start();
 
-  ArrayBufferAllocator allocator;
-  i::Isolate* internal_isolate = new i::Isolate(true);
-  internal_isolate->set_array_buffer_allocator(&allocator);
-  Isolate* isolate = reinterpret_cast<Isolate*>(internal_isolate);
-
   {
-    Isolate::Scope isolate_scope(isolate);
-    internal_isolate->Init(NULL);
-    Persistent<Context> context;
+    SnapshotCreatorData snapshot_creator(new i::Isolate(true), NULL, NULL);
+    Isolate* isolate = snapshot_creator.isolate_;
     {
       HandleScope handle_scope(isolate);
-      Local<Context> new_context = Context::New(isolate);
-      context.Reset(isolate, new_context);
-      if (embedded_source != NULL &&
-          !RunExtraCode(isolate, new_context, embedded_source, "<embedded>")) {
-        context.Reset();
+      Local<Context> context = Context::New(isolate);
+      if (embedded_source == NULL ||
+          RunExtraCode(isolate, context, embedded_source, "<embedded>")) {
+        snapshot_creator.contexts_.Append(context);
       }
     }
-
-    i::Snapshot::Metadata metadata;
-    metadata.set_embeds_script(embedded_source != NULL);
-
-    result = SerializeIsolateAndContext(
-        isolate, &context, metadata, i::StartupSerializer::CLEAR_FUNCTION_CODE);
-    DCHECK(context.IsEmpty());
+    snapshot_creator.metadata_.set_embeds_script(embedded_source != NULL);
+    result = snapshot_creator.CreateBlob(
+        i::StartupSerializer::CLEAR_FUNCTION_CODE, NULL);
   }
-  isolate->Dispose();
 
   if (i::FLAG_profile_deserialization) {
     i::PrintF("Creating snapshot took %0.3f ms\n",
@@ -491,37 +656,28 @@ StartupData V8::WarmUpSnapshotDataBlob(StartupData cold_snapshot_blob,
   base::ElapsedTimer timer;
   timer.Start();
 
-  ArrayBufferAllocator allocator;
-  i::Isolate* internal_isolate = new i::Isolate(true);
-  internal_isolate->set_array_buffer_allocator(&allocator);
-  internal_isolate->set_snapshot_blob(&cold_snapshot_blob);
-  Isolate* isolate = reinterpret_cast<Isolate*>(internal_isolate);
-
   {
-    Isolate::Scope isolate_scope(isolate);
-    i::Snapshot::Initialize(internal_isolate);
-    Persistent<Context> context;
+    SnapshotCreatorData snapshot_creator(new i::Isolate(true), NULL,
+                                         &cold_snapshot_blob);
+    Isolate* isolate = snapshot_creator.isolate_;
+    i::Isolate* internal_isolate = reinterpret_cast<i::Isolate*>(isolate);
     bool success;
     {
       HandleScope handle_scope(isolate);
-      Local<Context> new_context = Context::New(isolate);
-      success = RunExtraCode(isolate, new_context, warmup_source, "<warm-up>");
+      Local<Context> context = Context::New(isolate);
+      success = RunExtraCode(isolate, context, warmup_source, "<warm-up>");
     }
     if (success) {
       HandleScope handle_scope(isolate);
       isolate->ContextDisposedNotification(false);
-      Local<Context> new_context = Context::New(isolate);
-      context.Reset(isolate, new_context);
+      Local<Context> context = Context::New(isolate);
+      snapshot_creator.contexts_.Append(context);
     }
-
-    i::Snapshot::Metadata metadata;
-    metadata.set_embeds_script(i::Snapshot::EmbedsScript(internal_isolate));
-
-    result = SerializeIsolateAndContext(
-        isolate, &context, metadata, i::StartupSerializer::KEEP_FUNCTION_CODE);
-    DCHECK(context.IsEmpty());
+    snapshot_creator.metadata_.set_embeds_script(
+        i::Snapshot::EmbedsScript(internal_isolate));
+    result = snapshot_creator.CreateBlob(
+        i::StartupSerializer::KEEP_FUNCTION_CODE, NULL);
   }
-  isolate->Dispose();
 
   if (i::FLAG_profile_deserialization) {
     i::PrintF("Warming up snapshot took %0.3f ms\n",
@@ -1117,8 +1273,7 @@ static Local<FunctionTemplate> FunctionTemplateNew(
   obj->set_do_not_cache(do_not_cache);
   int next_serial_number = 0;
   if (!do_not_cache) {
-    next_serial_number = isolate->next_serial_number() + 1;
-    isolate->set_next_serial_number(next_serial_number);
+    next_serial_number = isolate->heap()->NextTemplateSerialNumber();
   }
   obj->set_serial_number(i::Smi::FromInt(next_serial_number));
   if (callback != 0) {
@@ -1143,9 +1298,6 @@ Local<FunctionTemplate> FunctionTemplate::New(Isolate* isolate,
                                               v8::Local<Signature> signature,
                                               int length) {
   i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
-  // Changes to the environment cannot be captured in the snapshot. Expect no
-  // function templates when the isolate is created for serialization.
-  DCHECK(!i_isolate->serializer_enabled());
   LOG_API(i_isolate, "FunctionTemplate::New");
   ENTER_V8(i_isolate);
   return FunctionTemplateNew(i_isolate, callback, nullptr, data, signature,
@@ -1153,12 +1305,27 @@ Local<FunctionTemplate> FunctionTemplate::New(Isolate* isolate,
 }
 
 
+MaybeLocal<FunctionTemplate> FunctionTemplate::FromSnapshot(Isolate* isolate,
+                                                          size_t index) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  i::FixedArray* templates = i_isolate->heap()->serialized_templates();
+  int int_index = static_cast<int>(index);
+  if (int_index < templates->length()) {
+    i::Object* info = templates->get(int_index);
+    if (info->IsFunctionTemplateInfo()) {
+      return Utils::ToLocal(i::Handle<i::FunctionTemplateInfo>(
+          i::FunctionTemplateInfo::cast(info)));
+    }
+  }
+  return Local<FunctionTemplate>();
+}
+
+
 Local<FunctionTemplate> FunctionTemplate::NewWithFastHandler(
     Isolate* isolate, FunctionCallback callback,
     experimental::FastAccessorBuilder* fast_handler, v8::Local<Value> data,
     v8::Local<Signature> signature, int length) {
   i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
-  DCHECK(!i_isolate->serializer_enabled());
   LOG_API(i_isolate, "FunctionTemplate::NewWithFastHandler");
   ENTER_V8(i_isolate);
   return FunctionTemplateNew(i_isolate, callback, fast_handler, data, signature,
@@ -1340,9 +1507,6 @@ Local<ObjectTemplate> ObjectTemplate::New() {
 static Local<ObjectTemplate> ObjectTemplateNew(
     i::Isolate* isolate, v8::Local<FunctionTemplate> constructor,
     bool do_not_cache) {
-  // Changes to the environment cannot be captured in the snapshot. Expect no
-  // object templates when the isolate is created for serialization.
-  DCHECK(!isolate->serializer_enabled());
   LOG_API(isolate, "ObjectTemplate::New");
   ENTER_V8(isolate);
   i::Handle<i::Struct> struct_obj =
@@ -1352,8 +1516,7 @@ static Local<ObjectTemplate> ObjectTemplateNew(
   InitializeTemplate(obj, Consts::OBJECT_TEMPLATE);
   int next_serial_number = 0;
   if (!do_not_cache) {
-    next_serial_number = isolate->next_serial_number() + 1;
-    isolate->set_next_serial_number(next_serial_number);
+    next_serial_number = isolate->heap()->NextTemplateSerialNumber();
   }
   obj->set_serial_number(i::Smi::FromInt(next_serial_number));
   if (!constructor.IsEmpty())
@@ -1367,6 +1530,21 @@ Local<ObjectTemplate> ObjectTemplate::New(
   return ObjectTemplateNew(isolate, constructor, false);
 }
 
+MaybeLocal<ObjectTemplate> ObjectTemplate::FromSnapshot(Isolate* isolate,
+                                                      size_t index) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  i::FixedArray* templates = i_isolate->heap()->serialized_templates();
+  int int_index = static_cast<int>(index);
+  if (int_index < templates->length()) {
+    i::Object* info = templates->get(int_index);
+    if (info->IsObjectTemplateInfo()) {
+      return Utils::ToLocal(
+          i::Handle<i::ObjectTemplateInfo>(i::ObjectTemplateInfo::cast(info)));
+    }
+  }
+  return Local<ObjectTemplate>();
+}
+
 // Ensure that the object template has a constructor.  If no
 // constructor is available we create one.
 static i::Handle<i::FunctionTemplateInfo> EnsureConstructor(
@@ -1672,6 +1850,7 @@ ScriptCompiler::CachedData::CachedData(const uint8_t* data_, int length_,
     : data(data_),
       length(length_),
       rejected(false),
+      reject_reason(kNotRejected),
       buffer_policy(buffer_policy_) {}
 
 
@@ -1693,6 +1872,13 @@ ScriptCompiler::StreamedSource::StreamedSource(ExternalSourceStream* stream,
     : impl_(new i::StreamedSource(stream, encoding)) {}
 
 
+ScriptCompiler::StreamedSource::StreamedSource(const uint8_t* data,
+                                               size_t length,
+                                               Encoding encoding)
+    : impl_(new i::StreamedSource(new i::InMemorySourceStream(data, length),
+                                  encoding)) {}
+
+
 ScriptCompiler::StreamedSource::~StreamedSource() { delete impl_; }
 
 
@@ -1885,6 +2071,7 @@ MaybeLocal<UnboundScript> ScriptCompiler::CompileUnboundInternal(
       script_data->ReleaseDataOwnership();
     } else if (options == kConsumeParserCache || options == kConsumeCodeCache) {
       source->cached_data->rejected = script_data->rejected();
+      source->cached_data->reject_reason = script_data->reject_reason();
     }
     delete script_data;
   }
@@ -2090,7 +2277,15 @@ ScriptCompiler::ScriptStreamingTask* ScriptCompiler::StartStreamingScript(
     Isolate* v8_isolate, StreamedSource* source, CompileOptions options) {
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(v8_isolate);
   return new i::BackgroundParsingTask(source->impl(), options,
-                                      i::FLAG_stack_size, isolate);
+                                      i::FLAG_stack_size, isolate, false);
+}
+
+
+ScriptCompiler::ScriptStreamingTask* ScriptCompiler::StartStreamingModule(
+    Isolate* v8_isolate, StreamedSource* source, CompileOptions options) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(v8_isolate);
+  return new i::BackgroundParsingTask(source->impl(), options,
+                                      i::FLAG_stack_size, isolate, true);
 }
 
 
@@ -2165,6 +2360,27 @@ uint32_t ScriptCompiler::CachedDataVersionTag() {
 }
 
 
+ScriptCompiler::CachedData* ScriptCompiler::CreateCodeCache(
+    Local<UnboundScript> unbound_script, Local<String> source) {
+  i::Handle<i::SharedFunctionInfo> shared =
+      i::Handle<i::SharedFunctionInfo>::cast(
+          Utils::OpenHandle(*unbound_script));
+  i::Isolate* isolate = shared->GetIsolate();
+  LOG_API(isolate, "v8::ScriptCompiler::CreateCodeCache");
+  DCHECK(shared->is_toplevel());
+  DCHECK(!isolate->debug()->is_loaded());
+  i::HandleScope scope(isolate);
+  i::ScriptData* script_data = i::CodeSerializer::SerializeExecuted(
+      isolate, shared, Utils::OpenHandle(*source));
+  if (script_data == NULL) return NULL;
+  CachedData* result = new CachedData(
+      script_data->data(), script_data->length(), CachedData::BufferOwned);
+  script_data->ReleaseDataOwnership();
+  delete script_data;
+  return result;
+}
+
+
 MaybeLocal<Script> Script::Compile(Local<Context> context, Local<String> source,
                                    ScriptOrigin* origin) {
   if (origin) {
@@ -2769,6 +2985,80 @@ MaybeLocal<Value> JSON::Parse(Local<Context> context,
   RETURN_ESCAPED(result);
 }
 
+namespace {
+
+// Decodes the chunks of |source_stream| into a flat sequential string, which
+// stays one-byte unless a character needs two bytes.
+i::MaybeHandle<i::String> ReadStreamedJsonSource(
+    i::Isolate* isolate, ScriptCompiler::ExternalSourceStream* source_stream) {
+  i::ExternalStreamingStream stream(source_stream,
+                                    ScriptCompiler::StreamedSource::UTF8);
+  std::vector<uint8_t> one_byte_chars;
+  std::vector<i::uc16> two_byte_chars;
+  bool is_one_byte = true;
+  for (i::uc32 c = stream.Advance(); c >= 0; c = stream.Advance()) {
+    // Take the whole decoded block instead of going a character at a time.
+    stream.PushBack(c);
+    i::Vector<const uint16_t> block = stream.BufferedCodeUnits();
+    for (int i = 0; i < block.length(); i++) {
+      if (is_one_byte && block[i] > i::String::kMaxOneByteCharCode) {
+        two_byte_chars.assign(one_byte_chars.begin(), one_byte_chars.end());
+        std::vector<uint8_t>().swap(one_byte_chars);
+        is_one_byte = false;
+      }
+      if (is_one_byte) {
+        one_byte_chars.push_back(static_cast<uint8_t>(block[i]));
+      } else {
+        two_byte_chars.push_back(block[i]);
+      }
+    }
+    stream.SeekForward(block.length());
+  }
+
+  i::Factory* factory = isolate->factory();
+  size_t length = is_one_byte ? one_byte_chars.size() : two_byte_chars.size();
+  if (length > static_cast<size_t>(i::String::kMaxLength)) {
+    isolate->Throw(*factory->NewInvalidStringLengthError());
+    return i::MaybeHandle<i::String>();
+  }
+  int int_length = static_cast<int>(length);
+  if (is_one_byte) {
+    i::Handle<i::SeqOneByteString> result;
+    if (!factory->NewRawOneByteString(int_length).ToHandle(&result)) {
+      return i::MaybeHandle<i::String>();
+    }
+    i::DisallowHeapAllocation no_gc;
+    i::CopyChars(result->GetChars(), one_byte_chars.data(), length);
+    return result;
+  }
+  i::Handle<i::SeqTwoByteString> result;
+  if (!factory->NewRawTwoByteString(int_length).ToHandle(&result)) {
+    return i::MaybeHandle<i::String>();
+  }
+  i::DisallowHeapAllocation no_gc;
+  i::CopyChars(result->GetChars(), two_byte_chars.data(), length);
+  return result;
+}
+
+}  // namespace
+
+MaybeLocal<Value> JSON::ParseStreaming(
+    Local<Context> context,
+    ScriptCompiler::ExternalSourceStream* source_stream) {
+  PREPARE_FOR_EXECUTION(context, "JSON::ParseStreaming", Value);
+  i::Handle<i::String> source;
+  has_pending_exception =
+      !ReadStreamedJsonSource(isolate, source_stream).ToHandle(&source);
+  RETURN_ON_FAILED_EXECUTION(Value);
+  auto maybe = source->IsSeqOneByteString()
+                   ? i::JsonParser<true>::Parse(source)
+                   : i::JsonParser<false>::Parse(source);
+  Local<Value> result;
+  has_pending_exception = !ToLocal<Value>(maybe, &result);
+  RETURN_ON_FAILED_EXECUTION(Value);
+  RETURN_ESCAPED(result);
+}
+
 Local<Value> JSON::Parse(Local<String> json_string) {
   RETURN_TO_LOCAL_UNCHECKED(Parse(Local<Context>(), json_string), Value);
 }
@@ -2788,6 +3078,154 @@ MaybeLocal<String> JSON::Stringify(Local<Context> context,
   RETURN_ESCAPED(result);
 }
 
+// --- V a l u e   S e r i a l i z a t i o n ---
+
+Maybe<bool> ValueSerializer::Delegate::WriteHostObject(Isolate* v8_isolate,
+                                                       Local<Object> object) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(v8_isolate);
+  isolate->ScheduleThrow(*isolate->factory()->NewError(
+      isolate->error_function(), i::MessageTemplate::kDataCloneError,
+      Utils::OpenHandle(*object)));
+  return Nothing<bool>();
+}
+
+struct ValueSerializer::PrivateData {
+  explicit PrivateData(i::Isolate* i, ValueSerializer::Delegate* delegate)
+      : isolate(i), serializer(i, delegate) {}
+  i::Isolate* isolate;
+  i::ValueSerializer serializer;
+};
+
+ValueSerializer::ValueSerializer(Isolate* isolate)
+    : ValueSerializer(isolate, nullptr) {}
+
+ValueSerializer::ValueSerializer(Isolate* isolate, Delegate* delegate)
+    : private_(
+          new PrivateData(reinterpret_cast<i::Isolate*>(isolate), delegate)) {}
+
+ValueSerializer::~ValueSerializer() { delete private_; }
+
+void ValueSerializer::WriteHeader() { private_->serializer.WriteHeader(); }
+
+Maybe<bool> ValueSerializer::WriteValue(Local<Context> context,
+                                        Local<Value> value) {
+  PREPARE_FOR_EXECUTION_PRIMITIVE(context, "v8::ValueSerializer::WriteValue",
+                                  bool);
+  i::Handle<i::Object> object = Utils::OpenHandle(*value);
+  Maybe<bool> result = private_->serializer.WriteObject(object);
+  has_pending_exception = result.IsNothing();
+  RETURN_ON_FAILED_EXECUTION_PRIMITIVE(bool);
+  return result;
+}
+
+std::vector<uint8_t> ValueSerializer::ReleaseBuffer() {
+  return private_->serializer.ReleaseBuffer();
+}
+
+void ValueSerializer::TransferArrayBuffer(uint32_t transfer_id,
+                                          Local<ArrayBuffer> array_buffer) {
+  private_->serializer.TransferArrayBuffer(transfer_id,
+                                           Utils::OpenHandle(*array_buffer));
+}
+
+void ValueSerializer::WriteUint32(uint32_t value) {
+  private_->serializer.WriteUint32(value);
+}
+
+void ValueSerializer::WriteUint64(uint64_t value) {
+  private_->serializer.WriteUint64(value);
+}
+
+void ValueSerializer::WriteDouble(double value) {
+  private_->serializer.WriteDouble(value);
+}
+
+void ValueSerializer::WriteRawBytes(const void* source, size_t length) {
+  private_->serializer.WriteRawBytes(source, length);
+}
+
+MaybeLocal<Object> ValueDeserializer::Delegate::ReadHostObject(
+    Isolate* v8_isolate) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(v8_isolate);
+  isolate->ScheduleThrow(*isolate->factory()->NewError(
+      isolate->error_function(),
+      i::MessageTemplate::kDataCloneDeserializationError));
+  return MaybeLocal<Object>();
+}
+
+struct ValueDeserializer::PrivateData {
+  PrivateData(i::Isolate* i, i::Vector<const uint8_t> data, Delegate* delegate)
+      : isolate(i), deserializer(i, data, delegate) {}
+  i::Isolate* isolate;
+  i::ValueDeserializer deserializer;
+};
+
+ValueDeserializer::ValueDeserializer(Isolate* isolate, const uint8_t* data,
+                                     size_t size)
+    : ValueDeserializer(isolate, data, size, nullptr) {}
+
+ValueDeserializer::ValueDeserializer(Isolate* isolate, const uint8_t* data,
+                                     size_t size, Delegate* delegate) {
+  Utils::ApiCheck(size <= static_cast<size_t>(i::kMaxInt),
+                  "v8::ValueDeserializer::ValueDeserializer",
+                  "Serialized data is too large");
+  private_ = new PrivateData(
+      reinterpret_cast<i::Isolate*>(isolate),
+      i::Vector<const uint8_t>(data, static_cast<int>(size)), delegate);
+}
+
+ValueDeserializer::~ValueDeserializer() { delete private_; }
+
+Maybe<bool> ValueDeserializer::ReadHeader(Local<Context> context) {
+  PREPARE_FOR_EXECUTION_PRIMITIVE(context, "v8::ValueDeserializer::ReadHeader",
+                                  bool);
+  Maybe<bool> result = private_->deserializer.ReadHeader();
+  has_pending_exception = result.IsNothing();
+  RETURN_ON_FAILED_EXECUTION_PRIMITIVE(bool);
+  return result;
+}
+
+MaybeLocal<Value> ValueDeserializer::ReadValue(Local<Context> context) {
+  PREPARE_FOR_EXECUTION(context, "v8::ValueDeserializer::ReadValue", Value);
+  i::MaybeHandle<i::Object> maybe = private_->deserializer.ReadObject();
+  Local<Value> result;
+  has_pending_exception = !ToLocal<Value>(maybe, &result);
+  if (has_pending_exception && !isolate->has_pending_exception()) {
+    // Malformed data does not throw on its own.
+    isolate->Throw(*isolate->factory()->NewError(
+        isolate->error_function(),
+        i::MessageTemplate::kDataCloneDeserializationError));
+  }
+  RETURN_ON_FAILED_EXECUTION(Value);
+  RETURN_ESCAPED(result);
+}
+
+void ValueDeserializer::TransferArrayBuffer(uint32_t transfer_id,
+                                            Local<ArrayBuffer> array_buffer) {
+  private_->deserializer.TransferArrayBuffer(transfer_id,
+                                             Utils::OpenHandle(*array_buffer));
+}
+
+uint32_t ValueDeserializer::GetWireFormatVersion() const {
+  return private_->deserializer.GetWireFormatVersion();
+}
+
+bool ValueDeserializer::ReadUint32(uint32_t* value) {
+  return private_->deserializer.ReadUint32(value);
+}
+
+bool ValueDeserializer::ReadUint64(uint64_t* value) {
+  return private_->deserializer.ReadUint64(value);
+}
+
+bool ValueDeserializer::ReadDouble(double* value) {
+  return private_->deserializer.ReadDouble(value);
+}
+
+bool ValueDeserializer::ReadRawBytes(size_t length, const void** data) {
+  return private_->deserializer.ReadRawBytes(length, data);
+}
+
 // --- D a t a ---
 
 bool Value::FullIsUndefined() const {
@@ -4857,8 +5295,12 @@ class Utf8LengthHelper : public i::AllStatic {
 
     void VisitOneByteString(const uint8_t* chars, int length) {
       int utf8_length = 0;
-      // Add in length 1 for each non-Latin1 character.
-      for (int i = 0; i < length; i++) {
+      // Add in length 1 for each non-ASCII character, skipping the ASCII
+      // prefix a word at a time.
+      int i = i::String::NonAsciiStart(reinterpret_cast<const char*>(chars),
+                                       length);
+      chars += i;
+      for (; i < length; i++) {
         utf8_length += *chars++ >> 7;
       }
       // Add in length 1 for each character.
@@ -5116,9 +5558,18 @@ class Utf8WriterVisitor {
       }
       // Write the characters to the stream.
       if (sizeof(Char) == 1) {
-        for (; i < fast_length; i++) {
+        while (i < fast_length) {
+          // Copy runs of ASCII characters as they are.
+          int ascii_length = i::String::NonAsciiStart(
+              reinterpret_cast<const char*>(chars), fast_length - i);
+          i::MemCopy(buffer, chars, ascii_length);
+          buffer += ascii_length;
+          chars += ascii_length;
+          i += ascii_length;
+          if (i == fast_length) break;
           buffer += unibrow::Utf8::EncodeOneByte(
               buffer, static_cast<uint8_t>(*chars++));
+          i++;
           DCHECK(capacity_ == -1 || (buffer - start_) <= capacity_);
         }
       } else {
@@ -5554,7 +6005,18 @@ HeapStatistics::HeapStatistics()
       used_heap_size_(0),
       heap_size_limit_(0),
       malloced_memory_(0),
-      does_zap_garbage_(0) {}
+      does_zap_garbage_(0),
+      shared_live_heap_size_(0) {}
+
+ContextHeapStatistics::ContextHeapStatistics() : live_heap_size_(0) {}
+
+IdleGarbageCollectionResult::IdleGarbageCollectionResult()
+    : performed_scavenge_(false),
+      performed_marking_step_(false),
+      performed_marking_finalization_(false),
+      performed_sweeping_(false),
+      performed_full_gc_(false),
+      remaining_budget_in_microseconds_(0) {}
 
 HeapSpaceStatistics::HeapSpaceStatistics(): space_name_(0),
                                             space_size_(0),
@@ -5570,6 +6032,19 @@ HeapObjectStatistics::HeapObjectStatistics()
       object_size_(0) {}
 
 
+HeapCompositionStatistics::HeapCompositionStatistics()
+    : string_size_(0),
+      code_size_(0),
+      feedback_size_(0),
+      map_size_(0),
+      array_size_(0),
+      other_size_(0) {}
+
+
+RuntimeCallCounterStatistics::RuntimeCallCounterStatistics()
+    : counter_name_(nullptr), call_count_(0), time_in_ms_(0) {}
+
+
 bool v8::V8::InitializeICU(const char* icu_data_file) {
   return i::InitializeICU(icu_data_file);
 }
@@ -5594,7 +6069,8 @@ const char* v8::V8::GetVersion() {
 static i::Handle<i::Context> CreateEnvironment(
     i::Isolate* isolate, v8::ExtensionConfiguration* extensions,
     v8::Local<ObjectTemplate> global_template,
-    v8::Local<Value> maybe_global_proxy) {
+    v8::Local<Value> maybe_global_proxy, size_t context_snapshot_index,
+    v8::DeserializeInternalFieldsCallback internal_fields_deserializer) {
   i::Handle<i::Context> env;
 
   // Enter V8 via an ENTER_V8 scope.
@@ -5639,7 +6115,8 @@ static i::Handle<i::Context> CreateEnvironment(
     }
     // Create the environment.
     env = isolate->bootstrapper()->CreateEnvironment(
-        maybe_proxy, proxy_template, extensions);
+        maybe_proxy, proxy_template, extensions, i::FULL_CONTEXT,
+        context_snapshot_index, internal_fields_deserializer);
 
     // Restore the access check info on the global template.
     if (!global_template.IsEmpty()) {
@@ -5656,17 +6133,18 @@ static i::Handle<i::Context> CreateEnvironment(
   return env;
 }
 
-Local<Context> v8::Context::New(v8::Isolate* external_isolate,
-                                v8::ExtensionConfiguration* extensions,
-                                v8::Local<ObjectTemplate> global_template,
-                                v8::Local<Value> global_object) {
+static Local<Context> NewContext(
+    v8::Isolate* external_isolate, v8::ExtensionConfiguration* extensions,
+    v8::Local<ObjectTemplate> global_template,
+    v8::Local<Value> global_object, size_t context_snapshot_index,
+    v8::DeserializeInternalFieldsCallback internal_fields_deserializer) {
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(external_isolate);
-  LOG_API(isolate, "Context::New");
   i::HandleScope scope(isolate);
   ExtensionConfiguration no_extensions;
   if (extensions == NULL) extensions = &no_extensions;
   i::Handle<i::Context> env =
-      CreateEnvironment(isolate, extensions, global_template, global_object);
+      CreateEnvironment(isolate, extensions, global_template, global_object,
+                        context_snapshot_index, internal_fields_deserializer);
   if (env.is_null()) {
     if (isolate->has_pending_exception()) {
       isolate->OptionalRescheduleException(true);
@@ -5676,6 +6154,29 @@ Local<Context> v8::Context::New(v8::Isolate* external_isolate,
   return Utils::ToLocal(scope.CloseAndEscape(env));
 }
 
+Local<Context> v8::Context::New(v8::Isolate* external_isolate,
+                                v8::ExtensionConfiguration* extensions,
+                                v8::Local<ObjectTemplate> global_template,
+                                v8::Local<Value> global_object) {
+  LOG_API(reinterpret_cast<i::Isolate*>(external_isolate), "Context::New");
+  return NewContext(external_isolate, extensions, global_template,
+                    global_object, 0, NULL);
+}
+
+MaybeLocal<Context> v8::Context::FromSnapshot(
+    v8::Isolate* external_isolate, size_t context_snapshot_index,
+    v8::DeserializeInternalFieldsCallback internal_fields_deserializer,
+    v8::ExtensionConfiguration* extensions, v8::Local<Value> global_object) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(external_isolate);
+  LOG_API(isolate, "Context::FromSnapshot");
+  if (!i::Snapshot::HaveASnapshotToStartFrom(isolate)) {
+    return MaybeLocal<Context>();
+  }
+  return NewContext(external_isolate, extensions, Local<ObjectTemplate>(),
+                    global_object, context_snapshot_index,
+                    internal_fields_deserializer);
+}
+
 
 void v8::Context::SetSecurityToken(Local<Value> token) {
   i::Handle<i::Context> env = Utils::OpenHandle(this);
@@ -5763,6 +6264,16 @@ size_t Context::EstimatedSize() {
 }
 
 
+bool Context::GetHeapStatistics(ContextHeapStatistics* statistics) {
+  i::Handle<i::Context> context = Utils::OpenHandle(this);
+  int live_kilobytes =
+      context->native_context()->live_heap_kilobytes()->value();
+  if (live_kilobytes < 0) return false;
+  statistics->live_heap_size_ = static_cast<size_t>(live_kilobytes) * i::KB;
+  return true;
+}
+
+
 MaybeLocal<v8::Object> ObjectTemplate::NewInstance(Local<Context> context) {
   PREPARE_FOR_EXECUTION(context, "v8::ObjectTemplate::NewInstance()", Object);
   auto self = Utils::OpenHandle(this);
@@ -6013,6 +6524,38 @@ MaybeLocal<String> v8::String::NewExternalOneByte(
 }
 
 
+MaybeLocal<String> v8::String::NewExternalUtf8(
+    Isolate* isolate, v8::String::ExternalOneByteStringResource* resource) {
+  CHECK(resource && resource->data());
+  if (resource->length() > static_cast<size_t>(i::String::kMaxLength)) {
+    return MaybeLocal<String>();
+  }
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  ENTER_V8(i_isolate);
+  LOG_API(i_isolate, "String::NewExternalUtf8");
+  i::Handle<i::String> external = i_isolate->factory()
+                                      ->NewExternalStringFromOneByte(resource)
+                                      .ToHandleChecked();
+  i_isolate->heap()->RegisterExternalString(*external);
+  i::Vector<const char> data(resource->data(),
+                             static_cast<int>(resource->length()));
+  if (i::String::IsAscii(data.start(), data.length())) {
+    return Utils::ToLocal(external);
+  }
+  // The decoded string may be longer than allowed; the resource is disposed
+  // in either case.
+  i::MaybeHandle<i::String> maybe_string =
+      i_isolate->factory()->NewStringFromUtf8(data);
+  i_isolate->heap()->FinalizeExternalString(*external);
+  i::Handle<i::String> string;
+  if (!maybe_string.ToHandle(&string)) {
+    i_isolate->clear_pending_exception();
+    return MaybeLocal<String>();
+  }
+  return Utils::ToLocal(string);
+}
+
+
 Local<String> v8::String::NewExternal(
     Isolate* isolate, v8::String::ExternalOneByteStringResource* resource) {
   RETURN_TO_LOCAL_UNCHECKED(NewExternalOneByte(isolate, resource), String);
@@ -6095,6 +6638,58 @@ Local<v8::Object> v8::Object::New(Isolate* isolate) {
 }
 
 
+Local<v8::Object> v8::Object::New(Isolate* isolate,
+                                  Local<Value> prototype_or_null,
+                                  Local<Name>* names, Local<Value>* values,
+                                  size_t length) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  i::Handle<i::Object> proto = Utils::OpenHandle(*prototype_or_null);
+  if (!Utils::ApiCheck(proto->IsUndefined() || proto->IsNull() ||
+                           proto->IsJSReceiver(),
+                       "v8::Object::New", "Invalid prototype")) {
+    return Local<v8::Object>();
+  }
+  LOG_API(i_isolate, "Object::New");
+  ENTER_V8(i_isolate);
+  i::Handle<i::Map> map(i_isolate->object_function()->initial_map(),
+                        i_isolate);
+  if (!proto->IsUndefined()) {
+    map = i::Map::TransitionToPrototype(map, proto, i::REGULAR_PROTOTYPE);
+  }
+  i::Handle<i::JSObject> obj = i_isolate->factory()->NewJSObjectFromMap(map);
+  for (size_t i = 0; i < length; ++i) {
+    i::Handle<i::Name> name =
+        i_isolate->factory()->InternalizeName(Utils::OpenHandle(*names[i]));
+    i::Handle<i::Object> value = Utils::OpenHandle(*values[i]);
+    // Follow or create the map transition for a new named property and write
+    // the field directly. Indices, duplicate names and objects that have too
+    // many properties take the generic path.
+    uint32_t index;
+    map = i::handle(obj->map(), i_isolate);
+    if (!map->is_dictionary_map() && !name->AsArrayIndex(&index) &&
+        map->instance_descriptors()->SearchWithCache(i_isolate, *name, *map) ==
+            i::DescriptorArray::kNotFound) {
+      i::Handle<i::Map> transition = i::Map::TransitionToDataProperty(
+          map, name, value, i::NONE, i::Object::CERTAINLY_NOT_STORE_FROM_KEYED);
+      if (!transition->is_dictionary_map()) {
+        i::JSObject::MigrateToMap(obj, transition);
+        int descriptor = transition->LastAdded();
+        i::PropertyDetails details =
+            transition->instance_descriptors()->GetDetails(descriptor);
+        // Constant function properties live in the descriptor.
+        if (details.type() == i::DATA) {
+          obj->WriteToField(descriptor, details, *value);
+        }
+        continue;
+      }
+    }
+    i::JSObject::DefinePropertyOrElementIgnoreAttributes(obj, name, value)
+        .Check();
+  }
+  return Utils::ToLocal(obj);
+}
+
+
 Local<v8::Value> v8::NumberObject::New(Isolate* isolate, double value) {
   i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
   LOG_API(i_isolate, "NumberObject::New");
@@ -6217,6 +6812,7 @@ void v8::Date::DateTimeConfigurationChangeNotification(Isolate* isolate) {
   i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
   LOG_API(i_isolate, "Date::DateTimeConfigurationChangeNotification");
   ENTER_V8(i_isolate);
+  i::DateCache::ResetTimezoneTransitions();
   i_isolate->date_cache()->ResetDateCache();
   if (!i_isolate->eternal_handles()->Exists(
           i::EternalHandles::DATE_CACHE_VERSION)) {
@@ -6291,6 +6887,22 @@ Local<v8::Array> v8::Array::New(Isolate* isolate, int length) {
 }
 
 
+Local<v8::Array> v8::Array::New(Isolate* isolate, Local<Value>* elements,
+                                size_t length) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  i::Factory* factory = i_isolate->factory();
+  LOG_API(i_isolate, "Array::New");
+  ENTER_V8(i_isolate);
+  int len = static_cast<int>(length);
+  i::Handle<i::FixedArray> result = factory->NewFixedArray(len);
+  for (int i = 0; i < len; i++) {
+    result->set(i, *Utils::OpenHandle(*elements[i]));
+  }
+  return Utils::ToLocal(
+      factory->NewJSArrayWithElements(result, i::FAST_ELEMENTS, len));
+}
+
+
 uint32_t v8::Array::Length() const {
   i::Handle<i::JSArray> obj = Utils::OpenHandle(this);
   i::Object* length = obj->length();
@@ -6701,6 +7313,30 @@ bool v8::ArrayBuffer::IsNeuterable() const {
 }
 
 
+void* v8::ArrayBuffer::Allocator::Reserve(size_t length) { return nullptr; }
+
+
+void v8::ArrayBuffer::Allocator::Free(void* data, size_t length,
+                                      AllocationMode mode) {
+  switch (mode) {
+    case AllocationMode::kNormal:
+      Free(data, length);
+      return;
+    case AllocationMode::kReservation:
+      // Allocators without reservations never hand out reserved blocks.
+      UNREACHABLE();
+      return;
+  }
+  UNREACHABLE();
+}
+
+
+void v8::ArrayBuffer::Allocator::SetProtection(void* data, size_t length,
+                                               Protection protection) {
+  UNREACHABLE();
+}
+
+
 v8::ArrayBuffer::Contents v8::ArrayBuffer::Externalize() {
   i::Handle<i::JSArrayBuffer> self = Utils::OpenHandle(this);
   i::Isolate* isolate = self->GetIsolate();
@@ -7309,6 +7945,9 @@ Isolate* Isolate::New(const Isolate::CreateParams& params) {
   } else {
     isolate->set_snapshot_blob(i::Snapshot::DefaultSnapshotBlob());
   }
+  isolate->set_api_external_references(params.external_references);
+  CHECK_LE(0, params.max_background_tasks);
+  isolate->background_task_budget()->SetLimit(params.max_background_tasks);
   if (params.entry_hook) {
     isolate->set_function_entry_hook(params.entry_hook);
   }
@@ -7353,6 +7992,88 @@ Isolate* Isolate::New(const Isolate::CreateParams& params) {
 }
 
 
+namespace {
+
+class IsolatePoolData {
+ public:
+  IsolatePoolData(const Isolate::CreateParams& params, size_t size)
+      : params_(params), size_(size), pending_(0) {
+    base::LockGuard<base::Mutex> lock_guard(&mutex_);
+    for (size_t i = 0; i < size_; i++) ScheduleCreation();
+  }
+
+  ~IsolatePoolData() {
+    base::LockGuard<base::Mutex> lock_guard(&mutex_);
+    while (pending_ > 0) creation_done_.Wait(&mutex_);
+    for (Isolate* isolate : ready_) isolate->Dispose();
+  }
+
+  Isolate* Acquire() {
+    {
+      base::LockGuard<base::Mutex> lock_guard(&mutex_);
+      if (!ready_.empty()) {
+        Isolate* isolate = ready_.back();
+        ready_.pop_back();
+        ScheduleCreation();
+        return isolate;
+      }
+    }
+    return Isolate::New(params_);
+  }
+
+  static IsolatePoolData* cast(void* data) {
+    return reinterpret_cast<IsolatePoolData*>(data);
+  }
+
+ private:
+  class CreationTask : public Task {
+   public:
+    explicit CreationTask(IsolatePoolData* pool) : pool_(pool) {}
+
+    void Run() override {
+      Isolate* isolate = Isolate::New(pool_->params_);
+      // Worker threads of the platform outlive the isolate, so do not keep
+      // per-thread data for them around.
+      isolate->DiscardThreadSpecificMetadata();
+      base::LockGuard<base::Mutex> lock_guard(&pool_->mutex_);
+      pool_->ready_.push_back(isolate);
+      pool_->pending_--;
+      pool_->creation_done_.NotifyAll();
+    }
+
+   private:
+    IsolatePoolData* pool_;
+  };
+
+  // Must be called with {mutex_} held.
+  void ScheduleCreation() {
+    if (ready_.size() + pending_ >= size_) return;
+    pending_++;
+    i::V8::GetCurrentPlatform()->CallOnBackgroundThread(
+        new CreationTask(this), Platform::kShortRunningTask);
+  }
+
+  const Isolate::CreateParams params_;
+  const size_t size_;
+  base::Mutex mutex_;
+  base::ConditionVariable creation_done_;
+  std::vector<Isolate*> ready_;
+  // Number of isolates that are being created in the background.
+  size_t pending_;
+};
+
+}  // namespace
+
+IsolatePool::IsolatePool(const Isolate::CreateParams& params, size_t size) {
+  data_ = new IsolatePoolData(params, size);
+}
+
+IsolatePool::~IsolatePool() { delete IsolatePoolData::cast(data_); }
+
+Isolate* IsolatePool::Acquire() {
+  return IsolatePoolData::cast(data_)->Acquire();
+}
+
 void Isolate::Dispose() {
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
   if (!Utils::ApiCheck(!isolate->IsInUse(),
@@ -7457,6 +8178,7 @@ void Isolate::GetHeapStatistics(HeapStatistics* heap_statistics) {
   heap_statistics->malloced_memory_ =
       isolate->allocator()->GetCurrentMemoryUsage();
   heap_statistics->does_zap_garbage_ = heap->ShouldZapGarbage();
+  heap_statistics->shared_live_heap_size_ = heap->shared_live_heap_size();
 }
 
 
@@ -7494,10 +8216,10 @@ size_t Isolate::NumberOfTrackedHeapObjectTypes() {
 bool Isolate::GetHeapObjectStatisticsAtLastGC(
     HeapObjectStatistics* object_statistics, size_t type_index) {
   if (!object_statistics) return false;
-  if (!i::FLAG_track_gc_object_stats) return false;
 
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
   i::Heap* heap = isolate->heap();
+  if (!heap->object_stats_enabled()) return false;
   if (type_index >= heap->NumberOfTrackedHeapObjectTypes()) return false;
 
   const char* object_type;
@@ -7519,6 +8241,75 @@ bool Isolate::GetHeapObjectStatisticsAtLastGC(
 }
 
 
+void Isolate::SetHeapObjectStatisticsEnabled(bool enabled) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->heap()->set_object_stats_enabled(enabled);
+}
+
+
+bool Isolate::GetHeapCompositionStatisticsAtLastGC(
+    HeapCompositionStatistics* composition_statistics) {
+  if (!composition_statistics) return false;
+
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::Heap* heap = isolate->heap();
+  if (!heap->object_stats_enabled()) return false;
+
+  composition_statistics->string_size_ =
+      heap->ObjectCategorySizeAtLastGC(i::ObjectStats::STRING_CATEGORY);
+  composition_statistics->code_size_ =
+      heap->ObjectCategorySizeAtLastGC(i::ObjectStats::CODE_CATEGORY);
+  composition_statistics->feedback_size_ =
+      heap->ObjectCategorySizeAtLastGC(i::ObjectStats::FEEDBACK_CATEGORY);
+  composition_statistics->map_size_ =
+      heap->ObjectCategorySizeAtLastGC(i::ObjectStats::MAP_CATEGORY);
+  composition_statistics->array_size_ =
+      heap->ObjectCategorySizeAtLastGC(i::ObjectStats::ARRAY_CATEGORY);
+  composition_statistics->other_size_ =
+      heap->ObjectCategorySizeAtLastGC(i::ObjectStats::OTHER_CATEGORY);
+  return true;
+}
+
+
+size_t Isolate::NumberOfRuntimeCallCounters() {
+  return i::RuntimeCallStats::kNumberOfCounters;
+}
+
+
+bool Isolate::GetRuntimeCallCounterStatistics(
+    RuntimeCallCounterStatistics* counter_statistics, size_t index) {
+  if (!counter_statistics) return false;
+  if (index >= NumberOfRuntimeCallCounters()) return false;
+
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::RuntimeCallCounter* counter =
+      isolate->counters()->runtime_call_stats()->GetCounter(
+          static_cast<int>(index));
+  counter_statistics->counter_name_ = counter->name;
+  counter_statistics->call_count_ = counter->count;
+  counter_statistics->time_in_ms_ = counter->time.InMillisecondsF();
+  return true;
+}
+
+
+void Isolate::ResetRuntimeCallCounters() {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->counters()->runtime_call_stats()->Reset();
+}
+
+
+void Isolate::VisitBlockCoverage(BlockCoverageVisitor* visitor) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::BlockCoverage::Collect(isolate, visitor);
+}
+
+
+void Isolate::ResetBlockCoverage() {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::BlockCoverage::Reset(isolate);
+}
+
+
 void Isolate::GetStackSample(const RegisterState& state, void** frames,
                              size_t frames_limit, SampleInfo* sample_info) {
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
@@ -7582,6 +8373,12 @@ void Isolate::SetPromiseRejectCallback(PromiseRejectCallback callback) {
 }
 
 
+void Isolate::SetDeoptimizationCallback(DeoptimizationCallback callback) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->set_deoptimization_callback(callback);
+}
+
+
 void Isolate::RunMicrotasks() {
   DCHECK(MicrotasksPolicy::kScoped != GetMicrotasksPolicy());
   reinterpret_cast<i::Isolate*>(this)->RunMicrotasks();
@@ -7692,6 +8489,38 @@ bool Isolate::IdleNotificationDeadline(double deadline_in_seconds) {
 }
 
 
+bool Isolate::IdleNotificationBudget(int64_t budget_in_microseconds,
+                                     IdleGarbageCollectionResult* result,
+                                     double next_deadline_in_seconds) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::Heap* heap = isolate->heap();
+  double deadline_in_ms =
+      heap->MonotonicallyIncreasingTimeInMs() +
+      static_cast<double>(budget_in_microseconds) /
+          base::Time::kMicrosecondsPerMillisecond;
+  if (next_deadline_in_seconds > 0.0) {
+    deadline_in_ms = std::min(
+        deadline_in_ms,
+        next_deadline_in_seconds * base::Time::kMillisecondsPerSecond);
+  }
+  int work = i::Heap::kNoIdleWork;
+  bool done = true;
+  if (i::FLAG_use_idle_notification) {
+    done = heap->IdleNotificationBudget(deadline_in_ms, &work);
+  }
+  result->performed_scavenge_ = (work & i::Heap::kIdleScavenge) != 0;
+  result->performed_marking_step_ = (work & i::Heap::kIdleMarkingStep) != 0;
+  result->performed_marking_finalization_ =
+      (work & i::Heap::kIdleMarkingFinalization) != 0;
+  result->performed_sweeping_ = (work & i::Heap::kIdleSweeping) != 0;
+  result->performed_full_gc_ = (work & i::Heap::kIdleFullGC) != 0;
+  result->remaining_budget_in_microseconds_ = static_cast<int64_t>(
+      (deadline_in_ms - heap->MonotonicallyIncreasingTimeInMs()) *
+      base::Time::kMicrosecondsPerMillisecond);
+  return done;
+}
+
+
 void Isolate::LowMemoryNotification() {
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
   {
@@ -7700,6 +8529,7 @@ void Isolate::LowMemoryNotification() {
     TRACE_EVENT0("v8", "V8.GCLowMemoryNotification");
     isolate->heap()->CollectAllAvailableGarbage("low memory notification");
   }
+  isolate->allocator()->ReleasePool();
 }
 
 
@@ -7720,6 +8550,27 @@ void Isolate::IsolateInBackgroundNotification() {
   return isolate->heap()->SetOptimizeForMemoryUsage();
 }
 
+ScriptCompiler::CachedData* Isolate::CreateOptimizationProfile() {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::HandleScope scope(isolate);
+  std::vector<uint32_t> profile =
+      isolate->runtime_profiler()->CreateProfile();
+  int length = static_cast<int>(profile.size() * sizeof(uint32_t));
+  uint8_t* data = new uint8_t[length];
+  i::MemCopy(data, profile.data(), length);
+  return new ScriptCompiler::CachedData(
+      data, length, ScriptCompiler::CachedData::BufferOwned);
+}
+
+bool Isolate::SetOptimizationProfile(const uint8_t* data, int length) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  if (length < 0 || length % sizeof(uint32_t) != 0) return false;
+  std::vector<uint32_t> profile(length / sizeof(uint32_t));
+  i::MemCopy(profile.data(), data, length);
+  return isolate->runtime_profiler()->SetProfile(profile.data(),
+                                                 profile.size());
+}
+
 void Isolate::MemoryPressureNotification(MemoryPressureLevel level) {
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
   return isolate->heap()->MemoryPressureNotification(level,
@@ -7755,6 +8606,27 @@ void Isolate::GetCodeRange(void** start, size_t* length_in_bytes) {
 }
 
 
+void Isolate::SetNearHeapLimitCallback(NearHeapLimitCallback callback,
+                                       void* data) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->heap()->SetNearHeapLimitCallback(callback, data);
+}
+
+
+void Isolate::SetHeapLimits(const ResourceConstraints& constraints) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->heap()->SetMaxOldGenerationSize(
+      static_cast<intptr_t>(constraints.max_old_space_size()) * i::MB,
+      static_cast<intptr_t>(constraints.max_executable_size()) * i::MB);
+}
+
+
+void Isolate::SetContextHeapAccountingEnabled(bool enabled) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->heap()->set_context_heap_accounting_enabled(enabled);
+}
+
+
 void Isolate::SetFatalErrorHandler(FatalErrorCallback that) {
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
   isolate->set_exception_behavior(that);
@@ -8338,6 +9210,17 @@ void CpuProfiler::CollectSample() {
   reinterpret_cast<i::CpuProfiler*>(this)->CollectSample();
 }
 
+void CpuProfiler::StartContinuousProfiling(OutputStream* stream,
+                                           int interval_ms) {
+  DCHECK_GT(interval_ms, 0);
+  reinterpret_cast<i::CpuProfiler*>(this)->StartContinuousProfiling(
+      stream, base::TimeDelta::FromMilliseconds(interval_ms));
+}
+
+void CpuProfiler::StopContinuousProfiling() {
+  reinterpret_cast<i::CpuProfiler*>(this)->StopContinuousProfiling();
+}
+
 void CpuProfiler::StartProfiling(Local<String> title, bool record_samples) {
   reinterpret_cast<i::CpuProfiler*>(this)->StartProfiling(
       *Utils::OpenHandle(*title), record_samples);
@@ -8547,6 +9430,25 @@ const HeapSnapshot* HeapProfiler::TakeHeapSnapshot(
 }
 
 
+bool HeapProfiler::WriteHeapSnapshot(OutputStream* stream,
+                                     ActivityControl* control,
+                                     ObjectNameResolver* resolver) {
+  Utils::ApiCheck(stream->GetChunkSize() > 0,
+                  "v8::HeapProfiler::WriteHeapSnapshot",
+                  "Invalid stream chunk size");
+  i::HeapSnapshot* snapshot =
+      reinterpret_cast<i::HeapProfiler*>(this)->TakeSnapshot(control,
+                                                              resolver);
+  if (snapshot == NULL) return false;
+  {
+    i::HeapSnapshotJSONSerializer serializer(snapshot);
+    serializer.Serialize(stream);
+  }
+  snapshot->Delete();
+  return true;
+}
+
+
 void HeapProfiler::StartTrackingHeapObjects(bool track_allocations) {
   reinterpret_cast<i::HeapProfiler*>(this)->StartHeapObjectsTracking(
       track_allocations);
@@ -8566,9 +9468,10 @@ SnapshotObjectId HeapProfiler::GetHeapStats(OutputStream* stream,
 
 
 bool HeapProfiler::StartSamplingHeapProfiler(uint64_t sample_interval,
-                                             int stack_depth) {
-  return reinterpret_cast<i::HeapProfiler*>(this)
-      ->StartSamplingHeapProfiler(sample_interval, stack_depth);
+                                             int stack_depth,
+                                             SamplingFlags flags) {
+  return reinterpret_cast<i::HeapProfiler*>(this)->StartSamplingHeapProfiler(
+      sample_interval, stack_depth, flags);
 }
 
 
@@ -8678,7 +9581,13 @@ namespace internal {
 
 
 void HandleScopeImplementer::FreeThreadResources() {
-  Free();
+  DCHECK(blocks_.length() == 0);
+  DCHECK(entered_contexts_.length() == 0);
+  DCHECK(saved_contexts_.length() == 0);
+  DCHECK(call_depth_ == 0);
+  // Nothing here belongs to the thread anymore. The spare blocks and the list
+  // backing stores are kept for the next thread locking the isolate, which
+  // makes switching threads with v8::Locker cheaper.
 }
 
 
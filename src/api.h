@@ -450,7 +450,7 @@ class HandleScopeImplementer {
         blocks_(0),
         entered_contexts_(0),
         saved_contexts_(0),
-        spare_(NULL),
+        spare_block_count_(0),
         call_depth_(0),
         microtasks_depth_(0),
         microtasks_suppressions_(0),
@@ -461,7 +461,7 @@ class HandleScopeImplementer {
         last_handle_before_deferred_block_(NULL) { }
 
   ~HandleScopeImplementer() {
-    DeleteArray(spare_);
+    for (int i = 0; i < spare_block_count_; i++) DeleteArray(spare_blocks_[i]);
   }
 
   // Threading support for handle data.
@@ -523,10 +523,15 @@ class HandleScopeImplementer {
   inline List<internal::Object**>* blocks() { return &blocks_; }
   Isolate* isolate() const { return isolate_; }
 
+  // Keeps a few blocks around so that scopes which repeatedly grow and
+  // shrink across block boundaries do not allocate.
   void ReturnBlock(Object** block) {
     DCHECK(block != NULL);
-    if (spare_ != NULL) DeleteArray(spare_);
-    spare_ = block;
+    if (spare_block_count_ < kMaxSpareBlocks) {
+      spare_blocks_[spare_block_count_++] = block;
+    } else {
+      DeleteArray(block);
+    }
   }
 
  private:
@@ -534,25 +539,11 @@ class HandleScopeImplementer {
     blocks_.Initialize(0);
     entered_contexts_.Initialize(0);
     saved_contexts_.Initialize(0);
-    spare_ = NULL;
+    spare_block_count_ = 0;
     last_handle_before_deferred_block_ = NULL;
     call_depth_ = 0;
   }
 
-  void Free() {
-    DCHECK(blocks_.length() == 0);
-    DCHECK(entered_contexts_.length() == 0);
-    DCHECK(saved_contexts_.length() == 0);
-    blocks_.Free();
-    entered_contexts_.Free();
-    saved_contexts_.Free();
-    if (spare_ != NULL) {
-      DeleteArray(spare_);
-      spare_ = NULL;
-    }
-    DCHECK(call_depth_ == 0);
-  }
-
   void BeginDeferredScope();
   DeferredHandles* Detach(Object** prev_limit);
 
@@ -562,7 +553,9 @@ class HandleScopeImplementer {
   List<Context*> entered_contexts_;
   // Used as a stack to keep track of saved contexts.
   List<Context*> saved_contexts_;
-  Object** spare_;
+  static const int kMaxSpareBlocks = 4;
+  Object** spare_blocks_[kMaxSpareBlocks];
+  int spare_block_count_;
   int call_depth_;
   int microtasks_depth_;
   int microtasks_suppressions_;
@@ -637,11 +630,8 @@ Handle<Context> HandleScopeImplementer::LastEnteredContext() {
 
 // If there's a spare block, use it for growing the current scope.
 internal::Object** HandleScopeImplementer::GetSpareOrNewBlock() {
-  internal::Object** block = (spare_ != NULL) ?
-      spare_ :
-      NewArray<internal::Object*>(kHandleBlockSize);
-  spare_ = NULL;
-  return block;
+  if (spare_block_count_ > 0) return spare_blocks_[--spare_block_count_];
+  return NewArray<internal::Object*>(kHandleBlockSize);
 }
 
 
@@ -662,10 +652,7 @@ void HandleScopeImplementer::DeleteExtensions(internal::Object** prev_limit) {
 #ifdef ENABLE_HANDLE_ZAPPING
     internal::HandleScope::ZapRange(block_start, block_limit);
 #endif
-    if (spare_ != NULL) {
-      DeleteArray(spare_);
-    }
-    spare_ = block_start;
+    ReturnBlock(block_start);
   }
   DCHECK((blocks_.is_empty() && prev_limit == NULL) ||
          (!blocks_.is_empty() && prev_limit != NULL));
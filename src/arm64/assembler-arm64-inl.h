@@ -54,6 +54,16 @@ void RelocInfo::update_wasm_memory_reference(
                                    icache_flush_mode);
 }
 
+void RelocInfo::update_wasm_global_reference(
+    Address old_base, Address new_base, ICacheFlushMode icache_flush_mode) {
+  DCHECK(IsWasmGlobalReference(rmode_));
+  DCHECK(old_base <= wasm_global_reference());
+  Address updated_reference = new_base + (wasm_global_reference() - old_base);
+  DCHECK(new_base <= updated_reference);
+  Assembler::set_target_address_at(isolate_, pc_, host_, updated_reference,
+                                   icache_flush_mode);
+}
+
 inline int CPURegister::code() const {
   DCHECK(IsValid());
   return reg_code;
@@ -710,6 +720,11 @@ Address RelocInfo::wasm_memory_reference() {
   return Assembler::target_address_at(pc_, host_);
 }
 
+Address RelocInfo::wasm_global_reference() {
+  DCHECK(IsWasmGlobalReference(rmode_));
+  return Assembler::target_address_at(pc_, host_);
+}
+
 Address RelocInfo::target_address_address() {
   DCHECK(IsCodeTarget(rmode_) || IsRuntimeEntry(rmode_)
                               || rmode_ == EMBEDDED_OBJECT
@@ -61,6 +61,7 @@
 #include "src/runtime/runtime.h"
 #include "src/simulator.h"  // For flushing instruction cache.
 #include "src/snapshot/serializer-common.h"
+#include "src/third_party/fdlibm/fdlibm.h"
 #include "src/wasm/wasm-external-refs.h"
 
 #if V8_TARGET_ARCH_IA32
@@ -846,6 +847,8 @@ const char* RelocInfo::RelocModeName(RelocInfo::Mode rmode) {
       return "generator continuation";
     case WASM_MEMORY_REFERENCE:
       return "wasm memory reference";
+    case WASM_GLOBAL_REFERENCE:
+      return "wasm global value reference";
     case NUMBER_OF_MODES:
     case PC_JUMP:
       UNREACHABLE();
@@ -941,6 +944,7 @@ void RelocInfo::Verify(Isolate* isolate) {
     case DEBUG_BREAK_SLOT_AT_TAIL_CALL:
     case GENERATOR_CONTINUATION:
     case WASM_MEMORY_REFERENCE:
+    case WASM_GLOBAL_REFERENCE:
     case NONE32:
     case NONE64:
       break;
@@ -1626,6 +1630,24 @@ ExternalReference ExternalReference::math_log_double_function(
 }
 
 
+ExternalReference ExternalReference::fdlibm_sin_function(Isolate* isolate) {
+  return ExternalReference(
+      Redirect(isolate, FUNCTION_ADDR(fdlibm::sin), BUILTIN_FP_CALL));
+}
+
+
+ExternalReference ExternalReference::fdlibm_cos_function(Isolate* isolate) {
+  return ExternalReference(
+      Redirect(isolate, FUNCTION_ADDR(fdlibm::cos), BUILTIN_FP_CALL));
+}
+
+
+ExternalReference ExternalReference::fdlibm_tan_function(Isolate* isolate) {
+  return ExternalReference(
+      Redirect(isolate, FUNCTION_ADDR(fdlibm::tan), BUILTIN_FP_CALL));
+}
+
+
 ExternalReference ExternalReference::math_exp_constants(int constant_index) {
   DCHECK(math_exp_data_initialized);
   return ExternalReference(
@@ -387,6 +387,8 @@ class RelocInfo {
     CELL,
     // To relocate pointers into the wasm memory embedded in wasm code
     WASM_MEMORY_REFERENCE,
+    // To relocate pointers into the wasm globals embedded in wasm code
+    WASM_GLOBAL_REFERENCE,
 
     // Everything after runtime_entry (inclusive) is not GC'ed.
     RUNTIME_ENTRY,
@@ -430,7 +432,7 @@ class RelocInfo {
     FIRST_REAL_RELOC_MODE = CODE_TARGET,
     LAST_REAL_RELOC_MODE = VENEER_POOL,
     LAST_CODE_ENUM = DEBUGGER_STATEMENT,
-    LAST_GCED_ENUM = WASM_MEMORY_REFERENCE,
+    LAST_GCED_ENUM = WASM_GLOBAL_REFERENCE,
     FIRST_SHAREABLE_RELOC_MODE = CELL,
   };
 
@@ -521,6 +523,12 @@ class RelocInfo {
   static inline bool IsWasmMemoryReference(Mode mode) {
     return mode == WASM_MEMORY_REFERENCE;
   }
+  static inline bool IsWasmGlobalReference(Mode mode) {
+    return mode == WASM_GLOBAL_REFERENCE;
+  }
+  static inline bool IsWasmReference(Mode mode) {
+    return mode == WASM_MEMORY_REFERENCE || mode == WASM_GLOBAL_REFERENCE;
+  }
   static inline int ModeMask(Mode mode) { return 1 << mode; }
 
   // Accessors
@@ -585,6 +593,10 @@ class RelocInfo {
   INLINE(void update_wasm_memory_reference(
       Address old_base, Address new_base, size_t old_size, size_t new_size,
       ICacheFlushMode icache_flush_mode = SKIP_ICACHE_FLUSH));
+  INLINE(Address wasm_global_reference());
+  INLINE(void update_wasm_global_reference(
+      Address old_base, Address new_base,
+      ICacheFlushMode icache_flush_mode = SKIP_ICACHE_FLUSH));
   // Returns the address of the constant pool entry where the target address
   // is held.  This should only be called if IsInConstantPool returns true.
   INLINE(Address constant_pool_entry_address());
@@ -1028,6 +1040,11 @@ class ExternalReference BASE_EMBEDDED {
 
   static ExternalReference math_log_double_function(Isolate* isolate);
 
+  // The fdlibm functions that back Math.sin, Math.cos and Math.tan.
+  static ExternalReference fdlibm_sin_function(Isolate* isolate);
+  static ExternalReference fdlibm_cos_function(Isolate* isolate);
+  static ExternalReference fdlibm_tan_function(Isolate* isolate);
+
   static ExternalReference math_exp_constants(int constant_index);
   static ExternalReference math_exp_log_table();
 
@@ -12,12 +12,14 @@ namespace internal {
 
 class AstNumberingVisitor final : public AstVisitor {
  public:
-  AstNumberingVisitor(Isolate* isolate, Zone* zone)
+  AstNumberingVisitor(Isolate* isolate, Zone* zone, bool block_coverage)
       : AstVisitor(),
         isolate_(isolate),
         zone_(zone),
         next_id_(BailoutId::FirstUsable().ToInt()),
         yield_count_(0),
+        block_coverage_(block_coverage),
+        block_counter_count_(0),
         properties_(zone),
         slot_cache_(zone),
         dont_optimize_reason_(kNoReason) {
@@ -83,10 +85,18 @@ class AstNumberingVisitor final : public AstVisitor {
     yield_count_ += old_yield_count;
   }
 
+  // Counts a block that the BytecodeGenerator instruments for
+  // --block-coverage. The counter slots are reserved after all other slots.
+  void ReserveBlockCounter() {
+    if (block_coverage_) block_counter_count_++;
+  }
+
   Isolate* isolate_;
   Zone* zone_;
   int next_id_;
   int yield_count_;
+  bool block_coverage_;
+  int block_counter_count_;
   AstProperties properties_;
   // The slot cache allows us to reuse certain feedback vector slots.
   FeedbackVectorSlotCache slot_cache_;
@@ -296,6 +306,7 @@ void AstNumberingVisitor::VisitDoWhileStatement(DoWhileStatement* node) {
   IncrementNodeCount();
   DisableSelfOptimization();
   node->set_base_id(ReserveIdRange(DoWhileStatement::num_ids()));
+  ReserveBlockCounter();
   int old_yield_count = GetAndResetYieldCount();
   Visit(node->body());
   Visit(node->cond());
@@ -307,6 +318,7 @@ void AstNumberingVisitor::VisitWhileStatement(WhileStatement* node) {
   IncrementNodeCount();
   DisableSelfOptimization();
   node->set_base_id(ReserveIdRange(WhileStatement::num_ids()));
+  ReserveBlockCounter();
   int old_yield_count = GetAndResetYieldCount();
   Visit(node->cond());
   Visit(node->body());
@@ -317,6 +329,7 @@ void AstNumberingVisitor::VisitWhileStatement(WhileStatement* node) {
 void AstNumberingVisitor::VisitTryCatchStatement(TryCatchStatement* node) {
   IncrementNodeCount();
   DisableOptimization(kTryCatchStatement);
+  ReserveBlockCounter();
   Visit(node->try_block());
   Visit(node->catch_block());
 }
@@ -393,6 +406,7 @@ void AstNumberingVisitor::VisitForInStatement(ForInStatement* node) {
   IncrementNodeCount();
   DisableSelfOptimization();
   node->set_base_id(ReserveIdRange(ForInStatement::num_ids()));
+  ReserveBlockCounter();
   Visit(node->enumerable());  // Not part of loop.
   int old_yield_count = GetAndResetYieldCount();
   Visit(node->each());
@@ -406,6 +420,7 @@ void AstNumberingVisitor::VisitForOfStatement(ForOfStatement* node) {
   IncrementNodeCount();
   DisableCrankshaft(kForOfStatement);
   node->set_base_id(ReserveIdRange(ForOfStatement::num_ids()));
+  ReserveBlockCounter();
   Visit(node->assign_iterator());  // Not part of loop.
   int old_yield_count = GetAndResetYieldCount();
   Visit(node->next_result());
@@ -420,6 +435,8 @@ void AstNumberingVisitor::VisitForOfStatement(ForOfStatement* node) {
 void AstNumberingVisitor::VisitConditional(Conditional* node) {
   IncrementNodeCount();
   node->set_base_id(ReserveIdRange(Conditional::num_ids()));
+  ReserveBlockCounter();
+  ReserveBlockCounter();
   Visit(node->condition());
   Visit(node->then_expression());
   Visit(node->else_expression());
@@ -429,9 +446,11 @@ void AstNumberingVisitor::VisitConditional(Conditional* node) {
 void AstNumberingVisitor::VisitIfStatement(IfStatement* node) {
   IncrementNodeCount();
   node->set_base_id(ReserveIdRange(IfStatement::num_ids()));
+  ReserveBlockCounter();
   Visit(node->condition());
   Visit(node->then_statement());
   if (node->HasElseStatement()) {
+    ReserveBlockCounter();
     Visit(node->else_statement());
   }
 }
@@ -451,6 +470,7 @@ void AstNumberingVisitor::VisitSwitchStatement(SwitchStatement* node) {
 void AstNumberingVisitor::VisitCaseClause(CaseClause* node) {
   IncrementNodeCount();
   node->set_base_id(ReserveIdRange(CaseClause::num_ids()));
+  ReserveBlockCounter();
   if (!node->is_default()) Visit(node->label());
   VisitStatements(node->statements());
 }
@@ -460,6 +480,7 @@ void AstNumberingVisitor::VisitForStatement(ForStatement* node) {
   IncrementNodeCount();
   DisableSelfOptimization();
   node->set_base_id(ReserveIdRange(ForStatement::num_ids()));
+  ReserveBlockCounter();
   if (node->init() != NULL) Visit(node->init());  // Not part of loop.
   int old_yield_count = GetAndResetYieldCount();
   if (node->cond() != NULL) Visit(node->cond());
@@ -589,9 +610,18 @@ bool AstNumberingVisitor::Renumber(FunctionLiteral* node) {
     DisableCrankshaft(kRestParameter);
   }
 
+  // The first block counter counts the invocations of the function.
+  ReserveBlockCounter();
   VisitDeclarations(scope->declarations());
   VisitStatements(node->body());
 
+  if (block_counter_count_ > 0) {
+    FeedbackVectorSpec* spec = properties_.get_spec();
+    FeedbackVectorSlot first_slot = spec->AddCounterSlot();
+    for (int i = 1; i < block_counter_count_; i++) spec->AddCounterSlot();
+    node->set_block_counters(first_slot, block_counter_count_);
+  }
+
   node->set_ast_properties(&properties_);
   node->set_dont_optimize_reason(dont_optimize_reason());
   node->set_yield_count(yield_count_);
@@ -600,8 +630,8 @@ bool AstNumberingVisitor::Renumber(FunctionLiteral* node) {
 
 
 bool AstNumbering::Renumber(Isolate* isolate, Zone* zone,
-                            FunctionLiteral* function) {
-  AstNumberingVisitor visitor(isolate, zone);
+                            FunctionLiteral* function, bool block_coverage) {
+  AstNumberingVisitor visitor(isolate, zone, block_coverage);
   return visitor.Renumber(function);
 }
 }  // namespace internal
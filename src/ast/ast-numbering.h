@@ -16,8 +16,10 @@ class Zone;
 namespace AstNumbering {
 // Assign type feedback IDs and bailout IDs to an AST node tree.  For a
 // generator function, also annotate the function itself and any loops therein
-// with the number of contained yields.
-bool Renumber(Isolate* isolate, Zone* zone, FunctionLiteral* function);
+// with the number of contained yields. With |block_coverage|, also reserve
+// the feedback slots of the block counters, see FunctionLiteral.
+bool Renumber(Isolate* isolate, Zone* zone, FunctionLiteral* function,
+              bool block_coverage = false);
 }
 
 }  // namespace internal
@@ -94,6 +94,20 @@ void AstRawString::Internalize(Isolate* isolate) {
 }
 
 
+bool AstRawString::InternalizeIfPresent(Isolate* isolate) {
+  if (!string_.is_null()) return true;
+  if (literal_bytes_.length() == 0) {
+    string_ = isolate->factory()->empty_string();
+    return true;
+  }
+  AstRawStringInternalizationKey key(this);
+  String* string = StringTable::LookupKeyIfExists(isolate, &key);
+  if (string == NULL) return false;
+  string_ = handle(string, isolate);
+  return true;
+}
+
+
 bool AstRawString::AsArrayIndex(uint32_t* index) const {
   if (!string_.is_null())
     return string_->AsArrayIndex(index);
@@ -262,6 +276,15 @@ void AstValueFactory::Internalize(Isolate* isolate) {
     // Everything is already internalized.
     return;
   }
+  // Look up the strings the string table already holds first, so that the
+  // table grows at most once for the ones that have to be added.
+  int missing = 0;
+  for (HashMap::Entry* entry = string_table_.Start(); entry != NULL;
+       entry = string_table_.Next(entry)) {
+    AstRawString* string = reinterpret_cast<AstRawString*>(entry->key);
+    if (!string->InternalizeIfPresent(isolate)) missing++;
+  }
+  if (missing > 0) StringTable::EnsureCapacityForBulkInsert(isolate, missing);
   // Strings need to be internalized before values, because values refer to
   // strings.
   for (int i = 0; i < strings_.length(); ++i) {
@@ -74,6 +74,10 @@ class AstRawString final : public AstString {
 
   void Internalize(Isolate* isolate) override;
 
+  // Internalizes the string only if the string table already holds it.
+  // Returns whether the string is internalized.
+  bool InternalizeIfPresent(Isolate* isolate);
+
   bool AsArrayIndex(uint32_t* index) const;
 
   // The string is not null-terminated, use length() to find out the length.
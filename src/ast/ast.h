@@ -2694,6 +2694,18 @@ class FunctionLiteral final : public Expression {
   int yield_count() { return yield_count_; }
   void set_yield_count(int yield_count) { yield_count_ = yield_count; }
 
+  // The block counters of --block-coverage are |block_counter_count|
+  // consecutive feedback vector slots starting at |first_block_counter_slot|.
+  // The first one counts the invocations of the function.
+  FeedbackVectorSlot first_block_counter_slot() const {
+    return first_block_counter_slot_;
+  }
+  int block_counter_count() const { return block_counter_count_; }
+  void set_block_counters(FeedbackVectorSlot first_slot, int count) {
+    first_block_counter_slot_ = first_slot;
+    block_counter_count_ = count;
+  }
+
  protected:
   FunctionLiteral(Zone* zone, const AstString* name,
                   AstValueFactory* ast_value_factory, Scope* scope,
@@ -2714,7 +2726,8 @@ class FunctionLiteral final : public Expression {
         expected_property_count_(expected_property_count),
         parameter_count_(parameter_count),
         function_token_position_(RelocInfo::kNoPosition),
-        yield_count_(0) {
+        yield_count_(0),
+        block_counter_count_(0) {
     bitfield_ =
         IsDeclaration::encode(function_type == kDeclaration) |
         IsNamedExpression::encode(function_type == kNamedExpression) |
@@ -2756,6 +2769,8 @@ class FunctionLiteral final : public Expression {
   int parameter_count_;
   int function_token_position_;
   int yield_count_;
+  FeedbackVectorSlot first_block_counter_slot_;
+  int block_counter_count_;
 };
 
 
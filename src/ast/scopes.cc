@@ -22,8 +22,9 @@ namespace internal {
 //       use. Because a Variable holding a handle with the same location exists
 //       this is ensured.
 
-VariableMap::VariableMap(Zone* zone)
-    : ZoneHashMap(ZoneHashMap::PointersMatch, 8, ZoneAllocationPolicy(zone)),
+VariableMap::VariableMap(Zone* zone, uint32_t capacity)
+    : ZoneHashMap(ZoneHashMap::PointersMatch, capacity,
+                  ZoneAllocationPolicy(zone)),
       zone_(zone) {}
 VariableMap::~VariableMap() {}
 
@@ -58,8 +59,9 @@ Variable* VariableMap::Lookup(const AstRawString* name) {
 }
 
 
-SloppyBlockFunctionMap::SloppyBlockFunctionMap(Zone* zone)
-    : ZoneHashMap(ZoneHashMap::PointersMatch, 8, ZoneAllocationPolicy(zone)),
+SloppyBlockFunctionMap::SloppyBlockFunctionMap(Zone* zone, uint32_t capacity)
+    : ZoneHashMap(ZoneHashMap::PointersMatch, capacity,
+                  ZoneAllocationPolicy(zone)),
       zone_(zone) {}
 SloppyBlockFunctionMap::~SloppyBlockFunctionMap() {}
 
@@ -102,6 +104,36 @@ Scope::Scope(Zone* zone, Scope* outer_scope, ScopeType scope_type,
   DCHECK(scope_type == SCRIPT_SCOPE || outer_scope != NULL);
 }
 
+Scope::Scope(Zone* zone, Scope* outer_scope, ScopeType scope_type,
+             AstValueFactory* ast_value_factory, FunctionKind function_kind,
+             PreParsingTag tag)
+    : inner_scopes_(0, zone),
+      variables_(zone, 1),
+      temps_(0, zone),
+      params_(0, zone),
+      unresolved_(0, zone),
+      decls_(0, zone),
+      module_descriptor_(NULL),
+      sloppy_block_function_map_(zone, 1),
+      already_resolved_(false),
+      ast_value_factory_(ast_value_factory),
+      zone_(zone) {
+  SetDefaults(scope_type, outer_scope, Handle<ScopeInfo>::null(),
+              function_kind);
+  DCHECK(scope_type == SCRIPT_SCOPE || outer_scope != NULL);
+  scope_inside_with_ = is_with_scope() ||
+                       (outer_scope != NULL && outer_scope->scope_inside_with_);
+}
+
+// static
+Scope* Scope::NewForPreParsing(Zone* zone, Scope* outer_scope,
+                               ScopeType scope_type,
+                               AstValueFactory* value_factory,
+                               FunctionKind function_kind) {
+  return new (zone) Scope(zone, outer_scope, scope_type, value_factory,
+                          function_kind, kPreParsing);
+}
+
 Scope::Scope(Zone* zone, Scope* inner_scope, ScopeType scope_type,
              Handle<ScopeInfo> scope_info, AstValueFactory* value_factory)
     : inner_scopes_(4, zone),
@@ -18,7 +18,7 @@ class ParseInfo;
 // A hash map to support fast variable declaration and lookup.
 class VariableMap: public ZoneHashMap {
  public:
-  explicit VariableMap(Zone* zone);
+  explicit VariableMap(Zone* zone, uint32_t capacity = 8);
 
   virtual ~VariableMap();
 
@@ -60,7 +60,7 @@ class DynamicScopePart : public ZoneObject {
 // Sloppy block-scoped function declarations to var-bind
 class SloppyBlockFunctionMap : public ZoneHashMap {
  public:
-  explicit SloppyBlockFunctionMap(Zone* zone);
+  explicit SloppyBlockFunctionMap(Zone* zone, uint32_t capacity = 8);
 
   virtual ~SloppyBlockFunctionMap();
 
@@ -92,6 +92,16 @@ class Scope: public ZoneObject {
         AstValueFactory* value_factory,
         FunctionKind function_kind = kNormalFunction);
 
+  // Creates a scope for the preparser. Preparser scopes only collect the
+  // flags that end up in the preparse data or are needed for early errors,
+  // so they declare no variables, start out with empty lists and are not
+  // linked into the inner scopes of their outer scope. The full scope is
+  // built when the function is actually compiled.
+  static Scope* NewForPreParsing(Zone* zone, Scope* outer_scope,
+                                 ScopeType scope_type,
+                                 AstValueFactory* value_factory,
+                                 FunctionKind function_kind);
+
   // Compute top scope and allocate variables. For lazy compilation the top
   // scope only contains the single lazily compiled function, so this
   // doesn't re-allocate variables repeatedly.
@@ -778,6 +788,12 @@ class Scope: public ZoneObject {
   MUST_USE_RESULT
   bool AllocateVariables(ParseInfo* info, AstNodeFactory* factory);
 
+  // Construct a preparser scope, see NewForPreParsing.
+  enum PreParsingTag { kPreParsing };
+  Scope(Zone* zone, Scope* outer_scope, ScopeType scope_type,
+        AstValueFactory* value_factory, FunctionKind function_kind,
+        PreParsingTag tag);
+
   // Construct a scope based on the scope info.
   Scope(Zone* zone, Scope* inner_scope, ScopeType type,
         Handle<ScopeInfo> scope_info, AstValueFactory* value_factory);
@@ -4,13 +4,25 @@
 
 #include "src/background-parsing-task.h"
 #include "src/debug/debug.h"
+#include "src/tracing/trace-event.h"
 
 namespace v8 {
 namespace internal {
 
+size_t InMemorySourceStream::GetMoreData(const uint8_t** src) {
+  size_t length = Min(kChunkSize, length_ - position_);
+  if (length == 0) return 0;
+  uint8_t* chunk = new uint8_t[length];
+  MemCopy(chunk, data_ + position_, length);
+  position_ += length;
+  *src = chunk;
+  return length;
+}
+
+
 BackgroundParsingTask::BackgroundParsingTask(
     StreamedSource* source, ScriptCompiler::CompileOptions options,
-    int stack_size, Isolate* isolate)
+    int stack_size, Isolate* isolate, bool is_module)
     : source_(source), stack_size_(stack_size) {
   // We don't set the context to the CompilationInfo yet, because the background
   // thread cannot do anything with it anyway. We set it just before compilation
@@ -30,6 +42,7 @@ BackgroundParsingTask::BackgroundParsingTask(
   info->set_source_stream_encoding(source->encoding);
   info->set_hash_seed(isolate->heap()->HashSeed());
   info->set_global();
+  if (is_module) info->set_module();
   info->set_unicode_cache(&source_->unicode_cache);
   info->set_compile_options(options);
   // Parse eagerly with ignition since we will compile eagerly.
@@ -41,6 +54,9 @@ void BackgroundParsingTask::Run() {
   DisallowHeapAllocation no_allocation;
   DisallowHandleAllocation no_handles;
   DisallowHandleDereference no_deref;
+  // The isolate's RuntimeCallStats are not thread-safe, so background parses
+  // only show up as trace events.
+  TRACE_EVENT0("v8", "V8.ParseBackground");
 
   ScriptData* script_data = NULL;
   ScriptCompiler::CompileOptions options = source_->info->compile_options();
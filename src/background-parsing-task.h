@@ -14,6 +14,28 @@
 namespace v8 {
 namespace internal {
 
+// Feeds a source buffer owned by the embedder to the streaming scanner, which
+// expects to own the chunks it receives. Copying one chunk at a time keeps
+// the extra memory small for big scripts.
+class InMemorySourceStream : public ScriptCompiler::ExternalSourceStream {
+ public:
+  InMemorySourceStream(const uint8_t* data, size_t length)
+      : data_(data), length_(length), position_(0) {}
+
+  size_t GetMoreData(const uint8_t** src) override;
+
+ private:
+  // Even, so that two-byte characters are never split.
+  static const size_t kChunkSize = 64 * KB;
+
+  const uint8_t* data_;
+  size_t length_;
+  size_t position_;
+
+  DISALLOW_COPY_AND_ASSIGN(InMemorySourceStream);
+};
+
+
 // Internal representation of v8::ScriptCompiler::StreamedSource. Contains all
 // data which needs to be transmitted between threads for background parsing,
 // finalizing it on the main thread, and compiling on the main thread.
@@ -46,7 +68,7 @@ class BackgroundParsingTask : public ScriptCompiler::ScriptStreamingTask {
  public:
   BackgroundParsingTask(StreamedSource* source,
                         ScriptCompiler::CompileOptions options, int stack_size,
-                        Isolate* isolate);
+                        Isolate* isolate, bool is_module);
 
   virtual void Run();
 
@@ -0,0 +1,62 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/background-task-budget.h"
+
+#include "include/v8-platform.h"
+#include "src/base/logging.h"
+#include "src/utils.h"
+#include "src/v8.h"
+
+namespace v8 {
+namespace internal {
+
+BackgroundTaskBudget::BackgroundTaskBudget(int limit)
+    : limit_(limit), total_in_use_(0) {
+  DCHECK_LE(0, limit);
+  for (int i = 0; i < kNumberOfClients; i++) in_use_[i] = 0;
+}
+
+void BackgroundTaskBudget::SetLimit(int limit) {
+  DCHECK_LE(0, limit);
+  DCHECK_EQ(0, total_in_use_);
+  limit_ = limit;
+}
+
+int BackgroundTaskBudget::limit() const {
+  if (limit_ > 0) return limit_;
+  return Max(1, static_cast<int>(V8::GetCurrentPlatform()
+                                     ->NumberOfAvailableBackgroundThreads()));
+}
+
+int BackgroundTaskBudget::TryAcquire(Client client, int requested) {
+  DCHECK_LE(0, requested);
+  if (requested == 0) return 0;
+  const int limit = this->limit();
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  int available = limit - total_in_use_;
+  if (client == kCompiler) {
+    available = Min(available, Max(1, limit / 2) - in_use_[client]);
+  }
+  if (in_use_[client] == 0) available = Max(1, available);
+  const int granted = Max(0, Min(requested, available));
+  in_use_[client] += granted;
+  total_in_use_ += granted;
+  return granted;
+}
+
+void BackgroundTaskBudget::Release(Client client, int count) {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  DCHECK_LE(count, in_use_[client]);
+  in_use_[client] -= count;
+  total_in_use_ -= count;
+}
+
+int BackgroundTaskBudget::InUse(Client client) {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  return in_use_[client];
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,56 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_BACKGROUND_TASK_BUDGET_H_
+#define V8_BACKGROUND_TASK_BUDGET_H_
+
+#include "src/base/macros.h"
+#include "src/base/platform/mutex.h"
+
+namespace v8 {
+namespace internal {
+
+// Limits the number of background tasks that an isolate runs at the same
+// time, so that many isolates sharing the platform's worker threads do not
+// overwhelm them. Subsystems ask for slots before posting tasks and return
+// them once the tasks are done.
+//
+// The compiler is limited to half of the budget so that it cannot starve the
+// GC. Each client is always granted one slot if it holds none, so that work
+// is never stalled behind the tasks of the other client.
+class BackgroundTaskBudget {
+ public:
+  enum Client { kGC, kCompiler, kNumberOfClients };
+
+  // A {limit} of 0 uses the number of background threads of the platform.
+  explicit BackgroundTaskBudget(int limit = 0);
+
+  // Changes the limit. Must be called before any slot is acquired.
+  void SetLimit(int limit);
+
+  // The maximal number of background tasks of the isolate.
+  int limit() const;
+
+  // Grants up to {requested} slots to {client} and returns their number.
+  // Never blocks.
+  int TryAcquire(Client client, int requested);
+
+  // Returns {count} slots that {client} acquired before.
+  void Release(Client client, int count);
+
+  int InUse(Client client);
+
+ private:
+  int limit_;
+  int in_use_[kNumberOfClients];
+  int total_in_use_;
+  base::Mutex mutex_;
+
+  DISALLOW_COPY_AND_ASSIGN(BackgroundTaskBudget);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_BACKGROUND_TASK_BUDGET_H_
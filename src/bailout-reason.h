@@ -34,6 +34,7 @@ namespace internal {
     "Bad value context for arguments value")                                   \
   V(kBailedOutDueToDependencyChange, "Bailed out due to dependency change")    \
   V(kBailoutWasNotPrepared, "Bailout was not prepared")                        \
+  V(kBlockCoverage, "Block coverage needs code built from bytecode")           \
   V(kBothRegistersWereSmisInSelectNonSmi,                                      \
     "Both registers were smis in SelectNonSmi")                                \
   V(kClassLiteral, "Class literal")                                            \
@@ -10,24 +10,102 @@
 #include <malloc.h>  // NOLINT
 #endif
 
+#include "src/base/bits.h"
+
 namespace v8 {
 namespace base {
 
+AccountingAllocator::~AccountingAllocator() { ReleasePool(); }
+
 void* AccountingAllocator::Allocate(size_t bytes) {
-  void* memory = malloc(bytes);
-  if (memory) NoBarrier_AtomicIncrement(&current_memory_usage_, bytes);
+  void* memory = nullptr;
+  int index = PoolIndex(bytes);
+  if (index >= 0 && NoBarrier_Load(&current_pool_size_) > 0) {
+    LockGuard<Mutex> lock_guard(&pool_mutex_);
+    PooledBlock* block = pools_[index];
+    if (block != nullptr) {
+      pools_[index] = block->next;
+      NoBarrier_AtomicIncrement(&current_pool_size_,
+                                -static_cast<AtomicWord>(bytes));
+      memory = block;
+    }
+  }
+  if (memory == nullptr) memory = malloc(bytes);
+  if (memory) {
+    AtomicWord current =
+        NoBarrier_AtomicIncrement(&current_memory_usage_, bytes);
+    AtomicWord max = NoBarrier_Load(&max_memory_usage_);
+    while (current > max) {
+      AtomicWord previous =
+          NoBarrier_CompareAndSwap(&max_memory_usage_, max, current);
+      if (previous == max) break;
+      max = previous;
+    }
+  }
   return memory;
 }
 
 void AccountingAllocator::Free(void* memory, size_t bytes) {
-  free(memory);
   NoBarrier_AtomicIncrement(&current_memory_usage_,
                             -static_cast<AtomicWord>(bytes));
+  int index = PoolIndex(bytes);
+  if (index >= 0 && NoBarrier_Load(&max_pool_size_) > 0) {
+    LockGuard<Mutex> lock_guard(&pool_mutex_);
+    AtomicWord pool_size = NoBarrier_Load(&current_pool_size_);
+    if (pool_size + static_cast<AtomicWord>(bytes) <=
+        NoBarrier_Load(&max_pool_size_)) {
+      PooledBlock* block = reinterpret_cast<PooledBlock*>(memory);
+      block->next = pools_[index];
+      pools_[index] = block;
+      NoBarrier_Store(&current_pool_size_, pool_size + bytes);
+      return;
+    }
+  }
+  free(memory);
+}
+
+void AccountingAllocator::ConfigureSegmentPool(size_t max_pool_size) {
+  NoBarrier_Store(&max_pool_size_, max_pool_size);
+  if (max_pool_size == 0) ReleasePool();
+}
+
+void AccountingAllocator::ReleasePool() {
+  LockGuard<Mutex> lock_guard(&pool_mutex_);
+  for (int i = 0; i < kNumberOfPools; i++) {
+    PooledBlock* block = pools_[i];
+    while (block != nullptr) {
+      PooledBlock* next = block->next;
+      free(block);
+      block = next;
+    }
+    pools_[i] = nullptr;
+  }
+  NoBarrier_Store(&current_pool_size_, 0);
 }
 
 size_t AccountingAllocator::GetCurrentMemoryUsage() const {
   return NoBarrier_Load(&current_memory_usage_);
 }
 
+size_t AccountingAllocator::GetMaxMemoryUsage() const {
+  return NoBarrier_Load(&max_memory_usage_);
+}
+
+size_t AccountingAllocator::GetCurrentPoolSize() const {
+  return NoBarrier_Load(&current_pool_size_);
+}
+
+// static
+int AccountingAllocator::PoolIndex(size_t bytes) {
+  if (bytes < kMinPooledSize || bytes > kMaxPooledSize ||
+      !bits::IsPowerOfTwo64(bytes)) {
+    return -1;
+  }
+  int index = static_cast<int>(bits::CountTrailingZeros64(bytes) -
+                               bits::CountTrailingZeros64(kMinPooledSize));
+  DCHECK_LT(index, kNumberOfPools);
+  return index;
+}
+
 }  // namespace base
 }  // namespace v8
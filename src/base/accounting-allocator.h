@@ -7,23 +7,52 @@
 
 #include "src/base/atomicops.h"
 #include "src/base/macros.h"
+#include "src/base/platform/mutex.h"
 
 namespace v8 {
 namespace base {
 
 class AccountingAllocator final {
  public:
+  // Freed blocks whose size is a power of two in this range can be kept for
+  // reuse. Zones allocate their segments in these sizes.
+  static const size_t kMinPooledSize = 8 * 1024;
+  static const size_t kMaxPooledSize = 1024 * 1024;
+
   AccountingAllocator() = default;
-  ~AccountingAllocator() = default;
+  ~AccountingAllocator();
 
   // Returns nullptr on failed allocation.
   void* Allocate(size_t bytes);
   void Free(void* memory, size_t bytes);
 
+  // Sets how many bytes of freed blocks are kept for reuse. Zero, the
+  // default, disables the pool.
+  void ConfigureSegmentPool(size_t max_pool_size);
+  // Frees all blocks kept for reuse, e.g. under memory pressure.
+  void ReleasePool();
+
   size_t GetCurrentMemoryUsage() const;
+  size_t GetMaxMemoryUsage() const;
+  size_t GetCurrentPoolSize() const;
 
  private:
+  static const int kNumberOfPools = 8;
+
+  struct PooledBlock {
+    PooledBlock* next;
+  };
+
+  // Returns the pool for blocks of |bytes|, or -1 if they are not pooled.
+  static int PoolIndex(size_t bytes);
+
   AtomicWord current_memory_usage_ = 0;
+  AtomicWord max_memory_usage_ = 0;
+  AtomicWord current_pool_size_ = 0;
+  AtomicWord max_pool_size_ = 0;
+
+  Mutex pool_mutex_;
+  PooledBlock* pools_[kNumberOfPools] = {};
 
   DISALLOW_COPY_AND_ASSIGN(AccountingAllocator);
 };
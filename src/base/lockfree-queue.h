@@ -0,0 +1,168 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_BASE_LOCKFREE_QUEUE_H_
+#define V8_BASE_LOCKFREE_QUEUE_H_
+
+#include <stddef.h>
+
+#include <deque>
+
+#include "src/base/atomicops.h"
+#include "src/base/bits.h"
+#include "src/base/logging.h"
+#include "src/base/macros.h"
+#include "src/base/platform/mutex.h"
+
+namespace v8 {
+namespace base {
+
+// Unbounded multi-producer, multi-consumer queue for handing values off
+// between threads. The values are kept in a bounded ring buffer as described
+// in "Bounded MPMC queue" by D. Vyukov, see
+// http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+// As long as the queue holds no more than |capacity| values, Enqueue and
+// Dequeue are lock-free and do not allocate. Once the ring buffer is full,
+// further values go to a mutex-protected overflow list until it is drained.
+//
+// Values enqueued by one thread are dequeued in the order they were enqueued.
+// Record should be cheap to copy, e.g. a pointer. The queue does not destroy
+// values it still holds when it is destroyed.
+template <typename Record>
+class LockFreeQueue final {
+ public:
+  static const size_t kDefaultCapacity = 256;
+
+  explicit LockFreeQueue(size_t capacity = kDefaultCapacity)
+      : mask_(bits::RoundUpToPowerOfTwo32(
+                  static_cast<uint32_t>(capacity < 2 ? 2 : capacity)) -
+              1),
+        cells_(new Cell[mask_ + 1]),
+        overflow_length_(0) {
+    NoBarrier_Store(&enqueue_position_.value, 0);
+    NoBarrier_Store(&dequeue_position_.value, 0);
+    for (size_t i = 0; i <= mask_; i++) {
+      NoBarrier_Store(&cells_[i].sequence, static_cast<AtomicWord>(i));
+    }
+  }
+
+  ~LockFreeQueue() { delete[] cells_; }
+
+  void Enqueue(const Record& record) {
+    // Values only bypass the overflow list while it is empty, otherwise they
+    // could overtake values of the same producer.
+    if (Acquire_Load(&overflow_length_) == 0 && TryEnqueue(record)) return;
+    LockGuard<Mutex> guard(&overflow_mutex_);
+    overflow_.push_back(record);
+    Release_Store(&overflow_length_, static_cast<AtomicWord>(overflow_.size()));
+  }
+
+  // Returns false if the queue is empty, or if the oldest value is still being
+  // enqueued by another thread.
+  bool Dequeue(Record* record) {
+    if (TryDequeue(record)) return true;
+    if (Acquire_Load(&overflow_length_) == 0) return false;
+    // A value still being written to the ring buffer may have been enqueued
+    // before the overflowing ones by the same producer.
+    if (Acquire_Load(&enqueue_position_.value) !=
+        Acquire_Load(&dequeue_position_.value)) {
+      return false;
+    }
+    LockGuard<Mutex> guard(&overflow_mutex_);
+    if (overflow_.empty()) return false;
+    *record = overflow_.front();
+    overflow_.pop_front();
+    Release_Store(&overflow_length_, static_cast<AtomicWord>(overflow_.size()));
+    return true;
+  }
+
+  // The result may be outdated by the time it is returned if other threads
+  // use the queue concurrently.
+  bool IsEmpty() const {
+    return Acquire_Load(&enqueue_position_.value) ==
+               Acquire_Load(&dequeue_position_.value) &&
+           Acquire_Load(&overflow_length_) == 0;
+  }
+
+  size_t capacity() const { return mask_ + 1; }
+
+ private:
+  // A cell is written once its sequence equals the enqueue position, and read
+  // once it equals the dequeue position + 1.
+  struct Cell {
+    volatile AtomicWord sequence;
+    Record value;
+  };
+
+  // Keeps the positions that producers and consumers update out of each
+  // other's cache lines.
+  static const size_t kCacheLineSize = 64;
+  struct Position {
+    volatile AtomicWord value;
+    char padding[kCacheLineSize - sizeof(AtomicWord)];
+  };
+
+  bool TryEnqueue(const Record& record) {
+    AtomicWord position = NoBarrier_Load(&enqueue_position_.value);
+    Cell* cell;
+    for (;;) {
+      cell = &cells_[position & mask_];
+      AtomicWord diff = Acquire_Load(&cell->sequence) - position;
+      if (diff == 0) {
+        AtomicWord previous = NoBarrier_CompareAndSwap(
+            &enqueue_position_.value, position, position + 1);
+        if (previous == position) break;
+        position = previous;
+      } else if (diff < 0) {
+        // The cell still holds the value enqueued one round earlier.
+        return false;
+      } else {
+        position = NoBarrier_Load(&enqueue_position_.value);
+      }
+    }
+    cell->value = record;
+    Release_Store(&cell->sequence, position + 1);
+    return true;
+  }
+
+  bool TryDequeue(Record* record) {
+    AtomicWord position = NoBarrier_Load(&dequeue_position_.value);
+    Cell* cell;
+    for (;;) {
+      cell = &cells_[position & mask_];
+      AtomicWord diff = Acquire_Load(&cell->sequence) - (position + 1);
+      if (diff == 0) {
+        AtomicWord previous = NoBarrier_CompareAndSwap(
+            &dequeue_position_.value, position, position + 1);
+        if (previous == position) break;
+        position = previous;
+      } else if (diff < 0) {
+        // The cell has not been written yet.
+        return false;
+      } else {
+        position = NoBarrier_Load(&dequeue_position_.value);
+      }
+    }
+    *record = cell->value;
+    Release_Store(&cell->sequence,
+                  position + static_cast<AtomicWord>(mask_) + 1);
+    return true;
+  }
+
+  const size_t mask_;
+  Cell* const cells_;
+  Position enqueue_position_;
+  Position dequeue_position_;
+
+  volatile AtomicWord overflow_length_;
+  Mutex overflow_mutex_;
+  std::deque<Record> overflow_;
+
+  DISALLOW_COPY_AND_ASSIGN(LockFreeQueue);
+};
+
+}  // namespace base
+}  // namespace v8
+
+#endif  // V8_BASE_LOCKFREE_QUEUE_H_
@@ -6,6 +6,7 @@
 // parts, the implementation is in platform-posix.cc.
 
 #include <pthread.h>
+#include <sched.h>
 #include <semaphore.h>
 #include <signal.h>
 #include <stdio.h>
@@ -204,6 +205,109 @@ std::vector<OS::SharedLibraryAddress> OS::GetSharedLibraryAddresses() {
 }
 
 
+// NaCl gets the NUMA support stubs of platform-posix.cc.
+#if !V8_OS_NACL
+
+namespace {
+
+// Reads a sysfs list of ids like "0-3,8-11" into |ids|.
+bool ReadSysfsList(const char* path, cpu_set_t* ids) {
+  FILE* fp = fopen(path, "r");
+  if (fp == NULL) return false;
+  CPU_ZERO(ids);
+  bool found = false;
+  int first;
+  while (fscanf(fp, "%d", &first) == 1) {
+    int last = first;
+    int c = fgetc(fp);
+    if (c == '-') {
+      if (fscanf(fp, "%d", &last) != 1) break;
+      c = fgetc(fp);
+    }
+    for (int id = first; id <= last && id < CPU_SETSIZE; id++) {
+      CPU_SET(id, ids);
+      found = true;
+    }
+    if (c != ',') break;
+  }
+  fclose(fp);
+  return found;
+}
+
+}  // namespace
+
+
+int OS::GetNumaNodeCount() {
+  cpu_set_t nodes;
+  if (!ReadSysfsList("/sys/devices/system/node/online", &nodes)) return 1;
+  int count = 1;
+  for (int node = 0; node < CPU_SETSIZE; node++) {
+    if (CPU_ISSET(node, &nodes)) count = node + 1;
+  }
+  return count;
+}
+
+
+int OS::GetCurrentNumaNode() {
+#if defined(__NR_getcpu)
+  unsigned cpu, node;
+  if (syscall(__NR_getcpu, &cpu, &node, NULL) == 0) {
+    return static_cast<int>(node);
+  }
+#endif
+  return 0;
+}
+
+
+bool OS::SetCurrentThreadNumaNode(int node) {
+  if (node < 0) return false;
+  char path[64];
+  SNPrintF(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist",
+           node);
+  cpu_set_t cpus;
+  if (!ReadSysfsList(path, &cpus)) return false;
+  return sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+}
+
+
+bool OS::SetCurrentThreadAffinity(int cpu) {
+  if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(cpu, &cpus);
+  return sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+}
+
+
+bool OS::BindMemoryToNumaNode(void* address, size_t size, int node) {
+#if defined(__NR_mbind)
+  // MPOL_PREFERRED from <linux/mempolicy.h>, which falls back to other nodes
+  // when |node| runs out of memory.
+  const int kMpolPreferred = 1;
+  typedef unsigned long NodeMask;  // NOLINT(runtime/int)
+  const int kBitsPerNodeMask = static_cast<int>(sizeof(NodeMask) * 8);
+  if (node < 0 || node >= kBitsPerNodeMask) return false;
+  NodeMask node_mask = static_cast<NodeMask>(1) << node;
+  // The kernel expects the number of bits of the mask plus one.
+  return syscall(__NR_mbind, address, size, kMpolPreferred, &node_mask,
+                 kBitsPerNodeMask + 1, 0) == 0;
+#else
+  return false;
+#endif
+}
+
+#endif  // !V8_OS_NACL
+
+
+bool OS::AdviseHugePages(void* address, size_t size) {
+#if defined(MADV_HUGEPAGE)
+  return madvise(address, size, MADV_HUGEPAGE) == 0;
+#else
+  return false;
+#endif
+}
+
+
 void OS::SignalCodeMovingGC() {
   // Support for ll_prof.py.
   //
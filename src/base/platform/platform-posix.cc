@@ -288,14 +288,16 @@ class PosixMemoryMappedFile final : public OS::MemoryMappedFile {
 
 
 // static
-OS::MemoryMappedFile* OS::MemoryMappedFile::open(const char* name) {
-  if (FILE* file = fopen(name, "r+")) {
+OS::MemoryMappedFile* OS::MemoryMappedFile::open(const char* name,
+                                                 FileMode mode) {
+  const char* fopen_mode = (mode == FileMode::kReadOnly) ? "r" : "r+";
+  int prot = (mode == FileMode::kReadOnly) ? PROT_READ : PROT_READ | PROT_WRITE;
+  if (FILE* file = fopen(name, fopen_mode)) {
     if (fseek(file, 0, SEEK_END) == 0) {
       long size = ftell(file);  // NOLINT(runtime/int)
       if (size >= 0) {
-        void* const memory =
-            mmap(OS::GetRandomMmapAddr(), size, PROT_READ | PROT_WRITE,
-                 MAP_SHARED, fileno(file), 0);
+        void* const memory = mmap(OS::GetRandomMmapAddr(), size, prot,
+                                  MAP_SHARED, fileno(file), 0);
         if (memory != MAP_FAILED) {
           return new PosixMemoryMappedFile(file, memory, size);
         }
@@ -353,6 +355,31 @@ int OS::GetCurrentThreadId() {
 }
 
 
+#if !V8_OS_LINUX
+// NUMA, affinity and huge page support is only implemented in
+// platform-linux.cc.
+
+int OS::GetNumaNodeCount() { return 1; }
+
+
+int OS::GetCurrentNumaNode() { return 0; }
+
+
+bool OS::SetCurrentThreadNumaNode(int node) { return false; }
+
+
+bool OS::SetCurrentThreadAffinity(int cpu) { return false; }
+
+
+bool OS::BindMemoryToNumaNode(void* address, size_t size, int node) {
+  return false;
+}
+
+
+bool OS::AdviseHugePages(void* address, size_t size) { return false; }
+#endif  // !V8_OS_LINUX
+
+
 // ----------------------------------------------------------------------------
 // POSIX date/time support.
 //
@@ -549,6 +576,8 @@ class Thread::PlatformData {
 Thread::Thread(const Options& options)
     : data_(new PlatformData),
       stack_size_(options.stack_size()),
+      numa_node_(options.numa_node()),
+      cpu_(options.cpu()),
       start_semaphore_(NULL) {
   if (stack_size_ > 0 && static_cast<size_t>(stack_size_) < PTHREAD_STACK_MIN) {
     stack_size_ = PTHREAD_STACK_MIN;
@@ -596,6 +625,11 @@ static void* ThreadEntry(void* arg) {
   // one).
   { LockGuard<Mutex> lock_guard(&thread->data()->thread_creation_mutex_); }
   SetThreadName(thread->name());
+  if (thread->cpu() >= 0) {
+    OS::SetCurrentThreadAffinity(thread->cpu());
+  } else if (thread->numa_node() != OS::kNoNumaNode) {
+    OS::SetCurrentThreadNumaNode(thread->numa_node());
+  }
   DCHECK(thread->data()->thread_ != kNoThread);
   thread->NotifyStartedAndRun();
   return NULL;
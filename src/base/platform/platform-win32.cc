@@ -506,6 +506,26 @@ int OS::GetCurrentThreadId() {
 }
 
 
+int OS::GetNumaNodeCount() { return 1; }
+
+
+int OS::GetCurrentNumaNode() { return 0; }
+
+
+bool OS::SetCurrentThreadNumaNode(int node) { return false; }
+
+
+bool OS::SetCurrentThreadAffinity(int cpu) { return false; }
+
+
+bool OS::BindMemoryToNumaNode(void* address, size_t size, int node) {
+  return false;
+}
+
+
+bool OS::AdviseHugePages(void* address, size_t size) { return false; }
+
+
 // ----------------------------------------------------------------------------
 // Win32 console output.
 //
@@ -873,21 +893,27 @@ class Win32MemoryMappedFile final : public OS::MemoryMappedFile {
 
 
 // static
-OS::MemoryMappedFile* OS::MemoryMappedFile::open(const char* name) {
+OS::MemoryMappedFile* OS::MemoryMappedFile::open(const char* name,
+                                                 FileMode mode) {
+  bool read_only = mode == FileMode::kReadOnly;
+  DWORD access = read_only ? GENERIC_READ : GENERIC_READ | GENERIC_WRITE;
+  DWORD protection = read_only ? PAGE_READONLY : PAGE_READWRITE;
+  DWORD view_access = read_only ? FILE_MAP_READ : FILE_MAP_ALL_ACCESS;
+
   // Open a physical file
-  HANDLE file = CreateFileA(name, GENERIC_READ | GENERIC_WRITE,
-      FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, 0, NULL);
+  HANDLE file = CreateFileA(name, access, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                            NULL, OPEN_EXISTING, 0, NULL);
   if (file == INVALID_HANDLE_VALUE) return NULL;
 
   DWORD size = GetFileSize(file, NULL);
 
   // Create a file mapping for the physical file
   HANDLE file_mapping =
-      CreateFileMapping(file, NULL, PAGE_READWRITE, 0, size, NULL);
+      CreateFileMapping(file, NULL, protection, 0, size, NULL);
   if (file_mapping == NULL) return NULL;
 
   // Map a view of the file into memory
-  void* memory = MapViewOfFile(file_mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+  void* memory = MapViewOfFile(file_mapping, view_access, 0, 0, size);
   return new Win32MemoryMappedFile(file, file_mapping, memory, size);
 }
 
@@ -1332,6 +1358,8 @@ class Thread::PlatformData {
 
 Thread::Thread(const Options& options)
     : stack_size_(options.stack_size()),
+      numa_node_(options.numa_node()),
+      cpu_(options.cpu()),
       start_semaphore_(NULL) {
   data_ = new PlatformData(kNoThread);
   set_name(options.name());
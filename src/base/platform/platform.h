@@ -217,7 +217,12 @@ class OS {
     virtual void* memory() const = 0;
     virtual size_t size() const = 0;
 
-    static MemoryMappedFile* open(const char* name);
+    enum class FileMode { kReadOnly, kReadWrite };
+
+    // A read-only mapping is shared with other processes that map the same
+    // file, through the page cache.
+    static MemoryMappedFile* open(const char* name,
+                                  FileMode mode = FileMode::kReadWrite);
     static MemoryMappedFile* create(const char* name, size_t size,
                                     void* initial);
   };
@@ -264,6 +269,25 @@ class OS {
 
   static int GetCurrentThreadId();
 
+  // NUMA support. Where the OS provides no NUMA information, the machine is
+  // reported to have a single node 0 and the functions below fail.
+  static const int kNoNumaNode = -1;
+  static int GetNumaNodeCount();
+  // Returns the node of the CPU the calling thread currently runs on.
+  static int GetCurrentNumaNode();
+  // Restricts the calling thread to the CPUs of |node|.
+  static bool SetCurrentThreadNumaNode(int node);
+  // Restricts the calling thread to |cpu|.
+  static bool SetCurrentThreadAffinity(int cpu);
+  // Asks the OS to allocate the pages of [address, address + size) on
+  // |node|. Pages that are already populated are not moved.
+  static bool BindMemoryToNumaNode(void* address, size_t size, int node);
+
+  // Asks the OS to back [address, address + size) with transparent huge
+  // pages. Only committed memory can be advised, and committing a region
+  // again drops the advice.
+  static bool AdviseHugePages(void* address, size_t size);
+
  private:
   static const int msPerSecond = 1000;
 
@@ -395,16 +419,34 @@ class Thread {
 
   class Options {
    public:
-    Options() : name_("v8:<unknown>"), stack_size_(0) {}
+    Options()
+        : name_("v8:<unknown>"),
+          stack_size_(0),
+          numa_node_(OS::kNoNumaNode),
+          cpu_(-1) {}
     explicit Options(const char* name, int stack_size = 0)
-        : name_(name), stack_size_(stack_size) {}
+        : name_(name),
+          stack_size_(stack_size),
+          numa_node_(OS::kNoNumaNode),
+          cpu_(-1) {}
 
     const char* name() const { return name_; }
     int stack_size() const { return stack_size_; }
 
+    // The thread runs only on the CPUs of this NUMA node, if supported.
+    int numa_node() const { return numa_node_; }
+    void set_numa_node(int numa_node) { numa_node_ = numa_node; }
+
+    // The thread runs only on this CPU, if supported. Takes precedence over
+    // the NUMA node.
+    int cpu() const { return cpu_; }
+    void set_cpu(int cpu) { cpu_ = cpu; }
+
    private:
     const char* name_;
     int stack_size_;
+    int numa_node_;
+    int cpu_;
   };
 
   // Create new thread.
@@ -430,6 +472,9 @@ class Thread {
     return name_;
   }
 
+  int numa_node() const { return numa_node_; }
+  int cpu() const { return cpu_; }
+
   // Abstract method for run handler.
   virtual void Run() = 0;
 
@@ -480,6 +525,8 @@ class Thread {
 
   char name_[kMaxThreadNameLength];
   int stack_size_;
+  int numa_node_;
+  int cpu_;
   Semaphore* start_semaphore_;
 
   DISALLOW_COPY_AND_ASSIGN(Thread);
@@ -0,0 +1,101 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/block-coverage.h"
+
+#include "include/v8.h"
+#include "src/interpreter/bytecode-array-iterator.h"
+#include "src/isolate.h"
+#include "src/objects-inl.h"
+#include "src/type-feedback-vector-inl.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+// Returns the type feedback vector of a function compiled to bytecode, or
+// NULL.
+TypeFeedbackVector* CoveredFeedbackVector(SharedFunctionInfo* shared) {
+  if (!shared->is_compiled() || !shared->HasBytecodeArray()) return NULL;
+  TypeFeedbackVector* vector = shared->feedback_vector();
+  return vector->is_empty() ? NULL : vector;
+}
+
+bool IsUserScript(SharedFunctionInfo* shared) {
+  if (!shared->script()->IsScript()) return false;
+  return Script::cast(shared->script())->type() == Script::TYPE_NORMAL;
+}
+
+bool FindFirstCounterSlot(TypeFeedbackVector* vector,
+                          FeedbackVectorSlot* slot) {
+  TypeFeedbackMetadataIterator iter(vector->metadata());
+  while (iter.HasNext()) {
+    FeedbackVectorSlot current = iter.Next();
+    if (iter.kind() == FeedbackVectorSlotKind::COUNTER) {
+      *slot = current;
+      return true;
+    }
+  }
+  return false;
+}
+
+uint32_t GetCount(TypeFeedbackVector* vector, FeedbackVectorSlot slot) {
+  return static_cast<uint32_t>(Smi::cast(vector->Get(slot))->value());
+}
+
+}  // namespace
+
+
+void BlockCoverage::Collect(Isolate* isolate,
+                            v8::BlockCoverageVisitor* visitor) {
+  HandleScope scope(isolate);
+  SharedFunctionInfo::Iterator iterator(isolate);
+  while (SharedFunctionInfo* shared = iterator.Next()) {
+    if (!IsUserScript(shared)) continue;
+    int script_id = Script::cast(shared->script())->id();
+    if (!shared->is_compiled()) {
+      visitor->VisitFunction(script_id, shared->start_position(),
+                             shared->end_position(), 0);
+      continue;
+    }
+    TypeFeedbackVector* vector = CoveredFeedbackVector(shared);
+    FeedbackVectorSlot first_slot;
+    if (vector == NULL || !FindFirstCounterSlot(vector, &first_slot)) continue;
+    visitor->VisitFunction(script_id, shared->start_position(),
+                           shared->end_position(),
+                           GetCount(vector, first_slot));
+    interpreter::BytecodeArrayIterator bytecodes(
+        handle(shared->bytecode_array(), isolate));
+    for (; !bytecodes.done(); bytecodes.Advance()) {
+      if (bytecodes.current_bytecode() !=
+          interpreter::Bytecode::kIncBlockCounter) {
+        continue;
+      }
+      FeedbackVectorSlot slot(static_cast<int>(bytecodes.GetIndexOperand(0)));
+      if (slot == first_slot) continue;
+      visitor->VisitBlock(script_id,
+                          static_cast<int>(bytecodes.GetIndexOperand(1)),
+                          GetCount(vector, slot));
+    }
+  }
+}
+
+
+void BlockCoverage::Reset(Isolate* isolate) {
+  SharedFunctionInfo::Iterator iterator(isolate);
+  while (SharedFunctionInfo* shared = iterator.Next()) {
+    TypeFeedbackVector* vector = CoveredFeedbackVector(shared);
+    if (vector == NULL) continue;
+    TypeFeedbackMetadataIterator iter(vector->metadata());
+    while (iter.HasNext()) {
+      FeedbackVectorSlot slot = iter.Next();
+      if (iter.kind() != FeedbackVectorSlotKind::COUNTER) continue;
+      vector->Set(slot, Smi::FromInt(0), SKIP_WRITE_BARRIER);
+    }
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
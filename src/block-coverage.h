@@ -0,0 +1,36 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_BLOCK_COVERAGE_H_
+#define V8_BLOCK_COVERAGE_H_
+
+#include "src/allocation.h"
+
+namespace v8 {
+
+class BlockCoverageVisitor;
+
+namespace internal {
+
+class Isolate;
+
+// Reads the counters maintained with --block-coverage. The counters live in
+// the COUNTER slots of the type feedback vectors: the first counts the
+// invocations of the function, the others are incremented by the
+// IncBlockCounter bytecodes, whose operands name the slot and the source
+// position of the block.
+class BlockCoverage : public AllStatic {
+ public:
+  // Passes the counters of all functions of user scripts to |visitor|, which
+  // must not call into V8.
+  static void Collect(Isolate* isolate, v8::BlockCoverageVisitor* visitor);
+
+  // Sets all counters to zero.
+  static void Reset(Isolate* isolate);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_BLOCK_COVERAGE_H_
@@ -140,7 +140,8 @@ class Genesis BASE_EMBEDDED {
   Genesis(Isolate* isolate, MaybeHandle<JSGlobalProxy> maybe_global_proxy,
           v8::Local<v8::ObjectTemplate> global_proxy_template,
           v8::ExtensionConfiguration* extensions,
-          GlobalContextType context_type);
+          GlobalContextType context_type, size_t context_snapshot_index,
+          v8::DeserializeInternalFieldsCallback internal_fields_deserializer);
   ~Genesis() { }
 
   Isolate* isolate() const { return isolate_; }
@@ -186,6 +187,10 @@ class Genesis BASE_EMBEDDED {
   // passed through the API.  The global from the snapshot is detached from the
   // other objects in the snapshot.
   void HookUpGlobalObject(Handle<JSGlobalObject> global_object);
+  // For the contexts that the embedder added to the snapshot, the global
+  // object from the snapshot is kept, and the given global proxy is
+  // initialized to be its proxy.
+  void HookUpDeserializedGlobalProxy(Handle<JSGlobalProxy> global_proxy);
   // The native context has a ScriptContextTable that store declarative bindings
   // made in script scopes.  Add a "this" binding to that table pointing to the
   // global proxy.
@@ -323,10 +328,13 @@ void Bootstrapper::Iterate(ObjectVisitor* v) {
 Handle<Context> Bootstrapper::CreateEnvironment(
     MaybeHandle<JSGlobalProxy> maybe_global_proxy,
     v8::Local<v8::ObjectTemplate> global_proxy_template,
-    v8::ExtensionConfiguration* extensions, GlobalContextType context_type) {
+    v8::ExtensionConfiguration* extensions, GlobalContextType context_type,
+    size_t context_snapshot_index,
+    v8::DeserializeInternalFieldsCallback internal_fields_deserializer) {
   HandleScope scope(isolate_);
   Genesis genesis(isolate_, maybe_global_proxy, global_proxy_template,
-                  extensions, context_type);
+                  extensions, context_type, context_snapshot_index,
+                  internal_fields_deserializer);
   Handle<Context> env = genesis.result();
   if (env.is_null() ||
       (context_type != THIN_CONTEXT && !InstallExtensions(env, extensions))) {
@@ -994,6 +1002,7 @@ Handle<JSGlobalObject> Genesis::CreateNewGlobals(
   // Return the global proxy.
 
   factory()->ReinitializeJSGlobalProxy(global_proxy, global_proxy_function);
+  native_context()->set_global_proxy_function(*global_proxy_function);
   return global_object;
 }
 
@@ -1012,6 +1021,21 @@ void Genesis::HookUpGlobalProxy(Handle<JSGlobalObject> global_object,
 }
 
 
+void Genesis::HookUpDeserializedGlobalProxy(
+    Handle<JSGlobalProxy> global_proxy) {
+  // Re-initialize the global proxy with the global proxy function from the
+  // snapshot, and then set up the link to the native context.
+  Handle<JSFunction> global_proxy_function(
+      native_context()->global_proxy_function());
+  factory()->ReinitializeJSGlobalProxy(global_proxy, global_proxy_function);
+  Handle<JSObject> global_object(
+      JSObject::cast(native_context()->global_object()));
+  SetObjectPrototype(global_proxy, global_object);
+  global_proxy->set_native_context(*native_context());
+  DCHECK(native_context()->global_proxy() == *global_proxy);
+}
+
+
 void Genesis::HookUpGlobalObject(Handle<JSGlobalObject> global_object) {
   Handle<JSGlobalObject> global_object_from_snapshot(
       JSGlobalObject::cast(native_context()->extension()));
@@ -1628,19 +1652,35 @@ void Genesis::InitializeGlobal(Handle<JSGlobalObject> global_object,
   }
 
   {  // -- M a p
-    Handle<JSFunction> js_map_fun = InstallFunction(
-        global, "Map", JS_MAP_TYPE, JSMap::kSize,
-        isolate->initial_object_prototype(), Builtins::kIllegal);
+    Handle<JSObject> prototype =
+        factory->NewJSObject(isolate->object_function(), TENURED);
+    Handle<JSFunction> js_map_fun =
+        InstallFunction(global, "Map", JS_MAP_TYPE, JSMap::kSize, prototype,
+                        Builtins::kIllegal);
     InstallWithIntrinsicDefaultProto(isolate, js_map_fun,
                                      Context::JS_MAP_FUN_INDEX);
+
+    // Install the lookup functions; the rest of Map.prototype is set up in
+    // collection.js.
+    SimpleInstallFunction(prototype, "get", Builtins::kMapPrototypeGet, 1,
+                          true);
+    SimpleInstallFunction(prototype, "has", Builtins::kMapPrototypeHas, 1,
+                          true);
   }
 
   {  // -- S e t
-    Handle<JSFunction> js_set_fun = InstallFunction(
-        global, "Set", JS_SET_TYPE, JSSet::kSize,
-        isolate->initial_object_prototype(), Builtins::kIllegal);
+    Handle<JSObject> prototype =
+        factory->NewJSObject(isolate->object_function(), TENURED);
+    Handle<JSFunction> js_set_fun =
+        InstallFunction(global, "Set", JS_SET_TYPE, JSSet::kSize, prototype,
+                        Builtins::kIllegal);
     InstallWithIntrinsicDefaultProto(isolate, js_set_fun,
                                      Context::JS_SET_FUN_INDEX);
+
+    // Install the lookup function; the rest of Set.prototype is set up in
+    // collection.js.
+    SimpleInstallFunction(prototype, "has", Builtins::kSetPrototypeHas, 1,
+                          true);
   }
 
   {  // -- I t e r a t o r R e s u l t
@@ -2729,6 +2769,8 @@ bool Genesis::InstallNatives(GlobalContextType context_type) {
       isolate(), ApiNatives::kInitialFunctionCacheSize);
   native_context()->set_template_instantiations_cache(
       *template_instantiations_cache);
+  native_context()->set_fast_template_instantiations_cache(
+      isolate()->heap()->empty_fixed_array());
 
   // Store the map for the %ObjectPrototype% after the natives has been compiled
   // and the Object function has been set up.
@@ -3550,7 +3592,9 @@ Genesis::Genesis(Isolate* isolate,
                  MaybeHandle<JSGlobalProxy> maybe_global_proxy,
                  v8::Local<v8::ObjectTemplate> global_proxy_template,
                  v8::ExtensionConfiguration* extensions,
-                 GlobalContextType context_type)
+                 GlobalContextType context_type, size_t context_snapshot_index,
+                 v8::DeserializeInternalFieldsCallback
+                     internal_fields_deserializer)
     : isolate_(isolate), active_(isolate->bootstrapper()) {
   NoTrackDoubleFieldsForSerializerScope disable_scope(isolate);
   result_ = Handle<Context>::null();
@@ -3579,10 +3623,14 @@ Genesis::Genesis(Isolate* isolate,
   // a snapshot. Otherwise we have to build the context from scratch.
   // Also create a context from scratch to expose natives, if required by flag.
   if (!isolate->initialized_from_snapshot() ||
-      !Snapshot::NewContextFromSnapshot(isolate, global_proxy)
+      !Snapshot::NewContextFromSnapshot(isolate, global_proxy,
+                                        context_snapshot_index,
+                                        internal_fields_deserializer)
            .ToHandle(&native_context_)) {
     native_context_ = Handle<Context>();
   }
+  // Only the default context can be created from scratch.
+  if (native_context().is_null() && context_snapshot_index != 0) return;
 
   if (!native_context().is_null()) {
     AddToWeakNativeContextList(*native_context());
@@ -3597,13 +3645,19 @@ Genesis::Genesis(Isolate* isolate,
       Map::TraceAllTransitions(object_fun->initial_map());
     }
 #endif
-    Handle<JSGlobalObject> global_object =
-        CreateNewGlobals(global_proxy_template, global_proxy);
+    if (context_snapshot_index == 0) {
+      Handle<JSGlobalObject> global_object =
+          CreateNewGlobals(global_proxy_template, global_proxy);
 
-    HookUpGlobalProxy(global_object, global_proxy);
-    HookUpGlobalObject(global_object);
+      HookUpGlobalProxy(global_object, global_proxy);
+      HookUpGlobalObject(global_object);
 
-    if (!ConfigureGlobalObjects(global_proxy_template)) return;
+      if (!ConfigureGlobalObjects(global_proxy_template)) return;
+    } else {
+      // The global object, including what the embedder installed on it, was
+      // deserialized, only the global proxy has to be hooked up.
+      HookUpDeserializedGlobalProxy(global_proxy);
+    }
   } else {
     // We get here if there was no context snapshot.
     CreateRoots();
@@ -76,11 +76,17 @@ class Bootstrapper final {
 
   // Creates a JavaScript Global Context with initial object graph.
   // The returned value is a global handle casted to V8Environment*.
+  // A context snapshot index other than 0 selects a context that the
+  // embedder added to the snapshot; its global object is deserialized
+  // instead of being created from {global_object_template}.
   Handle<Context> CreateEnvironment(
       MaybeHandle<JSGlobalProxy> maybe_global_proxy,
       v8::Local<v8::ObjectTemplate> global_object_template,
       v8::ExtensionConfiguration* extensions,
-      GlobalContextType context_type = FULL_CONTEXT);
+      GlobalContextType context_type = FULL_CONTEXT,
+      size_t context_snapshot_index = 0,
+      v8::DeserializeInternalFieldsCallback internal_fields_deserializer =
+          NULL);
 
   // Detach the environment from its outer global object.
   void DetachGlobal(Handle<Context> env);
@@ -608,7 +608,10 @@ RUNTIME_FUNCTION(Runtime_ArrayPush) {
   return DoArrayPush(isolate, caller_args);
 }
 
-BUILTIN(ArrayPop) {
+namespace {
+
+Object* DoArrayPop(Isolate* isolate,
+                   BuiltinArguments<BuiltinExtraArguments::kNone> args) {
   HandleScope scope(isolate);
   Handle<Object> receiver = args.receiver();
   if (!EnsureJSArrayWithWritableFastElements(isolate, receiver, nullptr, 0)) {
@@ -638,8 +641,8 @@ BUILTIN(ArrayPop) {
   return *result;
 }
 
-
-BUILTIN(ArrayShift) {
+Object* DoArrayShift(Isolate* isolate,
+                     BuiltinArguments<BuiltinExtraArguments::kNone> args) {
   HandleScope scope(isolate);
   Heap* heap = isolate->heap();
   Handle<Object> receiver = args.receiver();
@@ -660,6 +663,184 @@ BUILTIN(ArrayShift) {
   return *first;
 }
 
+// Loads the elements of {receiver} if it is a JSArray whose map is the
+// initial array map for a fast Smi or object elements kind, and whose backing
+// store is writable; jumps to {if_slow} otherwise. Arrays with additional
+// properties, a read-only length or another prototype never have the initial
+// map.
+compiler::Node* LoadWritableFastArrayElements(
+    CodeStubAssembler* assembler, compiler::Node* receiver,
+    compiler::Node* context, CodeStubAssembler::Label* if_slow) {
+  typedef compiler::Node Node;
+
+  assembler->GotoIf(assembler->WordIsSmi(receiver), if_slow);
+  Node* map = assembler->LoadMap(receiver);
+  Node* kind = assembler->BitFieldDecode<Map::ElementsKindBits>(
+      assembler->LoadMapBitField2(map));
+  assembler->GotoUnless(
+      assembler->Int32LessThanOrEqual(
+          kind, assembler->Int32Constant(FAST_HOLEY_ELEMENTS)),
+      if_slow);
+
+  Node* native_context = assembler->LoadFixedArrayElementConstantIndex(
+      context, Context::NATIVE_CONTEXT_INDEX);
+  Node* initial_map = assembler->LoadFixedArrayElementInt32Index(
+      native_context, kind, Context::FIRST_JS_ARRAY_MAP_SLOT * kPointerSize);
+  assembler->GotoUnless(assembler->WordEqual(map, initial_map), if_slow);
+
+  // Copy-on-write backing stores are copied by the runtime.
+  Node* elements = assembler->LoadElements(receiver);
+  assembler->GotoUnless(
+      assembler->WordEqual(assembler->LoadMap(elements),
+                           assembler->LoadRoot(Heap::kFixedArrayMapRootIndex)),
+      if_slow);
+  return elements;
+}
+
+}  // namespace
+
+// TODO(verwaest): This is a temporary helper until the ArrayPrototypePop and
+// ArrayPrototypeShift builtins can tailcall to the C++ code directly.
+RUNTIME_FUNCTION(Runtime_ArrayPop) {
+  DCHECK_EQ(1, args.length());
+  BuiltinArguments<BuiltinExtraArguments::kNone> caller_args(1,
+                                                             args.arguments());
+  return DoArrayPop(isolate, caller_args);
+}
+
+RUNTIME_FUNCTION(Runtime_ArrayShift) {
+  DCHECK_EQ(1, args.length());
+  BuiltinArguments<BuiltinExtraArguments::kNone> caller_args(1,
+                                                             args.arguments());
+  return DoArrayShift(isolate, caller_args);
+}
+
+// ES6 section 22.1.3.17 Array.prototype.pop ( )
+void Builtins::Generate_ArrayPrototypePop(CodeStubAssembler* assembler) {
+  typedef compiler::Node Node;
+  typedef CodeStubAssembler::Label Label;
+
+  Node* receiver = assembler->Parameter(0);
+  Node* context = assembler->Parameter(3);
+
+  Label call_runtime(assembler, Label::kDeferred), return_undefined(assembler);
+
+  Node* elements = LoadWritableFastArrayElements(assembler, receiver, context,
+                                                 &call_runtime);
+  Node* length = assembler->LoadObjectField(receiver, JSArray::kLengthOffset);
+  assembler->GotoIf(
+      assembler->SmiEqual(length, assembler->SmiConstant(Smi::FromInt(0))),
+      &return_undefined);
+
+  // Leave it to the runtime to trim backing stores that become mostly empty.
+  Node* new_length =
+      assembler->SmiSub(length, assembler->SmiConstant(Smi::FromInt(1)));
+  Node* capacity = assembler->LoadFixedArrayBaseLength(elements);
+  assembler->GotoIf(assembler->SmiLessThanOrEqual(
+                        assembler->SmiAdd(new_length, new_length), capacity),
+                    &call_runtime);
+
+  // Holes have to be looked up on the prototype chain.
+  Node* the_hole = assembler->LoadRoot(Heap::kTheHoleValueRootIndex);
+  Node* result = assembler->LoadFixedArrayElementSmiIndex(elements, new_length);
+  assembler->GotoIf(assembler->WordEqual(result, the_hole), &call_runtime);
+
+  assembler->StoreFixedArrayElementNoWriteBarrier(
+      elements, assembler->SmiUntag(new_length), the_hole);
+  assembler->StoreObjectFieldNoWriteBarrier(receiver, JSArray::kLengthOffset,
+                                            new_length);
+  assembler->Return(result);
+
+  assembler->Bind(&return_undefined);
+  assembler->Return(assembler->UndefinedConstant());
+
+  assembler->Bind(&call_runtime);
+  assembler->Return(
+      assembler->CallRuntime(Runtime::kArrayPop, context, receiver));
+}
+
+// ES6 section 22.1.3.22 Array.prototype.shift ( )
+void Builtins::Generate_ArrayPrototypeShift(CodeStubAssembler* assembler) {
+  typedef compiler::Node Node;
+  typedef CodeStubAssembler::Label Label;
+  typedef CodeStubAssembler::Variable Variable;
+
+  // Longer arrays are left-trimmed by the runtime instead of being copied.
+  static const int kMaxCopyLength = 16;
+
+  Node* receiver = assembler->Parameter(0);
+  Node* context = assembler->Parameter(3);
+
+  Label call_runtime(assembler, Label::kDeferred), return_undefined(assembler);
+
+  Node* elements = LoadWritableFastArrayElements(assembler, receiver, context,
+                                                 &call_runtime);
+
+  // Holes in the moved elements must not reveal elements of the prototypes.
+  Node* protector_cell = assembler->LoadRoot(Heap::kArrayProtectorRootIndex);
+  Node* protector =
+      assembler->LoadObjectField(protector_cell, PropertyCell::kValueOffset);
+  assembler->GotoUnless(
+      assembler->WordEqual(protector, assembler->SmiConstant(Smi::FromInt(
+                                          Isolate::kArrayProtectorValid))),
+      &call_runtime);
+
+  Node* length = assembler->LoadObjectField(receiver, JSArray::kLengthOffset);
+  assembler->GotoIf(
+      assembler->SmiEqual(length, assembler->SmiConstant(Smi::FromInt(0))),
+      &return_undefined);
+
+  Node* new_length =
+      assembler->SmiSub(length, assembler->SmiConstant(Smi::FromInt(1)));
+  assembler->GotoUnless(
+      assembler->SmiLessThanOrEqual(
+          new_length, assembler->SmiConstant(Smi::FromInt(kMaxCopyLength))),
+      &call_runtime);
+  Node* capacity = assembler->LoadFixedArrayBaseLength(elements);
+  assembler->GotoIf(assembler->SmiLessThanOrEqual(
+                        assembler->SmiAdd(new_length, new_length), capacity),
+                    &call_runtime);
+
+  Node* the_hole = assembler->LoadRoot(Heap::kTheHoleValueRootIndex);
+  Node* result = assembler->LoadFixedArrayElementConstantIndex(elements, 0);
+  assembler->GotoIf(assembler->WordEqual(result, the_hole), &call_runtime);
+
+  // Move the remaining elements down by one.
+  Node* new_length_word32 = assembler->SmiToWord32(new_length);
+  Variable var_index(assembler, MachineRepresentation::kWord32);
+  Label loop(assembler, &var_index), done_moving(assembler);
+  var_index.Bind(assembler->Int32Constant(0));
+  assembler->Goto(&loop);
+  assembler->Bind(&loop);
+  {
+    Node* index = var_index.value();
+    Label if_notdone(assembler);
+    assembler->Branch(assembler->Word32Equal(index, new_length_word32),
+                      &done_moving, &if_notdone);
+    assembler->Bind(&if_notdone);
+
+    Node* element = assembler->LoadFixedArrayElementInt32Index(
+        elements, index, kPointerSize);
+    assembler->StoreFixedArrayElementInt32Index(elements, index, element);
+    var_index.Bind(assembler->Int32Add(index, assembler->Int32Constant(1)));
+    assembler->Goto(&loop);
+  }
+
+  assembler->Bind(&done_moving);
+  assembler->StoreFixedArrayElementNoWriteBarrier(
+      elements, assembler->SmiUntag(new_length), the_hole);
+  assembler->StoreObjectFieldNoWriteBarrier(receiver, JSArray::kLengthOffset,
+                                            new_length);
+  assembler->Return(result);
+
+  assembler->Bind(&return_undefined);
+  assembler->Return(assembler->UndefinedConstant());
+
+  assembler->Bind(&call_runtime);
+  assembler->Return(
+      assembler->CallRuntime(Runtime::kArrayShift, context, receiver));
+}
+
 
 BUILTIN(ArrayUnshift) {
   HandleScope scope(isolate);
@@ -4563,6 +4744,293 @@ void Builtins::Generate_StringPrototypeCharCodeAt(
   assembler->Return(result);
 }
 
+// -----------------------------------------------------------------------------
+// ES6 section 23.1 Map Objects and ES6 section 23.2 Set Objects
+
+namespace {
+
+// Looks up {key} in the OrderedHashMap or OrderedHashSet {table}, whose
+// entries are {entry_size} fields long. Jumps to {if_found} with the table
+// index of the matching key in {var_key_index}, or to {if_not_found}. Only
+// Smi keys and String keys with a computed hash are handled here, other keys
+// jump to {if_slow}.
+void OrderedHashTableLookup(CodeStubAssembler* assembler, int entry_size,
+                            compiler::Node* context, compiler::Node* table,
+                            compiler::Node* key,
+                            CodeStubAssembler::Variable* var_key_index,
+                            CodeStubAssembler::Label* if_found,
+                            CodeStubAssembler::Label* if_not_found,
+                            CodeStubAssembler::Label* if_slow) {
+  typedef CodeStubAssembler::Label Label;
+  typedef compiler::Node Node;
+  typedef CodeStubAssembler::Variable Variable;
+
+  // Compute the hash of {key} like Object::GetHash does.
+  Variable var_hash(assembler, MachineRepresentation::kWord32);
+  Label if_keyissmi(assembler), if_keyisnotsmi(assembler),
+      if_hashcomputed(assembler, &var_hash);
+  assembler->Branch(assembler->WordIsSmi(key), &if_keyissmi, &if_keyisnotsmi);
+
+  assembler->Bind(&if_keyissmi);
+  {
+    // ComputeIntegerHash with a zero seed.
+    Node* hash = assembler->SmiToWord32(key);
+    hash = assembler->Int32Add(
+        assembler->Word32Xor(hash, assembler->Int32Constant(-1)),
+        assembler->Word32Shl(hash, assembler->Int32Constant(15)));
+    hash = assembler->Word32Xor(
+        hash, assembler->Word32Shr(hash, assembler->Int32Constant(12)));
+    hash = assembler->Int32Add(
+        hash, assembler->Word32Shl(hash, assembler->Int32Constant(2)));
+    hash = assembler->Word32Xor(
+        hash, assembler->Word32Shr(hash, assembler->Int32Constant(4)));
+    hash = assembler->Int32Mul(hash, assembler->Int32Constant(2057));
+    hash = assembler->Word32Xor(
+        hash, assembler->Word32Shr(hash, assembler->Int32Constant(16)));
+    var_hash.Bind(
+        assembler->Word32And(hash, assembler->Int32Constant(Smi::kMaxValue)));
+    assembler->Goto(&if_hashcomputed);
+  }
+
+  assembler->Bind(&if_keyisnotsmi);
+  {
+    Label if_keyisstring(assembler), if_hashfieldcomputed(assembler);
+    Node* key_instance_type = assembler->LoadInstanceType(key);
+    assembler->Branch(
+        assembler->Int32LessThan(
+            key_instance_type, assembler->Int32Constant(FIRST_NONSTRING_TYPE)),
+        &if_keyisstring, if_slow);
+
+    assembler->Bind(&if_keyisstring);
+    Node* hash_field = assembler->LoadNameHash(key);
+    Node* not_computed = assembler->Word32And(
+        hash_field, assembler->Int32Constant(Name::kHashNotComputedMask));
+    assembler->Branch(
+        assembler->Word32Equal(not_computed, assembler->Int32Constant(0)),
+        &if_hashfieldcomputed, if_slow);
+
+    assembler->Bind(&if_hashfieldcomputed);
+    var_hash.Bind(assembler->Word32Shr(
+        hash_field, assembler->Int32Constant(Name::kHashShift)));
+    assembler->Goto(&if_hashcomputed);
+  }
+
+  assembler->Bind(&if_hashcomputed);
+
+  // Load the first entry of the bucket for the hash.
+  Node* number_of_buckets = assembler->SmiToWord32(
+      assembler->LoadFixedArrayElementConstantIndex(
+          table, OrderedHashMap::kNumberOfBucketsIndex));
+  Node* bucket = assembler->Word32And(
+      var_hash.value(),
+      assembler->Int32Sub(number_of_buckets, assembler->Int32Constant(1)));
+  Node* first_entry_index = assembler->Int32Add(
+      number_of_buckets,
+      assembler->Int32Constant(OrderedHashMap::kHashTableStartIndex));
+
+  Variable var_entry(assembler, MachineRepresentation::kTagged);
+  var_entry.Bind(assembler->LoadFixedArrayElementInt32Index(
+      table, bucket, OrderedHashMap::kHashTableStartIndex * kPointerSize));
+
+  // Walk the chain of the bucket.
+  Label loop(assembler, &var_entry);
+  assembler->Goto(&loop);
+  assembler->Bind(&loop);
+  {
+    Node* entry = var_entry.value();
+    Node* not_found =
+        assembler->SmiConstant(Smi::FromInt(OrderedHashMap::kNotFound));
+    Label if_entryisvalid(assembler);
+    assembler->Branch(assembler->WordEqual(entry, not_found), if_not_found,
+                      &if_entryisvalid);
+
+    assembler->Bind(&if_entryisvalid);
+    Node* index = assembler->Int32Add(
+        first_entry_index,
+        assembler->Int32Mul(assembler->SmiToWord32(entry),
+                            assembler->Int32Constant(entry_size)));
+    Node* candidate = assembler->LoadFixedArrayElementInt32Index(table, index);
+
+    // Compare {candidate} with {key} using SameValueZero. Deleted entries
+    // hold the hole, which never matches.
+    Label if_match(assembler), if_nomatch(assembler),
+        if_candidateisnotsmi(assembler);
+    assembler->GotoIf(assembler->WordEqual(candidate, key), &if_match);
+    assembler->Branch(assembler->WordIsSmi(candidate), &if_nomatch,
+                      &if_candidateisnotsmi);
+
+    assembler->Bind(&if_candidateisnotsmi);
+    {
+      Label if_smikey(assembler), if_stringkey(assembler);
+      assembler->Branch(assembler->WordIsSmi(key), &if_smikey, &if_stringkey);
+
+      assembler->Bind(&if_smikey);
+      {
+        // A HeapNumber with an integral value hashes like the Smi.
+        Label if_candidateisnumber(assembler);
+        assembler->Branch(
+            assembler->WordEqual(assembler->LoadMap(candidate),
+                                 assembler->HeapNumberMapConstant()),
+            &if_candidateisnumber, &if_nomatch);
+
+        assembler->Bind(&if_candidateisnumber);
+        assembler->BranchIfFloat64Equal(
+            assembler->LoadHeapNumberValue(candidate),
+            assembler->SmiToFloat64(key), &if_match, &if_nomatch);
+      }
+
+      assembler->Bind(&if_stringkey);
+      {
+        Label if_candidateisstring(assembler), if_compare(assembler);
+        Node* candidate_instance_type = assembler->LoadInstanceType(candidate);
+        assembler->Branch(
+            assembler->Int32LessThan(
+                candidate_instance_type,
+                assembler->Int32Constant(FIRST_NONSTRING_TYPE)),
+            &if_candidateisstring, &if_nomatch);
+
+        // Different internalized strings are never equal.
+        assembler->Bind(&if_candidateisstring);
+        Node* both_instance_types = assembler->Word32Or(
+            assembler->LoadInstanceType(key), candidate_instance_type);
+        assembler->Branch(
+            assembler->Word32Equal(
+                assembler->Word32And(
+                    both_instance_types,
+                    assembler->Int32Constant(kIsNotInternalizedMask)),
+                assembler->Int32Constant(0)),
+            &if_nomatch, &if_compare);
+
+        assembler->Bind(&if_compare);
+        Callable callable = CodeFactory::StringEqual(assembler->isolate());
+        Node* result = assembler->CallStub(callable, context, key, candidate);
+        assembler->Branch(
+            assembler->WordEqual(result, assembler->BooleanConstant(true)),
+            &if_match, &if_nomatch);
+      }
+    }
+
+    assembler->Bind(&if_match);
+    var_key_index->Bind(index);
+    assembler->Goto(if_found);
+
+    assembler->Bind(&if_nomatch);
+    var_entry.Bind(assembler->LoadFixedArrayElementInt32Index(
+        table, index, (entry_size - 1) * kPointerSize));
+    assembler->Goto(&loop);
+  }
+}
+
+// Loads the table of the JSMap or JSSet {receiver}, jumping to {if_slow} if
+// {receiver} is not of {instance_type}.
+compiler::Node* LoadCollectionTable(CodeStubAssembler* assembler,
+                                    compiler::Node* receiver,
+                                    InstanceType instance_type,
+                                    CodeStubAssembler::Label* if_slow) {
+  CodeStubAssembler::Label if_receiverisnotsmi(assembler),
+      if_receiverisvalid(assembler);
+  assembler->Branch(assembler->WordIsSmi(receiver), if_slow,
+                    &if_receiverisnotsmi);
+  assembler->Bind(&if_receiverisnotsmi);
+  assembler->Branch(
+      assembler->Word32Equal(assembler->LoadInstanceType(receiver),
+                             assembler->Int32Constant(instance_type)),
+      &if_receiverisvalid, if_slow);
+  assembler->Bind(&if_receiverisvalid);
+  return assembler->LoadObjectField(receiver, JSCollection::kTableOffset);
+}
+
+}  // namespace
+
+// ES6 section 23.1.3.6 Map.prototype.get ( key )
+void Builtins::Generate_MapPrototypeGet(CodeStubAssembler* assembler) {
+  typedef CodeStubAssembler::Label Label;
+  typedef compiler::Node Node;
+  typedef CodeStubAssembler::Variable Variable;
+
+  Node* receiver = assembler->Parameter(0);
+  Node* key = assembler->Parameter(1);
+  Node* context = assembler->Parameter(4);
+
+  Variable var_key_index(assembler, MachineRepresentation::kWord32);
+  Label if_found(assembler, &var_key_index), if_not_found(assembler),
+      if_slow(assembler, Label::kDeferred);
+  Node* table = LoadCollectionTable(assembler, receiver, JS_MAP_TYPE, &if_slow);
+  OrderedHashTableLookup(assembler, OrderedHashMap::kEntrySize, context,
+                         table, key, &var_key_index, &if_found, &if_not_found,
+                         &if_slow);
+
+  assembler->Bind(&if_found);
+  assembler->Return(assembler->LoadFixedArrayElementInt32Index(
+      table, var_key_index.value(),
+      OrderedHashMap::kValueOffset * kPointerSize));
+
+  assembler->Bind(&if_not_found);
+  assembler->Return(assembler->UndefinedConstant());
+
+  assembler->Bind(&if_slow);
+  assembler->Return(
+      assembler->CallRuntime(Runtime::kMapGet, context, receiver, key));
+}
+
+// ES6 section 23.1.3.7 Map.prototype.has ( key )
+void Builtins::Generate_MapPrototypeHas(CodeStubAssembler* assembler) {
+  typedef CodeStubAssembler::Label Label;
+  typedef compiler::Node Node;
+  typedef CodeStubAssembler::Variable Variable;
+
+  Node* receiver = assembler->Parameter(0);
+  Node* key = assembler->Parameter(1);
+  Node* context = assembler->Parameter(4);
+
+  Variable var_key_index(assembler, MachineRepresentation::kWord32);
+  Label if_found(assembler, &var_key_index), if_not_found(assembler),
+      if_slow(assembler, Label::kDeferred);
+  Node* table = LoadCollectionTable(assembler, receiver, JS_MAP_TYPE, &if_slow);
+  OrderedHashTableLookup(assembler, OrderedHashMap::kEntrySize, context,
+                         table, key, &var_key_index, &if_found, &if_not_found,
+                         &if_slow);
+
+  assembler->Bind(&if_found);
+  assembler->Return(assembler->BooleanConstant(true));
+
+  assembler->Bind(&if_not_found);
+  assembler->Return(assembler->BooleanConstant(false));
+
+  assembler->Bind(&if_slow);
+  assembler->Return(
+      assembler->CallRuntime(Runtime::kMapHas, context, receiver, key));
+}
+
+// ES6 section 23.2.3.7 Set.prototype.has ( value )
+void Builtins::Generate_SetPrototypeHas(CodeStubAssembler* assembler) {
+  typedef CodeStubAssembler::Label Label;
+  typedef compiler::Node Node;
+  typedef CodeStubAssembler::Variable Variable;
+
+  Node* receiver = assembler->Parameter(0);
+  Node* key = assembler->Parameter(1);
+  Node* context = assembler->Parameter(4);
+
+  Variable var_key_index(assembler, MachineRepresentation::kWord32);
+  Label if_found(assembler, &var_key_index), if_not_found(assembler),
+      if_slow(assembler, Label::kDeferred);
+  Node* table = LoadCollectionTable(assembler, receiver, JS_SET_TYPE, &if_slow);
+  OrderedHashTableLookup(assembler, OrderedHashSet::kEntrySize, context,
+                         table, key, &var_key_index, &if_found, &if_not_found,
+                         &if_slow);
+
+  assembler->Bind(&if_found);
+  assembler->Return(assembler->BooleanConstant(true));
+
+  assembler->Bind(&if_not_found);
+  assembler->Return(assembler->BooleanConstant(false));
+
+  assembler->Bind(&if_slow);
+  assembler->Return(
+      assembler->CallRuntime(Runtime::kSetHas, context, receiver, key));
+}
+
 // -----------------------------------------------------------------------------
 // ES6 section 21.1 ArrayBuffer Objects
 
@@ -5318,6 +5786,21 @@ const char* Builtins::Lookup(byte* pc) {
 }
 
 
+void Builtins::set_builtin(Name name, Code* code) { builtins_[name] = code; }
+
+// static
+bool Builtins::IsLazy(int index) {
+  switch (index) {
+#define CASE_T(name, argc) case k##name:
+    BUILTIN_LIST_T(CASE_T)
+#undef CASE_T
+      return true;
+    default:
+      return false;
+  }
+}
+
+
 void Builtins::Generate_InterruptCheck(MacroAssembler* masm) {
   masm->TailCallRuntime(Runtime::kInterrupt);
 }
@@ -60,9 +60,7 @@ inline bool operator&(BuiltinExtraArguments lhs, BuiltinExtraArguments rhs) {
   V(EmptyFunction, kNone)                                      \
                                                                \
   V(ArrayConcat, kNone)                                        \
-  V(ArrayPop, kNone)                                           \
   V(ArrayPush, kNone)                                          \
-  V(ArrayShift, kNone)                                         \
   V(ArraySlice, kNone)                                         \
   V(ArraySplice, kNone)                                        \
   V(ArrayUnshift, kNone)                                       \
@@ -223,6 +221,7 @@ inline bool operator&(BuiltinExtraArguments lhs, BuiltinExtraArguments rhs) {
   V(CompileBaseline, BUILTIN, UNINITIALIZED, kNoExtraICState)                  \
   V(CompileOptimized, BUILTIN, UNINITIALIZED, kNoExtraICState)                 \
   V(CompileOptimizedConcurrent, BUILTIN, UNINITIALIZED, kNoExtraICState)       \
+  V(DeserializeLazy, BUILTIN, UNINITIALIZED, kNoExtraICState)                  \
   V(NotifyDeoptimized, BUILTIN, UNINITIALIZED, kNoExtraICState)                \
   V(NotifySoftDeoptimized, BUILTIN, UNINITIALIZED, kNoExtraICState)            \
   V(NotifyLazyDeoptimized, BUILTIN, UNINITIALIZED, kNoExtraICState)            \
@@ -296,6 +295,7 @@ inline bool operator&(BuiltinExtraArguments lhs, BuiltinExtraArguments rhs) {
   V(StringConstructor_ConstructStub, BUILTIN, UNINITIALIZED, kNoExtraICState)  \
                                                                                \
   V(OnStackReplacement, BUILTIN, UNINITIALIZED, kNoExtraICState)               \
+  V(InterpreterOnStackReplacement, BUILTIN, UNINITIALIZED, kNoExtraICState)    \
   V(InterruptCheck, BUILTIN, UNINITIALIZED, kNoExtraICState)                   \
   V(StackCheck, BUILTIN, UNINITIALIZED, kNoExtraICState)                       \
                                                                                \
@@ -317,8 +317,13 @@ inline bool operator&(BuiltinExtraArguments lhs, BuiltinExtraArguments rhs) {
   V(MathTrunc, 2)                 \
   V(ObjectHasOwnProperty, 2)      \
   V(ArrayIsArray, 2)              \
+  V(ArrayPrototypePop, 1)         \
+  V(ArrayPrototypeShift, 1)       \
   V(StringPrototypeCharAt, 2)     \
   V(StringPrototypeCharCodeAt, 2) \
+  V(MapPrototypeGet, 2)           \
+  V(MapPrototypeHas, 2)           \
+  V(SetPrototypeHas, 2)           \
   V(AtomicsLoad, 3)
 
 // Define list of builtin handlers implemented in assembly.
@@ -412,6 +417,14 @@ class Builtins {
     return reinterpret_cast<Address>(&builtins_[name]);
   }
 
+  // Installs a builtin that was deserialized after the startup snapshot.
+  void set_builtin(Name name, Code* code);
+
+  // Whether the builtin at {index} is only entered through the code of a
+  // JSFunction, so that the snapshot can defer its deserialization until
+  // the first call. These are the builtins implemented in TurboFan.
+  static bool IsLazy(int index);
+
   static Address c_function_address(CFunctionId id) {
     return c_functions_[id];
   }
@@ -446,6 +459,7 @@ class Builtins {
   static void Generate_ConstructedNonConstructable(MacroAssembler* masm);
   static void Generate_CompileLazy(MacroAssembler* masm);
   static void Generate_CompileBaseline(MacroAssembler* masm);
+  static void Generate_DeserializeLazy(MacroAssembler* masm);
   static void Generate_InOptimizationQueue(MacroAssembler* masm);
   static void Generate_CompileOptimized(MacroAssembler* masm);
   static void Generate_CompileOptimizedConcurrent(MacroAssembler* masm);
@@ -634,15 +648,27 @@ class Builtins {
 
   // ES6 section 22.1.2.2 Array.isArray
   static void Generate_ArrayIsArray(CodeStubAssembler* assembler);
+  // ES6 section 22.1.3.17 Array.prototype.pop ( )
+  static void Generate_ArrayPrototypePop(CodeStubAssembler* assembler);
+  // ES6 section 22.1.3.22 Array.prototype.shift ( )
+  static void Generate_ArrayPrototypeShift(CodeStubAssembler* assembler);
 
   // ES6 section 21.1.3.1 String.prototype.charAt ( pos )
   static void Generate_StringPrototypeCharAt(CodeStubAssembler* assembler);
   // ES6 section 21.1.3.2 String.prototype.charCodeAt ( pos )
   static void Generate_StringPrototypeCharCodeAt(CodeStubAssembler* assembler);
 
+  // ES6 section 23.1.3.6 Map.prototype.get ( key )
+  static void Generate_MapPrototypeGet(CodeStubAssembler* assembler);
+  // ES6 section 23.1.3.7 Map.prototype.has ( key )
+  static void Generate_MapPrototypeHas(CodeStubAssembler* assembler);
+  // ES6 section 23.2.3.7 Set.prototype.has ( value )
+  static void Generate_SetPrototypeHas(CodeStubAssembler* assembler);
+
   static void Generate_StringConstructor(MacroAssembler* masm);
   static void Generate_StringConstructor_ConstructStub(MacroAssembler* masm);
   static void Generate_OnStackReplacement(MacroAssembler* masm);
+  static void Generate_InterpreterOnStackReplacement(MacroAssembler* masm);
   static void Generate_InterruptCheck(MacroAssembler* masm);
   static void Generate_StackCheck(MacroAssembler* masm);
 
@@ -4,6 +4,8 @@
 
 #include "src/cancelable-task.h"
 
+#include <algorithm>
+
 #include "src/base/platform/platform.h"
 #include "src/isolate.h"
 
@@ -32,12 +34,34 @@ static bool ComparePointers(void* ptr1, void* ptr2) { return ptr1 == ptr2; }
 
 
 CancelableTaskManager::CancelableTaskManager()
-    : task_id_counter_(0), cancelable_tasks_(ComparePointers) {}
+    : task_id_counter_(0),
+      cancelable_tasks_(ComparePointers),
+      parent_(nullptr) {}
+
+
+CancelableTaskManager::CancelableTaskManager(CancelableTaskManager* parent)
+    : task_id_counter_(0),
+      cancelable_tasks_(ComparePointers),
+      parent_(parent) {
+  base::LockGuard<base::Mutex> guard(&parent->groups_mutex_);
+  parent->groups_.push_back(this);
+}
+
+
+CancelableTaskManager::~CancelableTaskManager() {
+  DCHECK(groups_.empty());
+  if (parent_ == nullptr) return;
+  DCHECK_EQ(0u, cancelable_tasks_.occupancy());
+  base::LockGuard<base::Mutex> guard(&parent_->groups_mutex_);
+  std::vector<CancelableTaskManager*>& groups = parent_->groups_;
+  groups.erase(std::find(groups.begin(), groups.end(), this));
+}
 
 
 uint32_t CancelableTaskManager::Register(Cancelable* task) {
+  // Ids are handed out without the lock, which only guards the map.
+  uint32_t id = task_id_counter_.Increment(1);
   base::LockGuard<base::Mutex> guard(&mutex_);
-  uint32_t id = ++task_id_counter_;
   // The loop below is just used when task_id_counter_ overflows.
   while ((id == 0) || (cancelable_tasks_.Lookup(reinterpret_cast<void*>(id),
                                                 id) != nullptr)) {
@@ -78,31 +102,48 @@ bool CancelableTaskManager::TryAbort(uint32_t id) {
 }
 
 
+void CancelableTaskManager::CancelWaitingTasksLocked() {
+  // HashMap does not support removing while iterating, hence keep a set of
+  // entries that are to be removed.
+  std::set<uint32_t> to_remove;
+  for (HashMap::Entry* p = cancelable_tasks_.Start(); p != nullptr;
+       p = cancelable_tasks_.Next(p)) {
+    if (reinterpret_cast<Cancelable*>(p->value)->Cancel()) {
+      to_remove.insert(reinterpret_cast<Cancelable*>(p->value)->id());
+    }
+  }
+  // Remove tasks that were successfully canceled.
+  for (auto id : to_remove) {
+    cancelable_tasks_.Remove(reinterpret_cast<void*>(id), id);
+  }
+}
+
+
+bool CancelableTaskManager::TryAbortAll() {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  CancelWaitingTasksLocked();
+  return cancelable_tasks_.occupancy() == 0;
+}
+
+
 void CancelableTaskManager::CancelAndWait() {
+  // Groups are canceled first, without holding {mutex_}, so that their tasks
+  // can still register tasks with this manager.
+  {
+    base::LockGuard<base::Mutex> guard(&groups_mutex_);
+    for (CancelableTaskManager* group : groups_) group->CancelAndWait();
+  }
+
   // Clean up all cancelable fore- and background tasks. Tasks are canceled on
   // the way if possible, i.e., if they have not started yet.  After each round
   // of canceling we wait for the background tasks that have already been
   // started.
   base::LockGuard<base::Mutex> guard(&mutex_);
 
-  // HashMap does not support removing while iterating, hence keep a set of
-  // entries that are to be removed.
-  std::set<uint32_t> to_remove;
-
   // Cancelable tasks could potentially register new tasks, requiring a loop
   // here.
   while (cancelable_tasks_.occupancy() > 0) {
-    for (HashMap::Entry* p = cancelable_tasks_.Start(); p != nullptr;
-         p = cancelable_tasks_.Next(p)) {
-      if (reinterpret_cast<Cancelable*>(p->value)->Cancel()) {
-        to_remove.insert(reinterpret_cast<Cancelable*>(p->value)->id());
-      }
-    }
-    // Remove tasks that were successfully canceled.
-    for (auto id : to_remove) {
-      cancelable_tasks_.Remove(reinterpret_cast<void*>(id), id);
-    }
-    to_remove.clear();
+    CancelWaitingTasksLocked();
 
     // Finally, wait for already running background tasks.
     if (cancelable_tasks_.occupancy() > 0) {
@@ -116,6 +157,11 @@ CancelableTask::CancelableTask(Isolate* isolate)
     : Cancelable(isolate->cancelable_task_manager()), isolate_(isolate) {}
 
 
+CancelableTask::CancelableTask(Isolate* isolate,
+                               CancelableTaskManager* manager)
+    : Cancelable(manager), isolate_(isolate) {}
+
+
 CancelableIdleTask::CancelableIdleTask(Isolate* isolate)
     : Cancelable(isolate->cancelable_task_manager()), isolate_(isolate) {}
 
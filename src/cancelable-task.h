@@ -5,6 +5,8 @@
 #ifndef V8_CANCELABLE_TASK_H_
 #define V8_CANCELABLE_TASK_H_
 
+#include <vector>
+
 #include "include/v8-platform.h"
 #include "src/atomic-utils.h"
 #include "src/base/macros.h"
@@ -20,10 +22,21 @@ class Isolate;
 
 // Keeps track of cancelable tasks. It is possible to register and remove tasks
 // from any fore- and background task/thread.
+//
+// Related tasks, e.g. the tasks of one GC phase or of one compile job, can be
+// kept in a separate group manager. Groups have their own lock, so their
+// tasks do not contend with other tasks, and they can be canceled at once.
 class CancelableTaskManager {
  public:
   CancelableTaskManager();
 
+  // Creates a group whose tasks are also canceled by {parent}'s
+  // {CancelAndWait}. All tasks of a group must be canceled or finished before
+  // it is destroyed, e.g. by calling {CancelAndWait} on it.
+  explicit CancelableTaskManager(CancelableTaskManager* parent);
+
+  ~CancelableTaskManager();
+
   // Registers a new cancelable {task}. Returns the unique {id} of the task that
   // can be used to try to abort a task by calling {Abort}.
   uint32_t Register(Cancelable* task);
@@ -38,8 +51,13 @@ class CancelableTaskManager {
   // Returns {false} for (1) and (2), and {true} for (3).
   bool TryAbort(uint32_t id);
 
-  // Cancels all remaining registered tasks and waits for tasks that are
-  // already running.
+  // Cancels all registered tasks that are not yet running, without waiting
+  // for the running ones. Returns {true} if no registered task is left, i.e.
+  // if all tasks are canceled or finished.
+  bool TryAbortAll();
+
+  // Cancels all remaining registered tasks, including those of groups, and
+  // waits for tasks that are already running.
   void CancelAndWait();
 
  private:
@@ -47,8 +65,11 @@ class CancelableTaskManager {
   // but needs to be removed.
   void RemoveFinishedTask(uint32_t id);
 
+  // Cancels and removes the tasks that are not yet running. Requires {mutex_}.
+  void CancelWaitingTasksLocked();
+
   // To mitigate the ABA problem, the api refers to tasks through an id.
-  uint32_t task_id_counter_;
+  AtomicNumber<uint32_t> task_id_counter_;
 
   // A set of cancelable tasks that are currently registered.
   HashMap cancelable_tasks_;
@@ -58,6 +79,14 @@ class CancelableTaskManager {
   base::ConditionVariable cancelable_tasks_barrier_;
   base::Mutex mutex_;
 
+  // The manager this group belongs to, or nullptr.
+  CancelableTaskManager* parent_;
+
+  // Groups belonging to this manager. Guarded by their own mutex, so that
+  // tasks can still register with this manager while groups are canceled.
+  std::vector<CancelableTaskManager*> groups_;
+  base::Mutex groups_mutex_;
+
   friend class Cancelable;
 
   DISALLOW_COPY_AND_ASSIGN(CancelableTaskManager);
@@ -122,6 +151,8 @@ class Cancelable {
 class CancelableTask : public Cancelable, public Task {
  public:
   explicit CancelableTask(Isolate* isolate);
+  // Registers the task with {manager}, e.g. a group of {isolate}'s manager.
+  CancelableTask(Isolate* isolate, CancelableTaskManager* manager);
 
   // Task overrides.
   void Run() final {
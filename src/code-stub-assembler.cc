@@ -1148,5 +1148,26 @@ Node* CodeStubAssembler::BitFieldDecode(Node* word32, uint32_t shift,
                    Int32Constant(shift));
 }
 
+void CodeStubAssembler::TryMonomorphicCase(Node* receiver, Node* int32_slot,
+                                           Node* vector, Label* if_handler,
+                                           Variable* var_handler,
+                                           Label* if_miss) {
+  // Smi receivers are recorded with the HeapNumber map, leave them to the IC.
+  GotoIf(WordIsSmi(receiver), if_miss);
+  Node* receiver_map = LoadMap(receiver);
+
+  // The feedback is not necessarily a WeakCell, but it is safe to look at
+  // WeakCell::kValueOffset for all kinds of feedback, the value there only
+  // matches a map in the monomorphic case.
+  Node* feedback = LoadFixedArrayElementInt32Index(vector, int32_slot);
+  Node* feedback_map = LoadObjectField(feedback, WeakCell::kValueOffset);
+  GotoUnless(WordEqual(receiver_map, feedback_map), if_miss);
+
+  // The handler is stored in the slot following the feedback.
+  var_handler->Bind(
+      LoadFixedArrayElementInt32Index(vector, int32_slot, kPointerSize));
+  Goto(if_handler);
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -202,6 +202,16 @@ class CodeStubAssembler : public compiler::CodeAssembler {
   compiler::Node* BitFieldDecode(compiler::Node* word32, uint32_t shift,
                                  uint32_t mask);
 
+  // Inline cache helpers.
+  // Checks for the monomorphic case of the IC at {int32_slot} in {vector}:
+  // if the map of {receiver} matches the map in the slot's WeakCell, binds
+  // the handler to {var_handler} and jumps to {if_handler}, otherwise jumps
+  // to {if_miss}.
+  void TryMonomorphicCase(compiler::Node* receiver,
+                          compiler::Node* int32_slot, compiler::Node* vector,
+                          Label* if_handler, Variable* var_handler,
+                          Label* if_miss);
+
  private:
   compiler::Node* AllocateRawAligned(compiler::Node* size_in_bytes,
                                      AllocationFlags flags,
@@ -5,9 +5,11 @@
 #include "src/compilation-cache.h"
 
 #include "src/assembler.h"
+#include "src/base/lazy-instance.h"
 #include "src/counters.h"
 #include "src/factory.h"
 #include "src/objects-inl.h"
+#include "src/parsing/preparse-data.h"
 
 namespace v8 {
 namespace internal {
@@ -402,5 +404,121 @@ void CompilationCache::Disable() {
 }
 
 
+static base::LazyInstance<SharedCodeCache>::type shared_code_cache =
+    LAZY_INSTANCE_INITIALIZER;
+
+
+SharedCodeCache* SharedCodeCache::Get() { return shared_code_cache.Pointer(); }
+
+
+void SharedCodeCache::InitializeKey(Entry* key, Handle<String> source,
+                                    Handle<Object> name, int line_offset,
+                                    int column_offset,
+                                    ScriptOriginOptions resource_options) {
+  source = String::Flatten(source);
+  key->hash = source->Hash();
+  {
+    DisallowHeapAllocation no_gc;
+    String::FlatContent content = source->GetFlatContent();
+    key->is_one_byte = content.IsOneByte();
+    if (key->is_one_byte) {
+      Vector<const uint8_t> chars = content.ToOneByteVector();
+      key->source.assign(reinterpret_cast<const char*>(chars.start()),
+                         chars.length());
+    } else {
+      Vector<const uc16> chars = content.ToUC16Vector();
+      key->source.assign(reinterpret_cast<const char*>(chars.start()),
+                         chars.length() * sizeof(uc16));
+    }
+  }
+  key->has_name = !name.is_null() && name->IsString();
+  if (key->has_name) key->name = String::cast(*name)->ToCString().get();
+  key->line_offset = line_offset;
+  key->column_offset = column_offset;
+  key->origin_flags = resource_options.Flags();
+}
+
+
+bool SharedCodeCache::Matches(const Entry& entry, const Entry& key) {
+  return entry.hash == key.hash && entry.is_one_byte == key.is_one_byte &&
+         entry.line_offset == key.line_offset &&
+         entry.column_offset == key.column_offset &&
+         entry.origin_flags == key.origin_flags &&
+         entry.has_name == key.has_name && entry.name == key.name &&
+         entry.source == key.source;
+}
+
+
+std::list<SharedCodeCache::Entry>::iterator SharedCodeCache::Find(
+    const Entry& key) {
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if (Matches(*it, key)) return it;
+  }
+  return entries_.end();
+}
+
+
+void SharedCodeCache::EvictToBudget(size_t budget) {
+  while (size_ > budget) {
+    size_ -= entries_.back().size();
+    entries_.pop_back();
+  }
+}
+
+
+ScriptData* SharedCodeCache::Lookup(Handle<String> source, Handle<Object> name,
+                                    int line_offset, int column_offset,
+                                    ScriptOriginOptions resource_options) {
+  Entry key;
+  InitializeKey(&key, source, name, line_offset, column_offset,
+                resource_options);
+  base::LockGuard<base::Mutex> lock_guard(&mutex_);
+  auto it = Find(key);
+  if (it == entries_.end()) return NULL;
+  entries_.splice(entries_.begin(), entries_, it);
+  int length = static_cast<int>(it->data.size());
+  byte* copy = NewArray<byte>(length);
+  CopyBytes(copy, it->data.data(), length);
+  ScriptData* result = new ScriptData(copy, length);
+  result->AcquireDataOwnership();
+  return result;
+}
+
+
+void SharedCodeCache::Put(Handle<String> source, Handle<Object> name,
+                          int line_offset, int column_offset,
+                          ScriptOriginOptions resource_options,
+                          const ScriptData* data) {
+  size_t budget = static_cast<size_t>(FLAG_shared_code_cache_size) * MB;
+  Entry key;
+  InitializeKey(&key, source, name, line_offset, column_offset,
+                resource_options);
+  key.data.assign(data->data(), data->data() + data->length());
+  if (key.size() > budget) return;
+  base::LockGuard<base::Mutex> lock_guard(&mutex_);
+  auto it = Find(key);
+  if (it != entries_.end()) {
+    size_ -= it->size();
+    entries_.erase(it);
+  }
+  EvictToBudget(budget - key.size());
+  size_ += key.size();
+  entries_.push_front(std::move(key));
+}
+
+
+void SharedCodeCache::Clear() {
+  base::LockGuard<base::Mutex> lock_guard(&mutex_);
+  entries_.clear();
+  size_ = 0;
+}
+
+
+size_t SharedCodeCache::size() {
+  base::LockGuard<base::Mutex> lock_guard(&mutex_);
+  return size_;
+}
+
+
 }  // namespace internal
 }  // namespace v8
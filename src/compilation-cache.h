@@ -5,7 +5,13 @@
 #ifndef V8_COMPILATION_CACHE_H_
 #define V8_COMPILATION_CACHE_H_
 
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "src/allocation.h"
+#include "src/base/platform/mutex.h"
 #include "src/handles.h"
 #include "src/objects.h"
 
@@ -236,6 +242,70 @@ class CompilationCache {
 };
 
 
+class ScriptData;
+
+// Process-wide cache of serialized toplevel code, shared by all isolates if
+// --shared-code-cache is enabled. Entries hold the output of the
+// CodeSerializer and are keyed by the source string and the origin of the
+// script. The least recently used entries are evicted once the cache is
+// larger than --shared-code-cache-size.
+class SharedCodeCache {
+ public:
+  SharedCodeCache() : size_(0) {}
+
+  static SharedCodeCache* Get();
+
+  // Returns a copy of the cached data for the given script, or NULL if there
+  // is none. The caller takes ownership of the result.
+  ScriptData* Lookup(Handle<String> source, Handle<Object> name,
+                     int line_offset, int column_offset,
+                     ScriptOriginOptions resource_options);
+
+  // Associates a copy of |data| with the given script. This may overwrite an
+  // existing entry.
+  void Put(Handle<String> source, Handle<Object> name, int line_offset,
+           int column_offset, ScriptOriginOptions resource_options,
+           const ScriptData* data);
+
+  void Clear();
+
+  // The number of bytes held by the cache.
+  size_t size();
+
+ private:
+  struct Entry {
+    uint32_t hash;
+    bool is_one_byte;
+    std::string source;
+    bool has_name;
+    std::string name;
+    int line_offset;
+    int column_offset;
+    int origin_flags;
+    std::vector<byte> data;
+
+    size_t size() const { return source.size() + name.size() + data.size(); }
+  };
+
+  static void InitializeKey(Entry* key, Handle<String> source,
+                            Handle<Object> name, int line_offset,
+                            int column_offset,
+                            ScriptOriginOptions resource_options);
+  static bool Matches(const Entry& entry, const Entry& key);
+  void EvictToBudget(size_t budget);
+
+  // Returns the matching entry or entries_.end().
+  std::list<Entry>::iterator Find(const Entry& key);
+
+  base::Mutex mutex_;
+  // Ordered from the most to the least recently used entry.
+  std::list<Entry> entries_;
+  size_t size_;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedCodeCache);
+};
+
+
 }  // namespace internal
 }  // namespace v8
 
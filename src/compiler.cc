@@ -30,6 +30,7 @@
 #include "src/profiler/cpu-profiler.h"
 #include "src/runtime-profiler.h"
 #include "src/snapshot/code-serializer.h"
+#include "src/tracing/trace-event.h"
 #include "src/vm-state-inl.h"
 
 namespace v8 {
@@ -135,7 +136,10 @@ CompilationInfo::CompilationInfo(ParseInfo* parse_info,
 
   if (FLAG_function_context_specialization) MarkAsFunctionContextSpecializing();
   if (FLAG_turbo_inlining) MarkAsInliningEnabled();
-  if (FLAG_turbo_source_positions) MarkAsSourcePositionsEnabled();
+  // The CPU profiler attributes ticks in optimized code to source lines.
+  if (FLAG_turbo_source_positions || isolate_->cpu_profiler()->is_profiling()) {
+    MarkAsSourcePositionsEnabled();
+  }
   if (FLAG_turbo_splitting) MarkAsSplittingEnabled();
 }
 
@@ -312,6 +316,10 @@ void CompilationInfo::PrintAstForTesting() {
 CompilationJob::Status CompilationJob::CreateGraph() {
   DisallowJavascriptExecution no_js(isolate());
   DCHECK(info()->IsOptimizing());
+  TRACE_EVENT2(TRACE_DISABLED_BY_DEFAULT("v8.compile"),
+               "V8.OptimizeCreateGraph", "function",
+               TRACE_STR_COPY(info()->GetDebugName().get()),
+               "bytes", info()->shared_info()->SourceSize());
 
   if (FLAG_trace_opt) {
     OFStream os(stdout);
@@ -332,6 +340,10 @@ CompilationJob::Status CompilationJob::OptimizeGraph() {
   DisallowHandleAllocation no_handles;
   DisallowHandleDereference no_deref;
   DisallowCodeDependencyChange no_dependency_change;
+  // Runs on a background thread for concurrent recompilation, where the
+  // function's name cannot be looked up.
+  TRACE_EVENT1(TRACE_DISABLED_BY_DEFAULT("v8.compile"), "V8.OptimizeGraph",
+               "compiler", compiler_name_);
 
   // Delegate to the underlying implementation.
   DCHECK_EQ(SUCCEEDED, last_status());
@@ -343,6 +355,9 @@ CompilationJob::Status CompilationJob::GenerateCode() {
   DisallowCodeDependencyChange no_dependency_change;
   DisallowJavascriptExecution no_js(isolate());
   DCHECK(!info()->dependencies()->HasAborted());
+  TRACE_EVENT1(TRACE_DISABLED_BY_DEFAULT("v8.compile"),
+               "V8.OptimizeGenerateCode", "function",
+               TRACE_STR_COPY(info()->GetDebugName().get()));
 
   // Delegate to the underlying implementation.
   DCHECK_EQ(SUCCEEDED, last_status());
@@ -475,20 +490,26 @@ void RecordFunctionCompilation(Logger::LogEventsAndTags tag,
   }
 }
 
-void EnsureFeedbackVector(CompilationInfo* info) {
+void EnsureFeedbackVector(CompilationInfo* info, bool allow_lazy = false) {
   DCHECK(info->has_shared_info());
+  Handle<SharedFunctionInfo> shared = info->shared_info();
 
   // If no type feedback vector exists, we create one now. At this point the
   // AstNumbering pass has already run. Note the snapshot can contain outdated
   // vectors for a different configuration, hence we also recreate a new vector
   // when the function is not compiled (i.e. no code was serialized).
-  if (info->shared_info()->feedback_vector()->is_empty() ||
-      !info->shared_info()->is_compiled()) {
+  if ((shared->feedback_vector()->is_empty() &&
+       !shared->feedback_vector()->is_lazy()) ||
+      !shared->is_compiled()) {
     Handle<TypeFeedbackMetadata> feedback_metadata = TypeFeedbackMetadata::New(
         info->isolate(), info->literal()->feedback_vector_spec());
     Handle<TypeFeedbackVector> feedback_vector =
-        TypeFeedbackVector::New(info->isolate(), feedback_metadata);
-    info->shared_info()->set_feedback_vector(*feedback_vector);
+        allow_lazy
+            ? TypeFeedbackVector::NewLazy(info->isolate(), feedback_metadata)
+            : TypeFeedbackVector::New(info->isolate(), feedback_metadata);
+    shared->set_feedback_vector(*feedback_vector);
+  } else if (!allow_lazy) {
+    SharedFunctionInfo::EnsureFeedbackVector(shared);
   }
 
   // It's very important that recompiles do not alter the structure of the type
@@ -533,15 +554,25 @@ int CodeAndMetadataSize(CompilationInfo* info) {
 
 bool GenerateUnoptimizedCode(CompilationInfo* info) {
   bool success;
-  EnsureFeedbackVector(info);
+  Isolate* isolate = info->isolate();
+  Counters* counters = isolate->counters();
   if (FLAG_ignition && UseIgnition(info)) {
+    RuntimeCallTimerScope runtime_timer(
+        isolate, &counters->runtime_call_stats()->CompileIgnition);
+    TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.compile"),
+                 "V8.CompileIgnition");
+    // The interpreter can run without feedback until the function is warm.
+    EnsureFeedbackVector(info, FLAG_ignition_lazy_feedback_allocation);
     success = interpreter::Interpreter::MakeBytecode(info);
   } else {
+    RuntimeCallTimerScope runtime_timer(
+        isolate, &counters->runtime_call_stats()->CompileFullCode);
+    TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.compile"),
+                 "V8.CompileFullCode");
+    EnsureFeedbackVector(info);
     success = FullCodeGenerator::MakeCode(info);
   }
   if (success) {
-    Isolate* isolate = info->isolate();
-    Counters* counters = isolate->counters();
     // TODO(4280): Rename counters from "baseline" to "unoptimized" eventually.
     counters->total_baseline_code_size()->Increment(CodeAndMetadataSize(info));
     counters->total_baseline_compile_count()->Increment(1);
@@ -651,8 +682,11 @@ void InsertCodeIntoOptimizedCodeMap(CompilationInfo* info) {
 }
 
 bool Renumber(ParseInfo* parse_info) {
+  // Natives are not covered, their snapshot feedback vectors have no block
+  // counters.
+  bool block_coverage = FLAG_block_coverage && !parse_info->is_native();
   if (!AstNumbering::Renumber(parse_info->isolate(), parse_info->zone(),
-                              parse_info->literal())) {
+                              parse_info->literal(), block_coverage)) {
     return false;
   }
   Handle<SharedFunctionInfo> shared_info = parse_info->shared_info();
@@ -794,6 +828,9 @@ MaybeHandle<Code> GetOptimizedCode(Handle<JSFunction> function,
     shared->code()->set_profiler_ticks(0);
   }
 
+  // The optimizing compilers read feedback from the vector slots.
+  SharedFunctionInfo::EnsureFeedbackVector(shared);
+
   // TODO(mstarzinger): We cannot properly deserialize a scope chain containing
   // an eval scope and hence would fail at parsing the eval source again.
   if (shared->disable_optimization_reason() == kEval) {
@@ -833,17 +870,28 @@ MaybeHandle<Code> GetOptimizedCode(Handle<JSFunction> function,
   TimerEventScope<TimerEventOptimizeCode> optimize_code_timer(isolate);
   TRACE_EVENT0("v8", "V8.OptimizeCode");
 
-  bool use_turbofan = UseTurboFan(info.get());
+  // OSR from an interpreted frame is only supported by TurboFan, which then
+  // has to build its graph from the very same bytecode.
+  bool osr_from_bytecode = osr_frame && osr_frame->is_interpreted();
+  bool use_turbofan = UseTurboFan(info.get()) || osr_from_bytecode;
   base::SmartPointer<CompilationJob> job(
       use_turbofan ? compiler::Pipeline::NewCompilationJob(info.get())
                    : new HCompilationJob(info.get()));
 
   // TruboFan can optimize directly from existing bytecode.
-  if (FLAG_turbo_from_bytecode && use_turbofan &&
+  if ((FLAG_turbo_from_bytecode || osr_from_bytecode) && use_turbofan &&
       info->shared_info()->HasBytecodeArray()) {
     info->MarkAsOptimizeFromBytecode();
   }
 
+  // The block counters of --block-coverage are only maintained by the
+  // interpreter and by TurboFan code built from bytecode.
+  if (FLAG_block_coverage && info->shared_info()->HasBytecodeArray() &&
+      !info->is_optimizing_from_bytecode()) {
+    info->AbortOptimization(kBlockCoverage);
+    return MaybeHandle<Code>();
+  }
+
   if (mode == Compiler::CONCURRENT) {
     if (GetOptimizedCodeLater(job.get())) {
       info.Detach();  // The background recompile job owns this now.
@@ -908,6 +956,11 @@ MaybeHandle<Code> GetBaselineCode(Handle<JSFunction> function) {
     return MaybeHandle<Code>();
   }
 
+  // The block counters of --block-coverage are only maintained in bytecode.
+  if (FLAG_block_coverage) {
+    return MaybeHandle<Code>();
+  }
+
   // TODO(4280): For now we do not switch generators to baseline code because
   // there might be suspended activations stored in generator objects on the
   // heap. We could eventually go directly to TurboFan in this case.
@@ -939,7 +992,9 @@ MaybeHandle<Code> GetBaselineCode(Handle<JSFunction> function) {
   Handle<SharedFunctionInfo> shared = info.shared_info();
   DCHECK_EQ(shared->language_mode(), info.literal()->language_mode());
 
-  // Compile baseline code using the full code generator.
+  // Compile baseline code using the full code generator, which cannot run
+  // without type feedback slots.
+  SharedFunctionInfo::EnsureFeedbackVector(shared);
   if (!Compiler::Analyze(info.parse_info()) ||
       !FullCodeGenerator::MakeCode(&info)) {
     if (!isolate->has_pending_exception()) isolate->StackOverflow();
@@ -1155,6 +1210,10 @@ Handle<SharedFunctionInfo> CompileToplevel(CompilationInfo* info) {
 
 bool Compiler::Analyze(ParseInfo* info) {
   DCHECK_NOT_NULL(info->literal());
+  Isolate* isolate = info->isolate();
+  RuntimeCallTimerScope runtime_timer(
+      isolate, &isolate->counters()->runtime_call_stats()->CompileAnalyse);
+  TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.compile"), "V8.CompileAnalyse");
   if (!Rewriter::Rewrite(info)) return false;
   if (!Scope::Analyze(info)) return false;
   if (!Renumber(info)) return false;
@@ -1360,6 +1419,78 @@ bool Compiler::EnsureDeoptimizationSupport(CompilationInfo* info) {
   return true;
 }
 
+void Compiler::CollectSourcePositions(Handle<SharedFunctionInfo> shared,
+                                      Handle<BytecodeArray> bytecode) {
+  if (!bytecode->omits_expression_positions()) return;
+  Isolate* isolate = shared->GetIsolate();
+  DCHECK(AllowCompilation::IsAllowed(isolate));
+  DCHECK(shared->allows_lazy_compilation_without_context());
+
+  // Do not clobber an exception being thrown and do not re-parse while a
+  // stack overflow is being reported.
+  StackLimitCheck check(isolate);
+  if (isolate->has_pending_exception() || check.HasOverflowed()) return;
+
+  VMState<COMPILER> state(isolate);
+  PostponeInterruptsScope postpone(isolate);
+  Zone zone(isolate->allocator());
+  ParseInfo parse_info(&zone, shared);
+  CompilationInfo info(&parse_info, Handle<JSFunction>::null());
+  info.MarkAsSourcePositionsEnabled();
+  if (!Compiler::ParseAndAnalyze(&parse_info)) {
+    isolate->clear_pending_exception();
+    return;
+  }
+  EnsureFeedbackVector(&info, FLAG_ignition_lazy_feedback_allocation);
+  if (!interpreter::Interpreter::MakeBytecode(&info)) {
+    isolate->clear_pending_exception();
+    return;
+  }
+
+  // Only expression positions differ between the two, install the new table
+  // unless the bytecode itself changed, e.g. because flags were modified.
+  Handle<BytecodeArray> regenerated = info.bytecode_array();
+  if (regenerated->length() != bytecode->length() ||
+      memcmp(regenerated->GetFirstBytecodeAddress(),
+             bytecode->GetFirstBytecodeAddress(), bytecode->length()) != 0) {
+    return;
+  }
+  bytecode->set_source_position_table(regenerated->source_position_table());
+  bytecode->set_omits_expression_positions(false);
+}
+
+MaybeHandle<Code> Compiler::CompileForSerialization(
+    Handle<SharedFunctionInfo> shared) {
+  Isolate* isolate = shared->GetIsolate();
+  DCHECK(AllowCompilation::IsAllowed(isolate));
+  DCHECK(shared->is_compiled());
+  if (!shared->allows_lazy_compilation_without_context()) {
+    return MaybeHandle<Code>();
+  }
+
+  VMState<COMPILER> state(isolate);
+  PostponeInterruptsScope postpone(isolate);
+  Zone zone(isolate->allocator());
+  ParseInfo parse_info(&zone, shared);
+  CompilationInfo info(&parse_info, Handle<JSFunction>::null());
+  if (shared->is_toplevel()) {
+    parse_info.set_global();
+    parse_info.set_toplevel();
+    parse_info.set_lazy(false);
+  }
+  info.PrepareForSerializing();
+  if (!Compiler::ParseAndAnalyze(&parse_info)) {
+    isolate->clear_pending_exception();
+    return MaybeHandle<Code>();
+  }
+  EnsureFeedbackVector(&info);
+  if (!FullCodeGenerator::MakeCode(&info)) {
+    isolate->clear_pending_exception();
+    return MaybeHandle<Code>();
+  }
+  return info.code();
+}
+
 MaybeHandle<JSFunction> Compiler::GetFunctionFromEval(
     Handle<String> source, Handle<SharedFunctionInfo> outer_info,
     Handle<Context> context, LanguageMode language_mode,
@@ -1482,6 +1613,30 @@ Handle<SharedFunctionInfo> Compiler::GetSharedFunctionInfoForScript(
     }
   }
 
+  // Scripts compiled without cached data from the embedder may be shared with
+  // other isolates through the process-wide code cache.
+  bool use_shared_code_cache =
+      FLAG_shared_code_cache && FLAG_serialize_toplevel &&
+      maybe_result.is_null() && extension == NULL &&
+      compile_options == ScriptCompiler::kNoCompileOptions &&
+      natives == NOT_NATIVES_CODE && !is_module &&
+      !isolate->debug()->is_loaded();
+  if (use_shared_code_cache) {
+    base::SmartPointer<ScriptData> shared_data(
+        SharedCodeCache::Get()->Lookup(source, script_name, line_offset,
+                                       column_offset, resource_options));
+    if (!shared_data.is_empty()) {
+      HistogramTimerScope timer(isolate->counters()->compile_deserialize());
+      TRACE_EVENT0("v8", "V8.CompileDeserialize");
+      Handle<SharedFunctionInfo> result;
+      if (CodeSerializer::Deserialize(isolate, shared_data.get(), source)
+              .ToHandle(&result)) {
+        compilation_cache->PutScript(source, context, language_mode, result);
+        return result;
+      }
+    }
+  }
+
   base::ElapsedTimer timer;
   if (FLAG_profile_deserialization && FLAG_serialize_toplevel &&
       compile_options == ScriptCompiler::kProduceCodeCache) {
@@ -1528,15 +1683,37 @@ Handle<SharedFunctionInfo> Compiler::GetSharedFunctionInfoForScript(
     parse_info.set_extension(extension);
     parse_info.set_context(context);
     if (FLAG_serialize_toplevel &&
-        compile_options == ScriptCompiler::kProduceCodeCache) {
+        (compile_options == ScriptCompiler::kProduceCodeCache ||
+         use_shared_code_cache)) {
       info.PrepareForSerializing();
     }
 
     parse_info.set_language_mode(
         static_cast<LanguageMode>(info.language_mode() | language_mode));
     result = CompileToplevel(&info);
+    if (FLAG_parser_cache_inner_functions && !result.is_null() &&
+        (compile_options == ScriptCompiler::kProduceParserCache ||
+         compile_options == ScriptCompiler::kConsumeParserCache) &&
+        *cached_data != NULL && !(*cached_data)->rejected()) {
+      // Keep the parser cache for lazy compilation of the script's functions.
+      Handle<ByteArray> preparse_data =
+          isolate->factory()->NewByteArray((*cached_data)->length(), TENURED);
+      preparse_data->copy_in(0, (*cached_data)->data(),
+                             (*cached_data)->length());
+      script->set_preparse_data(*preparse_data);
+    }
     if (extension == NULL && !result.is_null()) {
       compilation_cache->PutScript(source, context, language_mode, result);
+      if (use_shared_code_cache) {
+        HistogramTimerScope histogram_timer(
+            isolate->counters()->compile_serialize());
+        TRACE_EVENT0("v8", "V8.CompileSerialize");
+        base::SmartPointer<ScriptData> shared_data(
+            CodeSerializer::Serialize(isolate, result, source));
+        SharedCodeCache::Get()->Put(source, script_name, line_offset,
+                                    column_offset, resource_options,
+                                    shared_data.get());
+      }
       if (FLAG_serialize_toplevel &&
           compile_options == ScriptCompiler::kProduceCodeCache) {
         HistogramTimerScope histogram_timer(
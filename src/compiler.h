@@ -64,6 +64,16 @@ class Compiler : public AllStatic {
   static bool Analyze(ParseInfo* info);
   // Adds deoptimization support, requires ParseAndAnalyze.
   static bool EnsureDeoptimizationSupport(CompilationInfo* info);
+  // Recovers expression positions omitted from the source position table of
+  // {bytecode} by re-generating the bytecode of {shared}. This is best-effort,
+  // on failure the table keeps only statement positions.
+  static void CollectSourcePositions(Handle<SharedFunctionInfo> shared,
+                                     Handle<BytecodeArray> bytecode);
+  // Re-generates full-codegen code for the already compiled {shared} with
+  // the reloc info the code serializer needs, without installing it. The
+  // result is fresh code that has not been patched by running it.
+  MUST_USE_RESULT static MaybeHandle<Code> CompileForSerialization(
+      Handle<SharedFunctionInfo> shared);
 
   // ===========================================================================
   // The following family of methods instantiates new functions for scripts or
@@ -162,6 +172,7 @@ class CompilationInfo {
     kSourcePositionsEnabled = 1 << 15,
     kBailoutOnUninitialized = 1 << 16,
     kOptimizeFromBytecode = 1 << 17,
+    kFastRegisterAllocation = 1 << 18,
   };
 
   CompilationInfo(ParseInfo* parse_info, Handle<JSFunction> closure);
@@ -301,6 +312,12 @@ class CompilationInfo {
     return GetFlag(kOptimizeFromBytecode);
   }
 
+  void MarkAsFastRegisterAllocation() { SetFlag(kFastRegisterAllocation); }
+
+  bool is_fast_register_allocation() const {
+    return GetFlag(kFastRegisterAllocation);
+  }
+
   bool GeneratePreagedPrologue() const {
     // Generate a pre-aged prologue if we are optimizing for size, which
     // will make code flushing more aggressive. Only apply to Code::FUNCTION,
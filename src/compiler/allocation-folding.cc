@@ -0,0 +1,84 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/allocation-folding.h"
+
+#include "src/compiler/js-graph.h"
+#include "src/compiler/node-matchers.h"
+#include "src/compiler/node-properties.h"
+#include "src/heap/heap.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+namespace {
+
+bool HasSingleEffectUse(Node* node) {
+  int count = 0;
+  for (Edge const edge : node->use_edges()) {
+    if (NodeProperties::IsEffectEdge(edge) && ++count > 1) return false;
+  }
+  return count == 1;
+}
+
+}  // namespace
+
+AllocationFolding::~AllocationFolding() {}
+
+Reduction AllocationFolding::Reduce(Node* node) {
+  switch (node->opcode()) {
+    case IrOpcode::kAllocate:
+      return ReduceAllocate(node);
+    default:
+      break;
+  }
+  return NoChange();
+}
+
+Reduction AllocationFolding::ReduceAllocate(Node* node) {
+  DCHECK_EQ(IrOpcode::kAllocate, node->opcode());
+  NumberMatcher msize(node->InputAt(0));
+  if (!msize.HasValue()) return NoChange();
+  PretenureFlag const pretenure = OpParameter<PretenureFlag>(node->op());
+  Node* const control = NodeProperties::GetControlInput(node);
+
+  // Walk back to the previous allocation, skipping stores, which can neither
+  // trigger a GC nor observe the not yet initialized object. Every node on
+  // the way must flow only into {node}, otherwise the enlarged allocation
+  // could end up with an uninitialized tail on some path.
+  Node* group = NodeProperties::GetEffectInput(node);
+  while (group->opcode() == IrOpcode::kStoreField ||
+         group->opcode() == IrOpcode::kStoreElement) {
+    if (NodeProperties::GetControlInput(group) != control ||
+        !HasSingleEffectUse(group)) {
+      return NoChange();
+    }
+    group = NodeProperties::GetEffectInput(group);
+  }
+  if (group->opcode() != IrOpcode::kAllocate ||
+      OpParameter<PretenureFlag>(group->op()) != pretenure ||
+      NodeProperties::GetControlInput(group) != control ||
+      !HasSingleEffectUse(group)) {
+    return NoChange();
+  }
+  NumberMatcher mgroup_size(group->InputAt(0));
+  if (!mgroup_size.HasValue()) return NoChange();
+  double const size = mgroup_size.Value() + msize.Value();
+  if (size > Page::kMaxRegularHeapObjectSize) return NoChange();
+
+  // Grow the group allocation and turn {node} into an inner pointer.
+  group->ReplaceInput(0, jsgraph()->Constant(size));
+  Node* const value = jsgraph()->graph()->NewNode(
+      jsgraph()->machine()->BitcastWordToTagged(),
+      jsgraph()->graph()->NewNode(
+          jsgraph()->machine()->IntAdd(), group,
+          jsgraph()->IntPtrConstant(static_cast<int>(mgroup_size.Value()))));
+  ReplaceWithValue(node, value, NodeProperties::GetEffectInput(node));
+  return Replace(value);
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
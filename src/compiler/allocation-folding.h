@@ -0,0 +1,42 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_ALLOCATION_FOLDING_H_
+#define V8_COMPILER_ALLOCATION_FOLDING_H_
+
+#include "src/compiler/graph-reducer.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+// Forward declarations.
+class JSGraph;
+
+// Folds an Allocate node into the preceding Allocate node on the same effect
+// chain if only initializing stores separate them, so that both objects are
+// carved out of a single allocation with one limit check. Runs on the effect
+// linearized graph; the folded object becomes an inner pointer into the
+// enlarged allocation.
+class AllocationFolding final : public AdvancedReducer {
+ public:
+  AllocationFolding(Editor* editor, JSGraph* jsgraph)
+      : AdvancedReducer(editor), jsgraph_(jsgraph) {}
+  ~AllocationFolding() final;
+
+  Reduction Reduce(Node* node) final;
+
+ private:
+  Reduction ReduceAllocate(Node* node);
+
+  JSGraph* jsgraph() const { return jsgraph_; }
+
+  JSGraph* const jsgraph_;
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_ALLOCATION_FOLDING_H_
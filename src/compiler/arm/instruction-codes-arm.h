@@ -70,6 +70,9 @@ namespace compiler {
   V(ArmVmlsF64)                    \
   V(ArmVdivF64)                    \
   V(ArmVmodF64)                    \
+  V(ArmFloat64Sin)                 \
+  V(ArmFloat64Cos)                 \
+  V(ArmFloat64Tan)                 \
   V(ArmVabsF64)                    \
   V(ArmVnegF64)                    \
   V(ArmVsqrtF64)                   \
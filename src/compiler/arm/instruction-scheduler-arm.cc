@@ -72,6 +72,9 @@ int InstructionScheduler::GetTargetInstructionFlags(
     case kArmVmlsF64:
     case kArmVdivF64:
     case kArmVmodF64:
+    case kArmFloat64Sin:
+    case kArmFloat64Cos:
+    case kArmFloat64Tan:
     case kArmVabsF64:
     case kArmVnegF64:
     case kArmVsqrtF64:
@@ -1366,6 +1366,31 @@ void InstructionSelector::VisitFloat64RoundTiesEven(Node* node) {
   VisitRR(this, kArmVrintnF64, node);
 }
 
+namespace {
+
+// Calls an fdlibm function, which takes and returns its argument in d0.
+void VisitFloat64FdlibmUnop(InstructionSelector* selector, Node* node,
+                            ArchOpcode opcode) {
+  ArmOperandGenerator g(selector);
+  selector->Emit(opcode, g.DefineAsFixed(node, d0),
+                 g.UseFixed(node->InputAt(0), d0))
+      ->MarkAsCall();
+}
+
+}  // namespace
+
+void InstructionSelector::VisitFloat64Sin(Node* node) {
+  VisitFloat64FdlibmUnop(this, node, kArmFloat64Sin);
+}
+
+void InstructionSelector::VisitFloat64Cos(Node* node) {
+  VisitFloat64FdlibmUnop(this, node, kArmFloat64Cos);
+}
+
+void InstructionSelector::VisitFloat64Tan(Node* node) {
+  VisitFloat64FdlibmUnop(this, node, kArmFloat64Tan);
+}
+
 
 void InstructionSelector::EmitPrepareArguments(
     ZoneVector<PushParameter>* arguments, const CallDescriptor* descriptor,
@@ -1840,7 +1865,10 @@ MachineOperatorBuilder::Flags
 InstructionSelector::SupportedMachineOperatorFlags() {
   MachineOperatorBuilder::Flags flags =
       MachineOperatorBuilder::kInt32DivIsSafe |
-      MachineOperatorBuilder::kUint32DivIsSafe;
+      MachineOperatorBuilder::kUint32DivIsSafe |
+      MachineOperatorBuilder::kFloat64Sin |
+      MachineOperatorBuilder::kFloat64Cos |
+      MachineOperatorBuilder::kFloat64Tan;
   if (CpuFeatures::IsSupported(ARMv7)) {
     flags |= MachineOperatorBuilder::kWord32ReverseBits;
   }
@@ -185,7 +185,7 @@ class Arm64OperandConverter final : public InstructionOperandConverter {
       case Constant::kInt32:
         return Operand(constant.ToInt32());
       case Constant::kInt64:
-        if (constant.rmode() == RelocInfo::WASM_MEMORY_REFERENCE) {
+        if (RelocInfo::IsWasmReference(constant.rmode())) {
           return Operand(constant.ToInt64(), constant.rmode());
         } else {
           return Operand(constant.ToInt64());
@@ -479,6 +479,15 @@ Condition FlagsConditionToCondition(FlagsCondition condition) {
     __ Dmb(InnerShareable, BarrierAll);                               \
   } while (0)
 
+#define ASSEMBLE_FDLIBM_UNOP(name)                                           \
+  do {                                                                       \
+    FrameScope scope(masm(), StackFrame::MANUAL);                            \
+    DCHECK(d0.is(i.InputDoubleRegister(0)));                                 \
+    DCHECK(d0.is(i.OutputDoubleRegister()));                                 \
+    __ CallCFunction(ExternalReference::fdlibm_##name##_function(isolate()), \
+                     0, 1);                                                  \
+  } while (0)
+
 void CodeGenerator::AssembleDeconstructFrame() {
   const CallDescriptor* descriptor = linkage()->GetIncomingDescriptor();
   if (descriptor->IsCFunctionCall() || descriptor->UseNativeStack()) {
@@ -1190,6 +1199,15 @@ CodeGenerator::CodeGenResult CodeGenerator::AssembleArchInstruction(
                        0, 2);
       break;
     }
+    case kArm64Float64Sin:
+      ASSEMBLE_FDLIBM_UNOP(sin);
+      break;
+    case kArm64Float64Cos:
+      ASSEMBLE_FDLIBM_UNOP(cos);
+      break;
+    case kArm64Float64Tan:
+      ASSEMBLE_FDLIBM_UNOP(tan);
+      break;
     case kArm64Float64Max:
       // (b < a) ? a : b
       __ Fcmp(i.InputDoubleRegister(1), i.InputDoubleRegister(0));
@@ -99,6 +99,9 @@ namespace compiler {
   V(Arm64Float64Mul)               \
   V(Arm64Float64Div)               \
   V(Arm64Float64Mod)               \
+  V(Arm64Float64Sin)               \
+  V(Arm64Float64Cos)               \
+  V(Arm64Float64Tan)               \
   V(Arm64Float64Max)               \
   V(Arm64Float64Min)               \
   V(Arm64Float64Abs)               \
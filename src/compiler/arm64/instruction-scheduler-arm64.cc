@@ -93,6 +93,9 @@ int InstructionScheduler::GetTargetInstructionFlags(
     case kArm64Float64Mul:
     case kArm64Float64Div:
     case kArm64Float64Mod:
+    case kArm64Float64Sin:
+    case kArm64Float64Cos:
+    case kArm64Float64Tan:
     case kArm64Float64Max:
     case kArm64Float64Min:
     case kArm64Float64Abs:
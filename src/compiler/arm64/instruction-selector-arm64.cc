@@ -1626,6 +1626,35 @@ void InstructionSelector::VisitFloat64RoundTiesEven(Node* node) {
 }
 
 
+namespace {
+
+// Calls an fdlibm function, which takes and returns its argument in d0.
+void VisitFloat64FdlibmUnop(InstructionSelector* selector, Node* node,
+                            ArchOpcode opcode) {
+  Arm64OperandGenerator g(selector);
+  selector->Emit(opcode, g.DefineAsFixed(node, d0),
+                 g.UseFixed(node->InputAt(0), d0))
+      ->MarkAsCall();
+}
+
+}  // namespace
+
+
+void InstructionSelector::VisitFloat64Sin(Node* node) {
+  VisitFloat64FdlibmUnop(this, node, kArm64Float64Sin);
+}
+
+
+void InstructionSelector::VisitFloat64Cos(Node* node) {
+  VisitFloat64FdlibmUnop(this, node, kArm64Float64Cos);
+}
+
+
+void InstructionSelector::VisitFloat64Tan(Node* node) {
+  VisitFloat64FdlibmUnop(this, node, kArm64Float64Tan);
+}
+
+
 void InstructionSelector::EmitPrepareArguments(
     ZoneVector<PushParameter>* arguments, const CallDescriptor* descriptor,
     Node* node) {
@@ -2287,7 +2316,10 @@ InstructionSelector::SupportedMachineOperatorFlags() {
          MachineOperatorBuilder::kInt32DivIsSafe |
          MachineOperatorBuilder::kUint32DivIsSafe |
          MachineOperatorBuilder::kWord32ReverseBits |
-         MachineOperatorBuilder::kWord64ReverseBits;
+         MachineOperatorBuilder::kWord64ReverseBits |
+         MachineOperatorBuilder::kFloat64Sin |
+         MachineOperatorBuilder::kFloat64Cos |
+         MachineOperatorBuilder::kFloat64Tan;
 }
 
 }  // namespace compiler
@@ -4,9 +4,11 @@
 
 #include "src/compiler/bytecode-graph-builder.h"
 
+#include "src/compiler/access-builder.h"
 #include "src/compiler/bytecode-branch-analysis.h"
 #include "src/compiler/linkage.h"
 #include "src/compiler/operator-properties.h"
+#include "src/compiler/simplified-operator.h"
 #include "src/interpreter/bytecodes.h"
 
 namespace v8 {
@@ -60,6 +62,7 @@ class BytecodeGraphBuilder::Environment : public ZoneObject {
   Environment* CopyForConditional() const;
   Environment* CopyForLoop();
   void Merge(Environment* other);
+  void PrepareForOsr();
 
  private:
   explicit Environment(const Environment* copy);
@@ -353,6 +356,41 @@ void BytecodeGraphBuilder::Environment::PrepareForLoop() {
 }
 
 
+void BytecodeGraphBuilder::Environment::PrepareForOsr() {
+  DCHECK_EQ(IrOpcode::kLoop, GetControlDependency()->opcode());
+  DCHECK_EQ(1, GetControlDependency()->InputCount());
+  Node* start = graph()->start();
+
+  // Create a control node for the OSR entry point and merge it into the loop
+  // header. Update the current environment's control dependency accordingly.
+  Node* entry = graph()->NewNode(common()->OsrLoopEntry(), start, start);
+  Node* control = builder()->MergeControl(GetControlDependency(), entry);
+  UpdateControlDependency(control);
+
+  // Create a merge of the effect from the OSR entry and the existing effect
+  // dependency. Update the current environment's effect dependency accordingly.
+  Node* effect = builder()->MergeEffect(GetEffectDependency(), entry, control);
+  UpdateEffectDependency(effect);
+
+  // Rename all values in the environment which will extend or introduce Phi
+  // nodes to contain the OSR values available at the entry point.
+  Node* osr_context = graph()->NewNode(
+      common()->OsrValue(Linkage::kOsrContextSpillSlotIndex), entry);
+  context_ = builder()->MergeValue(context_, osr_context, control);
+  for (int i = 0; i < accumulator_base(); i++) {
+    int idx = i;  // Indexing scheme follows {StandardFrame}, adapt accordingly.
+    if (i >= register_base()) idx += InterpreterFrameConstants::kExtraSlotCount;
+    Node* osr_value = graph()->NewNode(common()->OsrValue(idx), entry);
+    values_[i] = builder()->MergeValue(values_[i], osr_value, control);
+  }
+
+  // The accumulator is dead at loop headers and hence not preserved in the
+  // interpreter frame, merge in a constant for the OSR entry.
+  Node* undefined = builder()->jsgraph()->UndefinedConstant();
+  values_[accumulator_base()] =
+      builder()->MergeValue(values_[accumulator_base()], undefined, control);
+}
+
 bool BytecodeGraphBuilder::Environment::StateValuesRequireUpdate(
     Node** state_values, int offset, int count) {
   if (!builder()->deoptimization_enabled_) {
@@ -449,6 +487,7 @@ BytecodeGraphBuilder::BytecodeGraphBuilder(Zone* local_zone,
           FrameStateType::kInterpretedFunction,
           bytecode_array()->parameter_count(),
           bytecode_array()->register_count(), info->shared_info())),
+      osr_ast_id_(info->osr_ast_id()),
       deoptimization_enabled_(info->is_deoptimization_enabled()),
       merge_environments_(local_zone),
       exception_handlers_(local_zone),
@@ -524,6 +563,12 @@ bool BytecodeGraphBuilder::CreateGraph() {
                   GetFunctionContext());
   set_environment(&env);
 
+  if (!osr_ast_id_.IsNone()) {
+    // Use OSR normal entry as the start of the top-level environment.
+    // It will be replaced with {Dead} after typing and optimizations.
+    NewNode(common()->OsrNormalEntry());
+  }
+
   VisitBytecodes();
 
   // Finish the basic structure of the graph.
@@ -1208,6 +1253,44 @@ void BytecodeGraphBuilder::VisitTestGreaterThanOrEqual() {
   BuildCompareOp(javascript()->GreaterThanOrEqual());
 }
 
+void BytecodeGraphBuilder::BuildCompareOpWithSmi(const Operator* js_op) {
+  FrameStateBeforeAndAfter states(this);
+  Node* left =
+      environment()->LookupRegister(bytecode_iterator().GetRegisterOperand(0));
+  Node* right =
+      jsgraph()->Constant(bytecode_iterator().GetImmediateOperand(1));
+  Node* node = NewNode(js_op, left, right);
+  environment()->BindAccumulator(node, &states);
+}
+
+void BytecodeGraphBuilder::VisitTestEqualSmi() {
+  BuildCompareOpWithSmi(javascript()->Equal());
+}
+
+void BytecodeGraphBuilder::VisitTestNotEqualSmi() {
+  BuildCompareOpWithSmi(javascript()->NotEqual());
+}
+
+void BytecodeGraphBuilder::VisitTestEqualStrictSmi() {
+  BuildCompareOpWithSmi(javascript()->StrictEqual());
+}
+
+void BytecodeGraphBuilder::VisitTestLessThanSmi() {
+  BuildCompareOpWithSmi(javascript()->LessThan());
+}
+
+void BytecodeGraphBuilder::VisitTestGreaterThanSmi() {
+  BuildCompareOpWithSmi(javascript()->GreaterThan());
+}
+
+void BytecodeGraphBuilder::VisitTestLessThanOrEqualSmi() {
+  BuildCompareOpWithSmi(javascript()->LessThanOrEqual());
+}
+
+void BytecodeGraphBuilder::VisitTestGreaterThanOrEqualSmi() {
+  BuildCompareOpWithSmi(javascript()->GreaterThanOrEqual());
+}
+
 void BytecodeGraphBuilder::VisitTestIn() {
   BuildCompareOp(javascript()->HasProperty());
 }
@@ -1300,6 +1383,27 @@ void BytecodeGraphBuilder::VisitStackCheck() {
   environment()->RecordAfterState(node, &states);
 }
 
+void BytecodeGraphBuilder::VisitOsrPoll() {
+  // The OSR entry is at the loop header, see {BuildLoopHeaderEnvironment}.
+}
+
+void BytecodeGraphBuilder::VisitIncBlockCounter() {
+  // Same as {Interpreter::DoIncBlockCounter}, masking the incremented count
+  // with Smi::kMaxValue keeps it in Smi range.
+  int slot_index = bytecode_iterator().GetIndexOperand(0);
+  FieldAccess access = AccessBuilder::ForFixedArraySlot(
+      TypeFeedbackVector::kReservedIndexCount + slot_index);
+  access.type = Type::SignedSmall();
+  Node* vector = jsgraph()->HeapConstant(feedback_vector());
+  Node* count = NewNode(simplified()->LoadField(access), vector);
+  Node* new_count =
+      NewNode(simplified()->NumberBitwiseAnd(),
+              NewNode(simplified()->NumberAdd(), count,
+                      jsgraph()->OneConstant()),
+              jsgraph()->Constant(Smi::kMaxValue));
+  NewNode(simplified()->StoreField(access), vector, new_count);
+}
+
 void BytecodeGraphBuilder::VisitReturn() {
   Node* control =
       NewNode(common()->Return(), environment()->LookupAccumulator());
@@ -1374,6 +1478,56 @@ void BytecodeGraphBuilder::VisitResumeGenerator() {
   UNIMPLEMENTED();
 }
 
+void BytecodeGraphBuilder::VisitSuspendGeneratorLive() {
+  UNIMPLEMENTED();
+}
+
+void BytecodeGraphBuilder::VisitResumeGeneratorLive() {
+  UNIMPLEMENTED();
+}
+
+// The first component of a superinstruction is a side-effect free
+// transfer. A deoptimization in the second component resumes at the start
+// of the superinstruction, which just repeats that transfer.
+
+void BytecodeGraphBuilder::VisitStarLdar() {
+  Node* value = environment()->LookupAccumulator();
+  environment()->BindRegister(bytecode_iterator().GetRegisterOperand(0), value);
+  value =
+      environment()->LookupRegister(bytecode_iterator().GetRegisterOperand(1));
+  environment()->BindAccumulator(value);
+}
+
+void BytecodeGraphBuilder::VisitLdarAdd() {
+  Node* right =
+      environment()->LookupRegister(bytecode_iterator().GetRegisterOperand(0));
+  environment()->BindAccumulator(right);
+  FrameStateBeforeAndAfter states(this);
+  Node* left =
+      environment()->LookupRegister(bytecode_iterator().GetRegisterOperand(1));
+  Node* node = NewNode(javascript()->Add(BinaryOperationHints::Any()), left,
+                       right);
+  environment()->BindAccumulator(node, &states);
+}
+
+void BytecodeGraphBuilder::VisitLdaSmiAdd() {
+  Node* right =
+      jsgraph()->Constant(bytecode_iterator().GetImmediateOperand(0));
+  environment()->BindAccumulator(right);
+  FrameStateBeforeAndAfter states(this);
+  Node* left =
+      environment()->LookupRegister(bytecode_iterator().GetRegisterOperand(1));
+  Node* node = NewNode(javascript()->Add(BinaryOperationHints::Any()), left,
+                       right);
+  environment()->BindAccumulator(node, &states);
+}
+
+void BytecodeGraphBuilder::VisitLdaSmiStar() {
+  Node* value = jsgraph()->Constant(bytecode_iterator().GetImmediateOperand(0));
+  environment()->BindAccumulator(value);
+  environment()->BindRegister(bytecode_iterator().GetRegisterOperand(1), value);
+}
+
 void BytecodeGraphBuilder::VisitWide() {
   // Consumed by the BytecodeArrayIterator.
   UNREACHABLE();
@@ -1403,6 +1557,12 @@ void BytecodeGraphBuilder::BuildLoopHeaderEnvironment(int current_offset) {
     // Add loop header and store a copy so we can connect merged back
     // edge inputs to the loop header.
     merge_environments_[current_offset] = environment()->CopyForLoop();
+
+    // The OSR entry point is the loop header targeted by the back edge that
+    // triggered on-stack replacement.
+    if (osr_ast_id_.ToInt() == current_offset) {
+      environment()->PrepareForOsr();
+    }
   }
 }
 
@@ -9,6 +9,7 @@
 #include "src/compiler/js-graph.h"
 #include "src/compiler/linkage.h"
 #include "src/compiler/machine-operator.h"
+#include "src/compiler/node-matchers.h"
 #include "src/compiler/node-properties.h"
 #include "src/compiler/operator-properties.h"
 #include "src/compiler/simplified-operator.h"
@@ -195,9 +196,72 @@ WriteBarrierKind ComputeWriteBarrierKind(BaseTaggedness base_is_tagged,
                                  input_type);
 }
 
+// The number of effects to look through for the allocation of a stored to
+// object, to keep the walks linear for large object literals.
+const int kMaxAllocationDistance = 32;
+
 }  // namespace
 
 
+Node* ChangeLowering::GetNewSpaceAllocation(Node* object) {
+  // Look through the inner pointers of folded allocations.
+  if (object->opcode() == IrOpcode::kBitcastWordToTagged) {
+    Node* const address = object->InputAt(0);
+    if (address->opcode() != IrOpcode::kInt32Add &&
+        address->opcode() != IrOpcode::kInt64Add) {
+      return nullptr;
+    }
+    object = address->InputAt(0);
+  }
+  Node* size;
+  if (object->opcode() == IrOpcode::kAllocate) {
+    if (OpParameter<PretenureFlag>(object->op()) != NOT_TENURED) {
+      return nullptr;
+    }
+    size = object->InputAt(0);
+  } else if (object->opcode() == IrOpcode::kCall) {
+    // The allocation may already have been lowered to a stub call.
+    HeapObjectMatcher mtarget(object->InputAt(0));
+    if (!mtarget.HasValue() ||
+        !mtarget.Value().is_identical_to(
+            CodeFactory::Allocate(isolate(), NOT_TENURED).code())) {
+      return nullptr;
+    }
+    size = object->InputAt(1);
+  } else {
+    return nullptr;
+  }
+  // Large objects are allocated in large object space even if not tenured.
+  NumberMatcher msize(size);
+  if (!msize.HasValue() || msize.Value() > Page::kMaxRegularHeapObjectSize) {
+    return nullptr;
+  }
+  return object;
+}
+
+
+bool ChangeLowering::IsFreshNewSpaceObject(Node* object, Node* effect) {
+  Node* const allocation = GetNewSpaceAllocation(object);
+  if (allocation == nullptr) return false;
+  for (int distance = 0; distance < kMaxAllocationDistance; ++distance) {
+    if (effect == allocation) return true;
+    switch (effect->opcode()) {
+      case IrOpcode::kLoad:
+      case IrOpcode::kLoadElement:
+      case IrOpcode::kLoadField:
+      case IrOpcode::kStore:
+      case IrOpcode::kStoreElement:
+      case IrOpcode::kStoreField:
+        effect = NodeProperties::GetEffectInput(effect);
+        break;
+      default:
+        return false;
+    }
+  }
+  return false;
+}
+
+
 Reduction ChangeLowering::LoadField(Node* node) {
   const FieldAccess& access = FieldAccessOf(node->op());
   Node* offset = jsgraph()->IntPtrConstant(access.offset - access.tag());
@@ -213,6 +277,11 @@ Reduction ChangeLowering::StoreField(Node* node) {
   WriteBarrierKind kind = ComputeWriteBarrierKind(
       access.base_is_tagged, access.machine_type.representation(),
       access.offset, access.type, type);
+  if (kind != kNoWriteBarrier &&
+      IsFreshNewSpaceObject(node->InputAt(0),
+                            NodeProperties::GetEffectInput(node))) {
+    kind = kNoWriteBarrier;
+  }
   Node* offset = jsgraph()->IntPtrConstant(access.offset - access.tag());
   node->InsertInput(graph()->zone(), 1, offset);
   NodeProperties::ChangeOp(node,
@@ -257,13 +326,18 @@ Reduction ChangeLowering::LoadElement(Node* node) {
 Reduction ChangeLowering::StoreElement(Node* node) {
   const ElementAccess& access = ElementAccessOf(node->op());
   Type* type = NodeProperties::GetType(node->InputAt(2));
+  WriteBarrierKind kind = ComputeWriteBarrierKind(
+      access.base_is_tagged, access.machine_type.representation(), access.type,
+      type);
+  if (kind != kNoWriteBarrier &&
+      IsFreshNewSpaceObject(node->InputAt(0),
+                            NodeProperties::GetEffectInput(node))) {
+    kind = kNoWriteBarrier;
+  }
   node->ReplaceInput(1, ComputeIndex(access, node->InputAt(1)));
   NodeProperties::ChangeOp(
       node, machine()->Store(StoreRepresentation(
-                access.machine_type.representation(),
-                ComputeWriteBarrierKind(access.base_is_tagged,
-                                        access.machine_type.representation(),
-                                        access.type, type))));
+                access.machine_type.representation(), kind)));
   return Changed(node);
 }
 
@@ -53,6 +53,14 @@ class ChangeLowering final : public Reducer {
   Reduction StoreElement(Node* node);
   Reduction Allocate(Node* node);
 
+  // Returns the allocation {object} points into if it is a new space
+  // allocation of a regular object, or nullptr otherwise.
+  Node* GetNewSpaceAllocation(Node* object);
+  // Stores into objects allocated in new space need no write barrier as long
+  // as no other allocation, and thus no GC or incremental marking step, can
+  // have happened since: the object is neither old nor marked yet.
+  bool IsFreshNewSpaceObject(Node* object, Node* effect);
+
   Node* IsSmi(Node* value);
   Node* LoadHeapObjectMap(Node* object, Node* control);
   Node* LoadMapBitField(Node* map);
@@ -28,7 +28,9 @@ EscapeAnalysisReducer::EscapeAnalysisReducer(Editor* editor, JSGraph* jsgraph,
       escape_analysis_(escape_analysis),
       zone_(zone),
       fully_reduced_(static_cast<int>(jsgraph->graph()->NodeCount() * 2), zone),
-      exists_virtual_allocate_(true) {}
+      exists_virtual_allocate_(true),
+      allocations_eliminated_(0),
+      loads_replaced_(0) {}
 
 
 Reduction EscapeAnalysisReducer::Reduce(Node* node) {
@@ -106,6 +108,7 @@ Reduction EscapeAnalysisReducer::ReduceLoad(Node* node) {
   }
   if (Node* rep = escape_analysis()->GetReplacement(node)) {
     counters()->turbo_escape_loads_replaced()->Increment();
+    loads_replaced_++;
     TRACE("Replaced #%d (%s) with #%d (%s)\n", node->id(),
           node->op()->mnemonic(), rep->id(), rep->op()->mnemonic());
     ReplaceWithValue(node, rep);
@@ -139,6 +142,7 @@ Reduction EscapeAnalysisReducer::ReduceAllocate(Node* node) {
   if (escape_analysis()->IsVirtual(node)) {
     RelaxEffectsAndControls(node);
     counters()->turbo_escape_allocs_replaced()->Increment();
+    allocations_eliminated_++;
     TRACE("Removed allocate #%d from effect chain\n", node->id());
     return Changed(node);
   }
@@ -183,7 +187,7 @@ Reduction EscapeAnalysisReducer::ReduceReferenceEqual(Node* node) {
         escape_analysis()->CompareVirtualObjects(left, right)) {
       ReplaceWithValue(node, jsgraph()->TrueConstant());
       TRACE("Replaced ref eq #%d with true\n", node->id());
-      Replace(jsgraph()->TrueConstant());
+      return Replace(jsgraph()->TrueConstant());
     }
     // Right-hand side is not a virtual object, or a different one.
     ReplaceWithValue(node, jsgraph()->FalseConstant());
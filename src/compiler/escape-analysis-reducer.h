@@ -34,6 +34,10 @@ class EscapeAnalysisReducer final : public AdvancedReducer {
   }
   void VerifyReplacement() const;
 
+  // Statistics for --turbo-escape-stats.
+  int allocations_eliminated() const { return allocations_eliminated_; }
+  int loads_replaced() const { return loads_replaced_; }
+
  private:
   Reduction ReduceLoad(Node* node);
   Reduction ReduceStore(Node* node);
@@ -59,6 +63,8 @@ class EscapeAnalysisReducer final : public AdvancedReducer {
   // and nodes that do not need a visit from ReduceDeoptState etc.
   BitVector fully_reduced_;
   bool exists_virtual_allocate_;
+  int allocations_eliminated_;
+  int loads_replaced_;
 
   DISALLOW_COPY_AND_ASSIGN(EscapeAnalysisReducer);
 };
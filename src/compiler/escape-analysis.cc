@@ -590,6 +590,16 @@ void EscapeStatusAnalysis::Process(Node* node) {
           RevisitInputs(rep);
           RevisitUses(rep);
         }
+      } else {
+        // A load from a phi of virtual objects must be replaced by a phi of
+        // the field values, otherwise the objects have to be materialized.
+        Node* from = NodeProperties::GetValueInput(node, 0);
+        if (from->opcode() == IrOpcode::kPhi && SetEscaped(from)) {
+          TRACE("Setting #%d (%s) to escaped because of unresolved load #%d\n",
+                from->id(), from->op()->mnemonic(), node->id());
+          RevisitInputs(from);
+          RevisitUses(from);
+        }
       }
       RevisitUses(node);
       break;
@@ -603,17 +613,20 @@ void EscapeStatusAnalysis::Process(Node* node) {
         RevisitInputs(node);
         RevisitUses(node);
       }
-      CheckUsesForEscape(node);
+      if (CheckUsesForEscape(node)) {
+        RevisitInputs(node);
+      }
+      break;
     default:
       break;
   }
 }
 
 bool EscapeStatusAnalysis::IsAllocationPhi(Node* node) {
-  for (Edge edge : node->input_edges()) {
-    Node* input = edge.to();
+  for (int i = 0; i < node->op()->ValueInputCount(); ++i) {
+    Node* input = NodeProperties::GetValueInput(node, i);
     if (input->opcode() == IrOpcode::kPhi && !IsEscaped(input)) continue;
-    if (IsAllocation(input)) continue;
+    if (IsAllocation(input) && !IsEscaped(input)) continue;
     return false;
   }
   return true;
@@ -623,6 +636,13 @@ void EscapeStatusAnalysis::ProcessStoreField(Node* node) {
   DCHECK_EQ(node->opcode(), IrOpcode::kStoreField);
   Node* to = NodeProperties::GetValueInput(node, 0);
   Node* val = NodeProperties::GetValueInput(node, 1);
+  // Stores through a phi cannot be attributed to a single virtual object.
+  if (to->opcode() == IrOpcode::kPhi && SetEscaped(to)) {
+    RevisitInputs(to);
+    RevisitUses(to);
+    TRACE("Setting #%d (%s) to escaped because of store to it\n", to->id(),
+          to->op()->mnemonic());
+  }
   if ((IsEscaped(to) || !IsAllocation(to)) && SetEscaped(val)) {
     RevisitUses(val);
     RevisitInputs(val);
@@ -635,6 +655,13 @@ void EscapeStatusAnalysis::ProcessStoreElement(Node* node) {
   DCHECK_EQ(node->opcode(), IrOpcode::kStoreElement);
   Node* to = NodeProperties::GetValueInput(node, 0);
   Node* val = NodeProperties::GetValueInput(node, 2);
+  // Stores through a phi cannot be attributed to a single virtual object.
+  if (to->opcode() == IrOpcode::kPhi && SetEscaped(to)) {
+    RevisitInputs(to);
+    RevisitUses(to);
+    TRACE("Setting #%d (%s) to escaped because of store to it\n", to->id(),
+          to->op()->mnemonic());
+  }
   if ((IsEscaped(to) || !IsAllocation(to)) && SetEscaped(val)) {
     RevisitUses(val);
     RevisitInputs(val);
@@ -662,13 +689,12 @@ void EscapeStatusAnalysis::ProcessAllocate(Node* node) {
       return;
     }
   }
-  if (CheckUsesForEscape(node, true)) {
+  if (CheckUsesForEscape(node)) {
     RevisitUses(node);
   }
 }
 
-bool EscapeStatusAnalysis::CheckUsesForEscape(Node* uses, Node* rep,
-                                              bool phi_escaping) {
+bool EscapeStatusAnalysis::CheckUsesForEscape(Node* uses, Node* rep) {
   for (Edge edge : uses->use_edges()) {
     Node* use = edge.from();
     if (IsNotReachable(use)) continue;
@@ -676,23 +702,23 @@ bool EscapeStatusAnalysis::CheckUsesForEscape(Node* uses, Node* rep,
                             OperatorProperties::GetContextInputCount(use->op()))
       continue;
     switch (use->opcode()) {
-      case IrOpcode::kPhi:
-        if (phi_escaping && SetEscaped(rep)) {
-          TRACE(
-              "Setting #%d (%s) to escaped because of use by phi node "
-              "#%d (%s)\n",
-              rep->id(), rep->op()->mnemonic(), use->id(),
-              use->op()->mnemonic());
+      case IrOpcode::kFrameState:
+      case IrOpcode::kStateValues:
+      case IrOpcode::kReferenceEqual:
+        // The deoptimizer can only materialize allocations, not phis of
+        // them, and reference equality on a phi depends on the path taken.
+        if (uses->opcode() == IrOpcode::kPhi && SetEscaped(rep)) {
+          TRACE("Setting #%d (%s) to escaped because of use by #%d (%s)\n",
+                rep->id(), rep->op()->mnemonic(), use->id(),
+                use->op()->mnemonic());
           return true;
         }
       // Fallthrough.
+      case IrOpcode::kPhi:
       case IrOpcode::kStoreField:
       case IrOpcode::kLoadField:
       case IrOpcode::kStoreElement:
       case IrOpcode::kLoadElement:
-      case IrOpcode::kFrameState:
-      case IrOpcode::kStateValues:
-      case IrOpcode::kReferenceEqual:
       case IrOpcode::kFinishRegion:
         if (IsEscaped(use) && SetEscaped(rep)) {
           TRACE(
@@ -720,12 +746,7 @@ bool EscapeStatusAnalysis::CheckUsesForEscape(Node* uses, Node* rep,
         }
         break;
       default:
-        if (use->op()->EffectInputCount() == 0 &&
-            uses->op()->EffectInputCount() > 0) {
-          TRACE("Encountered unaccounted use by #%d (%s)\n", use->id(),
-                use->op()->mnemonic());
-          UNREACHABLE();
-        }
+        // Unknown uses are treated conservatively.
         if (SetEscaped(rep)) {
           TRACE("Setting #%d (%s) to escaped because of use by #%d (%s)\n",
                 rep->id(), rep->op()->mnemonic(), use->id(),
@@ -743,7 +764,7 @@ void EscapeStatusAnalysis::ProcessFinishRegion(Node* node) {
     status_[node->id()] |= kTracked;
     RevisitUses(node);
   }
-  if (CheckUsesForEscape(node, true)) {
+  if (CheckUsesForEscape(node)) {
     RevisitInputs(node);
   }
 }
@@ -1458,14 +1479,17 @@ Node* EscapeAnalysis::GetOrCreateObjectState(Node* effect, Node* node) {
             "#%d\n",
             new_object_state->id(), static_cast<void*>(vobj), node->id(),
             effect->id());
-        // Now fix uses of other objects.
+        // Now fix uses of other objects. Empty fields are not part of the
+        // object state, so the input index can lag behind the field index.
+        int input_index = 0;
         for (size_t i = 0; i < vobj->field_count(); ++i) {
           if (Node* field = vobj->GetField(i)) {
             if (Node* field_object_state =
                     GetOrCreateObjectState(effect, field)) {
               NodeProperties::ReplaceValueInput(
-                  new_object_state, field_object_state, static_cast<int>(i));
+                  new_object_state, field_object_state, input_index);
             }
+            ++input_index;
           }
         }
         return new_object_state;
@@ -80,10 +80,10 @@ class EscapeStatusAnalysis {
   void ProcessFinishRegion(Node* node);
   void ProcessStoreField(Node* node);
   void ProcessStoreElement(Node* node);
-  bool CheckUsesForEscape(Node* node, bool phi_escaping = false) {
-    return CheckUsesForEscape(node, node, phi_escaping);
+  bool CheckUsesForEscape(Node* node) {
+    return CheckUsesForEscape(node, node);
   }
-  bool CheckUsesForEscape(Node* node, Node* rep, bool phi_escaping = false);
+  bool CheckUsesForEscape(Node* node, Node* rep);
   void RevisitUses(Node* node);
   void RevisitInputs(Node* node);
 
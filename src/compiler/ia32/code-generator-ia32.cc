@@ -66,7 +66,7 @@ class IA32OperandConverter : public InstructionOperandConverter {
   Immediate ToImmediate(InstructionOperand* operand) {
     Constant constant = ToConstant(operand);
     if (constant.type() == Constant::kInt32 &&
-        constant.rmode() == RelocInfo::WASM_MEMORY_REFERENCE) {
+        RelocInfo::IsWasmReference(constant.rmode())) {
       return Immediate(reinterpret_cast<Address>(constant.ToInt32()),
                        constant.rmode());
     }
@@ -335,6 +335,20 @@ class OutOfLineRecordWrite final : public OutOfLineCode {
     __ bind(&done);                                          \
   } while (false)
 
+// Calls an fdlibm function on xmm0. The result is returned in st(0) on ia32,
+// and moved into xmm0.
+#define ASSEMBLE_FDLIBM_UNOP(name)                                           \
+  do {                                                                       \
+    __ PrepareCallCFunction(2, eax);                                         \
+    __ movsd(Operand(esp, 0), i.InputDoubleRegister(0));                     \
+    __ CallCFunction(ExternalReference::fdlibm_##name##_function(isolate()), \
+                     2);                                                     \
+    __ sub(esp, Immediate(kDoubleSize));                                     \
+    __ fstp_d(Operand(esp, 0));                                              \
+    __ movsd(i.OutputDoubleRegister(), Operand(esp, 0));                     \
+    __ add(esp, Immediate(kDoubleSize));                                     \
+  } while (false)
+
 #define ASSEMBLE_COMPARE(asm_instr)                                   \
   do {                                                                \
     if (AddressingModeField::decode(instr->opcode()) != kMode_None) { \
@@ -925,6 +939,15 @@ CodeGenerator::CodeGenResult CodeGenerator::AssembleArchInstruction(
     case kSSEFloat64Sqrt:
       __ sqrtsd(i.OutputDoubleRegister(), i.InputOperand(0));
       break;
+    case kIA32Float64Sin:
+      ASSEMBLE_FDLIBM_UNOP(sin);
+      break;
+    case kIA32Float64Cos:
+      ASSEMBLE_FDLIBM_UNOP(cos);
+      break;
+    case kIA32Float64Tan:
+      ASSEMBLE_FDLIBM_UNOP(tan);
+      break;
     case kSSEFloat64Round: {
       CpuFeatureScope sse_scope(masm(), SSE4_1);
       RoundingMode const mode =
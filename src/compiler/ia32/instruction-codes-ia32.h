@@ -60,6 +60,9 @@ namespace compiler {
   V(SSEFloat64Mul)                 \
   V(SSEFloat64Div)                 \
   V(SSEFloat64Mod)                 \
+  V(IA32Float64Sin)                \
+  V(IA32Float64Cos)                \
+  V(IA32Float64Tan)                \
   V(SSEFloat64Max)                 \
   V(SSEFloat64Min)                 \
   V(SSEFloat64Abs)                 \
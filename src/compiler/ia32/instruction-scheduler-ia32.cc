@@ -63,6 +63,9 @@ int InstructionScheduler::GetTargetInstructionFlags(
     case kSSEFloat64Mul:
     case kSSEFloat64Div:
     case kSSEFloat64Mod:
+    case kIA32Float64Sin:
+    case kIA32Float64Cos:
+    case kIA32Float64Tan:
     case kSSEFloat64Max:
     case kSSEFloat64Min:
     case kSSEFloat64Abs:
@@ -1060,6 +1060,36 @@ void InstructionSelector::VisitFloat64RoundTiesEven(Node* node) {
 }
 
 
+namespace {
+
+// Calls an fdlibm function. The argument is passed on the stack, and the
+// result is returned in xmm0 by the code generator.
+void VisitFloat64FdlibmUnop(InstructionSelector* selector, Node* node,
+                            ArchOpcode opcode) {
+  IA32OperandGenerator g(selector);
+  selector->Emit(opcode, g.DefineAsFixed(node, xmm0),
+                 g.UseFixed(node->InputAt(0), xmm0))
+      ->MarkAsCall();
+}
+
+}  // namespace
+
+
+void InstructionSelector::VisitFloat64Sin(Node* node) {
+  VisitFloat64FdlibmUnop(this, node, kIA32Float64Sin);
+}
+
+
+void InstructionSelector::VisitFloat64Cos(Node* node) {
+  VisitFloat64FdlibmUnop(this, node, kIA32Float64Cos);
+}
+
+
+void InstructionSelector::VisitFloat64Tan(Node* node) {
+  VisitFloat64FdlibmUnop(this, node, kIA32Float64Tan);
+}
+
+
 void InstructionSelector::EmitPrepareArguments(
     ZoneVector<PushParameter>* arguments, const CallDescriptor* descriptor,
     Node* node) {
@@ -1585,7 +1615,10 @@ InstructionSelector::SupportedMachineOperatorFlags() {
       MachineOperatorBuilder::kFloat64Max |
       MachineOperatorBuilder::kFloat64Min |
       MachineOperatorBuilder::kWord32ShiftIsSafe |
-      MachineOperatorBuilder::kWord32Ctz;
+      MachineOperatorBuilder::kWord32Ctz |
+      MachineOperatorBuilder::kFloat64Sin |
+      MachineOperatorBuilder::kFloat64Cos |
+      MachineOperatorBuilder::kFloat64Tan;
   if (CpuFeatures::IsSupported(POPCNT)) {
     flags |= MachineOperatorBuilder::kWord32Popcnt;
   }
@@ -158,6 +158,18 @@ Reduction JSBuiltinReducer::ReduceMathClz32(Node* node) {
   return NoChange();
 }
 
+// ES6 section 20.2.2.12 Math.cos ( x )
+Reduction JSBuiltinReducer::ReduceMathCos(Node* node) {
+  JSCallReduction r(node);
+  if (r.InputsMatchOne(Type::Number()) &&
+      machine()->Float64Cos().IsSupported()) {
+    // Math.cos(a:number) -> Float64Cos(a)
+    Node* value = graph()->NewNode(machine()->Float64Cos().op(), r.left());
+    return Replace(value);
+  }
+  return NoChange();
+}
+
 // ES6 draft 08-24-14, section 20.2.2.16.
 Reduction JSBuiltinReducer::ReduceMathFloor(Node* node) {
   JSCallReduction r(node);
@@ -192,6 +204,18 @@ Reduction JSBuiltinReducer::ReduceMathRound(Node* node) {
   return NoChange();
 }
 
+// ES6 section 20.2.2.30 Math.sin ( x )
+Reduction JSBuiltinReducer::ReduceMathSin(Node* node) {
+  JSCallReduction r(node);
+  if (r.InputsMatchOne(Type::Number()) &&
+      machine()->Float64Sin().IsSupported()) {
+    // Math.sin(a:number) -> Float64Sin(a)
+    Node* value = graph()->NewNode(machine()->Float64Sin().op(), r.left());
+    return Replace(value);
+  }
+  return NoChange();
+}
+
 // ES6 section 20.2.2.32 Math.sqrt ( x )
 Reduction JSBuiltinReducer::ReduceMathSqrt(Node* node) {
   JSCallReduction r(node);
@@ -203,6 +227,18 @@ Reduction JSBuiltinReducer::ReduceMathSqrt(Node* node) {
   return NoChange();
 }
 
+// ES6 section 20.2.2.33 Math.tan ( x )
+Reduction JSBuiltinReducer::ReduceMathTan(Node* node) {
+  JSCallReduction r(node);
+  if (r.InputsMatchOne(Type::Number()) &&
+      machine()->Float64Tan().IsSupported()) {
+    // Math.tan(a:number) -> Float64Tan(a)
+    Node* value = graph()->NewNode(machine()->Float64Tan().op(), r.left());
+    return Replace(value);
+  }
+  return NoChange();
+}
+
 // ES6 section 20.2.2.35 Math.trunc ( x )
 Reduction JSBuiltinReducer::ReduceMathTrunc(Node* node) {
   JSCallReduction r(node);
@@ -230,6 +266,9 @@ Reduction JSBuiltinReducer::Reduce(Node* node) {
     case kMathClz32:
       reduction = ReduceMathClz32(node);
       break;
+    case kMathCos:
+      reduction = ReduceMathCos(node);
+      break;
     case kMathCeil:
       reduction = ReduceMathCeil(node);
       break;
@@ -242,9 +281,15 @@ Reduction JSBuiltinReducer::Reduce(Node* node) {
     case kMathRound:
       reduction = ReduceMathRound(node);
       break;
+    case kMathSin:
+      reduction = ReduceMathSin(node);
+      break;
     case kMathSqrt:
       reduction = ReduceMathSqrt(node);
       break;
+    case kMathTan:
+      reduction = ReduceMathTan(node);
+      break;
     case kMathTrunc:
       reduction = ReduceMathTrunc(node);
       break;
@@ -43,6 +43,8 @@ Reduction JSCallReducer::Reduce(Node* node) {
       return ReduceJSCallConstruct(node);
     case IrOpcode::kJSCallFunction:
       return ReduceJSCallFunction(node);
+    case IrOpcode::kJSCallRuntime:
+      return ReduceJSCallRuntime(node);
     default:
       break;
   }
@@ -497,6 +499,24 @@ Reduction JSCallReducer::ReduceJSCallConstruct(Node* node) {
 }
 
 
+Reduction JSCallReducer::ReduceJSCallRuntime(Node* node) {
+  DCHECK_EQ(IrOpcode::kJSCallRuntime, node->opcode());
+  CallRuntimeParameters const& p = CallRuntimeParametersOf(node->op());
+
+  // Turn %_Call into a proper JSCallFunction already during inlining (instead
+  // of waiting for the JSIntrinsicLowering), so that the callbacks passed to
+  // the JavaScript builtins become inlining candidates themselves.
+  if (p.id() == Runtime::kInlineCall) {
+    NodeProperties::ChangeOp(
+        node, javascript()->CallFunction(p.arity(), VectorSlotPair(),
+                                         ConvertReceiverMode::kAny,
+                                         TailCallMode::kDisallow));
+    return Changed(node);
+  }
+  return NoChange();
+}
+
+
 MaybeHandle<Context> JSCallReducer::GetNativeContext(Node* node) {
   Node* const context = NodeProperties::GetContextInput(node);
   return NodeProperties::GetSpecializationNativeContext(context,
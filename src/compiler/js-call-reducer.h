@@ -42,6 +42,7 @@ class JSCallReducer final : public Reducer {
   Reduction ReduceFunctionPrototypeCall(Node* node);
   Reduction ReduceJSCallConstruct(Node* node);
   Reduction ReduceJSCallFunction(Node* node);
+  Reduction ReduceJSCallRuntime(Node* node);
 
   MaybeHandle<Context> GetNativeContext(Node* node);
 
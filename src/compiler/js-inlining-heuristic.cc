@@ -5,13 +5,37 @@
 #include "src/compiler/js-inlining-heuristic.h"
 
 #include "src/compiler.h"
+#include "src/compiler/common-operator.h"
 #include "src/compiler/node-matchers.h"
+#include "src/compiler/simplified-operator.h"
 #include "src/objects-inl.h"
 
 namespace v8 {
 namespace internal {
 namespace compiler {
 
+namespace {
+
+// The array iteration builtins are implemented in JavaScript and are only
+// worth calling out-of-line if the callback is unknown; everywhere else
+// inlining them (and transitively the callback) pays off.
+bool IsInlineableArrayBuiltin(Handle<SharedFunctionInfo> shared) {
+  if (!FLAG_turbo_inline_array_builtins) return false;
+  if (!shared->HasBuiltinFunctionId()) return false;
+  switch (shared->builtin_function_id()) {
+    case kArrayForEach:
+    case kArrayMap:
+    case kArrayFilter:
+    case kArrayReduce:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+
 Reduction JSInliningHeuristic::Reduce(Node* node) {
   if (!IrOpcode::IsInlineeOpcode(node->opcode())) return NoChange();
 
@@ -19,13 +43,21 @@ Reduction JSInliningHeuristic::Reduce(Node* node) {
   if (seen_.find(node->id()) != seen_.end()) return NoChange();
   seen_.insert(node->id());
 
-  Node* callee = node->InputAt(0);
-  HeapObjectMatcher match(callee);
-  if (!match.HasValue() || !match.Value()->IsJSFunction()) return NoChange();
-  Handle<JSFunction> function = Handle<JSFunction>::cast(match.Value());
+  Candidate candidate;
+  candidate.node = node;
+  candidate.num_functions = CollectFunctions(node->InputAt(0),
+                                             candidate.functions);
+  if (candidate.num_functions == 0) return NoChange();
+  if (candidate.num_functions > 1) {
+    // Only plain calls are dispatched on the target; constructor calls would
+    // need the {new_target} to be specialized as well.
+    if (!FLAG_polymorphic_inlining) return NoChange();
+    if (node->opcode() != IrOpcode::kJSCallFunction) return NoChange();
+  }
+  Handle<JSFunction> function = candidate.functions[0];
 
   // Functions marked with %SetForceInlineFlag are immediately inlined.
-  if (function->shared()->force_inline()) {
+  if (candidate.num_functions == 1 && function->shared()->force_inline()) {
     return inliner_.ReduceJSCall(node, function);
   }
 
@@ -36,7 +68,7 @@ Reduction JSInliningHeuristic::Reduce(Node* node) {
     case kRestrictedInlining:
       return NoChange();
     case kStressInlining:
-      return inliner_.ReduceJSCall(node, function);
+      return InlineCandidate(candidate);
     case kGeneralInlining:
       break;
   }
@@ -45,26 +77,11 @@ Reduction JSInliningHeuristic::Reduce(Node* node) {
   // Everything below this line is part of the inlining heuristic.
   // ---------------------------------------------------------------------------
 
-  // Built-in functions are handled by the JSBuiltinReducer.
-  if (function->shared()->HasBuiltinFunctionId()) return NoChange();
-
-  // Don't inline builtins.
-  if (function->shared()->IsBuiltin()) return NoChange();
-
-  // Quick check on source code length to avoid parsing large candidate.
-  if (function->shared()->SourceSize() > FLAG_max_inlined_source_size) {
-    return NoChange();
-  }
-
-  // Quick check on the size of the AST to avoid parsing large candidate.
-  if (function->shared()->ast_node_count() > FLAG_max_inlined_nodes) {
-    return NoChange();
+  // All known targets must be worth inlining.
+  for (int i = 0; i < candidate.num_functions; ++i) {
+    if (!CanInlineFunction(candidate.functions[i])) return NoChange();
   }
 
-  // Avoid inlining within or across the boundary of asm.js code.
-  if (info_->shared_info()->asm_function()) return NoChange();
-  if (function->shared()->asm_function()) return NoChange();
-
   // Stop inlinining once the maximum allowed level is reached.
   int level = 0;
   for (Node* frame_state = NodeProperties::GetFrameStateInput(node, 0);
@@ -89,7 +106,8 @@ Reduction JSInliningHeuristic::Reduce(Node* node) {
   // ---------------------------------------------------------------------------
 
   // In the general case we remember the candidate for later.
-  candidates_.insert({function, node, calls});
+  candidate.calls = calls;
+  candidates_.insert(candidate);
   return NoChange();
 }
 
@@ -109,9 +127,16 @@ void JSInliningHeuristic::Finalize() {
     candidates_.erase(i);
     // Make sure we don't try to inline dead candidate nodes.
     if (!candidate.node->IsDead()) {
-      Reduction r = inliner_.ReduceJSCall(candidate.node, candidate.function);
+      // Polymorphic call sites inline all of their targets at once, so
+      // they must fit into the remaining budget as a whole.
+      int const size = CandidateSize(candidate);
+      if (candidate.num_functions > 1 &&
+          cumulative_count_ + size > FLAG_max_inlined_nodes_cumulative) {
+        continue;
+      }
+      Reduction r = InlineCandidate(candidate);
       if (r.Changed()) {
-        cumulative_count_ += candidate.function->shared()->ast_node_count();
+        cumulative_count_ += size;
         return;
       }
     }
@@ -128,17 +153,192 @@ bool JSInliningHeuristic::CandidateCompare::operator()(
 }
 
 
+int JSInliningHeuristic::CollectFunctions(Node* callee,
+                                          Handle<JSFunction>* functions) {
+  HeapObjectMatcher m(callee);
+  if (m.HasValue() && m.Value()->IsJSFunction()) {
+    functions[0] = Handle<JSFunction>::cast(m.Value());
+    return 1;
+  }
+  if (callee->opcode() == IrOpcode::kPhi) {
+    int const value_input_count = callee->op()->ValueInputCount();
+    if (value_input_count > kMaxCallPolymorphism) return 0;
+    for (int n = 0; n < value_input_count; ++n) {
+      HeapObjectMatcher mn(callee->InputAt(n));
+      if (!mn.HasValue() || !mn.Value()->IsJSFunction()) return 0;
+      functions[n] = Handle<JSFunction>::cast(mn.Value());
+    }
+    return value_input_count;
+  }
+  return 0;
+}
+
+
+bool JSInliningHeuristic::CanInlineFunction(
+    Handle<JSFunction> function) const {
+  Handle<SharedFunctionInfo> shared(function->shared());
+  if (!IsInlineableArrayBuiltin(shared)) {
+    // Built-in functions are handled by the JSBuiltinReducer.
+    if (shared->HasBuiltinFunctionId()) return false;
+
+    // Don't inline builtins.
+    if (shared->IsBuiltin()) return false;
+  }
+
+  // Quick check on source code length to avoid parsing large candidate.
+  if (function->shared()->SourceSize() > FLAG_max_inlined_source_size) {
+    return false;
+  }
+
+  // Quick check on the size of the AST to avoid parsing large candidate.
+  if (function->shared()->ast_node_count() > FLAG_max_inlined_nodes) {
+    return false;
+  }
+
+  // Avoid inlining within or across the boundary of asm.js code.
+  if (info_->shared_info()->asm_function()) return false;
+  if (function->shared()->asm_function()) return false;
+  return true;
+}
+
+
+Reduction JSInliningHeuristic::InlineCandidate(Candidate const& candidate) {
+  int const num_calls = candidate.num_functions;
+  Node* const node = candidate.node;
+  if (num_calls == 1) {
+    return inliner_.ReduceJSCall(node, candidate.functions[0]);
+  }
+  if (FLAG_trace_turbo_inlining) {
+    PrintF("Inlining polymorphic call site #%d with %d targets\n", node->id(),
+           num_calls);
+  }
+
+  // Expand the call {node} into a dispatch on the callee, with one cloned
+  // call per known target, and the original (generic) call as fallback.
+  Node* calls[kMaxCallPolymorphism + 2];
+  Node* if_successes[kMaxCallPolymorphism + 1];
+  Node* callee = NodeProperties::GetValueInput(node, 0);
+  Node* fallthrough_control = NodeProperties::GetControlInput(node);
+
+  // Check if we have an exception projection for the call {node}.
+  Node* if_exception = nullptr;
+  for (Edge const edge : node->use_edges()) {
+    if (NodeProperties::IsControlEdge(edge) &&
+        edge.from()->opcode() == IrOpcode::kIfException) {
+      if_exception = edge.from();
+      break;
+    }
+  }
+
+  // Setup the inputs for the cloned call nodes.
+  int const input_count = node->InputCount();
+  Node** inputs = graph()->zone()->NewArray<Node*>(input_count);
+  for (int i = 0; i < input_count; ++i) {
+    inputs[i] = node->InputAt(i);
+  }
+
+  // Create the control flow to dispatch to the cloned calls. The first input
+  // to a call is the target (which we specialize to the known function), the
+  // last input is the control dependency.
+  for (int i = 0; i <= num_calls; ++i) {
+    Node* control = fallthrough_control;
+    if (i < num_calls) {
+      Node* target = jsgraph()->HeapConstant(candidate.functions[i]);
+      Node* check = graph()->NewNode(simplified()->ReferenceEqual(Type::Any()),
+                                     callee, target);
+      Node* branch =
+          graph()->NewNode(common()->Branch(), check, fallthrough_control);
+      fallthrough_control = graph()->NewNode(common()->IfFalse(), branch);
+      control = graph()->NewNode(common()->IfTrue(), branch);
+      inputs[0] = target;
+    } else {
+      inputs[0] = callee;
+    }
+    inputs[input_count - 1] = control;
+    calls[i] = graph()->NewNode(node->op(), input_count, inputs);
+    seen_.insert(calls[i]->id());
+    if_successes[i] =
+        if_exception == nullptr
+            ? calls[i]
+            : graph()->NewNode(common()->IfSuccess(), calls[i]);
+  }
+  int const num_outputs = num_calls + 1;
+
+  if (if_exception != nullptr) {
+    // Morph the {if_exception} projection into a join.
+    IfExceptionHint const hint = OpParameter<IfExceptionHint>(if_exception);
+    Node* if_exceptions[kMaxCallPolymorphism + 2];
+    for (int i = 0; i < num_outputs; ++i) {
+      if_exceptions[i] =
+          graph()->NewNode(common()->IfException(hint), calls[i], calls[i]);
+    }
+    Node* exception_control = graph()->NewNode(
+        common()->Merge(num_outputs), num_outputs, if_exceptions);
+    if_exceptions[num_outputs] = exception_control;
+    Node* exception_effect =
+        graph()->NewNode(common()->EffectPhi(num_outputs), num_outputs + 1,
+                         if_exceptions);
+    Node* exception_value = graph()->NewNode(
+        common()->Phi(MachineRepresentation::kTagged, num_outputs),
+        num_outputs + 1, if_exceptions);
+    ReplaceWithValue(if_exception, exception_value, exception_effect,
+                     exception_control);
+  }
+
+  // Morph the call site into the dispatched call sites.
+  Node* control = graph()->NewNode(common()->Merge(num_outputs), num_outputs,
+                                   if_successes);
+  calls[num_outputs] = control;
+  Node* effect = graph()->NewNode(common()->EffectPhi(num_outputs),
+                                  num_outputs + 1, calls);
+  Node* value = graph()->NewNode(
+      common()->Phi(MachineRepresentation::kTagged, num_outputs),
+      num_outputs + 1, calls);
+  ReplaceWithValue(node, value, effect, control);
+
+  // Inline the individual, cloned call sites.
+  for (int i = 0; i < num_calls; ++i) {
+    inliner_.ReduceJSCall(calls[i], candidate.functions[i]);
+  }
+  return Replace(value);
+}
+
+
+int JSInliningHeuristic::CandidateSize(Candidate const& candidate) {
+  int size = 0;
+  for (int i = 0; i < candidate.num_functions; ++i) {
+    size += candidate.functions[i]->shared()->ast_node_count();
+  }
+  return size;
+}
+
+
 void JSInliningHeuristic::PrintCandidates() {
   PrintF("Candidates for inlining (size=%zu):\n", candidates_.size());
   for (const Candidate& candidate : candidates_) {
-    PrintF("  id:%d, calls:%d, size[source]:%d, size[ast]:%d / %s\n",
-           candidate.node->id(), candidate.calls,
-           candidate.function->shared()->SourceSize(),
-           candidate.function->shared()->ast_node_count(),
-           candidate.function->shared()->DebugName()->ToCString().get());
+    PrintF("  id:%d, calls:%d, targets:%d\n", candidate.node->id(),
+           candidate.calls, candidate.num_functions);
+    for (int i = 0; i < candidate.num_functions; ++i) {
+      Handle<SharedFunctionInfo> shared(candidate.functions[i]->shared());
+      PrintF("  - size[source]:%d, size[ast]:%d / %s\n", shared->SourceSize(),
+             shared->ast_node_count(), shared->DebugName()->ToCString().get());
+    }
   }
 }
 
+
+CommonOperatorBuilder* JSInliningHeuristic::common() const {
+  return jsgraph()->common();
+}
+
+
+Graph* JSInliningHeuristic::graph() const { return jsgraph()->graph(); }
+
+
+SimplifiedOperatorBuilder* JSInliningHeuristic::simplified() const {
+  return jsgraph()->simplified();
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
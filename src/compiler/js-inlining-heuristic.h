@@ -21,7 +21,8 @@ class JSInliningHeuristic final : public AdvancedReducer {
         inliner_(editor, local_zone, info, jsgraph),
         candidates_(local_zone),
         seen_(local_zone),
-        info_(info) {}
+        info_(info),
+        jsgraph_(jsgraph) {}
 
   Reduction Reduce(Node* node) final;
 
@@ -30,10 +31,14 @@ class JSInliningHeuristic final : public AdvancedReducer {
   void Finalize() final;
 
  private:
+  // Maximum number of known targets of a polymorphic call site.
+  static const int kMaxCallPolymorphism = 4;
+
   struct Candidate {
-    Handle<JSFunction> function;  // The call target being inlined.
-    Node* node;                   // The call site at which to inline.
-    int calls;                    // Number of times the call site was hit.
+    Handle<JSFunction> functions[kMaxCallPolymorphism];  // The call targets.
+    int num_functions;  // Number of known call targets.
+    Node* node;         // The call site at which to inline.
+    int calls;          // Number of times the call site was hit.
   };
 
   // Comparator for candidates.
@@ -47,11 +52,31 @@ class JSInliningHeuristic final : public AdvancedReducer {
   // Dumps candidates to console.
   void PrintCandidates();
 
+  // Collects the known targets of the {callee} into {functions}, and returns
+  // their number, or 0 if the targets are not known.
+  static int CollectFunctions(Node* callee, Handle<JSFunction>* functions);
+
+  // Checks whether the {function} is small and simple enough to be inlined.
+  bool CanInlineFunction(Handle<JSFunction> function) const;
+
+  // Inlines the targets of the {candidate}, dispatching on the callee first
+  // if the call site is polymorphic.
+  Reduction InlineCandidate(Candidate const& candidate);
+
+  // Sum of the AST sizes of all targets of the {candidate}.
+  static int CandidateSize(Candidate const& candidate);
+
+  CommonOperatorBuilder* common() const;
+  Graph* graph() const;
+  JSGraph* jsgraph() const { return jsgraph_; }
+  SimplifiedOperatorBuilder* simplified() const;
+
   Mode const mode_;
   JSInliner inliner_;
   Candidates candidates_;
   ZoneSet<NodeId> seen_;
   CompilationInfo* info_;
+  JSGraph* const jsgraph_;
   int cumulative_count_ = 0;
 };
 
@@ -13,6 +13,7 @@
 #include "src/compiler/js-operator.h"
 #include "src/compiler/linkage.h"
 #include "src/compiler/node-matchers.h"
+#include "src/compiler/state-values-utils.h"
 #include "src/field-index-inl.h"
 #include "src/isolate-inl.h"
 #include "src/objects-inl.h"  // TODO(mstarzinger): Temporary cycle breaker!
@@ -454,8 +455,15 @@ Reduction JSNativeContextSpecialization::ReduceNamedAccess(
 Reduction JSNativeContextSpecialization::ReduceJSLoadNamed(Node* node) {
   DCHECK_EQ(IrOpcode::kJSLoadNamed, node->opcode());
   NamedAccess const& p = NamedAccessOf(node->op());
+  Node* const receiver = NodeProperties::GetValueInput(node, 0);
   Node* const value = jsgraph()->Dead();
 
+  // Loads of arguments.length don't need the arguments object.
+  if (p.name().is_identical_to(factory()->length_string())) {
+    Reduction const reduction = ReduceArgumentsLoad(node, receiver, nullptr);
+    if (reduction.Changed()) return reduction;
+  }
+
   // Extract receiver maps from the LOAD_IC using the LoadICNexus.
   if (!p.feedback().IsValid()) return NoChange();
   LoadICNexus nexus(p.feedback().vector(), p.feedback().slot());
@@ -940,9 +948,14 @@ Reduction JSNativeContextSpecialization::ReduceSoftDeoptimize(Node* node) {
 Reduction JSNativeContextSpecialization::ReduceJSLoadProperty(Node* node) {
   DCHECK_EQ(IrOpcode::kJSLoadProperty, node->opcode());
   PropertyAccess const& p = PropertyAccessOf(node->op());
+  Node* const receiver = NodeProperties::GetValueInput(node, 0);
   Node* const index = NodeProperties::GetValueInput(node, 1);
   Node* const value = jsgraph()->Dead();
 
+  // Loads of arguments[i] don't need the arguments object.
+  Reduction const reduction = ReduceArgumentsLoad(node, receiver, index);
+  if (reduction.Changed()) return reduction;
+
   // Extract receiver maps from the KEYED_LOAD_IC using the KeyedLoadICNexus.
   if (!p.feedback().IsValid()) return NoChange();
   KeyedLoadICNexus nexus(p.feedback().vector(), p.feedback().slot());
@@ -953,6 +966,98 @@ Reduction JSNativeContextSpecialization::ReduceJSLoadProperty(Node* node) {
 }
 
 
+namespace {
+
+// Checks that the arguments object {node} is only used in frame states and
+// as the receiver of loads of its length or of constant in-bounds elements.
+// Such loads neither observe nor change anything but the initial values.
+bool IsArgumentsObjectOnlyLoadedFrom(Node* node, Handle<Name> length_string,
+                                     int length) {
+  for (Edge const edge : node->use_edges()) {
+    if (!NodeProperties::IsValueEdge(edge)) continue;
+    Node* const user = edge.from();
+    switch (user->opcode()) {
+      case IrOpcode::kFrameState:
+      case IrOpcode::kStateValues:
+      case IrOpcode::kTypedStateValues:
+        break;
+      case IrOpcode::kJSLoadNamed:
+        if (edge.index() != 0 ||
+            !NamedAccessOf(user->op()).name().is_identical_to(length_string)) {
+          return false;
+        }
+        break;
+      case IrOpcode::kJSLoadProperty: {
+        if (edge.index() != 0) return false;
+        NumberMatcher mindex(NodeProperties::GetValueInput(user, 1));
+        if (!mindex.IsInRange(0.0, length - 1.0) ||
+            mindex.Value() != static_cast<int>(mindex.Value())) {
+          return false;
+        }
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+
+Reduction JSNativeContextSpecialization::ReduceArgumentsLoad(Node* node,
+                                                             Node* receiver,
+                                                             Node* index) {
+  if (receiver->opcode() != IrOpcode::kJSCreateArguments) return NoChange();
+  CreateArgumentsType const type = CreateArgumentsTypeOf(receiver->op());
+  if (type == CreateArgumentsType::kRestParameter) return NoChange();
+
+  // Only inlined frames record the actual argument values in the frame state,
+  // possibly in the one of an arguments adaptor frame.
+  Node* const frame_state = NodeProperties::GetFrameStateInput(receiver, 0);
+  Node* args_state = frame_state->InputAt(kFrameStateOuterStateInput);
+  if (args_state->opcode() != IrOpcode::kFrameState) return NoChange();
+  if (OpParameter<FrameStateInfo>(args_state).type() !=
+      FrameStateType::kArgumentsAdaptor) {
+    args_state = frame_state;
+  }
+  Handle<SharedFunctionInfo> shared;
+  if (!OpParameter<FrameStateInfo>(frame_state).shared_info().ToHandle(
+          &shared)) {
+    return NoChange();
+  }
+  int const length =
+      OpParameter<FrameStateInfo>(args_state).parameter_count() - 1;
+  if (!IsArgumentsObjectOnlyLoadedFrom(receiver, factory()->length_string(),
+                                       length)) {
+    return NoChange();
+  }
+
+  Node* value;
+  if (index == nullptr) {
+    value = jsgraph()->Constant(length);
+  } else {
+    int const element = static_cast<int>(NumberMatcher(index).Value());
+    // Elements of mapped arguments objects alias the formal parameters, which
+    // may have been assigned to since the object was created.
+    if (type == CreateArgumentsType::kMappedArguments &&
+        element < shared->internal_formal_parameter_count()) {
+      return NoChange();
+    }
+    StateValuesAccess parameters_access(
+        args_state->InputAt(kFrameStateParametersInput));
+    auto parameters_it = ++parameters_access.begin();  // Skip the receiver.
+    for (int i = 0; i < element; ++i) ++parameters_it;
+    value = (*parameters_it).node;
+  }
+  Node* const effect = NodeProperties::GetEffectInput(node);
+  Node* const control = NodeProperties::GetControlInput(node);
+  ReplaceWithValue(node, value, effect, control);
+  return Replace(value);
+}
+
+
 Reduction JSNativeContextSpecialization::ReduceJSStoreProperty(Node* node) {
   DCHECK_EQ(IrOpcode::kJSStoreProperty, node->opcode());
   PropertyAccess const& p = PropertyAccessOf(node->op());
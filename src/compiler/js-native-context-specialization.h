@@ -79,6 +79,13 @@ class JSNativeContextSpecialization final : public AdvancedReducer {
 
   Reduction ReduceSoftDeoptimize(Node* node);
 
+  // Replaces loads of arguments.length and of arguments[i] from the arguments
+  // object of an inlined function by the values recorded in its frame state,
+  // if the object is only ever loaded from. The object itself stays alive for
+  // deoptimization only, where escape analysis can turn it into a virtual
+  // object that is materialized lazily.
+  Reduction ReduceArgumentsLoad(Node* node, Node* receiver, Node* index);
+
   // Adds stability dependencies on all prototypes of every class in
   // {receiver_type} up to (and including) the {holder}.
   void AssumePrototypesStable(Type* receiver_type,
@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "include/v8-experimental.h"
+#include "src/api.h"
 #include "src/code-factory.h"
 #include "src/compilation-dependencies.h"
 #include "src/compiler/access-builder.h"
@@ -322,6 +324,7 @@ JSTypedLowering::JSTypedLowering(Editor* editor,
       dependencies_(dependencies),
       flags_(flags),
       jsgraph_(jsgraph),
+      zone_(zone),
       true_type_(Type::Constant(factory()->true_value(), graph()->zone())),
       false_type_(Type::Constant(factory()->false_value(), graph()->zone())),
       the_hole_type_(
@@ -985,7 +988,9 @@ Reduction JSTypedLowering::ReduceJSLoadProperty(Node* node) {
         Node* effect = NodeProperties::GetEffectInput(node);
         Node* control = NodeProperties::GetControlInput(node);
         // Check if we can avoid the bounds check.
-        if (key_type->Min() >= 0 && key_type->Max() < array->length_value()) {
+        Type* narrowed_key_type = NarrowKeyType(key, key_type, control);
+        if (narrowed_key_type->Min() >= 0 &&
+            narrowed_key_type->Max() < array->length_value()) {
           Node* load = graph()->NewNode(
               simplified()->LoadElement(
                   AccessBuilder::ForTypedArrayElement(array->type(), true)),
@@ -1047,7 +1052,9 @@ Reduction JSTypedLowering::ReduceJSStoreProperty(Node* node) {
           }
         }
         // Check if we can avoid the bounds check.
-        if (key_type->Min() >= 0 && key_type->Max() < array->length_value()) {
+        Type* narrowed_key_type = NarrowKeyType(key, key_type, control);
+        if (narrowed_key_type->Min() >= 0 &&
+            narrowed_key_type->Max() < array->length_value()) {
           RelaxControls(node);
           node->ReplaceInput(0, buffer);
           DCHECK_EQ(key, node->InputAt(1));
@@ -1449,6 +1456,77 @@ Reduction JSTypedLowering::ReduceJSCallConstruct(Node* node) {
 }
 
 
+Reduction JSTypedLowering::ReduceFastApiCall(
+    Node* node, Handle<SharedFunctionInfo> shared) {
+  DCHECK_EQ(IrOpcode::kJSCallFunction, node->opcode());
+#if USE_SIMULATOR
+  // The simulators cannot redirect calls with arbitrary signatures.
+  return NoChange();
+#else
+  if (!shared->IsApiFunction()) return NoChange();
+  Handle<FunctionTemplateInfo> info(shared->get_api_func_data(), isolate());
+  if (!info->signature()->IsUndefined()) return NoChange();
+  if (!info->call_code()->IsCallHandlerInfo()) return NoChange();
+  CallHandlerInfo* call_handler = CallHandlerInfo::cast(info->call_code());
+  if (!call_handler->fast_c_function()->IsForeign()) return NoChange();
+  int const signature = Smi::cast(call_handler->fast_c_signature())->value();
+  int const arity =
+      static_cast<int>(CallFunctionParametersOf(node->op()).arity() - 2);
+  if (arity != CallHandlerInfo::FastArgumentCountBits::decode(signature)) {
+    return NoChange();
+  }
+
+  // The simplified C linkage does not pass floating point values yet, so
+  // only int32 signatures are lowered. The arguments must already be int32,
+  // there are no conversions that could call back into JavaScript here.
+  typedef v8::experimental::FastApiFunction FastApiFunction;
+  int const return_type =
+      CallHandlerInfo::FastReturnTypeBits::decode(signature);
+  if (return_type == FastApiFunction::kFloat64) return NoChange();
+  MachineSignature::Builder builder(
+      graph()->zone(), return_type == FastApiFunction::kVoid ? 0 : 1, arity);
+  if (return_type == FastApiFunction::kInt32) {
+    builder.AddReturn(MachineType::Int32());
+  }
+  for (int i = 0; i < arity; ++i) {
+    if (CallHandlerInfo::FastArgumentType(signature, i) !=
+        FastApiFunction::kInt32) {
+      return NoChange();
+    }
+    Type* const type =
+        NodeProperties::GetType(NodeProperties::GetValueInput(node, 2 + i));
+    if (!type->Is(Type::Signed32())) return NoChange();
+    builder.AddParam(MachineType::Int32());
+  }
+
+  // Patch {node} to a direct call of the C function, which neither reads the
+  // receiver nor can deoptimize.
+  ApiFunction function(
+      Foreign::cast(call_handler->fast_c_function())->foreign_address());
+  Node** inputs = graph()->zone()->NewArray<Node*>(arity + 3);
+  inputs[0] = jsgraph()->ExternalConstant(ExternalReference(
+      &function, ExternalReference::BUILTIN_CALL, isolate()));
+  for (int i = 0; i < arity; ++i) {
+    inputs[1 + i] = NodeProperties::GetValueInput(node, 2 + i);
+  }
+  inputs[arity + 1] = NodeProperties::GetEffectInput(node);
+  inputs[arity + 2] = NodeProperties::GetControlInput(node);
+  Node* call = graph()->NewNode(
+      common()->Call(
+          Linkage::GetSimplifiedCDescriptor(graph()->zone(), builder.Build())),
+      arity + 3, inputs);
+  Node* value = call;
+  if (return_type == FastApiFunction::kInt32) {
+    NodeProperties::SetType(call, Type::Signed32());
+  } else {
+    value = jsgraph()->UndefinedConstant();
+  }
+  ReplaceWithValue(node, value, call, call);
+  return Replace(value);
+#endif  // USE_SIMULATOR
+}
+
+
 Reduction JSTypedLowering::ReduceJSCallFunction(Node* node) {
   DCHECK_EQ(IrOpcode::kJSCallFunction, node->opcode());
   CallFunctionParameters const& p = CallFunctionParametersOf(node->op());
@@ -1480,6 +1558,10 @@ Reduction JSTypedLowering::ReduceJSCallFunction(Node* node) {
     // See ES6 section 9.2.1 [[Call]] ( thisArgument, argumentsList ).
     if (IsClassConstructor(shared->kind())) return NoChange();
 
+    // Check if {target} is an API function with a fast C function.
+    Reduction const reduction = ReduceFastApiCall(node, shared);
+    if (reduction.Changed()) return reduction;
+
     // Load the context from the {target}.
     Node* context = effect = graph()->NewNode(
         simplified()->LoadField(AccessBuilder::ForJSFunctionContext()), target,
@@ -1800,6 +1882,47 @@ Node* JSTypedLowering::Word32Shl(Node* const lhs, int32_t const rhs) {
 }
 
 
+Type* JSTypedLowering::NarrowKeyType(Node* key, Type* key_type,
+                                     Node* control) {
+  if (!key_type->Is(type_cache_.kInteger)) return key_type;
+  for (Node* const cond : key->uses()) {
+    bool strict;
+    switch (cond->opcode()) {
+      case IrOpcode::kJSLessThan:
+      case IrOpcode::kNumberLessThan:
+        strict = true;
+        break;
+      case IrOpcode::kJSLessThanOrEqual:
+      case IrOpcode::kNumberLessThanOrEqual:
+        strict = false;
+        break;
+      default:
+        continue;
+    }
+    if (cond->InputAt(0) != key) continue;
+    Type* bound_type = NodeProperties::GetType(cond->InputAt(1));
+    if (!bound_type->Is(Type::Number())) continue;
+    bound_type = Type::Intersect(bound_type, Type::OrderedNumber(), zone());
+    if (!bound_type->IsInhabited()) continue;
+    // The {key} is an integer, so {key < bound} implies
+    // {key <= ceil(bound) - 1}.
+    double max = strict ? std::ceil(bound_type->Max()) - 1
+                        : std::floor(bound_type->Max());
+    if (max >= key_type->Max() || max < key_type->Min()) continue;
+    for (Node* const branch : cond->uses()) {
+      if (branch->opcode() != IrOpcode::kBranch) continue;
+      for (Node* const if_true : branch->uses()) {
+        if (if_true->opcode() == IrOpcode::kIfTrue &&
+            NodeProperties::IsDominatedBy(control, if_true, zone())) {
+          key_type = Type::Range(key_type->Min(), max, graph()->zone());
+        }
+      }
+    }
+  }
+  return key_type;
+}
+
+
 Factory* JSTypedLowering::factory() const { return jsgraph()->factory(); }
 
 
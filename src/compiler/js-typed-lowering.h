@@ -77,6 +77,7 @@ class JSTypedLowering final : public AdvancedReducer {
   Reduction ReduceJSForInNext(Node* node);
   Reduction ReduceJSForInStep(Node* node);
   Reduction ReduceSelect(Node* node);
+  Reduction ReduceFastApiCall(Node* node, Handle<SharedFunctionInfo> shared);
   Reduction ReduceNumberBinop(Node* node, const Operator* numberOp);
   Reduction ReduceInt32Binop(Node* node, const Operator* intOp);
   Reduction ReduceUI32Shift(Node* node, Signedness left_signedness,
@@ -84,6 +85,10 @@ class JSTypedLowering final : public AdvancedReducer {
 
   Node* Word32Shl(Node* const lhs, int32_t const rhs);
 
+  // Narrows the {key_type} of an element access at {control} using a
+  // dominating {key < bound} or {key <= bound} check.
+  Type* NarrowKeyType(Node* key, Type* key_type, Node* control);
+
   Factory* factory() const;
   Graph* graph() const;
   JSGraph* jsgraph() const { return jsgraph_; }
@@ -94,10 +99,12 @@ class JSTypedLowering final : public AdvancedReducer {
   MachineOperatorBuilder* machine() const;
   CompilationDependencies* dependencies() const;
   Flags flags() const { return flags_; }
+  Zone* zone() const { return zone_; }
 
   CompilationDependencies* dependencies_;
   Flags flags_;
   JSGraph* jsgraph_;
+  Zone* zone_;
   Type* shifted_int32_ranges_[4];
   Type* const true_type_;
   Type* const false_type_;
@@ -329,6 +329,47 @@ PeeledIteration* LoopPeeler::Peel(Graph* graph, CommonOperatorBuilder* common,
   return iter;
 }
 
+
+namespace {
+
+int PeelInnerLoops(Graph* graph, CommonOperatorBuilder* common,
+                   LoopTree* loop_tree, LoopTree::Loop* loop,
+                   Zone* tmp_zone) {
+  // If the loop has nested loops, peel inside those.
+  if (!loop->children().empty()) {
+    int peeled = 0;
+    for (LoopTree::Loop* inner_loop : loop->children()) {
+      peeled += PeelInnerLoops(graph, common, loop_tree, inner_loop, tmp_zone);
+    }
+    return peeled;
+  }
+  // Only peel small-enough loops.
+  if (loop->TotalSize() > LoopPeeler::kMaxPeeledNodes) return 0;
+  Node* loop_node = loop_tree->GetLoopControl(loop);
+  if (LoopPeeler::Peel(graph, common, loop_tree, loop, tmp_zone) == nullptr) {
+    return 0;
+  }
+  if (FLAG_trace_turbo_loop) {
+    PrintF("Peeled loop #%d:%s\n", loop_node->id(),
+           loop_node->op()->mnemonic());
+  }
+  return 1;
+}
+
+}  // namespace
+
+
+// static
+int LoopPeeler::PeelInnerLoopsOfTree(Graph* graph,
+                                     CommonOperatorBuilder* common,
+                                     LoopTree* loop_tree, Zone* tmp_zone) {
+  int peeled = 0;
+  for (LoopTree::Loop* loop : loop_tree->outer_loops()) {
+    peeled += PeelInnerLoops(graph, common, loop_tree, loop, tmp_zone);
+  }
+  return peeled;
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
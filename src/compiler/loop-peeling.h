@@ -33,6 +33,14 @@ class LoopPeeler {
   static PeeledIteration* Peel(Graph* graph, CommonOperatorBuilder* common,
                                LoopTree* loop_tree, LoopTree::Loop* loop,
                                Zone* tmp_zone);
+
+  // Peels the first iteration of every innermost loop in {loop_tree} that
+  // can be peeled and has at most {kMaxPeeledNodes} nodes. Returns the
+  // number of peeled loops.
+  static int PeelInnerLoopsOfTree(Graph* graph, CommonOperatorBuilder* common,
+                                  LoopTree* loop_tree, Zone* tmp_zone);
+
+  static const size_t kMaxPeeledNodes = 1000;
 };
 
 
@@ -121,13 +121,17 @@ class MachineOperatorBuilder final : public ZoneObject {
     kWord64Popcnt = 1u << 19,
     kWord32ReverseBits = 1u << 20,
     kWord64ReverseBits = 1u << 21,
+    kFloat64Sin = 1u << 22,
+    kFloat64Cos = 1u << 23,
+    kFloat64Tan = 1u << 24,
     kAllOptionalOps = kFloat32Max | kFloat32Min | kFloat64Max | kFloat64Min |
                       kFloat32RoundDown | kFloat64RoundDown | kFloat32RoundUp |
                       kFloat64RoundUp | kFloat32RoundTruncate |
                       kFloat64RoundTruncate | kFloat64RoundTiesAway |
                       kFloat32RoundTiesEven | kFloat64RoundTiesEven |
                       kWord32Ctz | kWord64Ctz | kWord32Popcnt | kWord64Popcnt |
-                      kWord32ReverseBits | kWord64ReverseBits
+                      kWord32ReverseBits | kWord64ReverseBits | kFloat64Sin |
+                      kFloat64Cos | kFloat64Tan
   };
   typedef base::Flags<Flag, unsigned> Flags;
 
@@ -301,12 +305,30 @@ class MachineOperatorBuilder final : public ZoneObject {
   const OptionalOperator Float32RoundTiesEven();
   const OptionalOperator Float64RoundTiesEven();
 
+  // Floating point trigonometric functions, computed by calling the fdlibm
+  // implementation (double-precision).
+  const OptionalOperator Float64Sin();
+  const OptionalOperator Float64Cos();
+  const OptionalOperator Float64Tan();
+
   // Floating point bit representation.
   const Operator* Float64ExtractLowWord32();
   const Operator* Float64ExtractHighWord32();
   const Operator* Float64InsertLowWord32();
   const Operator* Float64InsertHighWord32();
 
+  // SIMD operators on 128-bit values. The lane index of an ExtractLane must
+  // be an Int32Constant.
+  const Operator* Float32x4Splat();
+  const Operator* Float32x4ExtractLane();
+  const Operator* Float32x4Add();
+  const Operator* Float32x4Sub();
+  const Operator* Float32x4Mul();
+  const Operator* Int32x4Splat();
+  const Operator* Int32x4ExtractLane();
+  const Operator* Int32x4Add();
+  const Operator* Int32x4Sub();
+
   // load [base + index]
   const Operator* Load(LoadRepresentation rep);
 
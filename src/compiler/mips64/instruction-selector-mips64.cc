@@ -1322,6 +1322,15 @@ void InstructionSelector::VisitFloat64RoundTiesAway(Node* node) {
 }
 
 
+void InstructionSelector::VisitFloat64Sin(Node* node) { UNREACHABLE(); }
+
+
+void InstructionSelector::VisitFloat64Cos(Node* node) { UNREACHABLE(); }
+
+
+void InstructionSelector::VisitFloat64Tan(Node* node) { UNREACHABLE(); }
+
+
 void InstructionSelector::VisitFloat32RoundTiesEven(Node* node) {
   VisitRR(this, kMips64Float32RoundTiesEven, node);
 }
@@ -307,6 +307,33 @@ void NodeProperties::CollectControlProjections(Node* node, Node** projections,
 }
 
 
+// static
+bool NodeProperties::IsDominatedBy(Node* control, Node* dominator,
+                                   Zone* temp_zone) {
+  // Search backwards from {control} without passing {dominator}; if we reach
+  // the start node there is a path that bypasses {dominator}.
+  static const size_t kMaxVisitedNodes = 1000;
+  ZoneSet<Node*> visited(temp_zone);
+  ZoneVector<Node*> stack(temp_zone);
+  stack.push_back(control);
+  visited.insert(control);
+  while (!stack.empty()) {
+    Node* current = stack.back();
+    stack.pop_back();
+    if (current == dominator) continue;
+    if (current->opcode() == IrOpcode::kStart) return false;
+    for (int i = 0; i < current->op()->ControlInputCount(); ++i) {
+      Node* input = GetControlInput(current, i);
+      if (visited.insert(input).second) {
+        if (visited.size() > kMaxVisitedNodes) return false;
+        stack.push_back(input);
+      }
+    }
+  }
+  return true;
+}
+
+
 // static
 MaybeHandle<Context> NodeProperties::GetSpecializationContext(
     Node* node, MaybeHandle<Context> context) {
@@ -118,6 +118,11 @@ class NodeProperties final {
   //  - Switch: [ IfValue, ..., IfDefault ]
   static void CollectControlProjections(Node* node, Node** proj, size_t count);
 
+  // Returns true if every control path from start to {control} passes through
+  // the control node {dominator}. Conservatively returns false if the search
+  // gets too expensive.
+  static bool IsDominatedBy(Node* control, Node* dominator, Zone* temp_zone);
+
   // ---------------------------------------------------------------------------
   // Context.
 
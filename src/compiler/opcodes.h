@@ -342,6 +342,9 @@
   V(Float64RoundTiesAway)       \
   V(Float32RoundTiesEven)       \
   V(Float64RoundTiesEven)       \
+  V(Float64Sin)                 \
+  V(Float64Cos)                 \
+  V(Float64Tan)                 \
   V(Float64ExtractLowWord32)    \
   V(Float64ExtractHighWord32)   \
   V(Float64InsertLowWord32)     \
@@ -357,7 +360,16 @@
   V(Word32PairShl)              \
   V(Word32PairShr)              \
   V(Word32PairSar)              \
-  V(AtomicLoad)
+  V(AtomicLoad)                 \
+  V(Float32x4Splat)             \
+  V(Float32x4ExtractLane)       \
+  V(Float32x4Add)               \
+  V(Float32x4Sub)               \
+  V(Float32x4Mul)               \
+  V(Int32x4Splat)               \
+  V(Int32x4ExtractLane)         \
+  V(Int32x4Add)                 \
+  V(Int32x4Sub)
 
 #define VALUE_OP_LIST(V) \
   COMMON_OP_LIST(V)      \
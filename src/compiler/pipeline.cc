@@ -9,6 +9,7 @@
 
 #include "src/base/adapters.h"
 #include "src/base/platform/elapsed-timer.h"
+#include "src/compiler/allocation-folding.h"
 #include "src/compiler/ast-graph-builder.h"
 #include "src/compiler/ast-loop-assignment-analyzer.h"
 #include "src/compiler/basic-block-instrumentor.h"
@@ -57,6 +58,7 @@
 #include "src/compiler/simplified-lowering.h"
 #include "src/compiler/simplified-operator-reducer.h"
 #include "src/compiler/simplified-operator.h"
+#include "src/compiler/store-store-elimination.h"
 #include "src/compiler/tail-call-optimization.h"
 #include "src/compiler/type-hint-analyzer.h"
 #include "src/compiler/typer.h"
@@ -66,6 +68,7 @@
 #include "src/isolate-inl.h"
 #include "src/ostreams.h"
 #include "src/register-configuration.h"
+#include "src/tracing/trace-event.h"
 #include "src/type-info.h"
 #include "src/utils.h"
 
@@ -453,6 +456,12 @@ void AddReducer(PipelineData* data, GraphReducer* graph_reducer,
 }
 
 
+// Phases without a name, e.g. graph printing and verification, show up with
+// this name as trace events.
+const char* PhaseTraceName(const char* phase_name) {
+  return phase_name == nullptr ? "V8.TFUnnamedPhase" : phase_name;
+}
+
 class PipelineRunScope {
  public:
   PipelineRunScope(PipelineData* data, const char* phase_name)
@@ -527,11 +536,22 @@ PipelineCompilationJob::Status PipelineCompilationJob::CreateGraphImpl() {
   if (info()->shared_info()->asm_function()) {
     if (info()->osr_frame()) info()->MarkAsFrameSpecializing();
     info()->MarkAsFunctionContextSpecializing();
+    if (FLAG_turbo_fast_register_allocation) {
+      info()->MarkAsFastRegisterAllocation();
+    }
   } else {
     if (!FLAG_always_opt) {
       info()->MarkAsBailoutOnUninitialized();
     }
-    if (FLAG_native_context_specialization) {
+    // Functions that have already been optimized for another native context
+    // get context-independent code instead, which is then shared by all
+    // native contexts through the optimized code map.
+    bool const context_independent =
+        FLAG_turbo_context_independent_code && FLAG_turbo_cache_shared_code &&
+        !info()->is_osr() &&
+        info()->shared_info()->WasOptimizedInOtherNativeContext(
+            info()->closure()->context()->native_context());
+    if (FLAG_native_context_specialization && !context_independent) {
       info()->MarkAsNativeContextSpecializing();
     }
   }
@@ -629,6 +649,8 @@ PipelineWasmCompilationJob::GenerateCodeImpl() {
 
 template <typename Phase>
 void Pipeline::Run() {
+  TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.compile"),
+               PhaseTraceName(Phase::phase_name()));
   PipelineRunScope scope(this->data_, Phase::phase_name());
   Phase phase;
   phase.Run(this->data_, scope.zone());
@@ -637,6 +659,8 @@ void Pipeline::Run() {
 
 template <typename Phase, typename Arg0>
 void Pipeline::Run(Arg0 arg_0) {
+  TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.compile"),
+               PhaseTraceName(Phase::phase_name()));
   PipelineRunScope scope(this->data_, Phase::phase_name());
   Phase phase;
   phase.Run(this->data_, scope.zone(), arg_0);
@@ -644,6 +668,8 @@ void Pipeline::Run(Arg0 arg_0) {
 
 template <typename Phase, typename Arg0, typename Arg1>
 void Pipeline::Run(Arg0 arg_0, Arg1 arg_1) {
+  TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.compile"),
+               PhaseTraceName(Phase::phase_name()));
   PipelineRunScope scope(this->data_, Phase::phase_name());
   Phase phase;
   phase.Run(this->data_, scope.zone(), arg_0, arg_1);
@@ -860,6 +886,13 @@ struct EscapeAnalysisPhase {
     AddReducer(data, &graph_reducer, &escape_reducer);
     graph_reducer.ReduceGraph();
     escape_reducer.VerifyReplacement();
+    if (FLAG_turbo_escape_stats) {
+      OFStream os(stdout);
+      os << "Escape analysis for " << data->info()->GetDebugName().get()
+         << ": eliminated " << escape_reducer.allocations_eliminated()
+         << " allocation(s), replaced " << escape_reducer.loads_replaced()
+         << " load(s)" << std::endl;
+    }
   }
 };
 
@@ -937,6 +970,28 @@ struct EffectControlLinearizationPhase {
   }
 };
 
+struct StoreStoreEliminationPhase {
+  static const char* phase_name() { return "store-store elimination"; }
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    JSGraphReducer graph_reducer(data->jsgraph(), temp_zone);
+    StoreStoreElimination store_store_elimination(&graph_reducer);
+    AddReducer(data, &graph_reducer, &store_store_elimination);
+    graph_reducer.ReduceGraph();
+  }
+};
+
+struct AllocationFoldingPhase {
+  static const char* phase_name() { return "allocation folding"; }
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    JSGraphReducer graph_reducer(data->jsgraph(), temp_zone);
+    AllocationFolding allocation_folding(&graph_reducer, data->jsgraph());
+    AddReducer(data, &graph_reducer, &allocation_folding);
+    graph_reducer.ReduceGraph();
+  }
+};
+
 struct LateOptimizationPhase {
   static const char* phase_name() { return "late optimization"; }
 
@@ -985,6 +1040,17 @@ struct LateGraphTrimmingPhase {
 };
 
 
+struct LoopPeelingPhase {
+  static const char* phase_name() { return "loop peeling"; }
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    LoopTree* loop_tree = LoopFinder::BuildLoopTree(data->graph(), temp_zone);
+    LoopPeeler::PeelInnerLoopsOfTree(data->graph(), data->common(), loop_tree,
+                                     temp_zone);
+  }
+};
+
+
 struct StressLoopPeelingPhase {
   static const char* phase_name() { return "stress loop peeling"; }
 
@@ -1332,6 +1398,9 @@ bool Pipeline::CreateGraph() {
   if (FLAG_turbo_stress_loop_peeling) {
     Run<StressLoopPeelingPhase>();
     RunPrintAndVerify("Loop peeled");
+  } else if (FLAG_turbo_loop_peeling) {
+    Run<LoopPeelingPhase>();
+    RunPrintAndVerify("Loops peeled");
   }
 
   if (FLAG_experimental_turbo_escape) {
@@ -1350,6 +1419,16 @@ bool Pipeline::CreateGraph() {
   Run<EffectControlLinearizationPhase>();
   RunPrintAndVerify("Effect and control linearized");
 
+  if (FLAG_turbo_store_elimination) {
+    Run<StoreStoreEliminationPhase>();
+    RunPrintAndVerify("Store-store eliminated");
+  }
+
+  if (FLAG_turbo_allocation_folding) {
+    Run<AllocationFoldingPhase>();
+    RunPrintAndVerify("Allocations folded");
+  }
+
   Run<BranchEliminationPhase>();
   RunPrintAndVerify("Branch conditions eliminated");
 
@@ -1495,9 +1574,11 @@ CompilationJob* Pipeline::NewWasmCompilationJob(
 
 bool Pipeline::AllocateRegistersForTesting(const RegisterConfiguration* config,
                                            InstructionSequence* sequence,
-                                           bool run_verifier) {
+                                           bool run_verifier,
+                                           bool fast_register_allocation) {
   CompilationInfo info(ArrayVector("testing"), sequence->isolate(),
                        sequence->zone());
+  if (fast_register_allocation) info.MarkAsFastRegisterAllocation();
   ZonePool zone_pool(sequence->isolate()->allocator());
   PipelineData data(&zone_pool, &info, sequence);
   Pipeline pipeline(&data);
@@ -1669,11 +1750,16 @@ void Pipeline::AllocateRegisters(const RegisterConfiguration* config,
               ->RangesDefinedInDeferredStayInDeferred());
   }
 
-  if (FLAG_turbo_preprocess_ranges) {
+  // The fast tier trades code quality for compile time: it skips splintering,
+  // the greedy allocator and the move optimizer.
+  bool const fast = info()->is_fast_register_allocation();
+  bool const preprocess_ranges = FLAG_turbo_preprocess_ranges && !fast;
+
+  if (preprocess_ranges) {
     Run<SplinterLiveRangesPhase>();
   }
 
-  if (FLAG_turbo_greedy_regalloc) {
+  if (FLAG_turbo_greedy_regalloc && !fast) {
     Run<AllocateGeneralRegistersPhase<GreedyAllocator>>();
     Run<AllocateFPRegistersPhase<GreedyAllocator>>();
   } else {
@@ -1681,7 +1767,7 @@ void Pipeline::AllocateRegisters(const RegisterConfiguration* config,
     Run<AllocateFPRegistersPhase<LinearScanAllocator>>();
   }
 
-  if (FLAG_turbo_preprocess_ranges) {
+  if (preprocess_ranges) {
     Run<MergeSplintersPhase>();
   }
 
@@ -1691,7 +1777,7 @@ void Pipeline::AllocateRegisters(const RegisterConfiguration* config,
   Run<PopulateReferenceMapsPhase>();
   Run<ConnectRangesPhase>();
   Run<ResolveControlFlowPhase>();
-  if (FLAG_turbo_move_optimization) {
+  if (FLAG_turbo_move_optimization && !fast) {
     Run<OptimizeMovesPhase>();
   }
 
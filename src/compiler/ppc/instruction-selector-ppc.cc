@@ -1349,6 +1349,15 @@ void InstructionSelector::VisitFloat64RoundTiesAway(Node* node) {
 }
 
 
+void InstructionSelector::VisitFloat64Sin(Node* node) { UNREACHABLE(); }
+
+
+void InstructionSelector::VisitFloat64Cos(Node* node) { UNREACHABLE(); }
+
+
+void InstructionSelector::VisitFloat64Tan(Node* node) { UNREACHABLE(); }
+
+
 void InstructionSelector::VisitFloat32RoundTiesEven(Node* node) {
   UNREACHABLE();
 }
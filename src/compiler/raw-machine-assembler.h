@@ -584,6 +584,11 @@ class RawMachineAssembler {
     return AddNode(machine()->Float64RoundTiesEven().op(), a);
   }
 
+  // Floating point trigonometric functions.
+  Node* Float64Sin(Node* a) { return AddNode(machine()->Float64Sin().op(), a); }
+  Node* Float64Cos(Node* a) { return AddNode(machine()->Float64Cos().op(), a); }
+  Node* Float64Tan(Node* a) { return AddNode(machine()->Float64Tan().op(), a); }
+
   // Float64 bit operations.
   Node* Float64ExtractLowWord32(Node* a) {
     return AddNode(machine()->Float64ExtractLowWord32(), a);
@@ -598,6 +603,33 @@ class RawMachineAssembler {
     return AddNode(machine()->Float64InsertHighWord32(), a, b);
   }
 
+  // SIMD operations.
+  Node* Float32x4Splat(Node* a) {
+    return AddNode(machine()->Float32x4Splat(), a);
+  }
+  Node* Float32x4ExtractLane(Node* a, int32_t lane) {
+    return AddNode(machine()->Float32x4ExtractLane(), a, Int32Constant(lane));
+  }
+  Node* Float32x4Add(Node* a, Node* b) {
+    return AddNode(machine()->Float32x4Add(), a, b);
+  }
+  Node* Float32x4Sub(Node* a, Node* b) {
+    return AddNode(machine()->Float32x4Sub(), a, b);
+  }
+  Node* Float32x4Mul(Node* a, Node* b) {
+    return AddNode(machine()->Float32x4Mul(), a, b);
+  }
+  Node* Int32x4Splat(Node* a) { return AddNode(machine()->Int32x4Splat(), a); }
+  Node* Int32x4ExtractLane(Node* a, int32_t lane) {
+    return AddNode(machine()->Int32x4ExtractLane(), a, Int32Constant(lane));
+  }
+  Node* Int32x4Add(Node* a, Node* b) {
+    return AddNode(machine()->Int32x4Add(), a, b);
+  }
+  Node* Int32x4Sub(Node* a, Node* b) {
+    return AddNode(machine()->Int32x4Sub(), a, b);
+  }
+
   // Stack operations.
   Node* LoadStackPointer() { return AddNode(machine()->LoadStackPointer()); }
   Node* LoadFramePointer() { return AddNode(machine()->LoadFramePointer()); }
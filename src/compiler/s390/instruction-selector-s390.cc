@@ -1218,6 +1218,12 @@ void InstructionSelector::VisitFloat64RoundTiesAway(Node* node) {
   VisitRR(this, kS390_RoundDouble, node);
 }
 
+void InstructionSelector::VisitFloat64Sin(Node* node) { UNREACHABLE(); }
+
+void InstructionSelector::VisitFloat64Cos(Node* node) { UNREACHABLE(); }
+
+void InstructionSelector::VisitFloat64Tan(Node* node) { UNREACHABLE(); }
+
 void InstructionSelector::VisitFloat32RoundTiesEven(Node* node) {
   UNREACHABLE();
 }
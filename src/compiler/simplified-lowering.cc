@@ -1336,6 +1336,9 @@ class RepresentationSelector {
       case IrOpcode::kFloat64RoundTruncate:
       case IrOpcode::kFloat64RoundTiesAway:
       case IrOpcode::kFloat64RoundUp:
+      case IrOpcode::kFloat64Sin:
+      case IrOpcode::kFloat64Cos:
+      case IrOpcode::kFloat64Tan:
         return VisitUnop(node, UseInfo::TruncatingFloat64(),
                          MachineRepresentation::kFloat64);
       case IrOpcode::kFloat64Equal:
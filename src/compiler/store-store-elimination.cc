@@ -0,0 +1,70 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/store-store-elimination.h"
+
+#include "src/compiler/node-properties.h"
+#include "src/compiler/simplified-operator.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+namespace {
+
+// Returns the only effect use of {node}, or nullptr if there are none or
+// several.
+Node* SingleEffectUse(Node* node) {
+  Node* result = nullptr;
+  for (Edge const edge : node->use_edges()) {
+    if (!NodeProperties::IsEffectEdge(edge)) continue;
+    if (result != nullptr) return nullptr;
+    result = edge.from();
+  }
+  return result;
+}
+
+}  // namespace
+
+StoreStoreElimination::~StoreStoreElimination() {}
+
+Reduction StoreStoreElimination::Reduce(Node* node) {
+  switch (node->opcode()) {
+    case IrOpcode::kStoreField:
+      return ReduceStoreField(node);
+    default:
+      break;
+  }
+  return NoChange();
+}
+
+Reduction StoreStoreElimination::ReduceStoreField(Node* node) {
+  DCHECK_EQ(IrOpcode::kStoreField, node->opcode());
+  FieldAccess const& access = FieldAccessOf(node->op());
+  Node* const object = NodeProperties::GetValueInput(node, 0);
+  Node* const control = NodeProperties::GetControlInput(node);
+  // Walk the effect chain forward through other field stores, which cannot
+  // observe the field, looking for a store that overwrites it. Anything that
+  // may read memory, allocate or deoptimize ends the search.
+  for (Node* effect = SingleEffectUse(node); effect != nullptr;
+       effect = SingleEffectUse(effect)) {
+    if (effect->opcode() != IrOpcode::kStoreField ||
+        NodeProperties::GetControlInput(effect) != control) {
+      break;
+    }
+    FieldAccess const& other = FieldAccessOf(effect->op());
+    if (object == NodeProperties::GetValueInput(effect, 0) &&
+        access.base_is_tagged == other.base_is_tagged &&
+        access.offset == other.offset &&
+        access.machine_type.representation() ==
+            other.machine_type.representation()) {
+      return Replace(NodeProperties::GetEffectInput(node));
+    }
+  }
+  return NoChange();
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
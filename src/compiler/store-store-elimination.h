@@ -0,0 +1,33 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_STORE_STORE_ELIMINATION_H_
+#define V8_COMPILER_STORE_STORE_ELIMINATION_H_
+
+#include "src/compiler/graph-reducer.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+// Removes StoreField nodes whose value is overwritten by a later StoreField
+// to the same field of the same object before anything can observe it, for
+// example initializing stores of inlined allocations. Runs on the effect
+// linearized graph, and only looks through chains of field stores.
+class StoreStoreElimination final : public AdvancedReducer {
+ public:
+  explicit StoreStoreElimination(Editor* editor) : AdvancedReducer(editor) {}
+  ~StoreStoreElimination() final;
+
+  Reduction Reduce(Node* node) final;
+
+ private:
+  Reduction ReduceStoreField(Node* node);
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_STORE_STORE_ELIMINATION_H_
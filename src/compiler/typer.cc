@@ -7,10 +7,12 @@
 #include "src/base/flags.h"
 #include "src/bootstrapper.h"
 #include "src/compilation-dependencies.h"
+#include "src/compiler/all-nodes.h"
 #include "src/compiler/common-operator.h"
 #include "src/compiler/graph-reducer.h"
 #include "src/compiler/js-operator.h"
 #include "src/compiler/node.h"
+#include "src/compiler/node-matchers.h"
 #include "src/compiler/node-properties.h"
 #include "src/compiler/simplified-operator.h"
 #include "src/objects-inl.h"
@@ -77,7 +79,9 @@ Typer::~Typer() {
 class Typer::Visitor : public Reducer {
  public:
   explicit Visitor(Typer* typer)
-      : typer_(typer), weakened_nodes_(typer->zone()) {}
+      : typer_(typer),
+        weakened_nodes_(typer->zone()),
+        induction_variables_(typer->zone()) {}
 
   Reduction Reduce(Node* node) override {
     if (node->op()->ValueOutputCount() == 0) return NoChange();
@@ -178,9 +182,25 @@ class Typer::Visitor : public Reducer {
 
   Type* TypeConstant(Handle<Object> value);
 
+  // Recognizes loop phis of the form
+  //
+  //   i = Phi(init, i + increment)
+  //
+  // whose back edge is dominated by the true branch of {i < bound} or
+  // {i <= bound}, and returns the {bound} nodes found so that they can be
+  // typed before the phis that depend on them.
+  void FindInductionVariables(Zone* temp_zone, NodeVector* bounds);
+
  private:
+  struct InductionVariable {
+    Node* bound;
+    double increment;
+    bool strict;  // {i < bound} vs. {i <= bound}.
+  };
+
   Typer* typer_;
   ZoneSet<NodeId> weakened_nodes_;
+  ZoneMap<NodeId, InductionVariable> induction_variables_;
 
 #define DECLARE_METHOD(x) inline Type* Type##x(Node* node);
   DECLARE_METHOD(Start)
@@ -200,6 +220,7 @@ class Typer::Visitor : public Reducer {
 
   Type* WrapContextTypeForInput(Node* node);
   Type* Weaken(Node* node, Type* current_type, Type* previous_type);
+  Type* TypeInductionVariablePhi(Node* node, InductionVariable const& iv);
 
   Zone* zone() { return typer_->zone(); }
   Isolate* isolate() { return typer_->isolate(); }
@@ -304,6 +325,14 @@ void Typer::Run(const NodeVector& roots) {
   Visitor visitor(this);
   GraphReducer graph_reducer(zone(), graph());
   graph_reducer.AddReducer(&visitor);
+  {
+    // The bounds of induction variables are not inputs of the loop phis, so
+    // make sure they are typed before the phis are visited.
+    Zone temp_zone(isolate()->allocator());
+    NodeVector bounds(&temp_zone);
+    visitor.FindInductionVariables(&temp_zone, &bounds);
+    for (Node* const bound : bounds) graph_reducer.ReduceNode(bound);
+  }
   for (Node* const root : roots) graph_reducer.ReduceNode(root);
   graph_reducer.ReduceGraph();
 }
@@ -683,6 +712,17 @@ Type* Typer::Visitor::TypeSelect(Node* node) {
 
 
 Type* Typer::Visitor::TypePhi(Node* node) {
+  auto it = induction_variables_.find(node->id());
+  if (it != induction_variables_.end()) {
+    Type* type = TypeInductionVariablePhi(node, it->second);
+    if (type != nullptr) {
+      // Keep the typing monotonic in case the phi was typed before its bound.
+      if (NodeProperties::IsTyped(node)) {
+        type = Type::Union(type, NodeProperties::GetType(node), zone());
+      }
+      return type;
+    }
+  }
   int arity = node->op()->ValueInputCount();
   Type* type = Operand(node, 0);
   for (int i = 1; i < arity; ++i) {
@@ -692,6 +732,90 @@ Type* Typer::Visitor::TypePhi(Node* node) {
 }
 
 
+Type* Typer::Visitor::TypeInductionVariablePhi(Node* node,
+                                               InductionVariable const& iv) {
+  Type* const integer = typer_->cache_.kInteger;
+  Type* initial_type = Operand(node, 0);
+  Type* bound_type =
+      Type::Intersect(TypeOrNone(iv.bound), Type::OrderedNumber(), zone());
+  if (!initial_type->IsInhabited() || !initial_type->Is(integer) ||
+      !bound_type->IsInhabited() || !TypeOrNone(iv.bound)->Is(Type::Number())) {
+    return nullptr;
+  }
+  // All values of the phi are integers, so {i < bound} implies
+  // {i <= ceil(bound) - 1}; the phi is at most one increment above that.
+  double bound_max = iv.strict ? std::ceil(bound_type->Max()) - 1
+                               : std::floor(bound_type->Max());
+  double max = bound_max + iv.increment;
+  if (!std::isfinite(max)) return nullptr;
+  return Type::Range(initial_type->Min(), std::max(initial_type->Max(), max),
+                     zone());
+}
+
+
+void Typer::Visitor::FindInductionVariables(Zone* temp_zone,
+                                            NodeVector* bounds) {
+  AllNodes all(temp_zone, graph());
+  for (Node* const node : all.live) {
+    if (node->opcode() != IrOpcode::kPhi) continue;
+    if (node->op()->ValueInputCount() != 2) continue;
+    Node* loop = NodeProperties::GetControlInput(node);
+    if (loop->opcode() != IrOpcode::kLoop) continue;
+
+    // Match the increment {i + increment} on the back edge.
+    Node* increment = node->InputAt(1);
+    if (increment->opcode() != IrOpcode::kJSAdd &&
+        increment->opcode() != IrOpcode::kNumberAdd) {
+      continue;
+    }
+    Node* lhs = increment->InputAt(0);
+    if (lhs->opcode() == IrOpcode::kJSToNumber) lhs = lhs->InputAt(0);
+    NumberMatcher mrhs(increment->InputAt(1));
+    if (lhs != node || !mrhs.HasValue() || !(mrhs.Value() > 0) ||
+        !std::isfinite(mrhs.Value()) ||
+        mrhs.Value() != std::floor(mrhs.Value())) {
+      continue;
+    }
+
+    // Match a comparison {i < bound} guarding the back edge.
+    for (Node* const cond : node->uses()) {
+      bool strict;
+      switch (cond->opcode()) {
+        case IrOpcode::kJSLessThan:
+        case IrOpcode::kNumberLessThan:
+          strict = true;
+          break;
+        case IrOpcode::kJSLessThanOrEqual:
+        case IrOpcode::kNumberLessThanOrEqual:
+          strict = false;
+          break;
+        default:
+          continue;
+      }
+      if (cond->InputAt(0) != node) continue;
+      bool found = false;
+      for (Node* const branch : cond->uses()) {
+        if (branch->opcode() != IrOpcode::kBranch) continue;
+        for (Node* const if_true : branch->uses()) {
+          if (if_true->opcode() != IrOpcode::kIfTrue) continue;
+          if (NodeProperties::IsDominatedBy(loop->InputAt(1), if_true,
+                                            temp_zone)) {
+            found = true;
+          }
+        }
+      }
+      if (found) {
+        Node* bound = cond->InputAt(1);
+        induction_variables_.insert(std::make_pair(
+            node->id(), InductionVariable{bound, mrhs.Value(), strict}));
+        bounds->push_back(bound);
+        break;
+      }
+    }
+  }
+}
+
+
 Type* Typer::Visitor::TypeEffectPhi(Node* node) {
   UNREACHABLE();
   return nullptr;
@@ -2503,6 +2627,15 @@ Type* Typer::Visitor::TypeFloat32RoundTiesEven(Node* node) {
 }
 
 
+Type* Typer::Visitor::TypeFloat64Sin(Node* node) { return Type::Number(); }
+
+
+Type* Typer::Visitor::TypeFloat64Cos(Node* node) { return Type::Number(); }
+
+
+Type* Typer::Visitor::TypeFloat64Tan(Node* node) { return Type::Number(); }
+
+
 Type* Typer::Visitor::TypeFloat64RoundTiesEven(Node* node) {
   // TODO(sigurds): We could have a tighter bound here.
   return Type::Number();
@@ -2563,6 +2696,30 @@ Type* Typer::Visitor::TypeWord32PairShr(Node* node) { return Type::Internal(); }
 
 Type* Typer::Visitor::TypeWord32PairSar(Node* node) { return Type::Internal(); }
 
+Type* Typer::Visitor::TypeFloat32x4Splat(Node* node) {
+  return Type::Internal();
+}
+
+Type* Typer::Visitor::TypeFloat32x4ExtractLane(Node* node) {
+  return Type::Number();
+}
+
+Type* Typer::Visitor::TypeFloat32x4Add(Node* node) { return Type::Internal(); }
+
+Type* Typer::Visitor::TypeFloat32x4Sub(Node* node) { return Type::Internal(); }
+
+Type* Typer::Visitor::TypeFloat32x4Mul(Node* node) { return Type::Internal(); }
+
+Type* Typer::Visitor::TypeInt32x4Splat(Node* node) { return Type::Internal(); }
+
+Type* Typer::Visitor::TypeInt32x4ExtractLane(Node* node) {
+  return Type::Integral32();
+}
+
+Type* Typer::Visitor::TypeInt32x4Add(Node* node) { return Type::Internal(); }
+
+Type* Typer::Visitor::TypeInt32x4Sub(Node* node) { return Type::Internal(); }
+
 // Heap constants.
 
 
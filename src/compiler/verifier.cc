@@ -984,6 +984,9 @@ void Verifier::Visitor::Check(Node* node) {
     case IrOpcode::kFloat64RoundTiesAway:
     case IrOpcode::kFloat32RoundTiesEven:
     case IrOpcode::kFloat64RoundTiesEven:
+    case IrOpcode::kFloat64Sin:
+    case IrOpcode::kFloat64Cos:
+    case IrOpcode::kFloat64Tan:
     case IrOpcode::kFloat64Equal:
     case IrOpcode::kFloat64LessThan:
     case IrOpcode::kFloat64LessThanOrEqual:
@@ -1032,6 +1035,15 @@ void Verifier::Visitor::Check(Node* node) {
     case IrOpcode::kCheckedLoad:
     case IrOpcode::kCheckedStore:
     case IrOpcode::kAtomicLoad:
+    case IrOpcode::kFloat32x4Splat:
+    case IrOpcode::kFloat32x4ExtractLane:
+    case IrOpcode::kFloat32x4Add:
+    case IrOpcode::kFloat32x4Sub:
+    case IrOpcode::kFloat32x4Mul:
+    case IrOpcode::kInt32x4Splat:
+    case IrOpcode::kInt32x4ExtractLane:
+    case IrOpcode::kInt32x4Add:
+    case IrOpcode::kInt32x4Sub:
       // TODO(rossberg): Check.
       break;
   }
@@ -214,12 +214,12 @@ class WasmTrapHelper : public ZoneObject {
           jsgraph()->zone(), f, fun->nargs, Operator::kNoProperties,
           CallDescriptor::kNoFlags);
       Node* inputs[] = {
-          jsgraph()->CEntryStubConstant(fun->result_size),  // C entry
-          message_id,                                       // message id
+          jsgraph()->CEntryStubConstant(fun->result_size),    // C entry
+          message_id,                                         // message id
           jsgraph()->ExternalConstant(
-              ExternalReference(f, jsgraph()->isolate())),  // ref
-          jsgraph()->Int32Constant(fun->nargs),             // arity
-          jsgraph()->Constant(module->instance->context),   // context
+              ExternalReference(f, jsgraph()->isolate())),    // ref
+          jsgraph()->Int32Constant(fun->nargs),               // arity
+          builder_->HeapConstant(module->instance->context),  // context
           *effect_ptr,
           *control_ptr};
 
@@ -260,7 +260,8 @@ WasmGraphBuilder::WasmGraphBuilder(
       cur_bufsize_(kDefaultBufferSize),
       trap_(new (zone) WasmTrapHelper(this)),
       function_signature_(function_signature),
-      source_position_table_(source_position_table) {
+      source_position_table_(source_position_table),
+      bounds_checks_(zone) {
   DCHECK_NOT_NULL(jsgraph_);
 }
 
@@ -892,6 +893,13 @@ Node* WasmGraphBuilder::Constant(Handle<Object> value) {
 }
 
 
+Node* WasmGraphBuilder::HeapConstant(Handle<HeapObject> value) {
+  // Unlike JSGraph::HeapConstant, this neither dereferences nor caches the
+  // handle, so that wasm functions can be decoded on a background thread.
+  return graph()->NewNode(jsgraph()->common()->HeapConstant(value));
+}
+
+
 Node* WasmGraphBuilder::Branch(Node* cond, Node** true_node,
                                Node** false_node) {
   DCHECK_NOT_NULL(cond);
@@ -1873,7 +1881,7 @@ Node* WasmGraphBuilder::CallDirect(uint32_t index, Node** args) {
   DCHECK_NULL(args[0]);
 
   // Add code object as constant.
-  args[0] = Constant(module_->GetFunctionCode(index));
+  args[0] = HeapConstant(module_->GetFunctionCode(index));
   wasm::FunctionSig* sig = module_->GetFunctionSignature(index);
 
   return BuildWasmCall(sig, args);
@@ -1883,7 +1891,7 @@ Node* WasmGraphBuilder::CallImport(uint32_t index, Node** args) {
   DCHECK_NULL(args[0]);
 
   // Add code object as constant.
-  args[0] = Constant(module_->GetImportCode(index));
+  args[0] = HeapConstant(module_->GetImportCode(index));
   wasm::FunctionSig* sig = module_->GetImportSignature(index);
 
   return BuildWasmCall(sig, args);
@@ -2493,6 +2501,50 @@ void WasmGraphBuilder::BuildWasmToJSWrapper(Handle<JSFunction> function,
   MergeControlToEnd(jsgraph(), ret);
 }
 
+void WasmGraphBuilder::BuildWasmLazyCompileStub(wasm::FunctionSig* sig) {
+  DCHECK(module_ && !module_->instance->context.is_null());
+  int wasm_count = static_cast<int>(sig->parameter_count());
+
+  // Build the start and the parameter nodes.
+  Node* start = Start(wasm_count + 1);
+  *control_ = start;
+  *effect_ = start;
+  Node** args = Buffer(wasm_count + 1);
+  for (int i = 0; i < wasm_count; i++) {
+    args[i + 1] = Param(i, sig->GetParam(i));
+  }
+
+  // Call the runtime to compile the function. It returns the code object,
+  // which identifies the function by the frame of this stub.
+  Runtime::FunctionId f = Runtime::kWasmCompileLazy;
+  const Runtime::Function* fun = Runtime::FunctionForId(f);
+  CallDescriptor* desc = Linkage::GetRuntimeCallDescriptor(
+      jsgraph()->zone(), f, fun->nargs, Operator::kNoProperties,
+      CallDescriptor::kNoFlags);
+  Node* inputs[] = {
+      jsgraph()->CEntryStubConstant(fun->result_size),  // C entry
+      jsgraph()->ExternalConstant(
+          ExternalReference(f, jsgraph()->isolate())),  // ref
+      jsgraph()->Int32Constant(fun->nargs),             // arity
+      HeapConstant(module_->instance->context),         // context
+      *effect_,
+      *control_};
+  Node* code = graph()->NewNode(jsgraph()->common()->Call(desc),
+                                static_cast<int>(arraysize(inputs)), inputs);
+  *effect_ = code;
+  *control_ = code;
+
+  // Call the compiled code with the parameters of the stub.
+  args[0] = code;
+  Node* call = BuildWasmCall(sig, args);
+  if (sig->return_count() == 0) {
+    ReturnVoid();
+  } else {
+    Node** vals = Buffer(1);
+    vals[0] = call;
+    Return(1, vals);
+  }
+}
 
 Node* WasmGraphBuilder::MemBuffer(uint32_t offset) {
   DCHECK(module_ && module_->instance);
@@ -2527,18 +2579,19 @@ Node* WasmGraphBuilder::FunctionTable() {
   DCHECK(module_ && module_->instance &&
          !module_->instance->function_table.is_null());
   if (!function_table_) {
-    function_table_ = jsgraph()->Constant(module_->instance->function_table);
+    function_table_ = HeapConstant(module_->instance->function_table);
   }
   return function_table_;
 }
 
 
 Node* WasmGraphBuilder::LoadGlobal(uint32_t index) {
-  DCHECK(module_ && module_->instance && module_->instance->globals_start);
+  DCHECK(module_ && module_->instance);
   MachineType mem_type = module_->GetGlobalType(index);
-  Node* addr = jsgraph()->IntPtrConstant(
+  Node* addr = jsgraph()->RelocatableIntPtrConstant(
       reinterpret_cast<uintptr_t>(module_->instance->globals_start +
-                                  module_->module->globals[index].offset));
+                                  module_->module->globals[index].offset),
+      RelocInfo::WASM_GLOBAL_REFERENCE);
   const Operator* op = jsgraph()->machine()->Load(mem_type);
   Node* node = graph()->NewNode(op, addr, jsgraph()->Int32Constant(0), *effect_,
                                 *control_);
@@ -2548,11 +2601,12 @@ Node* WasmGraphBuilder::LoadGlobal(uint32_t index) {
 
 
 Node* WasmGraphBuilder::StoreGlobal(uint32_t index, Node* val) {
-  DCHECK(module_ && module_->instance && module_->instance->globals_start);
+  DCHECK(module_ && module_->instance);
   MachineType mem_type = module_->GetGlobalType(index);
-  Node* addr = jsgraph()->IntPtrConstant(
+  Node* addr = jsgraph()->RelocatableIntPtrConstant(
       reinterpret_cast<uintptr_t>(module_->instance->globals_start +
-                                  module_->module->globals[index].offset));
+                                  module_->module->globals[index].offset),
+      RelocInfo::WASM_GLOBAL_REFERENCE);
   const Operator* op = jsgraph()->machine()->Store(
       StoreRepresentation(mem_type.representation(), kNoWriteBarrier));
   Node* node = graph()->NewNode(op, addr, jsgraph()->Int32Constant(0), val,
@@ -2564,24 +2618,43 @@ Node* WasmGraphBuilder::StoreGlobal(uint32_t index, Node* val) {
 
 void WasmGraphBuilder::BoundsCheckMem(MachineType memtype, Node* index,
                                       uint32_t offset) {
-  // TODO(turbofan): fold bounds checks for constant indexes.
   DCHECK(module_ && module_->instance);
   size_t size = module_->instance->mem_size;
   byte memsize = wasm::WasmOpcodes::MemSize(memtype);
-  Node* cond;
-  if (offset >= size || (static_cast<uint64_t>(offset) + memsize) > size) {
+  uint64_t end = static_cast<uint64_t>(offset) + memsize;
+  if (end > size) {
     // The access will always throw.
-    cond = jsgraph()->Int32Constant(0);
-  } else {
-    // Check against the limit.
-    size_t limit = size - offset - memsize;
-    CHECK(limit <= kMaxUInt32);
-    cond = graph()->NewNode(
-        jsgraph()->machine()->Uint32LessThanOrEqual(), index,
-        jsgraph()->Int32Constant(static_cast<uint32_t>(limit)));
+    trap_->AddTrapIfFalse(wasm::kTrapMemOutOfBounds,
+                          jsgraph()->Int32Constant(0));
+    return;
+  }
+  size_t limit = size - static_cast<size_t>(end);
+  CHECK(limit <= kMaxUInt32);
+
+  Uint32Matcher match(index);
+  if (match.HasValue()) {
+    // Constant indexes are checked at compile time.
+    if (match.Value() > limit) {
+      trap_->AddTrapIfFalse(wasm::kTrapMemOutOfBounds,
+                            jsgraph()->Int32Constant(0));
+    }
+    return;
   }
 
+  // The control after a check is only reachable through the check, so the
+  // checks recorded on the way to {bounds_checked_control_} hold there. An
+  // access that does not extend beyond a checked one needs no check.
+  if (*control_ != bounds_checked_control_) bounds_checks_.clear();
+  for (const std::pair<Node*, uint64_t>& check : bounds_checks_) {
+    if (check.first == index && check.second >= end) return;
+  }
+
+  Node* cond = graph()->NewNode(
+      jsgraph()->machine()->Uint32LessThanOrEqual(), index,
+      jsgraph()->Int32Constant(static_cast<uint32_t>(limit)));
   trap_->AddTrapIfFalse(wasm::kTrapMemOutOfBounds, cond);
+  bounds_checked_control_ = *control_;
+  bounds_checks_.push_back(std::make_pair(index, end));
 }
 
 
@@ -2855,140 +2928,178 @@ Handle<Code> CompileWasmToJSWrapper(Isolate* isolate, wasm::ModuleEnv* module,
   return code;
 }
 
-std::pair<JSGraph*, SourcePositionTable*> BuildGraphForWasmFunction(
-    Zone* zone, wasm::ErrorThrower* thrower, Isolate* isolate,
-    wasm::ModuleEnv*& module_env, const wasm::WasmFunction* function,
-    double* decode_ms) {
-  base::ElapsedTimer decode_timer;
-  if (FLAG_trace_wasm_decode_time) {
-    decode_timer.Start();
-  }
-  // Create a TF graph during decoding.
-  Graph* graph = new (zone) Graph(zone);
-  CommonOperatorBuilder* common = new (zone) CommonOperatorBuilder(zone);
-  MachineOperatorBuilder* machine = new (zone) MachineOperatorBuilder(
-      zone, MachineType::PointerRepresentation(),
+Handle<Code> CompileWasmLazyCompileStub(Isolate* isolate,
+                                        wasm::ModuleEnv* module_env,
+                                        const wasm::WasmFunction* function) {
+  //----------------------------------------------------------------------------
+  // Create the Graph
+  //----------------------------------------------------------------------------
+  Zone zone(isolate->allocator());
+  Graph graph(&zone);
+  CommonOperatorBuilder common(&zone);
+  MachineOperatorBuilder machine(
+      &zone, MachineType::PointerRepresentation(),
       InstructionSelector::SupportedMachineOperatorFlags());
-  JSGraph* jsgraph =
-      new (zone) JSGraph(isolate, graph, common, nullptr, nullptr, machine);
-  SourcePositionTable* source_position_table =
-      new (zone) SourcePositionTable(graph);
-  WasmGraphBuilder builder(zone, jsgraph, function->sig, source_position_table);
-  wasm::FunctionBody body = {
-      module_env, function->sig, module_env->module->module_start,
-      module_env->module->module_start + function->code_start_offset,
-      module_env->module->module_start + function->code_end_offset};
-  wasm::TreeResult result =
-      wasm::BuildTFGraph(isolate->allocator(), &builder, body);
-
-  if (machine->Is32()) {
-    Int64Lowering r(graph, machine, common, zone, function->sig);
+  JSGraph jsgraph(isolate, &graph, &common, nullptr, nullptr, &machine);
+
+  Node* control = nullptr;
+  Node* effect = nullptr;
+
+  WasmGraphBuilder builder(&zone, &jsgraph, function->sig);
+  builder.set_control_ptr(&control);
+  builder.set_effect_ptr(&effect);
+  builder.set_module(module_env);
+  builder.BuildWasmLazyCompileStub(function->sig);
+  if (machine.Is32()) {
+    Int64Lowering r(&graph, &machine, &common, &zone, function->sig);
     r.LowerGraph();
   }
 
-  if (result.failed()) {
-    if (FLAG_trace_wasm_compiler) {
-      OFStream os(stdout);
-      os << "Compilation failed: " << result << std::endl;
-    }
-    // Add the function as another context for the exception
-    ScopedVector<char> buffer(128);
-    wasm::WasmName name = module_env->module->GetName(function->name_offset,
-                                                      function->name_length);
-    SNPrintF(buffer, "Compiling WASM function #%d:%.*s failed:",
-             function->func_index, name.length(), name.start());
-    thrower->Failed(buffer.start(), result);
-    return std::make_pair(nullptr, nullptr);
+  //----------------------------------------------------------------------------
+  // Run the compilation pipeline.
+  //----------------------------------------------------------------------------
+  if (FLAG_trace_turbo_graph) {  // Simple textual RPO.
+    OFStream os(stdout);
+    os << "-- Graph after change lowering -- " << std::endl;
+    os << AsRPO(graph);
   }
-  int index = static_cast<int>(function->func_index);
-  if (index >= FLAG_trace_wasm_ast_start && index < FLAG_trace_wasm_ast_end) {
-    PrintAst(isolate->allocator(), body);
+
+  // The stub is called like the function it stands for.
+  CallDescriptor* incoming =
+      wasm::ModuleEnv::GetWasmCallDescriptor(&zone, function->sig);
+  if (machine.Is32()) {
+    incoming = wasm::ModuleEnv::GetI32WasmCallDescriptor(&zone, incoming);
   }
-  if (FLAG_trace_wasm_decode_time) {
-    *decode_ms = decode_timer.Elapsed().InMillisecondsF();
+  Code::Flags flags = Code::ComputeFlags(Code::WASM_FUNCTION);
+  CompilationInfo info(ArrayVector("wasm-lazy-compile"), isolate, &zone,
+                       flags);
+  Handle<Code> code =
+      Pipeline::GenerateCodeForTesting(&info, incoming, &graph, nullptr);
+#ifdef ENABLE_DISASSEMBLER
+  if (FLAG_print_opt_code && !code.is_null()) {
+    OFStream os(stdout);
+    code->Disassemble("wasm-lazy-compile", os);
   }
-  return std::make_pair(jsgraph, source_position_table);
+#endif
+
+  RecordFunctionCompilation(
+      Logger::FUNCTION_TAG, &info, "wasm-lazy-compile", function->func_index,
+      module_env->module->GetName(function->name_offset,
+                                  function->name_length));
+  return code;
 }
 
-// Helper function to compile a single function.
-Handle<Code> CompileWasmFunction(wasm::ErrorThrower* thrower, Isolate* isolate,
-                                 wasm::ModuleEnv* module_env,
-                                 const wasm::WasmFunction* function) {
-  HistogramTimerScope wasm_compile_function_time_scope(
-      isolate->counters()->wasm_compile_function_time());
-  if (FLAG_trace_wasm_compiler) {
-    OFStream os(stdout);
-    os << "Compiling WASM function "
-       << wasm::WasmFunctionName(function, module_env) << std::endl;
-    os << std::endl;
+class WasmCompilationUnit {
+ public:
+  WasmCompilationUnit(wasm::ErrorThrower* thrower, Isolate* isolate,
+                      wasm::ModuleEnv* module_env,
+                      const wasm::WasmFunction* function)
+      : thrower_(thrower),
+        isolate_(isolate),
+        module_env_(module_env),
+        function_(function),
+        graph_zone_(isolate->allocator()),
+        jsgraph_(new (&graph_zone_) JSGraph(
+            isolate, new (&graph_zone_) Graph(&graph_zone_),
+            new (&graph_zone_) CommonOperatorBuilder(&graph_zone_), nullptr,
+            nullptr,
+            new (&graph_zone_) MachineOperatorBuilder(
+                &graph_zone_, MachineType::PointerRepresentation(),
+                InstructionSelector::SupportedMachineOperatorFlags()))),
+        source_positions_(new (&graph_zone_)
+                              SourcePositionTable(jsgraph_->graph())),
+        func_name_(GetDebugName()),
+        info_(func_name_, isolate, &graph_zone_,
+              Code::ComputeFlags(Code::WASM_FUNCTION)),
+        ok_(true) {
+    if (FLAG_turbo_fast_register_allocation || UseFastTier(function)) {
+      info_.MarkAsFastRegisterAllocation();
+    }
+    // The trap code calls into the runtime through the CEntryStub, which may
+    // have to be generated. Do that here, on the main thread, so that graph
+    // building does not need to allocate.
+    jsgraph_->CEntryStubConstant(1);
   }
 
-  compiler::ZonePool zone_pool(isolate->allocator());
-  compiler::ZonePool::Scope graph_zone_scope(&zone_pool);
-  double decode_ms = 0;
-  std::pair<JSGraph*, SourcePositionTable*> graph_result =
-      BuildGraphForWasmFunction(graph_zone_scope.zone(), thrower, isolate,
-                                module_env, function, &decode_ms);
-  JSGraph* jsgraph = graph_result.first;
-  SourcePositionTable* source_positions = graph_result.second;
+  ~WasmCompilationUnit() { name_buffer_.Dispose(); }
 
-  if (jsgraph == nullptr) {
-    return Handle<Code>::null();
+  // Register allocation time grows faster than the size of the function, and
+  // the largest functions of big modules tend to be run rarely, e.g. once to
+  // initialize data. Those are compiled with the fast tier.
+  static bool UseFastTier(const wasm::WasmFunction* function) {
+    if (FLAG_wasm_fast_tier_body_size <= 0) return false;
+    uint32_t body_size =
+        function->code_end_offset - function->code_start_offset;
+    return body_size >= static_cast<uint32_t>(FLAG_wasm_fast_tier_body_size);
   }
 
-  base::ElapsedTimer compile_timer;
-  if (FLAG_trace_wasm_decode_time) {
-    compile_timer.Start();
-  }
-  // Run the compiler pipeline to generate machine code.
-  CallDescriptor* descriptor = wasm::ModuleEnv::GetWasmCallDescriptor(
-      jsgraph->graph()->zone(), function->sig);
-  if (jsgraph->machine()->Is32()) {
-    descriptor = module_env->GetI32WasmCallDescriptor(jsgraph->graph()->zone(),
-                                                      descriptor);
-  }
-  Code::Flags flags = Code::ComputeFlags(Code::WASM_FUNCTION);
-  // add flags here if a meaningful name is helpful for debugging.
-  bool debugging =
-#if DEBUG
-      true;
-#else
-      FLAG_print_opt_code || FLAG_trace_turbo || FLAG_trace_turbo_graph;
-#endif
-  Vector<const char> func_name = module_env->module->GetNameOrNull(
-      function->name_offset, function->name_length);
-  Vector<char> buffer;
-  if (func_name.is_empty()) {
-    if (debugging) {
-      buffer = Vector<char>::New(128);
-      int chars = SNPrintF(buffer, "WASM_function_#%d", function->func_index);
-      func_name = Vector<const char>::cast(buffer.SubVector(0, chars));
-    } else {
-      func_name = ArrayVector("wasm");
+  // Builds and optimizes the graph and selects instructions. This neither
+  // allocates on the heap nor dereferences handles, so it may run on a
+  // background thread.
+  void ExecuteCompilation() {
+    if (FLAG_trace_wasm_compiler) {
+      OFStream os(stdout);
+      os << "Compiling WASM function "
+         << wasm::WasmFunctionName(function_, module_env_) << std::endl;
+      os << std::endl;
+    }
+
+    base::ElapsedTimer timer;
+    if (FLAG_trace_wasm_decode_time) timer.Start();
+    if (!BuildGraph()) {
+      ok_ = false;
+      return;
+    }
+    if (FLAG_trace_wasm_decode_time) {
+      decode_ms_ = timer.Elapsed().InMillisecondsF();
+      timer.Restart();
+    }
+
+    CallDescriptor* descriptor =
+        wasm::ModuleEnv::GetWasmCallDescriptor(&graph_zone_, function_->sig);
+    if (jsgraph_->machine()->Is32()) {
+      descriptor =
+          module_env_->GetI32WasmCallDescriptor(&graph_zone_, descriptor);
+    }
+    job_.Reset(Pipeline::NewWasmCompilationJob(&info_, jsgraph_->graph(),
+                                               descriptor, source_positions_));
+    ok_ = job_->OptimizeGraph() == CompilationJob::SUCCEEDED;
+    if (FLAG_trace_wasm_decode_time) {
+      compile_ms_ = timer.Elapsed().InMillisecondsF();
     }
-  }
-  CompilationInfo info(func_name, isolate, jsgraph->graph()->zone(), flags);
-  base::SmartPointer<CompilationJob> job(Pipeline::NewWasmCompilationJob(
-      &info, jsgraph->graph(), descriptor, source_positions));
-  Handle<Code> code = Handle<Code>::null();
-  if (job->OptimizeGraph() == CompilationJob::SUCCEEDED &&
-      job->GenerateCode() == CompilationJob::SUCCEEDED) {
-    code = info.code();
   }
 
-  buffer.Dispose();
+  // Allocates the code object and reports errors. Must run on the main
+  // thread, after ExecuteCompilation.
+  Handle<Code> FinishCompilation() {
+    if (graph_construction_result_.failed()) {
+      // Add the function as another context for the exception
+      ScopedVector<char> buffer(128);
+      wasm::WasmName name = module_env_->module->GetName(
+          function_->name_offset, function_->name_length);
+      SNPrintF(buffer, "Compiling WASM function #%d:%.*s failed:",
+               function_->func_index, name.length(), name.start());
+      thrower_->Failed(buffer.start(), graph_construction_result_);
+      return Handle<Code>::null();
+    }
+    if (!ok_) return Handle<Code>::null();
 
-  if (!code.is_null()) {
+    base::ElapsedTimer timer;
+    if (FLAG_trace_wasm_decode_time) timer.Start();
+    if (job_->GenerateCode() != CompilationJob::SUCCEEDED) {
+      return Handle<Code>::null();
+    }
+    Handle<Code> code = info_.code();
     DCHECK(code->deoptimization_data() == nullptr ||
            code->deoptimization_data()->length() == 0);
     Handle<FixedArray> deopt_data =
-        isolate->factory()->NewFixedArray(2, TENURED);
-    if (!module_env->instance->js_object.is_null()) {
-      deopt_data->set(0, *module_env->instance->js_object);
-      deopt_data->set(1, Smi::FromInt(function->func_index));
-    } else if (func_name.start() != nullptr) {
+        isolate_->factory()->NewFixedArray(2, TENURED);
+    if (!module_env_->instance->js_object.is_null()) {
+      deopt_data->set(0, *module_env_->instance->js_object);
+      deopt_data->set(1, Smi::FromInt(function_->func_index));
+    } else if (func_name_.start() != nullptr) {
       MaybeHandle<String> maybe_name =
-          isolate->factory()->NewStringFromUtf8(func_name);
+          isolate_->factory()->NewStringFromUtf8(func_name_);
       if (!maybe_name.is_null())
         deopt_data->set(0, *maybe_name.ToHandleChecked());
     }
@@ -2996,55 +3107,110 @@ Handle<Code> CompileWasmFunction(wasm::ErrorThrower* thrower, Isolate* isolate,
     code->set_deoptimization_data(*deopt_data);
 
     RecordFunctionCompilation(
-        Logger::FUNCTION_TAG, &info, "WASM_function", function->func_index,
-        module_env->module->GetName(function->name_offset,
-                                    function->name_length));
-  }
-
-  if (FLAG_trace_wasm_decode_time) {
-    double compile_ms = compile_timer.Elapsed().InMillisecondsF();
-    PrintF(
-        "wasm-compile ok: %d bytes, %0.3f ms decode, %d nodes, %0.3f ms "
-        "compile\n",
-        static_cast<int>(function->code_end_offset -
-                         function->code_start_offset),
-        decode_ms, static_cast<int>(jsgraph->graph()->NodeCount()), compile_ms);
-  }
-  // TODO(bradnelson): Improve histogram handling of size_t.
-  isolate->counters()->wasm_compile_function_peak_memory_bytes()->AddSample(
-      static_cast<int>(jsgraph->graph()->zone()->allocation_size()));
-  graph_zone_scope.Destroy();
-  return code;
-}
+        Logger::FUNCTION_TAG, &info_, "WASM_function", function_->func_index,
+        module_env_->module->GetName(function_->name_offset,
+                                     function_->name_length));
+
+    if (FLAG_trace_wasm_decode_time) {
+      double compile_ms = compile_ms_ + timer.Elapsed().InMillisecondsF();
+      PrintF(
+          "wasm-compile ok: %d bytes, %0.3f ms decode, %d nodes, %0.3f ms "
+          "compile\n",
+          static_cast<int>(function_->code_end_offset -
+                           function_->code_start_offset),
+          decode_ms_, static_cast<int>(jsgraph_->graph()->NodeCount()),
+          compile_ms);
+    }
+    // TODO(bradnelson): Improve histogram handling of size_t.
+    isolate_->counters()->wasm_compile_function_peak_memory_bytes()->AddSample(
+        static_cast<int>(graph_zone_.allocation_size()));
+    return code;
+  }
 
-class WasmCompilationUnit {
- public:
-  WasmCompilationUnit(wasm::ErrorThrower* thrower, Isolate* isolate,
-                      wasm::ModuleEnv* module_env,
-                      const wasm::WasmFunction* function)
-      : thrower_(thrower),
-        isolate_(isolate),
-        module_env_(module_env),
-        function_(function) {}
+  int index() const { return static_cast<int>(function_->func_index); }
 
-  void ExecuteCompilation() {
-    if (function_->external) {
-      return;
+ private:
+  // Decodes the function body into a TF graph. Failures are recorded in
+  // {graph_construction_result_} and reported in FinishCompilation.
+  bool BuildGraph() {
+    WasmGraphBuilder builder(&graph_zone_, jsgraph_, function_->sig,
+                             source_positions_);
+    wasm::FunctionBody body = {
+        module_env_, function_->sig, module_env_->module->module_start,
+        module_env_->module->module_start + function_->code_start_offset,
+        module_env_->module->module_start + function_->code_end_offset};
+    graph_construction_result_ =
+        wasm::BuildTFGraph(isolate_->allocator(), &builder, body);
+
+    if (jsgraph_->machine()->Is32()) {
+      Int64Lowering r(jsgraph_->graph(), jsgraph_->machine(),
+                      jsgraph_->common(), &graph_zone_, function_->sig);
+      r.LowerGraph();
     }
-    // TODO(ahaas): The parallelizable parts of the compilation should move from
-    // FinishCompilation to here.
+
+    if (graph_construction_result_.failed()) {
+      if (FLAG_trace_wasm_compiler) {
+        OFStream os(stdout);
+        os << "Compilation failed: " << graph_construction_result_
+           << std::endl;
+      }
+      return false;
+    }
+    int index = static_cast<int>(function_->func_index);
+    if (index >= FLAG_trace_wasm_ast_start && index < FLAG_trace_wasm_ast_end) {
+      PrintAst(isolate_->allocator(), body);
+    }
+    return true;
   }
 
-  Handle<Code> FinishCompilation() {
-    return CompileWasmFunction(thrower_, isolate_, module_env_, function_);
+  Vector<const char> GetDebugName() {
+    Vector<const char> func_name = module_env_->module->GetNameOrNull(
+        function_->name_offset, function_->name_length);
+    if (!func_name.is_empty()) return func_name;
+    // add flags here if a meaningful name is helpful for debugging.
+    bool debugging =
+#if DEBUG
+        true;
+#else
+        FLAG_print_opt_code || FLAG_trace_turbo || FLAG_trace_turbo_graph;
+#endif
+    if (!debugging) return ArrayVector("wasm");
+    name_buffer_ = Vector<char>::New(128);
+    int chars =
+        SNPrintF(name_buffer_, "WASM_function_#%d", function_->func_index);
+    return Vector<const char>::cast(name_buffer_.SubVector(0, chars));
   }
 
   wasm::ErrorThrower* thrower_;
   Isolate* isolate_;
   wasm::ModuleEnv* module_env_;
   const wasm::WasmFunction* function_;
+  Zone graph_zone_;
+  JSGraph* jsgraph_;
+  SourcePositionTable* source_positions_;
+  Vector<char> name_buffer_;
+  Vector<const char> func_name_;
+  CompilationInfo info_;
+  base::SmartPointer<CompilationJob> job_;
+  wasm::TreeResult graph_construction_result_;
+  bool ok_;
+  double decode_ms_ = 0;
+  double compile_ms_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(WasmCompilationUnit);
 };
 
+// Helper function to compile a single function.
+Handle<Code> CompileWasmFunction(wasm::ErrorThrower* thrower, Isolate* isolate,
+                                 wasm::ModuleEnv* module_env,
+                                 const wasm::WasmFunction* function) {
+  HistogramTimerScope wasm_compile_function_time_scope(
+      isolate->counters()->wasm_compile_function_time());
+  WasmCompilationUnit unit(thrower, isolate, module_env, function);
+  unit.ExecuteCompilation();
+  return unit.FinishCompilation();
+}
+
 WasmCompilationUnit* CreateWasmCompilationUnit(
     wasm::ErrorThrower* thrower, Isolate* isolate, wasm::ModuleEnv* module_env,
     const wasm::WasmFunction* function) {
@@ -3055,12 +3221,18 @@ void ExecuteCompilation(WasmCompilationUnit* unit) {
   unit->ExecuteCompilation();
 }
 
+int GetIndexOfWasmCompilationUnit(WasmCompilationUnit* unit) {
+  return unit->index();
+}
+
 Handle<Code> FinishCompilation(WasmCompilationUnit* unit) {
   Handle<Code> result = unit->FinishCompilation();
   delete unit;
   return result;
 }
 
+void DeleteWasmCompilationUnit(WasmCompilationUnit* unit) { delete unit; }
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
@@ -9,6 +9,7 @@
 // Do not include anything from src/compiler here!
 #include "src/wasm/wasm-opcodes.h"
 #include "src/zone.h"
+#include "src/zone-containers.h"
 
 namespace v8 {
 namespace internal {
@@ -53,6 +54,12 @@ Handle<JSFunction> CompileJSToWasmWrapper(
     Isolate* isolate, wasm::ModuleEnv* module, Handle<String> name,
     Handle<Code> wasm_code, Handle<JSObject> module_object, uint32_t index);
 
+// Compiles a stub with the signature of {function} that has the function
+// compiled by the runtime on its first call, and then calls the result.
+Handle<Code> CompileWasmLazyCompileStub(Isolate* isolate,
+                                        wasm::ModuleEnv* module_env,
+                                        const wasm::WasmFunction* function);
+
 WasmCompilationUnit* CreateWasmCompilationUnit(
     wasm::ErrorThrower* thrower, Isolate* isolate, wasm::ModuleEnv* module_env,
     const wasm::WasmFunction* function);
@@ -63,6 +70,9 @@ int GetIndexOfWasmCompilationUnit(WasmCompilationUnit* unit);
 
 Handle<Code> FinishCompilation(WasmCompilationUnit* unit);
 
+// Deletes a unit whose code is not needed, without reporting its errors.
+void DeleteWasmCompilationUnit(WasmCompilationUnit* unit);
+
 // Abstracts details of building TurboFan graph nodes for WASM to separate
 // the WASM decoder from the internal details of TurboFan.
 class WasmTrapHelper;
@@ -99,6 +109,7 @@ class WasmGraphBuilder {
   Node* Float32Constant(float value);
   Node* Float64Constant(double value);
   Node* Constant(Handle<Object> value);
+  Node* HeapConstant(Handle<HeapObject> value);
   Node* Binop(wasm::WasmOpcode opcode, Node* left, Node* right);
   Node* Unop(wasm::WasmOpcode opcode, Node* input);
   unsigned InputCount(Node* node);
@@ -123,6 +134,7 @@ class WasmGraphBuilder {
   void BuildJSToWasmWrapper(Handle<Code> wasm_code, wasm::FunctionSig* sig);
   void BuildWasmToJSWrapper(Handle<JSFunction> function,
                             wasm::FunctionSig* sig);
+  void BuildWasmLazyCompileStub(wasm::FunctionSig* sig);
 
   Node* ToJS(Node* node, Node* context, wasm::LocalType type);
   Node* FromJS(Node* node, Node* context, wasm::LocalType type);
@@ -178,6 +190,12 @@ class WasmGraphBuilder {
 
   compiler::SourcePositionTable* source_position_table_ = nullptr;
 
+  // The memory accesses that have been bounds checked on the way to
+  // {bounds_checked_control_}, as pairs of an index and the end of the
+  // checked range relative to that index.
+  Node* bounds_checked_control_ = nullptr;
+  ZoneVector<std::pair<Node*, uint64_t>> bounds_checks_;
+
   // Internal helper methods.
   JSGraph* jsgraph() { return jsgraph_; }
   Graph* graph();
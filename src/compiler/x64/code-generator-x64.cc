@@ -597,6 +597,14 @@ class OutOfLineRecordWrite final : public OutOfLineCode {
     }                                                            \
   } while (false)
 
+#define ASSEMBLE_FDLIBM_UNOP(name)                                           \
+  do {                                                                       \
+    /* The input and the result are in xmm0, see the instruction selector. */ \
+    __ PrepareCallCFunction(1);                                              \
+    __ CallCFunction(ExternalReference::fdlibm_##name##_function(isolate()), \
+                     1);                                                     \
+  } while (false)
+
 void CodeGenerator::AssembleDeconstructFrame() {
   __ movq(rsp, rbp);
   __ popq(rbp);
@@ -1142,6 +1150,15 @@ CodeGenerator::CodeGenResult CodeGenerator::AssembleArchInstruction(
     case kSSEFloat64Sqrt:
       ASSEMBLE_SSE_UNOP(sqrtsd);
       break;
+    case kX64Float64Sin:
+      ASSEMBLE_FDLIBM_UNOP(sin);
+      break;
+    case kX64Float64Cos:
+      ASSEMBLE_FDLIBM_UNOP(cos);
+      break;
+    case kX64Float64Tan:
+      ASSEMBLE_FDLIBM_UNOP(tan);
+      break;
     case kSSEFloat64Round: {
       CpuFeatureScope sse_scope(masm(), SSE4_1);
       RoundingMode const mode =
@@ -1619,6 +1636,15 @@ CodeGenerator::CodeGenResult CodeGenerator::AssembleArchInstruction(
         __ Movsd(operand, i.InputDoubleRegister(index));
       }
       break;
+    case kX64Movdqu:
+      if (instr->HasOutput()) {
+        __ movdqu(i.OutputDoubleRegister(), i.MemoryOperand());
+      } else {
+        size_t index = 0;
+        Operand operand = i.MemoryOperand(&index);
+        __ movdqu(operand, i.InputDoubleRegister(index));
+      }
+      break;
     case kX64BitcastFI:
       if (instr->InputAt(0)->IsDoubleStackSlot()) {
         __ movl(i.OutputRegister(), i.InputOperand(0));
@@ -1763,6 +1789,54 @@ CodeGenerator::CodeGenResult CodeGenerator::AssembleArchInstruction(
     case kX64StackCheck:
       __ CompareRoot(rsp, Heap::kStackLimitRootIndex);
       break;
+    case kX64Float32x4Splat:
+      DCHECK(i.OutputDoubleRegister().is(i.InputDoubleRegister(0)));
+      __ shufps(i.OutputDoubleRegister(), i.OutputDoubleRegister(), 0x0);
+      break;
+    case kX64Float32x4ExtractLane: {
+      DCHECK(i.OutputDoubleRegister().is(i.InputDoubleRegister(0)));
+      // Shuffle the lane into the low lane, where the scalar float lives.
+      int8_t lane = i.InputInt8(1);
+      if (lane != 0) {
+        __ shufps(i.OutputDoubleRegister(), i.OutputDoubleRegister(), lane);
+      }
+      break;
+    }
+    case kX64Float32x4Add:
+      __ addps(i.OutputDoubleRegister(), i.InputDoubleRegister(1));
+      break;
+    case kX64Float32x4Sub:
+      __ subps(i.OutputDoubleRegister(), i.InputDoubleRegister(1));
+      break;
+    case kX64Float32x4Mul:
+      __ mulps(i.OutputDoubleRegister(), i.InputDoubleRegister(1));
+      break;
+    case kX64Int32x4Splat: {
+      XMMRegister dst = i.OutputDoubleRegister();
+      if (instr->InputAt(0)->IsRegister()) {
+        __ Movd(dst, i.InputRegister(0));
+      } else {
+        __ Movd(dst, i.InputOperand(0));
+      }
+      __ pshufd(dst, dst, 0x0);
+      break;
+    }
+    case kX64Int32x4ExtractLane: {
+      int8_t lane = i.InputInt8(1);
+      if (lane == 0) {
+        __ Movd(i.OutputRegister(), i.InputDoubleRegister(0));
+      } else {
+        __ pshufd(kScratchDoubleReg, i.InputDoubleRegister(0), lane);
+        __ Movd(i.OutputRegister(), kScratchDoubleReg);
+      }
+      break;
+    }
+    case kX64Int32x4Add:
+      __ paddd(i.OutputDoubleRegister(), i.InputDoubleRegister(1));
+      break;
+    case kX64Int32x4Sub:
+      __ psubd(i.OutputDoubleRegister(), i.InputDoubleRegister(1));
+      break;
     case kAtomicLoadInt8:
     case kAtomicLoadUint8:
     case kAtomicLoadInt16:
@@ -2112,7 +2186,7 @@ void CodeGenerator::AssembleMove(InstructionOperand* source,
                                                : kScratchRegister;
       switch (src.type()) {
         case Constant::kInt32: {
-          if (src.rmode() == RelocInfo::WASM_MEMORY_REFERENCE) {
+          if (RelocInfo::IsWasmReference(src.rmode())) {
             __ movq(dst, src.ToInt64(), src.rmode());
           } else {
             // TODO(dcarney): don't need scratch in this case.
@@ -2126,7 +2200,7 @@ void CodeGenerator::AssembleMove(InstructionOperand* source,
           break;
         }
         case Constant::kInt64:
-          if (src.rmode() == RelocInfo::WASM_MEMORY_REFERENCE) {
+          if (RelocInfo::IsWasmReference(src.rmode())) {
             __ movq(dst, src.ToInt64(), src.rmode());
           } else {
             __ Set(dst, src.ToInt64());
@@ -2189,11 +2263,27 @@ void CodeGenerator::AssembleMove(InstructionOperand* source,
     if (destination->IsDoubleRegister()) {
       XMMRegister dst = g.ToDoubleRegister(destination);
       __ Movapd(dst, src);
+    } else if (source->IsSimd128Register()) {
+      DCHECK(destination->IsSimd128StackSlot());
+      Operand dst = g.ToOperand(destination);
+      __ movdqu(dst, src);
     } else {
       DCHECK(destination->IsDoubleStackSlot());
       Operand dst = g.ToOperand(destination);
       __ Movsd(dst, src);
     }
+  } else if (source->IsSimd128StackSlot()) {
+    DCHECK(destination->IsSimd128Register() ||
+           destination->IsSimd128StackSlot());
+    Operand src = g.ToOperand(source);
+    if (destination->IsSimd128Register()) {
+      __ movdqu(g.ToDoubleRegister(destination), src);
+    } else {
+      // We rely on having xmm0 available as a fixed scratch register.
+      Operand dst = g.ToOperand(destination);
+      __ movdqu(xmm0, src);
+      __ movdqu(dst, xmm0);
+    }
   } else if (source->IsDoubleStackSlot()) {
     DCHECK(destination->IsDoubleRegister() || destination->IsDoubleStackSlot());
     Operand src = g.ToOperand(source);
@@ -2233,6 +2323,23 @@ void CodeGenerator::AssembleSwap(InstructionOperand* source,
     frame_access_state()->IncreaseSPDelta(-1);
     dst = g.ToOperand(destination);
     __ popq(dst);
+  } else if (source->IsSimd128StackSlot() &&
+             destination->IsSimd128StackSlot()) {
+    // Memory-memory of 128-bit values, swapped in two 64-bit halves.
+    Register tmp = kScratchRegister;
+    for (int half = 0; half < 2; half++) {
+      int extra = half * kPointerSize;
+      Operand src = g.ToOperand(source, extra);
+      Operand dst = g.ToOperand(destination, extra);
+      __ movq(tmp, dst);
+      __ pushq(src);
+      frame_access_state()->IncreaseSPDelta(1);
+      src = g.ToOperand(source, extra);
+      __ movq(src, tmp);
+      frame_access_state()->IncreaseSPDelta(-1);
+      dst = g.ToOperand(destination, extra);
+      __ popq(dst);
+    }
   } else if ((source->IsStackSlot() && destination->IsStackSlot()) ||
              (source->IsDoubleStackSlot() &&
               destination->IsDoubleStackSlot())) {
@@ -2256,6 +2363,15 @@ void CodeGenerator::AssembleSwap(InstructionOperand* source,
     __ Movapd(xmm0, src);
     __ Movapd(src, dst);
     __ Movapd(dst, xmm0);
+  } else if (source->IsSimd128Register() &&
+             destination->IsSimd128StackSlot()) {
+    // XMM register-memory swap of a 128-bit value.  We rely on having xmm0
+    // available as a fixed scratch register.
+    XMMRegister src = g.ToDoubleRegister(source);
+    Operand dst = g.ToOperand(destination);
+    __ movaps(xmm0, src);
+    __ movdqu(src, dst);
+    __ movdqu(dst, xmm0);
   } else if (source->IsDoubleRegister() && destination->IsDoubleStackSlot()) {
     // XMM register-memory swap.  We rely on having xmm0
     // available as a fixed scratch register.
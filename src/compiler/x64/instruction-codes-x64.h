@@ -76,6 +76,9 @@ namespace compiler {
   V(SSEFloat64Mul)                 \
   V(SSEFloat64Div)                 \
   V(SSEFloat64Mod)                 \
+  V(X64Float64Sin)                 \
+  V(X64Float64Cos)                 \
+  V(X64Float64Tan)                 \
   V(SSEFloat64Abs)                 \
   V(SSEFloat64Neg)                 \
   V(SSEFloat64Sqrt)                \
@@ -129,6 +132,7 @@ namespace compiler {
   V(X64Movl)                       \
   V(X64Movsxlq)                    \
   V(X64Movq)                       \
+  V(X64Movdqu)                     \
   V(X64Movsd)                      \
   V(X64Movss)                      \
   V(X64BitcastFI)                  \
@@ -141,7 +145,16 @@ namespace compiler {
   V(X64Inc32)                      \
   V(X64Push)                       \
   V(X64Poke)                       \
-  V(X64StackCheck)
+  V(X64StackCheck)                 \
+  V(X64Float32x4Splat)             \
+  V(X64Float32x4ExtractLane)       \
+  V(X64Float32x4Add)               \
+  V(X64Float32x4Sub)               \
+  V(X64Float32x4Mul)               \
+  V(X64Int32x4Splat)               \
+  V(X64Int32x4ExtractLane)         \
+  V(X64Int32x4Add)                 \
+  V(X64Int32x4Sub)
 
 // Addressing modes represent the "shape" of inputs to an instruction.
 // Many instructions support multiple addressing modes. Addressing modes
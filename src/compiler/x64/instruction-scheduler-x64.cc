@@ -76,6 +76,9 @@ int InstructionScheduler::GetTargetInstructionFlags(
     case kSSEFloat64Mul:
     case kSSEFloat64Div:
     case kSSEFloat64Mod:
+    case kX64Float64Sin:
+    case kX64Float64Cos:
+    case kX64Float64Tan:
     case kSSEFloat64Abs:
     case kSSEFloat64Neg:
     case kSSEFloat64Sqrt:
@@ -122,6 +125,15 @@ int InstructionScheduler::GetTargetInstructionFlags(
     case kAVXFloat64Neg:
     case kAVXFloat32Abs:
     case kAVXFloat32Neg:
+    case kX64Float32x4Splat:
+    case kX64Float32x4ExtractLane:
+    case kX64Float32x4Add:
+    case kX64Float32x4Sub:
+    case kX64Float32x4Mul:
+    case kX64Int32x4Splat:
+    case kX64Int32x4ExtractLane:
+    case kX64Int32x4Add:
+    case kX64Int32x4Sub:
     case kX64BitcastFI:
     case kX64BitcastDL:
     case kX64BitcastIF:
@@ -159,6 +171,7 @@ int InstructionScheduler::GetTargetInstructionFlags(
     case kX64Movq:
     case kX64Movsd:
     case kX64Movss:
+    case kX64Movdqu:
       return instr->HasOutput() ? kIsLoadOperation : kHasSideEffect;
 
     case kX64StackCheck:
@@ -181,8 +194,210 @@ int InstructionScheduler::GetTargetInstructionFlags(
 
 
 int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
-  // TODO(all): Add instruction cost modeling.
-  return 1;
+  // Basic latency modeling for x64 instructions. The numbers approximate the
+  // latencies of recent Intel cores; instructions with a memory operand add
+  // the latency of an L1 hit.
+  static const int kLoadLatency = 5;
+  switch (instr->arch_opcode()) {
+    case kX64Add:
+    case kX64Add32:
+    case kX64And:
+    case kX64And32:
+    case kX64Cmp:
+    case kX64Cmp32:
+    case kX64Cmp16:
+    case kX64Cmp8:
+    case kX64Test:
+    case kX64Test32:
+    case kX64Test16:
+    case kX64Test8:
+    case kX64Or:
+    case kX64Or32:
+    case kX64Xor:
+    case kX64Xor32:
+    case kX64Sub:
+    case kX64Sub32:
+    case kX64Not:
+    case kX64Not32:
+    case kX64Neg:
+    case kX64Neg32:
+    case kX64Shl:
+    case kX64Shl32:
+    case kX64Shr:
+    case kX64Shr32:
+    case kX64Sar:
+    case kX64Sar32:
+    case kX64Ror:
+    case kX64Ror32:
+    case kX64Dec32:
+    case kX64Inc32:
+      return (instr->addressing_mode() == kMode_None) ? 1 : kLoadLatency + 1;
+
+    case kX64Lea32:
+    case kX64Lea:
+      return 1;
+
+    case kX64Imul:
+    case kX64Imul32:
+    case kX64ImulHigh32:
+    case kX64UmulHigh32:
+    case kX64Lzcnt:
+    case kX64Lzcnt32:
+    case kX64Tzcnt:
+    case kX64Tzcnt32:
+    case kX64Popcnt:
+    case kX64Popcnt32:
+      return (instr->addressing_mode() == kMode_None) ? 3 : kLoadLatency + 3;
+
+    case kX64Idiv32:
+    case kX64Udiv32:
+      return 26;
+
+    case kX64Idiv:
+    case kX64Udiv:
+      return 40;
+
+    case kX64Movsxbl:
+    case kX64Movzxbl:
+    case kX64Movsxwl:
+    case kX64Movzxwl:
+    case kX64Movsxlq:
+      DCHECK(instr->InputCount() >= 1);
+      return instr->InputAt(0)->IsRegister() ? 1 : kLoadLatency;
+
+    case kX64Movl:
+      if (instr->HasOutput()) {
+        DCHECK(instr->InputCount() >= 1);
+        return instr->InputAt(0)->IsRegister() ? 1 : kLoadLatency;
+      }
+      return 1;
+
+    case kX64Movq:
+    case kX64Movsd:
+    case kX64Movss:
+    case kX64Movdqu:
+      return instr->HasOutput() ? kLoadLatency : 1;
+
+    case kX64StackCheck:
+      return kLoadLatency;
+
+    case kCheckedLoadInt8:
+    case kCheckedLoadUint8:
+    case kCheckedLoadInt16:
+    case kCheckedLoadUint16:
+    case kCheckedLoadWord32:
+    case kCheckedLoadWord64:
+    case kCheckedLoadFloat32:
+    case kCheckedLoadFloat64:
+      return kLoadLatency + 1;
+
+    case kSSEFloat32Abs:
+    case kSSEFloat32Neg:
+    case kSSEFloat64Abs:
+    case kSSEFloat64Neg:
+    case kAVXFloat32Abs:
+    case kAVXFloat32Neg:
+    case kAVXFloat64Abs:
+    case kAVXFloat64Neg:
+      return 1;
+
+    case kX64BitcastFI:
+    case kX64BitcastDL:
+    case kX64BitcastIF:
+    case kX64BitcastLD:
+    case kSSEFloat64ExtractLowWord32:
+    case kSSEFloat64ExtractHighWord32:
+    case kSSEFloat64InsertLowWord32:
+    case kSSEFloat64InsertHighWord32:
+    case kX64Float32x4Splat:
+    case kX64Float32x4ExtractLane:
+    case kX64Int32x4Splat:
+    case kX64Int32x4ExtractLane:
+      return 2;
+
+    case kSSEFloat32Cmp:
+    case kSSEFloat64Cmp:
+    case kAVXFloat32Cmp:
+    case kAVXFloat64Cmp:
+    case kSSEFloat32Add:
+    case kSSEFloat32Sub:
+    case kSSEFloat64Add:
+    case kSSEFloat64Sub:
+    case kAVXFloat32Add:
+    case kAVXFloat32Sub:
+    case kAVXFloat64Add:
+    case kAVXFloat64Sub:
+    case kSSEFloat32Max:
+    case kSSEFloat32Min:
+    case kSSEFloat64Max:
+    case kSSEFloat64Min:
+    case kAVXFloat32Max:
+    case kAVXFloat32Min:
+    case kAVXFloat64Max:
+    case kAVXFloat64Min:
+    case kX64Float32x4Add:
+    case kX64Float32x4Sub:
+      return 3;
+
+    case kSSEFloat32Mul:
+    case kSSEFloat64Mul:
+    case kAVXFloat32Mul:
+    case kAVXFloat64Mul:
+    case kX64Float32x4Mul:
+      return 5;
+
+    case kSSEFloat32Round:
+    case kSSEFloat64Round:
+    case kSSEFloat32ToFloat64:
+    case kSSEFloat64ToFloat32:
+    case kSSEFloat32ToInt32:
+    case kSSEFloat32ToUint32:
+    case kSSEFloat64ToInt32:
+    case kSSEFloat64ToUint32:
+    case kSSEFloat64ToInt64:
+    case kSSEFloat32ToInt64:
+    case kSSEFloat64ToUint64:
+    case kSSEFloat32ToUint64:
+    case kSSEInt32ToFloat64:
+    case kSSEInt32ToFloat32:
+    case kSSEInt64ToFloat32:
+    case kSSEInt64ToFloat64:
+    case kSSEUint64ToFloat32:
+    case kSSEUint64ToFloat64:
+    case kSSEUint32ToFloat64:
+    case kSSEUint32ToFloat32:
+      return 6;
+
+    case kSSEFloat64LoadLowWord32:
+      return kLoadLatency;
+
+    case kSSEFloat32Div:
+    case kAVXFloat32Div:
+      return 11;
+
+    case kSSEFloat32Sqrt:
+      return 12;
+
+    case kSSEFloat64Div:
+    case kAVXFloat64Div:
+      return 14;
+
+    case kSSEFloat64Sqrt:
+      return 18;
+
+    case kSSEFloat64Mod:
+      // Computed with a fprem loop on the x87 stack.
+      return 50;
+
+    case kX64Float64Sin:
+    case kX64Float64Cos:
+    case kX64Float64Tan:
+      // Calls into fdlibm.
+      return 50;
+
+    default:
+      return 1;
+  }
 }
 
 }  // namespace compiler
@@ -161,7 +161,9 @@ void InstructionSelector::VisitLoad(Node* node) {
     case MachineRepresentation::kWord64:
       opcode = kX64Movq;
       break;
-    case MachineRepresentation::kSimd128:  // Fall through.
+    case MachineRepresentation::kSimd128:
+      opcode = kX64Movdqu;
+      break;
     case MachineRepresentation::kNone:
       UNREACHABLE();
       return;
@@ -246,7 +248,9 @@ void InstructionSelector::VisitStore(Node* node) {
       case MachineRepresentation::kWord64:
         opcode = kX64Movq;
         break;
-      case MachineRepresentation::kSimd128:  // Fall through.
+      case MachineRepresentation::kSimd128:
+        opcode = kX64Movdqu;
+        break;
       case MachineRepresentation::kNone:
         UNREACHABLE();
         return;
@@ -1396,6 +1400,35 @@ void InstructionSelector::VisitFloat64RoundTiesEven(Node* node) {
 }
 
 
+namespace {
+
+// Calls an fdlibm function, which takes and returns its argument in xmm0.
+void VisitFloat64FdlibmUnop(InstructionSelector* selector, Node* node,
+                            ArchOpcode opcode) {
+  X64OperandGenerator g(selector);
+  selector->Emit(opcode, g.DefineAsFixed(node, xmm0),
+                 g.UseFixed(node->InputAt(0), xmm0))
+      ->MarkAsCall();
+}
+
+}  // namespace
+
+
+void InstructionSelector::VisitFloat64Sin(Node* node) {
+  VisitFloat64FdlibmUnop(this, node, kX64Float64Sin);
+}
+
+
+void InstructionSelector::VisitFloat64Cos(Node* node) {
+  VisitFloat64FdlibmUnop(this, node, kX64Float64Cos);
+}
+
+
+void InstructionSelector::VisitFloat64Tan(Node* node) {
+  VisitFloat64FdlibmUnop(this, node, kX64Float64Tan);
+}
+
+
 void InstructionSelector::EmitPrepareArguments(
     ZoneVector<PushParameter>* arguments, const CallDescriptor* descriptor,
     Node* node) {
@@ -2029,6 +2062,61 @@ void InstructionSelector::VisitAtomicLoad(Node* node) {
   VisitLoad(node);
 }
 
+namespace {
+
+void VisitSimd128Binop(InstructionSelector* selector, Node* node,
+                       ArchOpcode opcode) {
+  X64OperandGenerator g(selector);
+  selector->Emit(opcode, g.DefineSameAsFirst(node),
+                 g.UseRegister(node->InputAt(0)),
+                 g.UseRegister(node->InputAt(1)));
+}
+
+}  // namespace
+
+void InstructionSelector::VisitFloat32x4Splat(Node* node) {
+  X64OperandGenerator g(this);
+  Emit(kX64Float32x4Splat, g.DefineSameAsFirst(node),
+       g.UseRegister(node->InputAt(0)));
+}
+
+void InstructionSelector::VisitFloat32x4ExtractLane(Node* node) {
+  X64OperandGenerator g(this);
+  Emit(kX64Float32x4ExtractLane, g.DefineSameAsFirst(node),
+       g.UseRegister(node->InputAt(0)), g.UseImmediate(node->InputAt(1)));
+}
+
+void InstructionSelector::VisitFloat32x4Add(Node* node) {
+  VisitSimd128Binop(this, node, kX64Float32x4Add);
+}
+
+void InstructionSelector::VisitFloat32x4Sub(Node* node) {
+  VisitSimd128Binop(this, node, kX64Float32x4Sub);
+}
+
+void InstructionSelector::VisitFloat32x4Mul(Node* node) {
+  VisitSimd128Binop(this, node, kX64Float32x4Mul);
+}
+
+void InstructionSelector::VisitInt32x4Splat(Node* node) {
+  X64OperandGenerator g(this);
+  Emit(kX64Int32x4Splat, g.DefineAsRegister(node), g.Use(node->InputAt(0)));
+}
+
+void InstructionSelector::VisitInt32x4ExtractLane(Node* node) {
+  X64OperandGenerator g(this);
+  Emit(kX64Int32x4ExtractLane, g.DefineAsRegister(node),
+       g.UseRegister(node->InputAt(0)), g.UseImmediate(node->InputAt(1)));
+}
+
+void InstructionSelector::VisitInt32x4Add(Node* node) {
+  VisitSimd128Binop(this, node, kX64Int32x4Add);
+}
+
+void InstructionSelector::VisitInt32x4Sub(Node* node) {
+  VisitSimd128Binop(this, node, kX64Int32x4Sub);
+}
+
 // static
 MachineOperatorBuilder::Flags
 InstructionSelector::SupportedMachineOperatorFlags() {
@@ -2038,7 +2126,10 @@ InstructionSelector::SupportedMachineOperatorFlags() {
       MachineOperatorBuilder::kFloat64Max |
       MachineOperatorBuilder::kFloat64Min |
       MachineOperatorBuilder::kWord32ShiftIsSafe |
-      MachineOperatorBuilder::kWord32Ctz | MachineOperatorBuilder::kWord64Ctz;
+      MachineOperatorBuilder::kWord32Ctz | MachineOperatorBuilder::kWord64Ctz |
+      MachineOperatorBuilder::kFloat64Sin |
+      MachineOperatorBuilder::kFloat64Cos |
+      MachineOperatorBuilder::kFloat64Tan;
   if (CpuFeatures::IsSupported(POPCNT)) {
     flags |= MachineOperatorBuilder::kWord32Popcnt |
              MachineOperatorBuilder::kWord64Popcnt;
@@ -1054,6 +1054,15 @@ void InstructionSelector::VisitFloat64RoundTiesAway(Node* node) {
 }
 
 
+void InstructionSelector::VisitFloat64Sin(Node* node) { UNREACHABLE(); }
+
+
+void InstructionSelector::VisitFloat64Cos(Node* node) { UNREACHABLE(); }
+
+
+void InstructionSelector::VisitFloat64Tan(Node* node) { UNREACHABLE(); }
+
+
 void InstructionSelector::VisitFloat32RoundTiesEven(Node* node) {
   X87OperandGenerator g(this);
   Emit(kX87Float32Round | MiscField::encode(kRoundToNearest),
@@ -175,22 +175,15 @@ const char* DoubleToCString(double v, Vector<char> buffer) {
 
 
 const char* IntToCString(int n, Vector<char> buffer) {
-  bool negative = false;
-  if (n < 0) {
-    // We must not negate the most negative int.
-    if (n == kMinInt) return DoubleToCString(n, buffer);
-    negative = true;
-    n = -n;
-  }
-  // Build the string backwards from the least significant digit.
-  int i = buffer.length();
-  buffer[--i] = '\0';
-  do {
-    buffer[--i] = '0' + (n % 10);
-    n /= 10;
-  } while (n);
-  if (negative) buffer[--i] = '-';
-  return buffer.start() + i;
+  // Negate in unsigned arithmetic, which also works for the most negative
+  // int, and build the string backwards from the least significant digit.
+  uint32_t magnitude = n < 0 ? 0u - static_cast<uint32_t>(n)
+                             : static_cast<uint32_t>(n);
+  char* end = buffer.start() + buffer.length() - 1;
+  *end = '\0';
+  char* start = UnsignedToAsciiBackwards(magnitude, end);
+  if (n < 0) *--start = '-';
+  return start;
 }
 
 
@@ -293,35 +293,37 @@ void RuntimeCallStats::Leave(RuntimeCallTimer* timer) {
   current_timer_ = timer->Stop();
 }
 
+// static
+RuntimeCallCounter RuntimeCallStats::*const RuntimeCallStats::counters[] = {
+#define CALL_RUNTIME_COUNTER(name, nargs, ressize) \
+  &RuntimeCallStats::Runtime_##name,
+    FOR_EACH_INTRINSIC(CALL_RUNTIME_COUNTER)
+#undef CALL_RUNTIME_COUNTER
+#define CALL_BUILTIN_COUNTER(name, type) &RuntimeCallStats::Builtin_##name,
+    BUILTIN_LIST_C(CALL_BUILTIN_COUNTER)
+#undef CALL_BUILTIN_COUNTER
+#define CALL_COMPILE_PHASE_COUNTER(name) &RuntimeCallStats::name,
+    FOR_EACH_COMPILE_PHASE_COUNTER(CALL_COMPILE_PHASE_COUNTER)
+#undef CALL_COMPILE_PHASE_COUNTER
+    &RuntimeCallStats::ExternalCallback,
+    &RuntimeCallStats::GC,
+    &RuntimeCallStats::DeoptimizeCode,
+    &RuntimeCallStats::DeoptimizeMaterialization,
+    &RuntimeCallStats::UnexpectedStubMiss};
+
+// static
+const int RuntimeCallStats::kNumberOfCounters =
+    static_cast<int>(arraysize(RuntimeCallStats::counters));
+
 void RuntimeCallStats::Print(std::ostream& os) {
   RuntimeCallStatEntries entries;
-
-#define PRINT_COUNTER(name, nargs, ressize) entries.Add(&this->Runtime_##name);
-  FOR_EACH_INTRINSIC(PRINT_COUNTER)
-#undef PRINT_COUNTER
-
-#define PRINT_COUNTER(name, type) entries.Add(&this->Builtin_##name);
-  BUILTIN_LIST_C(PRINT_COUNTER)
-#undef PRINT_COUNTER
-
-  entries.Add(&this->ExternalCallback);
-  entries.Add(&this->GC);
-  entries.Add(&this->UnexpectedStubMiss);
-
+  for (int i = 0; i < kNumberOfCounters; i++) entries.Add(GetCounter(i));
   entries.Print(os);
 }
 
 void RuntimeCallStats::Reset() {
   if (!FLAG_runtime_call_stats) return;
-#define RESET_COUNTER(name, nargs, ressize) this->Runtime_##name.Reset();
-  FOR_EACH_INTRINSIC(RESET_COUNTER)
-#undef RESET_COUNTER
-#define RESET_COUNTER(name, type) this->Builtin_##name.Reset();
-  BUILTIN_LIST_C(RESET_COUNTER)
-#undef RESET_COUNTER
-  this->ExternalCallback.Reset();
-  this->GC.Reset();
-  this->UnexpectedStubMiss.Reset();
+  for (int i = 0; i < kNumberOfCounters; i++) GetCounter(i)->Reset();
 }
 
 void RuntimeCallTimerScope::Enter(Isolate* isolate,
@@ -522,6 +522,19 @@ class RuntimeCallTimer {
   base::ElapsedTimer timer_;
 };
 
+// Counters for the phases of getting from source to code. Parsing on a
+// background thread is not counted, see BackgroundParsingTask::Run.
+#define FOR_EACH_COMPILE_PHASE_COUNTER(V) \
+  V(AsmValidation)                        \
+  V(AsmWasmTranslation)                   \
+  V(CompileAnalyse)                       \
+  V(CompileFullCode)                      \
+  V(CompileIgnition)                      \
+  V(InternalizeAstValues)                 \
+  V(ParseLazy)                            \
+  V(ParseProgram)                         \
+  V(PreParse)
+
 struct RuntimeCallStats {
   // Dummy counter for the unexpected stub miss.
   RuntimeCallCounter UnexpectedStubMiss =
@@ -529,6 +542,15 @@ struct RuntimeCallStats {
   // Counter for runtime callbacks into JavaScript.
   RuntimeCallCounter ExternalCallback = RuntimeCallCounter("ExternalCallback");
   RuntimeCallCounter GC = RuntimeCallCounter("GC");
+  // Counters for computing the output frames of a deoptimization and for
+  // materializing the heap objects they refer to.
+  RuntimeCallCounter DeoptimizeCode = RuntimeCallCounter("DeoptimizeCode");
+  RuntimeCallCounter DeoptimizeMaterialization =
+      RuntimeCallCounter("DeoptimizeMaterialization");
+#define CALL_COMPILE_PHASE_COUNTER(name) \
+  RuntimeCallCounter name = RuntimeCallCounter(#name);
+  FOR_EACH_COMPILE_PHASE_COUNTER(CALL_COMPILE_PHASE_COUNTER)
+#undef CALL_COMPILE_PHASE_COUNTER
 #define CALL_RUNTIME_COUNTER(name, nargs, ressize) \
   RuntimeCallCounter Runtime_##name = RuntimeCallCounter(#name);
   FOR_EACH_INTRINSIC(CALL_RUNTIME_COUNTER)
@@ -553,10 +575,20 @@ struct RuntimeCallStats {
 
   RuntimeCallTimer* current_timer() { return current_timer_; }
 
+  // The counters in the order in which they are printed.
+  static const int kNumberOfCounters;
+  RuntimeCallCounter* GetCounter(int index) {
+    DCHECK(0 <= index && index < kNumberOfCounters);
+    return &(this->*counters[index]);
+  }
+
   void Reset();
   void Print(std::ostream& os);
 
   RuntimeCallStats() { Reset(); }
+
+ private:
+  static RuntimeCallCounter RuntimeCallStats::*const counters[];
 };
 
 // A RuntimeCallTimerScopes wraps around a RuntimeCallTimer to measure the
@@ -749,6 +781,8 @@ class RuntimeCallTimerScope {
   SC(ic_keyed_load_miss, V8.ICKeyedLoadMiss)                                   \
   SC(ic_store_miss, V8.ICStoreMiss)                                            \
   SC(ic_keyed_store_miss, V8.ICKeyedStoreMiss)                                 \
+  SC(ic_compiled_handlers, V8.ICCompiledHandlers)                              \
+  SC(ic_compiled_handlers_size, V8.ICCompiledHandlersSize)                     \
   SC(cow_arrays_created_runtime, V8.COWArraysCreatedRuntime)                   \
   SC(cow_arrays_converted, V8.COWArraysConverted)                              \
   SC(constructed_objects, V8.ConstructedObjects)                               \
@@ -758,6 +792,12 @@ class RuntimeCallTimerScope {
   SC(megamorphic_stub_cache_probes, V8.MegamorphicStubCacheProbes)             \
   SC(megamorphic_stub_cache_misses, V8.MegamorphicStubCacheMisses)             \
   SC(megamorphic_stub_cache_updates, V8.MegamorphicStubCacheUpdates)           \
+  SC(megamorphic_stub_cache_primary_collisions,                                \
+     V8.MegamorphicStubCachePrimaryCollisions)                                 \
+  SC(megamorphic_stub_cache_secondary_evictions,                               \
+     V8.MegamorphicStubCacheSecondaryEvictions)                                \
+  SC(map_deprecations, V8.MapDeprecations)                                     \
+  SC(instance_migrations, V8.InstanceMigrations)                               \
   SC(enum_cache_hits, V8.EnumCacheHits)                                        \
   SC(enum_cache_misses, V8.EnumCacheMisses)                                    \
   SC(fast_new_closure_total, V8.FastNewClosureTotal)                           \
@@ -784,6 +824,7 @@ class RuntimeCallTimerScope {
   SC(soft_deopts_requested, V8.SoftDeoptsRequested)                            \
   SC(soft_deopts_inserted, V8.SoftDeoptsInserted)                              \
   SC(soft_deopts_executed, V8.SoftDeoptsExecuted)                              \
+  SC(deopt_loops, V8.DeoptLoops)                                               \
   /* Number of write barriers in generated code. */                            \
   SC(write_barriers_dynamic, V8.WriteBarriersDynamic)                          \
   SC(write_barriers_static, V8.WriteBarriersStatic)                            \
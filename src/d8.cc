@@ -75,6 +75,99 @@ const int kMaxWorkers = 50;
 #endif
 
 
+#ifndef V8_SHARED
+// Keeps freed backing stores of small power of two size classes for reuse,
+// since scripts often allocate and drop many small buffers. Reservations are
+// backed by virtual memory.
+class ShellArrayBufferAllocator : public v8::ArrayBuffer::Allocator {
+ public:
+  ShellArrayBufferAllocator() {}
+
+  ~ShellArrayBufferAllocator() override {
+    for (int i = 0; i < kSizeClasses; i++) {
+      for (void* block : pool_[i]) free(block);
+    }
+  }
+
+  void* Allocate(size_t length) override {
+    void* data = AllocateUninitialized(length);
+    return data == NULL ? data : memset(data, 0, length);
+  }
+
+  void* AllocateUninitialized(size_t length) override {
+    int size_class = SizeClassFor(length);
+    if (size_class < 0) return malloc(length);
+    {
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      std::vector<void*>& pool = pool_[size_class];
+      if (!pool.empty()) {
+        void* block = pool.back();
+        pool.pop_back();
+        return block;
+      }
+    }
+    return malloc(SizeOfClass(size_class));
+  }
+
+  void Free(void* data, size_t length) override {
+    int size_class = SizeClassFor(length);
+    if (data != NULL && size_class >= 0) {
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      std::vector<void*>& pool = pool_[size_class];
+      if (pool.size() < kMaxPooledBlocks) {
+        pool.push_back(data);
+        return;
+      }
+    }
+    free(data);
+  }
+
+  void* Reserve(size_t length) override {
+    return base::VirtualMemory::ReserveRegion(length);
+  }
+
+  void Free(void* data, size_t length, AllocationMode mode) override {
+    if (mode == AllocationMode::kNormal) {
+      Free(data, length);
+    } else {
+      CHECK(base::VirtualMemory::ReleaseRegion(data, length));
+    }
+  }
+
+  void SetProtection(void* data, size_t length,
+                     Protection protection) override {
+    if (protection == Protection::kReadWrite) {
+      CHECK(base::VirtualMemory::CommitRegion(data, length, false));
+    } else {
+      CHECK(base::VirtualMemory::UncommitRegion(data, length));
+    }
+  }
+
+  bool IsThreadSafe() const override { return true; }
+
+ private:
+  static const int kMinSizeClassLog2 = 4;
+  static const int kSizeClasses = 9;  // 16 bytes to 4 KB.
+  static const size_t kMaxPooledBlocks = 64;
+
+  static size_t SizeOfClass(int size_class) {
+    return static_cast<size_t>(1) << (kMinSizeClassLog2 + size_class);
+  }
+
+  // Returns -1 for sizes that are not pooled.
+  static int SizeClassFor(size_t length) {
+    for (int i = 0; i < kSizeClasses; i++) {
+      if (length <= SizeOfClass(i)) return i;
+    }
+    return -1;
+  }
+
+  base::Mutex mutex_;
+  std::vector<void*> pool_[kSizeClasses];
+
+  DISALLOW_COPY_AND_ASSIGN(ShellArrayBufferAllocator);
+};
+#else
 class ShellArrayBufferAllocator : public v8::ArrayBuffer::Allocator {
  public:
   virtual void* Allocate(size_t length) {
@@ -83,7 +176,9 @@ class ShellArrayBufferAllocator : public v8::ArrayBuffer::Allocator {
   }
   virtual void* AllocateUninitialized(size_t length) { return malloc(length); }
   virtual void Free(void* data, size_t) { free(data); }
+  virtual bool IsThreadSafe() const { return true; }
 };
+#endif  // !V8_SHARED
 
 
 class MockArrayBufferAllocator : public v8::ArrayBuffer::Allocator {
@@ -97,6 +192,7 @@ class MockArrayBufferAllocator : public v8::ArrayBuffer::Allocator {
     return length > 10 * MB ? malloc(1) : malloc(length);
   }
   void Free(void* p, size_t) override { free(p); }
+  bool IsThreadSafe() const override { return true; }
 };
 
 
@@ -1601,6 +1697,260 @@ void SourceGroup::JoinThread() {
 }
 
 
+namespace {
+
+// PerIsolateData uses data slot 0.
+const uint32_t kBenchmarkDataSlot = 1;
+
+// Runs the first source group in a fresh isolate and then calls the global
+// function benchmark() until the deadline has passed.
+class BenchmarkThread : public base::Thread {
+ public:
+  BenchmarkThread(SourceGroup* group, double deadline_ms)
+      : base::Thread(base::Thread::Options("BenchmarkThread", 2 * MB)),
+        group_(group),
+        deadline_ms_(deadline_ms),
+        ops_(0),
+        gc_count_(0),
+        gc_start_ms_(0),
+        gc_time_ms_(0),
+        failed_(false) {}
+
+  void Run() override {
+    Isolate::CreateParams create_params;
+    create_params.array_buffer_allocator = Shell::array_buffer_allocator;
+    Isolate* isolate = Isolate::New(create_params);
+    isolate->SetData(kBenchmarkDataSlot, this);
+    isolate->AddGCPrologueCallback(GCPrologue);
+    isolate->AddGCEpilogueCallback(GCEpilogue);
+    {
+      Isolate::Scope iscope(isolate);
+      HandleScope scope(isolate);
+      PerIsolateData data(isolate);
+      Local<Context> context = Shell::CreateEvaluationContext(isolate);
+      Context::Scope cscope(context);
+      PerIsolateData::RealmScope realm_scope(PerIsolateData::Get(isolate));
+      group_->Execute(isolate);
+      Local<Value> function;
+      Local<String> name =
+          String::NewFromUtf8(isolate, "benchmark", NewStringType::kNormal)
+              .ToLocalChecked();
+      if (!context->Global()->Get(context, name).ToLocal(&function) ||
+          !function->IsFunction()) {
+        printf("The benchmark does not define a function benchmark()\n");
+        failed_ = true;
+      } else {
+        while (!failed_ &&
+               base::OS::TimeCurrentMillis() < deadline_ms_) {
+          HandleScope inner_scope(isolate);
+          TryCatch try_catch(isolate);
+          if (Local<Function>::Cast(function)
+                  ->Call(context, context->Global(), 0, NULL)
+                  .IsEmpty()) {
+            Shell::ReportException(isolate, &try_catch);
+            failed_ = true;
+          }
+          ops_++;
+        }
+      }
+    }
+    isolate->Dispose();
+  }
+
+  int64_t ops() const { return ops_; }
+  int gc_count() const { return gc_count_; }
+  double gc_time_ms() const { return gc_time_ms_; }
+  bool failed() const { return failed_; }
+
+ private:
+  static BenchmarkThread* Get(Isolate* isolate) {
+    return reinterpret_cast<BenchmarkThread*>(
+        isolate->GetData(kBenchmarkDataSlot));
+  }
+
+  static void GCPrologue(Isolate* isolate, GCType type,
+                         GCCallbackFlags flags) {
+    Get(isolate)->gc_start_ms_ = base::OS::TimeCurrentMillis();
+  }
+
+  static void GCEpilogue(Isolate* isolate, GCType type,
+                         GCCallbackFlags flags) {
+    BenchmarkThread* thread = Get(isolate);
+    thread->gc_count_++;
+    thread->gc_time_ms_ +=
+        base::OS::TimeCurrentMillis() - thread->gc_start_ms_;
+  }
+
+  SourceGroup* group_;
+  double deadline_ms_;
+  int64_t ops_;
+  int gc_count_;
+  double gc_start_ms_;
+  double gc_time_ms_;
+  bool failed_;
+};
+
+
+double UserTimeInMillis() {
+  uint32_t secs, usecs;
+  if (base::OS::GetUserTime(&secs, &usecs) != 0) return 0;
+  return secs * 1000.0 + usecs / 1000.0;
+}
+
+}  // namespace
+
+
+int Shell::RunIsolateBenchmark() {
+  int count = options.benchmark_isolates;
+  double start_ms = base::OS::TimeCurrentMillis();
+  double user_start_ms = UserTimeInMillis();
+  std::vector<BenchmarkThread*> threads;
+  for (int i = 0; i < count; i++) {
+    threads.push_back(new BenchmarkThread(
+        &options.isolate_sources[0],
+        start_ms + options.benchmark_duration * 1000));
+    threads.back()->Start();
+  }
+  int64_t total_ops = 0;
+  int result = 0;
+  for (int i = 0; i < count; i++) {
+    threads[i]->Join();
+    if (threads[i]->failed()) result = 1;
+    total_ops += threads[i]->ops();
+  }
+  double wall_ms = base::OS::TimeCurrentMillis() - start_ms;
+  double user_ms = UserTimeInMillis() - user_start_ms;
+  for (int i = 0; i < count; i++) {
+    BenchmarkThread* thread = threads[i];
+    printf("Isolate %d: %.0f ops/sec, %d GCs, %.1f ms in GC (%.1f%%)\n", i,
+           thread->ops() * 1000 / wall_ms, thread->gc_count(),
+           thread->gc_time_ms(), thread->gc_time_ms() * 100 / wall_ms);
+    delete thread;
+  }
+  printf("Total: %.0f ops/sec on %d isolates\n", total_ops * 1000 / wall_ms,
+         count);
+  // Threads that wait on locks, futexes or the platform's task queues lower
+  // the share of the wall time that the process spends running.
+  printf("CPU utilization: %.1f%% of %d threads\n",
+         user_ms * 100 / (wall_ms * count), count);
+  return result;
+}
+
+
+namespace {
+
+// Startup phases that happen once per process, timed in Shell::Main.
+double v8_initialize_ms = 0;
+double startup_data_ms = 0;
+double first_isolate_ms = 0;
+
+double MillisSince(base::TimeTicks start) {
+  return (base::TimeTicks::HighResolutionNow() - start).InMillisecondsF();
+}
+
+void PrintPercentiles(const char* phase, std::vector<double>* samples) {
+  std::sort(samples->begin(), samples->end());
+  size_t last = samples->size() - 1;
+  printf("%s-p50(ms): %.3f\n", phase, (*samples)[last / 2]);
+  printf("%s-p90(ms): %.3f\n", phase, (*samples)[last * 9 / 10]);
+  printf("%s-max(ms): %.3f\n", phase, (*samples)[last]);
+}
+
+}  // namespace
+
+
+int Shell::RunStartupBenchmark(const Isolate::CreateParams& create_params) {
+  int size;
+  char* chars = ReadChars(NULL, options.startup_benchmark, &size);
+  if (chars == NULL) {
+    printf("Error reading '%s'\n", options.startup_benchmark);
+    return 1;
+  }
+  std::vector<double> isolate_new, context_new, compile, compile_with_cache,
+      first_result;
+  ScriptCompiler::CachedData* cache = NULL;
+  // The first run produces the code cache that the others consume, and is
+  // not recorded.
+  for (int run = 0; run <= options.startup_benchmark_runs; run++) {
+    for (int consume = 0; consume <= 1; consume++) {
+      if (consume && cache == NULL) continue;
+      base::TimeTicks start = base::TimeTicks::HighResolutionNow();
+      Isolate* isolate = Isolate::New(create_params);
+      double isolate_ms = MillisSince(start);
+      {
+        Isolate::Scope iscope(isolate);
+        HandleScope scope(isolate);
+        base::TimeTicks context_start = base::TimeTicks::HighResolutionNow();
+        Local<Context> context = Context::New(isolate);
+        double context_ms = MillisSince(context_start);
+        Context::Scope cscope(context);
+        Local<String> source_string =
+            String::NewFromUtf8(isolate, chars, NewStringType::kNormal, size)
+                .ToLocalChecked();
+        ScriptCompiler::CompileOptions compile_options =
+            ScriptCompiler::kNoCompileOptions;
+        ScriptCompiler::CachedData* cached_data = NULL;
+        if (consume) {
+          // The source takes ownership of the cached data, so hand it a
+          // view that does not free the buffer.
+          cached_data =
+              new ScriptCompiler::CachedData(cache->data, cache->length);
+          compile_options = ScriptCompiler::kConsumeCodeCache;
+        } else if (cache == NULL) {
+          compile_options = ScriptCompiler::kProduceCodeCache;
+        }
+        ScriptCompiler::Source source(source_string, cached_data);
+        base::TimeTicks compile_start = base::TimeTicks::HighResolutionNow();
+        Local<Script> script;
+        if (!ScriptCompiler::Compile(context, &source, compile_options)
+                 .ToLocal(&script)) {
+          printf("Error compiling '%s'\n", options.startup_benchmark);
+          Shell::Exit(1);
+        }
+        double compile_ms = MillisSince(compile_start);
+        if (compile_options == ScriptCompiler::kProduceCodeCache &&
+            source.GetCachedData() != NULL) {
+          const ScriptCompiler::CachedData* data = source.GetCachedData();
+          uint8_t* copy = new uint8_t[data->length];
+          memcpy(copy, data->data, data->length);
+          cache = new ScriptCompiler::CachedData(
+              copy, data->length, ScriptCompiler::CachedData::BufferOwned);
+        }
+        if (script->Run(context).IsEmpty()) {
+          printf("Error running '%s'\n", options.startup_benchmark);
+          Shell::Exit(1);
+        }
+        if (run > 0) {
+          if (consume) {
+            compile_with_cache.push_back(compile_ms);
+          } else {
+            isolate_new.push_back(isolate_ms);
+            context_new.push_back(context_ms);
+            compile.push_back(compile_ms);
+            first_result.push_back(MillisSince(start));
+          }
+        }
+      }
+      isolate->Dispose();
+    }
+  }
+  delete[] chars;
+  delete cache;
+  printf("V8Initialize(ms): %.3f\n", v8_initialize_ms);
+  printf("StartupData(ms): %.3f\n", startup_data_ms);
+  printf("FirstIsolateNew(ms): %.3f\n", first_isolate_ms);
+  if (isolate_new.empty()) return 0;
+  PrintPercentiles("IsolateNew", &isolate_new);
+  PrintPercentiles("ContextNew", &context_new);
+  PrintPercentiles("Compile", &compile);
+  if (!compile_with_cache.empty()) {
+    PrintPercentiles("CompileWithCodeCache", &compile_with_cache);
+  }
+  PrintPercentiles("FirstResult", &first_result);
+  return 0;
+}
+
+
 SerializationData::~SerializationData() {
   // Any ArrayBuffer::Contents are owned by this SerializationData object if
   // ownership hasn't been transferred out via ReadArrayBufferContents.
@@ -1679,32 +2029,22 @@ void SerializationData::ReadSharedArrayBufferContents(
 
 
 void SerializationDataQueue::Enqueue(SerializationData* data) {
-  base::LockGuard<base::Mutex> lock_guard(&mutex_);
-  data_.Add(data);
+  data_.Enqueue(data);
 }
 
 
 bool SerializationDataQueue::Dequeue(SerializationData** data) {
-  base::LockGuard<base::Mutex> lock_guard(&mutex_);
   *data = NULL;
-  if (data_.is_empty()) return false;
-  *data = data_.Remove(0);
-  return true;
+  return data_.Dequeue(data);
 }
 
 
-bool SerializationDataQueue::IsEmpty() {
-  base::LockGuard<base::Mutex> lock_guard(&mutex_);
-  return data_.is_empty();
-}
+bool SerializationDataQueue::IsEmpty() { return data_.IsEmpty(); }
 
 
 void SerializationDataQueue::Clear() {
-  base::LockGuard<base::Mutex> lock_guard(&mutex_);
-  for (int i = 0; i < data_.length(); ++i) {
-    delete data_[i];
-  }
-  data_.Clear();
+  SerializationData* data;
+  while (data_.Dequeue(&data)) delete data;
 }
 
 
@@ -1910,6 +2250,9 @@ bool Shell::SetOptions(int argc, char* argv[]) {
     } else if (strcmp(argv[i], "--send-idle-notification") == 0) {
       options.send_idle_notification = true;
       argv[i] = NULL;
+    } else if (strcmp(argv[i], "--enable-idle-tasks") == 0) {
+      options.enable_idle_tasks = true;
+      argv[i] = NULL;
     } else if (strcmp(argv[i], "--invoke-weak-callbacks") == 0) {
       options.invoke_weak_callbacks = true;
       // TODO(jochen) See issue 3351
@@ -1928,6 +2271,29 @@ bool Shell::SetOptions(int argc, char* argv[]) {
       return false;
 #endif  // V8_SHARED
       options.num_isolates++;
+    } else if (strncmp(argv[i], "--benchmark-isolates=", 21) == 0) {
+#ifdef V8_SHARED
+      printf("D8 with shared library does not support multi-threading\n");
+      return false;
+#else
+      options.benchmark_isolates = atoi(argv[i] + 21);
+      argv[i] = NULL;
+#endif  // V8_SHARED
+    } else if (strncmp(argv[i], "--startup-benchmark=", 20) == 0) {
+#ifdef V8_SHARED
+      printf("D8 with shared library does not support benchmarking startup\n");
+      return false;
+#else
+      options.startup_benchmark = argv[i] + 20;
+      options.script_executed = true;
+      argv[i] = NULL;
+#endif  // V8_SHARED
+    } else if (strncmp(argv[i], "--startup-benchmark-runs=", 25) == 0) {
+      options.startup_benchmark_runs = atoi(argv[i] + 25);
+      argv[i] = NULL;
+    } else if (strncmp(argv[i], "--benchmark-duration=", 21) == 0) {
+      options.benchmark_duration = atof(argv[i] + 21);
+      argv[i] = NULL;
     } else if (strcmp(argv[i], "--dump-heap-constants") == 0) {
 #ifdef V8_SHARED
       printf("D8 with shared library does not support constant dumping\n");
@@ -1942,6 +2308,12 @@ bool Shell::SetOptions(int argc, char* argv[]) {
     } else if (strncmp(argv[i], "--icu-data-file=", 16) == 0) {
       options.icu_data_file = argv[i] + 16;
       argv[i] = NULL;
+    } else if (strcmp(argv[i], "--enable-tracing") == 0) {
+      options.trace_enabled = true;
+      argv[i] = NULL;
+    } else if (strncmp(argv[i], "--trace-categories=", 19) == 0) {
+      options.trace_categories = argv[i] + 19;
+      argv[i] = NULL;
 #ifdef V8_SHARED
     } else if (strcmp(argv[i], "--dump-counters") == 0) {
       printf("D8 with shared library does not include counters\n");
@@ -2060,6 +2432,10 @@ void Shell::EmptyMessageQueues(Isolate* isolate) {
   if (!i::FLAG_verify_predictable) {
 #endif
     while (v8::platform::PumpMessageLoop(g_platform, isolate)) continue;
+    if (options.enable_idle_tasks) {
+      const double kIdleTimeInSeconds = 0.05;
+      v8::platform::RunIdleTasks(g_platform, isolate, kIdleTimeInSeconds);
+    }
 #ifndef V8_SHARED
   }
 #endif
@@ -2402,22 +2778,58 @@ int Shell::Main(int argc, char* argv[]) {
 #endif  // defined(_WIN32) || defined(_WIN64)
   if (!SetOptions(argc, argv)) return 1;
   v8::V8::InitializeICU(options.icu_data_file);
+  v8::platform::IdleTaskSupport idle_task_support =
+      options.enable_idle_tasks ? v8::platform::IdleTaskSupport::kEnabled
+                                : v8::platform::IdleTaskSupport::kDisabled;
 #ifndef V8_SHARED
   g_platform = i::FLAG_verify_predictable
                    ? new PredictablePlatform()
-                   : v8::platform::CreateDefaultPlatform();
+                   : v8::platform::CreateDefaultPlatform(0, idle_task_support);
+#else
+  g_platform = v8::platform::CreateDefaultPlatform(0, idle_task_support);
+#endif  // !V8_SHARED
+
+  std::ofstream trace_file;
+  platform::tracing::TracingController* tracing_controller = NULL;
+#ifndef V8_SHARED
+  if (options.trace_enabled && !i::FLAG_verify_predictable) {
 #else
-  g_platform = v8::platform::CreateDefaultPlatform();
+  if (options.trace_enabled) {
 #endif  // !V8_SHARED
+    trace_file.open("v8_trace.json");
+    tracing_controller = new platform::tracing::TracingController();
+    platform::tracing::TraceBuffer* trace_buffer =
+        platform::tracing::TraceBuffer::CreateTraceBufferRingBuffer(
+            platform::tracing::TraceBuffer::kRingBufferChunks,
+            platform::tracing::TraceWriter::CreateJSONTraceWriter(trace_file));
+    tracing_controller->Initialize(trace_buffer);
+    platform::tracing::TraceConfig* trace_config =
+        options.trace_categories != NULL
+            ? platform::tracing::TraceConfig::CreateTraceConfigFromCategoryList(
+                  options.trace_categories)
+            : platform::tracing::TraceConfig::CreateDefaultTraceConfig();
+    tracing_controller->StartTracing(trace_config);
+    platform::SetTracingController(g_platform, tracing_controller);
+  }
 
+#ifndef V8_SHARED
+  base::TimeTicks initialize_start = base::TimeTicks::HighResolutionNow();
+#endif  // !V8_SHARED
   v8::V8::InitializePlatform(g_platform);
   v8::V8::Initialize();
+#ifndef V8_SHARED
+  v8_initialize_ms = MillisSince(initialize_start);
+  base::TimeTicks startup_data_start = base::TimeTicks::HighResolutionNow();
+#endif  // !V8_SHARED
   if (options.natives_blob || options.snapshot_blob) {
     v8::V8::InitializeExternalStartupData(options.natives_blob,
                                           options.snapshot_blob);
   } else {
     v8::V8::InitializeExternalStartupData(argv[0]);
   }
+#ifndef V8_SHARED
+  startup_data_ms = MillisSince(startup_data_start);
+#endif  // !V8_SHARED
   SetFlagsFromString("--trace-hydrogen-file=hydrogen.cfg");
   SetFlagsFromString("--trace-turbo-cfg-file=turbo.cfg");
   SetFlagsFromString("--redirect-code-traces-to=code.asm");
@@ -2445,8 +2857,12 @@ int Shell::Main(int argc, char* argv[]) {
     create_params.create_histogram_callback = CreateHistogram;
     create_params.add_histogram_sample_callback = AddHistogramSample;
   }
+  base::TimeTicks isolate_start = base::TimeTicks::HighResolutionNow();
 #endif
   Isolate* isolate = Isolate::New(create_params);
+#ifndef V8_SHARED
+  first_isolate_ms = MillisSince(isolate_start);
+#endif  // !V8_SHARED
   {
     Isolate::Scope scope(isolate);
     Initialize(isolate);
@@ -2482,6 +2898,10 @@ int Shell::Main(int argc, char* argv[]) {
         bool last_run = i == options.stress_runs - 1;
         result = RunMain(isolate, argc, argv, last_run);
       }
+    } else if (options.benchmark_isolates > 0) {
+      result = RunIsolateBenchmark();
+    } else if (options.startup_benchmark != NULL) {
+      result = RunStartupBenchmark(create_params);
 #endif
     } else {
       bool last_run = true;
@@ -2516,6 +2936,8 @@ int Shell::Main(int argc, char* argv[]) {
     os << *profiler;
   }
 #endif  // !V8_SHARED
+  // Write the trace file while the platform is still alive.
+  if (tracing_controller != NULL) tracing_controller->StopTracing();
   isolate->Dispose();
   V8::Dispose();
   V8::ShutdownPlatform();
@@ -7,6 +7,7 @@
 
 #ifndef V8_SHARED
 #include "src/allocation.h"
+#include "src/base/lockfree-queue.h"
 #include "src/base/platform/time.h"
 #include "src/hashmap.h"
 #include "src/list.h"
@@ -212,8 +213,7 @@ class SerializationDataQueue {
   void Clear();
 
  private:
-  base::Mutex mutex_;
-  i::List<SerializationData*> data_;
+  base::LockFreeQueue<SerializationData*> data_;
 };
 
 
@@ -275,6 +275,7 @@ class ShellOptions {
   ShellOptions()
       : script_executed(false),
         send_idle_notification(false),
+        enable_idle_tasks(false),
         invoke_weak_callbacks(false),
         omit_quit(false),
         stress_opt(false),
@@ -286,11 +287,17 @@ class ShellOptions {
         expected_to_throw(false),
         mock_arraybuffer_allocator(false),
         num_isolates(1),
+        benchmark_isolates(0),
+        benchmark_duration(10),
+        startup_benchmark(NULL),
+        startup_benchmark_runs(20),
         compile_options(v8::ScriptCompiler::kNoCompileOptions),
         isolate_sources(NULL),
         icu_data_file(NULL),
         natives_blob(NULL),
-        snapshot_blob(NULL) {}
+        snapshot_blob(NULL),
+        trace_enabled(false),
+        trace_categories(NULL) {}
 
   ~ShellOptions() {
     delete[] isolate_sources;
@@ -302,6 +309,7 @@ class ShellOptions {
 
   bool script_executed;
   bool send_idle_notification;
+  bool enable_idle_tasks;
   bool invoke_weak_callbacks;
   bool omit_quit;
   bool stress_opt;
@@ -313,11 +321,20 @@ class ShellOptions {
   bool expected_to_throw;
   bool mock_arraybuffer_allocator;
   int num_isolates;
+  // Runs the first source group in this many isolates at once.
+  int benchmark_isolates;
+  // Seconds to spend calling benchmark() in each isolate.
+  double benchmark_duration;
+  // Script whose compilation and first run the startup benchmark times.
+  const char* startup_benchmark;
+  int startup_benchmark_runs;
   v8::ScriptCompiler::CompileOptions compile_options;
   SourceGroup* isolate_sources;
   const char* icu_data_file;
   const char* natives_blob;
   const char* snapshot_blob;
+  bool trace_enabled;
+  const char* trace_categories;
 };
 
 #ifdef V8_SHARED
@@ -360,6 +377,8 @@ class Shell : public i::AllStatic {
                                             const SerializationData& data,
                                             int* offset);
   static void CleanupWorkers();
+  static int RunIsolateBenchmark();
+  static int RunStartupBenchmark(const Isolate::CreateParams& create_params);
   static int* LookupCounter(const char* name);
   static void* CreateHistogram(const char* name,
                                int min,
@@ -4,6 +4,10 @@
 
 #include "src/date.h"
 
+#include <algorithm>
+
+#include "src/base/lazy-instance.h"
+#include "src/base/platform/mutex.h"
 #include "src/objects.h"
 #include "src/objects-inl.h"
 
@@ -22,6 +26,23 @@ static const char kDaysInMonths[] =
     {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
 
 
+// The timezone shared by the date caches of all isolates.
+struct DateCache::SharedTimezone {
+  SharedTimezone() : valid(false) {}
+
+  base::Mutex mutex;
+  bool valid;
+  Timezone timezone;
+};
+
+
+DateCache::SharedTimezone* DateCache::shared_timezone() {
+  static base::LazyInstance<SharedTimezone>::type shared_timezone =
+      LAZY_INSTANCE_INITIALIZER;
+  return shared_timezone.Pointer();
+}
+
+
 void DateCache::ResetDateCache() {
   static const int kMaxStamp = Smi::kMaxValue;
   if (stamp_->value() >= kMaxStamp) {
@@ -37,11 +58,94 @@ void DateCache::ResetDateCache() {
   before_ = &dst_[0];
   after_ = &dst_[1];
   local_offset_ms_ = kInvalidLocalOffsetInMs;
+  timezone_valid_ = false;
   ymd_valid_ = false;
   base::OS::ClearTimezoneCache(tz_cache_);
 }
 
 
+void DateCache::ResetTimezoneTransitions() {
+  SharedTimezone* shared = shared_timezone();
+  base::LockGuard<base::Mutex> lock_guard(&shared->mutex);
+  shared->valid = false;
+}
+
+
+void DateCache::ComputeTimezone(Timezone* timezone) {
+  base::TimezoneCache* cache = base::OS::CreateTimezoneCache();
+  timezone->local_offset_ms =
+      static_cast<int>(base::OS::LocalTimeOffset(cache));
+  timezone->transitions.clear();
+
+  Transition probe;
+  auto probe_at = [cache, &probe](int time_sec) {
+    double time_ms = static_cast<double>(time_sec) * 1000;
+    probe.start_sec = time_sec;
+    probe.offset_ms =
+        static_cast<int>(base::OS::DaylightSavingsOffset(time_ms, cache));
+    probe.name = base::OS::LocalTimezone(time_ms, cache);
+  };
+  auto same_as = [&probe](const Transition& transition) {
+    return probe.offset_ms == transition.offset_ms &&
+           probe.name == transition.name;
+  };
+
+  probe_at(0);
+  timezone->transitions.push_back(probe);
+  // Step through time like the DST cache does and bisect every interval at
+  // whose end the offset or the name differ from the last transition.
+  int time_sec = 0;
+  while (time_sec < kMaxEpochTimeInSec) {
+    int end_sec = kMaxEpochTimeInSec - time_sec <= kDefaultDSTDeltaInSec
+                      ? kMaxEpochTimeInSec
+                      : time_sec + kDefaultDSTDeltaInSec;
+    probe_at(end_sec);
+    if (same_as(timezone->transitions.back())) {
+      time_sec = end_sec;
+      continue;
+    }
+    while (end_sec - time_sec > 1) {
+      int middle_sec = time_sec + (end_sec - time_sec) / 2;
+      probe_at(middle_sec);
+      if (same_as(timezone->transitions.back())) {
+        time_sec = middle_sec;
+      } else {
+        end_sec = middle_sec;
+      }
+    }
+    probe_at(end_sec);
+    timezone->transitions.push_back(probe);
+    time_sec = end_sec;
+  }
+  base::OS::DisposeTimezoneCache(cache);
+}
+
+
+void DateCache::LoadTimezone() {
+  SharedTimezone* shared = shared_timezone();
+  base::LockGuard<base::Mutex> lock_guard(&shared->mutex);
+  if (!shared->valid) {
+    ComputeTimezone(&shared->timezone);
+    shared->valid = true;
+  }
+  timezone_ = shared->timezone;
+  timezone_valid_ = true;
+}
+
+
+const DateCache::Transition* DateCache::FindTransition(int time_sec) {
+  DCHECK_LE(0, time_sec);
+  const std::vector<Transition>& transitions = timezone()->transitions;
+  DCHECK_EQ(0, transitions.front().start_sec);
+  auto it = std::upper_bound(
+      transitions.begin(), transitions.end(), time_sec,
+      [](int value, const Transition& transition) {
+        return value < transition.start_sec;
+      });
+  return &*(it - 1);
+}
+
+
 void DateCache::ClearSegment(DST* segment) {
   segment->start_sec = kMaxEpochTimeInSec;
   segment->end_sec = -kMaxEpochTimeInSec;
@@ -214,6 +318,8 @@ int DateCache::DaylightSavingsOffsetInMs(int64_t time_ms) {
       ? static_cast<int>(time_ms / 1000)
       : static_cast<int>(EquivalentTime(time_ms) / 1000);
 
+  if (UsesOSTimezone()) return FindTransition(time_sec)->offset_ms;
+
   // Invalidate cache if the usage counter is close to overflow.
   // Note that dst_usage_counter is incremented less than ten times
   // in this function.
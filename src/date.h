@@ -5,6 +5,9 @@
 #ifndef V8_DATE_H_
 #define V8_DATE_H_
 
+#include <string>
+#include <vector>
+
 #include "src/allocation.h"
 #include "src/base/platform/platform.h"
 #include "src/globals.h"
@@ -52,6 +55,11 @@ class DateCache {
   // Clears cached timezone information and increments the cache stamp.
   void ResetDateCache();
 
+  // Drops the timezone transitions shared by the date caches of all
+  // isolates, so that they are recomputed from the OS the next time any
+  // date cache is reset and needs them.
+  static void ResetTimezoneTransitions();
+
 
   // Computes floor(time_ms / kMsPerDay).
   static int DaysFromTime(int64_t time_ms) {
@@ -83,7 +91,8 @@ class DateCache {
   // ECMA 262 - 15.9.1.7.
   int LocalOffsetInMs() {
     if (local_offset_ms_ == kInvalidLocalOffsetInMs)  {
-      local_offset_ms_ = GetLocalOffsetFromOS();
+      local_offset_ms_ = UsesOSTimezone() ? timezone()->local_offset_ms
+                                          : GetLocalOffsetFromOS();
     }
     return local_offset_ms_;
   }
@@ -93,6 +102,9 @@ class DateCache {
     if (time_ms < 0 || time_ms > kMaxEpochTimeInMs) {
       time_ms = EquivalentTime(time_ms);
     }
+    if (UsesOSTimezone()) {
+      return FindTransition(static_cast<int>(time_ms / 1000))->name.c_str();
+    }
     return base::OS::LocalTimezone(static_cast<double>(time_ms), tz_cache_);
   }
 
@@ -214,6 +226,11 @@ class DateCache {
     return static_cast<int>(offset);
   }
 
+  // Whether the offsets are those of the OS, so that they can be looked up
+  // in the shared timezone transitions instead of calling the two functions
+  // above. Tests that override them return false.
+  virtual bool UsesOSTimezone() { return true; }
+
  private:
   // The implementation relies on the fact that no time zones have
   // more than one daylight savings offset change per 19 days.
@@ -260,6 +277,41 @@ class DateCache {
     return segment->start_sec > segment->end_sec;
   }
 
+  // A point in time from which on the daylight savings offset and the name
+  // of the local timezone stay the same until the next transition.
+  struct Transition {
+    int start_sec;
+    int offset_ms;
+    std::string name;
+  };
+
+  // The local timezone between the epoch and kMaxEpochTimeInSec. It is
+  // computed from the OS once per process, since the OS date-time library
+  // is slow and serializes all threads on a lock, and every date cache
+  // keeps an immutable copy that it searches without calling the OS.
+  struct Timezone {
+    int local_offset_ms;
+    // Sorted by start_sec, the first transition starts at the epoch.
+    std::vector<Transition> transitions;
+  };
+
+  struct SharedTimezone;
+  static SharedTimezone* shared_timezone();
+
+  // Computes the local timezone by probing the OS date-time library.
+  static void ComputeTimezone(Timezone* timezone);
+
+  const Timezone* timezone() {
+    if (!timezone_valid_) LoadTimezone();
+    return &timezone_;
+  }
+
+  // Copies the shared timezone, computing it first if necessary.
+  void LoadTimezone();
+
+  // Returns the last transition at or before 0 <= time_sec.
+  const Transition* FindTransition(int time_sec);
+
   Smi* stamp_;
 
   // Daylight Saving Time cache.
@@ -270,6 +322,9 @@ class DateCache {
 
   int local_offset_ms_;
 
+  bool timezone_valid_;
+  Timezone timezone_;
+
   // Year/Month/Day cache.
   bool ymd_valid_;
   int ymd_days_;
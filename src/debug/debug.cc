@@ -1297,6 +1297,30 @@ class RedirectActiveFunctions : public ThreadVisitor {
 };
 
 
+// Tells whether any code cached in the optimized code map of |holder|
+// inlines |shared|.
+static bool OptimizedCodeMapInlines(SharedFunctionInfo* holder,
+                                    SharedFunctionInfo* shared) {
+  DisallowHeapAllocation no_gc;
+  FixedArray* code_map = holder->optimized_code_map();
+  WeakCell* shared_code =
+      WeakCell::cast(code_map->get(SharedFunctionInfo::kSharedCodeIndex));
+  if (!shared_code->cleared() &&
+      Code::cast(shared_code->value())->Inlines(shared)) {
+    return true;
+  }
+  for (int i = SharedFunctionInfo::kEntriesStart; i < code_map->length();
+       i += SharedFunctionInfo::kEntryLength) {
+    WeakCell* cell = WeakCell::cast(
+        code_map->get(i + SharedFunctionInfo::kCachedCodeOffset));
+    if (!cell->cleared() && Code::cast(cell->value())->Inlines(shared)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+
 bool Debug::PrepareFunctionForBreakPoints(Handle<SharedFunctionInfo> shared) {
   DCHECK(shared->is_compiled());
 
@@ -1307,14 +1331,16 @@ bool Debug::PrepareFunctionForBreakPoints(Handle<SharedFunctionInfo> shared) {
   List<Handle<JSFunction> > functions;
   List<Handle<JSGeneratorObject> > suspended_generators;
 
-  // Flush all optimized code maps. Note that the below heap iteration does not
-  // cover this, because the given function might have been inlined into code
-  // for which no JSFunction exists.
+  // Flush the optimized code maps that hold code for or inlining the given
+  // function. Note that the below heap iteration does not cover this, because
+  // the given function might have been inlined into code for which no
+  // JSFunction exists. Other optimized code stays cached.
   {
     SharedFunctionInfo::Iterator iterator(isolate_);
-    while (SharedFunctionInfo* shared = iterator.Next()) {
-      if (!shared->OptimizedCodeMapIsCleared()) {
-        shared->ClearOptimizedCodeMap();
+    while (SharedFunctionInfo* candidate = iterator.Next()) {
+      if (candidate->OptimizedCodeMapIsCleared()) continue;
+      if (candidate == *shared || OptimizedCodeMapInlines(candidate, *shared)) {
+        candidate->ClearOptimizedCodeMap();
       }
     }
   }
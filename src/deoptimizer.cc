@@ -436,6 +436,9 @@ void Deoptimizer::DeoptimizeFunction(JSFunction* function) {
 
 
 void Deoptimizer::ComputeOutputFrames(Deoptimizer* deoptimizer) {
+  Isolate* isolate = deoptimizer->isolate_;
+  RuntimeCallTimerScope runtime_timer(
+      isolate, &isolate->counters()->runtime_call_stats()->DeoptimizeCode);
   deoptimizer->DoComputeOutputFrames();
 }
 
@@ -1966,11 +1969,24 @@ void Deoptimizer::DoComputeCompiledStubFrame(TranslatedFrame* translated_frame,
 
 
 void Deoptimizer::MaterializeHeapObjects(JavaScriptFrameIterator* it) {
+  RuntimeCallTimerScope runtime_timer(
+      isolate_,
+      &isolate_->counters()->runtime_call_stats()->DeoptimizeMaterialization);
   // Walk to the last JavaScript output frame to find out if it has
   // adapted arguments.
   for (int frame_index = 0; frame_index < jsframe_count(); ++frame_index) {
     if (frame_index != 0) it->Advance();
   }
+
+  // The common case of output frames without captured objects or arguments
+  // objects does not need the translated values, so there is no point in
+  // handlifying them.
+  if (values_to_materialize_.empty()) {
+    isolate_->materialized_object_store()->Remove(
+        reinterpret_cast<Address>(stack_fp_));
+    return;
+  }
+
   translated_state_.Prepare(it->frame()->has_adapted_arguments(),
                             reinterpret_cast<Address>(stack_fp_));
 
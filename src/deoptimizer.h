@@ -451,6 +451,7 @@ class Deoptimizer : public Malloced {
   Handle<JSFunction> function() const { return Handle<JSFunction>(function_); }
   Handle<Code> compiled_code() const { return Handle<Code>(compiled_code_); }
   BailoutType bailout_type() const { return bailout_type_; }
+  Address from() const { return from_; }
 
   // Number of created JS frames. Not all created frames are necessarily JS.
   int jsframe_count() const { return jsframe_count_; }
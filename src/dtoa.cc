@@ -29,6 +29,61 @@ static BignumDtoaMode DtoaToBignumDtoaMode(DtoaMode dtoa_mode) {
 }
 
 
+// The decimal representations of 0 to 99, two characters each.
+static const char kTwoDigits[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+
+char* UnsignedToAsciiBackwards(uint64_t value, char* end) {
+  // Produce two digits per division, the divisions are the expensive part.
+  while (value >= 100) {
+    int index = static_cast<int>(value % 100) * 2;
+    value /= 100;
+    *--end = kTwoDigits[index + 1];
+    *--end = kTwoDigits[index];
+  }
+  if (value >= 10) {
+    int index = static_cast<int>(value) * 2;
+    *--end = kTwoDigits[index + 1];
+    *--end = kTwoDigits[index];
+  } else {
+    *--end = static_cast<char>('0' + value);
+  }
+  return end;
+}
+
+
+// Integers below 2^53 are exactly representable and neighbouring doubles
+// there are at most one apart, so their own digits are the shortest
+// representation that reads back to them and neither Grisu nor bignums are
+// needed.
+static bool SafeIntegerDtoa(double v, Vector<char> buffer, int* length,
+                            int* point) {
+  const double kTwoPow53 = 9007199254740992.0;
+  if (v >= kTwoPow53) return false;
+  uint64_t integer = static_cast<uint64_t>(v);
+  if (static_cast<double>(integer) != v) return false;
+  char digits[kBase10MaximalLength];
+  char* end = digits + kBase10MaximalLength;
+  char* start = UnsignedToAsciiBackwards(integer, end);
+  *point = static_cast<int>(end - start);
+  while (end[-1] == '0') end--;
+  *length = static_cast<int>(end - start);
+  MemCopy(buffer.start(), start, *length);
+  buffer[*length] = '\0';
+  return true;
+}
+
+
 void DoubleToAscii(double v, DtoaMode mode, int requested_digits,
                    Vector<char> buffer, int* sign, int* length, int* point) {
   DCHECK(!Double(v).IsSpecial());
@@ -58,7 +113,8 @@ void DoubleToAscii(double v, DtoaMode mode, int requested_digits,
   bool fast_worked;
   switch (mode) {
     case DTOA_SHORTEST:
-      fast_worked = FastDtoa(v, FAST_DTOA_SHORTEST, 0, buffer, length, point);
+      fast_worked = SafeIntegerDtoa(v, buffer, length, point) ||
+                    FastDtoa(v, FAST_DTOA_SHORTEST, 0, buffer, length, point);
       break;
     case DTOA_FIXED:
       fast_worked = FastFixedDtoa(v, requested_digits, buffer, length, point);
@@ -59,6 +59,10 @@ const int kBase10MaximalLength = 17;
 void DoubleToAscii(double v, DtoaMode mode, int requested_digits,
                    Vector<char> buffer, int* sign, int* length, int* point);
 
+// Writes the decimal digits of value into the characters preceding end and
+// returns a pointer to the most significant one. No '\0' is written.
+char* UnsignedToAsciiBackwards(uint64_t value, char* end);
+
 }  // namespace internal
 }  // namespace v8
 
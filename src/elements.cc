@@ -143,13 +143,14 @@ void CopyObjectToObjectElements(FixedArrayBase* from_base,
   DCHECK(IsFastSmiOrObjectElementsKind(from_kind));
   DCHECK(IsFastSmiOrObjectElementsKind(to_kind));
 
-  WriteBarrierMode write_barrier_mode =
-      (IsFastObjectElementsKind(from_kind) && IsFastObjectElementsKind(to_kind))
-          ? UPDATE_WRITE_BARRIER
-          : SKIP_WRITE_BARRIER;
-  for (int i = 0; i < copy_size; i++) {
-    Object* value = from->get(from_start + i);
-    to->set(to_start + i, value, write_barrier_mode);
+  // Copy the elements in bulk and issue a single write barrier for the
+  // whole range afterwards. Smis need no write barrier at all.
+  MemMove(to->data_start() + to_start, from->data_start() + from_start,
+          copy_size * kPointerSize);
+  if (IsFastObjectElementsKind(from_kind) &&
+      IsFastObjectElementsKind(to_kind)) {
+    FIXED_ARRAY_ELEMENTS_WRITE_BARRIER(from->GetHeap(), to, to_start,
+                                       copy_size);
   }
 }
 
@@ -349,11 +350,13 @@ static void CopyPackedSmiToDoubleElements(FixedArrayBase* from_base,
   if (copy_size == 0) return;
   FixedArray* from = FixedArray::cast(from_base);
   FixedDoubleArray* to = FixedDoubleArray::cast(to_base);
-  for (uint32_t from_end = from_start + static_cast<uint32_t>(packed_size);
-       from_start < from_end; from_start++, to_start++) {
-    Object* smi = from->get(from_start);
-    DCHECK(!smi->IsTheHole());
-    to->set(to_start, Smi::cast(smi)->value());
+  // A plain loop over the raw slots, which compilers turn into vector
+  // conversions. Integers are never NaN, so no canonicalization is needed.
+  Object** from_slots = from->data_start() + from_start;
+  double* to_slots = to->data_start() + to_start;
+  for (int i = 0; i < packed_size; i++) {
+    DCHECK(from_slots[i]->IsSmi());
+    to_slots[i] = Smi::cast(from_slots[i])->value();
   }
 }
 
@@ -69,6 +69,12 @@ ExternalReferenceTable::ExternalReferenceTable(Isolate* isolate) {
       "power_double_int_function");
   Add(ExternalReference::math_log_double_function(isolate).address(),
       "std::log");
+  Add(ExternalReference::fdlibm_sin_function(isolate).address(),
+      "fdlibm::sin");
+  Add(ExternalReference::fdlibm_cos_function(isolate).address(),
+      "fdlibm::cos");
+  Add(ExternalReference::fdlibm_tan_function(isolate).address(),
+      "fdlibm::tan");
   Add(ExternalReference::store_buffer_top(isolate).address(),
       "store_buffer_top");
   Add(ExternalReference::address_of_the_hole_nan().address(), "the_hole_nan");
@@ -366,6 +372,16 @@ ExternalReferenceTable::ExternalReferenceTable(Isolate* isolate) {
         Deoptimizer::CALCULATE_ENTRY_ADDRESS);
     Add(address, "lazy_deopt");
   }
+
+  // Add the external references provided by the embedder. They come last, so
+  // that the encodings of the references above do not depend on them.
+  intptr_t* api_external_references = isolate->api_external_references();
+  if (api_external_references != NULL) {
+    while (*api_external_references != 0) {
+      Add(reinterpret_cast<Address>(*api_external_references), "<embedder>");
+      api_external_references++;
+    }
+  }
 }
 
 }  // namespace internal
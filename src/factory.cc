@@ -47,6 +47,11 @@ namespace internal {
       __allocation__ = FUNCTION_CALL;                                         \
     }                                                                         \
     RETURN_OBJECT_UNLESS_RETRY(ISOLATE, TYPE)                                 \
+    if ((ISOLATE)->heap()->InvokeNearHeapLimitCallback()) {                   \
+      AlwaysAllocateScope __scope__(ISOLATE);                                 \
+      __allocation__ = FUNCTION_CALL;                                         \
+    }                                                                         \
+    RETURN_OBJECT_UNLESS_RETRY(ISOLATE, TYPE)                                 \
     /* TODO(1181417): Fix this. */                                            \
     v8::internal::Heap::FatalProcessOutOfMemory("CALL_AND_RETRY_LAST", true); \
     return Handle<TYPE>();                                                    \
@@ -282,10 +287,9 @@ MaybeHandle<String> Factory::NewStringFromUtf8(Vector<const char> string,
       String);
   // Copy ASCII portion.
   uint16_t* data = result->GetChars();
-  const char* ascii_data = string.start();
-  for (int i = 0; i < non_ascii_start; i++) {
-    *data++ = *ascii_data++;
-  }
+  CopyChars(data, reinterpret_cast<const uint8_t*>(string.start()),
+            non_ascii_start);
+  data += non_ascii_start;
   // Now write the remainder.
   decoder->WriteUtf16(data, utf16_length);
   return result;
@@ -727,6 +731,8 @@ Handle<Context> Factory::NewNativeContext() {
   Handle<Context> context = Handle<Context>::cast(array);
   context->set_native_context(*context);
   context->set_errors_thrown(Smi::FromInt(0));
+  // Not measured yet, see MarkCompactCollector::AttributeLiveBytesToContexts.
+  context->set_live_heap_kilobytes(Smi::FromInt(-1));
   Handle<WeakCell> weak_cell = NewWeakCell(context);
   context->set_self_weak_cell(*weak_cell);
   DCHECK(context->IsNativeContext());
@@ -887,6 +893,7 @@ Handle<Script> Factory::NewScript(Handle<String> source) {
   script->set_eval_from_position(0);
   script->set_shared_function_infos(Smi::FromInt(0));
   script->set_flags(0);
+  script->set_preparse_data(heap->undefined_value());
 
   heap->set_script_list(*WeakFixedArray::Add(script_list(), script));
   return script;
@@ -2359,6 +2366,10 @@ void Factory::SetRegExpIrregexpData(Handle<JSRegExp> regexp,
   store->set(JSRegExp::kIrregexpMaxRegisterCountIndex, Smi::FromInt(0));
   store->set(JSRegExp::kIrregexpCaptureCountIndex,
              Smi::FromInt(capture_count));
+  store->set(JSRegExp::kIrregexpLatin1BytecodeIndex, uninitialized);
+  store->set(JSRegExp::kIrregexpUC16BytecodeIndex, uninitialized);
+  store->set(JSRegExp::kIrregexpTicksUntilTierUpIndex,
+             Smi::FromInt(FLAG_regexp_tier_up_ticks));
   regexp->set_data(*store);
 }
 
@@ -119,6 +119,13 @@ struct MaybeBoolFlag {
 #else
 #define DEBUG_BOOL false
 #endif
+// Only enable instruction scheduling by default on targets that have a
+// latency model.
+#if defined(V8_TARGET_ARCH_X64) || defined(V8_TARGET_ARCH_ARM64)
+#define TURBO_INSTRUCTION_SCHEDULING_BOOL true
+#else
+#define TURBO_INSTRUCTION_SCHEDULING_BOOL false
+#endif
 #if (defined CAN_USE_VFP3_INSTRUCTIONS) || !(defined ARM_TEST_NO_FEATURE_PROBE)
 #define ENABLE_VFP3_DEFAULT true
 #else
@@ -257,7 +264,8 @@ DEFINE_BOOL(page_promotion, true, "promote pages based on utilization")
 DEFINE_INT(page_promotion_threshold, 70,
            "min percentage of live bytes on a page to enable fast evacuation")
 DEFINE_BOOL(trace_pretenuring, false,
-            "trace pretenuring decisions of HAllocate instructions")
+            "trace pretenuring decisions of HAllocate instructions and "
+            "allocation sites")
 DEFINE_BOOL(trace_pretenuring_statistics, false,
             "trace allocation site pretenuring statistics")
 DEFINE_BOOL(track_fields, true, "track fields with only smi values")
@@ -271,6 +279,9 @@ DEFINE_IMPLICATION(track_computed_fields, track_fields)
 DEFINE_BOOL(track_field_types, true, "track field types")
 DEFINE_IMPLICATION(track_field_types, track_fields)
 DEFINE_IMPLICATION(track_field_types, track_heap_object_fields)
+DEFINE_BOOL(slack_tracking_feedback, false,
+            "size new instances of a constructor by the number of fields "
+            "observed when in-object slack tracking completed")
 DEFINE_BOOL(smi_binop, true, "support smi representation in binary operations")
 
 // Flags for optimization types.
@@ -290,6 +301,28 @@ DEFINE_BOOL(ignition_eager, true, "eagerly compile and parse with ignition")
 DEFINE_BOOL(ignition_generators, false,
             "enable experimental ignition support for generators")
 DEFINE_STRING(ignition_filter, "*", "filter for ignition interpreter")
+DEFINE_BOOL(ignition_fuse_bytecodes, false,
+            "fuse and eliminate bytecodes in the ignition peephole optimizer")
+DEFINE_BOOL(ignition_reo, false, "use ignition register equivalence optimizer")
+DEFINE_BOOL(ignition_lazy_source_positions, false,
+            "omit expression positions from bytecode and recover them by "
+            "re-parsing when a stack trace needs them")
+DEFINE_BOOL(ignition_superinstructions, false,
+            "combine frequent bytecode pairs into superinstructions")
+DEFINE_BOOL(ignition_osr, false, "enable support for OSR from ignition code")
+DEFINE_BOOL(ignition_fast_generators, false,
+            "suspend and resume ignition generators without runtime calls, "
+            "saving only the registers live across a yield")
+DEFINE_IMPLICATION(ignition_fast_generators, ignition_generators)
+DEFINE_BOOL(ignition_lazy_feedback_allocation, false,
+            "allocate type feedback vectors of interpreted functions once "
+            "they used up their first interrupt budget")
+DEFINE_BOOL(block_coverage, false,
+            "count function invocations and block executions in interpreted "
+            "code and in TurboFan code built from bytecode")
+DEFINE_IMPLICATION(block_coverage, ignition)
+DEFINE_NEG_IMPLICATION(block_coverage, ignition_lazy_feedback_allocation)
+DEFINE_NEG_IMPLICATION(block_coverage, flush_code)
 DEFINE_BOOL(print_bytecode, false,
             "print bytecode generated by ignition interpreter")
 DEFINE_BOOL(trace_ignition, false,
@@ -400,6 +433,9 @@ DEFINE_INT(concurrent_recompilation_delay, 0,
            "artificial compilation delay in ms")
 DEFINE_BOOL(block_concurrent_recompilation, false,
             "block queued jobs until released")
+DEFINE_INT(concurrent_recompilation_max_age, 32,
+           "drop queued jobs of functions that were not found on the stack "
+           "for this many runtime profiler ticks (0 = never)")
 
 DEFINE_BOOL(omit_map_checks_for_leaf_maps, true,
             "do not emit check maps for constant values that have a leaf map, "
@@ -442,21 +478,37 @@ DEFINE_BOOL(native_context_specialization, true,
             "enable native context specialization in TurboFan")
 DEFINE_BOOL(turbo_inlining, true, "enable inlining in TurboFan")
 DEFINE_BOOL(trace_turbo_inlining, false, "trace TurboFan inlining")
+DEFINE_BOOL(turbo_inline_array_builtins, true,
+            "inline array iteration builtins in TurboFan")
 DEFINE_BOOL(loop_assignment_analysis, true, "perform loop assignment analysis")
 DEFINE_BOOL(turbo_profiling, false, "enable profiling in TurboFan")
 DEFINE_BOOL(turbo_verify_allocation, DEBUG_BOOL,
             "verify register allocation in TurboFan")
 DEFINE_BOOL(turbo_move_optimization, true, "optimize gap moves in TurboFan")
+DEFINE_BOOL(turbo_fast_register_allocation, false,
+            "use a cheaper register allocation tier for wasm and asm.js code")
 DEFINE_BOOL(turbo_jt, true, "enable jump threading in TurboFan")
 DEFINE_BOOL(turbo_osr, true, "enable OSR in TurboFan")
 DEFINE_BOOL(turbo_stress_loop_peeling, false,
             "stress loop peeling optimization")
+DEFINE_BOOL(turbo_loop_peeling, false,
+            "peel the first iteration of small innermost loops")
+DEFINE_BOOL(trace_turbo_loop, false, "trace TurboFan's loop optimizations")
+DEFINE_BOOL(turbo_store_elimination, false,
+            "eliminate redundant field stores in TurboFan")
+DEFINE_BOOL(turbo_allocation_folding, false,
+            "fold consecutive allocations in TurboFan")
 DEFINE_BOOL(turbo_cf_optimization, true, "optimize control flow in TurboFan")
 DEFINE_BOOL(turbo_frame_elision, true, "elide frames in TurboFan")
 DEFINE_BOOL(turbo_cache_shared_code, true, "cache context-independent code")
 DEFINE_BOOL(turbo_preserve_shared_code, false, "keep context-independent code")
+DEFINE_BOOL(turbo_context_independent_code, false,
+            "compile context-independent code for functions that were "
+            "already optimized in another native context")
 DEFINE_BOOL(experimental_turbo_escape, false, "enable escape analysis")
-DEFINE_BOOL(turbo_instruction_scheduling, false,
+DEFINE_BOOL(turbo_escape_stats, false,
+            "print the allocations eliminated by escape analysis")
+DEFINE_BOOL(turbo_instruction_scheduling, TURBO_INSTRUCTION_SCHEDULING_BOOL,
             "enable instruction scheduling in TurboFan")
 DEFINE_BOOL(turbo_stress_instruction_scheduling, false,
             "randomly schedule instructions to stress dependency tracking")
@@ -464,6 +516,13 @@ DEFINE_BOOL(turbo_stress_instruction_scheduling, false,
 // Flags for native WebAssembly.
 DEFINE_BOOL(expose_wasm, false, "expose WASM interface to JavaScript")
 DEFINE_BOOL(wasm_parallel_compilation, false, "compile WASM code in parallel")
+DEFINE_INT(wasm_num_compilation_tasks, 10,
+           "number of parallel compilation tasks for wasm")
+DEFINE_INT(wasm_fast_tier_body_size, 0,
+           "compile wasm functions with bodies of at least this many bytes "
+           "with the fast register allocation tier (0 to disable)")
+DEFINE_BOOL(wasm_lazy_compilation, false,
+            "compile wasm functions when they are first called")
 DEFINE_BOOL(trace_wasm_encoder, false, "trace encoding of wasm code")
 DEFINE_BOOL(trace_wasm_decoder, false, "trace decoding of wasm code")
 DEFINE_BOOL(trace_wasm_decode_time, false, "trace decoding time of wasm code")
@@ -497,6 +556,12 @@ DEFINE_INT(type_info_threshold, 25,
 DEFINE_INT(generic_ic_threshold, 30,
            "max percentage of megamorphic/generic ICs to allow optimization")
 DEFINE_INT(self_opt_count, 130, "call count before self-optimization")
+DEFINE_INT(ticks_before_optimization, 2,
+           "profiler ticks without type feedback changes before a function "
+           "is optimized")
+DEFINE_INT(max_bytecode_size_for_early_opt, 81,
+           "maximum bytecode size of functions that are tiered up on their "
+           "first profiler tick if no type feedback changed")
 
 DEFINE_BOOL(trace_opt_verbose, false, "extra verbose compilation tracing")
 DEFINE_IMPLICATION(trace_opt_verbose, trace_opt)
@@ -591,12 +656,25 @@ DEFINE_BOOL(serialize_toplevel, true, "enable caching of toplevel scripts")
 DEFINE_BOOL(serialize_eager, false, "compile eagerly when caching scripts")
 DEFINE_BOOL(serialize_age_code, false, "pre age code in the code cache")
 DEFINE_BOOL(trace_serializer, false, "print code serializer trace")
+DEFINE_BOOL(shared_code_cache, false,
+            "share the code cache for toplevel scripts between isolates")
+DEFINE_INT(shared_code_cache_size, 64,
+           "maximum size of the shared code cache (in Mbytes)")
 
 // compiler.cc
 DEFINE_INT(min_preparse_length, 1024,
            "minimum length for automatic enable preparsing")
+DEFINE_BOOL(eager_unary_iife, false,
+            "treat functions preceded by !, +, -, ~ or void as immediately "
+            "invoked and parse and compile them eagerly")
+DEFINE_BOOL(parser_cache_inner_functions, false,
+            "record inner functions of lazy functions in the parser cache and "
+            "skip them when the enclosing function is compiled lazily")
 DEFINE_INT(max_opt_count, 10,
            "maximum number of optimization attempts before giving up.")
+DEFINE_INT(deopt_loop_count, 5,
+           "number of deoptimizations after which a function is reported to "
+           "be in a deoptimization loop")
 
 // compilation-cache.cc
 DEFINE_BOOL(compilation_cache, true, "enable compilation cache")
@@ -606,6 +684,9 @@ DEFINE_BOOL(cache_prototype_transitions, true, "cache prototype transitions")
 // cpu-profiler.cc
 DEFINE_INT(cpu_profiler_sampling_interval, 1000,
            "CPU profiler sampling interval in microseconds")
+DEFINE_BOOL(sampling_thread_timer, false,
+            "let a timer of the profiled thread send the CPU profiler's "
+            "sampling signal instead of the profiler thread (Linux only)")
 
 // Array abuse tracing
 DEFINE_BOOL(trace_js_array_abuse, false,
@@ -648,6 +729,9 @@ DEFINE_INT(semi_space_growth_factor, 2, "factor by which to grow the new space")
 DEFINE_BOOL(experimental_new_space_growth_heuristic, false,
             "Grow the new space based on the percentage of survivors instead "
             "of their absolute value.")
+DEFINE_BOOL(adaptive_new_space_sizing, false,
+            "size the new space based on allocation throughput, scavenge "
+            "speed and survival rate")
 DEFINE_INT(max_old_space_size, 0, "max size of the old space (in Mbytes)")
 DEFINE_INT(initial_old_space_size, 0, "initial old space size (in Mbytes)")
 DEFINE_INT(max_executable_size, 0, "max size of executable memory (in Mbytes)")
@@ -691,6 +775,9 @@ DEFINE_BOOL(age_code, true,
             "track un-executed functions to age code and flush only "
             "old code (required for code flushing)")
 DEFINE_BOOL(incremental_marking, true, "use incremental marking")
+DEFINE_BOOL(incremental_marking_wrappers, false,
+            "trace wrappers through the embedder heap during incremental "
+            "marking")
 DEFINE_INT(min_progress_during_incremental_marking_finalization, 32,
            "keep finalizing incremental marking as long as we discover at "
            "least this many unmarked objects")
@@ -699,8 +786,18 @@ DEFINE_INT(max_incremental_marking_finalization_rounds, 3,
 DEFINE_BOOL(black_allocation, true, "use black allocation")
 DEFINE_BOOL(concurrent_sweeping, true, "use concurrent sweeping")
 DEFINE_BOOL(parallel_compaction, true, "use parallel compaction")
+DEFINE_BOOL(parallel_marking, false,
+            "use parallel tasks to rescan the heap for grey objects when the "
+            "marking deque overflows in the atomic pause")
 DEFINE_BOOL(parallel_pointer_update, true,
             "use parallel pointer update during compaction")
+DEFINE_BOOL(parallel_scavenge, false,
+            "filter the old-to-new remembered set in parallel during scavenge")
+DEFINE_BOOL(concurrent_store_buffer, true,
+            "use concurrent store buffer processing")
+DEFINE_BOOL(concurrent_array_buffer_freeing, true,
+            "free backing stores of dead array buffers on a background thread "
+            "if the array buffer allocator is thread-safe")
 DEFINE_BOOL(trace_incremental_marking, false,
             "trace progress of the incremental marking")
 DEFINE_BOOL(track_gc_object_stats, false,
@@ -718,6 +815,13 @@ DEFINE_BOOL(verify_heap, false, "verify heap pointers before and after GC")
 #endif
 DEFINE_BOOL(move_object_start, true, "enable moving of object starts")
 DEFINE_BOOL(memory_reducer, true, "use memory reducer")
+DEFINE_BOOL(trace_memory_pressure, false,
+            "report the memory released on memory pressure notifications")
+DEFINE_BOOL(numa_bind_heap_pages, false,
+            "prefer the NUMA node of the allocating thread for heap pages")
+DEFINE_BOOL(code_range_huge_pages, false,
+            "back code range pages with transparent huge pages, "
+            "committing their headers and guard pages as executable")
 DEFINE_BOOL(scavenge_reclaim_unmodified_objects, true,
             "remove unmodified and unreferenced objects")
 DEFINE_INT(heap_growing_percent, 0,
@@ -739,6 +843,8 @@ DEFINE_BOOL(heap_profiler_trace_objects, false,
 // sampling-heap-profiler.cc
 DEFINE_BOOL(sampling_heap_profiler_suppress_randomness, false,
             "Use constant sample intervals to eliminate test flakiness")
+DEFINE_INT(sampling_heap_profiler_timeline_interval, 1000,
+           "Length of the intervals of the allocation timeline in ms")
 
 
 // v8.cc
@@ -747,6 +853,11 @@ DEFINE_BOOL(use_idle_notification, true,
 // ic.cc
 DEFINE_BOOL(use_ic, true, "use inline caching")
 DEFINE_BOOL(trace_ic, false, "trace inline cache state transitions")
+DEFINE_BOOL(ic_stats, false,
+            "collect inline cache state transitions per site and print the "
+            "sites with the most megamorphic misses on exit")
+DEFINE_INT(max_polymorphic_map_count, 4,
+           "maximum number of maps to track in POLYMORPHIC state")
 
 // macro-assembler-ia32.cc
 DEFINE_BOOL(native_code_counters, false,
@@ -827,6 +938,11 @@ DEFINE_INT(hash_seed, 0,
            "Fixed seed to use to hash property keys (0 means random)"
            "(with snapshots this option cannot override the baked-in seed)")
 
+DEFINE_INT(zone_segment_pool_size, 2048,
+           "size of freed zone segments kept for reuse (in kBytes)")
+DEFINE_BOOL(trace_zone_stats, false,
+            "report zone memory statistics when the isolate is torn down")
+
 // runtime.cc
 DEFINE_BOOL(runtime_call_stats, false, "report runtime call counts and times")
 
@@ -835,9 +951,20 @@ DEFINE_BOOL(profile_deserialization, false,
             "Print the time it takes to deserialize the snapshot.")
 DEFINE_BOOL(serialization_statistics, false,
             "Collect statistics on serialized objects.")
+DEFINE_BOOL(lazy_deserialization, true,
+            "Deserialize builtins from the snapshot on their first call.")
 
 // Regexp
 DEFINE_BOOL(regexp_optimization, true, "generate optimized regexp code")
+DEFINE_BOOL(regexp_vector_skip, true,
+            "scan for the first characters of a regexp match with vector "
+            "instructions where supported")
+DEFINE_BOOL(regexp_tier_up, false,
+            "interpret regexps first and compile them to native code only "
+            "once they have been executed a few times")
+DEFINE_INT(regexp_tier_up_ticks, 1,
+           "number of interpreted executions before a regexp is compiled to "
+           "native code")
 
 // Testing flags test/cctest/test-{flags,api,serialization}.cc
 DEFINE_BOOL(testing_bool_flag, true, "testing_bool_flag")
@@ -859,6 +986,8 @@ DEFINE_STRING(startup_src, NULL,
               "Write V8 startup as C++ src. (mksnapshot only)")
 DEFINE_STRING(startup_blob, NULL,
               "Write V8 startup blob file. (mksnapshot only)")
+DEFINE_BOOL(compress_startup_blob, false,
+            "Compress the V8 startup blob file. (mksnapshot only)")
 
 // code-stubs-hydrogen.cc
 DEFINE_BOOL(profile_hydrogen_code_stub_compilation, false,
@@ -868,6 +997,10 @@ DEFINE_BOOL(predictable, false, "enable predictable mode")
 DEFINE_NEG_IMPLICATION(predictable, concurrent_recompilation)
 DEFINE_NEG_IMPLICATION(predictable, concurrent_sweeping)
 DEFINE_NEG_IMPLICATION(predictable, parallel_compaction)
+DEFINE_NEG_IMPLICATION(predictable, parallel_marking)
+DEFINE_NEG_IMPLICATION(predictable, parallel_scavenge)
+DEFINE_NEG_IMPLICATION(predictable, concurrent_store_buffer)
+DEFINE_NEG_IMPLICATION(predictable, concurrent_array_buffer_freeing)
 DEFINE_NEG_IMPLICATION(predictable, memory_reducer)
 
 // mark-compact.cc
@@ -1032,9 +1165,11 @@ DEFINE_BOOL(perf_basic_prof_only_functions, false,
 DEFINE_IMPLICATION(perf_basic_prof_only_functions, perf_basic_prof)
 DEFINE_BOOL(perf_prof, false,
             "Enable perf linux profiler (experimental annotate support).")
-DEFINE_NEG_IMPLICATION(perf_prof, compact_code_space)
 DEFINE_BOOL(perf_prof_debug_info, false,
             "Enable debug info for perf linux profiler (experimental).")
+DEFINE_BOOL(perf_prof_unwinding_info, false,
+            "Enable unwinding info for perf linux profiler (experimental).")
+DEFINE_IMPLICATION(perf_prof_unwinding_info, perf_prof)
 DEFINE_STRING(gc_fake_mmap, "/tmp/__v8_gc__",
               "Specify the name of the file for fake gc mmap used in ll_prof")
 DEFINE_BOOL(log_internal_timer_events, false, "Time internal events.")
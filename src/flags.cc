@@ -549,6 +549,22 @@ void FlagList::PrintHelp() {
 static uint32_t flag_hash = 0;
 
 
+// Flags that neither affect the generated code nor what it may assume about
+// the heap. Caches that are checked against FlagList::Hash() stay valid when
+// these flags change.
+static bool IsCodeIndependentFlag(const Flag* flag) {
+  const void* valptr = flag->valptr_;
+  return valptr == &FLAG_stack_size || valptr == &FLAG_min_semi_space_size ||
+         valptr == &FLAG_max_semi_space_size ||
+         valptr == &FLAG_max_old_space_size ||
+         valptr == &FLAG_initial_old_space_size ||
+         valptr == &FLAG_max_executable_size || valptr == &FLAG_trace_gc ||
+         valptr == &FLAG_trace_serializer ||
+         valptr == &FLAG_profile_deserialization ||
+         valptr == &FLAG_serialization_statistics;
+}
+
+
 void ComputeFlagListHash() {
   std::ostringstream modified_args_as_string;
 #ifdef DEBUG
@@ -556,6 +572,7 @@ void ComputeFlagListHash() {
 #endif  // DEBUG
   for (size_t i = 0; i < num_flags; ++i) {
     Flag* current = &flags[i];
+    if (IsCodeIndependentFlag(current)) continue;
     if (!current->IsDefault()) {
       modified_args_as_string << i;
       modified_args_as_string << *current;
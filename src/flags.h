@@ -59,7 +59,8 @@ class FlagList {
   static void EnforceFlagImplications();
 
   // Hash of flags (to quickly determine mismatching flag expectations).
-  // This hash is calculated during V8::Initialize and cached.
+  // This hash is calculated during V8::Initialize and cached. Flags that do
+  // not affect the generated code, like heap sizes, are not part of it.
   static uint32_t Hash();
 };
 
@@ -16,25 +16,26 @@
 namespace v8 {
 namespace internal {
 
-base::LazyMutex FutexEmulation::mutex_ = LAZY_MUTEX_INITIALIZER;
-base::LazyInstance<FutexWaitList>::type FutexEmulation::wait_list_ =
-    LAZY_INSTANCE_INITIALIZER;
+base::LazyInstance<FutexEmulation::WaitLists>::type
+    FutexEmulation::wait_lists_ = LAZY_INSTANCE_INITIALIZER;
 
 
 void FutexWaitListNode::NotifyWake() {
-  // Lock the FutexEmulation mutex before notifying. We know that the mutex
-  // will have been unlocked if we are currently waiting on the condition
+  // Lock the mutex of the node's wait list before notifying. We know that the
+  // mutex will have been unlocked if we are currently waiting on the condition
   // variable.
   //
   // The mutex may also not be locked if the other thread is currently handling
   // interrupts, or if FutexEmulation::Wait was just called and the mutex
   // hasn't been locked yet. In either of those cases, we set the interrupted
   // flag to true, which will be tested after the mutex is re-locked.
-  base::LockGuard<base::Mutex> lock_guard(FutexEmulation::mutex_.Pointer());
+  FutexWaitList* list = FutexEmulation::LockWaitListOf(this);
+  if (list == nullptr) return;
   if (waiting_) {
     cond_.NotifyOne();
     interrupted_ = true;
   }
+  list->mutex_.Unlock();
 }
 
 
@@ -72,6 +73,27 @@ void FutexWaitList::RemoveNode(FutexWaitListNode* node) {
 }
 
 
+FutexWaitList* FutexEmulation::WaitListFor(void* backing_store,
+                                           size_t addr) {
+  uint32_t hash =
+      ComputePointerHash(static_cast<int8_t*>(backing_store) + addr);
+  return &wait_lists_.Pointer()->lists[hash & (kWaitListCount - 1)];
+}
+
+
+FutexWaitList* FutexEmulation::LockWaitListOf(FutexWaitListNode* node) {
+  // The node can be moved to another list by WakeOrRequeue until we hold the
+  // mutex of the list it is on.
+  while (true) {
+    FutexWaitList* list = node->wait_list();
+    if (list == nullptr) return nullptr;
+    list->mutex_.Lock();
+    if (node->wait_list() == list) return list;
+    list->mutex_.Unlock();
+  }
+}
+
+
 Object* FutexEmulation::Wait(Isolate* isolate,
                              Handle<JSArrayBuffer> array_buffer, size_t addr,
                              int32_t value, double rel_timeout_ms) {
@@ -81,14 +103,26 @@ Object* FutexEmulation::Wait(Isolate* isolate,
   int32_t* p =
       reinterpret_cast<int32_t*>(static_cast<int8_t*>(backing_store) + addr);
 
-  base::LockGuard<base::Mutex> lock_guard(mutex_.Pointer());
+  FutexWaitList* list = WaitListFor(backing_store, addr);
+  FutexWaitListNode* node = isolate->futex_wait_list_node();
+  FutexWaitList* old_list = node->wait_list();
+  if (old_list != list) {
+    // The node is not waiting, but NotifyWake may be looking at it.
+    if (old_list != nullptr) {
+      base::LockGuard<base::Mutex> lock_guard(&old_list->mutex_);
+      node->set_wait_list(list);
+    } else {
+      node->set_wait_list(list);
+    }
+  }
+
+  list->mutex_.Lock();
 
   if (*p != value) {
+    list->mutex_.Unlock();
     return Smi::FromInt(Result::kNotEqual);
   }
 
-  FutexWaitListNode* node = isolate->futex_wait_list_node();
-
   node->backing_store_ = backing_store;
   node->wait_addr_ = addr;
   node->waiting_ = true;
@@ -116,7 +150,7 @@ Object* FutexEmulation::Wait(Isolate* isolate,
   base::TimeTicks timeout_time = start_time + rel_timeout;
   base::TimeTicks current_time = start_time;
 
-  wait_list_.Pointer()->AddNode(node);
+  list->AddNode(node);
 
   Object* result;
 
@@ -125,18 +159,18 @@ Object* FutexEmulation::Wait(Isolate* isolate,
     node->interrupted_ = false;
 
     // Unlock the mutex here to prevent deadlock from lock ordering between
-    // mutex_ and mutexes locked by HandleInterrupts.
-    mutex_.Pointer()->Unlock();
+    // the list's mutex and mutexes locked by HandleInterrupts.
+    list->mutex_.Unlock();
 
     // Because the mutex is unlocked, we have to be careful about not dropping
     // an interrupt. The notification can happen in three different places:
     // 1) Before Wait is called: the notification will be dropped, but
     //    interrupted_ will be set to 1. This will be checked below.
-    // 2) After interrupted has been checked here, but before mutex_ is
-    //    acquired: interrupted is checked again below, with mutex_ locked.
-    //    Because the wakeup signal also acquires mutex_, we know it will not
-    //    be able to notify until mutex_ is released below, when waiting on the
-    //    condition variable.
+    // 2) After interrupted has been checked here, but before the mutex is
+    //    acquired: interrupted is checked again below, with the mutex locked.
+    //    Because the wakeup signal also acquires the mutex, we know it will
+    //    not be able to notify until the mutex is released below, when
+    //    waiting on the condition variable.
     // 3) After the mutex is released in the call to WaitFor(): this
     // notification will wake up the condition variable. node->waiting() will
     // be false, so we'll loop and then check interrupts.
@@ -144,15 +178,15 @@ Object* FutexEmulation::Wait(Isolate* isolate,
       Object* interrupt_object = isolate->stack_guard()->HandleInterrupts();
       if (interrupt_object->IsException()) {
         result = interrupt_object;
-        mutex_.Pointer()->Lock();
+        list = LockWaitListOf(node);
         break;
       }
     }
 
-    mutex_.Pointer()->Lock();
+    list = LockWaitListOf(node);
 
     if (node->interrupted_) {
-      // An interrupt occured while the mutex_ was unlocked. Don't wait yet.
+      // An interrupt occured while the mutex was unlocked. Don't wait yet.
       continue;
     }
 
@@ -172,17 +206,23 @@ Object* FutexEmulation::Wait(Isolate* isolate,
       base::TimeDelta time_until_timeout = timeout_time - current_time;
       DCHECK(time_until_timeout.InMicroseconds() >= 0);
       bool wait_for_result =
-          node->cond_.WaitFor(mutex_.Pointer(), time_until_timeout);
+          node->cond_.WaitFor(&list->mutex_, time_until_timeout);
       USE(wait_for_result);
     } else {
-      node->cond_.Wait(mutex_.Pointer());
+      node->cond_.Wait(&list->mutex_);
     }
 
-    // Spurious wakeup, interrupt or timeout.
+    // Spurious wakeup, interrupt, timeout or requeue. A requeued node is on
+    // another list now, whose mutex protects its state.
+    if (node->wait_list() != list) {
+      list->mutex_.Unlock();
+      list = LockWaitListOf(node);
+    }
   }
 
-  wait_list_.Pointer()->RemoveNode(node);
+  list->RemoveNode(node);
   node->waiting_ = false;
+  list->mutex_.Unlock();
 
   return result;
 }
@@ -196,8 +236,9 @@ Object* FutexEmulation::Wake(Isolate* isolate,
   int waiters_woken = 0;
   void* backing_store = array_buffer->backing_store();
 
-  base::LockGuard<base::Mutex> lock_guard(mutex_.Pointer());
-  FutexWaitListNode* node = wait_list_.Pointer()->head_;
+  FutexWaitList* list = WaitListFor(backing_store, addr);
+  base::LockGuard<base::Mutex> lock_guard(&list->mutex_);
+  FutexWaitListNode* node = list->head_;
   while (node && num_waiters_to_wake > 0) {
     if (backing_store == node->backing_store_ && addr == node->wait_addr_) {
       node->waiting_ = false;
@@ -224,30 +265,47 @@ Object* FutexEmulation::WakeOrRequeue(Isolate* isolate,
   int32_t* p =
       reinterpret_cast<int32_t*>(static_cast<int8_t*>(backing_store) + addr);
 
-  base::LockGuard<base::Mutex> lock_guard(mutex_.Pointer());
-  if (*p != value) {
-    return Smi::FromInt(Result::kNotEqual);
-  }
+  // Lock both lists in a fixed order, so that requeues between the same two
+  // lists in opposite directions cannot deadlock.
+  FutexWaitList* list = WaitListFor(backing_store, addr);
+  FutexWaitList* list2 = WaitListFor(backing_store, addr2);
+  FutexWaitList* first = list < list2 ? list : list2;
+  FutexWaitList* second = list < list2 ? list2 : list;
+  base::LockGuard<base::Mutex> first_lock_guard(&first->mutex_);
+  if (second != first) second->mutex_.Lock();
 
-  // Wake |num_waiters_to_wake|
-  int waiters_woken = 0;
-  FutexWaitListNode* node = wait_list_.Pointer()->head_;
-  while (node) {
-    if (backing_store == node->backing_store_ && addr == node->wait_addr_) {
-      if (num_waiters_to_wake > 0) {
-        node->waiting_ = false;
-        node->cond_.NotifyOne();
-        --num_waiters_to_wake;
-        waiters_woken++;
-      } else {
-        node->wait_addr_ = addr2;
+  Object* result;
+  if (*p != value) {
+    result = Smi::FromInt(Result::kNotEqual);
+  } else {
+    // Wake |num_waiters_to_wake|
+    int waiters_woken = 0;
+    FutexWaitListNode* node = list->head_;
+    while (node) {
+      FutexWaitListNode* next = node->next_;
+      if (backing_store == node->backing_store_ && addr == node->wait_addr_) {
+        if (num_waiters_to_wake > 0) {
+          node->waiting_ = false;
+          node->cond_.NotifyOne();
+          --num_waiters_to_wake;
+          waiters_woken++;
+        } else {
+          node->wait_addr_ = addr2;
+          if (list2 != list) {
+            list->RemoveNode(node);
+            list2->AddNode(node);
+            node->set_wait_list(list2);
+          }
+        }
       }
-    }
 
-    node = node->next_;
+      node = next;
+    }
+    result = Smi::FromInt(waiters_woken);
   }
 
-  return Smi::FromInt(waiters_woken);
+  if (second != first) second->mutex_.Unlock();
+  return result;
 }
 
 
@@ -257,10 +315,11 @@ Object* FutexEmulation::NumWaitersForTesting(Isolate* isolate,
   DCHECK(addr < NumberToSize(isolate, array_buffer->byte_length()));
   void* backing_store = array_buffer->backing_store();
 
-  base::LockGuard<base::Mutex> lock_guard(mutex_.Pointer());
+  FutexWaitList* list = WaitListFor(backing_store, addr);
+  base::LockGuard<base::Mutex> lock_guard(&list->mutex_);
 
   int waiters = 0;
-  FutexWaitListNode* node = wait_list_.Pointer()->head_;
+  FutexWaitListNode* node = list->head_;
   while (node) {
     if (backing_store == node->backing_store_ && addr == node->wait_addr_ &&
         node->waiting_) {
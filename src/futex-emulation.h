@@ -31,6 +31,7 @@ class TimeDelta;
 
 namespace internal {
 
+class FutexWaitList;
 class Isolate;
 class JSArrayBuffer;
 
@@ -39,6 +40,7 @@ class FutexWaitListNode {
   FutexWaitListNode()
       : prev_(nullptr),
         next_(nullptr),
+        wait_list_(0),
         backing_store_(nullptr),
         wait_addr_(0),
         waiting_(false),
@@ -50,9 +52,19 @@ class FutexWaitListNode {
   friend class FutexEmulation;
   friend class FutexWaitList;
 
+  FutexWaitList* wait_list() const {
+    return reinterpret_cast<FutexWaitList*>(base::Acquire_Load(&wait_list_));
+  }
+  void set_wait_list(FutexWaitList* list) {
+    base::Release_Store(&wait_list_, reinterpret_cast<base::AtomicWord>(list));
+  }
+
   base::ConditionVariable cond_;
   FutexWaitListNode* prev_;
   FutexWaitListNode* next_;
+  // The wait list the node was last added to, read without holding a lock.
+  // It only changes while the mutex of the old list is held.
+  base::AtomicWord wait_list_;
   void* backing_store_;
   size_t wait_addr_;
   bool waiting_;
@@ -71,7 +83,10 @@ class FutexWaitList {
 
  private:
   friend class FutexEmulation;
+  friend class FutexWaitListNode;
 
+  // Protects the list and the waiting state of its nodes.
+  base::Mutex mutex_;
   FutexWaitListNode* head_;
   FutexWaitListNode* tail_;
 
@@ -122,8 +137,22 @@ class FutexEmulation : public AllStatic {
  private:
   friend class FutexWaitListNode;
 
-  static base::LazyMutex mutex_;
-  static base::LazyInstance<FutexWaitList>::type wait_list_;
+  // Waiters are spread over several lists by the address they wait on, each
+  // with its own mutex, so that waits and wakes on unrelated addresses from
+  // different threads do not contend.
+  static const int kWaitListCount = 64;
+
+  struct WaitLists {
+    FutexWaitList lists[kWaitListCount];
+  };
+
+  static FutexWaitList* WaitListFor(void* backing_store, size_t addr);
+
+  // Locks and returns the list |node| is currently on, or returns nullptr if
+  // the node has never waited.
+  static FutexWaitList* LockWaitListOf(FutexWaitListNode* node);
+
+  static base::LazyInstance<WaitLists>::type wait_lists_;
 };
 }  // namespace internal
 }  // namespace v8
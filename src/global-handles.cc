@@ -680,10 +680,21 @@ void GlobalHandles::IterateWeakRoots(ObjectVisitor* v) {
 
 
 void GlobalHandles::IdentifyWeakHandles(WeakSlotCallback f) {
+  // The flags for minor collections are not used by the mark-compact
+  // collector, so they are reset here instead of visiting all nodes once more
+  // in PostMarkSweepProcessing. Nodes that are still pending from an earlier
+  // collection whose processing was interrupted are picked up again.
+  pending_nodes_.Rewind(0);
   for (NodeIterator it(this); !it.done(); it.Advance()) {
-    if (it.node()->IsWeak() && f(it.node()->location())) {
-      it.node()->MarkPending();
+    Node* node = it.node();
+    if (!node->IsRetainer()) continue;
+    if (FLAG_scavenge_reclaim_unmodified_objects) {
+      node->set_active(false);
+    } else {
+      node->clear_partially_dependent();
     }
+    if (node->IsWeak() && f(node->location())) node->MarkPending();
+    if (node->state() == Node::PENDING) pending_nodes_.Add(node);
   }
 }
 
@@ -995,27 +1006,27 @@ int GlobalHandles::PostScavengeProcessing(
 int GlobalHandles::PostMarkSweepProcessing(
     const int initial_post_gc_processing_count) {
   int freed_nodes = 0;
-  for (NodeIterator it(this); !it.done(); it.Advance()) {
-    if (!it.node()->IsRetainer()) {
+  // Only the nodes found by IdentifyWeakHandles can have weak callbacks to
+  // run. Callbacks may free or reuse other nodes, which is handled by the
+  // state checks.
+  for (int i = 0; i < pending_nodes_.length(); ++i) {
+    Node* node = pending_nodes_[i];
+    if (!node->IsRetainer()) {
       // Free nodes do not have weak callbacks. Do not use them to compute
       // the freed_nodes.
       continue;
     }
-    if (FLAG_scavenge_reclaim_unmodified_objects) {
-      it.node()->set_active(false);
-    } else {
-      it.node()->clear_partially_dependent();
-    }
-    if (it.node()->PostGarbageCollectionProcessing(isolate_)) {
+    if (node->PostGarbageCollectionProcessing(isolate_)) {
       if (initial_post_gc_processing_count != post_gc_processing_count_) {
         // See the comment above.
         return freed_nodes;
       }
     }
-    if (!it.node()->IsRetainer()) {
+    if (!node->IsRetainer()) {
       freed_nodes++;
     }
   }
+  pending_nodes_.Rewind(0);
   return freed_nodes;
 }
 
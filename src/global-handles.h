@@ -342,6 +342,10 @@ class GlobalHandles {
   // is accessed, some of the objects may have been promoted already.
   List<Node*> new_space_nodes_;
 
+  // Nodes found pending by the last mark-compact collection, whose weak
+  // callbacks are run after the collection.
+  List<Node*> pending_nodes_;
+
   int post_gc_processing_count_;
 
   // Object groups and implicit references, public and more efficient
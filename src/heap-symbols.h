@@ -106,6 +106,7 @@
   V(source_string, "source")                                       \
   V(source_url_string, "source_url")                               \
   V(stack_string, "stack")                                         \
+  V(stack_trace_limit_string, "stackTraceLimit")                   \
   V(strict_compare_ic_string, "===")                               \
   V(string_string, "string")                                       \
   V(String_string, "String")                                       \
@@ -12,7 +12,25 @@
 namespace v8 {
 namespace internal {
 
+class ArrayBufferTracker::FreeTask : public v8::Task {
+ public:
+  FreeTask(ArrayBufferTracker* tracker, DeadBackingStores* backing_stores)
+      : tracker_(tracker), backing_stores_(backing_stores) {}
+
+ private:
+  // v8::Task overrides.
+  void Run() override {
+    tracker_->FreeBackingStores(backing_stores_);
+    tracker_->pending_free_tasks_semaphore_.Signal();
+  }
+
+  ArrayBufferTracker* tracker_;
+  DeadBackingStores* backing_stores_;
+  DISALLOW_COPY_AND_ASSIGN(FreeTask);
+};
+
 ArrayBufferTracker::~ArrayBufferTracker() {
+  WaitUntilFreeingCompleted();
   Isolate* isolate = heap()->isolate();
   size_t freed_memory = 0;
   for (auto& buffer : live_array_buffers_) {
@@ -92,16 +110,18 @@ void ArrayBufferTracker::MarkLive(JSArrayBuffer* buffer) {
 
 void ArrayBufferTracker::FreeDead(bool from_scavenge) {
   size_t freed_memory = 0;
-  Isolate* isolate = heap()->isolate();
+  DeadBackingStores* dead = new DeadBackingStores();
   for (auto& buffer : not_yet_discovered_array_buffers_for_scavenge_) {
-    isolate->array_buffer_allocator()->Free(buffer.first, buffer.second);
+    dead->data.push_back(buffer.first);
+    dead->length.push_back(buffer.second);
     freed_memory += buffer.second;
     live_array_buffers_for_scavenge_.erase(buffer.first);
   }
 
   if (!from_scavenge) {
     for (auto& buffer : not_yet_discovered_array_buffers_) {
-      isolate->array_buffer_allocator()->Free(buffer.first, buffer.second);
+      dead->data.push_back(buffer.first);
+      dead->length.push_back(buffer.second);
       freed_memory += buffer.second;
       live_array_buffers_.erase(buffer.first);
     }
@@ -111,12 +131,43 @@ void ArrayBufferTracker::FreeDead(bool from_scavenge) {
       live_array_buffers_for_scavenge_;
   if (!from_scavenge) not_yet_discovered_array_buffers_ = live_array_buffers_;
 
+  if (dead->data.empty()) {
+    delete dead;
+  } else if (FLAG_concurrent_array_buffer_freeing &&
+             heap()->isolate()->array_buffer_allocator()->IsThreadSafe()) {
+    V8::GetCurrentPlatform()->CallOnBackgroundThread(
+        new FreeTask(this, dead), v8::Platform::kShortRunningTask);
+    concurrent_free_tasks_active_++;
+  } else {
+    FreeBackingStores(dead);
+  }
+
   // Do not call through the api as this code is triggered while doing a GC.
   heap()->update_amount_of_external_allocated_memory(
       -static_cast<int64_t>(freed_memory));
 }
 
 
+bool ArrayBufferTracker::WaitUntilFreeingCompleted() {
+  bool waited = false;
+  while (concurrent_free_tasks_active_ > 0) {
+    pending_free_tasks_semaphore_.Wait();
+    concurrent_free_tasks_active_--;
+    waited = true;
+  }
+  return waited;
+}
+
+
+void ArrayBufferTracker::FreeBackingStores(DeadBackingStores* backing_stores) {
+  DCHECK_EQ(backing_stores->data.size(), backing_stores->length.size());
+  heap()->isolate()->array_buffer_allocator()->FreeBatch(
+      backing_stores->data.data(), backing_stores->length.data(),
+      backing_stores->data.size());
+  delete backing_stores;
+}
+
+
 void ArrayBufferTracker::PrepareDiscoveryInNewSpace() {
   not_yet_discovered_array_buffers_for_scavenge_ =
       live_array_buffers_for_scavenge_;
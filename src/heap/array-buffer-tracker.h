@@ -6,8 +6,10 @@
 #define V8_HEAP_ARRAY_BUFFER_TRACKER_H_
 
 #include <map>
+#include <vector>
 
 #include "src/base/platform/mutex.h"
+#include "src/base/platform/semaphore.h"
 #include "src/globals.h"
 
 namespace v8 {
@@ -19,7 +21,10 @@ class JSArrayBuffer;
 
 class ArrayBufferTracker {
  public:
-  explicit ArrayBufferTracker(Heap* heap) : heap_(heap) {}
+  explicit ArrayBufferTracker(Heap* heap)
+      : heap_(heap),
+        pending_free_tasks_semaphore_(0),
+        concurrent_free_tasks_active_(0) {}
   ~ArrayBufferTracker();
 
   inline Heap* heap() { return heap_; }
@@ -37,9 +42,15 @@ class ArrayBufferTracker {
   void MarkLive(JSArrayBuffer* buffer);
 
   // Frees all backing store pointers that weren't discovered in the previous
-  // marking or scavenge phase.
+  // marking or scavenge phase. The memory is handed back to the allocator in
+  // one batch, on a background thread if the allocator is thread-safe and
+  // --concurrent-array-buffer-freeing is enabled.
   void FreeDead(bool from_scavenge);
 
+  // Blocks until all backing stores handed to background tasks have been
+  // freed. Returns true if it had to wait.
+  bool WaitUntilFreeingCompleted();
+
   // Prepare for a new scavenge phase. A new marking phase is implicitly
   // prepared by finishing the previous one.
   void PrepareDiscoveryInNewSpace();
@@ -48,9 +59,23 @@ class ArrayBufferTracker {
   void Promote(JSArrayBuffer* buffer);
 
  private:
+  class FreeTask;
+
+  // Backing stores of dead array buffers that are waiting to be returned to
+  // the array buffer allocator.
+  struct DeadBackingStores {
+    std::vector<void*> data;
+    std::vector<size_t> length;
+  };
+
+  void FreeBackingStores(DeadBackingStores* backing_stores);
+
   base::Mutex mutex_;
   Heap* heap_;
 
+  base::Semaphore pending_free_tasks_semaphore_;
+  intptr_t concurrent_free_tasks_active_;
+
   // |live_array_buffers_| maps externally allocated memory used as backing
   // store for ArrayBuffers to the length of the respective memory blocks.
   //
@@ -0,0 +1,203 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_CONCURRENT_MARKING_DEQUE_
+#define V8_HEAP_CONCURRENT_MARKING_DEQUE_
+
+#include "src/allocation.h"
+#include "src/base/platform/mutex.h"
+#include "src/utils.h"
+
+namespace v8 {
+namespace internal {
+
+class HeapObject;
+
+// A marking worklist that can be shared by several marking tasks.
+// Every task owns a private push segment and a private pop segment that it
+// accesses without synchronization. Full push segments are published to a
+// global pool that is protected by a mutex. A task that runs out of local
+// work steals a segment from the global pool.
+//
+// Unlike MarkingDeque the worklist never overflows: segments are allocated
+// on demand from the C++ heap.
+class ConcurrentMarkingDeque {
+ public:
+  static const int kMaxNumTasks = 8;
+  static const int kSegmentCapacity = 64;
+
+  explicit ConcurrentMarkingDeque(int num_tasks)
+      : num_tasks_(num_tasks), global_pool_(nullptr), global_pool_size_(0) {
+    DCHECK_LE(num_tasks, kMaxNumTasks);
+    for (int i = 0; i < num_tasks_; i++) {
+      private_push_segment_[i] = new Segment();
+      private_pop_segment_[i] = new Segment();
+    }
+  }
+
+  ~ConcurrentMarkingDeque() {
+    Clear();
+    for (int i = 0; i < num_tasks_; i++) {
+      delete private_push_segment_[i];
+      delete private_pop_segment_[i];
+    }
+  }
+
+  int num_tasks() const { return num_tasks_; }
+
+  void Push(int task_id, HeapObject* object) {
+    DCHECK_LT(task_id, num_tasks_);
+    Segment* segment = private_push_segment_[task_id];
+    if (segment->IsFull()) {
+      PublishPushSegment(task_id);
+      segment = private_push_segment_[task_id];
+    }
+    segment->Push(object);
+  }
+
+  // Pops an object from the private segments of the given task. Falls back
+  // to stealing work from the global pool. Returns false iff no work was
+  // found.
+  bool Pop(int task_id, HeapObject** object) {
+    DCHECK_LT(task_id, num_tasks_);
+    Segment* segment = private_pop_segment_[task_id];
+    if (segment->IsEmpty()) {
+      Segment* push_segment = private_push_segment_[task_id];
+      if (!push_segment->IsEmpty()) {
+        // Swap the segments instead of stealing from other tasks, this keeps
+        // the working set local.
+        private_pop_segment_[task_id] = push_segment;
+        private_push_segment_[task_id] = segment;
+      } else if (!StealPopSegment(task_id)) {
+        return false;
+      }
+      segment = private_pop_segment_[task_id];
+    }
+    *object = segment->Pop();
+    return true;
+  }
+
+  // Makes all private work of the given task visible to other tasks.
+  void FlushToGlobal(int task_id) {
+    DCHECK_LT(task_id, num_tasks_);
+    if (!private_push_segment_[task_id]->IsEmpty()) {
+      PublishPushSegment(task_id);
+    }
+    if (!private_pop_segment_[task_id]->IsEmpty()) {
+      Segment* segment = private_pop_segment_[task_id];
+      private_pop_segment_[task_id] = new Segment();
+      PushToGlobalPool(segment);
+    }
+  }
+
+  bool IsLocalEmpty(int task_id) {
+    return private_push_segment_[task_id]->IsEmpty() &&
+           private_pop_segment_[task_id]->IsEmpty();
+  }
+
+  bool IsGlobalPoolEmpty() {
+    base::LockGuard<base::Mutex> guard(&lock_);
+    return global_pool_ == nullptr;
+  }
+
+  // Returns true if no task has local work and the global pool is empty.
+  // Must not be called while tasks are running.
+  bool IsEmpty() {
+    for (int i = 0; i < num_tasks_; i++) {
+      if (!IsLocalEmpty(i)) return false;
+    }
+    return IsGlobalPoolEmpty();
+  }
+
+  // Number of segments in the global pool. Used by the scheduler of
+  // marking tasks to decide whether it is worth spawning more tasks.
+  int GlobalPoolSize() {
+    base::LockGuard<base::Mutex> guard(&lock_);
+    return global_pool_size_;
+  }
+
+  // Drops all work. Must not be called while tasks are running.
+  void Clear() {
+    for (int i = 0; i < num_tasks_; i++) {
+      private_push_segment_[i]->Clear();
+      private_pop_segment_[i]->Clear();
+    }
+    base::LockGuard<base::Mutex> guard(&lock_);
+    while (global_pool_ != nullptr) {
+      Segment* next = global_pool_->next();
+      delete global_pool_;
+      global_pool_ = next;
+    }
+    global_pool_size_ = 0;
+  }
+
+ private:
+  class Segment : public Malloced {
+   public:
+    Segment() : index_(0), next_(nullptr) {}
+
+    bool IsEmpty() const { return index_ == 0; }
+    bool IsFull() const { return index_ == kSegmentCapacity; }
+    void Clear() { index_ = 0; }
+
+    void Push(HeapObject* object) {
+      DCHECK(!IsFull());
+      objects_[index_++] = object;
+    }
+
+    HeapObject* Pop() {
+      DCHECK(!IsEmpty());
+      return objects_[--index_];
+    }
+
+    Segment* next() const { return next_; }
+    void set_next(Segment* segment) { next_ = segment; }
+
+   private:
+    int index_;
+    Segment* next_;
+    HeapObject* objects_[kSegmentCapacity];
+  };
+
+  void PublishPushSegment(int task_id) {
+    PushToGlobalPool(private_push_segment_[task_id]);
+    private_push_segment_[task_id] = new Segment();
+  }
+
+  bool StealPopSegment(int task_id) {
+    Segment* segment = nullptr;
+    {
+      base::LockGuard<base::Mutex> guard(&lock_);
+      if (global_pool_ == nullptr) return false;
+      segment = global_pool_;
+      global_pool_ = segment->next();
+      global_pool_size_--;
+    }
+    delete private_pop_segment_[task_id];
+    segment->set_next(nullptr);
+    private_pop_segment_[task_id] = segment;
+    return true;
+  }
+
+  void PushToGlobalPool(Segment* segment) {
+    base::LockGuard<base::Mutex> guard(&lock_);
+    segment->set_next(global_pool_);
+    global_pool_ = segment;
+    global_pool_size_++;
+  }
+
+  int num_tasks_;
+  Segment* private_push_segment_[kMaxNumTasks];
+  Segment* private_pop_segment_[kMaxNumTasks];
+  base::Mutex lock_;
+  Segment* global_pool_;
+  int global_pool_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(ConcurrentMarkingDeque);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_CONCURRENT_MARKING_DEQUE_
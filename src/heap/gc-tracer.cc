@@ -7,6 +7,7 @@
 #include "src/counters.h"
 #include "src/heap/heap-inl.h"
 #include "src/isolate.h"
+#include "src/tracing/trace-event.h"
 
 namespace v8 {
 namespace internal {
@@ -79,7 +80,10 @@ GCTracer::Event::Event(Type type, const char* gc_reason,
       incremental_marking_duration(0.0),
       cumulative_pure_incremental_marking_duration(0.0),
       pure_incremental_marking_duration(0.0),
-      longest_incremental_marking_step(0.0) {
+      longest_incremental_marking_step(0.0),
+      scavenge_tasks(0),
+      scavenge_tasks_duration(0.0),
+      longest_scavenge_task(0.0) {
   for (int i = 0; i < Scope::NUMBER_OF_SCOPES; i++) {
     scopes[i] = 0;
   }
@@ -138,6 +142,18 @@ GCTracer::GCTracer(Heap* heap)
 }
 
 
+void GCTracer::TraceHeapSizes(intptr_t object_size, intptr_t memory_size,
+                              intptr_t holes_size) {
+  // Counters are sampled at the beginning and the end of every GC, so that
+  // the GC phase events can be put in relation to the heap size.
+  TRACE_COUNTER2(TRACE_DISABLED_BY_DEFAULT("v8.gc"), "V8.GCHeapSize",
+                 "object_size_kb", object_size / KB, "memory_size_kb",
+                 memory_size / KB);
+  TRACE_COUNTER1(TRACE_DISABLED_BY_DEFAULT("v8.gc"), "V8.GCHolesSize",
+                 holes_size / KB);
+}
+
+
 void GCTracer::Start(GarbageCollector collector, const char* gc_reason,
                      const char* collector_reason) {
   start_counter_++;
@@ -182,6 +198,8 @@ void GCTracer::Start(GarbageCollector collector, const char* gc_reason,
   for (int i = 0; i < Scope::NUMBER_OF_SCOPES; i++) {
     current_.scopes[i] = 0;
   }
+  TraceHeapSizes(current_.start_object_size, current_.start_memory_size,
+                 current_.start_holes_size);
   int committed_memory = static_cast<int>(heap_->CommittedMemory() / KB);
   int used_memory = static_cast<int>(current_.start_object_size / KB);
   heap_->isolate()->counters()->aggregated_memory_heap_committed()->AddSample(
@@ -219,6 +237,8 @@ void GCTracer::Stop(GarbageCollector collector) {
   current_.survived_new_space_object_size = heap_->SurvivedNewSpaceObjectSize();
 
   AddAllocation(current_.end_time);
+  TraceHeapSizes(current_.end_object_size, current_.end_memory_size,
+                 current_.end_holes_size);
 
   int committed_memory = static_cast<int>(heap_->CommittedMemory() / KB);
   int used_memory = static_cast<int>(current_.end_object_size / KB);
@@ -389,6 +409,14 @@ void GCTracer::AddIncrementalMarkingFinalizationStep(double duration) {
 }
 
 
+void GCTracer::AddScavengeTask(double duration) {
+  current_.scavenge_tasks++;
+  current_.scavenge_tasks_duration += duration;
+  current_.longest_scavenge_task =
+      Max(current_.longest_scavenge_task, duration);
+}
+
+
 void GCTracer::Output(const char* format, ...) const {
   if (FLAG_trace_gc) {
     va_list arguments;
@@ -469,6 +497,9 @@ void GCTracer::PrintNVP() const {
                    "reduce_memory=%d "
                    "scavenge=%.2f "
                    "old_new=%.2f "
+                   "old_new_tasks=%d "
+                   "old_new_tasks_took=%.2f "
+                   "old_new_longest_task=%.2f "
                    "weak=%.2f "
                    "roots=%.2f "
                    "code=%.2f "
@@ -508,6 +539,8 @@ void GCTracer::PrintNVP() const {
                    current_.reduce_memory,
                    current_.scopes[Scope::SCAVENGER_SCAVENGE],
                    current_.scopes[Scope::SCAVENGER_OLD_TO_NEW_POINTERS],
+                   current_.scavenge_tasks, current_.scavenge_tasks_duration,
+                   current_.longest_scavenge_task,
                    current_.scopes[Scope::SCAVENGER_WEAK],
                    current_.scopes[Scope::SCAVENGER_ROOTS],
                    current_.scopes[Scope::SCAVENGER_CODE_FLUSH_CANDIDATES],
@@ -243,6 +243,15 @@ class GCTracer {
     // (value at start of event)
     double longest_incremental_marking_step;
 
+    // Number of tasks that processed the old-to-new remembered set in
+    // parallel during a scavenge.
+    int scavenge_tasks;
+
+    // Sum and maximum of the time individual parallel scavenge tasks spent
+    // processing pages.
+    double scavenge_tasks_duration;
+    double longest_scavenge_task;
+
     // Amounts of time spent in different scopes during GC.
     double scopes[Scope::NUMBER_OF_SCOPES];
   };
@@ -276,6 +285,9 @@ class GCTracer {
 
   void AddIncrementalMarkingFinalizationStep(double duration);
 
+  // Log the time spent by a single parallel scavenge task.
+  void AddScavengeTask(double duration);
+
   // Log time spent in marking.
   void AddMarkingTime(double duration) {
     cumulative_marking_duration_ += duration;
@@ -385,6 +397,10 @@ class GCTracer {
   // it can be included in later crash dumps.
   void PRINTF_FORMAT(2, 3) Output(const char* format, ...) const;
 
+  // Emits the heap size as trace counters in the v8.gc category.
+  void TraceHeapSizes(intptr_t object_size, intptr_t memory_size,
+                      intptr_t holes_size);
+
   void ClearMarkCompactStatistics() {
     cumulative_incremental_marking_steps_ = 0;
     cumulative_incremental_marking_bytes_ = 0;
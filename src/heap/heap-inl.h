@@ -401,22 +401,32 @@ bool Heap::ShouldBePromoted(Address old_address, int object_size) {
          (!page->ContainsLimit(age_mark) || old_address < age_mark);
 }
 
+void StoreBuffer::InsertEntry(Address slot) {
+  if (heap_->gc_state() != Heap::NOT_IN_GC) {
+    RememberedSet<OLD_TO_NEW>::Insert(Page::FromAnyPointerAddress(heap_, slot),
+                                      slot);
+    return;
+  }
+  *top_ = slot;
+  top_++;
+  // The limits of the buffers are aligned to the buffer size, see SetUp.
+  if ((reinterpret_cast<uintptr_t>(top_) & kStoreBufferMask) == 0) {
+    FlipStoreBuffers();
+  }
+}
+
 void Heap::RecordWrite(Object* object, int offset, Object* o) {
   if (!InNewSpace(o) || !object->IsHeapObject() || InNewSpace(object)) {
     return;
   }
-  RememberedSet<OLD_TO_NEW>::Insert(
-      Page::FromAddress(reinterpret_cast<Address>(object)),
-      HeapObject::cast(object)->address() + offset);
+  store_buffer()->InsertEntry(HeapObject::cast(object)->address() + offset);
 }
 
 void Heap::RecordFixedArrayElements(FixedArray* array, int offset, int length) {
   if (InNewSpace(array)) return;
-  Page* page = Page::FromAddress(reinterpret_cast<Address>(array));
   for (int i = 0; i < length; i++) {
     if (!InNewSpace(array->get(offset + i))) continue;
-    RememberedSet<OLD_TO_NEW>::Insert(
-        page,
+    store_buffer()->InsertEntry(
         reinterpret_cast<Address>(array->RawFieldOfElementAt(offset + i)));
   }
 }
@@ -631,13 +641,15 @@ int DescriptorLookupCache::Hash(Object* source, Name* name) {
       static_cast<uint32_t>(reinterpret_cast<uintptr_t>(source)) >>
       kPointerSizeLog2;
   uint32_t name_hash = name->hash_field();
-  return (source_hash ^ name_hash) % kLength;
+  return ((source_hash ^ name_hash) & (kSetCount - 1)) * kEntriesPerSet;
 }
 
 int DescriptorLookupCache::Lookup(Map* source, Name* name) {
   int index = Hash(source, name);
-  Key& key = keys_[index];
-  if ((key.source == source) && (key.name == name)) return results_[index];
+  for (int i = index; i < index + kEntriesPerSet; i++) {
+    Key& key = keys_[i];
+    if ((key.source == source) && (key.name == name)) return results_[i];
+  }
   return kAbsent;
 }
 
@@ -645,9 +657,15 @@ int DescriptorLookupCache::Lookup(Map* source, Name* name) {
 void DescriptorLookupCache::Update(Map* source, Name* name, int result) {
   DCHECK(result != kAbsent);
   int index = Hash(source, name);
-  Key& key = keys_[index];
-  key.source = source;
-  key.name = name;
+  Key& first = keys_[index];
+  if ((first.source != source) || (first.name != name)) {
+    // Demote the most recent entry of the set, dropping the older one.
+    STATIC_ASSERT(kEntriesPerSet == 2);
+    keys_[index + 1] = first;
+    results_[index + 1] = results_[index];
+    first.source = source;
+    first.name = name;
+  }
   results_[index] = result;
 }
 
@@ -685,6 +703,12 @@ int Heap::NextScriptId() {
   return last_id;
 }
 
+int Heap::NextTemplateSerialNumber() {
+  int next_serial_number = next_template_serial_number()->value() + 1;
+  set_next_template_serial_number(Smi::FromInt(next_serial_number));
+  return next_serial_number;
+}
+
 
 void Heap::SetArgumentsAdaptorDeoptPCOffset(int pc_offset) {
   DCHECK(arguments_adaptor_deopt_pc_offset() == Smi::FromInt(0));
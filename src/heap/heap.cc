@@ -27,6 +27,7 @@
 #include "src/heap/object-stats.h"
 #include "src/heap/objects-visiting-inl.h"
 #include "src/heap/objects-visiting.h"
+#include "src/heap/page-parallel-job.h"
 #include "src/heap/remembered-set.h"
 #include "src/heap/scavenge-job.h"
 #include "src/heap/scavenger-inl.h"
@@ -78,6 +79,7 @@ Heap::Heap()
       max_semi_space_size_(8 * (kPointerSize / 4) * MB),
       initial_semispace_size_(Page::kPageSize),
       max_old_generation_size_(700ul * (kPointerSize / 4) * MB),
+      initial_max_old_generation_size_(max_old_generation_size_),
       initial_old_generation_size_(max_old_generation_size_ /
                                    kInitalOldGenerationLimitFactor),
       old_generation_size_configured_(false),
@@ -158,6 +160,12 @@ Heap::Heap()
       current_gc_callback_flags_(GCCallbackFlags::kNoGCCallbackFlags),
       external_string_table_(this),
       gc_callbacks_depth_(0),
+      near_heap_limit_callback_(nullptr),
+      near_heap_limit_callback_data_(nullptr),
+      invoking_near_heap_limit_callback_(false),
+      context_heap_accounting_enabled_(false),
+      shared_live_heap_size_(0),
+      object_stats_enabled_(false),
       deserialization_complete_(false),
       strong_roots_list_(NULL),
       array_buffer_tracker_(NULL),
@@ -750,7 +758,11 @@ void Heap::GarbageCollectionEpilogue() {
   new_space_top_after_last_gc_ = new_space()->top();
   last_gc_time_ = MonotonicallyIncreasingTimeInMs();
 
-  ReduceNewSpaceSize();
+  if (FLAG_adaptive_new_space_sizing) {
+    AdaptNewSpaceCapacity();
+  } else {
+    ReduceNewSpaceSize();
+  }
 }
 
 
@@ -1044,6 +1056,13 @@ bool Heap::CollectGarbage(GarbageCollector collector, const char* gc_reason,
     isolate()->CountUsage(v8::Isolate::kForcedGC);
   }
 
+  // Give the embedder a chance to raise the limit or to free memory before
+  // allocations start failing.
+  if (collector == MARK_COMPACTOR &&
+      !CanExpandOldGeneration(new_space()->Capacity())) {
+    InvokeNearHeapLimitCallback();
+  }
+
   // Start incremental marking for the next cycle. The heap snapshot
   // generator needs incremental marking to stay off after it aborted.
   if (!ShouldAbortIncrementalMarking() && incremental_marking()->IsStopped() &&
@@ -1414,6 +1433,9 @@ void Heap::MarkCompact() {
   gc_state_ = MARK_COMPACT;
   LOG(isolate_, ResourceEvent("markcompact", "begin"));
 
+  // GC prologue callbacks may have recorded slots after the prologue.
+  store_buffer()->MoveEntriesToRememberedSet();
+
   uint64_t size_of_objects_before_gc = SizeOfObjects();
 
   mark_compact_collector()->Prepare();
@@ -1503,6 +1525,8 @@ static void VerifyNonPointerSpacePointers(Heap* heap) {
 
 
 void Heap::CheckNewSpaceExpansionCriteria() {
+  // The adaptive controller resizes the new space after the GC.
+  if (FLAG_adaptive_new_space_sizing) return;
   if (FLAG_experimental_new_space_growth_heuristic) {
     if (new_space_.TotalCapacity() < new_space_.MaximumCapacity() &&
         survived_last_scavenge_ * 100 / new_space_.TotalCapacity() >= 10) {
@@ -1600,6 +1624,86 @@ class ScavengeWeakObjectRetainer : public WeakObjectRetainer {
 };
 
 
+
+// Filters the old-to-new remembered set of a page and collects all slots that
+// still point into from space. The slot sets of different memory chunks are
+// independent, so several tasks can process them concurrently. Copying of
+// the referenced objects is left to the main thread.
+class OldToNewSlotsCollectionJobTraits {
+ public:
+  struct TaskData {
+    TaskData() : duration(0.0) {}
+    List<Address> slots;
+    double duration;
+  };
+
+  typedef int PerPageData;  // Unused.
+  typedef TaskData* PerTaskData;
+
+  static bool ProcessPageInParallel(Heap* heap, PerTaskData data,
+                                    MemoryChunk* chunk, PerPageData) {
+    double start = heap->MonotonicallyIncreasingTimeInMs();
+    RememberedSet<OLD_TO_NEW>::Iterate(chunk, [heap, data](Address addr) {
+      Object* object = *reinterpret_cast<Object**>(addr);
+      if (heap->InFromSpace(object)) {
+        data->slots.Add(addr);
+        return KEEP_SLOT;
+      }
+      DCHECK(!heap->InNewSpace(object));
+      return REMOVE_SLOT;
+    });
+    data->duration += heap->MonotonicallyIncreasingTimeInMs() - start;
+    return true;
+  }
+
+  static const bool NeedSequentialFinalization = false;
+  static void FinalizePageSequentially(Heap*, MemoryChunk*, bool, PerPageData) {
+  }
+};
+
+static const int kMaxOldToNewSlotsCollectionTasks = 8;
+
+static int NumberOfOldToNewSlotsCollectionTasks(int pages) {
+  const int kPagesPerTask = 4;
+  return Min(kMaxOldToNewSlotsCollectionTasks,
+             (pages + kPagesPerTask - 1) / kPagesPerTask);
+}
+
+// Scavenges all objects referenced from the old-to-new remembered set. The
+// remembered set is filtered in parallel, the collected slots are then
+// processed on the main thread. Slots that do not point into to space after
+// scavenging are removed from the remembered set.
+static void ScavengeOldToNewPointersInParallel(Heap* heap) {
+  PageParallelJob<OldToNewSlotsCollectionJobTraits> job(
+      heap, heap->isolate()->cancelable_task_manager());
+  RememberedSet<OLD_TO_NEW>::IterateMemoryChunks(
+      heap, [&job](MemoryChunk* chunk) { job.AddPage(chunk, 0); });
+  OldToNewSlotsCollectionJobTraits::TaskData
+      task_data[kMaxOldToNewSlotsCollectionTasks];
+  int num_tasks = NumberOfOldToNewSlotsCollectionTasks(job.NumberOfPages());
+  if (num_tasks > 0) {
+    job.Run(num_tasks, [&task_data](int i) { return &task_data[i]; });
+  }
+  for (int i = 0; i < job.NumberOfTasks(); i++) {
+    heap->tracer()->AddScavengeTask(task_data[i].duration);
+    List<Address>& slots = task_data[i].slots;
+    for (int j = 0; j < slots.length(); j++) {
+      Address addr = slots[j];
+      Object** slot = reinterpret_cast<Object**>(addr);
+      Object* object = *slot;
+      if (heap->InFromSpace(object)) {
+        Scavenger::ScavengeObject(reinterpret_cast<HeapObject**>(slot),
+                                  reinterpret_cast<HeapObject*>(object));
+        object = *slot;
+      }
+      if (!heap->InToSpace(object)) {
+        Page* page = Page::FromAnyPointerAddress(heap, addr);
+        RememberedSet<OLD_TO_NEW>::Remove(page, addr);
+      }
+    }
+  }
+}
+
 void Heap::Scavenge() {
   TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_SCAVENGE);
   RelocationLock relocation_lock(this);
@@ -1621,6 +1725,9 @@ void Heap::Scavenge() {
   // Implements Cheney's copying algorithm
   LOG(isolate_, ResourceEvent("scavenge", "begin"));
 
+  // GC prologue callbacks may have recorded slots after the prologue.
+  store_buffer()->MoveEntriesToRememberedSet();
+
   // Used for updating survived_since_last_expansion_ at function end.
   intptr_t survived_watermark = PromotedSpaceSizeOfObjects();
 
@@ -1669,8 +1776,12 @@ void Heap::Scavenge() {
   {
     // Copy objects reachable from the old generation.
     TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_OLD_TO_NEW_POINTERS);
-    RememberedSet<OLD_TO_NEW>::IterateWithWrapper(this,
-                                                  Scavenger::ScavengeObject);
+    if (FLAG_parallel_scavenge) {
+      ScavengeOldToNewPointersInParallel(this);
+    } else {
+      RememberedSet<OLD_TO_NEW>::IterateWithWrapper(this,
+                                                    Scavenger::ScavengeObject);
+    }
   }
 
   {
@@ -2854,6 +2965,11 @@ void Heap::CreateInitialObjects() {
 
   set_noscript_shared_function_infos(Smi::FromInt(0));
 
+  // Handling of template serial numbers is in
+  // Heap::NextTemplateSerialNumber().
+  set_next_template_serial_number(Smi::FromInt(0));
+  set_serialized_templates(empty_fixed_array());
+
   // Initialize keyed lookup cache.
   isolate_->keyed_lookup_cache()->Clear();
 
@@ -2885,6 +3001,7 @@ bool Heap::RootCanBeWrittenAfterInitialization(Heap::RootListIndex root_index) {
     case kRetainedMapsRootIndex:
     case kNoScriptSharedFunctionInfosRootIndex:
     case kWeakStackTraceListRootIndex:
+    case kSerializedTemplatesRootIndex:
 // Smi values
 #define SMI_ENTRY(type, name, Name) case k##Name##RootIndex:
       SMI_ROOT_LIST(SMI_ENTRY)
@@ -2911,7 +3028,7 @@ int Heap::FullSizeNumberStringCacheLength() {
   // size to ensure that it is bigger after being made 'full size'.
   int number_string_cache_size = max_semi_space_size_ / 512;
   number_string_cache_size = Max(kInitialNumberStringCacheSize * 2,
-                                 Min(0x4000, number_string_cache_size));
+                                 Min(0x8000, number_string_cache_size));
   // There is a string and a number per entry so the length is twice the number
   // of entries.
   return number_string_cache_size * 2;
@@ -3026,6 +3143,9 @@ AllocationResult Heap::AllocateBytecodeArray(int length,
   instance->set_frame_size(frame_size);
   instance->set_parameter_count(parameter_count);
   instance->set_interrupt_budget(interpreter::Interpreter::InterruptBudget());
+  instance->set_osr_loop_nesting_level(0);
+  instance->set_bytecode_age(BytecodeArray::kNoAgeBytecodeAge);
+  instance->set_omits_expression_positions(false);
   instance->set_constant_pool(constant_pool);
   instance->set_handler_table(empty_fixed_array());
   instance->set_source_position_table(empty_byte_array());
@@ -3204,9 +3324,9 @@ void Heap::RightTrimFixedArray(FixedArrayBase* object, int elements_to_trim) {
   // Technically in new space this write might be omitted (except for
   // debug mode which iterates through the heap), but to play safer
   // we still do it.
-  // We do not create a filler for objects in large object space.
-  // TODO(hpayer): We should shrink the large object page if the size
-  // of the object changed significantly.
+  // We do not create a filler for objects in large object space. The large
+  // object page is shrunk in the next full GC, see
+  // LargeObjectSpace::FreeUnmarkedObjects.
   if (!lo_space()->Contains(object)) {
     CreateFillerObjectAt(new_end, bytes_to_trim, ClearRecordedSlots::kYes);
   }
@@ -3377,6 +3497,10 @@ AllocationResult Heap::CopyBytecodeArray(BytecodeArray* bytecode_array) {
   copy->set_handler_table(bytecode_array->handler_table());
   copy->set_source_position_table(bytecode_array->source_position_table());
   copy->set_interrupt_budget(bytecode_array->interrupt_budget());
+  copy->set_osr_loop_nesting_level(bytecode_array->osr_loop_nesting_level());
+  copy->set_bytecode_age(bytecode_array->bytecode_age());
+  copy->set_omits_expression_positions(
+      bytecode_array->omits_expression_positions());
   bytecode_array->CopyBytecodesTo(copy);
   return copy;
 }
@@ -4171,6 +4295,60 @@ void Heap::ReduceNewSpaceSize() {
   }
 }
 
+void Heap::AdaptNewSpaceCapacity() {
+  if (FLAG_predictable) return;
+
+  if (ShouldReduceMemory()) {
+    new_space_.Shrink();
+    UncommitFromSpace();
+    return;
+  }
+
+  const double allocation_throughput =
+      tracer()->NewSpaceAllocationThroughputInBytesPerMillisecond();
+  const double scavenge_speed =
+      tracer()->ScavengeSpeedInBytesPerMillisecond(kForSurvivedObjects);
+  // Wait until the tracer has seen enough events.
+  if (allocation_throughput == 0 || scavenge_speed == 0) return;
+
+  // A scavenge takes survived / speed milliseconds and the mutator fills the
+  // semispace in capacity / throughput milliseconds. Solve for the capacity
+  // that yields the target mutator utilization.
+  const double kUtilization = kTargetYoungGenerationMutatorUtilization;
+  double desired_capacity = static_cast<double>(survived_last_scavenge_) *
+                            allocation_throughput / scavenge_speed *
+                            kUtilization / (1 - kUtilization);
+  desired_capacity = Min(desired_capacity,
+                         static_cast<double>(new_space_.MaximumCapacity()));
+  const int current_capacity = static_cast<int>(new_space_.TotalCapacity());
+  const int new_capacity = static_cast<int>(desired_capacity);
+
+  if (new_capacity > current_capacity) {
+    // With a high survival rate objects are promoted anyway and larger
+    // semispaces only increase the amount of copying.
+    if (tracer()->AverageSurvivalRatio() >= kYoungSurvivalRateHighThreshold) {
+      return;
+    }
+    new_space_.GrowTo(new_capacity);
+  } else if (new_capacity < current_capacity / 2) {
+    // Shrink lazily to avoid oscillating between sizes.
+    new_space_.ShrinkTo(new_capacity);
+    UncommitFromSpace();
+  } else {
+    return;
+  }
+
+  if (FLAG_trace_gc_verbose) {
+    PrintIsolate(isolate_,
+                 "Adaptive new space sizing: survived %" V8PRIdPTR
+                 " KB, allocation throughput %.1f KB/ms, scavenge speed "
+                 "%.1f KB/ms, capacity %d KB -> %" V8PRIdPTR " KB\n",
+                 survived_last_scavenge_ / KB, allocation_throughput / KB,
+                 scavenge_speed / KB, current_capacity / KB,
+                 new_space_.TotalCapacity() / KB);
+  }
+}
+
 
 void Heap::FinalizeIncrementalMarkingIfComplete(const char* comment) {
   if (incremental_marking()->IsMarking() &&
@@ -4383,6 +4561,93 @@ bool Heap::IdleNotification(double deadline_in_seconds) {
 }
 
 
+bool Heap::IdleNotificationBudget(double deadline_in_ms, int* performed_work) {
+  CHECK(HasBeenSetUp());
+  HistogramTimerScope idle_notification_scope(
+      isolate_->counters()->gc_idle_notification());
+  TRACE_EVENT0("v8", "V8.GCIdleNotification");
+  double start_ms = MonotonicallyIncreasingTimeInMs();
+  int work = kNoIdleWork;
+
+  tracer()->SampleAllocation(start_ms, NewSpaceAllocationCounter(),
+                             OldGenerationAllocationCounter());
+
+  // Unlike IdleNotification, which relies on the scavenge idle task, the
+  // embedder may not provide idle tasks. Scavenge first if the new space is
+  // close to full and the scavenge fits into the budget.
+  double scavenge_speed_in_bytes_per_ms =
+      tracer()->ScavengeSpeedInBytesPerMillisecond();
+  size_t new_space_size = new_space()->Size();
+  if (ScavengeJob::ReachedIdleAllocationLimit(scavenge_speed_in_bytes_per_ms,
+                                              new_space_size,
+                                              new_space()->Capacity()) &&
+      ScavengeJob::EnoughIdleTimeForScavenge(deadline_in_ms - start_ms,
+                                             scavenge_speed_in_bytes_per_ms,
+                                             new_space_size)) {
+    CollectGarbage(NEW_SPACE, "idle notification: scavenge");
+    work |= kIdleScavenge;
+  }
+
+  GCIdleTimeHeapState heap_state = ComputeHeapState();
+  GCIdleTimeAction action = gc_idle_time_handler_->Compute(
+      deadline_in_ms - MonotonicallyIncreasingTimeInMs(), heap_state);
+
+  bool result = false;
+  switch (action.type) {
+    case DONE:
+      result = true;
+      break;
+    case DO_INCREMENTAL_STEP: {
+      // Mirrors IncrementalMarkingJob::IdleTask::Step but keeps track of the
+      // individual phases.
+      incremental_marking()
+          ->incremental_marking_job()
+          ->NotifyIdleTaskProgress();
+      if (incremental_marking()->IsSweeping()) {
+        incremental_marking()->FinalizeSweeping();
+        work |= kIdleSweeping;
+      }
+      if (incremental_marking()->IsMarking() &&
+          MonotonicallyIncreasingTimeInMs() < deadline_in_ms) {
+        double remaining_idle_time_in_ms =
+            incremental_marking()->AdvanceIncrementalMarking(
+                deadline_in_ms, IncrementalMarking::IdleStepActions());
+        work |= kIdleMarkingStep;
+        if (remaining_idle_time_in_ms > 0.0 &&
+            TryFinalizeIdleIncrementalMarking(remaining_idle_time_in_ms)) {
+          work |= kIdleMarkingFinalization;
+        }
+      }
+      result = incremental_marking()->IsStopped();
+      break;
+    }
+    case DO_FULL_GC: {
+      DCHECK(contexts_disposed_ > 0);
+      HistogramTimerScope scope(isolate_->counters()->gc_context());
+      TRACE_EVENT0("v8", "V8.GCContext");
+      CollectAllGarbage(kNoGCFlags, "idle notification: contexts disposed");
+      work |= kIdleFullGC;
+      break;
+    }
+    case DO_NOTHING:
+      break;
+  }
+
+  // Sweeper tasks may have finished in the background; picking up their
+  // results is cheap and frees the main thread from doing it on allocation.
+  if (mark_compact_collector()->sweeping_in_progress() &&
+      mark_compact_collector()->sweeper().IsSweepingCompleted() &&
+      MonotonicallyIncreasingTimeInMs() < deadline_in_ms) {
+    mark_compact_collector()->EnsureSweepingCompleted();
+    work |= kIdleSweeping;
+  }
+
+  IdleNotificationEpilogue(action, heap_state, start_ms, deadline_in_ms);
+  *performed_work = work;
+  return result;
+}
+
+
 bool Heap::RecentIdleNotificationHappened() {
   return (last_idle_notification_time_ +
           GCIdleTimeHandler::kMaxScheduledIdleTime) >
@@ -4408,6 +4673,9 @@ void Heap::CheckMemoryPressure() {
   if (memory_pressure_level_.Value() == MemoryPressureLevel::kCritical) {
     CollectGarbageOnMemoryPressure("memory pressure");
   } else if (memory_pressure_level_.Value() == MemoryPressureLevel::kModerate) {
+    // Cached compilation results are cheap to recreate, drop them so that
+    // the next mark-compact can reclaim the code they retain.
+    isolate()->compilation_cache()->Clear();
     if (FLAG_incremental_marking && incremental_marking()->IsStopped()) {
       StartIdleIncrementalMarking();
     }
@@ -4419,8 +4687,33 @@ void Heap::CheckMemoryPressure() {
 }
 
 void Heap::CollectGarbageOnMemoryPressure(const char* source) {
+  intptr_t committed_before = CommittedMemory();
+  intptr_t size_before = SizeOfObjects();
+  size_t pool_before = isolate()->allocator()->GetCurrentPoolSize();
+  // Everything that can be recreated on demand is released before the GC so
+  // that the objects it retains die. The remaining lookup caches (number
+  // strings, keyed lookups, descriptors, regexp results, stubs) are flushed
+  // by every mark-compact.
+  if (isolate()->concurrent_recompilation_enabled()) {
+    DisallowHeapAllocation no_recursive_gc;
+    isolate()->optimizing_compile_dispatcher()->Flush();
+  }
+  isolate()->ClearSerializerData();
+  isolate()->compilation_cache()->Clear();
   CollectAllGarbage(kReduceMemoryFootprintMask | kAbortIncrementalMarkingMask,
                     source);
+  new_space_.Shrink();
+  UncommitFromSpace();
+  isolate()->allocator()->ReleasePool();
+  if (FLAG_trace_memory_pressure) {
+    PrintIsolate(isolate(),
+                 "Memory pressure: objects %" V8PRIdPTR " KB -> %" V8PRIdPTR
+                 " KB, committed %" V8PRIdPTR " KB -> %" V8PRIdPTR
+                 " KB, released %" PRIuS " KB of zone segments\n",
+                 size_before / KB, SizeOfObjects() / KB,
+                 committed_before / KB, CommittedMemory() / KB,
+                 pool_before / KB);
+  }
 }
 
 void Heap::MemoryPressureNotification(MemoryPressureLevel level,
@@ -4921,6 +5214,8 @@ bool Heap::ConfigureHeap(int max_semi_space_size, int max_old_space_size,
     max_executable_size_ = max_old_generation_size_;
   }
 
+  initial_max_old_generation_size_ = max_old_generation_size_;
+
   if (FLAG_initial_old_space_size > 0) {
     initial_old_generation_size_ = FLAG_initial_old_space_size * MB;
   } else {
@@ -4942,6 +5237,57 @@ bool Heap::ConfigureHeap(int max_semi_space_size, int max_old_space_size,
 }
 
 
+void Heap::SetMaxOldGenerationSize(intptr_t max_old_generation_size,
+                                   intptr_t max_executable_size) {
+  if (max_old_generation_size > 0) {
+    int paged_space_count = LAST_PAGED_SPACE - FIRST_PAGED_SPACE + 1;
+    max_old_generation_size_ =
+        Max(static_cast<intptr_t>(paged_space_count * Page::kPageSize),
+            ROUND_UP(max_old_generation_size, Page::kPageSize));
+    // Make the next GC happen before the new limit is hit.
+    old_generation_allocation_limit_ =
+        Min(old_generation_allocation_limit_, max_old_generation_size_);
+  }
+  if (max_executable_size > 0) {
+    max_executable_size_ = ROUND_UP(max_executable_size, Page::kPageSize);
+  }
+  if (max_executable_size_ > max_old_generation_size_) {
+    max_executable_size_ = max_old_generation_size_;
+  }
+  if (FLAG_trace_gc_verbose) {
+    PrintIsolate(isolate_,
+                 "Heap limits changed: max old generation size %" V8PRIdPTR
+                 " KB, max executable size %" V8PRIdPTR " KB\n",
+                 max_old_generation_size_ / KB, max_executable_size_ / KB);
+  }
+}
+
+
+bool Heap::InvokeNearHeapLimitCallback() {
+  if (near_heap_limit_callback_ == nullptr ||
+      invoking_near_heap_limit_callback_) {
+    return false;
+  }
+  invoking_near_heap_limit_callback_ = true;
+  size_t heap_limit;
+  {
+    AllowHeapAllocation allow_allocation;
+    VMState<EXTERNAL> state(isolate_);
+    HandleScope handle_scope(isolate_);
+    heap_limit = near_heap_limit_callback_(
+        near_heap_limit_callback_data_,
+        static_cast<size_t>(max_old_generation_size_),
+        static_cast<size_t>(initial_max_old_generation_size_));
+  }
+  invoking_near_heap_limit_callback_ = false;
+  if (heap_limit > static_cast<size_t>(max_old_generation_size_)) {
+    SetMaxOldGenerationSize(static_cast<intptr_t>(heap_limit), 0);
+    return true;
+  }
+  return false;
+}
+
+
 void Heap::AddToRingBuffer(const char* string) {
   size_t first_part =
       Min(strlen(string), kTraceRingBufferSize - ring_buffer_end_);
@@ -5031,6 +5377,7 @@ const double Heap::kMaxHeapGrowingFactor = 4.0;
 const double Heap::kMaxHeapGrowingFactorMemoryConstrained = 2.0;
 const double Heap::kMaxHeapGrowingFactorIdle = 1.5;
 const double Heap::kTargetMutatorUtilization = 0.97;
+const double Heap::kTargetYoungGenerationMutatorUtilization = 0.95;
 
 
 // Given GC speed in bytes per ms, the allocation throughput in bytes per ms
@@ -5286,6 +5633,7 @@ bool Heap::SetUp() {
 
   object_stats_ = new ObjectStats(this);
   object_stats_->ClearObjectStats(true);
+  object_stats_enabled_ = FLAG_track_gc_object_stats;
 
   scavenge_job_ = new ScavengeJob();
 
@@ -5321,6 +5669,10 @@ bool Heap::CreateHeapObjects() {
   return true;
 }
 
+void Heap::SetSerializedTemplates(FixedArray* templates) {
+  DCHECK(isolate_->serializer_enabled());
+  set_serialized_templates(templates);
+}
 
 void Heap::SetStackLimits() {
   DCHECK(isolate_ != NULL);
@@ -5349,14 +5701,15 @@ void Heap::PrintAlloctionsHash() {
 
 void Heap::NotifyDeserializationComplete() {
   deserialization_complete_ = true;
-#ifdef DEBUG
-  // All pages right after bootstrapping must be marked as never-evacuate.
   PagedSpaces spaces(this);
   for (PagedSpace* s = spaces.next(); s != NULL; s = spaces.next()) {
+#ifdef DEBUG
+    // All pages right after bootstrapping must be marked as never-evacuate.
     PageIterator it(s);
     while (it.has_next()) CHECK(it.next()->NeverEvacuate());
-  }
 #endif  // DEBUG
+    s->ShrinkImmortalImmovablePages();
+  }
 }
 
 void Heap::SetEmbedderHeapTracer(EmbedderHeapTracer* tracer) {
@@ -5389,6 +5742,8 @@ void Heap::TearDown() {
     PrintF("gc_count=%d ", gc_count_);
     PrintF("mark_sweep_count=%d ", ms_count_);
     PrintF("max_gc_pause=%.1f ", get_max_gc_pause());
+    PrintF("gc_pause_p50=%.1f ", GetGCPausePercentile(50));
+    PrintF("gc_pause_p99=%.1f ", GetGCPausePercentile(99));
     PrintF("total_gc_time=%.1f ", total_gc_time_ms_);
     PrintF("min_in_mutator=%.1f ", get_min_in_mutator());
     PrintF("max_alive_after_gc=%" V8PRIdPTR " ", get_max_alive_after_gc());
@@ -5930,6 +6285,86 @@ HeapObject* HeapIterator::NextObject() {
 }
 
 
+IncrementalHeapIterator::IncrementalHeapIterator(Heap* heap, Visitor* visitor)
+    : heap_(heap),
+      visitor_(visitor),
+      gc_count_(heap->gc_count()),
+      visit_new_space_(true),
+      visit_large_objects_(true),
+      new_space_skipped_(false),
+      object_iterator_(nullptr) {
+  PagedSpaces spaces(heap);
+  for (PagedSpace* space = spaces.next(); space != NULL;
+       space = spaces.next()) {
+    PageIterator it(space);
+    while (it.has_next()) pending_pages_.Add(it.next());
+  }
+}
+
+
+IncrementalHeapIterator::~IncrementalHeapIterator() {
+  delete object_iterator_;
+}
+
+
+IncrementalHeapIterator::StepResult IncrementalHeapIterator::Step(
+    double deadline_in_ms) {
+  if (heap_->gc_count() != gc_count_) {
+    delete object_iterator_;
+    object_iterator_ = nullptr;
+    return kAborted;
+  }
+  int visited_objects = 0;
+  while (object_iterator_ != nullptr || AdvanceIterator()) {
+    HeapObject* object = object_iterator_->next_object();
+    if (object == nullptr) {
+      delete object_iterator_;
+      object_iterator_ = nullptr;
+      continue;
+    }
+    visitor_->Visit(object);
+    if (++visited_objects % kObjectsBetweenDeadlineChecks == 0 &&
+        heap_->MonotonicallyIncreasingTimeInMs() >= deadline_in_ms) {
+      return kInProgress;
+    }
+  }
+  return IsDone() ? kDone : kInProgress;
+}
+
+
+bool IncrementalHeapIterator::AdvanceIterator() {
+  DCHECK_NULL(object_iterator_);
+  if (visit_new_space_) {
+    visit_new_space_ = false;
+    if (heap_->IsHeapIterable()) {
+      object_iterator_ = new SemiSpaceIterator(heap_->new_space());
+      return true;
+    }
+    new_space_skipped_ = true;
+  }
+  for (int i = 0; i < pending_pages_.length(); i++) {
+    Page* page = pending_pages_[i];
+    if (page->SweepingDone()) {
+      pending_pages_.Remove(i);
+      object_iterator_ = new HeapObjectIterator(page);
+      return true;
+    }
+  }
+  if (visit_large_objects_) {
+    visit_large_objects_ = false;
+    object_iterator_ = new LargeObjectIterator(heap_->lo_space());
+    return true;
+  }
+  return false;
+}
+
+
+bool IncrementalHeapIterator::IsDone() const {
+  return object_iterator_ == nullptr && !visit_new_space_ &&
+         !visit_large_objects_ && pending_pages_.is_empty();
+}
+
+
 #ifdef DEBUG
 
 Object* const PathTracer::kAnyGlobalObject = NULL;
@@ -6119,12 +6554,22 @@ void Heap::TracePathToGlobal() {
 #endif
 
 
+double Heap::GetGCPausePercentile(int percentile) {
+  DCHECK(0 <= percentile && percentile <= 100);
+  if (gc_pauses_.is_empty()) return 0;
+  gc_pauses_.Sort();
+  int index = (gc_pauses_.length() - 1) * percentile / 100;
+  return gc_pauses_[index];
+}
+
+
 void Heap::UpdateCumulativeGCStatistics(double duration,
                                         double spent_in_mutator,
                                         double marking_time) {
   if (FLAG_print_cumulative_gc_stat) {
     total_gc_time_ms_ += duration;
     max_gc_pause_ = Max(max_gc_pause_, duration);
+    gc_pauses_.Add(duration);
     max_alive_after_gc_ = Max(max_alive_after_gc_, SizeOfObjects());
     min_in_mutator_ = Min(min_in_mutator_, spent_in_mutator);
   } else if (FLAG_trace_gc_verbose) {
@@ -6316,6 +6761,13 @@ size_t Heap::ObjectSizeAtLastGC(size_t index) {
 }
 
 
+size_t Heap::ObjectCategorySizeAtLastGC(int category) {
+  DCHECK(category >= 0 && category < ObjectStats::CATEGORY_COUNT);
+  return object_stats_->category_size_last_gc(
+      static_cast<ObjectStats::Category>(category));
+}
+
+
 bool Heap::GetObjectTypeName(size_t index, const char** object_type,
                              const char** object_sub_type) {
   if (index >= ObjectStats::OBJECT_STATS_COUNT) return false;
@@ -193,13 +193,15 @@ using v8::MemoryPressureLevel;
   V(Object, noscript_shared_function_infos, NoScriptSharedFunctionInfos)       \
   V(Map, bytecode_array_map, BytecodeArrayMap)                                 \
   V(WeakCell, empty_weak_cell, EmptyWeakCell)                                  \
-  V(PropertyCell, species_protector, SpeciesProtector)
+  V(PropertyCell, species_protector, SpeciesProtector)                         \
+  V(FixedArray, serialized_templates, SerializedTemplates)
 
 // Entries in this list are limited to Smis and are not visited during GC.
 #define SMI_ROOT_LIST(V)                                                   \
   V(Smi, stack_limit, StackLimit)                                          \
   V(Smi, real_stack_limit, RealStackLimit)                                 \
   V(Smi, last_script_id, LastScriptId)                                     \
+  V(Smi, next_template_serial_number, NextTemplateSerialNumber)            \
   V(Smi, arguments_adaptor_deopt_pc_offset, ArgumentsAdaptorDeoptPCOffset) \
   V(Smi, construct_stub_deopt_pc_offset, ConstructStubDeoptPCOffset)       \
   V(Smi, getter_stub_deopt_pc_offset, GetterStubDeoptPCOffset)             \
@@ -533,6 +535,7 @@ class Heap {
   static const double kMaxHeapGrowingFactorMemoryConstrained;
   static const double kMaxHeapGrowingFactorIdle;
   static const double kTargetMutatorUtilization;
+  static const double kTargetYoungGenerationMutatorUtilization;
 
   static const int kNoGCFlags = 0;
   static const int kReduceMemoryFootprintMask = 1;
@@ -741,10 +744,25 @@ class Heap {
 
   void CreateApiObjects();
 
+  // Kinds of work reported by IdleNotificationBudget.
+  enum IdleWork {
+    kNoIdleWork = 0,
+    kIdleScavenge = 1 << 0,
+    kIdleMarkingStep = 1 << 1,
+    kIdleMarkingFinalization = 1 << 2,
+    kIdleSweeping = 1 << 3,
+    kIdleFullGC = 1 << 4
+  };
+
   // Implements the corresponding V8 API function.
   bool IdleNotification(double deadline_in_seconds);
   bool IdleNotification(int idle_time_in_ms);
 
+  // Performs idle work that fits before deadline_in_ms and stores a mask of
+  // IdleWork values in |performed_work|. Returns true if there is no more
+  // idle work to do.
+  bool IdleNotificationBudget(double deadline_in_ms, int* performed_work);
+
   void MemoryPressureNotification(MemoryPressureLevel level,
                                   bool is_isolate_locked);
   void CheckMemoryPressure();
@@ -787,6 +805,7 @@ class Heap {
   inline uint32_t HashSeed();
 
   inline int NextScriptId();
+  inline int NextTemplateSerialNumber();
 
   inline void SetArgumentsAdaptorDeoptPCOffset(int pc_offset);
   inline void SetConstructStubDeoptPCOffset(int pc_offset);
@@ -987,6 +1006,10 @@ class Heap {
     roots_[kNoScriptSharedFunctionInfosRootIndex] = value;
   }
 
+  // Sets the templates that SnapshotCreator::AddTemplate() collected, so that
+  // they become part of the startup snapshot.
+  void SetSerializedTemplates(FixedArray* templates);
+
   // Set the stack limit in the roots_ array.  Some architectures generate
   // code that looks here, because it is faster than loading from the static
   // jslimit_/real_jslimit_ variable in the StackGuard.
@@ -1159,6 +1182,8 @@ class Heap {
   // instance types.
   size_t ObjectCountAtLastGC(size_t index);
   size_t ObjectSizeAtLastGC(size_t index);
+  // Returns the size of an ObjectStats::Category at the last major GC.
+  size_t ObjectCategorySizeAtLastGC(int category);
 
   // Retrieves names of buckets used by object statistics tracking.
   bool GetObjectTypeName(size_t index, const char** object_type,
@@ -1175,6 +1200,41 @@ class Heap {
   int MaxSemiSpaceSize() { return max_semi_space_size_; }
   int InitialSemiSpaceSize() { return initial_semispace_size_; }
   intptr_t MaxOldGenerationSize() { return max_old_generation_size_; }
+  intptr_t InitialMaxOldGenerationSize() {
+    return initial_max_old_generation_size_;
+  }
+
+  // Adjusts the limits configured by ConfigureHeap at runtime. Zero values
+  // keep the respective limit.
+  void SetMaxOldGenerationSize(intptr_t max_old_generation_size,
+                               intptr_t max_executable_size);
+
+  void SetNearHeapLimitCallback(v8::NearHeapLimitCallback callback,
+                                void* data) {
+    near_heap_limit_callback_ = callback;
+    near_heap_limit_callback_data_ = data;
+  }
+
+  // Invokes the near heap limit callback and applies the returned limit.
+  // Returns true if the limit was raised.
+  bool InvokeNearHeapLimitCallback();
+
+  bool context_heap_accounting_enabled() const {
+    return context_heap_accounting_enabled_;
+  }
+  void set_context_heap_accounting_enabled(bool enabled) {
+    context_heap_accounting_enabled_ = enabled;
+  }
+
+  bool object_stats_enabled() const { return object_stats_enabled_; }
+  void set_object_stats_enabled(bool enabled) {
+    object_stats_enabled_ = enabled;
+  }
+
+  size_t shared_live_heap_size() const { return shared_live_heap_size_; }
+  void set_shared_live_heap_size(size_t size) {
+    shared_live_heap_size_ = size;
+  }
   intptr_t MaxExecutableSize() { return max_executable_size_; }
 
   // Returns the capacity of the heap in bytes w/o growing. Heap grows when
@@ -1616,6 +1676,12 @@ class Heap {
 
   void ReduceNewSpaceSize();
 
+  // Resizes the semispaces so that the time spent in scavenges relative to
+  // the mutator time matches kTargetYoungGenerationMutatorUtilization, given
+  // the observed allocation throughput, scavenge speed, and the amount of
+  // memory that survived the last scavenge.
+  void AdaptNewSpaceCapacity();
+
   bool TryFinalizeIdleIncrementalMarking(
       double idle_time_in_ms, size_t size_of_objects,
       size_t mark_compact_speed_in_bytes_per_ms);
@@ -1708,6 +1774,9 @@ class Heap {
   // Returns maximum GC pause.
   double get_max_gc_pause() { return max_gc_pause_; }
 
+  // Returns the GC pause below which |percentile| percent of the pauses lie.
+  double GetGCPausePercentile(int percentile);
+
   // Returns maximum size of objects alive after GC.
   intptr_t get_max_alive_after_gc() { return max_alive_after_gc_; }
 
@@ -1989,6 +2058,8 @@ class Heap {
   int max_semi_space_size_;
   int initial_semispace_size_;
   intptr_t max_old_generation_size_;
+  // The max old generation size after ConfigureHeap.
+  intptr_t initial_max_old_generation_size_;
   intptr_t initial_old_generation_size_;
   bool old_generation_size_configured_;
   intptr_t max_executable_size_;
@@ -2116,6 +2187,9 @@ class Heap {
   // Maximum GC pause.
   double max_gc_pause_;
 
+  // All GC pauses, recorded with --print-cumulative-gc-stat.
+  List<double> gc_pauses_;
+
   // Total time spent in GC.
   double total_gc_time_ms_;
 
@@ -2213,6 +2287,20 @@ class Heap {
 
   int gc_callbacks_depth_;
 
+  v8::NearHeapLimitCallback near_heap_limit_callback_;
+  void* near_heap_limit_callback_data_;
+  bool invoking_near_heap_limit_callback_;
+
+  // If enabled, mark-compact attributes live bytes to native contexts.
+  bool context_heap_accounting_enabled_;
+  // Live bytes not attributed to any native context by the last mark-compact
+  // with context heap accounting enabled.
+  size_t shared_live_heap_size_;
+
+  // If enabled, mark-compact records the statistics of live objects in
+  // object_stats_. Initialized from --track-gc-object-stats.
+  bool object_stats_enabled_;
+
   bool deserialization_complete_;
 
   StrongRootsList* strong_roots_list_;
@@ -2236,7 +2324,6 @@ class Heap {
   friend class MarkCompactCollector;
   friend class MarkCompactMarkingVisitor;
   friend class NewSpace;
-  friend class ObjectStatsVisitor;
   friend class Page;
   friend class Scavenger;
   friend class StoreBuffer;
@@ -2420,6 +2507,60 @@ class HeapIterator BASE_EMBEDDED {
 };
 
 
+// An IncrementalHeapIterator walks the heap without forcing a GC. Pages of
+// the paged spaces are visited one by one as soon as the concurrent sweeper
+// is done with them; the main thread never sweeps or waits on behalf of the
+// walk. Step() returns once the deadline has passed, so a walk can be spread
+// over several idle tasks, and JavaScript may run between two steps.
+//
+// Objects allocated after the walk started may or may not be visited. Any GC
+// between two steps invalidates the walk: Step() then returns kAborted and a
+// new iterator has to be created. New space is only visited if it is
+// iterable without a GC at the time it is reached, see Heap::IsHeapIterable.
+class IncrementalHeapIterator {
+ public:
+  enum StepResult { kInProgress, kDone, kAborted };
+
+  class Visitor {
+   public:
+    virtual ~Visitor() {}
+    virtual void Visit(HeapObject* object) = 0;
+  };
+
+  IncrementalHeapIterator(Heap* heap, Visitor* visitor);
+  ~IncrementalHeapIterator();
+
+  // Visits objects until |deadline_in_ms| (in terms of
+  // Heap::MonotonicallyIncreasingTimeInMs) has passed, the walk is complete,
+  // or only pages that are still being swept are left.
+  StepResult Step(double deadline_in_ms);
+
+  bool new_space_skipped() const { return new_space_skipped_; }
+
+ private:
+  static const int kObjectsBetweenDeadlineChecks = 128;
+
+  // Sets up |object_iterator_| for the next iterable part of the heap.
+  // Returns false if no such part is available right now.
+  bool AdvanceIterator();
+
+  bool IsDone() const;
+
+  Heap* heap_;
+  Visitor* visitor_;
+  int gc_count_;
+  bool visit_new_space_;
+  bool visit_large_objects_;
+  bool new_space_skipped_;
+  // Pages of the old, code, and map space that have not been visited yet.
+  List<Page*> pending_pages_;
+  // Object iterator for the part of the heap currently being visited.
+  ObjectIterator* object_iterator_;
+
+  DISALLOW_COPY_AND_ASSIGN(IncrementalHeapIterator);
+};
+
+
 // Cache for mapping (map, property name) into field offset.
 // Cleared at startup and prior to mark sweep collection.
 class KeyedLookupCache {
@@ -2433,7 +2574,7 @@ class KeyedLookupCache {
   // Clear the cache.
   void Clear();
 
-  static const int kLength = 256;
+  static const int kLength = 1024;
   static const int kCapacityMask = kLength - 1;
   static const int kMapHashShift = 5;
   static const int kHashMask = -4;  // Zero the last two bits.
@@ -2483,6 +2624,9 @@ class KeyedLookupCache {
 // Cache for mapping (map, property name) into descriptor index.
 // The cache contains both positive and negative results.
 // Descriptor index equals kNotFound means the property is absent.
+// The cache is two-way set associative: a set holds the most recently
+// updated entry first, so two keys hashing to the same set do not evict
+// each other.
 // Cleared at startup and prior to any gc.
 class DescriptorLookupCache {
  public:
@@ -2507,9 +2651,14 @@ class DescriptorLookupCache {
     }
   }
 
+  // Returns the index of the first entry of the set for (source, name).
   static inline int Hash(Object* source, Name* name);
 
-  static const int kLength = 64;
+  static const int kLength = 256;
+  static const int kEntriesPerSet = 2;
+  static const int kSetCount = kLength / kEntriesPerSet;
+  STATIC_ASSERT((kSetCount & (kSetCount - 1)) == 0);
+
   struct Key {
     Map* source;
     Name* name;
@@ -543,6 +543,10 @@ void IncrementalMarking::StartMarking() {
 
   ActivateIncrementalWriteBarrier();
 
+  if (FLAG_incremental_marking_wrappers && heap_->UsingEmbedderHeapTracer()) {
+    heap_->mark_compact_collector()->StartEmbedderTracing();
+  }
+
 // Marking bits are cleared by the sweeper.
 #ifdef VERIFY_HEAP
   if (FLAG_verify_heap) {
@@ -593,6 +597,20 @@ void IncrementalMarking::MarkRoots() {
 }
 
 
+bool IncrementalMarking::TraceWrappers() {
+  MarkCompactCollector* collector = heap_->mark_compact_collector();
+  if (!collector->UsingEmbedderHeapTracer() ||
+      !collector->embedder_tracing_in_progress()) {
+    return false;
+  }
+  collector->RegisterWrappersWithEmbedderHeapTracer();
+  double deadline =
+      heap_->MonotonicallyIncreasingTimeInMs() + kWrapperTracingStepInMs;
+  return collector->embedder_heap_tracer()->AdvanceTracing(
+      deadline, EmbedderHeapTracer::AdvanceTracingActions(
+                    EmbedderHeapTracer::DO_NOT_FORCE_COMPLETION));
+}
+
 void IncrementalMarking::MarkObjectGroups() {
   DCHECK(!heap_->UsingEmbedderHeapTracer());
   DCHECK(!finalize_marking_completed_);
@@ -1158,6 +1176,9 @@ intptr_t IncrementalMarking::Step(intptr_t allocated_bytes,
     HistogramTimerScope incremental_marking_scope(
         heap_->isolate()->counters()->gc_incremental_marking());
     TRACE_EVENT0("v8", "V8.GCIncrementalMarking");
+    TRACE_EVENT1(TRACE_DISABLED_BY_DEFAULT("v8.gc"),
+                 "V8.GCIncrementalMarkingStep", "allocated_bytes",
+                 static_cast<int64_t>(allocated_bytes));
     double start = heap_->MonotonicallyIncreasingTimeInMs();
 
     // The marking speed is driven either by the allocation rate or by the rate
@@ -1183,7 +1204,10 @@ intptr_t IncrementalMarking::Step(intptr_t allocated_bytes,
 
     if (state_ == MARKING) {
       bytes_processed = ProcessMarkingDeque(bytes_to_process);
-      if (heap_->mark_compact_collector()->marking_deque()->IsEmpty()) {
+      // Objects that the embedder reaches are scanned by the next step.
+      bool wrapper_tracing_left = TraceWrappers();
+      if (heap_->mark_compact_collector()->marking_deque()->IsEmpty() &&
+          !wrapper_tracing_left) {
         if (completion == FORCE_COMPLETION ||
             IsIdleMarkingDelayCounterLimitReached()) {
           if (!finalize_marking_completed_) {
@@ -137,6 +137,9 @@ class IncrementalMarking {
   // incremental marking to be postponed.
   static const size_t kMaxIdleMarkingDelayCounter = 3;
 
+  // Time that a marking step lets the embedder trace its heap.
+  static const int kWrapperTracingStepInMs = 1;
+
   void FinalizeSweeping();
 
   void OldSpaceStep(intptr_t allocated);
@@ -244,6 +247,9 @@ class IncrementalMarking {
 
   void MarkRoots();
   void MarkObjectGroups();
+  // Hands found wrappers to the embedder heap tracer and lets it trace for a
+  // while. Returns true if the embedder has tracing work left.
+  bool TraceWrappers();
   void ProcessWeakCells();
   // Retain dying maps for <FLAG_retain_maps_for_n_gc> garbage collections to
   // increase chances of reusing of map transition tree in future.
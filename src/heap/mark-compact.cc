@@ -4,6 +4,7 @@
 
 #include "src/heap/mark-compact.h"
 
+#include "src/background-task-budget.h"
 #include "src/base/atomicops.h"
 #include "src/base/bits.h"
 #include "src/base/sys-info.h"
@@ -15,6 +16,7 @@
 #include "src/gdb-jit.h"
 #include "src/global-handles.h"
 #include "src/heap/array-buffer-tracker.h"
+#include "src/heap/concurrent-marking-deque.h"
 #include "src/heap/gc-tracer.h"
 #include "src/heap/incremental-marking.h"
 #include "src/heap/mark-compact-inl.h"
@@ -58,8 +60,11 @@ MarkCompactCollector::MarkCompactCollector(Heap* heap)
       heap_(heap),
       marking_deque_memory_(NULL),
       marking_deque_memory_committed_(0),
+      scanned_weak_collections_(Smi::FromInt(0)),
+      ephemerons_indexed_(false),
       code_flusher_(nullptr),
       embedder_heap_tracer_(nullptr),
+      embedder_tracing_in_progress_(false),
       have_code_to_deoptimize_(false),
       compacting_(false),
       sweeper_(heap) {
@@ -343,6 +348,14 @@ void MarkCompactCollector::CollectGarbage() {
 
   ClearNonLiveReferences();
 
+  if (heap()->context_heap_accounting_enabled()) {
+    AttributeLiveBytesToContexts();
+  }
+
+  if (heap()->object_stats_enabled()) {
+    RecordObjectStats();
+  }
+
 #ifdef VERIFY_HEAP
   if (FLAG_verify_heap) {
     VerifyMarking(heap_);
@@ -460,10 +473,11 @@ void MarkCompactCollector::ClearMarkbits() {
 class MarkCompactCollector::Sweeper::SweeperTask : public v8::Task {
  public:
   SweeperTask(Sweeper* sweeper, base::Semaphore* pending_sweeper_tasks,
-              AllocationSpace space_to_start)
+              AllocationSpace space_to_start, bool holds_budget_slot)
       : sweeper_(sweeper),
         pending_sweeper_tasks_(pending_sweeper_tasks),
-        space_to_start_(space_to_start) {}
+        space_to_start_(space_to_start),
+        holds_budget_slot_(holds_budget_slot) {}
 
   virtual ~SweeperTask() {}
 
@@ -480,12 +494,17 @@ class MarkCompactCollector::Sweeper::SweeperTask : public v8::Task {
       DCHECK_LE(space_id, LAST_PAGED_SPACE);
       sweeper_->ParallelSweepSpace(static_cast<AllocationSpace>(space_id), 0);
     }
+    if (holds_budget_slot_) {
+      sweeper_->heap_->isolate()->background_task_budget()->Release(
+          BackgroundTaskBudget::kGC, 1);
+    }
     pending_sweeper_tasks_->Signal();
   }
 
   Sweeper* sweeper_;
   base::Semaphore* pending_sweeper_tasks_;
   AllocationSpace space_to_start_;
+  bool holds_budget_slot_;
 
   DISALLOW_COPY_AND_ASSIGN(SweeperTask);
 };
@@ -497,18 +516,22 @@ void MarkCompactCollector::Sweeper::StartSweeping() {
               [](Page* a, Page* b) { return a->LiveBytes() < b->LiveBytes(); });
   });
   if (FLAG_concurrent_sweeping) {
-    ForAllSweepingSpaces([this](AllocationSpace space) {
+    BackgroundTaskBudget* budget = heap_->isolate()->background_task_budget();
+    ForAllSweepingSpaces([this, budget](AllocationSpace space) {
       if (space == NEW_SPACE) return;
-      StartSweepingHelper(space);
+      // Each task sweeps all spaces, so fewer tasks only lower parallelism.
+      if (budget->TryAcquire(BackgroundTaskBudget::kGC, 1) == 0) return;
+      StartSweepingHelper(space, true);
     });
   }
 }
 
 void MarkCompactCollector::Sweeper::StartSweepingHelper(
-    AllocationSpace space_to_start) {
+    AllocationSpace space_to_start, bool holds_budget_slot) {
   num_sweeping_tasks_++;
   V8::GetCurrentPlatform()->CallOnBackgroundThread(
-      new SweeperTask(this, &pending_sweeper_tasks_semaphore_, space_to_start),
+      new SweeperTask(this, &pending_sweeper_tasks_semaphore_, space_to_start,
+                      holds_budget_slot),
       v8::Platform::kShortRunningTask);
 }
 
@@ -852,6 +875,7 @@ void MarkCompactCollector::Prepare() {
   if (was_marked_incrementally_ && heap_->ShouldAbortIncrementalMarking()) {
     heap()->incremental_marking()->Stop();
     ClearMarkbits();
+    if (UsingEmbedderHeapTracer()) AbortEmbedderTracing();
     AbortWeakCollections();
     AbortWeakCells();
     AbortTransitionArrays();
@@ -884,8 +908,11 @@ void MarkCompactCollector::Finish() {
 
   if (sweeper().contains_late_pages() && FLAG_concurrent_sweeping) {
     // If we added some more pages during MC, we need to start at least one
-    // more task as all other tasks might already be finished.
-    sweeper().StartSweepingHelper(OLD_SPACE);
+    // more task as all other tasks might already be finished. The task is
+    // started even if the background task budget is exhausted.
+    sweeper().StartSweepingHelper(
+        OLD_SPACE, isolate()->background_task_budget()->TryAcquire(
+                       BackgroundTaskBudget::kGC, 1) == 1);
   }
 
   // The hashing of weak_object_to_code_table is no longer valid.
@@ -952,6 +979,41 @@ void MarkCompactCollector::Finish() {
 // and continue with marking.  This process repeats until all reachable
 // objects have been marked.
 
+// Returns true if the unoptimized code of |shared| was not marked live.
+// Interpreted functions share the entry trampoline, for them the mark of
+// the bytecode array is decisive.
+static bool IsUnmarkedUnoptimizedCode(SharedFunctionInfo* shared) {
+  HeapObject* code = shared->code();
+  if (shared->HasBytecodeArray()) code = shared->bytecode_array();
+  return Marking::IsWhite(Marking::MarkBitFrom(code));
+}
+
+
+// Drops the unoptimized code and bytecode of |shared| so that it is
+// lazily recompiled on its next invocation.
+static void FlushUnoptimizedCode(SharedFunctionInfo* shared,
+                                 Code* lazy_compile) {
+  if (FLAG_trace_code_flushing && shared->is_compiled()) {
+    PrintF("[code-flushing clears: ");
+    shared->ShortPrint();
+    if (shared->HasBytecodeArray()) {
+      PrintF(" - bytecode age: %d]\n",
+             shared->bytecode_array()->bytecode_age());
+    } else {
+      PrintF(" - age: %d]\n", shared->code()->GetAge());
+    }
+  }
+  // Always flush the optimized code map if there is one.
+  if (!shared->OptimizedCodeMapIsCleared()) {
+    shared->ClearOptimizedCodeMap();
+  }
+  if (shared->HasBytecodeArray()) {
+    shared->ClearBytecodeArray();
+  }
+  shared->set_code(lazy_compile);
+}
+
+
 void CodeFlusher::ProcessJSFunctionCandidates() {
   Code* lazy_compile = isolate_->builtins()->builtin(Builtins::kCompileLazy);
   Object* undefined = isolate_->heap()->undefined_value();
@@ -965,21 +1027,11 @@ void CodeFlusher::ProcessJSFunctionCandidates() {
     SharedFunctionInfo* shared = candidate->shared();
 
     Code* code = shared->code();
-    MarkBit code_mark = Marking::MarkBitFrom(code);
-    if (Marking::IsWhite(code_mark)) {
-      if (FLAG_trace_code_flushing && shared->is_compiled()) {
-        PrintF("[code-flushing clears: ");
-        shared->ShortPrint();
-        PrintF(" - age: %d]\n", code->GetAge());
-      }
-      // Always flush the optimized code map if there is one.
-      if (!shared->OptimizedCodeMapIsCleared()) {
-        shared->ClearOptimizedCodeMap();
-      }
-      shared->set_code(lazy_compile);
+    if (IsUnmarkedUnoptimizedCode(shared)) {
+      FlushUnoptimizedCode(shared, lazy_compile);
       candidate->set_code(lazy_compile);
     } else {
-      DCHECK(Marking::IsBlack(code_mark));
+      DCHECK(Marking::IsBlack(Marking::MarkBitFrom(code)));
       candidate->set_code(code);
     }
 
@@ -994,6 +1046,10 @@ void CodeFlusher::ProcessJSFunctionCandidates() {
         HeapObject::RawField(shared, SharedFunctionInfo::kCodeOffset);
     isolate_->heap()->mark_compact_collector()->RecordSlot(
         shared, shared_code_slot, *shared_code_slot);
+    Object** shared_data_slot =
+        HeapObject::RawField(shared, SharedFunctionInfo::kFunctionDataOffset);
+    isolate_->heap()->mark_compact_collector()->RecordSlot(
+        shared, shared_data_slot, *shared_data_slot);
 
     candidate = next_candidate;
   }
@@ -1011,25 +1067,18 @@ void CodeFlusher::ProcessSharedFunctionInfoCandidates() {
     next_candidate = GetNextCandidate(candidate);
     ClearNextCandidate(candidate);
 
-    Code* code = candidate->code();
-    MarkBit code_mark = Marking::MarkBitFrom(code);
-    if (Marking::IsWhite(code_mark)) {
-      if (FLAG_trace_code_flushing && candidate->is_compiled()) {
-        PrintF("[code-flushing clears: ");
-        candidate->ShortPrint();
-        PrintF(" - age: %d]\n", code->GetAge());
-      }
-      // Always flush the optimized code map if there is one.
-      if (!candidate->OptimizedCodeMapIsCleared()) {
-        candidate->ClearOptimizedCodeMap();
-      }
-      candidate->set_code(lazy_compile);
+    if (IsUnmarkedUnoptimizedCode(candidate)) {
+      FlushUnoptimizedCode(candidate, lazy_compile);
     }
 
     Object** code_slot =
         HeapObject::RawField(candidate, SharedFunctionInfo::kCodeOffset);
     isolate_->heap()->mark_compact_collector()->RecordSlot(candidate, code_slot,
                                                            *code_slot);
+    Object** data_slot = HeapObject::RawField(
+        candidate, SharedFunctionInfo::kFunctionDataOffset);
+    isolate_->heap()->mark_compact_collector()->RecordSlot(candidate, data_slot,
+                                                           *data_slot);
 
     candidate = next_candidate;
   }
@@ -1295,10 +1344,6 @@ void MarkCompactMarkingVisitor::Initialize() {
   StaticMarkingVisitor<MarkCompactMarkingVisitor>::Initialize();
 
   table_.Register(kVisitJSRegExp, &VisitRegExpAndFlushCode);
-
-  if (FLAG_track_gc_object_stats) {
-    ObjectStatsVisitor::Initialize(&table_);
-  }
 }
 
 
@@ -1332,6 +1377,10 @@ class SharedFunctionInfoMarkingVisitor : public ObjectVisitor {
       MarkBit shared_mark = Marking::MarkBitFrom(shared);
       MarkBit code_mark = Marking::MarkBitFrom(shared->code());
       collector_->MarkObject(shared->code(), code_mark);
+      if (shared->HasBytecodeArray()) {
+        BytecodeArray* bytecode = shared->bytecode_array();
+        collector_->MarkObject(bytecode, Marking::MarkBitFrom(bytecode));
+      }
       collector_->MarkObject(shared, shared_mark);
     }
   }
@@ -1357,6 +1406,11 @@ void MarkCompactCollector::PrepareThreadForCodeFlushing(Isolate* isolate,
       MarkBit optimized_code_mark = Marking::MarkBitFrom(optimized_code);
       MarkObject(optimized_code, optimized_code_mark);
     }
+    if (frame->is_interpreted()) {
+      BytecodeArray* bytecode =
+          reinterpret_cast<InterpretedFrame*>(frame)->GetBytecodeArray();
+      MarkObject(bytecode, Marking::MarkBitFrom(bytecode));
+    }
   }
 }
 
@@ -1890,6 +1944,93 @@ void MarkCompactCollector::DiscoverGreyObjectsInNewSpace() {
 }
 
 
+// Scans the mark bitmaps of pages for grey objects. The scan only reads mark
+// bits, so several tasks can process different pages in parallel. Discovered
+// objects are pushed onto a shared worklist and transferred to the marking
+// deque on the main thread.
+class GreyObjectsDiscoveryJobTraits {
+ public:
+  struct TaskData {
+    ConcurrentMarkingDeque* worklist;
+    int task_id;
+    // Number of objects all tasks discovered so far and the number of
+    // objects after which scanning stops.
+    AtomicNumber<intptr_t>* discovered;
+    intptr_t limit;
+  };
+
+  typedef int PerPageData;  // Unused.
+  typedef TaskData PerTaskData;
+
+  static bool ProcessPageInParallel(Heap* heap, PerTaskData data,
+                                    MemoryChunk* chunk, PerPageData) {
+    if (data.discovered->Value() >= data.limit) return true;
+    LiveObjectIterator<kGreyObjects> it(chunk);
+    HeapObject* object = nullptr;
+    intptr_t count = 0;
+    while ((object = it.Next()) != nullptr) {
+      data.worklist->Push(data.task_id, object);
+      count++;
+    }
+    data.discovered->Increment(count);
+    return true;
+  }
+
+  static const bool NeedSequentialFinalization = false;
+  static void FinalizePageSequentially(Heap*, MemoryChunk*, bool, PerPageData) {
+  }
+};
+
+int NumberOfParallelMarkingTasks(int pages) {
+  const int kPagesPerTask = 4;
+  return Min(ConcurrentMarkingDeque::kMaxNumTasks,
+             (pages + kPagesPerTask - 1) / kPagesPerTask);
+}
+
+void MarkCompactCollector::DiscoverGreyObjectsInParallel() {
+  DCHECK(!marking_deque()->IsFull());
+  PageParallelJob<GreyObjectsDiscoveryJobTraits> job(
+      heap(), isolate()->cancelable_task_manager());
+  NewSpace* new_space = heap()->new_space();
+  NewSpacePageIterator new_space_it(new_space->bottom(), new_space->top());
+  while (new_space_it.has_next()) {
+    job.AddPage(new_space_it.next(), 0);
+  }
+  PagedSpaces spaces(heap());
+  for (PagedSpace* space = spaces.next(); space != NULL;
+       space = spaces.next()) {
+    PageIterator it(space);
+    while (it.has_next()) {
+      Page* p = it.next();
+      if (!p->IsFlagSet(Page::BLACK_PAGE)) job.AddPage(p, 0);
+    }
+  }
+  int num_tasks = NumberOfParallelMarkingTasks(job.NumberOfPages());
+  if (num_tasks == 0) return;
+  ConcurrentMarkingDeque worklist(num_tasks);
+  AtomicNumber<intptr_t> discovered(0);
+  // There is no point in discovering more objects than the marking deque can
+  // hold. Remaining grey objects are found by the next refill.
+  intptr_t limit = marking_deque()->mask() -
+                   ((marking_deque()->top() - marking_deque()->bottom()) &
+                    marking_deque()->mask());
+  job.Run(num_tasks, [&worklist, &discovered, limit](int i) {
+    GreyObjectsDiscoveryJobTraits::TaskData data = {&worklist, i, &discovered,
+                                                    limit};
+    return data;
+  });
+  for (int i = 0; i < job.NumberOfTasks(); i++) {
+    HeapObject* object = nullptr;
+    while (!marking_deque()->IsFull() && worklist.Pop(i, &object)) {
+      MarkBit markbit = Marking::MarkBitFrom(object);
+      DCHECK(Marking::IsGrey(markbit));
+      Marking::GreyToBlack(markbit);
+      PushBlack(object);
+    }
+  }
+}
+
+
 bool MarkCompactCollector::IsUnmarkedHeapObject(Object** p) {
   Object* o = *p;
   if (!o->IsHeapObject()) return false;
@@ -1997,6 +2138,8 @@ void MarkCompactCollector::EmptyMarkingDeque() {
     MarkObject(map, map_mark);
 
     MarkCompactMarkingVisitor::IterateBody(map, object);
+
+    if (!ephemerons_by_key_.empty()) MarkEphemeronsOfKey(object);
   }
 }
 
@@ -2010,17 +2153,22 @@ void MarkCompactCollector::RefillMarkingDeque() {
   isolate()->CountUsage(v8::Isolate::UseCounterFeature::kMarkDequeOverflow);
   DCHECK(marking_deque_.overflowed());
 
-  DiscoverGreyObjectsInNewSpace();
-  if (marking_deque_.IsFull()) return;
+  if (FLAG_parallel_marking) {
+    DiscoverGreyObjectsInParallel();
+    if (marking_deque_.IsFull()) return;
+  } else {
+    DiscoverGreyObjectsInNewSpace();
+    if (marking_deque_.IsFull()) return;
 
-  DiscoverGreyObjectsInSpace(heap()->old_space());
-  if (marking_deque_.IsFull()) return;
+    DiscoverGreyObjectsInSpace(heap()->old_space());
+    if (marking_deque_.IsFull()) return;
 
-  DiscoverGreyObjectsInSpace(heap()->code_space());
-  if (marking_deque_.IsFull()) return;
+    DiscoverGreyObjectsInSpace(heap()->code_space());
+    if (marking_deque_.IsFull()) return;
 
-  DiscoverGreyObjectsInSpace(heap()->map_space());
-  if (marking_deque_.IsFull()) return;
+    DiscoverGreyObjectsInSpace(heap()->map_space());
+    if (marking_deque_.IsFull()) return;
+  }
 
   LargeObjectIterator lo_it(heap()->lo_space());
   DiscoverGreyObjectsWithIterator(&lo_it);
@@ -2048,10 +2196,13 @@ void MarkCompactCollector::ProcessEphemeralMarking(
     ObjectVisitor* visitor, bool only_process_harmony_weak_collections) {
   DCHECK(marking_deque_.IsEmpty() && !marking_deque_.overflowed());
   bool work_to_do = true;
+  int rounds = 0;
   while (work_to_do) {
     if (UsingEmbedderHeapTracer()) {
-      embedder_heap_tracer()->TraceWrappersFrom(wrappers_to_trace_);
-      wrappers_to_trace_.clear();
+      RegisterWrappersWithEmbedderHeapTracer();
+      embedder_heap_tracer()->AdvanceTracing(
+          0, EmbedderHeapTracer::AdvanceTracingActions(
+                 EmbedderHeapTracer::FORCE_COMPLETION));
     }
     if (!only_process_harmony_weak_collections) {
       isolate()->global_handles()->IterateObjectGroups(
@@ -2059,9 +2210,12 @@ void MarkCompactCollector::ProcessEphemeralMarking(
       MarkImplicitRefGroups(&MarkCompactMarkingVisitor::MarkObject);
     }
     ProcessWeakCollections();
+    if (++rounds == kEphemeronRoundsBeforeIndexing) IndexPendingEphemerons();
     work_to_do = !marking_deque_.IsEmpty();
     ProcessMarkingDeque();
   }
+  ephemerons_by_key_.clear();
+  ephemerons_indexed_ = false;
 }
 
 void MarkCompactCollector::ProcessTopOptimizedFrame(ObjectVisitor* visitor) {
@@ -2168,6 +2322,35 @@ void MarkCompactCollector::SetEmbedderHeapTracer(EmbedderHeapTracer* tracer) {
   embedder_heap_tracer_ = tracer;
 }
 
+void MarkCompactCollector::StartEmbedderTracing() {
+  DCHECK(UsingEmbedderHeapTracer());
+  if (embedder_tracing_in_progress_) return;
+  embedder_heap_tracer()->TracePrologue();
+  embedder_tracing_in_progress_ = true;
+}
+
+void MarkCompactCollector::AbortEmbedderTracing() {
+  DCHECK(UsingEmbedderHeapTracer());
+  wrappers_to_trace_.clear();
+  if (!embedder_tracing_in_progress_) return;
+  embedder_heap_tracer()->AbortTracing();
+  embedder_tracing_in_progress_ = false;
+}
+
+void MarkCompactCollector::FinishEmbedderTracing() {
+  DCHECK(embedder_tracing_in_progress_);
+  DCHECK(wrappers_to_trace_.empty());
+  embedder_heap_tracer()->TraceEpilogue();
+  embedder_tracing_in_progress_ = false;
+}
+
+void MarkCompactCollector::RegisterWrappersWithEmbedderHeapTracer() {
+  DCHECK(embedder_tracing_in_progress_);
+  if (wrappers_to_trace_.empty()) return;
+  embedder_heap_tracer()->RegisterV8References(wrappers_to_trace_);
+  wrappers_to_trace_.clear();
+}
+
 void MarkCompactCollector::TracePossibleWrapper(JSObject* js_object) {
   DCHECK(js_object->WasConstructedFromApiFunction());
   if (js_object->GetInternalFieldCount() >= 2 &&
@@ -2185,6 +2368,12 @@ void MarkCompactCollector::RegisterExternallyReferencedObject(Object** object) {
   DCHECK(in_use());
   HeapObject* heap_object = HeapObject::cast(*object);
   DCHECK(heap_->Contains(heap_object));
+  if (heap_->incremental_marking()->IsMarkingIncomplete()) {
+    // The embedder traces during incremental marking, the object is scanned
+    // by a later marking step.
+    IncrementalMarking::MarkObject(heap_, heap_object);
+    return;
+  }
   MarkBit mark_bit = Marking::MarkBitFrom(heap_object);
   MarkObject(heap_object, mark_bit);
 }
@@ -2245,7 +2434,8 @@ void MarkCompactCollector::MarkLiveObjects() {
       TRACE_GC(heap()->tracer(),
                GCTracer::Scope::MC_MARK_WEAK_CLOSURE_EPHEMERAL);
       if (UsingEmbedderHeapTracer()) {
-        embedder_heap_tracer()->TracePrologue();
+        StartEmbedderTracing();
+        embedder_heap_tracer()->EnterFinalPause();
         ProcessMarkingDeque();
       }
       ProcessEphemeralMarking(&root_visitor, false);
@@ -2283,7 +2473,7 @@ void MarkCompactCollector::MarkLiveObjects() {
       TRACE_GC(heap()->tracer(), GCTracer::Scope::MC_MARK_WEAK_CLOSURE_HARMONY);
       ProcessEphemeralMarking(&root_visitor, true);
       if (UsingEmbedderHeapTracer()) {
-        embedder_heap_tracer()->TraceEpilogue();
+        FinishEmbedderTracing();
       }
     }
   }
@@ -2292,14 +2482,126 @@ void MarkCompactCollector::MarkLiveObjects() {
     heap_->tracer()->AddMarkingTime(heap_->MonotonicallyIncreasingTimeInMs() -
                                     start_time);
   }
-  if (FLAG_track_gc_object_stats) {
-    if (FLAG_trace_gc_object_stats) {
-      heap()->object_stats_->TraceObjectStats();
+}
+
+
+namespace {
+
+// Returns the native context that owns |object| for the purpose of context
+// heap accounting, or nullptr if the object is shared between contexts.
+Context* OwnerNativeContext(HeapObject* object) {
+  Object* context = nullptr;
+  if (object->IsContext()) {
+    context = Context::cast(object)->native_context();
+  } else if (object->IsJSFunction()) {
+    context = JSFunction::cast(object)->context()->native_context();
+  } else if (object->IsJSObject()) {
+    Object* constructor = JSObject::cast(object)->map()->GetConstructor();
+    if (constructor->IsJSFunction()) {
+      context = JSFunction::cast(constructor)->context()->native_context();
+    }
+  }
+  if (context == nullptr || !context->IsNativeContext()) return nullptr;
+  return Context::cast(context);
+}
+
+class ContextLiveBytesCounter {
+ public:
+  ContextLiveBytesCounter() : shared_live_bytes_(0) {}
+
+  void Visit(HeapObject* object) {
+    Context* context = OwnerNativeContext(object);
+    if (context == nullptr) {
+      shared_live_bytes_ += object->Size();
+    } else {
+      live_bytes_[context] += object->Size();
+    }
+  }
+
+  size_t LiveBytes(Context* context) { return live_bytes_[context]; }
+  size_t shared_live_bytes() const { return shared_live_bytes_; }
+
+ private:
+  std::map<Context*, size_t> live_bytes_;
+  size_t shared_live_bytes_;
+};
+
+template <typename Visitor>
+void VisitLiveObjectsOnPage(MemoryChunk* chunk, Visitor* visitor) {
+  if (chunk->IsFlagSet(Page::BLACK_PAGE)) {
+    // All objects on black pages are live.
+    HeapObjectIterator it(static_cast<Page*>(chunk));
+    for (HeapObject* object = it.Next(); object != nullptr;
+         object = it.Next()) {
+      visitor->Visit(object);
+    }
+    return;
+  }
+  LiveObjectIterator<kBlackObjects> it(chunk);
+  HeapObject* object = nullptr;
+  while ((object = it.Next()) != nullptr) {
+    visitor->Visit(object);
+  }
+}
+
+// Passes every object marked by the last full marking to |visitor|.
+template <typename Visitor>
+void VisitAllLiveObjects(Heap* heap, Visitor* visitor) {
+  NewSpacePageIterator new_space_it(heap->new_space()->bottom(),
+                                    heap->new_space()->top());
+  while (new_space_it.has_next()) {
+    VisitLiveObjectsOnPage(new_space_it.next(), visitor);
+  }
+
+  PagedSpaces spaces(heap);
+  for (PagedSpace* space = spaces.next(); space != NULL;
+       space = spaces.next()) {
+    PageIterator it(space);
+    while (it.has_next()) {
+      VisitLiveObjectsOnPage(it.next(), visitor);
+    }
+  }
+
+  LargeObjectIterator lo_it(heap->lo_space());
+  for (HeapObject* object = lo_it.Next(); object != nullptr;
+       object = lo_it.Next()) {
+    if (Marking::IsBlack(Marking::MarkBitFrom(object))) {
+      visitor->Visit(object);
     }
-    heap()->object_stats_->CheckpointObjectStats();
   }
 }
 
+}  // namespace
+
+
+void MarkCompactCollector::AttributeLiveBytesToContexts() {
+  ContextLiveBytesCounter counter;
+  VisitAllLiveObjects(heap(), &counter);
+
+  // Weak references have been cleared, so only live contexts are left.
+  Object* list = heap()->native_contexts_list();
+  while (!list->IsUndefined()) {
+    Context* context = Context::cast(list);
+    size_t live_kilobytes = Min(counter.LiveBytes(context) / KB,
+                                static_cast<size_t>(Smi::kMaxValue));
+    context->set(Context::LIVE_HEAP_KILOBYTES_INDEX,
+                 Smi::FromInt(static_cast<int>(live_kilobytes)),
+                 SKIP_WRITE_BARRIER);
+    list = context->get(Context::NEXT_CONTEXT_LINK);
+  }
+  heap()->set_shared_live_heap_size(counter.shared_live_bytes());
+}
+
+
+void MarkCompactCollector::RecordObjectStats() {
+  ObjectStatsCollector collector(heap(), heap()->object_stats_);
+  VisitAllLiveObjects(heap(), &collector);
+  if (FLAG_trace_gc_object_stats) {
+    heap()->object_stats_->TraceObjectStats();
+  }
+  heap()->object_stats_->CheckpointObjectStats();
+}
+
 
 void MarkCompactCollector::ClearNonLiveReferences() {
   TRACE_GC(heap()->tracer(), GCTracer::Scope::MC_CLEAR);
@@ -2558,8 +2860,23 @@ void MarkCompactCollector::TrimEnumCache(Map* map,
 
 
 void MarkCompactCollector::ProcessWeakCollections() {
+  // Revisit the ephemerons whose keys were unmarked.
+  int pending = 0;
+  for (int i = 0; i < pending_ephemerons_.length(); i++) {
+    const Ephemeron& ephemeron = pending_ephemerons_[i];
+    HeapObject* key = HeapObject::cast(ephemeron.table->KeyAt(ephemeron.entry));
+    if (MarkCompactCollector::IsMarked(key)) {
+      MarkEphemeronValue(ephemeron);
+    } else {
+      pending_ephemerons_[pending++] = ephemeron;
+    }
+  }
+  pending_ephemerons_.Rewind(pending);
+
+  // Scan the weak collections encountered since the last call. New ones are
+  // added to the front of the list.
   Object* weak_collection_obj = heap()->encountered_weak_collections();
-  while (weak_collection_obj != Smi::FromInt(0)) {
+  while (weak_collection_obj != scanned_weak_collections_) {
     JSWeakCollection* weak_collection =
         reinterpret_cast<JSWeakCollection*>(weak_collection_obj);
     DCHECK(MarkCompactCollector::IsMarked(weak_collection));
@@ -2567,18 +2884,68 @@ void MarkCompactCollector::ProcessWeakCollections() {
       ObjectHashTable* table = ObjectHashTable::cast(weak_collection->table());
       for (int i = 0; i < table->Capacity(); i++) {
         if (MarkCompactCollector::IsMarked(HeapObject::cast(table->KeyAt(i)))) {
-          Object** key_slot =
-              table->RawFieldOfElementAt(ObjectHashTable::EntryToIndex(i));
-          RecordSlot(table, key_slot, *key_slot);
-          Object** value_slot =
-              table->RawFieldOfElementAt(ObjectHashTable::EntryToValueIndex(i));
-          MarkCompactMarkingVisitor::MarkObjectByPointer(this, table,
-                                                         value_slot);
+          MarkEphemeronValue({table, i});
+        } else {
+          AddPendingEphemeron(table, i);
         }
       }
     }
     weak_collection_obj = weak_collection->next();
   }
+  scanned_weak_collections_ = heap()->encountered_weak_collections();
+}
+
+
+void MarkCompactCollector::AddPendingEphemeron(ObjectHashTable* table,
+                                               int entry) {
+  Ephemeron ephemeron = {table, entry};
+  pending_ephemerons_.Add(ephemeron);
+  if (ephemerons_indexed_) {
+    HeapObject* key = HeapObject::cast(table->KeyAt(entry));
+    ephemerons_by_key_.insert(std::make_pair(key, ephemeron));
+  }
+}
+
+
+void MarkCompactCollector::MarkEphemeronValue(const Ephemeron& ephemeron) {
+  ObjectHashTable* table = ephemeron.table;
+  Object** key_slot = table->RawFieldOfElementAt(
+      ObjectHashTable::EntryToIndex(ephemeron.entry));
+  RecordSlot(table, key_slot, *key_slot);
+  Object** value_slot = table->RawFieldOfElementAt(
+      ObjectHashTable::EntryToValueIndex(ephemeron.entry));
+  MarkCompactMarkingVisitor::MarkObjectByPointer(this, table, value_slot);
+}
+
+
+void MarkCompactCollector::IndexPendingEphemerons() {
+  DCHECK(!ephemerons_indexed_);
+  ephemerons_indexed_ = true;
+  for (int i = 0; i < pending_ephemerons_.length(); i++) {
+    const Ephemeron& ephemeron = pending_ephemerons_[i];
+    HeapObject* key = HeapObject::cast(ephemeron.table->KeyAt(ephemeron.entry));
+    ephemerons_by_key_.insert(std::make_pair(key, ephemeron));
+  }
+}
+
+
+void MarkCompactCollector::MarkEphemeronsOfKey(HeapObject* key) {
+  auto range = ephemerons_by_key_.equal_range(key);
+  if (range.first == range.second) return;
+  // Objects can be marked without being pushed, so the pending list stays
+  // authoritative and is revisited by ProcessWeakCollections.
+  for (auto it = range.first; it != range.second; ++it) {
+    MarkEphemeronValue(it->second);
+  }
+  ephemerons_by_key_.erase(range.first, range.second);
+}
+
+
+void MarkCompactCollector::ClearPendingEphemerons() {
+  pending_ephemerons_.Clear();
+  scanned_weak_collections_ = Smi::FromInt(0);
+  ephemerons_by_key_.clear();
+  ephemerons_indexed_ = false;
 }
 
 
@@ -2602,6 +2969,7 @@ void MarkCompactCollector::ClearWeakCollections() {
     weak_collection->set_next(heap()->undefined_value());
   }
   heap()->set_encountered_weak_collections(Smi::FromInt(0));
+  ClearPendingEphemerons();
 }
 
 
@@ -2614,6 +2982,7 @@ void MarkCompactCollector::AbortWeakCollections() {
     weak_collection->set_next(heap()->undefined_value());
   }
   heap()->set_encountered_weak_collections(Smi::FromInt(0));
+  ClearPendingEphemerons();
 }
 
 
@@ -3211,17 +3580,15 @@ int MarkCompactCollector::NumberOfParallelCompactionTasks(int pages,
   //
   // The number of parallel compaction tasks is limited by:
   // - #evacuation pages
-  // - (#cores - 1)
+  // - the isolate's background task budget
   const double kTargetCompactionTimeInMs = 1;
-  const int kNumSweepingTasks = 3;
 
   double compaction_speed =
       heap()->tracer()->CompactionSpeedInBytesPerMillisecond();
 
-  const int available_cores = Max(
-      1, static_cast<int>(
-             V8::GetCurrentPlatform()->NumberOfAvailableBackgroundThreads()) -
-             kNumSweepingTasks - 1);
+  // The main thread runs one of the tasks.
+  const int available_cores =
+      1 + isolate()->background_task_budget()->limit();
   int tasks;
   if (compaction_speed > 0) {
     tasks = 1 + static_cast<int>(live_bytes / compaction_speed /
@@ -3322,13 +3689,13 @@ void MarkCompactCollector::EvacuatePagesInParallel() {
   if (FLAG_trace_evacuation) {
     PrintIsolate(isolate(),
                  "%8.0f ms: evacuation-summary: parallel=%s pages=%d "
-                 "aborted=%d wanted_tasks=%d tasks=%d cores=%" PRIuS
+                 "aborted=%d wanted_tasks=%d tasks=%d budget=%d"
                  " live_bytes=%" V8PRIdPTR " compaction_speed=%.f\n",
                  isolate()->time_millis_since_init(),
                  FLAG_parallel_compaction ? "yes" : "no", job.NumberOfPages(),
                  abandoned_pages, wanted_num_tasks, job.NumberOfTasks(),
-                 V8::GetCurrentPlatform()->NumberOfAvailableBackgroundThreads(),
-                 live_bytes, compaction_speed);
+                 isolate()->background_task_budget()->limit(), live_bytes,
+                 compaction_speed);
   }
 }
 
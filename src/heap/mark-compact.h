@@ -6,6 +6,7 @@
 #define V8_HEAP_MARK_COMPACT_H_
 
 #include <deque>
+#include <unordered_map>
 
 #include "src/base/bits.h"
 #include "src/heap/spaces.h"
@@ -437,7 +438,8 @@ class MarkCompactCollector {
     int ParallelSweepPage(Page* page, PagedSpace* space);
 
     void StartSweeping();
-    void StartSweepingHelper(AllocationSpace space_to_start);
+    void StartSweepingHelper(AllocationSpace space_to_start,
+                             bool holds_budget_slot);
     void EnsureCompleted();
     bool IsSweepingCompleted();
     void SweepOrWaitUntilSweepingCompleted(Page* page);
@@ -623,6 +625,17 @@ class MarkCompactCollector {
 
   bool UsingEmbedderHeapTracer() { return embedder_heap_tracer(); }
 
+  // Calls the embedder's TracePrologue unless tracing already started during
+  // incremental marking.
+  void StartEmbedderTracing();
+  // Drops the wrappers found so far and lets the embedder abort tracing.
+  void AbortEmbedderTracing();
+  void FinishEmbedderTracing();
+  bool embedder_tracing_in_progress() { return embedder_tracing_in_progress_; }
+
+  // Hands the wrappers found since the last call to the embedder.
+  void RegisterWrappersWithEmbedderHeapTracer();
+
   void TracePossibleWrapper(JSObject* js_object);
 
   void RegisterExternallyReferencedObject(Object** object);
@@ -756,6 +769,7 @@ class MarkCompactCollector {
   void DiscoverGreyObjectsOnPage(MemoryChunk* p);
   void DiscoverGreyObjectsInSpace(PagedSpace* space);
   void DiscoverGreyObjectsInNewSpace();
+  void DiscoverGreyObjectsInParallel();
 
   // Callback function for telling whether the object *p is an unmarked
   // heap object.
@@ -764,6 +778,14 @@ class MarkCompactCollector {
   // Clear non-live references in weak cells, transition and descriptor arrays,
   // and deoptimize dependent code of non-live maps.
   void ClearNonLiveReferences();
+
+  // Sums up the sizes of marked objects per owning native context and stores
+  // the result in the native contexts. Used for context heap accounting.
+  void AttributeLiveBytesToContexts();
+
+  // Records the statistics of all marked objects in the heap's ObjectStats.
+  // Used for heap object statistics.
+  void RecordObjectStats();
   void MarkDependentCodeForDeoptimization(DependentCode* list);
   // Find non-live targets of simple transitions in the given list. Clear
   // transitions to non-live targets and if needed trim descriptors arrays.
@@ -777,11 +799,32 @@ class MarkCompactCollector {
   void TrimDescriptorArray(Map* map, DescriptorArray* descriptors);
   void TrimEnumCache(Map* map, DescriptorArray* descriptors);
 
+  // An entry of an encountered weak collection whose key was not marked yet
+  // when the entry was last visited.
+  struct Ephemeron {
+    ObjectHashTable* table;
+    int entry;
+  };
+
+  // Marking ephemeron values one round at a time is quadratic for chains of
+  // keys only reachable through values. After this many rounds, marking a
+  // key marks the values of its ephemerons right away.
+  static const int kEphemeronRoundsBeforeIndexing = 2;
+
   // Mark all values associated with reachable keys in weak collections
   // encountered so far.  This might push new object or even new weak maps onto
-  // the marking stack.
+  // the marking stack. Only tables encountered since the last call are
+  // scanned in full, for the others only the pending ephemerons are visited.
   void ProcessWeakCollections();
 
+  void AddPendingEphemeron(ObjectHashTable* table, int entry);
+  void MarkEphemeronValue(const Ephemeron& ephemeron);
+  // Indexes the pending ephemerons by key, so that EmptyMarkingDeque can mark
+  // their values as soon as their keys are marked.
+  void IndexPendingEphemerons();
+  void MarkEphemeronsOfKey(HeapObject* key);
+  void ClearPendingEphemerons();
+
   // After all reachable objects have been marked those weak map entries
   // with an unreachable key are removed from all encountered weak maps.
   // The linked list of all encountered weak maps is destroyed.
@@ -855,9 +898,17 @@ class MarkCompactCollector {
   MarkingDeque marking_deque_;
   std::vector<std::pair<void*, void*>> wrappers_to_trace_;
 
+  // Ephemerons whose keys were unmarked when they were last visited, and the
+  // head of the encountered weak collections list when they were collected.
+  List<Ephemeron> pending_ephemerons_;
+  Object* scanned_weak_collections_;
+  bool ephemerons_indexed_;
+  std::unordered_multimap<HeapObject*, Ephemeron> ephemerons_by_key_;
+
   CodeFlusher* code_flusher_;
 
   EmbedderHeapTracer* embedder_heap_tracer_;
+  bool embedder_tracing_in_progress_;
 
   bool have_code_to_deoptimize_;
 
@@ -7,6 +7,7 @@
 #include "src/counters.h"
 #include "src/heap/heap-inl.h"
 #include "src/isolate.h"
+#include "src/type-feedback-vector-inl.h"
 #include "src/utils.h"
 
 namespace v8 {
@@ -21,10 +22,45 @@ void ObjectStats::ClearObjectStats(bool clear_last_time_stats) {
   if (clear_last_time_stats) {
     memset(object_counts_last_time_, 0, sizeof(object_counts_last_time_));
     memset(object_sizes_last_time_, 0, sizeof(object_sizes_last_time_));
+    memset(category_sizes_last_time_, 0, sizeof(category_sizes_last_time_));
   }
 }
 
 
+void ObjectStats::ComputeCategorySizes(size_t* sizes) {
+  const size_t* sub_types = object_sizes_ + FIRST_FIXED_ARRAY_SUB_TYPE;
+  size_t total = 0;
+  size_t strings = 0;
+  for (int type = 0; type <= LAST_TYPE; type++) {
+    total += object_sizes_[type];
+    if (type < FIRST_NONSTRING_TYPE) strings += object_sizes_[type];
+  }
+  sizes[STRING_CATEGORY] = strings + sub_types[STRING_TABLE_SUB_TYPE];
+  sizes[CODE_CATEGORY] =
+      object_sizes_[CODE_TYPE] + object_sizes_[BYTECODE_ARRAY_TYPE];
+  sizes[FEEDBACK_CATEGORY] = sub_types[TYPE_FEEDBACK_VECTOR_SUB_TYPE] +
+                             sub_types[TYPE_FEEDBACK_METADATA_SUB_TYPE] +
+                             object_sizes_[TYPE_FEEDBACK_INFO_TYPE] +
+                             object_sizes_[ALLOCATION_SITE_TYPE];
+  sizes[MAP_CATEGORY] = object_sizes_[MAP_TYPE] +
+                        sub_types[DESCRIPTOR_ARRAY_SUB_TYPE] +
+                        sub_types[MAP_CODE_CACHE_SUB_TYPE];
+  // The fixed arrays attributed to the categories above are not arrays.
+  size_t attributed = sub_types[STRING_TABLE_SUB_TYPE] +
+                      sub_types[TYPE_FEEDBACK_VECTOR_SUB_TYPE] +
+                      sub_types[TYPE_FEEDBACK_METADATA_SUB_TYPE] +
+                      sub_types[DESCRIPTOR_ARRAY_SUB_TYPE] +
+                      sub_types[MAP_CODE_CACHE_SUB_TYPE];
+  size_t fixed_arrays = object_sizes_[FIXED_ARRAY_TYPE];
+  sizes[ARRAY_CATEGORY] =
+      object_sizes_[JS_ARRAY_TYPE] + object_sizes_[FIXED_DOUBLE_ARRAY_TYPE] +
+      (fixed_arrays > attributed ? fixed_arrays - attributed : 0);
+  size_t categorized = 0;
+  for (int i = 0; i < OTHER_CATEGORY; i++) categorized += sizes[i];
+  sizes[OTHER_CATEGORY] = total > categorized ? total - categorized : 0;
+}
+
+
 void ObjectStats::TraceObjectStat(const char* name, int count, int size,
                                   double time) {
   int ms_count = heap()->ms_count();
@@ -126,6 +162,7 @@ void ObjectStats::CheckpointObjectStats() {
   CODE_AGE_LIST_COMPLETE(ADJUST_LAST_TIME_OBJECT_COUNT)
 #undef ADJUST_LAST_TIME_OBJECT_COUNT
 
+  ComputeCategorySizes(category_sizes_last_time_);
   MemCopy(object_counts_last_time_, object_counts_, sizeof(object_counts_));
   MemCopy(object_sizes_last_time_, object_sizes_, sizeof(object_sizes_));
   ClearObjectStats();
@@ -135,112 +172,77 @@ void ObjectStats::CheckpointObjectStats() {
 Isolate* ObjectStats::isolate() { return heap()->isolate(); }
 
 
-void ObjectStatsVisitor::CountFixedArray(
-    FixedArrayBase* fixed_array, FixedArraySubInstanceType fast_type,
-    FixedArraySubInstanceType dictionary_type) {
-  Heap* heap = fixed_array->map()->GetHeap();
-  if (fixed_array->map() != heap->fixed_cow_array_map() &&
-      fixed_array->map() != heap->fixed_double_array_map() &&
-      fixed_array != heap->empty_fixed_array()) {
-    if (fixed_array->IsDictionary()) {
-      heap->object_stats_->RecordFixedArraySubTypeStats(dictionary_type,
-                                                        fixed_array->Size());
-    } else {
-      heap->object_stats_->RecordFixedArraySubTypeStats(fast_type,
-                                                        fixed_array->Size());
-    }
-  }
-}
-
-
-void ObjectStatsVisitor::VisitBase(VisitorId id, Map* map, HeapObject* obj) {
-  Heap* heap = map->GetHeap();
-  int object_size = obj->Size();
-  heap->object_stats_->RecordObjectStats(map->instance_type(), object_size);
-  table_.GetVisitorById(id)(map, obj);
+void ObjectStatsCollector::Visit(HeapObject* obj) {
+  Map* map = obj->map();
+  stats_->RecordObjectStats(map->instance_type(), obj->SizeFromMap(map));
   if (obj->IsJSObject()) {
-    JSObject* object = JSObject::cast(obj);
-    CountFixedArray(object->elements(), DICTIONARY_ELEMENTS_SUB_TYPE,
-                    FAST_ELEMENTS_SUB_TYPE);
-    CountFixedArray(object->properties(), DICTIONARY_PROPERTIES_SUB_TYPE,
-                    FAST_PROPERTIES_SUB_TYPE);
+    RecordJSObjectDetails(JSObject::cast(obj));
+  } else if (obj->IsMap()) {
+    RecordMapDetails(Map::cast(obj));
+  } else if (obj->IsCode()) {
+    RecordCodeDetails(Code::cast(obj));
+  } else if (obj->IsSharedFunctionInfo()) {
+    RecordSharedFunctionInfoDetails(SharedFunctionInfo::cast(obj));
+  } else if (obj == heap_->string_table()) {
+    stats_->RecordFixedArraySubTypeStats(STRING_TABLE_SUB_TYPE, obj->Size());
   }
 }
 
 
-template <ObjectStatsVisitor::VisitorId id>
-void ObjectStatsVisitor::Visit(Map* map, HeapObject* obj) {
-  VisitBase(id, map, obj);
+void ObjectStatsCollector::RecordJSObjectDetails(JSObject* object) {
+  RecordFixedArrayDetails(object->elements(), FAST_ELEMENTS_SUB_TYPE,
+                          DICTIONARY_ELEMENTS_SUB_TYPE);
+  RecordFixedArrayDetails(object->properties(), FAST_PROPERTIES_SUB_TYPE,
+                          DICTIONARY_PROPERTIES_SUB_TYPE);
 }
 
 
-template <>
-void ObjectStatsVisitor::Visit<ObjectStatsVisitor::kVisitMap>(Map* map,
-                                                              HeapObject* obj) {
-  Heap* heap = map->GetHeap();
-  Map* map_obj = Map::cast(obj);
-  DCHECK(map->instance_type() == MAP_TYPE);
-  DescriptorArray* array = map_obj->instance_descriptors();
-  if (map_obj->owns_descriptors() && array != heap->empty_descriptor_array()) {
-    int fixed_array_size = array->Size();
-    heap->object_stats_->RecordFixedArraySubTypeStats(DESCRIPTOR_ARRAY_SUB_TYPE,
-                                                      fixed_array_size);
+void ObjectStatsCollector::RecordMapDetails(Map* map) {
+  DescriptorArray* array = map->instance_descriptors();
+  if (map->owns_descriptors() && array != heap_->empty_descriptor_array()) {
+    stats_->RecordFixedArraySubTypeStats(DESCRIPTOR_ARRAY_SUB_TYPE,
+                                         array->Size());
   }
-  if (map_obj->has_code_cache()) {
-    FixedArray* cache = FixedArray::cast(map_obj->code_cache());
-    heap->object_stats_->RecordFixedArraySubTypeStats(MAP_CODE_CACHE_SUB_TYPE,
-                                                      cache->Size());
+  if (map->has_code_cache()) {
+    stats_->RecordFixedArraySubTypeStats(
+        MAP_CODE_CACHE_SUB_TYPE, FixedArray::cast(map->code_cache())->Size());
   }
-  VisitBase(kVisitMap, map, obj);
 }
 
 
-template <>
-void ObjectStatsVisitor::Visit<ObjectStatsVisitor::kVisitCode>(
-    Map* map, HeapObject* obj) {
-  Heap* heap = map->GetHeap();
-  int object_size = obj->Size();
-  DCHECK(map->instance_type() == CODE_TYPE);
-  Code* code_obj = Code::cast(obj);
-  heap->object_stats_->RecordCodeSubTypeStats(code_obj->kind(),
-                                              code_obj->GetAge(), object_size);
-  VisitBase(kVisitCode, map, obj);
+void ObjectStatsCollector::RecordCodeDetails(Code* code) {
+  stats_->RecordCodeSubTypeStats(code->kind(), code->GetAge(), code->Size());
 }
 
 
-template <>
-void ObjectStatsVisitor::Visit<ObjectStatsVisitor::kVisitSharedFunctionInfo>(
-    Map* map, HeapObject* obj) {
-  Heap* heap = map->GetHeap();
-  SharedFunctionInfo* sfi = SharedFunctionInfo::cast(obj);
-  if (sfi->scope_info() != heap->empty_fixed_array()) {
-    heap->object_stats_->RecordFixedArraySubTypeStats(
+void ObjectStatsCollector::RecordSharedFunctionInfoDetails(
+    SharedFunctionInfo* sfi) {
+  if (sfi->scope_info() != heap_->empty_fixed_array()) {
+    stats_->RecordFixedArraySubTypeStats(
         SCOPE_INFO_SUB_TYPE, FixedArray::cast(sfi->scope_info())->Size());
   }
-  VisitBase(kVisitSharedFunctionInfo, map, obj);
-}
-
-
-template <>
-void ObjectStatsVisitor::Visit<ObjectStatsVisitor::kVisitFixedArray>(
-    Map* map, HeapObject* obj) {
-  Heap* heap = map->GetHeap();
-  FixedArray* fixed_array = FixedArray::cast(obj);
-  if (fixed_array == heap->string_table()) {
-    heap->object_stats_->RecordFixedArraySubTypeStats(STRING_TABLE_SUB_TYPE,
-                                                      fixed_array->Size());
+  TypeFeedbackVector* vector = sfi->feedback_vector();
+  if (vector->length() == 0) return;
+  stats_->RecordFixedArraySubTypeStats(TYPE_FEEDBACK_VECTOR_SUB_TYPE,
+                                       vector->Size());
+  TypeFeedbackMetadata* metadata = vector->metadata();
+  if (metadata != heap_->empty_fixed_array()) {
+    stats_->RecordFixedArraySubTypeStats(TYPE_FEEDBACK_METADATA_SUB_TYPE,
+                                         metadata->Size());
   }
-  VisitBase(kVisitFixedArray, map, obj);
 }
 
 
-void ObjectStatsVisitor::Initialize(VisitorDispatchTable<Callback>* original) {
-  // Copy the original visitor table to make call-through possible. After we
-  // preserved a copy locally, we patch the original table to call us.
-  table_.CopyFrom(original);
-#define COUNT_FUNCTION(id) original->Register(kVisit##id, Visit<kVisit##id>);
-  VISITOR_ID_LIST(COUNT_FUNCTION)
-#undef COUNT_FUNCTION
+void ObjectStatsCollector::RecordFixedArrayDetails(
+    FixedArrayBase* array, FixedArraySubInstanceType fast_type,
+    FixedArraySubInstanceType dictionary_type) {
+  if (array->map() == heap_->fixed_cow_array_map() ||
+      array->map() == heap_->fixed_double_array_map() ||
+      array == heap_->empty_fixed_array()) {
+    return;
+  }
+  stats_->RecordFixedArraySubTypeStats(
+      array->IsDictionary() ? dictionary_type : fast_type, array->Size());
 }
 
 }  // namespace internal
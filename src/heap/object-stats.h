@@ -6,7 +6,6 @@
 #define V8_HEAP_OBJECT_STATS_H_
 
 #include "src/heap/heap.h"
-#include "src/heap/objects-visiting.h"
 #include "src/objects.h"
 
 namespace v8 {
@@ -28,6 +27,18 @@ class ObjectStats {
     OBJECT_STATS_COUNT = FIRST_CODE_AGE_SUB_TYPE + Code::kCodeAgeCount + 1
   };
 
+  // Non-overlapping groups of the live heap, see
+  // v8::HeapCompositionStatistics.
+  enum Category {
+    STRING_CATEGORY,
+    CODE_CATEGORY,
+    FEEDBACK_CATEGORY,
+    MAP_CATEGORY,
+    ARRAY_CATEGORY,
+    OTHER_CATEGORY,
+    CATEGORY_COUNT
+  };
+
   void ClearObjectStats(bool clear_last_time_stats = false);
 
   void TraceObjectStats();
@@ -68,10 +79,16 @@ class ObjectStats {
     return object_sizes_last_time_[index];
   }
 
+  size_t category_size_last_gc(Category category) {
+    return category_sizes_last_time_[category];
+  }
+
   Isolate* isolate();
   Heap* heap() { return heap_; }
 
  private:
+  void ComputeCategorySizes(size_t* sizes);
+
   Heap* heap_;
 
   // Object counts and used memory by InstanceType
@@ -79,21 +96,31 @@ class ObjectStats {
   size_t object_counts_last_time_[OBJECT_STATS_COUNT];
   size_t object_sizes_[OBJECT_STATS_COUNT];
   size_t object_sizes_last_time_[OBJECT_STATS_COUNT];
+  size_t category_sizes_last_time_[CATEGORY_COUNT];
 };
 
 
-class ObjectStatsVisitor : public StaticMarkingVisitor<ObjectStatsVisitor> {
+// Records the statistics of the objects found live by a full marking. The
+// collector visits the marked objects once marking is complete, so objects
+// marked incrementally or allocated black are counted as well.
+class ObjectStatsCollector {
  public:
-  static void Initialize(VisitorDispatchTable<Callback>* original);
+  ObjectStatsCollector(Heap* heap, ObjectStats* stats)
+      : heap_(heap), stats_(stats) {}
 
-  static void VisitBase(VisitorId id, Map* map, HeapObject* obj);
+  void Visit(HeapObject* obj);
 
-  static void CountFixedArray(FixedArrayBase* fixed_array,
-                              FixedArraySubInstanceType fast_type,
-                              FixedArraySubInstanceType dictionary_type);
+ private:
+  void RecordJSObjectDetails(JSObject* object);
+  void RecordMapDetails(Map* map);
+  void RecordCodeDetails(Code* code);
+  void RecordSharedFunctionInfoDetails(SharedFunctionInfo* sfi);
+  void RecordFixedArrayDetails(FixedArrayBase* array,
+                               FixedArraySubInstanceType fast_type,
+                               FixedArraySubInstanceType dictionary_type);
 
-  template <VisitorId id>
-  static inline void Visit(Map* map, HeapObject* obj);
+  Heap* heap_;
+  ObjectStats* stats_;
 };
 
 }  // namespace internal
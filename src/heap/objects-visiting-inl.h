@@ -508,6 +508,9 @@ void StaticMarkingVisitor<StaticVisitor>::VisitJSFunction(Map* map,
     } else {
       // Visit all unoptimized code objects to prevent flushing them.
       StaticVisitor::MarkObject(heap, function->shared()->code());
+      if (function->shared()->HasBytecodeArray()) {
+        StaticVisitor::MarkObject(heap, function->shared()->bytecode_array());
+      }
     }
   }
   VisitJSFunctionStrongCode(map, object);
@@ -541,10 +544,14 @@ void StaticMarkingVisitor<StaticVisitor>::VisitJSArrayBuffer(
 template <typename StaticVisitor>
 void StaticMarkingVisitor<StaticVisitor>::VisitBytecodeArray(
     Map* map, HeapObject* object) {
+  Heap* heap = map->GetHeap();
   StaticVisitor::VisitPointers(
-      map->GetHeap(), object,
+      heap, object,
       HeapObject::RawField(object, BytecodeArray::kConstantPoolOffset),
       HeapObject::RawField(object, BytecodeArray::kFrameSizeOffset));
+  if (FLAG_age_code && !heap->isolate()->serializer_enabled()) {
+    BytecodeArray::cast(object)->MakeOlder();
+  }
 }
 
 
@@ -595,21 +602,25 @@ bool StaticMarkingVisitor<StaticVisitor>::IsFlushable(Heap* heap,
                                                       JSFunction* function) {
   SharedFunctionInfo* shared_info = function->shared();
 
-  // Code is either on stack, in compilation cache or referenced
-  // by optimized version of function.
-  MarkBit code_mark = Marking::MarkBitFrom(function->code());
-  if (Marking::IsBlackOrGrey(code_mark)) {
-    return false;
-  }
-
   // We do not (yet) flush code for optimized functions.
   if (function->code() != shared_info->code()) {
     return false;
   }
 
-  // Check age of optimized code.
-  if (FLAG_age_code && !function->code()->IsOld()) {
-    return false;
+  // Interpreted functions all share the entry trampoline, whether they
+  // are in use is decided by their bytecode below.
+  if (!shared_info->IsInterpreted()) {
+    // Code is either on stack, in compilation cache or referenced
+    // by optimized version of function.
+    MarkBit code_mark = Marking::MarkBitFrom(function->code());
+    if (Marking::IsBlackOrGrey(code_mark)) {
+      return false;
+    }
+
+    // Check age of optimized code.
+    if (FLAG_age_code && !function->code()->IsOld()) {
+      return false;
+    }
   }
 
   return IsFlushable(heap, shared_info);
@@ -619,11 +630,27 @@ bool StaticMarkingVisitor<StaticVisitor>::IsFlushable(Heap* heap,
 template <typename StaticVisitor>
 bool StaticMarkingVisitor<StaticVisitor>::IsFlushable(
     Heap* heap, SharedFunctionInfo* shared_info) {
-  // Code is either on stack, in compilation cache or referenced
-  // by optimized version of function.
-  MarkBit code_mark = Marking::MarkBitFrom(shared_info->code());
-  if (Marking::IsBlackOrGrey(code_mark)) {
-    return false;
+  if (shared_info->HasBytecodeArray()) {
+    // We do not flush functions with both bytecode and baseline code, the
+    // two would have to be kept alive together.
+    if (!shared_info->IsInterpreted()) {
+      return false;
+    }
+
+    // Bytecode is either on stack, in compilation cache or referenced
+    // by optimized version of function.
+    MarkBit bytecode_mark =
+        Marking::MarkBitFrom(shared_info->bytecode_array());
+    if (Marking::IsBlackOrGrey(bytecode_mark)) {
+      return false;
+    }
+  } else {
+    // Code is either on stack, in compilation cache or referenced
+    // by optimized version of function.
+    MarkBit code_mark = Marking::MarkBitFrom(shared_info->code());
+    if (Marking::IsBlackOrGrey(code_mark)) {
+      return false;
+    }
   }
 
   // The function must be compiled and have the source code available,
@@ -638,7 +665,8 @@ bool StaticMarkingVisitor<StaticVisitor>::IsFlushable(
   }
 
   // Only flush code for functions.
-  if (shared_info->code()->kind() != Code::FUNCTION) {
+  if (shared_info->code()->kind() != Code::FUNCTION &&
+      !shared_info->IsInterpreted()) {
     return false;
   }
 
@@ -664,7 +692,8 @@ bool StaticMarkingVisitor<StaticVisitor>::IsFlushable(
   }
 
   // Maintain debug break slots in the code.
-  if (shared_info->HasDebugCode()) {
+  if (shared_info->IsInterpreted() ? shared_info->HasDebugInfo()
+                                   : shared_info->HasDebugCode()) {
     return false;
   }
 
@@ -675,7 +704,11 @@ bool StaticMarkingVisitor<StaticVisitor>::IsFlushable(
   }
 
   // Check age of code. If code aging is disabled we never flush.
-  if (!FLAG_age_code || !shared_info->code()->IsOld()) {
+  if (!FLAG_age_code) {
+    return false;
+  }
+  if (shared_info->IsInterpreted() ? !shared_info->bytecode_array()->IsOld()
+                                   : !shared_info->code()->IsOld()) {
     return false;
   }
 
@@ -711,6 +744,14 @@ void StaticMarkingVisitor<StaticVisitor>::VisitSharedFunctionInfoWeakCode(
       HeapObject::RawField(object, SharedFunctionInfo::kOptimizedCodeMapOffset);
   Object** end_slot = HeapObject::RawField(
       object, SharedFunctionInfo::BodyDescriptor::kEndOffset);
+  if (SharedFunctionInfo::cast(object)->HasBytecodeArray()) {
+    // Skip visiting kFunctionDataOffset as the bytecode is treated weakly
+    // together with the code.
+    Object** data_slot =
+        HeapObject::RawField(object, SharedFunctionInfo::kFunctionDataOffset);
+    StaticVisitor::VisitPointers(heap, object, start_slot, data_slot);
+    start_slot = data_slot + 1;
+  }
   StaticVisitor::VisitPointers(heap, object, start_slot, end_slot);
 }
 
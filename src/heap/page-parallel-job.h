@@ -6,6 +6,7 @@
 #define V8_HEAP_PAGE_PARALLEL_JOB_
 
 #include "src/allocation.h"
+#include "src/background-task-budget.h"
 #include "src/cancelable-task.h"
 #include "src/utils.h"
 #include "src/v8.h"
@@ -38,8 +39,7 @@ class PageParallelJob {
         cancelable_task_manager_(cancelable_task_manager),
         items_(nullptr),
         num_items_(0),
-        num_tasks_(0),
-        pending_tasks_(new base::Semaphore(0)) {}
+        num_tasks_(0) {}
 
   ~PageParallelJob() {
     Item* item = items_;
@@ -48,7 +48,6 @@ class PageParallelJob {
       delete item;
       item = next;
     }
-    delete pending_tasks_;
   }
 
   void AddPage(MemoryChunk* chunk, typename JobTraits::PerPageData data) {
@@ -63,18 +62,21 @@ class PageParallelJob {
   int NumberOfTasks() { return num_tasks_; }
 
   // Runs the given number of tasks in parallel and processes the previously
-  // added pages. This function blocks until all tasks finish.
+  // added pages. This function blocks until all tasks finish. The number of
+  // background tasks is limited by the isolate's background task budget.
   // The callback takes the index of a task and returns data for that task.
   template <typename Callback>
   void Run(int num_tasks, Callback per_task_data_callback) {
     if (num_items_ == 0) return;
     DCHECK_GE(num_tasks, 1);
-    uint32_t task_ids[kMaxNumberOfTasks];
-    const int max_num_tasks = Min(
-        kMaxNumberOfTasks,
-        static_cast<int>(
-            V8::GetCurrentPlatform()->NumberOfAvailableBackgroundThreads()));
-    num_tasks_ = Max(1, Min(num_tasks, max_num_tasks));
+    // The tasks of one run form a group, which is canceled and waited for
+    // without touching the tasks of other jobs.
+    CancelableTaskManager group(cancelable_task_manager_);
+    BackgroundTaskBudget* budget = heap_->isolate()->background_task_budget();
+    // The first task runs on the main thread.
+    const int num_background_tasks = budget->TryAcquire(
+        BackgroundTaskBudget::kGC, Min(num_tasks, kMaxNumberOfTasks) - 1);
+    num_tasks_ = 1 + num_background_tasks;
     int items_per_task = (num_items_ + num_tasks_ - 1) / num_tasks_;
     int start_index = 0;
     Task* main_task = nullptr;
@@ -82,9 +84,8 @@ class PageParallelJob {
       if (start_index >= num_items_) {
         start_index -= num_items_;
       }
-      Task* task = new Task(heap_, items_, num_items_, start_index,
-                            pending_tasks_, per_task_data_callback(i));
-      task_ids[i] = task->id();
+      Task* task = new Task(heap_, &group, items_, num_items_, start_index,
+                            per_task_data_callback(i));
       if (i > 0) {
         V8::GetCurrentPlatform()->CallOnBackgroundThread(
             task, v8::Platform::kShortRunningTask);
@@ -95,12 +96,10 @@ class PageParallelJob {
     // Contribute on main thread.
     main_task->Run();
     delete main_task;
-    // Wait for background tasks.
-    for (int i = 0; i < num_tasks_; i++) {
-      if (!cancelable_task_manager_->TryAbort(task_ids[i])) {
-        pending_tasks_->Wait();
-      }
-    }
+    // Cancel the background tasks that have not started yet and wait for the
+    // others.
+    group.CancelAndWait();
+    budget->Release(BackgroundTaskBudget::kGC, num_background_tasks);
     if (JobTraits::NeedSequentialFinalization) {
       Item* item = items_;
       while (item != nullptr) {
@@ -128,14 +127,13 @@ class PageParallelJob {
 
   class Task : public CancelableTask {
    public:
-    Task(Heap* heap, Item* items, int num_items, int start_index,
-         base::Semaphore* on_finish, typename JobTraits::PerTaskData data)
-        : CancelableTask(heap->isolate()),
+    Task(Heap* heap, CancelableTaskManager* group, Item* items, int num_items,
+         int start_index, typename JobTraits::PerTaskData data)
+        : CancelableTask(heap->isolate(), group),
           heap_(heap),
           items_(items),
           num_items_(num_items),
           start_index_(start_index),
-          on_finish_(on_finish),
           data_(data) {}
 
     virtual ~Task() {}
@@ -161,14 +159,12 @@ class PageParallelJob {
           current = items_;
         }
       }
-      on_finish_->Signal();
     }
 
     Heap* heap_;
     Item* items_;
     int num_items_;
     int start_index_;
-    base::Semaphore* on_finish_;
     typename JobTraits::PerTaskData data_;
     DISALLOW_COPY_AND_ASSIGN(Task);
   };
@@ -178,7 +174,6 @@ class PageParallelJob {
   Item* items_;
   int num_items_;
   int num_tasks_;
-  base::Semaphore* pending_tasks_;
   DISALLOW_COPY_AND_ASSIGN(PageParallelJob);
 };
 
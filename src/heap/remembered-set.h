@@ -41,17 +41,25 @@ class RememberedSet {
     }
   }
 
-  // Given a page and a range of slots in that page, this function removes the
-  // slots from the remembered set.
-  static void RemoveRange(Page* page, Address start, Address end) {
-    SlotSet* slot_set = GetSlotSet(page);
+  // Given a chunk and a range of slots in that chunk, this function removes
+  // the slots from the remembered set. For large pages the range may span
+  // several slot sets.
+  static void RemoveRange(MemoryChunk* chunk, Address start, Address end) {
+    SlotSet* slot_set = GetSlotSet(chunk);
     if (slot_set != nullptr) {
-      uintptr_t start_offset = start - page->address();
-      uintptr_t end_offset = end - page->address();
+      uintptr_t start_offset = start - chunk->address();
+      uintptr_t end_offset = end - chunk->address();
       DCHECK_LT(start_offset, end_offset);
-      DCHECK_LE(end_offset, static_cast<uintptr_t>(Page::kPageSize));
-      slot_set->RemoveRange(static_cast<uint32_t>(start_offset),
-                            static_cast<uint32_t>(end_offset));
+      DCHECK_LE(end_offset, chunk->size());
+      const uintptr_t kPageSize = static_cast<uintptr_t>(Page::kPageSize);
+      while (start_offset < end_offset) {
+        uintptr_t index = start_offset / kPageSize;
+        uintptr_t region_end = Min((index + 1) * kPageSize, end_offset);
+        slot_set[index].RemoveRange(
+            static_cast<int>(start_offset - index * kPageSize),
+            static_cast<int>(region_end - index * kPageSize));
+        start_offset = region_end;
+      }
     }
   }
 
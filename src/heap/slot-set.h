@@ -232,6 +232,7 @@ enum SlotType {
 // encoded (slot type, slot offset) pairs.
 // There is no duplicate detection and we do not expect many duplicates because
 // typed slots contain V8 internal pointers that are not directly exposed to JS.
+// Chunks that no longer contain slots are released during iteration.
 class TypedSlotSet {
  public:
   typedef uint32_t TypedSlot;
@@ -275,23 +276,35 @@ class TypedSlotSet {
     STATIC_ASSERT(NUMBER_OF_SLOT_TYPES < 8);
     const TypedSlot kRemovedSlot = TypeField::encode(NUMBER_OF_SLOT_TYPES);
     Chunk* chunk = chunk_;
+    Chunk* previous = nullptr;
     int new_count = 0;
     while (chunk != nullptr) {
       TypedSlot* buffer = chunk->buffer;
       int count = chunk->count;
+      int in_chunk_count = 0;
       for (int i = 0; i < count; i++) {
         TypedSlot slot = buffer[i];
         if (slot != kRemovedSlot) {
           SlotType type = TypeField::decode(slot);
           Address addr = page_start_ + OffsetField::decode(slot);
           if (callback(type, addr) == KEEP_SLOT) {
-            new_count++;
+            in_chunk_count++;
           } else {
             buffer[i] = kRemovedSlot;
           }
         }
       }
-      chunk = chunk->next;
+      Chunk* next = chunk->next;
+      if (in_chunk_count == 0 && previous != nullptr) {
+        // Release chunks without live slots. The head chunk is kept because
+        // new slots are added to it.
+        previous->next = next;
+        delete chunk;
+      } else {
+        previous = chunk;
+      }
+      new_count += in_chunk_count;
+      chunk = next;
     }
     return new_count;
   }
@@ -8,6 +8,7 @@
 #include "src/base/platform/platform.h"
 #include "src/base/platform/semaphore.h"
 #include "src/full-codegen/full-codegen.h"
+#include "src/heap/remembered-set.h"
 #include "src/heap/slot-set.h"
 #include "src/macro-assembler.h"
 #include "src/msan.h"
@@ -150,7 +151,11 @@ bool CodeRange::SetUp(size_t requested) {
     }
     base += kReservedCodeRangePages * base::OS::CommitPageSize();
   }
-  Address aligned_base = RoundUp(base, MemoryChunk::kAlignment);
+  // Huge pages can only back the range if neighbouring chunks form
+  // naturally aligned huge pages.
+  Address aligned_base =
+      RoundUp(base, FLAG_code_range_huge_pages ? kHugePageSize
+                                               : MemoryChunk::kAlignment);
   size_t size = code_range_->size() - (aligned_base - base) -
                 kReservedCodeRangePages * base::OS::CommitPageSize();
   allocation_list_.Add(FreeBlock(aligned_base, size));
@@ -226,8 +231,18 @@ Address CodeRange::AllocateRawMemory(const size_t requested_size,
   *allocated = current.size;
   DCHECK(*allocated <= current.size);
   DCHECK(IsAddressAligned(current.start, MemoryChunk::kAlignment));
-  if (!isolate_->heap()->memory_allocator()->CommitExecutableMemory(
-          code_range_, current.start, commit_size, *allocated)) {
+  bool committed;
+  if (FLAG_code_range_huge_pages) {
+    // Commit the whole block, including the header and guard pages, as one
+    // executable mapping. The kernel can then merge neighbouring blocks into
+    // huge pages, which mappings with different protections would prevent.
+    committed = CommitRawMemory(current.start, *allocated);
+    if (committed) base::OS::AdviseHugePages(current.start, *allocated);
+  } else {
+    committed = isolate_->heap()->memory_allocator()->CommitExecutableMemory(
+        code_range_, current.start, commit_size, *allocated);
+  }
+  if (!committed) {
     *allocated = 0;
     ReleaseBlock(&current);
     return NULL;
@@ -404,10 +419,19 @@ bool MemoryAllocator::CommitMemory(Address base, size_t size,
     return false;
   }
   UpdateAllocatedSpaceLimits(base, base + size);
+  BindToCurrentNumaNode(base, size);
   return true;
 }
 
 
+void MemoryAllocator::BindToCurrentNumaNode(Address base, size_t size) {
+  if (!FLAG_numa_bind_heap_pages) return;
+  // The pages are not touched yet, so they are placed on the preferred node
+  // when they are first written to. Failing to bind is not an error.
+  base::OS::BindMemoryToNumaNode(base, size, base::OS::GetCurrentNumaNode());
+}
+
+
 void MemoryAllocator::FreeMemory(base::VirtualMemory* reservation,
                                  Executability executable) {
   // TODO(gc) make code_range part of memory allocator?
@@ -477,6 +501,7 @@ Address MemoryAllocator::AllocateAlignedMemory(
     return NULL;
   }
 
+  BindToCurrentNumaNode(base, commit_size);
   controller->TakeControl(&reservation);
   return base;
 }
@@ -759,6 +784,47 @@ void Page::ResetFreeListStatistics() {
   available_in_free_list_ = 0;
 }
 
+size_t Page::ShrinkToLastObject() {
+  // We do not shrink code pages, see MemoryAllocator::PartialFreeMemory.
+  if (executable() == EXECUTABLE) return 0;
+  if (!reserved_memory()->IsReserved()) return 0;
+  Address used_end = area_start();
+  HeapObjectIterator it(this);
+  for (HeapObject* object = it.Next(); object != NULL; object = it.Next()) {
+    used_end = object->address() + object->Size();
+  }
+  Address free_start =
+      address() + RoundUp(used_end - address(), base::OS::CommitPageSize());
+  if (free_start <= area_start() || free_start >= area_end()) return 0;
+  size_t unused = static_cast<size_t>(area_end() - free_start);
+  if (used_end < free_start) {
+    heap()->CreateFillerObjectAt(used_end,
+                                 static_cast<int>(free_start - used_end),
+                                 ClearRecordedSlots::kNo);
+  }
+  heap()->memory_allocator()->PartialFreeMemory(this, free_start);
+  return unused;
+}
+
+void MemoryAllocator::PartialFreeMemory(MemoryChunk* chunk,
+                                        Address start_free) {
+  // We do not allow partial shrink for code.
+  DCHECK(chunk->executable() == NOT_EXECUTABLE);
+  base::VirtualMemory* reservation = chunk->reserved_memory();
+  DCHECK(reservation->IsReserved());
+  DCHECK(chunk->area_start() < start_free);
+  DCHECK(start_free < chunk->address() + chunk->size());
+  size_t to_free_size = chunk->size() - (start_free - chunk->address());
+  CHECK(reservation->Uncommit(start_free, to_free_size));
+  chunk->size_ -= to_free_size;
+  chunk->area_end_ = start_free;
+  intptr_t new_size = static_cast<intptr_t>(chunk->size_);
+  if (chunk->high_water_mark_.Value() > new_size) {
+    chunk->high_water_mark_.SetValue(new_size);
+  }
+}
+
+
 void MemoryAllocator::PreFreeMemory(MemoryChunk* chunk) {
   DCHECK(!chunk->IsFlagSet(MemoryChunk::PRE_FREED));
   LOG(isolate_, DeleteEvent("MemoryChunk", chunk));
@@ -857,6 +923,9 @@ template Page*
 MemoryAllocator::AllocatePage<MemoryAllocator::kRegular, PagedSpace>(
     intptr_t size, PagedSpace* owner, Executability executable);
 template Page*
+MemoryAllocator::AllocatePage<MemoryAllocator::kPooled, PagedSpace>(
+    intptr_t size, PagedSpace* owner, Executability executable);
+template Page*
 MemoryAllocator::AllocatePage<MemoryAllocator::kRegular, SemiSpace>(
     intptr_t size, SemiSpace* owner, Executability executable);
 template Page*
@@ -884,6 +953,10 @@ MemoryChunk* MemoryAllocator::AllocatePagePooled(SpaceType* owner) {
   MemoryChunk::Initialize(isolate_->heap(), start, size, area_start, area_end,
                           NOT_EXECUTABLE, owner, &reservation);
   size_.Increment(size);
+  // Keep allocation events balanced with the ones reported in PreFreeMemory.
+  LOG(isolate_, NewEvent("MemoryChunk", start, size));
+  ObjectSpace space = static_cast<ObjectSpace>(1 << owner->identity());
+  PerformAllocationCallback(space, kAllocationActionAllocate, size);
   return chunk;
 }
 
@@ -1240,7 +1313,15 @@ bool PagedSpace::Expand() {
 
   if (!heap()->CanExpandOldGeneration(size)) return false;
 
-  Page* p = heap()->memory_allocator()->AllocatePage(size, this, executable());
+  Page* p = nullptr;
+  if (size == Page::kAllocatableMemory && executable() == NOT_EXECUTABLE) {
+    // Regular pages can be taken from the pool of the unmapper, which avoids
+    // mapping fresh memory.
+    p = heap()->memory_allocator()->AllocatePage<MemoryAllocator::kPooled>(
+        size, this, executable());
+  } else {
+    p = heap()->memory_allocator()->AllocatePage(size, this, executable());
+  }
   if (p == nullptr) return false;
 
   AccountCommitted(static_cast<intptr_t>(p->size()));
@@ -1316,6 +1397,26 @@ void PagedSpace::ReleasePage(Page* page) {
   accounting_stats_.ShrinkSpace(AreaSize());
 }
 
+void PagedSpace::ShrinkImmortalImmovablePages() {
+  DCHECK(heap()->deserialization_complete());
+  // Code pages cannot be shrunk, so keep allocating on them.
+  if (executable() == EXECUTABLE) return;
+  EmptyAllocationInfo();
+  PageIterator it(this);
+  while (it.has_next()) {
+    Page* page = it.next();
+    DCHECK(page->NeverEvacuate());
+    // The free memory of the page is either released or accounted as wasted
+    // until the page is swept for the first time.
+    intptr_t evicted = free_list_.EvictFreeListItems(page);
+    page->ResetFreeListStatistics();
+    accounting_stats_.AllocateBytes(evicted);
+    size_t unused = page->ShrinkToLastObject();
+    accounting_stats_.ShrinkSpace(static_cast<int>(unused));
+    AccountUncommitted(static_cast<intptr_t>(unused));
+  }
+}
+
 #ifdef DEBUG
 void PagedSpace::Print() {}
 #endif
@@ -1420,9 +1521,13 @@ void NewSpace::Flip() { SemiSpace::Swap(&from_space_, &to_space_); }
 void NewSpace::Grow() {
   // Double the semispace size but only up to maximum capacity.
   DCHECK(TotalCapacity() < MaximumCapacity());
-  int new_capacity =
-      Min(MaximumCapacity(),
-          FLAG_semi_space_growth_factor * static_cast<int>(TotalCapacity()));
+  GrowTo(FLAG_semi_space_growth_factor * static_cast<int>(TotalCapacity()));
+}
+
+
+void NewSpace::GrowTo(int new_capacity) {
+  new_capacity = Min(MaximumCapacity(), RoundUp(new_capacity, Page::kPageSize));
+  if (new_capacity <= TotalCapacity()) return;
   if (to_space_.GrowTo(new_capacity)) {
     // Only grow from space if we managed to grow to-space.
     if (!from_space_.GrowTo(new_capacity)) {
@@ -1439,8 +1544,12 @@ void NewSpace::Grow() {
 }
 
 
-void NewSpace::Shrink() {
-  int new_capacity = Max(InitialTotalCapacity(), 2 * SizeAsInt());
+void NewSpace::Shrink() { ShrinkTo(InitialTotalCapacity()); }
+
+
+void NewSpace::ShrinkTo(int new_capacity) {
+  new_capacity =
+      Max(new_capacity, Max(InitialTotalCapacity(), 2 * SizeAsInt()));
   int rounded_new_capacity = RoundUp(new_capacity, Page::kPageSize);
   if (rounded_new_capacity < TotalCapacity() &&
       to_space_.ShrinkTo(rounded_new_capacity)) {
@@ -1897,8 +2006,11 @@ void SemiSpace::Reset() {
 bool SemiSpace::ReplaceWithEmptyPage(Page* old_page) {
   // TODO(mlippautz): We do not have to get a new page here when the semispace
   // is uncommitted later on.
-  Page* new_page = heap()->memory_allocator()->AllocatePage(
-      Page::kAllocatableMemory, this, executable());
+  // Promoting a page should not cost an mmap, so prefer pages that were
+  // pooled when the semispaces shrank.
+  Page* new_page =
+      heap()->memory_allocator()->AllocatePage<MemoryAllocator::kPooled>(
+          Page::kAllocatableMemory, this, executable());
   if (new_page == nullptr) return false;
   Bitmap::Clear(new_page);
   new_page->SetFlags(old_page->GetFlags(), Page::kCopyAllFlags);
@@ -2298,7 +2410,10 @@ void FreeListCategory::Invalidate() {
   type_ = kInvalidCategory;
 }
 
-FreeList::FreeList(PagedSpace* owner) : owner_(owner), wasted_bytes_(0) {
+STATIC_ASSERT(kNumberOfCategories <= kBitsPerInt);
+
+FreeList::FreeList(PagedSpace* owner)
+    : owner_(owner), wasted_bytes_(0), non_empty_categories_(0) {
   for (int i = kFirstCategory; i < kNumberOfCategories; i++) {
     categories_[i] = nullptr;
   }
@@ -2312,6 +2427,7 @@ void FreeList::Reset() {
   for (int i = kFirstCategory; i < kNumberOfCategories; i++) {
     categories_[i] = nullptr;
   }
+  non_empty_categories_ = 0;
   ResetStats();
 }
 
@@ -2392,16 +2508,24 @@ FreeSpace* FreeList::FindNodeFor(int size_in_bytes, int* node_size) {
 
   // First try the allocation fast path: try to allocate the minimum element
   // size of a free list category. This operation is constant time.
+  // Only categories that have linked pages are visited.
   FreeListCategoryType type =
       SelectFastAllocationFreeListCategoryType(size_in_bytes);
-  for (int i = type; i < kHuge; i++) {
-    node = FindNodeIn(static_cast<FreeListCategoryType>(i), node_size);
+  uint32_t candidates =
+      non_empty_categories_ & ~CategoryMask(type) & CategoryMask(kHuge);
+  while (candidates != 0) {
+    FreeListCategoryType current = static_cast<FreeListCategoryType>(
+        base::bits::CountTrailingZeros32(candidates));
+    node = FindNodeIn(current, node_size);
     if (node != nullptr) return node;
+    candidates &= ~(1u << current);
   }
 
   // Next search the huge list for free list nodes. This takes linear time in
   // the number of huge elements.
-  node = SearchForNodeInList(kHuge, node_size, size_in_bytes);
+  if (categories_[kHuge] != nullptr) {
+    node = SearchForNodeInList(kHuge, node_size, size_in_bytes);
+  }
   if (node != nullptr) {
     DCHECK(IsVeryLong() || Available() == SumFreeLists());
     return node;
@@ -2534,6 +2658,7 @@ bool FreeList::AddCategory(FreeListCategory* category) {
   }
   category->set_next(top);
   categories_[type] = category;
+  non_empty_categories_ |= 1u << type;
   return true;
 }
 
@@ -2544,6 +2669,9 @@ void FreeList::RemoveCategory(FreeListCategory* category) {
   // Common double-linked list removal.
   if (top == category) {
     categories_[type] = category->next();
+    if (categories_[type] == nullptr) {
+      non_empty_categories_ &= ~(1u << type);
+    }
   }
   if (category->prev() != nullptr) {
     category->prev()->set_next(category->next());
@@ -2983,6 +3111,8 @@ AllocationResult LargeObjectSpace::AllocateRaw(int object_size,
   // this large page in the chunk map.
   uintptr_t base = reinterpret_cast<uintptr_t>(page) / MemoryChunk::kAlignment;
   uintptr_t limit = base + (page->size() - 1) / MemoryChunk::kAlignment;
+  // The store buffer task looks up pages concurrently.
+  base::LockGuard<base::Mutex> guard(&chunk_map_mutex_);
   for (uintptr_t key = base; key <= limit; key++) {
     HashMap::Entry* entry = chunk_map_.LookupOrInsert(
         reinterpret_cast<void*>(key), static_cast<uint32_t>(key));
@@ -3031,6 +3161,7 @@ Object* LargeObjectSpace::FindObject(Address a) {
 
 LargePage* LargeObjectSpace::FindPage(Address a) {
   uintptr_t key = reinterpret_cast<uintptr_t>(a) / MemoryChunk::kAlignment;
+  base::LockGuard<base::Mutex> guard(&chunk_map_mutex_);
   HashMap::Entry* e = chunk_map_.Lookup(reinterpret_cast<void*>(key),
                                         static_cast<uint32_t>(key));
   if (e != NULL) {
@@ -3059,6 +3190,18 @@ void LargeObjectSpace::ClearMarkingStateOfLiveObjects() {
 }
 
 
+Address LargePage::GetAddressToShrink() {
+  // We do not shrink code pages.
+  if (executable() == EXECUTABLE) return NULL;
+  if (!reserved_memory()->IsReserved()) return NULL;
+  HeapObject* object = GetObject();
+  size_t used_size = RoundUp((object->address() - address()) + object->Size(),
+                             base::OS::CommitPageSize());
+  if (used_size < size()) return address() + used_size;
+  return NULL;
+}
+
+
 void LargeObjectSpace::FreeUnmarkedObjects() {
   LargePage* previous = NULL;
   LargePage* current = first_page_;
@@ -3067,6 +3210,17 @@ void LargeObjectSpace::FreeUnmarkedObjects() {
     MarkBit mark_bit = Marking::MarkBitFrom(object);
     DCHECK(!Marking::IsGrey(mark_bit));
     if (Marking::IsBlack(mark_bit)) {
+      Address free_start = current->GetAddressToShrink();
+      if (free_start != NULL) {
+        Address free_end = current->address() + current->size();
+        size_t freed = static_cast<size_t>(free_end - free_start);
+        RememberedSet<OLD_TO_NEW>::RemoveRange(current, free_start, free_end);
+        RememberedSet<OLD_TO_OLD>::RemoveRange(current, free_start, free_end);
+        RemoveChunkMapEntries(current, free_start);
+        heap()->memory_allocator()->PartialFreeMemory(current, free_start);
+        size_ -= static_cast<intptr_t>(freed);
+        AccountUncommitted(static_cast<intptr_t>(freed));
+      }
       previous = current;
       current = current->next_page();
     } else {
@@ -3086,15 +3240,7 @@ void LargeObjectSpace::FreeUnmarkedObjects() {
       page_count_--;
 
       // Remove entries belonging to this page.
-      // Use variable alignment to help pass length check (<= 80 characters)
-      // of single line in tools/presubmit.py.
-      const intptr_t alignment = MemoryChunk::kAlignment;
-      uintptr_t base = reinterpret_cast<uintptr_t>(page) / alignment;
-      uintptr_t limit = base + (page->size() - 1) / alignment;
-      for (uintptr_t key = base; key <= limit; key++) {
-        chunk_map_.Remove(reinterpret_cast<void*>(key),
-                          static_cast<uint32_t>(key));
-      }
+      RemoveChunkMapEntries(page, page->address());
 
       heap()->memory_allocator()->Free<MemoryAllocator::kPreFreeAndQueue>(page);
     }
@@ -3102,6 +3248,23 @@ void LargeObjectSpace::FreeUnmarkedObjects() {
 }
 
 
+void LargeObjectSpace::RemoveChunkMapEntries(LargePage* page,
+                                             Address free_start) {
+  // Use variable alignment to help pass length check (<= 80 characters)
+  // of single line in tools/presubmit.py.
+  const uintptr_t alignment = MemoryChunk::kAlignment;
+  uintptr_t start = reinterpret_cast<uintptr_t>(free_start);
+  uintptr_t end = reinterpret_cast<uintptr_t>(page) + page->size();
+  uintptr_t base = RoundUp(start, alignment) / alignment;
+  uintptr_t limit = (end - 1) / alignment;
+  base::LockGuard<base::Mutex> guard(&chunk_map_mutex_);
+  for (uintptr_t key = base; key <= limit; key++) {
+    chunk_map_.Remove(reinterpret_cast<void*>(key),
+                      static_cast<uint32_t>(key));
+  }
+}
+
+
 bool LargeObjectSpace::Contains(HeapObject* object) {
   Address address = object->address();
   MemoryChunk* chunk = MemoryChunk::FromAddress(address);
@@ -929,6 +929,11 @@ class Page : public MemoryChunk {
 
   void ResetFreeListStatistics();
 
+  // Releases the committed memory behind the last object on the page and
+  // returns the number of bytes released. The free list of the owner must not
+  // hold any items of this page.
+  size_t ShrinkToLastObject();
+
   int LiveBytesFromFreeList() {
     return static_cast<int>(area_size() - wasted_memory() -
                             available_in_free_list());
@@ -977,6 +982,11 @@ class LargePage : public MemoryChunk {
 
   inline void set_next_page(LargePage* page) { set_next_chunk(page); }
 
+  // Returns the start of the committed memory behind the object that can be
+  // released, e.g. after the object was right-trimmed, or NULL if there is
+  // none.
+  Address GetAddressToShrink();
+
   // A limit to guarantee that we do not overflow typed slot offset in
   // the old to old remembered set.
   // Note that this limit is higher than what assembler already imposes on
@@ -1154,6 +1164,9 @@ class CodeRange {
   void FreeRawMemory(Address buf, size_t length);
 
  private:
+  // The size of the huge pages that --code-range-huge-pages asks for.
+  static const size_t kHugePageSize = 2 * MB;
+
   // Frees the range of virtual memory, and frees the data structures used to
   // manage it.
   void TearDown();
@@ -1376,6 +1389,10 @@ class MemoryAllocator {
   template <MemoryAllocator::FreeMode mode = kFull>
   void Free(MemoryChunk* chunk);
 
+  // Uncommits the memory of |chunk| starting at |start_free| and shrinks the
+  // chunk accordingly. The reservation is kept until the chunk is freed.
+  void PartialFreeMemory(MemoryChunk* chunk, Address start_free);
+
   // Returns allocated spaces in bytes.
   intptr_t Size() { return size_.Value(); }
 
@@ -1549,6 +1566,10 @@ class MemoryAllocator {
     } while ((high > ptr) && !highest_ever_allocated_.TrySetValue(ptr, high));
   }
 
+  // Makes the committed region prefer the NUMA node of the current thread if
+  // --numa-bind-heap-pages is enabled.
+  void BindToCurrentNumaNode(Address base, size_t size);
+
   base::VirtualMemory last_chunk_;
   Unmapper unmapper_;
 
@@ -1977,10 +1998,19 @@ class FreeList {
 
   FreeListCategory* top(FreeListCategoryType type) { return categories_[type]; }
 
+  // Mask of all categories below |type|.
+  static uint32_t CategoryMask(FreeListCategoryType type) {
+    return (1u << type) - 1;
+  }
+
   PagedSpace* owner_;
   AtomicNumber<intptr_t> wasted_bytes_;
   FreeListCategory* categories_[kNumberOfCategories];
 
+  // Bit i is set iff categories_[i] is not nullptr. Allows the allocation
+  // fast path to skip over empty categories.
+  uint32_t non_empty_categories_;
+
   friend class FreeListCategory;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(FreeList);
@@ -2233,6 +2263,12 @@ class PagedSpace : public Space {
   // Releases an unused page and shrinks the space.
   void ReleasePage(Page* page);
 
+  // Releases the unused tail of the pages created while deserializing the
+  // startup snapshot, so that they only hold immortal immovable objects and
+  // later allocations do not end up on pages that are never evacuated. Code
+  // space is left alone.
+  void ShrinkImmortalImmovablePages();
+
   // The dummy page that anchors the linked list of pages.
   Page* anchor() { return &anchor_; }
 
@@ -2629,9 +2665,17 @@ class NewSpace : public Space {
   // their maximum capacity.
   void Grow();
 
+  // Grow the capacity of the semispaces to |new_capacity|, rounded up to the
+  // page size and capped at the maximum capacity.
+  void GrowTo(int new_capacity);
+
   // Shrink the capacity of the semispaces.
   void Shrink();
 
+  // Shrink the capacity of the semispaces towards |new_capacity|, keeping at
+  // least the initial capacity and twice the size of the live objects.
+  void ShrinkTo(int new_capacity);
+
   // Return the allocated bytes in the active semispace.
   intptr_t Size() override {
     return pages_used_ * Page::kAllocatableMemory +
@@ -3077,6 +3121,11 @@ class LargeObjectSpace : public Space {
   intptr_t objects_size_;  // size of objects
   // Map MemoryChunk::kAlignment-aligned chunks to large pages covering them
   HashMap chunk_map_;
+  base::Mutex chunk_map_mutex_;
+
+  // Removes the chunk map entries of |page| that only cover memory at or
+  // above |free_start|.
+  void RemoveChunkMapEntries(LargePage* page, Address free_start);
 
   friend class LargeObjectIterator;
 };
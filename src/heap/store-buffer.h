@@ -7,6 +7,7 @@
 
 #include "src/allocation.h"
 #include "src/base/logging.h"
+#include "src/base/platform/mutex.h"
 #include "src/base/platform/platform.h"
 #include "src/globals.h"
 #include "src/heap/slot-set.h"
@@ -15,11 +16,16 @@ namespace v8 {
 namespace internal {
 
 // Intermediate buffer that accumulates old-to-new stores from the generated
-// code. On buffer overflow the slots are moved to the remembered set.
+// code and the runtime. The store buffer consists of two buffers of equal
+// size. On overflow of one buffer the buffers are flipped and the full buffer
+// is moved to the remembered set by a background task while the mutator keeps
+// filling the other buffer. Before the remembered set is accessed by the main
+// thread all buffers have to be moved with MoveEntriesToRememberedSet.
 class StoreBuffer {
  public:
   static const int kStoreBufferSize = 1 << (14 + kPointerSizeLog2);
   static const int kStoreBufferMask = kStoreBufferSize - 1;
+  static const int kStoreBuffers = 2;
 
   static void StoreBufferOverflow(Isolate* isolate);
 
@@ -30,17 +36,47 @@ class StoreBuffer {
   // Used to add entries from generated code.
   inline Address* top_address() { return reinterpret_cast<Address*>(&top_); }
 
+  // Used to add entries from the runtime. Entries recorded during GC are
+  // inserted directly into the remembered set.
+  inline void InsertEntry(Address slot);
+
+  // Moves the entries of all buffers to the remembered set. Waits for a
+  // concurrently running buffer processing task.
   void MoveEntriesToRememberedSet();
 
  private:
+  class Task;
+
+  // Makes the other buffer the current one and moves the entries of the full
+  // buffer to the remembered set, concurrently if possible.
+  void FlipStoreBuffers();
+
+  // Moves the entries of the given buffer to the remembered set. Has to be
+  // called with the mutex held.
+  void MoveEntriesToRememberedSet(int index);
+
+  void ConcurrentlyProcessStoreBuffer();
+
   Heap* heap_;
 
   Address* top_;
 
-  // The start and the limit of the buffer that contains store slots
+  // The start and the limit of the buffers that contain store slots
   // added from the generated code.
-  Address* start_;
-  Address* limit_;
+  Address* start_[kStoreBuffers];
+  Address* limit_[kStoreBuffers];
+
+  // At most one buffer is in processing at the same time. The lazy top of a
+  // buffer is the end of its entries while the buffer is not current.
+  Address* lazy_top_[kStoreBuffers];
+
+  // The buffer that is currently filled by the mutator.
+  int current_;
+
+  // Guards the buffers that are not current and task_running_.
+  base::Mutex mutex_;
+
+  bool task_running_;
 
   base::VirtualMemory* virtual_memory_;
 };
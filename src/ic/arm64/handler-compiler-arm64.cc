@@ -535,12 +535,21 @@ Register PropertyHandlerCompiler::CheckPrototypes(
       DCHECK(current.is_null() || (current->property_dictionary()->FindEntry(
                                        name) == NameDictionary::kNotFound));
 
-      if (FLAG_eliminate_prototype_chain_checks && depth > 1) {
-        // TODO(jkummerow): Cache and re-use weak cell.
-        __ LoadWeakValue(reg, isolate()->factory()->NewWeakCell(current), miss);
+      // Adding a property to a dictionary-mode prototype invalidates the
+      // validity cell checked above, so only the receiver and prototypes
+      // without prototype maps need a negative lookup.
+      bool needs_negative_lookup = !FLAG_eliminate_prototype_chain_checks ||
+                                   depth == 1 ||
+                                   !current_map->is_prototype_map();
+      if (needs_negative_lookup) {
+        if (FLAG_eliminate_prototype_chain_checks && depth > 1) {
+          // TODO(jkummerow): Cache and re-use weak cell.
+          __ LoadWeakValue(reg, isolate()->factory()->NewWeakCell(current),
+                           miss);
+        }
+        GenerateDictionaryNegativeLookup(masm(), miss, reg, name, scratch1,
+                                         scratch2);
       }
-      GenerateDictionaryNegativeLookup(masm(), miss, reg, name, scratch1,
-                                       scratch2);
 
       if (!FLAG_eliminate_prototype_chain_checks) {
         __ Ldr(scratch1, FieldMemOperand(reg, HeapObject::kMapOffset));
@@ -80,6 +80,9 @@ Handle<Code> PropertyHandlerCompiler::GetCode(Code::Kind kind,
   Handle<Code> code = GetCodeWithFlags(flags, name);
   PROFILE(isolate(), CodeCreateEvent(Logger::HANDLER_TAG,
                                      AbstractCode::cast(*code), *name));
+  Counters* counters = isolate()->counters();
+  counters->ic_compiled_handlers()->Increment();
+  counters->ic_compiled_handlers_size()->Increment(code->Size());
 #ifdef DEBUG
   code->VerifyEmbeddedObjects();
 #endif
@@ -11,8 +11,6 @@ namespace v8 {
 namespace internal {
 
 
-const int kMaxKeyedPolymorphism = 4;
-
 
 class ICUtility : public AllStatic {
  public:
@@ -0,0 +1,103 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/ic/ic-stats.h"
+
+#include <algorithm>
+#include <ostream>
+#include <vector>
+
+#include "src/ic/ic.h"
+#include "src/objects-inl.h"
+
+namespace v8 {
+namespace internal {
+
+bool ICStats::SiteKey::operator<(const SiteKey& other) const {
+  if (script_id != other.script_id) return script_id < other.script_id;
+  if (function_position != other.function_position) {
+    return function_position < other.function_position;
+  }
+  return slot < other.slot;
+}
+
+ICStats::SiteStats::SiteStats() : is_keyed(false), type(nullptr) {
+  for (int i = 0; i < kStateCount; i++) {
+    for (int j = 0; j < kStateCount; j++) transitions[i][j] = 0;
+  }
+}
+
+int ICStats::SiteStats::TotalTransitions() const {
+  int total = 0;
+  for (int i = 0; i < kStateCount; i++) {
+    for (int j = 0; j < kStateCount; j++) total += transitions[i][j];
+  }
+  return total;
+}
+
+int ICStats::SiteStats::MegamorphicMisses() const {
+  int misses = 0;
+  for (int j = 0; j < kStateCount; j++) misses += transitions[MEGAMORPHIC][j];
+  return misses;
+}
+
+void ICStats::RecordTransition(JSFunction* function, int slot, bool is_keyed,
+                               const char* type, InlineCacheState old_state,
+                               InlineCacheState new_state) {
+  SharedFunctionInfo* shared = function->shared();
+  SiteKey key;
+  key.script_id =
+      shared->script()->IsScript() ? Script::cast(shared->script())->id() : -1;
+  key.function_position = shared->start_position();
+  key.slot = slot;
+  SiteMap::iterator it = sites_.find(key);
+  if (it == sites_.end()) {
+    it = sites_.insert(std::make_pair(key, SiteStats())).first;
+    it->second.function_name = shared->DebugName()->ToCString().get();
+    it->second.is_keyed = is_keyed;
+    it->second.type = type;
+  }
+  it->second.transitions[old_state][new_state]++;
+}
+
+void ICStats::Print(std::ostream& os, size_t max_sites) const {
+  typedef std::pair<const SiteKey*, const SiteStats*> Site;
+  std::vector<Site> sites;
+  for (const auto& entry : sites_) {
+    sites.push_back(Site(&entry.first, &entry.second));
+  }
+  std::sort(sites.begin(), sites.end(), [](const Site& a, const Site& b) {
+    int a_misses = a.second->MegamorphicMisses();
+    int b_misses = b.second->MegamorphicMisses();
+    if (a_misses != b_misses) return a_misses > b_misses;
+    return a.second->TotalTransitions() > b.second->TotalTransitions();
+  });
+  if (sites.size() > max_sites) sites.resize(max_sites);
+
+  os << "IC sites by megamorphic misses (" << sites_.size() << " sites):\n";
+  for (const Site& site : sites) {
+    const SiteStats* stats = site.second;
+    const char* name = stats->function_name.empty()
+                           ? "(anonymous)"
+                           : stats->function_name.c_str();
+    os << "  " << (stats->is_keyed ? "Keyed" : "") << stats->type << " in "
+       << name << " (script " << site.first->script_id << ", position "
+       << site.first->function_position << ", slot " << site.first->slot
+       << "): " << stats->MegamorphicMisses() << " megamorphic misses, "
+       << stats->TotalTransitions() << " transitions";
+    for (int i = 0; i < kStateCount; i++) {
+      for (int j = 0; j < kStateCount; j++) {
+        int count = stats->transitions[i][j];
+        if (count == 0) continue;
+        os << " " << IC::TransitionMarkFromState(static_cast<IC::State>(i))
+           << "->" << IC::TransitionMarkFromState(static_cast<IC::State>(j))
+           << ":" << count;
+      }
+    }
+    os << "\n";
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
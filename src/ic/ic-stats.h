@@ -0,0 +1,74 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_IC_IC_STATS_H_
+#define V8_IC_IC_STATS_H_
+
+#include <iosfwd>
+#include <map>
+#include <string>
+
+#include "src/allocation.h"
+#include "src/globals.h"
+
+namespace v8 {
+namespace internal {
+
+class JSFunction;
+
+// Collects the IC state transitions of every IC site in memory, for
+// --ic-stats. Unlike --trace-ic nothing is printed per transition, so the
+// collection is cheap enough to run on big applications. A site is
+// identified by its script, the position of its function and its feedback
+// slot, none of which change when objects move.
+class ICStats final : public Malloced {
+ public:
+  ICStats() {}
+
+  void RecordTransition(JSFunction* function, int slot, bool is_keyed,
+                        const char* type, InlineCacheState old_state,
+                        InlineCacheState new_state);
+
+  // Prints the |max_sites| sites with the most misses in the megamorphic
+  // state, the sites with the most transitions breaking ties.
+  void Print(std::ostream& os, size_t max_sites) const;
+  void Reset() { sites_.clear(); }
+
+  bool is_empty() const { return sites_.empty(); }
+
+ private:
+  static const int kStateCount = DEBUG_STUB + 1;
+
+  struct SiteKey {
+    int script_id;
+    int function_position;
+    int slot;
+
+    bool operator<(const SiteKey& other) const;
+  };
+
+  struct SiteStats {
+    SiteStats();
+
+    int TotalTransitions() const;
+    // Misses of the stub cache show up as transitions out of MEGAMORPHIC.
+    int MegamorphicMisses() const;
+
+    std::string function_name;
+    bool is_keyed;
+    const char* type;
+    int transitions[kStateCount][kStateCount];
+  };
+
+  typedef std::map<SiteKey, SiteStats> SiteMap;
+
+  SiteMap sites_;
+
+  DISALLOW_COPY_AND_ASSIGN(ICStats);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_IC_IC_STATS_H_
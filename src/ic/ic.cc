@@ -18,6 +18,7 @@
 #include "src/ic/handler-compiler.h"
 #include "src/ic/ic-inl.h"
 #include "src/ic/ic-compiler.h"
+#include "src/ic/ic-stats.h"
 #include "src/ic/stub-cache.h"
 #include "src/isolate-inl.h"
 #include "src/macro-assembler.h"
@@ -92,10 +93,19 @@ const char* GetTransitionMarkModifier(KeyedAccessStoreMode mode) {
 
 
 void IC::TraceIC(const char* type, Handle<Object> name) {
-  if (FLAG_trace_ic) {
+  if (FLAG_trace_ic || FLAG_ic_stats) {
     if (AddressIsDeoptimizedCode()) return;
     DCHECK(UseVector());
     State new_state = nexus()->StateFromFeedback();
+    if (FLAG_ic_stats) {
+      Object* maybe_function =
+          Memory::Object_at(fp_ + JavaScriptFrameConstants::kFunctionOffset);
+      if (maybe_function->IsJSFunction()) {
+        isolate()->GetICStats()->RecordTransition(
+            JSFunction::cast(maybe_function), nexus()->slot().ToInt(),
+            is_keyed(), type, state(), new_state);
+      }
+    }
     TraceIC(type, name, state(), new_state);
   }
 }
@@ -376,6 +386,16 @@ void IC::OnTypeFeedbackChanged(Isolate* isolate, Code* host) {
   // unoptimized version for the benefit of later inlining.
 }
 
+void IC::OnTypeFeedbackChanged() {
+  Code* host = get_host();
+  if (host->kind() == Code::BYTECODE_HANDLER) {
+    GetSharedFunctionInfo()->set_profiler_ticks(0);
+    isolate()->runtime_profiler()->NotifyICChanged();
+    return;
+  }
+  OnTypeFeedbackChanged(isolate(), host);
+}
+
 void IC::PostPatching(Address address, Code* target, Code* old_target) {
   // Type vector based ICs update these statistics at a different time because
   // they don't always patch on state change.
@@ -521,7 +541,7 @@ void IC::ConfigureVectorState(IC::State new_state, Handle<Object> key) {
   }
 
   vector_set_ = true;
-  OnTypeFeedbackChanged(isolate(), get_host());
+  OnTypeFeedbackChanged();
 }
 
 
@@ -544,7 +564,7 @@ void IC::ConfigureVectorState(Handle<Name> name, Handle<Map> map,
   }
 
   vector_set_ = true;
-  OnTypeFeedbackChanged(isolate(), get_host());
+  OnTypeFeedbackChanged();
 }
 
 
@@ -567,7 +587,7 @@ void IC::ConfigureVectorState(Handle<Name> name, MapHandleList* maps,
   }
 
   vector_set_ = true;
-  OnTypeFeedbackChanged(isolate(), get_host());
+  OnTypeFeedbackChanged();
 }
 
 
@@ -580,7 +600,7 @@ void IC::ConfigureVectorState(MapHandleList* maps,
   nexus->ConfigurePolymorphic(maps, transitioned_maps, handlers);
 
   vector_set_ = true;
-  OnTypeFeedbackChanged(isolate(), get_host());
+  OnTypeFeedbackChanged();
 }
 
 
@@ -707,7 +727,7 @@ bool IC::UpdatePolymorphicIC(Handle<Name> name, Handle<Code> code) {
   int number_of_valid_maps =
       number_of_maps - deprecated_maps - (handler_to_overwrite != -1);
 
-  if (number_of_valid_maps >= 4) return false;
+  if (number_of_valid_maps >= FLAG_max_polymorphic_map_count) return false;
   if (number_of_maps == 0 && state() != MONOMORPHIC && state() != POLYMORPHIC) {
     return false;
   }
@@ -1217,7 +1237,7 @@ void KeyedLoadIC::UpdateLoadElement(Handle<HeapObject> receiver) {
 
   // If the maximum number of receiver maps has been exceeded, use the generic
   // version of the IC.
-  if (target_receiver_maps.length() > kMaxKeyedPolymorphism) {
+  if (target_receiver_maps.length() > FLAG_max_polymorphic_map_count) {
     TRACE_GENERIC_IC(isolate(), "KeyedLoadIC", "max polymorph exceeded");
     return;
   }
@@ -1715,7 +1735,7 @@ void KeyedStoreIC::UpdateStoreElement(Handle<Map> receiver_map,
 
   // If the maximum number of receiver maps has been exceeded, use the
   // megamorphic version of the IC.
-  if (target_receiver_maps.length() > kMaxKeyedPolymorphism) return;
+  if (target_receiver_maps.length() > FLAG_max_polymorphic_map_count) return;
 
   // Make sure all polymorphic handlers have the same store mode, otherwise the
   // megamorphic stub must be used.
@@ -1992,7 +2012,7 @@ void CallIC::HandleMiss(Handle<Object> function) {
     name = handle(js_function->shared()->name(), isolate());
   }
 
-  OnTypeFeedbackChanged(isolate(), get_host());
+  OnTypeFeedbackChanged();
   TRACE_IC("CallIC", name);
 }
 
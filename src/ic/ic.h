@@ -45,6 +45,9 @@ class IC {
   // Clear the inline cache to initial state.
   static void Clear(Isolate* isolate, Address address, Address constant_pool);
 
+  // The character --trace-ic uses for |state|.
+  static char TransitionMarkFromState(IC::State state);
+
 #ifdef DEBUG
   bool IsLoadStub() const {
     return kind_ == Code::LOAD_IC || kind_ == Code::KEYED_LOAD_IC;
@@ -119,7 +122,6 @@ class IC {
                             MapHandleList* transitioned_maps,
                             CodeHandleList* handlers);
 
-  char TransitionMarkFromState(IC::State state);
   void TraceIC(const char* type, Handle<Object> name);
   void TraceIC(const char* type, Handle<Object> name, State old_state,
                State new_state);
@@ -135,6 +137,9 @@ class IC {
                                         Address constant_pool);
   // As a vector-based IC, type feedback must be updated differently.
   static void OnTypeFeedbackChanged(Isolate* isolate, Code* host);
+  // Also restarts the profiler ticks of interpreted functions, which are
+  // counted on the SharedFunctionInfo rather than on the host code.
+  void OnTypeFeedbackChanged();
   static void PostPatching(Address address, Code* target, Code* old_target);
 
   // Compute the handler either by compiling or by retrieving a cached version.
@@ -53,12 +53,22 @@ Code* StubCache::Set(Name* name, Map* map, Code* code) {
 
   // If the primary entry has useful data in it, we retire it to the
   // secondary cache before overwriting it.
-  if (old_code != isolate_->builtins()->builtin(Builtins::kIllegal)) {
+  Code* empty = isolate_->builtins()->builtin(Builtins::kIllegal);
+  if (old_code != empty) {
     Map* old_map = primary->map;
     Code::Flags old_flags = Code::RemoveHolderFromFlags(old_code->flags());
     int seed = PrimaryOffset(primary->key, old_flags, old_map);
     int secondary_offset = SecondaryOffset(primary->key, old_flags, seed);
     Entry* secondary = entry(secondary_, secondary_offset);
+    // Count the entries other (name, map) pairs push out of the cache, which
+    // show whether the tables are too small for the program.
+    Counters* counters = isolate()->counters();
+    if (primary->key != name || old_map != map) {
+      counters->megamorphic_stub_cache_primary_collisions()->Increment();
+      if (secondary->value != empty) {
+        counters->megamorphic_stub_cache_secondary_evictions()->Increment();
+      }
+    }
     *secondary = *primary;
   }
 
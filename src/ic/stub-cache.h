@@ -7,6 +7,13 @@
 
 #include "src/macro-assembler.h"
 
+#ifndef V8_STUB_CACHE_PRIMARY_TABLE_BITS
+#define V8_STUB_CACHE_PRIMARY_TABLE_BITS 11
+#endif
+#ifndef V8_STUB_CACHE_SECONDARY_TABLE_BITS
+#define V8_STUB_CACHE_SECONDARY_TABLE_BITS 9
+#endif
+
 namespace v8 {
 namespace internal {
 
@@ -150,9 +157,12 @@ class StubCache {
                                     offset * multiplier);
   }
 
-  static const int kPrimaryTableBits = 11;
+  // The table sizes are baked into the probing code of every architecture
+  // and into the stubs in the snapshot, so they can only be changed at build
+  // time. The V8.MegamorphicStubCache* counters help to pick them.
+  static const int kPrimaryTableBits = V8_STUB_CACHE_PRIMARY_TABLE_BITS;
   static const int kPrimaryTableSize = (1 << kPrimaryTableBits);
-  static const int kSecondaryTableBits = 9;
+  static const int kSecondaryTableBits = V8_STUB_CACHE_SECONDARY_TABLE_BITS;
   static const int kSecondaryTableSize = (1 << kSecondaryTableBits);
 
  private:
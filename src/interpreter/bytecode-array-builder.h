@@ -6,6 +6,7 @@
 #define V8_INTERPRETER_BYTECODE_ARRAY_BUILDER_H_
 
 #include "src/ast/ast.h"
+#include "src/interpreter/bytecode-array-writer.h"
 #include "src/interpreter/bytecode-register-allocator.h"
 #include "src/interpreter/bytecodes.h"
 #include "src/interpreter/constant-array-builder.h"
@@ -21,13 +22,17 @@ class Isolate;
 namespace interpreter {
 
 class BytecodeLabel;
+class BytecodeNode;
+class BytecodePipelineStage;
 class Register;
 
 class BytecodeArrayBuilder final : public ZoneObject {
  public:
-  BytecodeArrayBuilder(Isolate* isolate, Zone* zone, int parameter_count,
-                       int context_count, int locals_count,
-                       FunctionLiteral* literal = nullptr);
+  BytecodeArrayBuilder(
+      Isolate* isolate, Zone* zone, int parameter_count, int context_count,
+      int locals_count, FunctionLiteral* literal = nullptr,
+      SourcePositionTableBuilder::RecordingMode source_position_mode =
+          SourcePositionTableBuilder::RECORD_SOURCE_POSITIONS);
 
   Handle<BytecodeArray> ToBytecodeArray();
 
@@ -73,6 +78,10 @@ class BytecodeArrayBuilder final : public ZoneObject {
   // Returns true if the register |reg| is a live temporary register.
   bool TemporaryRegisterIsLive(Register reg) const;
 
+  // Returns the number of registers up to and including the highest live
+  // temporary register. Registers above it do not hold live values.
+  int live_register_count() const;
+
   // Constant loads to accumulator.
   BytecodeArrayBuilder& LoadLiteral(v8::internal::Smi* value);
   BytecodeArrayBuilder& LoadLiteral(Handle<Object> object);
@@ -225,6 +234,12 @@ class BytecodeArrayBuilder final : public ZoneObject {
 
   BytecodeArrayBuilder& StackCheck(int position);
 
+  BytecodeArrayBuilder& OsrPoll(int loop_depth);
+
+  // Increments the block counter in |counter_slot| of the feedback vector,
+  // see --block-coverage. |position| is the source position of the block.
+  BytecodeArrayBuilder& IncBlockCounter(int counter_slot, int position);
+
   BytecodeArrayBuilder& Throw();
   BytecodeArrayBuilder& ReThrow();
   BytecodeArrayBuilder& Return();
@@ -245,6 +260,12 @@ class BytecodeArrayBuilder final : public ZoneObject {
   // Generators.
   BytecodeArrayBuilder& SuspendGenerator(Register generator);
   BytecodeArrayBuilder& ResumeGenerator(Register generator);
+  // Variants which only save or restore the first |register_count|
+  // registers of the register file.
+  BytecodeArrayBuilder& SuspendGeneratorLive(Register generator,
+                                             int register_count);
+  BytecodeArrayBuilder& ResumeGeneratorLive(Register generator,
+                                            int register_count);
 
   // Exception handling.
   BytecodeArrayBuilder& MarkHandler(int handler_id, bool will_catch);
@@ -289,7 +310,6 @@ class BytecodeArrayBuilder final : public ZoneObject {
   static uint32_t UnsignedOperand(size_t value);
 
  private:
-  class PreviousBytecodeHelper;
   friend class BytecodeRegisterAllocator;
 
   static Bytecode BytecodeForBinaryOperation(Token::Value op);
@@ -307,9 +327,7 @@ class BytecodeArrayBuilder final : public ZoneObject {
   static Bytecode GetJumpWithConstantOperand(Bytecode jump_smi8_operand);
   static Bytecode GetJumpWithToBoolean(Bytecode jump_smi8_operand);
 
-  template <size_t N>
-  INLINE(void Output(Bytecode bytecode, uint32_t (&operands)[N],
-                     OperandScale operand_scale = OperandScale::kSingle));
+  void Output(BytecodeNode* node);
   void Output(Bytecode bytecode);
   void OutputScaled(Bytecode bytecode, OperandScale operand_scale,
                     uint32_t operand0, uint32_t operand1, uint32_t operand2,
@@ -338,9 +356,8 @@ class BytecodeArrayBuilder final : public ZoneObject {
                       int operand_index, uint32_t operand_value) const;
   bool RegisterIsValid(Register reg, OperandSize reg_size) const;
 
-  bool LastBytecodeInSameBlock() const;
-  bool NeedToBooleanCast();
-  bool IsRegisterInAccumulator(Register reg);
+  // Attach latest source position to |node|.
+  void AttachSourceInfo(BytecodeNode* node);
 
   // Set position for return.
   void SetReturnPosition();
@@ -348,8 +365,13 @@ class BytecodeArrayBuilder final : public ZoneObject {
   // Gets a constant pool entry for the |object|.
   size_t GetConstantPoolEntry(Handle<Object> object);
 
-  ZoneVector<uint8_t>* bytecodes() { return &bytecodes_; }
-  const ZoneVector<uint8_t>* bytecodes() const { return &bytecodes_; }
+  ZoneVector<uint8_t>* bytecodes() {
+    return bytecode_array_writer_.bytecodes();
+  }
+  const ZoneVector<uint8_t>* bytecodes() const {
+    return bytecode_array_writer_.bytecodes();
+  }
+  BytecodePipelineStage* pipeline() { return pipeline_; }
   Isolate* isolate() const { return isolate_; }
   ConstantArrayBuilder* constant_array_builder() {
     return &constant_array_builder_;
@@ -366,13 +388,13 @@ class BytecodeArrayBuilder final : public ZoneObject {
 
   Isolate* isolate_;
   Zone* zone_;
-  ZoneVector<uint8_t> bytecodes_;
   bool bytecode_generated_;
   ConstantArrayBuilder constant_array_builder_;
   HandlerTableBuilder handler_table_builder_;
   SourcePositionTableBuilder source_position_table_builder_;
-  size_t last_block_end_;
-  size_t last_bytecode_start_;
+  BytecodeArrayWriter bytecode_array_writer_;
+  BytecodePipelineStage* pipeline_;
+  BytecodeSourceInfo latest_source_info_;
   bool exit_seen_in_block_;
   int unbound_jumps_;
   int parameter_count_;
@@ -7,8 +7,10 @@
 #include "src/ast/scopes.h"
 #include "src/code-stubs.h"
 #include "src/compiler.h"
+#include "src/debug/debug.h"
 #include "src/interpreter/bytecode-register-allocator.h"
 #include "src/interpreter/control-flow-builders.h"
+#include "src/log.h"
 #include "src/objects.h"
 #include "src/parsing/parser.h"
 #include "src/parsing/token.h"
@@ -555,13 +557,34 @@ class BytecodeGenerator::RegisterResultScope final
   Register result_register_;
 };
 
+static SourcePositionTableBuilder::RecordingMode SourcePositionRecordingMode(
+    CompilationInfo* info) {
+  if (!FLAG_ignition_lazy_source_positions ||
+      info->is_source_positions_enabled()) {
+    return SourcePositionTableBuilder::RECORD_SOURCE_POSITIONS;
+  }
+  // The debugger and the profilers consume positions as code is created.
+  Isolate* isolate = info->isolate();
+  if (isolate->debug()->is_active() ||
+      isolate->logger()->is_logging_code_events()) {
+    return SourcePositionTableBuilder::RECORD_SOURCE_POSITIONS;
+  }
+  // Omitted positions are recovered by re-parsing the function on its own.
+  if (!info->has_shared_info() || info->parse_info()->is_toplevel() ||
+      !info->shared_info()->allows_lazy_compilation_without_context()) {
+    return SourcePositionTableBuilder::RECORD_SOURCE_POSITIONS;
+  }
+  return SourcePositionTableBuilder::OMIT_EXPRESSION_POSITIONS;
+}
+
 BytecodeGenerator::BytecodeGenerator(CompilationInfo* info)
     : isolate_(info->isolate()),
       zone_(info->zone()),
       builder_(new (zone()) BytecodeArrayBuilder(
           info->isolate(), info->zone(), info->num_parameters_including_this(),
           info->scope()->MaxNestedContextChainLength(),
-          info->scope()->num_stack_slots(), info->literal())),
+          info->scope()->num_stack_slots(), info->literal(),
+          SourcePositionRecordingMode(info))),
       info_(info),
       scope_(info->scope()),
       globals_(0, info->zone()),
@@ -572,8 +595,10 @@ BytecodeGenerator::BytecodeGenerator(CompilationInfo* info)
       generator_resume_points_(info->literal()->yield_count(), info->zone()),
       generator_state_(),
       generator_yields_seen_(0),
+      loop_depth_(0),
       try_catch_nesting_level_(0),
-      try_finally_nesting_level_(0) {
+      try_finally_nesting_level_(0),
+      block_counters_used_(0) {
   InitializeAstVisitor(isolate());
 }
 
@@ -641,6 +666,9 @@ void BytecodeGenerator::MakeBytecodeBody() {
   // Perform a stack-check before the body.
   builder()->StackCheck(info()->literal()->start_position());
 
+  // The first block counter counts the invocations of the function.
+  BuildIncrementBlockCounter(info()->literal()->start_position());
+
   // Visit statements in the function body.
   VisitStatements(info()->literal()->body());
 }
@@ -659,6 +687,28 @@ void BytecodeGenerator::BuildIndexedJump(Register index, size_t start_index,
   builder()->Illegal();  // Should never get here.
 }
 
+void BytecodeGenerator::BuildIncrementBlockCounter(AstNode* node,
+                                                   AstNode* parent) {
+  // A {...} block starts at its first statement.
+  while (node->position() == RelocInfo::kNoPosition && node->IsBlock() &&
+         !node->AsBlock()->statements()->is_empty()) {
+    node = node->AsBlock()->statements()->first();
+  }
+  int position = node->position();
+  if (position == RelocInfo::kNoPosition) position = parent->position();
+  BuildIncrementBlockCounter(position);
+}
+
+void BytecodeGenerator::BuildIncrementBlockCounter(int position) {
+  // The AstNumbering pass reserved a counter for every block that can be
+  // instrumented here, some of them may stay unused.
+  FunctionLiteral* literal = info()->literal();
+  if (block_counters_used_ >= literal->block_counter_count()) return;
+  int slot = literal->first_block_counter_slot().ToInt() + block_counters_used_;
+  block_counters_used_++;
+  builder()->IncBlockCounter(slot, Max(position, 0));
+}
+
 void BytecodeGenerator::VisitIterationHeader(IterationStatement* stmt,
                                              LoopBuilder* loop_builder) {
   // Recall that stmt->yield_count() is always zero inside ordinary
@@ -705,9 +755,13 @@ void BytecodeGenerator::VisitGeneratorPrologue() {
 
   // This is a resume call. Restore registers and perform state dispatch.
   // (The current context has already been restored by the trampoline.)
-  builder()
-      ->ResumeGenerator(generator_object)
-      .StoreAccumulatorInRegister(generator_state_);
+  if (FLAG_ignition_fast_generators) {
+    // Only fetch the state, every resume point restores its own registers.
+    builder()->ResumeGeneratorLive(generator_object, 0);
+  } else {
+    builder()->ResumeGenerator(generator_object);
+  }
+  builder()->StoreAccumulatorInRegister(generator_state_);
   BuildIndexedJump(generator_state_, 0, generator_resume_points_.size(),
                    generator_resume_points_);
 
@@ -919,10 +973,12 @@ void BytecodeGenerator::VisitIfStatement(IfStatement* stmt) {
   BytecodeLabel else_label, end_label;
   if (stmt->condition()->ToBooleanIsTrue()) {
     // Generate then block unconditionally as always true.
+    BuildIncrementBlockCounter(stmt->then_statement(), stmt);
     Visit(stmt->then_statement());
   } else if (stmt->condition()->ToBooleanIsFalse()) {
     // Generate else block unconditionally if it exists.
     if (stmt->HasElseStatement()) {
+      BuildIncrementBlockCounter(stmt->else_statement(), stmt);
       Visit(stmt->else_statement());
     }
   } else {
@@ -931,10 +987,12 @@ void BytecodeGenerator::VisitIfStatement(IfStatement* stmt) {
     // jump/jump_ifs here. See BasicLoops test.
     VisitForAccumulatorValue(stmt->condition());
     builder()->JumpIfFalse(&else_label);
+    BuildIncrementBlockCounter(stmt->then_statement(), stmt);
     Visit(stmt->then_statement());
     if (stmt->HasElseStatement()) {
       builder()->Jump(&end_label);
       builder()->Bind(&else_label);
+      BuildIncrementBlockCounter(stmt->else_statement(), stmt);
       Visit(stmt->else_statement());
     } else {
       builder()->Bind(&else_label);
@@ -1021,6 +1079,7 @@ void BytecodeGenerator::VisitSwitchStatement(SwitchStatement* stmt) {
   for (int i = 0; i < clauses->length(); i++) {
     CaseClause* clause = clauses->at(i);
     switch_builder.SetCaseTarget(i);
+    BuildIncrementBlockCounter(clause, stmt);
     VisitStatements(clause->statements());
   }
   builder()->Bind(&done_label);
@@ -1038,7 +1097,10 @@ void BytecodeGenerator::VisitIterationBody(IterationStatement* stmt,
                                            LoopBuilder* loop_builder) {
   ControlScopeForIteration execution_control(this, stmt, loop_builder);
   builder()->StackCheck(stmt->position());
+  BuildIncrementBlockCounter(stmt->body(), stmt);
+  loop_depth_++;
   Visit(stmt->body());
+  loop_depth_--;
 }
 
 void BytecodeGenerator::VisitDoWhileStatement(DoWhileStatement* stmt) {
@@ -1050,13 +1112,13 @@ void BytecodeGenerator::VisitDoWhileStatement(DoWhileStatement* stmt) {
   } else if (stmt->cond()->ToBooleanIsTrue()) {
     loop_builder.Condition();
     VisitIterationBody(stmt, &loop_builder);
-    loop_builder.JumpToHeader();
+    loop_builder.JumpToHeader(loop_depth_);
   } else {
     VisitIterationBody(stmt, &loop_builder);
     loop_builder.Condition();
     builder()->SetExpressionAsStatementPosition(stmt->cond());
     VisitForAccumulatorValue(stmt->cond());
-    loop_builder.JumpToHeaderIfTrue();
+    loop_builder.JumpToHeaderIfTrue(loop_depth_);
   }
   loop_builder.EndLoop();
 }
@@ -1076,7 +1138,7 @@ void BytecodeGenerator::VisitWhileStatement(WhileStatement* stmt) {
     loop_builder.BreakIfFalse();
   }
   VisitIterationBody(stmt, &loop_builder);
-  loop_builder.JumpToHeader();
+  loop_builder.JumpToHeader(loop_depth_);
   loop_builder.EndLoop();
 }
 
@@ -1105,7 +1167,7 @@ void BytecodeGenerator::VisitForStatement(ForStatement* stmt) {
     builder()->SetStatementPosition(stmt->next());
     Visit(stmt->next());
   }
-  loop_builder.JumpToHeader();
+  loop_builder.JumpToHeader(loop_depth_);
   loop_builder.EndLoop();
 }
 
@@ -1231,7 +1293,7 @@ void BytecodeGenerator::VisitForInStatement(ForInStatement* stmt) {
   loop_builder.Next();
   builder()->ForInStep(index);
   builder()->StoreAccumulatorInRegister(index);
-  loop_builder.JumpToHeader();
+  loop_builder.JumpToHeader(loop_depth_);
   loop_builder.EndLoop();
   builder()->Bind(&subject_null_label);
   builder()->Bind(&subject_undefined_label);
@@ -1254,7 +1316,7 @@ void BytecodeGenerator::VisitForOfStatement(ForOfStatement* stmt) {
 
   VisitForEffect(stmt->assign_each());
   VisitIterationBody(stmt, &loop_builder);
-  loop_builder.JumpToHeader();
+  loop_builder.JumpToHeader(loop_depth_);
   loop_builder.EndLoop();
 }
 
@@ -1291,6 +1353,7 @@ void BytecodeGenerator::VisitTryCatchStatement(TryCatchStatement* stmt) {
   builder()->LoadAccumulatorWithRegister(context);
 
   // Evaluate the catch-block.
+  BuildIncrementBlockCounter(stmt->catch_block(), stmt);
   VisitInScope(stmt->catch_block(), stmt->scope());
   try_control_builder.EndCatch();
 }
@@ -1554,10 +1617,12 @@ void BytecodeGenerator::VisitConditional(Conditional* expr) {
   VisitForAccumulatorValue(expr->condition());
   builder()->JumpIfFalse(&else_label);
 
+  BuildIncrementBlockCounter(expr->then_expression(), expr);
   VisitForAccumulatorValue(expr->then_expression());
   builder()->Jump(&end_label);
 
   builder()->Bind(&else_label);
+  BuildIncrementBlockCounter(expr->else_expression(), expr);
   VisitForAccumulatorValue(expr->else_expression());
   builder()->Bind(&end_label);
 
@@ -2285,15 +2350,27 @@ void BytecodeGenerator::VisitYield(Yield* expr) {
 
   Register generator = VisitForRegisterValue(expr->generator_object());
 
-  // Save context, registers, and state. Then return.
+  // Save context, registers, and state. Then return. Registers above the
+  // highest temporary still in use are dead and need not be saved.
+  int live_register_count = builder()->live_register_count();
+  builder()->LoadLiteral(Smi::FromInt(static_cast<int>(id)));
+  if (FLAG_ignition_fast_generators) {
+    builder()->SuspendGeneratorLive(generator, live_register_count);
+  } else {
+    builder()->SuspendGenerator(generator);
+  }
   builder()
-      ->LoadLiteral(Smi::FromInt(static_cast<int>(id)))
-      .SuspendGenerator(generator)
-      .LoadAccumulatorWithRegister(value)
+      ->LoadAccumulatorWithRegister(value)
       .Return();  // Hard return (ignore any finally blocks).
 
   builder()->Bind(&(generator_resume_points_[id]));
   // Upon resume, we continue here.
+  if (FLAG_ignition_fast_generators) {
+    // The generator object is still passed in the new.target register, the
+    // register holding it has not been restored yet.
+    builder()->ResumeGeneratorLive(Register::new_target(),
+                                   live_register_count);
+  }
 
   {
     RegisterAllocationScope register_scope(this);
@@ -2304,14 +2381,22 @@ void BytecodeGenerator::VisitYield(Yield* expr) {
         ->LoadLiteral(Smi::FromInt(JSGeneratorObject::kGeneratorExecuting))
         .StoreAccumulatorInRegister(generator_state_);
 
+    // With fast generators the intrinsics load the fields directly.
+    Runtime::FunctionId get_input = FLAG_ignition_fast_generators
+                                        ? Runtime::kInlineGeneratorGetInput
+                                        : Runtime::kGeneratorGetInput;
+    Runtime::FunctionId get_resume_mode =
+        FLAG_ignition_fast_generators ? Runtime::kInlineGeneratorGetResumeMode
+                                      : Runtime::kGeneratorGetResumeMode;
+
     Register input = register_allocator()->NewRegister();
     builder()
-        ->CallRuntime(Runtime::kGeneratorGetInput, generator, 1)
+        ->CallRuntime(get_input, generator, 1)
         .StoreAccumulatorInRegister(input);
 
     Register resume_mode = register_allocator()->NewRegister();
     builder()
-        ->CallRuntime(Runtime::kGeneratorGetResumeMode, generator, 1)
+        ->CallRuntime(get_resume_mode, generator, 1)
         .StoreAccumulatorInRegister(resume_mode);
 
     // Now dispatch on resume mode.
@@ -114,6 +114,12 @@ class BytecodeGenerator final : public AstVisitor {
   void BuildIndexedJump(Register value, size_t start_index, size_t size,
                         ZoneVector<BytecodeLabel>& targets);
 
+  // Build an increment of the next block counter of --block-coverage for the
+  // block |node|, which is reported at the position of |parent| if the block
+  // has no position of its own.
+  void BuildIncrementBlockCounter(AstNode* node, AstNode* parent);
+  void BuildIncrementBlockCounter(int position);
+
   void VisitGeneratorPrologue();
 
   void VisitArgumentsObject(Variable* variable);
@@ -211,8 +217,10 @@ class BytecodeGenerator final : public AstVisitor {
   ZoneVector<BytecodeLabel> generator_resume_points_;
   Register generator_state_;
   size_t generator_yields_seen_;
+  int loop_depth_;
   int try_catch_nesting_level_;
   int try_finally_nesting_level_;
+  int block_counters_used_;
 };
 
 }  // namespace interpreter
@@ -0,0 +1,319 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/interpreter/bytecode-peephole-optimizer.h"
+
+#include "src/interpreter/constant-array-builder.h"
+#include "src/objects-inl.h"
+
+namespace v8 {
+namespace internal {
+namespace interpreter {
+
+namespace {
+
+// Returns the compare-with-Smi form of the compare bytecode |bytecode|,
+// or Bytecode::kIllegal if there is none.
+Bytecode GetCompareWithSmi(Bytecode bytecode) {
+  switch (bytecode) {
+    case Bytecode::kTestEqual:
+      return Bytecode::kTestEqualSmi;
+    case Bytecode::kTestNotEqual:
+      return Bytecode::kTestNotEqualSmi;
+    case Bytecode::kTestEqualStrict:
+      return Bytecode::kTestEqualStrictSmi;
+    case Bytecode::kTestLessThan:
+      return Bytecode::kTestLessThanSmi;
+    case Bytecode::kTestGreaterThan:
+      return Bytecode::kTestGreaterThanSmi;
+    case Bytecode::kTestLessThanOrEqual:
+      return Bytecode::kTestLessThanOrEqualSmi;
+    case Bytecode::kTestGreaterThanOrEqual:
+      return Bytecode::kTestGreaterThanOrEqualSmi;
+    default:
+      return Bytecode::kIllegal;
+  }
+}
+
+// Returns true if |bytecode| loads the accumulator without reading
+// any other state that could be observed.
+bool IsAccumulatorLoadWithoutEffects(Bytecode bytecode) {
+  switch (bytecode) {
+    case Bytecode::kLdaZero:
+    case Bytecode::kLdaSmi:
+    case Bytecode::kLdaUndefined:
+    case Bytecode::kLdaNull:
+    case Bytecode::kLdaTheHole:
+    case Bytecode::kLdaTrue:
+    case Bytecode::kLdaFalse:
+    case Bytecode::kLdaConstant:
+    case Bytecode::kLdar:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Sign-extends the raw immediate |operand| encoded at |operand_scale|.
+int32_t DecodeImmediate(uint32_t operand, OperandScale operand_scale) {
+  switch (operand_scale) {
+    case OperandScale::kSingle:
+      return static_cast<int8_t>(operand);
+    case OperandScale::kDouble:
+      return static_cast<int16_t>(operand);
+    case OperandScale::kQuadruple:
+      return static_cast<int32_t>(operand);
+    default:
+      UNREACHABLE();
+      return 0;
+  }
+}
+
+// Encodes the immediate |value| for |operand_scale|.
+uint32_t EncodeImmediate(int32_t value, OperandScale operand_scale) {
+  switch (operand_scale) {
+    case OperandScale::kSingle:
+      return static_cast<uint8_t>(value & 0xff);
+    case OperandScale::kDouble:
+      return static_cast<uint16_t>(value & 0xffff);
+    case OperandScale::kQuadruple:
+      return static_cast<uint32_t>(value);
+    default:
+      UNREACHABLE();
+      return 0;
+  }
+}
+
+}  // namespace
+
+BytecodePeepholeOptimizer::BytecodePeepholeOptimizer(
+    ConstantArrayBuilder* constant_array_builder,
+    BytecodePipelineStage* next_stage)
+    : constant_array_builder_(constant_array_builder),
+      next_stage_(next_stage),
+      last_(Bytecode::kIllegal),
+      last_is_discardable_(true) {
+  InvalidateLast();
+}
+
+void BytecodePeepholeOptimizer::InvalidateLast() {
+  last_.set_bytecode(Bytecode::kIllegal);
+}
+
+bool BytecodePeepholeOptimizer::LastIsValid() const {
+  return last_.bytecode() != Bytecode::kIllegal;
+}
+
+void BytecodePeepholeOptimizer::SetLast(const BytecodeNode* const node) {
+  last_ = *node;
+  last_is_discardable_ = true;
+}
+
+// override
+size_t BytecodePeepholeOptimizer::FlushForOffset() {
+  size_t buffered_size = next_stage_->FlushForOffset();
+  if (LastIsValid()) {
+    buffered_size += last_.Size();
+    last_is_discardable_ = false;
+  }
+  return buffered_size;
+}
+
+// override
+void BytecodePeepholeOptimizer::FlushBasicBlock() {
+  if (LastIsValid()) {
+    next_stage_->Write(&last_);
+    InvalidateLast();
+  }
+  next_stage_->FlushBasicBlock();
+}
+
+// override
+void BytecodePeepholeOptimizer::Write(BytecodeNode* node) {
+  // Source positions of dropped bytecodes apply to the next bytecode
+  // that is emitted at the same offset.
+  if (pending_source_info_.is_valid()) {
+    BytecodeSourceInfo source_info = pending_source_info_;
+    source_info.Update(node->source_info());
+    node->source_info() = source_info;
+    pending_source_info_.set_invalid();
+  }
+
+  node = Optimize(node);
+  if (node == nullptr) return;
+
+  if (LastIsValid()) {
+    next_stage_->Write(&last_);
+  }
+  SetLast(node);
+}
+
+BytecodeNode* BytecodePeepholeOptimizer::Optimize(BytecodeNode* current) {
+  UpdateJumpForToBoolean(current);
+
+  if (CanElideCurrent(current)) {
+    pending_source_info_.Update(current->source_info());
+    return nullptr;
+  }
+
+  if (FLAG_ignition_fuse_bytecodes && CanCombineWithLast(current)) {
+    if (TryFuseCompareWithSmi(current) || CanElideLast(current)) {
+      BytecodeSourceInfo source_info = last_.source_info();
+      source_info.Update(current->source_info());
+      current->source_info() = source_info;
+      InvalidateLast();
+    }
+  }
+
+  if (FLAG_ignition_superinstructions && CanCombineWithLast(current) &&
+      TryFuseSuperinstruction(current)) {
+    BytecodeSourceInfo source_info = last_.source_info();
+    source_info.Update(current->source_info());
+    current->source_info() = source_info;
+    InvalidateLast();
+  }
+  return current;
+}
+
+void BytecodePeepholeOptimizer::UpdateJumpForToBoolean(
+    BytecodeNode* const current) {
+  // The BytecodeArrayBuilder always emits the ToBoolean form of
+  // conditional jumps. Drop the conversion if the accumulator is
+  // known to hold a boolean.
+  if (!LastBytecodePutsBooleanInAccumulator()) return;
+  switch (current->bytecode()) {
+    case Bytecode::kJumpIfToBooleanTrue:
+      current->set_bytecode(Bytecode::kJumpIfTrue);
+      break;
+    case Bytecode::kJumpIfToBooleanFalse:
+      current->set_bytecode(Bytecode::kJumpIfFalse);
+      break;
+    default:
+      break;
+  }
+}
+
+bool BytecodePeepholeOptimizer::CanElideCurrent(
+    const BytecodeNode* const current) const {
+  if (!LastIsValid()) return false;
+  switch (current->bytecode()) {
+    case Bytecode::kLdar:
+    case Bytecode::kStar:
+      // Transfers between the accumulator and a register that already
+      // holds the same value.
+      return (last_.bytecode() == Bytecode::kLdar ||
+              last_.bytecode() == Bytecode::kStar) &&
+             last_.operand(0) == current->operand(0);
+    case Bytecode::kToName:
+      return LastBytecodePutsNameInAccumulator();
+    default:
+      return false;
+  }
+}
+
+bool BytecodePeepholeOptimizer::CanCombineWithLast(
+    const BytecodeNode* const current) const {
+  // The last bytecode can only be removed if nothing has depended on
+  // its offset and the source positions of both bytecodes can be
+  // attached to a single bytecode without losing information.
+  return LastIsValid() && last_is_discardable_ &&
+         (!last_.source_info().is_valid() ||
+          !current->source_info().is_valid());
+}
+
+bool BytecodePeepholeOptimizer::CanElideLast(
+    const BytecodeNode* const current) const {
+  // An accumulator load is dead if the accumulator is overwritten
+  // without being read.
+  return IsAccumulatorLoadWithoutEffects(last_.bytecode()) &&
+         Bytecodes::WritesAccumulator(current->bytecode()) &&
+         !Bytecodes::ReadsAccumulator(current->bytecode());
+}
+
+bool BytecodePeepholeOptimizer::TryFuseCompareWithSmi(
+    BytecodeNode* const current) {
+  // LdaSmi <imm>; Test<op> <reg>  =>  Test<op>Smi <reg> <imm>
+  Bytecode fused = GetCompareWithSmi(current->bytecode());
+  if (fused == Bytecode::kIllegal) return false;
+
+  int32_t value;
+  if (last_.bytecode() == Bytecode::kLdaZero) {
+    value = 0;
+  } else if (last_.bytecode() == Bytecode::kLdaSmi) {
+    value = DecodeImmediate(last_.operand(0), last_.operand_scale());
+  } else {
+    return false;
+  }
+
+  OperandScale operand_scale =
+      std::max(last_.operand_scale(), current->operand_scale());
+  current->set_bytecode(fused, current->operand(0),
+                        EncodeImmediate(value, operand_scale), operand_scale);
+  return true;
+}
+
+bool BytecodePeepholeOptimizer::TryFuseSuperinstruction(
+    BytecodeNode* const current) {
+  // <first> <operands0>; <second> <operands1>
+  //   =>  <first><second> <operands0> <operands1>
+  Bytecode fused =
+      Bytecodes::GetSuperinstruction(last_.bytecode(), current->bytecode());
+  if (fused == Bytecode::kIllegal) return false;
+
+  // A single prefix scales all the operands of the superinstruction.
+  if (last_.operand_scale() != current->operand_scale()) return false;
+
+  DCHECK_EQ(2, Bytecodes::NumberOfOperands(fused));
+  DCHECK_EQ(1, last_.operand_count());
+  DCHECK_EQ(1, current->operand_count());
+  current->set_bytecode(fused, last_.operand(0), current->operand(0),
+                        current->operand_scale());
+  return true;
+}
+
+bool BytecodePeepholeOptimizer::LastBytecodePutsNameInAccumulator() const {
+  if (!LastIsValid()) return false;
+  switch (last_.bytecode()) {
+    case Bytecode::kToName:
+    case Bytecode::kTypeOf:
+      return true;
+    case Bytecode::kLdaConstant:
+      return constant_array_builder_->At(last_.operand(0))->IsName();
+    default:
+      return false;
+  }
+}
+
+bool BytecodePeepholeOptimizer::LastBytecodePutsBooleanInAccumulator() const {
+  if (!LastIsValid()) return false;
+  switch (last_.bytecode()) {
+    case Bytecode::kLdaTrue:
+    case Bytecode::kLdaFalse:
+    case Bytecode::kLogicalNot:
+    case Bytecode::kTestEqual:
+    case Bytecode::kTestNotEqual:
+    case Bytecode::kTestEqualStrict:
+    case Bytecode::kTestLessThan:
+    case Bytecode::kTestLessThanOrEqual:
+    case Bytecode::kTestGreaterThan:
+    case Bytecode::kTestGreaterThanOrEqual:
+    case Bytecode::kTestEqualSmi:
+    case Bytecode::kTestNotEqualSmi:
+    case Bytecode::kTestEqualStrictSmi:
+    case Bytecode::kTestLessThanSmi:
+    case Bytecode::kTestLessThanOrEqualSmi:
+    case Bytecode::kTestGreaterThanSmi:
+    case Bytecode::kTestGreaterThanOrEqualSmi:
+    case Bytecode::kTestInstanceOf:
+    case Bytecode::kTestIn:
+    case Bytecode::kForInDone:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace interpreter
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,74 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_INTERPRETER_BYTECODE_PEEPHOLE_OPTIMIZER_H_
+#define V8_INTERPRETER_BYTECODE_PEEPHOLE_OPTIMIZER_H_
+
+#include "src/interpreter/bytecode-pipeline.h"
+
+namespace v8 {
+namespace internal {
+namespace interpreter {
+
+class ConstantArrayBuilder;
+
+// An optimization stage for performing peephole optimizations on
+// generated bytecode. The optimizer may buffer one bytecode
+// internally. Bytecodes are only combined or removed within a basic
+// block, and a bytecode is never removed once its offset has been
+// observed through FlushForOffset().
+//
+// Redundant register transfers, ToName casts and ToBoolean jumps are
+// always elided. When --ignition-fuse-bytecodes is enabled the
+// optimizer additionally removes accumulator loads that are
+// overwritten before being read and folds a Smi load followed by a
+// comparison into a compare-with-Smi bytecode. When
+// --ignition-superinstructions is enabled, pairs of bytecodes listed in
+// SUPERINSTRUCTION_LIST are combined into their superinstruction.
+class BytecodePeepholeOptimizer final : public BytecodePipelineStage,
+                                        public ZoneObject {
+ public:
+  BytecodePeepholeOptimizer(ConstantArrayBuilder* constant_array_builder,
+                            BytecodePipelineStage* next_stage);
+
+  // BytecodePipelineStage interface.
+  void Write(BytecodeNode* node) override;
+  size_t FlushForOffset() override;
+  void FlushBasicBlock() override;
+
+ private:
+  // Returns |current| with any transformation applied, or nullptr if
+  // |current| is redundant and should be dropped.
+  BytecodeNode* Optimize(BytecodeNode* current);
+
+  void UpdateJumpForToBoolean(BytecodeNode* const current);
+  bool CanElideCurrent(const BytecodeNode* const current) const;
+  bool CanCombineWithLast(const BytecodeNode* const current) const;
+  bool CanElideLast(const BytecodeNode* const current) const;
+  bool TryFuseCompareWithSmi(BytecodeNode* const current);
+  bool TryFuseSuperinstruction(BytecodeNode* const current);
+
+  bool LastIsValid() const;
+  void InvalidateLast();
+  void SetLast(const BytecodeNode* const node);
+
+  bool LastBytecodePutsNameInAccumulator() const;
+  bool LastBytecodePutsBooleanInAccumulator() const;
+
+  ConstantArrayBuilder* constant_array_builder_;
+  BytecodePipelineStage* next_stage_;
+  BytecodeNode last_;
+  bool last_is_discardable_;
+  // Source information of dropped bytecodes, attached to the next
+  // bytecode written.
+  BytecodeSourceInfo pending_source_info_;
+
+  DISALLOW_COPY_AND_ASSIGN(BytecodePeepholeOptimizer);
+};
+
+}  // namespace interpreter
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_INTERPRETER_BYTECODE_PEEPHOLE_OPTIMIZER_H_
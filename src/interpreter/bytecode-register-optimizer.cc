@@ -0,0 +1,481 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/interpreter/bytecode-register-optimizer.h"
+
+#include "src/interpreter/bytecode-array-builder.h"
+
+namespace v8 {
+namespace internal {
+namespace interpreter {
+
+const uint32_t BytecodeRegisterOptimizer::kInvalidEquivalenceId;
+
+// A class for tracking the state of a register. This class tracks
+// which equivalence set a register is a member of and also whether a
+// register is materialized in the bytecode stream. Members of an
+// equivalence set are linked in a circular doubly-linked list.
+class BytecodeRegisterOptimizer::RegisterInfo final : public ZoneObject {
+ public:
+  RegisterInfo(Register reg, uint32_t equivalence_id, bool materialized)
+      : register_(reg),
+        equivalence_id_(equivalence_id),
+        materialized_(materialized),
+        next_(this),
+        prev_(this) {}
+
+  // Removes this register from its current equivalence set and adds
+  // it to the equivalence set of |info|. The register is not
+  // materialized afterwards.
+  void AddToEquivalenceSetOf(RegisterInfo* info);
+
+  // Removes this register from its current equivalence set and moves
+  // it into a new set |equivalence_id| of its own.
+  void MoveToNewEquivalenceSet(uint32_t equivalence_id, bool materialized);
+
+  bool IsOnlyMemberOfEquivalenceSet() const { return next_ == this; }
+
+  bool IsInSameEquivalenceSet(const RegisterInfo* info) const {
+    return equivalence_id() == info->equivalence_id();
+  }
+
+  // Returns a materialized member of the equivalence set, preferring
+  // this register, or nullptr if there is none.
+  RegisterInfo* GetMaterializedEquivalent();
+
+  // Returns a materialized member of the equivalence set other than
+  // this register and |excluded|, or nullptr if there is none.
+  RegisterInfo* GetMaterializedEquivalentOtherThan(
+      const RegisterInfo* excluded);
+
+  // Returns a member of the equivalence set that is not materialized,
+  // or nullptr if there is none.
+  RegisterInfo* GetEquivalentToMaterialize();
+
+  RegisterInfo* next() const { return next_; }
+
+  Register register_value() const { return register_; }
+  bool materialized() const { return materialized_; }
+  void set_materialized(bool materialized) { materialized_ = materialized; }
+  uint32_t equivalence_id() const { return equivalence_id_; }
+
+ private:
+  void Unlink();
+
+  Register register_;
+  uint32_t equivalence_id_;
+  bool materialized_;
+  RegisterInfo* next_;
+  RegisterInfo* prev_;
+
+  DISALLOW_COPY_AND_ASSIGN(RegisterInfo);
+};
+
+void BytecodeRegisterOptimizer::RegisterInfo::Unlink() {
+  prev_->next_ = next_;
+  next_->prev_ = prev_;
+  next_ = prev_ = this;
+}
+
+void BytecodeRegisterOptimizer::RegisterInfo::AddToEquivalenceSetOf(
+    RegisterInfo* info) {
+  DCHECK_NE(this, info);
+  Unlink();
+  // Insert into the circular list after |info|.
+  next_ = info->next_;
+  prev_ = info;
+  info->next_->prev_ = this;
+  info->next_ = this;
+  equivalence_id_ = info->equivalence_id();
+  materialized_ = false;
+}
+
+void BytecodeRegisterOptimizer::RegisterInfo::MoveToNewEquivalenceSet(
+    uint32_t equivalence_id, bool materialized) {
+  Unlink();
+  equivalence_id_ = equivalence_id;
+  materialized_ = materialized;
+}
+
+BytecodeRegisterOptimizer::RegisterInfo*
+BytecodeRegisterOptimizer::RegisterInfo::GetMaterializedEquivalent() {
+  RegisterInfo* visitor = this;
+  do {
+    if (visitor->materialized()) return visitor;
+    visitor = visitor->next_;
+  } while (visitor != this);
+  return nullptr;
+}
+
+BytecodeRegisterOptimizer::RegisterInfo*
+BytecodeRegisterOptimizer::RegisterInfo::GetMaterializedEquivalentOtherThan(
+    const RegisterInfo* excluded) {
+  for (RegisterInfo* visitor = next_; visitor != this;
+       visitor = visitor->next_) {
+    if (visitor->materialized() && visitor != excluded) return visitor;
+  }
+  return nullptr;
+}
+
+BytecodeRegisterOptimizer::RegisterInfo*
+BytecodeRegisterOptimizer::RegisterInfo::GetEquivalentToMaterialize() {
+  for (RegisterInfo* visitor = next_; visitor != this;
+       visitor = visitor->next_) {
+    if (!visitor->materialized()) return visitor;
+  }
+  return nullptr;
+}
+
+BytecodeRegisterOptimizer::BytecodeRegisterOptimizer(
+    Zone* zone, TemporaryRegisterAllocator* register_allocator,
+    int parameter_count, BytecodePipelineStage* next_stage)
+    : temporary_base_(register_allocator->allocation_base()),
+      accumulator_info_(nullptr),
+      register_info_table_(zone),
+      equivalence_id_(0),
+      next_stage_(next_stage),
+      flush_required_(false),
+      zone_(zone) {
+  register_allocator->set_observer(this);
+
+  // Parameters are the lowest register indices, so the table is
+  // offset to make the first parameter index zero.
+  register_info_table_offset_ =
+      -Register::FromParameterIndex(0, parameter_count).index();
+
+  // Initialize register map for parameters, locals, and the
+  // accumulator. The accumulator is not a real register and is
+  // represented by an invalid Register.
+  register_info_table_.resize(register_info_table_offset_ +
+                              static_cast<size_t>(temporary_base_.index()));
+  for (size_t i = 0; i < register_info_table_.size(); ++i) {
+    Register reg(static_cast<int>(i) - register_info_table_offset_);
+    register_info_table_[i] =
+        new (zone) RegisterInfo(reg, NextEquivalenceId(), true);
+  }
+  accumulator_info_ =
+      new (zone) RegisterInfo(Register(), NextEquivalenceId(), true);
+}
+
+void BytecodeRegisterOptimizer::Write(BytecodeNode* node) {
+  switch (node->bytecode()) {
+    case Bytecode::kLdar:
+      DoLdar(node);
+      return;
+    case Bytecode::kStar:
+      DoStar(node);
+      return;
+    case Bytecode::kMov:
+      DoMov(node);
+      return;
+    default:
+      break;
+  }
+
+  // Bytecodes that leave the basic block, suspend the frame or expose
+  // the whole register file see all registers materialized. PushContext
+  // and PopContext implicitly write registers, so flushing keeps every
+  // location they touch out of any equivalence set.
+  if (Bytecodes::IsJump(node->bytecode()) ||
+      node->bytecode() == Bytecode::kDebugger ||
+      node->bytecode() == Bytecode::kOsrPoll ||
+      node->bytecode() == Bytecode::kSuspendGenerator ||
+      node->bytecode() == Bytecode::kResumeGenerator ||
+      node->bytecode() == Bytecode::kSuspendGeneratorLive ||
+      node->bytecode() == Bytecode::kResumeGeneratorLive ||
+      node->bytecode() == Bytecode::kPushContext ||
+      node->bytecode() == Bytecode::kPopContext) {
+    FlushState();
+  }
+
+  PrepareOperands(node);
+  WriteToNextStage(node);
+
+  switch (node->bytecode()) {
+    case Bytecode::kReturn:
+    case Bytecode::kThrow:
+    case Bytecode::kReThrow:
+      // Nothing in the current basic block is reachable any more.
+      DiscardState();
+      break;
+    default:
+      break;
+  }
+}
+
+size_t BytecodeRegisterOptimizer::FlushForOffset() {
+  FlushState();
+  return next_stage_->FlushForOffset();
+}
+
+void BytecodeRegisterOptimizer::FlushBasicBlock() {
+  FlushState();
+  next_stage_->FlushBasicBlock();
+}
+
+void BytecodeRegisterOptimizer::FlushState() {
+  if (!flush_required_) return;
+
+  // Materialize all sets and then turn them into singletons.
+  for (size_t i = 0; i <= register_info_table_.size(); ++i) {
+    RegisterInfo* info = i < register_info_table_.size()
+                             ? register_info_table_[i]
+                             : accumulator_info_;
+    if (info->IsOnlyMemberOfEquivalenceSet()) continue;
+    RegisterInfo* materialized = info->GetMaterializedEquivalent();
+    DCHECK_NOT_NULL(materialized);
+    RegisterInfo* equivalent;
+    while ((equivalent = materialized->GetEquivalentToMaterialize()) !=
+           nullptr) {
+      OutputRegisterTransfer(materialized, equivalent, BytecodeSourceInfo());
+    }
+    while (!materialized->IsOnlyMemberOfEquivalenceSet()) {
+      materialized->next()->MoveToNewEquivalenceSet(NextEquivalenceId(),
+                                                    true);
+    }
+  }
+
+  flush_required_ = false;
+}
+
+void BytecodeRegisterOptimizer::DiscardState() {
+  for (size_t i = 0; i < register_info_table_.size(); ++i) {
+    register_info_table_[i]->MoveToNewEquivalenceSet(NextEquivalenceId(),
+                                                     true);
+  }
+  accumulator_info_->MoveToNewEquivalenceSet(NextEquivalenceId(), true);
+  flush_required_ = false;
+}
+
+void BytecodeRegisterOptimizer::WriteToNextStage(BytecodeNode* node) {
+  if (pending_source_info_.is_valid()) {
+    pending_source_info_.Update(node->source_info());
+    node->source_info() = pending_source_info_;
+    pending_source_info_.set_invalid();
+  }
+  next_stage_->Write(node);
+}
+
+void BytecodeRegisterOptimizer::OutputRegisterTransfer(
+    RegisterInfo* input, RegisterInfo* output,
+    const BytecodeSourceInfo& source_info) {
+  Register input_reg = input->register_value();
+  Register output_reg = output->register_value();
+  DCHECK(input_reg != output_reg);
+
+  BytecodeNode node;
+  if (output == accumulator_info_) {
+    node = BytecodeNode(
+        Bytecode::kLdar, BytecodeArrayBuilder::RegisterOperand(input_reg),
+        BytecodeArrayBuilder::OperandSizesToScale(input_reg.SizeOfOperand()));
+  } else if (input == accumulator_info_) {
+    node = BytecodeNode(
+        Bytecode::kStar, BytecodeArrayBuilder::RegisterOperand(output_reg),
+        BytecodeArrayBuilder::OperandSizesToScale(output_reg.SizeOfOperand()));
+  } else {
+    node = BytecodeNode(Bytecode::kMov,
+                        BytecodeArrayBuilder::RegisterOperand(input_reg),
+                        BytecodeArrayBuilder::RegisterOperand(output_reg),
+                        BytecodeArrayBuilder::OperandSizesToScale(
+                            input_reg.SizeOfOperand(),
+                            output_reg.SizeOfOperand()));
+  }
+  node.source_info() = source_info;
+  WriteToNextStage(&node);
+  output->set_materialized(true);
+}
+
+void BytecodeRegisterOptimizer::CreateMaterializedEquivalent(
+    RegisterInfo* info) {
+  DCHECK(info->materialized());
+  if (info->GetMaterializedEquivalentOtherThan(nullptr) != nullptr) return;
+  RegisterInfo* unmaterialized = info->GetEquivalentToMaterialize();
+  if (unmaterialized != nullptr) {
+    OutputRegisterTransfer(info, unmaterialized, BytecodeSourceInfo());
+  }
+}
+
+void BytecodeRegisterOptimizer::Materialize(RegisterInfo* info) {
+  if (info->materialized()) return;
+  RegisterInfo* materialized = info->GetMaterializedEquivalent();
+  if (materialized == nullptr) {
+    // A register that has been returned to the allocator and is read
+    // before being written again. Its contents are unspecified.
+    info->set_materialized(true);
+    return;
+  }
+  OutputRegisterTransfer(materialized, info, BytecodeSourceInfo());
+}
+
+void BytecodeRegisterOptimizer::RegisterTransfer(
+    RegisterInfo* input, RegisterInfo* output,
+    const BytecodeSourceInfo& source_info) {
+  // The transfer is redundant if both locations already hold the same
+  // value. Keep the source position for the next bytecode.
+  if (output->IsInSameEquivalenceSet(input)) {
+    pending_source_info_.Update(source_info);
+    return;
+  }
+
+  // Preserve the old value of |output| if no other location holds it.
+  if (output->materialized()) {
+    CreateMaterializedEquivalent(output);
+  }
+
+  output->AddToEquivalenceSetOf(input);
+  flush_required_ = true;
+
+  if (RegisterIsObservable(output)) {
+    // Observable registers always hold their value.
+    RegisterInfo* materialized = input->GetMaterializedEquivalent();
+    if (materialized == nullptr) {
+      input->set_materialized(true);
+      materialized = input;
+    }
+    OutputRegisterTransfer(materialized, output, source_info);
+  } else {
+    pending_source_info_.Update(source_info);
+  }
+}
+
+void BytecodeRegisterOptimizer::DoLdar(const BytecodeNode* const node) {
+  Register input = BytecodeArrayBuilder::RegisterFromOperand(node->operand(0));
+  RegisterTransfer(GetRegisterInfo(input), accumulator_info_,
+                   node->source_info());
+}
+
+void BytecodeRegisterOptimizer::DoStar(const BytecodeNode* const node) {
+  Register output = BytecodeArrayBuilder::RegisterFromOperand(node->operand(0));
+  RegisterTransfer(accumulator_info_, GetRegisterInfo(output),
+                   node->source_info());
+}
+
+void BytecodeRegisterOptimizer::DoMov(const BytecodeNode* const node) {
+  Register input = BytecodeArrayBuilder::RegisterFromOperand(node->operand(0));
+  Register output = BytecodeArrayBuilder::RegisterFromOperand(node->operand(1));
+  RegisterTransfer(GetRegisterInfo(input), GetRegisterInfo(output),
+                   node->source_info());
+}
+
+void BytecodeRegisterOptimizer::PrepareOperands(BytecodeNode* const node) {
+  Bytecode bytecode = node->bytecode();
+  int operand_count = node->operand_count();
+
+  // Materialize inputs before preparing outputs so that an output never
+  // clobbers a location the bytecode reads.
+  // Return is not marked as reading the accumulator but returns its
+  // value.
+  if (Bytecodes::ReadsAccumulator(bytecode) || bytecode == Bytecode::kReturn) {
+    Materialize(accumulator_info_);
+  }
+  for (int i = 0; i < operand_count; ++i) {
+    OperandType operand_type = Bytecodes::GetOperandType(bytecode, i);
+    if (!Bytecodes::IsRegisterInputOperandType(operand_type)) continue;
+    Register reg = BytecodeArrayBuilder::RegisterFromOperand(node->operand(i));
+    if (i + 1 < operand_count &&
+        Bytecodes::GetOperandType(bytecode, i + 1) == OperandType::kRegCount) {
+      PrepareRegisterRangeInputOperand(reg,
+                                       static_cast<int>(node->operand(i + 1)));
+    } else if (operand_type == OperandType::kRegPair) {
+      PrepareRegisterRangeInputOperand(reg, 2);
+    } else {
+      PrepareRegisterInputOperand(node, i);
+    }
+  }
+
+  for (int i = 0; i < operand_count; ++i) {
+    OperandType operand_type = Bytecodes::GetOperandType(bytecode, i);
+    if (!Bytecodes::IsRegisterOutputOperandType(operand_type)) continue;
+    Register reg = BytecodeArrayBuilder::RegisterFromOperand(node->operand(i));
+    int count = 1;
+    if (operand_type == OperandType::kRegOutPair) {
+      count = 2;
+    } else if (operand_type == OperandType::kRegOutTriple) {
+      count = 3;
+    }
+    for (int j = 0; j < count; ++j) {
+      PrepareRegisterOutput(GetRegisterInfo(Register(reg.index() + j)));
+    }
+  }
+  if (Bytecodes::WritesAccumulator(bytecode)) {
+    PrepareRegisterOutput(accumulator_info_);
+  }
+}
+
+void BytecodeRegisterOptimizer::PrepareRegisterInputOperand(
+    BytecodeNode* const node, int index) {
+  Register reg =
+      BytecodeArrayBuilder::RegisterFromOperand(node->operand(index));
+  RegisterInfo* info = GetRegisterInfo(reg);
+  if (info->materialized()) return;
+
+  // Read the value from an equivalent register that already holds it
+  // rather than emitting a transfer, provided the operand still fits
+  // the operand scale of the bytecode.
+  RegisterInfo* equivalent =
+      info->GetMaterializedEquivalentOtherThan(accumulator_info_);
+  if (equivalent != nullptr &&
+      BytecodeArrayBuilder::OperandSizesToScale(
+          equivalent->register_value().SizeOfOperand()) <=
+          node->operand_scale()) {
+    node->operands()[index] =
+        BytecodeArrayBuilder::RegisterOperand(equivalent->register_value());
+    return;
+  }
+  Materialize(info);
+}
+
+void BytecodeRegisterOptimizer::PrepareRegisterRangeInputOperand(Register start,
+                                                                 int count) {
+  for (int i = 0; i < count; ++i) {
+    Materialize(GetRegisterInfo(Register(start.index() + i)));
+  }
+}
+
+void BytecodeRegisterOptimizer::PrepareRegisterOutput(RegisterInfo* info) {
+  if (info->materialized()) {
+    CreateMaterializedEquivalent(info);
+  }
+  info->MoveToNewEquivalenceSet(NextEquivalenceId(), true);
+}
+
+void BytecodeRegisterOptimizer::TemporaryRegisterFreeEvent(Register reg) {
+  RegisterInfo* info = GetRegisterInfo(reg);
+  if (info->materialized()) {
+    CreateMaterializedEquivalent(info);
+  }
+  // The register holds no useful value until it is written again.
+  info->MoveToNewEquivalenceSet(NextEquivalenceId(), false);
+}
+
+bool BytecodeRegisterOptimizer::RegisterIsObservable(
+    const RegisterInfo* info) const {
+  return info != accumulator_info_ &&
+         !RegisterIsTemporary(info->register_value());
+}
+
+BytecodeRegisterOptimizer::RegisterInfo*
+BytecodeRegisterOptimizer::GetRegisterInfo(Register reg) {
+  DCHECK_GE(reg.index() + register_info_table_offset_, 0);
+  size_t index = static_cast<size_t>(reg.index() + register_info_table_offset_);
+  if (index >= register_info_table_.size()) {
+    GrowRegisterMap(reg);
+  }
+  return register_info_table_[index];
+}
+
+void BytecodeRegisterOptimizer::GrowRegisterMap(Register reg) {
+  size_t index = static_cast<size_t>(reg.index() + register_info_table_offset_);
+  size_t old_size = register_info_table_.size();
+  register_info_table_.resize(index + 1);
+  for (size_t i = old_size; i <= index; ++i) {
+    Register new_reg(static_cast<int>(i) - register_info_table_offset_);
+    register_info_table_[i] =
+        new (zone()) RegisterInfo(new_reg, NextEquivalenceId(), true);
+  }
+}
+
+}  // namespace interpreter
+}  // namespace internal
+}  // namespace v8
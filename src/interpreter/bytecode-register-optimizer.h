@@ -0,0 +1,124 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_INTERPRETER_BYTECODE_REGISTER_OPTIMIZER_H_
+#define V8_INTERPRETER_BYTECODE_REGISTER_OPTIMIZER_H_
+
+#include "src/interpreter/bytecode-pipeline.h"
+#include "src/interpreter/bytecode-register-allocator.h"
+
+namespace v8 {
+namespace internal {
+namespace interpreter {
+
+// An optimization stage for eliminating unnecessary transfers between
+// registers. The bytecode generator uses temporary registers
+// liberally for correctness and convenience and this stage removes
+// transfers that are not required and preserves correctness.
+//
+// Registers and the accumulator are grouped into equivalence sets of
+// locations that hold the same value. Transfers into the accumulator
+// and temporary registers (Ldar, Star, Mov) only update the sets and
+// are emitted lazily, when a bytecode reads a location that does not
+// yet physically hold its value, or when the location is about to be
+// overwritten while it is the only materialized copy of the value.
+// Parameters, locals and the special registers are observable by the
+// debugger and by deoptimization, so transfers into them are always
+// emitted. All state is flushed at basic block boundaries.
+class BytecodeRegisterOptimizer final : public BytecodePipelineStage,
+                                        public TemporaryRegisterObserver,
+                                        public ZoneObject {
+ public:
+  BytecodeRegisterOptimizer(Zone* zone,
+                            TemporaryRegisterAllocator* register_allocator,
+                            int parameter_count,
+                            BytecodePipelineStage* next_stage);
+  virtual ~BytecodeRegisterOptimizer() {}
+
+  // BytecodePipelineStage interface.
+  void Write(BytecodeNode* node) override;
+  size_t FlushForOffset() override;
+  void FlushBasicBlock() override;
+
+ private:
+  static const uint32_t kInvalidEquivalenceId = kMaxUInt32;
+
+  class RegisterInfo;
+
+  // TemporaryRegisterObserver interface.
+  void TemporaryRegisterFreeEvent(Register reg) override;
+
+  // Emits transfers so that every location holds its value and resets
+  // all equivalence sets to singletons.
+  void FlushState();
+  // Resets all equivalence sets without emitting anything. Used after
+  // bytecodes that leave the function.
+  void DiscardState();
+
+  void WriteToNextStage(BytecodeNode* node);
+  void OutputRegisterTransfer(RegisterInfo* input, RegisterInfo* output,
+                              const BytecodeSourceInfo& source_info);
+
+  // Ensures that the value held by |info| survives |info| being
+  // overwritten by materializing another member of its set if needed.
+  void CreateMaterializedEquivalent(RegisterInfo* info);
+  // Emits a transfer into |info| if it does not hold its value.
+  void Materialize(RegisterInfo* info);
+
+  void RegisterTransfer(RegisterInfo* input, RegisterInfo* output,
+                        const BytecodeSourceInfo& source_info);
+  void DoLdar(const BytecodeNode* const node);
+  void DoStar(const BytecodeNode* const node);
+  void DoMov(const BytecodeNode* const node);
+
+  void PrepareOperands(BytecodeNode* const node);
+  void PrepareRegisterInputOperand(BytecodeNode* const node, int index);
+  void PrepareRegisterRangeInputOperand(Register start, int count);
+  void PrepareRegisterOutput(RegisterInfo* info);
+
+  RegisterInfo* GetRegisterInfo(Register reg);
+  void GrowRegisterMap(Register reg);
+
+  bool RegisterIsTemporary(Register reg) const {
+    return reg >= temporary_base_;
+  }
+  // Returns true if the value held by |info| can be observed by the
+  // debugger or the deoptimizer, i.e. |info| is neither the
+  // accumulator nor a temporary register.
+  bool RegisterIsObservable(const RegisterInfo* info) const;
+
+  uint32_t NextEquivalenceId() {
+    equivalence_id_++;
+    CHECK_NE(equivalence_id_, kInvalidEquivalenceId);
+    return equivalence_id_;
+  }
+
+  Zone* zone() { return zone_; }
+
+  const Register temporary_base_;
+  RegisterInfo* accumulator_info_;
+
+  // Table of RegisterInfo objects indexed by register index plus
+  // |register_info_table_offset_|, so that parameters can be stored.
+  ZoneVector<RegisterInfo*> register_info_table_;
+  int register_info_table_offset_;
+
+  // Counter for equivalence sets identifiers.
+  uint32_t equivalence_id_;
+
+  BytecodePipelineStage* next_stage_;
+  bool flush_required_;
+  // Source information of dropped transfers, attached to the next
+  // bytecode written.
+  BytecodeSourceInfo pending_source_info_;
+  Zone* zone_;
+
+  DISALLOW_COPY_AND_ASSIGN(BytecodeRegisterOptimizer);
+};
+
+}  // namespace interpreter
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_INTERPRETER_BYTECODE_REGISTER_OPTIMIZER_H_
@@ -370,6 +370,47 @@ bool Bytecodes::IsDebugBreak(Bytecode bytecode) {
   return false;
 }
 
+// static
+bool Bytecodes::IsSuperinstruction(Bytecode bytecode) {
+  switch (bytecode) {
+#define CASE(Name, ...) case Bytecode::k##Name:
+    SUPERINSTRUCTION_LIST(CASE);
+#undef CASE
+    return true;
+    default:
+      break;
+  }
+  return false;
+}
+
+// static
+Bytecode Bytecodes::GetSuperinstruction(Bytecode first, Bytecode second) {
+#define RETURN_IF_COMPONENTS_MATCH(Name, First, Second)               \
+  if (first == Bytecode::k##First && second == Bytecode::k##Second) { \
+    return Bytecode::k##Name;                                         \
+  }
+  SUPERINSTRUCTION_LIST(RETURN_IF_COMPONENTS_MATCH)
+#undef RETURN_IF_COMPONENTS_MATCH
+  return Bytecode::kIllegal;
+}
+
+// static
+Bytecode Bytecodes::GetSuperinstructionComponent(Bytecode bytecode,
+                                                 int index) {
+  DCHECK(index == 0 || index == 1);
+  switch (bytecode) {
+#define CASE(Name, First, Second) \
+  case Bytecode::k##Name:         \
+    return index == 0 ? Bytecode::k##First : Bytecode::k##Second;
+    SUPERINSTRUCTION_LIST(CASE)
+#undef CASE
+    default:
+      break;
+  }
+  UNREACHABLE();
+  return Bytecode::kIllegal;
+}
+
 // static
 bool Bytecodes::IsBytecodeWithScalableOperands(Bytecode bytecode) {
   switch (bytecode) {
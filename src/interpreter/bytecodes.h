@@ -186,6 +186,22 @@ namespace interpreter {
   V(TestInstanceOf, AccumulatorUse::kReadWrite, OperandType::kReg)            \
   V(TestIn, AccumulatorUse::kReadWrite, OperandType::kReg)                    \
                                                                               \
+  /* Test Operators with Smi immediate */                                     \
+  V(TestEqualSmi, AccumulatorUse::kWrite, OperandType::kReg,                  \
+    OperandType::kImm)                                                        \
+  V(TestNotEqualSmi, AccumulatorUse::kWrite, OperandType::kReg,               \
+    OperandType::kImm)                                                        \
+  V(TestEqualStrictSmi, AccumulatorUse::kWrite, OperandType::kReg,            \
+    OperandType::kImm)                                                        \
+  V(TestLessThanSmi, AccumulatorUse::kWrite, OperandType::kReg,               \
+    OperandType::kImm)                                                        \
+  V(TestGreaterThanSmi, AccumulatorUse::kWrite, OperandType::kReg,            \
+    OperandType::kImm)                                                        \
+  V(TestLessThanOrEqualSmi, AccumulatorUse::kWrite, OperandType::kReg,        \
+    OperandType::kImm)                                                        \
+  V(TestGreaterThanOrEqualSmi, AccumulatorUse::kWrite, OperandType::kReg,     \
+    OperandType::kImm)                                                        \
+                                                                              \
   /* Cast operators */                                                        \
   V(ToName, AccumulatorUse::kReadWrite)                                       \
   V(ToNumber, AccumulatorUse::kReadWrite)                                     \
@@ -236,6 +252,13 @@ namespace interpreter {
   /* Perform a stack guard check */                                           \
   V(StackCheck, AccumulatorUse::kNone)                                        \
                                                                               \
+  /* Perform a check to trigger on-stack replacement */                       \
+  V(OsrPoll, AccumulatorUse::kNone, OperandType::kImm)                        \
+                                                                              \
+  /* Block coverage */                                                        \
+  V(IncBlockCounter, AccumulatorUse::kNone, OperandType::kIdx,                \
+    OperandType::kIdx)                                                        \
+                                                                              \
   /* Non-local flow control */                                                \
   V(Throw, AccumulatorUse::kRead)                                             \
   V(ReThrow, AccumulatorUse::kRead)                                           \
@@ -244,6 +267,18 @@ namespace interpreter {
   /* Generators */                                                            \
   V(SuspendGenerator, AccumulatorUse::kRead, OperandType::kReg)               \
   V(ResumeGenerator, AccumulatorUse::kWrite, OperandType::kReg)               \
+  V(SuspendGeneratorLive, AccumulatorUse::kRead, OperandType::kReg,           \
+    OperandType::kIdx)                                                        \
+  V(ResumeGeneratorLive, AccumulatorUse::kWrite, OperandType::kReg,           \
+    OperandType::kIdx)                                                        \
+                                                                              \
+  /* Superinstructions, see SUPERINSTRUCTION_LIST */                          \
+  V(StarLdar, AccumulatorUse::kReadWrite, OperandType::kRegOut,               \
+    OperandType::kReg)                                                        \
+  V(LdarAdd, AccumulatorUse::kWrite, OperandType::kReg, OperandType::kReg)    \
+  V(LdaSmiAdd, AccumulatorUse::kWrite, OperandType::kImm, OperandType::kReg)  \
+  V(LdaSmiStar, AccumulatorUse::kWrite, OperandType::kImm,                    \
+    OperandType::kRegOut)                                                     \
                                                                               \
   /* Debugger */                                                              \
   V(Debugger, AccumulatorUse::kNone)                                          \
@@ -252,6 +287,21 @@ namespace interpreter {
   /* Illegal bytecode (terminates execution) */                               \
   V(Illegal, AccumulatorUse::kNone)
 
+// The list of superinstructions. A superinstruction performs the bytecode
+// |First| followed by the bytecode |Second| with a single dispatch. Its
+// operands are the operands of |First| followed by the operands of
+// |Second|, and it is declared in BYTECODE_LIST with the accumulator use
+// of the pair. The pairs are picked from bytecode dispatch frequencies
+// (see --trace-ignition-dispatches). Only |Second| may call or deoptimize,
+// |First| must be a side-effect free transfer so that the pair can be
+// re-executed from its start. Both components are generated from their
+// regular handlers and hence must not contain control flow.
+#define SUPERINSTRUCTION_LIST(V) \
+  V(StarLdar, Star, Ldar)        \
+  V(LdarAdd, Ldar, Add)          \
+  V(LdaSmiAdd, LdaSmi, Add)      \
+  V(LdaSmiStar, LdaSmi, Star)
+
 enum class AccumulatorUse : uint8_t {
   kNone = 0,
   kRead = 1 << 0,
@@ -526,6 +576,16 @@ class Bytecodes {
   // Returns true if the bytecode is a debug break.
   static bool IsDebugBreak(Bytecode bytecode);
 
+  // Returns true if the bytecode is a superinstruction.
+  static bool IsSuperinstruction(Bytecode bytecode);
+
+  // Returns the superinstruction performing |first| followed by |second|,
+  // or Bytecode::kIllegal if there is none.
+  static Bytecode GetSuperinstruction(Bytecode first, Bytecode second);
+
+  // Returns the |index|-th component of the superinstruction |bytecode|.
+  static Bytecode GetSuperinstructionComponent(Bytecode bytecode, int index);
+
   // Returns true if the bytecode has wider operand forms.
   static bool IsBytecodeWithScalableOperands(Bytecode bytecode);
 
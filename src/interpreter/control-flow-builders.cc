@@ -103,6 +103,33 @@ void LoopBuilder::LoopHeader(ZoneVector<BytecodeLabel>* additional_labels) {
 }
 
 
+void LoopBuilder::JumpToHeader(int loop_depth) {
+  // Loops always jump backwards.
+  DCHECK(loop_header_.is_bound());
+  if (FLAG_ignition_osr) {
+    // Poll for on-stack replacement on the back edge. The frame here
+    // holds exactly the values that flow into the loop header.
+    int level = std::min(loop_depth, Code::kMaxLoopNestingMarker - 1);
+    builder()->OsrPoll(level);
+  }
+  builder()->Jump(&loop_header_);
+}
+
+
+void LoopBuilder::JumpToHeaderIfTrue(int loop_depth) {
+  if (FLAG_ignition_osr) {
+    // The OSR poll must be on an unconditional back edge, otherwise
+    // entering the loop header would skip the loop exit.
+    BytecodeLabel loop_exit;
+    builder()->JumpIfFalse(&loop_exit);
+    JumpToHeader(loop_depth);
+    builder()->Bind(&loop_exit);
+  } else {
+    builder()->JumpIfTrue(&loop_header_);
+  }
+}
+
+
 void LoopBuilder::EndLoop() {
   // Loop must have closed form, i.e. all loop elements are within the loop,
   // the loop header precedes the body and next elements in the loop.
@@ -90,8 +90,10 @@ class LoopBuilder final : public BreakableControlFlowBuilder {
   void LoopHeader(ZoneVector<BytecodeLabel>* additional_labels);
   void Condition() { builder()->Bind(&condition_); }
   void Next() { builder()->Bind(&next_); }
-  void JumpToHeader() { builder()->Jump(&loop_header_); }
-  void JumpToHeaderIfTrue() { builder()->JumpIfTrue(&loop_header_); }
+  // Emits the back edge to the loop header. |loop_depth| is the number
+  // of loops enclosing this loop and is used to arm on-stack replacement.
+  void JumpToHeader(int loop_depth);
+  void JumpToHeaderIfTrue(int loop_depth);
   void EndLoop();
 
   // This method is called when visiting continue statements in the AST.
@@ -30,6 +30,9 @@ InterpreterAssembler::InterpreterAssembler(Isolate* isolate, Zone* zone,
                         Bytecodes::ToString(bytecode), 0),
       bytecode_(bytecode),
       operand_scale_(operand_scale),
+      component_bytecode_(bytecode),
+      component_operand_base_(0),
+      component_dispatches_(true),
       accumulator_(this, MachineRepresentation::kTagged),
       accumulator_use_(AccumulatorUse::kNone),
       made_call_(false),
@@ -54,13 +57,18 @@ Node* InterpreterAssembler::GetAccumulatorUnchecked() {
 }
 
 Node* InterpreterAssembler::GetAccumulator() {
-  DCHECK(Bytecodes::ReadsAccumulator(bytecode_));
-  accumulator_use_ = accumulator_use_ | AccumulatorUse::kRead;
+  DCHECK(Bytecodes::ReadsAccumulator(component_bytecode_));
+  // A component of a superinstruction reading the accumulator written by an
+  // earlier component does not read the accumulator of the superinstruction.
+  if (component_bytecode_ == bytecode_ ||
+      (accumulator_use_ & AccumulatorUse::kWrite) == AccumulatorUse::kNone) {
+    accumulator_use_ = accumulator_use_ | AccumulatorUse::kRead;
+  }
   return GetAccumulatorUnchecked();
 }
 
 void InterpreterAssembler::SetAccumulator(Node* value) {
-  DCHECK(Bytecodes::WritesAccumulator(bytecode_));
+  DCHECK(Bytecodes::WritesAccumulator(component_bytecode_));
   accumulator_use_ = accumulator_use_ | AccumulatorUse::kWrite;
   accumulator_.Bind(value);
 }
@@ -313,6 +321,7 @@ Node* InterpreterAssembler::BytecodeUnsignedOperand(int operand_index,
 }
 
 Node* InterpreterAssembler::BytecodeOperandCount(int operand_index) {
+  operand_index += component_operand_base_;
   DCHECK_EQ(OperandType::kRegCount,
             Bytecodes::GetOperandType(bytecode_, operand_index));
   OperandSize operand_size =
@@ -321,6 +330,7 @@ Node* InterpreterAssembler::BytecodeOperandCount(int operand_index) {
 }
 
 Node* InterpreterAssembler::BytecodeOperandFlag(int operand_index) {
+  operand_index += component_operand_base_;
   DCHECK_EQ(OperandType::kFlag8,
             Bytecodes::GetOperandType(bytecode_, operand_index));
   OperandSize operand_size =
@@ -330,6 +340,7 @@ Node* InterpreterAssembler::BytecodeOperandFlag(int operand_index) {
 }
 
 Node* InterpreterAssembler::BytecodeOperandImm(int operand_index) {
+  operand_index += component_operand_base_;
   DCHECK_EQ(OperandType::kImm,
             Bytecodes::GetOperandType(bytecode_, operand_index));
   OperandSize operand_size =
@@ -338,6 +349,7 @@ Node* InterpreterAssembler::BytecodeOperandImm(int operand_index) {
 }
 
 Node* InterpreterAssembler::BytecodeOperandIdx(int operand_index) {
+  operand_index += component_operand_base_;
   DCHECK(OperandType::kIdx ==
          Bytecodes::GetOperandType(bytecode_, operand_index));
   OperandSize operand_size =
@@ -346,6 +358,7 @@ Node* InterpreterAssembler::BytecodeOperandIdx(int operand_index) {
 }
 
 Node* InterpreterAssembler::BytecodeOperandReg(int operand_index) {
+  operand_index += component_operand_base_;
   DCHECK(Bytecodes::IsRegisterOperandType(
       Bytecodes::GetOperandType(bytecode_, operand_index)));
   OperandSize operand_size =
@@ -354,6 +367,7 @@ Node* InterpreterAssembler::BytecodeOperandReg(int operand_index) {
 }
 
 Node* InterpreterAssembler::BytecodeOperandRuntimeId(int operand_index) {
+  operand_index += component_operand_base_;
   DCHECK(OperandType::kRuntimeId ==
          Bytecodes::GetOperandType(bytecode_, operand_index));
   OperandSize operand_size =
@@ -400,6 +414,32 @@ Node* InterpreterAssembler::LoadTypeFeedbackVector() {
   return vector;
 }
 
+Node* InterpreterAssembler::LoadTypeFeedbackVector(Node** raw_slot,
+                                                   int dummy_slot) {
+  Node* vector = LoadTypeFeedbackVector();
+  if (!FLAG_ignition_lazy_feedback_allocation) return vector;
+
+  Variable var_vector(this, MachineRepresentation::kTagged);
+  Variable var_slot(this, MachineRepresentation::kWord32);
+  CodeStubAssembler::Label if_lazy(this), end(this);
+  var_vector.Bind(vector);
+  var_slot.Bind(*raw_slot);
+  Node* length = LoadObjectField(vector, FixedArray::kLengthOffset);
+  Node* lazy_length =
+      SmiConstant(Smi::FromInt(TypeFeedbackVector::kReservedIndexCount));
+  Branch(WordEqual(length, lazy_length), &if_lazy, &end);
+  Bind(&if_lazy);
+  {
+    var_vector.Bind(LoadRoot(Heap::kDummyVectorRootIndex));
+    var_slot.Bind(Int32Constant(TypeFeedbackVector::GetIndexFromSpec(
+        nullptr, TypeFeedbackVector::DummySlot(dummy_slot))));
+    Goto(&end);
+  }
+  Bind(&end);
+  *raw_slot = var_slot.value();
+  return var_vector.value();
+}
+
 void InterpreterAssembler::CallPrologue() {
   StoreRegister(SmiTag(BytecodeOffset()), Register::bytecode_offset());
 
@@ -475,6 +515,11 @@ void InterpreterAssembler::UpdateInterruptBudget(Node* weight) {
 
   // Perform interrupt and reset budget.
   Bind(&interrupt_check);
+  if (FLAG_ignition_lazy_feedback_allocation) {
+    // The function used up a whole budget, start collecting feedback.
+    CallRuntime(Runtime::kInterpreterAllocateFeedbackVector, GetContext(),
+                LoadRegister(Register::function_closure()));
+  }
   CallRuntime(Runtime::kInterrupt, GetContext());
   StoreNoWriteBarrier(MachineRepresentation::kWord32,
                       BytecodeArrayTaggedPointer(), budget_offset,
@@ -523,9 +568,24 @@ void InterpreterAssembler::JumpIfWordNotEqual(Node* lhs, Node* rhs,
 }
 
 Node* InterpreterAssembler::Dispatch() {
+  // Only the last component of a superinstruction dispatches, the code
+  // of the next component follows directly.
+  if (!component_dispatches_) return nullptr;
   return DispatchTo(Advance(Bytecodes::Size(bytecode_, operand_scale_)));
 }
 
+void InterpreterAssembler::BeginSuperinstructionComponent(int index) {
+  DCHECK(Bytecodes::IsSuperinstruction(bytecode_));
+  component_bytecode_ = Bytecodes::GetSuperinstructionComponent(bytecode_, 0);
+  component_operand_base_ = 0;
+  component_dispatches_ = false;
+  if (index == 1) {
+    component_operand_base_ = Bytecodes::NumberOfOperands(component_bytecode_);
+    component_bytecode_ = Bytecodes::GetSuperinstructionComponent(bytecode_, 1);
+    component_dispatches_ = true;
+  }
+}
+
 Node* InterpreterAssembler::DispatchTo(Node* new_bytecode_offset) {
   Node* target_bytecode = Load(
       MachineType::Uint8(), BytecodeArrayTaggedPointer(), new_bytecode_offset);
@@ -637,6 +697,12 @@ void InterpreterAssembler::StackCheck() {
   Bind(&end);
 }
 
+Node* InterpreterAssembler::LoadOSRNestingLevel() {
+  Node* offset =
+      IntPtrConstant(BytecodeArray::kOSRNestingLevelOffset - kHeapObjectTag);
+  return Load(MachineType::Int8(), BytecodeArrayTaggedPointer(), offset);
+}
+
 void InterpreterAssembler::Abort(BailoutReason bailout_reason) {
   disable_stack_check_across_call_ = true;
   Node* abort_id = SmiTag(Int32Constant(bailout_reason));
@@ -721,7 +787,11 @@ Node* InterpreterAssembler::ExportRegisterFile(Node* array) {
     AbortIfWordNotEqual(
         array_size, RegisterCount(), kInvalidRegisterFileInGenerator);
   }
+  return ExportRegisters(array, RegisterCount());
+}
 
+Node* InterpreterAssembler::ExportRegisters(Node* array,
+                                            Node* register_count) {
   Variable var_index(this, MachineRepresentation::kWord32);
   var_index.Bind(Int32Constant(0));
 
@@ -731,7 +801,7 @@ Node* InterpreterAssembler::ExportRegisterFile(Node* array) {
   Bind(&loop);
   {
     Node* index = var_index.value();
-    Node* condition = Int32LessThan(index, RegisterCount());
+    Node* condition = Int32LessThan(index, register_count);
     GotoUnless(condition, &done_loop);
 
     Node* reg_index =
@@ -754,7 +824,11 @@ Node* InterpreterAssembler::ImportRegisterFile(Node* array) {
     AbortIfWordNotEqual(
         array_size, RegisterCount(), kInvalidRegisterFileInGenerator);
   }
+  return ImportRegisters(array, RegisterCount());
+}
 
+Node* InterpreterAssembler::ImportRegisters(Node* array,
+                                            Node* register_count) {
   Variable var_index(this, MachineRepresentation::kWord32);
   var_index.Bind(Int32Constant(0));
 
@@ -765,7 +839,7 @@ Node* InterpreterAssembler::ImportRegisterFile(Node* array) {
   Bind(&loop);
   {
     Node* index = var_index.value();
-    Node* condition = Int32LessThan(index, RegisterCount());
+    Node* condition = Int32LessThan(index, register_count);
     GotoUnless(condition, &done_loop);
 
     Node* value = LoadFixedArrayElementInt32Index(array, index);
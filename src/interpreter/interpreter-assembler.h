@@ -56,6 +56,11 @@ class InterpreterAssembler : public CodeStubAssembler {
   // Backup/restore register file to/from a fixed array of the correct length.
   compiler::Node* ExportRegisterFile(compiler::Node* array);
   compiler::Node* ImportRegisterFile(compiler::Node* array);
+  // Backup/restore only the first |register_count| registers.
+  compiler::Node* ExportRegisters(compiler::Node* array,
+                                  compiler::Node* register_count);
+  compiler::Node* ImportRegisters(compiler::Node* array,
+                                  compiler::Node* register_count);
 
   // Loads from and stores to the interpreter register file.
   compiler::Node* LoadRegister(Register reg);
@@ -85,6 +90,12 @@ class InterpreterAssembler : public CodeStubAssembler {
 
   // Load the TypeFeedbackVector for the current function.
   compiler::Node* LoadTypeFeedbackVector();
+  // Load the TypeFeedbackVector to be used with the feedback slot
+  // |*raw_slot|. While the vector of the current function is lazy this is
+  // the megamorphic dummy vector and |*raw_slot| is replaced with the index
+  // of its |dummy_slot|.
+  compiler::Node* LoadTypeFeedbackVector(compiler::Node** raw_slot,
+                                         int dummy_slot);
 
   // Call JSFunction or Callable |function| with |arg_count|
   // arguments (not including receiver) and the first argument
@@ -132,6 +143,9 @@ class InterpreterAssembler : public CodeStubAssembler {
   // Perform a stack guard check.
   void StackCheck();
 
+  // Load the OSR nesting level of the current function's BytecodeArray.
+  compiler::Node* LoadOSRNestingLevel();
+
   // Returns from the function.
   compiler::Node* InterpreterReturn();
 
@@ -146,6 +160,13 @@ class InterpreterAssembler : public CodeStubAssembler {
   // Dispatch bytecode as wide operand variant.
   void DispatchWide(OperandScale operand_scale);
 
+  // Superinstruction handlers are generated by running the handler
+  // generators of their components in sequence. Starts the generation of
+  // component |index| of the current superinstruction: operand indices are
+  // relative to the first operand of that component from now on, and only
+  // the last component dispatches.
+  void BeginSuperinstructionComponent(int index);
+
   // Abort with the given bailout reason.
   void Abort(BailoutReason bailout_reason);
 
@@ -231,6 +252,11 @@ class InterpreterAssembler : public CodeStubAssembler {
 
   Bytecode bytecode_;
   OperandScale operand_scale_;
+  // The bytecode whose handler generator is running. This differs from
+  // |bytecode_| while generating a component of a superinstruction.
+  Bytecode component_bytecode_;
+  int component_operand_base_;
+  bool component_dispatches_;
   CodeStubAssembler::Variable accumulator_;
   AccumulatorUse accumulator_use_;
   bool made_call_;
@@ -141,6 +141,16 @@ Node* IntrinsicsHelper::IsArray(Node* input) {
   return return_value.value();
 }
 
+Node* IntrinsicsHelper::GeneratorGetInput(Node* input) {
+  Node* generator = __ LoadRegister(input);
+  return __ LoadObjectField(generator, JSGeneratorObject::kInputOffset);
+}
+
+Node* IntrinsicsHelper::GeneratorGetResumeMode(Node* input) {
+  Node* generator = __ LoadRegister(input);
+  return __ LoadObjectField(generator, JSGeneratorObject::kResumeModeOffset);
+}
+
 void IntrinsicsHelper::AbortIfArgCountMismatch(int expected, Node* actual) {
   InterpreterAssembler::Label match(assembler_), mismatch(assembler_),
       end(assembler_);
@@ -20,9 +20,11 @@ namespace compiler {
 class Node;
 }  // namespace compiler
 
-#define INTRINSICS_LIST(V)           \
-  V(IsJSReceiver, is_js_receiver, 1) \
-  V(IsArray, is_array, 1)
+#define INTRINSICS_LIST(V)                             \
+  V(IsJSReceiver, is_js_receiver, 1)                   \
+  V(IsArray, is_array, 1)                              \
+  V(GeneratorGetInput, generator_get_input, 1)         \
+  V(GeneratorGetResumeMode, generator_get_resume_mode, 1)
 
 namespace interpreter {
 
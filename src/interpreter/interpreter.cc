@@ -15,6 +15,7 @@
 #include "src/interpreter/interpreter-assembler.h"
 #include "src/interpreter/interpreter-intrinsics.h"
 #include "src/log.h"
+#include "src/tracing/trace-event.h"
 #include "src/zone.h"
 
 namespace v8 {
@@ -125,6 +126,10 @@ int Interpreter::InterruptBudget() {
 bool Interpreter::MakeBytecode(CompilationInfo* info) {
   TimerEventScope<TimerEventCompileIgnition> timer(info->isolate());
   TRACE_EVENT0("v8", "V8.CompileIgnition");
+  TRACE_EVENT2(TRACE_DISABLED_BY_DEFAULT("v8.compile"), "V8.MakeBytecode",
+               "function", TRACE_STR_COPY(info->GetDebugName().get()), "bytes",
+               info->literal()->end_position() -
+                   info->literal()->start_position());
 
   if (FLAG_print_bytecode || FLAG_print_source || FLAG_print_ast) {
     OFStream os(stdout);
@@ -388,8 +393,9 @@ void Interpreter::DoLoadGlobal(Callable ic, InterpreterAssembler* assembler) {
   Node* constant_index = __ BytecodeOperandIdx(0);
   Node* name = __ LoadConstantPoolEntry(constant_index);
   Node* raw_slot = __ BytecodeOperandIdx(1);
+  Node* type_feedback_vector = __ LoadTypeFeedbackVector(
+      &raw_slot, TypeFeedbackVector::kDummyLoadICSlot);
   Node* smi_slot = __ SmiTag(raw_slot);
-  Node* type_feedback_vector = __ LoadTypeFeedbackVector();
   Node* result = __ CallStub(ic.descriptor(), code_target, context, global,
                              name, smi_slot, type_feedback_vector);
   __ SetAccumulator(result);
@@ -429,8 +435,9 @@ void Interpreter::DoStoreGlobal(Callable ic, InterpreterAssembler* assembler) {
   Node* name = __ LoadConstantPoolEntry(constant_index);
   Node* value = __ GetAccumulator();
   Node* raw_slot = __ BytecodeOperandIdx(1);
+  Node* type_feedback_vector = __ LoadTypeFeedbackVector(
+      &raw_slot, TypeFeedbackVector::kDummyStoreICSlot);
   Node* smi_slot = __ SmiTag(raw_slot);
-  Node* type_feedback_vector = __ LoadTypeFeedbackVector();
   __ CallStub(ic.descriptor(), code_target, context, global, name, value,
               smi_slot, type_feedback_vector);
   __ Dispatch();
@@ -546,12 +553,32 @@ void Interpreter::DoLoadIC(Callable ic, InterpreterAssembler* assembler) {
   Node* constant_index = __ BytecodeOperandIdx(1);
   Node* name = __ LoadConstantPoolEntry(constant_index);
   Node* raw_slot = __ BytecodeOperandIdx(2);
+  Node* type_feedback_vector = __ LoadTypeFeedbackVector(
+      &raw_slot, TypeFeedbackVector::kDummyLoadICSlot);
   Node* smi_slot = __ SmiTag(raw_slot);
-  Node* type_feedback_vector = __ LoadTypeFeedbackVector();
   Node* context = __ GetContext();
-  Node* result = __ CallStub(ic.descriptor(), code_target, context, object,
-                             name, smi_slot, type_feedback_vector);
-  __ SetAccumulator(result);
+
+  // In the monomorphic case call the handler directly rather than going
+  // through the LoadIC dispatcher, handlers expect the same arguments.
+  Variable var_result(assembler, MachineRepresentation::kTagged);
+  Variable var_handler(assembler, MachineRepresentation::kTagged);
+  Label if_handler(assembler), if_miss(assembler), end(assembler);
+  __ TryMonomorphicCase(object, raw_slot, type_feedback_vector, &if_handler,
+                        &var_handler, &if_miss);
+  __ Bind(&if_handler);
+  {
+    var_result.Bind(__ CallStub(ic.descriptor(), var_handler.value(), context,
+                                object, name, smi_slot, type_feedback_vector));
+    __ Goto(&end);
+  }
+  __ Bind(&if_miss);
+  {
+    var_result.Bind(__ CallStub(ic.descriptor(), code_target, context, object,
+                                name, smi_slot, type_feedback_vector));
+    __ Goto(&end);
+  }
+  __ Bind(&end);
+  __ SetAccumulator(var_result.value());
   __ Dispatch();
 }
 
@@ -571,8 +598,9 @@ void Interpreter::DoKeyedLoadIC(Callable ic, InterpreterAssembler* assembler) {
   Node* object = __ LoadRegister(reg_index);
   Node* name = __ GetAccumulator();
   Node* raw_slot = __ BytecodeOperandIdx(1);
+  Node* type_feedback_vector = __ LoadTypeFeedbackVector(
+      &raw_slot, TypeFeedbackVector::kDummyKeyedLoadICSlot);
   Node* smi_slot = __ SmiTag(raw_slot);
-  Node* type_feedback_vector = __ LoadTypeFeedbackVector();
   Node* context = __ GetContext();
   Node* result = __ CallStub(ic.descriptor(), code_target, context, object,
                              name, smi_slot, type_feedback_vector);
@@ -598,11 +626,30 @@ void Interpreter::DoStoreIC(Callable ic, InterpreterAssembler* assembler) {
   Node* name = __ LoadConstantPoolEntry(constant_index);
   Node* value = __ GetAccumulator();
   Node* raw_slot = __ BytecodeOperandIdx(2);
+  Node* type_feedback_vector = __ LoadTypeFeedbackVector(
+      &raw_slot, TypeFeedbackVector::kDummyStoreICSlot);
   Node* smi_slot = __ SmiTag(raw_slot);
-  Node* type_feedback_vector = __ LoadTypeFeedbackVector();
   Node* context = __ GetContext();
-  __ CallStub(ic.descriptor(), code_target, context, object, name, value,
-              smi_slot, type_feedback_vector);
+
+  // In the monomorphic case call the handler directly rather than going
+  // through the StoreIC dispatcher, handlers expect the same arguments.
+  Variable var_handler(assembler, MachineRepresentation::kTagged);
+  Label if_handler(assembler), if_miss(assembler), end(assembler);
+  __ TryMonomorphicCase(object, raw_slot, type_feedback_vector, &if_handler,
+                        &var_handler, &if_miss);
+  __ Bind(&if_handler);
+  {
+    __ CallStub(ic.descriptor(), var_handler.value(), context, object, name,
+                value, smi_slot, type_feedback_vector);
+    __ Goto(&end);
+  }
+  __ Bind(&if_miss);
+  {
+    __ CallStub(ic.descriptor(), code_target, context, object, name, value,
+                smi_slot, type_feedback_vector);
+    __ Goto(&end);
+  }
+  __ Bind(&end);
   __ Dispatch();
 }
 
@@ -638,8 +685,9 @@ void Interpreter::DoKeyedStoreIC(Callable ic, InterpreterAssembler* assembler) {
   Node* name = __ LoadRegister(name_reg_index);
   Node* value = __ GetAccumulator();
   Node* raw_slot = __ BytecodeOperandIdx(2);
+  Node* type_feedback_vector = __ LoadTypeFeedbackVector(
+      &raw_slot, TypeFeedbackVector::kDummyKeyedStoreICSlot);
   Node* smi_slot = __ SmiTag(raw_slot);
-  Node* type_feedback_vector = __ LoadTypeFeedbackVector();
   Node* context = __ GetContext();
   __ CallStub(ic.descriptor(), code_target, context, object, name, value,
               smi_slot, type_feedback_vector);
@@ -1132,6 +1180,71 @@ void Interpreter::DoTestGreaterThanOrEqual(InterpreterAssembler* assembler) {
 }
 
 
+void Interpreter::DoCompareOpWithSmi(Callable callable,
+                                     InterpreterAssembler* assembler) {
+  Node* target = __ HeapConstant(callable.code());
+  Node* reg_index = __ BytecodeOperandReg(0);
+  Node* lhs = __ LoadRegister(reg_index);
+  Node* raw_int = __ BytecodeOperandImm(1);
+  Node* rhs = __ SmiTag(raw_int);
+  Node* context = __ GetContext();
+  Node* result = __ CallStub(callable.descriptor(), target, context, lhs, rhs);
+  __ SetAccumulator(result);
+  __ Dispatch();
+}
+
+// TestEqualSmi <src> <imm>
+//
+// Test if the value in the <src> register equals the Smi <imm>.
+void Interpreter::DoTestEqualSmi(InterpreterAssembler* assembler) {
+  DoCompareOpWithSmi(CodeFactory::Equal(isolate_), assembler);
+}
+
+// TestNotEqualSmi <src> <imm>
+//
+// Test if the value in the <src> register is not equal to the Smi <imm>.
+void Interpreter::DoTestNotEqualSmi(InterpreterAssembler* assembler) {
+  DoCompareOpWithSmi(CodeFactory::NotEqual(isolate_), assembler);
+}
+
+// TestEqualStrictSmi <src> <imm>
+//
+// Test if the value in the <src> register is strictly equal to the Smi <imm>.
+void Interpreter::DoTestEqualStrictSmi(InterpreterAssembler* assembler) {
+  DoCompareOpWithSmi(CodeFactory::StrictEqual(isolate_), assembler);
+}
+
+// TestLessThanSmi <src> <imm>
+//
+// Test if the value in the <src> register is less than the Smi <imm>.
+void Interpreter::DoTestLessThanSmi(InterpreterAssembler* assembler) {
+  DoCompareOpWithSmi(CodeFactory::LessThan(isolate_), assembler);
+}
+
+// TestGreaterThanSmi <src> <imm>
+//
+// Test if the value in the <src> register is greater than the Smi <imm>.
+void Interpreter::DoTestGreaterThanSmi(InterpreterAssembler* assembler) {
+  DoCompareOpWithSmi(CodeFactory::GreaterThan(isolate_), assembler);
+}
+
+// TestLessThanOrEqualSmi <src> <imm>
+//
+// Test if the value in the <src> register is less than or equal to the
+// Smi <imm>.
+void Interpreter::DoTestLessThanOrEqualSmi(InterpreterAssembler* assembler) {
+  DoCompareOpWithSmi(CodeFactory::LessThanOrEqual(isolate_), assembler);
+}
+
+// TestGreaterThanOrEqualSmi <src> <imm>
+//
+// Test if the value in the <src> register is greater than or equal to the
+// Smi <imm>.
+void Interpreter::DoTestGreaterThanOrEqualSmi(
+    InterpreterAssembler* assembler) {
+  DoCompareOpWithSmi(CodeFactory::GreaterThanOrEqual(isolate_), assembler);
+}
+
 // TestIn <src>
 //
 // Test if the object referenced by the register operand is a property of the
@@ -1584,6 +1697,56 @@ void Interpreter::DoStackCheck(InterpreterAssembler* assembler) {
   __ Dispatch();
 }
 
+// OsrPoll <loop_depth>
+//
+// Performs a loop nesting check and potentially triggers OSR in case the
+// current OSR level matches (or exceeds) the specified |loop_depth|.
+void Interpreter::DoOsrPoll(InterpreterAssembler* assembler) {
+  Node* loop_depth = __ BytecodeOperandImm(0);
+  Node* osr_level = __ LoadOSRNestingLevel();
+
+  // Check if OSR points at the given {loop_depth} are armed by comparing it to
+  // the current {osr_level} loaded from the header of the BytecodeArray.
+  InterpreterAssembler::Label ok(assembler), osr_armed(assembler);
+  Node* condition = __ Int32GreaterThanOrEqual(loop_depth, osr_level);
+  __ Branch(condition, &ok, &osr_armed);
+
+  __ Bind(&ok);
+  __ Dispatch();
+
+  __ Bind(&osr_armed);
+  {
+    Callable callable = CodeFactory::InterpreterOnStackReplacement(isolate_);
+    Node* target = __ HeapConstant(callable.code());
+    Node* context = __ GetContext();
+    __ CallStub(callable.descriptor(), target, context);
+    __ Dispatch();
+  }
+}
+
+// IncBlockCounter <slot> <position>
+//
+// Increments the block counter in feedback vector slot <slot>. The counter
+// is a Smi that wraps around to zero after Smi::kMaxValue. <position> is the
+// source position of the block, it is only read when coverage is reported.
+void Interpreter::DoIncBlockCounter(InterpreterAssembler* assembler) {
+  Node* slot_index = __ BytecodeOperandIdx(0);
+  Node* type_feedback_vector = __ LoadTypeFeedbackVector();
+  Node* index = __ IntPtrAdd(
+      slot_index, __ IntPtrConstant(TypeFeedbackVector::kReservedIndexCount));
+  Node* offset =
+      __ IntPtrAdd(__ WordShl(index, __ IntPtrConstant(kPointerSizeLog2)),
+                   __ IntPtrConstant(FixedArray::kHeaderSize - kHeapObjectTag));
+  Node* count = __ Load(MachineType::AnyTagged(), type_feedback_vector, offset);
+  // Masking a tagged Smi with the tagged Smi::kMaxValue keeps it a Smi.
+  Node* new_count =
+      __ WordAnd(__ SmiAdd(count, __ SmiConstant(Smi::FromInt(1))),
+                 __ SmiConstant(Smi::FromInt(Smi::kMaxValue)));
+  __ StoreNoWriteBarrier(MachineRepresentation::kTagged, type_feedback_vector,
+                         offset, new_count);
+  __ Dispatch();
+}
+
 // Throw
 //
 // Throws the exception in the accumulator.
@@ -1690,8 +1853,11 @@ void Interpreter::DoForInNext(InterpreterAssembler* assembler) {
   __ Bind(&if_slow);
   {
     // Record the fact that we hit the for-in slow path.
+    // Without feedback this overwrites a slot of the dummy vector, which is
+    // megamorphic already.
     Node* vector_index = __ BytecodeOperandIdx(3);
-    Node* type_feedback_vector = __ LoadTypeFeedbackVector();
+    Node* type_feedback_vector = __ LoadTypeFeedbackVector(
+        &vector_index, TypeFeedbackVector::kDummyLoadICSlot);
     Node* megamorphic_sentinel =
         __ HeapConstant(TypeFeedbackVector::MegamorphicSentinel(isolate_));
     __ StoreFixedArrayElementNoWriteBarrier(type_feedback_vector, vector_index,
@@ -1809,6 +1975,64 @@ void Interpreter::DoResumeGenerator(InterpreterAssembler* assembler) {
   __ Dispatch();
 }
 
+// SuspendGeneratorLive <generator> <register_count>
+//
+// Like SuspendGenerator, but only exports the first <register_count>
+// registers, which hold all values live across the suspension.
+void Interpreter::DoSuspendGeneratorLive(InterpreterAssembler* assembler) {
+  Node* generator_reg = __ BytecodeOperandReg(0);
+  Node* generator = __ LoadRegister(generator_reg);
+  Node* register_count = __ BytecodeOperandIdx(1);
+
+  Node* array =
+      __ LoadObjectField(generator, JSGeneratorObject::kOperandStackOffset);
+  Node* context = __ GetContext();
+  Node* state = __ GetAccumulator();
+
+  __ ExportRegisters(array, register_count);
+  __ StoreObjectField(generator, JSGeneratorObject::kContextOffset, context);
+  __ StoreObjectField(generator, JSGeneratorObject::kContinuationOffset, state);
+
+  __ Dispatch();
+}
+
+// ResumeGeneratorLive <generator> <register_count>
+//
+// Like ResumeGenerator, but only imports the first <register_count>
+// registers stored in the generator.
+void Interpreter::DoResumeGeneratorLive(InterpreterAssembler* assembler) {
+  Node* generator_reg = __ BytecodeOperandReg(0);
+  Node* generator = __ LoadRegister(generator_reg);
+  Node* register_count = __ BytecodeOperandIdx(1);
+
+  __ ImportRegisters(
+      __ LoadObjectField(generator, JSGeneratorObject::kOperandStackOffset),
+      register_count);
+
+  Node* old_state =
+      __ LoadObjectField(generator, JSGeneratorObject::kContinuationOffset);
+  Node* new_state = __ Int32Constant(JSGeneratorObject::kGeneratorExecuting);
+  __ StoreObjectField(generator, JSGeneratorObject::kContinuationOffset,
+      __ SmiTag(new_state));
+  __ SetAccumulator(old_state);
+
+  __ Dispatch();
+}
+
+// Superinstructions
+//
+// Perform the two component bytecodes of the superinstruction in sequence
+// without dispatching in between, see SUPERINSTRUCTION_LIST.
+#define DEFINE_SUPERINSTRUCTION_HANDLER(Name, First, Second)    \
+  void Interpreter::Do##Name(InterpreterAssembler* assembler) { \
+    __ BeginSuperinstructionComponent(0);                       \
+    Do##First(assembler);                                       \
+    __ BeginSuperinstructionComponent(1);                       \
+    Do##Second(assembler);                                      \
+  }
+SUPERINSTRUCTION_LIST(DEFINE_SUPERINSTRUCTION_HANDLER)
+#undef DEFINE_SUPERINSTRUCTION_HANDLER
+
 }  // namespace interpreter
 }  // namespace internal
 }  // namespace v8
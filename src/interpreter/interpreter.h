@@ -80,6 +80,10 @@ class Interpreter {
   // |compare_op|.
   void DoCompareOp(Token::Value compare_op, InterpreterAssembler* assembler);
 
+  // Generates code to perform the comparison via |callable| of a register
+  // operand and a Smi immediate operand.
+  void DoCompareOpWithSmi(Callable callable, InterpreterAssembler* assembler);
+
   // Generates code to load a constant from the constant pool.
   void DoLoadConstant(InterpreterAssembler* assembler);
 
@@ -123,6 +123,7 @@ void SourcePositionTableBuilder::AddStatementPosition(size_t bytecode_offset,
 
 void SourcePositionTableBuilder::AddExpressionPosition(size_t bytecode_offset,
                                                        int source_position) {
+  if (omits_expression_positions()) return;
   int offset = static_cast<int>(bytecode_offset);
   AddEntry({offset, source_position, false});
 }
@@ -36,8 +36,15 @@ struct PositionTableEntry {
 
 class SourcePositionTableBuilder : public PositionsRecorder {
  public:
-  SourcePositionTableBuilder(Isolate* isolate, Zone* zone)
+  // Expression positions are only needed for precise stack traces and the
+  // debugger, they can be omitted when the function can be re-parsed later
+  // to recover them (see Compiler::CollectSourcePositions).
+  enum RecordingMode { RECORD_SOURCE_POSITIONS, OMIT_EXPRESSION_POSITIONS };
+
+  SourcePositionTableBuilder(Isolate* isolate, Zone* zone,
+                             RecordingMode mode = RECORD_SOURCE_POSITIONS)
       : isolate_(isolate),
+        mode_(mode),
         bytes_(zone),
 #ifdef ENABLE_SLOW_DCHECKS
         raw_entries_(zone),
@@ -49,6 +56,10 @@ class SourcePositionTableBuilder : public PositionsRecorder {
   void AddExpressionPosition(size_t bytecode_offset, int source_position);
   Handle<ByteArray> ToSourcePositionTable();
 
+  bool omits_expression_positions() const {
+    return mode_ == OMIT_EXPRESSION_POSITIONS;
+  }
+
  private:
   static const int kUninitializedCandidateOffset = -1;
 
@@ -56,6 +67,7 @@ class SourcePositionTableBuilder : public PositionsRecorder {
   void CommitEntry();
 
   Isolate* isolate_;
+  RecordingMode mode_;
   ZoneVector<byte> bytes_;
 #ifdef ENABLE_SLOW_DCHECKS
   ZoneVector<PositionTableEntry> raw_entries_;
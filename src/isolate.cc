@@ -11,6 +11,7 @@
 
 #include "src/ast/ast.h"
 #include "src/ast/scopeinfo.h"
+#include "src/background-task-budget.h"
 #include "src/base/platform/platform.h"
 #include "src/base/sys-info.h"
 #include "src/base/utils/random-number-generator.h"
@@ -19,11 +20,13 @@
 #include "src/codegen.h"
 #include "src/compilation-cache.h"
 #include "src/compilation-statistics.h"
+#include "src/compiler.h"
 #include "src/crankshaft/hydrogen.h"
 #include "src/debug/debug.h"
 #include "src/deoptimizer.h"
 #include "src/external-reference-table.h"
 #include "src/frames-inl.h"
+#include "src/ic/ic-stats.h"
 #include "src/ic/stub-cache.h"
 #include "src/interpreter/interpreter.h"
 #include "src/isolate-inl.h"
@@ -339,6 +342,16 @@ static bool IsVisibleInStackTrace(JSFunction* fun,
   return true;
 }
 
+// Bytecode may have been generated without expression positions, they are
+// recovered before any position is computed from a bytecode offset.
+static void EnsureSourcePositions(Handle<JSFunction> fun,
+                                  Handle<AbstractCode> abstract_code) {
+  if (!abstract_code->IsBytecodeArray()) return;
+  Handle<BytecodeArray> bytecode(abstract_code->GetBytecodeArray());
+  if (!bytecode->omits_expression_positions()) return;
+  Compiler::CollectSourcePositions(handle(fun->shared()), bytecode);
+}
+
 static Handle<FixedArray> MaybeGrow(Isolate* isolate,
                                     Handle<FixedArray> elements,
                                     int cur_position, int new_size) {
@@ -357,13 +370,21 @@ static Handle<FixedArray> MaybeGrow(Isolate* isolate,
 
 Handle<Object> Isolate::CaptureSimpleStackTrace(Handle<JSReceiver> error_object,
                                                 Handle<Object> caller) {
-  // Get stack trace limit.
-  Handle<JSObject> error = error_function();
-  Handle<String> stackTraceLimit =
-      factory()->InternalizeUtf8String("stackTraceLimit");
-  DCHECK(!stackTraceLimit.is_null());
-  Handle<Object> stack_trace_limit =
-      JSReceiver::GetDataProperty(error, stackTraceLimit);
+  // Get stack trace limit. Error classes can override Error.stackTraceLimit
+  // with a stackTraceLimit of their own, e.g. to not capture any frames for
+  // errors that are used for control flow.
+  Handle<Object> stack_trace_limit = factory()->undefined_value();
+  Handle<Object> constructor = JSReceiver::GetDataProperty(
+      error_object, factory()->constructor_string());
+  if (constructor->IsJSReceiver()) {
+    stack_trace_limit = JSReceiver::GetDataProperty(
+        Handle<JSReceiver>::cast(constructor),
+        factory()->stack_trace_limit_string());
+  }
+  if (!stack_trace_limit->IsNumber()) {
+    stack_trace_limit = JSReceiver::GetDataProperty(
+        error_function(), factory()->stack_trace_limit_string());
+  }
   if (!stack_trace_limit->IsNumber()) return factory()->undefined_value();
   int limit = FastD2IChecked(stack_trace_limit->Number());
   limit = Max(limit, 0);  // Ensure that limit is not negative.
@@ -406,8 +427,9 @@ Handle<Object> Isolate::CaptureSimpleStackTrace(Handle<JSReceiver> error_object,
           }
           elements = MaybeGrow(this, elements, cursor, cursor + 4);
 
+          // Source positions are recovered once the position is needed, see
+          // PositionFromStackTrace.
           Handle<AbstractCode> abstract_code = frames[i].abstract_code();
-
           Handle<Smi> offset(Smi::FromInt(frames[i].code_offset()), this);
           // The stack trace API should not expose receivers and function
           // objects on frames deeper than the top-most one with a strict mode
@@ -633,12 +655,13 @@ class CaptureStackTraceHelper {
 
 
 int PositionFromStackTrace(Handle<FixedArray> elements, int index) {
-  DisallowHeapAllocation no_gc;
   Object* maybe_code = elements->get(index + 2);
   if (maybe_code->IsSmi()) {
     return Smi::cast(maybe_code)->value();
   } else {
-    AbstractCode* abstract_code = AbstractCode::cast(maybe_code);
+    Handle<AbstractCode> abstract_code(AbstractCode::cast(maybe_code));
+    EnsureSourcePositions(handle(JSFunction::cast(elements->get(index + 1))),
+                          abstract_code);
     int code_offset = Smi::cast(elements->get(index + 3))->value();
     return abstract_code->SourcePosition(code_offset);
   }
@@ -705,6 +728,7 @@ Handle<JSArray> Isolate::CaptureCurrentStackTrace(
       // Filter frames from other security contexts.
       if (!(options & StackTrace::kExposeFramesAcrossSecurityOrigins) &&
           !this->context()->HasSameSecurityTokenAs(fun->context())) continue;
+      EnsureSourcePositions(fun, frames[i].abstract_code());
       int position =
           frames[i].abstract_code()->SourcePosition(frames[i].code_offset());
       Handle<JSObject> stack_frame =
@@ -1737,16 +1761,14 @@ char* Isolate::RestoreThread(char* from) {
 }
 
 
-Isolate::ThreadDataTable::ThreadDataTable()
-    : list_(NULL) {
-}
+Isolate::ThreadDataTable::ThreadDataTable() {}
 
 
 Isolate::ThreadDataTable::~ThreadDataTable() {
   // TODO(svenpanne) The assertion below would fire if an embedder does not
   // cleanly dispose all Isolates before disposing v8, so we are conservative
   // and leave it out for now.
-  // DCHECK_NULL(list_);
+  // DCHECK(table_.empty());
 }
 
 
@@ -1760,34 +1782,35 @@ Isolate::PerIsolateThreadData::~PerIsolateThreadData() {
 Isolate::PerIsolateThreadData*
     Isolate::ThreadDataTable::Lookup(Isolate* isolate,
                                      ThreadId thread_id) {
-  for (PerIsolateThreadData* data = list_; data != NULL; data = data->next_) {
-    if (data->Matches(isolate, thread_id)) return data;
-  }
-  return NULL;
+  auto it = table_.find(Key(isolate, thread_id.ToInteger()));
+  if (it == table_.end()) return NULL;
+  DCHECK(it->second->Matches(isolate, thread_id));
+  return it->second;
 }
 
 
 void Isolate::ThreadDataTable::Insert(Isolate::PerIsolateThreadData* data) {
-  if (list_ != NULL) list_->prev_ = data;
-  data->next_ = list_;
-  list_ = data;
+  Key key(data->isolate(), data->thread_id().ToInteger());
+  bool inserted = table_.insert(std::make_pair(key, data)).second;
+  USE(inserted);
+  DCHECK(inserted);
 }
 
 
 void Isolate::ThreadDataTable::Remove(PerIsolateThreadData* data) {
-  if (list_ == data) list_ = data->next_;
-  if (data->next_ != NULL) data->next_->prev_ = data->prev_;
-  if (data->prev_ != NULL) data->prev_->next_ = data->next_;
+  table_.erase(Key(data->isolate(), data->thread_id().ToInteger()));
   delete data;
 }
 
 
 void Isolate::ThreadDataTable::RemoveAllThreads(Isolate* isolate) {
-  PerIsolateThreadData* data = list_;
-  while (data != NULL) {
-    PerIsolateThreadData* next = data->next_;
-    if (data->isolate() == isolate) Remove(data);
-    data = next;
+  for (auto it = table_.begin(); it != table_.end();) {
+    if (it->first.first == isolate) {
+      delete it->second;
+      it = table_.erase(it);
+    } else {
+      ++it;
+    }
   }
 }
 
@@ -1862,6 +1885,7 @@ Isolate::Isolate(bool enable_serializer)
       use_counter_callback_(NULL),
       basic_block_profiler_(NULL),
       cancelable_task_manager_(new CancelableTaskManager()),
+      background_task_budget_(new BackgroundTaskBudget()),
       abort_on_uncaught_exception_callback_(NULL) {
   {
     base::LockGuard<base::Mutex> lock_guard(thread_data_table_mutex_.Pointer());
@@ -1870,6 +1894,9 @@ Isolate::Isolate(bool enable_serializer)
   id_ = base::NoBarrier_AtomicIncrement(&isolate_counter_, 1);
   TRACE_ISOLATE(constructor);
 
+  allocator_.ConfigureSegmentPool(
+      static_cast<size_t>(Max(0, FLAG_zone_segment_pool_size)) * KB);
+
   memset(isolate_addresses_, 0,
       sizeof(isolate_addresses_[0]) * (kIsolateAddressCount + 1));
 
@@ -2098,6 +2125,9 @@ Isolate::~Isolate() {
   delete cancelable_task_manager_;
   cancelable_task_manager_ = nullptr;
 
+  delete background_task_budget_;
+  background_task_budget_ = nullptr;
+
 #if USE_SIMULATOR
   Simulator::TearDown(simulator_i_cache_, simulator_redirection_);
   simulator_i_cache_ = nullptr;
@@ -2442,11 +2472,24 @@ void Isolate::DumpAndResetCompilationStats() {
   turbo_statistics_ = nullptr;
   delete hstatistics_;
   hstatistics_ = nullptr;
+  if (ic_stats() != nullptr) {
+    OFStream os(stdout);
+    ic_stats()->Print(os, 50);
+  }
+  delete ic_stats_;
+  ic_stats_ = nullptr;
   if (FLAG_runtime_call_stats) {
     OFStream os(stdout);
     counters()->runtime_call_stats()->Print(os);
     counters()->runtime_call_stats()->Reset();
   }
+  if (FLAG_trace_zone_stats) {
+    PrintF("[Zone memory: %" PRIuS " KB in use, %" PRIuS " KB peak, %" PRIuS
+           " KB pooled]\n",
+           allocator_.GetCurrentMemoryUsage() / KB,
+           allocator_.GetMaxMemoryUsage() / KB,
+           allocator_.GetCurrentPoolSize() / KB);
+  }
 }
 
 
@@ -2463,6 +2506,12 @@ CompilationStatistics* Isolate::GetTurboStatistics() {
 }
 
 
+ICStats* Isolate::GetICStats() {
+  if (ic_stats() == NULL) set_ic_stats(new ICStats());
+  return ic_stats();
+}
+
+
 HTracer* Isolate::GetHTracer() {
   if (htracer() == NULL) set_htracer(new HTracer(id()));
   return htracer();
@@ -2761,6 +2810,26 @@ void Isolate::ReportPromiseReject(Handle<JSObject> promise,
 }
 
 
+void Isolate::ReportDeoptimization(Handle<JSFunction> function,
+                                   v8::DeoptimizationType type,
+                                   const char* reason, int position) {
+  int deopt_count = function->shared()->deopt_count();
+  bool is_deopt_loop = deopt_count >= FLAG_deopt_loop_count;
+  if (deopt_count == FLAG_deopt_loop_count) {
+    counters()->deopt_loops()->Increment();
+    if (FLAG_trace_deopt) {
+      PrintF("[deoptimization loop: ");
+      function->PrintName();
+      PrintF(" was deoptimized %d times]\n", deopt_count);
+    }
+  }
+  if (deoptimization_callback() == NULL) return;
+  deoptimization_callback()(v8::DeoptimizationEvent(
+      v8::Utils::CallableToLocal(function), type, reason, position, deopt_count,
+      is_deopt_loop));
+}
+
+
 void Isolate::EnqueueMicrotask(Handle<Object> microtask) {
   DCHECK(microtask->IsJSFunction() || microtask->IsCallHandlerInfo());
   Handle<FixedArray> queue(heap()->microtask_queue(), this);
@@ -2799,26 +2868,45 @@ void Isolate::RunMicrotasksInternal() {
     set_pending_microtask_count(0);
     heap()->set_microtask_queue(heap()->empty_fixed_array());
 
-    Isolate* isolate = this;
-    FOR_WITH_HANDLE_SCOPE(isolate, int, i = 0, i, i < num_tasks, i++, {
+    int i = 0;
+    while (i < num_tasks) {
+      HandleScope loop_scope(this);
       Handle<Object> microtask(queue->get(i), this);
       if (microtask->IsJSFunction()) {
-        Handle<JSFunction> microtask_function =
-            Handle<JSFunction>::cast(microtask);
+        // Consecutive microtasks of the same native context are run by a
+        // single call to the native context's microtask runner.
+        Handle<Context> native_context(
+            JSFunction::cast(*microtask)->context()->native_context(), this);
+        int end = i + 1;
+        while (end < num_tasks && queue->get(end)->IsJSFunction() &&
+               JSFunction::cast(queue->get(end))->context()->native_context() ==
+                   *native_context) {
+          end++;
+        }
+
         SaveContext save(this);
-        set_context(microtask_function->context()->native_context());
+        set_context(*native_context);
+        Handle<Object> callable = microtask;
+        int argc = 0;
+        Handle<Object> argv[1];
+        if (end - i > 1) {
+          Handle<FixedArray> batch = factory()->NewFixedArray(end - i);
+          queue->CopyTo(i, *batch, 0, end - i);
+          callable = handle(native_context->run_microtasks(), this);
+          argv[argc++] = factory()->NewJSArrayWithElements(batch);
+        }
         MaybeHandle<Object> maybe_exception;
-        MaybeHandle<Object> result = Execution::TryCall(
-            this, microtask_function, factory()->undefined_value(), 0, NULL,
-            &maybe_exception);
+        MaybeHandle<Object> result =
+            Execution::TryCall(this, callable, factory()->undefined_value(),
+                               argc, argv, &maybe_exception);
         // If execution is terminating, just bail out.
-        Handle<Object> exception;
         if (result.is_null() && maybe_exception.is_null()) {
           // Clear out any remaining callbacks in the queue.
           heap()->set_microtask_queue(heap()->empty_fixed_array());
           set_pending_microtask_count(0);
           return;
         }
+        i = end;
       } else {
         Handle<CallHandlerInfo> callback_info =
             Handle<CallHandlerInfo>::cast(microtask);
@@ -2826,8 +2914,9 @@ void Isolate::RunMicrotasksInternal() {
             v8::ToCData<v8::MicrotaskCallback>(callback_info->callback());
         void* data = v8::ToCData<void*>(callback_info->data());
         callback(data);
+        i++;
       }
-    });
+    }
   }
 }
 
@@ -7,6 +7,8 @@
 
 #include <queue>
 #include <set>
+#include <unordered_map>
+#include <utility>
 
 #include "include/v8-debug.h"
 #include "src/allocation.h"
@@ -39,6 +41,7 @@ class RandomNumberGenerator;
 
 namespace internal {
 
+class BackgroundTaskBudget;
 class BasicBlockProfiler;
 class Bootstrapper;
 class CallInterfaceDescriptorData;
@@ -62,6 +65,7 @@ class FunctionInfoListener;
 class HandleScopeImplementer;
 class HeapProfiler;
 class HStatistics;
+class ICStats;
 class HTracer;
 class InlineRuntimeFunctionsTable;
 class InnerPointerToCodeCache;
@@ -381,7 +385,6 @@ typedef List<HeapObject*> DebugObjectCache;
   V(AllowCodeGenerationFromStringsCallback, allow_code_gen_callback, NULL)     \
   /* To distinguish the function templates, so that we can find them in the */ \
   /* function cache of the native context. */                                  \
-  V(int, next_serial_number, 0)                                                \
   V(ExternalReferenceRedirectorPointer*, external_reference_redirector, NULL)  \
   /* Part of the state of liveedit. */                                         \
   V(FunctionInfoListener*, active_function_info_listener, NULL)                \
@@ -395,12 +398,15 @@ typedef List<HeapObject*> DebugObjectCache;
   V(int, pending_microtask_count, 0)                                           \
   V(HStatistics*, hstatistics, NULL)                                           \
   V(CompilationStatistics*, turbo_statistics, NULL)                            \
+  V(ICStats*, ic_stats, NULL)                                                  \
   V(HTracer*, htracer, NULL)                                                   \
   V(CodeTracer*, code_tracer, NULL)                                            \
   V(bool, fp_stubs_generated, false)                                           \
   V(uint32_t, per_isolate_assert_data, 0xFFFFFFFFu)                            \
   V(PromiseRejectCallback, promise_reject_callback, NULL)                      \
+  V(DeoptimizationCallback, deoptimization_callback, NULL)                     \
   V(const v8::StartupData*, snapshot_blob, NULL)                               \
+  V(intptr_t*, api_external_references, NULL)                                  \
   ISOLATE_INIT_SIMULATOR_LIST(V)
 
 #define THREAD_LOCAL_TOP_ACCESSOR(type, name)                        \
@@ -428,12 +434,13 @@ class Isolate {
         : isolate_(isolate),
           thread_id_(thread_id),
           stack_limit_(0),
-          thread_state_(NULL),
+          thread_state_(NULL)
 #if USE_SIMULATOR
-          simulator_(NULL),
+          ,
+          simulator_(NULL)
 #endif
-          next_(NULL),
-          prev_(NULL) { }
+    {
+    }
     ~PerIsolateThreadData();
     Isolate* isolate() const { return isolate_; }
     ThreadId thread_id() const { return thread_id_; }
@@ -459,9 +466,6 @@ class Isolate {
     Simulator* simulator_;
 #endif
 
-    PerIsolateThreadData* next_;
-    PerIsolateThreadData* prev_;
-
     friend class Isolate;
     friend class ThreadDataTable;
     friend class EntryStackItem;
@@ -1004,6 +1008,7 @@ class Isolate {
 
   HStatistics* GetHStatistics();
   CompilationStatistics* GetTurboStatistics();
+  ICStats* GetICStats();
   HTracer* GetHTracer();
   CodeTracer* GetCodeTracer();
 
@@ -1060,6 +1065,11 @@ class Isolate {
   void ReportPromiseReject(Handle<JSObject> promise, Handle<Object> value,
                            v8::PromiseRejectEvent event);
 
+  // Counts deoptimization loops and notifies the deoptimization callback.
+  void ReportDeoptimization(Handle<JSFunction> function,
+                            v8::DeoptimizationType type, const char* reason,
+                            int position);
+
   void EnqueueMicrotask(Handle<Object> microtask);
   void RunMicrotasks();
   bool IsRunningMicrotasks() const { return is_running_microtasks_; }
@@ -1103,6 +1113,10 @@ class Isolate {
     return cancelable_task_manager_;
   }
 
+  BackgroundTaskBudget* background_task_budget() {
+    return background_task_budget_;
+  }
+
   interpreter::Interpreter* interpreter() const { return interpreter_; }
 
   base::AccountingAllocator* allocator() { return &allocator_; }
@@ -1123,7 +1137,8 @@ class Isolate {
   Heap heap_;
 
   // The per-process lock should be acquired before the ThreadDataTable is
-  // modified.
+  // modified. Lookups are hashed, as they happen on every thread switch of a
+  // Locker'ed isolate.
   class ThreadDataTable {
    public:
     ThreadDataTable();
@@ -1135,7 +1150,15 @@ class Isolate {
     void RemoveAllThreads(Isolate* isolate);
 
    private:
-    PerIsolateThreadData* list_;
+    typedef std::pair<Isolate*, int> Key;
+    struct KeyHash {
+      size_t operator()(const Key& key) const {
+        return reinterpret_cast<size_t>(key.first) ^
+               static_cast<size_t>(key.second);
+      }
+    };
+
+    std::unordered_map<Key, PerIsolateThreadData*, KeyHash> table_;
   };
 
   // These items form a stack synchronously with threads Enter'ing and Exit'ing
@@ -1355,6 +1378,8 @@ class Isolate {
 
   CancelableTaskManager* cancelable_task_manager_;
 
+  BackgroundTaskBudget* background_task_budget_;
+
   v8::Isolate::AbortOnUncaughtExceptionCallback
       abort_on_uncaught_exception_callback_;
 
@@ -1372,6 +1397,7 @@ class Isolate {
   friend v8::StartupData v8::V8::CreateSnapshotDataBlob(const char*);
   friend v8::StartupData v8::V8::WarmUpSnapshotDataBlob(v8::StartupData,
                                                         const char*);
+  friend class v8::SnapshotCreator;
 
   DISALLOW_COPY_AND_ASSIGN(Isolate);
 };
@@ -166,6 +166,10 @@ utils.Export(function(to) {
   to.ArrayValues = ArrayValues;
 });
 
-%InstallToContext(["array_values_iterator", ArrayValues]);
+%InstallToContext([
+  "array_iterator_next", ArrayIteratorNext,
+  "array_iterator_prototype", ArrayIterator.prototype,
+  "array_values_iterator", ArrayValues,
+]);
 
 })
@@ -1064,7 +1064,7 @@ function InnerArrayFilter(f, receiver, array, length, result) {
   }
   return result;
 }
-
+%SetForceInlineFlag(InnerArrayFilter);
 
 
 function ArrayFilter(f, receiver) {
@@ -1100,6 +1100,7 @@ function InnerArrayForEach(f, receiver, array, length) {
     }
   }
 }
+%SetForceInlineFlag(InnerArrayForEach);
 
 
 function ArrayForEach(f, receiver) {
@@ -1334,6 +1335,7 @@ function InnerArrayReduce(callback, current, array, length, argumentsLength) {
   }
   return current;
 }
+%SetForceInlineFlag(InnerArrayReduce);
 
 
 function ArrayReduce(callback, current) {
@@ -11,7 +11,6 @@
 // Imports
 
 var GlobalMap = global.Map;
-var GlobalObject = global.Object;
 var GlobalSet = global.Set;
 var hashCodeSymbol = utils.ImportNow("hash_code_symbol");
 var IntRandom;
@@ -259,7 +258,6 @@ function SetForEach(f, receiver) {
 
 %SetCode(GlobalSet, SetConstructor);
 %FunctionSetLength(GlobalSet, 0);
-%FunctionSetPrototype(GlobalSet, new GlobalObject());
 %AddNamedProperty(GlobalSet.prototype, "constructor", GlobalSet, DONT_ENUM);
 %AddNamedProperty(GlobalSet.prototype, toStringTagSymbol, "Set",
                   DONT_ENUM | READ_ONLY);
@@ -270,7 +268,6 @@ function SetForEach(f, receiver) {
 utils.InstallGetter(GlobalSet.prototype, "size", SetGetSize);
 utils.InstallFunctions(GlobalSet.prototype, DONT_ENUM, [
   "add", SetAdd,
-  "has", SetHas,
   "delete", SetDelete,
   "clear", SetClearJS,
   "forEach", SetForEach
@@ -439,7 +436,6 @@ function MapForEach(f, receiver) {
 
 %SetCode(GlobalMap, MapConstructor);
 %FunctionSetLength(GlobalMap, 0);
-%FunctionSetPrototype(GlobalMap, new GlobalObject());
 %AddNamedProperty(GlobalMap.prototype, "constructor", GlobalMap, DONT_ENUM);
 %AddNamedProperty(
     GlobalMap.prototype, toStringTagSymbol, "Map", DONT_ENUM | READ_ONLY);
@@ -449,9 +445,7 @@ function MapForEach(f, receiver) {
 // Set up the non-enumerable functions on the Map prototype object.
 utils.InstallGetter(GlobalMap.prototype, "size", MapGetSize);
 utils.InstallFunctions(GlobalMap.prototype, DONT_ENUM, [
-  "get", MapGet,
   "set", MapSet,
-  "has", MapHas,
   "delete", MapDelete,
   "clear", MapClearJS,
   "forEach", MapForEach
@@ -27,6 +27,7 @@ var GlobalRegExp = global.RegExp;
 var GlobalString = global.String;
 var InstallFunctions = utils.InstallFunctions;
 var InstallGetter = utils.InstallGetter;
+var InternalArray = utils.InternalArray;
 var InternalPackedArray = utils.InternalPackedArray;
 var InternalRegExpMatch;
 var InternalRegExpReplace
@@ -1975,19 +1976,45 @@ var defaultObjects = {
 };
 
 
+// Instances created with a single locale string and no options, keyed by
+// service and locale. At most kServiceCacheSize of them are kept, the oldest
+// one is dropped first.
+var kServiceCacheSize = 32;
+var serviceCache = {__proto__: null};
+var serviceCacheKeys = new InternalArray(kServiceCacheSize);
+var serviceCacheNext = 0;
+
+
 /**
  * Returns cached or newly created instance of a given service.
- * We cache only default instances (where no locales or options are provided).
+ * We cache only instances where no options are provided, and locales is either
+ * undefined or a single string.
  */
 function cachedOrNewService(service, locales, options, defaults) {
   var useOptions = (IS_UNDEFINED(defaults)) ? options : defaults;
-  if (IS_UNDEFINED(locales) && IS_UNDEFINED(options)) {
+  if (!IS_UNDEFINED(options)) {
+    return new savedObjects[service](locales, useOptions);
+  }
+  if (IS_UNDEFINED(locales)) {
     if (IS_UNDEFINED(defaultObjects[service])) {
       defaultObjects[service] = new savedObjects[service](locales, useOptions);
     }
     return defaultObjects[service];
   }
-  return new savedObjects[service](locales, useOptions);
+  if (!IS_STRING(locales)) {
+    return new savedObjects[service](locales, useOptions);
+  }
+  var key = service + ' ' + locales;
+  var instance = serviceCache[key];
+  if (IS_UNDEFINED(instance)) {
+    instance = new savedObjects[service](locales, useOptions);
+    var oldKey = serviceCacheKeys[serviceCacheNext];
+    if (!IS_UNDEFINED(oldKey)) delete serviceCache[oldKey];
+    serviceCacheKeys[serviceCacheNext] = key;
+    serviceCacheNext = (serviceCacheNext + 1) % kServiceCacheSize;
+    serviceCache[key] = instance;
+  }
+  return instance;
 }
 
 /**
@@ -409,6 +409,12 @@ function RegExpSplit(string, limit) {
     return [subject];
   }
 
+  // Sticky separators only match at the search position, so they keep the
+  // exec loop below.
+  if (!REGEXP_STICKY(separator)) {
+    return %RegExpSplit(separator, subject, limit, RegExpLastMatchInfo);
+  }
+
   var currentIndex = 0;
   var startIndex = 0;
   var startMatch = 0;
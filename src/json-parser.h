@@ -167,6 +167,12 @@ class JsonParser BASE_EMBEDDED {
   // as an element, not a property.
   ParseElementResult ParseElement(Handle<JSObject> json_object);
 
+  // Helper for ParseJsonObject. Matches the next key against the keys of the
+  // field transitions of |map| without internalizing it. On success stores
+  // the key and the transition target and returns true.
+  bool ParseJsonTransitionKey(Handle<Map> map, Handle<String>* key,
+                              Handle<Map>* target);
+
   // Parses a JSON array literal (grammar production JSONArray). An array
   // literal is a square-bracketed and comma separated sequence (possibly empty)
   // of JSON values.
@@ -187,6 +193,9 @@ class JsonParser BASE_EMBEDDED {
 
   static const int kInitialSpecialStringLength = 32;
   static const int kPretenureTreshold = 100 * 1024;
+  // Maps with more transitions are left to the transition search, which is
+  // cheaper than comparing the input against every key.
+  static const int kMaxTransitionsToMatch = 8;
 
 
  private:
@@ -345,6 +354,34 @@ ParseElementResult JsonParser<seq_one_byte>::ParseElement(
   return kElementNotFound;
 }
 
+template <bool seq_one_byte>
+bool JsonParser<seq_one_byte>::ParseJsonTransitionKey(Handle<Map> map,
+                                                      Handle<String>* key,
+                                                      Handle<Map>* target) {
+  DCHECK(seq_one_byte);
+  Object* raw_transitions = map->raw_transitions();
+  if (!TransitionArray::IsFullTransitionArray(raw_transitions)) return false;
+  int count = TransitionArray::NumberOfTransitions(raw_transitions);
+  if (count > kMaxTransitionsToMatch) return false;
+  // Matching a key does not allocate on the heap.
+  DisallowHeapAllocation no_gc;
+  for (int i = 0; i < count; i++) {
+    Name* name = TransitionArray::GetKey(raw_transitions, i);
+    if (!name->IsString()) continue;
+    Map* transition = TransitionArray::GetTarget(raw_transitions, i);
+    PropertyDetails details =
+        TransitionArray::GetTargetDetails(name, transition);
+    if (details.type() != DATA || details.attributes() != NONE) continue;
+    Handle<String> candidate(String::cast(name), isolate());
+    if (ParseJsonString(candidate)) {
+      *key = candidate;
+      *target = handle(transition, isolate());
+      return true;
+    }
+  }
+  return false;
+}
+
 // Parse a JSON object. Position must be right at '{'.
 template <bool seq_one_byte>
 Handle<Object> JsonParser<seq_one_byte>::ParseJsonObject() {
@@ -391,11 +428,16 @@ Handle<Object> JsonParser<seq_one_byte>::ParseJsonObject() {
       if (seq_one_byte) {
         key = TransitionArray::ExpectedTransitionKey(map);
         follow_expected = !key.is_null() && ParseJsonString(key);
+        // If the expected transition hits, follow it.
+        if (follow_expected) {
+          target = TransitionArray::ExpectedTransitionTarget(map);
+        } else {
+          // Otherwise the key may still be one of a few known field
+          // transitions, as when parsing objects of a handful of shapes.
+          follow_expected = ParseJsonTransitionKey(map, &key, &target);
+        }
       }
-      // If the expected transition hits, follow it.
-      if (follow_expected) {
-        target = TransitionArray::ExpectedTransitionTarget(map);
-      } else {
+      if (!follow_expected) {
         // If the expected transition failed, parse an internalized string and
         // try to find a matching transition.
         key = ParseJsonInternalizedString();
@@ -811,8 +853,15 @@ Handle<String> JsonParser<seq_one_byte>::ScanJsonString() {
   }
 
   int beg_pos = position_;
+  if (seq_one_byte) {
+    // Skip straight to the first character that needs a closer look.
+    position_ = FindJsonStringSpecialCharacter(seq_source_->GetChars(),
+                                               position_, source_length_) -
+                1;
+    Advance();
+  }
   // Fast case for Latin1 only without escape characters.
-  do {
+  while (c0_ != '"') {
     // Check for control character (0x00-0x1f) or unterminated string (<0).
     if (c0_ < 0x20) return Handle<String>::null();
     if (c0_ != '\\') {
@@ -828,7 +877,7 @@ Handle<String> JsonParser<seq_one_byte>::ScanJsonString() {
                                                            beg_pos,
                                                            position_);
     }
-  } while (c0_ != '"');
+  }
   int length = position_ - beg_pos;
   Handle<String> result =
       factory()->NewRawOneByteString(length, pretenure_).ToHandleChecked();
@@ -608,6 +608,24 @@ void BasicJsonStringifier::SerializeStringUnchecked_(
   // The <uc16, char> version of this method must not be called.
   DCHECK(sizeof(DestChar) >= sizeof(SrcChar));
 
+  if (sizeof(SrcChar) == 1) {
+    // Copy the runs of characters that need no escaping in bulk. Apart from
+    // the characters found here, the escape table maps one-byte characters
+    // to themselves.
+    const uint8_t* chars = reinterpret_cast<const uint8_t*>(src.start());
+    int length = src.length();
+    int i = 0;
+    while (i < length) {
+      int next = FindJsonStringSpecialCharacter(chars, i, length);
+      dest->AppendChars(chars + i, next - i);
+      if (next == length) break;
+      dest->AppendCString(
+          &JsonEscapeTable[chars[next] * kJsonEscapeTableEntrySize]);
+      i = next + 1;
+    }
+    return;
+  }
+
   for (int i = 0; i < src.length(); i++) {
     SrcChar c = src[i];
     if (DoNotEscape(c)) {
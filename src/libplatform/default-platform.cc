@@ -17,8 +17,11 @@ namespace v8 {
 namespace platform {
 
 
-v8::Platform* CreateDefaultPlatform(int thread_pool_size) {
-  DefaultPlatform* platform = new DefaultPlatform();
+v8::Platform* CreateDefaultPlatform(int thread_pool_size,
+                                    IdleTaskSupport idle_task_support,
+                                    NumaSupport numa_support) {
+  DefaultPlatform* platform =
+      new DefaultPlatform(idle_task_support, numa_support);
   platform->SetThreadPoolSize(thread_pool_size);
   platform->EnsureInitialized();
   return platform;
@@ -29,19 +32,53 @@ bool PumpMessageLoop(v8::Platform* platform, v8::Isolate* isolate) {
   return reinterpret_cast<DefaultPlatform*>(platform)->PumpMessageLoop(isolate);
 }
 
+
+void RunIdleTasks(v8::Platform* platform, v8::Isolate* isolate,
+                  double idle_time_in_seconds) {
+  reinterpret_cast<DefaultPlatform*>(platform)->RunIdleTasks(
+      isolate, idle_time_in_seconds);
+}
+
+
+void SetTracingController(
+    v8::Platform* platform,
+    v8::platform::tracing::TracingController* tracing_controller) {
+  reinterpret_cast<DefaultPlatform*>(platform)->SetTracingController(
+      tracing_controller);
+}
+
+
+void CallDelayedOnBackgroundThread(
+    v8::Platform* platform, v8::Task* task,
+    v8::Platform::ExpectedRuntime expected_runtime, double delay_in_seconds) {
+  reinterpret_cast<DefaultPlatform*>(platform)->CallDelayedOnBackgroundThread(
+      task, expected_runtime, delay_in_seconds);
+}
+
 const int DefaultPlatform::kMaxThreadPoolSize = 8;
 
-DefaultPlatform::DefaultPlatform()
-    : initialized_(false), thread_pool_size_(0) {}
+DefaultPlatform::DefaultPlatform(IdleTaskSupport idle_task_support,
+                                 NumaSupport numa_support)
+    : initialized_(false),
+      thread_pool_size_(0),
+      queue_(NULL),
+      idle_task_support_(idle_task_support),
+      numa_support_(numa_support),
+      tracing_controller_(NULL) {}
 
 
 DefaultPlatform::~DefaultPlatform() {
   base::LockGuard<base::Mutex> guard(&lock_);
-  queue_.Terminate();
+  while (!background_delayed_queue_.empty()) {
+    delete background_delayed_queue_.top().task;
+    background_delayed_queue_.pop();
+  }
   if (initialized_) {
+    queue_->Terminate();
     for (auto i = thread_pool_.begin(); i != thread_pool_.end(); ++i) {
       delete *i;
     }
+    delete queue_;
   }
   for (auto i = main_thread_queue_.begin(); i != main_thread_queue_.end();
        ++i) {
@@ -57,6 +94,15 @@ DefaultPlatform::~DefaultPlatform() {
       i->second.pop();
     }
   }
+  for (auto i = main_thread_idle_queue_.begin();
+       i != main_thread_idle_queue_.end(); ++i) {
+    while (!i->second.empty()) {
+      delete i->second.front();
+      i->second.pop();
+    }
+  }
+  // Worker threads may trace until they are joined above.
+  delete tracing_controller_;
 }
 
 
@@ -76,8 +122,12 @@ void DefaultPlatform::EnsureInitialized() {
   if (initialized_) return;
   initialized_ = true;
 
+  int number_of_nodes = numa_support_ == NumaSupport::kEnabled
+                            ? base::OS::GetNumaNodeCount()
+                            : 1;
+  queue_ = new TaskQueue(std::max(thread_pool_size_, 1), number_of_nodes);
   for (int i = 0; i < thread_pool_size_; ++i)
-    thread_pool_.push_back(new WorkerThread(&queue_));
+    thread_pool_.push_back(new WorkerThread(queue_, i));
 }
 
 
@@ -107,10 +157,51 @@ Task* DefaultPlatform::PopTaskInMainThreadDelayedQueue(v8::Isolate* isolate) {
 }
 
 
+IdleTask* DefaultPlatform::PopTaskInMainThreadIdleQueue(v8::Isolate* isolate) {
+  auto it = main_thread_idle_queue_.find(isolate);
+  if (it == main_thread_idle_queue_.end() || it->second.empty()) {
+    return NULL;
+  }
+  IdleTask* task = it->second.front();
+  it->second.pop();
+  return task;
+}
+
+
+void DefaultPlatform::MoveDelayedBackgroundTasks() {
+  if (background_delayed_queue_.empty()) return;
+  double now = MonotonicallyIncreasingTime();
+  while (!background_delayed_queue_.empty() &&
+         background_delayed_queue_.top().deadline <= now) {
+    const DelayedBackgroundEntry& entry = background_delayed_queue_.top();
+    AppendToBackgroundQueue(entry.task, entry.expected_runtime);
+    background_delayed_queue_.pop();
+  }
+}
+
+
+void DefaultPlatform::AppendToBackgroundQueue(
+    Task* task, ExpectedRuntime expected_runtime) {
+  DCHECK_NOT_NULL(queue_);
+  // Short running tasks are mostly GC tasks that the main thread waits for,
+  // so they are not queued behind long running ones.
+  TaskQueue::Priority priority = expected_runtime == kShortRunningTask
+                                    ? TaskQueue::kHighPriority
+                                    : TaskQueue::kLowPriority;
+  // Tasks mostly touch the data of the isolate posting them, so they run on
+  // the NUMA node of the posting thread.
+  int node = numa_support_ == NumaSupport::kEnabled
+                 ? base::OS::GetCurrentNumaNode()
+                 : TaskQueue::kAnyNode;
+  queue_->Append(task, priority, node);
+}
+
+
 bool DefaultPlatform::PumpMessageLoop(v8::Isolate* isolate) {
   Task* task = NULL;
   {
     base::LockGuard<base::Mutex> guard(&lock_);
+    MoveDelayedBackgroundTasks();
 
     // Move delayed tasks that hit their deadline to the main queue.
     task = PopTaskInMainThreadDelayedQueue(isolate);
@@ -131,10 +222,41 @@ bool DefaultPlatform::PumpMessageLoop(v8::Isolate* isolate) {
 }
 
 
+void DefaultPlatform::RunIdleTasks(v8::Isolate* isolate,
+                                   double idle_time_in_seconds) {
+  DCHECK(IdleTaskSupport::kEnabled == idle_task_support_);
+  double deadline_in_seconds =
+      MonotonicallyIncreasingTime() + idle_time_in_seconds;
+  while (deadline_in_seconds > MonotonicallyIncreasingTime()) {
+    IdleTask* task;
+    {
+      base::LockGuard<base::Mutex> guard(&lock_);
+      MoveDelayedBackgroundTasks();
+      task = PopTaskInMainThreadIdleQueue(isolate);
+    }
+    if (task == NULL) return;
+    task->Run(deadline_in_seconds);
+    delete task;
+  }
+}
+
+
 void DefaultPlatform::CallOnBackgroundThread(Task *task,
                                              ExpectedRuntime expected_runtime) {
   EnsureInitialized();
-  queue_.Append(task);
+  AppendToBackgroundQueue(task, expected_runtime);
+}
+
+
+void DefaultPlatform::CallDelayedOnBackgroundThread(
+    Task* task, ExpectedRuntime expected_runtime, double delay_in_seconds) {
+  EnsureInitialized();
+  base::LockGuard<base::Mutex> guard(&lock_);
+  DelayedBackgroundEntry entry;
+  entry.deadline = MonotonicallyIncreasingTime() + delay_in_seconds;
+  entry.expected_runtime = expected_runtime;
+  entry.task = task;
+  background_delayed_queue_.push(entry);
 }
 
 
@@ -155,11 +277,14 @@ void DefaultPlatform::CallDelayedOnForegroundThread(Isolate* isolate,
 
 void DefaultPlatform::CallIdleOnForegroundThread(Isolate* isolate,
                                                  IdleTask* task) {
-  UNREACHABLE();
+  base::LockGuard<base::Mutex> guard(&lock_);
+  main_thread_idle_queue_[isolate].push(task);
 }
 
 
-bool DefaultPlatform::IdleTasksEnabled(Isolate* isolate) { return false; }
+bool DefaultPlatform::IdleTasksEnabled(Isolate* isolate) {
+  return idle_task_support_ == IdleTaskSupport::kEnabled;
+}
 
 
 double DefaultPlatform::MonotonicallyIncreasingTime() {
@@ -173,24 +298,45 @@ uint64_t DefaultPlatform::AddTraceEvent(
     const char* scope, uint64_t id, uint64_t bind_id, int num_args,
     const char** arg_names, const uint8_t* arg_types,
     const uint64_t* arg_values, unsigned int flags) {
-  return 0;
+  if (tracing_controller_ == NULL) return 0;
+  return tracing_controller_->AddTraceEvent(
+      phase, category_enabled_flag, name, scope, id, bind_id, num_args,
+      arg_names, arg_types, arg_values, flags);
 }
 
 
 void DefaultPlatform::UpdateTraceEventDuration(
-    const uint8_t* category_enabled_flag, const char* name, uint64_t handle) {}
+    const uint8_t* category_enabled_flag, const char* name, uint64_t handle) {
+  if (tracing_controller_ == NULL) return;
+  tracing_controller_->UpdateTraceEventDuration(category_enabled_flag, name,
+                                                handle);
+}
 
 
 const uint8_t* DefaultPlatform::GetCategoryGroupEnabled(const char* name) {
-  static uint8_t no = 0;
-  return &no;
+  if (tracing_controller_ == NULL) {
+    static uint8_t no = 0;
+    return &no;
+  }
+  return tracing_controller_->GetCategoryGroupEnabled(name);
 }
 
 
 const char* DefaultPlatform::GetCategoryGroupName(
     const uint8_t* category_enabled_flag) {
-  static const char dummy[] = "dummy";
-  return dummy;
+  if (tracing_controller_ == NULL) {
+    static const char dummy[] = "dummy";
+    return dummy;
+  }
+  return tracing::TracingController::GetCategoryGroupName(
+      category_enabled_flag);
+}
+
+
+void DefaultPlatform::SetTracingController(
+    tracing::TracingController* tracing_controller) {
+  delete tracing_controller_;
+  tracing_controller_ = tracing_controller;
 }
 
 
@@ -10,6 +10,8 @@
 #include <queue>
 #include <vector>
 
+#include "include/libplatform/libplatform.h"
+#include "include/libplatform/v8-tracing.h"
 #include "include/v8-platform.h"
 #include "src/base/macros.h"
 #include "src/base/platform/mutex.h"
@@ -24,7 +26,9 @@ class WorkerThread;
 
 class DefaultPlatform : public Platform {
  public:
-  DefaultPlatform();
+  explicit DefaultPlatform(
+      IdleTaskSupport idle_task_support = IdleTaskSupport::kDisabled,
+      NumaSupport numa_support = NumaSupport::kDisabled);
   virtual ~DefaultPlatform();
 
   void SetThreadPoolSize(int thread_pool_size);
@@ -33,6 +37,15 @@ class DefaultPlatform : public Platform {
 
   bool PumpMessageLoop(v8::Isolate* isolate);
 
+  void RunIdleTasks(v8::Isolate* isolate, double idle_time_in_seconds);
+
+  void CallDelayedOnBackgroundThread(Task* task,
+                                     ExpectedRuntime expected_runtime,
+                                     double delay_in_seconds);
+
+  // Takes ownership of |tracing_controller|.
+  void SetTracingController(tracing::TracingController* tracing_controller);
+
   // v8::Platform implementation.
   size_t NumberOfAvailableBackgroundThreads() override;
   void CallOnBackgroundThread(Task* task,
@@ -61,13 +74,18 @@ class DefaultPlatform : public Platform {
 
   Task* PopTaskInMainThreadQueue(v8::Isolate* isolate);
   Task* PopTaskInMainThreadDelayedQueue(v8::Isolate* isolate);
+  IdleTask* PopTaskInMainThreadIdleQueue(v8::Isolate* isolate);
+  // Posts the delayed background tasks that hit their deadline.
+  void MoveDelayedBackgroundTasks();
+  void AppendToBackgroundQueue(Task* task, ExpectedRuntime expected_runtime);
 
   base::Mutex lock_;
   bool initialized_;
   int thread_pool_size_;
   std::vector<WorkerThread*> thread_pool_;
-  TaskQueue queue_;
+  TaskQueue* queue_;
   std::map<v8::Isolate*, std::queue<Task*> > main_thread_queue_;
+  std::map<v8::Isolate*, std::queue<IdleTask*> > main_thread_idle_queue_;
 
   typedef std::pair<double, Task*> DelayedEntry;
   std::map<v8::Isolate*,
@@ -75,6 +93,22 @@ class DefaultPlatform : public Platform {
                                std::greater<DelayedEntry> > >
       main_thread_delayed_queue_;
 
+  struct DelayedBackgroundEntry {
+    double deadline;
+    ExpectedRuntime expected_runtime;
+    Task* task;
+    bool operator>(const DelayedBackgroundEntry& other) const {
+      return deadline > other.deadline;
+    }
+  };
+  std::priority_queue<DelayedBackgroundEntry,
+                      std::vector<DelayedBackgroundEntry>,
+                      std::greater<DelayedBackgroundEntry> >
+      background_delayed_queue_;
+  IdleTaskSupport idle_task_support_;
+  NumaSupport numa_support_;
+  tracing::TracingController* tracing_controller_;
+
   DISALLOW_COPY_AND_ASSIGN(DefaultPlatform);
 };
 
@@ -4,44 +4,118 @@
 
 #include "src/libplatform/task-queue.h"
 
+#include <algorithm>
+
 #include "src/base/logging.h"
 
 namespace v8 {
 namespace platform {
 
-TaskQueue::TaskQueue() : process_queue_semaphore_(0), terminated_(false) {}
+TaskQueue::TaskQueue(int number_of_workers, int number_of_nodes)
+    : number_of_workers_(number_of_workers),
+      // Every node needs at least one worker.
+      number_of_nodes_(std::min(number_of_nodes, number_of_workers)),
+      worker_queues_(new WorkerQueue[number_of_workers]),
+      next_worker_(0),
+      terminated_(false) {
+  DCHECK_LT(0, number_of_workers);
+  DCHECK_LT(0, number_of_nodes);
+  for (int i = 0; i < number_of_nodes_; ++i) {
+    process_queue_semaphores_.push_back(new base::Semaphore(0));
+  }
+}
 
 
 TaskQueue::~TaskQueue() {
   base::LockGuard<base::Mutex> guard(&lock_);
   DCHECK(terminated_);
-  DCHECK(task_queue_.empty());
+#ifdef DEBUG
+  for (int i = 0; i < number_of_workers_; ++i) {
+    for (int priority = 0; priority < kNumberOfPriorities; ++priority) {
+      DCHECK(worker_queues_[i].tasks[priority].empty());
+    }
+  }
+#endif
+  delete[] worker_queues_;
+  for (size_t i = 0; i < process_queue_semaphores_.size(); ++i) {
+    delete process_queue_semaphores_[i];
+  }
 }
 
 
-void TaskQueue::Append(Task* task) {
-  base::LockGuard<base::Mutex> guard(&lock_);
-  DCHECK(!terminated_);
-  task_queue_.push(task);
-  process_queue_semaphore_.Signal();
+void TaskQueue::Append(Task* task, Priority priority, int node) {
+  DCHECK_LE(0, priority);
+  DCHECK_LT(priority, kNumberOfPriorities);
+  uint32_t count = static_cast<uint32_t>(
+      base::NoBarrier_AtomicIncrement(&next_worker_, 1));
+  int worker;
+  if (node == kAnyNode) {
+    worker = count % number_of_workers_;
+  } else {
+    // Pick one of the workers node, node + number_of_nodes_, ...
+    node %= number_of_nodes_;
+    int workers_on_node =
+        (number_of_workers_ - node + number_of_nodes_ - 1) / number_of_nodes_;
+    worker = node + number_of_nodes_ * (count % workers_on_node);
+  }
+  WorkerQueue* queue = &worker_queues_[worker];
+  {
+    base::LockGuard<base::Mutex> guard(&queue->lock);
+    queue->tasks[priority].push_back(task);
+  }
+  process_queue_semaphores_[NodeOfWorker(worker)]->Signal();
 }
 
 
-Task* TaskQueue::GetNext() {
+Task* TaskQueue::TryPop(int worker, Priority priority, bool steal) {
+  WorkerQueue* queue = &worker_queues_[worker];
+  base::LockGuard<base::Mutex> guard(&queue->lock);
+  std::deque<Task*>* tasks = &queue->tasks[priority];
+  if (tasks->empty()) return NULL;
+  Task* result;
+  if (steal) {
+    result = tasks->back();
+    tasks->pop_back();
+  } else {
+    result = tasks->front();
+    tasks->pop_front();
+  }
+  return result;
+}
+
+
+Task* TaskQueue::TryGetNext(int worker) {
+  for (int priority = 0; priority < kNumberOfPriorities; ++priority) {
+    Priority p = static_cast<Priority>(priority);
+    if (Task* task = TryPop(worker, p, false)) return task;
+    // Only steal from workers of the same node.
+    for (int i = number_of_nodes_; i < number_of_workers_;
+         i += number_of_nodes_) {
+      int victim = (worker + i) % number_of_workers_;
+      if (NodeOfWorker(victim) != NodeOfWorker(worker)) continue;
+      if (Task* task = TryPop(victim, p, true)) return task;
+    }
+  }
+  return NULL;
+}
+
+
+Task* TaskQueue::GetNext(int worker) {
+  DCHECK_LE(0, worker);
+  DCHECK_LT(worker, number_of_workers_);
+  base::Semaphore* semaphore = process_queue_semaphores_[NodeOfWorker(worker)];
   for (;;) {
+    if (Task* task = TryGetNext(worker)) return task;
     {
       base::LockGuard<base::Mutex> guard(&lock_);
-      if (!task_queue_.empty()) {
-        Task* result = task_queue_.front();
-        task_queue_.pop();
-        return result;
-      }
       if (terminated_) {
-        process_queue_semaphore_.Signal();
+        // Tasks appended right before termination may have been missed above.
+        if (Task* task = TryGetNext(worker)) return task;
+        semaphore->Signal();
         return NULL;
       }
     }
-    process_queue_semaphore_.Wait();
+    semaphore->Wait();
   }
 }
 
@@ -50,7 +124,9 @@ void TaskQueue::Terminate() {
   base::LockGuard<base::Mutex> guard(&lock_);
   DCHECK(!terminated_);
   terminated_ = true;
-  process_queue_semaphore_.Signal();
+  for (size_t i = 0; i < process_queue_semaphores_.size(); ++i) {
+    process_queue_semaphores_[i]->Signal();
+  }
 }
 
 }  // namespace platform
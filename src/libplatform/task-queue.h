@@ -5,8 +5,10 @@
 #ifndef V8_LIBPLATFORM_TASK_QUEUE_H_
 #define V8_LIBPLATFORM_TASK_QUEUE_H_
 
-#include <queue>
+#include <deque>
+#include <vector>
 
+#include "src/base/atomicops.h"
 #include "src/base/macros.h"
 #include "src/base/platform/mutex.h"
 #include "src/base/platform/semaphore.h"
@@ -17,25 +19,64 @@ class Task;
 
 namespace platform {
 
+// The queue of background tasks shared by the worker threads. Every worker
+// owns a deque per priority, which avoids contention on a single lock. Tasks
+// appended to the queue are distributed round-robin over the workers, and a
+// worker whose own deques are empty steals from the back of the other ones.
+//
+// Workers can be split into NUMA nodes, worker i belonging to node
+// i % number_of_nodes. Tasks appended for a node are only run by the workers
+// of that node.
 class TaskQueue {
  public:
-  TaskQueue();
+  enum Priority {
+    // Tasks on the critical path of the main thread, e.g. sweeping.
+    kHighPriority,
+    // Best-effort tasks, e.g. optimizing compiles.
+    kLowPriority,
+    kNumberOfPriorities
+  };
+
+  // Appending a task for |kAnyNode| distributes it over all workers.
+  static const int kAnyNode = -1;
+
+  explicit TaskQueue(int number_of_workers = 1, int number_of_nodes = 1);
   ~TaskQueue();
 
   // Appends a task to the queue. The queue takes ownership of |task|.
-  void Append(Task* task);
+  void Append(Task* task, Priority priority = kHighPriority,
+              int node = kAnyNode);
 
-  // Returns the next task to process. Blocks if no task is available. Returns
-  // NULL if the queue is terminated.
-  Task* GetNext();
+  // Returns the next task for the worker with index |worker|, preferring
+  // tasks of higher priority over tasks of the worker's own deques. Blocks if
+  // no task is available. Returns NULL if the queue is terminated.
+  Task* GetNext(int worker = 0);
 
   // Terminate the queue.
   void Terminate();
 
+  int number_of_workers() const { return number_of_workers_; }
+  int number_of_nodes() const { return number_of_nodes_; }
+  int NodeOfWorker(int worker) const { return worker % number_of_nodes_; }
+
  private:
-  base::Semaphore process_queue_semaphore_;
+  struct WorkerQueue {
+    base::Mutex lock;
+    std::deque<Task*> tasks[kNumberOfPriorities];
+  };
+
+  // Takes a task of the given priority from the front of |worker|'s deque,
+  // or, if |steal| is true, from the back.
+  Task* TryPop(int worker, Priority priority, bool steal);
+  Task* TryGetNext(int worker);
+
+  const int number_of_workers_;
+  const int number_of_nodes_;
+  WorkerQueue* worker_queues_;
+  base::Atomic32 next_worker_;
+  // One semaphore per node, counting the tasks appended to its workers.
+  std::vector<base::Semaphore*> process_queue_semaphores_;
   base::Mutex lock_;
-  std::queue<Task*> task_queue_;
   bool terminated_;
 
   DISALLOW_COPY_AND_ASSIGN(TaskQueue);
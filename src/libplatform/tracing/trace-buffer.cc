@@ -0,0 +1,161 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/libplatform/tracing/trace-buffer.h"
+
+#include <algorithm>
+
+#include "src/base/logging.h"
+
+namespace v8 {
+namespace platform {
+namespace tracing {
+
+TraceBufferRingBuffer::TraceBufferRingBuffer(size_t max_chunks,
+                                             TraceWriter* trace_writer)
+    : max_chunks_(max_chunks),
+      trace_writer_(trace_writer),
+      chunks_(max_chunks, NULL),
+      current_chunk_seq_(0),
+      current_chunk_(0) {
+  DCHECK_LT(0u, max_chunks);
+}
+
+
+TraceBufferRingBuffer::~TraceBufferRingBuffer() {
+  for (size_t i = 0; i < chunks_.size(); ++i) delete chunks_[i];
+  delete trace_writer_;
+}
+
+
+TraceObject* TraceBufferRingBuffer::AddTraceEvent(uint64_t* handle) {
+  for (;;) {
+    TraceBufferChunk* chunk = reinterpret_cast<TraceBufferChunk*>(
+        base::Acquire_Load(&current_chunk_));
+    if (chunk != NULL) {
+      size_t event_index;
+      TraceObject* trace_object = chunk->AddTraceEvent(&event_index);
+      if (trace_object != NULL) {
+        *handle = MakeHandle(chunk->seq(), event_index);
+        return trace_object;
+      }
+    }
+
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    // Another thread may have moved on to the next chunk in the meantime.
+    if (base::NoBarrier_Load(&current_chunk_) !=
+        reinterpret_cast<base::AtomicWord>(chunk)) {
+      continue;
+    }
+    uint32_t seq = ++current_chunk_seq_;
+    TraceBufferChunk*& next = chunks_[ChunkIndex(seq)];
+    if (next == NULL) {
+      next = new TraceBufferChunk(seq);
+    } else {
+      next->Reset(seq);
+    }
+    base::Release_Store(&current_chunk_,
+                        reinterpret_cast<base::AtomicWord>(next));
+  }
+}
+
+
+TraceObject* TraceBufferRingBuffer::GetEventByHandle(uint64_t handle) {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  size_t chunk_index, event_index;
+  uint32_t chunk_seq;
+  ExtractHandle(handle, &chunk_index, &chunk_seq, &event_index);
+  TraceBufferChunk* chunk = chunks_[chunk_index];
+  if (chunk == NULL || chunk->seq() != chunk_seq ||
+      event_index >= chunk->size()) {
+    return NULL;
+  }
+  return chunk->GetEventAt(event_index);
+}
+
+
+bool TraceBufferRingBuffer::Flush() {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  // Write the chunks from the oldest to the current one.
+  size_t current_index = ChunkIndex(current_chunk_seq_);
+  for (size_t i = 1; i <= max_chunks_; ++i) {
+    size_t index = (current_index + i) % max_chunks_;
+    TraceBufferChunk* chunk = chunks_[index];
+    if (chunk == NULL) continue;
+    for (size_t j = 0; j < chunk->size(); ++j) {
+      trace_writer_->AppendTraceEvent(chunk->GetEventAt(j));
+    }
+    delete chunk;
+    chunks_[index] = NULL;
+  }
+  base::Release_Store(&current_chunk_, 0);
+  trace_writer_->Flush();
+  return true;
+}
+
+
+uint64_t TraceBufferRingBuffer::MakeHandle(uint32_t chunk_seq,
+                                           size_t event_index) const {
+  return static_cast<uint64_t>(chunk_seq) * TraceBufferChunk::kChunkSize +
+         event_index;
+}
+
+
+void TraceBufferRingBuffer::ExtractHandle(uint64_t handle,
+                                          size_t* chunk_index,
+                                          uint32_t* chunk_seq,
+                                          size_t* event_index) const {
+  *event_index = static_cast<size_t>(handle % TraceBufferChunk::kChunkSize);
+  *chunk_seq = static_cast<uint32_t>(handle / TraceBufferChunk::kChunkSize);
+  *chunk_index = ChunkIndex(*chunk_seq);
+}
+
+
+size_t TraceBufferRingBuffer::ChunkIndex(uint32_t chunk_seq) const {
+  return (chunk_seq + max_chunks_ - 1) % max_chunks_;
+}
+
+
+const size_t TraceBufferChunk::kChunkSize;
+
+
+TraceBufferChunk::TraceBufferChunk(uint32_t seq) : next_free_(0), seq_(seq) {}
+
+
+void TraceBufferChunk::Reset(uint32_t new_seq) {
+  base::NoBarrier_Store(&next_free_, 0);
+  seq_ = new_seq;
+}
+
+
+bool TraceBufferChunk::IsFull() const {
+  return static_cast<size_t>(base::NoBarrier_Load(&next_free_)) >= kChunkSize;
+}
+
+
+TraceObject* TraceBufferChunk::AddTraceEvent(size_t* event_index) {
+  if (IsFull()) return NULL;
+  size_t index =
+      static_cast<size_t>(base::NoBarrier_AtomicIncrement(&next_free_, 1) - 1);
+  if (index >= kChunkSize) return NULL;
+  *event_index = index;
+  return &chunk_[index];
+}
+
+
+size_t TraceBufferChunk::size() const {
+  return std::min(static_cast<size_t>(base::NoBarrier_Load(&next_free_)),
+                  kChunkSize);
+}
+
+
+// static
+TraceBuffer* TraceBuffer::CreateTraceBufferRingBuffer(
+    size_t max_chunks, TraceWriter* trace_writer) {
+  return new TraceBufferRingBuffer(max_chunks, trace_writer);
+}
+
+}  // namespace tracing
+}  // namespace platform
+}  // namespace v8
@@ -0,0 +1,57 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_LIBPLATFORM_TRACING_TRACE_BUFFER_H_
+#define V8_LIBPLATFORM_TRACING_TRACE_BUFFER_H_
+
+#include <vector>
+
+#include "include/libplatform/v8-tracing.h"
+#include "src/base/atomicops.h"
+#include "src/base/macros.h"
+#include "src/base/platform/mutex.h"
+
+namespace v8 {
+namespace platform {
+namespace tracing {
+
+// A ring of chunks. Events are added to the current chunk without locking;
+// the mutex is only taken to move on to the next chunk, which recycles the
+// oldest one once all chunks are in use. A recycled chunk must not be written
+// to concurrently, i.e. the ring has to be large enough that no thread still
+// fills a chunk by the time the ring wraps around to it.
+class TraceBufferRingBuffer : public TraceBuffer {
+ public:
+  TraceBufferRingBuffer(size_t max_chunks, TraceWriter* trace_writer);
+  ~TraceBufferRingBuffer();
+
+  TraceObject* AddTraceEvent(uint64_t* handle) final;
+  TraceObject* GetEventByHandle(uint64_t handle) final;
+  bool Flush() final;
+
+ private:
+  // The chunk with sequence number |seq| lives at index (seq - 1) % max_chunks
+  // of the ring, so a handle only has to record the sequence number.
+  uint64_t MakeHandle(uint32_t chunk_seq, size_t event_index) const;
+  void ExtractHandle(uint64_t handle, size_t* chunk_index, uint32_t* chunk_seq,
+                     size_t* event_index) const;
+  size_t ChunkIndex(uint32_t chunk_seq) const;
+
+  base::Mutex mutex_;
+  size_t max_chunks_;
+  TraceWriter* trace_writer_;
+  std::vector<TraceBufferChunk*> chunks_;
+  // The sequence number of the current chunk. Guarded by |mutex_|.
+  uint32_t current_chunk_seq_;
+  // The chunk new events are added to, or NULL. Written under |mutex_|.
+  base::AtomicWord current_chunk_;
+
+  DISALLOW_COPY_AND_ASSIGN(TraceBufferRingBuffer);
+};
+
+}  // namespace tracing
+}  // namespace platform
+}  // namespace v8
+
+#endif  // V8_LIBPLATFORM_TRACING_TRACE_BUFFER_H_
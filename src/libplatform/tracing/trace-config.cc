@@ -0,0 +1,109 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string.h>
+
+#include "include/libplatform/v8-tracing.h"
+#include "src/base/logging.h"
+
+namespace v8 {
+namespace platform {
+namespace tracing {
+
+namespace {
+
+const char kDisabledByDefaultPrefix[] = "disabled-by-default-";
+
+bool IsDisabledByDefault(const std::string& category) {
+  return category.compare(0, strlen(kDisabledByDefaultPrefix),
+                          kDisabledByDefaultPrefix) == 0;
+}
+
+bool Contains(const TraceConfig::StringList& list,
+              const std::string& category) {
+  for (size_t i = 0; i < list.size(); ++i) {
+    if (list[i] == category) return true;
+  }
+  return false;
+}
+
+// Calls |callback| for every non-empty entry of the comma separated |list|,
+// with surrounding spaces removed.
+template <typename Callback>
+void ForEachCategory(const char* list, Callback callback) {
+  const char* start = list;
+  for (;;) {
+    const char* end = strchr(start, ',');
+    if (end == NULL) end = start + strlen(start);
+    const char* first = start;
+    const char* last = end;
+    while (first < last && *first == ' ') ++first;
+    while (last > first && *(last - 1) == ' ') --last;
+    if (first < last) callback(std::string(first, last));
+    if (*end == '\0') return;
+    start = end + 1;
+  }
+}
+
+}  // namespace
+
+
+// static
+TraceConfig* TraceConfig::CreateDefaultTraceConfig() {
+  TraceConfig* trace_config = new TraceConfig();
+  trace_config->include_all_ = true;
+  return trace_config;
+}
+
+
+// static
+TraceConfig* TraceConfig::CreateTraceConfigFromCategoryList(
+    const char* category_list) {
+  TraceConfig* trace_config = new TraceConfig();
+  ForEachCategory(category_list, [trace_config](const std::string& category) {
+    if (category == "*") {
+      trace_config->include_all_ = true;
+    } else if (category[0] == '-') {
+      trace_config->excluded_categories_.push_back(category.substr(1));
+    } else {
+      trace_config->included_categories_.push_back(category);
+    }
+  });
+  return trace_config;
+}
+
+
+void TraceConfig::AddIncludedCategory(const char* included_category) {
+  DCHECK(included_category != NULL && strlen(included_category) > 0);
+  included_categories_.push_back(included_category);
+}
+
+
+void TraceConfig::AddExcludedCategory(const char* excluded_category) {
+  DCHECK(excluded_category != NULL && strlen(excluded_category) > 0);
+  excluded_categories_.push_back(excluded_category);
+}
+
+
+bool TraceConfig::IsCategoryEnabled(const std::string& category) const {
+  if (Contains(excluded_categories_, category)) return false;
+  if (Contains(included_categories_, category)) return true;
+  return include_all_ && !IsDisabledByDefault(category);
+}
+
+
+bool TraceConfig::IsCategoryGroupEnabled(const char* category_group) const {
+  // A group like "v8,devtools.timeline" is enabled if any of its categories
+  // is.
+  bool enabled = false;
+  ForEachCategory(category_group,
+                  [this, &enabled](const std::string& category) {
+                    if (IsCategoryEnabled(category)) enabled = true;
+                  });
+  return enabled;
+}
+
+}  // namespace tracing
+}  // namespace platform
+}  // namespace v8
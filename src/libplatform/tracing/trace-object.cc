@@ -0,0 +1,108 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "include/libplatform/v8-tracing.h"
+
+#include <string.h>
+
+#include "base/trace_event/common/trace_event_common.h"
+#include "src/base/platform/platform.h"
+#include "src/base/platform/time.h"
+
+namespace v8 {
+namespace platform {
+namespace tracing {
+
+namespace {
+
+// Space for the string and its terminating NUL.
+size_t GetAllocLength(const char* str) { return str ? strlen(str) + 1 : 0; }
+
+// Copies |*member| into |*buffer|, sets |*member| to point to this new
+// location, and then advances |*buffer| by the amount written.
+void CopyTraceObjectParameter(char** buffer, const char** member) {
+  if (*member == NULL) return;
+  size_t length = strlen(*member) + 1;
+  memcpy(*buffer, *member, length);
+  *member = *buffer;
+  *buffer += length;
+}
+
+}  // namespace
+
+
+TraceObject::~TraceObject() { delete[] parameter_copy_storage_; }
+
+
+void TraceObject::Initialize(char phase, const uint8_t* category_enabled_flag,
+                             const char* name, const char* scope, uint64_t id,
+                             uint64_t bind_id, int num_args,
+                             const char** arg_names, const uint8_t* arg_types,
+                             const uint64_t* arg_values, unsigned int flags) {
+  pid_ = base::OS::GetCurrentProcessId();
+  tid_ = base::OS::GetCurrentThreadId();
+  phase_ = phase;
+  category_enabled_flag_ = category_enabled_flag;
+  name_ = name;
+  scope_ = scope;
+  id_ = id;
+  bind_id_ = bind_id;
+  flags_ = flags;
+  ts_ = base::TimeTicks::HighResolutionNow().ToInternalValue();
+  duration_ = 0;
+
+  // Clamp num_args since it may have been set by a third-party library.
+  num_args_ = num_args > kTraceMaxNumArgs ? kTraceMaxNumArgs : num_args;
+  for (int i = 0; i < num_args_; ++i) {
+    arg_names_[i] = arg_names[i];
+    arg_values_[i].as_uint = arg_values[i];
+    arg_types_[i] = arg_types[i];
+  }
+
+  // Objects are reused once the trace buffer wraps around.
+  delete[] parameter_copy_storage_;
+  parameter_copy_storage_ = NULL;
+
+  // Allocate a single buffer for all copied strings.
+  bool copy = (flags & TRACE_EVENT_FLAG_COPY) != 0;
+  size_t alloc_size = 0;
+  if (copy) {
+    alloc_size += GetAllocLength(name) + GetAllocLength(scope);
+    for (int i = 0; i < num_args_; ++i) {
+      alloc_size += GetAllocLength(arg_names_[i]);
+      if (arg_types_[i] == TRACE_VALUE_TYPE_STRING) {
+        arg_types_[i] = TRACE_VALUE_TYPE_COPY_STRING;
+      }
+    }
+  }
+  for (int i = 0; i < num_args_; ++i) {
+    if (arg_types_[i] == TRACE_VALUE_TYPE_COPY_STRING) {
+      alloc_size += GetAllocLength(arg_values_[i].as_string);
+    }
+  }
+  if (alloc_size == 0) return;
+
+  char* buffer = parameter_copy_storage_ = new char[alloc_size];
+  if (copy) {
+    CopyTraceObjectParameter(&buffer, &name_);
+    CopyTraceObjectParameter(&buffer, &scope_);
+    for (int i = 0; i < num_args_; ++i) {
+      CopyTraceObjectParameter(&buffer, &arg_names_[i]);
+    }
+  }
+  for (int i = 0; i < num_args_; ++i) {
+    if (arg_types_[i] == TRACE_VALUE_TYPE_COPY_STRING) {
+      CopyTraceObjectParameter(&buffer, &arg_values_[i].as_string);
+    }
+  }
+}
+
+
+void TraceObject::UpdateDuration() {
+  duration_ = base::TimeTicks::HighResolutionNow().ToInternalValue() - ts_;
+}
+
+}  // namespace tracing
+}  // namespace platform
+}  // namespace v8
@@ -0,0 +1,166 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/libplatform/tracing/trace-writer.h"
+
+#include <cmath>
+
+#include "base/trace_event/common/trace_event_common.h"
+#include "src/base/format-macros.h"
+#include "src/base/platform/platform.h"
+
+namespace v8 {
+namespace platform {
+namespace tracing {
+
+// Writes |str| as a JSON string literal, escaping quotes, backslashes and
+// control characters.
+void JSONTraceWriter::AppendString(const char* str) {
+  stream_ << "\"";
+  for (; str != NULL && *str != '\0'; ++str) {
+    char c = *str;
+    switch (c) {
+      case '"':
+        stream_ << "\\\"";
+        break;
+      case '\\':
+        stream_ << "\\\\";
+        break;
+      case '\b':
+        stream_ << "\\b";
+        break;
+      case '\f':
+        stream_ << "\\f";
+        break;
+      case '\n':
+        stream_ << "\\n";
+        break;
+      case '\r':
+        stream_ << "\\r";
+        break;
+      case '\t':
+        stream_ << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char buffer[8];
+          base::OS::SNPrintF(buffer, sizeof(buffer), "\\u%04X", c);
+          stream_ << buffer;
+        } else {
+          stream_ << c;
+        }
+        break;
+    }
+  }
+  stream_ << "\"";
+}
+
+
+void JSONTraceWriter::AppendArgValue(uint8_t type,
+                                     TraceObject::ArgValue value) {
+  switch (type) {
+    case TRACE_VALUE_TYPE_BOOL:
+      stream_ << (value.as_bool ? "true" : "false");
+      break;
+    case TRACE_VALUE_TYPE_UINT:
+      stream_ << value.as_uint;
+      break;
+    case TRACE_VALUE_TYPE_INT:
+      stream_ << value.as_int;
+      break;
+    case TRACE_VALUE_TYPE_DOUBLE: {
+      // JSON has no representation for NaN and infinity.
+      double d = value.as_double;
+      if (std::isnan(d)) {
+        stream_ << "\"NaN\"";
+      } else if (std::isinf(d)) {
+        stream_ << (d > 0 ? "\"Infinity\"" : "\"-Infinity\"");
+      } else {
+        char buffer[32];
+        base::OS::SNPrintF(buffer, sizeof(buffer), "%.17g", d);
+        stream_ << buffer;
+      }
+      break;
+    }
+    case TRACE_VALUE_TYPE_POINTER: {
+      // JSON only supports double numbers, so pointers are written as
+      // hexadecimal strings.
+      char buffer[32];
+      base::OS::SNPrintF(buffer, sizeof(buffer), "\"%p\"", value.as_pointer);
+      stream_ << buffer;
+      break;
+    }
+    case TRACE_VALUE_TYPE_STRING:
+    case TRACE_VALUE_TYPE_COPY_STRING:
+      AppendString(value.as_string);
+      break;
+    default:
+      stream_ << "\"<unsupported>\"";
+      break;
+  }
+}
+
+
+JSONTraceWriter::JSONTraceWriter(std::ostream& stream)
+    : stream_(stream), append_comma_(false) {
+  stream_ << "{\"traceEvents\":[";
+}
+
+
+JSONTraceWriter::~JSONTraceWriter() {
+  stream_ << "]}";
+  stream_.flush();
+}
+
+
+void JSONTraceWriter::AppendTraceEvent(TraceObject* trace_event) {
+  if (append_comma_) stream_ << ",";
+  append_comma_ = true;
+  stream_ << "{\"pid\":" << trace_event->pid()
+          << ",\"tid\":" << trace_event->tid()
+          << ",\"ts\":" << trace_event->ts()
+          << ",\"ph\":\"" << trace_event->phase() << "\",\"cat\":";
+  AppendString(TracingController::GetCategoryGroupName(
+      trace_event->category_enabled_flag()));
+  stream_ << ",\"name\":";
+  AppendString(trace_event->name());
+  if (trace_event->phase() == TRACE_EVENT_PHASE_COMPLETE) {
+    stream_ << ",\"dur\":" << trace_event->duration();
+  }
+  if (trace_event->flags() & TRACE_EVENT_FLAG_HAS_ID) {
+    if (trace_event->scope() != NULL) {
+      stream_ << ",\"scope\":";
+      AppendString(trace_event->scope());
+    }
+    // So as not to lose bits from a 64-bit integer, output as a hex string.
+    char buffer[24];
+    base::OS::SNPrintF(buffer, sizeof(buffer), "\"0x%" PRIx64 "\"",
+                       trace_event->id());
+    stream_ << ",\"id\":" << buffer;
+  }
+  stream_ << ",\"args\":{";
+  const char** arg_names = trace_event->arg_names();
+  const uint8_t* arg_types = trace_event->arg_types();
+  const TraceObject::ArgValue* arg_values = trace_event->arg_values();
+  for (int i = 0; i < trace_event->num_args(); ++i) {
+    if (i > 0) stream_ << ",";
+    AppendString(arg_names[i]);
+    stream_ << ":";
+    AppendArgValue(arg_types[i], arg_values[i]);
+  }
+  stream_ << "}}";
+}
+
+
+void JSONTraceWriter::Flush() { stream_.flush(); }
+
+
+// static
+TraceWriter* TraceWriter::CreateJSONTraceWriter(std::ostream& stream) {
+  return new JSONTraceWriter(stream);
+}
+
+}  // namespace tracing
+}  // namespace platform
+}  // namespace v8
@@ -10,8 +10,22 @@
 namespace v8 {
 namespace platform {
 
-WorkerThread::WorkerThread(TaskQueue* queue)
-    : Thread(Options("V8 WorkerThread")), queue_(queue) {
+namespace {
+
+base::Thread::Options WorkerThreadOptions(TaskQueue* queue, int index) {
+  base::Thread::Options options("V8 WorkerThread");
+  // Keep the worker on the NUMA node whose tasks it runs.
+  if (queue->number_of_nodes() > 1) {
+    options.set_numa_node(queue->NodeOfWorker(index));
+  }
+  return options;
+}
+
+}  // namespace
+
+
+WorkerThread::WorkerThread(TaskQueue* queue, int index)
+    : Thread(WorkerThreadOptions(queue, index)), queue_(queue), index_(index) {
   Start();
 }
 
@@ -22,7 +36,7 @@ WorkerThread::~WorkerThread() {
 
 
 void WorkerThread::Run() {
-  while (Task* task = queue_->GetNext()) {
+  while (Task* task = queue_->GetNext(index_)) {
     task->Run();
     delete task;
   }
@@ -18,7 +18,8 @@ class TaskQueue;
 
 class WorkerThread : public base::Thread {
  public:
-  explicit WorkerThread(TaskQueue* queue);
+  // |index| selects the worker deques of |queue| the thread mainly works on.
+  WorkerThread(TaskQueue* queue, int index);
   virtual ~WorkerThread();
 
   // Thread implementation.
@@ -28,6 +29,7 @@ class WorkerThread : public base::Thread {
   friend class QuitTask;
 
   TaskQueue* queue_;
+  int index_;
 
   DISALLOW_COPY_AND_ASSIGN(WorkerThread);
 };
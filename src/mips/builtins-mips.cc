@@ -1002,6 +1002,11 @@ void Builtins::Generate_InterpreterEntryTrampoline(MacroAssembler* masm) {
               Operand(BYTECODE_ARRAY_TYPE));
   }
 
+  // Reset code age.
+  __ li(t0, Operand(BytecodeArray::kNoAgeBytecodeAge));
+  __ sb(t0, FieldMemOperand(kInterpreterBytecodeArrayRegister,
+                            BytecodeArray::kBytecodeAgeOffset));
+
   // Push new.target, bytecode array and zero for bytecode array offset.
   __ Push(a3, kInterpreterBytecodeArrayRegister, zero_reg);
 
@@ -1390,6 +1395,10 @@ void Builtins::Generate_CompileBaseline(MacroAssembler* masm) {
   GenerateTailCallToReturnedCode(masm, Runtime::kCompileBaseline);
 }
 
+void Builtins::Generate_DeserializeLazy(MacroAssembler* masm) {
+  GenerateTailCallToReturnedCode(masm, Runtime::kDeserializeLazy);
+}
+
 void Builtins::Generate_CompileOptimized(MacroAssembler* masm) {
   GenerateTailCallToReturnedCode(masm,
                                  Runtime::kCompileOptimized_NotConcurrent);
@@ -1665,9 +1674,15 @@ void Builtins::Generate_HandleFastApiCall(MacroAssembler* masm) {
 }
 
 
-void Builtins::Generate_OnStackReplacement(MacroAssembler* masm) {
+static void Generate_OnStackReplacementHelper(MacroAssembler* masm,
+                                              bool has_handler_frame) {
   // Lookup the function in the JavaScript frame.
-  __ lw(a0, MemOperand(fp, JavaScriptFrameConstants::kFunctionOffset));
+  if (has_handler_frame) {
+    __ lw(a0, MemOperand(fp, StandardFrameConstants::kCallerFPOffset));
+    __ lw(a0, MemOperand(a0, JavaScriptFrameConstants::kFunctionOffset));
+  } else {
+    __ lw(a0, MemOperand(fp, JavaScriptFrameConstants::kFunctionOffset));
+  }
   {
     FrameScope scope(masm, StackFrame::INTERNAL);
     // Pass function as argument.
@@ -1678,6 +1693,13 @@ void Builtins::Generate_OnStackReplacement(MacroAssembler* masm) {
   // If the code object is null, just return to the unoptimized code.
   __ Ret(eq, v0, Operand(Smi::FromInt(0)));
 
+  // Drop the handler frame that is sitting on top of the actual
+  // JavaScript frame. This is the case when OSR is triggered from
+  // bytecode.
+  if (has_handler_frame) {
+    __ LeaveFrame(StackFrame::STUB);
+  }
+
   // Load deoptimization data from the code object.
   // <deopt_data> = <code>[#deoptimization_data_offset]
   __ lw(a1, MemOperand(v0, Code::kDeoptimizationDataOffset - kHeapObjectTag));
@@ -1698,6 +1720,16 @@ void Builtins::Generate_OnStackReplacement(MacroAssembler* masm) {
 }
 
 
+void Builtins::Generate_OnStackReplacement(MacroAssembler* masm) {
+  Generate_OnStackReplacementHelper(masm, false);
+}
+
+
+void Builtins::Generate_InterpreterOnStackReplacement(MacroAssembler* masm) {
+  Generate_OnStackReplacementHelper(masm, true);
+}
+
+
 // static
 void Builtins::Generate_DatePrototype_GetField(MacroAssembler* masm,
                                                int field_index) {
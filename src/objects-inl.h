@@ -1727,9 +1727,10 @@ inline bool AllocationSite::DigestPretenuringFeedback(
   int create_count = memento_create_count();
   int found_count = memento_found_count();
   bool minimum_mementos_created = create_count >= kPretenureMinimumCreated;
-  double ratio =
-      minimum_mementos_created || FLAG_trace_pretenuring_statistics ?
-          static_cast<double>(found_count) / create_count : 0.0;
+  double ratio = minimum_mementos_created || FLAG_trace_pretenuring ||
+                         FLAG_trace_pretenuring_statistics
+                     ? static_cast<double>(found_count) / create_count
+                     : 0.0;
   PretenureDecision current_decision = pretenure_decision();
 
   if (minimum_mementos_created) {
@@ -1744,6 +1745,15 @@ inline bool AllocationSite::DigestPretenuringFeedback(
                  this, create_count, found_count, ratio,
                  PretenureDecisionName(current_decision),
                  PretenureDecisionName(pretenure_decision()));
+  } else if (FLAG_trace_pretenuring &&
+             current_decision != pretenure_decision()) {
+    // Only report decision changes to keep the output readable.
+    PrintIsolate(GetIsolate(),
+                 "pretenuring: AllocationSite(%p) changed decision %s => %s "
+                 "(created=%d, found=%d, survival ratio=%f)\n",
+                 this, PretenureDecisionName(current_decision),
+                 PretenureDecisionName(pretenure_decision()), create_count,
+                 found_count, ratio);
   }
 
   // Clear feedback calculation fields until the next gc.
@@ -4001,6 +4011,33 @@ void BytecodeArray::set_interrupt_budget(int interrupt_budget) {
   WRITE_INT_FIELD(this, kInterruptBudgetOffset, interrupt_budget);
 }
 
+int BytecodeArray::osr_loop_nesting_level() const {
+  return READ_INT8_FIELD(this, kOSRNestingLevelOffset);
+}
+
+void BytecodeArray::set_osr_loop_nesting_level(int depth) {
+  DCHECK(0 <= depth && depth <= Code::kMaxLoopNestingMarker);
+  WRITE_INT8_FIELD(this, kOSRNestingLevelOffset, depth);
+}
+
+BytecodeArray::Age BytecodeArray::bytecode_age() const {
+  return static_cast<Age>(READ_INT8_FIELD(this, kBytecodeAgeOffset));
+}
+
+void BytecodeArray::set_bytecode_age(BytecodeArray::Age age) {
+  DCHECK_GE(age, kFirstBytecodeAge);
+  DCHECK_LE(age, kLastBytecodeAge);
+  WRITE_INT8_FIELD(this, kBytecodeAgeOffset, static_cast<int8_t>(age));
+}
+
+bool BytecodeArray::omits_expression_positions() const {
+  return READ_INT8_FIELD(this, kSourcePositionFlagsOffset) != 0;
+}
+
+void BytecodeArray::set_omits_expression_positions(bool value) {
+  WRITE_INT8_FIELD(this, kSourcePositionFlagsOffset, value ? 1 : 0);
+}
+
 int BytecodeArray::parameter_count() const {
   // Parameter count is stored as the size on stack of the parameters to allow
   // it to be used directly by generated code.
@@ -5479,6 +5516,8 @@ BOOL_ACCESSORS(InterceptorInfo, flags, non_masking, kNonMasking)
 ACCESSORS(CallHandlerInfo, callback, Object, kCallbackOffset)
 ACCESSORS(CallHandlerInfo, data, Object, kDataOffset)
 ACCESSORS(CallHandlerInfo, fast_handler, Object, kFastHandlerOffset)
+ACCESSORS(CallHandlerInfo, fast_c_function, Object, kFastCFunctionOffset)
+ACCESSORS(CallHandlerInfo, fast_c_signature, Object, kFastCSignatureOffset)
 
 ACCESSORS(TemplateInfo, tag, Object, kTagOffset)
 ACCESSORS(TemplateInfo, serial_number, Object, kSerialNumberOffset)
@@ -5533,6 +5572,7 @@ ACCESSORS(Script, shared_function_infos, Object, kSharedFunctionInfosOffset)
 SMI_ACCESSORS(Script, flags, kFlagsOffset)
 ACCESSORS(Script, source_url, Object, kSourceUrlOffset)
 ACCESSORS(Script, source_mapping_url, Object, kSourceMappingUrlOffset)
+ACCESSORS(Script, preparse_data, Object, kPreparseDataOffset)
 
 Script::CompilationType Script::compilation_type() {
   return BooleanBit::get(flags(), kCompilationTypeBit) ?
@@ -6909,10 +6949,13 @@ inline void StringHasher::AddCharacters(const Char* chars, int length) {
       }
     }
   }
+  DCHECK(i == length || !is_array_index_);
+  // Keep the running hash in a local, the characters might alias the field.
+  uint32_t running_hash = raw_running_hash_;
   for (; i < length; i++) {
-    DCHECK(!is_array_index_);
-    AddCharacter(chars[i]);
+    running_hash = AddCharacterCore(running_hash, chars[i]);
   }
+  raw_running_hash_ = running_hash;
 }
 
 
@@ -7305,10 +7348,28 @@ void Dictionary<Derived, Shape, Key>::SetEntry(int entry,
                                                Handle<Object> key,
                                                Handle<Object> value,
                                                PropertyDetails details) {
+  ClearEnumCache();
   Shape::SetEntry(static_cast<Derived*>(this), entry, key, value, details);
 }
 
 
+template <typename Derived, typename Shape, typename Key>
+void Dictionary<Derived, Shape, Key>::ClearEnumCache() {
+  if (!Shape::kIsEnumerable) return;
+  Object* undefined = this->GetHeap()->undefined_value();
+  if (this->get(kEnumCacheIndex) == undefined) return;
+  this->set(kEnumCacheIndex, undefined, SKIP_WRITE_BARRIER);
+}
+
+
+Object* NameDictionary::enum_cache() { return get(kEnumCacheIndex); }
+
+
+void NameDictionary::set_enum_cache(FixedArray* keys) {
+  set(kEnumCacheIndex, keys);
+}
+
+
 template <typename Key>
 template <typename Dictionary>
 void BaseDictionaryShape<Key>::SetEntry(Dictionary* dict, int entry,
@@ -616,6 +616,10 @@ void TypeFeedbackVector::TypeFeedbackVectorPrint(std::ostream& os) {  // NOLINT
     os << " (empty)\n";
     return;
   }
+  if (is_lazy()) {
+    os << " (lazy)\n";
+    return;
+  }
 
   TypeFeedbackMetadataIterator iter(metadata());
   while (iter.HasNext()) {
@@ -650,6 +654,7 @@ void TypeFeedbackVector::TypeFeedbackVectorPrint(std::ostream& os) {  // NOLINT
         break;
       }
       case FeedbackVectorSlotKind::GENERAL:
+      case FeedbackVectorSlotKind::COUNTER:
         break;
       case FeedbackVectorSlotKind::INVALID:
       case FeedbackVectorSlotKind::KINDS_NUMBER:
@@ -1056,6 +1061,8 @@ void CallHandlerInfo::CallHandlerInfoPrint(std::ostream& os) {  // NOLINT
   HeapObject::PrintHeader(os, "CallHandlerInfo");
   os << "\n - callback: " << Brief(callback());
   os << "\n - data: " << Brief(data());
+  os << "\n - fast_c_function: " << Brief(fast_c_function());
+  os << "\n - fast_c_signature: " << Brief(fast_c_signature());
   os << "\n";
 }
 
@@ -1146,6 +1153,7 @@ void Script::ScriptPrint(std::ostream& os) {  // NOLINT
   os << "\n - eval from shared: " << Brief(eval_from_shared());
   os << "\n - eval from position: " << eval_from_position();
   os << "\n - shared function infos: " << Brief(shared_function_infos());
+  os << "\n - preparse data: " << Brief(preparse_data());
   os << "\n";
 }
 
@@ -774,6 +774,36 @@ MaybeHandle<Object> Object::GetProperty(LookupIterator* it) {
   } while (false)
 
 
+namespace {
+
+// Returns true if |trap_result| is known to satisfy the invariants of step 10
+// of a proxy's [[Get]] for the ordinary object |target|. This is the case if
+// |name| is absent or configurable on |target|, or a non-configurable,
+// non-writable data property with the same value. Avoids materializing the
+// target's property descriptor. Returns false if the full check is needed.
+bool IsGetTrapResultTriviallyValid(Isolate* isolate, Handle<JSReceiver> target,
+                                   Handle<Name> name,
+                                   Handle<Object> trap_result) {
+  if (!target->IsJSObject()) return false;
+  LookupIterator it = LookupIterator::PropertyOrElement(
+      isolate, target, name, target, LookupIterator::OWN);
+  switch (it.state()) {
+    case LookupIterator::NOT_FOUND:
+      return true;
+    case LookupIterator::DATA:
+      if ((it.property_attributes() & DONT_DELETE) == 0) return true;
+      if ((it.property_attributes() & READ_ONLY) == 0) return true;
+      return trap_result->SameValue(*it.GetDataValue());
+    case LookupIterator::ACCESSOR:
+      return (it.property_attributes() & DONT_DELETE) == 0;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+
 // static
 MaybeHandle<Object> JSProxy::GetProperty(Isolate* isolate,
                                          Handle<JSProxy> proxy,
@@ -823,6 +853,9 @@ MaybeHandle<Object> JSProxy::GetProperty(Isolate* isolate,
   ASSIGN_RETURN_ON_EXCEPTION(
       isolate, trap_result,
       Execution::Call(isolate, trap, handler, arraysize(args), args), Object);
+  if (IsGetTrapResultTriviallyValid(isolate, target, name, trap_result)) {
+    return trap_result;
+  }
   // 9. Let targetDesc be ? target.[[GetOwnProperty]](P).
   PropertyDescriptor target_desc;
   Maybe<bool> target_found =
@@ -1376,6 +1409,9 @@ void JSObject::SetNormalizedProperty(Handle<JSObject> object,
       property_dictionary =
           NameDictionary::Add(property_dictionary, name, value, details);
       object->set_properties(*property_dictionary);
+      // The new property may shadow one further up the prototype chain,
+      // handlers rely on the validity cell instead of a negative lookup.
+      InvalidatePrototypeChains(object->map());
     } else {
       PropertyDetails original_details = property_dictionary->DetailsAt(entry);
       int enumeration_index = original_details.dictionary_index();
@@ -2649,6 +2685,9 @@ void JSObject::AddSlowProperty(Handle<JSObject> object,
     Handle<NameDictionary> result =
         NameDictionary::Add(dict, name, value, details);
     if (*dict != *result) object->set_properties(*result);
+    // The new property may shadow one further up the prototype chain,
+    // handlers rely on the validity cell instead of a negative lookup.
+    InvalidatePrototypeChains(object->map());
   }
 }
 
@@ -3199,6 +3238,7 @@ void Map::DeprecateTransitionTree() {
     TransitionArray::GetTarget(transitions, i)->DeprecateTransitionTree();
   }
   deprecate();
+  GetIsolate()->counters()->map_deprecations()->Increment();
   dependent_code()->DeoptimizeDependentCodeGroup(
       GetIsolate(), DependentCode::kTransitionGroup);
   NotifyLeafMapLayoutChange();
@@ -5189,6 +5229,7 @@ void JSObject::MigrateInstance(Handle<JSObject> object) {
   Handle<Map> map = Map::Update(original_map);
   map->set_migration_target(true);
   MigrateToMap(object, map);
+  object->GetIsolate()->counters()->instance_migrations()->Increment();
   if (FLAG_trace_migration) {
     object->PrintInstanceMigration(stdout, *original_map, *map);
   }
@@ -5210,6 +5251,7 @@ bool JSObject::TryMigrateInstance(Handle<JSObject> object) {
     return false;
   }
   JSObject::MigrateToMap(object, new_map);
+  isolate->counters()->instance_migrations()->Increment();
   if (FLAG_trace_migration) {
     object->PrintInstanceMigration(stdout, *original_map, object->map());
   }
@@ -8345,12 +8387,22 @@ Handle<FixedArray> JSObject::GetEnumPropertyKeys(Handle<JSObject> object) {
     return storage;
   } else {
     Handle<NameDictionary> dictionary(object->property_dictionary());
+    if (dictionary->enum_cache()->IsFixedArray()) {
+      isolate->counters()->enum_cache_hits()->Increment();
+      return isolate->factory()->CopyFixedArray(
+          handle(FixedArray::cast(dictionary->enum_cache()), isolate));
+    }
     int length = dictionary->NumberOfEnumElements();
     if (length == 0) {
       return isolate->factory()->empty_fixed_array();
     }
     Handle<FixedArray> storage = isolate->factory()->NewFixedArray(length);
     dictionary->CopyEnumKeysTo(*storage);
+    // Collecting the keys scans the whole dictionary and sorts them by
+    // enumeration index, remember the result until the keys change.
+    isolate->counters()->enum_cache_misses()->Increment();
+    Handle<FixedArray> cache = isolate->factory()->CopyFixedArray(storage);
+    dictionary->set_enum_cache(*cache);
     return storage;
   }
 }
@@ -11132,7 +11184,7 @@ template <typename Char>
 static inline bool CompareRawStringContents(const Char* const a,
                                             const Char* const b,
                                             int length) {
-  return CompareChars(a, b, length) == 0;
+  return CompareCharsEqual(a, b, length);
 }
 
 
@@ -11141,12 +11193,7 @@ class RawStringComparator : public AllStatic {
  public:
   static inline bool compare(const Chars1* a, const Chars2* b, int len) {
     DCHECK(sizeof(Chars1) != sizeof(Chars2));
-    for (int i = 0; i < len; i++) {
-      if (a[i] != b[i]) {
-        return false;
-      }
-    }
-    return true;
+    return CompareCharsEqual(a, b, len);
   }
 };
 
@@ -11349,6 +11396,13 @@ bool String::SlowEquals(Handle<String> one, Handle<String> two) {
   // before we try to flatten the strings.
   if (one->Get(0) != two->Get(0)) return false;
 
+  // Walk ropes piece by piece instead of copying them into flat strings.
+  if (!one->IsFlat() || !two->IsFlat()) {
+    DisallowHeapAllocation no_gc;
+    StringComparator comparator;
+    return comparator.Equals(*one, *two);
+  }
+
   one = String::Flatten(one);
   two = String::Flatten(two);
 
@@ -11360,11 +11414,15 @@ bool String::SlowEquals(Handle<String> one, Handle<String> two) {
       return CompareRawStringContents(flat1.ToOneByteVector().start(),
                                       flat2.ToOneByteVector().start(),
                                       one_length);
+  } else if (flat1.IsOneByte()) {
+    return CompareCharsEqual(flat1.ToOneByteVector().start(),
+                             flat2.ToUC16Vector().start(), one_length);
+  } else if (flat2.IsOneByte()) {
+    return CompareCharsEqual(flat1.ToUC16Vector().start(),
+                             flat2.ToOneByteVector().start(), one_length);
   } else {
-    for (int i = 0; i < one_length; i++) {
-      if (flat1.Get(i) != flat2.Get(i)) return false;
-    }
-    return true;
+    return CompareRawStringContents(flat1.ToUC16Vector().start(),
+                                    flat2.ToUC16Vector().start(), one_length);
   }
 }
 
@@ -11388,6 +11446,24 @@ ComparisonResult String::Compare(Handle<String> x, Handle<String> y) {
     return ComparisonResult::kGreaterThan;
   }
 
+  // Walk ropes piece by piece instead of copying them into flat strings.
+  if (!x->IsFlat() || !y->IsFlat()) {
+    DisallowHeapAllocation no_gc;
+    StringCharacterStream x_stream(*x);
+    StringCharacterStream y_stream(*y);
+    while (x_stream.HasMore() && y_stream.HasMore()) {
+      int const d = x_stream.GetNext() - y_stream.GetNext();
+      if (d < 0) {
+        return ComparisonResult::kLessThan;
+      } else if (d > 0) {
+        return ComparisonResult::kGreaterThan;
+      }
+    }
+    if (x_stream.HasMore()) return ComparisonResult::kGreaterThan;
+    if (y_stream.HasMore()) return ComparisonResult::kLessThan;
+    return ComparisonResult::kEqual;
+  }
+
   // Slow case.
   x = String::Flatten(x);
   y = String::Flatten(y);
@@ -11468,8 +11544,8 @@ bool String::IsOneByteEqualTo(Vector<const uint8_t> str) {
   DisallowHeapAllocation no_gc;
   FlatContent content = GetFlatContent();
   if (content.IsOneByte()) {
-    return CompareChars(content.ToOneByteVector().start(),
-                        str.start(), slen) == 0;
+    return CompareCharsEqual(content.ToOneByteVector().start(), str.start(),
+                             slen);
   }
   for (int i = 0; i < slen; i++) {
     if (Get(i) != static_cast<uint16_t>(str[i])) return false;
@@ -11484,7 +11560,7 @@ bool String::IsTwoByteEqualTo(Vector<const uc16> str) {
   DisallowHeapAllocation no_gc;
   FlatContent content = GetFlatContent();
   if (content.IsTwoByte()) {
-    return CompareChars(content.ToUC16Vector().start(), str.start(), slen) == 0;
+    return CompareCharsEqual(content.ToUC16Vector().start(), str.start(), slen);
   }
   for (int i = 0; i < slen; i++) {
     if (Get(i) != str[i]) return false;
@@ -11740,11 +11816,15 @@ bool Map::EquivalentToForNormalization(Map* other,
 
 
 bool JSFunction::Inlines(SharedFunctionInfo* candidate) {
-  DisallowHeapAllocation no_gc;
   if (shared() == candidate) return true;
-  if (code()->kind() != Code::OPTIMIZED_FUNCTION) return false;
+  return code()->Inlines(candidate);
+}
+
+bool Code::Inlines(SharedFunctionInfo* candidate) {
+  DisallowHeapAllocation no_gc;
+  if (kind() != OPTIMIZED_FUNCTION) return false;
   DeoptimizationInputData* const data =
-      DeoptimizationInputData::cast(code()->deoptimization_data());
+      DeoptimizationInputData::cast(deoptimization_data());
   if (data->length() == 0) return false;
   FixedArray* const literals = data->LiteralArray();
   int const inlined_count = data->InlinedFunctionCount()->value();
@@ -12016,10 +12096,31 @@ static void StopSlackTracking(Map* map, void* data) {
   map->set_construction_counter(Map::kNoSlackTracking);
 }
 
+static void GetMaxNumberOfFields(Map* map, void* data) {
+  int fields = map->NumberOfFields();
+  if (*reinterpret_cast<int*>(data) < fields) {
+    *reinterpret_cast<int*>(data) = fields;
+  }
+}
+
 void Map::CompleteInobjectSlackTracking() {
   // Has to be an initial map.
   DCHECK(GetBackPointer()->IsUndefined());
 
+  if (FLAG_slack_tracking_feedback && GetConstructor()->IsJSFunction()) {
+    // Size the initial maps of later closures of the same function by the
+    // fields the instances actually got, including those that spilled to
+    // the out-of-object properties backing store. Subclass constructors
+    // are skipped as their estimate is summed over the prototype chain.
+    SharedFunctionInfo* shared = JSFunction::cast(GetConstructor())->shared();
+    if (!IsSubclassConstructor(shared->kind())) {
+      int fields = 0;
+      TransitionArray::TraverseTransitionTree(this, &GetMaxNumberOfFields,
+                                              &fields);
+      shared->set_expected_nof_properties(fields);
+    }
+  }
+
   int slack = unused_property_fields();
   TransitionArray::TraverseTransitionTree(this, &GetMinInobjectSlack, &slack);
   if (slack != 0) {
@@ -13381,6 +13482,27 @@ void SharedFunctionInfo::ResetForNewContext(int new_ic_age) {
 }
 
 
+bool SharedFunctionInfo::WasOptimizedInOtherNativeContext(
+    Context* native_context) {
+  DisallowHeapAllocation no_gc;
+  DCHECK(native_context->IsNativeContext());
+  if (OptimizedCodeMapIsCleared()) return false;
+  FixedArray* optimized_code_map = this->optimized_code_map();
+  int length = optimized_code_map->length();
+  Smi* none_smi = Smi::FromInt(BailoutId::None().ToInt());
+  for (int i = kEntriesStart; i < length; i += kEntryLength) {
+    // Entries of dead native contexts count as well, they have been cleared
+    // but not yet reused.
+    if (WeakCell::cast(optimized_code_map->get(i + kContextOffset))
+                ->value() != native_context &&
+        optimized_code_map->get(i + kOsrAstIdOffset) == none_smi) {
+      return true;
+    }
+  }
+  return false;
+}
+
+
 int SharedFunctionInfo::SearchOptimizedCodeMapEntry(Context* native_context,
                                                     BailoutId osr_ast_id) {
   DisallowHeapAllocation no_gc;
@@ -13736,6 +13858,19 @@ int AbstractCode::SourceStatementPosition(int offset) {
                            : GetCode()->SourceStatementPosition(offset);
 }
 
+// static
+void SharedFunctionInfo::EnsureFeedbackVector(
+    Handle<SharedFunctionInfo> shared) {
+  if (!shared->feedback_vector()->is_lazy()) return;
+  Isolate* isolate = shared->GetIsolate();
+  Handle<TypeFeedbackMetadata> metadata(shared->feedback_vector()->metadata(),
+                                        isolate);
+  Handle<TypeFeedbackVector> vector =
+      TypeFeedbackVector::New(isolate, metadata);
+  shared->set_feedback_vector(*vector);
+}
+
+
 void SharedFunctionInfo::ClearTypeFeedbackInfo() {
   feedback_vector()->ClearSlots(this);
 }
@@ -14510,6 +14645,19 @@ void BytecodeArray::CopyBytecodesTo(BytecodeArray* to) {
             from->length());
 }
 
+void BytecodeArray::MakeOlder() {
+  Age age = bytecode_age();
+  if (age < kLastBytecodeAge) {
+    set_bytecode_age(static_cast<Age>(age + 1));
+  }
+  DCHECK_GE(bytecode_age(), kFirstBytecodeAge);
+  DCHECK_LE(bytecode_age(), kLastBytecodeAge);
+}
+
+bool BytecodeArray::IsOld() const {
+  return bytecode_age() >= kIsOldBytecodeAge;
+}
+
 // static
 void JSArray::Initialize(Handle<JSArray> array, int capacity, int length) {
   DCHECK(capacity >= 0);
@@ -17029,8 +17177,8 @@ MaybeHandle<String> StringTable::LookupTwoCharsStringIfExists(
 }
 
 
-void StringTable::EnsureCapacityForDeserialization(Isolate* isolate,
-                                                   int expected) {
+void StringTable::EnsureCapacityForBulkInsert(Isolate* isolate,
+                                              int expected) {
   Handle<StringTable> table = isolate->factory()->string_table();
   // We need a key instance for the virtual hash function.
   InternalizedStringKey dummy_key(isolate->factory()->empty_string());
@@ -783,13 +783,15 @@ std::ostream& operator<<(std::ostream& os, InstanceType instance_type);
   V(MAP_CODE_CACHE_SUB_TYPE)                  \
   V(SCOPE_INFO_SUB_TYPE)                      \
   V(STRING_TABLE_SUB_TYPE)                    \
-  V(DESCRIPTOR_ARRAY_SUB_TYPE)
+  V(DESCRIPTOR_ARRAY_SUB_TYPE)                \
+  V(TYPE_FEEDBACK_VECTOR_SUB_TYPE)            \
+  V(TYPE_FEEDBACK_METADATA_SUB_TYPE)
 
 enum FixedArraySubInstanceType {
 #define DEFINE_FIXED_ARRAY_SUB_INSTANCE_TYPE(name) name,
   FIXED_ARRAY_SUB_INSTANCE_TYPE_LIST(DEFINE_FIXED_ARRAY_SUB_INSTANCE_TYPE)
 #undef DEFINE_FIXED_ARRAY_SUB_INSTANCE_TYPE
-      LAST_FIXED_ARRAY_SUB_TYPE = DESCRIPTOR_ARRAY_SUB_TYPE
+      LAST_FIXED_ARRAY_SUB_TYPE = TYPE_FEEDBACK_METADATA_SUB_TYPE
 };
 
 
@@ -3405,7 +3407,9 @@ class StringTable: public HashTable<StringTable,
       uint16_t c1,
       uint16_t c2);
 
-  static void EnsureCapacityForDeserialization(Isolate* isolate, int expected);
+  // Grows the table so that |expected| strings can be added without growing
+  // it again.
+  static void EnsureCapacityForBulkInsert(Isolate* isolate, int expected);
 
   DECLARE_CAST(StringTable)
 
@@ -3458,6 +3462,7 @@ class Dictionary: public HashTable<Derived, Shape, Key> {
 
   // Set the details for entry.
   void DetailsAtPut(int entry, PropertyDetails value) {
+    ClearEnumCache();
     Shape::DetailsAtPut(static_cast<Derived*>(this), entry, value);
   }
 
@@ -3566,7 +3571,15 @@ class Dictionary: public HashTable<Derived, Shape, Key> {
   // Returns iteration indices array for the |dictionary|.
   static Handle<FixedArray> GenerateNewEnumerationIndices(
       Handle<Derived> dictionary);
+
+  // Drops the enum cache of an enumerable dictionary. Called whenever a key
+  // is added or removed or the details of an entry change.
+  inline void ClearEnumCache();
+
   static const int kMaxNumberKeyIndex = DerivedHashTable::kPrefixStartIndex;
+  // Dictionaries with name keys have no maximum number key, they use the
+  // slot to cache their enumerable keys instead.
+  static const int kEnumCacheIndex = kMaxNumberKeyIndex;
   static const int kNextEnumerationIndexIndex = kMaxNumberKeyIndex + 1;
 };
 
@@ -3633,6 +3646,12 @@ class NameDictionary
 
   inline static Handle<FixedArray> DoGenerateNewEnumerationIndices(
       Handle<NameDictionary> dictionary);
+
+  // The enumerable string keys in enumeration order, as computed by
+  // CopyEnumKeysTo, or undefined if they have not been cached since the
+  // last change to the keys. The cached array must not be handed out.
+  inline Object* enum_cache();
+  inline void set_enum_cache(FixedArray* keys);
 };
 
 
@@ -3926,6 +3945,16 @@ class OrderedHashTable: public FixedArray {
 
   Object* KeyAt(int entry) { return get(EntryToIndex(entry)); }
 
+  // Returns the entry whose key is SameValueZero to |key|, or kNotFound.
+  int FindEntry(Object* key) {
+    int entry = KeyToFirstEntry(key);
+    while (entry != kNotFound) {
+      if (KeyAt(entry)->SameValueZero(key)) return entry;
+      entry = NextChainEntry(entry);
+    }
+    return kNotFound;
+  }
+
   bool IsObsolete() {
     return !get(kNextTableIndex)->IsSmi();
   }
@@ -4444,6 +4473,20 @@ class ByteArray: public FixedArrayBase {
 // BytecodeArray represents a sequence of interpreter bytecodes.
 class BytecodeArray : public FixedArrayBase {
  public:
+#define DECLARE_BYTECODE_AGE_ENUM(X) k##X##BytecodeAge,
+  // Bytecode arrays age on every mark-compact in which they are not
+  // executed, the interpreter entry trampoline makes them young again.
+  // Old bytecode is flushed together with the unoptimized code of its
+  // function, see StaticMarkingVisitor::IsFlushable.
+  enum Age {
+    kNoAgeBytecodeAge = 0,
+    CODE_AGE_LIST(DECLARE_BYTECODE_AGE_ENUM) kAfterLastBytecodeAge,
+    kFirstBytecodeAge = kNoAgeBytecodeAge,
+    kLastBytecodeAge = kAfterLastBytecodeAge - 1,
+    kIsOldBytecodeAge = kSexagenarianBytecodeAge
+  };
+#undef DECLARE_BYTECODE_AGE_ENUM
+
   static int SizeFor(int length) {
     return OBJECT_POINTER_ALIGN(kHeaderSize + length);
   }
@@ -4470,6 +4513,20 @@ class BytecodeArray : public FixedArrayBase {
   inline int interrupt_budget() const;
   inline void set_interrupt_budget(int interrupt_budget);
 
+  // Accessors for OSR loop nesting level. Back edges of loops nested
+  // less deeply than this level trigger on-stack replacement.
+  inline int osr_loop_nesting_level() const;
+  inline void set_osr_loop_nesting_level(int depth);
+
+  // Accessors for bytecode's code age.
+  inline Age bytecode_age() const;
+  inline void set_bytecode_age(Age age);
+
+  // Accessors for whether the source position table lacks expression
+  // positions, which can be recovered by Compiler::CollectSourcePositions.
+  inline bool omits_expression_positions() const;
+  inline void set_omits_expression_positions(bool value);
+
   // Accessors for the constant pool.
   DECL_ACCESSORS(constant_pool, FixedArray)
 
@@ -4497,6 +4554,10 @@ class BytecodeArray : public FixedArrayBase {
 
   void CopyBytecodesTo(BytecodeArray* to);
 
+  // Bytecode aging.
+  void MakeOlder();
+  bool IsOld() const;
+
   // Layout description.
   static const int kConstantPoolOffset = FixedArrayBase::kHeaderSize;
   static const int kHandlerTableOffset = kConstantPoolOffset + kPointerSize;
@@ -4505,7 +4566,10 @@ class BytecodeArray : public FixedArrayBase {
   static const int kFrameSizeOffset = kSourcePositionTableOffset + kPointerSize;
   static const int kParameterSizeOffset = kFrameSizeOffset + kIntSize;
   static const int kInterruptBudgetOffset = kParameterSizeOffset + kIntSize;
-  static const int kHeaderSize = kInterruptBudgetOffset + kIntSize;
+  static const int kOSRNestingLevelOffset = kInterruptBudgetOffset + kIntSize;
+  static const int kBytecodeAgeOffset = kOSRNestingLevelOffset + kCharSize;
+  static const int kSourcePositionFlagsOffset = kBytecodeAgeOffset + kCharSize;
+  static const int kHeaderSize = kSourcePositionFlagsOffset + kCharSize;
 
   // Maximal memory consumption for a single BytecodeArray.
   static const int kMaxSize = 512 * MB;
@@ -5011,6 +5075,9 @@ class Code: public HeapObject {
   inline bool IsCodeStubOrIC();
   inline bool IsJavaScriptCode();
 
+  // Tells whether this optimized code inlines the given shared function info.
+  bool Inlines(SharedFunctionInfo* candidate);
+
   inline void set_raw_kind_specific_flags1(int value);
   inline void set_raw_kind_specific_flags2(int value);
 
@@ -5656,7 +5723,9 @@ class Map: public HeapObject {
   //   use the adjusted instance size.
   // - SharedFunctionInfo's expected_nof_properties left unmodified since
   //   allocations made using different closures could actually create different
-  //   kind of objects (see prototype inheritance pattern).
+  //   kind of objects (see prototype inheritance pattern). With
+  //   --slack-tracking-feedback it is set to the largest number of fields
+  //   found in the transition tree instead.
   //
   //  Important: inobject slack tracking is not attempted during the snapshot
   //  creation.
@@ -6430,6 +6499,11 @@ class Script: public Struct {
   // [source_url]: sourceMappingURL magic comment
   DECL_ACCESSORS(source_mapping_url, Object)
 
+  // [preparse_data]: ByteArray holding the parser cache data the script was
+  // compiled with, or undefined. Only kept with
+  // --parser-cache-inner-functions, for lazy compilation of its functions.
+  DECL_ACCESSORS(preparse_data, Object)
+
   // [compilation_type]: how the the script was compiled. Encoded in the
   // 'flags' field.
   inline CompilationType compilation_type();
@@ -6516,7 +6590,8 @@ class Script: public Struct {
   static const int kFlagsOffset = kSharedFunctionInfosOffset + kPointerSize;
   static const int kSourceUrlOffset = kFlagsOffset + kPointerSize;
   static const int kSourceMappingUrlOffset = kSourceUrlOffset + kPointerSize;
-  static const int kSize = kSourceMappingUrlOffset + kPointerSize;
+  static const int kPreparseDataOffset = kSourceMappingUrlOffset + kPointerSize;
+  static const int kSize = kPreparseDataOffset + kPointerSize;
 
  private:
   int GetLineNumberWithArray(int code_pos);
@@ -6549,6 +6624,10 @@ class Script: public Struct {
   V(Array.prototype, push, ArrayPush)                       \
   V(Array.prototype, pop, ArrayPop)                         \
   V(Array.prototype, shift, ArrayShift)                     \
+  V(Array.prototype, forEach, ArrayForEach)                 \
+  V(Array.prototype, map, ArrayMap)                         \
+  V(Array.prototype, filter, ArrayFilter)                   \
+  V(Array.prototype, reduce, ArrayReduce)                   \
   V(Function.prototype, apply, FunctionApply)               \
   V(Function.prototype, call, FunctionCall)                 \
   V(Object.prototype, hasOwnProperty, ObjectHasOwnProperty) \
@@ -6649,6 +6728,11 @@ class SharedFunctionInfo: public HeapObject {
   // Trims the optimized code map after entries have been removed.
   void TrimOptimizedCodeMap(int shrink_by);
 
+  // Returns true if the optimized code map has a non-OSR entry for a native
+  // context other than {native_context}, i.e. the function has already been
+  // optimized in a different native context.
+  bool WasOptimizedInOtherNativeContext(Context* native_context);
+
   // Add or update entry in the optimized code map for context-independent code.
   static void AddSharedCodeToOptimizedCodeMap(Handle<SharedFunctionInfo> shared,
                                               Handle<Code> code);
@@ -6723,6 +6807,9 @@ class SharedFunctionInfo: public HeapObject {
   // available.
   DECL_ACCESSORS(feedback_vector, TypeFeedbackVector)
 
+  // Allocates the slots of the feedback vector if it is still lazy.
+  static void EnsureFeedbackVector(Handle<SharedFunctionInfo> shared);
+
   // Unconditionally clear the type feedback vector (including vector ICs).
   void ClearTypeFeedbackInfo();
 
@@ -7938,6 +8025,14 @@ class JSRegExp: public JSObject {
     }
   }
 
+  static int bytecode_index(bool is_latin1) {
+    if (is_latin1) {
+      return kIrregexpLatin1BytecodeIndex;
+    } else {
+      return kIrregexpUC16BytecodeIndex;
+    }
+  }
+
   DECLARE_CAST(JSRegExp)
 
   // Dispatched behavior.
@@ -7983,7 +8078,15 @@ class JSRegExp: public JSObject {
   // Number of captures in the compiled regexp.
   static const int kIrregexpCaptureCountIndex = kDataIndex + 5;
 
-  static const int kIrregexpDataSize = kIrregexpCaptureCountIndex + 1;
+  // Irregexp bytecode for Latin1 and UC16 used by native regexp builds while
+  // --regexp-tier-up interprets a regexp before compiling it.
+  static const int kIrregexpLatin1BytecodeIndex = kDataIndex + 6;
+  static const int kIrregexpUC16BytecodeIndex = kDataIndex + 7;
+  // Number of interpreted executions left before the regexp is compiled to
+  // native code.
+  static const int kIrregexpTicksUntilTierUpIndex = kDataIndex + 8;
+
+  static const int kIrregexpDataSize = kIrregexpTicksUntilTierUpIndex + 1;
 
   // Offsets directly into the data fixed array.
   static const int kDataTagOffset =
@@ -10422,6 +10525,11 @@ class CallHandlerInfo: public Struct {
   DECL_ACCESSORS(callback, Object)
   DECL_ACCESSORS(data, Object)
   DECL_ACCESSORS(fast_handler, Object)
+  // The C function registered through v8::experimental::FastApiFunction as a
+  // Foreign, or undefined. Its signature is encoded in a Smi as described by
+  // the bit fields below.
+  DECL_ACCESSORS(fast_c_function, Object)
+  DECL_ACCESSORS(fast_c_signature, Object)
 
   DECLARE_CAST(CallHandlerInfo)
 
@@ -10429,10 +10537,23 @@ class CallHandlerInfo: public Struct {
   DECLARE_PRINTER(CallHandlerInfo)
   DECLARE_VERIFIER(CallHandlerInfo)
 
+  // Encoding of fast_c_signature. The argument types follow the argument
+  // count, two bits each. Types are v8::experimental::FastApiFunction::Type.
+  class FastReturnTypeBits : public BitField<int, 0, 2> {};
+  class FastArgumentCountBits : public BitField<int, 2, 4> {};
+  static int FastArgumentTypeShift(int index) {
+    return FastArgumentCountBits::kNext + 2 * index;
+  }
+  static int FastArgumentType(int signature, int index) {
+    return (signature >> FastArgumentTypeShift(index)) & 3;
+  }
+
   static const int kCallbackOffset = HeapObject::kHeaderSize;
   static const int kDataOffset = kCallbackOffset + kPointerSize;
   static const int kFastHandlerOffset = kDataOffset + kPointerSize;
-  static const int kSize = kFastHandlerOffset + kPointerSize;
+  static const int kFastCFunctionOffset = kFastHandlerOffset + kPointerSize;
+  static const int kFastCSignatureOffset = kFastCFunctionOffset + kPointerSize;
+  static const int kSize = kFastCSignatureOffset + kPointerSize;
 
  private:
   DISALLOW_IMPLICIT_CONSTRUCTORS(CallHandlerInfo);
@@ -4,6 +4,7 @@
 
 #include "src/optimizing-compile-dispatcher.h"
 
+#include "src/background-task-budget.h"
 #include "src/base/atomicops.h"
 #include "src/full-codegen/full-codegen.h"
 #include "src/isolate.h"
@@ -26,6 +27,10 @@ void DisposeCompilationJob(CompilationJob* job, bool restore_function_code) {
   delete info;
 }
 
+// Priority bonus for a queued function that the runtime profiler finds in
+// the top frame, i.e. that is still running unoptimized code.
+const int kTopFramePriorityBonus = 4;
+
 }  // namespace
 
 
@@ -58,7 +63,9 @@ class OptimizingCompileDispatcher::CompileTask : public v8::Task {
             dispatcher->recompilation_delay_));
       }
 
-      dispatcher->CompileNext(dispatcher->NextInput(true));
+      do {
+        dispatcher->CompileNext(dispatcher->NextInput(true));
+      } while (dispatcher->TakeDeferredJob());
     }
     {
       base::LockGuard<base::Mutex> lock_guard(&dispatcher->ref_count_mutex_);
@@ -82,16 +89,20 @@ OptimizingCompileDispatcher::~OptimizingCompileDispatcher() {
   }
 #endif
   DCHECK_EQ(0, input_queue_length_);
+  DCHECK_EQ(0, deferred_jobs_);
   DeleteArray(input_queue_);
 }
 
 CompilationJob* OptimizingCompileDispatcher::NextInput(bool check_if_flushing) {
   base::LockGuard<base::Mutex> access_input_queue_(&input_queue_mutex_);
   if (input_queue_length_ == 0) return NULL;
-  CompilationJob* job = input_queue_[InputQueueIndex(0)];
+  int next = 0;
+  for (int i = 1; i < input_queue_length_; i++) {
+    if (input_queue_[i].priority > input_queue_[next].priority) next = i;
+  }
+  CompilationJob* job = input_queue_[next].job;
   DCHECK_NOT_NULL(job);
-  input_queue_shift_ = InputQueueIndex(1);
-  input_queue_length_--;
+  RemoveInput(next);
   if (check_if_flushing) {
     if (static_cast<ModeFlag>(base::Acquire_Load(&mode_)) == FLUSH) {
       AllowHandleDereference allow_handle_dereference;
@@ -102,6 +113,37 @@ CompilationJob* OptimizingCompileDispatcher::NextInput(bool check_if_flushing) {
   return job;
 }
 
+void OptimizingCompileDispatcher::RemoveInput(int index) {
+  DCHECK_LE(0, index);
+  DCHECK_LT(index, input_queue_length_);
+  input_queue_length_--;
+  for (int i = index; i < input_queue_length_; i++) {
+    input_queue_[i] = input_queue_[i + 1];
+  }
+}
+
+bool OptimizingCompileDispatcher::ReserveCompileTaskLocked() {
+  if (isolate_->background_task_budget()->TryAcquire(
+          BackgroundTaskBudget::kCompiler, 1) == 1) {
+    return true;
+  }
+  // The budget always grants the compiler one slot if it holds none, so a
+  // running task will pick up the job.
+  deferred_jobs_++;
+  return false;
+}
+
+bool OptimizingCompileDispatcher::TakeDeferredJob() {
+  base::LockGuard<base::Mutex> access_input_queue(&input_queue_mutex_);
+  if (deferred_jobs_ > 0) {
+    deferred_jobs_--;
+    return true;
+  }
+  isolate_->background_task_budget()->Release(BackgroundTaskBudget::kCompiler,
+                                              1);
+  return false;
+}
+
 void OptimizingCompileDispatcher::CompileNext(CompilationJob* job) {
   if (!job) return;
 
@@ -110,24 +152,16 @@ void OptimizingCompileDispatcher::CompileNext(CompilationJob* job) {
   USE(status);  // Prevent an unused-variable error.
 
   // The function may have already been optimized by OSR.  Simply continue.
-  // Use a mutex to make sure that functions marked for install
-  // are always also queued.
-  base::LockGuard<base::Mutex> access_output_queue_(&output_queue_mutex_);
-  output_queue_.push(job);
+  // The job is queued before the install request, so the main thread always
+  // finds it.
+  output_queue_.Enqueue(job);
   isolate_->stack_guard()->RequestInstallCode();
 }
 
 
 void OptimizingCompileDispatcher::FlushOutputQueue(bool restore_function_code) {
-  for (;;) {
-    CompilationJob* job = NULL;
-    {
-      base::LockGuard<base::Mutex> access_output_queue_(&output_queue_mutex_);
-      if (output_queue_.empty()) return;
-      job = output_queue_.front();
-      output_queue_.pop();
-    }
-
+  CompilationJob* job = NULL;
+  while (output_queue_.Dequeue(&job)) {
     DisposeCompilationJob(job, restore_function_code);
   }
 }
@@ -171,14 +205,8 @@ void OptimizingCompileDispatcher::Stop() {
 void OptimizingCompileDispatcher::InstallOptimizedFunctions() {
   HandleScope handle_scope(isolate_);
 
-  for (;;) {
-    CompilationJob* job = NULL;
-    {
-      base::LockGuard<base::Mutex> access_output_queue_(&output_queue_mutex_);
-      if (output_queue_.empty()) return;
-      job = output_queue_.front();
-      output_queue_.pop();
-    }
+  CompilationJob* job = NULL;
+  while (output_queue_.Dequeue(&job)) {
     CompilationInfo* info = job->info();
     Handle<JSFunction> function(*info->closure());
     if (function->IsOptimized()) {
@@ -196,26 +224,87 @@ void OptimizingCompileDispatcher::InstallOptimizedFunctions() {
 
 void OptimizingCompileDispatcher::QueueForOptimization(CompilationJob* job) {
   DCHECK(IsQueueAvailable());
+  SharedFunctionInfo* shared = *job->info()->shared_info();
+  bool post_task = false;
   {
     // Add job to the back of the input queue.
     base::LockGuard<base::Mutex> access_input_queue(&input_queue_mutex_);
     DCHECK_LT(input_queue_length_, input_queue_capacity_);
-    input_queue_[InputQueueIndex(input_queue_length_)] = job;
+    QueuedJob* entry = &input_queue_[input_queue_length_];
+    entry->job = job;
+    entry->priority = shared->profiler_ticks();
+    entry->deopt_count = shared->deopt_count();
+    entry->last_hot_tick = profiler_ticks_;
     input_queue_length_++;
+    if (!FLAG_block_concurrent_recompilation) {
+      post_task = ReserveCompileTaskLocked();
+    }
   }
   if (FLAG_block_concurrent_recompilation) {
     blocked_jobs_++;
-  } else {
+  } else if (post_task) {
     V8::GetCurrentPlatform()->CallOnBackgroundThread(
-        new CompileTask(isolate_), v8::Platform::kShortRunningTask);
+        new CompileTask(isolate_), v8::Platform::kLongRunningTask);
+  }
+}
+
+
+void OptimizingCompileDispatcher::NotifyQueuedFunctionIsHot(
+    JSFunction* function, bool is_top_frame) {
+  base::LockGuard<base::Mutex> access_input_queue(&input_queue_mutex_);
+  for (int i = 0; i < input_queue_length_; i++) {
+    QueuedJob* entry = &input_queue_[i];
+    if (*entry->job->info()->closure() != function) continue;
+    entry->priority += is_top_frame ? kTopFramePriorityBonus : 1;
+    entry->last_hot_tick = profiler_ticks_;
+    return;
+  }
+}
+
+
+void OptimizingCompileDispatcher::DropStaleJobs() {
+  profiler_ticks_++;
+  // Blocked jobs are expected to be compiled once they are released.
+  if (FLAG_block_concurrent_recompilation) return;
+  List<CompilationJob*> stale_jobs;
+  {
+    base::LockGuard<base::Mutex> access_input_queue(&input_queue_mutex_);
+    for (int i = input_queue_length_ - 1; i >= 0; i--) {
+      QueuedJob* entry = &input_queue_[i];
+      SharedFunctionInfo* shared = *entry->job->info()->shared_info();
+      bool deoptimized = shared->deopt_count() != entry->deopt_count ||
+                         shared->optimization_disabled();
+      bool cold = FLAG_concurrent_recompilation_max_age > 0 &&
+                  profiler_ticks_ - entry->last_hot_tick >
+                      FLAG_concurrent_recompilation_max_age;
+      if (!deoptimized && !cold) continue;
+      stale_jobs.Add(entry->job);
+      RemoveInput(i);
+    }
+  }
+  for (int i = 0; i < stale_jobs.length(); i++) {
+    if (FLAG_trace_concurrent_recompilation) {
+      PrintF("  ** Dropping stale compilation job for ");
+      stale_jobs[i]->info()->closure()->ShortPrint();
+      PrintF(".\n");
+    }
+    // The compile task posted for the job will find one job less queued.
+    DisposeCompilationJob(stale_jobs[i], true);
   }
 }
 
 
 void OptimizingCompileDispatcher::Unblock() {
   while (blocked_jobs_ > 0) {
-    V8::GetCurrentPlatform()->CallOnBackgroundThread(
-        new CompileTask(isolate_), v8::Platform::kShortRunningTask);
+    bool post_task;
+    {
+      base::LockGuard<base::Mutex> access_input_queue(&input_queue_mutex_);
+      post_task = ReserveCompileTaskLocked();
+    }
+    if (post_task) {
+      V8::GetCurrentPlatform()->CallOnBackgroundThread(
+          new CompileTask(isolate_), v8::Platform::kLongRunningTask);
+    }
     blocked_jobs_--;
   }
 }
@@ -5,9 +5,8 @@
 #ifndef V8_OPTIMIZING_COMPILE_DISPATCHER_H_
 #define V8_OPTIMIZING_COMPILE_DISPATCHER_H_
 
-#include <queue>
-
 #include "src/base/atomicops.h"
+#include "src/base/lockfree-queue.h"
 #include "src/base/platform/condition-variable.h"
 #include "src/base/platform/mutex.h"
 #include "src/base/platform/platform.h"
@@ -18,6 +17,7 @@ namespace v8 {
 namespace internal {
 
 class CompilationJob;
+class JSFunction;
 class SharedFunctionInfo;
 
 class OptimizingCompileDispatcher {
@@ -26,12 +26,13 @@ class OptimizingCompileDispatcher {
       : isolate_(isolate),
         input_queue_capacity_(FLAG_concurrent_recompilation_queue_length),
         input_queue_length_(0),
-        input_queue_shift_(0),
+        deferred_jobs_(0),
+        profiler_ticks_(0),
         blocked_jobs_(0),
         ref_count_(0),
         recompilation_delay_(FLAG_concurrent_recompilation_delay) {
     base::NoBarrier_Store(&mode_, static_cast<base::AtomicWord>(COMPILE));
-    input_queue_ = NewArray<CompilationJob*>(input_queue_capacity_);
+    input_queue_ = NewArray<QueuedJob>(input_queue_capacity_);
   }
 
   ~OptimizingCompileDispatcher();
@@ -43,6 +44,16 @@ class OptimizingCompileDispatcher {
   void Unblock();
   void InstallOptimizedFunctions();
 
+  // Called by the runtime profiler for a queued |function| it finds on the
+  // stack. Raises the priority of the function's job, in particular if the
+  // function is the one currently executing, which would otherwise be a
+  // candidate for on-stack replacement.
+  void NotifyQueuedFunctionIsHot(JSFunction* function, bool is_top_frame);
+
+  // Called by the runtime profiler on every tick. Drops the jobs of functions
+  // that were deoptimized since they were queued or that are no longer hot.
+  void DropStaleJobs();
+
   inline bool IsQueueAvailable() {
     base::LockGuard<base::Mutex> access_input_queue(&input_queue_mutex_);
     return input_queue_length_ < input_queue_capacity_;
@@ -55,31 +66,50 @@ class OptimizingCompileDispatcher {
 
   enum ModeFlag { COMPILE, FLUSH };
 
+  struct QueuedJob {
+    CompilationJob* job;
+    // The profiler ticks of the function when it was queued, raised whenever
+    // the runtime profiler finds the function on the stack.
+    int priority;
+    // The deoptimization count of the function when it was queued.
+    int deopt_count;
+    // The value of profiler_ticks_ when the function was last seen hot.
+    int last_hot_tick;
+  };
+
   void FlushOutputQueue(bool restore_function_code);
   void CompileNext(CompilationJob* job);
+  // Removes the job with the highest priority from the input queue.
   CompilationJob* NextInput(bool check_if_flushing = false);
-
-  inline int InputQueueIndex(int i) {
-    int result = (i + input_queue_shift_) % input_queue_capacity_;
-    DCHECK_LE(0, result);
-    DCHECK_LT(result, input_queue_capacity_);
-    return result;
-  }
+  void RemoveInput(int index);
+  // Posts a compile task for a newly queued job, or defers the job to a
+  // running task if the background task budget is exhausted. Requires
+  // {input_queue_mutex_}.
+  bool ReserveCompileTaskLocked();
+  // Called by a compile task when it is done with its job. Hands it a
+  // deferred job, or returns its slot of the background task budget.
+  bool TakeDeferredJob();
 
   Isolate* isolate_;
 
-  // Circular queue of incoming recompilation tasks (including OSR).
-  CompilationJob** input_queue_;
+  // Incoming recompilation tasks in the order they were queued. Jobs of
+  // equal priority are compiled in this order.
+  QueuedJob* input_queue_;
   int input_queue_capacity_;
   int input_queue_length_;
-  int input_queue_shift_;
   base::Mutex input_queue_mutex_;
 
-  // Queue of recompilation tasks ready to be installed (excluding OSR).
-  std::queue<CompilationJob*> output_queue_;
-  // Used for job based recompilation which has multiple producers on
-  // different threads.
-  base::Mutex output_queue_mutex_;
+  // The number of queued jobs without a compile task of their own. They are
+  // compiled by the running tasks.
+  int deferred_jobs_;
+
+  // The number of runtime profiler ticks seen by DropStaleJobs. Only used on
+  // the main thread.
+  int profiler_ticks_;
+
+  // Queue of recompilation tasks ready to be installed (excluding OSR). Jobs
+  // are added by the compiler threads and removed on the main thread.
+  base::LockFreeQueue<CompilationJob*> output_queue_;
 
   volatile base::AtomicWord mode_;
 
@@ -432,6 +432,21 @@ class ParserBase : public Traits {
     Mode old_mode_;
   };
 
+  // Redirects the allocations of the parser (scopes, non-pattern lists, ...)
+  // to another zone for the lifetime of this object.
+  class ParsingZoneScope BASE_EMBEDDED {
+   public:
+    ParsingZoneScope(ParserBase* parser, Zone* zone)
+        : parser_(parser), old_zone_(parser->zone()) {
+      parser_->zone_ = zone;
+    }
+    ~ParsingZoneScope() { parser_->zone_ = old_zone_; }
+
+   private:
+    ParserBase* parser_;
+    Zone* old_zone_;
+  };
+
   Scope* NewScope(Scope* parent, ScopeType scope_type) {
     // Must always pass the function kind for FUNCTION_SCOPE.
     DCHECK(scope_type != FUNCTION_SCOPE);
@@ -440,10 +455,8 @@ class ParserBase : public Traits {
 
   Scope* NewScope(Scope* parent, ScopeType scope_type, FunctionKind kind) {
     DCHECK(ast_value_factory());
-    Scope* result = new (zone())
-        Scope(zone(), parent, scope_type, ast_value_factory(), kind);
-    result->Initialize();
-    return result;
+    return Traits::CreateScope(zone(), parent, scope_type,
+                               ast_value_factory(), kind);
   }
 
   Scanner* scanner() const { return scanner_; }
@@ -2284,6 +2297,15 @@ ParserBase<Traits>::ParseUnaryExpression(ExpressionClassifier* classifier,
 
     op = Next();
     int pos = position();
+    // Minified code often writes immediately called functions as
+    // '!function() {...}()' instead of '(function() {...})()'. Treat any
+    // such unary operator like an opening parenthesis, see
+    // ParsePrimaryExpression.
+    if (FLAG_eager_unary_iife && peek() == Token::FUNCTION &&
+        (op == Token::NOT || op == Token::ADD || op == Token::SUB ||
+         op == Token::BIT_NOT || op == Token::VOID)) {
+      function_state_->next_function_is_parenthesized(true);
+    }
     ExpressionT expression = ParseUnaryExpression(classifier, CHECK_OK);
     Traits::RewriteNonPattern(classifier, CHECK_OK);
 
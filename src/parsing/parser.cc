@@ -29,7 +29,10 @@ namespace v8 {
 namespace internal {
 
 ScriptData::ScriptData(const byte* data, int length)
-    : owns_data_(false), rejected_(false), data_(data), length_(length) {
+    : owns_data_(false),
+      reject_reason_(v8::ScriptCompiler::CachedData::kNotRejected),
+      data_(data),
+      length_(length) {
   if (!IsAligned(reinterpret_cast<intptr_t>(data), kPointerAlignment)) {
     byte* copy = NewArray<byte>(length);
     DCHECK(IsAligned(reinterpret_cast<intptr_t>(copy), kPointerAlignment));
@@ -95,17 +98,73 @@ ParseInfo::ParseInfo(Zone* zone, Handle<Script> script) : ParseInfo(zone) {
 }
 
 
+ParseData* ParseData::ForInnerFunctions(ScriptData* cached_data, int start,
+                                        int end) {
+  ParseData outer(cached_data);
+  if (!outer.IsSane()) return NULL;
+  int first = outer.LowerBound(start);
+  int last = outer.LowerBound(end);
+  int functions_size = (last - first) * FunctionEntry::kSize;
+  int total_size = PreparseDataConstants::kHeaderSize + functions_size;
+  unsigned* data = NewArray<unsigned>(total_size);
+  MemCopy(data, outer.Data(),
+          PreparseDataConstants::kHeaderSize * sizeof(unsigned));
+  data[PreparseDataConstants::kFunctionsSizeOffset] = functions_size;
+  MemCopy(data + PreparseDataConstants::kHeaderSize,
+          outer.Data() + PreparseDataConstants::kHeaderSize +
+              first * FunctionEntry::kSize,
+          functions_size * sizeof(unsigned));
+  ScriptData* script_data =
+      new ScriptData(reinterpret_cast<byte*>(data),
+                     total_size * sizeof(unsigned));
+  script_data->AcquireDataOwnership();
+  ParseData* result = new ParseData(script_data);
+  result->owns_script_data_ = true;
+  DCHECK(result->IsSane());
+  return result;
+}
+
+
 FunctionEntry ParseData::GetFunctionEntry(int start) {
-  // The current pre-data entry must be a FunctionEntry with the given
-  // start position.
-  if ((function_index_ + FunctionEntry::kSize <= Length()) &&
-      (static_cast<int>(Data()[function_index_]) == start)) {
-    int index = function_index_;
-    function_index_ += FunctionEntry::kSize;
-    Vector<unsigned> subvector(&(Data()[index]), FunctionEntry::kSize);
-    return FunctionEntry(subvector);
+  // Entries are sorted by start position and usually consumed in order, so
+  // try the entry after the last one returned before searching.
+  int index = function_index_;
+  if (index + FunctionEntry::kSize > Length() ||
+      static_cast<int>(Data()[index]) != start) {
+    index = PreparseDataConstants::kHeaderSize +
+            LowerBound(start) * FunctionEntry::kSize;
+    if (index + FunctionEntry::kSize > Length() ||
+        static_cast<int>(Data()[index]) != start) {
+      return FunctionEntry();
+    }
   }
-  return FunctionEntry();
+  function_index_ = index + FunctionEntry::kSize;
+  Vector<unsigned> subvector(&(Data()[index]), FunctionEntry::kSize);
+  return FunctionEntry(subvector);
+}
+
+
+bool ParseData::HasFunctionEntry(int start) {
+  int index = LowerBound(start);
+  return index < FunctionCount() &&
+         static_cast<int>(Data()[PreparseDataConstants::kHeaderSize +
+                                 index * FunctionEntry::kSize]) == start;
+}
+
+
+int ParseData::LowerBound(int start) {
+  const unsigned* entries = Data() + PreparseDataConstants::kHeaderSize;
+  int low = 0;
+  int high = FunctionCount();
+  while (low < high) {
+    int middle = low + (high - low) / 2;
+    if (static_cast<int>(entries[middle * FunctionEntry::kSize]) < start) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
 }
 
 
@@ -777,6 +836,7 @@ Parser::Parser(ParseInfo* info)
       cached_parse_data_(NULL),
       total_preparse_skipped_(0),
       pre_parse_timer_(NULL),
+      runtime_call_stats_(NULL),
       parsing_on_main_thread_(true) {
   // Even though we were passed ParseInfo, we should not store it in
   // Parser - this makes sure that Isolate is not accidentally accessed via
@@ -807,6 +867,14 @@ Parser::Parser(ParseInfo* info)
 }
 
 
+// Returns a copy of the URL of |script| for trace events.
+static base::SmartArrayPointer<char> ScriptUrlForTracing(Script* script) {
+  Object* name = script->name();
+  if (!name->IsString()) return base::SmartArrayPointer<char>(StrDup(""));
+  return String::cast(name)->ToCString();
+}
+
+
 FunctionLiteral* Parser::ParseProgram(Isolate* isolate, ParseInfo* info) {
   // TODO(bmeurer): We temporarily need to pass allow_nesting = true here,
   // see comment for HistogramTimerScope class.
@@ -816,8 +884,14 @@ FunctionLiteral* Parser::ParseProgram(Isolate* isolate, ParseInfo* info) {
   DCHECK(parsing_on_main_thread_);
 
   HistogramTimerScope timer_scope(isolate->counters()->parse(), true);
+  RuntimeCallTimerScope runtime_timer(
+      isolate, &isolate->counters()->runtime_call_stats()->ParseProgram);
   TRACE_EVENT0("v8", "V8.Parse");
   Handle<String> source(String::cast(info->script()->source()));
+  TRACE_EVENT2(TRACE_DISABLED_BY_DEFAULT("v8.compile"), "V8.ParseScript",
+               "url",
+               TRACE_STR_COPY(ScriptUrlForTracing(*info->script()).get()),
+               "bytes", source->length());
   isolate->counters()->total_parse_size()->Increment(source->length());
   base::ElapsedTimer timer;
   if (FLAG_trace_parse) {
@@ -845,6 +919,11 @@ FunctionLiteral* Parser::ParseProgram(Isolate* isolate, ParseInfo* info) {
         Handle<ExternalTwoByteString>::cast(source), 0, source->length());
     scanner_.Initialize(&stream);
     result = DoParseProgram(info);
+  } else if (source->IsExternalOneByteString()) {
+    ExternalOneByteStringUtf16CharacterStream stream(
+        Handle<ExternalOneByteString>::cast(source), 0, source->length());
+    scanner_.Initialize(&stream);
+    result = DoParseProgram(info);
   } else {
     GenericStringUtf16CharacterStream stream(source, 0, source->length());
     scanner_.Initialize(&stream);
@@ -981,6 +1060,8 @@ FunctionLiteral* Parser::ParseLazy(Isolate* isolate, ParseInfo* info) {
   // called in the main thread.
   DCHECK(parsing_on_main_thread_);
   HistogramTimerScope timer_scope(isolate->counters()->parse_lazy());
+  RuntimeCallTimerScope runtime_timer(
+      isolate, &isolate->counters()->runtime_call_stats()->ParseLazy);
   TRACE_EVENT0("v8", "V8.ParseLazy");
   Handle<String> source(String::cast(info->script()->source()));
   isolate->counters()->total_parse_size()->Increment(source->length());
@@ -990,6 +1071,22 @@ FunctionLiteral* Parser::ParseLazy(Isolate* isolate, ParseInfo* info) {
   }
   Handle<SharedFunctionInfo> shared_info = info->shared_info();
 
+  // Reuse the entries the parser cache holds for the inner functions.
+  if (FLAG_parser_cache_inner_functions &&
+      info->script()->preparse_data()->IsByteArray()) {
+    DisallowHeapAllocation no_gc;
+    ByteArray* preparse_data = ByteArray::cast(info->script()->preparse_data());
+    ScriptData script_data(preparse_data->GetDataStartAddress(),
+                           preparse_data->length());
+    cached_parse_data_ = ParseData::ForInnerFunctions(
+        &script_data, shared_info->start_position(),
+        shared_info->end_position());
+    if (cached_parse_data_ != NULL) {
+      cached_parse_data_->Initialize();
+      compile_options_ = ScriptCompiler::kConsumeParserCache;
+    }
+  }
+
   // Initialize parser state.
   source = String::Flatten(source);
   FunctionLiteral* result;
@@ -999,6 +1096,12 @@ FunctionLiteral* Parser::ParseLazy(Isolate* isolate, ParseInfo* info) {
         shared_info->start_position(),
         shared_info->end_position());
     result = ParseLazy(isolate, info, &stream);
+  } else if (source->IsExternalOneByteString()) {
+    ExternalOneByteStringUtf16CharacterStream stream(
+        Handle<ExternalOneByteString>::cast(source),
+        shared_info->start_position(),
+        shared_info->end_position());
+    result = ParseLazy(isolate, info, &stream);
   } else {
     GenericStringUtf16CharacterStream stream(source,
                                              shared_info->start_position(),
@@ -4101,6 +4204,23 @@ FunctionLiteral* Parser::ParseFunctionLiteral(
                             scope_->AllowsLazyParsing() &&
                             !function_state_->this_function_is_parenthesized();
 
+    // Functions inside a lazily compiled function are parsed eagerly so that
+    // the variables they reference get context allocated. An inner function
+    // found in the parser cache is skipped instead, and all variables of the
+    // functions enclosing it are context allocated.
+    if (!is_lazily_parsed && FLAG_parser_cache_inner_functions &&
+        scope_->outer_scope() != original_scope_ &&
+        consume_cached_parse_data() && !cached_parse_data_->rejected() &&
+        scope_->AllowsLazyParsing() &&
+        !function_state_->this_function_is_parenthesized() &&
+        cached_parse_data_->HasFunctionEntry(position())) {
+      for (Scope* s = scope_->outer_scope(); s != original_scope_;
+           s = s->outer_scope()) {
+        s->ForceContextAllocation();
+      }
+      is_lazily_parsed = true;
+    }
+
     // Eager or lazy parse?
     // If is_lazily_parsed, we'll parse lazy. If we can set a bookmark, we'll
     // pass it to SkipLazyFunctionBody, which may use it to abort lazy
@@ -4603,6 +4723,9 @@ PreParser::PreParseResult Parser::ParseLazyFunctionBodyWithPreParser(
   if (pre_parse_timer_ != NULL) {
     pre_parse_timer_->Start();
   }
+  if (runtime_call_stats_ != NULL) {
+    runtime_call_stats_->Enter(&runtime_call_stats_->PreParse);
+  }
   TRACE_EVENT0("v8", "V8.PreParse");
 
   DCHECK_EQ(Token::LBRACE, scanner()->current_token());
@@ -4621,12 +4744,17 @@ PreParser::PreParseResult Parser::ParseLazyFunctionBodyWithPreParser(
     SET_ALLOW(harmony_restrictive_declarations);
 #undef SET_ALLOW
   }
+  ParserRecorder* inner_function_log =
+      FLAG_parser_cache_inner_functions && produce_cached_parse_data()
+          ? log_
+          : NULL;
   PreParser::PreParseResult result = reusable_preparser_->PreParseLazyFunction(
       language_mode(), function_state_->kind(), scope_->has_simple_parameters(),
-      parsing_module_, logger, bookmark, use_counts_);
+      parsing_module_, logger, inner_function_log, bookmark, use_counts_);
   if (pre_parse_timer_ != NULL) {
     pre_parse_timer_->Stop();
   }
+  if (runtime_call_stats_ != NULL) runtime_call_stats_->Leave();
   return result;
 }
 
@@ -4936,7 +5064,14 @@ void Parser::HandleSourceURLComments(Isolate* isolate, Handle<Script> script) {
 
 void Parser::Internalize(Isolate* isolate, Handle<Script> script, bool error) {
   // Internalize strings.
-  ast_value_factory()->Internalize(isolate);
+  {
+    RuntimeCallTimerScope runtime_timer(
+        isolate,
+        &isolate->counters()->runtime_call_stats()->InternalizeAstValues);
+    TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.compile"),
+                 "V8.InternalizeAstValues");
+    ast_value_factory()->Internalize(isolate);
+  }
 
   // Error processing.
   if (error) {
@@ -4987,6 +5122,9 @@ bool Parser::Parse(ParseInfo* info) {
   DCHECK(parsing_on_main_thread_);
   Isolate* isolate = info->isolate();
   pre_parse_timer_ = isolate->counters()->pre_parse();
+  if (FLAG_runtime_call_stats) {
+    runtime_call_stats_ = isolate->counters()->runtime_call_stats();
+  }
   if (FLAG_trace_parse || allow_natives() || extension_ != NULL) {
     // If intrinsics are allowed, the Parser cannot operate independent of the
     // V8 heap because of Runtime. Tell the string table to internalize strings
@@ -5172,15 +5310,17 @@ ZoneList<v8::internal::Expression*>* Parser::PrepareSpreadArguments(
       new (zone()) ZoneList<v8::internal::Expression*>(1, zone());
   if (list->length() == 1) {
     // Spread-call with single spread argument produces an InternalArray
-    // containing the values from the array.
+    // containing the values from the array. Arrays with an unmodified
+    // iteration protocol are passed on unchanged, since nothing can modify
+    // them before the call reads their elements.
     //
     // Function is called or constructed with the produced array of arguments
     //
-    // EG: Apply(Func, Spread(spread0))
+    // EG: Apply(Func, SpreadPrepare(spread0))
     ZoneList<Expression*>* spread_list =
         new (zone()) ZoneList<Expression*>(0, zone());
     spread_list->Add(list->at(0)->AsSpread()->expression(), zone());
-    args->Add(factory()->NewCallRuntime(Context::SPREAD_ITERABLE_INDEX,
+    args->Add(factory()->NewCallRuntime(Runtime::kSpreadIterablePrepare,
                                         spread_list, RelocInfo::kNoPosition),
               zone());
     return args;
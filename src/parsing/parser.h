@@ -243,13 +243,24 @@ class ParseData {
   static ParseData* FromCachedData(ScriptData* cached_data) {
     ParseData* pd = new ParseData(cached_data);
     if (pd->IsSane()) return pd;
-    cached_data->Reject();
+    cached_data->Reject(v8::ScriptCompiler::CachedData::kInvalidParserCache);
     delete pd;
     return NULL;
   }
 
+  // Copies the entries of |cached_data| for the functions starting inside
+  // [start, end) into parse data that owns its copy. Returns NULL if
+  // |cached_data| is not sane.
+  static ParseData* ForInnerFunctions(ScriptData* cached_data, int start,
+                                      int end);
+
+  ~ParseData() {
+    if (owns_script_data_) delete script_data_;
+  }
+
   void Initialize();
   FunctionEntry GetFunctionEntry(int start);
+  bool HasFunctionEntry(int start);
   int FunctionCount();
 
   bool HasError();
@@ -258,14 +269,20 @@ class ParseData {
     return reinterpret_cast<unsigned*>(const_cast<byte*>(script_data_->data()));
   }
 
-  void Reject() { script_data_->Reject(); }
+  void Reject() {
+    script_data_->Reject(v8::ScriptCompiler::CachedData::kInvalidParserCache);
+  }
 
   bool rejected() const { return script_data_->rejected(); }
 
  private:
-  explicit ParseData(ScriptData* script_data) : script_data_(script_data) {}
+  explicit ParseData(ScriptData* script_data)
+      : script_data_(script_data), owns_script_data_(false) {}
 
   bool IsSane();
+  // Returns the index of the first entry whose start position is not less
+  // than |start|, or FunctionCount() if there is none.
+  int LowerBound(int start);
   unsigned Magic();
   unsigned Version();
   int FunctionsSize();
@@ -275,6 +292,7 @@ class ParseData {
   }
 
   ScriptData* script_data_;
+  bool owns_script_data_;
   int function_index_;
 
   DISALLOW_COPY_AND_ASSIGN(ParseData);
@@ -350,6 +368,15 @@ class ParserTraits {
 
   explicit ParserTraits(Parser* parser) : parser_(parser) {}
 
+  static Scope* CreateScope(Zone* zone, Scope* parent, ScopeType scope_type,
+                            AstValueFactory* ast_value_factory,
+                            FunctionKind kind) {
+    Scope* result =
+        new (zone) Scope(zone, parent, scope_type, ast_value_factory, kind);
+    result->Initialize();
+    return result;
+  }
+
   // Helper functions for recursive descent.
   bool IsEval(const AstRawString* identifier) const;
   bool IsArguments(const AstRawString* identifier) const;
@@ -1076,6 +1103,8 @@ class Parser : public ParserBase<ParserTraits> {
   int use_counts_[v8::Isolate::kUseCounterFeatureCount];
   int total_preparse_skipped_;
   HistogramTimer* pre_parse_timer_;
+  // Only set on the main thread with --runtime-call-stats.
+  RuntimeCallStats* runtime_call_stats_;
 
   bool parsing_on_main_thread_;
 };
@@ -2,6 +2,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <vector>
+
 #include "src/base/logging.h"
 #include "src/globals.h"
 #include "src/hashmap.h"
@@ -58,6 +61,49 @@ void CompleteParserRecorder::WriteString(Vector<const char> str) {
 }
 
 
+namespace {
+
+unsigned StartPosition(const unsigned* entries, int index) {
+  return entries[index * FunctionEntry::kSize +
+                 FunctionEntry::kStartPositionIndex];
+}
+
+struct FunctionEntryStartLess {
+  explicit FunctionEntryStartLess(const unsigned* entries)
+      : entries_(entries) {}
+  bool operator()(int a, int b) const {
+    return StartPosition(entries_, a) < StartPosition(entries_, b);
+  }
+  const unsigned* entries_;
+};
+
+// Inner functions logged by the preparser precede the function containing
+// them. Orders the entries by start position, which ParseData relies on to
+// look them up.
+void SortFunctionEntries(Vector<unsigned> entries) {
+  int count = entries.length() / FunctionEntry::kSize;
+  bool sorted = true;
+  for (int i = 1; i < count && sorted; i++) {
+    sorted = StartPosition(entries.start(), i - 1) <
+             StartPosition(entries.start(), i);
+  }
+  if (sorted) return;
+  std::vector<int> order(count);
+  for (int i = 0; i < count; i++) order[i] = i;
+  std::sort(order.begin(), order.end(),
+            FunctionEntryStartLess(entries.start()));
+  Vector<unsigned> copy = entries.Clone();
+  for (int i = 0; i < count; i++) {
+    MemCopy(&entries[i * FunctionEntry::kSize],
+            &copy[order[i] * FunctionEntry::kSize],
+            FunctionEntry::kSize * sizeof(unsigned));
+  }
+  copy.Dispose();
+}
+
+}  // namespace
+
+
 ScriptData* CompleteParserRecorder::GetScriptData() {
   int function_size = function_store_.size();
   int total_size = PreparseDataConstants::kHeaderSize + function_size;
@@ -65,8 +111,10 @@ ScriptData* CompleteParserRecorder::GetScriptData() {
   preamble_[PreparseDataConstants::kFunctionsSizeOffset] = function_size;
   MemCopy(data, preamble_, sizeof(preamble_));
   if (function_size > 0) {
-    function_store_.WriteTo(Vector<unsigned>(
-        data + PreparseDataConstants::kHeaderSize, function_size));
+    Vector<unsigned> entries(data + PreparseDataConstants::kHeaderSize,
+                             function_size);
+    function_store_.WriteTo(entries);
+    if (!HasError()) SortFunctionEntries(entries);
   }
   DCHECK(IsAligned(reinterpret_cast<intptr_t>(data), kPointerAlignment));
   ScriptData* result = new ScriptData(reinterpret_cast<byte*>(data),
@@ -5,6 +5,7 @@
 #ifndef V8_PARSING_PREPARSE_DATA_H_
 #define V8_PARSING_PREPARSE_DATA_H_
 
+#include "include/v8.h"
 #include "src/allocation.h"
 #include "src/collector.h"
 #include "src/hashmap.h"
@@ -16,6 +17,8 @@ namespace internal {
 
 class ScriptData {
  public:
+  typedef v8::ScriptCompiler::CachedData::RejectReason RejectReason;
+
   ScriptData(const byte* data, int length);
   ~ScriptData() {
     if (owns_data_) DeleteArray(data_);
@@ -23,9 +26,15 @@ class ScriptData {
 
   const byte* data() const { return data_; }
   int length() const { return length_; }
-  bool rejected() const { return rejected_; }
+  bool rejected() const {
+    return reject_reason_ != v8::ScriptCompiler::CachedData::kNotRejected;
+  }
+  RejectReason reject_reason() const { return reject_reason_; }
 
-  void Reject() { rejected_ = true; }
+  void Reject(RejectReason reason) {
+    DCHECK_NE(v8::ScriptCompiler::CachedData::kNotRejected, reason);
+    reject_reason_ = reason;
+  }
 
   void AcquireDataOwnership() {
     DCHECK(!owns_data_);
@@ -38,8 +47,8 @@ class ScriptData {
   }
 
  private:
-  bool owns_data_ : 1;
-  bool rejected_ : 1;
+  bool owns_data_;
+  RejectReason reject_reason_;
   const byte* data_;
   int length_;
 
@@ -102,11 +102,17 @@ PreParserExpression PreParserTraits::ParseFunctionLiteral(
 
 PreParser::PreParseResult PreParser::PreParseLazyFunction(
     LanguageMode language_mode, FunctionKind kind, bool has_simple_parameters,
-    bool parsing_module, ParserRecorder* log, Scanner::BookmarkScope* bookmark,
+    bool parsing_module, ParserRecorder* log,
+    ParserRecorder* inner_function_log, Scanner::BookmarkScope* bookmark,
     int* use_counts) {
   parsing_module_ = parsing_module;
   log_ = log;
+  inner_function_log_ = inner_function_log;
   use_counts_ = use_counts;
+  // Nothing the preparser allocates outlives the skipped function, so keep
+  // it out of the zone of the outer parser.
+  Zone preparse_zone(zone()->allocator());
+  ParsingZoneScope zone_scope(this, &preparse_zone);
   // Lazy functions always have trivial outer scopes (no with/catch scopes).
   Scope* top_scope = NewScope(scope_, SCRIPT_SCOPE);
   PreParserFactory top_factory(NULL);
@@ -123,6 +129,7 @@ PreParser::PreParseResult PreParser::PreParseLazyFunction(
   int start_position = peek_position();
   ParseLazyFunctionLiteralBody(&ok, bookmark);
   use_counts_ = nullptr;
+  inner_function_log_ = nullptr;
   if (bookmark && bookmark->HasBeenReset()) {
     // Do nothing, as we've just aborted scanning this function.
   } else if (stack_overflow()) {
@@ -1092,6 +1099,8 @@ PreParser::Expression PreParser::ParseFunctionLiteral(
                            !function_state_->this_function_is_parenthesized());
 
   Expect(Token::LBRACE, CHECK_OK);
+  int body_start = position();
+  int formals_literal_count = function_state_->materialized_literal_count();
   if (is_lazily_parsed) {
     ParseLazyFunctionLiteralBody(CHECK_OK);
   } else {
@@ -1102,6 +1111,16 @@ PreParser::Expression PreParser::ParseFunctionLiteral(
   // Parsing the body may change the language mode in our scope.
   language_mode = function_scope->language_mode();
 
+  if (!is_lazily_parsed && inner_function_log_ != NULL) {
+    // Log the inner function so that a lazy compile of the enclosing
+    // function can skip it.
+    inner_function_log_->LogFunction(
+        body_start, scanner()->location().end_pos,
+        function_state_->materialized_literal_count() - formals_literal_count,
+        function_state_->expected_property_count(), language_mode,
+        scope_->uses_super_property(), scope_->calls_eval());
+  }
+
   // Validate name and parameter names. We can do this only after parsing the
   // function, since the function can declare itself strict.
   CheckFunctionName(language_mode, function_name, function_name_validity,
@@ -597,6 +597,15 @@ class PreParserTraits {
 
   explicit PreParserTraits(PreParser* pre_parser) : pre_parser_(pre_parser) {}
 
+  // The preparser's scopes only collect the flags it records, see
+  // Scope::NewForPreParsing.
+  static Scope* CreateScope(Zone* zone, Scope* parent, ScopeType scope_type,
+                            AstValueFactory* ast_value_factory,
+                            FunctionKind kind) {
+    return Scope::NewForPreParsing(zone, parent, scope_type,
+                                   ast_value_factory, kind);
+  }
+
   // Helper functions for recursive descent.
   static bool IsEval(PreParserIdentifier identifier) {
     return identifier.IsEval();
@@ -975,7 +984,8 @@ class PreParser : public ParserBase<PreParserTraits> {
             ParserRecorder* log, uintptr_t stack_limit)
       : ParserBase<PreParserTraits>(zone, scanner, stack_limit, NULL,
                                     ast_value_factory, log, this),
-        use_counts_(nullptr) {}
+        use_counts_(nullptr),
+        inner_function_log_(nullptr) {}
 
   // Pre-parse the program from the character stream; returns true on
   // success (even if parsing failed, the pre-parse data successfully
@@ -1024,6 +1034,7 @@ class PreParser : public ParserBase<PreParserTraits> {
                                       FunctionKind kind,
                                       bool has_simple_parameters,
                                       bool parsing_module, ParserRecorder* log,
+                                      ParserRecorder* inner_function_log,
                                       Scanner::BookmarkScope* bookmark,
                                       int* use_counts);
 
@@ -1102,6 +1113,9 @@ class PreParser : public ParserBase<PreParserTraits> {
                                         bool* ok);
 
   int* use_counts_;
+  // If non-NULL, receives the entries of functions nested in the function
+  // being preparsed, which are otherwise not logged.
+  ParserRecorder* inner_function_log_;
 };
 
 
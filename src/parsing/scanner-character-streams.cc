@@ -190,6 +190,26 @@ Utf8ToUtf16CharacterStream::Utf8ToUtf16CharacterStream(const byte* data,
 Utf8ToUtf16CharacterStream::~Utf8ToUtf16CharacterStream() { }
 
 
+// Returns the number of ASCII bytes at the start of |src|, checking a word at
+// a time once |src| is aligned.
+static size_t AsciiRunLength(const byte* src, size_t length) {
+  static const uintptr_t kNonAsciiMask =
+      static_cast<uintptr_t>(V8_UINT64_C(0x8080808080808080));
+  size_t i = 0;
+  while (i < length &&
+         !IsAligned(reinterpret_cast<intptr_t>(src + i), sizeof(uintptr_t))) {
+    if (src[i] > unibrow::Utf8::kMaxOneByteChar) return i;
+    i++;
+  }
+  while (i + sizeof(uintptr_t) <= length &&
+         (*reinterpret_cast<const uintptr_t*>(src + i) & kNonAsciiMask) == 0) {
+    i += sizeof(uintptr_t);
+  }
+  while (i < length && src[i] <= unibrow::Utf8::kMaxOneByteChar) i++;
+  return i;
+}
+
+
 size_t Utf8ToUtf16CharacterStream::CopyChars(uint16_t* dest, size_t length,
                                              const byte* src, size_t* src_pos,
                                              size_t src_length) {
@@ -203,11 +223,16 @@ size_t Utf8ToUtf16CharacterStream::CopyChars(uint16_t* dest, size_t length,
     if (*src_pos == src_length) break;
     unibrow::uchar c = src[*src_pos];
     if (c <= unibrow::Utf8::kMaxOneByteChar) {
-      *src_pos = *src_pos + 1;
-    } else {
-      c = unibrow::Utf8::CalculateValue(src + *src_pos, src_length - *src_pos,
-                                        src_pos);
+      // Widen the whole run of ASCII characters at once.
+      size_t run = AsciiRunLength(src + *src_pos,
+                                  Min(src_length - *src_pos, length - 1 - i));
+      CopyCharsUnsigned(dest + i, src + *src_pos, run);
+      *src_pos += run;
+      i += run;
+      continue;
     }
+    c = unibrow::Utf8::CalculateValue(src + *src_pos, src_length - *src_pos,
+                                      src_pos);
     if (c > kMaxUtf16Character) {
       dest[i++] = unibrow::Utf16::LeadSurrogate(c);
       dest[i++] = unibrow::Utf16::TrailSurrogate(c);
@@ -585,5 +610,76 @@ void ExternalTwoByteStringUtf16CharacterStream::ResetToBookmark() {
   pos_ = bookmark_;
   buffer_cursor_ = raw_data_ + bookmark_;
 }
+
+
+// ----------------------------------------------------------------------------
+// ExternalOneByteStringUtf16CharacterStream
+
+ExternalOneByteStringUtf16CharacterStream::
+    ~ExternalOneByteStringUtf16CharacterStream() {}
+
+
+ExternalOneByteStringUtf16CharacterStream::
+    ExternalOneByteStringUtf16CharacterStream(
+        Handle<ExternalOneByteString> data, int start_position,
+        int end_position)
+    : Utf16CharacterStream(),
+      source_(data),
+      raw_data_(data->GetChars()),
+      length_(end_position),
+      bookmark_(kNoBookmark) {
+  DCHECK(end_position >= start_position);
+  pos_ = start_position;
+  // Initialize buffer as being empty. First read will fill the buffer.
+  buffer_cursor_ = buffer_;
+  buffer_end_ = buffer_;
+}
+
+
+void ExternalOneByteStringUtf16CharacterStream::PushBack(uc32 character) {
+  DCHECK(pos_ > 0);
+  pos_--;
+  if (character == kEndOfInput) return;
+  // The buffer holds the source characters, so the pushed back character
+  // is still in front of the cursor unless a refill just happened.
+  DCHECK_EQ(static_cast<uc32>(raw_data_[pos_]), character);
+  if (buffer_cursor_ > buffer_) {
+    buffer_cursor_--;
+  } else {
+    ReadBlock();
+  }
+}
+
+
+bool ExternalOneByteStringUtf16CharacterStream::SetBookmark() {
+  bookmark_ = pos_;
+  return true;
+}
+
+
+void ExternalOneByteStringUtf16CharacterStream::ResetToBookmark() {
+  DCHECK(bookmark_ != kNoBookmark);
+  pos_ = bookmark_;
+  ReadBlock();
+}
+
+
+size_t ExternalOneByteStringUtf16CharacterStream::SlowSeekForward(
+    size_t delta) {
+  size_t old_pos = pos_;
+  pos_ = Min(pos_ + delta, length_);
+  ReadBlock();
+  return pos_ - old_pos;
+}
+
+
+bool ExternalOneByteStringUtf16CharacterStream::ReadBlock() {
+  buffer_cursor_ = buffer_;
+  size_t length = pos_ < length_ ? Min(kBufferSize, length_ - pos_) : 0;
+  CopyChars(buffer_, raw_data_ + pos_, length);
+  buffer_end_ = buffer_ + length;
+  return length > 0;
+}
+
 }  // namespace internal
 }  // namespace v8
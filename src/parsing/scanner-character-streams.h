@@ -13,6 +13,7 @@ namespace v8 {
 namespace internal {
 
 // Forward declarations.
+class ExternalOneByteString;
 class ExternalTwoByteString;
 
 // A buffered character stream based on a random access character
@@ -183,6 +184,40 @@ class ExternalTwoByteStringUtf16CharacterStream: public Utf16CharacterStream {
   size_t bookmark_;
 };
 
+
+
+// UTF16 buffer to read characters from an external one-byte string. The
+// characters are read straight from the external resource and widened
+// block-wise, without going through String::WriteToFlat.
+class ExternalOneByteStringUtf16CharacterStream : public Utf16CharacterStream {
+ public:
+  ExternalOneByteStringUtf16CharacterStream(Handle<ExternalOneByteString> data,
+                                            int start_position,
+                                            int end_position);
+  ~ExternalOneByteStringUtf16CharacterStream() override;
+
+  void PushBack(uc32 character) override;
+
+  bool SetBookmark() override;
+  void ResetToBookmark() override;
+
+ protected:
+  static const size_t kBufferSize = 512;
+
+  size_t SlowSeekForward(size_t delta) override;
+  bool ReadBlock() override;
+
+  Handle<ExternalOneByteString> source_;
+  const uint8_t* raw_data_;  // Pointer to the actual array of characters.
+  size_t length_;
+
+ private:
+  static const size_t kNoBookmark = -1;
+
+  size_t bookmark_;
+  uc16 buffer_[kBufferSize];
+};
+
 }  // namespace internal
 }  // namespace v8
 
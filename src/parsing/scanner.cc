@@ -33,6 +33,94 @@ bool Utf16CharacterStream::SetBookmark() { return false; }
 void Utf16CharacterStream::ResetToBookmark() { UNREACHABLE(); }
 
 
+// ----------------------------------------------------------------------------
+// Word-at-a-time code unit search
+
+namespace {
+
+const int kCodeUnitsPerWord = sizeof(uintptr_t) / sizeof(uint16_t);
+
+// Returns a word with |code_unit| in each of its code unit lanes.
+inline uintptr_t Broadcast(uint16_t code_unit) {
+  return kUintptrAllBitsSet / 0xFFFF * code_unit;
+}
+
+// Returns non-zero iff one of the code unit lanes of |word| is |code_unit|.
+inline uintptr_t HasCodeUnit(uintptr_t word, uint16_t code_unit) {
+  uintptr_t lanes = word ^ Broadcast(code_unit);
+  return (lanes - Broadcast(1)) & ~lanes & Broadcast(0x8000);
+}
+
+// Matchers are used by Scanner::AdvanceUntil. Match() decides whether to
+// stop at a code unit. MayMatch() must be non-zero if Match() holds for
+// any code unit lane of a word, and should be zero for most words that
+// do not need to be looked at.
+
+// Line terminators end single-line comments.
+struct LineTerminatorMatcher {
+  static bool Match(uc32 c) {
+    return c == '\n' || c == '\r' || c == 0x2028 || c == 0x2029;
+  }
+  static uintptr_t MayMatch(uintptr_t word) {
+    return HasCodeUnit(word, '\n') | HasCodeUnit(word, '\r') |
+           (word & Broadcast(0xE000));
+  }
+};
+
+// Only '*' and line terminators are interesting inside multi-line comments.
+struct MultiLineCommentMatcher {
+  static bool Match(uc32 c) {
+    return c == '*' || LineTerminatorMatcher::Match(c);
+  }
+  static uintptr_t MayMatch(uintptr_t word) {
+    return HasCodeUnit(word, '*') | LineTerminatorMatcher::MayMatch(word);
+  }
+};
+
+// Stops at the end of a run of spaces.
+struct NonSpaceMatcher {
+  static bool Match(uc32 c) { return c != ' '; }
+  static uintptr_t MayMatch(uintptr_t word) { return word ^ Broadcast(' '); }
+};
+
+// Stops at anything in a string literal that is not a one-byte character
+// standing for itself.
+template <uint16_t quote>
+struct StringMatcher {
+  static bool Match(uc32 c) {
+    return c == quote || c == '\\' || c == '\n' || c == '\r' ||
+           c > unibrow::Utf8::kMaxOneByteChar;
+  }
+  static uintptr_t MayMatch(uintptr_t word) {
+    return HasCodeUnit(word, quote) | HasCodeUnit(word, '\\') |
+           HasCodeUnit(word, '\n') | HasCodeUnit(word, '\r') |
+           (word & Broadcast(0xFF80));
+  }
+};
+
+// Returns the index of the first code unit in |units| accepted by
+// |Matcher|, or the length of |units| if there is none.
+template <typename Matcher>
+int FindCodeUnit(Vector<const uint16_t> units) {
+  const uint16_t* start = units.start();
+  const uint16_t* chars = start;
+  const uint16_t* limit = start + units.length();
+  while (chars < limit) {
+    if (IsAligned(reinterpret_cast<intptr_t>(chars), sizeof(uintptr_t)) &&
+        limit - chars >= kCodeUnitsPerWord &&
+        !Matcher::MayMatch(*reinterpret_cast<const uintptr_t*>(chars))) {
+      chars += kCodeUnitsPerWord;
+      continue;
+    }
+    if (Matcher::Match(*chars)) break;
+    ++chars;
+  }
+  return static_cast<int>(chars - start);
+}
+
+}  // namespace
+
+
 // ----------------------------------------------------------------------------
 // Scanner
 
@@ -296,6 +384,22 @@ static inline bool IsLittleEndianByteOrderMark(uc32 c) {
 }
 
 
+template <typename Matcher, bool capture_literal>
+void Scanner::AdvanceUntil() {
+  while (c0_ >= 0 && !Matcher::Match(c0_)) {
+    if (capture_literal) AddLiteralChar(c0_);
+    Vector<const uint16_t> units = source_->BufferedCodeUnits();
+    int skip = FindCodeUnit<Matcher>(units);
+    if (capture_literal) {
+      DCHECK_NOT_NULL(next_.literal_chars);
+      next_.literal_chars->AddOneByteChars(units.start(), skip);
+    }
+    source_->SeekForward(skip);
+    c0_ = source_->Advance();
+  }
+}
+
+
 bool Scanner::SkipWhiteSpace() {
   int start_position = source_pos();
 
@@ -305,6 +409,12 @@ bool Scanner::SkipWhiteSpace() {
       if (c0_ < 0) break;
       // Advance as long as character is a WhiteSpace or LineTerminator.
       // Remember if the latter is the case.
+      if (c0_ == ' ') {
+        // Skip runs of spaces, e.g. indentation, at once.
+        AdvanceUntil<NonSpaceMatcher, false>();
+        HandleLeadSurrogate();
+        continue;
+      }
       if (unicode_cache_->IsLineTerminator(c0_)) {
         has_line_terminator_before_next_ = true;
       } else if (!unicode_cache_->IsWhiteSpace(c0_) &&
@@ -346,9 +456,7 @@ Token::Value Scanner::SkipSingleLineComment() {
   // separately by the lexical grammar and becomes part of the
   // stream of input elements for the syntactic grammar (see
   // ECMA-262, section 7.4).
-  while (c0_ >= 0 && !unicode_cache_->IsLineTerminator(c0_)) {
-    Advance();
-  }
+  AdvanceUntil<LineTerminatorMatcher, false>();
 
   return Token::WHITESPACE;
 }
@@ -356,9 +464,7 @@ Token::Value Scanner::SkipSingleLineComment() {
 
 Token::Value Scanner::SkipSourceURLComment() {
   TryToParseSourceURLComment();
-  while (c0_ >= 0 && !unicode_cache_->IsLineTerminator(c0_)) {
-    Advance();
-  }
+  AdvanceUntil<LineTerminatorMatcher, false>();
 
   return Token::WHITESPACE;
 }
@@ -420,6 +526,9 @@ Token::Value Scanner::SkipMultiLineComment() {
   Advance();
 
   while (c0_ >= 0) {
+    // Nothing but '*' and line terminators matters until the comment ends.
+    AdvanceUntil<MultiLineCommentMatcher, false>();
+    if (c0_ < 0) break;
     uc32 ch = c0_;
     Advance();
     if (c0_ >= 0 && unicode_cache_->IsLineTerminator(ch)) {
@@ -840,21 +949,23 @@ Token::Value Scanner::ScanString() {
   Advance<false, false>();  // consume quote
 
   LiteralScope literal(this);
-  while (true) {
-    if (c0_ > kMaxAscii) {
-      HandleLeadSurrogate();
-      break;
-    }
+  // Fast case: add one-byte characters up to the first quote, escape,
+  // line terminator or non-one-byte character to the literal at once.
+  if (quote == '"') {
+    AdvanceUntil<StringMatcher<'"'>, true>();
+  } else {
+    AdvanceUntil<StringMatcher<'\''>, true>();
+  }
+  if (c0_ > kMaxAscii) {
+    HandleLeadSurrogate();
+  } else {
     if (c0_ < 0 || c0_ == '\n' || c0_ == '\r') return Token::ILLEGAL;
     if (c0_ == quote) {
       literal.Complete();
       Advance<false, false>();
       return Token::STRING;
     }
-    uc32 c = c0_;
-    if (c == '\\') break;
-    Advance<false, false>();
-    AddLiteralChar(c);
+    DCHECK_EQ('\\', c0_);
   }
 
   while (c0_ != quote && c0_ >= 0
@@ -80,6 +80,14 @@ class Utf16CharacterStream {
   // Must not be used right after calling SeekForward.
   virtual void PushBack(int32_t code_unit) = 0;
 
+  // Returns the code units that have been buffered but not yet returned
+  // by Advance(). The result is only valid until the stream is advanced.
+  // Skipping over a prefix of it with SeekForward is cheap.
+  inline Vector<const uint16_t> BufferedCodeUnits() const {
+    return Vector<const uint16_t>(
+        buffer_cursor_, static_cast<int>(buffer_end_ - buffer_cursor_));
+  }
+
   virtual bool SetBookmark();
   virtual void ResetToBookmark();
 
@@ -182,6 +190,17 @@ class LiteralBuffer {
     }
   }
 
+  // Adds |length| code units that are all known to be one-byte.
+  void AddOneByteChars(const uint16_t* chars, int length) {
+    if (!is_one_byte_) {
+      for (int i = 0; i < length; i++) AddChar(chars[i]);
+      return;
+    }
+    while (position_ + length > backing_store_.length()) ExpandBuffer();
+    CopyChars(&backing_store_[position_], chars, length);
+    position_ += length;
+  }
+
   bool is_one_byte() const { return is_one_byte_; }
 
   bool is_contextual_keyword(Vector<const char> keyword) const {
@@ -576,6 +595,14 @@ class Scanner {
     if (check_surrogate) HandleLeadSurrogate();
   }
 
+  // Advances until c0_ is accepted by |Matcher| or is the end of input.
+  // The code units in between are looked at directly in the buffer of the
+  // source stream, a machine word at a time where possible. If
+  // |capture_literal| is true, they are added to the current literal, in
+  // which case |Matcher| has to accept every code unit beyond one-byte.
+  template <typename Matcher, bool capture_literal>
+  void AdvanceUntil();
+
   void HandleLeadSurrogate() {
     if (unibrow::Utf16::IsLeadSurrogate(c0_)) {
       uc32 c1 = source_->Advance();
@@ -56,7 +56,13 @@ struct PerfJitHeader {
 };
 
 struct PerfJitBase {
-  enum PerfJitEvent { kLoad = 0, kMove = 1, kDebugInfo = 2, kClose = 3 };
+  enum PerfJitEvent {
+    kLoad = 0,
+    kMove = 1,
+    kDebugInfo = 2,
+    kClose = 3,
+    kUnwindingInfo = 4
+  };
 
   uint32_t event_;
   uint32_t size_;
@@ -72,6 +78,16 @@ struct PerfJitCodeLoad : PerfJitBase {
   uint64_t code_id_;
 };
 
+struct PerfJitCodeMove : PerfJitBase {
+  uint32_t process_id_;
+  uint32_t thread_id_;
+  uint64_t vma_;
+  uint64_t old_code_address_;
+  uint64_t new_code_address_;
+  uint64_t code_size_;
+  uint64_t code_id_;
+};
+
 struct PerfJitDebugEntry {
   uint64_t address_;
   int line_number_;
@@ -85,6 +101,142 @@ struct PerfJitCodeDebugInfo : PerfJitBase {
   // Followed by entry_count_ instances of PerfJitDebugEntry.
 };
 
+struct PerfJitCodeUnwindingInfo : PerfJitBase {
+  uint64_t unwinding_size_;
+  uint64_t eh_frame_hdr_size_;
+  uint64_t mapped_size_;
+  // Followed by unwinding_size_ bytes of .eh_frame and .eh_frame_hdr.
+};
+
+namespace {
+
+// DWARF call frame instructions and pointer encodings.
+const uint8_t kDwarfCfaDefCfa = 0x0c;
+const uint8_t kDwarfCfaOffset = 0x80;  // The register is in the low bits.
+const uint8_t kDwarfPeUdata4 = 0x03;
+const uint8_t kDwarfPeSdata4 = 0x0b;
+const uint8_t kDwarfPePcRel = 0x10;
+const uint8_t kDwarfPeDataRel = 0x30;
+
+// DWARF numbers of the frame pointer and the return address registers.
+#if V8_TARGET_ARCH_X64
+const int kDwarfFramePointer = 6;
+const int kDwarfReturnAddress = 16;
+#elif V8_TARGET_ARCH_IA32
+const int kDwarfFramePointer = 5;
+const int kDwarfReturnAddress = 8;
+#elif V8_TARGET_ARCH_ARM
+const int kDwarfFramePointer = 11;
+const int kDwarfReturnAddress = 14;
+#elif V8_TARGET_ARCH_MIPS
+const int kDwarfFramePointer = 30;
+const int kDwarfReturnAddress = 31;
+#else
+#define V8_PERF_JIT_NO_UNWINDING_INFO
+#endif
+
+const int kEhFrameHdrSize = 20;
+
+class EhFrameBuffer {
+ public:
+  int size() const { return static_cast<int>(bytes_.size()); }
+  const uint8_t* data() const { return bytes_.data(); }
+
+  void Write8(uint8_t value) { bytes_.push_back(value); }
+  void Write32(int32_t value) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    bytes_.insert(bytes_.end(), bytes, bytes + sizeof(value));
+  }
+  void WriteULeb128(uint32_t value) {
+    do {
+      uint8_t chunk = value & 0x7f;
+      value >>= 7;
+      Write8(value == 0 ? chunk : (chunk | 0x80));
+    } while (value != 0);
+  }
+  void WriteSLeb128(int32_t value) {
+    bool done;
+    do {
+      uint8_t chunk = value & 0x7f;
+      value >>= 7;
+      done = (value == 0 && (chunk & 0x40) == 0) ||
+             (value == -1 && (chunk & 0x40) != 0);
+      Write8(done ? chunk : (chunk | 0x80));
+    } while (!done);
+  }
+
+  // Pads the CIE or FDE starting at {start} with DW_CFA_nop and fills in
+  // its length.
+  void FinishEntry(int start) {
+    while ((size() - start) % kPointerSize != 0) Write8(0);
+    int32_t length = size() - start - kInt32Size;
+    memcpy(&bytes_[start], &length, sizeof(length));
+  }
+
+ private:
+  std::vector<uint8_t> bytes_;
+};
+
+// Writes the .eh_frame and .eh_frame_hdr sections for code of {code_size}
+// bytes. perf puts them into the ELF image it creates for the code, after
+// the code aligned to 8 bytes, which the pc-relative offsets are based on.
+//
+// Generated code does not come with unwinding info of its own, so every
+// instruction is described as if a standard frame had been built: callers
+// can be found through the frame pointer. That is right for all of the
+// code but the frame setup and teardown and the stubs without a frame.
+void WriteEhFrame(EhFrameBuffer* buffer, uint32_t code_size) {
+#ifndef V8_PERF_JIT_NO_UNWINDING_INFO
+  int32_t code_offset = -RoundUp(static_cast<int32_t>(code_size), 8);
+
+  int cie_start = buffer->size();
+  buffer->Write32(0);  // Length.
+  buffer->Write32(0);  // CIE id.
+  buffer->Write8(1);   // Version.
+  buffer->Write8('z');
+  buffer->Write8('R');
+  buffer->Write8(0);
+  buffer->WriteULeb128(1);  // Code alignment factor.
+  buffer->WriteSLeb128(-kPointerSize);  // Data alignment factor.
+  buffer->WriteULeb128(kDwarfReturnAddress);
+  buffer->WriteULeb128(1);  // Augmentation data length.
+  buffer->Write8(kDwarfPePcRel | kDwarfPeSdata4);
+  // CFA = fp + 2 * kPointerSize, the return address and the caller's fp are
+  // saved right below it.
+  buffer->Write8(kDwarfCfaDefCfa);
+  buffer->WriteULeb128(kDwarfFramePointer);
+  buffer->WriteULeb128(2 * kPointerSize);
+  buffer->Write8(kDwarfCfaOffset | kDwarfReturnAddress);
+  buffer->WriteULeb128(1);
+  buffer->Write8(kDwarfCfaOffset | kDwarfFramePointer);
+  buffer->WriteULeb128(2);
+  buffer->FinishEntry(cie_start);
+
+  int fde_start = buffer->size();
+  buffer->Write32(0);  // Length.
+  buffer->Write32(buffer->size() - cie_start);  // CIE pointer.
+  buffer->Write32(code_offset - buffer->size());  // Initial location.
+  buffer->Write32(static_cast<int32_t>(code_size));  // Address range.
+  buffer->WriteULeb128(0);  // Augmentation data length.
+  buffer->FinishEntry(fde_start);
+
+  buffer->Write32(0);  // Terminator.
+  int eh_frame_size = buffer->size();
+
+  buffer->Write8(1);  // Version.
+  buffer->Write8(kDwarfPePcRel | kDwarfPeSdata4);
+  buffer->Write8(kDwarfPeUdata4);
+  buffer->Write8(kDwarfPeDataRel | kDwarfPeSdata4);
+  buffer->Write32(-buffer->size());  // .eh_frame start.
+  buffer->Write32(1);  // FDE count.
+  buffer->Write32(code_offset - eh_frame_size);
+  buffer->Write32(fde_start - eh_frame_size);
+  DCHECK_EQ(kEhFrameHdrSize, buffer->size() - eh_frame_size);
+#endif  // V8_PERF_JIT_NO_UNWINDING_INFO
+}
+
+}  // namespace
+
 const char PerfJitLogger::kFilenameFormatString[] = "./jit-%d.dump";
 
 // Extra padding for the PID in the filename
@@ -96,6 +248,8 @@ uint64_t PerfJitLogger::reference_count_ = 0;
 void* PerfJitLogger::marker_address_ = nullptr;
 uint64_t PerfJitLogger::code_index_ = 0;
 FILE* PerfJitLogger::perf_output_handle_ = nullptr;
+std::map<Address, PerfJitLogger::LoggedCode>* PerfJitLogger::logged_code_ =
+    nullptr;
 
 void PerfJitLogger::OpenJitDumpFile() {
   // Open the perf JIT dump file.
@@ -150,6 +304,7 @@ PerfJitLogger::PerfJitLogger() {
   reference_count_++;
   // If this is the first logger, open the file and write the header.
   if (reference_count_ == 1) {
+    logged_code_ = new std::map<Address, LoggedCode>();
     OpenJitDumpFile();
     if (perf_output_handle_ == nullptr) return;
     LogWriteHeader();
@@ -163,6 +318,8 @@ PerfJitLogger::~PerfJitLogger() {
   // If this was the last logger, close the file.
   if (reference_count_ == 0) {
     CloseJitDumpFile();
+    delete logged_code_;
+    logged_code_ = nullptr;
   }
 }
 
@@ -204,6 +361,11 @@ void PerfJitLogger::LogRecordedBuffer(AbstractCode* abstract_code,
   uint32_t code_size = code->is_crankshafted() ? code->safepoint_table_offset()
                                                : code->instruction_size();
 
+  // Unwinding info applies to the code load that follows it.
+  if (FLAG_perf_prof_unwinding_info) {
+    LogWriteUnwindingInfo(code_size);
+  }
+
   static const char string_terminator[] = "\0";
 
   PerfJitCodeLoad code_load;
@@ -218,6 +380,7 @@ void PerfJitLogger::LogRecordedBuffer(AbstractCode* abstract_code,
   code_load.code_size_ = code_size;
   code_load.code_id_ = code_index_;
 
+  (*logged_code_)[code->instruction_start()] = {code_index_, code_size};
   code_index_++;
 
   LogWriteBytes(reinterpret_cast<const char*>(&code_load), sizeof(code_load));
@@ -303,9 +466,62 @@ void PerfJitLogger::LogWriteDebugInfo(Code* code, SharedFunctionInfo* shared) {
   LogWriteBytes(padding_bytes, padding);
 }
 
+void PerfJitLogger::LogWriteUnwindingInfo(uint32_t code_size) {
+  EhFrameBuffer eh_frame;
+  WriteEhFrame(&eh_frame, code_size);
+  if (eh_frame.size() == 0) return;
+
+  PerfJitCodeUnwindingInfo unwinding_info;
+  unwinding_info.event_ = PerfJitCodeLoad::kUnwindingInfo;
+  unwinding_info.time_stamp_ = GetTimestamp();
+  unwinding_info.unwinding_size_ = eh_frame.size();
+  unwinding_info.eh_frame_hdr_size_ = kEhFrameHdrSize;
+  // The unwinding info is not part of the code in memory.
+  unwinding_info.mapped_size_ = 0;
+
+  uint32_t size = sizeof(unwinding_info) + eh_frame.size();
+  int padding = ((size + 7) & (~7)) - size;
+  unwinding_info.size_ = size + padding;
+
+  LogWriteBytes(reinterpret_cast<const char*>(&unwinding_info),
+                sizeof(unwinding_info));
+  LogWriteBytes(reinterpret_cast<const char*>(eh_frame.data()),
+                eh_frame.size());
+  char padding_bytes[] = "\0\0\0\0\0\0\0\0";
+  LogWriteBytes(padding_bytes, padding);
+}
+
 void PerfJitLogger::CodeMoveEvent(AbstractCode* from, Address to) {
-  // Code relocation not supported.
-  UNREACHABLE();
+  // Bytecode arrays are not logged, see LogRecordedBuffer.
+  if (!from->IsCode()) return;
+
+  base::LockGuard<base::RecursiveMutex> guard_file(file_mutex_.Pointer());
+
+  if (perf_output_handle_ == nullptr) return;
+
+  Address old_code_address = from->GetCode()->instruction_start();
+  auto logged = logged_code_->find(old_code_address);
+  // The code might have been filtered out when it was created.
+  if (logged == logged_code_->end()) return;
+  LoggedCode logged_code = logged->second;
+  logged_code_->erase(logged);
+  Address new_code_address = to + Code::kHeaderSize;
+  (*logged_code_)[new_code_address] = logged_code;
+
+  PerfJitCodeMove code_move;
+  code_move.event_ = PerfJitCodeLoad::kMove;
+  code_move.size_ = sizeof(code_move);
+  code_move.time_stamp_ = GetTimestamp();
+  code_move.process_id_ =
+      static_cast<uint32_t>(base::OS::GetCurrentProcessId());
+  code_move.thread_id_ = static_cast<uint32_t>(base::OS::GetCurrentThreadId());
+  code_move.vma_ = 0x0;  //  Our addresses are absolute.
+  code_move.old_code_address_ = reinterpret_cast<uint64_t>(old_code_address);
+  code_move.new_code_address_ = reinterpret_cast<uint64_t>(new_code_address);
+  code_move.code_size_ = logged_code.code_size;
+  code_move.code_id_ = logged_code.code_id;
+
+  LogWriteBytes(reinterpret_cast<const char*>(&code_move), sizeof(code_move));
 }
 
 void PerfJitLogger::LogWriteBytes(const char* bytes, int size) {
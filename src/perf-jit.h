@@ -28,6 +28,8 @@
 #ifndef V8_PERF_JIT_H_
 #define V8_PERF_JIT_H_
 
+#include <map>
+
 #include "src/log.h"
 
 namespace v8 {
@@ -66,6 +68,7 @@ class PerfJitLogger : public CodeEventLogger {
   void LogWriteBytes(const char* bytes, int size);
   void LogWriteHeader();
   void LogWriteDebugInfo(Code* code, SharedFunctionInfo* shared);
+  void LogWriteUnwindingInfo(uint32_t code_size);
 
   static const uint32_t kElfMachIA32 = 3;
   static const uint32_t kElfMachX64 = 62;
@@ -94,6 +97,13 @@ class PerfJitLogger : public CodeEventLogger {
   static uint64_t reference_count_;
   static void* marker_address_;
   static uint64_t code_index_;
+
+  struct LoggedCode {
+    uint64_t code_id;
+    uint64_t code_size;
+  };
+  // Logged code by instruction start, to log the moves of the code.
+  static std::map<Address, LoggedCode>* logged_code_;
 };
 
 #else
@@ -10,6 +10,7 @@
 #include "src/locked-queue-inl.h"
 #include "src/log-inl.h"
 #include "src/profiler/cpu-profiler-inl.h"
+#include "src/profiler/output-stream-writer.h"
 #include "src/vm-state-inl.h"
 
 #include "include/v8-profiler.h"
@@ -20,6 +21,93 @@ namespace internal {
 static const int kProfilerStackSize = 64 * KB;
 
 
+ContinuousProfileStreamer::ContinuousProfileStreamer(
+    CpuProfilesCollection* profiles, v8::OutputStream* stream,
+    base::TimeDelta interval)
+    : profiles_(profiles),
+      stream_(stream),
+      interval_(interval),
+      next_profile_time_(base::TimeTicks::HighResolutionNow() + interval) {}
+
+
+void ContinuousProfileStreamer::MaybeStreamProfile(base::TimeTicks now) {
+  if (now < next_profile_time_) return;
+  next_profile_time_ = now + interval_;
+  CpuProfile* profile = profiles_->RestartContinuousProfile();
+  WriteProfile(profile);
+  delete profile;
+}
+
+
+void ContinuousProfileStreamer::StreamLastProfile() {
+  CpuProfile* profile = profiles_->StopContinuousProfile();
+  WriteProfile(profile);
+  delete profile;
+}
+
+
+void ContinuousProfileStreamer::WriteProfile(CpuProfile* profile) {
+  OutputStreamWriter writer(stream_);
+  writer.AddString("{\"startTime\":");
+  writer.AddUint64(static_cast<uint64_t>(
+      (profile->start_time() - base::TimeTicks()).InMicroseconds()));
+  writer.AddString(",\"endTime\":");
+  writer.AddUint64(static_cast<uint64_t>(
+      (profile->end_time() - base::TimeTicks()).InMicroseconds()));
+
+  // id, parent id, function name, resource name, line, column, hit count.
+  std::map<const char*, unsigned> string_ids;
+  std::vector<const char*> strings;
+  std::vector<std::pair<const ProfileNode*, unsigned>> stack;
+  stack.push_back(std::make_pair(profile->top_down()->root(), 0u));
+  writer.AddString(",\"nodes\":[");
+  bool first_node = true;
+  while (!stack.empty() && !writer.aborted()) {
+    const ProfileNode* node = stack.back().first;
+    unsigned parent_id = stack.back().second;
+    stack.pop_back();
+    const char* names[] = {node->entry()->name(),
+                           node->entry()->resource_name()};
+    unsigned name_ids[arraysize(names)];
+    for (size_t i = 0; i < arraysize(names); i++) {
+      auto it = string_ids.find(names[i]);
+      if (it == string_ids.end()) {
+        unsigned id = static_cast<unsigned>(strings.size());
+        it = string_ids.insert(std::make_pair(names[i], id)).first;
+        strings.push_back(names[i]);
+      }
+      name_ids[i] = it->second;
+    }
+    if (!first_node) writer.AddCharacter(',');
+    first_node = false;
+    writer.AddNumber(node->id());
+    writer.AddCharacter(',');
+    writer.AddNumber(parent_id);
+    for (size_t i = 0; i < arraysize(name_ids); i++) {
+      writer.AddCharacter(',');
+      writer.AddNumber(name_ids[i]);
+    }
+    writer.AddCharacter(',');
+    writer.AddNumber(static_cast<unsigned>(node->entry()->line_number()));
+    writer.AddCharacter(',');
+    writer.AddNumber(static_cast<unsigned>(node->entry()->column_number()));
+    writer.AddCharacter(',');
+    writer.AddNumber(node->self_ticks());
+    const List<ProfileNode*>* children = node->children();
+    for (int i = children->length() - 1; i >= 0; i--) {
+      stack.push_back(std::make_pair(children->at(i), node->id()));
+    }
+  }
+  writer.AddString("],\"strings\":[");
+  for (size_t i = 0; i < strings.size() && !writer.aborted(); i++) {
+    if (i > 0) writer.AddCharacter(',');
+    writer.AddJSONString(reinterpret_cast<const unsigned char*>(strings[i]));
+  }
+  writer.AddString("]}");
+  writer.Finalize();
+}
+
+
 ProfilerEventsProcessor::ProfilerEventsProcessor(ProfileGenerator* generator,
                                                  Sampler* sampler,
                                                  base::TimeDelta period)
@@ -29,7 +117,8 @@ ProfilerEventsProcessor::ProfilerEventsProcessor(ProfileGenerator* generator,
       running_(1),
       period_(period),
       last_code_event_id_(0),
-      last_processed_code_event_id_(0) {}
+      last_processed_code_event_id_(0),
+      streamer_(NULL) {}
 
 
 ProfilerEventsProcessor::~ProfilerEventsProcessor() {}
@@ -69,6 +158,13 @@ void ProfilerEventsProcessor::AddCurrentStack(Isolate* isolate,
 }
 
 
+void ProfilerEventsProcessor::SetContinuousProfileStreamer(
+    ContinuousProfileStreamer* streamer) {
+  base::LockGuard<base::Mutex> guard(&streamer_mutex_);
+  streamer_ = streamer;
+}
+
+
 void ProfilerEventsProcessor::StopSynchronously() {
   if (!base::NoBarrier_AtomicExchange(&running_, 0)) return;
   Join();
@@ -138,10 +234,24 @@ void ProfilerEventsProcessor::Run() {
       now = base::TimeTicks::HighResolutionNow();
     } while (result != NoSamplesInQueue && now < nextSampleTime);
 
+    {
+      base::LockGuard<base::Mutex> guard(&streamer_mutex_);
+      if (streamer_ != NULL) {
+        streamer_->MaybeStreamProfile(now);
+        now = base::TimeTicks::HighResolutionNow();
+      }
+    }
+
     if (nextSampleTime > now) {
 #if V8_OS_WIN
-      // Do not use Sleep on Windows as it is very imprecise.
-      // Could be up to 16ms jitter, which is unacceptable for the purpose.
+      // Sleep on Windows is very imprecise. It could be up to 16ms jitter,
+      // which is unacceptable for the purpose, so only sleep for the part of
+      // long periods that exceeds the jitter and spin for the rest.
+      const base::TimeDelta kMaxSleepJitter =
+          base::TimeDelta::FromMilliseconds(16);
+      if (nextSampleTime - now > kMaxSleepJitter) {
+        base::OS::Sleep(nextSampleTime - now - kMaxSleepJitter);
+      }
       while (base::TimeTicks::HighResolutionNow() < nextSampleTime) {
       }
 #else
@@ -150,7 +260,7 @@ void ProfilerEventsProcessor::Run() {
     }
 
     // Schedule next sample. sampler_ is NULL in tests.
-    if (sampler_) sampler_->DoSample();
+    if (sampler_ && !sampler_->HasThreadTimer()) sampler_->DoSample();
   }
 
   // Process remaining tick events.
@@ -185,6 +295,7 @@ CpuProfile* CpuProfiler::GetProfile(int index) {
 
 
 void CpuProfiler::DeleteAllProfiles() {
+  StopContinuousProfiling();
   if (is_profiling_) StopProcessor();
   ResetProfiles();
 }
@@ -285,7 +396,8 @@ void CpuProfiler::CodeCreateEvent(Logger::LogEventsAndTags tag,
         // script. So the proper fix is to store script_id in some form
         // along with the inlined function positions.
         if (position < start_position || position >= end_position) continue;
-        int pc_offset = static_cast<int>(reloc_info->pc() - code->address());
+        int pc_offset =
+            static_cast<int>(reloc_info->pc() - code->instruction_start());
         int line_number = script->GetLineNumber(position) + 1;
         line_table->SetPosition(pc_offset, line_number);
       }
@@ -296,8 +408,7 @@ void CpuProfiler::CodeCreateEvent(Logger::LogEventsAndTags tag,
           bytecode->source_position_table());
       for (; !it.done(); it.Advance()) {
         int line_number = script->GetLineNumber(it.source_position()) + 1;
-        int pc_offset = it.bytecode_offset() + BytecodeArray::kHeaderSize;
-        line_table->SetPosition(pc_offset, line_number);
+        line_table->SetPosition(it.bytecode_offset(), line_number);
       }
     }
   }
@@ -457,6 +568,7 @@ CpuProfiler::CpuProfiler(Isolate* isolate)
       profiles_(new CpuProfilesCollection(isolate->heap())),
       generator_(NULL),
       processor_(NULL),
+      streamer_(NULL),
       is_profiling_(false) {
 }
 
@@ -471,12 +583,14 @@ CpuProfiler::CpuProfiler(Isolate* isolate,
       profiles_(test_profiles),
       generator_(test_generator),
       processor_(test_processor),
+      streamer_(NULL),
       is_profiling_(false) {
 }
 
 
 CpuProfiler::~CpuProfiler() {
   DCHECK(!is_profiling_);
+  DCHECK_NULL(streamer_);
   delete profiles_;
 }
 
@@ -500,7 +614,7 @@ void CpuProfiler::CollectSample() {
 
 void CpuProfiler::StartProfiling(const char* title, bool record_samples) {
   if (profiles_->StartProfiling(title, record_samples)) {
-    StartProcessorIfNotStarted();
+    StartProcessorIfNotStarted(sampling_interval_);
   }
 }
 
@@ -511,7 +625,31 @@ void CpuProfiler::StartProfiling(String* title, bool record_samples) {
 }
 
 
-void CpuProfiler::StartProcessorIfNotStarted() {
+void CpuProfiler::StartContinuousProfiling(v8::OutputStream* stream,
+                                           base::TimeDelta interval) {
+  if (streamer_ != NULL) return;
+  profiles_->StartContinuousProfile();
+  streamer_ = new ContinuousProfileStreamer(profiles_, stream, interval);
+  StartProcessorIfNotStarted(
+      Max(sampling_interval_,
+          base::TimeDelta::FromMilliseconds(kContinuousSamplingIntervalMs)));
+  processor_->SetContinuousProfileStreamer(streamer_);
+}
+
+
+void CpuProfiler::StopContinuousProfiling() {
+  if (streamer_ == NULL) return;
+  processor_->SetContinuousProfileStreamer(NULL);
+  // Stopping the processor first flushes the remaining samples into the
+  // profile of the last interval.
+  if (!profiles_->has_current_profiles()) StopProcessor();
+  streamer_->StreamLastProfile();
+  delete streamer_;
+  streamer_ = NULL;
+}
+
+
+void CpuProfiler::StartProcessorIfNotStarted(base::TimeDelta period) {
   if (processor_ != NULL) {
     processor_->AddCurrentStack(isolate_);
     return;
@@ -522,8 +660,7 @@ void CpuProfiler::StartProcessorIfNotStarted() {
   logger->is_logging_ = false;
   generator_ = new ProfileGenerator(profiles_);
   Sampler* sampler = logger->sampler();
-  processor_ = new ProfilerEventsProcessor(
-      generator_, sampler, sampling_interval_);
+  processor_ = new ProfilerEventsProcessor(generator_, sampler, period);
   is_profiling_ = true;
   // Enumerate stuff we already have in the heap.
   DCHECK(isolate_->heap()->HasBeenSetUp());
@@ -536,6 +673,7 @@ void CpuProfiler::StartProcessorIfNotStarted() {
   // Enable stack sampling.
   sampler->SetHasProcessingThread(true);
   sampler->IncreaseProfilingDepth();
+  if (FLAG_sampling_thread_timer) sampler->StartThreadTimer(period);
   processor_->AddCurrentStack(isolate_);
   processor_->StartSynchronously();
 }
@@ -569,6 +707,7 @@ void CpuProfiler::StopProcessor() {
   Logger* logger = isolate_->logger();
   Sampler* sampler = reinterpret_cast<Sampler*>(logger->ticker_);
   is_profiling_ = false;
+  sampler->StopThreadTimer();
   processor_->StopSynchronously();
   delete processor_;
   delete generator_;
@@ -8,6 +8,7 @@
 #include "src/allocation.h"
 #include "src/atomic-utils.h"
 #include "src/base/atomicops.h"
+#include "src/base/platform/mutex.h"
 #include "src/base/platform/time.h"
 #include "src/compiler.h"
 #include "src/locked-queue.h"
@@ -123,6 +124,34 @@ class CodeEventsContainer {
 };
 
 
+// Streams the profile of a continuous profiling session to the embedder.
+// Every interval, the continuous profile is restarted, and the profile of
+// the past interval is serialized and deleted right away, so memory use does
+// not grow with the length of the session. See
+// v8::CpuProfiler::StartContinuousProfiling for the format.
+class ContinuousProfileStreamer {
+ public:
+  ContinuousProfileStreamer(CpuProfilesCollection* profiles,
+                            v8::OutputStream* stream,
+                            base::TimeDelta interval);
+
+  // Called from events processing thread.
+  void MaybeStreamProfile(base::TimeTicks now);
+  // Called from VM thread when the session ends.
+  void StreamLastProfile();
+
+ private:
+  void WriteProfile(CpuProfile* profile);
+
+  CpuProfilesCollection* profiles_;
+  v8::OutputStream* stream_;
+  const base::TimeDelta interval_;
+  base::TimeTicks next_profile_time_;
+
+  DISALLOW_COPY_AND_ASSIGN(ContinuousProfileStreamer);
+};
+
+
 // This class implements both the profile events processor thread and
 // methods called by event producers: VM and stack sampler threads.
 class ProfilerEventsProcessor : public base::Thread {
@@ -142,6 +171,10 @@ class ProfilerEventsProcessor : public base::Thread {
   void AddCurrentStack(Isolate* isolate, bool update_stats = false);
   void AddDeoptStack(Isolate* isolate, Address from, int fp_to_sp_delta);
 
+  // Attaches the streamer of a continuous profile. Passing NULL detaches
+  // it; the events processing thread does not use it after that.
+  void SetContinuousProfileStreamer(ContinuousProfileStreamer* streamer);
+
   // Tick sample events are filled directly in the buffer of the circular
   // queue (because the structure is of fixed width, but usually not all
   // stack frame entries are filled.) This method returns a pointer to the
@@ -178,6 +211,8 @@ class ProfilerEventsProcessor : public base::Thread {
   LockedQueue<TickSampleEventRecord> ticks_from_vm_buffer_;
   AtomicNumber<unsigned> last_code_event_id_;
   unsigned last_processed_code_event_id_;
+  base::Mutex streamer_mutex_;
+  ContinuousProfileStreamer* streamer_;
 };
 
 
@@ -214,6 +249,15 @@ class CpuProfiler : public CodeEventListener {
   void DeleteAllProfiles();
   void DeleteProfile(CpuProfile* profile);
 
+  // Continuous profiling samples every kContinuousSamplingIntervalMs or at
+  // the sampling interval, whichever is longer, unless the processor has
+  // already been started for a regular profile.
+  void StartContinuousProfiling(v8::OutputStream* stream,
+                                base::TimeDelta interval);
+  void StopContinuousProfiling();
+
+  static const int kContinuousSamplingIntervalMs = 10;
+
   // Invoked from stack sampler (thread or signal handler.)
   inline TickSample* StartTickSample();
   inline void FinishTickSample();
@@ -252,7 +296,7 @@ class CpuProfiler : public CodeEventListener {
   Isolate* isolate() const { return isolate_; }
 
  private:
-  void StartProcessorIfNotStarted();
+  void StartProcessorIfNotStarted(base::TimeDelta period);
   void StopProcessorIfLastProfile(const char* title);
   void StopProcessor();
   void ResetProfiles();
@@ -265,6 +309,7 @@ class CpuProfiler : public CodeEventListener {
   CpuProfilesCollection* profiles_;
   ProfileGenerator* generator_;
   ProfilerEventsProcessor* processor_;
+  ContinuousProfileStreamer* streamer_;
   bool saved_is_logging_;
   bool is_profiling_;
 
@@ -0,0 +1,173 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_PROFILER_OUTPUT_STREAM_WRITER_H_
+#define V8_PROFILER_OUTPUT_STREAM_WRITER_H_
+
+#include "include/v8-profiler.h"
+#include "src/unicode.h"
+#include "src/utils.h"
+
+namespace v8 {
+namespace internal {
+
+template<int bytes> struct MaxDecimalDigitsIn;
+template<> struct MaxDecimalDigitsIn<4> {
+  static const int kSigned = 11;
+  static const int kUnsigned = 10;
+};
+template<> struct MaxDecimalDigitsIn<8> {
+  static const int kSigned = 20;
+  static const int kUnsigned = 20;
+};
+
+
+// Buffers the output of the JSON serializers of the profilers and writes it
+// to a v8::OutputStream in chunks of the size preferred by the stream.
+class OutputStreamWriter {
+ public:
+  explicit OutputStreamWriter(v8::OutputStream* stream)
+      : stream_(stream),
+        chunk_size_(stream->GetChunkSize()),
+        chunk_(chunk_size_),
+        chunk_pos_(0),
+        aborted_(false) {
+    DCHECK(chunk_size_ > 0);
+  }
+  bool aborted() { return aborted_; }
+  void AddCharacter(char c) {
+    DCHECK(c != '\0');
+    DCHECK(chunk_pos_ < chunk_size_);
+    chunk_[chunk_pos_++] = c;
+    MaybeWriteChunk();
+  }
+  void AddString(const char* s) {
+    AddSubstring(s, StrLength(s));
+  }
+  void AddSubstring(const char* s, int n) {
+    if (n <= 0) return;
+    DCHECK(static_cast<size_t>(n) <= strlen(s));
+    const char* s_end = s + n;
+    while (s < s_end) {
+      int s_chunk_size =
+          Min(chunk_size_ - chunk_pos_, static_cast<int>(s_end - s));
+      DCHECK(s_chunk_size > 0);
+      MemCopy(chunk_.start() + chunk_pos_, s, s_chunk_size);
+      s += s_chunk_size;
+      chunk_pos_ += s_chunk_size;
+      MaybeWriteChunk();
+    }
+  }
+  void AddNumber(unsigned n) { AddNumberImpl<unsigned>(n, "%u"); }
+  void AddUint64(uint64_t n) { AddNumberImpl<uint64_t>(n, "%" PRIu64); }
+  // Adds the UTF-8 string {s} as a quoted JSON string literal.
+  void AddJSONString(const unsigned char* s) {
+    AddCharacter('\"');
+    for ( ; *s != '\0'; ++s) {
+      switch (*s) {
+        case '\b':
+          AddString("\\b");
+          continue;
+        case '\f':
+          AddString("\\f");
+          continue;
+        case '\n':
+          AddString("\\n");
+          continue;
+        case '\r':
+          AddString("\\r");
+          continue;
+        case '\t':
+          AddString("\\t");
+          continue;
+        case '\"':
+        case '\\':
+          AddCharacter('\\');
+          AddCharacter(*s);
+          continue;
+        default:
+          if (*s > 31 && *s < 128) {
+            AddCharacter(*s);
+          } else if (*s <= 31) {
+            // Special character with no dedicated literal.
+            AddUChar(*s);
+          } else {
+            // Convert UTF-8 into \u UTF-16 literal.
+            size_t length = 1, cursor = 0;
+            for ( ; length <= 4 && *(s + length) != '\0'; ++length) { }
+            unibrow::uchar c =
+                unibrow::Utf8::CalculateValue(s, length, &cursor);
+            if (c != unibrow::Utf8::kBadChar) {
+              AddUChar(c);
+              DCHECK(cursor != 0);
+              s += cursor - 1;
+            } else {
+              AddCharacter('?');
+            }
+          }
+      }
+    }
+    AddCharacter('\"');
+  }
+  void Finalize() {
+    if (aborted_) return;
+    DCHECK(chunk_pos_ < chunk_size_);
+    if (chunk_pos_ != 0) {
+      WriteChunk();
+    }
+    stream_->EndOfStream();
+  }
+
+ private:
+  template<typename T>
+  void AddNumberImpl(T n, const char* format) {
+    // Buffer for the longest value plus trailing \0
+    static const int kMaxNumberSize =
+        MaxDecimalDigitsIn<sizeof(T)>::kUnsigned + 1;
+    if (chunk_size_ - chunk_pos_ >= kMaxNumberSize) {
+      int result = SNPrintF(
+          chunk_.SubVector(chunk_pos_, chunk_size_), format, n);
+      DCHECK(result != -1);
+      chunk_pos_ += result;
+      MaybeWriteChunk();
+    } else {
+      EmbeddedVector<char, kMaxNumberSize> buffer;
+      int result = SNPrintF(buffer, format, n);
+      USE(result);
+      DCHECK(result != -1);
+      AddString(buffer.start());
+    }
+  }
+  void AddUChar(unibrow::uchar u) {
+    static const char hex_chars[] = "0123456789ABCDEF";
+    AddString("\\u");
+    AddCharacter(hex_chars[(u >> 12) & 0xf]);
+    AddCharacter(hex_chars[(u >> 8) & 0xf]);
+    AddCharacter(hex_chars[(u >> 4) & 0xf]);
+    AddCharacter(hex_chars[u & 0xf]);
+  }
+  void MaybeWriteChunk() {
+    DCHECK(chunk_pos_ <= chunk_size_);
+    if (chunk_pos_ == chunk_size_) {
+      WriteChunk();
+    }
+  }
+  void WriteChunk() {
+    if (aborted_) return;
+    if (stream_->WriteAsciiChunk(chunk_.start(), chunk_pos_) ==
+        v8::OutputStream::kAbort) aborted_ = true;
+    chunk_pos_ = 0;
+  }
+
+  v8::OutputStream* stream_;
+  int chunk_size_;
+  ScopedVector<char> chunk_;
+  int chunk_pos_;
+  bool aborted_;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_PROFILER_OUTPUT_STREAM_WRITER_H_
@@ -10,7 +10,6 @@
 #include "src/global-handles.h"
 #include "src/profiler/profile-generator-inl.h"
 #include "src/profiler/sampler.h"
-#include "src/splay-tree-inl.h"
 #include "src/unicode.h"
 
 namespace v8 {
@@ -33,11 +32,10 @@ void JITLineInfoTable::SetPosition(int pc_offset, int line) {
 
 
 int JITLineInfoTable::GetSourceLineNumber(int pc_offset) const {
-  PcOffsetMap::const_iterator it = pc_offset_map_.lower_bound(pc_offset);
-  if (it == pc_offset_map_.end()) {
-    if (pc_offset_map_.empty()) return v8::CpuProfileNode::kNoLineNumberInfo;
-    return (--pc_offset_map_.end())->second;
-  }
+  if (pc_offset_map_.empty()) return v8::CpuProfileNode::kNoLineNumberInfo;
+  PcOffsetMap::const_iterator it = pc_offset_map_.upper_bound(pc_offset);
+  // Offsets before the first position belong to the first line.
+  if (it != pc_offset_map_.begin()) --it;
   return it->second;
 }
 
@@ -98,6 +96,19 @@ void CodeEntry::SetBuiltinId(Builtins::Name id) {
 }
 
 
+bool CodeEntry::IsInterpreterCode() const {
+  if (tag() == Logger::BYTECODE_HANDLER_TAG) return true;
+  switch (builtin_id()) {
+    case Builtins::kInterpreterEntryTrampoline:
+    case Builtins::kInterpreterExitTrampoline:
+    case Builtins::kInterpreterEnterBytecodeDispatch:
+      return true;
+    default:
+      return false;
+  }
+}
+
+
 int CodeEntry::GetSourceLine(int pc_offset) const {
   if (line_info_ && !line_info_->empty()) {
     return line_info_->GetSourceLineNumber(pc_offset);
@@ -395,69 +406,58 @@ void CpuProfile::Print() {
 CodeMap::~CodeMap() {}
 
 
-const CodeMap::CodeTreeConfig::Key CodeMap::CodeTreeConfig::kNoKey = NULL;
-
-
 void CodeMap::AddCode(Address addr, CodeEntry* entry, unsigned size) {
   DeleteAllCoveredCode(addr, addr + size);
-  CodeTree::Locator locator;
-  tree_.Insert(addr, &locator);
-  locator.set_value(CodeEntryInfo(entry, size));
+  // Empty code ranges are not covered by anything, replace them explicitly.
+  code_map_.erase(addr);
+  code_map_.insert(std::make_pair(addr, CodeEntryInfo(entry, size)));
 }
 
 
 void CodeMap::DeleteAllCoveredCode(Address start, Address end) {
-  List<Address> to_delete;
-  Address addr = end - 1;
-  while (addr >= start) {
-    CodeTree::Locator locator;
-    if (!tree_.FindGreatestLessThan(addr, &locator)) break;
-    Address start2 = locator.key(), end2 = start2 + locator.value().size;
-    if (start2 < end && start < end2) to_delete.Add(start2);
-    addr = start2 - 1;
+  auto left = code_map_.upper_bound(start);
+  if (left != code_map_.begin()) {
+    --left;
+    if (left->first + left->second.size <= start) ++left;
   }
-  for (int i = 0; i < to_delete.length(); ++i) tree_.Remove(to_delete[i]);
+  auto right = left;
+  while (right != code_map_.end() && right->first < end) ++right;
+  code_map_.erase(left, right);
 }
 
 
 CodeEntry* CodeMap::FindEntry(Address addr) {
-  CodeTree::Locator locator;
-  if (tree_.FindGreatestLessThan(addr, &locator)) {
-    // locator.key() <= addr. Need to check that addr is within entry.
-    const CodeEntryInfo& entry = locator.value();
-    if (addr < (locator.key() + entry.size)) {
-      return entry.entry;
-    }
-  }
-  return NULL;
+  auto it = code_map_.upper_bound(addr);
+  if (it == code_map_.begin()) return NULL;
+  --it;
+  // it->first <= addr. Need to check that addr is within entry.
+  Address end = it->first + it->second.size;
+  return addr < end ? it->second.entry : NULL;
 }
 
 
 void CodeMap::MoveCode(Address from, Address to) {
   if (from == to) return;
-  CodeTree::Locator locator;
-  if (!tree_.Find(from, &locator)) return;
-  CodeEntryInfo entry = locator.value();
-  tree_.Remove(from);
-  AddCode(to, entry.entry, entry.size);
-}
-
-
-void CodeMap::CodeTreePrinter::Call(
-    const Address& key, const CodeMap::CodeEntryInfo& value) {
-  base::OS::Print("%p %5d %s\n", key, value.size, value.entry->name());
+  auto it = code_map_.find(from);
+  if (it == code_map_.end()) return;
+  CodeEntryInfo info = it->second;
+  code_map_.erase(it);
+  AddCode(to, info.entry, info.size);
 }
 
 
 void CodeMap::Print() {
-  CodeTreePrinter printer;
-  tree_.ForEach(&printer);
+  for (auto it = code_map_.begin(); it != code_map_.end(); ++it) {
+    base::OS::Print("%p %5d %s\n", static_cast<void*>(it->first),
+                    it->second.size, it->second.entry->name());
+  }
 }
 
 
 CpuProfilesCollection::CpuProfilesCollection(Heap* heap)
     : function_and_resource_names_(heap),
       isolate_(heap->isolate()),
+      continuous_profile_(NULL),
       current_profiles_semaphore_(1) {}
 
 
@@ -474,6 +474,7 @@ static void DeleteCpuProfile(CpuProfile** profile_ptr) {
 CpuProfilesCollection::~CpuProfilesCollection() {
   finished_profiles_.Iterate(DeleteCpuProfile);
   current_profiles_.Iterate(DeleteCpuProfile);
+  delete continuous_profile_;
   code_entries_.Iterate(DeleteCodeEntry);
 }
 
@@ -521,7 +522,9 @@ CpuProfile* CpuProfilesCollection::StopProfiling(const char* title) {
 bool CpuProfilesCollection::IsLastProfile(const char* title) {
   // Called from VM thread, and only it can mutate the list,
   // so no locking is needed here.
-  if (current_profiles_.length() != 1) return false;
+  if (current_profiles_.length() != 1 || has_continuous_profile()) {
+    return false;
+  }
   return StrLength(title) == 0
       || strcmp(current_profiles_[0]->title(), title) == 0;
 }
@@ -538,6 +541,37 @@ void CpuProfilesCollection::RemoveProfile(CpuProfile* profile) {
   UNREACHABLE();
 }
 
+
+void CpuProfilesCollection::StartContinuousProfile() {
+  DCHECK(!has_continuous_profile());
+  CpuProfile* profile = new CpuProfile(isolate_, "", false);
+  current_profiles_semaphore_.Wait();
+  continuous_profile_ = profile;
+  current_profiles_semaphore_.Signal();
+}
+
+
+CpuProfile* CpuProfilesCollection::RestartContinuousProfile() {
+  // Called from profile generator thread. The new profile is allocated
+  // before taking the lock, so that samples are not held up by it.
+  CpuProfile* profile = new CpuProfile(isolate_, "", false);
+  current_profiles_semaphore_.Wait();
+  std::swap(profile, continuous_profile_);
+  current_profiles_semaphore_.Signal();
+  profile->CalculateTotalTicksAndSamplingRate();
+  return profile;
+}
+
+
+CpuProfile* CpuProfilesCollection::StopContinuousProfile() {
+  current_profiles_semaphore_.Wait();
+  CpuProfile* profile = continuous_profile_;
+  continuous_profile_ = NULL;
+  current_profiles_semaphore_.Signal();
+  if (profile != NULL) profile->CalculateTotalTicksAndSamplingRate();
+  return profile;
+}
+
 void CpuProfilesCollection::AddPathToCurrentProfiles(
     base::TimeTicks timestamp, const std::vector<CodeEntry*>& path,
     int src_line, bool update_stats) {
@@ -548,6 +582,9 @@ void CpuProfilesCollection::AddPathToCurrentProfiles(
   for (int i = 0; i < current_profiles_.length(); ++i) {
     current_profiles_[i]->AddPath(timestamp, path, src_line, update_stats);
   }
+  if (continuous_profile_ != NULL) {
+    continuous_profile_->AddPath(timestamp, path, src_line, update_stats);
+  }
   current_profiles_semaphore_.Signal();
 }
 
@@ -620,6 +657,13 @@ void ProfileGenerator::RecordTickSample(const TickSample& sample) {
                         sample.top_frame_type == StackFrame::OPTIMIZED)) {
         pc_entry = code_map_.FindEntry(sample.tos);
       }
+      // The bytecode array and offset of the interpreted frame identify the
+      // function and line that the interpreter is executing, so attribute
+      // the tick to that frame instead of to the interpreter itself.
+      if (pc_entry && sample.top_frame_type == StackFrame::INTERPRETED &&
+          pc_entry->IsInterpreterCode()) {
+        pc_entry = NULL;
+      }
       // If pc is in the function code before it set up stack frame or after the
       // frame was destroyed SafeStackFrameIterator incorrectly thinks that
       // ebp contains return address of the current function and skips caller's
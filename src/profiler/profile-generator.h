@@ -15,8 +15,9 @@
 namespace v8 {
 namespace internal {
 
-// Provides a mapping from the offsets within generated code to
-// the source line.
+// Provides a mapping from the offsets within generated code or bytecode,
+// relative to the instruction start, to the source line. An offset maps to
+// the line of the closest position at or before it.
 class JITLineInfoTable : public Malloced {
  public:
   JITLineInfoTable();
@@ -94,6 +95,10 @@ class CodeEntry {
     return BuiltinIdField::decode(bit_field_);
   }
 
+  // Bytecode handlers and interpreter builtins run on behalf of the
+  // function in the interpreted frame below them.
+  bool IsInterpreterCode() const;
+
   uint32_t GetHash() const;
   bool IsSameFunctionAs(CodeEntry* entry) const;
 
@@ -282,25 +287,11 @@ class CodeMap {
     unsigned size;
   };
 
-  struct CodeTreeConfig {
-    typedef Address Key;
-    typedef CodeEntryInfo Value;
-    static const Key kNoKey;
-    static const Value NoValue() { return CodeEntryInfo(NULL, 0); }
-    static int Compare(const Key& a, const Key& b) {
-      return a < b ? -1 : (a > b ? 1 : 0);
-    }
-  };
-  typedef SplayTree<CodeTreeConfig> CodeTree;
-
-  class CodeTreePrinter {
-   public:
-    void Call(const Address& key, const CodeEntryInfo& value);
-  };
-
   void DeleteAllCoveredCode(Address start, Address end);
 
-  CodeTree tree_;
+  // Code ranges keyed by their start address. Unlike a splay tree, lookups
+  // for tick samples do not restructure the map.
+  std::map<Address, CodeEntryInfo> code_map_;
 
   DISALLOW_COPY_AND_ASSIGN(CodeMap);
 };
@@ -327,8 +318,18 @@ class CpuProfilesCollection {
     return function_and_resource_names_.GetFunctionName(name);
   }
   bool IsLastProfile(const char* title);
+  bool has_current_profiles() const { return !current_profiles_.is_empty(); }
   void RemoveProfile(CpuProfile* profile);
 
+  // The continuous profile only holds the samples collected since it was
+  // started or last restarted. It is neither a current nor a finished
+  // profile, so at most one of it can exist at a time.
+  bool has_continuous_profile() const { return continuous_profile_ != NULL; }
+  void StartContinuousProfile();
+  // Replaces the continuous profile by an empty one and returns it.
+  CpuProfile* RestartContinuousProfile();
+  CpuProfile* StopContinuousProfile();
+
   CodeEntry* NewCodeEntry(
       Logger::LogEventsAndTags tag, const char* name,
       const char* name_prefix = CodeEntry::kEmptyNamePrefix,
@@ -354,6 +355,7 @@ class CpuProfilesCollection {
 
   // Accessed by VM thread and profile generator thread.
   List<CpuProfile*> current_profiles_;
+  CpuProfile* continuous_profile_;
   base::Semaphore current_profiles_semaphore_;
 
   DISALLOW_COPY_AND_ASSIGN(CpuProfilesCollection);
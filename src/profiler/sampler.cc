@@ -12,6 +12,7 @@
 #include <pthread.h>
 #include <signal.h>
 #include <sys/time.h>
+#include <time.h>
 
 #if !V8_OS_QNX && !V8_OS_NACL && !V8_OS_AIX
 #include <sys/syscall.h>  // NOLINT
@@ -289,11 +290,66 @@ uint32_t ThreadHash(pthread_t thread_id) {
 
 class Sampler::PlatformData : public PlatformDataCommon {
  public:
-  PlatformData() : vm_tid_(pthread_self()) {}
+  PlatformData() : vm_tid_(pthread_self()) {
+#if V8_OS_LINUX
+    vm_kernel_tid_ = base::OS::GetCurrentThreadId();
+    has_thread_timer_ = false;
+#endif
+  }
   pthread_t vm_tid() const { return vm_tid_; }
 
+#if V8_OS_LINUX
+  ~PlatformData() { DCHECK(!has_thread_timer_); }
+
+  // Creates a timer that sends SIGPROF to the sampled thread every
+  // {interval}. Has to be called on the sampled thread.
+  bool StartThreadTimer(base::TimeDelta interval) {
+    DCHECK(pthread_equal(vm_tid_, pthread_self()));
+    DCHECK(!has_thread_timer_);
+    if (interval <= base::TimeDelta()) return false;
+    struct sigevent event;
+    memset(&event, 0, sizeof(event));
+    event.sigev_notify = SIGEV_THREAD_ID;
+    event.sigev_signo = SIGPROF;
+    // Older C libraries do not name the field.
+#ifdef sigev_notify_thread_id
+    event.sigev_notify_thread_id = vm_kernel_tid_;
+#else
+    event._sigev_un._tid = vm_kernel_tid_;
+#endif
+    if (timer_create(CLOCK_MONOTONIC, &event, &thread_timer_) != 0) {
+      return false;
+    }
+    struct itimerspec timer_spec;
+    timer_spec.it_interval = interval.ToTimespec();
+    timer_spec.it_value = timer_spec.it_interval;
+    if (timer_settime(thread_timer_, 0, &timer_spec, NULL) != 0) {
+      timer_delete(thread_timer_);
+      return false;
+    }
+    has_thread_timer_ = true;
+    return true;
+  }
+
+  // Has to be called on the sampled thread as well, so that a signal which
+  // is still pending is delivered before the signal handler is restored.
+  void StopThreadTimer() {
+    DCHECK(pthread_equal(vm_tid_, pthread_self()));
+    if (!has_thread_timer_) return;
+    timer_delete(thread_timer_);
+    has_thread_timer_ = false;
+  }
+
+  bool has_thread_timer() const { return has_thread_timer_; }
+#endif  // V8_OS_LINUX
+
  private:
   pthread_t vm_tid_;
+#if V8_OS_LINUX
+  int vm_kernel_tid_;
+  timer_t thread_timer_;
+  bool has_thread_timer_;
+#endif
 };
 
 #elif V8_OS_WIN || V8_OS_CYGWIN
@@ -990,6 +1046,36 @@ void Sampler::DecreaseProfilingDepth() {
 }
 
 
+bool Sampler::StartThreadTimer(base::TimeDelta interval) {
+#if defined(USE_SIGNALS) && V8_OS_LINUX
+  if (!SignalHandler::Installed()) return false;
+  if (!IsActive() && !IsRegistered()) {
+    SamplerThread::RegisterSampler(this);
+    SetRegistered(true);
+  }
+  return platform_data()->StartThreadTimer(interval);
+#else
+  return false;
+#endif
+}
+
+
+void Sampler::StopThreadTimer() {
+#if defined(USE_SIGNALS) && V8_OS_LINUX
+  platform_data()->StopThreadTimer();
+#endif
+}
+
+
+bool Sampler::HasThreadTimer() const {
+#if defined(USE_SIGNALS) && V8_OS_LINUX
+  return platform_data()->has_thread_timer();
+#else
+  return false;
+#endif
+}
+
+
 void Sampler::SampleStack(const v8::RegisterState& state) {
   TickSample* sample = isolate_->cpu_profiler()->StartTickSample();
   TickSample sample_obj;
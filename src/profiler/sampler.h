@@ -98,6 +98,15 @@ class Sampler {
   bool IsRegistered() const { return base::NoBarrier_Load(&registered_); }
 
   void DoSample();
+
+  // Lets a timer of the sampled thread initiate a sample every {interval}
+  // instead of DoSample, see --sampling-thread-timer. Only supported on
+  // Linux, returns false if the timer could not be started. Has to be
+  // called on the sampled thread, like StopThreadTimer.
+  bool StartThreadTimer(base::TimeDelta interval);
+  void StopThreadTimer();
+  bool HasThreadTimer() const;
+
   // If true next sample must be initiated on the profiler event processor
   // thread right after latest sample is processed.
   void SetHasProcessingThread(bool value) {
@@ -12,6 +12,7 @@
 #include "src/heap/heap.h"
 #include "src/isolate.h"
 #include "src/profiler/strings-storage.h"
+#include "src/tracing/trace-event.h"
 
 namespace v8 {
 namespace internal {
@@ -40,15 +41,19 @@ intptr_t SamplingAllocationObserver::GetNextSampleInterval(uint64_t rate) {
 // sampled is 1-exp(-S/R). This function uses the above probability to
 // approximate the true number of allocations with size *size* given that
 // *count* samples were observed.
+double SamplingHeapProfiler::SampleScale(size_t size) {
+  return 1.0 / (1.0 - std::exp(-static_cast<double>(size) / rate_));
+}
+
 v8::AllocationProfile::Allocation SamplingHeapProfiler::ScaleSample(
     size_t size, unsigned int count) {
-  double scale = 1.0 / (1.0 - std::exp(-static_cast<double>(size) / rate_));
   // Round count instead of truncating.
-  return {size, static_cast<unsigned int>(count * scale + 0.5)};
+  return {size, static_cast<unsigned int>(count * SampleScale(size) + 0.5)};
 }
 
-SamplingHeapProfiler::SamplingHeapProfiler(Heap* heap, StringsStorage* names,
-                                           uint64_t rate, int stack_depth)
+SamplingHeapProfiler::SamplingHeapProfiler(
+    Heap* heap, StringsStorage* names, uint64_t rate, int stack_depth,
+    v8::HeapProfiler::SamplingFlags flags)
     : isolate_(heap->isolate()),
       heap_(heap),
       new_space_observer_(new SamplingAllocationObserver(
@@ -61,7 +66,10 @@ SamplingHeapProfiler::SamplingHeapProfiler(Heap* heap, StringsStorage* names,
       profile_root_(nullptr, "(root)", v8::UnboundScript::kNoScriptId, 0),
       samples_(),
       stack_depth_(stack_depth),
-      rate_(rate) {
+      rate_(rate),
+      flags_(flags),
+      timeline_interval_start_(0),
+      timeline_start_time_(heap->MonotonicallyIncreasingTimeInMs()) {
   CHECK_GT(rate_, 0);
   heap->new_space()->AddAllocationObserver(new_space_observer_.get());
   AllSpaces spaces(heap);
@@ -74,6 +82,9 @@ SamplingHeapProfiler::SamplingHeapProfiler(Heap* heap, StringsStorage* names,
 
 
 SamplingHeapProfiler::~SamplingHeapProfiler() {
+  if (flags_ & v8::HeapProfiler::kSamplingRecordTimeline) {
+    TraceTimelineInterval();
+  }
   heap_->new_space()->RemoveAllocationObserver(new_space_observer_.get());
   AllSpaces spaces(heap_);
   for (Space* space = spaces.next(); space != nullptr; space = spaces.next()) {
@@ -106,14 +117,66 @@ void SamplingHeapProfiler::SampleObject(Address soon_object, size_t size) {
 
   AllocationNode* node = AddStack();
   node->allocations_[size]++;
+  if (flags_ & v8::HeapProfiler::kSamplingRecordTimeline) {
+    RecordTimeline(node,
+                   MemoryChunk::FromAddress(soon_object)->owner()->identity(),
+                   size);
+  }
   Sample* sample = new Sample(size, node, loc, this);
   samples_.insert(sample);
   sample->global.SetWeak(sample, OnWeakCallback, WeakCallbackType::kParameter);
 }
 
+void SamplingHeapProfiler::RecordTimeline(AllocationNode* node,
+                                          AllocationSpace space,
+                                          size_t size) {
+  int interval = static_cast<int>(
+      (heap()->MonotonicallyIncreasingTimeInMs() - timeline_start_time_) /
+      Max(FLAG_sampling_heap_profiler_timeline_interval, 1));
+  if (timeline_interval_start_ < timeline_.size() &&
+      timeline_[timeline_interval_start_].interval != interval) {
+    TraceTimelineInterval();
+    timeline_interval_start_ = timeline_.size();
+  }
+  double bytes = size * SampleScale(size);
+  for (size_t i = timeline_interval_start_; i < timeline_.size(); i++) {
+    TimelineEntry& entry = timeline_[i];
+    if (entry.space == space && entry.script_id == node->script_id_ &&
+        entry.start_position == node->script_position_ &&
+        strcmp(entry.name, node->name_) == 0) {
+      entry.size += bytes;
+      return;
+    }
+  }
+  timeline_.push_back({interval, node->name_, node->script_id_,
+                       node->script_position_, space, bytes});
+}
+
+void SamplingHeapProfiler::TraceTimelineInterval() {
+  bool enabled;
+  TRACE_EVENT_CATEGORY_GROUP_ENABLED(
+      TRACE_DISABLED_BY_DEFAULT("v8.sampling_heap_profiler"), &enabled);
+  if (!enabled) return;
+  for (size_t i = timeline_interval_start_; i < timeline_.size(); i++) {
+    const TimelineEntry& entry = timeline_[i];
+    EmbeddedVector<char, 256> name;
+    SNPrintF(name, "V8.AllocatedBytes %s %s %d:%d",
+             heap()->GetSpaceName(entry.space), entry.name, entry.script_id,
+             entry.start_position);
+    TRACE_COPY_COUNTER1(TRACE_DISABLED_BY_DEFAULT("v8.sampling_heap_profiler"),
+                        name.start(), static_cast<int>(entry.size));
+  }
+}
+
 void SamplingHeapProfiler::OnWeakCallback(
     const WeakCallbackInfo<Sample>& data) {
   Sample* sample = data.GetParameter();
+  if (sample->profiler->flags_ &
+      v8::HeapProfiler::kSamplingIncludeObjectsCollectedByGC) {
+    sample->profiler->samples_.erase(sample);
+    delete sample;
+    return;
+  }
   AllocationNode* node = sample->owner;
   DCHECK(node->allocations_[sample->size] > 0);
   node->allocations_[sample->size]--;
@@ -205,7 +268,8 @@ SamplingHeapProfiler::AllocationNode* SamplingHeapProfiler::AddStack() {
 
 v8::AllocationProfile::Node* SamplingHeapProfiler::TranslateAllocationNode(
     AllocationProfile* profile, SamplingHeapProfiler::AllocationNode* node,
-    const std::map<int, Handle<Script>>& scripts) {
+    const std::map<int, Handle<Script>>& scripts,
+    const std::map<AllocationNode*, std::vector<double>>& survivors) {
   // By pinning the node we make sure its children won't get disposed if
   // a GC kicks in during the tree retrieval.
   node->pinned_ = true;
@@ -234,12 +298,23 @@ v8::AllocationProfile::Node* SamplingHeapProfiler::TranslateAllocationNode(
       allocations.push_back(ScaleSample(alloc.first, alloc.second));
     }
   }
+  std::vector<unsigned int> node_survivors(
+      v8::AllocationProfile::kMaxSurvivedGCs);
+  auto node_survivor_estimates = survivors.find(node);
+  if (node_survivor_estimates != survivors.end()) {
+    for (size_t i = 0; i < node_survivors.size(); i++) {
+      // Round count instead of truncating.
+      node_survivors[i] = static_cast<unsigned int>(
+          node_survivor_estimates->second[i] + 0.5);
+    }
+  }
 
   profile->nodes().push_back(v8::AllocationProfile::Node(
       {ToApiHandle<v8::String>(
            isolate_->factory()->InternalizeUtf8String(node->name_)),
        script_name, node->script_id_, node->script_position_, line, column,
-       std::vector<v8::AllocationProfile::Node*>(), allocations}));
+       std::vector<v8::AllocationProfile::Node*>(), allocations,
+       node_survivors}));
   v8::AllocationProfile::Node* current = &profile->nodes().back();
   size_t child_len = node->children_.size();
   // The children vector may have nodes appended to it during translation
@@ -248,8 +323,8 @@ v8::AllocationProfile::Node* SamplingHeapProfiler::TranslateAllocationNode(
   // iteration so that nodes appended to the vector during iteration are
   // not processed.
   for (size_t i = 0; i < child_len; i++) {
-    current->children.push_back(
-        TranslateAllocationNode(profile, node->children_[i], scripts));
+    current->children.push_back(TranslateAllocationNode(
+        profile, node->children_[i], scripts, survivors));
   }
   node->pinned_ = false;
   return current;
@@ -265,8 +340,34 @@ v8::AllocationProfile* SamplingHeapProfiler::GetAllocationProfile() {
       scripts[script->id()] = handle(script);
     }
   }
+  // Estimate the number of objects behind the samples that are still live,
+  // by the number of garbage collections they survived.
+  std::map<AllocationNode*, std::vector<double>> survivors;
+  for (Sample* sample : samples_) {
+    int survived_gcs = Min(heap()->gc_count() - sample->gc_count,
+                           v8::AllocationProfile::kMaxSurvivedGCs);
+    if (survived_gcs == 0) continue;
+    std::vector<double>& node_survivors = survivors[sample->owner];
+    node_survivors.resize(v8::AllocationProfile::kMaxSurvivedGCs);
+    double scale = SampleScale(sample->size);
+    for (int i = 0; i < survived_gcs; i++) node_survivors[i] += scale;
+  }
   auto profile = new v8::internal::AllocationProfile();
-  TranslateAllocationNode(profile, &profile_root_, scripts);
+  TranslateAllocationNode(profile, &profile_root_, scripts, survivors);
+  // Creating the names may allocate and add samples to the timeline.
+  size_t timeline_length = timeline_.size();
+  profile->timeline().reserve(timeline_length);
+  for (size_t i = 0; i < timeline_length; i++) {
+    TimelineEntry entry = timeline_[i];
+    profile->timeline().push_back(
+        {static_cast<double>(entry.interval) *
+             FLAG_sampling_heap_profiler_timeline_interval,
+         ToApiHandle<v8::String>(
+             isolate_->factory()->InternalizeUtf8String(entry.name)),
+         entry.script_id, entry.start_position,
+         heap()->GetSpaceName(entry.space),
+         static_cast<size_t>(entry.size + 0.5)});
+  }
   return profile;
 }
 
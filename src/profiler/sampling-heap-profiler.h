@@ -30,10 +30,19 @@ class AllocationProfile : public v8::AllocationProfile {
     return nodes_.size() == 0 ? nullptr : &nodes_.front();
   }
 
+  const std::vector<v8::AllocationProfile::TimelineEntry>& GetTimeline()
+      override {
+    return timeline_;
+  }
+
   std::deque<v8::AllocationProfile::Node>& nodes() { return nodes_; }
+  std::vector<v8::AllocationProfile::TimelineEntry>& timeline() {
+    return timeline_;
+  }
 
  private:
   std::deque<v8::AllocationProfile::Node> nodes_;
+  std::vector<v8::AllocationProfile::TimelineEntry> timeline_;
 
   DISALLOW_COPY_AND_ASSIGN(AllocationProfile);
 };
@@ -41,7 +50,7 @@ class AllocationProfile : public v8::AllocationProfile {
 class SamplingHeapProfiler {
  public:
   SamplingHeapProfiler(Heap* heap, StringsStorage* names, uint64_t rate,
-                       int stack_depth);
+                       int stack_depth, v8::HeapProfiler::SamplingFlags flags);
   ~SamplingHeapProfiler();
 
   v8::AllocationProfile* GetAllocationProfile();
@@ -58,12 +67,15 @@ class SamplingHeapProfiler {
           owner(owner_),
           global(Global<Value>(
               reinterpret_cast<v8::Isolate*>(profiler_->isolate_), local_)),
-          profiler(profiler_) {}
+          profiler(profiler_),
+          gc_count(profiler_->heap()->gc_count()) {}
     ~Sample() { global.Reset(); }
     const size_t size;
     AllocationNode* const owner;
     Global<Value> global;
     SamplingHeapProfiler* const profiler;
+    // The number of garbage collections before the object was allocated.
+    const int gc_count;
 
    private:
     DISALLOW_COPY_AND_ASSIGN(Sample);
@@ -103,6 +115,13 @@ class SamplingHeapProfiler {
 
   void SampleObject(Address soon_object, size_t size);
 
+  // Adds a sample of *size* bytes allocated by *node* in *space* to the
+  // current interval of the timeline.
+  void RecordTimeline(AllocationNode* node, AllocationSpace space,
+                      size_t size);
+  // Emits the entries of the current interval as trace counters.
+  void TraceTimelineInterval();
+
   static void OnWeakCallback(const WeakCallbackInfo<Sample>& data);
 
   // Methods that construct v8::AllocationProfile.
@@ -112,11 +131,15 @@ class SamplingHeapProfiler {
   // to the provided AllocationProfile *profile*. Line numbers, column numbers,
   // and script names are resolved using *scripts* which maps all currently
   // loaded scripts keyed by their script id.
+  // The survivors of every node are looked up in *survivors*, which maps
+  // nodes to the unrounded estimates of their live samples.
   v8::AllocationProfile::Node* TranslateAllocationNode(
       AllocationProfile* profile, SamplingHeapProfiler::AllocationNode* node,
-      const std::map<int, Handle<Script>>& scripts);
+      const std::map<int, Handle<Script>>& scripts,
+      const std::map<AllocationNode*, std::vector<double>>& survivors);
   v8::AllocationProfile::Allocation ScaleSample(size_t size,
                                                 unsigned int count);
+  double SampleScale(size_t size);
   AllocationNode* AddStack();
   AllocationNode* FindOrAddChildNode(AllocationNode* parent, const char* name,
                                      int script_id, int start_position);
@@ -130,6 +153,21 @@ class SamplingHeapProfiler {
   std::set<Sample*> samples_;
   const int stack_depth_;
   const uint64_t rate_;
+  const v8::HeapProfiler::SamplingFlags flags_;
+
+  struct TimelineEntry {
+    int interval;
+    const char* name;
+    int script_id;
+    int start_position;
+    AllocationSpace space;
+    // Estimated number of bytes.
+    double size;
+  };
+  std::vector<TimelineEntry> timeline_;
+  // Index of the first entry of the current interval in timeline_.
+  size_t timeline_interval_start_;
+  const double timeline_start_time_;
 
   friend class SamplingAllocationObserver;
 };
@@ -17,6 +17,11 @@ namespace internal {
 
 
 RegExpImpl::GlobalCache::~GlobalCache() {
+  // Count the whole global operation as one execution towards tier-up, so
+  // that all of its matches run in the same tier.
+  if (regexp_->TypeTag() == JSRegExp::IRREGEXP) {
+    RegExpImpl::IrregexpTickTierUp(FixedArray::cast(regexp_->data()));
+  }
   // Deallocate the register array if we allocated it in the constructor
   // (as opposed to using the existing jsregexp_static_offsets_vector).
   if (register_array_size_ > Isolate::kJSRegexpStaticOffsetsVectorSize) {
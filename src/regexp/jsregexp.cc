@@ -321,13 +321,15 @@ Handle<Object> RegExpImpl::AtomExec(Handle<JSRegExp> re,
 // returns false.
 bool RegExpImpl::EnsureCompiledIrregexp(Handle<JSRegExp> re,
                                         Handle<String> sample_subject,
-                                        bool is_one_byte) {
+                                        bool is_one_byte, bool interpreted) {
+  if (interpreted) {
+    // Bytecode is not flushed, so there is no saved copy to reinstate.
+    Object* bytecode = re->DataAt(IrregexpByteCodeIndex(is_one_byte));
+    if (bytecode->IsByteArray()) return true;
+    return CompileIrregexp(re, sample_subject, is_one_byte, true);
+  }
   Object* compiled_code = re->DataAt(JSRegExp::code_index(is_one_byte));
-#ifdef V8_INTERPRETED_REGEXP
-  if (compiled_code->IsByteArray()) return true;
-#else  // V8_INTERPRETED_REGEXP (RegExp native code)
   if (compiled_code->IsCode()) return true;
-#endif
   // We could potentially have marked this as flushable, but have kept
   // a saved version if we did not flush it yet.
   Object* saved_code = re->DataAt(JSRegExp::saved_code_index(is_one_byte));
@@ -337,20 +339,22 @@ bool RegExpImpl::EnsureCompiledIrregexp(Handle<JSRegExp> re,
     DCHECK(compiled_code->IsSmi());
     return true;
   }
-  return CompileIrregexp(re, sample_subject, is_one_byte);
+  return CompileIrregexp(re, sample_subject, is_one_byte, false);
 }
 
 
 bool RegExpImpl::CompileIrregexp(Handle<JSRegExp> re,
                                  Handle<String> sample_subject,
-                                 bool is_one_byte) {
+                                 bool is_one_byte, bool interpreted) {
   // Compile the RegExp.
   Isolate* isolate = re->GetIsolate();
   Zone zone(isolate->allocator());
   PostponeInterruptsScope postpone(isolate);
+  int index = interpreted ? IrregexpByteCodeIndex(is_one_byte)
+                          : JSRegExp::code_index(is_one_byte);
   // If we had a compilation error the last time this is saved at the
   // saved code index.
-  Object* entry = re->DataAt(JSRegExp::code_index(is_one_byte));
+  Object* entry = re->DataAt(index);
   // When arriving here entry can only be a smi, either representing an
   // uncompiled regexp, a previous compilation error, or code that has
   // been flushed.
@@ -386,7 +390,7 @@ bool RegExpImpl::CompileIrregexp(Handle<JSRegExp> re,
   }
   RegExpEngine::CompilationResult result =
       RegExpEngine::Compile(isolate, &zone, &compile_data, flags, pattern,
-                            sample_subject, is_one_byte);
+                            sample_subject, is_one_byte, interpreted);
   if (result.error_message != NULL) {
     // Unable to compile regexp.
     Handle<String> error_message = isolate->factory()->NewStringFromUtf8(
@@ -396,7 +400,7 @@ bool RegExpImpl::CompileIrregexp(Handle<JSRegExp> re,
   }
 
   Handle<FixedArray> data = Handle<FixedArray>(FixedArray::cast(re->data()));
-  data->set(JSRegExp::code_index(is_one_byte), result.code);
+  data->set(index, result.code);
   int register_max = IrregexpMaxRegisterCount(*data);
   if (result.num_registers > register_max) {
     SetIrregexpMaxRegisterCount(*data, result.num_registers);
@@ -428,7 +432,7 @@ int RegExpImpl::IrregexpNumberOfRegisters(FixedArray* re) {
 
 
 ByteArray* RegExpImpl::IrregexpByteCode(FixedArray* re, bool is_one_byte) {
-  return ByteArray::cast(re->get(JSRegExp::code_index(is_one_byte)));
+  return ByteArray::cast(re->get(IrregexpByteCodeIndex(is_one_byte)));
 }
 
 
@@ -437,6 +441,36 @@ Code* RegExpImpl::IrregexpNativeCode(FixedArray* re, bool is_one_byte) {
 }
 
 
+int RegExpImpl::IrregexpByteCodeIndex(bool is_one_byte) {
+#ifdef V8_INTERPRETED_REGEXP
+  return JSRegExp::code_index(is_one_byte);
+#else  // V8_INTERPRETED_REGEXP
+  return JSRegExp::bytecode_index(is_one_byte);
+#endif  // V8_INTERPRETED_REGEXP
+}
+
+
+bool RegExpImpl::IrregexpInterpreted(FixedArray* re) {
+#ifdef V8_INTERPRETED_REGEXP
+  return true;
+#else  // V8_INTERPRETED_REGEXP
+  if (!FLAG_regexp_tier_up) return false;
+  return Smi::cast(re->get(JSRegExp::kIrregexpTicksUntilTierUpIndex))
+             ->value() > 0;
+#endif  // V8_INTERPRETED_REGEXP
+}
+
+
+void RegExpImpl::IrregexpTickTierUp(FixedArray* re) {
+  if (!FLAG_regexp_tier_up) return;
+  int ticks =
+      Smi::cast(re->get(JSRegExp::kIrregexpTicksUntilTierUpIndex))->value();
+  if (ticks > 0) {
+    re->set(JSRegExp::kIrregexpTicksUntilTierUpIndex, Smi::FromInt(ticks - 1));
+  }
+}
+
+
 void RegExpImpl::IrregexpInitialize(Handle<JSRegExp> re,
                                     Handle<String> pattern,
                                     JSRegExp::Flags flags,
@@ -456,42 +490,38 @@ int RegExpImpl::IrregexpPrepare(Handle<JSRegExp> regexp,
 
   // Check representation of the underlying storage.
   bool is_one_byte = subject->IsOneByteRepresentationUnderneath();
-  if (!EnsureCompiledIrregexp(regexp, subject, is_one_byte)) return -1;
+  bool interpreted = IrregexpInterpreted(FixedArray::cast(regexp->data()));
+  if (!EnsureCompiledIrregexp(regexp, subject, is_one_byte, interpreted)) {
+    return -1;
+  }
 
-#ifdef V8_INTERPRETED_REGEXP
-  // Byte-code regexp needs space allocated for all its registers.
-  // The result captures are copied to the start of the registers array
-  // if the match succeeds.  This way those registers are not clobbered
-  // when we set the last match info from last successful match.
-  return IrregexpNumberOfRegisters(FixedArray::cast(regexp->data())) +
-         (IrregexpNumberOfCaptures(FixedArray::cast(regexp->data())) + 1) * 2;
-#else  // V8_INTERPRETED_REGEXP
+  if (interpreted) {
+    // Byte-code regexp needs space allocated for all its registers.
+    // The result captures are copied to the start of the registers array
+    // if the match succeeds.  This way those registers are not clobbered
+    // when we set the last match info from last successful match.
+    return IrregexpNumberOfRegisters(FixedArray::cast(regexp->data())) +
+           (IrregexpNumberOfCaptures(FixedArray::cast(regexp->data())) + 1) *
+               2;
+  }
   // Native regexp only needs room to output captures. Registers are handled
   // internally.
   return (IrregexpNumberOfCaptures(FixedArray::cast(regexp->data())) + 1) * 2;
-#endif  // V8_INTERPRETED_REGEXP
 }
 
 
-int RegExpImpl::IrregexpExecRaw(Handle<JSRegExp> regexp,
-                                Handle<String> subject,
-                                int index,
-                                int32_t* output,
-                                int output_size) {
+#ifndef V8_INTERPRETED_REGEXP
+int RegExpImpl::IrregexpExecNative(Handle<JSRegExp> regexp,
+                                   Handle<String> subject, int index,
+                                   int32_t* output, int output_size) {
   Isolate* isolate = regexp->GetIsolate();
 
   Handle<FixedArray> irregexp(FixedArray::cast(regexp->data()), isolate);
-
-  DCHECK(index >= 0);
-  DCHECK(index <= subject->length());
-  DCHECK(subject->IsFlat());
-
   bool is_one_byte = subject->IsOneByteRepresentationUnderneath();
 
-#ifndef V8_INTERPRETED_REGEXP
   DCHECK(output_size >= (IrregexpNumberOfCaptures(*irregexp) + 1) * 2);
   do {
-    EnsureCompiledIrregexp(regexp, subject, is_one_byte);
+    EnsureCompiledIrregexp(regexp, subject, is_one_byte, false);
     Handle<Code> code(IrregexpNativeCode(*irregexp, is_one_byte), isolate);
     // The stack is used to allocate registers for the compiled regexp code.
     // This means that in case of failure, the output registers array is left
@@ -526,7 +556,30 @@ int RegExpImpl::IrregexpExecRaw(Handle<JSRegExp> regexp,
   } while (true);
   UNREACHABLE();
   return RE_EXCEPTION;
-#else  // V8_INTERPRETED_REGEXP
+}
+#endif  // V8_INTERPRETED_REGEXP
+
+
+int RegExpImpl::IrregexpExecRaw(Handle<JSRegExp> regexp,
+                                Handle<String> subject,
+                                int index,
+                                int32_t* output,
+                                int output_size) {
+  Isolate* isolate = regexp->GetIsolate();
+
+  Handle<FixedArray> irregexp(FixedArray::cast(regexp->data()), isolate);
+
+  DCHECK(index >= 0);
+  DCHECK(index <= subject->length());
+  DCHECK(subject->IsFlat());
+
+#ifndef V8_INTERPRETED_REGEXP
+  if (!IrregexpInterpreted(*irregexp)) {
+    return IrregexpExecNative(regexp, subject, index, output, output_size);
+  }
+#endif  // V8_INTERPRETED_REGEXP
+
+  bool is_one_byte = subject->IsOneByteRepresentationUnderneath();
 
   DCHECK(output_size >= IrregexpNumberOfRegisters(*irregexp));
   // We must have done EnsureCompiledIrregexp, so we can get the number of
@@ -557,7 +610,6 @@ int RegExpImpl::IrregexpExecRaw(Handle<JSRegExp> regexp,
     isolate->StackOverflow();
   }
   return result;
-#endif  // V8_INTERPRETED_REGEXP
 }
 
 
@@ -594,6 +646,7 @@ MaybeHandle<Object> RegExpImpl::IrregexpExec(Handle<JSRegExp> regexp,
 
   int res = RegExpImpl::IrregexpExecRaw(
       regexp, subject, previous_index, output_registers, required_registers);
+  IrregexpTickTierUp(FixedArray::cast(regexp->data()));
   if (res == RE_SUCCESS) {
     int capture_count =
         IrregexpNumberOfCaptures(FixedArray::cast(regexp->data()));
@@ -645,18 +698,15 @@ RegExpImpl::GlobalCache::GlobalCache(Handle<JSRegExp> regexp,
     register_array_size_(0),
     regexp_(regexp),
     subject_(subject) {
-#ifdef V8_INTERPRETED_REGEXP
-  bool interpreted = true;
-#else
   bool interpreted = false;
-#endif  // V8_INTERPRETED_REGEXP
 
   if (regexp_->TypeTag() == JSRegExp::ATOM) {
     static const int kAtomRegistersPerMatch = 2;
     registers_per_match_ = kAtomRegistersPerMatch;
     // There is no distinction between interpreted and native for atom regexps.
-    interpreted = false;
   } else {
+    interpreted =
+        RegExpImpl::IrregexpInterpreted(FixedArray::cast(regexp_->data()));
     registers_per_match_ = RegExpImpl::IrregexpPrepare(regexp_, subject_);
     if (registers_per_match_ < 0) {
       num_matches_ = -1;  // Signal exception.
@@ -664,8 +714,10 @@ RegExpImpl::GlobalCache::GlobalCache(Handle<JSRegExp> regexp,
     }
   }
 
-  DCHECK_NE(0, regexp->GetFlags() & JSRegExp::kGlobal);
-  if (!interpreted) {
+  // A non-global native regexp stops after the first match, so it is
+  // treated like the interpreted case and fetches one match per call.
+  bool global = (regexp->GetFlags() & JSRegExp::kGlobal) != 0;
+  if (!interpreted && global) {
     register_array_size_ =
         Max(registers_per_match_, Isolate::kJSRegexpStaticOffsetsVectorSize);
     max_matches_ = register_array_size_ / registers_per_match_;
@@ -3782,10 +3834,49 @@ int BoyerMooreLookahead::GetSkipTable(int min_lookahead,
 }
 
 
+// If some position ahead can only hold a single character (modulus the
+// kTableSize) that is rare in the sample subject, the macro assembler may scan
+// for it a vector of characters at a time.  This leaves the current position
+// at the first candidate, or close to the end of the subject, from where the
+// instructions emitted by EmitSkipInstructions take over.
+void BoyerMooreLookahead::EmitVectorSkipInstructions(
+    RegExpMacroAssembler* masm) {
+  const int kSize = RegExpMacroAssembler::kTableSize;
+  // Stopping at every occurrence of a frequent character is slower than
+  // skipping with the loops below.
+  const int kMaxFrequency = kSize / 8;
+
+  int best_offset = -1;
+  int best_character = 0;
+  int best_frequency = kMaxFrequency;
+  for (int i = 0; i < length_; i++) {
+    BoyerMoorePositionInfo* map = bitmaps_->at(i);
+    if (map->map_count() != 1) continue;
+    for (int j = 0; j < kSize; j++) {
+      if (!map->at(j)) continue;
+      int frequency = compiler_->frequency_collator()->Frequency(j);
+      if (frequency < best_frequency) {
+        best_offset = i;
+        best_character = j;
+        best_frequency = frequency;
+      }
+      break;
+    }
+  }
+  if (best_offset < 0) return;
+
+  uint32_t mask = max_char_ > kSize ? RegExpMacroAssembler::kTableMask
+                                    : String::kMaxUtf16CodeUnit;
+  masm->SkipUntilCharacterAfterAnd(best_offset, best_character, mask);
+}
+
+
 // See comment above on the implementation of GetSkipTable.
 void BoyerMooreLookahead::EmitSkipInstructions(RegExpMacroAssembler* masm) {
   const int kSize = RegExpMacroAssembler::kTableSize;
 
+  if (FLAG_regexp_vector_skip) EmitVectorSkipInstructions(masm);
+
   int min_lookahead = 0;
   int max_lookahead = 0;
 
@@ -6614,7 +6705,7 @@ RegExpNode* OptionallyStepBackToLeadSurrogate(RegExpCompiler* compiler,
 RegExpEngine::CompilationResult RegExpEngine::Compile(
     Isolate* isolate, Zone* zone, RegExpCompileData* data,
     JSRegExp::Flags flags, Handle<String> pattern,
-    Handle<String> sample_subject, bool is_one_byte) {
+    Handle<String> sample_subject, bool is_one_byte, bool interpreted) {
   if ((data->capture_count + 1) * 2 - 1 > RegExpMacroAssembler::kMaxRegister) {
     return IrregexpRegExpTooBig(isolate);
   }
@@ -6688,51 +6779,56 @@ RegExpEngine::CompilationResult RegExpEngine::Compile(
   }
 
   // Create the correct assembler for the architecture.
+  base::SmartPointer<RegExpMacroAssembler> macro_assembler_scope;
+  EmbeddedVector<byte, 1024> codes;
 #ifndef V8_INTERPRETED_REGEXP
-  // Native regexp implementation.
-
-  NativeRegExpMacroAssembler::Mode mode =
-      is_one_byte ? NativeRegExpMacroAssembler::LATIN1
-                  : NativeRegExpMacroAssembler::UC16;
-
+  if (!interpreted) {
+    // Native regexp implementation.
+    NativeRegExpMacroAssembler::Mode mode =
+        is_one_byte ? NativeRegExpMacroAssembler::LATIN1
+                    : NativeRegExpMacroAssembler::UC16;
+    int registers = (data->capture_count + 1) * 2;
 #if V8_TARGET_ARCH_IA32
-  RegExpMacroAssemblerIA32 macro_assembler(isolate, zone, mode,
-                                           (data->capture_count + 1) * 2);
+    macro_assembler_scope.Reset(
+        new RegExpMacroAssemblerIA32(isolate, zone, mode, registers));
 #elif V8_TARGET_ARCH_X64
-  RegExpMacroAssemblerX64 macro_assembler(isolate, zone, mode,
-                                          (data->capture_count + 1) * 2);
+    macro_assembler_scope.Reset(
+        new RegExpMacroAssemblerX64(isolate, zone, mode, registers));
 #elif V8_TARGET_ARCH_ARM
-  RegExpMacroAssemblerARM macro_assembler(isolate, zone, mode,
-                                          (data->capture_count + 1) * 2);
+    macro_assembler_scope.Reset(
+        new RegExpMacroAssemblerARM(isolate, zone, mode, registers));
 #elif V8_TARGET_ARCH_ARM64
-  RegExpMacroAssemblerARM64 macro_assembler(isolate, zone, mode,
-                                            (data->capture_count + 1) * 2);
+    macro_assembler_scope.Reset(
+        new RegExpMacroAssemblerARM64(isolate, zone, mode, registers));
 #elif V8_TARGET_ARCH_S390
-  RegExpMacroAssemblerS390 macro_assembler(isolate, zone, mode,
-                                           (data->capture_count + 1) * 2);
+    macro_assembler_scope.Reset(
+        new RegExpMacroAssemblerS390(isolate, zone, mode, registers));
 #elif V8_TARGET_ARCH_PPC
-  RegExpMacroAssemblerPPC macro_assembler(isolate, zone, mode,
-                                          (data->capture_count + 1) * 2);
+    macro_assembler_scope.Reset(
+        new RegExpMacroAssemblerPPC(isolate, zone, mode, registers));
 #elif V8_TARGET_ARCH_MIPS
-  RegExpMacroAssemblerMIPS macro_assembler(isolate, zone, mode,
-                                           (data->capture_count + 1) * 2);
+    macro_assembler_scope.Reset(
+        new RegExpMacroAssemblerMIPS(isolate, zone, mode, registers));
 #elif V8_TARGET_ARCH_MIPS64
-  RegExpMacroAssemblerMIPS macro_assembler(isolate, zone, mode,
-                                           (data->capture_count + 1) * 2);
+    macro_assembler_scope.Reset(
+        new RegExpMacroAssemblerMIPS(isolate, zone, mode, registers));
 #elif V8_TARGET_ARCH_X87
-  RegExpMacroAssemblerX87 macro_assembler(isolate, zone, mode,
-                                          (data->capture_count + 1) * 2);
+    macro_assembler_scope.Reset(
+        new RegExpMacroAssemblerX87(isolate, zone, mode, registers));
 #else
 #error "Unsupported architecture"
 #endif
-
-#else  // V8_INTERPRETED_REGEXP
-  // Interpreted regexp implementation.
-  EmbeddedVector<byte, 1024> codes;
-  RegExpMacroAssemblerIrregexp macro_assembler(isolate, codes, zone);
+  }
+#else   // V8_INTERPRETED_REGEXP
+  DCHECK(interpreted);
 #endif  // V8_INTERPRETED_REGEXP
+  if (interpreted) {
+    macro_assembler_scope.Reset(
+        new RegExpMacroAssemblerIrregexp(isolate, codes, zone));
+  }
+  RegExpMacroAssembler* macro_assembler = macro_assembler_scope.get();
 
-  macro_assembler.set_slow_safe(TooMuchRegExpCode(pattern));
+  macro_assembler->set_slow_safe(TooMuchRegExpCode(pattern));
 
   // Inserted here, instead of in Assembler, because it depends on information
   // in the AST that isn't replicated in the Node structure.
@@ -6740,7 +6836,7 @@ RegExpEngine::CompilationResult RegExpEngine::Compile(
   if (is_end_anchored &&
       !is_start_anchored &&
       max_length < kMaxBacksearchLimit) {
-    macro_assembler.SetCurrentPositionFromEnd(max_length);
+    macro_assembler->SetCurrentPositionFromEnd(max_length);
   }
 
   if (is_global) {
@@ -6750,10 +6846,10 @@ RegExpEngine::CompilationResult RegExpEngine::Compile(
     } else if (is_unicode) {
       mode = RegExpMacroAssembler::GLOBAL_UNICODE;
     }
-    macro_assembler.set_global_mode(mode);
+    macro_assembler->set_global_mode(mode);
   }
 
-  return compiler.Assemble(&macro_assembler,
+  return compiler.Assemble(macro_assembler,
                            node,
                            data->capture_count,
                            pattern);
@@ -201,6 +201,13 @@ class RegExpImpl {
   static ByteArray* IrregexpByteCode(FixedArray* re, bool is_one_byte);
   static Code* IrregexpNativeCode(FixedArray* re, bool is_one_byte);
 
+  // Whether executions of the regexp run its bytecode in the interpreter.
+  // Native regexp builds only interpret with --regexp-tier-up, until the
+  // regexp has been executed --regexp-tier-up-ticks times.
+  static bool IrregexpInterpreted(FixedArray* re);
+  // Counts an execution of the regexp towards compiling it to native code.
+  static void IrregexpTickTierUp(FixedArray* re);
+
   // Limit the space regexps take up on the heap.  In order to limit this we
   // would like to keep track of the amount of regexp code on the heap.  This
   // is not tracked, however.  As a conservative approximation we track the
@@ -212,10 +219,20 @@ class RegExpImpl {
 
  private:
   static bool CompileIrregexp(Handle<JSRegExp> re,
-                              Handle<String> sample_subject, bool is_one_byte);
+                              Handle<String> sample_subject, bool is_one_byte,
+                              bool interpreted);
   static inline bool EnsureCompiledIrregexp(Handle<JSRegExp> re,
                                             Handle<String> sample_subject,
-                                            bool is_one_byte);
+                                            bool is_one_byte,
+                                            bool interpreted);
+  // The data array index holding the bytecode, which interpreted regexp
+  // builds keep in place of the native code.
+  static int IrregexpByteCodeIndex(bool is_one_byte);
+#ifndef V8_INTERPRETED_REGEXP
+  static int IrregexpExecNative(Handle<JSRegExp> regexp,
+                                Handle<String> subject, int index,
+                                int32_t* output, int output_size);
+#endif  // V8_INTERPRETED_REGEXP
 };
 
 
@@ -1222,6 +1239,7 @@ class BoyerMooreLookahead : public ZoneObject {
   int GetSkipTable(int min_lookahead,
                    int max_lookahead,
                    Handle<ByteArray> boolean_skip_table);
+  void EmitVectorSkipInstructions(RegExpMacroAssembler* masm);
   bool FindWorthwhileInterval(int* from, int* to);
   int FindBestInterval(
     int max_number_of_chars, int old_biggest_points, int* from, int* to);
@@ -1549,12 +1567,14 @@ class RegExpEngine: public AllStatic {
     int num_registers;
   };
 
+  // Generates bytecode for the interpreter if |interpreted| is true and
+  // native code otherwise.
   static CompilationResult Compile(Isolate* isolate, Zone* zone,
                                    RegExpCompileData* input,
                                    JSRegExp::Flags flags,
                                    Handle<String> pattern,
                                    Handle<String> sample_subject,
-                                   bool is_one_byte);
+                                   bool is_one_byte, bool interpreted);
 
   static bool TooMuchRegExpCode(Handle<String> pattern);
 
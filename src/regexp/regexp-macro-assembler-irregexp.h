@@ -5,8 +5,6 @@
 #ifndef V8_REGEXP_REGEXP_MACRO_ASSEMBLER_IRREGEXP_H_
 #define V8_REGEXP_REGEXP_MACRO_ASSEMBLER_IRREGEXP_H_
 
-#ifdef V8_INTERPRETED_REGEXP
-
 #include "src/regexp/regexp-macro-assembler.h"
 
 namespace v8 {
@@ -128,6 +126,4 @@ class RegExpMacroAssemblerIrregexp: public RegExpMacroAssembler {
 }  // namespace internal
 }  // namespace v8
 
-#endif  // V8_INTERPRETED_REGEXP
-
 #endif  // V8_REGEXP_REGEXP_MACRO_ASSEMBLER_IRREGEXP_H_
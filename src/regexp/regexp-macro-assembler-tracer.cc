@@ -132,6 +132,17 @@ void RegExpMacroAssemblerTracer::SetRegister(int register_index, int to) {
 }
 
 
+bool RegExpMacroAssemblerTracer::SkipUntilCharacterAfterAnd(int cp_offset,
+                                                            uint32_t c,
+                                                            uint32_t mask) {
+  bool supported = assembler_->SkipUntilCharacterAfterAnd(cp_offset, c, mask);
+  PrintF(" SkipUntilCharacterAfterAnd(cp_offset=%d, c=0x%04x, mask=0x%04x): "
+         "%s;\n",
+         cp_offset, c, mask, supported ? "true" : "false");
+  return supported;
+}
+
+
 void RegExpMacroAssemblerTracer::WriteCurrentPositionToRegister(int reg,
                                                                 int cp_offset) {
   PrintF(" WriteCurrentPositionToRegister(register=%d,cp_offset=%d);\n",
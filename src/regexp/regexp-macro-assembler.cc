@@ -110,6 +110,12 @@ bool RegExpMacroAssembler::CheckSpecialCharacterClass(uc16 type,
   return false;
 }
 
+bool RegExpMacroAssembler::SkipUntilCharacterAfterAnd(int cp_offset,
+                                                      unsigned c,
+                                                      unsigned mask) {
+  return false;
+}
+
 #ifndef V8_INTERPRETED_REGEXP  // Avoid unused code, e.g., on ARM.
 
 NativeRegExpMacroAssembler::NativeRegExpMacroAssembler(Isolate* isolate,
@@ -148,6 +148,14 @@ class RegExpMacroAssembler {
   virtual void ReadStackPointerFromRegister(int reg) = 0;
   virtual void SetCurrentPositionFromEnd(int by) = 0;
   virtual void SetRegister(int register_index, int to) = 0;
+  // Advances the current position to the first position at which the
+  // character cp_offset ahead, and-ed with mask, is c, comparing a vector of
+  // characters at a time. Stops earlier, at a position that has not been
+  // checked, once fewer characters than fit in a vector are left. Clobbers
+  // the current character. Returns false without generating code if there is
+  // no vector support.
+  virtual bool SkipUntilCharacterAfterAnd(int cp_offset, unsigned c,
+                                          unsigned mask);
   // Return whether the matching (with a global regexp) will be restarted.
   virtual bool Succeed() = 0;
   virtual void WriteCurrentPositionToRegister(int reg, int cp_offset) = 0;
@@ -1141,6 +1141,53 @@ void RegExpMacroAssemblerX64::SetRegister(int register_index, int to) {
 }
 
 
+bool RegExpMacroAssemblerX64::SkipUntilCharacterAfterAnd(int cp_offset,
+                                                         uint32_t c,
+                                                         uint32_t mask) {
+  // SSE2 is available on every x64 CPU. Each iteration compares the 16 bytes
+  // starting cp_offset characters ahead with a vector of copies of c.
+  static const int kVectorSize = 16;
+  uint32_t char_mask = mode_ == LATIN1 ? String::kMaxOneByteCharCode
+                                       : String::kMaxUtf16CodeUnit;
+  uint32_t broadcast = mode_ == LATIN1 ? 0x01010101 : 0x00010001;
+  bool use_mask = (mask & char_mask) != char_mask;
+  __ movl(rax, Immediate(static_cast<int32_t>(c * broadcast)));
+  __ Movd(xmm1, rax);
+  __ pshufd(xmm1, xmm1, 0);
+  if (use_mask) {
+    __ movl(rax, Immediate(static_cast<int32_t>((mask & char_mask) *
+                                                broadcast)));
+    __ Movd(xmm2, rax);
+    __ pshufd(xmm2, xmm2, 0);
+  }
+
+  Label loop, found, done;
+  __ bind(&loop);
+  __ cmpl(rdi, Immediate(-cp_offset * char_size() - kVectorSize));
+  __ j(greater, &done, Label::kNear);
+  __ movdqu(xmm0, Operand(rsi, rdi, times_1, cp_offset * char_size()));
+  if (use_mask) __ andpd(xmm0, xmm2);
+  if (mode_ == LATIN1) {
+    __ pcmpeqb(xmm0, xmm1);
+  } else {
+    __ pcmpeqw(xmm0, xmm1);
+  }
+  __ pmovmskb(rax, xmm0);
+  __ testl(rax, rax);
+  __ j(not_zero, &found, Label::kNear);
+  __ addq(rdi, Immediate(kVectorSize));
+  __ jmp(&loop);
+
+  // The lowest set bit is the byte offset of the first matching character,
+  // since pcmpeqw sets both bits of a matching two-byte character.
+  __ bind(&found);
+  __ bsfl(rax, rax);
+  __ addq(rdi, rax);
+  __ bind(&done);
+  return true;
+}
+
+
 bool RegExpMacroAssemblerX64::Succeed() {
   __ jmp(&success_label_);
   return global();
@@ -4,6 +4,8 @@
 
 #include "src/runtime-profiler.h"
 
+#include <algorithm>
+
 #include "src/assembler.h"
 #include "src/ast/scopeinfo.h"
 #include "src/base/platform/platform.h"
@@ -14,14 +16,12 @@
 #include "src/frames-inl.h"
 #include "src/full-codegen/full-codegen.h"
 #include "src/global-handles.h"
+#include "src/optimizing-compile-dispatcher.h"
 
 namespace v8 {
 namespace internal {
 
 
-// Number of times a function has to be seen on the stack before it is
-// optimized.
-static const int kProfilerTicksBeforeOptimization = 2;
 // If the function optimization was disabled due to high deoptimization count,
 // but the function is hot and has been seen on the stack this number of times,
 // then we try to reenable optimization for this function.
@@ -31,7 +31,6 @@ static const int kProfilerTicksBeforeReenablingOptimization = 250;
 // optimize it as it is.
 static const int kTicksWhenNotEnoughTypeInfo = 100;
 // We only have one byte to store the number of ticks.
-STATIC_ASSERT(kProfilerTicksBeforeOptimization < 256);
 STATIC_ASSERT(kProfilerTicksBeforeReenablingOptimization < 256);
 STATIC_ASSERT(kTicksWhenNotEnoughTypeInfo < 256);
 
@@ -51,6 +50,29 @@ static const int kMaxSizeEarlyOpt =
 RuntimeProfiler::RuntimeProfiler(Isolate* isolate)
     : isolate_(isolate),
       any_ic_changed_(false) {
+  Thresholds thresholds;
+  thresholds.ticks_before_optimization = FLAG_ticks_before_optimization;
+  thresholds.ticks_when_not_enough_type_info = kTicksWhenNotEnoughTypeInfo;
+  thresholds.max_code_size_for_early_opt = kMaxSizeEarlyOpt;
+  thresholds.max_bytecode_size_for_early_opt =
+      FLAG_max_bytecode_size_for_early_opt;
+  set_thresholds(thresholds);
+}
+
+
+void RuntimeProfiler::set_thresholds(const Thresholds& thresholds) {
+  // Full-codegen code only has one byte to store the number of ticks.
+  thresholds_.ticks_before_optimization =
+      Max(0, Min(thresholds.ticks_before_optimization,
+                 Code::ProfilerTicksField::kMax));
+  thresholds_.ticks_when_not_enough_type_info =
+      Max(thresholds_.ticks_before_optimization,
+          Min(thresholds.ticks_when_not_enough_type_info,
+              Code::ProfilerTicksField::kMax));
+  thresholds_.max_code_size_for_early_opt =
+      thresholds.max_code_size_for_early_opt;
+  thresholds_.max_bytecode_size_for_early_opt =
+      thresholds.max_bytecode_size_for_early_opt;
 }
 
 
@@ -106,7 +128,9 @@ void RuntimeProfiler::Optimize(JSFunction* function, const char* reason) {
     PrintF("]\n");
   }
 
-  if (function->shared()->HasBytecodeArray()) {
+  // With --block-coverage, interpreted functions are only optimized by
+  // TurboFan from their bytecode, which keeps the block counters.
+  if (function->shared()->HasBytecodeArray() && !FLAG_block_coverage) {
     function->MarkForBaseline();
   } else {
     function->AttemptConcurrentOptimization();
@@ -114,8 +138,9 @@ void RuntimeProfiler::Optimize(JSFunction* function, const char* reason) {
 }
 
 
-void RuntimeProfiler::AttemptOnStackReplacement(JSFunction* function,
+void RuntimeProfiler::AttemptOnStackReplacement(JavaScriptFrame* frame,
                                                 int loop_nesting_levels) {
+  JSFunction* function = frame->function();
   SharedFunctionInfo* shared = function->shared();
   if (!FLAG_use_osr || function->shared()->IsBuiltin()) {
     return;
@@ -138,23 +163,34 @@ void RuntimeProfiler::AttemptOnStackReplacement(JSFunction* function,
     PrintF("]\n");
   }
 
+  if (frame->is_interpreted()) {
+    // Arm the back edges of all loops nested less deeply than the new level,
+    // see {Interpreter::DoOsrPoll}.
+    DCHECK(FLAG_ignition_osr);
+    BytecodeArray* bytecode = shared->bytecode_array();
+    int level = bytecode->osr_loop_nesting_level();
+    bytecode->set_osr_loop_nesting_level(
+        Min(level + loop_nesting_levels, Code::kMaxLoopNestingMarker));
+    return;
+  }
+
   for (int i = 0; i < loop_nesting_levels; i++) {
     BackEdgeTable::Patch(isolate_, shared->code());
   }
 }
 
 void RuntimeProfiler::MaybeOptimizeFullCodegen(JSFunction* function,
-                                               int frame_count,
-                                               bool frame_optimized) {
+                                               JavaScriptFrame* frame,
+                                               int frame_count) {
   SharedFunctionInfo* shared = function->shared();
   Code* shared_code = shared->code();
   if (shared_code->kind() != Code::FUNCTION) return;
   if (function->IsInOptimizationQueue()) return;
 
   if (FLAG_always_osr) {
-    AttemptOnStackReplacement(function, Code::kMaxLoopNestingMarker);
+    AttemptOnStackReplacement(frame, Code::kMaxLoopNestingMarker);
     // Fall through and do a normal optimized compile as well.
-  } else if (!frame_optimized &&
+  } else if (!frame->is_optimized() &&
              (function->IsMarkedForOptimization() ||
               function->IsMarkedForConcurrentOptimization() ||
               function->IsOptimized())) {
@@ -168,7 +204,7 @@ void RuntimeProfiler::MaybeOptimizeFullCodegen(JSFunction* function,
         ticks < Code::ProfilerTicksField::kMax) {
       shared_code->set_profiler_ticks(ticks + 1);
     } else {
-      AttemptOnStackReplacement(function);
+      AttemptOnStackReplacement(frame);
     }
     return;
   }
@@ -199,9 +235,16 @@ void RuntimeProfiler::MaybeOptimizeFullCodegen(JSFunction* function,
   }
   if (function->IsOptimized()) return;
 
+  // Functions that were hot in an earlier process are optimized right away,
+  // unless they have deoptimized since.
+  if (shared->deopt_count() == 0 && IsHotInProfile(shared)) {
+    Optimize(function, "hot in profile");
+    return;
+  }
+
   int ticks = shared_code->profiler_ticks();
 
-  if (ticks >= kProfilerTicksBeforeOptimization) {
+  if (ticks >= thresholds_.ticks_before_optimization) {
     int typeinfo, generic, total, type_percentage, generic_percentage;
     GetICCounts(shared, &typeinfo, &generic, &total, &type_percentage,
                 &generic_percentage);
@@ -210,7 +253,7 @@ void RuntimeProfiler::MaybeOptimizeFullCodegen(JSFunction* function,
       // If this particular function hasn't had any ICs patched for enough
       // ticks, optimize it now.
       Optimize(function, "hot and stable");
-    } else if (ticks >= kTicksWhenNotEnoughTypeInfo) {
+    } else if (ticks >= thresholds_.ticks_when_not_enough_type_info) {
       Optimize(function, "not much type info but very hot");
     } else {
       shared_code->set_profiler_ticks(ticks + 1);
@@ -222,7 +265,8 @@ void RuntimeProfiler::MaybeOptimizeFullCodegen(JSFunction* function,
       }
     }
   } else if (!any_ic_changed_ &&
-             shared_code->instruction_size() < kMaxSizeEarlyOpt) {
+             shared_code->instruction_size() <
+                 thresholds_.max_code_size_for_early_opt) {
     // If no IC was patched since the last tick and this function is very
     // small, optimistically optimize it now.
     int typeinfo, generic, total, type_percentage, generic_percentage;
@@ -239,8 +283,84 @@ void RuntimeProfiler::MaybeOptimizeFullCodegen(JSFunction* function,
   }
 }
 
+bool RuntimeProfiler::ProfileEntry::operator<(
+    const ProfileEntry& other) const {
+  if (script_name_hash != other.script_name_hash) {
+    return script_name_hash < other.script_name_hash;
+  }
+  if (script_length != other.script_length) {
+    return script_length < other.script_length;
+  }
+  if (start_position != other.start_position) {
+    return start_position < other.start_position;
+  }
+  return end_position < other.end_position;
+}
+
+
+bool RuntimeProfiler::GetProfileEntry(SharedFunctionInfo* shared,
+                                      ProfileEntry* entry) {
+  if (!shared->script()->IsScript()) return false;
+  Script* script = Script::cast(shared->script());
+  if (!script->source()->IsString()) return false;
+  entry->script_name_hash =
+      script->name()->IsString() ? String::cast(script->name())->Hash() : 0;
+  entry->script_length = String::cast(script->source())->length();
+  entry->start_position = shared->start_position();
+  entry->end_position = shared->end_position();
+  return true;
+}
+
+
+bool RuntimeProfiler::IsHotInProfile(SharedFunctionInfo* shared) {
+  ProfileEntry entry;
+  if (profile_.empty() || !GetProfileEntry(shared, &entry)) return false;
+  return std::binary_search(profile_.begin(), profile_.end(), entry);
+}
+
+
+std::vector<uint32_t> RuntimeProfiler::CreateProfile() {
+  std::vector<ProfileEntry> entries;
+  HeapIterator iterator(isolate_->heap());
+  for (HeapObject* obj = iterator.next(); obj != NULL; obj = iterator.next()) {
+    if (!obj->IsSharedFunctionInfo()) continue;
+    SharedFunctionInfo* shared = SharedFunctionInfo::cast(obj);
+    ProfileEntry entry;
+    if (shared->opt_count() > 0 && !shared->optimization_disabled() &&
+        GetProfileEntry(shared, &entry)) {
+      entries.push_back(entry);
+    }
+  }
+  std::vector<uint32_t> data;
+  data.push_back(kProfileMagic);
+  data.push_back(static_cast<uint32_t>(entries.size()));
+  for (const ProfileEntry& entry : entries) {
+    data.push_back(entry.script_name_hash);
+    data.push_back(entry.script_length);
+    data.push_back(entry.start_position);
+    data.push_back(entry.end_position);
+  }
+  return data;
+}
+
+
+bool RuntimeProfiler::SetProfile(const uint32_t* data, size_t length) {
+  if (length < 2 || data[0] != kProfileMagic ||
+      length != 2 + static_cast<size_t>(data[1]) * kEntryWords) {
+    return false;
+  }
+  profile_.clear();
+  for (size_t i = 2; i < length; i += kEntryWords) {
+    ProfileEntry entry = {data[i], data[i + 1], data[i + 2], data[i + 3]};
+    profile_.push_back(entry);
+  }
+  std::sort(profile_.begin(), profile_.end());
+  return true;
+}
+
+
 void RuntimeProfiler::MaybeOptimizeIgnition(JSFunction* function,
-                                            bool frame_optimized) {
+                                            JavaScriptFrame* frame) {
   if (function->IsInOptimizationQueue()) return;
 
   SharedFunctionInfo* shared = function->shared();
@@ -248,15 +368,18 @@ void RuntimeProfiler::MaybeOptimizeIgnition(JSFunction* function,
 
   // TODO(rmcilroy): Also ensure we only OSR top-level code if it is smaller
   // than kMaxToplevelSourceSize.
-  // TODO(rmcilroy): Consider whether we should optimize small functions when
-  // they are first seen on the stack (e.g., kMaxSizeEarlyOpt).
-
-  if (!frame_optimized && (function->IsMarkedForBaseline() ||
-                           function->IsMarkedForOptimization() ||
-                           function->IsMarkedForConcurrentOptimization() ||
-                           function->IsOptimized())) {
-    // TODO(rmcilroy): Support OSR in these cases.
 
+  if (FLAG_ignition_osr && FLAG_always_osr) {
+    AttemptOnStackReplacement(frame, Code::kMaxLoopNestingMarker);
+    // Fall through and do a normal optimized compile as well.
+  } else if (!frame->is_optimized() &&
+             (function->IsMarkedForBaseline() ||
+              function->IsMarkedForOptimization() ||
+              function->IsMarkedForConcurrentOptimization() ||
+              function->IsOptimized())) {
+    // Attempt OSR if we are still running interpreted code even though the
+    // the function has long been marked or even already been optimized.
+    if (FLAG_ignition_osr) AttemptOnStackReplacement(frame);
     return;
   }
 
@@ -275,7 +398,9 @@ void RuntimeProfiler::MaybeOptimizeIgnition(JSFunction* function,
 
   if (function->IsOptimized()) return;
 
-  if (ticks >= kProfilerTicksBeforeOptimization) {
+  // The ticks are counted on the SharedFunctionInfo and reset whenever an IC
+  // of the function changes state, see {IC::OnTypeFeedbackChanged}.
+  if (ticks >= thresholds_.ticks_before_optimization) {
     int typeinfo, generic, total, type_percentage, generic_percentage;
     GetICCounts(shared, &typeinfo, &generic, &total, &type_percentage,
                 &generic_percentage);
@@ -284,7 +409,7 @@ void RuntimeProfiler::MaybeOptimizeIgnition(JSFunction* function,
       // If this particular function hasn't had any ICs patched for enough
       // ticks, optimize it now.
       Optimize(function, "hot and stable");
-    } else if (ticks >= kTicksWhenNotEnoughTypeInfo) {
+    } else if (ticks >= thresholds_.ticks_when_not_enough_type_info) {
       Optimize(function, "not much type info but very hot");
     } else {
       if (FLAG_trace_opt_verbose) {
@@ -294,6 +419,18 @@ void RuntimeProfiler::MaybeOptimizeIgnition(JSFunction* function,
                type_percentage);
       }
     }
+  } else if (!any_ic_changed_ &&
+             shared->bytecode_array()->length() <
+                 thresholds_.max_bytecode_size_for_early_opt) {
+    // If no IC was patched since the last tick and this function is very
+    // small, optimistically optimize it now.
+    int typeinfo, generic, total, type_percentage, generic_percentage;
+    GetICCounts(shared, &typeinfo, &generic, &total, &type_percentage,
+                &generic_percentage);
+    if (type_percentage >= FLAG_type_info_threshold &&
+        generic_percentage <= FLAG_generic_ic_threshold) {
+      Optimize(function, "small function");
+    }
   }
 }
 
@@ -304,6 +441,12 @@ void RuntimeProfiler::MarkCandidatesForOptimization() {
 
   DisallowHeapAllocation no_gc;
 
+  OptimizingCompileDispatcher* dispatcher =
+      isolate_->concurrent_recompilation_enabled()
+          ? isolate_->optimizing_compile_dispatcher()
+          : nullptr;
+  if (dispatcher != nullptr) dispatcher->DropStaleJobs();
+
   // Run through the JavaScript frames and collect them. If we already
   // have a sample of the function, we mark it for optimizations
   // (eagerly or lazily).
@@ -325,10 +468,14 @@ void RuntimeProfiler::MarkCandidatesForOptimization() {
       }
     }
 
+    if (dispatcher != nullptr && function->IsInOptimizationQueue()) {
+      dispatcher->NotifyQueuedFunctionIsHot(function, frame_count == 1);
+    }
+
     if (frame->is_interpreted()) {
-      MaybeOptimizeIgnition(function, frame->is_optimized());
+      MaybeOptimizeIgnition(function, frame);
     } else {
-      MaybeOptimizeFullCodegen(function, frame_count, frame->is_optimized());
+      MaybeOptimizeFullCodegen(function, frame, frame_count);
     }
   }
   any_ic_changed_ = false;
@@ -5,28 +5,74 @@
 #ifndef V8_RUNTIME_PROFILER_H_
 #define V8_RUNTIME_PROFILER_H_
 
+#include <vector>
+
 #include "src/allocation.h"
 
 namespace v8 {
 namespace internal {
 
 class Isolate;
+class JavaScriptFrame;
 class JSFunction;
+class SharedFunctionInfo;
 
 class RuntimeProfiler {
  public:
+  // Tick counts and code sizes that decide when a function tiers up. They are
+  // initialized from the flags and can be tuned per isolate.
+  struct Thresholds {
+    // Number of ticks without type feedback changes before a function with
+    // enough type info is optimized.
+    int ticks_before_optimization;
+    // Number of ticks after which a function is optimized even if it has not
+    // collected enough type info.
+    int ticks_when_not_enough_type_info;
+    // Functions smaller than this are optimized on their first tick if no
+    // type feedback changed since the last tick.
+    int max_code_size_for_early_opt;
+    int max_bytecode_size_for_early_opt;
+  };
+
   explicit RuntimeProfiler(Isolate* isolate);
 
+  const Thresholds& thresholds() const { return thresholds_; }
+  void set_thresholds(const Thresholds& thresholds);
+
   void MarkCandidatesForOptimization();
 
   void NotifyICChanged() { any_ic_changed_ = true; }
 
-  void AttemptOnStackReplacement(JSFunction* function, int nesting_levels = 1);
+  void AttemptOnStackReplacement(JavaScriptFrame* frame,
+                                 int nesting_levels = 1);
+
+  // Returns the functions that have been optimized in this isolate, encoded
+  // so that another process can pass them to SetProfile.
+  std::vector<uint32_t> CreateProfile();
+  // Functions of the profile are optimized on their first tick instead of
+  // once they are found to be hot. Returns false if the data is invalid.
+  bool SetProfile(const uint32_t* data, size_t length);
 
  private:
-  void MaybeOptimizeFullCodegen(JSFunction* function, int frame_count,
-                                bool frame_optimized);
-  void MaybeOptimizeIgnition(JSFunction* function, bool frame_optimized);
+  // Identifies a function across processes by its script and its position
+  // in the script.
+  struct ProfileEntry {
+    uint32_t script_name_hash;
+    uint32_t script_length;
+    uint32_t start_position;
+    uint32_t end_position;
+
+    bool operator<(const ProfileEntry& other) const;
+  };
+  static const int kEntryWords = 4;
+  static const uint32_t kProfileMagic = 0x50524f46;
+
+  static bool GetProfileEntry(SharedFunctionInfo* shared, ProfileEntry* entry);
+  bool IsHotInProfile(SharedFunctionInfo* shared);
+
+  void MaybeOptimizeFullCodegen(JSFunction* function, JavaScriptFrame* frame,
+                                int frame_count);
+  void MaybeOptimizeIgnition(JSFunction* function, JavaScriptFrame* frame);
   void Optimize(JSFunction* function, const char* reason);
 
   bool CodeSizeOKForOSR(Code* shared_code);
@@ -34,6 +80,9 @@ class RuntimeProfiler {
   Isolate* isolate_;
 
   bool any_ic_changed_;
+  Thresholds thresholds_;
+  // Sorted entries of the profile passed to SetProfile.
+  std::vector<ProfileEntry> profile_;
 };
 
 }  // namespace internal
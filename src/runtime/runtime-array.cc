@@ -31,18 +31,24 @@ RUNTIME_FUNCTION(Runtime_FinishArrayPrototypeSetup) {
 }
 
 static void InstallCode(Isolate* isolate, Handle<JSObject> holder,
-                        const char* name, Handle<Code> code) {
+                        const char* name, Handle<Code> code, int argc = -1) {
   Handle<String> key = isolate->factory()->InternalizeUtf8String(name);
   Handle<JSFunction> optimized =
       isolate->factory()->NewFunctionWithoutPrototype(key, code);
-  optimized->shared()->DontAdaptArguments();
+  if (argc < 0) {
+    optimized->shared()->DontAdaptArguments();
+  } else {
+    optimized->shared()->set_internal_formal_parameter_count(argc);
+  }
   JSObject::AddProperty(holder, key, optimized, NONE);
 }
 
 static void InstallBuiltin(Isolate* isolate, Handle<JSObject> holder,
-                           const char* name, Builtins::Name builtin_name) {
+                           const char* name, Builtins::Name builtin_name,
+                           int argc = -1) {
   InstallCode(isolate, holder, name,
-              handle(isolate->builtins()->builtin(builtin_name), isolate));
+              handle(isolate->builtins()->builtin(builtin_name), isolate),
+              argc);
 }
 
 RUNTIME_FUNCTION(Runtime_SpecialArrayFunctions) {
@@ -51,10 +57,10 @@ RUNTIME_FUNCTION(Runtime_SpecialArrayFunctions) {
   Handle<JSObject> holder =
       isolate->factory()->NewJSObject(isolate->object_function());
 
-  InstallBuiltin(isolate, holder, "pop", Builtins::kArrayPop);
+  InstallBuiltin(isolate, holder, "pop", Builtins::kArrayPrototypePop, 0);
   FastArrayPushStub stub(isolate);
   InstallCode(isolate, holder, "push", stub.GetCode());
-  InstallBuiltin(isolate, holder, "shift", Builtins::kArrayShift);
+  InstallBuiltin(isolate, holder, "shift", Builtins::kArrayPrototypeShift, 0);
   InstallBuiltin(isolate, holder, "unshift", Builtins::kArrayUnshift);
   InstallBuiltin(isolate, holder, "slice", Builtins::kArraySlice);
   InstallBuiltin(isolate, holder, "splice", Builtins::kArraySplice);
@@ -498,5 +504,63 @@ RUNTIME_FUNCTION(Runtime_ArraySpeciesConstructor) {
   return *constructor;
 }
 
+
+namespace {
+
+// Returns true if the value at |name| of |holder| is found on |holder| itself
+// as a plain data property with value |expected|. Accessors are not called.
+bool HasOwnDataValue(Handle<JSObject> holder, Handle<Name> name,
+                     Handle<Object> expected) {
+  LookupIterator it(holder, name, holder, LookupIterator::OWN);
+  return it.state() == LookupIterator::DATA &&
+         *it.GetDataValue() == *expected;
+}
+
+
+// Spreading |spread| gives its elements in order, without observable side
+// effects, if it is an array whose iteration protocol is unmodified and
+// whose holes, if any, read as undefined.
+bool IsFastSpread(Isolate* isolate, Handle<Object> spread) {
+  if (!spread->IsJSArray()) return false;
+  Handle<JSArray> array = Handle<JSArray>::cast(spread);
+  ElementsKind kind = array->GetElementsKind();
+  if (!IsFastElementsKind(kind)) return false;
+  if (IsFastHoleyElementsKind(kind) &&
+      !isolate->IsFastArrayConstructorPrototypeChainIntact()) {
+    return false;
+  }
+  Handle<JSObject> array_prototype = isolate->initial_array_prototype();
+  if (array->map()->prototype() != *array_prototype) return false;
+  Handle<Symbol> iterator_symbol = isolate->factory()->iterator_symbol();
+  LookupIterator it(array, iterator_symbol, array, LookupIterator::OWN);
+  if (it.state() != LookupIterator::NOT_FOUND) return false;
+  return HasOwnDataValue(array_prototype, iterator_symbol,
+                         isolate->array_values_iterator()) &&
+         HasOwnDataValue(isolate->array_iterator_prototype(),
+                         isolate->factory()->next_string(),
+                         isolate->array_iterator_next());
+}
+
+}  // namespace
+
+
+// Prepares the single spread argument of a call f(...spread) for the Apply
+// builtin. Arrays that are iterated without observable side effects are
+// passed on as they are, so their elements go directly onto the stack.
+// Everything else is iterated into a fresh list.
+RUNTIME_FUNCTION(Runtime_SpreadIterablePrepare) {
+  HandleScope scope(isolate);
+  DCHECK(args.length() == 1);
+  CONVERT_ARG_HANDLE_CHECKED(Object, spread, 0);
+  if (IsFastSpread(isolate, spread)) return *spread;
+  Handle<JSFunction> spread_iterable = isolate->spread_iterable();
+  Handle<Object> result;
+  ASSIGN_RETURN_FAILURE_ON_EXCEPTION(
+      isolate, result,
+      Execution::Call(isolate, spread_iterable,
+                      isolate->factory()->undefined_value(), 1, &spread));
+  return *result;
+}
+
 }  // namespace internal
 }  // namespace v8
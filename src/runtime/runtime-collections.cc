@@ -140,6 +140,27 @@ RUNTIME_FUNCTION(Runtime_SetIteratorDetails) {
 }
 
 
+// Slow path of the Set.prototype.has builtin.
+RUNTIME_FUNCTION(Runtime_SetHas) {
+  HandleScope scope(isolate);
+  DCHECK(args.length() == 2);
+  CONVERT_ARG_HANDLE_CHECKED(Object, receiver, 0);
+  CONVERT_ARG_HANDLE_CHECKED(Object, key, 1);
+  if (!receiver->IsJSSet()) {
+    THROW_NEW_ERROR_RETURN_FAILURE(
+        isolate,
+        NewTypeError(MessageTemplate::kIncompatibleMethodReceiver,
+                     isolate->factory()->NewStringFromAsciiChecked(
+                         "Set.prototype.has"),
+                     receiver));
+  }
+  OrderedHashSet* table =
+      OrderedHashSet::cast(Handle<JSSet>::cast(receiver)->table());
+  return isolate->heap()->ToBoolean(table->FindEntry(*key) !=
+                                    OrderedHashSet::kNotFound);
+}
+
+
 RUNTIME_FUNCTION(Runtime_MapInitialize) {
   HandleScope scope(isolate);
   DCHECK(args.length() == 1);
@@ -180,6 +201,51 @@ RUNTIME_FUNCTION(Runtime_MapGrow) {
 }
 
 
+// Slow path of the Map.prototype.get builtin.
+RUNTIME_FUNCTION(Runtime_MapGet) {
+  HandleScope scope(isolate);
+  DCHECK(args.length() == 2);
+  CONVERT_ARG_HANDLE_CHECKED(Object, receiver, 0);
+  CONVERT_ARG_HANDLE_CHECKED(Object, key, 1);
+  if (!receiver->IsJSMap()) {
+    THROW_NEW_ERROR_RETURN_FAILURE(
+        isolate,
+        NewTypeError(MessageTemplate::kIncompatibleMethodReceiver,
+                     isolate->factory()->NewStringFromAsciiChecked(
+                         "Map.prototype.get"),
+                     receiver));
+  }
+  OrderedHashMap* table =
+      OrderedHashMap::cast(Handle<JSMap>::cast(receiver)->table());
+  int entry = table->FindEntry(*key);
+  if (entry == OrderedHashMap::kNotFound) {
+    return isolate->heap()->undefined_value();
+  }
+  return table->ValueAt(entry);
+}
+
+
+// Slow path of the Map.prototype.has builtin.
+RUNTIME_FUNCTION(Runtime_MapHas) {
+  HandleScope scope(isolate);
+  DCHECK(args.length() == 2);
+  CONVERT_ARG_HANDLE_CHECKED(Object, receiver, 0);
+  CONVERT_ARG_HANDLE_CHECKED(Object, key, 1);
+  if (!receiver->IsJSMap()) {
+    THROW_NEW_ERROR_RETURN_FAILURE(
+        isolate,
+        NewTypeError(MessageTemplate::kIncompatibleMethodReceiver,
+                     isolate->factory()->NewStringFromAsciiChecked(
+                         "Map.prototype.has"),
+                     receiver));
+  }
+  OrderedHashMap* table =
+      OrderedHashMap::cast(Handle<JSMap>::cast(receiver)->table());
+  return isolate->heap()->ToBoolean(table->FindEntry(*key) !=
+                                    OrderedHashMap::kNotFound);
+}
+
+
 RUNTIME_FUNCTION(Runtime_MapIteratorInitialize) {
   HandleScope scope(isolate);
   DCHECK(args.length() == 3);
@@ -9,8 +9,10 @@
 #include "src/deoptimizer.h"
 #include "src/frames-inl.h"
 #include "src/full-codegen/full-codegen.h"
+#include "src/interpreter/bytecode-array-iterator.h"
 #include "src/isolate-inl.h"
 #include "src/messages.h"
+#include "src/snapshot/snapshot.h"
 #include "src/v8threads.h"
 #include "src/vm-state-inl.h"
 
@@ -79,6 +81,31 @@ RUNTIME_FUNCTION(Runtime_CompileOptimized_NotConcurrent) {
   return function->code();
 }
 
+RUNTIME_FUNCTION(Runtime_DeserializeLazy) {
+  HandleScope scope(isolate);
+  DCHECK_EQ(1, args.length());
+  CONVERT_ARG_HANDLE_CHECKED(JSFunction, function, 0);
+
+  // The function was entered through the placeholder of a builtin that is
+  // deserialized lazily. The placeholder knows which builtin it stands for.
+  Handle<Code> placeholder(function->code(), isolate);
+  DCHECK(Builtins::IsLazy(placeholder->builtin_index()));
+  Builtins::Name name =
+      static_cast<Builtins::Name>(placeholder->builtin_index());
+  // Other functions with the same builtin may have deserialized it already.
+  if (isolate->builtins()->builtin(name) == *placeholder) {
+    Snapshot::DeserializeBuiltin(isolate, name);
+  }
+
+  Code* code = isolate->builtins()->builtin(name);
+  DCHECK_NE(*placeholder, code);
+  if (function->shared()->code() == *placeholder) {
+    function->shared()->set_code(code);
+  }
+  function->set_code(code);
+  return code;
+}
+
 
 RUNTIME_FUNCTION(Runtime_NotifyStubFailure) {
   HandleScope scope(isolate);
@@ -112,6 +139,38 @@ class ActivationsFinder : public ThreadVisitor {
 };
 
 
+namespace {
+
+// Called once the deoptimized frames are complete, because the callback
+// may allocate.
+void ReportDeoptimization(Isolate* isolate, Handle<JSFunction> function,
+                          Deoptimizer::BailoutType type,
+                          const Deoptimizer::DeoptInfo& deopt_info) {
+  STATIC_ASSERT(static_cast<int>(v8::kDeoptimizationEager) ==
+                Deoptimizer::EAGER);
+  STATIC_ASSERT(static_cast<int>(v8::kDeoptimizationLazy) ==
+                Deoptimizer::LAZY);
+  STATIC_ASSERT(static_cast<int>(v8::kDeoptimizationSoft) ==
+                Deoptimizer::SOFT);
+  // Tracked positions are relative to the start of the inlined function
+  // they belong to, only those in the deoptimized function are reported.
+  SourcePosition deopt_position = deopt_info.position;
+  int position = v8::Message::kNoColumnInfo;
+  if (!deopt_position.IsUnknown()) {
+    if (!FLAG_hydrogen_track_positions) {
+      position = static_cast<int>(deopt_position.raw());
+    } else if (deopt_position.inlining_id() == 0) {
+      position = function->shared()->start_position() +
+                 static_cast<int>(deopt_position.position());
+    }
+  }
+  isolate->ReportDeoptimization(
+      function, static_cast<v8::DeoptimizationType>(type),
+      Deoptimizer::GetDeoptReason(deopt_info.deopt_reason), position);
+}
+
+}  // namespace
+
 RUNTIME_FUNCTION(Runtime_NotifyDeoptimized) {
   HandleScope scope(isolate);
   DCHECK(args.length() == 1);
@@ -128,6 +187,8 @@ RUNTIME_FUNCTION(Runtime_NotifyDeoptimized) {
 
   DCHECK(optimized_code->kind() == Code::OPTIMIZED_FUNCTION);
   DCHECK(type == deoptimizer->bailout_type());
+  Deoptimizer::DeoptInfo deopt_info =
+      Deoptimizer::GetDeoptInfo(*optimized_code, deoptimizer->from());
 
   // Make sure to materialize objects before causing any allocation.
   JavaScriptFrameIterator it(isolate);
@@ -140,6 +201,7 @@ RUNTIME_FUNCTION(Runtime_NotifyDeoptimized) {
   isolate->set_context(Context::cast(top_frame->context()));
 
   if (type == Deoptimizer::LAZY) {
+    ReportDeoptimization(isolate, function, type, deopt_info);
     return isolate->heap()->undefined_value();
   }
 
@@ -171,6 +233,7 @@ RUNTIME_FUNCTION(Runtime_NotifyDeoptimized) {
     Deoptimizer::DeoptimizeFunction(*function);
   }
 
+  ReportDeoptimization(isolate, function, type, deopt_info);
   return isolate->heap()->undefined_value();
 }
 
@@ -193,37 +256,76 @@ static bool IsSuitableForOnStackReplacement(Isolate* isolate,
 }
 
 
-RUNTIME_FUNCTION(Runtime_CompileForOnStackReplacement) {
-  HandleScope scope(isolate);
-  DCHECK(args.length() == 1);
-  CONVERT_ARG_HANDLE_CHECKED(JSFunction, function, 0);
-  Handle<Code> caller_code(function->shared()->code());
+namespace {
 
-  // We're not prepared to handle a function with arguments object.
-  DCHECK(!function->shared()->uses_arguments());
+BailoutId DetermineEntryAndDisarmOSRForBaseline(JavaScriptFrame* frame) {
+  Handle<Code> caller_code(frame->function()->shared()->code());
 
-  RUNTIME_ASSERT(FLAG_use_osr);
-
-  // Passing the PC in the javascript frame from the caller directly is
+  // Passing the PC in the JavaScript frame from the caller directly is
   // not GC safe, so we walk the stack to get it.
-  JavaScriptFrameIterator it(isolate);
-  JavaScriptFrame* frame = it.frame();
   if (!caller_code->contains(frame->pc())) {
     // Code on the stack may not be the code object referenced by the shared
     // function info.  It may have been replaced to include deoptimization data.
     caller_code = Handle<Code>(frame->LookupCode());
   }
 
+  DCHECK_EQ(frame->LookupCode(), *caller_code);
+  DCHECK_EQ(Code::FUNCTION, caller_code->kind());
+  DCHECK(caller_code->contains(frame->pc()));
+
+  // Revert the patched back edge table, regardless of whether OSR succeeds.
+  BackEdgeTable::Revert(frame->isolate(), *caller_code);
+
   uint32_t pc_offset =
       static_cast<uint32_t>(frame->pc() - caller_code->instruction_start());
+  return caller_code->TranslatePcOffsetToAstId(pc_offset);
+}
 
-#ifdef DEBUG
-  DCHECK_EQ(frame->function(), *function);
-  DCHECK_EQ(frame->LookupCode(), *caller_code);
-  DCHECK(caller_code->contains(frame->pc()));
-#endif  // DEBUG
+BailoutId DetermineEntryAndDisarmOSRForInterpreter(JavaScriptFrame* frame) {
+  InterpretedFrame* iframe = reinterpret_cast<InterpretedFrame*>(frame);
+
+  // Note that the bytecode array active on the stack might be different from
+  // the one installed on the function (e.g. patched by debugger). This however
+  // is fine because we guarantee the layout to be in sync, hence any offset
+  // used for OSR is valid on both.
+  Handle<BytecodeArray> bytecode(iframe->GetBytecodeArray());
+
+  // Reset the OSR loop nesting depth to disarm back edges.
+  bytecode->set_osr_loop_nesting_level(0);
+
+  // The current bytecode is the {OsrPoll} that triggered on-stack replacement,
+  // it is always directly followed by the {Jump} to the loop header. The
+  // offset of that loop header serves as the bailout id of the OSR entry.
+  int osr_poll_offset = iframe->GetBytecodeOffset();
+  interpreter::BytecodeArrayIterator iterator(bytecode);
+  while (iterator.current_offset() < osr_poll_offset) iterator.Advance();
+  DCHECK_EQ(osr_poll_offset, iterator.current_offset());
+  DCHECK_EQ(interpreter::Bytecode::kOsrPoll, iterator.current_bytecode());
+  iterator.Advance();
+  DCHECK(interpreter::Bytecodes::IsJump(iterator.current_bytecode()));
+  return BailoutId(iterator.GetJumpTargetOffset());
+}
+
+}  // namespace
 
-  BailoutId ast_id = caller_code->TranslatePcOffsetToAstId(pc_offset);
+RUNTIME_FUNCTION(Runtime_CompileForOnStackReplacement) {
+  HandleScope scope(isolate);
+  DCHECK(args.length() == 1);
+  CONVERT_ARG_HANDLE_CHECKED(JSFunction, function, 0);
+
+  // We're not prepared to handle a function with arguments object.
+  DCHECK(!function->shared()->uses_arguments());
+
+  RUNTIME_ASSERT(FLAG_use_osr);
+
+  // Determine the entry point for which this OSR request has been fired and
+  // also disarm all back edges in the calling code to stop new requests.
+  JavaScriptFrameIterator it(isolate);
+  JavaScriptFrame* frame = it.frame();
+  DCHECK_EQ(frame->function(), *function);
+  BailoutId ast_id = frame->is_interpreted()
+                         ? DetermineEntryAndDisarmOSRForInterpreter(frame)
+                         : DetermineEntryAndDisarmOSRForBaseline(frame);
   DCHECK(!ast_id.IsNone());
 
   MaybeHandle<Code> maybe_result;
@@ -236,9 +338,6 @@ RUNTIME_FUNCTION(Runtime_CompileForOnStackReplacement) {
     maybe_result = Compiler::GetOptimizedCodeForOSR(function, ast_id, frame);
   }
 
-  // Revert the patched back edge table, regardless of whether OSR succeeds.
-  BackEdgeTable::Revert(isolate, *caller_code);
-
   // Check whether we ended up with usable optimized code.
   Handle<Code> result;
   if (maybe_result.ToHandle(&result) &&
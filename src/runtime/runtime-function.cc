@@ -88,11 +88,18 @@ RUNTIME_FUNCTION(Runtime_FunctionGetScriptSourcePosition) {
 
 
 RUNTIME_FUNCTION(Runtime_FunctionGetPositionForOffset) {
-  SealHandleScope shs(isolate);
-  DCHECK(args.length() == 2);
+  HandleScope scope(isolate);
+  DCHECK(args.length() == 3);
 
-  CONVERT_ARG_CHECKED(AbstractCode, abstract_code, 0);
-  CONVERT_NUMBER_CHECKED(int, offset, Int32, args[1]);
+  CONVERT_ARG_HANDLE_CHECKED(JSFunction, fun, 0);
+  CONVERT_ARG_HANDLE_CHECKED(AbstractCode, abstract_code, 1);
+  CONVERT_NUMBER_CHECKED(int, offset, Int32, args[2]);
+  // Stack traces record bytecode offsets only, positions omitted from the
+  // bytecode are recovered when the stack trace is formatted.
+  if (abstract_code->IsBytecodeArray()) {
+    Handle<BytecodeArray> bytecode(abstract_code->GetBytecodeArray());
+    Compiler::CollectSourcePositions(handle(fun->shared()), bytecode);
+  }
   return Smi::FromInt(abstract_code->SourcePosition(offset));
 }
 
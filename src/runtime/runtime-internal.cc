@@ -10,9 +10,11 @@
 #include "src/conversions.h"
 #include "src/debug/debug.h"
 #include "src/frames-inl.h"
+#include "src/ic/ic-stats.h"
 #include "src/isolate-inl.h"
 #include "src/messages.h"
 #include "src/parsing/parser.h"
+#include "src/wasm/wasm-module.h"
 
 namespace v8 {
 namespace internal {
@@ -104,6 +106,22 @@ RUNTIME_FUNCTION(Runtime_ThrowWasmError) {
       isolate, NewError(static_cast<MessageTemplate::Template>(message_id)));
 }
 
+RUNTIME_FUNCTION(Runtime_WasmCompileLazy) {
+  HandleScope scope(isolate);
+  DCHECK_EQ(0, args.length());
+  // The caller is the lazy compile stub of the function to compile.
+  StackFrameIterator it(isolate);
+  DCHECK(it.frame()->is_exit());
+  it.Advance();
+  DCHECK(it.frame()->is_wasm());
+  Handle<Code> stub(it.frame()->LookupCode(), isolate);
+  Handle<Code> code;
+  if (!wasm::CompileLazy(isolate, stub).ToHandle(&code)) {
+    return isolate->PromoteScheduledException();
+  }
+  return *code;
+}
+
 RUNTIME_FUNCTION(Runtime_UnwindAndFindExceptionHandler) {
   SealHandleScope shs(isolate);
   DCHECK(args.length() == 0);
@@ -503,6 +521,18 @@ RUNTIME_FUNCTION(Runtime_GetAndResetRuntimeCallStats) {
   return *result;
 }
 
+RUNTIME_FUNCTION(Runtime_GetAndResetICStats) {
+  HandleScope scope(isolate);
+  DCHECK_EQ(0, args.length());
+  std::stringstream stats_stream;
+  ICStats* stats = isolate->GetICStats();
+  stats->Print(stats_stream, std::numeric_limits<size_t>::max());
+  Handle<String> result =
+      isolate->factory()->NewStringFromAsciiChecked(stats_stream.str().c_str());
+  stats->Reset();
+  return *result;
+}
+
 RUNTIME_FUNCTION(Runtime_EnqueueMicrotask) {
   HandleScope scope(isolate);
   DCHECK(args.length() == 1);
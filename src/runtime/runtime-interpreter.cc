@@ -168,5 +168,13 @@ RUNTIME_FUNCTION(Runtime_InterpreterSetPendingMessage) {
   return isolate->heap()->undefined_value();
 }
 
+RUNTIME_FUNCTION(Runtime_InterpreterAllocateFeedbackVector) {
+  HandleScope scope(isolate);
+  DCHECK_EQ(1, args.length());
+  CONVERT_ARG_HANDLE_CHECKED(JSFunction, function, 0);
+  SharedFunctionInfo::EnsureFeedbackVector(handle(function->shared()));
+  return isolate->heap()->undefined_value();
+}
+
 }  // namespace internal
 }  // namespace v8
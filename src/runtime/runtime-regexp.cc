@@ -767,6 +767,81 @@ RUNTIME_FUNCTION(Runtime_StringSplit) {
 }
 
 
+// Splits a non-empty |subject| at the matches of a non-sticky |regexp|.
+// This gives the same result as the matching loop in RegExpSplit, but scans
+// with a single GlobalCache instead of one exec call per separator, and only
+// updates the last match info once, after the last match.
+RUNTIME_FUNCTION(Runtime_RegExpSplit) {
+  HandleScope handle_scope(isolate);
+  DCHECK(args.length() == 4);
+  CONVERT_ARG_HANDLE_CHECKED(JSRegExp, regexp, 0);
+  CONVERT_ARG_HANDLE_CHECKED(String, subject, 1);
+  CONVERT_NUMBER_CHECKED(uint32_t, limit, Uint32, args[2]);
+  CONVERT_ARG_HANDLE_CHECKED(JSArray, last_match_info, 3);
+  RUNTIME_ASSERT(limit > 0);
+  RUNTIME_ASSERT(subject->length() > 0);
+  RUNTIME_ASSERT((regexp->GetFlags() & JSRegExp::kSticky) == 0);
+  RUNTIME_ASSERT(last_match_info->HasFastObjectElements());
+
+  subject = String::Flatten(subject);
+  int subject_length = subject->length();
+  int capture_count = regexp->CaptureCount();
+
+  RegExpImpl::GlobalCache global_cache(regexp, subject, isolate);
+  if (global_cache.HasException()) return isolate->heap()->exception();
+
+  static const int kInitialPartCapacity = 16;
+  FixedArrayBuilder builder(isolate, kInitialPartCapacity);
+
+  int part_start = 0;
+  bool matched = false;
+  while (static_cast<uint32_t>(builder.length()) < limit) {
+    int32_t* current_match = global_cache.FetchNext();
+    if (current_match == NULL) break;
+    matched = true;
+    int match_start = current_match[0];
+    int match_end = current_match[1];
+    if (match_start == subject_length) break;
+    // An empty match at the start of the current part does not split it.
+    if (match_end == part_start) continue;
+
+    builder.EnsureCapacity(1 + capture_count);
+    // Avoid accumulating new handles inside loop.
+    HandleScope temp_scope(isolate);
+    builder.Add(
+        *isolate->factory()->NewSubString(subject, part_start, match_start));
+    for (int i = 1; i <= capture_count; i++) {
+      if (static_cast<uint32_t>(builder.length()) == limit) break;
+      int start = current_match[i * 2];
+      if (start >= 0) {
+        int end = current_match[i * 2 + 1];
+        builder.Add(*isolate->factory()->NewSubString(subject, start, end));
+      } else {
+        builder.Add(isolate->heap()->undefined_value());
+      }
+    }
+    part_start = match_end;
+  }
+
+  if (global_cache.HasException()) return isolate->heap()->exception();
+
+  if (static_cast<uint32_t>(builder.length()) < limit) {
+    builder.EnsureCapacity(1);
+    builder.Add(*isolate->factory()->NewSubString(subject, part_start,
+                                                  subject_length));
+  }
+
+  if (matched) {
+    RegExpImpl::SetLastMatchInfo(last_match_info, subject, capture_count,
+                                 global_cache.LastSuccessfulMatch());
+  }
+
+  Handle<FixedArray> parts = builder.array();
+  parts->Shrink(builder.length());
+  return *isolate->factory()->NewJSArrayWithElements(parts);
+}
+
+
 RUNTIME_FUNCTION(Runtime_RegExpExec) {
   HandleScope scope(isolate);
   DCHECK(args.length() == 4);
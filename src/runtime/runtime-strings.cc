@@ -16,6 +16,38 @@ namespace v8 {
 namespace internal {
 
 
+// Searches the pieces of a rope one by one for a single character, which
+// cannot span two pieces, so that the rope does not have to be flattened.
+static int ConsStringCharacterMatch(Isolate* isolate, ConsString* subject,
+                                    uc16 pattern_char, int start_index) {
+  DisallowHeapAllocation no_gc;
+  const uint8_t one_byte_pattern[] = {static_cast<uint8_t>(pattern_char)};
+  Vector<const uint8_t> one_byte_vector(one_byte_pattern, 1);
+  Vector<const uc16> two_byte_vector(&pattern_char, 1);
+  ConsStringIterator iter(subject, start_index);
+  int consumed = start_index;
+  int offset;
+  for (String* piece = iter.Next(&offset); piece != NULL;
+       piece = iter.Next(&offset)) {
+    // |offset| is only non-zero for the piece holding |start_index|.
+    int piece_start = consumed - offset;
+    consumed = piece_start + piece->length();
+    String::FlatContent content = piece->GetFlatContent();
+    int index;
+    if (content.IsOneByte()) {
+      if (pattern_char > String::kMaxOneByteCharCode) continue;
+      index = SearchString(isolate, content.ToOneByteVector(),
+                           one_byte_vector, offset);
+    } else {
+      index = SearchString(isolate, content.ToUC16Vector(), two_byte_vector,
+                           offset);
+    }
+    if (index != -1) return piece_start + index;
+  }
+  return -1;
+}
+
+
 // Perform string match of pattern on subject, starting at start index.
 // Caller must ensure that 0 <= start_index <= sub->length(),
 // and should check that pat->length() + start_index <= sub->length().
@@ -30,6 +62,11 @@ int StringMatch(Isolate* isolate, Handle<String> sub, Handle<String> pat,
   int subject_length = sub->length();
   if (start_index + pattern_length > subject_length) return -1;
 
+  if (pattern_length == 1 && !sub->IsFlat()) {
+    return ConsStringCharacterMatch(isolate, ConsString::cast(*sub),
+                                    pat->Get(0), start_index);
+  }
+
   sub = String::Flatten(sub);
   pat = String::Flatten(pat);
 
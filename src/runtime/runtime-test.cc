@@ -132,20 +132,17 @@ RUNTIME_FUNCTION(Runtime_OptimizeOsr) {
   RUNTIME_ASSERT(args.length() == 0 || args.length() == 1);
   Handle<JSFunction> function = Handle<JSFunction>::null();
 
+  // Find the JavaScript function on the top of the stack.
+  JavaScriptFrameIterator it(isolate);
   if (args.length() == 0) {
-    // Find the JavaScript function on the top of the stack.
-    JavaScriptFrameIterator it(isolate);
-    while (!it.done()) {
-      if (it.frame()->is_java_script()) {
-        function = Handle<JSFunction>(it.frame()->function());
-        break;
-      }
-    }
-    if (function.is_null()) return isolate->heap()->undefined_value();
+    if (it.done()) return isolate->heap()->undefined_value();
+    function = Handle<JSFunction>(it.frame()->function());
   } else {
-    // Function was passed as an argument.
+    // Function was passed as an argument, find its topmost activation.
     CONVERT_ARG_HANDLE_CHECKED(JSFunction, arg, 0);
     function = arg;
+    while (!it.done() && it.frame()->function() != *function) it.Advance();
+    if (it.done()) return isolate->heap()->undefined_value();
   }
 
   // The following assertion was lifted from the DCHECK inside
@@ -155,7 +152,7 @@ RUNTIME_FUNCTION(Runtime_OptimizeOsr) {
 
   // If function is interpreted, just return. OSR is not supported.
   // TODO(4764): Remove this check when OSR is enabled in the interpreter.
-  if (function->shared()->HasBytecodeArray()) {
+  if (function->shared()->HasBytecodeArray() && !FLAG_ignition_osr) {
     return isolate->heap()->undefined_value();
   }
 
@@ -163,10 +160,13 @@ RUNTIME_FUNCTION(Runtime_OptimizeOsr) {
   if (function->IsOptimized()) return isolate->heap()->undefined_value();
 
   Code* unoptimized = function->shared()->code();
-  if (unoptimized->kind() == Code::FUNCTION) {
+  if (it.frame()->is_interpreted()) {
+    isolate->runtime_profiler()->AttemptOnStackReplacement(
+        it.frame(), Code::kMaxLoopNestingMarker);
+  } else if (unoptimized->kind() == Code::FUNCTION) {
     DCHECK(BackEdgeTable::Verify(isolate, unoptimized));
     isolate->runtime_profiler()->AttemptOnStackReplacement(
-        *function, Code::kMaxLoopNestingMarker);
+        it.frame(), Code::kMaxLoopNestingMarker);
   }
 
   return isolate->heap()->undefined_value();
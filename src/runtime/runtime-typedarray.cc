@@ -4,7 +4,11 @@
 
 #include "src/runtime/runtime-utils.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "src/arguments.h"
+#include "src/base/smart-pointers.h"
 #include "src/factory.h"
 #include "src/messages.h"
 #include "src/objects-inl.h"
@@ -299,18 +303,70 @@ RUNTIME_FUNCTION(Runtime_TypedArrayGetBuffer) {
 // Return codes for Runtime_TypedArraySetFastCases.
 // Should be synchronized with typedarray.js natives.
 enum TypedArraySetResultCodes {
-  // Set from typed array of the same type.
+  // Set from typed array.
   // This is processed by TypedArraySetFastCases
-  TYPED_ARRAY_SET_TYPED_ARRAY_SAME_TYPE = 0,
-  // Set from typed array of the different type, overlapping in memory.
-  TYPED_ARRAY_SET_TYPED_ARRAY_OVERLAPPING = 1,
-  // Set from typed array of the different type, non-overlapping.
-  TYPED_ARRAY_SET_TYPED_ARRAY_NONOVERLAPPING = 2,
+  TYPED_ARRAY_SET_TYPED_ARRAY = 0,
   // Set from non-typed array.
-  TYPED_ARRAY_SET_NON_TYPED_ARRAY = 3
+  TYPED_ARRAY_SET_NON_TYPED_ARRAY = 1
 };
 
 
+namespace {
+
+// Converts |length| elements of type SourceType to the element type of
+// TargetTraits, with the same conversions as storing each element with a
+// keyed store. The loops are simple enough for the C++ compiler to
+// vectorize them.
+template <typename SourceType, typename TargetTraits>
+void ConvertTypedArrayElements(const void* source, void* target,
+                               size_t length) {
+  typedef typename TargetTraits::ElementType TargetType;
+  const SourceType* source_elements = static_cast<const SourceType*>(source);
+  TargetType* target_elements = static_cast<TargetType*>(target);
+  for (size_t i = 0; i < length; i++) {
+    target_elements[i] = FixedTypedArray<TargetTraits>::from_double(
+        static_cast<double>(source_elements[i]));
+  }
+}
+
+
+template <typename SourceType>
+void ConvertTypedArrayElements(ExternalArrayType target_type,
+                               const void* source, void* target,
+                               size_t length) {
+  switch (target_type) {
+#define TYPED_ARRAY_CASE(Type, type, TYPE, ctype, size)                        \
+  case kExternal##Type##Array:                                                 \
+    ConvertTypedArrayElements<SourceType, Type##ArrayTraits>(source, target,   \
+                                                             length);          \
+    return;
+
+    TYPED_ARRAYS(TYPED_ARRAY_CASE)
+#undef TYPED_ARRAY_CASE
+  }
+  UNREACHABLE();
+}
+
+
+void ConvertTypedArrayElements(ExternalArrayType source_type,
+                               ExternalArrayType target_type,
+                               const void* source, void* target,
+                               size_t length) {
+  switch (source_type) {
+#define TYPED_ARRAY_CASE(Type, type, TYPE, ctype, size)                        \
+  case kExternal##Type##Array:                                                 \
+    ConvertTypedArrayElements<ctype>(target_type, source, target, length);     \
+    return;
+
+    TYPED_ARRAYS(TYPED_ARRAY_CASE)
+#undef TYPED_ARRAY_CASE
+  }
+  UNREACHABLE();
+}
+
+}  // namespace
+
+
 RUNTIME_FUNCTION(Runtime_TypedArraySetFastCases) {
   HandleScope scope(isolate);
   DCHECK(args.length() == 3);
@@ -353,10 +409,12 @@ RUNTIME_FUNCTION(Runtime_TypedArraySetFastCases) {
   if (target->type() == source->type()) {
     memmove(target_base + offset * target->element_size(), source_base,
             source_byte_length);
-    return Smi::FromInt(TYPED_ARRAY_SET_TYPED_ARRAY_SAME_TYPE);
+    return Smi::FromInt(TYPED_ARRAY_SET_TYPED_ARRAY);
   }
 
-  // Typed arrays of different types over the same backing store
+  // Typed arrays of different types over the same backing store. Copy the
+  // source out first, so that no element is read after it was overwritten.
+  base::SmartArrayPointer<uint8_t> source_copy;
   if ((source_base <= target_base &&
        source_base + source_byte_length > target_base) ||
       (target_base <= source_base &&
@@ -364,10 +422,118 @@ RUNTIME_FUNCTION(Runtime_TypedArraySetFastCases) {
     // We do not support overlapping ArrayBuffers
     DCHECK(target->GetBuffer()->backing_store() ==
            source->GetBuffer()->backing_store());
-    return Smi::FromInt(TYPED_ARRAY_SET_TYPED_ARRAY_OVERLAPPING);
-  } else {  // Non-overlapping typed arrays
-    return Smi::FromInt(TYPED_ARRAY_SET_TYPED_ARRAY_NONOVERLAPPING);
+    source_copy.Reset(NewArray<uint8_t>(source_byte_length));
+    memcpy(source_copy.get(), source_base, source_byte_length);
+    source_base = source_copy.get();
+  }
+  ConvertTypedArrayElements(source->type(), target->type(), source_base,
+                            target_base + offset * target->element_size(),
+                            source_length);
+  return Smi::FromInt(TYPED_ARRAY_SET_TYPED_ARRAY);
+}
+
+
+namespace {
+
+template <typename T>
+void SortTypedArrayElements(T* elements, size_t length) {
+  std::sort(elements, elements + length);
+}
+
+
+// Orders floating point numbers as required by ES6 section 22.2.3.25:
+// -0 before +0, and NaNs last.
+template <typename T>
+bool FloatingPointLessThan(T x, T y) {
+  if (x < y) return true;
+  if (x > y) return false;
+  if (x == 0 && y == 0) return std::signbit(x) && !std::signbit(y);
+  return !std::isnan(x) && std::isnan(y);
+}
+
+
+template <>
+void SortTypedArrayElements(float* elements, size_t length) {
+  std::sort(elements, elements + length, FloatingPointLessThan<float>);
+}
+
+
+template <>
+void SortTypedArrayElements(double* elements, size_t length) {
+  std::sort(elements, elements + length, FloatingPointLessThan<double>);
+}
+
+}  // namespace
+
+
+// Sorts the elements of a typed array in numeric order, for
+// %TypedArray%.prototype.sort without a comparison function.
+RUNTIME_FUNCTION(Runtime_TypedArraySortFast) {
+  HandleScope scope(isolate);
+  DCHECK(args.length() == 1);
+  CONVERT_ARG_HANDLE_CHECKED(JSTypedArray, array, 0);
+  size_t length = array->length_value();
+  if (length < 2) return *array;
+  void* data = FixedTypedArrayBase::cast(array->elements())->DataPtr();
+  switch (array->type()) {
+#define TYPED_ARRAY_CASE(Type, type, TYPE, ctype, size)                        \
+  case kExternal##Type##Array:                                                 \
+    SortTypedArrayElements(static_cast<ctype*>(data), length);                 \
+    break;
+
+    TYPED_ARRAYS(TYPED_ARRAY_CASE)
+#undef TYPED_ARRAY_CASE
+  }
+  return *array;
+}
+
+
+namespace {
+
+template <typename Traits>
+void FillTypedArrayElements(void* data, double value, size_t start,
+                            size_t end) {
+  typedef typename Traits::ElementType ElementType;
+  ElementType element = FixedTypedArray<Traits>::from_double(value);
+  ElementType* elements = static_cast<ElementType*>(data);
+  if (sizeof(ElementType) == 1) {
+    memset(elements + start, static_cast<uint8_t>(element), end - start);
+  } else {
+    std::fill(elements + start, elements + end, element);
+  }
+}
+
+}  // namespace
+
+
+// Stores the number |value| into the elements [start, end[ of a typed
+// array, converting it only once. The indices are clamped to the current
+// length, which is zero if converting the value neutered the buffer.
+RUNTIME_FUNCTION(Runtime_TypedArrayFill) {
+  HandleScope scope(isolate);
+  DCHECK(args.length() == 4);
+  CONVERT_ARG_HANDLE_CHECKED(JSTypedArray, array, 0);
+  CONVERT_DOUBLE_ARG_CHECKED(value, 1);
+  CONVERT_NUMBER_ARG_HANDLE_CHECKED(start_obj, 2);
+  CONVERT_NUMBER_ARG_HANDLE_CHECKED(end_obj, 3);
+  size_t start = 0;
+  size_t end = 0;
+  RUNTIME_ASSERT(TryNumberToSize(isolate, *start_obj, &start));
+  RUNTIME_ASSERT(TryNumberToSize(isolate, *end_obj, &end));
+  size_t length = array->length_value();
+  end = std::min(end, length);
+  if (start >= end) return *array;
+  void* data = FixedTypedArrayBase::cast(array->elements())->DataPtr();
+  switch (array->type()) {
+#define TYPED_ARRAY_CASE(Type, type, TYPE, ctype, size)                        \
+  case kExternal##Type##Array:                                                 \
+    FillTypedArrayElements<Type##ArrayTraits>(data, value, start, end);        \
+    break;
+
+    TYPED_ARRAYS(TYPED_ARRAY_CASE)
+#undef TYPED_ARRAY_CASE
   }
+  return *array;
 }
 
 
@@ -43,6 +43,8 @@ namespace internal {
   F(NewArray, -1 /* >= 3 */, 1)      \
   F(InternalArrayConstructor, -1, 1) \
   F(ArrayPush, -1, 1)                \
+  F(ArrayPop, 1, 1)                  \
+  F(ArrayShift, 1, 1)                \
   F(NormalizeElements, 1, 1)         \
   F(GrowArrayElements, 2, 1)         \
   F(HasComplexElements, 1, 1)        \
@@ -52,7 +54,8 @@ namespace internal {
   F(GetCachedArrayIndex, 1, 1)       \
   F(FixedArrayGet, 2, 1)             \
   F(FixedArraySet, 3, 1)             \
-  F(ArraySpeciesConstructor, 1, 1)
+  F(ArraySpeciesConstructor, 1, 1)   \
+  F(SpreadIterablePrepare, 1, 1)
 
 #define FOR_EACH_INTRINSIC_ATOMICS(F)           \
   F(ThrowNotIntegerSharedTypedArrayError, 1, 1) \
@@ -105,10 +108,13 @@ namespace internal {
   F(SetIteratorClone, 1, 1)               \
   F(SetIteratorNext, 2, 1)                \
   F(SetIteratorDetails, 1, 1)             \
+  F(SetHas, 2, 1)                         \
   F(MapInitialize, 1, 1)                  \
   F(MapShrink, 1, 1)                      \
   F(MapClear, 1, 1)                       \
   F(MapGrow, 1, 1)                        \
+  F(MapGet, 2, 1)                         \
+  F(MapHas, 2, 1)                         \
   F(MapIteratorInitialize, 3, 1)          \
   F(MapIteratorClone, 1, 1)               \
   F(MapIteratorDetails, 1, 1)             \
@@ -126,6 +132,7 @@ namespace internal {
   F(CompileBaseline, 1, 1)                \
   F(CompileOptimized_Concurrent, 1, 1)    \
   F(CompileOptimized_NotConcurrent, 1, 1) \
+  F(DeserializeLazy, 1, 1)                \
   F(NotifyStubFailure, 0, 1)              \
   F(NotifyDeoptimized, 1, 1)              \
   F(CompileForOnStackReplacement, 1, 1)   \
@@ -201,7 +208,8 @@ namespace internal {
   F(InterpreterTraceBytecodeEntry, 3, 1)  \
   F(InterpreterTraceBytecodeExit, 3, 1)   \
   F(InterpreterClearPendingMessage, 0, 1) \
-  F(InterpreterSetPendingMessage, 1, 1)
+  F(InterpreterSetPendingMessage, 1, 1)   \
+  F(InterpreterAllocateFeedbackVector, 1, 1)
 
 #define FOR_EACH_INTRINSIC_FUNCTION(F)     \
   F(FunctionGetName, 1, 1)                 \
@@ -210,7 +218,7 @@ namespace internal {
   F(FunctionGetScript, 1, 1)               \
   F(FunctionGetSourceCode, 1, 1)           \
   F(FunctionGetScriptSourcePosition, 1, 1) \
-  F(FunctionGetPositionForOffset, 2, 1)    \
+  F(FunctionGetPositionForOffset, 3, 1)    \
   F(FunctionGetContextData, 1, 1)          \
   F(FunctionSetInstanceClassName, 2, 1)    \
   F(FunctionSetLength, 2, 1)               \
@@ -285,6 +293,7 @@ namespace internal {
   F(ThrowGeneratorRunning, 0, 1)                    \
   F(ThrowStackOverflow, 0, 1)                       \
   F(ThrowWasmError, 1, 1)                           \
+  F(WasmCompileLazy, 0, 1)                          \
   F(PromiseRejectEvent, 3, 1)                       \
   F(PromiseRevokeReject, 1, 1)                      \
   F(StackGuard, 0, 1)                               \
@@ -314,6 +323,7 @@ namespace internal {
   F(IncrementUseCounter, 1, 1)                      \
   F(GetOrdinaryHasInstance, 0, 1)                   \
   F(GetAndResetRuntimeCallStats, 0, 1)              \
+  F(GetAndResetICStats, 0, 1)                       \
   F(EnqueueMicrotask, 1, 1)                         \
   F(RunMicrotasks, 0, 1)
 
@@ -471,6 +481,7 @@ namespace internal {
   F(RegExpConstructResult, 3, 1)               \
   F(RegExpInitializeAndCompile, 3, 1)          \
   F(RegExpExecMultiple, 4, 1)                  \
+  F(RegExpSplit, 4, 1)                         \
   F(RegExpExecReThrow, 4, 1)                   \
   F(IsRegExp, 1, 1)
 
@@ -915,6 +926,8 @@ namespace internal {
   F(DataViewGetBuffer, 1, 1)                 \
   F(TypedArrayGetBuffer, 1, 1)               \
   F(TypedArraySetFastCases, 3, 1)            \
+  F(TypedArraySortFast, 1, 1)                \
+  F(TypedArrayFill, 4, 1)                    \
   F(TypedArrayMaxSizeInHeap, 0, 1)           \
   F(IsTypedArray, 1, 1)                      \
   F(IsSharedTypedArray, 1, 1)                \
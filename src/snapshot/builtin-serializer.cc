@@ -0,0 +1,91 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/snapshot/builtin-serializer.h"
+
+#include "src/objects-inl.h"
+
+namespace v8 {
+namespace internal {
+
+BuiltinSerializer::BuiltinSerializer(Isolate* isolate,
+                                     StartupSerializer* startup_serializer,
+                                     SnapshotByteSink* sink)
+    : Serializer(isolate, sink),
+      startup_serializer_(startup_serializer),
+      builtin_(NULL) {
+  InitializeCodeAddressMap();
+}
+
+BuiltinSerializer::~BuiltinSerializer() {
+  OutputStatistics("BuiltinSerializer");
+}
+
+void BuiltinSerializer::Serialize(Code* builtin) {
+  DCHECK_EQ(Code::BUILTIN, builtin->kind());
+  DCHECK(Builtins::IsLazy(builtin->builtin_index()));
+  builtin_ = builtin;
+  Object* root = builtin;
+  VisitPointer(&root);
+  SerializeDeferredObjects();
+  Pad();
+}
+
+void BuiltinSerializer::SerializeObject(HeapObject* obj, HowToCode how_to_code,
+                                        WhereToPoint where_to_point, int skip) {
+  int root_index = root_index_map_.Lookup(obj);
+  if (root_index != RootIndexMap::kInvalidRootIndex) {
+    PutRoot(root_index, obj, how_to_code, where_to_point, skip);
+    return;
+  }
+
+  if (!IsOwnedByBuiltin(obj)) {
+    FlushSkip(skip);
+
+    int cache_index = startup_serializer_->PartialSnapshotCacheIndex(obj);
+    sink_->Put(kPartialSnapshotCache + how_to_code + where_to_point,
+               "PartialSnapshotCache");
+    sink_->PutInt(cache_index, "partial_snapshot_cache_index");
+    return;
+  }
+
+  if (SerializeKnownObject(obj, how_to_code, where_to_point, skip)) return;
+
+  FlushSkip(skip);
+
+  ObjectSerializer serializer(this, obj, sink_, how_to_code, where_to_point);
+  serializer.Serialize();
+}
+
+bool BuiltinSerializer::IsOwnedByBuiltin(HeapObject* o) {
+  // Other code objects, including other builtins, and shared objects like
+  // maps and internalized strings keep their identity.
+  return o == builtin_ || o == builtin_->relocation_info() ||
+         o == builtin_->handler_table() ||
+         o == builtin_->deoptimization_data() ||
+         o == builtin_->raw_type_feedback_info();
+}
+
+// static
+void BuiltinSerializer::CreatePlaceholders(Isolate* isolate,
+                                           List<Code*>* placeholders) {
+  DCHECK(placeholders->is_empty());
+  HandleScope scope(isolate);
+  Handle<Code> trampoline = isolate->builtins()->DeserializeLazy();
+  List<Handle<Code> > handles(Builtins::builtin_count);
+  for (int i = 0; i < Builtins::builtin_count; i++) {
+    Handle<Code> placeholder;
+    if (Builtins::IsLazy(i)) {
+      placeholder = isolate->factory()->CopyCode(trampoline);
+      placeholder->set_builtin_index(i);
+    }
+    handles.Add(placeholder);
+  }
+  for (Handle<Code> placeholder : handles) {
+    placeholders->Add(placeholder.is_null() ? NULL : *placeholder);
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
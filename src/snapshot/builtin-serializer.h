@@ -0,0 +1,47 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_SNAPSHOT_BUILTIN_SERIALIZER_H_
+#define V8_SNAPSHOT_BUILTIN_SERIALIZER_H_
+
+#include "src/snapshot/startup-serializer.h"
+
+namespace v8 {
+namespace internal {
+
+// Serializes a builtin that is deserialized lazily, on its first call, into
+// a snapshot of its own. Only the code object and the arrays it owns are part
+// of that snapshot. Everything else is referred to through the root list or
+// the partial snapshot cache, because the builtin is deserialized into an
+// isolate that has been running for a while.
+class BuiltinSerializer : public Serializer {
+ public:
+  BuiltinSerializer(Isolate* isolate, StartupSerializer* startup_serializer,
+                    SnapshotByteSink* sink);
+  ~BuiltinSerializer() override;
+
+  void Serialize(Code* builtin);
+
+  // Creates a placeholder for each builtin that can be deserialized lazily,
+  // and NULL for the others. A placeholder is a copy of the DeserializeLazy
+  // builtin that carries the index of the builtin it stands for. The
+  // placeholders are not reachable from any root, so they have to be passed
+  // to the StartupSerializer before the next allocation.
+  static void CreatePlaceholders(Isolate* isolate, List<Code*>* placeholders);
+
+ private:
+  void SerializeObject(HeapObject* o, HowToCode how_to_code,
+                       WhereToPoint where_to_point, int skip) override;
+
+  bool IsOwnedByBuiltin(HeapObject* o);
+
+  StartupSerializer* startup_serializer_;
+  Code* builtin_;
+  DISALLOW_COPY_AND_ASSIGN(BuiltinSerializer);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_SNAPSHOT_BUILTIN_SERIALIZER_H_
@@ -4,7 +4,9 @@
 
 #include "src/snapshot/code-serializer.h"
 
+#include "src/base/functional.h"
 #include "src/code-stubs.h"
+#include "src/compiler.h"
 #include "src/log.h"
 #include "src/macro-assembler.h"
 #include "src/profiler/cpu-profiler.h"
@@ -17,6 +19,77 @@ namespace internal {
 ScriptData* CodeSerializer::Serialize(Isolate* isolate,
                                       Handle<SharedFunctionInfo> info,
                                       Handle<String> source) {
+  return SerializeInternal(isolate, info, source, NULL);
+}
+
+ScriptData* CodeSerializer::SerializeExecuted(Isolate* isolate,
+                                              Handle<SharedFunctionInfo> info,
+                                              Handle<String> source) {
+  if (!info->is_compiled()) return NULL;
+
+  HandleScope scope(isolate);
+  Zone zone(isolate->allocator());
+  IdentityMap<Object**> substitutions(isolate->heap(), &zone);
+  Handle<Object> trampoline =
+      isolate->builtins()->InterpreterEntryTrampoline();
+  Handle<Object> compile_lazy = isolate->builtins()->CompileLazy();
+  Handle<Object> cleared_code_map =
+      isolate->factory()->cleared_optimized_code_map();
+
+  // Collect the functions first, allocating feedback vectors below can
+  // move them.
+  List<Handle<SharedFunctionInfo> > functions;
+  functions.Add(info);
+  {
+    WeakFixedArray::Iterator iterator(
+        Script::cast(info->script())->shared_function_infos());
+    while (SharedFunctionInfo* shared = iterator.Next<SharedFunctionInfo>()) {
+      if (shared != *info) functions.Add(handle(shared, isolate));
+    }
+  }
+
+  for (int i = 0; i < functions.length(); i++) {
+    Handle<SharedFunctionInfo> shared = functions[i];
+    // Baseline code has been patched while running and has no reloc info
+    // for serialization. Fall back to the bytecode, or to code re-generated
+    // for serialization, or to lazy compilation if neither is possible.
+    if (shared->is_compiled() && shared->code()->kind() == Code::FUNCTION) {
+      Handle<Object> code(shared->code(), isolate);
+      Handle<Code> fresh_code;
+      if (shared->HasBytecodeArray()) {
+        substitutions.Set(code, trampoline.location());
+      } else if (Compiler::CompileForSerialization(shared).ToHandle(
+                     &fresh_code)) {
+        substitutions.Set(code, Handle<Object>::cast(fresh_code).location());
+      } else if (shared.is_identical_to(info)) {
+        return NULL;
+      } else {
+        substitutions.Set(code, compile_lazy.location());
+      }
+    }
+    // Collected type feedback refers to maps and closures of the running
+    // context. Serialize a fresh feedback vector instead.
+    if (!shared->feedback_vector()->is_empty()) {
+      Handle<TypeFeedbackVector> vector(shared->feedback_vector(), isolate);
+      Handle<TypeFeedbackMetadata> metadata(vector->metadata(), isolate);
+      Handle<Object> fresh =
+          FLAG_ignition_lazy_feedback_allocation
+              ? TypeFeedbackVector::NewLazy(isolate, metadata)
+              : TypeFeedbackVector::New(isolate, metadata);
+      substitutions.Set(vector, fresh.location());
+    }
+    if (!shared->OptimizedCodeMapIsCleared()) {
+      Handle<Object> code_map(shared->optimized_code_map(), isolate);
+      substitutions.Set(code_map, cleared_code_map.location());
+    }
+  }
+
+  return SerializeInternal(isolate, info, source, &substitutions);
+}
+
+ScriptData* CodeSerializer::SerializeInternal(
+    Isolate* isolate, Handle<SharedFunctionInfo> info, Handle<String> source,
+    IdentityMap<Object**>* substitutions) {
   base::ElapsedTimer timer;
   if (FLAG_profile_deserialization) timer.Start();
   if (FLAG_trace_serializer) {
@@ -28,7 +101,8 @@ ScriptData* CodeSerializer::Serialize(Isolate* isolate,
 
   // Serialize code object.
   SnapshotByteSink sink(info->code()->CodeSize() * 2);
-  CodeSerializer cs(isolate, &sink, *source);
+  CodeSerializer cs(isolate, &sink, *source,
+                    SerializedCodeData::SourceHash(*source), substitutions);
   DisallowHeapAllocation no_gc;
   Object** location = Handle<Object>::cast(info).location();
   cs.VisitPointer(location);
@@ -49,6 +123,11 @@ ScriptData* CodeSerializer::Serialize(Isolate* isolate,
 
 void CodeSerializer::SerializeObject(HeapObject* obj, HowToCode how_to_code,
                                      WhereToPoint where_to_point, int skip) {
+  if (substitutions_ != NULL) {
+    Object*** substitute = substitutions_->Find(obj);
+    if (substitute != NULL) obj = HeapObject::cast(**substitute);
+  }
+
   int root_index = root_index_map_.Lookup(obj);
   if (root_index != RootIndexMap::kInvalidRootIndex) {
     PutRoot(root_index, obj, how_to_code, where_to_point, skip);
@@ -85,8 +164,12 @@ void CodeSerializer::SerializeObject(HeapObject* obj, HowToCode how_to_code,
         SerializeGeneric(code_object, how_to_code, where_to_point);
         return;
       case Code::WASM_FUNCTION:
-      case Code::WASM_TO_JS_FUNCTION:
-      case Code::JS_TO_WASM_FUNCTION:
+        // Compiled wasm modules contain wasm functions and placeholders for
+        // them. Neither has been patched for an instance.
+        SerializeGeneric(code_object, how_to_code, where_to_point);
+        return;
+      case Code::WASM_TO_JS_FUNCTION:  // Import wrappers are not cached.
+      case Code::JS_TO_WASM_FUNCTION:  // Export wrappers are not cached.
         UNREACHABLE();
     }
     UNREACHABLE();
@@ -198,8 +281,8 @@ MaybeHandle<SharedFunctionInfo> CodeSerializer::Deserialize(
 
   HandleScope scope(isolate);
 
-  base::SmartPointer<SerializedCodeData> scd(
-      SerializedCodeData::FromCachedData(isolate, cached_data, *source));
+  base::SmartPointer<SerializedCodeData> scd(SerializedCodeData::FromCachedData(
+      isolate, cached_data, SerializedCodeData::SourceHash(*source)));
   if (scd.is_empty()) {
     if (FLAG_profile_deserialization) PrintF("[Cached code failed check]\n");
     DCHECK(cached_data->rejected());
@@ -247,6 +330,76 @@ MaybeHandle<SharedFunctionInfo> CodeSerializer::Deserialize(
   return scope.CloseAndEscape(result);
 }
 
+ScriptData* CodeSerializer::SerializeWasmModule(
+    Isolate* isolate, Handle<FixedArray> compiled_module,
+    Vector<const byte> wire_bytes) {
+  base::ElapsedTimer timer;
+  if (FLAG_profile_deserialization) timer.Start();
+
+  SnapshotByteSink sink(wire_bytes.length() * 4);
+  CodeSerializer cs(isolate, &sink, *isolate->native_context(),
+                    SerializedCodeData::SourceHash(wire_bytes), NULL);
+  DisallowHeapAllocation no_gc;
+  Object** location = Handle<Object>::cast(compiled_module).location();
+  cs.VisitPointer(location);
+  cs.SerializeDeferredObjects();
+  cs.Pad();
+
+  SerializedCodeData data(sink.data(), cs);
+  ScriptData* script_data = data.GetScriptData();
+
+  if (FLAG_profile_deserialization) {
+    double ms = timer.Elapsed().InMillisecondsF();
+    int length = script_data->length();
+    PrintF("[Serializing wasm module to %d bytes took %0.3f ms]\n", length,
+           ms);
+  }
+  return script_data;
+}
+
+MaybeHandle<FixedArray> CodeSerializer::DeserializeWasmModule(
+    Isolate* isolate, ScriptData* cached_data, Vector<const byte> wire_bytes) {
+  base::ElapsedTimer timer;
+  if (FLAG_profile_deserialization) timer.Start();
+
+  HandleScope scope(isolate);
+
+  base::SmartPointer<SerializedCodeData> scd(SerializedCodeData::FromCachedData(
+      isolate, cached_data, SerializedCodeData::SourceHash(wire_bytes)));
+  if (scd.is_empty()) {
+    if (FLAG_profile_deserialization) PrintF("[Cached code failed check]\n");
+    DCHECK(cached_data->rejected());
+    return MaybeHandle<FixedArray>();
+  }
+
+  // The native context takes the place of the source string.
+  Vector<const uint32_t> code_stub_keys = scd->CodeStubKeys();
+  Vector<Handle<Object> > attached_objects = Vector<Handle<Object> >::New(
+      code_stub_keys.length() + kCodeStubsBaseIndex);
+  attached_objects[kSourceObjectIndex] = isolate->native_context();
+  for (int i = 0; i < code_stub_keys.length(); i++) {
+    attached_objects[i + kCodeStubsBaseIndex] =
+        CodeStub::GetCode(isolate, code_stub_keys[i]).ToHandleChecked();
+  }
+
+  Deserializer deserializer(scd.get());
+  deserializer.SetAttachedObjects(attached_objects);
+
+  Handle<HeapObject> result;
+  if (!deserializer.DeserializeObject(isolate).ToHandle(&result)) {
+    if (FLAG_profile_deserialization) PrintF("[Deserializing failed]\n");
+    return MaybeHandle<FixedArray>();
+  }
+
+  if (FLAG_profile_deserialization) {
+    double ms = timer.Elapsed().InMillisecondsF();
+    int length = cached_data->length();
+    PrintF("[Deserializing wasm module from %d bytes took %0.3f ms]\n",
+           length, ms);
+  }
+  return scope.CloseAndEscape(Handle<FixedArray>::cast(result));
+}
+
 class Checksum {
  public:
   explicit Checksum(Vector<const byte> payload) {
@@ -308,7 +461,7 @@ SerializedCodeData::SerializedCodeData(const List<byte>& payload,
   // Set header values.
   SetMagicNumber(cs.isolate());
   SetHeaderValue(kVersionHashOffset, Version::Hash());
-  SetHeaderValue(kSourceHashOffset, SourceHash(cs.source()));
+  SetHeaderValue(kSourceHashOffset, cs.source_hash());
   SetHeaderValue(kCpuFeaturesOffset,
                  static_cast<uint32_t>(CpuFeatures::SupportedFeatures()));
   SetHeaderValue(kFlagHashOffset, FlagList::Hash());
@@ -336,7 +489,7 @@ SerializedCodeData::SerializedCodeData(const List<byte>& payload,
 }
 
 SerializedCodeData::SanityCheckResult SerializedCodeData::SanityCheck(
-    Isolate* isolate, String* source) const {
+    Isolate* isolate, uint32_t expected_source_hash) const {
   uint32_t magic_number = GetMagicNumber();
   if (magic_number != ComputeMagicNumber(isolate)) return MAGIC_NUMBER_MISMATCH;
   uint32_t version_hash = GetHeaderValue(kVersionHashOffset);
@@ -346,7 +499,7 @@ SerializedCodeData::SanityCheckResult SerializedCodeData::SanityCheck(
   uint32_t c1 = GetHeaderValue(kChecksum1Offset);
   uint32_t c2 = GetHeaderValue(kChecksum2Offset);
   if (version_hash != Version::Hash()) return VERSION_MISMATCH;
-  if (source_hash != SourceHash(source)) return SOURCE_MISMATCH;
+  if (source_hash != expected_source_hash) return SOURCE_MISMATCH;
   if (cpu_features != static_cast<uint32_t>(CpuFeatures::SupportedFeatures())) {
     return CPU_FEATURES_MISMATCH;
   }
@@ -355,10 +508,17 @@ SerializedCodeData::SanityCheckResult SerializedCodeData::SanityCheck(
   return CHECK_SUCCESS;
 }
 
-uint32_t SerializedCodeData::SourceHash(String* source) const {
+uint32_t SerializedCodeData::SourceHash(String* source) {
   return source->length();
 }
 
+uint32_t SerializedCodeData::SourceHash(Vector<const byte> wire_bytes) {
+  // Unlike a script, the compiled module does not refer to its source, so
+  // that a length check would not catch cached data for the wrong module.
+  return static_cast<uint32_t>(
+      base::hash_range(wire_bytes.begin(), wire_bytes.end()));
+}
+
 // Return ScriptData object and relinquish ownership over it to the caller.
 ScriptData* SerializedCodeData::GetScriptData() {
   DCHECK(owns_data_);
@@ -398,15 +558,27 @@ Vector<const uint32_t> SerializedCodeData::CodeStubKeys() const {
 SerializedCodeData::SerializedCodeData(ScriptData* data)
     : SerializedData(const_cast<byte*>(data->data()), data->length()) {}
 
-SerializedCodeData* SerializedCodeData::FromCachedData(Isolate* isolate,
-                                                       ScriptData* cached_data,
-                                                       String* source) {
+SerializedCodeData* SerializedCodeData::FromCachedData(
+    Isolate* isolate, ScriptData* cached_data, uint32_t expected_source_hash) {
   DisallowHeapAllocation no_gc;
   SerializedCodeData* scd = new SerializedCodeData(cached_data);
-  SanityCheckResult r = scd->SanityCheck(isolate, source);
+  SanityCheckResult r = scd->SanityCheck(isolate, expected_source_hash);
   if (r == CHECK_SUCCESS) return scd;
-  cached_data->Reject();
-  source->GetIsolate()->counters()->code_cache_reject_reason()->AddSample(r);
+  // The embedder learns the reason through CachedData::reject_reason.
+  typedef v8::ScriptCompiler::CachedData CachedData;
+  STATIC_ASSERT(MAGIC_NUMBER_MISMATCH ==
+                static_cast<int>(CachedData::kMagicNumberMismatch));
+  STATIC_ASSERT(VERSION_MISMATCH ==
+                static_cast<int>(CachedData::kVersionMismatch));
+  STATIC_ASSERT(SOURCE_MISMATCH ==
+                static_cast<int>(CachedData::kSourceMismatch));
+  STATIC_ASSERT(CPU_FEATURES_MISMATCH ==
+                static_cast<int>(CachedData::kCpuFeaturesMismatch));
+  STATIC_ASSERT(FLAGS_MISMATCH == static_cast<int>(CachedData::kFlagsMismatch));
+  STATIC_ASSERT(CHECKSUM_MISMATCH ==
+                static_cast<int>(CachedData::kChecksumMismatch));
+  cached_data->Reject(static_cast<ScriptData::RejectReason>(r));
+  isolate->counters()->code_cache_reject_reason()->AddSample(r);
   delete scd;
   return NULL;
 }
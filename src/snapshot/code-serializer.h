@@ -5,6 +5,7 @@
 #ifndef V8_SNAPSHOT_CODE_SERIALIZER_H_
 #define V8_SNAPSHOT_CODE_SERIALIZER_H_
 
+#include "src/identity-map.h"
 #include "src/parsing/preparse-data.h"
 #include "src/snapshot/serializer.h"
 
@@ -17,29 +18,59 @@ class CodeSerializer : public Serializer {
                                Handle<SharedFunctionInfo> info,
                                Handle<String> source);
 
+  // Serializes a top-level function after the script has been run, so that
+  // the cache also contains the inner functions compiled while running it.
+  // Type feedback is not serialized, and full-codegen code is re-generated
+  // for serialization. Returns NULL if the top-level function cannot be
+  // serialized.
+  static ScriptData* SerializeExecuted(Isolate* isolate,
+                                       Handle<SharedFunctionInfo> info,
+                                       Handle<String> source);
+
   MUST_USE_RESULT static MaybeHandle<SharedFunctionInfo> Deserialize(
       Isolate* isolate, ScriptData* cached_data, Handle<String> source);
 
+  // Serializes a compiled wasm module, as returned by
+  // WasmModule::CompileFunctions, for the module with the given wire bytes.
+  // The native context the code refers to is not serialized.
+  static ScriptData* SerializeWasmModule(Isolate* isolate,
+                                         Handle<FixedArray> compiled_module,
+                                         Vector<const byte> wire_bytes);
+
+  // Deserializes a compiled wasm module into the current native context.
+  // Returns an empty handle if the cached data was produced for other wire
+  // bytes, by another V8 version or with other flags.
+  MUST_USE_RESULT static MaybeHandle<FixedArray> DeserializeWasmModule(
+      Isolate* isolate, ScriptData* cached_data, Vector<const byte> wire_bytes);
+
   static const int kSourceObjectIndex = 0;
   STATIC_ASSERT(kSourceObjectReference == kSourceObjectIndex);
 
   static const int kCodeStubsBaseIndex = 1;
 
-  String* source() const {
-    DCHECK(!AllowHeapAllocation::IsAllowed());
-    return source_;
-  }
+  uint32_t source_hash() const { return source_hash_; }
 
   const List<uint32_t>* stub_keys() const { return &stub_keys_; }
 
  private:
-  CodeSerializer(Isolate* isolate, SnapshotByteSink* sink, String* source)
-      : Serializer(isolate, sink), source_(source) {
-    back_reference_map_.AddSourceString(source);
+  // The {source} object is not serialized but attached again when
+  // deserializing: the source string of a script, or the native context of
+  // a wasm module.
+  CodeSerializer(Isolate* isolate, SnapshotByteSink* sink, HeapObject* source,
+                 uint32_t source_hash, IdentityMap<Object**>* substitutions)
+      : Serializer(isolate, sink),
+        source_hash_(source_hash),
+        substitutions_(substitutions) {
+    back_reference_map_.Add(source, BackReference::SourceReference());
   }
 
   ~CodeSerializer() override { OutputStatistics("CodeSerializer"); }
 
+  static ScriptData* SerializeInternal(Isolate* isolate,
+                                       Handle<SharedFunctionInfo> info,
+                                       Handle<String> source,
+                                       IdentityMap<Object**>* substitutions);
+
   void SerializeObject(HeapObject* o, HowToCode how_to_code,
                        WhereToPoint where_to_point, int skip) override;
 
@@ -54,7 +85,10 @@ class CodeSerializer : public Serializer {
   int AddCodeStubKey(uint32_t stub_key);
 
   DisallowHeapAllocation no_gc_;
-  String* source_;
+  uint32_t source_hash_;
+  // Objects to serialize in place of others, or NULL. Keys and values are
+  // kept alive by handles owned by the caller.
+  IdentityMap<Object**>* substitutions_;
   List<uint32_t> stub_keys_;
   DISALLOW_COPY_AND_ASSIGN(CodeSerializer);
 };
@@ -65,7 +99,7 @@ class SerializedCodeData : public SerializedData {
   // Used when consuming.
   static SerializedCodeData* FromCachedData(Isolate* isolate,
                                             ScriptData* cached_data,
-                                            String* source);
+                                            uint32_t expected_source_hash);
 
   // Used when producing.
   SerializedCodeData(const List<byte>& payload, const CodeSerializer& cs);
@@ -78,6 +112,9 @@ class SerializedCodeData : public SerializedData {
 
   Vector<const uint32_t> CodeStubKeys() const;
 
+  static uint32_t SourceHash(String* source);
+  static uint32_t SourceHash(Vector<const byte> wire_bytes);
+
  private:
   explicit SerializedCodeData(ScriptData* data);
 
@@ -91,9 +128,8 @@ class SerializedCodeData : public SerializedData {
     CHECKSUM_MISMATCH = 6
   };
 
-  SanityCheckResult SanityCheck(Isolate* isolate, String* source) const;
-
-  uint32_t SourceHash(String* source) const;
+  SanityCheckResult SanityCheck(Isolate* isolate,
+                                uint32_t expected_source_hash) const;
 
   // The data header consists of uint32_t-sized entries:
   // [0] magic number and external reference count
@@ -4,12 +4,14 @@
 
 #include "src/snapshot/deserializer.h"
 
+#include "src/api.h"
 #include "src/bootstrapper.h"
 #include "src/external-reference-table.h"
 #include "src/heap/heap.h"
 #include "src/isolate.h"
 #include "src/macro-assembler.h"
 #include "src/snapshot/natives.h"
+#include "src/tracing/trace-event.h"
 #include "src/v8.h"
 
 namespace v8 {
@@ -72,6 +74,8 @@ void Deserializer::Initialize(Isolate* isolate) {
 }
 
 void Deserializer::Deserialize(Isolate* isolate) {
+  TRACE_EVENT1(TRACE_DISABLED_BY_DEFAULT("v8.compile"), "V8.DeserializeIsolate",
+               "bytes", source_.length());
   Initialize(isolate);
   if (!ReserveSpace()) V8::FatalProcessOutOfMemory("deserializing context");
   // No active threads.
@@ -112,7 +116,10 @@ void Deserializer::Deserialize(Isolate* isolate) {
 }
 
 MaybeHandle<Object> Deserializer::DeserializePartial(
-    Isolate* isolate, Handle<JSGlobalProxy> global_proxy) {
+    Isolate* isolate, Handle<JSGlobalProxy> global_proxy,
+    v8::DeserializeInternalFieldsCallback internal_fields_deserializer) {
+  TRACE_EVENT1(TRACE_DISABLED_BY_DEFAULT("v8.compile"), "V8.DeserializeContext",
+               "bytes", source_.length());
   Initialize(isolate);
   if (!ReserveSpace()) {
     V8::FatalProcessOutOfMemory("deserialize context");
@@ -131,6 +138,7 @@ MaybeHandle<Object> Deserializer::DeserializePartial(
   Object* root;
   VisitPointer(&root);
   DeserializeDeferredObjects();
+  DeserializeInternalFields(internal_fields_deserializer);
 
   isolate->heap()->RegisterReservationsForBlackAllocation(reservations_);
 
@@ -141,22 +149,48 @@ MaybeHandle<Object> Deserializer::DeserializePartial(
   return Handle<Object>(root, isolate);
 }
 
+Handle<Code> Deserializer::DeserializeBuiltin(Isolate* isolate) {
+  Initialize(isolate);
+  if (!ReserveSpace()) V8::FatalProcessOutOfMemory("deserialize builtin");
+
+  DisallowHeapAllocation no_gc;
+  Object* root;
+  VisitPointer(&root);
+  DeserializeDeferredObjects();
+  isolate->heap()->RegisterReservationsForBlackAllocation(reservations_);
+
+  Code* code = Code::cast(root);
+  Assembler::FlushICache(isolate, code->instruction_start(),
+                         code->instruction_size());
+  return Handle<Code>(code, isolate);
+}
+
 MaybeHandle<SharedFunctionInfo> Deserializer::DeserializeCode(
     Isolate* isolate) {
+  TRACE_EVENT1(TRACE_DISABLED_BY_DEFAULT("v8.compile"), "V8.DeserializeCode",
+               "bytes", source_.length());
+  Handle<HeapObject> result;
+  if (!DeserializeObject(isolate).ToHandle(&result)) {
+    return MaybeHandle<SharedFunctionInfo>();
+  }
+  return Handle<SharedFunctionInfo>::cast(result);
+}
+
+MaybeHandle<HeapObject> Deserializer::DeserializeObject(Isolate* isolate) {
   Initialize(isolate);
   if (!ReserveSpace()) {
-    return Handle<SharedFunctionInfo>();
+    return MaybeHandle<HeapObject>();
   } else {
     deserializing_user_code_ = true;
     HandleScope scope(isolate);
-    Handle<SharedFunctionInfo> result;
+    Handle<HeapObject> result;
     {
       DisallowHeapAllocation no_gc;
       Object* root;
       VisitPointer(&root);
       DeserializeDeferredObjects();
       FlushICacheForNewCodeObjects();
-      result = Handle<SharedFunctionInfo>(SharedFunctionInfo::cast(root));
+      result = Handle<HeapObject>(HeapObject::cast(root));
       isolate->heap()->RegisterReservationsForBlackAllocation(reservations_);
     }
     CommitPostProcessedObjects(isolate);
@@ -183,6 +217,31 @@ void Deserializer::Synchronize(VisitorSynchronization::SyncTag tag) {
   CHECK_EQ(expected, source_.Get());
 }
 
+void Deserializer::DeserializeInternalFields(
+    v8::DeserializeInternalFieldsCallback internal_fields_deserializer) {
+  if (!source_.HasMore() || source_.Get() != kInternalFieldsData) return;
+  DisallowHeapAllocation no_gc;
+  DisallowJavascriptExecution no_js(isolate_);
+  for (int code = source_.Get(); code != kSynchronize; code = source_.Get()) {
+    HandleScope scope(isolate_);
+    int space = code & kSpaceMask;
+    DCHECK(space <= kNumberOfSpaces);
+    DCHECK(code - space == kNewObject);
+    Handle<JSObject> holder(JSObject::cast(GetBackReferencedObject(space)),
+                            isolate_);
+    int index = source_.GetInt();
+    const byte* data;
+    int size = source_.GetBlob(&data);
+    // The field still holds the value it had in the serializing process.
+    holder->SetInternalField(index, Smi::FromInt(0));
+    if (internal_fields_deserializer == NULL) continue;
+    // The payload is only valid during the callback, so it can point into the
+    // snapshot, which may be a read-only mapping of the blob file.
+    v8::StartupData payload = {reinterpret_cast<const char*>(data), size};
+    internal_fields_deserializer(v8::Utils::ToLocal(holder), index, payload);
+  }
+}
+
 void Deserializer::DeserializeDeferredObjects() {
   for (int code = source_.Get(); code != kSynchronize; code = source_.Get()) {
     switch (code) {
@@ -294,7 +353,7 @@ HeapObject* Deserializer::PostProcessNewObject(HeapObject* obj, int space) {
 }
 
 void Deserializer::CommitPostProcessedObjects(Isolate* isolate) {
-  StringTable::EnsureCapacityForDeserialization(
+  StringTable::EnsureCapacityForBulkInsert(
       isolate, new_internalized_strings_.length());
   for (Handle<String> string : new_internalized_strings_) {
     StringTableInsertionKey key(*string);
@@ -786,10 +845,9 @@ bool Deserializer::ReadData(Object** current, Object** limit, int source_space,
       STATIC_ASSERT(kNumberOfFixedRawData == 32);
       SIXTEEN_CASES(kFixedRawData)
       SIXTEEN_CASES(kFixedRawData + 16) {
-        byte* raw_data_out = reinterpret_cast<byte*>(current);
-        int size_in_bytes = (data - kFixedRawDataStart) << kPointerSizeLog2;
-        source_.CopyRaw(raw_data_out, size_in_bytes);
-        current = reinterpret_cast<Object**>(raw_data_out + size_in_bytes);
+        int size_in_words = data - kFixedRawDataStart;
+        source_.CopyRawWords(reinterpret_cast<byte*>(current), size_in_words);
+        current += size_in_words;
         break;
       }
 
@@ -13,6 +13,7 @@
 #include "src/list.h"
 #include "src/snapshot/natives.h"
 #include "src/snapshot/partial-serializer.h"
+#include "src/snapshot/startup-data-compression.h"
 #include "src/snapshot/startup-serializer.h"
 
 using namespace v8;
@@ -46,6 +47,17 @@ class SnapshotWriter {
   void MaybeWriteStartupBlob(const i::Vector<const i::byte>& blob) const {
     if (!startup_blob_file_) return;
 
+    if (i::FLAG_compress_startup_blob) {
+      i::Vector<i::byte> compressed = i::StartupDataCompression::Compress(blob);
+      WriteStartupBlob(
+          i::Vector<const i::byte>(compressed.start(), compressed.length()));
+      compressed.Dispose();
+    } else {
+      WriteStartupBlob(blob);
+    }
+  }
+
+  void WriteStartupBlob(const i::Vector<const i::byte>& blob) const {
     size_t written = fwrite(blob.begin(), 1, blob.length(), startup_blob_file_);
     if (written != static_cast<size_t>(blob.length())) {
       i::PrintF("Writing snapshot file failed.. Aborting.\n");
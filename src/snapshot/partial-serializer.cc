@@ -4,18 +4,20 @@
 
 #include "src/snapshot/partial-serializer.h"
 
+#include "src/api.h"
 #include "src/objects-inl.h"
 
 namespace v8 {
 namespace internal {
 
-PartialSerializer::PartialSerializer(Isolate* isolate,
-                                     Serializer* startup_snapshot_serializer,
-                                     SnapshotByteSink* sink)
+PartialSerializer::PartialSerializer(
+    Isolate* isolate, StartupSerializer* startup_snapshot_serializer,
+    SnapshotByteSink* sink,
+    v8::SerializeInternalFieldsCallback internal_fields_serializer)
     : Serializer(isolate, sink),
       startup_serializer_(startup_snapshot_serializer),
       global_object_(NULL),
-      next_partial_cache_index_(0) {
+      internal_fields_serializer_(internal_fields_serializer) {
   InitializeCodeAddressMap();
 }
 
@@ -41,6 +43,7 @@ void PartialSerializer::Serialize(Object** o) {
   }
   VisitPointer(o);
   SerializeDeferredObjects();
+  SerializeInternalFields();
   Pad();
 }
 
@@ -64,7 +67,7 @@ void PartialSerializer::SerializeObject(HeapObject* obj, HowToCode how_to_code,
   if (ShouldBeInThePartialSnapshotCache(obj)) {
     FlushSkip(skip);
 
-    int cache_index = PartialSnapshotCacheIndex(obj);
+    int cache_index = startup_serializer_->PartialSnapshotCacheIndex(obj);
     sink_->Put(kPartialSnapshotCache + how_to_code + where_to_point,
                "PartialSnapshotCache");
     sink_->PutInt(cache_index, "partial_snapshot_cache_index");
@@ -89,35 +92,70 @@ void PartialSerializer::SerializeObject(HeapObject* obj, HowToCode how_to_code,
     for (int i = 0; i < literals->length(); i++) literals->set_undefined(i);
   }
 
+  if (HasEmbedderInternalFields(obj)) {
+    internal_field_holders_.Add(JSObject::cast(obj));
+  }
+
   // Object has not yet been serialized.  Serialize it here.
   ObjectSerializer serializer(this, obj, sink_, how_to_code, where_to_point);
   serializer.Serialize();
 }
 
-int PartialSerializer::PartialSnapshotCacheIndex(HeapObject* heap_object) {
-  int index = partial_cache_index_map_.LookupOrInsert(
-      heap_object, next_partial_cache_index_);
-  if (index == PartialCacheIndexMap::kInvalidIndex) {
-    // This object is not part of the partial snapshot cache yet. Add it to the
-    // startup snapshot so we can refer to it via partial snapshot index from
-    // the partial snapshot.
-    startup_serializer_->VisitPointer(reinterpret_cast<Object**>(&heap_object));
-    return next_partial_cache_index_++;
-  }
-  return index;
-}
-
 bool PartialSerializer::ShouldBeInThePartialSnapshotCache(HeapObject* o) {
   // Scripts should be referred only through shared function infos.  We can't
   // allow them to be part of the partial snapshot because they contain a
   // unique ID, and deserializing several partial snapshots containing script
   // would cause dupes.
   DCHECK(!o->IsScript());
+  // Templates are shared between the contexts in the snapshot and the
+  // templates that SnapshotCreator::AddTemplate() added to the startup
+  // snapshot.
   return o->IsName() || o->IsSharedFunctionInfo() || o->IsHeapNumber() ||
          o->IsCode() || o->IsScopeInfo() || o->IsAccessorInfo() ||
+         o->IsTemplateInfo() ||
          o->map() ==
              startup_serializer_->isolate()->heap()->fixed_cow_array_map();
 }
 
+bool PartialSerializer::HasEmbedderInternalFields(HeapObject* o) {
+  if (internal_fields_serializer_ == NULL) return false;
+  InstanceType type = o->map()->instance_type();
+  if (type != JS_API_OBJECT_TYPE && type != JS_SPECIAL_API_OBJECT_TYPE) {
+    return false;
+  }
+  return JSObject::cast(o)->GetInternalFieldCount() > 0;
+}
+
+void PartialSerializer::SerializeInternalFields() {
+  if (internal_field_holders_.is_empty()) return;
+  DCHECK_NOT_NULL(internal_fields_serializer_);
+  // The embedder callback must not change the heap that is being serialized.
+  DisallowHeapAllocation no_gc;
+  DisallowJavascriptExecution no_js(isolate());
+  sink_->Put(kInternalFieldsData, "InternalFieldsData");
+  for (JSObject* obj : internal_field_holders_) {
+    HandleScope scope(isolate());
+    Handle<JSObject> holder(obj, isolate());
+    BackReference reference = back_reference_map()->Lookup(obj);
+    DCHECK(reference.is_valid());
+    int internal_field_count = holder->GetInternalFieldCount();
+    for (int i = 0; i < internal_field_count; i++) {
+      // Heap objects are part of the serialized object graph already.
+      if (holder->GetInternalField(i)->IsHeapObject()) continue;
+      v8::StartupData data =
+          internal_fields_serializer_(v8::Utils::ToLocal(holder), i);
+      sink_->Put(kNewObject + reference.space(), "InternalFieldHolder");
+      PutBackReference(obj, reference);
+      sink_->PutInt(i, "internal field index");
+      sink_->PutInt(data.raw_size, "internal field data size");
+      sink_->PutRaw(reinterpret_cast<const byte*>(data.data), data.raw_size,
+                    "InternalFieldData");
+      delete[] data.data;
+    }
+  }
+  internal_field_holders_.Clear();
+  sink_->Put(kSynchronize, "Finished internal fields data");
+}
+
 }  // namespace internal
 }  // namespace v8
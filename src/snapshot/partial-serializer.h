@@ -5,16 +5,17 @@
 #ifndef V8_SNAPSHOT_PARTIAL_SERIALIZER_H_
 #define V8_SNAPSHOT_PARTIAL_SERIALIZER_H_
 
-#include "src/address-map.h"
-#include "src/snapshot/serializer.h"
+#include "src/snapshot/startup-serializer.h"
 
 namespace v8 {
 namespace internal {
 
 class PartialSerializer : public Serializer {
  public:
-  PartialSerializer(Isolate* isolate, Serializer* startup_snapshot_serializer,
-                    SnapshotByteSink* sink);
+  PartialSerializer(
+      Isolate* isolate, StartupSerializer* startup_snapshot_serializer,
+      SnapshotByteSink* sink,
+      v8::SerializeInternalFieldsCallback internal_fields_serializer = NULL);
 
   ~PartialSerializer() override;
 
@@ -22,37 +23,22 @@ class PartialSerializer : public Serializer {
   void Serialize(Object** o);
 
  private:
-  class PartialCacheIndexMap : public AddressMapBase {
-   public:
-    PartialCacheIndexMap() : map_(HashMap::PointersMatch) {}
-
-    static const int kInvalidIndex = -1;
-
-    // Lookup object in the map. Return its index if found, or create
-    // a new entry with new_index as value, and return kInvalidIndex.
-    int LookupOrInsert(HeapObject* obj, int new_index) {
-      HashMap::Entry* entry = LookupEntry(&map_, obj, false);
-      if (entry != NULL) return GetValue(entry);
-      SetValue(LookupEntry(&map_, obj, true), static_cast<uint32_t>(new_index));
-      return kInvalidIndex;
-    }
-
-   private:
-    HashMap map_;
-
-    DISALLOW_COPY_AND_ASSIGN(PartialCacheIndexMap);
-  };
-
   void SerializeObject(HeapObject* o, HowToCode how_to_code,
                        WhereToPoint where_to_point, int skip) override;
 
-  int PartialSnapshotCacheIndex(HeapObject* o);
   bool ShouldBeInThePartialSnapshotCache(HeapObject* o);
 
-  Serializer* startup_serializer_;
+  // Whether the internal fields of the API object {o} are serialized by the
+  // embedder callback.
+  bool HasEmbedderInternalFields(HeapObject* o);
+  void SerializeInternalFields();
+
+  StartupSerializer* startup_serializer_;
   Object* global_object_;
-  PartialCacheIndexMap partial_cache_index_map_;
-  int next_partial_cache_index_;
+  v8::SerializeInternalFieldsCallback internal_fields_serializer_;
+  // The API objects whose internal fields are serialized after the object
+  // graph, so that the deserializer can hand them to the embedder.
+  List<JSObject*> internal_field_holders_;
   DISALLOW_COPY_AND_ASSIGN(PartialSerializer);
 };
 
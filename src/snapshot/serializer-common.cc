@@ -33,7 +33,12 @@ uint32_t ExternalReferenceEncoder::Encode(Address address) const {
   DCHECK_NOT_NULL(address);
   HashMap::Entry* entry =
       const_cast<HashMap*>(map_)->Lookup(address, Hash(address));
-  DCHECK_NOT_NULL(entry);
+  if (entry == NULL) {
+    // Embedder callbacks have to be registered as external references, see
+    // v8::Isolate::CreateParams::external_references.
+    PrintF("Unknown external reference %p.\n", static_cast<void*>(address));
+    V8_Fatal(__FILE__, __LINE__, "Unknown external reference");
+  }
   return static_cast<uint32_t>(reinterpret_cast<intptr_t>(entry->value));
 }
 
@@ -173,7 +173,9 @@ class SerializerDeserializer : public ObjectVisitor {
   // Alignment prefixes 0x7d..0x7f
   static const int kAlignmentPrefix = 0x7d;
 
-  // 0x77 unused
+  // Used to encode embedder data of internal fields, see
+  // v8::SerializeInternalFieldsCallback.
+  static const int kInternalFieldsData = 0x77;
 
   // ---------- byte code range 0x80..0xff ----------
   // First 32 root array items.
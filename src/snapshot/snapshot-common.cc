@@ -9,6 +9,7 @@
 #include "src/api.h"
 #include "src/base/platform/platform.h"
 #include "src/full-codegen/full-codegen.h"
+#include "src/profiler/cpu-profiler.h"
 #include "src/snapshot/deserializer.h"
 #include "src/snapshot/snapshot-source-sink.h"
 #include "src/version.h"
@@ -18,8 +19,9 @@ namespace internal {
 
 #ifdef DEBUG
 bool Snapshot::SnapshotIsValid(v8::StartupData* snapshot_blob) {
+  if (Snapshot::ExtractNumContexts(snapshot_blob) == 0) return false;
   return !Snapshot::ExtractStartupData(snapshot_blob).is_empty() &&
-         !Snapshot::ExtractContextData(snapshot_blob).is_empty();
+         !Snapshot::ExtractContextData(snapshot_blob, 0).is_empty();
 }
 #endif  // DEBUG
 
@@ -64,30 +66,75 @@ bool Snapshot::Initialize(Isolate* isolate) {
     int bytes = startup_data.length();
     PrintF("[Deserializing isolate (%d bytes) took %0.3f ms]\n", bytes, ms);
   }
+  // Only the default snapshot blob is guaranteed to outlive the isolate. The
+  // embedder may dispose of any other blob once the contexts are created.
+  // An isolate that creates a snapshot needs all builtins to serialize them.
+  if (success && (!FLAG_lazy_deserialization || isolate->serializer_enabled() ||
+                  blob != DefaultSnapshotBlob())) {
+    DeserializeLazyBuiltins(isolate);
+  }
   return success;
 }
 
+void Snapshot::DeserializeBuiltin(Isolate* isolate, Builtins::Name name) {
+  base::ElapsedTimer timer;
+  if (FLAG_profile_deserialization) timer.Start();
+
+  Vector<const byte> builtin_data =
+      ExtractBuiltinData(isolate->snapshot_blob(), name);
+  CHECK(!builtin_data.is_empty());
+  SnapshotData snapshot_data(builtin_data);
+  Deserializer deserializer(&snapshot_data);
+  HandleScope scope(isolate);
+  Handle<Code> code = deserializer.DeserializeBuiltin(isolate);
+  DCHECK_EQ(static_cast<int>(name), code->builtin_index());
+  isolate->builtins()->set_builtin(name, *code);
+  PROFILE(isolate,
+          CodeCreateEvent(Logger::BUILTIN_TAG, AbstractCode::cast(*code),
+                          isolate->builtins()->name(name)));
+  if (FLAG_profile_deserialization) {
+    double ms = timer.Elapsed().InMillisecondsF();
+    PrintF("[Deserializing builtin %s (%d bytes) took %0.3f ms]\n",
+           isolate->builtins()->name(name), builtin_data.length(), ms);
+  }
+}
+
+void Snapshot::DeserializeLazyBuiltins(Isolate* isolate) {
+  const v8::StartupData* blob = isolate->snapshot_blob();
+  for (int i = 0; i < Builtins::builtin_count; i++) {
+    if (ExtractBuiltinData(blob, i).is_empty()) continue;
+    DeserializeBuiltin(isolate, static_cast<Builtins::Name>(i));
+  }
+}
+
 
 MaybeHandle<Context> Snapshot::NewContextFromSnapshot(
-    Isolate* isolate, Handle<JSGlobalProxy> global_proxy) {
+    Isolate* isolate, Handle<JSGlobalProxy> global_proxy, size_t context_index,
+    v8::DeserializeInternalFieldsCallback internal_fields_deserializer) {
   if (!isolate->snapshot_available()) return Handle<Context>();
   base::ElapsedTimer timer;
   if (FLAG_profile_deserialization) timer.Start();
 
   const v8::StartupData* blob = isolate->snapshot_blob();
-  Vector<const byte> context_data = ExtractContextData(blob);
+  int num_contexts = ExtractNumContexts(blob);
+  if (context_index >= static_cast<size_t>(num_contexts)) {
+    return MaybeHandle<Context>();
+  }
+  Vector<const byte> context_data =
+      ExtractContextData(blob, static_cast<int>(context_index));
   SnapshotData snapshot_data(context_data);
   Deserializer deserializer(&snapshot_data);
 
-  MaybeHandle<Object> maybe_context =
-      deserializer.DeserializePartial(isolate, global_proxy);
+  MaybeHandle<Object> maybe_context = deserializer.DeserializePartial(
+      isolate, global_proxy, internal_fields_deserializer);
   Handle<Object> result;
   if (!maybe_context.ToHandle(&result)) return MaybeHandle<Context>();
   CHECK(result->IsContext());
   if (FLAG_profile_deserialization) {
     double ms = timer.Elapsed().InMillisecondsF();
     int bytes = context_data.length();
-    PrintF("[Deserializing context (%d bytes) took %0.3f ms]\n", bytes, ms);
+    PrintF("[Deserializing context #%d (%d bytes) took %0.3f ms]\n",
+           static_cast<int>(context_index), bytes, ms);
   }
   return Handle<Context>::cast(result);
 }
@@ -164,44 +211,88 @@ void CalculateFirstPageSizes(bool is_default_snapshot,
 
 
 v8::StartupData Snapshot::CreateSnapshotBlob(
-    const i::StartupSerializer& startup_ser,
-    const i::PartialSerializer& context_ser, Snapshot::Metadata metadata) {
-  SnapshotData startup_snapshot(startup_ser);
-  SnapshotData context_snapshot(context_ser);
-  Vector<const byte> startup_data = startup_snapshot.RawData();
-  Vector<const byte> context_data = context_snapshot.RawData();
+    const SnapshotData* startup_snapshot,
+    const List<SnapshotData*>* builtin_snapshots,
+    const List<SnapshotData*>* context_snapshots,
+    Snapshot::Metadata metadata) {
+  int num_contexts = context_snapshots->length();
+  DCHECK_LT(0, num_contexts);
+  DCHECK_EQ(Builtins::builtin_count, builtin_snapshots->length());
+  int startup_snapshot_offset = StartupSnapshotOffset(num_contexts);
+  int total_length = startup_snapshot_offset;
+  total_length += startup_snapshot->RawData().length();
+  for (const auto& builtin_snapshot : *builtin_snapshots) {
+    if (builtin_snapshot == NULL) continue;
+    total_length += builtin_snapshot->RawData().length();
+  }
+  for (const auto& context_snapshot : *context_snapshots) {
+    total_length += context_snapshot->RawData().length();
+  }
 
+  // The first page sizes are tuned for the context that v8::Context::New()
+  // deserializes.
   uint32_t first_page_sizes[kNumPagedSpaces];
+  CalculateFirstPageSizes(!metadata.embeds_script(), *startup_snapshot,
+                          *context_snapshots->at(0), first_page_sizes);
 
-  CalculateFirstPageSizes(!metadata.embeds_script(), startup_snapshot,
-                          context_snapshot, first_page_sizes);
-
-  int startup_length = startup_data.length();
-  int context_length = context_data.length();
-  int context_offset = ContextOffset(startup_length);
-
-  int length = context_offset + context_length;
-  char* data = new char[length];
-
+  char* data = new char[total_length];
+  memcpy(data + kNumberOfContextsOffset, &num_contexts, kInt32Size);
   memcpy(data + kMetadataOffset, &metadata.RawValue(), kInt32Size);
   memcpy(data + kFirstPageSizesOffset, first_page_sizes,
          kNumPagedSpaces * kInt32Size);
-  memcpy(data + kStartupLengthOffset, &startup_length, kInt32Size);
-  memcpy(data + kStartupDataOffset, startup_data.begin(), startup_length);
-  memcpy(data + context_offset, context_data.begin(), context_length);
-  v8::StartupData result = {data, length};
-
+  int payload_offset = startup_snapshot_offset;
+  int payload_length = startup_snapshot->RawData().length();
+  memcpy(data + payload_offset, startup_snapshot->RawData().start(),
+         payload_length);
   if (FLAG_profile_deserialization) {
-    PrintF(
-        "Snapshot blob consists of:\n"
-        "%10d bytes for startup\n"
-        "%10d bytes for context\n",
-        startup_length, context_length);
+    PrintF("Snapshot blob consists of:\n%10d bytes for startup\n",
+           payload_length);
+  }
+  payload_offset += payload_length;
+  int builtins_length = 0;
+  for (int i = 0; i < Builtins::builtin_count; i++) {
+    memcpy(data + BuiltinSnapshotOffsetOffset(num_contexts, i),
+           &payload_offset, kInt32Size);
+    SnapshotData* builtin_snapshot = builtin_snapshots->at(i);
+    if (builtin_snapshot == NULL) continue;
+    payload_length = builtin_snapshot->RawData().length();
+    memcpy(data + payload_offset, builtin_snapshot->RawData().start(),
+           payload_length);
+    builtins_length += payload_length;
+    payload_offset += payload_length;
+  }
+  memcpy(data + BuiltinSnapshotOffsetOffset(num_contexts,
+                                            Builtins::builtin_count),
+         &payload_offset, kInt32Size);
+  if (FLAG_profile_deserialization) {
+    PrintF("%10d bytes for lazily deserialized builtins\n", builtins_length);
+  }
+  for (int i = 0; i < num_contexts; i++) {
+    memcpy(data + ContextSnapshotOffsetOffset(i), &payload_offset, kInt32Size);
+    SnapshotData* context_snapshot = context_snapshots->at(i);
+    payload_length = context_snapshot->RawData().length();
+    memcpy(data + payload_offset, context_snapshot->RawData().start(),
+           payload_length);
+    if (FLAG_profile_deserialization) {
+      PrintF("%10d bytes for context #%d\n", payload_length, i);
+    }
+    payload_offset += payload_length;
   }
+  DCHECK_EQ(total_length, payload_offset);
+
+  v8::StartupData result = {data, total_length};
   return result;
 }
 
 
+int Snapshot::ExtractNumContexts(const v8::StartupData* data) {
+  CHECK_LT(kNumberOfContextsOffset, data->raw_size);
+  int num_contexts;
+  memcpy(&num_contexts, data->data + kNumberOfContextsOffset, kInt32Size);
+  return num_contexts;
+}
+
+
 Snapshot::Metadata Snapshot::ExtractMetadata(const v8::StartupData* data) {
   uint32_t raw;
   memcpy(&raw, data->data + kMetadataOffset, kInt32Size);
@@ -210,25 +301,63 @@ Snapshot::Metadata Snapshot::ExtractMetadata(const v8::StartupData* data) {
 
 
 Vector<const byte> Snapshot::ExtractStartupData(const v8::StartupData* data) {
-  DCHECK_LT(kIntSize, data->raw_size);
-  int startup_length;
-  memcpy(&startup_length, data->data + kStartupLengthOffset, kInt32Size);
-  DCHECK_LT(startup_length, data->raw_size);
+  int num_contexts = ExtractNumContexts(data);
+  int startup_offset = StartupSnapshotOffset(num_contexts);
+  CHECK_LT(startup_offset, data->raw_size);
+  int first_builtin_offset;
+  memcpy(&first_builtin_offset,
+         data->data + BuiltinSnapshotOffsetOffset(num_contexts, 0),
+         kInt32Size);
+  CHECK_LT(first_builtin_offset, data->raw_size);
+  int startup_length = first_builtin_offset - startup_offset;
   const byte* startup_data =
-      reinterpret_cast<const byte*>(data->data + kStartupDataOffset);
+      reinterpret_cast<const byte*>(data->data + startup_offset);
   return Vector<const byte>(startup_data, startup_length);
 }
 
+Vector<const byte> Snapshot::ExtractBuiltinData(const v8::StartupData* data,
+                                                int index) {
+  int num_contexts = ExtractNumContexts(data);
+  CHECK_LT(index, Builtins::builtin_count);
+
+  int builtin_offset;
+  memcpy(&builtin_offset,
+         data->data + BuiltinSnapshotOffsetOffset(num_contexts, index),
+         kInt32Size);
+  int next_builtin_offset;
+  memcpy(&next_builtin_offset,
+         data->data + BuiltinSnapshotOffsetOffset(num_contexts, index + 1),
+         kInt32Size);
+  CHECK_LE(builtin_offset, next_builtin_offset);
+  CHECK_LT(next_builtin_offset, data->raw_size);
+
+  const byte* builtin_data =
+      reinterpret_cast<const byte*>(data->data + builtin_offset);
+  int builtin_length = next_builtin_offset - builtin_offset;
+  return Vector<const byte>(builtin_data, builtin_length);
+}
+
+
+Vector<const byte> Snapshot::ExtractContextData(const v8::StartupData* data,
+                                                int index) {
+  int num_contexts = ExtractNumContexts(data);
+  CHECK_LT(index, num_contexts);
+
+  int context_offset;
+  memcpy(&context_offset, data->data + ContextSnapshotOffsetOffset(index),
+         kInt32Size);
+  int next_context_offset;
+  if (index == num_contexts - 1) {
+    next_context_offset = data->raw_size;
+  } else {
+    memcpy(&next_context_offset,
+           data->data + ContextSnapshotOffsetOffset(index + 1), kInt32Size);
+    CHECK_LT(next_context_offset, data->raw_size);
+  }
 
-Vector<const byte> Snapshot::ExtractContextData(const v8::StartupData* data) {
-  DCHECK_LT(kIntSize, data->raw_size);
-  int startup_length;
-  memcpy(&startup_length, data->data + kStartupLengthOffset, kIntSize);
-  int context_offset = ContextOffset(startup_length);
   const byte* context_data =
       reinterpret_cast<const byte*>(data->data + context_offset);
-  DCHECK_LT(context_offset, data->raw_size);
-  int context_length = data->raw_size - context_offset;
+  int context_length = next_context_offset - context_offset;
   return Vector<const byte>(context_data, context_length);
 }
 
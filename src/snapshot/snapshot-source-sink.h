@@ -38,7 +38,26 @@ class SnapshotByteSource final {
 
   void Advance(int by) { position_ += by; }
 
-  void CopyRaw(byte* to, int number_of_bytes);
+  // Raw data makes up most of a snapshot, so this is inlined into the
+  // deserializer's loop.
+  void CopyRaw(byte* to, int number_of_bytes) {
+    DCHECK_LE(position_ + number_of_bytes, length_);
+    MemCopy(to, data_ + position_, number_of_bytes);
+    position_ += number_of_bytes;
+  }
+
+  // Copies the few words of a kFixedRawData section. These are too short to
+  // be worth a call of MemCopy, which is not inlined on all platforms, so
+  // they are copied word by word. Neither side has to be aligned.
+  void CopyRawWords(byte* to, int number_of_words) {
+    const byte* from = data_ + position_;
+    int number_of_bytes = number_of_words * kPointerSize;
+    DCHECK_LE(position_ + number_of_bytes, length_);
+    for (int offset = 0; offset < number_of_bytes; offset += kPointerSize) {
+      memcpy(to + offset, from + offset, kPointerSize);
+    }
+    position_ += number_of_bytes;
+  }
 
   inline int GetInt() {
     // This way of decoding variable-length encoded integers does not
@@ -57,10 +76,11 @@ class SnapshotByteSource final {
     return answer;
   }
 
-  // Returns length.
+  // Returns length. The data is not copied, it points into the source.
   int GetBlob(const byte** data);
 
   int position() { return position_; }
+  int length() const { return length_; }
 
  private:
   const byte* data_;
@@ -14,6 +14,7 @@ namespace internal {
 // Forward declarations.
 class Isolate;
 class PartialSerializer;
+class SnapshotData;
 class StartupSerializer;
 
 class Snapshot : public AllStatic {
@@ -36,9 +37,16 @@ class Snapshot : public AllStatic {
   // Initialize the Isolate from the internal snapshot. Returns false if no
   // snapshot could be found.
   static bool Initialize(Isolate* isolate);
-  // Create a new context using the internal partial snapshot.
+  // Create a new context using the internal partial snapshot. The context at
+  // index 0 is the one that v8::Context::New() deserializes.
   static MaybeHandle<Context> NewContextFromSnapshot(
-      Isolate* isolate, Handle<JSGlobalProxy> global_proxy);
+      Isolate* isolate, Handle<JSGlobalProxy> global_proxy,
+      size_t context_index,
+      v8::DeserializeInternalFieldsCallback internal_fields_deserializer);
+
+  // Deserialize a builtin that the startup snapshot only contains a
+  // placeholder for, and install it in the builtins table.
+  static void DeserializeBuiltin(Isolate* isolate, Builtins::Name name);
 
   static bool HaveASnapshotToStartFrom(Isolate* isolate);
 
@@ -50,36 +58,71 @@ class Snapshot : public AllStatic {
   // To be implemented by the snapshot source.
   static const v8::StartupData* DefaultSnapshotBlob();
 
+  // {builtin_snapshots} holds the snapshot of each builtin that is
+  // deserialized lazily, indexed by builtin, and NULL for the others.
   static v8::StartupData CreateSnapshotBlob(
-      const StartupSerializer& startup_ser,
-      const PartialSerializer& context_ser, Snapshot::Metadata metadata);
+      const SnapshotData* startup_snapshot,
+      const List<SnapshotData*>* builtin_snapshots,
+      const List<SnapshotData*>* context_snapshots,
+      Snapshot::Metadata metadata);
 
 #ifdef DEBUG
   static bool SnapshotIsValid(v8::StartupData* snapshot_blob);
 #endif  // DEBUG
 
  private:
+  static int ExtractNumContexts(const v8::StartupData* data);
   static Vector<const byte> ExtractStartupData(const v8::StartupData* data);
-  static Vector<const byte> ExtractContextData(const v8::StartupData* data);
+  static Vector<const byte> ExtractBuiltinData(const v8::StartupData* data,
+                                               int index);
+  static Vector<const byte> ExtractContextData(const v8::StartupData* data,
+                                               int index);
   static Metadata ExtractMetadata(const v8::StartupData* data);
 
+  // Deserializes the builtins that would otherwise be read from the blob on
+  // their first call.
+  static void DeserializeLazyBuiltins(Isolate* isolate);
+
   // Snapshot blob layout:
-  // [0] metadata
-  // [1 - 6] pre-calculated first page sizes for paged spaces
-  // [7] serialized start up data length
+  // [0] number of contexts N
+  // [1] metadata
+  // [2 - 7] pre-calculated first page sizes for paged spaces
+  // [8] offset to context 0
+  // [9] offset to context 1
+  // ...
+  // ... offset to context N - 1
+  // ... offset to builtin 0
+  // ... offset to builtin 1
+  // ...
+  // ... offset to builtin B - 1
+  // ... offset to the end of the builtins
   // ... serialized start up data
-  // ... serialized context data
+  // ... serialized builtin 0 (empty unless it is deserialized lazily)
+  // ... serialized builtin 1
+  // ...
+  // ... serialized context 0
+  // ... serialized context 1
+  // ...
 
   static const int kNumPagedSpaces = LAST_PAGED_SPACE - FIRST_PAGED_SPACE + 1;
 
-  static const int kMetadataOffset = 0;
+  static const int kNumberOfContextsOffset = 0;
+  static const int kMetadataOffset = kNumberOfContextsOffset + kInt32Size;
   static const int kFirstPageSizesOffset = kMetadataOffset + kInt32Size;
-  static const int kStartupLengthOffset =
+  static const int kFirstContextOffsetOffset =
       kFirstPageSizesOffset + kNumPagedSpaces * kInt32Size;
-  static const int kStartupDataOffset = kStartupLengthOffset + kInt32Size;
 
-  static int ContextOffset(int startup_length) {
-    return kStartupDataOffset + startup_length;
+  static int StartupSnapshotOffset(int num_contexts) {
+    return BuiltinSnapshotOffsetOffset(num_contexts, Builtins::builtin_count) +
+           kInt32Size;
+  }
+
+  static int BuiltinSnapshotOffsetOffset(int num_contexts, int index) {
+    return kFirstContextOffsetOffset + (num_contexts + index) * kInt32Size;
+  }
+
+  static int ContextSnapshotOffsetOffset(int index) {
+    return kFirstContextOffsetOffset + index * kInt32Size;
   }
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(Snapshot);
@@ -0,0 +1,292 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/snapshot/startup-data-compression.h"
+
+#include "src/base/platform/platform.h"
+#include "src/base/sys-info.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+// Parameters of the LZ4 block format.
+const int kMinMatch = 4;
+// The last five bytes of a block are always literals.
+const int kLastLiterals = 5;
+// The last match starts at least twelve bytes before the end of a block.
+const int kMatchFindLimit = 12;
+const int kMaxOffset = 0xffff;
+const int kRunMask = 0xf;
+
+const int kHashBits = 14;
+
+uint32_t Read32(const byte* p) {
+  uint32_t value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+uint32_t HashSequence(uint32_t sequence) {
+  return (sequence * 2654435761u) >> (32 - kHashBits);
+}
+
+uint32_t ReadLittleEndian32(const byte* p) {
+  return p[0] | (p[1] << 8) | (p[2] << 16) |
+         (static_cast<uint32_t>(p[3]) << 24);
+}
+
+void WriteLittleEndian32(byte* p, uint32_t value) {
+  for (int i = 0; i < 4; i++) p[i] = static_cast<byte>(value >> (8 * i));
+}
+
+void EmitLength(std::vector<byte>* out, int length) {
+  for (; length >= 0xff; length -= 0xff) out->push_back(0xff);
+  out->push_back(static_cast<byte>(length));
+}
+
+// Emits {literals} literal bytes starting at {start}, followed by a match of
+// {match_length} bytes at {offset}, or by nothing if {match_length} is 0.
+void EmitSequence(std::vector<byte>* out, const byte* start, int literals,
+                  int offset, int match_length) {
+  int match_code = match_length == 0 ? 0 : match_length - kMinMatch;
+  int token = (Min(literals, kRunMask) << 4) | Min(match_code, kRunMask);
+  out->push_back(static_cast<byte>(token));
+  if (literals >= kRunMask) EmitLength(out, literals - kRunMask);
+  out->insert(out->end(), start, start + literals);
+  if (match_length == 0) return;
+  out->push_back(static_cast<byte>(offset));
+  out->push_back(static_cast<byte>(offset >> 8));
+  if (match_code >= kRunMask) EmitLength(out, match_code - kRunMask);
+}
+
+bool ReadLength(const byte** in, const byte* in_end, size_t* length) {
+  byte b;
+  do {
+    if (*in == in_end) return false;
+    b = *(*in)++;
+    *length += b;
+  } while (b == 0xff);
+  return true;
+}
+
+}  // namespace
+
+class StartupDataCompression::DecompressionThread : public base::Thread {
+ public:
+  DecompressionThread(const std::vector<Chunk>* chunks, size_t first,
+                      size_t stride)
+      : Thread(Options("StartupDataDecompression")),
+        chunks_(chunks),
+        first_(first),
+        stride_(stride),
+        success_(false) {}
+
+  void Run() override {
+    success_ = DecompressChunks(*chunks_, first_, stride_);
+  }
+
+  bool success() const { return success_; }
+
+ private:
+  const std::vector<Chunk>* chunks_;
+  size_t first_;
+  size_t stride_;
+  bool success_;
+};
+
+// static
+bool StartupDataCompression::IsCompressed(Vector<const byte> data) {
+  return data.length() >= kHeaderEntries * kInt32Size &&
+         ReadLittleEndian32(data.start()) == kMagicNumber;
+}
+
+// static
+Vector<byte> StartupDataCompression::CompressBlock(Vector<const byte> input) {
+  const byte* start = input.start();
+  int length = input.length();
+  std::vector<byte> out;
+  out.reserve(length + length / 0xff + 16);
+
+  int anchor = 0;
+  if (length > kMatchFindLimit) {
+    std::vector<int> table(1 << kHashBits, -1);
+    int match_end_limit = length - kLastLiterals;
+    for (int pos = 0; pos < length - kMatchFindLimit;) {
+      uint32_t sequence = Read32(start + pos);
+      uint32_t hash = HashSequence(sequence);
+      int candidate = table[hash];
+      table[hash] = pos;
+      if (candidate < 0 || pos - candidate > kMaxOffset ||
+          Read32(start + candidate) != sequence) {
+        pos++;
+        continue;
+      }
+      int match_length = kMinMatch;
+      while (pos + match_length < match_end_limit &&
+             start[candidate + match_length] == start[pos + match_length]) {
+        match_length++;
+      }
+      EmitSequence(&out, start + anchor, pos - anchor, pos - candidate,
+                   match_length);
+      pos += match_length;
+      anchor = pos;
+    }
+  }
+  EmitSequence(&out, start + anchor, length - anchor, 0, 0);
+
+  Vector<byte> result = Vector<byte>::New(static_cast<int>(out.size()));
+  CopyBytes(result.start(), out.data(), out.size());
+  return result;
+}
+
+// static
+bool StartupDataCompression::DecompressBlock(Vector<const byte> input,
+                                             Vector<byte> output) {
+  const byte* in = input.start();
+  const byte* in_end = in + input.length();
+  byte* out = output.start();
+  byte* out_end = out + output.length();
+  while (in < in_end) {
+    int token = *in++;
+    size_t literals = token >> 4;
+    if (literals == kRunMask && !ReadLength(&in, in_end, &literals)) {
+      return false;
+    }
+    if (static_cast<size_t>(in_end - in) < literals ||
+        static_cast<size_t>(out_end - out) < literals) {
+      return false;
+    }
+    MemCopy(out, in, literals);
+    in += literals;
+    out += literals;
+    // The last sequence has no match.
+    if (in == in_end) break;
+
+    if (in_end - in < 2) return false;
+    size_t offset = in[0] | (in[1] << 8);
+    in += 2;
+    if (offset == 0 || offset > static_cast<size_t>(out - output.start())) {
+      return false;
+    }
+    size_t match_length = token & kRunMask;
+    if (match_length == kRunMask && !ReadLength(&in, in_end, &match_length)) {
+      return false;
+    }
+    match_length += kMinMatch;
+    if (static_cast<size_t>(out_end - out) < match_length) return false;
+    const byte* match = out - offset;
+    if (offset >= match_length) {
+      MemCopy(out, match, match_length);
+      out += match_length;
+    } else {
+      // The match overlaps the bytes it produces.
+      for (size_t i = 0; i < match_length; i++) *out++ = *match++;
+    }
+  }
+  return out == out_end;
+}
+
+// static
+bool StartupDataCompression::DecompressChunks(const std::vector<Chunk>& chunks,
+                                              size_t first, size_t stride) {
+  for (size_t i = first; i < chunks.size(); i += stride) {
+    if (!DecompressBlock(chunks[i].input, chunks[i].output)) return false;
+  }
+  return true;
+}
+
+// static
+Vector<byte> StartupDataCompression::Compress(Vector<const byte> data) {
+  int chunk_count = (data.length() + kChunkSize - 1) / kChunkSize;
+  std::vector<Vector<byte>> chunks;
+  int size = (kHeaderEntries + chunk_count) * kInt32Size;
+  for (int i = 0; i < chunk_count; i++) {
+    int offset = i * kChunkSize;
+    int length = Min(kChunkSize, data.length() - offset);
+    chunks.push_back(CompressBlock(data.SubVector(offset, offset + length)));
+    size += chunks.back().length();
+  }
+
+  Vector<byte> result = Vector<byte>::New(size);
+  byte* header = result.start();
+  WriteLittleEndian32(header, kMagicNumber);
+  WriteLittleEndian32(header + kInt32Size, data.length());
+  WriteLittleEndian32(header + 2 * kInt32Size, kChunkSize);
+  WriteLittleEndian32(header + 3 * kInt32Size, chunk_count);
+  byte* payload = header + (kHeaderEntries + chunk_count) * kInt32Size;
+  for (int i = 0; i < chunk_count; i++) {
+    WriteLittleEndian32(header + (kHeaderEntries + i) * kInt32Size,
+                        chunks[i].length());
+    CopyBytes(payload, chunks[i].start(), chunks[i].length());
+    payload += chunks[i].length();
+    chunks[i].Dispose();
+  }
+  DCHECK_EQ(result.start() + size, payload);
+  return result;
+}
+
+// static
+Vector<byte> StartupDataCompression::Decompress(Vector<const byte> data) {
+  if (!IsCompressed(data)) return Vector<byte>();
+  const byte* header = data.start();
+  uint32_t size = ReadLittleEndian32(header + kInt32Size);
+  uint32_t chunk_size = ReadLittleEndian32(header + 2 * kInt32Size);
+  uint32_t chunk_count = ReadLittleEndian32(header + 3 * kInt32Size);
+  if (size > static_cast<uint32_t>(kMaxInt) || chunk_size == 0 ||
+      chunk_count != (size + (chunk_size - 1)) / chunk_size) {
+    return Vector<byte>();
+  }
+  size_t header_size =
+      (kHeaderEntries + static_cast<size_t>(chunk_count)) * kInt32Size;
+  if (header_size > static_cast<size_t>(data.length())) return Vector<byte>();
+
+  Vector<byte> result = Vector<byte>::New(static_cast<int>(size));
+  std::vector<Chunk> chunks(chunk_count);
+  size_t input_offset = header_size;
+  for (uint32_t i = 0; i < chunk_count; i++) {
+    size_t input_size =
+        ReadLittleEndian32(header + (kHeaderEntries + i) * kInt32Size);
+    if (input_size > data.length() - input_offset) {
+      result.Dispose();
+      return Vector<byte>();
+    }
+    size_t output_offset = static_cast<size_t>(i) * chunk_size;
+    size_t output_size = Min<size_t>(chunk_size, size - output_offset);
+    chunks[i].input = Vector<const byte>(data.start() + input_offset,
+                                         static_cast<int>(input_size));
+    chunks[i].output = Vector<byte>(result.start() + output_offset,
+                                    static_cast<int>(output_size));
+    input_offset += input_size;
+  }
+  if (input_offset != static_cast<size_t>(data.length())) {
+    result.Dispose();
+    return Vector<byte>();
+  }
+
+  // The calling thread decompresses its share of the chunks as well.
+  size_t thread_count = Min<size_t>(
+      chunks.size(), Min(kMaxThreads, base::SysInfo::NumberOfProcessors()));
+  thread_count = Max<size_t>(thread_count, 1);
+  std::vector<DecompressionThread*> threads;
+  for (size_t i = 1; i < thread_count; i++) {
+    threads.push_back(new DecompressionThread(&chunks, i, thread_count));
+    threads.back()->Start();
+  }
+  bool success = DecompressChunks(chunks, 0, thread_count);
+  for (DecompressionThread* thread : threads) {
+    thread->Join();
+    success &= thread->success();
+    delete thread;
+  }
+  if (!success) {
+    result.Dispose();
+    return Vector<byte>();
+  }
+  return result;
+}
+
+}  // namespace internal
+}  // namespace v8
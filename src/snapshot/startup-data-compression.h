@@ -0,0 +1,64 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_SNAPSHOT_STARTUP_DATA_COMPRESSION_H_
+#define V8_SNAPSHOT_STARTUP_DATA_COMPRESSION_H_
+
+#include <vector>
+
+#include "src/utils.h"
+
+namespace v8 {
+namespace internal {
+
+// Compression of the external startup blobs, i.e. natives_blob.bin and
+// snapshot_blob.bin, for targets where reading the files dominates startup.
+//
+// A compressed blob consists of uint32_t-sized little-endian header entries
+//   [0] magic number
+//   [1] uncompressed size
+//   [2] chunk size
+//   [3] number of chunks
+//   [4 .. 4 + number of chunks - 1] compressed size of each chunk
+// followed by the chunks. Every chunk is an LZ4 block that decompresses to
+// chunk size bytes, except for the last one, which may be shorter. Chunks
+// are independent of each other, so they are decompressed in parallel.
+//
+// tools/concatenate-files.py implements the same format for the natives.
+class StartupDataCompression : public AllStatic {
+ public:
+  static const uint32_t kMagicNumber = 0x7a6c3856;  // "V8lz"
+  static const int kChunkSize = 256 * KB;
+
+  static bool IsCompressed(Vector<const byte> data);
+
+  // The result is allocated with NewArray and owned by the caller.
+  static Vector<byte> Compress(Vector<const byte> data);
+
+  // The result is allocated with NewArray and owned by the caller. Returns
+  // an empty vector if {data} is not a valid compressed blob.
+  static Vector<byte> Decompress(Vector<const byte> data);
+
+ private:
+  struct Chunk {
+    Vector<const byte> input;
+    Vector<byte> output;
+  };
+  class DecompressionThread;
+
+  static const int kHeaderEntries = 4;
+  static const int kMaxThreads = 4;
+
+  static Vector<byte> CompressBlock(Vector<const byte> input);
+  // Decompresses an LZ4 block into {output}, which it has to fill exactly.
+  static bool DecompressBlock(Vector<const byte> input, Vector<byte> output);
+  // Decompresses every {stride}th chunk, starting with chunk {first}.
+  static bool DecompressChunks(const std::vector<Chunk>& chunks, size_t first,
+                               size_t stride);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_SNAPSHOT_STARTUP_DATA_COMPRESSION_H_
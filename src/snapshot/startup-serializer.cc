@@ -12,10 +12,13 @@ namespace internal {
 
 StartupSerializer::StartupSerializer(
     Isolate* isolate, SnapshotByteSink* sink,
-    FunctionCodeHandling function_code_handling)
+    FunctionCodeHandling function_code_handling,
+    const List<Code*>* lazy_builtin_placeholders)
     : Serializer(isolate, sink),
       function_code_handling_(function_code_handling),
-      serializing_builtins_(false) {
+      lazy_builtin_placeholders_(lazy_builtin_placeholders),
+      serializing_builtins_(false),
+      next_partial_cache_index_(0) {
   InitializeCodeAddressMap();
 }
 
@@ -27,6 +30,16 @@ void StartupSerializer::SerializeObject(HeapObject* obj, HowToCode how_to_code,
                                         WhereToPoint where_to_point, int skip) {
   DCHECK(!obj->IsJSFunction());
 
+  if (lazy_builtin_placeholders_ != NULL && obj->IsCode()) {
+    Code* code = Code::cast(obj);
+    // This also replaces placeholders from the snapshot this isolate was
+    // deserialized from, which carry the index of their builtin as well.
+    if (code->kind() == Code::BUILTIN &&
+        Builtins::IsLazy(code->builtin_index())) {
+      obj = lazy_builtin_placeholders_->at(code->builtin_index());
+    }
+  }
+
   if (function_code_handling_ == CLEAR_FUNCTION_CODE) {
     if (obj->IsCode()) {
       Code* code = Code::cast(obj);
@@ -78,6 +91,19 @@ void StartupSerializer::SerializeObject(HeapObject* obj, HowToCode how_to_code,
   }
 }
 
+int StartupSerializer::PartialSnapshotCacheIndex(HeapObject* heap_object) {
+  int index = partial_cache_index_map_.LookupOrInsert(
+      heap_object, next_partial_cache_index_);
+  if (index == PartialCacheIndexMap::kInvalidIndex) {
+    // This object is not part of the partial snapshot cache yet. Add it to the
+    // startup snapshot so we can refer to it via partial snapshot index from
+    // the partial snapshot.
+    VisitPointer(reinterpret_cast<Object**>(&heap_object));
+    return next_partial_cache_index_++;
+  }
+  return index;
+}
+
 void StartupSerializer::SerializeWeakReferencesAndDeferred() {
   // This comes right after serialization of the partial snapshot, where we
   // add entries to the partial snapshot cache of the startup snapshot. Add
@@ -6,6 +6,7 @@
 #define V8_SNAPSHOT_STARTUP_SERIALIZER_H_
 
 #include <bitset>
+#include "src/address-map.h"
 #include "src/snapshot/serializer.h"
 
 namespace v8 {
@@ -15,9 +16,13 @@ class StartupSerializer : public Serializer {
  public:
   enum FunctionCodeHandling { CLEAR_FUNCTION_CODE, KEEP_FUNCTION_CODE };
 
+  // If {lazy_builtin_placeholders} is given, it holds a placeholder for each
+  // builtin that is deserialized lazily, indexed by builtin. The startup
+  // snapshot refers to these builtins only through their placeholders.
   StartupSerializer(
       Isolate* isolate, SnapshotByteSink* sink,
-      FunctionCodeHandling function_code_handling = CLEAR_FUNCTION_CODE);
+      FunctionCodeHandling function_code_handling = CLEAR_FUNCTION_CODE,
+      const List<Code*>* lazy_builtin_placeholders = NULL);
   ~StartupSerializer() override;
 
   // Serialize the current state of the heap.  The order is:
@@ -28,7 +33,33 @@ class StartupSerializer : public Serializer {
   void SerializeStrongReferences();
   void SerializeWeakReferencesAndDeferred();
 
+  // Returns the index of {o} in the partial snapshot cache. Objects that are
+  // not in the cache yet are added to the startup snapshot. The cache is
+  // shared by all partial snapshots serialized against this one.
+  int PartialSnapshotCacheIndex(HeapObject* o);
+
  private:
+  class PartialCacheIndexMap : public AddressMapBase {
+   public:
+    PartialCacheIndexMap() : map_(HashMap::PointersMatch) {}
+
+    static const int kInvalidIndex = -1;
+
+    // Lookup object in the map. Return its index if found, or create
+    // a new entry with new_index as value, and return kInvalidIndex.
+    int LookupOrInsert(HeapObject* obj, int new_index) {
+      HashMap::Entry* entry = LookupEntry(&map_, obj, false);
+      if (entry != NULL) return GetValue(entry);
+      SetValue(LookupEntry(&map_, obj, true), static_cast<uint32_t>(new_index));
+      return kInvalidIndex;
+    }
+
+   private:
+    HashMap map_;
+
+    DISALLOW_COPY_AND_ASSIGN(PartialCacheIndexMap);
+  };
+
   // The StartupSerializer has to serialize the root array, which is slightly
   // different.
   void VisitPointers(Object** start, Object** end) override;
@@ -43,9 +74,12 @@ class StartupSerializer : public Serializer {
   bool RootShouldBeSkipped(int root_index);
 
   FunctionCodeHandling function_code_handling_;
+  const List<Code*>* lazy_builtin_placeholders_;
   bool serializing_builtins_;
   bool serializing_immortal_immovables_roots_;
   std::bitset<Heap::kStrongRootListLength> root_has_been_serialized_;
+  PartialCacheIndexMap partial_cache_index_map_;
+  int next_partial_cache_index_;
   DISALLOW_COPY_AND_ASSIGN(StartupSerializer);
 };
 
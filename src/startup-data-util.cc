@@ -9,6 +9,7 @@
 
 #include "src/base/logging.h"
 #include "src/base/platform/platform.h"
+#include "src/snapshot/startup-data-compression.h"
 #include "src/utils.h"
 
 
@@ -22,6 +23,11 @@ namespace {
 v8::StartupData g_natives;
 v8::StartupData g_snapshot;
 
+// The blob files are mapped read-only where possible, so that processes
+// loading the same files share their pages.
+base::OS::MemoryMappedFile* g_natives_file = nullptr;
+base::OS::MemoryMappedFile* g_snapshot_file = nullptr;
+
 
 void ClearStartupData(v8::StartupData* data) {
   data->data = nullptr;
@@ -29,24 +35,72 @@ void ClearStartupData(v8::StartupData* data) {
 }
 
 
-void DeleteStartupData(v8::StartupData* data) {
-  delete[] data->data;
+void DeleteStartupData(v8::StartupData* data,
+                       base::OS::MemoryMappedFile** file) {
+  if (*file != nullptr) {
+    delete *file;
+    *file = nullptr;
+  } else {
+    delete[] data->data;
+  }
   ClearStartupData(data);
 }
 
 
 void FreeStartupData() {
-  DeleteStartupData(&g_natives);
-  DeleteStartupData(&g_snapshot);
+  DeleteStartupData(&g_natives, &g_natives_file);
+  DeleteStartupData(&g_snapshot, &g_snapshot_file);
+}
+
+
+bool Map(const char* blob_file, v8::StartupData* startup_data,
+         base::OS::MemoryMappedFile** file) {
+  base::OS::MemoryMappedFile* mapped = base::OS::MemoryMappedFile::open(
+      blob_file, base::OS::MemoryMappedFile::FileMode::kReadOnly);
+  if (mapped == nullptr) return false;
+  if (mapped->size() == 0 || mapped->size() > static_cast<size_t>(kMaxInt)) {
+    delete mapped;
+    return false;
+  }
+  *file = mapped;
+  startup_data->data = reinterpret_cast<const char*>(mapped->memory());
+  startup_data->raw_size = static_cast<int>(mapped->size());
+  return true;
+}
+
+
+// Replaces compressed blobs by their decompressed contents, which are owned by
+// {startup_data} rather than by the mapped file.
+bool MaybeDecompress(v8::StartupData* startup_data,
+                     base::OS::MemoryMappedFile** file) {
+  Vector<const byte> data(reinterpret_cast<const byte*>(startup_data->data),
+                          startup_data->raw_size);
+  if (!StartupDataCompression::IsCompressed(data)) return true;
+  Vector<byte> decompressed = StartupDataCompression::Decompress(data);
+  DeleteStartupData(startup_data, file);
+  if (decompressed.is_empty()) return false;
+  startup_data->data = reinterpret_cast<const char*>(decompressed.start());
+  startup_data->raw_size = decompressed.length();
+  return true;
 }
 
 
 void Load(const char* blob_file, v8::StartupData* startup_data,
+          base::OS::MemoryMappedFile** mapped_file,
           void (*setter_fn)(v8::StartupData*)) {
   ClearStartupData(startup_data);
 
   CHECK(blob_file);
 
+  if (Map(blob_file, startup_data, mapped_file)) {
+    if (MaybeDecompress(startup_data, mapped_file)) {
+      (*setter_fn)(startup_data);
+    } else {
+      PrintF(stderr, "Corrupted startup resource '%s'.\n", blob_file);
+    }
+    return;
+  }
+
   FILE* file = fopen(blob_file, "rb");
   if (!file) {
     PrintF(stderr, "Failed to open startup resource '%s'.\n", blob_file);
@@ -62,7 +116,8 @@ void Load(const char* blob_file, v8::StartupData* startup_data,
                                          1, startup_data->raw_size, file));
   fclose(file);
 
-  if (startup_data->raw_size == read_size) {
+  if (startup_data->raw_size == read_size &&
+      MaybeDecompress(startup_data, mapped_file)) {
     (*setter_fn)(startup_data);
   } else {
     PrintF(stderr, "Corrupted startup resource '%s'.\n", blob_file);
@@ -71,8 +126,9 @@ void Load(const char* blob_file, v8::StartupData* startup_data,
 
 
 void LoadFromFiles(const char* natives_blob, const char* snapshot_blob) {
-  Load(natives_blob, &g_natives, v8::V8::SetNativesDataBlob);
-  Load(snapshot_blob, &g_snapshot, v8::V8::SetSnapshotDataBlob);
+  Load(natives_blob, &g_natives, &g_natives_file, v8::V8::SetNativesDataBlob);
+  Load(snapshot_blob, &g_snapshot, &g_snapshot_file,
+       v8::V8::SetSnapshotDataBlob);
 
   atexit(&FreeStartupData);
 }
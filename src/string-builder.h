@@ -329,6 +329,11 @@ class IncrementalStringBuilder {
       const uint8_t* u = reinterpret_cast<const uint8_t*>(s);
       while (*u != '\0') Append(*(u++));
     }
+    template <typename SrcChar>
+    INLINE(void AppendChars(const SrcChar* chars, int length)) {
+      CopyChars(cursor_, chars, length);
+      cursor_ += length;
+    }
 
     int written() { return static_cast<int>(cursor_ - start_); }
 
@@ -270,6 +270,48 @@ inline bool CharCompare(const PatternChar* pattern,
 }
 
 
+// Linear search of one-byte subjects for short one-byte patterns. Checks a
+// word of start positions at a time for both the first and the last pattern
+// character, which filters out far more candidates than the first character
+// alone when that character is common.
+inline int FirstLastCharacterSearch(Vector<const uint8_t> pattern,
+                                    Vector<const uint8_t> subject, int index) {
+  int pattern_length = pattern.length();
+  DCHECK(pattern_length > 1);
+  const uint8_t* chars = subject.start();
+  const uint8_t first_char = pattern[0];
+  const uint8_t last_char = pattern[pattern_length - 1];
+  int i = index;
+  int n = subject.length() - pattern_length;
+  // (x - ones) & ~x & highs is non-zero iff some byte of x is zero. Bytes of
+  // both words that match set their high bit in both masks.
+  const uintptr_t ones = kUintptrAllBitsSet / 0xFF;
+  const uintptr_t highs = ones * 0x80;
+  const uintptr_t firsts = ones * first_char;
+  const uintptr_t lasts = ones * last_char;
+  for (; i + kIntptrSize - 1 <= n; i += kIntptrSize) {
+    uintptr_t f = ReadUnalignedValue<uintptr_t>(chars + i) ^ firsts;
+    uintptr_t l =
+        ReadUnalignedValue<uintptr_t>(chars + i + pattern_length - 1) ^ lasts;
+    if ((((f - ones) & ~f) & ((l - ones) & ~l) & highs) == 0) continue;
+    for (int j = i; j < i + kIntptrSize; j++) {
+      if (chars[j] == first_char &&
+          chars[j + pattern_length - 1] == last_char &&
+          CharCompare(pattern.start() + 1, chars + j + 1, pattern_length - 1)) {
+        return j;
+      }
+    }
+  }
+  for (; i <= n; i++) {
+    if (chars[i] == first_char && chars[i + pattern_length - 1] == last_char &&
+        CharCompare(pattern.start() + 1, chars + i + 1, pattern_length - 1)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+
 // Simple linear search for short patterns. Never bails out.
 template <typename PatternChar, typename SubjectChar>
 int StringSearch<PatternChar, SubjectChar>::LinearSearch(
@@ -278,6 +320,11 @@ int StringSearch<PatternChar, SubjectChar>::LinearSearch(
     int index) {
   Vector<const PatternChar> pattern = search->pattern_;
   DCHECK(pattern.length() > 1);
+  if (sizeof(PatternChar) == 1 && sizeof(SubjectChar) == 1) {
+    return FirstLastCharacterSearch(
+        Vector<const uint8_t>::cast(pattern),
+        Vector<const uint8_t>::cast(subject), index);
+  }
   int pattern_length = pattern.length();
   int i = index;
   int n = subject.length() - pattern_length;
@@ -224,5 +224,266 @@ int rempio2(double x, double* y) {
   }
   return n;
 }
+
+
+namespace {
+
+static const double invpio2 = 6.36619772367581382433e-01;
+static const double pio2_1 = 1.57079632673412561417;
+static const double pio2_1t = 6.07710050650619224932e-11;
+static const double pio2_2 = 6.07710050630396597660e-11;
+static const double pio2_2t = 2.02226624879595063154e-21;
+static const double pio2_3 = 2.02226624871116645580e-21;
+static const double pio2_3t = 8.47842766036889956997e-32;
+static const double pio4 = 7.85398163397448278999e-01;
+static const double pio4lo = 3.06161699786838301793e-17;
+
+static const double S1 = -1.66666666666666324348e-01;
+static const double S2 = 8.33333333332248946124e-03;
+static const double S3 = -1.98412698298579493134e-04;
+static const double S4 = 2.75573137070700676789e-06;
+static const double S5 = -2.50507602534068634195e-08;
+static const double S6 = 1.58969099521155010221e-10;
+
+static const double C1 = 4.16666666666666019037e-02;
+static const double C2 = -1.38888888888741095749e-03;
+static const double C3 = 2.48015872894767294178e-05;
+static const double C4 = -2.75573143513906633035e-07;
+static const double C5 = 2.08757232129817482790e-09;
+static const double C6 = -1.13596475577881948265e-11;
+
+static const double T[] = {
+    3.33333333333334091986e-01,  1.33333333333201242699e-01,
+    5.39682539762260521377e-02,  2.18694882948595424599e-02,
+    8.86323982359930005737e-03,  3.59207910759131235356e-03,
+    1.45620945432529025516e-03,  5.88041240820264096874e-04,
+    2.46463134818469906812e-04,  7.81794442939557092300e-05,
+    7.14072491382608190305e-05,  -1.85586374855275456654e-05,
+    2.59073051863633712884e-05};
+
+
+inline int32_t HighWord(double x) {
+  return static_cast<int32_t>(internal::double_to_uint64(x) >> 32);
+}
+
+
+inline int32_t LowWord(double x) {
+  return static_cast<int32_t>(internal::double_to_uint64(x) & 0xFFFFFFFFu);
+}
+
+
+// Returns the double with the given high word and a zero low word.
+inline double FromHighWord(int32_t hx) {
+  return internal::uint64_to_double(static_cast<uint64_t>(hx) << 32);
+}
+
+
+// Computes n and y such that x - n*pi/2 = y[0] + y[1] with |y| < pi/4. This
+// is the REMPIO2 macro of fdlibm.js, and must compute the same results.
+int32_t __ieee754_rem_pio2(double x, double* y) {
+  int32_t hx = HighWord(x);
+  int32_t ix = hx & 0x7fffffff;
+  int32_t n;
+
+  if (ix < 0x4002d97c) {
+    // |x| ~< 3*pi/4, special case with n = +/- 1
+    if (hx > 0) {
+      double z = x - pio2_1;
+      if (ix != 0x3ff921fb) {
+        // 33+53 bit pi is good enough
+        y[0] = z - pio2_1t;
+        y[1] = (z - y[0]) - pio2_1t;
+      } else {
+        // near pi/2, use 33+33+53 bit pi
+        z -= pio2_2;
+        y[0] = z - pio2_2t;
+        y[1] = (z - y[0]) - pio2_2t;
+      }
+      return 1;
+    } else {
+      // Negative x
+      double z = x + pio2_1;
+      if (ix != 0x3ff921fb) {
+        // 33+53 bit pi is good enough
+        y[0] = z + pio2_1t;
+        y[1] = (z - y[0]) + pio2_1t;
+      } else {
+        // near pi/2, use 33+33+53 bit pi
+        z += pio2_2;
+        y[0] = z + pio2_2t;
+        y[1] = (z - y[0]) + pio2_2t;
+      }
+      return -1;
+    }
+  } else if (ix <= 0x413921fb) {
+    // |x| ~<= 2^19*(pi/2), medium size
+    double t = std::fabs(x);
+    n = static_cast<int32_t>(t * invpio2 + 0.5);
+    double fn = static_cast<double>(n);
+    double r = t - fn * pio2_1;
+    double w = fn * pio2_1t;
+    // First round good to 85 bit
+    y[0] = r - w;
+    if (ix - (HighWord(y[0]) & 0x7ff00000) > 0x1000000) {
+      // 2nd iteration needed, good to 118
+      t = r;
+      w = fn * pio2_2;
+      r = t - w;
+      w = fn * pio2_2t - ((t - r) - w);
+      y[0] = r - w;
+      if (ix - (HighWord(y[0]) & 0x7ff00000) > 0x3100000) {
+        // 3rd iteration needed. 151 bits accuracy
+        t = r;
+        w = fn * pio2_3;
+        r = t - w;
+        w = fn * pio2_3t - ((t - r) - w);
+        y[0] = r - w;
+      }
+    }
+    y[1] = (r - y[0]) - w;
+    if (hx < 0) {
+      y[0] = -y[0];
+      y[1] = -y[1];
+      return -n;
+    }
+    return n;
+  }
+  // Need to do full Payne-Hanek reduction here.
+  return rempio2(x, y);
+}
+
+
+// Sine on [-pi/4, pi/4], where y is the tail of x. See the description of
+// __kernel_sin in fdlibm.js.
+double __kernel_sin(double x, double y) {
+  double z = x * x;
+  double v = z * x;
+  double r = S2 + z * (S3 + z * (S4 + z * (S5 + z * S6)));
+  return x - ((z * (0.5 * y - v * r) - y) - v * S1);
+}
+
+
+// Cosine on [-pi/4, pi/4], where y is the tail of x. See the description of
+// __kernel_cos in fdlibm.js.
+double __kernel_cos(double x, double y) {
+  int32_t ix = HighWord(x) & 0x7fffffff;
+  double z = x * x;
+  double r = z * (C1 + z * (C2 + z * (C3 + z * (C4 + z * (C5 + z * C6)))));
+  if (ix < 0x3fd33333) {  // |x| ~< 0.3
+    return 1 - (0.5 * z - (z * r - x * y));
+  }
+  double qx;
+  if (ix > 0x3fe90000) {  // |x| > 0.78125
+    qx = 0.28125;
+  } else {
+    qx = FromHighWord(HighWord(0.25 * x));
+  }
+  double hz = 0.5 * z - qx;
+  return 1 - qx - (hz - (z * r - x * y));
+}
+
+
+// Tangent (if k is 1) or -1/tangent (if k is -1) on [-pi/4, pi/4], where y is
+// the tail of x. See the description of KernelTan in fdlibm.js.
+double __kernel_tan(double x, double y, int k) {
+  double z;
+  double w;
+  int32_t hx = HighWord(x);
+  int32_t ix = hx & 0x7fffffff;
+
+  if (ix < 0x3e300000) {  // |x| < 2^-28
+    if (((ix | LowWord(x)) | (k + 1)) == 0) {
+      // x == 0 && k == -1
+      return 1 / std::fabs(x);
+    } else if (k == 1) {
+      return x;
+    } else {
+      // Compute -1/(x + y) carefully
+      w = x + y;
+      z = FromHighWord(HighWord(w));
+      double v = y - (z - x);
+      double a = -1 / w;
+      double t = FromHighWord(HighWord(a));
+      double s = 1 + t * z;
+      return t + a * (s + t * v);
+    }
+  }
+  if (ix >= 0x3fe59428) {  // |x| > .6744
+    if (x < 0) {
+      x = -x;
+      y = -y;
+    }
+    z = pio4 - x;
+    w = pio4lo - y;
+    x = z + w;
+    y = 0;
+  }
+  z = x * x;
+  w = z * z;
+
+  // Break x^5 * (T1 + x^2*T2 + ...) into
+  // x^5 * (T1 + x^4*T3 + ... + x^20*T11) +
+  // x^5 * (x^2 * (T2 + x^4*T4 + ... + x^22*T12))
+  double r = T[1] + w * (T[3] + w * (T[5] +
+             w * (T[7] + w * (T[9] + w * T[11]))));
+  double v = z * (T[2] + w * (T[4] + w * (T[6] +
+             w * (T[8] + w * (T[10] + w * T[12])))));
+  double s = z * x;
+  r = y + z * (s * (r + v) + y);
+  r = r + T[0] * s;
+  w = x + r;
+  if (ix >= 0x3fe59428) {
+    return (1 - ((hx >> 30) & 2)) * (k - 2.0 * (x - (w * w / (w + k) - r)));
+  }
+  if (k == 1) return w;
+  z = FromHighWord(HighWord(w));
+  v = r - (z - x);
+  double a = -1 / w;
+  double t = FromHighWord(HighWord(a));
+  s = 1 + t * z;
+  return t + a * (s + t * v);
+}
+
+}  // namespace
+
+
+double sin(double x) {
+  if ((HighWord(x) & 0x7fffffff) <= 0x3fe921fb) {
+    // |x| < pi/4, approximately.  No reduction needed.
+    return __kernel_sin(x, 0);
+  }
+  double y[2] = {0, 0};
+  int32_t n = __ieee754_rem_pio2(x, y);
+  double sign = 1 - (n & 2);
+  if (n & 1) return __kernel_cos(y[0], y[1]) * sign;
+  return __kernel_sin(y[0], y[1]) * sign;
+}
+
+
+double cos(double x) {
+  if ((HighWord(x) & 0x7fffffff) <= 0x3fe921fb) {
+    // |x| < pi/4, approximately.  No reduction needed.
+    return __kernel_cos(x, 0);
+  }
+  double y[2] = {0, 0};
+  int32_t n = __ieee754_rem_pio2(x, y);
+  if (n & 1) {
+    double sign = (n & 2) - 1;
+    return __kernel_sin(y[0], y[1]) * sign;
+  }
+  double sign = 1 - (n & 2);
+  return __kernel_cos(y[0], y[1]) * sign;
+}
+
+
+double tan(double x) {
+  if ((HighWord(x) & 0x7fffffff) <= 0x3fe921fb) {
+    // |x| < pi/4, approximately.  No reduction needed.
+    return __kernel_tan(x, 0, 1);
+  }
+  double y[2] = {0, 0};
+  int32_t n = __ieee754_rem_pio2(x, y);
+  return __kernel_tan(y[0], y[1], (n & 1) ? -1 : 1);
+}
 }  // namespace internal
 }  // namespace v8
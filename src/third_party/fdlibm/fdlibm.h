@@ -21,6 +21,11 @@ namespace fdlibm {
 
 int rempio2(double x, double* y);
 
+// The sine, cosine and tangent of fdlibm.js, for use by optimized code.
+double sin(double x);
+double cos(double x);
+double tan(double x);
+
 }  // namespace internal
 }  // namespace v8
 
@@ -50,27 +50,33 @@ TypeFeedbackVector* TypeFeedbackVector::cast(Object* obj) {
 int TypeFeedbackMetadata::GetSlotSize(FeedbackVectorSlotKind kind) {
   DCHECK_NE(FeedbackVectorSlotKind::INVALID, kind);
   DCHECK_NE(FeedbackVectorSlotKind::KINDS_NUMBER, kind);
-  return kind == FeedbackVectorSlotKind::GENERAL ? 1 : 2;
+  return kind == FeedbackVectorSlotKind::GENERAL ||
+                 kind == FeedbackVectorSlotKind::COUNTER
+             ? 1
+             : 2;
 }
 
 
 bool TypeFeedbackVector::is_empty() const {
-  if (length() == 0) return true;
-  DCHECK(length() > kReservedIndexCount);
-  return false;
+  return length() <= kReservedIndexCount;
+}
+
+
+bool TypeFeedbackVector::is_lazy() const {
+  return length() == kReservedIndexCount;
 }
 
 
 int TypeFeedbackVector::slot_count() const {
-  if (length() == 0) return 0;
-  DCHECK(length() > kReservedIndexCount);
+  if (is_empty()) return 0;
   return length() - kReservedIndexCount;
 }
 
 
 TypeFeedbackMetadata* TypeFeedbackVector::metadata() const {
-  return is_empty() ? TypeFeedbackMetadata::cast(GetHeap()->empty_fixed_array())
-                    : TypeFeedbackMetadata::cast(get(kMetadataIndex));
+  return length() == 0
+             ? TypeFeedbackMetadata::cast(GetHeap()->empty_fixed_array())
+             : TypeFeedbackMetadata::cast(get(kMetadataIndex));
 }
 
 
@@ -113,6 +119,11 @@ void TypeFeedbackVector::ComputeCounts(int* with_type_info, int* generic) {
       *TypeFeedbackVector::MegamorphicSentinel(GetIsolate());
   int with = 0;
   int gen = 0;
+  if (is_lazy()) {
+    *with_type_info = with;
+    *generic = gen;
+    return;
+  }
   TypeFeedbackMetadataIterator iter(metadata());
   while (iter.HasNext()) {
     FeedbackVectorSlot slot = iter.Next();
@@ -120,7 +131,8 @@ void TypeFeedbackVector::ComputeCounts(int* with_type_info, int* generic) {
 
     Object* obj = Get(slot);
     if (obj != uninitialized_sentinel &&
-        kind != FeedbackVectorSlotKind::GENERAL) {
+        kind != FeedbackVectorSlotKind::GENERAL &&
+        kind != FeedbackVectorSlotKind::COUNTER) {
       if (obj->IsWeakCell() || obj->IsFixedArray() || obj->IsString()) {
         with++;
       } else if (obj == megamorphic_sentinel) {
@@ -124,6 +124,8 @@ const char* TypeFeedbackMetadata::Kind2String(FeedbackVectorSlotKind kind) {
       return "KEYED_STORE_IC";
     case FeedbackVectorSlotKind::GENERAL:
       return "STUB";
+    case FeedbackVectorSlotKind::COUNTER:
+      return "COUNTER";
     case FeedbackVectorSlotKind::KINDS_NUMBER:
       break;
   }
@@ -153,6 +155,29 @@ Handle<TypeFeedbackVector> TypeFeedbackVector::New(
     array->set(i, *uninitialized_sentinel, SKIP_WRITE_BARRIER);
   }
 
+  // Block counters start out at zero.
+  TypeFeedbackMetadataIterator iter(metadata);
+  while (iter.HasNext()) {
+    FeedbackVectorSlot slot = iter.Next();
+    if (iter.kind() != FeedbackVectorSlotKind::COUNTER) continue;
+    array->set(kReservedIndexCount + slot.ToInt(), Smi::FromInt(0));
+  }
+
+  return Handle<TypeFeedbackVector>::cast(array);
+}
+
+
+// static
+Handle<TypeFeedbackVector> TypeFeedbackVector::NewLazy(
+    Isolate* isolate, Handle<TypeFeedbackMetadata> metadata) {
+  Factory* factory = isolate->factory();
+  if (metadata->slot_count() == 0) {
+    return Handle<TypeFeedbackVector>::cast(factory->empty_fixed_array());
+  }
+
+  Handle<FixedArray> array =
+      factory->NewFixedArray(kReservedIndexCount, TENURED);
+  array->set(kMetadataIndex, *metadata);
   return Handle<TypeFeedbackVector>::cast(array);
 }
 
@@ -186,9 +211,18 @@ void TypeFeedbackVector::ClearSlotsImpl(SharedFunctionInfo* shared,
   Isolate* isolate = GetIsolate();
 
   if (!force_clear && !ClearLogic(isolate)) return;
+  if (is_lazy()) return;
 
   Object* uninitialized_sentinel =
       TypeFeedbackVector::RawUninitializedSentinel(isolate);
+  // Megamorphic feedback, together with the call count of a megamorphic
+  // call, does not refer to any object of the context it was collected in.
+  // Keep it in a snapshot, so that the code compiled by a warm-up script
+  // does not have to go through the IC states again in every new isolate.
+  Object* megamorphic_sentinel =
+      isolate->serializer_enabled()
+          ? *TypeFeedbackVector::MegamorphicSentinel(isolate)
+          : uninitialized_sentinel;
 
   TypeFeedbackMetadataIterator iter(metadata());
   while (iter.HasNext()) {
@@ -196,7 +230,7 @@ void TypeFeedbackVector::ClearSlotsImpl(SharedFunctionInfo* shared,
     FeedbackVectorSlotKind kind = iter.kind();
 
     Object* obj = Get(slot);
-    if (obj != uninitialized_sentinel) {
+    if (obj != uninitialized_sentinel && obj != megamorphic_sentinel) {
       switch (kind) {
         case FeedbackVectorSlotKind::CALL_IC: {
           CallICNexus nexus(this, slot);
@@ -236,6 +270,9 @@ void TypeFeedbackVector::ClearSlotsImpl(SharedFunctionInfo* shared,
           }
           break;
         }
+        case FeedbackVectorSlotKind::COUNTER:
+          // Block counters are never cleared.
+          break;
         case FeedbackVectorSlotKind::INVALID:
         case FeedbackVectorSlotKind::KINDS_NUMBER:
           UNREACHABLE();
@@ -259,6 +296,7 @@ void TypeFeedbackVector::ClearAllKeyedStoreICs(Isolate* isolate) {
 
 void TypeFeedbackVector::ClearKeyedStoreICs(SharedFunctionInfo* shared) {
   Isolate* isolate = GetIsolate();
+  if (is_lazy()) return;
 
   Code* host = shared->code();
   Object* uninitialized_sentinel =
@@ -31,6 +31,10 @@ enum class FeedbackVectorSlotKind {
   // This is a general purpose slot that occupies one feedback vector element.
   GENERAL,
 
+  // Counts how often a block was executed for --block-coverage. It occupies
+  // one feedback vector element that always holds a Smi.
+  COUNTER,
+
   KINDS_NUMBER  // Last value indicating number of kinds.
 };
 
@@ -66,6 +70,10 @@ class FeedbackVectorSpecBase {
   FeedbackVectorSlot AddGeneralSlot() {
     return AddSlot(FeedbackVectorSlotKind::GENERAL);
   }
+
+  FeedbackVectorSlot AddCounterSlot() {
+    return AddSlot(FeedbackVectorSlotKind::COUNTER);
+  }
 };
 
 
@@ -155,7 +163,7 @@ class TypeFeedbackMetadata : public FixedArray {
   static const char* Kind2String(FeedbackVectorSlotKind kind);
 
  private:
-  static const int kFeedbackVectorSlotKindBits = 3;
+  static const int kFeedbackVectorSlotKindBits = 4;
   STATIC_ASSERT(static_cast<int>(FeedbackVectorSlotKind::KINDS_NUMBER) <
                 (1 << kFeedbackVectorSlotKindBits));
 
@@ -176,6 +184,10 @@ class TypeFeedbackMetadata : public FixedArray {
 // ...
 // N + slot_count - 1: feedback slot #(slot_count-1)
 //
+// A lazy vector only consists of the feedback metadata, its slots are
+// allocated by SharedFunctionInfo::EnsureFeedbackVector. Until then the
+// interpreter runs the function against the megamorphic dummy vector.
+//
 class TypeFeedbackVector : public FixedArray {
  public:
   // Casting.
@@ -187,6 +199,7 @@ class TypeFeedbackVector : public FixedArray {
   inline void ComputeCounts(int* with_type_info, int* generic);
 
   inline bool is_empty() const;
+  inline bool is_lazy() const;
 
   // Returns number of slots in the vector.
   inline int slot_count() const;
@@ -209,6 +222,8 @@ class TypeFeedbackVector : public FixedArray {
 
   static Handle<TypeFeedbackVector> New(Isolate* isolate,
                                         Handle<TypeFeedbackMetadata> metadata);
+  static Handle<TypeFeedbackVector> NewLazy(
+      Isolate* isolate, Handle<TypeFeedbackMetadata> metadata);
 
   static Handle<TypeFeedbackVector> Copy(Isolate* isolate,
                                          Handle<TypeFeedbackVector> vector);
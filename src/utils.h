@@ -9,6 +9,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <cmath>
+#include <type_traits>
 
 #include "include/v8.h"
 #include "src/allocation.h"
@@ -620,6 +621,39 @@ inline int CompareChars(const lchar* lhs, const rchar* rhs, size_t chars) {
 }
 
 
+// Same as CompareChars(lhs, rhs, chars) == 0, but faster. Equality does not
+// depend on the byte order, so characters of the same width are compared
+// with memcmp, and characters of different widths in blocks that the
+// compiler can vectorize.
+template <typename lchar, typename rchar>
+inline bool CompareCharsEqual(const lchar* lhs, const rchar* rhs,
+                              size_t chars) {
+  DCHECK(sizeof(lchar) <= 2);
+  DCHECK(sizeof(rchar) <= 2);
+  if (sizeof(lchar) == sizeof(rchar)) {
+    return memcmp(lhs, rhs, chars * sizeof(lchar)) == 0;
+  }
+  typedef typename std::conditional<sizeof(lchar) == 1, uint8_t,
+                                    uint16_t>::type lunsigned;
+  typedef typename std::conditional<sizeof(rchar) == 1, uint8_t,
+                                    uint16_t>::type runsigned;
+  const lunsigned* l = reinterpret_cast<const lunsigned*>(lhs);
+  const runsigned* r = reinterpret_cast<const runsigned*>(rhs);
+  const size_t kBlockSize = 16;
+  for (; chars >= kBlockSize; chars -= kBlockSize) {
+    int difference = 0;
+    for (size_t i = 0; i < kBlockSize; i++) difference |= l[i] ^ r[i];
+    if (difference != 0) return false;
+    l += kBlockSize;
+    r += kBlockSize;
+  }
+  for (size_t i = 0; i < chars; i++) {
+    if (l[i] != r[i]) return false;
+  }
+  return true;
+}
+
+
 // Calculate 10^exponent.
 inline int TenToThe(int exponent) {
   DCHECK(exponent <= 9);
@@ -1543,6 +1577,45 @@ static inline void WriteUnalignedUInt32(void* p, uint32_t value) {
   WriteUnalignedValue(p, value);
 }
 
+// Returns the index of the first '"', '\' or control character in
+// chars[start, end), or end if there is none. These are exactly the one-byte
+// characters that JSON string literals have to escape. Checks a word at a
+// time, since string bodies usually make up most of JSON text.
+static inline int FindJsonStringSpecialCharacter(const uint8_t* chars,
+                                                 int start, int end) {
+  int i = start;
+  if (end - start >= kIntptrSize) {
+    // Check unaligned bytes.
+    while (!IsAligned(reinterpret_cast<intptr_t>(chars + i),
+                      sizeof(uintptr_t))) {
+      uint8_t c = chars[i];
+      if (c == '"' || c == '\\' || c < 0x20) return i;
+      i++;
+    }
+    // Check aligned words. (x - ones * n) & ~x & highs is non-zero iff some
+    // byte of x is below n, for n <= 0x80. With n = 1 applied to the word
+    // xor'ed with a repeated character this finds that character.
+    const uintptr_t ones = kUintptrAllBitsSet / 0xFF;
+    const uintptr_t highs = ones * 0x80;
+    while (i + kIntptrSize <= end) {
+      uintptr_t w = *reinterpret_cast<const uintptr_t*>(chars + i);
+      uintptr_t quote = w ^ (ones * '"');
+      uintptr_t backslash = w ^ (ones * '\\');
+      uintptr_t special = ((quote - ones) & ~quote) |
+                          ((backslash - ones) & ~backslash) |
+                          ((w - ones * 0x20) & ~w);
+      if (special & highs) break;
+      i += kIntptrSize;
+    }
+  }
+  // Check remaining bytes.
+  for (; i < end; i++) {
+    uint8_t c = chars[i];
+    if (c == '"' || c == '\\' || c < 0x20) return i;
+  }
+  return end;
+}
+
 }  // namespace internal
 }  // namespace v8
 
@@ -31,6 +31,10 @@
     'v8_code': 1,
     'v8_random_seed%': 314159265,
     'v8_vector_stores%': 0,
+    # Compress natives_blob.bin and snapshot_blob.bin. Only embedders that
+    # load them through v8::internal::InitializeExternalStartupData (like d8)
+    # can read the compressed files.
+    'v8_compress_startup_data%': 0,
     'embed_script%': "",
     'warmup_script%': "",
     'v8_extra_library_files%': [],
@@ -319,6 +323,9 @@
                   ['v8_vector_stores!=0', {
                     'mksnapshot_flags': ['--vector-stores'],
                   }],
+                  ['v8_compress_startup_data==1', {
+                    'mksnapshot_flags': ['--compress_startup_blob'],
+                  }],
                 ],
               },
               'conditions': [
@@ -447,6 +454,8 @@
         'atomic-utils.h',
         'background-parsing-task.cc',
         'background-parsing-task.h',
+        'background-task-budget.cc',
+        'background-task-budget.h',
         'bailout-reason.cc',
         'bailout-reason.h',
         'basic-block-profiler.cc',
@@ -457,6 +466,8 @@
         'bignum.h',
         'bit-vector.cc',
         'bit-vector.h',
+        'block-coverage.cc',
+        'block-coverage.h',
         'bootstrapper.cc',
         'bootstrapper.h',
         'builtins.cc',
@@ -491,6 +502,8 @@
         'compiler/access-info.h',
         'compiler/all-nodes.cc',
         'compiler/all-nodes.h',
+        'compiler/allocation-folding.cc',
+        'compiler/allocation-folding.h',
         'compiler/ast-graph-builder.cc',
         'compiler/ast-graph-builder.h',
         'compiler/ast-loop-assignment-analyzer.cc',
@@ -659,6 +672,8 @@
         'compiler/source-position.h',
         'compiler/state-values-utils.cc',
         'compiler/state-values-utils.h',
+        'compiler/store-store-elimination.cc',
+        'compiler/store-store-elimination.h',
         'compiler/tail-call-optimization.cc',
         'compiler/tail-call-optimization.h',
         'compiler/type-hint-analyzer.cc',
@@ -831,6 +846,7 @@
         'heap-symbols.h',
         'heap/array-buffer-tracker.cc',
         'heap/array-buffer-tracker.h',
+        'heap/concurrent-marking-deque.h',
         'heap/memory-reducer.cc',
         'heap/memory-reducer.h',
         'heap/gc-idle-time-handler.cc',
@@ -880,6 +896,8 @@
         'ic/ic-inl.h',
         'ic/ic-state.cc',
         'ic/ic-state.h',
+        'ic/ic-stats.cc',
+        'ic/ic-stats.h',
         'ic/ic.cc',
         'ic/ic.h',
         'ic/ic-compiler.cc',
@@ -894,10 +912,18 @@
         'interpreter/bytecode-array-builder.h',
         'interpreter/bytecode-array-iterator.cc',
         'interpreter/bytecode-array-iterator.h',
+        'interpreter/bytecode-array-writer.cc',
+        'interpreter/bytecode-array-writer.h',
         'interpreter/bytecode-register-allocator.cc',
         'interpreter/bytecode-register-allocator.h',
+        'interpreter/bytecode-register-optimizer.cc',
+        'interpreter/bytecode-register-optimizer.h',
         'interpreter/bytecode-generator.cc',
         'interpreter/bytecode-generator.h',
+        'interpreter/bytecode-peephole-optimizer.cc',
+        'interpreter/bytecode-peephole-optimizer.h',
+        'interpreter/bytecode-pipeline.cc',
+        'interpreter/bytecode-pipeline.h',
         'interpreter/bytecode-traits.h',
         'interpreter/constant-array-builder.cc',
         'interpreter/constant-array-builder.h',
@@ -989,6 +1015,7 @@
         'profiler/heap-snapshot-generator-inl.h',
         'profiler/heap-snapshot-generator.cc',
         'profiler/heap-snapshot-generator.h',
+        'profiler/output-stream-writer.h',
         'profiler/profile-generator-inl.h',
         'profiler/profile-generator.cc',
         'profiler/profile-generator.h',
@@ -1067,6 +1094,8 @@
         'signature.h',
         'simulator.h',
         'small-pointer-list.h',
+        'snapshot/builtin-serializer.cc',
+        'snapshot/builtin-serializer.h',
         'snapshot/code-serializer.cc',
         'snapshot/code-serializer.h',
         'snapshot/deserializer.cc',
@@ -1083,6 +1112,8 @@
         'snapshot/snapshot-common.cc',
         'snapshot/snapshot-source-sink.cc',
         'snapshot/snapshot-source-sink.h',
+        'snapshot/startup-data-compression.cc',
+        'snapshot/startup-data-compression.h',
         'snapshot/startup-serializer.cc',
         'snapshot/startup-serializer.h',
         'source-position.h',
@@ -1132,6 +1163,8 @@
         'v8memory.h',
         'v8threads.cc',
         'v8threads.h',
+        'value-serializer.cc',
+        'value-serializer.h',
         'vector.h',
         'version.cc',
         'version.h',
@@ -1148,6 +1181,8 @@
         'wasm/module-decoder.cc',
         'wasm/module-decoder.h',
         'wasm/switch-logic.h',
+        'wasm/streaming-decoder.cc',
+        'wasm/streaming-decoder.h',
         'wasm/switch-logic.cc',
         'wasm/wasm-external-refs.cc',
         'wasm/wasm-external-refs.h',
@@ -1660,6 +1695,7 @@
         'base/functional.h',
         'base/iterator.h',
         'base/lazy-instance.h',
+        'base/lockfree-queue.h',
         'base/logging.cc',
         'base/logging.h',
         'base/macros.h',
@@ -1902,10 +1938,18 @@
       ],
       'sources': [
         '../include/libplatform/libplatform.h',
+        '../include/libplatform/v8-tracing.h',
         'libplatform/default-platform.cc',
         'libplatform/default-platform.h',
         'libplatform/task-queue.cc',
         'libplatform/task-queue.h',
+        'libplatform/tracing/trace-buffer.cc',
+        'libplatform/tracing/trace-buffer.h',
+        'libplatform/tracing/trace-config.cc',
+        'libplatform/tracing/trace-object.cc',
+        'libplatform/tracing/trace-writer.cc',
+        'libplatform/tracing/trace-writer.h',
+        'libplatform/tracing/tracing-controller.cc',
         'libplatform/worker-thread.cc',
         'libplatform/worker-thread.h',
       ],
@@ -1936,6 +1980,14 @@
           ],
           'actions': [{
             'action_name': 'concatenate_natives_blob',
+            'variables': {
+              'concatenate_flags': [],
+              'conditions': [
+                ['v8_compress_startup_data==1', {
+                  'concatenate_flags': ['--compress'],
+                }],
+              ],
+            },
             'inputs': [
               '../tools/concatenate-files.py',
               '<(SHARED_INTERMEDIATE_DIR)/libraries.bin',
@@ -1951,14 +2003,16 @@
                       '<(PRODUCT_DIR)/natives_blob_host.bin',
                     ],
                     'action': [
-                      'python', '<@(_inputs)', '<(PRODUCT_DIR)/natives_blob_host.bin'
+                      'python', '<@(_inputs)', '<@(concatenate_flags)',
+                      '<(PRODUCT_DIR)/natives_blob_host.bin'
                     ],
                   }, {
                     'outputs': [
                       '<(PRODUCT_DIR)/natives_blob.bin',
                     ],
                     'action': [
-                      'python', '<@(_inputs)', '<(PRODUCT_DIR)/natives_blob.bin'
+                      'python', '<@(_inputs)', '<@(concatenate_flags)',
+                      '<(PRODUCT_DIR)/natives_blob.bin'
                     ],
                   }],
                 ],
@@ -1967,7 +2021,8 @@
                   '<(PRODUCT_DIR)/natives_blob.bin',
                 ],
                 'action': [
-                  'python', '<@(_inputs)', '<(PRODUCT_DIR)/natives_blob.bin'
+                  'python', '<@(_inputs)', '<@(concatenate_flags)',
+                  '<(PRODUCT_DIR)/natives_blob.bin'
                 ],
               }],
             ],
@@ -0,0 +1,206 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_VALUE_SERIALIZER_H_
+#define V8_VALUE_SERIALIZER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "include/v8.h"
+#include "src/base/compiler-specific.h"
+#include "src/base/macros.h"
+#include "src/identity-map.h"
+#include "src/messages.h"
+#include "src/vector.h"
+#include "src/zone.h"
+
+namespace v8 {
+namespace internal {
+
+class HeapNumber;
+class Isolate;
+class JSArrayBuffer;
+class JSArrayBufferView;
+class JSDate;
+class Object;
+class Oddball;
+class SeededNumberDictionary;
+class Smi;
+
+enum class SerializationTag : uint8_t;
+
+// Writes V8 objects in a binary format that allows the objects to be cloned
+// according to the HTML structured clone algorithm. The tags of the wire
+// format are listed in value-serializer.cc.
+class ValueSerializer {
+ public:
+  ValueSerializer(Isolate* isolate, v8::ValueSerializer::Delegate* delegate);
+  ~ValueSerializer();
+
+  // Writes out a header, which includes the format version.
+  void WriteHeader();
+
+  // Serializes a V8 object into the buffer.
+  Maybe<bool> WriteObject(Handle<Object> object) WARN_UNUSED_RESULT;
+
+  // Returns the stored data. This serializer should not be used once the
+  // buffer is released. The contents are undefined if a previous write has
+  // failed.
+  std::vector<uint8_t> ReleaseBuffer() { return std::move(buffer_); }
+
+  // Marks an ArrayBuffer as having its contents transferred out of band.
+  // Pass the corresponding JSArrayBuffer in the deserializing context to
+  // ValueDeserializer::TransferArrayBuffer.
+  void TransferArrayBuffer(uint32_t transfer_id,
+                           Handle<JSArrayBuffer> array_buffer);
+
+  // Publicly exposed wire format writing methods. These are intended for use
+  // by the embedder when writing host objects.
+  void WriteUint32(uint32_t value);
+  void WriteUint64(uint64_t value);
+  void WriteDouble(double value);
+  void WriteRawBytes(const void* source, size_t length);
+
+ private:
+  // Writing the wire format.
+  void WriteTag(SerializationTag tag);
+  template <typename T>
+  void WriteVarint(T value);
+  template <typename T>
+  void WriteZigZag(T value);
+  void WriteOneByteString(Vector<const uint8_t> chars);
+  void WriteTwoByteString(Vector<const uc16> chars);
+
+  // Writing V8 objects of various kinds.
+  void WriteOddball(Oddball* oddball);
+  void WriteSmi(Smi* smi);
+  void WriteHeapNumber(HeapNumber* number);
+  void WriteString(Handle<String> string);
+  Maybe<bool> WriteJSReceiver(Handle<JSReceiver> receiver) WARN_UNUSED_RESULT;
+  Maybe<bool> WriteJSObject(Handle<JSObject> object) WARN_UNUSED_RESULT;
+  Maybe<bool> WriteJSArray(Handle<JSArray> array) WARN_UNUSED_RESULT;
+  void WriteJSDate(JSDate* date);
+  Maybe<bool> WriteJSArrayBuffer(JSArrayBuffer* array_buffer)
+      WARN_UNUSED_RESULT;
+  Maybe<bool> WriteJSArrayBufferView(JSArrayBufferView* array_buffer_view)
+      WARN_UNUSED_RESULT;
+  Maybe<bool> WriteHostObject(Handle<JSObject> object) WARN_UNUSED_RESULT;
+
+  // Writes the own enumerable properties of |object| that are listed in
+  // |keys|, and returns the number of properties written.
+  Maybe<uint32_t> WriteJSObjectProperties(
+      Handle<JSObject> object, Handle<FixedArray> keys) WARN_UNUSED_RESULT;
+
+  // Throws a DataCloneError, through the delegate if there is one.
+  void ThrowDataCloneError(MessageTemplate::Template template_index);
+  void ThrowDataCloneError(MessageTemplate::Template template_index,
+                           Handle<Object> arg0);
+
+  Isolate* const isolate_;
+  v8::ValueSerializer::Delegate* const delegate_;
+  std::vector<uint8_t> buffer_;
+  Zone zone_;
+
+  // To support circular references, objects are assigned IDs in the order
+  // they are first written. The deserializer assigns the same IDs.
+  IdentityMap<uint32_t> id_map_;
+  uint32_t next_id_ = 0;
+
+  // Transfer IDs of the ArrayBuffers whose contents are sent out of band.
+  IdentityMap<uint32_t> array_buffer_transfer_map_;
+
+  DISALLOW_COPY_AND_ASSIGN(ValueSerializer);
+};
+
+// Deserializes values from data written with ValueSerializer, or a compatible
+// implementation.
+class ValueDeserializer {
+ public:
+  ValueDeserializer(Isolate* isolate, Vector<const uint8_t> data,
+                    v8::ValueDeserializer::Delegate* delegate);
+  ~ValueDeserializer();
+
+  // Runs version detection logic, which may fail if the format is invalid.
+  Maybe<bool> ReadHeader() WARN_UNUSED_RESULT;
+
+  // Reads the underlying wire format version. Likely mostly to be useful to
+  // legacy code reading old wire format versions. Must be called after
+  // ReadHeader.
+  uint32_t GetWireFormatVersion() const { return version_; }
+
+  // Deserializes a V8 object from the buffer.
+  MaybeHandle<Object> ReadObject() WARN_UNUSED_RESULT;
+
+  // Accepts the array buffer corresponding to the one passed previously to
+  // ValueSerializer::TransferArrayBuffer.
+  void TransferArrayBuffer(uint32_t transfer_id,
+                           Handle<JSArrayBuffer> array_buffer);
+
+  // Publicly exposed wire format reading methods. These are intended for use
+  // by the embedder when reading host objects.
+  bool ReadUint32(uint32_t* value) WARN_UNUSED_RESULT;
+  bool ReadUint64(uint64_t* value) WARN_UNUSED_RESULT;
+  bool ReadDouble(double* value) WARN_UNUSED_RESULT;
+  bool ReadRawBytes(size_t length, const void** data) WARN_UNUSED_RESULT;
+
+ private:
+  // Reading the wire format.
+  Maybe<SerializationTag> PeekTag() const WARN_UNUSED_RESULT;
+  void ConsumeTag(SerializationTag peeked_tag);
+  Maybe<SerializationTag> ReadTag() WARN_UNUSED_RESULT;
+  template <typename T>
+  Maybe<T> ReadVarint() WARN_UNUSED_RESULT;
+  template <typename T>
+  Maybe<T> ReadZigZag() WARN_UNUSED_RESULT;
+  Maybe<double> ReadDouble() WARN_UNUSED_RESULT;
+  Maybe<Vector<const uint8_t>> ReadRawBytes(size_t size) WARN_UNUSED_RESULT;
+
+  // Like ReadObject, but does not wrap ArrayBuffers in a view that follows
+  // immediately in the stream.
+  MaybeHandle<Object> ReadObjectInternal() WARN_UNUSED_RESULT;
+
+  // Reading V8 objects of specific kinds.
+  // The tag is assumed to have already been read.
+  MaybeHandle<String> ReadOneByteString() WARN_UNUSED_RESULT;
+  MaybeHandle<String> ReadTwoByteString() WARN_UNUSED_RESULT;
+  MaybeHandle<JSObject> ReadJSObject() WARN_UNUSED_RESULT;
+  MaybeHandle<JSArray> ReadSparseJSArray() WARN_UNUSED_RESULT;
+  MaybeHandle<JSArray> ReadDenseJSArray() WARN_UNUSED_RESULT;
+  MaybeHandle<JSDate> ReadJSDate() WARN_UNUSED_RESULT;
+  MaybeHandle<JSArrayBuffer> ReadJSArrayBuffer() WARN_UNUSED_RESULT;
+  MaybeHandle<JSArrayBuffer> ReadTransferredJSArrayBuffer() WARN_UNUSED_RESULT;
+  MaybeHandle<JSArrayBufferView> ReadJSArrayBufferView(
+      Handle<JSArrayBuffer> buffer) WARN_UNUSED_RESULT;
+  MaybeHandle<JSObject> ReadHostObject() WARN_UNUSED_RESULT;
+
+  // Reads key-value pairs into the object until the specified end tag is
+  // encountered. If successful, returns the number of properties read.
+  Maybe<uint32_t> ReadJSObjectProperties(Handle<JSObject> object,
+                                         SerializationTag end_tag)
+      WARN_UNUSED_RESULT;
+
+  // Managing the object reference table.
+  bool HasObjectWithID(uint32_t id);
+  MaybeHandle<JSReceiver> GetObjectWithID(uint32_t id);
+  void AddObjectWithID(uint32_t id, Handle<JSReceiver> object);
+
+  Isolate* const isolate_;
+  v8::ValueDeserializer::Delegate* const delegate_;
+  const uint8_t* position_;
+  const uint8_t* const end_;
+  uint32_t version_ = 0;
+  uint32_t next_id_ = 0;
+
+  // Always global handles.
+  Handle<SeededNumberDictionary> id_map_;
+  MaybeHandle<SeededNumberDictionary> array_buffer_transfer_map_;
+
+  DISALLOW_COPY_AND_ASSIGN(ValueDeserializer);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_VALUE_SERIALIZER_H_
@@ -0,0 +1,321 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/wasm/streaming-decoder.h"
+
+#include <algorithm>
+
+#include "src/cancelable-task.h"
+#include "src/compiler/wasm-compiler.h"
+#include "src/isolate.h"
+#include "src/locked-queue-inl.h"
+#include "src/v8.h"
+#include "src/wasm/module-decoder.h"
+
+namespace v8 {
+namespace internal {
+namespace wasm {
+
+namespace {
+// The magic word and the version.
+const size_t kModuleHeaderSize = 8;
+// The maximum length of an unsigned LEB128 encoded 32-bit value.
+const size_t kMaxVarInt32Size = 5;
+}  // namespace
+
+// Executes one pending compilation unit. A task is posted for each unit, so
+// a task that finds the queue empty has been overtaken by the main thread.
+class StreamingDecoder::CompilationTask : public CancelableTask {
+ public:
+  explicit CompilationTask(StreamingDecoder* decoder)
+      : CancelableTask(decoder->isolate_), decoder_(decoder) {}
+
+  void RunInternal() override {
+    {
+      DisallowHeapAllocation no_allocation;
+      DisallowHandleAllocation no_handles;
+      DisallowHandleDereference no_deref;
+      DisallowCodeDependencyChange no_dependency_change;
+
+      compiler::WasmCompilationUnit* unit = nullptr;
+      if (decoder_->pending_units_.Dequeue(&unit)) {
+        compiler::ExecuteCompilation(unit);
+      }
+    }
+    decoder_->task_done_.Signal();
+  }
+
+ private:
+  StreamingDecoder* decoder_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompilationTask);
+};
+
+StreamingDecoder::StreamingDecoder(Isolate* isolate)
+    : isolate_(isolate),
+      thrower_(isolate, "StreamingDecoder::Finish()"),
+      zone_(isolate->allocator()),
+      task_done_(0) {}
+
+StreamingDecoder::~StreamingDecoder() {
+  WaitForTasks();
+  DiscardCompilationUnits();
+}
+
+void StreamingDecoder::OnBytesReceived(const byte* bytes, size_t length) {
+  Append(bytes, length);
+  Decode();
+}
+
+void StreamingDecoder::Append(const byte* bytes, size_t length) {
+  if (code_section_end_ == 0) {
+    bytes_.insert(bytes_.end(), bytes, bytes + length);
+    return;
+  }
+  // The function bodies in {bytes_} may be read by background tasks, so the
+  // buffer must not grow beyond the capacity reserved for the code section.
+  size_t fits = std::min(length, code_section_end_ - bytes_.size());
+  bytes_.insert(bytes_.end(), bytes, bytes + fits);
+  tail_.insert(tail_.end(), bytes + fits, bytes + length);
+}
+
+bool StreamingDecoder::ReadU32v(uint32_t* value) {
+  uint32_t result = 0;
+  for (size_t i = 0; i < kMaxVarInt32Size; i++) {
+    if (pos_ + i >= bytes_.size()) return false;
+    byte b = bytes_[pos_ + i];
+    result |= static_cast<uint32_t>(b & 0x7f) << (7 * i);
+    if ((b & 0x80) == 0) {
+      pos_ += i + 1;
+      *value = result;
+      return true;
+    }
+  }
+  Fail();
+  return false;
+}
+
+void StreamingDecoder::Decode() {
+  // Each state returns once it needs more bytes than have been received, and
+  // resumes from the same position with the next chunk.
+  while (true) {
+    switch (state_) {
+      case kModuleHeader:
+        // The header is checked by the ModuleDecoder.
+        if (bytes_.size() < kModuleHeaderSize) return;
+        pos_ = kModuleHeaderSize;
+        state_ = kSectionHeader;
+        break;
+      case kSectionHeader: {
+        size_t header_start = pos_;
+        uint32_t name_length;
+        if (!ReadU32v(&name_length)) return;
+        size_t name_start = pos_;
+        uint32_t section_length;
+        if (bytes_.size() - name_start < name_length) {
+          pos_ = header_start;
+          return;
+        }
+        pos_ += name_length;
+        if (!ReadU32v(&section_length)) {
+          pos_ = header_start;
+          return;
+        }
+        WasmSection::Code section =
+            WasmSection::lookup(&bytes_[name_start], name_length);
+        if (section == WasmSection::Code::FunctionBodies) {
+          StartCodeSection(header_start, pos_ + section_length);
+        } else {
+          section_end_ = pos_ + section_length;
+          state_ = kSectionBody;
+        }
+        break;
+      }
+      case kSectionBody:
+        if (bytes_.size() < section_end_) return;
+        pos_ = section_end_;
+        state_ = kSectionHeader;
+        break;
+      case kBodyCount:
+        if (!ReadU32v(&body_count_)) return;
+        if (body_count_ != prefix_module_->functions.size()) {
+          Fail();
+          return;
+        }
+        state_ = kBodyHeader;
+        break;
+      case kBodyHeader: {
+        if (next_body_ == body_count_) {
+          if (pos_ == section_end_) {
+            state_ = kAfterCode;
+          } else {
+            Fail();
+          }
+          return;
+        }
+        uint32_t size;
+        if (!ReadU32v(&size)) return;
+        if (section_end_ - pos_ < size) {
+          Fail();
+          return;
+        }
+        body_end_ = pos_ + size;
+        state_ = kBody;
+        break;
+      }
+      case kBody:
+        if (bytes_.size() < body_end_) return;
+        OnFunctionBody(next_body_++, pos_, body_end_);
+        pos_ = body_end_;
+        state_ = kBodyHeader;
+        break;
+      case kAfterCode:
+      case kFailed:
+        return;
+    }
+  }
+}
+
+void StreamingDecoder::StartCodeSection(size_t header_start,
+                                        size_t section_end) {
+  // Reserve the whole code section before decoding the prefix, so that the
+  // prefix module and the compilation units point into the final buffer.
+  code_section_end_ = section_end;
+  section_end_ = section_end;
+  if (bytes_.size() > section_end) {
+    tail_.assign(bytes_.begin() + section_end, bytes_.end());
+    bytes_.resize(section_end);
+  }
+  bytes_.reserve(section_end);
+
+  ModuleResult result =
+      DecodeWasmModule(isolate_, &zone_, bytes_.data(),
+                       bytes_.data() + header_start, false, kWasmOrigin);
+  prefix_module_.Reset(result.val);
+  if (result.failed() ||
+      prefix_module_->min_mem_pages > WasmModule::kMaxMemPages) {
+    // Finish() reports the error, or compiles the module the regular way.
+    Fail();
+    return;
+  }
+  prefix_module_->shared_isolate = isolate_;
+  builder_.Reset(new CompiledModuleBuilder(
+      isolate_, prefix_module_.get(),
+      WasmModule::kPageSize * prefix_module_->min_mem_pages));
+  builder_->CreatePlaceholders();
+  state_ = kBodyCount;
+}
+
+void StreamingDecoder::OnFunctionBody(uint32_t index, size_t start,
+                                      size_t end) {
+  WasmFunction* function = &prefix_module_->functions[index];
+  function->code_start_offset = static_cast<uint32_t>(start);
+  function->code_end_offset = static_cast<uint32_t>(end);
+  if (index < static_cast<uint32_t>(FLAG_skip_compiling_wasm_funcs)) return;
+  if (function->external) return;
+
+  compiler::WasmCompilationUnit* unit = compiler::CreateWasmCompilationUnit(
+      &thrower_, isolate_, builder_->module_env(), function);
+  units_.push_back(unit);
+  pending_units_.Enqueue(unit);
+  CompilationTask* task = new CompilationTask(this);
+  task_ids_.push_back(task->id());
+  V8::GetCurrentPlatform()->CallOnBackgroundThread(
+      task, v8::Platform::kShortRunningTask);
+}
+
+void StreamingDecoder::WaitForTasks() {
+  for (uint32_t task_id : task_ids_) {
+    if (!isolate_->cancelable_task_manager()->TryAbort(task_id)) {
+      task_done_.Wait();
+    }
+  }
+  task_ids_.clear();
+}
+
+bool StreamingDecoder::StreamedCodeMatches() const {
+  if (state_ != kAfterCode) return false;
+  const WasmModule* prefix = prefix_module_.get();
+  const WasmModule* module = module_.get();
+  if (prefix->functions.size() != module->functions.size()) return false;
+  if (prefix->import_table.size() != module->import_table.size()) {
+    return false;
+  }
+  if (prefix->function_table != module->function_table) return false;
+  if (prefix->min_mem_pages != module->min_mem_pages) return false;
+  if (prefix->globals.size() != module->globals.size()) return false;
+  for (size_t i = 0; i < module->globals.size(); i++) {
+    if (prefix->globals[i].type != module->globals[i].type) return false;
+  }
+  for (size_t i = 0; i < module->functions.size(); i++) {
+    const WasmFunction& expected = prefix->functions[i];
+    const WasmFunction& actual = module->functions[i];
+    if (expected.code_start_offset != actual.code_start_offset ||
+        expected.code_end_offset != actual.code_end_offset ||
+        expected.external != actual.external) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void StreamingDecoder::DiscardCompilationUnits() {
+  for (compiler::WasmCompilationUnit* unit : units_) {
+    compiler::DeleteWasmCompilationUnit(unit);
+  }
+  units_.clear();
+}
+
+MaybeHandle<FixedArray> StreamingDecoder::Finish() {
+  // Execute the units that no task has picked up yet, and let the tasks that
+  // are still running return.
+  compiler::WasmCompilationUnit* unit = nullptr;
+  while (pending_units_.Dequeue(&unit)) {
+    compiler::ExecuteCompilation(unit);
+  }
+  WaitForTasks();
+
+  bytes_.insert(bytes_.end(), tail_.begin(), tail_.end());
+  tail_.clear();
+  // Decode the complete module. From here on, the function bodies are read
+  // from the final buffer, which is not modified any more.
+  ModuleResult result =
+      DecodeWasmModule(isolate_, &zone_, bytes_.data(),
+                       bytes_.data() + bytes_.size(), false, kWasmOrigin);
+  module_.Reset(result.val);
+  if (result.failed()) {
+    thrower_.Failed("", result);
+    DiscardCompilationUnits();
+    return MaybeHandle<FixedArray>();
+  }
+
+  size_t mem_size = WasmModule::kPageSize * module_->min_mem_pages;
+  if (!StreamedCodeMatches()) {
+    DiscardCompilationUnits();
+    return module_->CompileFunctions(isolate_, &thrower_, mem_size);
+  }
+
+  module_->shared_isolate = isolate_;
+  std::vector<Handle<Code>> results(module_->functions.size());
+  for (compiler::WasmCompilationUnit* unit : units_) {
+    int index = compiler::GetIndexOfWasmCompilationUnit(unit);
+    results[index] = compiler::FinishCompilation(unit);
+  }
+  units_.clear();
+
+  for (uint32_t i = FLAG_skip_compiling_wasm_funcs;
+       i < module_->functions.size(); i++) {
+    const WasmFunction& func = module_->functions[i];
+    if (func.external || !results[i].is_null()) continue;
+    WasmName str = module_->GetName(func.name_offset, func.name_length);
+    thrower_.Error("Compilation of #%d:%.*s failed.", i, str.length(),
+                   str.start());
+    return MaybeHandle<FixedArray>();
+  }
+  return builder_->Build(results);
+}
+
+}  // namespace wasm
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,123 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_WASM_STREAMING_DECODER_H_
+#define V8_WASM_STREAMING_DECODER_H_
+
+#include <vector>
+
+#include "src/base/platform/semaphore.h"
+#include "src/base/smart-pointers.h"
+#include "src/locked-queue.h"
+#include "src/wasm/wasm-module.h"
+#include "src/wasm/wasm-result.h"
+#include "src/zone.h"
+
+namespace v8 {
+namespace internal {
+namespace wasm {
+
+// Decodes a wasm module whose bytes arrive in chunks, e.g. from the network.
+// Once all sections before the code section have arrived, every function body
+// is compiled on a background thread as soon as its last byte is received, so
+// that compilation overlaps with the download. Finish() decodes the complete
+// module and returns a compiled module for WasmModule::Instantiate.
+//
+// Only the framing of sections and function bodies is decoded incrementally.
+// The complete module is decoded again by the ModuleDecoder in Finish(); if
+// it turns out that the streamed functions were compiled in a different
+// environment, e.g. because a globals section followed the code section, the
+// module is compiled again the regular way.
+class StreamingDecoder {
+ public:
+  explicit StreamingDecoder(Isolate* isolate);
+  ~StreamingDecoder();
+
+  // Appends the next {length} bytes of the module.
+  void OnBytesReceived(const byte* bytes, size_t length);
+
+  // Called after the last chunk has been received. Returns the compiled
+  // module, or an empty handle if decoding or compilation failed, in which
+  // case an exception has been scheduled.
+  MaybeHandle<FixedArray> Finish();
+
+  // The module decoded by Finish(). It points into the bytes owned by this
+  // decoder and has to be instantiated before the decoder is destroyed.
+  WasmModule* module() const { return module_.get(); }
+
+ private:
+  class CompilationTask;
+
+  enum State {
+    kModuleHeader,   // Expecting the magic word and the version.
+    kSectionHeader,  // Expecting the name and size of a section.
+    kSectionBody,    // Skipping the payload of a section.
+    kBodyCount,      // Expecting the number of function bodies.
+    kBodyHeader,     // Expecting the size of a function body.
+    kBody,           // Expecting the bytes of a function body.
+    kAfterCode,      // Buffering the sections after the code section.
+    kFailed          // The framing is invalid, just buffering.
+  };
+
+  // The number of module bytes received so far.
+  size_t received() const { return bytes_.size() + tail_.size(); }
+
+  void Append(const byte* bytes, size_t length);
+  void Decode();
+
+  // Reads an unsigned LEB128 value at {pos_}. Returns false if more bytes are
+  // needed, or if the value is invalid, in which case decoding stops.
+  bool ReadU32v(uint32_t* value);
+
+  void StartCodeSection(size_t header_start, size_t section_end);
+  void OnFunctionBody(uint32_t index, size_t start, size_t end);
+  void Fail() { state_ = kFailed; }
+
+  // Waits for the background tasks that have started to return and aborts
+  // the others.
+  void WaitForTasks();
+  // Checks that the complete module agrees with the prefix module on
+  // everything the compiled code depends on.
+  bool StreamedCodeMatches() const;
+  void DiscardCompilationUnits();
+
+  Isolate* isolate_;
+  ErrorThrower thrower_;
+  Zone zone_;
+
+  // All received bytes up to the end of the code section. Once the size of
+  // the code section is known, this buffer is not reallocated any more, as
+  // the compilation units read the function bodies from it. Bytes after the
+  // code section are kept in {tail_} until Finish().
+  std::vector<byte> bytes_;
+  std::vector<byte> tail_;
+  size_t code_section_end_ = 0;
+
+  State state_ = kModuleHeader;
+  size_t pos_ = 0;          // The offset of the next byte to decode.
+  size_t section_end_ = 0;  // The end of the current section.
+  size_t body_end_ = 0;     // The end of the current function body.
+  uint32_t body_count_ = 0;
+  uint32_t next_body_ = 0;
+
+  // The module decoded from the sections before the code section, which the
+  // streamed functions are compiled against.
+  base::SmartPointer<WasmModule> prefix_module_;
+  base::SmartPointer<CompiledModuleBuilder> builder_;
+
+  std::vector<compiler::WasmCompilationUnit*> units_;
+  LockedQueue<compiler::WasmCompilationUnit*> pending_units_;
+  base::Semaphore task_done_;
+  std::vector<uint32_t> task_ids_;
+
+  base::SmartPointer<WasmModule> module_;
+
+  DISALLOW_COPY_AND_ASSIGN(StreamingDecoder);
+};
+
+}  // namespace wasm
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_WASM_STREAMING_DECODER_H_
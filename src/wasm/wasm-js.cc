@@ -28,6 +28,12 @@ using v8::internal::wasm::ErrorThrower;
 namespace v8 {
 
 namespace {
+// Internal constants for the layout of the objects returned by
+// Wasm.compileModule().
+const int kCompiledModuleObjectFieldCount = 2;
+const int kCompiledModuleObjectCode = 0;
+const int kCompiledModuleObjectBytes = 1;
+
 struct RawBuffer {
   const byte* start;
   const byte* end;
@@ -142,11 +148,19 @@ v8::internal::wasm::WasmModuleIndex* TranslateAsmModule(
   if (i::FLAG_enable_simd_asmjs) {
     typer.set_allow_simd(true);
   }
-  if (!typer.Validate()) {
-    thrower->Error("Asm.js validation failed: %s", typer.error_message());
-    return nullptr;
+  i::RuntimeCallStats* stats =
+      info->isolate()->counters()->runtime_call_stats();
+  {
+    i::RuntimeCallTimerScope runtime_timer(info->isolate(),
+                                           &stats->AsmValidation);
+    if (!typer.Validate()) {
+      thrower->Error("Asm.js validation failed: %s", typer.error_message());
+      return nullptr;
+    }
   }
 
+  i::RuntimeCallTimerScope runtime_timer(info->isolate(),
+                                         &stats->AsmWasmTranslation);
   auto module =
       v8::internal::wasm::AsmWasmBuilder(info->isolate(), info->zone(),
                                          info->literal(), foreign, &typer)
@@ -155,10 +169,24 @@ v8::internal::wasm::WasmModuleIndex* TranslateAsmModule(
   return module;
 }
 
+bool IsCompiledModuleObject(Local<Value> value) {
+  if (!value->IsObject()) return false;
+  i::Handle<i::Object> object = v8::Utils::OpenHandle(*value);
+  if (!object->IsJSObject()) return false;
+  i::JSObject* js_object = i::JSObject::cast(*object);
+  return js_object->GetInternalFieldCount() ==
+             kCompiledModuleObjectFieldCount &&
+         js_object->GetInternalField(kCompiledModuleObjectCode)
+             ->IsFixedArray() &&
+         js_object->GetInternalField(kCompiledModuleObjectBytes)->IsByteArray();
+}
+
 void InstantiateModuleCommon(const v8::FunctionCallbackInfo<v8::Value>& args,
                              const byte* start, const byte* end,
                              ErrorThrower* thrower,
-                             internal::wasm::ModuleOrigin origin) {
+                             internal::wasm::ModuleOrigin origin,
+                             i::Handle<i::FixedArray> compiled_module =
+                                 i::Handle<i::FixedArray>::null()) {
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(args.GetIsolate());
 
   i::Handle<i::JSArrayBuffer> memory = i::Handle<i::JSArrayBuffer>::null();
@@ -187,7 +215,9 @@ void InstantiateModuleCommon(const v8::FunctionCallbackInfo<v8::Value>& args,
     }
 
     i::MaybeHandle<i::JSObject> object =
-        result.val->Instantiate(isolate, ffi, memory);
+        compiled_module.is_null()
+            ? result.val->Instantiate(isolate, ffi, memory)
+            : result.val->Instantiate(isolate, compiled_module, ffi, memory);
 
     if (!object.is_null()) {
       args.GetReturnValue().Set(v8::Utils::ToLocal(object.ToHandleChecked()));
@@ -235,12 +265,73 @@ void InstantiateModule(const v8::FunctionCallbackInfo<v8::Value>& args) {
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(args.GetIsolate());
   ErrorThrower thrower(isolate, "WASM.instantiateModule()");
 
+  if (args.Length() > 0 && IsCompiledModuleObject(args[0])) {
+    // Instantiate the code of a module compiled by Wasm.compileModule(). The
+    // module is decoded again from a copy of its bytes, because the decoded
+    // module points into them and the byte array may move.
+    i::Handle<i::JSObject> object =
+        i::Handle<i::JSObject>::cast(v8::Utils::OpenHandle(*args[0]));
+    i::Handle<i::FixedArray> compiled_module(
+        i::FixedArray::cast(
+            object->GetInternalField(kCompiledModuleObjectCode)),
+        isolate);
+    i::ByteArray* bytes = i::ByteArray::cast(
+        object->GetInternalField(kCompiledModuleObjectBytes));
+    std::vector<byte> copy(bytes->GetDataStartAddress(),
+                           bytes->GetDataStartAddress() + bytes->length());
+    InstantiateModuleCommon(args, copy.data(), copy.data() + copy.size(),
+                            &thrower, internal::wasm::kWasmOrigin,
+                            compiled_module);
+    return;
+  }
+
   RawBuffer buffer = GetRawBufferArgument(thrower, args);
   if (buffer.start == nullptr) return;
 
   InstantiateModuleCommon(args, buffer.start, buffer.end, &thrower,
                           internal::wasm::kWasmOrigin);
 }
+
+
+void CompileModule(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  HandleScope scope(args.GetIsolate());
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(args.GetIsolate());
+  ErrorThrower thrower(isolate, "WASM.compileModule()");
+
+  RawBuffer buffer = GetRawBufferArgument(thrower, args);
+  if (thrower.error()) return;
+
+  i::Zone zone(isolate->allocator());
+  internal::wasm::ModuleResult result =
+      internal::wasm::DecodeWasmModule(isolate, &zone, buffer.start, buffer.end,
+                                       false, internal::wasm::kWasmOrigin);
+
+  if (result.failed()) {
+    thrower.Failed("", result);
+  } else {
+    size_t mem_size =
+        internal::wasm::WasmModule::kPageSize * result.val->min_mem_pages;
+    i::Handle<i::FixedArray> compiled_module;
+    if (result.val->CompileFunctions(isolate, &thrower, mem_size)
+            .ToHandle(&compiled_module)) {
+      i::Factory* factory = isolate->factory();
+      int size = static_cast<int>(buffer.size());
+      i::Handle<i::ByteArray> bytes = factory->NewByteArray(size, i::TENURED);
+      bytes->copy_in(0, buffer.start, size);
+      i::Handle<i::Map> map = factory->NewMap(
+          i::JS_OBJECT_TYPE,
+          i::JSObject::kHeaderSize +
+              kCompiledModuleObjectFieldCount * i::kPointerSize);
+      i::Handle<i::JSObject> object =
+          factory->NewJSObjectFromMap(map, i::TENURED);
+      object->SetInternalField(kCompiledModuleObjectCode, *compiled_module);
+      object->SetInternalField(kCompiledModuleObjectBytes, *bytes);
+      args.GetReturnValue().Set(v8::Utils::ToLocal(object));
+    }
+  }
+
+  if (result.val) delete result.val;
+}
 }  // namespace
 
 
@@ -291,6 +382,7 @@ void WasmJs::Install(Isolate* isolate, Handle<JSGlobalObject> global) {
   // Install functions on the WASM object.
   InstallFunc(isolate, wasm_object, "verifyModule", VerifyModule);
   InstallFunc(isolate, wasm_object, "verifyFunction", VerifyFunction);
+  InstallFunc(isolate, wasm_object, "compileModule", CompileModule);
   InstallFunc(isolate, wasm_object, "instantiateModule", InstantiateModule);
   InstallFunc(isolate, wasm_object, "instantiateModuleFromAsm",
               InstantiateModuleFromAsm);
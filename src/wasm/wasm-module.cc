@@ -2,6 +2,11 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "src/atomic-utils.h"
+#include "src/background-task-budget.h"
+#include "src/base/lockfree-queue.h"
+#include "src/base/platform/semaphore.h"
+#include "src/cancelable-task.h"
 #include "src/macro-assembler.h"
 #include "src/objects.h"
 #include "src/property-descriptor.h"
@@ -116,47 +121,50 @@ std::ostream& operator<<(std::ostream& os, const WasmFunctionName& pair) {
 }
 
 // A helper class for compiling multiple wasm functions that offers
-// placeholder code objects for calling functions that are not yet compiled.
+// placeholder code objects for calling functions and imports that are not yet
+// compiled. Placeholders are recognized by their index alone, so the code
+// compiled with one linker can be linked by another one.
 class WasmLinker {
  public:
-  WasmLinker(Isolate* isolate, size_t size)
-      : isolate_(isolate), placeholder_code_(size), function_code_(size) {}
+  WasmLinker(Isolate* isolate, size_t function_count, size_t import_count)
+      : isolate_(isolate),
+        function_count_(function_count),
+        code_(function_count + import_count) {}
 
   // Get the code object for a function, allocating a placeholder if it has
   // not yet been compiled.
   Handle<Code> GetFunctionCode(uint32_t index) {
-    DCHECK(index < function_code_.size());
-    if (function_code_[index].is_null()) {
-      // Create a placeholder code object and encode the corresponding index in
-      // the {constant_pool_offset} field of the code object.
-      // TODO(titzer): placeholder code objects are somewhat dangerous.
-      Handle<Code> self(nullptr, isolate_);
-      byte buffer[] = {0, 0, 0, 0, 0, 0, 0, 0};  // fake instructions.
-      CodeDesc desc = {buffer, 8, 8, 0, 0, nullptr};
-      Handle<Code> code = isolate_->factory()->NewCode(
-          desc, Code::KindField::encode(Code::WASM_FUNCTION), self);
-      code->set_constant_pool_offset(index + kPlaceholderMarker);
-      placeholder_code_[index] = code;
-      function_code_[index] = code;
-    }
-    return function_code_[index];
+    DCHECK(index < function_count_);
+    return GetCode(index);
+  }
+
+  // Get the code object for an import, allocating a placeholder if its
+  // wrapper has not yet been compiled.
+  Handle<Code> GetImportCode(uint32_t index) {
+    DCHECK(index < code_.size() - function_count_);
+    return GetCode(static_cast<uint32_t>(function_count_) + index);
   }
 
   void Finish(uint32_t index, Handle<Code> code) {
-    DCHECK(index < function_code_.size());
-    function_code_[index] = code;
+    DCHECK(index < function_count_);
+    code_[index] = code;
+  }
+
+  void FinishImport(uint32_t index, Handle<Code> code) {
+    DCHECK(index < code_.size() - function_count_);
+    code_[function_count_ + index] = code;
   }
 
   void Link(Handle<FixedArray> function_table,
             std::vector<uint16_t>& functions) {
-    for (size_t i = 0; i < function_code_.size(); i++) {
-      LinkFunction(function_code_[i]);
+    for (size_t i = 0; i < function_count_; i++) {
+      if (!code_[i].is_null()) LinkFunction(code_[i]);
     }
     if (!function_table.is_null()) {
       int table_size = static_cast<int>(functions.size());
       DCHECK_EQ(function_table->length(), table_size * 2);
       for (int i = 0; i < table_size; i++) {
-        function_table->set(i + table_size, *function_code_[functions[i]]);
+        function_table->set(i + table_size, *code_[functions[i]]);
       }
     }
   }
@@ -165,8 +173,25 @@ class WasmLinker {
   static const int kPlaceholderMarker = 1000000000;
 
   Isolate* isolate_;
-  std::vector<Handle<Code>> placeholder_code_;
-  std::vector<Handle<Code>> function_code_;
+  size_t function_count_;
+  // Code for the functions, followed by the code for the imports.
+  std::vector<Handle<Code>> code_;
+
+  Handle<Code> GetCode(uint32_t index) {
+    if (code_[index].is_null()) {
+      // Create a placeholder code object and encode the corresponding index in
+      // the {constant_pool_offset} field of the code object.
+      // TODO(titzer): placeholder code objects are somewhat dangerous.
+      Handle<Code> self(nullptr, isolate_);
+      byte buffer[] = {0, 0, 0, 0, 0, 0, 0, 0};  // fake instructions.
+      CodeDesc desc = {buffer, 8, 8, 0, 0, nullptr};
+      Handle<Code> code = isolate_->factory()->NewCode(
+          desc, Code::KindField::encode(Code::WASM_FUNCTION), self);
+      code->set_constant_pool_offset(index + kPlaceholderMarker);
+      code_[index] = code;
+    }
+    return code_[index];
+  }
 
   void LinkFunction(Handle<Code> code) {
     bool modified = false;
@@ -181,10 +206,9 @@ class WasmLinker {
             target->constant_pool_offset() >= kPlaceholderMarker) {
           // Patch direct calls to placeholder code objects.
           uint32_t index = target->constant_pool_offset() - kPlaceholderMarker;
-          CHECK(index < function_code_.size());
-          Handle<Code> new_target = function_code_[index];
-          if (target != *new_target) {
-            CHECK_EQ(*placeholder_code_[index], target);
+          CHECK(index < code_.size());
+          Handle<Code> new_target = code_[index];
+          if (!new_target.is_null() && target != *new_target) {
             it.rinfo()->set_target_address(new_target->instruction_start(),
                                            SKIP_WRITE_BARRIER,
                                            SKIP_ICACHE_FLUSH);
@@ -202,12 +226,24 @@ class WasmLinker {
 
 namespace {
 // Internal constants for the layout of the module object.
-const int kWasmModuleInternalFieldCount = 5;
+const int kWasmModuleInternalFieldCount = 8;
 const int kWasmModuleFunctionTable = 0;
 const int kWasmModuleCodeTable = 1;
 const int kWasmMemArrayBuffer = 2;
 const int kWasmGlobalsArrayBuffer = 3;
 const int kWasmFunctionNamesArray = 4;
+// The fields below are only set if functions are compiled lazily.
+const int kWasmImportCodeTable = 5;  // FixedArray of import wrappers.
+const int kWasmExportCodeTable = 6;  // FixedArray of export wrappers.
+const int kWasmModuleBytes = 7;      // ByteArray with the module bytes.
+
+// Internal constants for the layout of the compiled module.
+const int kCompiledModuleLength = 5;
+const int kCompiledCodeTable = 0;      // FixedArray of unlinked code.
+const int kCompiledFunctionTable = 1;  // FixedArray, or undefined if none.
+const int kCompiledContext = 2;        // native context of the trap code.
+const int kCompiledMemSize = 3;        // memory size checked by the code.
+const int kCompiledLazy = 4;  // true if the code table holds lazy stubs.
 
 size_t AllocateGlobalsOffsets(std::vector<WasmGlobal>& globals) {
   uint32_t offset = 0;
@@ -323,6 +359,246 @@ bool AllocateGlobals(ErrorThrower* thrower, Isolate* isolate,
   }
   return true;
 }
+
+// Takes the next unit from {compilation_units} and executes it. Returns false
+// once all units have been taken. Executed units are queued on
+// {executed_units} for the main thread to finish.
+bool FetchAndExecuteCompilationUnit(
+    std::vector<compiler::WasmCompilationUnit*>* compilation_units,
+    base::LockFreeQueue<compiler::WasmCompilationUnit*>* executed_units,
+    AtomicNumber<size_t>* next_unit, base::Semaphore* unit_executed) {
+  DisallowHeapAllocation no_allocation;
+  DisallowHandleAllocation no_handles;
+  DisallowHandleDereference no_deref;
+  DisallowCodeDependencyChange no_dependency_change;
+
+  // Increment returns the value after the increment, hence the - 1.
+  size_t index = next_unit->Increment(1) - 1;
+  if (index >= compilation_units->size()) return false;
+
+  compiler::WasmCompilationUnit* unit = compilation_units->at(index);
+  compiler::ExecuteCompilation(unit);
+  executed_units->Enqueue(unit);
+  unit_executed->Signal();
+  return true;
+}
+
+class WasmCompilationTask : public CancelableTask {
+ public:
+  WasmCompilationTask(
+      Isolate* isolate,
+      std::vector<compiler::WasmCompilationUnit*>* compilation_units,
+      base::LockFreeQueue<compiler::WasmCompilationUnit*>* executed_units,
+      AtomicNumber<size_t>* next_unit, base::Semaphore* unit_executed,
+      base::Semaphore* task_done)
+      : CancelableTask(isolate),
+        compilation_units_(compilation_units),
+        executed_units_(executed_units),
+        next_unit_(next_unit),
+        unit_executed_(unit_executed),
+        task_done_(task_done) {}
+
+  void RunInternal() override {
+    while (FetchAndExecuteCompilationUnit(compilation_units_, executed_units_,
+                                          next_unit_, unit_executed_)) {
+    }
+    task_done_->Signal();
+  }
+
+ private:
+  std::vector<compiler::WasmCompilationUnit*>* compilation_units_;
+  base::LockFreeQueue<compiler::WasmCompilationUnit*>* executed_units_;
+  AtomicNumber<size_t>* next_unit_;
+  base::Semaphore* unit_executed_;
+  base::Semaphore* task_done_;
+
+  DISALLOW_COPY_AND_ASSIGN(WasmCompilationTask);
+};
+
+// Finishes all units that have been executed so far, storing the code in
+// {results} by function index. Returns the number of finished units.
+size_t FinishCompilationUnits(
+    base::LockFreeQueue<compiler::WasmCompilationUnit*>* executed_units,
+    std::vector<Handle<Code>>* results) {
+  size_t finished = 0;
+  compiler::WasmCompilationUnit* unit = nullptr;
+  while (executed_units->Dequeue(&unit)) {
+    int index = compiler::GetIndexOfWasmCompilationUnit(unit);
+    (*results)[index] = compiler::FinishCompilation(unit);
+    finished++;
+  }
+  return finished;
+}
+
+// Executes {compilation_units} on background threads and on the main thread.
+// Units are finished on the main thread as soon as they have been executed,
+// which overlaps code allocation with the remaining background work.
+void CompileInParallel(
+    Isolate* isolate,
+    std::vector<compiler::WasmCompilationUnit*>& compilation_units,
+    std::vector<Handle<Code>>* results) {
+  // Sized so that handing over the executed units never takes a lock.
+  base::LockFreeQueue<compiler::WasmCompilationUnit*> executed_units(
+      compilation_units.size());
+  AtomicNumber<size_t> next_unit(0);
+  base::Semaphore unit_executed(0);
+  base::Semaphore task_done(0);
+
+  BackgroundTaskBudget* budget = isolate->background_task_budget();
+  size_t num_tasks = static_cast<size_t>(budget->TryAcquire(
+      BackgroundTaskBudget::kCompiler,
+      static_cast<int>(std::min(
+          static_cast<size_t>(std::max(FLAG_wasm_num_compilation_tasks, 0)),
+          compilation_units.size()))));
+  std::vector<uint32_t> task_ids(num_tasks);
+  for (size_t i = 0; i < num_tasks; i++) {
+    WasmCompilationTask* task =
+        new WasmCompilationTask(isolate, &compilation_units, &executed_units,
+                                &next_unit, &unit_executed, &task_done);
+    task_ids[i] = task->id();
+    V8::GetCurrentPlatform()->CallOnBackgroundThread(
+        task, v8::Platform::kShortRunningTask);
+  }
+
+  // The main thread executes units too, finishing the executed ones in
+  // between. Once no unit is left to execute, it waits for the background
+  // tasks to hand over the rest.
+  size_t finished = 0;
+  while (FetchAndExecuteCompilationUnit(&compilation_units, &executed_units,
+                                        &next_unit, &unit_executed)) {
+    finished += FinishCompilationUnits(&executed_units, results);
+  }
+  while (finished < compilation_units.size()) {
+    unit_executed.Wait();
+    finished += FinishCompilationUnits(&executed_units, results);
+  }
+
+  // All units are finished, but the tasks may still be about to return.
+  // Tasks that have not started yet are aborted instead.
+  for (uint32_t task_id : task_ids) {
+    if (!isolate->cancelable_task_manager()->TryAbort(task_id)) {
+      task_done.Wait();
+    }
+  }
+  budget->Release(BackgroundTaskBudget::kCompiler, static_cast<int>(num_tasks));
+}
+
+// Copies the code of a function from {compiled_module} and relocates the copy
+// to the memory, globals area, function table and context of {instance}.
+// Direct calls still go to placeholders, which the linker patches later.
+Handle<Code> CloneCodeForInstance(Isolate* isolate,
+                                  Handle<FixedArray> compiled_module,
+                                  Handle<Code> code,
+                                  WasmModuleInstance* instance,
+                                  uint32_t func_index) {
+  Handle<Code> clone = isolate->factory()->CopyCode(code);
+  {
+    DisallowHeapAllocation no_gc;
+    Object* old_function_table = compiled_module->get(kCompiledFunctionTable);
+    Object* old_context = compiled_module->get(kCompiledContext);
+    size_t old_mem_size =
+        static_cast<size_t>(compiled_module->get(kCompiledMemSize)->Number());
+    DCHECK_EQ(old_mem_size, instance->mem_size);
+
+    int mode_mask = RelocInfo::ModeMask(RelocInfo::EMBEDDED_OBJECT) |
+                    RelocInfo::ModeMask(RelocInfo::WASM_MEMORY_REFERENCE) |
+                    RelocInfo::ModeMask(RelocInfo::WASM_GLOBAL_REFERENCE);
+    for (RelocIterator it(*clone, mode_mask); !it.done(); it.next()) {
+      RelocInfo::Mode mode = it.rinfo()->rmode();
+      if (RelocInfo::IsWasmMemoryReference(mode)) {
+        // The compiled code addresses a memory that starts at 0.
+        if (old_mem_size == 0) continue;
+        it.rinfo()->update_wasm_memory_reference(
+            nullptr, instance->mem_start, old_mem_size, instance->mem_size,
+            SKIP_ICACHE_FLUSH);
+      } else if (RelocInfo::IsWasmGlobalReference(mode)) {
+        // The same holds for the globals area.
+        it.rinfo()->update_wasm_global_reference(
+            nullptr, instance->globals_start, SKIP_ICACHE_FLUSH);
+      } else {
+        Object* target = it.rinfo()->target_object();
+        if (!instance->function_table.is_null() &&
+            target == old_function_table) {
+          it.rinfo()->set_target_object(*instance->function_table,
+                                        UPDATE_WRITE_BARRIER,
+                                        SKIP_ICACHE_FLUSH);
+        } else if (target == old_context && target != *instance->context) {
+          it.rinfo()->set_target_object(*instance->context,
+                                        UPDATE_WRITE_BARRIER,
+                                        SKIP_ICACHE_FLUSH);
+        }
+      }
+    }
+    Assembler::FlushICache(isolate, clone->instruction_start(),
+                           clone->instruction_size());
+  }
+
+  Handle<FixedArray> deopt_data =
+      isolate->factory()->NewFixedArray(2, TENURED);
+  deopt_data->set(0, *instance->js_object);
+  deopt_data->set(1, Smi::FromInt(func_index));
+  clone->set_deoptimization_data(*deopt_data);
+  return clone;
+}
+
+// Verifies the bodies of the functions of the module and creates a lazy
+// compile stub in place of the code of each function. The bodies are not
+// compiled before their first call, but invalid ones are still reported here.
+bool CreateLazyCompileStubs(Isolate* isolate, ErrorThrower* thrower,
+                            ModuleEnv* module_env,
+                            std::vector<Handle<Code>>* results) {
+  WasmModule* module = module_env->module;
+  for (uint32_t i = FLAG_skip_compiling_wasm_funcs;
+       i < module->functions.size(); i++) {
+    const WasmFunction& func = module->functions[i];
+    if (func.external) continue;
+    TreeResult result = VerifyWasmCode(
+        isolate->allocator(), module_env, func.sig,
+        module->module_start + func.code_start_offset,
+        module->module_start + func.code_end_offset);
+    if (result.failed()) {
+      WasmName str = module->GetName(func.name_offset, func.name_length);
+      ScopedVector<char> buffer(128);
+      SNPrintF(buffer, "Compiling WASM function #%d:%.*s failed:", i,
+               str.length(), str.start());
+      thrower->Failed(buffer.start(), result);
+      return false;
+    }
+    (*results)[i] =
+        compiler::CompileWasmLazyCompileStub(isolate, module_env, &func);
+  }
+  return true;
+}
+
+Handle<FixedArray> NewCodeTable(Isolate* isolate,
+                                const std::vector<Handle<Code>>& code) {
+  Handle<FixedArray> table =
+      isolate->factory()->NewFixedArray(static_cast<int>(code.size()), TENURED);
+  for (size_t i = 0; i < code.size(); i++) {
+    table->set(static_cast<int>(i), *code[i]);
+  }
+  return table;
+}
+
+// Redirects the direct calls to {old_target} in {code} to {new_target}.
+void RedirectCalls(Isolate* isolate, Code* code, Code* old_target,
+                   Code* new_target) {
+  DisallowHeapAllocation no_gc;
+  bool modified = false;
+  for (RelocIterator it(code, RelocInfo::kCodeTargetMask); !it.done();
+       it.next()) {
+    Code* target = Code::GetCodeFromTargetAddress(it.rinfo()->target_address());
+    if (target == old_target) {
+      it.rinfo()->set_target_address(new_target->instruction_start(),
+                                     UPDATE_WRITE_BARRIER, SKIP_ICACHE_FLUSH);
+      modified = true;
+    }
+  }
+  if (modified) {
+    Assembler::FlushICache(isolate, code->instruction_start(),
+                           code->instruction_size());
+  }
+}
 }  // namespace
 
 WasmModule::WasmModule()
@@ -398,6 +674,128 @@ static MaybeHandle<JSFunction> LookupFunction(
   return Handle<JSFunction>::cast(function);
 }
 
+CompiledModuleBuilder::CompiledModuleBuilder(Isolate* isolate,
+                                             WasmModule* module,
+                                             size_t mem_size)
+    : isolate_(isolate),
+      instance_(module),
+      linker_(new WasmLinker(isolate, module->functions.size(),
+                             module->import_table.size())) {
+  instance_.context = isolate->native_context();
+  instance_.mem_size = mem_size;
+  instance_.globals_size = AllocateGlobalsOffsets(module->globals);
+  instance_.function_table = BuildFunctionTable(isolate, module);
+  module_env_.module = module;
+  module_env_.instance = &instance_;
+  module_env_.linker = linker_.get();
+  module_env_.origin = module->origin;
+}
+
+CompiledModuleBuilder::~CompiledModuleBuilder() {}
+
+void CompiledModuleBuilder::CreatePlaceholders() {
+  // TODO(ahaas): Maybe we could skip this for external functions.
+  WasmModule* module = instance_.module;
+  for (uint32_t i = 0; i < module->functions.size(); i++) {
+    linker_->GetFunctionCode(i);
+  }
+  for (uint32_t i = 0; i < module->import_table.size(); i++) {
+    linker_->GetImportCode(i);
+  }
+}
+
+Handle<FixedArray> CompiledModuleBuilder::Build(
+    const std::vector<Handle<Code>>& code) {
+  Factory* factory = isolate_->factory();
+  Handle<FixedArray> code_table =
+      factory->NewFixedArray(static_cast<int>(code.size()), TENURED);
+  for (size_t i = 0; i < code.size(); i++) {
+    if (!code[i].is_null()) code_table->set(static_cast<int>(i), *code[i]);
+  }
+
+  Handle<FixedArray> compiled_module =
+      factory->NewFixedArray(kCompiledModuleLength, TENURED);
+  compiled_module->set(kCompiledCodeTable, *code_table);
+  if (!instance_.function_table.is_null()) {
+    compiled_module->set(kCompiledFunctionTable, *instance_.function_table);
+  }
+  compiled_module->set(kCompiledContext, *instance_.context);
+  compiled_module->set(kCompiledMemSize,
+                       *factory->NewNumberFromSize(instance_.mem_size));
+  compiled_module->set(kCompiledLazy, isolate_->heap()->false_value());
+  return compiled_module;
+}
+
+// Compiles all functions of the module into a compiled module. The code is
+// not specialized to an instance: it addresses a memory and a globals area
+// that start at 0, refers to a template of the function table and calls
+// placeholders for functions and imports. Only the size of the memory, which
+// the bounds checks embed, is fixed at compile time. With
+// --wasm-lazy-compilation, the code of each function is a stub that compiles
+// the function for the instance when it is first called.
+MaybeHandle<FixedArray> WasmModule::CompileFunctions(Isolate* isolate,
+                                                     ErrorThrower* thrower,
+                                                     size_t mem_size) {
+  HistogramTimerScope wasm_compile_module_time_scope(
+      isolate->counters()->wasm_compile_module_time());
+  this->shared_isolate = isolate;  // TODO(titzer): have a real shared isolate.
+
+  if (mem_size > WasmModule::kMaxMemPages * WasmModule::kPageSize) {
+    thrower->Error("Out of memory: wasm memory too large");
+    return MaybeHandle<FixedArray>();
+  }
+
+  CompiledModuleBuilder builder(isolate, this, mem_size);
+  ModuleEnv* module_env = builder.module_env();
+
+  isolate->counters()->wasm_functions_per_module()->AddSample(
+      static_cast<int>(functions.size()));
+
+  std::vector<Handle<Code>> results(functions.size());
+  if (FLAG_wasm_lazy_compilation && origin == kWasmOrigin) {
+    if (!CreateLazyCompileStubs(isolate, thrower, module_env, &results)) {
+      return MaybeHandle<FixedArray>();
+    }
+    Handle<FixedArray> compiled_module = builder.Build(results);
+    compiled_module->set(kCompiledLazy, isolate->heap()->true_value());
+    return compiled_module;
+  }
+  if (FLAG_wasm_parallel_compilation) {
+    // Create a placeholder code object for all functions and imports, so that
+    // direct calls can be compiled without allocating.
+    builder.CreatePlaceholders();
+
+    std::vector<compiler::WasmCompilationUnit*> compilation_units;
+    for (uint32_t i = FLAG_skip_compiling_wasm_funcs; i < functions.size();
+         i++) {
+      if (!functions[i].external) {
+        compilation_units.push_back(compiler::CreateWasmCompilationUnit(
+            thrower, isolate, module_env, &functions[i]));
+      }
+    }
+
+    CompileInParallel(isolate, compilation_units, &results);
+  }
+
+  for (uint32_t i = FLAG_skip_compiling_wasm_funcs; i < functions.size();
+       i++) {
+    const WasmFunction& func = functions[i];
+    if (func.external) continue;
+    DCHECK_EQ(i, func.func_index);
+    if (!FLAG_wasm_parallel_compilation) {
+      results[i] =
+          compiler::CompileWasmFunction(thrower, isolate, module_env, &func);
+    }
+    if (results[i].is_null()) {
+      WasmName str = GetName(func.name_offset, func.name_length);
+      thrower->Error("Compilation of #%d:%.*s failed.", i, str.length(),
+                     str.start());
+      return MaybeHandle<FixedArray>();
+    }
+  }
+  return builder.Build(results);
+}
+
 // Instantiates a wasm module as a JSObject.
 //  * allocates a backing store of {mem_size} bytes.
 //  * installs a named property "memory" for that buffer if exported
@@ -406,9 +804,27 @@ static MaybeHandle<JSFunction> LookupFunction(
 MaybeHandle<JSObject> WasmModule::Instantiate(Isolate* isolate,
                                               Handle<JSObject> ffi,
                                               Handle<JSArrayBuffer> memory) {
+  ErrorThrower thrower(isolate, "WasmModule::Instantiate()");
+  size_t mem_size = memory.is_null()
+                        ? WasmModule::kPageSize * min_mem_pages
+                        : static_cast<size_t>(memory->byte_length()->Number());
+  MaybeHandle<FixedArray> compiled_module =
+      CompileFunctions(isolate, &thrower, mem_size);
+  if (compiled_module.is_null()) return MaybeHandle<JSObject>();
+  return Instantiate(isolate, compiled_module.ToHandleChecked(), ffi, memory);
+}
+
+// Instantiates a wasm module from a compiled module, which can be
+// instantiated any number of times.
+//  * allocates a backing store of {mem_size} bytes.
+//  * installs a named property "memory" for that buffer if exported
+//  * installs named properties on the object for exported functions
+//  * copies the compiled code and relocates it to the new instance
+MaybeHandle<JSObject> WasmModule::Instantiate(
+    Isolate* isolate, Handle<FixedArray> compiled_module, Handle<JSObject> ffi,
+    Handle<JSArrayBuffer> memory) {
   HistogramTimerScope wasm_instantiate_module_time_scope(
       isolate->counters()->wasm_instantiate_module_time());
-  this->shared_isolate = isolate;  // TODO(titzer): have a real shared isolate.
   ErrorThrower thrower(isolate, "WasmModule::Instantiate()");
   Factory* factory = isolate->factory();
 
@@ -466,15 +882,32 @@ MaybeHandle<JSObject> WasmModule::Instantiate(Isolate* isolate,
                                          *instance.globals_buffer);
   }
 
-  HistogramTimerScope wasm_compile_module_time_scope(
-      isolate->counters()->wasm_compile_module_time());
+  //-------------------------------------------------------------------------
+  // Recompile if the memory does not have the size the code was compiled
+  // for, since the bounds checks embed that size.
+  //-------------------------------------------------------------------------
+  if (static_cast<size_t>(compiled_module->get(kCompiledMemSize)->Number()) !=
+      instance.mem_size) {
+    if (!CompileFunctions(isolate, &thrower, instance.mem_size)
+             .ToHandle(&compiled_module)) {
+      return MaybeHandle<JSObject>();
+    }
+  }
+  Handle<FixedArray> compiled_code(
+      FixedArray::cast(compiled_module->get(kCompiledCodeTable)), isolate);
+  Handle<Object> compiled_function_table(
+      compiled_module->get(kCompiledFunctionTable), isolate);
+  if (compiled_function_table->IsFixedArray()) {
+    instance.function_table = factory->CopyFixedArray(
+        Handle<FixedArray>::cast(compiled_function_table));
+  }
 
   //-------------------------------------------------------------------------
   // Compile wrappers to imported functions.
   //-------------------------------------------------------------------------
   uint32_t index = 0;
-  instance.function_table = BuildFunctionTable(isolate, this);
-  WasmLinker linker(isolate, functions.size());
+  std::vector<Handle<Code>> export_code;
+  WasmLinker linker(isolate, functions.size(), import_table.size());
   ModuleEnv module_env;
   module_env.module = this;
   module_env.instance = &instance;
@@ -495,44 +928,17 @@ MaybeHandle<JSObject> WasmModule::Instantiate(Isolate* isolate,
           isolate, &module_env, function.ToHandleChecked(), import.sig,
           module_name, function_name);
       instance.import_code.push_back(code);
+      linker.FinishImport(index, code);
       record_code_size(*code);
       index++;
     }
   }
 
   //-------------------------------------------------------------------------
-  // Compile all functions in the module.
+  // Copy the code of all functions in the module into the instance.
   //-------------------------------------------------------------------------
   {
-    isolate->counters()->wasm_functions_per_module()->AddSample(
-        static_cast<int>(functions.size()));
-
-    std::vector<compiler::WasmCompilationUnit*> compilation_units(
-        functions.size());
-    if (FLAG_wasm_parallel_compilation) {
-      // Create a placeholder code object for all functions.
-      // TODO(ahaas): Maybe we could skip this for external functions.
-      for (uint32_t i = 0; i < functions.size(); i++) {
-        linker.GetFunctionCode(i);
-      }
-
-      for (uint32_t i = FLAG_skip_compiling_wasm_funcs; i < functions.size();
-           i++) {
-        if (!functions[i].external) {
-          compilation_units[i] = compiler::CreateWasmCompilationUnit(
-              &thrower, isolate, &module_env, &functions[i]);
-        }
-      }
-
-      for (uint32_t i = FLAG_skip_compiling_wasm_funcs; i < functions.size();
-           i++) {
-        if (!functions[i].external) {
-          compiler::ExecuteCompilation(compilation_units[i]);
-        }
-      }
-    }
-
-    // First pass: compile each function and initialize the code table.
+    // First pass: relocate each function and initialize the code table.
     for (uint32_t i = FLAG_skip_compiling_wasm_funcs; i < functions.size();
          i++) {
       const WasmFunction& func = functions[i];
@@ -553,21 +959,13 @@ MaybeHandle<JSObject> WasmModule::Instantiate(Isolate* isolate,
                                                 function.ToHandleChecked(),
                                                 func.sig, str, str_null);
       } else {
-        if (FLAG_wasm_parallel_compilation) {
-          code = compiler::FinishCompilation(compilation_units[i]);
-        } else {
-          // Compile the function.
-          code = compiler::CompileWasmFunction(&thrower, isolate, &module_env,
-                                               &func);
-        }
-        if (code.is_null()) {
-          thrower.Error("Compilation of #%d:%.*s failed.", i, str.length(),
-                        str.start());
-          return MaybeHandle<JSObject>();
-        }
+        code = CloneCodeForInstance(
+            isolate, compiled_module,
+            handle(Code::cast(compiled_code->get(i)), isolate), &instance, i);
         if (func.exported) {
           function = compiler::CompileJSToWasmWrapper(
               isolate, &module_env, name, code, instance.js_object, i);
+          export_code.push_back(handle(function->code(), isolate));
           record_code_size(function->code());
         }
       }
@@ -590,8 +988,13 @@ MaybeHandle<JSObject> WasmModule::Instantiate(Isolate* isolate,
 
     // Second pass: patch all direct call sites.
     linker.Link(instance.function_table, this->function_table);
-    instance.js_object->SetInternalField(kWasmModuleFunctionTable,
-                                         Smi::FromInt(0));
+    if (instance.function_table.is_null()) {
+      instance.js_object->SetInternalField(kWasmModuleFunctionTable,
+                                           Smi::FromInt(0));
+    } else {
+      instance.js_object->SetInternalField(kWasmModuleFunctionTable,
+                                           *instance.function_table);
+    }
 
     //-------------------------------------------------------------------------
     // Create and populate the exports object.
@@ -615,6 +1018,7 @@ MaybeHandle<JSObject> WasmModule::Instantiate(Isolate* isolate,
         Handle<JSFunction> function = compiler::CompileJSToWasmWrapper(
             isolate, &module_env, name, code, instance.js_object,
             exp.func_index);
+        export_code.push_back(handle(function->code(), isolate));
         record_code_size(function->code());
         desc.set_value(function);
         Maybe<bool> status = JSReceiver::DefineOwnProperty(
@@ -641,6 +1045,20 @@ MaybeHandle<JSObject> WasmModule::Instantiate(Isolate* isolate,
     instance.js_object->SetInternalField(kWasmFunctionNamesArray, *arr);
   }
 
+  //-------------------------------------------------------------------------
+  // Keep what is needed to compile the functions when they are first called.
+  //-------------------------------------------------------------------------
+  if (compiled_module->get(kCompiledLazy)->IsTrue()) {
+    instance.js_object->SetInternalField(
+        kWasmImportCodeTable, *NewCodeTable(isolate, instance.import_code));
+    instance.js_object->SetInternalField(
+        kWasmExportCodeTable, *NewCodeTable(isolate, export_code));
+    int size = static_cast<int>(module_end - module_start);
+    Handle<ByteArray> bytes = factory->NewByteArray(size, TENURED);
+    bytes->copy_in(0, module_start, size);
+    instance.js_object->SetInternalField(kWasmModuleBytes, *bytes);
+  }
+
   if (FLAG_print_wasm_code_size)
     printf("Total generated wasm code: %u bytes\n", total_code_size);
 
@@ -674,6 +1092,7 @@ Handle<Code> ModuleEnv::GetFunctionCode(uint32_t index) {
 
 Handle<Code> ModuleEnv::GetImportCode(uint32_t index) {
   DCHECK(IsValidImport(index));
+  if (linker) return linker->GetImportCode(index);
   return instance ? instance->import_code[index] : Handle<Code>::null();
 }
 
@@ -732,7 +1151,8 @@ int32_t CompileAndRunWasmModule(Isolate* isolate, WasmModule* module) {
   instance.function_table = BuildFunctionTable(isolate, module);
 
   // Create module environment.
-  WasmLinker linker(isolate, module->functions.size());
+  WasmLinker linker(isolate, module->functions.size(),
+                    module->import_table.size());
   ModuleEnv module_env;
   module_env.module = module;
   module_env.instance = &instance;
@@ -795,6 +1215,110 @@ int32_t CompileAndRunWasmModule(Isolate* isolate, WasmModule* module) {
   return -1;
 }
 
+MaybeHandle<Code> CompileLazy(Isolate* isolate, Handle<Code> stub) {
+  FixedArray* deopt_data = stub->deoptimization_data();
+  Handle<JSObject> js_object(JSObject::cast(deopt_data->get(0)), isolate);
+  uint32_t func_index =
+      static_cast<uint32_t>(Smi::cast(deopt_data->get(1))->value());
+  Handle<FixedArray> code_table(
+      FixedArray::cast(js_object->GetInternalField(kWasmModuleCodeTable)),
+      isolate);
+  if (code_table->get(func_index) != *stub) {
+    // The function has been compiled through a call site of the stub that is
+    // not patched, e.g. a frame below that was already calling it.
+    return handle(Code::cast(code_table->get(func_index)), isolate);
+  }
+
+  // Decode the module again from a copy of its bytes, because the decoded
+  // module points into them and the byte array may move.
+  // TODO(wasm): keep the decoded module alive with the instance instead.
+  ByteArray* bytes =
+      ByteArray::cast(js_object->GetInternalField(kWasmModuleBytes));
+  std::vector<byte> copy(bytes->GetDataStartAddress(),
+                         bytes->GetDataStartAddress() + bytes->length());
+  Zone zone(isolate->allocator());
+  ModuleResult result = DecodeWasmModule(isolate, &zone, copy.data(),
+                                         copy.data() + copy.size(), false,
+                                         kWasmOrigin);
+  base::SmartPointer<WasmModule> module(result.val);
+  CHECK(!result.failed());  // The module has been decoded before.
+  module->shared_isolate = isolate;
+  AllocateGlobalsOffsets(module->globals);
+
+  // Recreate the environment of the instance. Direct calls go to the code
+  // in the code table, which is either compiled code or another stub.
+  WasmModuleInstance instance(module.get());
+  instance.js_object = js_object;
+  instance.context = isolate->native_context();
+  SetMemory(&instance,
+            handle(JSArrayBuffer::cast(
+                       js_object->GetInternalField(kWasmMemArrayBuffer)),
+                   isolate));
+  Object* globals = js_object->GetInternalField(kWasmGlobalsArrayBuffer);
+  if (globals->IsJSArrayBuffer()) {
+    instance.globals_buffer = handle(JSArrayBuffer::cast(globals), isolate);
+    instance.globals_start =
+        reinterpret_cast<byte*>(instance.globals_buffer->backing_store());
+    instance.globals_size = static_cast<size_t>(
+        instance.globals_buffer->byte_length()->Number());
+  }
+  Object* function_table =
+      js_object->GetInternalField(kWasmModuleFunctionTable);
+  if (function_table->IsFixedArray()) {
+    instance.function_table =
+        handle(FixedArray::cast(function_table), isolate);
+  }
+  for (int i = 0; i < code_table->length(); i++) {
+    Object* code = code_table->get(i);
+    instance.function_code.push_back(
+        code->IsCode() ? handle(Code::cast(code), isolate)
+                       : Handle<Code>::null());
+  }
+  FixedArray* import_code =
+      FixedArray::cast(js_object->GetInternalField(kWasmImportCodeTable));
+  for (int i = 0; i < import_code->length(); i++) {
+    instance.import_code.push_back(
+        handle(Code::cast(import_code->get(i)), isolate));
+  }
+  ModuleEnv module_env;
+  module_env.module = module.get();
+  module_env.instance = &instance;
+  module_env.linker = nullptr;
+  module_env.origin = module->origin;
+
+  ErrorThrower thrower(isolate, "WasmModule::CompileLazy()");
+  const WasmFunction& func = module->functions[func_index];
+  Handle<Code> code =
+      compiler::CompileWasmFunction(&thrower, isolate, &module_env, &func);
+  if (code.is_null()) {
+    WasmName str = module->GetName(func.name_offset, func.name_length);
+    thrower.Error("Compilation of #%d:%.*s failed.", func_index, str.length(),
+                  str.start());
+    return MaybeHandle<Code>();
+  }
+
+  // Install the code and patch the function table and the direct calls from
+  // the functions and the export wrappers, so that the stub is not called
+  // again.
+  code_table->set(func_index, *code);
+  if (!instance.function_table.is_null()) {
+    FixedArray* table = *instance.function_table;
+    for (int i = table->length() / 2; i < table->length(); i++) {
+      if (table->get(i) == *stub) table->set(i, *code);
+    }
+  }
+  for (int i = 0; i < code_table->length(); i++) {
+    if (!code_table->get(i)->IsCode()) continue;
+    RedirectCalls(isolate, Code::cast(code_table->get(i)), *stub, *code);
+  }
+  FixedArray* export_code =
+      FixedArray::cast(js_object->GetInternalField(kWasmExportCodeTable));
+  for (int i = 0; i < export_code->length(); i++) {
+    RedirectCalls(isolate, Code::cast(export_code->get(i)), *stub, *code);
+  }
+  return code;
+}
+
 Handle<Object> GetWasmFunctionName(Handle<JSObject> wasm, uint32_t func_index) {
   Handle<Object> func_names_arr_obj = handle(
       wasm->GetInternalField(kWasmFunctionNamesArray), wasm->GetIsolate());
@@ -9,6 +9,7 @@
 #include "src/wasm/wasm-result.h"
 
 #include "src/api.h"
+#include "src/base/smart-pointers.h"
 #include "src/handles.h"
 
 namespace v8 {
@@ -220,9 +221,23 @@ struct WasmModule {
     return start <= size && end <= size;
   }
 
+  // Compiles the functions of the module for a memory of {mem_size} bytes.
+  // The result does not depend on a particular memory, globals area or
+  // function table and can be instantiated many times.
+  MaybeHandle<FixedArray> CompileFunctions(Isolate* isolate,
+                                           ErrorThrower* thrower,
+                                           size_t mem_size);
+
   // Creates a new instantiation of the module in the given isolate.
   MaybeHandle<JSObject> Instantiate(Isolate* isolate, Handle<JSObject> ffi,
                                     Handle<JSArrayBuffer> memory);
+
+  // Creates a new instantiation of the module from the result of
+  // CompileFunctions.
+  MaybeHandle<JSObject> Instantiate(Isolate* isolate,
+                                    Handle<FixedArray> compiled_module,
+                                    Handle<JSObject> ffi,
+                                    Handle<JSArrayBuffer> memory);
 };
 
 // An instantiated WASM module, including memory, function table, etc.
@@ -307,6 +322,37 @@ struct ModuleEnv {
   compiler::CallDescriptor* GetCallDescriptor(Zone* zone, uint32_t index);
 };
 
+// Sets up the environment for compiling the functions of {module} for a
+// memory of {mem_size} bytes, and assembles the compiled module from the
+// resulting code. WasmModule::CompileFunctions is built on this, as is the
+// streaming decoder, which compiles functions before the whole module has
+// been decoded.
+class CompiledModuleBuilder {
+ public:
+  CompiledModuleBuilder(Isolate* isolate, WasmModule* module, size_t mem_size);
+  ~CompiledModuleBuilder();
+
+  // The environment to compile the functions in.
+  ModuleEnv* module_env() { return &module_env_; }
+
+  // Creates the placeholder code objects for direct calls to all functions
+  // and imports, so that compilation units can be executed without
+  // allocating.
+  void CreatePlaceholders();
+
+  // Assembles the compiled module from the code of the functions, indexed by
+  // function index.
+  Handle<FixedArray> Build(const std::vector<Handle<Code>>& code);
+
+ private:
+  Isolate* isolate_;
+  WasmModuleInstance instance_;
+  base::SmartPointer<WasmLinker> linker_;
+  ModuleEnv module_env_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompiledModuleBuilder);
+};
+
 // A helper for printing out the names of functions.
 struct WasmFunctionName {
   const WasmFunction* function_;
@@ -331,6 +377,11 @@ int32_t CompileAndRunWasmModule(Isolate* isolate, const byte* module_start,
 // given decoded module.
 int32_t CompileAndRunWasmModule(Isolate* isolate, WasmModule* module);
 
+// Compiles the function whose lazy compile {stub} has been called, for the
+// instance the stub belongs to. Installs the code in that instance and
+// returns it, or schedules an exception if compilation fails.
+MaybeHandle<Code> CompileLazy(Isolate* isolate, Handle<Code> stub);
+
 // Extract a function name from the given wasm object.
 // Returns undefined if the function is unnamed or the function index is
 // invalid.
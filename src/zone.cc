@@ -6,6 +6,7 @@
 
 #include <cstring>
 
+#include "src/base/bits.h"
 #include "src/v8.h"
 
 #ifdef V8_USE_ADDRESS_SANITIZER
@@ -232,11 +233,12 @@ Address Zone::NewExpand(size_t size) {
   // Compute the new segment size. We use a 'high water mark'
   // strategy, where we increase the segment size every time we expand
   // except that we employ a maximum segment size when we delete. This
-  // is to avoid excessive malloc() and free() overhead.
+  // is to avoid excessive malloc() and free() overhead. Sizes up to the
+  // maximum are powers of two, so that the allocator can recycle segments.
   Segment* head = segment_head_;
   const size_t old_size = (head == nullptr) ? 0 : head->size();
   static const size_t kSegmentOverhead = sizeof(Segment) + kAlignment;
-  const size_t new_size_no_overhead = size + (old_size << 1);
+  const size_t new_size_no_overhead = size + old_size;
   size_t new_size = kSegmentOverhead + new_size_no_overhead;
   const size_t min_new_size = kSegmentOverhead + size;
   // Guard against integer overflow.
@@ -252,6 +254,13 @@ Address Zone::NewExpand(size_t size) {
     // All the while making sure to allocate a segment large enough to hold the
     // requested size.
     new_size = Max(min_new_size, kMaximumSegmentSize);
+  } else {
+    STATIC_ASSERT(kMinimumSegmentSize ==
+                  base::AccountingAllocator::kMinPooledSize);
+    STATIC_ASSERT(kMaximumSegmentSize ==
+                  base::AccountingAllocator::kMaxPooledSize);
+    new_size =
+        base::bits::RoundUpToPowerOfTwo32(static_cast<uint32_t>(new_size));
   }
   if (new_size > INT_MAX) {
     V8::FatalProcessOutOfMemory("Zone");
@@ -573,6 +573,23 @@ TEST(InlineMutuallyRecursive) {
   T.CheckCall(T.Val(42), T.Val(1));
 }
 
+
+TEST(InlinePolymorphicCall) {
+  FLAG_polymorphic_inlining = true;
+  FunctionTester T(
+      "(function () {"
+      "  'use strict';"
+      "  const foo = function(s) { AssertInlineCount(2); return s; };"
+      "  const baz = function(s) { AssertInlineCount(2); return s + 1; };"
+      "  return function(s, t) { return (t ? foo : baz)(s); };"
+      "})();",
+      kInlineFlags);
+
+  InstallAssertInlineCountHelper(CcTest::isolate());
+  T.CheckCall(T.Val(1), T.Val(1), T.true_value());
+  T.CheckCall(T.Val(2), T.Val(1), T.false_value());
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
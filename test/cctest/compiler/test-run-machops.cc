@@ -9,6 +9,7 @@
 #include "src/base/bits.h"
 #include "src/base/utils/random-number-generator.h"
 #include "src/codegen.h"
+#include "src/third_party/fdlibm/fdlibm.h"
 #include "test/cctest/cctest.h"
 #include "test/cctest/compiler/codegen-tester.h"
 #include "test/cctest/compiler/graph-builder-tester.h"
@@ -5681,6 +5682,30 @@ TEST(RunFloat64RoundTiesAway) {
 }
 
 
+TEST(RunFloat64Sin) {
+  BufferedRawMachineAssemblerTester<double> m(MachineType::Float64());
+  if (!m.machine()->Float64Sin().IsSupported()) return;
+  m.Return(m.Float64Sin(m.Parameter(0)));
+  FOR_FLOAT64_INPUTS(i) { CHECK_DOUBLE_EQ(fdlibm::sin(*i), m.Call(*i)); }
+}
+
+
+TEST(RunFloat64Cos) {
+  BufferedRawMachineAssemblerTester<double> m(MachineType::Float64());
+  if (!m.machine()->Float64Cos().IsSupported()) return;
+  m.Return(m.Float64Cos(m.Parameter(0)));
+  FOR_FLOAT64_INPUTS(i) { CHECK_DOUBLE_EQ(fdlibm::cos(*i), m.Call(*i)); }
+}
+
+
+TEST(RunFloat64Tan) {
+  BufferedRawMachineAssemblerTester<double> m(MachineType::Float64());
+  if (!m.machine()->Float64Tan().IsSupported()) return;
+  m.Return(m.Float64Tan(m.Parameter(0)));
+  FOR_FLOAT64_INPUTS(i) { CHECK_DOUBLE_EQ(fdlibm::tan(*i), m.Call(*i)); }
+}
+
+
 #if !USE_SIMULATOR
 
 namespace {
@@ -6250,6 +6275,181 @@ TEST(ParentFramePointer) {
   CHECK_EQ(1, r.Call(1));
 }
 
+#if V8_TARGET_ARCH_X64
+TEST(RunFloat32x4ExtractLane) {
+  for (int32_t lane = 0; lane < 4; lane++) {
+    BufferedRawMachineAssemblerTester<float> m(MachineType::Float32());
+    m.Return(m.Float32x4ExtractLane(m.Float32x4Splat(m.Parameter(0)), lane));
+    FOR_FLOAT32_INPUTS(i) { CHECK_FLOAT_EQ(*i, m.Call(*i)); }
+  }
+}
+
+TEST(RunFloat32x4Binops) {
+  for (int32_t lane = 0; lane < 4; lane++) {
+    BufferedRawMachineAssemblerTester<float> add(MachineType::Float32(),
+                                                 MachineType::Float32());
+    BufferedRawMachineAssemblerTester<float> sub(MachineType::Float32(),
+                                                 MachineType::Float32());
+    BufferedRawMachineAssemblerTester<float> mul(MachineType::Float32(),
+                                                 MachineType::Float32());
+    add.Return(add.Float32x4ExtractLane(
+        add.Float32x4Add(add.Float32x4Splat(add.Parameter(0)),
+                         add.Float32x4Splat(add.Parameter(1))),
+        lane));
+    sub.Return(sub.Float32x4ExtractLane(
+        sub.Float32x4Sub(sub.Float32x4Splat(sub.Parameter(0)),
+                         sub.Float32x4Splat(sub.Parameter(1))),
+        lane));
+    mul.Return(mul.Float32x4ExtractLane(
+        mul.Float32x4Mul(mul.Float32x4Splat(mul.Parameter(0)),
+                         mul.Float32x4Splat(mul.Parameter(1))),
+        lane));
+    FOR_FLOAT32_INPUTS(i) {
+      FOR_FLOAT32_INPUTS(j) {
+        CHECK_FLOAT_EQ(*i + *j, add.Call(*i, *j));
+        CHECK_FLOAT_EQ(*i - *j, sub.Call(*i, *j));
+        CHECK_FLOAT_EQ(*i * *j, mul.Call(*i, *j));
+      }
+    }
+  }
+}
+
+TEST(RunInt32x4ExtractLane) {
+  for (int32_t lane = 0; lane < 4; lane++) {
+    BufferedRawMachineAssemblerTester<int32_t> m(MachineType::Int32());
+    m.Return(m.Int32x4ExtractLane(m.Int32x4Splat(m.Parameter(0)), lane));
+    FOR_INT32_INPUTS(i) { CHECK_EQ(*i, m.Call(*i)); }
+  }
+}
+
+TEST(RunInt32x4Binops) {
+  for (int32_t lane = 0; lane < 4; lane++) {
+    BufferedRawMachineAssemblerTester<int32_t> add(MachineType::Int32(),
+                                                   MachineType::Int32());
+    BufferedRawMachineAssemblerTester<int32_t> sub(MachineType::Int32(),
+                                                   MachineType::Int32());
+    add.Return(add.Int32x4ExtractLane(
+        add.Int32x4Add(add.Int32x4Splat(add.Parameter(0)),
+                       add.Int32x4Splat(add.Parameter(1))),
+        lane));
+    sub.Return(sub.Int32x4ExtractLane(
+        sub.Int32x4Sub(sub.Int32x4Splat(sub.Parameter(0)),
+                       sub.Int32x4Splat(sub.Parameter(1))),
+        lane));
+    FOR_INT32_INPUTS(i) {
+      FOR_INT32_INPUTS(j) {
+        uint32_t a = static_cast<uint32_t>(*i);
+        uint32_t b = static_cast<uint32_t>(*j);
+        CHECK_EQ(static_cast<int32_t>(a + b), add.Call(*i, *j));
+        CHECK_EQ(static_cast<int32_t>(a - b), sub.Call(*i, *j));
+      }
+    }
+  }
+}
+
+TEST(RunInt32x4Phi) {
+  RawMachineAssemblerTester<int32_t> m(MachineType::Int32(),
+                                       MachineType::Int32());
+  RawMachineLabel tlabel;
+  RawMachineLabel flabel;
+  RawMachineLabel merge;
+  m.Branch(m.Parameter(0), &tlabel, &flabel);
+  m.Bind(&tlabel);
+  Node* tvalue = m.Int32x4Splat(m.Parameter(1));
+  m.Goto(&merge);
+  m.Bind(&flabel);
+  Node* fvalue = m.Int32x4Splat(m.Int32Constant(-1));
+  m.Goto(&merge);
+  m.Bind(&merge);
+  Node* phi = m.Phi(MachineRepresentation::kSimd128, tvalue, fvalue);
+  m.Return(m.Int32x4ExtractLane(m.Int32x4Add(phi, phi), 3));
+  FOR_INT32_INPUTS(i) {
+    uint32_t a = static_cast<uint32_t>(*i);
+    CHECK_EQ(static_cast<int32_t>(a + a), m.Call(1, *i));
+    CHECK_EQ(-2, m.Call(0, *i));
+  }
+}
+
+TEST(RunSimd128LoadStore) {
+  // Unaligned on purpose, vector accesses must not require 16-byte alignment.
+  int32_t input[5] = {0, 1, -2, 3, -4};
+  int32_t output[6] = {0, 0, 0, 0, 0, 0};
+  RawMachineAssemblerTester<int32_t> m;
+  Node* value = m.Load(MachineType::Simd128(), m.PointerConstant(&input[1]));
+  m.Store(MachineRepresentation::kSimd128, m.PointerConstant(&output[1]),
+          m.Int32x4Add(value, value), kNoWriteBarrier);
+  m.Return(m.Int32Constant(0));
+  CHECK_EQ(0, m.Call());
+  CHECK_EQ(0, output[0]);
+  for (int i = 1; i < 5; i++) CHECK_EQ(2 * input[i], output[i]);
+  CHECK_EQ(0, output[5]);
+}
+
+TEST(RunFloat32x4MulAddLoop) {
+  // a[i] = b[i] * s + c[i], four elements at a time, with a scalar epilogue
+  // for the remaining elements.
+  const int kLength = 11;
+  float a[kLength], b[kLength], c[kLength];
+  for (int i = 0; i < kLength; i++) {
+    a[i] = 0.0f;
+    b[i] = static_cast<float>(i) + 0.5f;
+    c[i] = static_cast<float>(kLength - i);
+  }
+  const float s = 3.0f;
+  const intptr_t kVectorBytes = 4 * sizeof(float);
+  const intptr_t kBytes = kLength * sizeof(float);
+  RawMachineAssemblerTester<int32_t> m;
+  Node* a_base = m.PointerConstant(a);
+  Node* b_base = m.PointerConstant(b);
+  Node* c_base = m.PointerConstant(c);
+  Node* scalar = m.Float32Constant(s);
+  Node* vector = m.Float32x4Splat(scalar);
+  Node* zero = m.IntPtrConstant(0);
+  RawMachineLabel vector_header, vector_body, scalar_header, scalar_body, end;
+
+  m.Goto(&vector_header);
+  m.Bind(&vector_header);
+  Node* vector_offset = m.Phi(MachineType::PointerRepresentation(), zero, zero);
+  m.Branch(m.IntPtrLessThanOrEqual(
+               m.IntPtrAdd(vector_offset, m.IntPtrConstant(kVectorBytes)),
+               m.IntPtrConstant(kBytes)),
+           &vector_body, &scalar_header);
+  m.Bind(&vector_body);
+  m.Store(MachineRepresentation::kSimd128, a_base, vector_offset,
+          m.Float32x4Add(
+              m.Float32x4Mul(m.Load(MachineType::Simd128(), b_base,
+                                    vector_offset),
+                             vector),
+              m.Load(MachineType::Simd128(), c_base, vector_offset)),
+          kNoWriteBarrier);
+  vector_offset->ReplaceInput(
+      1, m.IntPtrAdd(vector_offset, m.IntPtrConstant(kVectorBytes)));
+  m.Goto(&vector_header);
+
+  m.Bind(&scalar_header);
+  Node* scalar_offset =
+      m.Phi(MachineType::PointerRepresentation(), vector_offset, zero);
+  m.Branch(m.IntPtrLessThan(scalar_offset, m.IntPtrConstant(kBytes)),
+           &scalar_body, &end);
+  m.Bind(&scalar_body);
+  m.Store(MachineRepresentation::kFloat32, a_base, scalar_offset,
+          m.Float32Add(m.Float32Mul(m.Load(MachineType::Float32(), b_base,
+                                           scalar_offset),
+                                    scalar),
+                       m.Load(MachineType::Float32(), c_base, scalar_offset)),
+          kNoWriteBarrier);
+  scalar_offset->ReplaceInput(
+      1, m.IntPtrAdd(scalar_offset, m.IntPtrConstant(sizeof(float))));
+  m.Goto(&scalar_header);
+
+  m.Bind(&end);
+  m.Return(m.Int32Constant(0));
+
+  CHECK_EQ(0, m.Call());
+  for (int i = 0; i < kLength; i++) CHECK_FLOAT_EQ(b[i] * s + c[i], a[i]);
+}
+#endif  // V8_TARGET_ARCH_X64
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
@@ -251,3 +251,36 @@ TEST(CodeRange) {
     }
   }
 }
+
+
+TEST(CodeRangeHugePages) {
+  const size_t code_range_size = 32 * MB;
+  CcTest::InitializeVM();
+  bool old_flag = FLAG_code_range_huge_pages;
+  FLAG_code_range_huge_pages = true;
+  {
+    CodeRange code_range(reinterpret_cast<Isolate*>(CcTest::isolate()));
+    code_range.SetUp(code_range_size +
+                     kReservedCodeRangePages * v8::base::OS::CommitPageSize());
+    size_t requested = Page::kPageSize;
+    size_t allocated = 0;
+    Address first = code_range.AllocateRawMemory(
+        requested, requested - (2 * MemoryAllocator::CodePageGuardSize()),
+        &allocated);
+    CHECK(first != NULL);
+    // The range starts on a huge page boundary.
+    CHECK_EQ(0u, reinterpret_cast<uintptr_t>(first) % (2 * MB));
+    // Guard pages are committed as well.
+    Address guard = first + MemoryAllocator::CodePageGuardStartOffset();
+    *guard = 1;
+    *(first + allocated - 1) = 1;
+    size_t second_allocated = 0;
+    Address second = code_range.AllocateRawMemory(
+        requested, requested - (2 * MemoryAllocator::CodePageGuardSize()),
+        &second_allocated);
+    CHECK(second != NULL);
+    code_range.FreeRawMemory(first, allocated);
+    code_range.FreeRawMemory(second, second_allocated);
+  }
+  FLAG_code_range_huge_pages = old_flag;
+}
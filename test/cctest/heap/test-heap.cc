@@ -35,6 +35,7 @@
 #include "src/factory.h"
 #include "src/field-type.h"
 #include "src/global-handles.h"
+#include "src/heap/array-buffer-tracker.h"
 #include "src/heap/gc-tracer.h"
 #include "src/heap/memory-reducer.h"
 #include "src/ic/ic.h"
@@ -1247,6 +1248,71 @@ UNINITIALIZED_TEST(TestCodeFlushing) {
 }
 
 
+UNINITIALIZED_TEST(TestBytecodeFlushing) {
+  // If we do not flush code this test is invalid.
+  if (!FLAG_flush_code) return;
+  i::FLAG_allow_natives_syntax = true;
+  i::FLAG_optimize_for_size = false;
+  i::FLAG_ignition = true;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  isolate->Enter();
+  Factory* factory = i_isolate->factory();
+  {
+    v8::HandleScope scope(isolate);
+    v8::Context::New(isolate)->Enter();
+    const char* source =
+        "function foo() {"
+        "  var x = 42;"
+        "  var y = 42;"
+        "  var z = x + y;"
+        "};"
+        "foo()";
+    Handle<String> foo_name = factory->InternalizeUtf8String("foo");
+
+    // This compile will add the code to the compilation cache.
+    {
+      v8::HandleScope scope(isolate);
+      CompileRun(source);
+    }
+
+    // Check function is compiled to bytecode.
+    Handle<Object> func_value = Object::GetProperty(i_isolate->global_object(),
+                                                    foo_name).ToHandleChecked();
+    CHECK(func_value->IsJSFunction());
+    Handle<JSFunction> function = Handle<JSFunction>::cast(func_value);
+    CHECK(function->shared()->is_compiled());
+    CHECK(function->shared()->HasBytecodeArray());
+
+    // The bytecode will survive at least two GCs.
+    i_isolate->heap()->CollectAllGarbage();
+    i_isolate->heap()->CollectAllGarbage();
+    CHECK(function->shared()->is_compiled());
+    CHECK(function->shared()->HasBytecodeArray());
+
+    // Simulate several GCs that use full marking.
+    const int kAgingThreshold = 6;
+    for (int i = 0; i < kAgingThreshold; i++) {
+      i_isolate->heap()->CollectAllGarbage();
+    }
+
+    // foo should no longer be in the compilation cache
+    CHECK(!function->shared()->is_compiled() || function->IsOptimized());
+    CHECK(!function->shared()->HasBytecodeArray() || function->IsOptimized());
+    CHECK(!function->is_compiled() || function->IsOptimized());
+    // Call foo to get it recompiled.
+    CompileRun("foo()");
+    CHECK(function->shared()->is_compiled());
+    CHECK(function->shared()->HasBytecodeArray());
+    CHECK(function->is_compiled());
+  }
+  isolate->Exit();
+  isolate->Dispose();
+}
+
+
 TEST(TestCodeFlushingPreAged) {
   // If we do not flush code this test is invalid.
   if (!FLAG_flush_code) return;
@@ -1626,6 +1692,39 @@ TEST(CompilationCacheCachingBehavior) {
 }
 
 
+TEST(CompilationCacheClearedOnMemoryPressure) {
+  if (!FLAG_compilation_cache) return;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  Heap* heap = isolate->heap();
+  CompilationCache* compilation_cache = isolate->compilation_cache();
+  LanguageMode language_mode = construct_language_mode(FLAG_use_strict);
+
+  v8::HandleScope scope(CcTest::isolate());
+  const char* raw_source = "function foo() { return 42; }; foo()";
+  Handle<String> source = factory->InternalizeUtf8String(raw_source);
+  Handle<Context> native_context = isolate->native_context();
+  {
+    v8::HandleScope scope(CcTest::isolate());
+    CompileRun(raw_source);
+  }
+  MaybeHandle<SharedFunctionInfo> info = compilation_cache->LookupScript(
+      source, Handle<Object>(), 0, 0,
+      v8::ScriptOriginOptions(false, true, false), native_context,
+      language_mode);
+  CHECK(!info.is_null());
+
+  heap->MemoryPressureNotification(v8::MemoryPressureLevel::kCritical, true);
+  info = compilation_cache->LookupScript(
+      source, Handle<Object>(), 0, 0,
+      v8::ScriptOriginOptions(false, true, false), native_context,
+      language_mode);
+  CHECK(info.is_null());
+  heap->MemoryPressureNotification(v8::MemoryPressureLevel::kNone, true);
+}
+
+
 static void OptimizeEmptyFunction(const char* name) {
   HandleScope scope(CcTest::i_isolate());
   EmbeddedVector<char, 256> source;
@@ -2332,6 +2431,92 @@ TEST(GrowAndShrinkNewSpace) {
 }
 
 
+TEST(GrowToAndShrinkToNewSpace) {
+  CcTest::InitializeVM();
+  Heap* heap = CcTest::heap();
+  NewSpace* new_space = heap->new_space();
+
+  if (heap->MaxSemiSpaceSize() == heap->InitialSemiSpaceSize()) {
+    return;
+  }
+
+  // Growing is capped at the maximum capacity.
+  intptr_t initial_capacity = new_space->TotalCapacity();
+  new_space->GrowTo(new_space->MaximumCapacity() + Page::kPageSize);
+  CHECK_EQ(new_space->MaximumCapacity(), new_space->TotalCapacity());
+
+  // Growing to a smaller capacity has no effect.
+  new_space->GrowTo(static_cast<int>(initial_capacity));
+  CHECK_EQ(new_space->MaximumCapacity(), new_space->TotalCapacity());
+
+  // Shrinking an empty new space stops at the initial capacity.
+  heap->CollectGarbage(NEW_SPACE);
+  new_space->ShrinkTo(0);
+  CHECK_EQ(initial_capacity, new_space->TotalCapacity());
+}
+
+namespace {
+
+class FindObjectVisitor : public IncrementalHeapIterator::Visitor {
+ public:
+  explicit FindObjectVisitor(HeapObject* target)
+      : target_(target), found_(false), visited_(0) {}
+
+  void Visit(HeapObject* object) override {
+    if (object == target_) found_ = true;
+    visited_++;
+  }
+
+  bool found() const { return found_; }
+  int visited() const { return visited_; }
+
+ private:
+  HeapObject* target_;
+  bool found_;
+  int visited_;
+};
+
+}  // namespace
+
+
+TEST(IncrementalHeapIterator) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  HandleScope scope(isolate);
+  Handle<FixedArray> old = isolate->factory()->NewFixedArray(10, TENURED);
+  CHECK(!heap->InNewSpace(*old));
+
+  FindObjectVisitor visitor(*old);
+  IncrementalHeapIterator iterator(heap, &visitor);
+  int gc_count = heap->gc_count();
+  IncrementalHeapIterator::StepResult result;
+  do {
+    // Steps with an expired deadline still make progress.
+    result = iterator.Step(0);
+    if (result == IncrementalHeapIterator::kInProgress &&
+        heap->mark_compact_collector()->sweeping_in_progress()) {
+      heap->mark_compact_collector()->EnsureSweepingCompleted();
+    }
+  } while (result == IncrementalHeapIterator::kInProgress);
+  CHECK_EQ(IncrementalHeapIterator::kDone, result);
+  CHECK_EQ(gc_count, heap->gc_count());
+  CHECK(visitor.found());
+  CHECK_LT(0, visitor.visited());
+}
+
+
+TEST(IncrementalHeapIteratorAbortsAfterGC) {
+  CcTest::InitializeVM();
+  Heap* heap = CcTest::heap();
+  FindObjectVisitor visitor(nullptr);
+  IncrementalHeapIterator iterator(heap, &visitor);
+  heap->CollectGarbage(NEW_SPACE);
+  CHECK_EQ(IncrementalHeapIterator::kAborted,
+           iterator.Step(heap->MonotonicallyIncreasingTimeInMs() + 1000));
+  CHECK_EQ(0, visitor.visited());
+}
+
 TEST(CollectingAllAvailableGarbageShrinksNewSpace) {
   CcTest::InitializeVM();
   Heap* heap = CcTest::heap();
@@ -3535,38 +3720,39 @@ TEST(ReleaseOverReservedPages) {
 
   // Prepare many pages with low live-bytes count.
   PagedSpace* old_space = heap->old_space();
-  CHECK_EQ(1, old_space->CountTotalPages());
+  // The startup snapshot has a page of its own, so the context may have
+  // needed another one.
+  const int initial_pages = old_space->CountTotalPages();
+  CHECK_GE(2, initial_pages);
   for (int i = 0; i < number_of_test_pages; i++) {
     AlwaysAllocateScope always_allocate(isolate);
     SimulateFullSpace(old_space);
     factory->NewFixedArray(1, TENURED);
   }
-  CHECK_EQ(number_of_test_pages + 1, old_space->CountTotalPages());
+  CHECK_EQ(number_of_test_pages + initial_pages, old_space->CountTotalPages());
 
   // Triggering one GC will cause a lot of garbage to be discovered but
   // even spread across all allocated pages.
   heap->CollectAllGarbage(Heap::kFinalizeIncrementalMarkingMask,
                           "triggered for preparation");
-  CHECK_GE(number_of_test_pages + 1, old_space->CountTotalPages());
+  CHECK_GE(number_of_test_pages + initial_pages, old_space->CountTotalPages());
 
   // Triggering subsequent GCs should cause at least half of the pages
   // to be released to the OS after at most two cycles.
   heap->CollectAllGarbage(Heap::kFinalizeIncrementalMarkingMask,
                           "triggered by test 1");
-  CHECK_GE(number_of_test_pages + 1, old_space->CountTotalPages());
+  CHECK_GE(number_of_test_pages + initial_pages, old_space->CountTotalPages());
   heap->CollectAllGarbage(Heap::kFinalizeIncrementalMarkingMask,
                           "triggered by test 2");
-  CHECK_GE(number_of_test_pages + 1, old_space->CountTotalPages() * 2);
+  CHECK_GE(number_of_test_pages + initial_pages,
+           old_space->CountTotalPages() * 2);
 
   // Triggering a last-resort GC should cause all pages to be released to the
   // OS so that other processes can seize the memory.  If we get a failure here
-  // where there are 2 pages left instead of 1, then we should increase the
-  // size of the first page a little in SizeOfFirstPage in spaces.cc.  The
-  // first page should be small in order to reduce memory used when the VM
-  // boots, but if the 20 small arrays don't fit on the first page then that's
-  // an indication that it is too small.
+  // where there are more pages left than initially, then the 20 small arrays
+  // did not fit on the page that holds the context.
   heap->CollectAllAvailableGarbage("triggered really hard");
-  CHECK_EQ(1, old_space->CountTotalPages());
+  CHECK_EQ(initial_pages, old_space->CountTotalPages());
 }
 
 static int forced_gc_counter = 0;
@@ -4626,6 +4812,39 @@ TEST(LargeObjectSlotRecording) {
 }
 
 
+TEST(LargeObjectPageShrinksAfterRightTrim) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  HandleScope scope(isolate);
+
+  int length = Max(1000000, Page::kMaxRegularHeapObjectSize + KB);
+  Handle<FixedArray> lo = isolate->factory()->NewFixedArray(length, TENURED);
+  CHECK(heap->lo_space()->Contains(*lo));
+  LargePage* page =
+      static_cast<LargePage*>(MemoryChunk::FromAddress(lo->address()));
+  size_t old_page_size = page->size();
+  intptr_t old_space_size = heap->lo_space()->Size();
+
+  // Record an old-to-new slot in the part that is trimmed away.
+  Handle<HeapNumber> number = isolate->factory()->NewHeapNumber(42);
+  CHECK(heap->InNewSpace(*number));
+  lo->set(length - 1, *number);
+
+  const int kRemainingLength = 100;
+  heap->RightTrimFixedArray<Heap::SEQUENTIAL_TO_SWEEPER>(
+      *lo, length - kRemainingLength);
+  heap->CollectAllGarbage();
+  CHECK_EQ(kRemainingLength, lo->length());
+  CHECK_LT(page->size(), old_page_size);
+  CHECK_LT(heap->lo_space()->Size(), old_space_size);
+  CHECK_LE(lo->address() + lo->Size(), page->area_end());
+
+  // The slot in the released memory must not be visited anymore.
+  heap->CollectGarbage(NEW_SPACE);
+  CHECK(heap->lo_space()->Contains(*lo));
+}
+
 class DummyVisitor : public ObjectVisitor {
  public:
   void VisitPointers(Object** start, Object** end) override {}
@@ -6642,5 +6861,213 @@ UNINITIALIZED_TEST(PagePromotion) {
   }
 }
 
+TEST(ParallelScavengeOldToNewPointers) {
+  FLAG_parallel_scavenge = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  Heap* heap = isolate->heap();
+  HandleScope scope(isolate);
+  const int kLength = 1024;
+  Handle<FixedArray> old = factory->NewFixedArray(kLength, TENURED);
+  CHECK(heap->InOldSpace(*old));
+  for (int i = 0; i < kLength; i++) {
+    Handle<HeapNumber> number = factory->NewHeapNumber(i);
+    CHECK(heap->InNewSpace(*number));
+    old->set(i, *number);
+  }
+  // The first scavenge copies the numbers within new space, the second one
+  // promotes them.
+  heap->CollectGarbage(NEW_SPACE);
+  for (int i = 0; i < kLength; i++) {
+    CHECK(heap->InNewSpace(old->get(i)));
+    CHECK_EQ(i, HeapNumber::cast(old->get(i))->value());
+  }
+  heap->CollectGarbage(NEW_SPACE);
+  for (int i = 0; i < kLength; i++) {
+    CHECK(!heap->InNewSpace(old->get(i)));
+    CHECK_EQ(i, HeapNumber::cast(old->get(i))->value());
+  }
+}
+
+namespace {
+
+struct NearHeapLimitState {
+  int invocations;
+  size_t initial_heap_limit;
+};
+
+size_t RaiseHeapLimit(void* data, size_t current_heap_limit,
+                      size_t initial_heap_limit) {
+  NearHeapLimitState* state = reinterpret_cast<NearHeapLimitState*>(data);
+  state->invocations++;
+  state->initial_heap_limit = initial_heap_limit;
+  return current_heap_limit * 2;
+}
+
+}  // namespace
+
+UNINITIALIZED_TEST(NearHeapLimitCallbackRaisesLimit) {
+  v8::Isolate::CreateParams create_params;
+  create_params.constraints.set_max_old_space_size(16 * Page::kPageSize / MB);
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  NearHeapLimitState state = {0, 0};
+  isolate->SetNearHeapLimitCallback(RaiseHeapLimit, &state);
+  isolate->Enter();
+  {
+    i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+    Heap* heap = i_isolate->heap();
+    intptr_t initial_limit = heap->MaxOldGenerationSize();
+    HandleScope handle_scope(i_isolate);
+    const int kMaxObjects = 10000;
+    const int kFixedArrayLen = 8 * KB;
+    Handle<FixedArray> objects[kMaxObjects];
+    for (int i = 0; i < kMaxObjects && state.invocations == 0; i++) {
+      objects[i] = i_isolate->factory()->NewFixedArray(kFixedArrayLen, TENURED);
+    }
+    CHECK_LT(0, state.invocations);
+    CHECK_EQ(static_cast<size_t>(initial_limit), state.initial_heap_limit);
+    CHECK_LT(initial_limit, heap->MaxOldGenerationSize());
+    CHECK_EQ(initial_limit, heap->InitialMaxOldGenerationSize());
+  }
+  isolate->Exit();
+  isolate->Dispose();
+}
+
+TEST(SetHeapLimits) {
+  CcTest::InitializeVM();
+  Heap* heap = CcTest::heap();
+  intptr_t old_generation_limit = heap->MaxOldGenerationSize();
+  v8::ResourceConstraints constraints;
+  constraints.set_max_old_space_size(
+      static_cast<int>(2 * old_generation_limit / MB));
+  CcTest::isolate()->SetHeapLimits(constraints);
+  CHECK_EQ(2 * old_generation_limit, heap->MaxOldGenerationSize());
+  // Zero values keep the limits.
+  CcTest::isolate()->SetHeapLimits(v8::ResourceConstraints());
+  CHECK_EQ(2 * old_generation_limit, heap->MaxOldGenerationSize());
+  constraints.set_max_old_space_size(
+      static_cast<int>(old_generation_limit / MB));
+  CcTest::isolate()->SetHeapLimits(constraints);
+  CHECK_EQ(old_generation_limit, heap->MaxOldGenerationSize());
+  CHECK_EQ(old_generation_limit, heap->InitialMaxOldGenerationSize());
+}
+
+TEST(DescriptorLookupCacheKeepsRecentEntries) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  HandleScope scope(isolate);
+  DescriptorLookupCache* cache = isolate->descriptor_lookup_cache();
+  cache->Clear();
+  Handle<Map> map = factory->NewMap(JS_OBJECT_TYPE, JSObject::kHeaderSize);
+
+  static const int kNameCount = 512;
+  Handle<String> names[kNameCount];
+  for (int i = 0; i < kNameCount; i++) {
+    EmbeddedVector<char, 16> buffer;
+    SNPrintF(buffer, "name%d", i);
+    names[i] = factory->InternalizeUtf8String(buffer.start());
+  }
+
+  DisallowHeapAllocation no_gc;
+  for (int i = 0; i + 1 < kNameCount; i++) {
+    // The two most recently updated keys always survive, even when they
+    // hash to the same set.
+    cache->Update(*map, *names[i], i);
+    cache->Update(*map, *names[i + 1], i + 1);
+    CHECK_EQ(i, cache->Lookup(*map, *names[i]));
+    CHECK_EQ(i + 1, cache->Lookup(*map, *names[i + 1]));
+  }
+  // Updating a cached key overwrites its result.
+  cache->Update(*map, *names[0], 42);
+  CHECK_EQ(42, cache->Lookup(*map, *names[0]));
+
+  cache->Clear();
+  for (int i = 0; i < kNameCount; i++) {
+    CHECK_EQ(DescriptorLookupCache::kAbsent, cache->Lookup(*map, *names[i]));
+  }
+}
+
+TEST(ConcurrentStoreBufferProcessing) {
+  FLAG_concurrent_store_buffer = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  Heap* heap = isolate->heap();
+  HandleScope scope(isolate);
+  // Record enough slots to overflow both store buffers several times.
+  const int kLength =
+      3 * StoreBuffer::kStoreBuffers * StoreBuffer::kStoreBufferSize /
+      kPointerSize;
+  Handle<FixedArray> old = factory->NewFixedArray(kLength, TENURED);
+  CHECK(!heap->InNewSpace(*old));
+  Handle<HeapNumber> number = factory->NewHeapNumber(42);
+  CHECK(heap->InNewSpace(*number));
+  for (int i = 0; i < kLength; i++) {
+    old->set(i, *number);
+  }
+  heap->CollectGarbage(NEW_SPACE);
+  for (int i = 0; i < kLength; i++) {
+    CHECK_EQ(*number, old->get(i));
+  }
+}
+
+namespace {
+
+class BatchFreeingArrayBufferAllocator : public v8::ArrayBuffer::Allocator {
+ public:
+  BatchFreeingArrayBufferAllocator() : batches_(0), freed_blocks_(0) {}
+
+  void* Allocate(size_t length) override { return calloc(length, 1); }
+  void* AllocateUninitialized(size_t length) override {
+    return malloc(length);
+  }
+  void Free(void* data, size_t) override { free(data); }
+  void FreeBatch(void** data, size_t* length, size_t count) override {
+    batches_++;
+    freed_blocks_ += static_cast<int>(count);
+    v8::ArrayBuffer::Allocator::FreeBatch(data, length, count);
+  }
+  bool IsThreadSafe() const override { return true; }
+
+  int batches() const { return batches_; }
+  int freed_blocks() const { return freed_blocks_; }
+
+ private:
+  int batches_;
+  int freed_blocks_;
+};
+
+}  // namespace
+
+UNINITIALIZED_TEST(ConcurrentArrayBufferFreeing) {
+  FLAG_concurrent_array_buffer_freeing = true;
+  BatchFreeingArrayBufferAllocator allocator;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = &allocator;
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  isolate->Enter();
+  {
+    i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+    Heap* heap = i_isolate->heap();
+    const int kNumBuffers = 16;
+    {
+      HandleScope handle_scope(i_isolate);
+      for (int i = 0; i < kNumBuffers; i++) {
+        Handle<JSArrayBuffer> buffer = i_isolate->factory()->NewJSArrayBuffer();
+        CHECK(JSArrayBuffer::SetupAllocatingData(buffer, i_isolate, KB));
+      }
+    }
+    heap->CollectAllGarbage();
+    heap->array_buffer_tracker()->WaitUntilFreeingCompleted();
+    CHECK_LE(1, allocator.batches());
+    CHECK_LE(kNumBuffers, allocator.freed_blocks());
+  }
+  isolate->Exit();
+  isolate->Dispose();
+}
+
 }  // namespace internal
 }  // namespace v8
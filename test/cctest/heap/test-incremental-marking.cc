@@ -194,5 +194,121 @@ TEST(IncrementalMarkingUsingDelayedTasks) {
   i::V8::SetPlatformForTesting(old_platform);
 }
 
+
+namespace {
+
+// Keeps |target| alive as long as the wrapper with |tag| in its first internal
+// field is alive. Traces in incremental marking steps only.
+class IncrementalTracer : public v8::EmbedderHeapTracer {
+ public:
+  IncrementalTracer(v8::Isolate* isolate, void* tag,
+                    v8::Global<v8::Object>* target)
+      : isolate_(isolate),
+        tag_(tag),
+        target_(target),
+        found_wrapper_(false),
+        in_final_pause_(false),
+        traced_incrementally_(false),
+        prologues_(0),
+        epilogues_(0) {}
+
+  void TracePrologue() override { prologues_++; }
+
+  void TraceWrappersFrom(
+      const std::vector<std::pair<void*, void*> >& internal_fields) override {
+    CHECK(false);
+  }
+
+  void RegisterV8References(
+      const std::vector<std::pair<void*, void*> >& internal_fields) override {
+    for (const std::pair<void*, void*>& fields : internal_fields) {
+      if (fields.first == tag_) found_wrapper_ = true;
+    }
+  }
+
+  bool AdvanceTracing(double deadline_in_ms,
+                      AdvanceTracingActions actions) override {
+    CHECK_EQ(in_final_pause_,
+             actions.force_completion == EmbedderHeapTracer::FORCE_COMPLETION);
+    if (found_wrapper_ && !target_->IsEmpty()) {
+      if (!in_final_pause_) traced_incrementally_ = true;
+      target_->RegisterExternalReference(isolate_);
+    }
+    found_wrapper_ = false;
+    return false;
+  }
+
+  void EnterFinalPause() override { in_final_pause_ = true; }
+
+  void TraceEpilogue() override {
+    in_final_pause_ = false;
+    epilogues_++;
+  }
+
+  bool traced_incrementally() const { return traced_incrementally_; }
+  int prologues() const { return prologues_; }
+  int epilogues() const { return epilogues_; }
+
+ private:
+  v8::Isolate* isolate_;
+  void* tag_;
+  v8::Global<v8::Object>* target_;
+  bool found_wrapper_;
+  bool in_final_pause_;
+  bool traced_incrementally_;
+  int prologues_;
+  int epilogues_;
+};
+
+void ResetOnGC(const v8::WeakCallbackInfo<v8::Global<v8::Object> >& data) {
+  data.GetParameter()->Reset();
+}
+
+}  // namespace
+
+
+TEST(IncrementalMarkingTracesWrappers) {
+  if (!i::FLAG_incremental_marking) return;
+  i::FLAG_incremental_marking_wrappers = true;
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope scope(isolate);
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+
+  static int tag = 0;
+  static int other_field = 0;
+  // The tracer cannot be unregistered and has to outlive the test.
+  static v8::Global<v8::Object> target;
+  static IncrementalTracer* tracer =
+      new IncrementalTracer(isolate, &tag, &target);
+  isolate->SetEmbedderHeapTracer(tracer);
+
+  v8::Local<v8::FunctionTemplate> templ = v8::FunctionTemplate::New(isolate);
+  templ->InstanceTemplate()->SetInternalFieldCount(2);
+  {
+    v8::HandleScope inner_scope(isolate);
+    v8::Local<v8::Object> wrapper = templ->GetFunction(context)
+                                        .ToLocalChecked()
+                                        ->NewInstance(context)
+                                        .ToLocalChecked();
+    wrapper->SetAlignedPointerInInternalField(0, &tag);
+    wrapper->SetAlignedPointerInInternalField(1, &other_field);
+    CHECK(context->Global()
+              ->Set(context, v8_str("wrapper"), wrapper)
+              .FromJust());
+    // Only the embedder keeps the target alive.
+    target.Reset(isolate, v8::Object::New(isolate));
+    target.SetWeak(&target, ResetOnGC, v8::WeakCallbackType::kParameter);
+  }
+
+  SimulateIncrementalMarking(CcTest::heap());
+  CHECK(tracer->traced_incrementally());
+  CcTest::heap()->CollectAllGarbage();
+  CHECK(!target.IsEmpty());
+  CHECK_EQ(1, tracer->prologues());
+  CHECK_EQ(1, tracer->epilogues());
+  target.Reset();
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -200,6 +200,40 @@ HEAP_TEST(MarkCompactCollector) {
 }
 
 
+TEST(ParallelMarkingDequeOverflow) {
+  FLAG_parallel_marking = true;
+  FLAG_force_marking_deque_overflows = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = CcTest::heap();
+  Factory* factory = isolate->factory();
+  HandleScope scope(isolate);
+
+  // Build a wide tree of arrays that does not fit into the marking deque.
+  const int kWidth = 256;
+  const int kDepth = 8;
+  Handle<FixedArray> root = factory->NewFixedArray(kWidth, TENURED);
+  for (int i = 0; i < kWidth; i++) {
+    Handle<FixedArray> current = root;
+    for (int j = 0; j < kDepth; j++) {
+      Handle<FixedArray> child = factory->NewFixedArray(2, TENURED);
+      child->set(0, Smi::FromInt(i * kDepth + j));
+      current->set(current.is_identical_to(root) ? i : 1, *child);
+      current = child;
+    }
+  }
+  heap->CollectAllGarbage();
+  heap->CollectAllGarbage();
+  for (int i = 0; i < kWidth; i++) {
+    FixedArray* current = FixedArray::cast(root->get(i));
+    for (int j = 0; j < kDepth; j++) {
+      CHECK_EQ(Smi::FromInt(i * kDepth + j), current->get(0));
+      if (j < kDepth - 1) current = FixedArray::cast(current->get(1));
+    }
+  }
+}
+
+
 // TODO(1600): compaction of map space is temporary removed from GC.
 #if 0
 static Handle<Map> CreateMap(Isolate* isolate) {
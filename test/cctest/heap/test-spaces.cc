@@ -352,6 +352,29 @@ TEST(MemoryAllocator) {
 }
 
 
+TEST(PagedSpaceExpandReusesPooledPages) {
+  CcTest::InitializeVM();
+  Heap* heap = CcTest::heap();
+  MemoryAllocator* memory_allocator = heap->memory_allocator();
+  OldSpace* old_space = heap->old_space();
+  Page* page = memory_allocator->AllocatePage(
+      Page::kAllocatableMemory, static_cast<PagedSpace*>(old_space),
+      NOT_EXECUTABLE);
+  Address pooled_address = page->address();
+  memory_allocator->Free<MemoryAllocator::kPooledAndQueue>(page);
+  memory_allocator->unmapper()->FreeQueuedChunks();
+  memory_allocator->unmapper()->WaitUntilCompleted();
+  // Allocate until the old space has to expand.
+  AlwaysAllocateScope always_allocate(CcTest::i_isolate());
+  HandleScope scope(CcTest::i_isolate());
+  int pages = old_space->CountTotalPages();
+  while (old_space->CountTotalPages() == pages) {
+    CcTest::i_isolate()->factory()->NewFixedArray(1024, TENURED);
+  }
+  CHECK_EQ(pooled_address, old_space->anchor()->prev_page()->address());
+}
+
+
 TEST(NewSpace) {
   Isolate* isolate = CcTest::i_isolate();
   Heap* heap = isolate->heap();
@@ -483,6 +506,75 @@ TEST(LargeObjectSpace) {
 }
 
 
+TEST(LargeObjectSpaceReleasesDeadChunksConcurrently) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  LargeObjectSpace* lo = heap->lo_space();
+  heap->CollectAllGarbage();
+  heap->memory_allocator()->unmapper()->WaitUntilCompleted();
+  intptr_t lo_size_before = lo->Size();
+  {
+    HandleScope scope(isolate);
+    const int kLength = Page::kMaxRegularHeapObjectSize / kPointerSize;
+    Handle<FixedArray> array = isolate->factory()->NewFixedArray(kLength);
+    CHECK(lo->Contains(*array));
+    CHECK_GT(lo->Size(), lo_size_before);
+  }
+  heap->CollectAllGarbage();
+  // The dead chunk is dropped from the space during the pause, the memory is
+  // given back to the OS by the unmapper.
+  CHECK_LE(lo->Size(), lo_size_before);
+  heap->memory_allocator()->unmapper()->WaitUntilCompleted();
+}
+
+
+TEST(FreeListAllocationInFragmentedOldSpace) {
+  FLAG_never_compact = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  Factory* factory = isolate->factory();
+  OldSpace* old_space = heap->old_space();
+  HandleScope scope(isolate);
+
+  // Fragment the old space with holes of all free list categories.
+  const int kNumArrays = 4096;
+  Handle<FixedArray> holder = factory->NewFixedArray(kNumArrays, TENURED);
+  for (int i = 0; i < kNumArrays; i++) {
+    int length = 4 << (i % 10);
+    holder->set(i, *factory->NewFixedArray(length, TENURED));
+  }
+  for (int i = 0; i < kNumArrays; i += 2) {
+    holder->set(i, Smi::FromInt(0));
+  }
+  heap->CollectAllGarbage();
+  heap->mark_compact_collector()->EnsureSweepingCompleted();
+  intptr_t available = old_space->free_list()->Available();
+  CHECK_GT(available, 0);
+  int pages = old_space->CountTotalPages();
+
+  // Refill the holes. Allocations should be served from the free lists.
+  AlwaysAllocateScope always_allocate(isolate);
+  for (int i = 0; i < kNumArrays; i += 2) {
+    int length = 4 << (i % 10);
+    holder->set(i, *factory->NewFixedArray(length, TENURED));
+  }
+  CHECK_LT(old_space->free_list()->Available(), available);
+  CHECK_LE(old_space->CountTotalPages(), pages + 1);
+}
+
+
+static int CountPagesAfterBootstrapping(PagedSpace* space) {
+  int pages = 0;
+  PageIterator it(space);
+  while (it.has_next()) {
+    if (!it.next()->NeverEvacuate()) pages++;
+  }
+  return pages;
+}
+
+
 TEST(SizeOfFirstPageIsLargeEnough) {
   if (i::FLAG_always_opt) return;
   // Bootstrapping without a snapshot causes more allocations.
@@ -494,26 +586,46 @@ TEST(SizeOfFirstPageIsLargeEnough) {
   // If this test fails due to enabling experimental natives that are not part
   // of the snapshot, we may need to adjust CalculateFirstPageSizes.
 
-  // Freshly initialized VM gets by with one page per space.
+  // Freshly initialized VM gets by with one page per space for the startup
+  // snapshot and at most one more page per space for the context.
   for (int i = FIRST_PAGED_SPACE; i <= LAST_PAGED_SPACE; i++) {
     // Debug code can be very large, so skip CODE_SPACE if we are generating it.
     if (i == CODE_SPACE && i::FLAG_debug_code) continue;
-    CHECK_EQ(1, isolate->heap()->paged_space(i)->CountTotalPages());
+    PagedSpace* space = isolate->heap()->paged_space(i);
+    CHECK_GE(1, CountPagesAfterBootstrapping(space));
+    CHECK_EQ(1, space->CountTotalPages() - CountPagesAfterBootstrapping(space));
   }
 
-  // Executing the empty script gets by with one page per space.
+  // Executing the empty script does not need any further pages.
   HandleScope scope(isolate);
   CompileRun("/*empty*/");
   for (int i = FIRST_PAGED_SPACE; i <= LAST_PAGED_SPACE; i++) {
     // Debug code can be very large, so skip CODE_SPACE if we are generating it.
     if (i == CODE_SPACE && i::FLAG_debug_code) continue;
-    CHECK_EQ(1, isolate->heap()->paged_space(i)->CountTotalPages());
+    PagedSpace* space = isolate->heap()->paged_space(i);
+    CHECK_GE(1, CountPagesAfterBootstrapping(space));
+    CHECK_EQ(1, space->CountTotalPages() - CountPagesAfterBootstrapping(space));
   }
 
   // No large objects required to perform the above steps.
   CHECK(isolate->heap()->lo_space()->IsEmpty());
 }
 
+
+TEST(StartupSnapshotPagesAreNotSharedWithLaterAllocations) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  HandleScope scope(isolate);
+  // Old and map space pages holding the startup snapshot are released down to
+  // their last object, so that everything allocated later goes to pages that
+  // can be evacuated.
+  Handle<FixedArray> array = factory->NewFixedArray(16, TENURED);
+  CHECK(!Page::FromAddress(array->address())->NeverEvacuate());
+  Handle<Map> map = factory->NewMap(JS_OBJECT_TYPE, JSObject::kHeaderSize);
+  CHECK(!Page::FromAddress(map->address())->NeverEvacuate());
+}
+
 static HeapObject* AllocateUnaligned(NewSpace* space, int size) {
   AllocationResult allocation = space->AllocateRawUnaligned(size);
   CHECK(!allocation.IsRetry());
@@ -91,6 +91,34 @@ TEST(IsArray) {
   CHECK_EQ(*factory->false_value(), *helper.Invoke(helper.NewObject("42")));
 }
 
+TEST(GeneratorGetInput) {
+  HandleAndZoneScope handles;
+
+  InvokeIntrinsicHelper helper(handles.main_isolate(), handles.main_zone(),
+                               Runtime::kInlineGeneratorGetInput);
+
+  Handle<Object> generator = helper.NewObject(
+      "var g = (function*() { yield 1; yield 2; })();"
+      "g.next(); g.next(42); g");
+  CHECK_EQ(Smi::FromInt(42), *helper.Invoke(generator));
+}
+
+TEST(GeneratorGetResumeMode) {
+  HandleAndZoneScope handles;
+
+  InvokeIntrinsicHelper helper(handles.main_isolate(), handles.main_zone(),
+                               Runtime::kInlineGeneratorGetResumeMode);
+
+  Handle<Object> generator = helper.NewObject(
+      "var g = (function*() { try { yield 1; } catch (e) { yield 2; } })();"
+      "g.next(); g.next(); g");
+  CHECK_EQ(Smi::FromInt(JSGeneratorObject::kNext), *helper.Invoke(generator));
+  generator = helper.NewObject(
+      "var h = (function*() { try { yield 1; } catch (e) { yield 2; } })();"
+      "h.next(); h.throw(new Error()); h");
+  CHECK_EQ(Smi::FromInt(JSGeneratorObject::kThrow), *helper.Invoke(generator));
+}
+
 }  // namespace interpreter
 }  // namespace internal
 }  // namespace v8
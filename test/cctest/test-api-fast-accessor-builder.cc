@@ -362,3 +362,57 @@ TEST(FastAccessorCallback) {
   CompileRun(FN_WARMUP("callbackparam", "return obj.param"));
   ExpectInt32("callbackparam()", 1000);
 }
+
+
+namespace {
+
+static int fast_api_calls = 0;
+
+static int32_t FastAdd(int32_t a, int32_t b) {
+  fast_api_calls++;
+  return a + b;
+}
+
+static void NativeAdd(const v8::FunctionCallbackInfo<v8::Value>& info) {
+  v8::Local<v8::Context> context = info.GetIsolate()->GetCurrentContext();
+  info.GetReturnValue().Set(info[0]->Int32Value(context).FromJust() +
+                            info[1]->Int32Value(context).FromJust());
+}
+
+}  // anonymous namespace
+
+
+// Register a fast C function and verify that optimized code calls it.
+TEST(FastApiFunction) {
+  i::FLAG_allow_natives_syntax = true;
+  i::FLAG_turbo = true;
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+
+  v8::Local<v8::FunctionTemplate> add =
+      v8::FunctionTemplate::New(isolate, NativeAdd);
+  const v8::experimental::FastApiFunction::Type kArgumentTypes[] = {
+      v8::experimental::FastApiFunction::kInt32,
+      v8::experimental::FastApiFunction::kInt32};
+  v8::experimental::FastApiFunction::Set(
+      add, reinterpret_cast<const void*>(&FastAdd),
+      v8::experimental::FastApiFunction::kInt32, 2, kArgumentTypes);
+  CHECK(env->Global()
+            ->Set(env.local(), v8_str("add"),
+                  add->GetFunction(env.local()).ToLocalChecked())
+            .FromJust());
+
+  // Unoptimized code and arguments of other types use the callback.
+  CompileRun("function f(a, b) { return add(a | 0, b | 0); }");
+  ExpectInt32("f(1, 2)", 3);
+  CompileRun("function g(a, b) { return add(a, b); }");
+  ExpectInt32("g(1, 2); %OptimizeFunctionOnNextCall(g); g('3', 4)", 7);
+  CHECK_EQ(0, fast_api_calls);
+
+#if !USE_SIMULATOR
+  ExpectInt32("%OptimizeFunctionOnNextCall(f); f(3, 4)", 7);
+  ExpectInt32("f(-5, 4)", -1);
+  CHECK_EQ(2, fast_api_calls);
+#endif
+}
@@ -38,6 +38,7 @@
 
 #include "include/v8-util.h"
 #include "src/api.h"
+#include "src/api-natives.h"
 #include "src/arguments.h"
 #include "src/base/platform/platform.h"
 #include "src/base/smart-pointers.h"
@@ -486,6 +487,41 @@ THREADED_TEST(ScriptUsingOneByteStringResource) {
 }
 
 
+THREADED_TEST(NewExternalUtf8) {
+  int dispose_count = 0;
+  {
+    LocalContext env;
+    v8::HandleScope scope(env->GetIsolate());
+    // ASCII data is used in place.
+    TestOneByteResource* resource =
+        new TestOneByteResource(i::StrDup("ascii"), &dispose_count);
+    Local<String> ascii =
+        String::NewExternalUtf8(env->GetIsolate(), resource).ToLocalChecked();
+    CHECK(ascii->IsExternalOneByte());
+    CHECK_EQ(static_cast<const String::ExternalStringResourceBase*>(resource),
+             ascii->GetExternalOneByteStringResource());
+    CHECK_EQ(0, dispose_count);
+
+    // Other data is decoded and the resource is released immediately.
+    Local<String> decoded =
+        String::NewExternalUtf8(
+            env->GetIsolate(),
+            new TestOneByteResource(i::StrDup("caf\xc3\xa9 \xe2\x82\xac"),
+                                    &dispose_count))
+            .ToLocalChecked();
+    CHECK(!decoded->IsExternal());
+    CHECK_EQ(6, decoded->Length());
+    CHECK_EQ(1, dispose_count);
+    CHECK(decoded->Equals(env.local(), v8_str("caf\xc3\xa9 \xe2\x82\xac"))
+              .FromJust());
+    CcTest::heap()->CollectAllGarbage();
+    CHECK_EQ(1, dispose_count);
+  }
+  CcTest::heap()->CollectAllAvailableGarbage();
+  CHECK_EQ(2, dispose_count);
+}
+
+
 THREADED_TEST(ScriptMakingExternalString) {
   int dispose_count = 0;
   uint16_t* two_byte_source = AsciiToTwoByteString("1 + 2 * 3");
@@ -1294,6 +1330,35 @@ THREADED_TEST(FunctionTemplateSetLength) {
 }
 
 
+THREADED_TEST(TemplateInstantiationsCache) {
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  // Enough templates to use both the array and the dictionary cache.
+  const int kTemplates =
+      2 * i::ApiNatives::kFastTemplateInstantiationsCacheSize;
+  for (int i = 0; i < kTemplates; i++) {
+    v8::HandleScope inner_scope(isolate);
+    Local<v8::FunctionTemplate> fun_templ =
+        v8::FunctionTemplate::New(isolate, handle_callback);
+    fun_templ->InstanceTemplate()->Set(v8_str("i"), v8_num(i));
+    Local<Function> fun = fun_templ->GetFunction(env.local()).ToLocalChecked();
+    CHECK(fun == fun_templ->GetFunction(env.local()).ToLocalChecked());
+    Local<v8::Object> first = fun_templ->InstanceTemplate()
+                                  ->NewInstance(env.local())
+                                  .ToLocalChecked();
+    Local<v8::Object> second = fun_templ->InstanceTemplate()
+                                   ->NewInstance(env.local())
+                                   .ToLocalChecked();
+    CHECK(first != second);
+    CHECK_EQ(i, second->Get(env.local(), v8_str("i"))
+                    .ToLocalChecked()
+                    ->Int32Value(env.local())
+                    .FromJust());
+  }
+}
+
+
 static void* expected_ptr;
 static void callback(const v8::FunctionCallbackInfo<v8::Value>& args) {
   void* ptr = v8::External::Cast(*args.Data())->Value();
@@ -5332,6 +5397,54 @@ THREADED_TEST(Array) {
 }
 
 
+THREADED_TEST(ArrayNewWithElements) {
+  LocalContext context;
+  v8::Isolate* isolate = context->GetIsolate();
+  v8::HandleScope scope(isolate);
+  Local<Value> elements[] = {v8_num(1), v8_str("two"), v8::Null(isolate)};
+  Local<v8::Array> array = v8::Array::New(isolate, elements, 3);
+  CHECK_EQ(3u, array->Length());
+  CHECK(context->Global()->Set(context.local(), v8_str("a"), array).FromJust());
+  ExpectString("JSON.stringify(a)", "[1,\"two\",null]");
+  ExpectInt32("a.push(4)", 4);
+  CHECK_EQ(0u, v8::Array::New(isolate, elements, 0)->Length());
+}
+
+
+THREADED_TEST(ObjectNewWithProperties) {
+  LocalContext context;
+  v8::Isolate* isolate = context->GetIsolate();
+  v8::HandleScope scope(isolate);
+  Local<v8::Name> names[] = {v8_str("x"), v8_str("y"), v8_str("0"),
+                             v8_str("x")};
+  Local<Value> values[] = {v8_num(1), v8_num(2.5), v8_str("zero"),
+                           v8_num(3)};
+  Local<v8::Object> first =
+      v8::Object::New(isolate, v8::Undefined(isolate), names, values, 4);
+  Local<v8::Object> second =
+      v8::Object::New(isolate, v8::Undefined(isolate), names, values, 2);
+  Local<v8::Object> third = v8::Object::New(isolate, v8::Null(isolate), names,
+                                            values, 2);
+  CHECK(context->Global()->Set(context.local(), v8_str("first"), first)
+            .FromJust());
+  CHECK(context->Global()->Set(context.local(), v8_str("second"), second)
+            .FromJust());
+  CHECK(context->Global()->Set(context.local(), v8_str("third"), third)
+            .FromJust());
+  ExpectString("JSON.stringify(first)", "{\"0\":\"zero\",\"x\":3,\"y\":2.5}");
+  ExpectString("JSON.stringify(second)", "{\"x\":1,\"y\":2.5}");
+  ExpectTrue("Object.getPrototypeOf(second) === Object.prototype");
+  ExpectTrue("Object.getPrototypeOf(third) === null");
+  ExpectTrue("third.x === 1 && third.y === 2.5");
+
+  // Objects with the same prototype and names share their map.
+  i::Handle<i::JSObject> a = v8::Utils::OpenHandle(*second);
+  i::Handle<i::JSObject> b = v8::Utils::OpenHandle(
+      *v8::Object::New(isolate, v8::Undefined(isolate), names, values, 2));
+  CHECK_EQ(a->map(), b->map());
+}
+
+
 void HandleF(const v8::FunctionCallbackInfo<v8::Value>& args) {
   v8::EscapableHandleScope scope(args.GetIsolate());
   ApiTestFuzzer::Fuzz();
@@ -17769,6 +17882,56 @@ TEST(TestIdleNotification) {
 }
 
 
+// Test that idle notifications with a budget report the performed work and
+// eventually collect garbage.
+TEST(TestIdleNotificationBudget) {
+  if (!i::FLAG_incremental_marking) return;
+  const intptr_t MB = 1024 * 1024;
+  const int64_t kBudgetInMicroseconds = 1000000;
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  intptr_t initial_size = CcTest::heap()->SizeOfObjects();
+  CreateGarbageInOldSpace();
+  intptr_t size_with_garbage = CcTest::heap()->SizeOfObjects();
+  CHECK_GT(size_with_garbage, initial_size + MB);
+  bool finished = false;
+  bool performed_marking_step = false;
+  for (int i = 0; i < 200 && !finished; i++) {
+    if (i < 10 && CcTest::heap()->incremental_marking()->IsStopped()) {
+      CcTest::heap()->StartIdleIncrementalMarking();
+    }
+    v8::IdleGarbageCollectionResult result;
+    finished = env->GetIsolate()->IdleNotificationBudget(kBudgetInMicroseconds,
+                                                         &result);
+    CHECK_LE(result.remaining_budget_in_microseconds(), kBudgetInMicroseconds);
+    performed_marking_step |= result.performed_marking_step();
+    if (CcTest::heap()->mark_compact_collector()->sweeping_in_progress()) {
+      CcTest::heap()->mark_compact_collector()->EnsureSweepingCompleted();
+    }
+  }
+  intptr_t final_size = CcTest::heap()->SizeOfObjects();
+  CHECK(finished);
+  CHECK(performed_marking_step);
+  CHECK_LT(final_size, initial_size + 1);
+}
+
+
+// Test that no work is started once the next deadline has passed.
+TEST(TestIdleNotificationBudgetPastDeadline) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  CcTest::heap()->StartIdleIncrementalMarking();
+  v8::IdleGarbageCollectionResult result;
+  const double kPastDeadlineInSeconds = 1e-6;
+  env->GetIsolate()->IdleNotificationBudget(1000000, &result,
+                                            kPastDeadlineInSeconds);
+  CHECK(!result.performed_scavenge());
+  CHECK(!result.performed_marking_step());
+  CHECK(!result.performed_full_gc());
+  CHECK_LT(result.remaining_budget_in_microseconds(), 0);
+}
+
+
 TEST(Regress2333) {
   LocalContext env;
   for (int i = 0; i < 3; i++) {
@@ -19382,6 +19545,30 @@ UNINITIALIZED_TEST(DisposeIsolateWhenInUse) {
 }
 
 
+UNINITIALIZED_TEST(IsolatePool) {
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::IsolatePool pool(create_params, 2);
+  // Acquiring more isolates than the pool holds falls back to creating them
+  // on this thread.
+  v8::Isolate* isolates[3];
+  for (int i = 0; i < 3; i++) {
+    isolates[i] = pool.Acquire();
+    CHECK(isolates[i] != NULL);
+    for (int j = 0; j < i; j++) CHECK(isolates[i] != isolates[j]);
+  }
+  for (int i = 0; i < 3; i++) {
+    {
+      v8::Isolate::Scope isolate_scope(isolates[i]);
+      v8::HandleScope scope(isolates[i]);
+      LocalContext context(isolates[i]);
+      ExpectInt32("6 * 7", 42);
+    }
+    isolates[i]->Dispose();
+  }
+}
+
+
 static void BreakArrayGuarantees(const char* script) {
   v8::Isolate::CreateParams create_params;
   create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
@@ -23621,6 +23808,62 @@ void RunStreamingTest(const char** chunks,
 }
 
 
+TEST(OptimizationProfile) {
+  if (!i::FLAG_crankshaft || i::FLAG_ignition) return;
+  i::FLAG_allow_natives_syntax = true;
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  CompileRun(
+      "function hot(x) { return x + 1; }"
+      "hot(1); hot(2);"
+      "%OptimizeFunctionOnNextCall(hot);"
+      "hot(3);");
+
+  v8::ScriptCompiler::CachedData* profile =
+      isolate->CreateOptimizationProfile();
+  // A header of two words and at least one entry of four words.
+  CHECK_LE(24, profile->length);
+  CHECK_EQ(8, profile->length % 16);
+  CHECK(isolate->SetOptimizationProfile(profile->data, profile->length));
+  CHECK(!isolate->SetOptimizationProfile(profile->data, profile->length - 4));
+  CHECK(!isolate->SetOptimizationProfile(profile->data, 4));
+  delete profile;
+
+  const uint32_t empty_profile[] = {0x50524f46, 0};
+  CHECK(isolate->SetOptimizationProfile(
+      reinterpret_cast<const uint8_t*>(empty_profile), sizeof(empty_profile)));
+}
+
+
+TEST(StreamingInMemorySource) {
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+
+  // Long enough to be handed to the parser in several chunks.
+  std::string source(200 * i::KB, ' ');
+  source += "var x = 13; x;";
+  v8::ScriptCompiler::StreamedSource streamed_source(
+      reinterpret_cast<const uint8_t*>(source.c_str()), source.length(),
+      v8::ScriptCompiler::StreamedSource::ONE_BYTE);
+  v8::ScriptCompiler::ScriptStreamingTask* task =
+      v8::ScriptCompiler::StartStreamingScript(isolate, &streamed_source);
+  task->Run();
+  delete task;
+
+  v8::Local<Script> script =
+      v8::ScriptCompiler::Compile(env.local(), &streamed_source,
+                                  v8_str(source.c_str()),
+                                  v8::ScriptOrigin(v8_str("http://foo.com")))
+          .ToLocalChecked();
+  CHECK_EQ(13, script->Run(env.local())
+                   .ToLocalChecked()
+                   ->Int32Value(env.local())
+                   .FromJust());
+}
+
+
 TEST(StreamingSimpleScript) {
   // This script is unrealistically small, since no one chunk is enough to fill
   // the backing buffer of Scanner, let alone overflow it.
@@ -23999,6 +24242,60 @@ TEST(StreamingWithHarmonyScopes) {
 }
 
 
+TEST(StreamingModules) {
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  v8::TryCatch try_catch(isolate);
+
+  // Stream several modules before compiling any of them.
+  const char* chunks1[] = {"export let a = ", "13;", NULL};
+  const char* chunks2[] = {"export let b = 2;", NULL};
+  const char** modules[] = {chunks1, chunks2};
+  const int kModuleCount = static_cast<int>(arraysize(modules));
+  v8::ScriptCompiler::StreamedSource* sources[kModuleCount];
+  for (int i = 0; i < kModuleCount; i++) {
+    sources[i] = new v8::ScriptCompiler::StreamedSource(
+        new TestSourceStream(modules[i]),
+        v8::ScriptCompiler::StreamedSource::ONE_BYTE);
+    v8::ScriptCompiler::ScriptStreamingTask* task =
+        v8::ScriptCompiler::StartStreamingModule(isolate, sources[i]);
+    task->Run();
+    delete task;
+  }
+  CHECK_EQ(false, try_catch.HasCaught());
+
+  for (int i = 0; i < kModuleCount; i++) {
+    v8::ScriptOrigin origin(v8_str("http://foo.com"));
+    char* full_source = TestSourceStream::FullSourceString(modules[i]);
+    v8::Local<Script> script;
+    CHECK(v8::ScriptCompiler::Compile(env.local(), sources[i],
+                                      v8_str(full_source), origin)
+              .ToLocal(&script));
+    CHECK(!script->Run(env.local()).IsEmpty());
+    delete[] full_source;
+    delete sources[i];
+  }
+  CHECK_EQ(false, try_catch.HasCaught());
+
+  // The same source is a syntax error when streamed as a script.
+  v8::ScriptCompiler::StreamedSource source(
+      new TestSourceStream(chunks1),
+      v8::ScriptCompiler::StreamedSource::ONE_BYTE);
+  v8::ScriptCompiler::ScriptStreamingTask* task =
+      v8::ScriptCompiler::StartStreamingScript(isolate, &source);
+  task->Run();
+  delete task;
+  v8::ScriptOrigin origin(v8_str("http://foo.com"));
+  char* full_source = TestSourceStream::FullSourceString(chunks1);
+  CHECK(v8::ScriptCompiler::Compile(env.local(), &source, v8_str(full_source),
+                                    origin)
+            .IsEmpty());
+  CHECK(try_catch.HasCaught());
+  delete[] full_source;
+}
+
+
 TEST(CodeCache) {
   v8::Isolate::CreateParams create_params;
   create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
@@ -24294,6 +24591,48 @@ TEST(StreamingScriptWithSourceMappingURLInTheMiddle) {
 }
 
 
+TEST(JSONParseStreaming) {
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  // Keys, strings and numbers split across chunks.
+  const char* chunks[] = {"{\"fo", "o\":[1,2.", "5,\"b", "ar\"],\"x\":", "tr",
+                          "ue}", NULL};
+  TestSourceStream stream(chunks);
+  Local<Value> value =
+      v8::JSON::ParseStreaming(env.local(), &stream).ToLocalChecked();
+  env->Global()->Set(env.local(), v8_str("obj"), value).FromJust();
+  ExpectString("JSON.stringify(obj)", "{\"foo\":[1,2.5,\"bar\"],\"x\":true}");
+}
+
+
+TEST(JSONParseStreamingTwoByte) {
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  // "\xe4\xbd\xa0" is U+4F60, split in the middle. "\xc3\xa4" is U+00E4,
+  // which still fits a one-byte string.
+  const char* chunks[] = {"[\"\xc3\xa4\",\"\xe4", "\xbd\xa0\"]", NULL};
+  TestSourceStream stream(chunks);
+  Local<Value> value =
+      v8::JSON::ParseStreaming(env.local(), &stream).ToLocalChecked();
+  env->Global()->Set(env.local(), v8_str("obj"), value).FromJust();
+  ExpectTrue("obj[0] === '\\u00e4' && obj[1] === '\\u4f60'");
+}
+
+
+TEST(JSONParseStreamingSyntaxError) {
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  v8::TryCatch try_catch(isolate);
+  const char* chunks[] = {"{\"x\":", "}", NULL};
+  TestSourceStream stream(chunks);
+  CHECK(v8::JSON::ParseStreaming(env.local(), &stream).IsEmpty());
+  CHECK(try_catch.HasCaught());
+}
+
+
 TEST(NewStringRangeError) {
   v8::Isolate* isolate = CcTest::isolate();
   v8::HandleScope handle_scope(isolate);
@@ -24362,6 +24701,30 @@ TEST(SealHandleScopeNested) {
 }
 
 
+TEST(HandleScopeReusesBlocks) {
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope handle_scope(isolate);
+  LocalContext env;
+  int handles_before = v8::HandleScope::NumberOfHandles(isolate);
+  // Each round spans several handle blocks, which are returned to and taken
+  // from the spare blocks of the isolate.
+  const int kHandles = 5000;
+  for (int round = 0; round < 3; round++) {
+    v8::HandleScope inner(isolate);
+    v8::Local<v8::Integer> first = v8::Integer::New(isolate, round);
+    v8::Local<v8::Integer> last;
+    for (int i = 0; i < kHandles; i++) {
+      last = v8::Integer::New(isolate, i);
+    }
+    CHECK_EQ(round, first->Value());
+    CHECK_EQ(kHandles - 1, last->Value());
+    CHECK_LE(kHandles, v8::HandleScope::NumberOfHandles(isolate) -
+                           handles_before);
+  }
+  CHECK_EQ(handles_before, v8::HandleScope::NumberOfHandles(isolate));
+}
+
+
 static void ExtrasBindingTestRuntimeFunction(
     const v8::FunctionCallbackInfo<v8::Value>& args) {
   CHECK_EQ(
@@ -24764,6 +25127,68 @@ TEST(EstimatedContextSize) {
 }
 
 
+TEST(ContextHeapAccounting) {
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope scope(isolate);
+  v8::Local<v8::Context> small_context = v8::Context::New(isolate);
+  v8::Local<v8::Context> large_context = v8::Context::New(isolate);
+  v8::ContextHeapStatistics small_stats;
+  v8::ContextHeapStatistics large_stats;
+  CHECK(!large_context->GetHeapStatistics(&large_stats));
+  {
+    v8::Context::Scope context_scope(large_context);
+    CompileRun(
+        "var objects = [];"
+        "for (var i = 0; i < 100000; i++) objects.push({a: i});");
+  }
+  isolate->SetContextHeapAccountingEnabled(true);
+  CcTest::heap()->CollectAllGarbage();
+  isolate->SetContextHeapAccountingEnabled(false);
+  CHECK(small_context->GetHeapStatistics(&small_stats));
+  CHECK(large_context->GetHeapStatistics(&large_stats));
+  CHECK_LT(small_stats.live_heap_size(), large_stats.live_heap_size());
+  v8::HeapStatistics heap_stats;
+  isolate->GetHeapStatistics(&heap_stats);
+  CHECK_LT(0u, heap_stats.shared_live_heap_size());
+}
+
+
+TEST(HeapCompositionStatistics) {
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope scope(isolate);
+  LocalContext env;
+  v8::HeapCompositionStatistics composition;
+  isolate->SetHeapObjectStatisticsEnabled(false);
+  CHECK(!isolate->GetHeapCompositionStatisticsAtLastGC(&composition));
+
+  isolate->SetHeapObjectStatisticsEnabled(true);
+  CompileRun(
+      "var strings = [];"
+      "for (var i = 0; i < 10000; i++) strings.push('s' + i);"
+      "function f(o) { return o.x; }"
+      "f({x: 1});");
+  CcTest::heap()->CollectAllGarbage();
+  CHECK(isolate->GetHeapCompositionStatisticsAtLastGC(&composition));
+  CHECK_LT(10000u * 16, composition.string_size());
+  CHECK_LT(0u, composition.code_size());
+  CHECK_LT(0u, composition.feedback_size());
+  CHECK_LT(0u, composition.map_size());
+  CHECK_LT(0u, composition.array_size());
+
+  // The categories add up to the sizes of all instance types.
+  size_t instance_type_size = 0;
+  v8::HeapObjectStatistics object_stats;
+  for (size_t i = 0; i < isolate->NumberOfTrackedHeapObjectTypes(); i++) {
+    if (!isolate->GetHeapObjectStatisticsAtLastGC(&object_stats, i)) continue;
+    if (strlen(object_stats.object_sub_type()) == 0) {
+      instance_type_size += object_stats.object_size();
+    }
+  }
+  CHECK_EQ(instance_type_size, composition.total_size());
+  isolate->SetHeapObjectStatisticsEnabled(false);
+}
+
+
 static int nb_uncaught_exception_callback_calls = 0;
 
 
@@ -25027,3 +25452,135 @@ TEST(PrivateForApiIsNumber) {
   // Shouldn't crash.
   v8::Private::ForApi(isolate, v8_str("42"));
 }
+
+
+TEST(RuntimeCallCounterStatistics) {
+  i::FLAG_runtime_call_stats = true;
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  isolate->ResetRuntimeCallCounters();
+
+  CompileRun("var o = {}; Object.defineProperty(o, 'x', {value: 1});");
+
+  size_t count = isolate->NumberOfRuntimeCallCounters();
+  CHECK_LT(0u, count);
+  v8::RuntimeCallCounterStatistics statistics;
+  CHECK(!isolate->GetRuntimeCallCounterStatistics(&statistics, count));
+  CHECK(!isolate->GetRuntimeCallCounterStatistics(nullptr, 0));
+
+  int64_t parse_count = -1;
+  for (size_t i = 0; i < count; i++) {
+    CHECK(isolate->GetRuntimeCallCounterStatistics(&statistics, i));
+    CHECK_NOT_NULL(statistics.counter_name());
+    CHECK_LE(0, statistics.call_count());
+    if (strcmp(statistics.counter_name(), "ParseProgram") == 0) {
+      parse_count = statistics.call_count();
+    }
+  }
+  CHECK_LT(0, parse_count);
+
+  isolate->ResetRuntimeCallCounters();
+  for (size_t i = 0; i < count; i++) {
+    CHECK(isolate->GetRuntimeCallCounterStatistics(&statistics, i));
+    CHECK_EQ(0, statistics.call_count());
+    CHECK_EQ(0.0, statistics.time_in_ms());
+  }
+  i::FLAG_runtime_call_stats = false;
+}
+
+
+namespace {
+
+class TestBlockCoverageVisitor : public v8::BlockCoverageVisitor {
+ public:
+  explicit TestBlockCoverageVisitor(int script_id) : script_id_(script_id) {}
+
+  void VisitFunction(int script_id, int start_position, int end_position,
+                     uint32_t count) override {
+    if (script_id != script_id_) return;
+    CHECK_LE(start_position, end_position);
+    functions_[start_position] = std::make_pair(end_position, count);
+  }
+
+  void VisitBlock(int script_id, int position, uint32_t count) override {
+    if (script_id != script_id_) return;
+    blocks_[position] = count;
+  }
+
+  // Returns the count of the innermost function around |position|.
+  uint32_t FunctionCount(int position) const {
+    int start = -1;
+    uint32_t count = 0;
+    for (const auto& function : functions_) {
+      if (function.first <= position && position < function.second.first &&
+          function.first > start) {
+        start = function.first;
+        count = function.second.second;
+      }
+    }
+    CHECK_LE(0, start);
+    return count;
+  }
+
+  // Returns the count of the first block in [from, to).
+  uint32_t BlockCount(int from, int to) const {
+    auto it = blocks_.lower_bound(from);
+    CHECK(it != blocks_.end());
+    CHECK_LT(it->first, to);
+    return it->second;
+  }
+
+ private:
+  int script_id_;
+  std::map<int, std::pair<int, uint32_t> > functions_;
+  std::map<int, uint32_t> blocks_;
+};
+
+}  // namespace
+
+
+TEST(BlockCoverage) {
+  i::FLAG_block_coverage = true;
+  i::FLAG_ignition = true;
+  i::FLAG_ignition_lazy_feedback_allocation = false;
+  i::FLAG_flush_code = false;
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+
+  const char* source =
+      "function f(x) {\n"
+      "  if (x) {\n"
+      "    return 1;\n"
+      "  } else {\n"
+      "    return 2;\n"
+      "  }\n"
+      "}\n"
+      "function g() {}\n"
+      "f(true); f(true); f(false);\n";
+  std::string text(source);
+  int then_block = static_cast<int>(text.find("{\n    return 1"));
+  int then_position = static_cast<int>(text.find("return 1"));
+  int else_position = static_cast<int>(text.find("else"));
+  int end_of_f = static_cast<int>(text.find("function g"));
+  int g_position = static_cast<int>(text.find("{}"));
+
+  v8::Local<v8::Script> script = v8_compile(source);
+  script->Run(env.local()).ToLocalChecked();
+  int script_id = script->GetUnboundScript()->GetId();
+
+  TestBlockCoverageVisitor visitor(script_id);
+  isolate->VisitBlockCoverage(&visitor);
+  CHECK_EQ(3u, visitor.FunctionCount(then_position));
+  CHECK_EQ(0u, visitor.FunctionCount(g_position));
+  CHECK_EQ(2u, visitor.BlockCount(then_block, else_position));
+  CHECK_EQ(1u, visitor.BlockCount(else_position, end_of_f));
+
+  isolate->ResetBlockCoverage();
+  TestBlockCoverageVisitor reset_visitor(script_id);
+  isolate->VisitBlockCoverage(&reset_visitor);
+  CHECK_EQ(0u, reset_visitor.FunctionCount(then_position));
+  CHECK_EQ(0u, reset_visitor.BlockCount(then_block, else_position));
+  i::FLAG_block_coverage = false;
+}
@@ -58,3 +58,39 @@ TEST(List) {
   CHECK_EQ(0, list->length());
   delete list;
 }
+
+
+TEST(InternalizeAstStrings) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  HandleScope scope(isolate);
+  Zone zone(isolate->allocator());
+  AstValueFactory value_factory(&zone, isolate->heap()->HashSeed());
+
+  // A string the string table already holds, and many that it does not.
+  const AstRawString* length = value_factory.GetOneByteString("length");
+  const int kFreshStrings = 1000;
+  const AstRawString* fresh[kFreshStrings];
+  for (int i = 0; i < kFreshStrings; i++) {
+    EmbeddedVector<char, 32> buffer;
+    SNPrintF(buffer, "ast_value_factory_test_%d", i);
+    fresh[i] = value_factory.GetOneByteString(buffer.start());
+  }
+  const AstConsString* cons = value_factory.NewConsString(length, fresh[0]);
+
+  value_factory.Internalize(isolate);
+  CHECK(value_factory.IsInternalized());
+  CHECK(length->string().is_identical_to(
+      isolate->factory()->length_string()));
+  for (int i = 0; i < kFreshStrings; i++) {
+    EmbeddedVector<char, 32> buffer;
+    SNPrintF(buffer, "ast_value_factory_test_%d", i);
+    Handle<String> string = fresh[i]->string();
+    CHECK(string->IsInternalizedString());
+    CHECK(string->IsUtf8EqualTo(CStrVector(buffer.start())));
+    CHECK(string.is_identical_to(
+        isolate->factory()->InternalizeUtf8String(buffer.start())));
+  }
+  CHECK(cons->string()->IsUtf8EqualTo(
+      CStrVector("lengthast_value_factory_test_0")));
+}
@@ -544,6 +544,57 @@ TEST(OptimizedCodeSharing3) {
   }
 }
 
+// Test that a function optimized in a second native context gets
+// context-independent code that is shared with further native contexts.
+TEST(OptimizedCodeSharingAcrossNativeContexts) {
+  if (FLAG_stress_compaction) return;
+  FLAG_allow_natives_syntax = true;
+  FLAG_native_context_specialization = true;
+  FLAG_turbo_cache_shared_code = true;
+  FLAG_turbo_context_independent_code = true;
+  const char* flag = "--turbo-filter=*";
+  FlagList::SetFlagsFromString(flag, StrLength(flag));
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  v8::Local<v8::Script> script = v8_compile(
+      "function MakeClosure() {"
+      "  return function() { return x; };"
+      "}");
+  Handle<Code> reference_code;
+  for (int i = 0; i < 3; i++) {
+    LocalContext env;
+    env->Global()
+        ->Set(env.local(), v8_str("x"), v8::Integer::New(CcTest::isolate(), i))
+        .FromJust();
+    script->GetUnboundScript()
+        ->BindToCurrentContext()
+        ->Run(env.local())
+        .ToLocalChecked();
+    CHECK_EQ(i, CompileRun("var closure0 = MakeClosure();"
+                           "closure0();"
+                           "%OptimizeFunctionOnNextCall(closure0);"
+                           "closure0();")
+                    ->Int32Value(env.local())
+                    .FromJust());
+    Handle<JSFunction> fun0 = Handle<JSFunction>::cast(
+        v8::Utils::OpenHandle(*v8::Local<v8::Function>::Cast(
+            env->Global()
+                ->Get(env.local(), v8_str("closure0"))
+                .ToLocalChecked())));
+    CHECK(fun0->IsOptimized() || !CcTest::i_isolate()->use_crankshaft());
+    if (!fun0->IsOptimized()) continue;
+    if (i == 0) {
+      // The first native context gets specialized code.
+      CHECK(fun0->code()->is_turbofanned());
+    } else if (i == 1) {
+      reference_code = handle(fun0->code());
+    } else {
+      CHECK_EQ(*reference_code, fun0->code());
+    }
+  }
+}
+
+
 
 TEST(CompileFunctionInContext) {
   CcTest::InitializeVM();
@@ -701,6 +752,32 @@ TEST(CompileFunctionInContextScriptOrigin) {
 }
 
 
+TEST(RuntimeCallStatsCountCompilePhases) {
+  i::FLAG_runtime_call_stats = true;
+  i::FLAG_min_preparse_length = 0;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  LocalContext env;
+  RuntimeCallStats* stats =
+      CcTest::i_isolate()->counters()->runtime_call_stats();
+  stats->Reset();
+
+  CompileRun(
+      "function lazy() { return 1; }"
+      "lazy();");
+
+  CHECK_LT(0, stats->ParseProgram.count);
+  CHECK_LT(0, stats->CompileAnalyse.count);
+  CHECK_LT(0, stats->InternalizeAstValues.count);
+  CHECK_LT(0, stats->CompileIgnition.count + stats->CompileFullCode.count);
+  if (i::FLAG_lazy && !(i::FLAG_ignition && i::FLAG_ignition_eager)) {
+    CHECK_LT(0, stats->PreParse.count);
+    CHECK_LT(0, stats->ParseLazy.count);
+  }
+  i::FLAG_runtime_call_stats = false;
+}
+
+
 #ifdef ENABLE_DISASSEMBLER
 static Handle<JSFunction> GetJSFunction(v8::Local<v8::Object> obj,
                                         const char* property_name) {
@@ -572,6 +572,81 @@ TEST(CollectCpuProfile) {
   profile->Delete();
 }
 
+namespace {
+
+// Collects the profiles of a continuous profiling session. Intervals are
+// written from the profiler thread, so the stream is synchronized.
+class ContinuousProfileStream : public v8::OutputStream {
+ public:
+  void EndOfStream() override {
+    v8::base::LockGuard<v8::base::Mutex> guard(&mutex_);
+    profiles_.push_back(current_);
+    current_.clear();
+  }
+  WriteResult WriteAsciiChunk(char* data, int size) override {
+    v8::base::LockGuard<v8::base::Mutex> guard(&mutex_);
+    CHECK_GT(size, 0);
+    current_.append(data, size);
+    return kContinue;
+  }
+  size_t profiles_count() {
+    v8::base::LockGuard<v8::base::Mutex> guard(&mutex_);
+    return profiles_.size();
+  }
+  const std::vector<std::string>& profiles() { return profiles_; }
+
+ private:
+  v8::base::Mutex mutex_;
+  std::string current_;
+  std::vector<std::string> profiles_;
+};
+
+}  // namespace
+
+TEST(ContinuousProfiling) {
+  i::FLAG_allow_natives_syntax = true;
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::CpuProfiler* cpu_profiler = env->GetIsolate()->GetCpuProfiler();
+
+  CompileRun(cpu_profiler_test_source);
+  v8::Local<v8::Function> function = GetFunction(env.local(), "start");
+  v8::Local<v8::Value> args[] = {v8::Integer::New(env->GetIsolate(), 50)};
+
+  ContinuousProfileStream stream;
+  cpu_profiler->StartContinuousProfiling(&stream, 20);
+  i::Sampler* sampler =
+      reinterpret_cast<i::Isolate*>(env->GetIsolate())->logger()->sampler();
+  sampler->StartCountingSamples();
+  do {
+    function->Call(env.local(), env->Global(), arraysize(args), args)
+        .ToLocalChecked();
+  } while (sampler->js_sample_count() < 10 || stream.profiles_count() < 2);
+  cpu_profiler->StopContinuousProfiling();
+  CHECK(!reinterpret_cast<i::CpuProfiler*>(cpu_profiler)->is_profiling());
+
+  // Every interval is a separate JSON object. Look for the hot function in
+  // all of them, as the samples are spread across the intervals.
+  CHECK_GE(stream.profiles().size(), 3u);
+  bool found_loop = false;
+  for (const std::string& json : stream.profiles()) {
+    env->Global()
+        ->Set(env.local(), v8_str("json"), v8_str(json.c_str()))
+        .FromJust();
+    CHECK(CompileRun("var profile = JSON.parse(json);"
+                     "profile.startTime <= profile.endTime &&"
+                     "profile.nodes.length % 7 == 0 &&"
+                     "profile.nodes[1] == 0 &&"
+                     "profile.strings[profile.nodes[2]] == '(root)';")
+              ->BooleanValue(env.local())
+              .FromJust());
+    found_loop |= CompileRun("profile.strings.indexOf('loop') != -1;")
+                      ->BooleanValue(env.local())
+                      .FromJust();
+  }
+  CHECK(found_loop);
+}
+
 static const char* hot_deopt_no_frame_entry_test_source =
     "%NeverOptimizeFunction(foo);\n"
     "%NeverOptimizeFunction(start);\n"
@@ -2030,3 +2105,27 @@ TEST(DeoptUntrackedFunction) {
 
   iprofiler->DeleteProfile(iprofile);
 }
+
+TEST(CollectCpuProfileWithThreadTimer) {
+  i::FLAG_allow_natives_syntax = true;
+  i::FLAG_sampling_thread_timer = true;
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+
+  CompileRun(cpu_profiler_test_source);
+  v8::Local<v8::Function> function = GetFunction(env.local(), "start");
+
+  int32_t profiling_interval_ms = 200;
+  v8::Local<v8::Value> args[] = {
+      v8::Integer::New(env->GetIsolate(), profiling_interval_ms)};
+  // Where the timer is not supported, the profiler thread keeps sampling.
+  v8::CpuProfile* profile =
+      RunProfiler(env.local(), function, args, arraysize(args), 200, 0, true);
+  CHECK_LE(200, profile->GetSamplesCount());
+
+  i::Sampler* sampler =
+      reinterpret_cast<i::Isolate*>(env->GetIsolate())->logger()->sampler();
+  CHECK(!sampler->HasThreadTimer());
+  profile->Delete();
+  i::FLAG_sampling_thread_timer = false;
+}
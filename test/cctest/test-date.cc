@@ -56,6 +56,8 @@ class DateCacheMock: public DateCache {
     return local_offset_;
   }
 
+  virtual bool UsesOSTimezone() { return false; }
+
  private:
   Rule* FindRuleFor(int year, int month, int day, int time_in_day_sec) {
     Rule* result = NULL;
@@ -166,3 +168,22 @@ TEST(DaylightSavingsTime) {
   CheckDST(august_20 + 2 * 3600 - 1000);
   CheckDST(august_20);
 }
+
+
+TEST(TimezoneTransitions) {
+  LocalContext context;
+  v8::HandleScope scope(context->GetIsolate());
+  DateCache* date_cache = CcTest::i_isolate()->date_cache();
+  v8::base::TimezoneCache* tz_cache = v8::base::OS::CreateTimezoneCache();
+  // Check every six hours from the epoch to 2037, and around each of them.
+  int64_t end_of_2037 = TimeFromYearMonthDay(date_cache, 2038, 0, 1) - 1;
+  for (int64_t time = 0; time < end_of_2037; time += 6 * 3600 * 1000) {
+    CheckDST(time);
+    CheckDST(time + 1000);
+    CheckDST(time + 3600 * 1000 - 1000);
+    const char* name =
+        v8::base::OS::LocalTimezone(static_cast<double>(time), tz_cache);
+    CHECK_EQ(0, strcmp(name, date_cache->LocalTimezone(time)));
+  }
+  v8::base::OS::DisposeTimezoneCache(tz_cache);
+}
@@ -962,6 +962,43 @@ TEST(BreakPointICStore) {
 }
 
 
+// Test that setting a break point keeps the optimized code of unrelated
+// functions cached.
+TEST(BreakPointKeepsUnrelatedOptimizedCode) {
+  if (!i::FLAG_crankshaft || i::FLAG_ignition) return;
+  i::FLAG_allow_natives_syntax = true;
+  break_point_hit_count = 0;
+  DebugLocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+
+  v8::Debug::SetDebugEventListener(env->GetIsolate(),
+                                   DebugEventBreakPointHitCount);
+  v8::Local<v8::Function> foo =
+      CompileFunction(&env, "function foo(){bar=0;}", "foo");
+  CompileRun(
+      "function unrelated(x) { return x + 1; }"
+      "unrelated(1); unrelated(2);"
+      "%OptimizeFunctionOnNextCall(unrelated);"
+      "unrelated(3);");
+  Handle<v8::internal::JSFunction> unrelated =
+      v8::Utils::OpenHandle(*v8::Local<v8::Function>::Cast(
+          env->Global()->Get(env.context(), v8_str("unrelated"))
+              .ToLocalChecked()));
+  CHECK(unrelated->IsOptimized());
+  CHECK(!unrelated->shared()->OptimizedCodeMapIsCleared());
+
+  int bp = SetBreakPoint(foo, 0);
+  foo->Call(env.context(), env->Global(), 0, NULL).ToLocalChecked();
+  CHECK_EQ(1, break_point_hit_count);
+  CHECK(unrelated->IsOptimized());
+  CHECK(!unrelated->shared()->OptimizedCodeMapIsCleared());
+
+  ClearBreakPoint(bp);
+  v8::Debug::SetDebugEventListener(env->GetIsolate(), nullptr);
+  CheckDebuggerUnloaded(env->GetIsolate());
+}
+
+
 // Test that a break point can be set at an IC load location.
 TEST(BreakPointICLoad) {
   break_point_hit_count = 0;
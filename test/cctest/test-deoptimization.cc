@@ -932,3 +932,80 @@ UNINITIALIZED_TEST(DeoptimizeLoadICStoreICNested) {
   isolate->Exit();
   isolate->Dispose();
 }
+
+
+static int deoptimization_events = 0;
+static int deoptimization_loop_events = 0;
+
+
+static void DeoptimizationCallback(v8::DeoptimizationEvent event) {
+  deoptimization_events++;
+  if (event.IsDeoptLoop()) deoptimization_loop_events++;
+  CHECK_EQ(v8::kDeoptimizationLazy, event.GetType());
+  CHECK_EQ(deoptimization_events, event.GetDeoptCount());
+  CHECK_NOT_NULL(event.GetReason());
+  v8::String::Utf8Value name(event.GetFunction()->GetName());
+  CHECK_EQ(0, strcmp("f", *name));
+}
+
+
+TEST(DeoptimizationCallback) {
+  i::FLAG_deopt_loop_count = 3;
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  if (!CcTest::i_isolate()->use_crankshaft()) return;
+  env->GetIsolate()->SetDeoptimizationCallback(DeoptimizationCallback);
+
+  // Optimize and lazily deoptimize f over and over again.
+  {
+    AllowNativesSyntaxNoInlining options;
+    CompileRun(
+        "function g() { %DeoptimizeFunction(f); }"
+        "function f() { g(); };"
+        "f();"
+        "for (var i = 0; i < 4; i++) {"
+        "  %OptimizeFunctionOnNextCall(f);"
+        "  f();"
+        "}");
+  }
+  env->GetIsolate()->SetDeoptimizationCallback(NULL);
+
+  CHECK_EQ(4, deoptimization_events);
+  // The third and the fourth deoptimization are reported as a loop.
+  CHECK_EQ(2, deoptimization_loop_events);
+  i::FLAG_deopt_loop_count = 5;
+}
+
+
+TEST(DeoptimizationRuntimeCallStats) {
+  i::FLAG_runtime_call_stats = true;
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  i::RuntimeCallStats* stats =
+      CcTest::i_isolate()->counters()->runtime_call_stats();
+  stats->Reset();
+
+  // Lazily deoptimize f, whose object literal may have to be materialized.
+  {
+    AllowNativesSyntaxNoInlining options;
+    CompileRun(
+        "function g() { %DeoptimizeFunction(f); }"
+        "function f(x) { var o = { x: x }; g(); return o.x; };"
+        "f(1); f(2);"
+        "%OptimizeFunctionOnNextCall(f);"
+        "var result = f(3);");
+  }
+  NonIncrementalGC(CcTest::i_isolate());
+
+  CHECK_EQ(3, env->Global()
+                  ->Get(env.local(), v8_str("result"))
+                  .ToLocalChecked()
+                  ->Int32Value(env.local())
+                  .FromJust());
+  CHECK_EQ(stats->DeoptimizeCode.count,
+           stats->DeoptimizeMaterialization.count);
+  if (CcTest::i_isolate()->use_crankshaft()) {
+    CHECK_LT(0, stats->DeoptimizeCode.count);
+  }
+  i::FLAG_runtime_call_stats = false;
+}
@@ -242,4 +242,45 @@ TEST(SetRequiresCopyOnCapacityChange) {
   CHECK_NE(*dict, *new_dict);
 }
 
+TEST(NameDictionaryEnumCache) {
+  LocalContext context;
+  v8::HandleScope scope(context->GetIsolate());
+  Isolate* isolate = CcTest::i_isolate();
+  Handle<JSObject> object = Handle<JSObject>::cast(v8::Utils::OpenHandle(
+      *CompileRun("var o = {a: 1, b: 2, c: 3}; delete o.b; o")));
+  CHECK(!object->HasFastProperties());
+  Handle<NameDictionary> dict(object->property_dictionary(), isolate);
+  CHECK(dict->enum_cache()->IsUndefined());
+
+  Handle<FixedArray> keys = JSObject::GetEnumPropertyKeys(object);
+  CHECK_EQ(2, keys->length());
+  CHECK(dict->enum_cache()->IsFixedArray());
+  CHECK_NE(*keys, dict->enum_cache());
+
+  // Hits hand out copies of the cached keys.
+  Handle<FixedArray> cached_keys = JSObject::GetEnumPropertyKeys(object);
+  CHECK_NE(*keys, *cached_keys);
+  CHECK_EQ(2, cached_keys->length());
+  CHECK_EQ(keys->get(0), cached_keys->get(0));
+  CHECK_EQ(keys->get(1), cached_keys->get(1));
+
+  // Adding a property drops the cache.
+  CompileRun("o.d = 4");
+  dict = handle(object->property_dictionary(), isolate);
+  CHECK(dict->enum_cache()->IsUndefined());
+  CHECK_EQ(3, JSObject::GetEnumPropertyKeys(object)->length());
+
+  // So does changing the attributes of one.
+  CompileRun("Object.defineProperty(o, 'a', {enumerable: false})");
+  dict = handle(object->property_dictionary(), isolate);
+  CHECK(dict->enum_cache()->IsUndefined());
+  CHECK_EQ(2, JSObject::GetEnumPropertyKeys(object)->length());
+
+  // And deleting one.
+  CompileRun("delete o.c");
+  dict = handle(object->property_dictionary(), isolate);
+  CHECK(dict->enum_cache()->IsUndefined());
+  CHECK_EQ(1, JSObject::GetEnumPropertyKeys(object)->length());
+}
+
 }  // namespace
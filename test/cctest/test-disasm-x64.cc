@@ -455,10 +455,17 @@ TEST(DisasmX64) {
     __ psllq(xmm0, 6);
     __ psrlq(xmm0, 6);
 
+    __ pcmpeqb(xmm1, xmm0);
+    __ pcmpeqw(xmm9, xmm14);
     __ pcmpeqd(xmm1, xmm0);
+    __ pmovmskb(r11, xmm7);
 
     __ punpckldq(xmm1, xmm11);
     __ punpckhdq(xmm8, xmm15);
+
+    __ paddd(xmm1, xmm11);
+    __ psubd(xmm8, xmm15);
+    __ pshufd(xmm0, xmm9, 0x1b);
   }
 
   // cmov.
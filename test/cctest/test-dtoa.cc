@@ -284,6 +284,49 @@ TEST(DtoaGayShortest) {
 }
 
 
+TEST(DtoaSafeIntegers) {
+  char buffer_container[kBufferSize];
+  Vector<char> buffer(buffer_container, kBufferSize);
+  char expected_container[kBufferSize];
+  Vector<char> expected(expected_container, kBufferSize);
+  int sign;
+  int length;
+  int point;
+
+  const double kTwoPow53 = 9007199254740992.0;
+  double values[] = {1.0,
+                     9.0,
+                     10.0,
+                     99.0,
+                     100.0,
+                     101.0,
+                     1000000.0,
+                     4294967295.0,
+                     4294967296.0,
+                     1e15,
+                     123456789012345.0,
+                     kTwoPow53 / 2 + 1,
+                     kTwoPow53 - 2,
+                     kTwoPow53 - 1};
+  for (size_t i = 0; i < arraysize(values); ++i) {
+    for (int negative = 0; negative < 2; ++negative) {
+      double v = negative ? -values[i] : values[i];
+      DoubleToAscii(v, DTOA_SHORTEST, 0, buffer, &sign, &length, &point);
+      SNPrintF(expected, "%.0f", values[i]);
+      CHECK_EQ(negative, sign);
+      CHECK_EQ(StrLength(expected.start()), point);
+      TrimRepresentation(expected);
+      CHECK_EQ(StrLength(expected.start()), length);
+      CHECK_EQ(0, strcmp(expected.start(), buffer.start()));
+    }
+  }
+  // 2^53 itself is past the integer fast path.
+  DoubleToAscii(kTwoPow53, DTOA_SHORTEST, 0, buffer, &sign, &length, &point);
+  CHECK_EQ(0, strcmp("9007199254740992", buffer.start()));
+  CHECK_EQ(16, point);
+}
+
+
 TEST(DtoaGayFixed) {
   char buffer_container[kBufferSize];
   Vector<char> buffer(buffer_container, kBufferSize);
@@ -289,6 +289,41 @@ TEST(VectorLoadICStates) {
 }
 
 
+TEST(VectorLoadICMaxPolymorphism) {
+  if (i::FLAG_always_opt) return;
+  int saved_max_polymorphic_map_count = i::FLAG_max_polymorphic_map_count;
+  i::FLAG_max_polymorphic_map_count = 6;
+  CcTest::InitializeVM();
+  LocalContext context;
+  v8::HandleScope scope(context->GetIsolate());
+  Isolate* isolate = CcTest::i_isolate();
+
+  CompileRun(
+      "function f(a) { return a.foo; }"
+      "f({ foo: 1 });"
+      "f({ foo: 1 });"
+      "f({ a: 1, foo: 1 });"
+      "f({ b: 1, foo: 1 });"
+      "f({ c: 1, foo: 1 });"
+      "f({ d: 1, foo: 1 });"
+      "f({ e: 1, foo: 1 });");
+  Handle<JSFunction> f = GetFunction("f");
+  Handle<TypeFeedbackVector> feedback_vector =
+      Handle<TypeFeedbackVector>(f->shared()->feedback_vector(), isolate);
+  LoadICNexus nexus(feedback_vector, FeedbackVectorSlot(0));
+
+  // Six maps fit into the polymorphic IC...
+  CHECK_EQ(POLYMORPHIC, nexus.StateFromFeedback());
+  MapHandleList maps;
+  nexus.FindAllMaps(&maps);
+  CHECK_EQ(6, maps.length());
+
+  // ... and the seventh drives it megamorphic.
+  CompileRun("f({ g: 1, foo: 1 })");
+  CHECK_EQ(MEGAMORPHIC, nexus.StateFromFeedback());
+  i::FLAG_max_polymorphic_map_count = saved_max_polymorphic_map_count;
+}
+
 TEST(VectorLoadICSlotSharing) {
   if (i::FLAG_always_opt) return;
   CcTest::InitializeVM();
@@ -512,4 +547,76 @@ TEST(VectorStoreICBasic) {
   CHECK_EQ(MONOMORPHIC, nexus.StateFromFeedback());
 }
 
+
+TEST(VectorLazyAllocation) {
+  if (i::FLAG_always_opt) return;
+  i::FLAG_ignition = true;
+  i::FLAG_ignition_lazy_feedback_allocation = true;
+
+  CcTest::InitializeVM();
+  LocalContext context;
+  v8::HandleScope scope(context->GetIsolate());
+  Isolate* isolate = CcTest::i_isolate();
+
+  CompileRun(
+      "function f(a) {"
+      "  return a.foo;"
+      "}"
+      "var a = { foo: 3 };"
+      "f(a);");
+  Handle<JSFunction> f = GetFunction("f");
+  CHECK(f->shared()->HasBytecodeArray());
+
+  // The function is not warm yet, only the metadata is kept.
+  Handle<TypeFeedbackVector> lazy_vector(f->shared()->feedback_vector());
+  CHECK(lazy_vector->is_lazy());
+  CHECK(lazy_vector->is_empty());
+  CHECK_EQ(0, lazy_vector->slot_count());
+  CHECK_EQ(1, lazy_vector->metadata()->slot_count());
+
+  // The IC runs against the dummy vector in the meantime.
+  CHECK_EQ(3, CompileRun("f(a)")->Int32Value(context.local()).FromJust());
+  CHECK(f->shared()->feedback_vector()->is_lazy());
+
+  SharedFunctionInfo::EnsureFeedbackVector(handle(f->shared(), isolate));
+  Handle<TypeFeedbackVector> vector(f->shared()->feedback_vector());
+  CHECK(!vector->is_lazy());
+  CHECK_EQ(lazy_vector->metadata(), vector->metadata());
+  FeedbackVectorHelper helper(vector);
+  CHECK_EQ(1, helper.slot_count());
+
+  LoadICNexus nexus(vector, helper.slot(0));
+  CHECK_EQ(UNINITIALIZED, nexus.StateFromFeedback());
+  CompileRun("f(a); f(a);");
+  CHECK_EQ(MONOMORPHIC, nexus.StateFromFeedback());
+}
+
+
+TEST(VectorICChangeResetsProfilerTicks) {
+  if (i::FLAG_always_opt) return;
+  i::FLAG_ignition = true;
+
+  CcTest::InitializeVM();
+  LocalContext context;
+  v8::HandleScope scope(context->GetIsolate());
+
+  CompileRun(
+      "function f(a) {"
+      "  return a.foo;"
+      "}"
+      "var a = { foo: 3 };"
+      "f(a); f(a);");
+  Handle<JSFunction> f = GetFunction("f");
+  CHECK(f->shared()->HasBytecodeArray());
+
+  // Feedback that does not change keeps the ticks of interpreted functions.
+  f->shared()->set_profiler_ticks(5);
+  CompileRun("f(a)");
+  CHECK_EQ(5, f->shared()->profiler_ticks());
+
+  // Going polymorphic restarts the count.
+  CompileRun("f({ bar: 1, foo: 2 })");
+  CHECK_EQ(0, f->shared()->profiler_ticks());
+}
+
 }  // namespace
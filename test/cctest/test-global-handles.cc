@@ -450,3 +450,36 @@ TEST(FinalizerWeakness) {
   CHECK_EQ(identity, o->GetIdentityHash());
   CHECK(o->Has(isolate->GetCurrentContext(), v8_str("finalizer")).FromJust());
 }
+
+static int nested_gc_finalizer_calls = 0;
+
+void NestedGCFinalizer(
+    const v8::WeakCallbackInfo<v8::Global<v8::Object>>& data) {
+  data.GetParameter()->Reset();
+  if (++nested_gc_finalizer_calls == 1) {
+    CcTest::i_isolate()->heap()->CollectAllGarbage();
+  }
+}
+
+TEST(FinalizerWithNestedGC) {
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+
+  v8::Global<v8::Object> g1;
+  v8::Global<v8::Object> g2;
+  {
+    v8::HandleScope scope(isolate);
+    g1.Reset(isolate, v8::Object::New(isolate));
+    g1.SetWeak(&g1, NestedGCFinalizer, v8::WeakCallbackType::kFinalizer);
+    g2.Reset(isolate, v8::Object::New(isolate));
+    g2.SetWeak(&g2, NestedGCFinalizer, v8::WeakCallbackType::kFinalizer);
+  }
+
+  // The collection started by the first callback interrupts the processing
+  // of the outer one, and has to run the callback of the other handle.
+  nested_gc_finalizer_calls = 0;
+  CcTest::i_isolate()->heap()->CollectAllGarbage();
+  CHECK_EQ(2, nested_gc_finalizer_calls);
+  CHECK(g1.IsEmpty());
+  CHECK(g2.IsEmpty());
+}
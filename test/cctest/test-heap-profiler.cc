@@ -145,8 +145,8 @@ static bool ValidateSnapshot(const v8::HeapSnapshot* snapshot, int depth = 3) {
       reinterpret_cast<const i::HeapSnapshot*>(snapshot));
 
   i::HashMap visited(AddressesMatch);
-  i::List<i::HeapGraphEdge>& edges = heap_snapshot->edges();
-  for (int i = 0; i < edges.length(); ++i) {
+  std::deque<i::HeapGraphEdge>& edges = heap_snapshot->edges();
+  for (size_t i = 0; i < edges.size(); ++i) {
     i::HashMap::Entry* entry = visited.LookupOrInsert(
         reinterpret_cast<void*>(edges[i].to()),
         static_cast<uint32_t>(reinterpret_cast<uintptr_t>(edges[i].to())));
@@ -1020,6 +1020,39 @@ TEST(HeapSnapshotJSONSerialization) {
 }
 
 
+TEST(WriteHeapSnapshot) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+  CompileRun("function A() {}\nvar a = new A();");
+
+  TestJSONStream stream;
+  CHECK(heap_profiler->WriteHeapSnapshot(&stream));
+  CHECK_EQ(0, heap_profiler->GetSnapshotCount());
+  CHECK_GT(stream.size(), 0);
+  CHECK_EQ(1, stream.eos_signaled());
+  i::ScopedVector<char> json(stream.size());
+  stream.WriteTo(json);
+
+  OneByteResource* json_res = new OneByteResource(json);
+  v8::Local<v8::String> json_string =
+      v8::String::NewExternalOneByte(env->GetIsolate(), json_res)
+          .ToLocalChecked();
+  env->Global()
+      ->Set(env.local(), v8_str("json_snapshot"), json_string)
+      .FromJust();
+  v8::Local<v8::Value> result = CompileRun(
+      "var parsed = JSON.parse(json_snapshot);"
+      "var meta = parsed.snapshot.meta;"
+      "parsed.strings.indexOf('A') != -1 &&"
+      "parsed.nodes.length =="
+      "    parsed.snapshot.node_count * meta.node_fields.length &&"
+      "parsed.edges.length =="
+      "    parsed.snapshot.edge_count * meta.edge_fields.length;");
+  CHECK(result->BooleanValue(env.local()).FromJust());
+}
+
+
 TEST(HeapSnapshotJSONSerializationAborting) {
   LocalContext env;
   v8::HandleScope scope(env->GetIsolate());
@@ -3056,3 +3089,143 @@ TEST(SamplingHeapProfilerLeftTrimming) {
 
   heap_profiler->StopSamplingHeapProfiler();
 }
+
+TEST(SamplingHeapProfilerSurvivors) {
+  v8::HandleScope scope(v8::Isolate::GetCurrent());
+  LocalContext env;
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+
+  // Turn off always_opt. Inlining can cause stack traces to be shorter than
+  // what we expect in this test.
+  v8::internal::FLAG_always_opt = false;
+
+  // Suppress randomness to avoid flakiness in tests.
+  v8::internal::FLAG_sampling_heap_profiler_suppress_randomness = true;
+
+  heap_profiler->StartSamplingHeapProfiler(1024);
+  CompileRun(
+      "var A = [];\n"
+      "function bar(size) { return new Array(size); }\n"
+      "var foo = function() {\n"
+      "  for (var i = 0; i < 1024; ++i) {\n"
+      "    A[i] = bar(1024);\n"
+      "  }\n"
+      "}\n"
+      "foo();");
+
+  for (int i = 0; i < v8::AllocationProfile::kMaxSurvivedGCs; i++) {
+    CcTest::heap()->CollectAllGarbage();
+  }
+
+  v8::base::SmartPointer<v8::AllocationProfile> profile(
+      heap_profiler->GetAllocationProfile());
+  CHECK(!profile.is_empty());
+  const char* names[] = {"", "foo", "bar"};
+  auto node_bar = FindAllocationProfileNode(*profile, ArrayVector(names));
+  CHECK(node_bar);
+  CHECK_EQ(static_cast<size_t>(v8::AllocationProfile::kMaxSurvivedGCs),
+           node_bar->survivors.size());
+
+  // All the arrays are retained by A, so they survived every collection.
+  CHECK_GT(node_bar->survivors[0], 0u);
+  for (unsigned int survivors : node_bar->survivors) {
+    CHECK_EQ(node_bar->survivors[0], survivors);
+  }
+
+  heap_profiler->StopSamplingHeapProfiler();
+}
+
+TEST(SamplingHeapProfilerIncludeObjectsCollectedByGC) {
+  v8::HandleScope scope(v8::Isolate::GetCurrent());
+  LocalContext env;
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+
+  // Turn off always_opt. Inlining can cause stack traces to be shorter than
+  // what we expect in this test.
+  v8::internal::FLAG_always_opt = false;
+
+  // Suppress randomness to avoid flakiness in tests.
+  v8::internal::FLAG_sampling_heap_profiler_suppress_randomness = true;
+
+  heap_profiler->StartSamplingHeapProfiler(
+      1024, 16, v8::HeapProfiler::kSamplingIncludeObjectsCollectedByGC);
+  CompileRun(
+      "function bar(size) { return new Array(size); }\n"
+      "var foo = function() {\n"
+      "  for (var i = 0; i < 1024; ++i) {\n"
+      "    bar(1024);\n"
+      "  }\n"
+      "}\n"
+      "foo();");
+
+  CcTest::heap()->CollectAllGarbage();
+
+  // The arrays are garbage, but their allocations are still in the profile.
+  v8::base::SmartPointer<v8::AllocationProfile> profile(
+      heap_profiler->GetAllocationProfile());
+  CHECK(!profile.is_empty());
+  const char* names[] = {"", "foo", "bar"};
+  auto node_bar = FindAllocationProfileNode(*profile, ArrayVector(names));
+  CHECK(node_bar);
+  unsigned int count = 0;
+  for (auto allocation : node_bar->allocations) count += allocation.count;
+  CHECK_GT(count, 0u);
+  CHECK_EQ(0u, node_bar->survivors[0]);
+
+  heap_profiler->StopSamplingHeapProfiler();
+}
+
+TEST(SamplingHeapProfilerTimeline) {
+  v8::HandleScope scope(v8::Isolate::GetCurrent());
+  LocalContext env;
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+
+  // Turn off always_opt. Inlining can cause stack traces to be shorter than
+  // what we expect in this test.
+  v8::internal::FLAG_always_opt = false;
+
+  // Suppress randomness to avoid flakiness in tests.
+  v8::internal::FLAG_sampling_heap_profiler_suppress_randomness = true;
+
+  // Without the flag there is no timeline.
+  {
+    heap_profiler->StartSamplingHeapProfiler(1024);
+    CompileRun("var a = []; for (var i = 0; i < 1024; ++i) a[i] = [i];");
+    v8::base::SmartPointer<v8::AllocationProfile> profile(
+        heap_profiler->GetAllocationProfile());
+    CHECK(!profile.is_empty());
+    CHECK(profile->GetTimeline().empty());
+    heap_profiler->StopSamplingHeapProfiler();
+  }
+
+  heap_profiler->StartSamplingHeapProfiler(
+      1024, 16, v8::HeapProfiler::kSamplingRecordTimeline);
+  CompileRun(
+      "function bar(size) { return new Array(size); }\n"
+      "var foo = function() {\n"
+      "  for (var i = 0; i < 1024; ++i) {\n"
+      "    bar(1024);\n"
+      "  }\n"
+      "}\n"
+      "foo();");
+
+  v8::base::SmartPointer<v8::AllocationProfile> profile(
+      heap_profiler->GetAllocationProfile());
+  CHECK(!profile.is_empty());
+  const std::vector<v8::AllocationProfile::TimelineEntry>& timeline =
+      profile->GetTimeline();
+  CHECK(!timeline.empty());
+  size_t bar_size = 0;
+  double start_time = 0;
+  for (const v8::AllocationProfile::TimelineEntry& entry : timeline) {
+    CHECK_LE(start_time, entry.start_time);
+    start_time = entry.start_time;
+    CHECK_NOT_NULL(entry.space_name);
+    v8::String::Utf8Value name(entry.name);
+    if (strcmp(*name, "bar") == 0) bar_size += entry.size;
+  }
+  // The arrays allocated by bar take several megabytes.
+  CHECK_LT(1024u * 1024u, bar_size);
+
+  heap_profiler->StopSamplingHeapProfiler();
+}
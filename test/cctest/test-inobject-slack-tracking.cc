@@ -187,6 +187,50 @@ TEST(JSObjectBasicNoInlineNew) {
 }
 
 
+TEST(SlackTrackingFeedback) {
+  // Avoid eventual completion of in-object slack tracking.
+  FLAG_inline_construct = false;
+  FLAG_always_opt = false;
+  bool old_flag = FLAG_slack_tracking_feedback;
+  FLAG_slack_tracking_feedback = true;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  const char* source =
+      "function make() {"
+      "  return function A() {"
+      "    this.a = 1;"
+      "    this.b = 2;"
+      "    this.c = 3;"
+      "  };"
+      "}"
+      "var A1 = make();"
+      "var A2 = make();";
+  CompileRun(source);
+
+  Handle<JSFunction> func1 = GetGlobal<JSFunction>("A1");
+  Handle<JSFunction> func2 = GetGlobal<JSFunction>("A2");
+  CHECK_EQ(func1->shared(), func2->shared());
+  // The parser estimate leaves generous slack.
+  CHECK_LT(3, func1->shared()->expected_nof_properties());
+
+  v8::Local<v8::Script> new_A1_script = v8_compile("new A1();");
+  Handle<JSObject> obj = Run<JSObject>(new_A1_script);
+  Handle<Map> initial_map(func1->initial_map());
+  for (int i = 1; i < Map::kGenerousAllocationCount; i++) {
+    Run<JSObject>(new_A1_script);
+  }
+  CHECK(!initial_map->IsInobjectSlackTrackingInProgress());
+  CHECK_EQ(3, obj->map()->GetInObjectProperties());
+
+  // The observed field count sizes the instances of other closures.
+  CHECK_EQ(3, func1->shared()->expected_nof_properties());
+  Handle<JSObject> obj2 = CompileRun<JSObject>("new A2();");
+  CHECK_EQ(3, obj2->map()->GetInObjectProperties());
+
+  FLAG_slack_tracking_feedback = old_flag;
+}
+
+
 TEST(JSObjectComplex) {
   // Avoid eventual completion of in-object slack tracking.
   FLAG_inline_construct = false;
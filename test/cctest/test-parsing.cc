@@ -306,6 +306,99 @@ TEST(PreparseFunctionDataIsUsed) {
 }
 
 
+TEST(PreparseInnerFunctionDataIsUsed) {
+  // Producing cached parser data while parsing eagerly is not supported.
+  if (!i::FLAG_lazy || (i::FLAG_ignition && i::FLAG_ignition_eager)) return;
+
+  // This tests that the lazy compilation of a function uses the data the
+  // preparser generated for its inner functions.
+  i::FLAG_min_preparse_length = 0;
+  i::FLAG_parser_cache_inner_functions = true;
+
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope handles(isolate);
+  v8::Local<v8::Context> context = v8::Context::New(isolate);
+  v8::Context::Scope context_scope(context);
+  CcTest::i_isolate()->stack_guard()->SetStackLimit(
+      i::GetCurrentStackPosition() - 128 * 1024);
+
+  const char* good_code =
+      "function outer(a) {"
+      "  var x = 20;"
+      "  function inner() { return x + a; }"
+      "  function this_is_lazy() { var a; }"
+      "  return inner();"
+      "}"
+      "outer(5);";
+
+  // Insert a syntax error inside the inner lazy function.
+  const char* bad_code =
+      "function outer(a) {"
+      "  var x = 20;"
+      "  function inner() { return x + a; }"
+      "  function this_is_lazy() { if (   }"
+      "  return inner();"
+      "}"
+      "outer(5);";
+
+  v8::ScriptCompiler::Source good_source(v8_str(good_code));
+  v8::ScriptCompiler::Compile(isolate->GetCurrentContext(), &good_source,
+                              v8::ScriptCompiler::kProduceParserCache)
+      .ToLocalChecked();
+
+  const v8::ScriptCompiler::CachedData* cached_data =
+      good_source.GetCachedData();
+  CHECK(cached_data->data != NULL);
+
+  // The data holds entries for outer, inner and this_is_lazy.
+  i::ScriptData script_data(cached_data->data, cached_data->length);
+  i::ParseData* parse_data = i::ParseData::FromCachedData(&script_data);
+  CHECK(parse_data != NULL);
+  CHECK_EQ(3, parse_data->FunctionCount());
+  delete parse_data;
+
+  // If the data is used when outer is compiled lazily, this_is_lazy is
+  // skipped and the call succeeds. The variables inner references are
+  // allocated in outer's context.
+  v8::ScriptCompiler::Source bad_source(
+      v8_str(bad_code), new v8::ScriptCompiler::CachedData(
+                            cached_data->data, cached_data->length));
+  v8::Local<v8::Value> result =
+      CompileRun(isolate->GetCurrentContext(), &bad_source,
+                 v8::ScriptCompiler::kConsumeParserCache);
+  CHECK(result->IsInt32());
+  CHECK_EQ(25, result->Int32Value(isolate->GetCurrentContext()).FromJust());
+}
+
+
+TEST(PreParserScopesDeclareNoVariables) {
+  i::Isolate* isolate = CcTest::i_isolate();
+  i::HandleScope handles(isolate);
+  i::Zone zone(isolate->allocator());
+  i::AstValueFactory avf(&zone, isolate->heap()->HashSeed());
+
+  i::Scope* script_scope =
+      i::Scope::NewForPreParsing(&zone, NULL, i::SCRIPT_SCOPE, &avf,
+                                 i::kNormalFunction);
+  script_scope->SetLanguageMode(i::STRICT);
+  i::Scope* function_scope =
+      i::Scope::NewForPreParsing(&zone, script_scope, i::FUNCTION_SCOPE, &avf,
+                                 i::kNormalFunction);
+
+  // The flags needed for the preparse data are tracked as usual...
+  CHECK(is_strict(function_scope->language_mode()));
+  CHECK_EQ(function_scope, function_scope->ReceiverScope());
+  function_scope->RecordEvalCall();
+  CHECK(function_scope->calls_eval());
+
+  // ... but neither the receiver nor 'arguments' are declared, and the
+  // scope is not linked into its outer scope.
+  CHECK(function_scope->LookupLocal(avf.arguments_string()) == NULL);
+  CHECK(function_scope->LookupLocal(avf.this_string()) == NULL);
+  CHECK_EQ(0, script_scope->inner_scopes()->length());
+}
+
+
 TEST(StandAlonePreParser) {
   v8::V8::Initialize();
 
@@ -582,6 +675,12 @@ void TestCharacterStream(const char* one_byte_source, unsigned length,
       i::Handle<i::ExternalTwoByteString>::cast(uc16_string), start, end);
   i::GenericStringUtf16CharacterStream string_stream(one_byte_string, start,
                                                      end);
+  i::Handle<i::String> latin1_string(
+      factory->NewExternalStringFromOneByte(
+                 new ScriptResource(one_byte_source, length))
+          .ToHandleChecked());
+  i::ExternalOneByteStringUtf16CharacterStream latin1_stream(
+      i::Handle<i::ExternalOneByteString>::cast(latin1_string), start, end);
   i::Utf8ToUtf16CharacterStream utf8_stream(
       reinterpret_cast<const i::byte*>(one_byte_source), end);
   utf8_stream.SeekForward(start);
@@ -592,17 +691,21 @@ void TestCharacterStream(const char* one_byte_source, unsigned length,
     CHECK_EQU(i, uc16_stream.pos());
     CHECK_EQU(i, string_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
+    CHECK_EQU(i, latin1_stream.pos());
     int32_t c0 = one_byte_source[i];
     int32_t c1 = uc16_stream.Advance();
     int32_t c2 = string_stream.Advance();
     int32_t c3 = utf8_stream.Advance();
+    int32_t c4 = latin1_stream.Advance();
     i++;
     CHECK_EQ(c0, c1);
     CHECK_EQ(c0, c2);
     CHECK_EQ(c0, c3);
+    CHECK_EQ(c0, c4);
     CHECK_EQU(i, uc16_stream.pos());
     CHECK_EQU(i, string_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
+    CHECK_EQU(i, latin1_stream.pos());
   }
   while (i > start + sub_length / 4) {
     // Pushback, re-read, pushback again.
@@ -610,64 +713,80 @@ void TestCharacterStream(const char* one_byte_source, unsigned length,
     CHECK_EQU(i, uc16_stream.pos());
     CHECK_EQU(i, string_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
+    CHECK_EQU(i, latin1_stream.pos());
     uc16_stream.PushBack(c0);
     string_stream.PushBack(c0);
     utf8_stream.PushBack(c0);
+    latin1_stream.PushBack(c0);
     i--;
     CHECK_EQU(i, uc16_stream.pos());
     CHECK_EQU(i, string_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
+    CHECK_EQU(i, latin1_stream.pos());
     int32_t c1 = uc16_stream.Advance();
     int32_t c2 = string_stream.Advance();
     int32_t c3 = utf8_stream.Advance();
+    int32_t c4 = latin1_stream.Advance();
     i++;
     CHECK_EQU(i, uc16_stream.pos());
     CHECK_EQU(i, string_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
+    CHECK_EQU(i, latin1_stream.pos());
     CHECK_EQ(c0, c1);
     CHECK_EQ(c0, c2);
     CHECK_EQ(c0, c3);
+    CHECK_EQ(c0, c4);
     uc16_stream.PushBack(c0);
     string_stream.PushBack(c0);
     utf8_stream.PushBack(c0);
+    latin1_stream.PushBack(c0);
     i--;
     CHECK_EQU(i, uc16_stream.pos());
     CHECK_EQU(i, string_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
+    CHECK_EQU(i, latin1_stream.pos());
   }
   unsigned halfway = start + sub_length / 2;
   uc16_stream.SeekForward(halfway - i);
   string_stream.SeekForward(halfway - i);
   utf8_stream.SeekForward(halfway - i);
+  latin1_stream.SeekForward(halfway - i);
   i = halfway;
   CHECK_EQU(i, uc16_stream.pos());
   CHECK_EQU(i, string_stream.pos());
   CHECK_EQU(i, utf8_stream.pos());
+  CHECK_EQU(i, latin1_stream.pos());
 
   while (i < end) {
     // Read streams one char at a time
     CHECK_EQU(i, uc16_stream.pos());
     CHECK_EQU(i, string_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
+    CHECK_EQU(i, latin1_stream.pos());
     int32_t c0 = one_byte_source[i];
     int32_t c1 = uc16_stream.Advance();
     int32_t c2 = string_stream.Advance();
     int32_t c3 = utf8_stream.Advance();
+    int32_t c4 = latin1_stream.Advance();
     i++;
     CHECK_EQ(c0, c1);
     CHECK_EQ(c0, c2);
     CHECK_EQ(c0, c3);
+    CHECK_EQ(c0, c4);
     CHECK_EQU(i, uc16_stream.pos());
     CHECK_EQU(i, string_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
+    CHECK_EQU(i, latin1_stream.pos());
   }
 
   int32_t c1 = uc16_stream.Advance();
   int32_t c2 = string_stream.Advance();
   int32_t c3 = utf8_stream.Advance();
+  int32_t c4 = latin1_stream.Advance();
   CHECK_LT(c1, 0);
   CHECK_LT(c2, 0);
   CHECK_LT(c3, 0);
+  CHECK_LT(c4, 0);
 }
 
 
@@ -747,6 +866,42 @@ TEST(Utf8CharacterStream) {
   }
 }
 
+
+TEST(Utf8CharacterStreamAsciiRuns) {
+  // ASCII runs of every length up to 40, each followed by a two-byte, a
+  // three-byte or a four-byte character, so that runs start and end at all
+  // word alignments and straddle the stream's buffer boundaries.
+  static const char* kMultiByte[] = {"\xc3\xa9", "\xec\x92\x81",
+                                     "\xf0\x9f\x98\x80"};
+  static const uint16_t kMultiByteUtf16[][2] = {
+      {0xe9, 0}, {0xc481, 0}, {0xd83d, 0xde00}};
+  std::string utf8;
+  std::vector<uint16_t> utf16;
+  for (int repeat = 0; repeat < 8; repeat++) {
+    for (int run = 0; run <= 40; run++) {
+      for (int i = 0; i < run; i++) {
+        char c = static_cast<char>('a' + (i + run) % 26);
+        utf8 += c;
+        utf16.push_back(c);
+      }
+      int kind = (run + repeat) % 3;
+      utf8 += kMultiByte[kind];
+      utf16.push_back(kMultiByteUtf16[kind][0]);
+      if (kMultiByteUtf16[kind][1] != 0) {
+        utf16.push_back(kMultiByteUtf16[kind][1]);
+      }
+    }
+  }
+
+  i::Utf8ToUtf16CharacterStream stream(
+      reinterpret_cast<const i::byte*>(utf8.data()), utf8.length());
+  for (size_t i = 0; i < utf16.size(); i++) {
+    CHECK_EQU(i, stream.pos());
+    CHECK_EQ(static_cast<int32_t>(utf16[i]), stream.Advance());
+  }
+  CHECK_EQ(-1, stream.Advance());
+}
+
 #undef CHECK_EQU
 
 void TestStreamScanner(i::Utf16CharacterStream* stream,
@@ -860,6 +1015,40 @@ void TestScanRegExp(const char* re_source, const char* expected) {
 }
 
 
+TEST(ScanLongCommentsAndStrings) {
+  v8::V8::Initialize();
+
+  // Comments, strings and runs of spaces long enough to span several
+  // buffer refills of the character streams.
+  std::string body;
+  for (int i = 0; i < 300; i++) body += "ab*c/d-e";
+  std::string spaces(1500, ' ');
+  std::string source = "/*" + body + "*\n*/" + spaces + "'" + body +
+                       "' //" + body + "\n\"" + body + "\\\"\"" + spaces +
+                       "x";
+  std::string expected_string = body + "\"";
+
+  i::Utf8ToUtf16CharacterStream stream(
+      reinterpret_cast<const i::byte*>(source.c_str()),
+      static_cast<unsigned>(source.length()));
+  i::Scanner scanner(CcTest::i_isolate()->unicode_cache());
+  scanner.Initialize(&stream);
+
+  CHECK(scanner.HasAnyLineTerminatorBeforeNext());
+  CHECK_EQ(i::Token::STRING, scanner.Next());
+  CHECK(scanner.UnescapedLiteralMatches(body.c_str(),
+                                        static_cast<int>(body.length())));
+  CHECK(scanner.HasAnyLineTerminatorBeforeNext());
+  CHECK_EQ(i::Token::STRING, scanner.Next());
+  CHECK(scanner.LiteralMatches(expected_string.c_str(),
+                               static_cast<int>(expected_string.length())));
+  CHECK(!scanner.HasAnyLineTerminatorBeforeNext());
+  CHECK_EQ(i::Token::IDENTIFIER, scanner.Next());
+  CHECK_EQ(static_cast<int>(source.length()) - 1, scanner.location().beg_pos);
+  CHECK_EQ(i::Token::EOS, scanner.Next());
+}
+
+
 TEST(RegExpScanning) {
   v8::V8::Initialize();
 
@@ -1408,6 +1597,48 @@ TEST(ScopePositions) {
 }
 
 
+TEST(UnaryIIFEsParsedEagerly) {
+  // Functions preceded by a unary operator can be hinted as immediately
+  // called, like functions inside parentheses.
+  const char* sources[] = {"!function f() { var a; }();",
+                           "void function f() { var a; }();", NULL};
+
+  i::Isolate* isolate = CcTest::i_isolate();
+  i::Factory* factory = isolate->factory();
+  v8::HandleScope handles(CcTest::isolate());
+
+  for (int eager = 0; eager < 2; eager++) {
+    i::FLAG_eager_unary_iife = eager != 0;
+    for (int i = 0; sources[i]; i++) {
+      i::Handle<i::String> source_code =
+          factory->NewStringFromUtf8(i::CStrVector(sources[i]))
+              .ToHandleChecked();
+      i::Handle<i::Script> script = factory->NewScript(source_code);
+      i::Zone zone(CcTest::i_isolate()->allocator());
+      i::ParseInfo info(&zone, script);
+      info.set_allow_lazy_parsing();
+      i::Parser parser(&info);
+      parser.Parse(&info);
+      i::FunctionLiteral* function = info.literal();
+      CHECK_NOT_NULL(function);
+      CHECK_EQ(1, function->body()->length());
+      i::FunctionLiteral* inner = function->body()
+                                      ->first()
+                                      ->AsExpressionStatement()
+                                      ->expression()
+                                      ->AsUnaryOperation()
+                                      ->expression()
+                                      ->AsCall()
+                                      ->expression()
+                                      ->AsFunctionLiteral();
+      CHECK_EQ(eager != 0, inner->should_eager_compile());
+      CHECK_EQ(eager != 0, inner->body() != NULL);
+    }
+  }
+  i::FLAG_eager_unary_iife = false;
+}
+
+
 TEST(DiscardFunctionBody) {
   // Test that inner function bodies are discarded if possible.
   // See comments in ParseFunctionLiteral in parser.cc.
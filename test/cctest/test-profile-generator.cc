@@ -323,6 +323,45 @@ TEST(CodeMapMoveAndDeleteCode) {
 }
 
 
+TEST(CodeMapManyEntries) {
+  static const int kEntries = 10000;
+  static const int kSize = 0x40;
+  CodeMap code_map;
+  CodeEntry entry1(i::Logger::FUNCTION_TAG, "aaa");
+  CodeEntry entry2(i::Logger::FUNCTION_TAG, "bbb");
+  // Leave a gap of one code range after every entry.
+  for (int i = 0; i < kEntries; i++) {
+    code_map.AddCode(ToAddress(0x10000 + 2 * i * kSize),
+                     i % 2 == 0 ? &entry1 : &entry2, kSize);
+  }
+  for (int i = 0; i < kEntries; i++) {
+    int start = 0x10000 + 2 * i * kSize;
+    CodeEntry* expected = i % 2 == 0 ? &entry1 : &entry2;
+    CHECK_EQ(expected, code_map.FindEntry(ToAddress(start)));
+    CHECK_EQ(expected, code_map.FindEntry(ToAddress(start + kSize - 1)));
+    CHECK(!code_map.FindEntry(ToAddress(start + kSize)));
+  }
+  // Move every entry into the gap behind it, as the GC does when
+  // compacting code space.
+  for (int i = kEntries - 1; i >= 0; i--) {
+    int start = 0x10000 + 2 * i * kSize;
+    code_map.MoveCode(ToAddress(start), ToAddress(start + kSize));
+  }
+  for (int i = 0; i < kEntries; i++) {
+    int start = 0x10000 + 2 * i * kSize;
+    CHECK(!code_map.FindEntry(ToAddress(start)));
+    CHECK_EQ(i % 2 == 0 ? &entry1 : &entry2,
+             code_map.FindEntry(ToAddress(start + kSize)));
+  }
+  // A large code range replaces all the ranges it covers.
+  code_map.AddCode(ToAddress(0x10000), &entry1, 2 * kEntries * kSize);
+  CHECK_EQ(&entry1, code_map.FindEntry(ToAddress(0x10000 + 3 * kSize)));
+  CHECK_EQ(&entry1,
+           code_map.FindEntry(ToAddress(0x10000 + 2 * kEntries * kSize - 1)));
+  CHECK(!code_map.FindEntry(ToAddress(0x10000 + 2 * kEntries * kSize)));
+}
+
+
 namespace {
 
 class TestSetup {
@@ -400,6 +439,49 @@ TEST(RecordTickSample) {
 }
 
 
+TEST(RecordTickSampleInInterpretedFrame) {
+  TestSetup test_setup;
+  CpuProfilesCollection profiles(CcTest::heap());
+  profiles.StartProfiling("", false);
+  ProfileGenerator generator(&profiles);
+  CodeEntry* handler_entry =
+      profiles.NewCodeEntry(i::Logger::BYTECODE_HANDLER_TAG, "Add");
+  i::JITLineInfoTable* line_table = new i::JITLineInfoTable();
+  line_table->SetPosition(0x00, 1);
+  line_table->SetPosition(0x10, 3);
+  line_table->SetPosition(0x20, 5);
+  CodeEntry* function_entry = profiles.NewCodeEntry(
+      i::Logger::FUNCTION_TAG, "aaa", CodeEntry::kEmptyNamePrefix,
+      CodeEntry::kEmptyResourceName, 1, 1, line_table, ToAddress(0x1700));
+  generator.code_map()->AddCode(ToAddress(0x1500), handler_entry, 0x100);
+  generator.code_map()->AddCode(ToAddress(0x1700), function_entry, 0x100);
+
+  // The pc is in the bytecode handler, and the interpreted frame points at
+  // the bytecode it is executing, which is on line 3.
+  TickSample sample;
+  sample.pc = ToAddress(0x1520);
+  sample.tos = ToAddress(0x1500);
+  sample.top_frame_type = i::StackFrame::INTERPRETED;
+  sample.stack[0] = ToAddress(0x1718);
+  sample.frames_count = 1;
+  generator.RecordTickSample(sample);
+
+  CpuProfile* profile = profiles.StopProfiling("");
+  CHECK(profile);
+  ProfileTreeTestHelper top_down_test_helper(profile->top_down());
+  CHECK(!top_down_test_helper.Walk(handler_entry));
+  CHECK(!top_down_test_helper.Walk(function_entry, handler_entry));
+  ProfileNode* node = top_down_test_helper.Walk(function_entry);
+  CHECK(node);
+  CHECK_EQ(1u, node->self_ticks());
+  CHECK_EQ(1u, node->GetHitLineCount());
+  v8::CpuProfileNode::LineTick line_tick;
+  CHECK(node->GetLineTicks(&line_tick, 1));
+  CHECK_EQ(3, line_tick.line);
+  CHECK_EQ(1u, line_tick.hit_count);
+}
+
+
 static void CheckNodeIds(ProfileNode* node, unsigned* expectedId) {
   CHECK_EQ((*expectedId)++, node->id());
   for (int i = 0; i < node->children()->length(); i++) {
@@ -573,7 +573,8 @@ static RegExpNode* Compile(const char* input, bool multiline, bool unicode,
   Handle<String> sample_subject =
       isolate->factory()->NewStringFromUtf8(CStrVector("")).ToHandleChecked();
   RegExpEngine::Compile(isolate, zone, &compile_data, flags, pattern,
-                        sample_subject, is_one_byte);
+                        sample_subject, is_one_byte,
+                        !RegExpImpl::UsesNativeRegExp());
   return compile_data.node;
 }
 
@@ -1996,3 +1997,31 @@ TEST(UncachedExternalString) {
   CompileRun("var re = /y(.)/; re.test('ab');");
   ExpectString("external.substring(1).match(re)[1]", "z");
 }
+
+
+TEST(RegExpTierUp) {
+  if (!RegExpImpl::UsesNativeRegExp()) return;
+  bool saved_tier_up = i::FLAG_regexp_tier_up;
+  int saved_ticks = i::FLAG_regexp_tier_up_ticks;
+  i::FLAG_regexp_tier_up = true;
+  i::FLAG_regexp_tier_up_ticks = 2;
+  {
+    v8::HandleScope scope(CcTest::isolate());
+    LocalContext env;
+    CompileRun("var re = /a(b+)c/; function f() { return re.exec('xabbcx'); }");
+    Handle<JSRegExp> re =
+        Handle<JSRegExp>::cast(v8::Utils::OpenHandle(*CompileRun("re")));
+    // The first executions run bytecode in the interpreter.
+    for (int i = 0; i < 2; i++) {
+      ExpectString("f()[1]", "bb");
+      CHECK(re->DataAt(JSRegExp::kIrregexpLatin1BytecodeIndex)->IsByteArray());
+      CHECK(re->DataAt(JSRegExp::code_index(true))->IsSmi());
+    }
+    // After that the regexp is compiled to native code.
+    ExpectString("f()[1]", "bb");
+    CHECK(re->DataAt(JSRegExp::code_index(true))->IsCode());
+    ExpectString("'abc abbc'.replace(/a(b+)c/g, '$1')", "b bb");
+  }
+  i::FLAG_regexp_tier_up = saved_tier_up;
+  i::FLAG_regexp_tier_up_ticks = saved_ticks;
+}
@@ -854,6 +854,61 @@ TEST(CustomSnapshotDataBlobWithWarmup) {
   isolate->Dispose();
 }
 
+InlineCacheState LoadICState(const char* name) {
+  Handle<JSFunction> function =
+      Handle<JSFunction>::cast(v8::Utils::OpenHandle(*CompileRun(name)));
+  Handle<TypeFeedbackVector> vector(function->shared()->feedback_vector());
+  TypeFeedbackMetadataIterator iter(vector->metadata());
+  while (iter.HasNext()) {
+    FeedbackVectorSlot slot = iter.Next();
+    if (iter.kind() == FeedbackVectorSlotKind::LOAD_IC) {
+      return LoadICNexus(vector, slot).StateFromFeedback();
+    }
+  }
+  UNREACHABLE();
+  return UNINITIALIZED;
+}
+
+TEST(CustomSnapshotDataBlobWithWarmupKeepsMegamorphicFeedback) {
+  DisableTurbofan();
+  const char* source =
+      "function f(o) { return o.x; }\n"
+      "function g(o) { return o.x; }\n";
+  const char* warmup =
+      "for (var i = 0; i < 10; i++) {"
+      "  var o = {x: i};"
+      "  o['p' + i] = i;"
+      "  f(o);"
+      "}"
+      "g({x: 1});";
+
+  v8::StartupData cold = v8::V8::CreateSnapshotDataBlob(source);
+  v8::StartupData warm = v8::V8::WarmUpSnapshotDataBlob(cold, warmup);
+  delete[] cold.data;
+
+  v8::Isolate::CreateParams params;
+  params.snapshot_blob = &warm;
+  params.array_buffer_allocator = CcTest::array_buffer_allocator();
+
+  v8::Isolate* isolate = v8::Isolate::New(params);
+  {
+    v8::Isolate::Scope i_scope(isolate);
+    v8::HandleScope h_scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    delete[] warm.data;
+    v8::Context::Scope c_scope(context);
+    CHECK(IsCompiled("f"));
+    CHECK(IsCompiled("g"));
+    // The megamorphic state of f does not depend on the warm-up context, the
+    // map that g has seen does.
+    CHECK_EQ(MEGAMORPHIC, LoadICState("f"));
+    CHECK_NE(MONOMORPHIC, LoadICState("g"));
+    CHECK_EQ(3, CompileRun("f({x: 3})")->Int32Value(context).FromJust());
+    CHECK_EQ(4, CompileRun("g({x: 4})")->Int32Value(context).FromJust());
+  }
+  isolate->Dispose();
+}
+
 TEST(CustomSnapshotDataBlobImmortalImmovableRoots) {
   DisableTurbofan();
   // Flood the startup snapshot with shared function infos. If they are
@@ -884,6 +939,372 @@ TEST(CustomSnapshotDataBlobImmortalImmovableRoots) {
   source.Dispose();
 }
 
+TEST(SnapshotCreatorMultipleContexts) {
+  DisableTurbofan();
+  v8::StartupData blob;
+  {
+    v8::SnapshotCreator creator;
+    v8::Isolate* isolate = creator.GetIsolate();
+    {
+      v8::HandleScope handle_scope(isolate);
+      v8::Local<v8::Context> context = v8::Context::New(isolate);
+      v8::Context::Scope context_scope(context);
+      CompileRun("var f = function() { return 1; }");
+      CHECK_EQ(0u, creator.AddContext(context));
+    }
+    {
+      v8::HandleScope handle_scope(isolate);
+      v8::Local<v8::Context> context = v8::Context::New(isolate);
+      v8::Context::Scope context_scope(context);
+      CompileRun("var f = function() { return 2; }");
+      CHECK_EQ(1u, creator.AddContext(context));
+    }
+    {
+      v8::HandleScope handle_scope(isolate);
+      v8::Local<v8::Context> context = v8::Context::New(isolate);
+      CHECK_EQ(2u, creator.AddContext(context));
+    }
+    blob =
+        creator.CreateBlob(v8::SnapshotCreator::FunctionCodeHandling::kClear);
+  }
+
+  v8::Isolate::CreateParams params;
+  params.snapshot_blob = &blob;
+  params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(params);
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    {
+      v8::HandleScope handle_scope(isolate);
+      v8::Local<v8::Context> context = v8::Context::New(isolate);
+      v8::Context::Scope context_scope(context);
+      ExpectInt32("f()", 1);
+    }
+    {
+      v8::HandleScope handle_scope(isolate);
+      v8::Local<v8::Context> context =
+          v8::Context::FromSnapshot(isolate, 1).ToLocalChecked();
+      v8::Context::Scope context_scope(context);
+      ExpectInt32("f()", 2);
+    }
+    {
+      v8::HandleScope handle_scope(isolate);
+      v8::Local<v8::Context> context =
+          v8::Context::FromSnapshot(isolate, 2).ToLocalChecked();
+      v8::Context::Scope context_scope(context);
+      ExpectUndefined("this.f");
+    }
+    {
+      v8::HandleScope handle_scope(isolate);
+      CHECK(v8::Context::FromSnapshot(isolate, 3).IsEmpty());
+    }
+  }
+  isolate->Dispose();
+  delete[] blob.data;
+}
+
+TEST(SnapshotCreatorLazyBuiltins) {
+  DisableTurbofan();
+  v8::StartupData blob;
+  {
+    v8::SnapshotCreator creator;
+    v8::Isolate* isolate = creator.GetIsolate();
+    {
+      v8::HandleScope handle_scope(isolate);
+      v8::Local<v8::Context> context = v8::Context::New(isolate);
+      v8::Context::Scope context_scope(context);
+      CompileRun("var clz32 = Math.clz32; clz32(1);");
+      creator.AddContext(context);
+    }
+    blob =
+        creator.CreateBlob(v8::SnapshotCreator::FunctionCodeHandling::kClear);
+  }
+
+  v8::Isolate::CreateParams params;
+  params.snapshot_blob = &blob;
+  params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(params);
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    // The builtins of an embedder-provided blob are deserialized with the
+    // isolate, and the blob is not needed afterwards.
+    delete[] blob.data;
+    v8::Context::Scope context_scope(context);
+    ExpectInt32("clz32(1)", 31);
+    ExpectInt32("Math.clz32(0)", 32);
+    ExpectInt32("[1, 2, 3].pop()", 3);
+  }
+  isolate->Dispose();
+}
+
+TEST(DeserializeBuiltinsLazily) {
+  Isolate* isolate = CcTest::i_isolate();
+  if (!FLAG_lazy_deserialization ||
+      isolate->snapshot_blob() != Snapshot::DefaultSnapshotBlob() ||
+      !Snapshot::HaveASnapshotToStartFrom(isolate)) {
+    return;
+  }
+  LocalContext env;
+  v8::HandleScope scope(CcTest::isolate());
+  Builtins* builtins = isolate->builtins();
+  Handle<Code> placeholder(builtins->builtin(Builtins::kMathClz32));
+  CHECK_EQ(Builtins::kMathClz32, placeholder->builtin_index());
+  CHECK_EQ(builtins->builtin(Builtins::kDeserializeLazy)->instruction_size(),
+           placeholder->instruction_size());
+
+  ExpectInt32("Math.clz32(0)", 32);
+  Handle<Code> code(builtins->builtin(Builtins::kMathClz32));
+  CHECK(!code.is_identical_to(placeholder));
+  CHECK_EQ(Builtins::kMathClz32, code->builtin_index());
+  Handle<JSFunction> clz32 = Handle<JSFunction>::cast(
+      v8::Utils::OpenHandle(*CompileRun("Math.clz32")));
+  CHECK_EQ(*code, clz32->code());
+  CHECK_EQ(*code, clz32->shared()->code());
+  ExpectInt32("Math.clz32(1)", 31);
+}
+
+static void SerializedCallback(
+    const v8::FunctionCallbackInfo<v8::Value>& args) {
+  args.GetReturnValue().Set(v8_num(42));
+}
+
+static void SerializedCallbackReplacement(
+    const v8::FunctionCallbackInfo<v8::Value>& args) {
+  args.GetReturnValue().Set(v8_num(1337));
+}
+
+static intptr_t original_external_references[] = {
+    reinterpret_cast<intptr_t>(SerializedCallback), 0};
+
+static intptr_t replaced_external_references[] = {
+    reinterpret_cast<intptr_t>(SerializedCallbackReplacement), 0};
+
+TEST(SnapshotCreatorExternalReferences) {
+  DisableTurbofan();
+  v8::StartupData blob;
+  {
+    v8::SnapshotCreator creator(original_external_references);
+    v8::Isolate* isolate = creator.GetIsolate();
+    {
+      v8::HandleScope handle_scope(isolate);
+      v8::Local<v8::Context> context = v8::Context::New(isolate);
+      v8::Context::Scope context_scope(context);
+      v8::Local<v8::FunctionTemplate> callback =
+          v8::FunctionTemplate::New(isolate, SerializedCallback);
+      v8::Local<v8::Value> function =
+          callback->GetFunction(context).ToLocalChecked();
+      CHECK(context->Global()->Set(context, v8_str("f"), function).FromJust());
+      ExpectInt32("f()", 42);
+      CHECK_EQ(0u, creator.AddContext(context));
+    }
+    blob =
+        creator.CreateBlob(v8::SnapshotCreator::FunctionCodeHandling::kClear);
+  }
+
+  // Deserialize with the original external reference.
+  {
+    v8::Isolate::CreateParams params;
+    params.snapshot_blob = &blob;
+    params.array_buffer_allocator = CcTest::array_buffer_allocator();
+    params.external_references = original_external_references;
+    v8::Isolate* isolate = v8::Isolate::New(params);
+    {
+      v8::Isolate::Scope isolate_scope(isolate);
+      v8::HandleScope handle_scope(isolate);
+      v8::Local<v8::Context> context = v8::Context::New(isolate);
+      v8::Context::Scope context_scope(context);
+      ExpectInt32("f()", 42);
+    }
+    isolate->Dispose();
+  }
+
+  // Deserialize with some other external reference in the same slot.
+  {
+    v8::Isolate::CreateParams params;
+    params.snapshot_blob = &blob;
+    params.array_buffer_allocator = CcTest::array_buffer_allocator();
+    params.external_references = replaced_external_references;
+    v8::Isolate* isolate = v8::Isolate::New(params);
+    {
+      v8::Isolate::Scope isolate_scope(isolate);
+      v8::HandleScope handle_scope(isolate);
+      v8::Local<v8::Context> context = v8::Context::New(isolate);
+      v8::Context::Scope context_scope(context);
+      ExpectInt32("f()", 1337);
+    }
+    isolate->Dispose();
+  }
+  delete[] blob.data;
+}
+
+struct InternalFieldData {
+  uint32_t data;
+};
+
+static v8::StartupData SerializeInternalFields(v8::Local<v8::Object> holder,
+                                               int index) {
+  InternalFieldData* field = static_cast<InternalFieldData*>(
+      holder->GetAlignedPointerFromInternalField(index));
+  int size = sizeof(*field);
+  char* payload = new char[size];
+  // We simply use memcpy to serialize the content.
+  memcpy(payload, field, size);
+  return {payload, size};
+}
+
+static List<InternalFieldData*> deserialized_data;
+
+static void DeserializeInternalFields(v8::Local<v8::Object> holder, int index,
+                                      v8::StartupData payload) {
+  InternalFieldData* field = new InternalFieldData{0};
+  memcpy(field, payload.data, payload.raw_size);
+  holder->SetAlignedPointerInInternalField(index, field);
+  deserialized_data.Add(field);
+}
+
+TEST(SnapshotCreatorTemplates) {
+  DisableTurbofan();
+  v8::StartupData blob;
+  {
+    InternalFieldData* a1 = new InternalFieldData{11};
+    InternalFieldData* b0 = new InternalFieldData{20};
+    v8::SnapshotCreator creator(original_external_references);
+    v8::Isolate* isolate = creator.GetIsolate();
+    {
+      v8::HandleScope handle_scope(isolate);
+      v8::ExtensionConfiguration* no_extension = NULL;
+      v8::Local<v8::ObjectTemplate> global_template =
+          v8::ObjectTemplate::New(isolate);
+      v8::Local<v8::FunctionTemplate> callback =
+          v8::FunctionTemplate::New(isolate, SerializedCallback);
+      global_template->Set(v8_str("f"), callback);
+      v8::Local<v8::Context> context =
+          v8::Context::New(isolate, no_extension, global_template);
+      v8::Local<v8::ObjectTemplate> object_template =
+          v8::ObjectTemplate::New(isolate);
+      object_template->SetInternalFieldCount(3);
+
+      v8::Context::Scope context_scope(context);
+      ExpectInt32("f()", 42);
+
+      v8::Local<v8::Object> a =
+          object_template->NewInstance(context).ToLocalChecked();
+      v8::Local<v8::Object> b =
+          object_template->NewInstance(context).ToLocalChecked();
+      a->SetInternalField(0, b);
+      a->SetAlignedPointerInInternalField(1, a1);
+      a->SetInternalField(2, v8_str("a2"));
+      b->SetAlignedPointerInInternalField(0, b0);
+      b->SetInternalField(1, a);
+      b->SetInternalField(2, v8_str("b2"));
+      CHECK(context->Global()->Set(context, v8_str("a"), a).FromJust());
+
+      CHECK_EQ(0u, creator.AddContext(context));
+      CHECK_EQ(0u, creator.AddTemplate(callback));
+      CHECK_EQ(1u, creator.AddTemplate(global_template));
+    }
+    blob = creator.CreateBlob(
+        v8::SnapshotCreator::FunctionCodeHandling::kClear,
+        SerializeInternalFields);
+
+    delete a1;
+    delete b0;
+  }
+
+  {
+    v8::Isolate::CreateParams params;
+    params.snapshot_blob = &blob;
+    params.array_buffer_allocator = CcTest::array_buffer_allocator();
+    params.external_references = original_external_references;
+    v8::Isolate* isolate = v8::Isolate::New(params);
+    {
+      v8::Isolate::Scope isolate_scope(isolate);
+      {
+        // Create a new context without a new object template.
+        v8::HandleScope handle_scope(isolate);
+        v8::Local<v8::Context> context =
+            v8::Context::FromSnapshot(isolate, 0, DeserializeInternalFields)
+                .ToLocalChecked();
+        v8::Context::Scope context_scope(context);
+        ExpectInt32("f()", 42);
+
+        // Retrieve the snapshotted object template.
+        v8::Local<v8::ObjectTemplate> obj_template =
+            v8::ObjectTemplate::FromSnapshot(isolate, 1).ToLocalChecked();
+        CHECK(!obj_template.IsEmpty());
+        v8::Local<v8::Object> object =
+            obj_template->NewInstance(context).ToLocalChecked();
+        CHECK(context->Global()->Set(context, v8_str("o"), object).FromJust());
+        ExpectInt32("o.f()", 42);
+        // Check that it instantiates to the same prototype.
+        ExpectTrue("o.f.prototype === f.prototype");
+
+        // Retrieve the snapshotted function template.
+        v8::Local<v8::FunctionTemplate> fun_template =
+            v8::FunctionTemplate::FromSnapshot(isolate, 0).ToLocalChecked();
+        CHECK(!fun_template.IsEmpty());
+        v8::Local<v8::Function> fun =
+            fun_template->GetFunction(context).ToLocalChecked();
+        CHECK(context->Global()->Set(context, v8_str("g"), fun).FromJust());
+        ExpectInt32("g()", 42);
+        // Check that it instantiates to the same prototype.
+        ExpectTrue("g.prototype === f.prototype");
+
+        // Retrieve the embedder objects and their internal fields.
+        v8::Local<v8::Object> a = context->Global()
+                                      ->Get(context, v8_str("a"))
+                                      .ToLocalChecked()
+                                      ->ToObject(context)
+                                      .ToLocalChecked();
+        v8::Local<v8::Object> b =
+            a->GetInternalField(0)->ToObject(context).ToLocalChecked();
+        InternalFieldData* a1 = reinterpret_cast<InternalFieldData*>(
+            a->GetAlignedPointerFromInternalField(1));
+        v8::Local<v8::Value> a2 = a->GetInternalField(2);
+
+        InternalFieldData* b0 = reinterpret_cast<InternalFieldData*>(
+            b->GetAlignedPointerFromInternalField(0));
+        v8::Local<v8::Value> b1 = b->GetInternalField(1);
+        v8::Local<v8::Value> b2 = b->GetInternalField(2);
+
+        CHECK_EQ(11u, a1->data);
+        CHECK(a2->StrictEquals(v8_str("a2")));
+
+        CHECK_EQ(20u, b0->data);
+        CHECK(b1->StrictEquals(a));
+        CHECK(b2->StrictEquals(v8_str("b2")));
+      }
+
+      {
+        // Create a context with a new object template. It is merged into the
+        // deserialized global object.
+        v8::HandleScope handle_scope(isolate);
+        v8::ExtensionConfiguration* no_extension = NULL;
+        v8::Local<v8::ObjectTemplate> global_template =
+            v8::ObjectTemplate::New(isolate);
+        global_template->Set(
+            v8_str("g"),
+            v8::FunctionTemplate::New(isolate, SerializedCallbackReplacement));
+        v8::Local<v8::Context> context =
+            v8::Context::New(isolate, no_extension, global_template);
+        v8::Context::Scope context_scope(context);
+        ExpectInt32("g()", 1337);
+        ExpectInt32("f()", 42);
+
+        CHECK(v8::ObjectTemplate::FromSnapshot(isolate, 0).IsEmpty());
+        CHECK(v8::FunctionTemplate::FromSnapshot(isolate, 1).IsEmpty());
+        CHECK(v8::ObjectTemplate::FromSnapshot(isolate, 2).IsEmpty());
+      }
+    }
+    isolate->Dispose();
+    delete[] blob.data;
+    for (InternalFieldData* data : deserialized_data) delete data;
+    deserialized_data.Clear();
+  }
+}
+
 TEST(TestThatAlwaysSucceeds) {
 }
 
@@ -1528,6 +1949,63 @@ TEST(CodeSerializerIsolates) {
   isolate2->Dispose();
 }
 
+static void CompileAndRunInNewIsolate(const char* source, bool allow_compile) {
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate);
+    v8::HandleScope scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source script_source(v8_str(source), origin);
+    v8::Local<v8::UnboundScript> script;
+    {
+      v8::base::SmartPointer<DisallowCompilation> no_compile;
+      if (!allow_compile) {
+        no_compile.Reset(
+            new DisallowCompilation(reinterpret_cast<Isolate*>(isolate)));
+      }
+      script = v8::ScriptCompiler::CompileUnboundScript(isolate, &script_source)
+                   .ToLocalChecked();
+    }
+    v8::Local<v8::Value> result =
+        script->BindToCurrentContext()->Run(context).ToLocalChecked();
+    CHECK(result->ToString(context)
+              .ToLocalChecked()
+              ->Equals(context, v8_str("abcdef"))
+              .FromJust());
+  }
+  isolate->Dispose();
+}
+
+TEST(SharedCodeCacheIsolates) {
+  FLAG_serialize_toplevel = true;
+  FLAG_shared_code_cache = true;
+  SharedCodeCache* cache = SharedCodeCache::Get();
+  cache->Clear();
+
+  const char* source = "function f() { return 'abc'; }; f() + 'def'";
+  CompileAndRunInNewIsolate(source, true);
+  size_t size = cache->size();
+  CHECK_LT(0u, size);
+
+  // The second isolate deserializes the script instead of compiling it.
+  CompileAndRunInNewIsolate(source, false);
+  CHECK_EQ(size, cache->size());
+
+  // Scripts larger than the budget are not cached.
+  cache->Clear();
+  FLAG_shared_code_cache_size = 0;
+  CompileAndRunInNewIsolate(source, true);
+  CHECK_EQ(0u, cache->size());
+
+  FLAG_shared_code_cache_size = 64;
+  FLAG_shared_code_cache = false;
+}
+
 TEST(CodeSerializerFlagChange) {
   FLAG_serialize_toplevel = true;
 
@@ -1553,6 +2031,40 @@ TEST(CodeSerializerFlagChange) {
         isolate2, &source, v8::ScriptCompiler::kConsumeCodeCache)
         .ToLocalChecked();
     CHECK(cache->rejected);
+    CHECK_EQ(v8::ScriptCompiler::CachedData::kFlagsMismatch,
+             cache->reject_reason);
+  }
+  isolate2->Dispose();
+}
+
+TEST(CodeSerializerCodeIndependentFlagChange) {
+  FLAG_serialize_toplevel = true;
+
+  const char* source = "function f() { return 'abc'; }; f() + 'def'";
+  v8::ScriptCompiler::CachedData* cache = ProduceCache(source);
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+
+  // Diagnostic flags do not affect the generated code.
+  FLAG_profile_deserialization = true;
+  FlagList::EnforceFlagImplications();
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+
+    v8::Local<v8::String> source_str = v8_str(source);
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin, cache);
+    v8::ScriptCompiler::CompileUnboundScript(
+        isolate2, &source, v8::ScriptCompiler::kConsumeCodeCache)
+        .ToLocalChecked();
+    CHECK(!cache->rejected);
+    CHECK_EQ(v8::ScriptCompiler::CachedData::kNotRejected,
+             cache->reject_reason);
   }
   isolate2->Dispose();
 }
@@ -1582,6 +2094,8 @@ TEST(CodeSerializerBitFlip) {
         isolate2, &source, v8::ScriptCompiler::kConsumeCodeCache)
         .ToLocalChecked();
     CHECK(cache->rejected);
+    CHECK_EQ(v8::ScriptCompiler::CachedData::kChecksumMismatch,
+             cache->reject_reason);
   }
   isolate2->Dispose();
 }
@@ -1810,6 +2324,100 @@ TEST(CodeSerializerEagerCompilationAndPreAge) {
   isolate2->Dispose();
 }
 
+static void TestCodeSerializerAfterExecute(bool ignition) {
+  FLAG_ignition = ignition;
+  FLAG_lazy = true;
+  FLAG_min_preparse_length = 1;
+  FLAG_serialize_toplevel = true;
+
+  static const char* source =
+      "function f() { return g(); }"
+      "function g() { return 'abc'; }"
+      "function h() { return 'def'; }"
+      "f() + 'def';";
+
+  v8::ScriptCompiler::CachedData* cache;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate1 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate1);
+    v8::HandleScope scope(isolate1);
+    v8::Local<v8::Context> context = v8::Context::New(isolate1);
+    v8::Context::Scope context_scope(context);
+
+    v8::Local<v8::String> source_str = v8_str(source);
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin);
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnboundScript(
+            isolate1, &source, v8::ScriptCompiler::kNoCompileOptions)
+            .ToLocalChecked();
+    v8::Local<v8::Value> result =
+        script->BindToCurrentContext()->Run(context).ToLocalChecked();
+    CHECK(result->ToString(context).ToLocalChecked()->Equals(context,
+                                                             v8_str("abcdef"))
+              .FromJust());
+
+    cache = v8::ScriptCompiler::CreateCodeCache(script, source_str);
+    CHECK(cache);
+  }
+  isolate1->Dispose();
+
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+
+    v8::Local<v8::String> source_str = v8_str(source);
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin, cache);
+    v8::Local<v8::UnboundScript> unbound =
+        v8::ScriptCompiler::CompileUnboundScript(
+            isolate2, &source, v8::ScriptCompiler::kConsumeCodeCache)
+            .ToLocalChecked();
+
+    CHECK(!cache->rejected);
+
+    Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate2);
+    {
+      HandleScope i_scope(i_isolate);
+      Handle<SharedFunctionInfo> toplevel = v8::Utils::OpenHandle(*unbound);
+      CHECK_EQ(ignition, toplevel->HasBytecodeArray());
+      Handle<Script> script(Script::cast(toplevel->script()));
+      WeakFixedArray::Iterator iterator(script->shared_function_infos());
+      // Only the functions that ran before creating the cache are compiled.
+      int count = 0;
+      while (SharedFunctionInfo* shared = iterator.Next<SharedFunctionInfo>()) {
+        if (shared->is_compiled() && shared != *toplevel) {
+          CHECK_EQ(ignition, shared->HasBytecodeArray());
+          CHECK(ignition || shared->code()->kind() == Code::FUNCTION);
+          count++;
+        }
+      }
+      CHECK_EQ(2, count);
+    }
+
+    // Running the startup path again does not compile anything.
+    DisallowCompilation no_compile_expected(i_isolate);
+    v8::Local<v8::Value> result =
+        unbound->BindToCurrentContext()->Run(context).ToLocalChecked();
+    CHECK(result->ToString(context).ToLocalChecked()->Equals(context,
+                                                             v8_str("abcdef"))
+              .FromJust());
+  }
+  isolate2->Dispose();
+}
+
+TEST(CodeSerializerAfterExecute) { TestCodeSerializerAfterExecute(true); }
+
+TEST(CodeSerializerAfterExecuteFullCodegen) {
+  // Lazily compiled full-codegen code is re-generated for the cache.
+  TestCodeSerializerAfterExecute(false);
+}
+
 TEST(Regress503552) {
   // Test that the code serializer can deal with weak cells that form a linked
   // list during incremental marking.
@@ -190,6 +190,34 @@ TEST(MemMove) {
 }
 
 
+TEST(CompareCharsEqual) {
+  static const int kMaxLength = 70;
+  uint8_t one_byte[kMaxLength];
+  uint16_t two_byte[kMaxLength];
+  uint16_t other_two_byte[kMaxLength];
+  for (int i = 0; i < kMaxLength; i++) {
+    one_byte[i] = static_cast<uint8_t>('a' + i % 26);
+    two_byte[i] = one_byte[i];
+    other_two_byte[i] = one_byte[i];
+  }
+  for (int length = 0; length <= kMaxLength; length++) {
+    CHECK(CompareCharsEqual(one_byte, two_byte, length));
+    CHECK(CompareCharsEqual(two_byte, one_byte, length));
+    CHECK(CompareCharsEqual(two_byte, other_two_byte, length));
+    for (int i = 0; i < length; i++) {
+      // A difference in the high byte only.
+      two_byte[i] |= 0x100;
+      CHECK(!CompareCharsEqual(one_byte, two_byte, length));
+      CHECK(!CompareCharsEqual(two_byte, one_byte, length));
+      CHECK(!CompareCharsEqual(two_byte, other_two_byte, length));
+      CHECK_EQ(CompareChars(two_byte, other_two_byte, length) == 0,
+               CompareCharsEqual(two_byte, other_two_byte, length));
+      two_byte[i] = one_byte[i];
+    }
+  }
+}
+
+
 TEST(Collector) {
   Collector<int> collector(8);
   const int kLoops = 5;
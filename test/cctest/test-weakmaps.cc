@@ -265,3 +265,46 @@ TEST(Regress399527) {
   // marking bits which makes the weak map garbage.
   heap->CollectAllGarbage();
 }
+
+
+TEST(EphemeronChains) {
+  FLAG_incremental_marking = false;
+  FLAG_always_compact = true;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  v8::Local<v8::Context> context = CcTest::isolate()->GetCurrentContext();
+  Heap* heap = CcTest::i_isolate()->heap();
+  // Each key is only reachable through the value of the previous one, and
+  // the chain alternates between two weak maps. Keys are added in reverse
+  // order, so a single pass over the tables marks one link at a time.
+  CompileRun(
+      "var maps = [new WeakMap(), new WeakMap()];"
+      "var keys = [];"
+      "for (var i = 0; i < 2000; i++) keys.push({ id: i });"
+      "for (var i = 1999; i >= 0; i--) {"
+      "  maps[i % 2].set(keys[i], i < 1999 ? keys[i + 1] : 'end');"
+      "}"
+      "var head = keys[0];"
+      "keys = null;"
+      "function walk() {"
+      "  var key = head, length = 0;"
+      "  while (typeof key == 'object') {"
+      "    if (key.id != length) return -1;"
+      "    key = maps[length % 2].get(key);"
+      "    length++;"
+      "  }"
+      "  return key == 'end' ? length : -1;"
+      "}");
+  heap->CollectAllGarbage();
+  heap->CollectAllGarbage();
+  CHECK_EQ(2000, CompileRun("walk()")->Int32Value(context).FromJust());
+  // Without the head, the whole chain is garbage.
+  CompileRun("head = null;");
+  heap->CollectAllGarbage();
+  Handle<JSWeakMap> map0 = Handle<JSWeakMap>::cast(
+      v8::Utils::OpenHandle(*CompileRun("maps[0]")));
+  Handle<JSWeakMap> map1 = Handle<JSWeakMap>::cast(
+      v8::Utils::OpenHandle(*CompileRun("maps[1]")));
+  CHECK_EQ(0, ObjectHashTable::cast(map0->table())->NumberOfElements());
+  CHECK_EQ(0, ObjectHashTable::cast(map1->table())->NumberOfElements());
+}
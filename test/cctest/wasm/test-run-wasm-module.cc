@@ -5,7 +5,10 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "src/snapshot/code-serializer.h"
 #include "src/wasm/encoder.h"
+#include "src/wasm/module-decoder.h"
+#include "src/wasm/streaming-decoder.h"
 #include "src/wasm/wasm-js.h"
 #include "src/wasm/wasm-macro-gen.h"
 #include "src/wasm/wasm-module.h"
@@ -154,3 +157,199 @@ TEST(Run_WasmModule_Global) {
   WasmModuleWriter* writer = builder->Build(&zone);
   TestModule(writer->WriteTo(&zone), 97);
 }
+
+namespace {
+int32_t CallExportedFunction(Isolate* isolate, Handle<JSObject> instance,
+                             const char* name) {
+  Handle<Object> function =
+      Object::GetProperty(instance,
+                          isolate->factory()->InternalizeUtf8String(name))
+          .ToHandleChecked();
+  CHECK(function->IsJSFunction());
+  Handle<Object> undefined = isolate->factory()->undefined_value();
+  Handle<Object> result =
+      Execution::Call(isolate, function, undefined, 0, nullptr)
+          .ToHandleChecked();
+  CHECK(result->IsSmi());
+  return Smi::cast(*result)->value();
+}
+}  // namespace
+
+TEST(Run_WasmModule_InstantiateCompiledModuleTwice) {
+  v8::base::AccountingAllocator allocator;
+  Zone zone(&allocator);
+  WasmModuleBuilder* builder = new (&zone) WasmModuleBuilder(&zone);
+  uint32_t global = builder->AddGlobal(MachineType::Int32(), 0);
+  uint16_t f_index = builder->AddFunction();
+  WasmFunctionBuilder* f = builder->FunctionAt(f_index);
+  f->ReturnType(kAstI32);
+  f->Exported(1);
+  static const unsigned char kName[] = "counter";
+  f->SetName(kName, static_cast<int>(sizeof(kName) - 1));
+  byte code[] = {WASM_STORE_GLOBAL(
+      global, WASM_I32_ADD(WASM_LOAD_GLOBAL(global), WASM_I8(1)))};
+  f->EmitCode(code, sizeof(code));
+  WasmModuleWriter* writer = builder->Build(&zone);
+  WasmModuleIndex* module_bytes = writer->WriteTo(&zone);
+
+  Isolate* isolate = CcTest::InitIsolateOnce();
+  HandleScope scope(isolate);
+  WasmJs::InstallWasmFunctionMap(isolate, isolate->native_context());
+  ModuleResult result =
+      DecodeWasmModule(isolate, &zone, module_bytes->Begin(),
+                       module_bytes->End(), false, kWasmOrigin);
+  CHECK(result.ok());
+  WasmModule* module = result.val;
+
+  ErrorThrower thrower(isolate, "InstantiateCompiledModuleTwice");
+  Handle<FixedArray> compiled_module =
+      module
+          ->CompileFunctions(isolate, &thrower,
+                             WasmModule::kPageSize * module->min_mem_pages)
+          .ToHandleChecked();
+  Handle<JSObject> null_ffi = Handle<JSObject>::null();
+  Handle<JSArrayBuffer> null_memory = Handle<JSArrayBuffer>::null();
+  Handle<JSObject> first =
+      module->Instantiate(isolate, compiled_module, null_ffi, null_memory)
+          .ToHandleChecked();
+  Handle<JSObject> second =
+      module->Instantiate(isolate, compiled_module, null_ffi, null_memory)
+          .ToHandleChecked();
+
+  // Each instance has its own globals, although the code was compiled once.
+  CHECK_EQ(1, CallExportedFunction(isolate, first, "counter"));
+  CHECK_EQ(2, CallExportedFunction(isolate, first, "counter"));
+  CHECK_EQ(1, CallExportedFunction(isolate, second, "counter"));
+  CHECK_EQ(3, CallExportedFunction(isolate, first, "counter"));
+  CHECK_EQ(2, CallExportedFunction(isolate, second, "counter"));
+  delete module;
+}
+
+namespace {
+// Feeds {size} module bytes to a StreamingDecoder in chunks of {chunk_size}
+// bytes, then instantiates the module and calls its exported function "main".
+int32_t StreamAndRunModule(const byte* module_bytes, size_t size,
+                           size_t chunk_size) {
+  Isolate* isolate = CcTest::InitIsolateOnce();
+  HandleScope scope(isolate);
+  WasmJs::InstallWasmFunctionMap(isolate, isolate->native_context());
+  StreamingDecoder decoder(isolate);
+  for (size_t pos = 0; pos < size; pos += chunk_size) {
+    decoder.OnBytesReceived(module_bytes + pos,
+                            std::min(chunk_size, size - pos));
+  }
+  Handle<FixedArray> compiled_module = decoder.Finish().ToHandleChecked();
+  Handle<JSObject> instance =
+      decoder.module()
+          ->Instantiate(isolate, compiled_module, Handle<JSObject>::null(),
+                        Handle<JSArrayBuffer>::null())
+          .ToHandleChecked();
+  return CallExportedFunction(isolate, instance, "main");
+}
+
+// The function bodies are in a code section, which the streaming decoder
+// compiles while the rest of the module is still arriving.
+const byte kStreamedCallAddModule[] = {
+    WASM_MODULE_HEADER,
+    // Signatures: i_ii, i_v.
+    WASM_SECTION_SIGNATURES, 11, 2,
+    SIG_ENTRY_x_xx(kLocalI32, kLocalI32, kLocalI32),
+    SIG_ENTRY_x(kLocalI32),
+    // Functions: add, main.
+    WASM_SECTION_FUNCTION_SIGNATURES, 3, 2, 0, 1,
+    // Exports: main.
+    WASM_SECTION_EXPORT_TABLE, 7, 1, 1, 4, 'm', 'a', 'i', 'n',
+    // Function bodies.
+    WASM_SECTION_FUNCTION_BODIES, 17, 2,
+    6, 0, WASM_I32_ADD(WASM_GET_LOCAL(0), WASM_GET_LOCAL(1)),
+    8, 0, WASM_CALL_FUNCTION2(0, WASM_I8(77), WASM_I8(22)),
+};
+}  // namespace
+
+TEST(Run_WasmModule_StreamingDecoder) {
+  const byte* data = kStreamedCallAddModule;
+  size_t size = sizeof(kStreamedCallAddModule);
+  CHECK_EQ(99, StreamAndRunModule(data, size, 1));
+  CHECK_EQ(99, StreamAndRunModule(data, size, 7));
+  CHECK_EQ(99, StreamAndRunModule(data, size, size));
+}
+
+TEST(Run_WasmModule_StreamingDecoderGlobalsAfterCode) {
+  // The global is declared after the code section, so the body streamed
+  // before it cannot be used and the module is compiled again in Finish().
+  static const byte data[] = {
+      WASM_MODULE_HEADER,
+      WASM_SECTION_SIGNATURES, 5, 1, SIG_ENTRY_x(kLocalI32),
+      WASM_SECTION_FUNCTION_SIGNATURES, 2, 1, 0,
+      WASM_SECTION_EXPORT_TABLE, 7, 1, 0, 4, 'm', 'a', 'i', 'n',
+      WASM_SECTION_FUNCTION_BODIES, 7, 1,
+      5, 0, WASM_STORE_GLOBAL(0, WASM_I8(11)),
+      WASM_SECTION_GLOBALS, 4, 1, 0, kMemI32, 0,
+  };
+  CHECK_EQ(11, StreamAndRunModule(data, sizeof(data), 3));
+}
+
+TEST(Run_WasmModule_StreamingDecoderTruncated) {
+  Isolate* isolate = CcTest::InitIsolateOnce();
+  HandleScope scope(isolate);
+  // Cut off the last function body. The first one is compiled while the
+  // module is streamed, but Finish() has to report the decoding error.
+  StreamingDecoder decoder(isolate);
+  decoder.OnBytesReceived(kStreamedCallAddModule,
+                          sizeof(kStreamedCallAddModule) - 2);
+  CHECK(decoder.Finish().is_null());
+  CHECK(isolate->has_scheduled_exception());
+  isolate->clear_scheduled_exception();
+}
+
+TEST(Run_WasmModule_SerializeCompiledModule) {
+  v8::base::AccountingAllocator allocator;
+  Zone zone(&allocator);
+  const byte* data = kStreamedCallAddModule;
+  Vector<const byte> wire_bytes(data, sizeof(kStreamedCallAddModule));
+
+  Isolate* isolate = CcTest::InitIsolateOnce();
+  HandleScope scope(isolate);
+  WasmJs::InstallWasmFunctionMap(isolate, isolate->native_context());
+  ModuleResult result =
+      DecodeWasmModule(isolate, &zone, wire_bytes.begin(), wire_bytes.end(),
+                       false, kWasmOrigin);
+  CHECK(result.ok());
+  WasmModule* module = result.val;
+
+  ScriptData* cached_data;
+  {
+    HandleScope compile_scope(isolate);
+    ErrorThrower thrower(isolate, "SerializeCompiledModule");
+    Handle<FixedArray> compiled_module =
+        module
+            ->CompileFunctions(isolate, &thrower,
+                               WasmModule::kPageSize * module->min_mem_pages)
+            .ToHandleChecked();
+    cached_data =
+        CodeSerializer::SerializeWasmModule(isolate, compiled_module,
+                                            wire_bytes);
+  }
+
+  // Cached data for other wire bytes is rejected.
+  const byte other_bytes[] = {WASM_MODULE_HEADER};
+  CHECK(CodeSerializer::DeserializeWasmModule(
+            isolate, cached_data,
+            Vector<const byte>(other_bytes, sizeof(other_bytes)))
+            .is_null());
+  CHECK(cached_data->rejected());
+  ScriptData fresh_data(cached_data->data(), cached_data->length());
+
+  Handle<FixedArray> compiled_module =
+      CodeSerializer::DeserializeWasmModule(isolate, &fresh_data, wire_bytes)
+          .ToHandleChecked();
+  CHECK(!fresh_data.rejected());
+  Handle<JSObject> instance =
+      module
+          ->Instantiate(isolate, compiled_module, Handle<JSObject>::null(),
+                        Handle<JSArrayBuffer>::null())
+          .ToHandleChecked();
+  CHECK_EQ(99, CallExportedFunction(isolate, instance, "main"));
+  delete cached_data;
+  delete module;
+}
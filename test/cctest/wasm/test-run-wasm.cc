@@ -1400,6 +1400,34 @@ TEST(Run_Wasm_LoadMemI32_offset) {
 }
 
 
+TEST(Run_Wasm_LoadMemI32_offset_sequence_oob) {
+  TestingModule module;
+  int32_t* memory = module.AddMemoryElems<int32_t>(4);
+  WasmRunner<int32_t> r(&module, MachineType::Uint32());
+
+  // The load at offset 4 extends beyond the one at offset 0 and needs its
+  // own bounds check, the load at offset 0 after it does not.
+  BUILD(r, WASM_I32_ADD(
+               WASM_I32_ADD(
+                   WASM_LOAD_MEM(MachineType::Int32(), WASM_GET_LOCAL(0)),
+                   WASM_LOAD_MEM_OFFSET(MachineType::Int32(), 4,
+                                        WASM_GET_LOCAL(0))),
+               WASM_LOAD_MEM(MachineType::Int32(), WASM_GET_LOCAL(0))));
+
+  memory[0] = 1;
+  memory[1] = 10;
+  memory[2] = 100;
+  memory[3] = 1000;
+  CHECK_EQ(12, r.Call(0u));
+  CHECK_EQ(120, r.Call(4u));
+  CHECK_EQ(1200, r.Call(8u));
+  for (uint32_t index = 9; index < 20; index++) {
+    CHECK_TRAP(r.Call(index));
+  }
+  CHECK_TRAP(r.Call(0xfffffffcu));
+}
+
+
 #if !V8_TARGET_ARCH_MIPS && !V8_TARGET_ARCH_MIPS64
 
 TEST(Run_Wasm_LoadMemI32_const_oob_misaligned) {
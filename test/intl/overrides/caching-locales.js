@@ -0,0 +1,43 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Overridden methods called with a single locale string reuse formatters.
+// Make sure results match freshly created formatters, also after older
+// cache entries have been dropped.
+
+var date = new Date(2016, 4, 3, 13, 14, 15);
+var number = 1234567.891;
+
+function check(locale) {
+  assertEquals(new Intl.NumberFormat(locale).format(number),
+               number.toLocaleString(locale));
+  assertEquals(new Intl.DateTimeFormat(locale).format(date),
+               date.toLocaleDateString(locale));
+  assertEquals(new Intl.Collator(locale).compare('a', 'b'),
+               'a'.localeCompare('b', locale));
+}
+
+// Keys of the cache must not hit accessors on Object.prototype.
+Object.defineProperty(Object.prototype, 'numberformat de', {
+  get: function() { throw new Error('getter called'); },
+  set: function() { throw new Error('setter called'); },
+  configurable: true
+});
+
+var locales = ['en', 'de', 'sr', 'fr', 'ja', 'zh', 'ru', 'ar'];
+for (var round = 0; round < 3; round++) {
+  for (var i = 0; i < locales.length; i++) check(locales[i]);
+}
+
+// More locales than the cache holds.
+var many = [];
+for (var i = 0; i < 40; i++) {
+  many.push(locales[i % locales.length] + (i < 8 ? '' : '-u-nu-latn'));
+  many.push('en-' + String.fromCharCode(65 + (i % 26)) +
+            String.fromCharCode(65 + ((i / 26) | 0)));
+}
+for (var i = 0; i < many.length; i++) check(many[i]);
+for (var i = 0; i < locales.length; i++) check(locales[i]);
+
+delete Object.prototype['numberformat de'];
@@ -0,0 +1,69 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+new BenchmarkSuite('ForEach', [1000], [
+  new Benchmark('ForEach', false, false, 0, ForEach, Setup, ForEachTearDown)
+]);
+
+new BenchmarkSuite('Map', [1000], [
+  new Benchmark('Map', false, false, 0, Map, Setup, MapTearDown)
+]);
+
+new BenchmarkSuite('Filter', [1000], [
+  new Benchmark('Filter', false, false, 0, Filter, Setup, FilterTearDown)
+]);
+
+new BenchmarkSuite('Reduce', [1000], [
+  new Benchmark('Reduce', false, false, 0, Reduce, Setup, ReduceTearDown)
+]);
+
+// ----------------------------------------------------------------------------
+
+var array;
+var result;
+
+function Setup() {
+  array = [];
+  for (var i = 0; i < 100; ++i) array.push(i);
+}
+
+// ----------------------------------------------------------------------------
+
+function Add(x) { result += x; }
+function Double(x) { return x * 2; }
+function IsOdd(x) { return (x & 1) == 1; }
+function Sum(a, b) { return a + b; }
+
+function ForEach() {
+  result = 0;
+  array.forEach(Add);
+}
+
+function ForEachTearDown() {
+  return result == 4950;
+}
+
+function Map() {
+  result = array.map(Double);
+}
+
+function MapTearDown() {
+  return result.length == 100 && result[99] == 198;
+}
+
+function Filter() {
+  result = array.filter(IsOdd);
+}
+
+function FilterTearDown() {
+  return result.length == 50 && result[0] == 1;
+}
+
+function Reduce() {
+  result = array.reduce(Sum, 0);
+}
+
+function ReduceTearDown() {
+  return result == 4950;
+}
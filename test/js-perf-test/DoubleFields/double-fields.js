@@ -0,0 +1,76 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Objects with double fields. With --unbox-double-fields the doubles are
+// stored in the object itself, otherwise every field holds a
+// MutableHeapNumber that has to be allocated with the object and followed
+// on every load. Compare runs with and without the flag.
+
+new BenchmarkSuite('Create', [1000], [
+  new Benchmark('Create', false, false, 0, Create, Setup, TearDown),
+]);
+
+new BenchmarkSuite('Update', [1000], [
+  new Benchmark('Update', false, false, 0, Update, Setup, TearDown),
+]);
+
+new BenchmarkSuite('ArrayOfObjects', [1000], [
+  new Benchmark('ArrayOfObjects', false, false, 0, ArrayOfObjects, Setup,
+                TearDown),
+]);
+
+var kPointCount = 1000;
+var points;
+var result;
+
+function Point(x, y, z) {
+  this.x = x;
+  this.y = y;
+  this.z = z;
+}
+
+// ----------------------------------------------------------------------------
+
+function Setup() {
+  points = [];
+  for (var i = 0; i < kPointCount; i++) {
+    points.push(new Point(i + 0.5, i + 0.25, i + 0.125));
+  }
+  result = 0;
+}
+
+function TearDown() {
+  points = null;
+  return result !== 0;
+}
+
+// ----------------------------------------------------------------------------
+
+function Create() {
+  var sum = 0;
+  for (var i = 0; i < kPointCount; i++) {
+    var p = new Point(i + 0.5, i * 0.5, 1.5);
+    sum += p.x + p.y + p.z;
+  }
+  result = sum;
+}
+
+function Update() {
+  for (var i = 0; i < kPointCount; i++) {
+    var p = points[i];
+    p.x += 0.5;
+    p.y *= 1.0001;
+    p.z = p.x - p.y;
+  }
+  result = points[0].z;
+}
+
+function ArrayOfObjects() {
+  var sum = 0;
+  for (var i = 0; i < kPointCount; i++) {
+    var p = points[i];
+    sum += p.x * p.x + p.y * p.y + p.z * p.z;
+  }
+  result = sum;
+}
@@ -0,0 +1,74 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+new BenchmarkSuite('ParseObjects', [1000], [
+  new Benchmark('ParseObjects', false, false, 0, ParseObjects,
+                ParseObjectsSetup, TearDown),
+]);
+
+new BenchmarkSuite('ParseStrings', [1000], [
+  new Benchmark('ParseStrings', false, false, 0, ParseStrings,
+                ParseStringsSetup, TearDown),
+]);
+
+new BenchmarkSuite('ParseNumbers', [1000], [
+  new Benchmark('ParseNumbers', false, false, 0, ParseNumbers,
+                ParseNumbersSetup, TearDown),
+]);
+
+var kRecordCount = 200;
+var input;
+var result;
+
+function TearDown() {
+  input = null;
+  return result !== undefined;
+}
+
+// ----------------------------------------------------------------------------
+
+function ParseObjectsSetup() {
+  var records = [];
+  for (var i = 0; i < kRecordCount; i++) {
+    var record = {id: i, name: "record" + i, active: i % 2 == 0};
+    if (i % 3 == 0) record.score = i * 1.5;
+    if (i % 5 == 0) record.tags = ["a", "b"];
+    records.push(record);
+  }
+  input = JSON.stringify(records);
+}
+
+function ParseObjects() {
+  result = JSON.parse(input);
+}
+
+// ----------------------------------------------------------------------------
+
+function ParseStringsSetup() {
+  var text = "The quick brown fox jumps over the lazy dog. ";
+  var strings = [];
+  for (var i = 0; i < kRecordCount; i++) {
+    strings.push(text + i + text + text);
+  }
+  strings.push("with \"escapes\" and \\ backslashes\n");
+  input = JSON.stringify(strings);
+}
+
+function ParseStrings() {
+  result = JSON.parse(input);
+}
+
+// ----------------------------------------------------------------------------
+
+function ParseNumbersSetup() {
+  var numbers = [];
+  for (var i = 0; i < kRecordCount; i++) {
+    numbers.push(i, -i * 1000, i / 7, i * 1e21);
+  }
+  input = JSON.stringify(numbers);
+}
+
+function ParseNumbers() {
+  result = JSON.parse(input);
+}
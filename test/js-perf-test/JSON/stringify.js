@@ -0,0 +1,82 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+new BenchmarkSuite('StringifyObjects', [1000], [
+  new Benchmark('StringifyObjects', false, false, 0, StringifyObjects,
+                StringifyObjectsSetup, StringifyTearDown),
+]);
+
+new BenchmarkSuite('StringifyStrings', [1000], [
+  new Benchmark('StringifyStrings', false, false, 0, StringifyStrings,
+                StringifyStringsSetup, StringifyTearDown),
+]);
+
+new BenchmarkSuite('StringifyNumbers', [1000], [
+  new Benchmark('StringifyNumbers', false, false, 0, StringifyNumbers,
+                StringifyNumbersSetup, StringifyTearDown),
+]);
+
+var kStringifyRecordCount = 200;
+var value;
+var output;
+
+function StringifyTearDown() {
+  value = null;
+  return typeof output === "string";
+}
+
+// ----------------------------------------------------------------------------
+
+function StringifyObjectsSetup() {
+  value = [];
+  for (var i = 0; i < kStringifyRecordCount; i++) {
+    value.push({id: i, name: "record" + i, active: i % 2 == 0,
+                description: "a plain description without escapes " + i});
+  }
+}
+
+function StringifyObjects() {
+  output = JSON.stringify(value);
+}
+
+// ----------------------------------------------------------------------------
+
+function StringifyStringsSetup() {
+  var text = "The quick brown fox jumps over the lazy dog. ";
+  value = [];
+  for (var i = 0; i < kStringifyRecordCount; i++) {
+    value.push(text + i + text + text);
+  }
+  value.push("with \"escapes\" and \\ backslashes\n");
+}
+
+function StringifyStrings() {
+  output = JSON.stringify(value);
+}
+
+// ----------------------------------------------------------------------------
+
+// A few of the shortest representations from test/cctest/gay-shortest.cc.
+var kGayShortestDoubles = [
+  1.3252057186783201350530603e-106, 1.6899223998841386493367055e-33,
+  1.0077972445720390730768089e+138, 9.1867519315348420150084539e+98,
+  2.3806039266050926162811123e-63, 4.5919976932520640180577270e-133,
+  1.7272067615194015698157467e-111
+];
+
+function StringifyNumbersSetup() {
+  value = [];
+  for (var i = 0; i < kStringifyRecordCount; i++) {
+    value.push({
+      id: i,
+      timestamp: 1460000000000 + i * 1009,
+      price: (i * 37) / 100,
+      ratio: kGayShortestDoubles[i % kGayShortestDoubles.length]
+    });
+  }
+}
+
+function StringifyNumbers() {
+  output = JSON.stringify(value);
+}
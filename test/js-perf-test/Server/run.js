@@ -0,0 +1,11 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Usage: d8 --allow-natives-syntax run.js -- [seconds]
+
+load('server.js');
+
+var duration_ms = (arguments.length > 0 ? Number(arguments[0]) : 120) * 1000;
+var requests = RunServer(duration_ms);
+print('Throughput-Server(Score): ' + Math.round(requests * 1000 / duration_ms));
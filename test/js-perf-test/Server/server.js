@@ -0,0 +1,79 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Simulates a long-running server: requests arrive as JSON, are answered
+// through promise chains and leave their results in a bounded Map cache,
+// which keeps a large heap alive while garbage is allocated steadily.
+
+var kCacheSize = 50000;
+var kSessionCount = 1000;
+var kBatchSize = 100;
+
+var cache = new Map();
+var sessions = [];
+var responses = 0;
+
+function Session(id) {
+  this.id = id;
+  this.user = 'user' + id;
+  this.history = [];
+}
+
+function MakeRequest(seq) {
+  return JSON.stringify({
+    seq: seq,
+    session: seq % kSessionCount,
+    path: '/items/' + (seq * 7919 % (kCacheSize * 2)),
+    query: {limit: 10 + seq % 10, tags: ['a', 'b', 'c'].slice(seq % 3)}
+  });
+}
+
+function Lookup(request) {
+  var item = cache.get(request.path);
+  if (item === undefined) {
+    item = {path: request.path, created: request.seq, values: []};
+    for (var i = 0; i < request.query.limit; i++) {
+      item.values.push({index: i, label: request.path + '#' + i});
+    }
+    // Evict the oldest entry, as an LRU cache would.
+    if (cache.size >= kCacheSize) cache.delete(cache.keys().next().value);
+    cache.set(request.path, item);
+  }
+  return item;
+}
+
+function Handle(body) {
+  return Promise.resolve(body)
+      .then(JSON.parse)
+      .then(function(request) {
+        var session = sessions[request.session];
+        session.history.push(request.seq);
+        if (session.history.length > 32) session.history.shift();
+        return {request: request, item: Lookup(request)};
+      })
+      .then(function(state) {
+        return JSON.stringify({
+          seq: state.request.seq,
+          user: sessions[state.request.session].user,
+          values: state.item.values.slice(0, state.request.query.limit),
+          tags: state.request.query.tags
+        });
+      })
+      .then(function(response) {
+        if (response.length > 0) responses++;
+      });
+}
+
+// Serves requests for |duration_ms| milliseconds and returns the number of
+// answered requests.
+function RunServer(duration_ms) {
+  for (var i = 0; i < kSessionCount; i++) sessions.push(new Session(i));
+  var seq = 0;
+  var start = Date.now();
+  while (Date.now() - start < duration_ms) {
+    for (var i = 0; i < kBatchSize; i++) Handle(MakeRequest(seq++));
+    %RunMicrotasks();
+  }
+  return responses;
+}
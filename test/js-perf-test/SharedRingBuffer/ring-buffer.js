@@ -0,0 +1,144 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Sends a stream of small integers to a Worker, once through postMessage
+// (which serializes every message and goes through the Worker's locked
+// queue) and once through a ring buffer in a SharedArrayBuffer.
+
+new BenchmarkSuite('PostMessage', [1000], [
+  new Benchmark('PostMessage', false, false, 0, PostMessage,
+                PostMessageSetup, TearDown),
+]);
+
+new BenchmarkSuite('RingBuffer', [1000], [
+  new Benchmark('RingBuffer', false, false, 0, RingBufferSend,
+                RingBufferSetup, TearDown),
+]);
+
+var kMessageCount = 10000;
+var kCapacity = 1024;
+var kEndOfBatch = -1;
+var kExit = -2;
+
+var worker;
+var ring;
+var result;
+
+function TearDown() {
+  if (ring) ring.Push(kExit);
+  worker.terminate();
+  worker = null;
+  ring = null;
+  return result === kMessageCount * (kMessageCount - 1) / 2;
+}
+
+// A single-producer, single-consumer queue of int32 values in a
+// SharedArrayBuffer. Only the producer writes the head index and only the
+// consumer writes the tail index, so no lock is needed. A side that finds
+// the queue full or empty sleeps on the other side's index, and is only
+// woken if it announced that it is waiting.
+function RingBuffer(sab) {
+  var kHead = 0;
+  var kTail = 1;
+  var kConsumerWaiting = 2;
+  var kProducerWaiting = 3;
+  var kHeaderSize = 4;
+
+  var header = new Int32Array(sab, 0, kHeaderSize);
+  var data = new Int32Array(sab, kHeaderSize * Int32Array.BYTES_PER_ELEMENT);
+  var capacity = data.length;
+  var mask = capacity - 1;
+
+  function Push(value) {
+    var head = Atomics.load(header, kHead);
+    var tail = Atomics.load(header, kTail);
+    while (((head - tail) | 0) === capacity) {
+      Atomics.store(header, kProducerWaiting, 1);
+      Atomics.futexWait(header, kTail, tail);
+      Atomics.store(header, kProducerWaiting, 0);
+      tail = Atomics.load(header, kTail);
+    }
+    data[head & mask] = value;
+    Atomics.store(header, kHead, (head + 1) | 0);
+    if (Atomics.load(header, kConsumerWaiting) !== 0) {
+      Atomics.futexWake(header, kHead, 1);
+    }
+  }
+
+  function Pop() {
+    var tail = Atomics.load(header, kTail);
+    var head = Atomics.load(header, kHead);
+    while (head === tail) {
+      Atomics.store(header, kConsumerWaiting, 1);
+      Atomics.futexWait(header, kHead, head);
+      Atomics.store(header, kConsumerWaiting, 0);
+      head = Atomics.load(header, kHead);
+    }
+    var value = data[tail & mask];
+    Atomics.store(header, kTail, (tail + 1) | 0);
+    if (Atomics.load(header, kProducerWaiting) !== 0) {
+      Atomics.futexWake(header, kTail, 1);
+    }
+    return value;
+  }
+
+  return { Push: Push, Pop: Pop };
+}
+
+// Allocates the four header words followed by |capacity| values, which must
+// be a power of two.
+RingBuffer.New = function(capacity) {
+  return new SharedArrayBuffer((4 + capacity) * Int32Array.BYTES_PER_ELEMENT);
+};
+
+// ----------------------------------------------------------------------------
+
+function PostMessageSetup() {
+  worker = new Worker(
+      `var sum = 0;
+       onmessage = function(value) {
+         if (value === ${kEndOfBatch}) {
+           postMessage(sum);
+           sum = 0;
+         } else {
+           sum += value;
+         }
+       };`);
+}
+
+function PostMessage() {
+  for (var i = 0; i < kMessageCount; i++) worker.postMessage(i);
+  worker.postMessage(kEndOfBatch);
+  result = worker.getMessage();
+}
+
+// ----------------------------------------------------------------------------
+
+function RingBufferSetup() {
+  worker = new Worker(
+      `${RingBuffer}
+       onmessage = function(sab) {
+         var ring = RingBuffer(sab);
+         var sum = 0;
+         for (;;) {
+           var value = ring.Pop();
+           if (value === ${kExit}) return;
+           if (value === ${kEndOfBatch}) {
+             postMessage(sum);
+             sum = 0;
+           } else {
+             sum += value;
+           }
+         }
+       };`);
+  var sab = RingBuffer.New(kCapacity);
+  worker.postMessage(sab, [sab]);
+  ring = RingBuffer(sab);
+}
+
+function RingBufferSend() {
+  for (var i = 0; i < kMessageCount; i++) ring.Push(i);
+  ring.Push(kEndOfBatch);
+  result = worker.getMessage();
+}
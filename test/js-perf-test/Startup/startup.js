@@ -0,0 +1,39 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// A small application whose compilation and first run d8 times with
+// --startup-benchmark. The result of the last expression is the first
+// function result.
+
+function Point(x, y) {
+  this.x = x;
+  this.y = y;
+}
+
+Point.prototype.distance = function(other) {
+  var dx = this.x - other.x;
+  var dy = this.y - other.y;
+  return Math.sqrt(dx * dx + dy * dy);
+};
+
+function Route(points) {
+  this.points = points;
+}
+
+Route.prototype.length = function() {
+  var length = 0;
+  for (var i = 1; i < this.points.length; i++) {
+    length += this.points[i - 1].distance(this.points[i]);
+  }
+  return length;
+};
+
+function Handle(request) {
+  var points = request.points.map(function(p) {
+    return new Point(p[0], p[1]);
+  });
+  return JSON.stringify({length: new Route(points).length()});
+}
+
+Handle(JSON.parse('{"points": [[0, 0], [3, 4], [6, 8]]}'));
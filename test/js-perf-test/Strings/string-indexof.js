@@ -0,0 +1,36 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+new BenchmarkSuite('StringIndexOf', [1000], [
+  new Benchmark('StringIndexOfShortPattern', false, false, 0,
+                IndexOfShortPattern, IndexOfSetup, IndexOfTearDown),
+  new Benchmark('StringIncludesShortPattern', false, false, 0,
+                IncludesShortPattern, IndexOfSetup, IndexOfTearDown),
+]);
+
+
+var indexOfSubject;
+var indexOfResult;
+
+function IndexOfSetup() {
+  var line = "2016-05-10 12:00:00 INFO request served in 12ms ";
+  indexOfSubject = "";
+  for (var i = 0; i < 100; i++) indexOfSubject += line + i + " ";
+  indexOfSubject += "ERROR";
+  indexOfResult = 0;
+}
+
+function IndexOfShortPattern() {
+  indexOfResult += indexOfSubject.indexOf("ERROR");
+  indexOfResult += indexOfSubject.indexOf("in 99");
+}
+
+function IncludesShortPattern() {
+  if (indexOfSubject.includes("WARN")) indexOfResult++;
+  if (indexOfSubject.includes("e 12")) indexOfResult++;
+}
+
+function IndexOfTearDown() {
+  return indexOfResult > 0;
+}
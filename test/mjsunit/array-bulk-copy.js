@@ -0,0 +1,33 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --expose-gc
+
+// Copies of object elements from old into new space and back have to
+// keep the write barrier intact.
+var objects = [];
+for (var i = 0; i < 1000; i++) objects.push({ value: i });
+gc();
+gc();
+
+var slice = objects.slice(10, 900);
+var concat = slice.concat(objects);
+gc();
+assertEquals(890, slice.length);
+assertEquals(1890, concat.length);
+for (var i = 0; i < slice.length; i++) {
+  assertEquals(i + 10, slice[i].value);
+  assertEquals(i + 10, concat[i].value);
+}
+for (var i = 0; i < objects.length; i++) {
+  assertEquals(i, concat[890 + i].value);
+}
+
+// Packed Smis copied into double arrays.
+var smis = [];
+for (var i = 0; i < 1000; i++) smis.push(i - 500);
+var doubles = smis.concat([0.5]);
+assertEquals(1001, doubles.length);
+for (var i = 0; i < smis.length; i++) assertEquals(i - 500, doubles[i]);
+assertEquals(0.5, doubles[1000]);
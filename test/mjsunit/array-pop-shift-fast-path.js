@@ -0,0 +1,143 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Packed and holey Smi and object arrays.
+(function() {
+  var a = [1, 2, 3, 4];
+  assertEquals(4, a.pop());
+  assertEquals(1, a.shift());
+  assertEquals([2, 3], a);
+  assertEquals(2, a.length);
+
+  var o = [{}, "x", 1.5, null];
+  assertEquals(null, o.pop());
+  assertEquals(1.5, o.pop());
+  assertEquals("x", o[1]);
+
+  var h = [1, , 3];
+  assertEquals(3, h.pop());
+  assertEquals(undefined, h.pop());
+  assertEquals(1, h.pop());
+  assertEquals(undefined, h.pop());
+  assertEquals(0, h.length);
+
+  var s = [, 2, , 4];
+  assertEquals(undefined, s.shift());
+  assertEquals(2, s.shift());
+  assertEquals(undefined, s.shift());
+  assertEquals([4], s);
+})();
+
+// Double arrays go through the runtime.
+(function() {
+  var d = [1.5, 2.5, 3.5];
+  assertEquals(3.5, d.pop());
+  assertEquals(1.5, d.shift());
+  assertEquals([2.5], d);
+})();
+
+// Copy-on-write literals must not be modified in place.
+(function() {
+  function literal() { return [1, 2, 3]; }
+  var a = literal();
+  assertEquals(3, a.pop());
+  assertEquals(1, a.shift());
+  assertEquals([1, 2, 3], literal());
+})();
+
+// Queues that shrink and grow again.
+(function() {
+  var q = [];
+  var next = 0;
+  for (var i = 0; i < 1000; i++) {
+    q.push(i);
+    if (i % 3 == 0) assertEquals(next++, q.shift());
+  }
+  while (q.length > 0) assertEquals(next++, q.shift());
+  assertEquals(1000, next);
+  assertEquals(undefined, q.shift());
+
+  var stack = [];
+  for (var i = 0; i < 100; i++) stack.push(i);
+  for (var i = 99; i >= 0; i--) assertEquals(i, stack.pop());
+  assertEquals(undefined, stack.pop());
+})();
+
+// Arrays that have left their initial map.
+(function() {
+  var ro = [1, 2, 3];
+  Object.defineProperty(ro, "length", { writable: false });
+  assertThrows(function() { ro.pop(); }, TypeError);
+  assertThrows(function() { ro.shift(); }, TypeError);
+  assertEquals(3, ro.length);
+
+  var frozen = Object.freeze([1, 2]);
+  assertThrows(function() { frozen.pop(); }, TypeError);
+  assertThrows(function() { frozen.shift(); }, TypeError);
+
+  var props = [1, 2, 3];
+  props.foo = "bar";
+  assertEquals(3, props.pop());
+  assertEquals(1, props.shift());
+  assertEquals("bar", props.foo);
+
+  class MyArray extends Array {}
+  var sub = new MyArray(1, 2, 3);
+  assertEquals(3, sub.pop());
+  assertEquals(1, sub.shift());
+  assertEquals(1, sub.length);
+})();
+
+// Non-array receivers.
+(function() {
+  var obj = { 0: "a", 1: "b", length: 2 };
+  assertEquals("b", Array.prototype.pop.call(obj));
+  assertEquals("a", Array.prototype.shift.call(obj));
+  assertEquals(0, obj.length);
+  assertEquals(undefined, Array.prototype.pop.call(1));
+  assertThrows(function() { Array.prototype.shift.call(null); }, TypeError);
+})();
+
+// Extra arguments are ignored.
+(function() {
+  var a = [1, 2, 3];
+  assertEquals(3, a.pop(10, 20));
+  assertEquals(1, a.shift(10));
+  assertEquals([2], a);
+})();
+
+// Optimized callers.
+(function() {
+  function pop(a) { return a.pop(); }
+  function shift(a) { return a.shift(); }
+  for (var i = 0; i < 3; i++) {
+    assertEquals(3, pop([1, 2, 3]));
+    assertEquals(1, shift([1, 2, 3]));
+  }
+  %OptimizeFunctionOnNextCall(pop);
+  %OptimizeFunctionOnNextCall(shift);
+  assertEquals(3, pop([1, 2, 3]));
+  assertEquals(1, shift([1, 2, 3]));
+  assertEquals(undefined, pop([]));
+  assertEquals(undefined, shift([]));
+})();
+
+// Holes are looked up on the prototype chain.
+(function() {
+  var a = [0, , 2];
+  a.pop();
+  Array.prototype[1] = "proto";
+  assertEquals("proto", a.pop());
+  var b = [, 1];
+  Array.prototype[0] = "zero";
+  assertEquals("zero", b.shift());
+  delete Array.prototype[0];
+  var c = [0, , 2];
+  assertEquals(0, c.shift());
+  assertEquals("proto", c[0]);
+  assertTrue(c.hasOwnProperty(0));
+  delete Array.prototype[1];
+})();
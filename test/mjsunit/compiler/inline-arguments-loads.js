@@ -0,0 +1,108 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo-filter=*
+
+(function TestStrictArgumentsLoads() {
+  function callee() {
+    "use strict";
+    var sum = arguments.length * 100;
+    if (arguments.length > 0) sum += arguments[0];
+    if (arguments.length > 1) sum += arguments[1] * 10;
+    return sum;
+  }
+  function caller() {
+    return callee() + callee(1) + callee(1, 2) + callee(1, 2, 3);
+  }
+  assertEquals(643, caller());
+  assertEquals(643, caller());
+  %OptimizeFunctionOnNextCall(caller);
+  assertEquals(643, caller());
+})();
+
+(function TestStrictArgumentsWithFormalParameters() {
+  function callee(a, b) {
+    "use strict";
+    a = 10;
+    return arguments.length + arguments[0] + (arguments[2] | 0);
+  }
+  function caller() {
+    return callee(1) + callee(1, 2, 3);
+  }
+  assertEquals(9, caller());
+  assertEquals(9, caller());
+  %OptimizeFunctionOnNextCall(caller);
+  assertEquals(9, caller());
+})();
+
+(function TestSloppyArgumentsAliasing() {
+  function callee(a) {
+    a = 10;
+    return arguments.length + arguments[0] + (arguments[1] | 0);
+  }
+  function caller() {
+    return callee(1) + callee(1, 2);
+  }
+  assertEquals(25, caller());
+  assertEquals(25, caller());
+  %OptimizeFunctionOnNextCall(caller);
+  assertEquals(25, caller());
+})();
+
+(function TestArgumentsStores() {
+  function callee() {
+    "use strict";
+    var before = arguments[0];
+    arguments[0] = 5;
+    return before + arguments[0] + arguments.length;
+  }
+  function caller() {
+    return callee(1, 2);
+  }
+  assertEquals(8, caller());
+  assertEquals(8, caller());
+  %OptimizeFunctionOnNextCall(caller);
+  assertEquals(8, caller());
+})();
+
+(function TestArgumentsAfterDeoptimization() {
+  var deopt = false;
+  function callee() {
+    "use strict";
+    var sum = arguments.length + arguments[1];
+    if (deopt) {
+      %DeoptimizeNow();
+      sum += arguments[0];
+    }
+    return sum;
+  }
+  function caller() {
+    return callee(1, 2);
+  }
+  assertEquals(4, caller());
+  assertEquals(4, caller());
+  %OptimizeFunctionOnNextCall(caller);
+  assertEquals(4, caller());
+  deopt = true;
+  assertEquals(5, caller());
+})();
+
+(function TestArgumentsEscape() {
+  var escaped;
+  function callee() {
+    "use strict";
+    var length = arguments.length;
+    escaped = arguments;
+    return length + arguments[0];
+  }
+  function caller() {
+    return callee(1, 2);
+  }
+  assertEquals(3, caller());
+  assertEquals(3, caller());
+  %OptimizeFunctionOnNextCall(caller);
+  assertEquals(3, caller());
+  assertEquals(2, escaped.length);
+  assertEquals(2, escaped[1]);
+})();
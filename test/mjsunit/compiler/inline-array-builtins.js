@@ -0,0 +1,66 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo-filter=* --turbo-inline-array-builtins
+
+(function TestForEach() {
+  var sum;
+  function add(x) { sum += x; }
+  function foo(a) { sum = 0; a.forEach(add); return sum; }
+
+  assertEquals(6, foo([1, 2, 3]));
+  assertEquals(6, foo([1, 2, 3]));
+  %OptimizeFunctionOnNextCall(foo);
+  assertEquals(6, foo([1, 2, 3]));
+  // Holey and double elements.
+  assertEquals(4, foo([1, , 3]));
+  assertEquals(4.5, foo([1.5, 3]));
+})();
+
+(function TestForEachChangesElements() {
+  function foo(a) {
+    var result = [];
+    a.forEach(function(x, i) { if (i == 0) a[2] = 'x'; result.push(x); });
+    return result;
+  }
+
+  assertEquals([1, 2, 'x'], foo([1, 2, 3]));
+  assertEquals([1, 2, 'x'], foo([1, 2, 3]));
+  %OptimizeFunctionOnNextCall(foo);
+  assertEquals([1, 2, 'x'], foo([1, 2, 3]));
+})();
+
+(function TestMap() {
+  function double(x) { return x * 2; }
+  function foo(a) { return a.map(double); }
+
+  assertEquals([2, 4, 6], foo([1, 2, 3]));
+  assertEquals([2, 4, 6], foo([1, 2, 3]));
+  %OptimizeFunctionOnNextCall(foo);
+  assertEquals([2, 4, 6], foo([1, 2, 3]));
+  assertEquals([2, , 6], foo([1, , 3]));
+})();
+
+(function TestFilter() {
+  function odd(x) { return x & 1; }
+  function foo(a) { return a.filter(odd); }
+
+  assertEquals([1, 3], foo([1, 2, 3]));
+  assertEquals([1, 3], foo([1, 2, 3]));
+  %OptimizeFunctionOnNextCall(foo);
+  assertEquals([1, 3], foo([1, 2, 3]));
+  assertEquals([1, 3], foo([1, , 3]));
+})();
+
+(function TestReduce() {
+  function sum(a, b) { return a + b; }
+  function foo(a) { return a.reduce(sum); }
+
+  assertEquals(6, foo([1, 2, 3]));
+  assertEquals(6, foo([1, 2, 3]));
+  %OptimizeFunctionOnNextCall(foo);
+  assertEquals(6, foo([1, 2, 3]));
+  assertEquals('abc', foo(['a', 'b', 'c']));
+  assertThrows(function() { foo([]); }, TypeError);
+})();
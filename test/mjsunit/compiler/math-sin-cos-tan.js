@@ -0,0 +1,23 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+var inputs = [0, -0, 0.5, -0.5, 1, -1, 3, Math.PI / 4, Math.PI / 2,
+              Math.PI, 1e-300, 1e5, -1e5, 1e300, -1e300, NaN,
+              Infinity, -Infinity];
+
+function sin(x) { return Math.sin(x); }
+function cos(x) { return Math.cos(x); }
+function tan(x) { return Math.tan(x); }
+
+[sin, cos, tan].forEach(function(f) {
+  var expected = inputs.map(f);
+  f(1); f(2);
+  %OptimizeFunctionOnNextCall(f);
+  for (var i = 0; i < inputs.length; ++i) {
+    assertTrue(Object.is(expected[i], f(inputs[i])),
+               f.name + "(" + inputs[i] + ")");
+  }
+});
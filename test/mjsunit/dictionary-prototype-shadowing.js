@@ -0,0 +1,46 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Loads through dictionary-mode prototypes must notice properties that are
+// later added to them and shadow the holder.
+function MakeChain() {
+  var top = {foo: "top"};
+  var middle = Object.create(top);
+  middle.a = 1;
+  middle.b = 2;
+  delete middle.a;
+  var bottom = Object.create(middle);
+  bottom.c = 3;
+  bottom.d = 4;
+  delete bottom.c;
+  var receiver = Object.create(bottom);
+  return {top: top, middle: middle, bottom: bottom, receiver: receiver};
+}
+
+function load(o) { return o.foo; }
+
+var chain = MakeChain();
+assertFalse(%HasFastProperties(chain.middle));
+for (var i = 0; i < 5; i++) assertEquals("top", load(chain.receiver));
+chain.middle.foo = "middle";
+assertEquals("middle", load(chain.receiver));
+chain.bottom.foo = "bottom";
+assertEquals("bottom", load(chain.receiver));
+delete chain.bottom.foo;
+assertEquals("middle", load(chain.receiver));
+
+// Accessors added to a dictionary-mode prototype shadow as well.
+chain = MakeChain();
+for (var i = 0; i < 5; i++) assertEquals("top", load(chain.receiver));
+Object.defineProperty(chain.middle, "foo", {get: function() { return 42; }});
+assertEquals(42, load(chain.receiver));
+
+// Non-existent loads.
+function loadMissing(o) { return o.missing; }
+chain = MakeChain();
+for (var i = 0; i < 5; i++) assertEquals(undefined, loadMissing(chain.receiver));
+chain.middle.missing = "found";
+assertEquals("found", loadMissing(chain.receiver));
@@ -0,0 +1,112 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Map.prototype.get, Map.prototype.has and Set.prototype.has look up Smi and
+// hashed String keys without calling into the runtime.
+
+function TestLookup(keys, lookalikes) {
+  var map = new Map;
+  var set = new Set;
+  for (var i = 0; i < keys.length; i++) {
+    map.set(keys[i], i);
+    set.add(keys[i]);
+  }
+  for (var i = 0; i < keys.length; i++) {
+    assertEquals(i, map.get(keys[i]));
+    assertTrue(map.has(keys[i]));
+    assertTrue(set.has(keys[i]));
+    assertEquals(i, map.get(lookalikes[i]));
+    assertTrue(map.has(lookalikes[i]));
+    assertTrue(set.has(lookalikes[i]));
+  }
+  for (var i = 0; i < keys.length; i += 2) {
+    map.delete(keys[i]);
+    set.delete(keys[i]);
+  }
+  for (var i = 0; i < keys.length; i++) {
+    var present = (i % 2) == 1;
+    assertEquals(present ? i : undefined, map.get(lookalikes[i]));
+    assertEquals(present, map.has(lookalikes[i]));
+    assertEquals(present, set.has(lookalikes[i]));
+  }
+}
+
+var smis = [];
+var numbers = [];
+for (var i = -50; i < 50; i++) {
+  smis.push(i * 7);
+  // Integral HeapNumbers and Smis are the same key.
+  numbers.push(%AllocateHeapNumber() + i * 7);
+}
+TestLookup(smis, smis);
+TestLookup(numbers, smis);
+TestLookup(smis, numbers);
+
+var strings = [];
+var copies = [];
+for (var i = 0; i < 100; i++) {
+  strings.push("key" + i);
+  // Flattened cons strings that are not internalized.
+  var copy = ["k", "ey", i].join("");
+  copies.push(copy);
+}
+TestLookup(strings, copies);
+TestLookup(copies, strings);
+
+var objects = [];
+for (var i = 0; i < 100; i++) objects.push({ i: i });
+TestLookup(objects, objects);
+
+var others = [1.5, -0.25, NaN, undefined, null, true, false, Symbol("s"),
+              Symbol.iterator, "", -0];
+var other_lookalikes = [3 / 2, -1 / 4, 0 / 0, undefined, null, true, false];
+other_lookalikes = other_lookalikes.concat(others.slice(7, 10), [0]);
+TestLookup(others, other_lookalikes);
+
+(function TestMisses() {
+  var map = new Map([[1, "one"], ["1", "string one"]]);
+  var set = new Set([1, "1"]);
+  assertEquals("one", map.get(1));
+  assertEquals("string one", map.get("1"));
+  assertEquals(undefined, map.get(2));
+  assertEquals(undefined, map.get("2"));
+  assertEquals(undefined, map.get({}));
+  assertFalse(map.has(1.5));
+  assertFalse(set.has(2));
+  assertFalse(set.has("2"));
+  assertFalse(set.has({}));
+})();
+
+(function TestIncompatibleReceivers() {
+  var map_get = Map.prototype.get;
+  var map_has = Map.prototype.has;
+  var set_has = Set.prototype.has;
+  var receivers = [1, "x", {}, new Set, new WeakMap, undefined];
+  for (var receiver of receivers) {
+    assertThrows(function() { map_get.call(receiver, 1); }, TypeError);
+    assertThrows(function() { map_has.call(receiver, "x"); }, TypeError);
+  }
+  assertThrows(function() { set_has.call(new Map, 1); }, TypeError);
+  assertThrows(function() { set_has.call([], 1); }, TypeError);
+})();
+
+(function TestProperties() {
+  assertEquals(1, Map.prototype.get.length);
+  assertEquals(1, Map.prototype.has.length);
+  assertEquals(1, Set.prototype.has.length);
+  assertEquals("get", Map.prototype.get.name);
+  assertFalse(Object.getOwnPropertyDescriptor(Map.prototype, "get").enumerable);
+  assertFalse(Object.getOwnPropertyDescriptor(Set.prototype, "has").enumerable);
+  assertSame(Map, Map.prototype.constructor);
+  assertSame(Set, Set.prototype.constructor);
+})();
+
+(function TestSubclass() {
+  class MyMap extends Map {}
+  var map = new MyMap([["a", 1]]);
+  assertEquals(1, map.get("a"));
+  assertTrue(map.has("a"));
+})();
@@ -0,0 +1,78 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Consecutive microtasks of one native context run in a single batch. The
+// batch must keep the order, the exception handling and the context of
+// running the microtasks one at a time.
+
+var log = [];
+
+(function TestOrderWithExceptions() {
+  log = [];
+  for (var i = 0; i < 10; i++) {
+    (function(i) {
+      %EnqueueMicrotask(function() {
+        log.push(i);
+        if (i % 3 == 0) throw new Error("microtask " + i);
+      });
+    })(i);
+  }
+  %RunMicrotasks();
+  assertEquals([0, 1, 2, 3, 4, 5, 6, 7, 8, 9], log);
+})();
+
+(function TestNestedMicrotasksRunAfterTheBatch() {
+  log = [];
+  %EnqueueMicrotask(function() {
+    log.push("a");
+    %EnqueueMicrotask(function() { log.push("nested"); });
+  });
+  %EnqueueMicrotask(function() { log.push("b"); });
+  %RunMicrotasks();
+  assertEquals(["a", "b", "nested"], log);
+})();
+
+(function TestPromiseChains() {
+  log = [];
+  var resolvers = [];
+  for (var i = 0; i < 5; i++) {
+    (function(i) {
+      new Promise(function(resolve) { resolvers.push(resolve); })
+          .then(function(v) { log.push("first " + v); return v; })
+          .then(function(v) { log.push("second " + v); throw v; })
+          .catch(function(v) { log.push("caught " + v); });
+    })(i);
+  }
+  for (var i = 0; i < resolvers.length; i++) resolvers[i](i);
+  %RunMicrotasks();
+  assertEquals(15, log.length);
+  for (var i = 0; i < 5; i++) {
+    assertEquals("first " + i, log[i]);
+    assertEquals("second " + i, log[5 + i]);
+    assertEquals("caught " + i, log[10 + i]);
+  }
+})();
+
+(function TestCrossRealm() {
+  var realm = Realm.create();
+  Realm.shared = [];
+  var enqueue_in_realm = Realm.eval(realm,
+      "(function(tag) {" +
+      "  %EnqueueMicrotask(function() {" +
+      "    Realm.shared.push(tag);" +
+      "  });" +
+      "})");
+  var enqueue_here = function(tag) {
+    %EnqueueMicrotask(function() { Realm.shared.push(tag); });
+  };
+  enqueue_here("here1");
+  enqueue_in_realm("realm1");
+  enqueue_in_realm("realm2");
+  enqueue_here("here2");
+  enqueue_here("here3");
+  %RunMicrotasks();
+  assertEquals(["here1", "realm1", "realm2", "here2", "here3"], Realm.shared);
+})();
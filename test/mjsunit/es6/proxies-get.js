@@ -102,6 +102,41 @@
   assertSame(undefined, proxy.key4);
 })();
 
+(function testInvariantOnOrdinaryTargets() {
+  var handler = { get: function(t, p) { return "value" } };
+
+  // Configurable and writable properties do not constrain the result.
+  var target = { key: "other", 0: "other" };
+  Object.defineProperty(target, "writable", {
+    configurable: false, writable: true, value: "other"
+  });
+  var proxy = new Proxy(target, handler);
+  assertEquals("value", proxy.key);
+  assertEquals("value", proxy[0]);
+  assertEquals("value", proxy.writable);
+
+  // Non-configurable, non-writable properties, named or indexed, must match.
+  Object.defineProperty(target, "same", {
+    configurable: false, writable: false, value: "value"
+  });
+  Object.defineProperty(target, 1, {
+    configurable: false, writable: false, value: "other"
+  });
+  assertEquals("value", proxy.same);
+  assertThrows(function() { proxy[1] }, TypeError);
+  Object.freeze(target);
+  assertThrows(function() { proxy.key }, TypeError);
+  assertThrows(function() { proxy[0] }, TypeError);
+  assertEquals("value", proxy.missing);
+
+  // Indices of string wrappers are non-configurable and non-writable.
+  proxy = new Proxy(new String("ab"), handler);
+  assertThrows(function() { proxy[0] }, TypeError);
+  assertEquals("value", proxy[2]);
+  proxy = new Proxy(new String("value"), { get: function() { return "v" } });
+  assertEquals("v", proxy[0]);
+})();
+
 (function testGetInternalIterators() {
   var log = [];
   var array = [1,2,3,4,5]
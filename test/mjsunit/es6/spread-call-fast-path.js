@@ -0,0 +1,69 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Spreading a single array skips iteration only while that is not
+// observable.
+
+function args() { return Array.prototype.slice.call(arguments); }
+function forward(...rest) { return args(...rest); }
+
+assertEquals([1, 2, 3], args(...[1, 2, 3]));
+assertEquals([1.5, 2.5], args(...[1.5, 2.5]));
+assertEquals(['a', {}], args(...['a', {}]));
+assertEquals([1, undefined, 3], args(...[1, , 3]));
+assertEquals([], args(...[]));
+assertEquals([1, 2, 3], forward(1, 2, 3));
+assertEquals([1, 2], new (function(a, b) { this.v = [a, b]; })(...[1, 2]).v);
+
+// Holes read through the prototype chain.
+Array.prototype[1] = 'proto';
+assertEquals([1, 'proto', 3], args(...[1, , 3]));
+delete Array.prototype[1];
+
+// An own iterator on the array.
+var own = [1, 2, 3];
+own[Symbol.iterator] = function*() { yield 'own'; };
+assertEquals(['own'], args(...own));
+
+// Subclasses of Array with their own iterator.
+class MyArray extends Array {
+  *[Symbol.iterator]() { yield 'sub'; }
+}
+assertEquals(['sub'], args(...MyArray.from([1, 2])));
+
+// A modified %ArrayIteratorPrototype%.next.
+var ArrayIteratorPrototype = Object.getPrototypeOf([][Symbol.iterator]());
+var next = ArrayIteratorPrototype.next;
+ArrayIteratorPrototype.next = function() {
+  var result = next.call(this);
+  if (!result.done) result.value *= 2;
+  return result;
+};
+assertEquals([2, 4], args(...[1, 2]));
+ArrayIteratorPrototype.next = next;
+assertEquals([1, 2], args(...[1, 2]));
+
+// next as an accessor is not called while checking for the fast path.
+var calls = 0;
+Object.defineProperty(ArrayIteratorPrototype, 'next', {
+  get: function() { calls++; return next; }, configurable: true
+});
+assertEquals([1, 2], args(...[1, 2]));
+assertEquals(1, calls);
+Object.defineProperty(ArrayIteratorPrototype, 'next', {
+  value: next, writable: true, configurable: true
+});
+
+// A modified Array.prototype[Symbol.iterator].
+var values = Array.prototype[Symbol.iterator];
+Array.prototype[Symbol.iterator] = function*() { yield 'modified'; };
+assertEquals(['modified'], args(...[1, 2]));
+assertEquals(['modified'], forward(1, 2));
+Array.prototype[Symbol.iterator] = values;
+assertEquals([1, 2], args(...[1, 2]));
+
+// Non-arrays are still iterated.
+assertEquals(['a', 'b'], args(...'ab'));
+assertEquals([1, 2], args(...new Set([1, 2])));
+assertThrows(function() { args(...undefined); }, TypeError);
@@ -43,3 +43,14 @@ for (var constructor of typedArrayConstructors) {
   Array.prototype.fill.call(a, 4);
   assertArrayEquals([a[0], a[1]], [4, 3]);
 }
+
+// The value is converted to a number once, before the indices.
+var log = [];
+var value = { valueOf: function() { log.push("value"); return 300.7; } };
+var start = { valueOf: function() { log.push("start"); return 1; } };
+assertArrayEquals([0, 44, 44], Array.from(new Uint8Array(3).fill(value, start)));
+assertEquals(["value", "start"], log);
+assertArrayEquals([0, 255, 255],
+                  Array.from(new Uint8ClampedArray(3).fill(value, start)));
+assertArrayEquals([NaN, NaN], Array.from(new Float64Array(2).fill("x")));
+assertArrayEquals([-1, -1], Array.from(new Int16Array(2).fill(65535)));
@@ -0,0 +1,40 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Setting a typed array from a typed array of a different type converts
+// each element as if it was stored through [[Set]].
+var source = new Float64Array([1.5, -1.5, 256, -0, NaN, 1e10]);
+
+var u8 = new Uint8Array(6);
+u8.set(source);
+assertArrayEquals([1, 255, 0, 0, 0, 0], Array.from(u8));
+
+var clamped = new Uint8ClampedArray(6);
+clamped.set(source);
+assertArrayEquals([2, 0, 255, 0, 0, 255], Array.from(clamped));
+
+var i32 = new Int32Array(7);
+i32.set(source, 1);
+assertArrayEquals([0, 1, -1, 256, 0, 0, 1410065408], Array.from(i32));
+
+var f32 = new Float32Array(3);
+f32.set(new Int32Array([1, -2, 16777217]));
+assertArrayEquals([1, -2, 16777216], Array.from(f32));
+
+// Overlapping typed arrays of different types over the same buffer.
+var buffer = new ArrayBuffer(16);
+var bytes = new Uint8Array(buffer);
+for (var i = 0; i < 16; i++) bytes[i] = i;
+var words = new Uint16Array(buffer, 0, 4);
+words.set(new Uint8Array(buffer, 2, 4));
+assertArrayEquals([2, 3, 4, 5], Array.from(words));
+
+words.set([0x100, 0x302, 0x504, 0x706]);
+new Uint8Array(buffer, 4, 4).set(words);
+assertArrayEquals([0, 2, 4, 6], Array.from(bytes).slice(4, 8));
+
+for (var i = 0; i < 16; i++) bytes[i] = i;
+var doubles = new Float64Array(buffer);
+doubles.set(new Uint8Array(buffer, 0, 2));
+assertArrayEquals([0, 1], Array.from(doubles));
@@ -0,0 +1,54 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+function keys(o) {
+  var result = [];
+  for (var key in o) result.push(key);
+  return result;
+}
+
+var o = {a: 1, b: 2, c: 3, d: 4};
+delete o.b;
+assertFalse(%HasFastProperties(o));
+
+assertEquals(["a", "c", "d"], keys(o));
+assertEquals(["a", "c", "d"], Object.keys(o));
+assertEquals(["a", "c", "d"], keys(o));
+
+// The returned keys must not alias the cached ones.
+var k = Object.keys(o);
+k[0] = "x";
+assertEquals(["a", "c", "d"], Object.keys(o));
+
+o.e = 5;
+assertEquals(["a", "c", "d", "e"], keys(o));
+
+delete o.c;
+assertEquals(["a", "d", "e"], Object.keys(o));
+
+Object.defineProperty(o, "a", {enumerable: false});
+assertEquals(["d", "e"], keys(o));
+
+Object.defineProperty(o, "a", {enumerable: true});
+assertEquals(["a", "d", "e"], keys(o));
+
+// Changing values does not change the keys.
+o.d = 10;
+assertEquals(["a", "d", "e"], keys(o));
+assertEquals(10, o.d);
+
+// Keys of a dictionary copied from a boilerplate stay independent.
+function make() {
+  var p = {x: 1, y: 2, z: 3};
+  delete p.y;
+  return p;
+}
+var p1 = make();
+var p2 = make();
+assertEquals(["x", "z"], keys(p1));
+p2.w = 4;
+assertEquals(["x", "z"], keys(p1));
+assertEquals(["x", "z", "w"], keys(p2));
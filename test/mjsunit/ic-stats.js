@@ -0,0 +1,20 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --ic-stats --allow-natives-syntax
+
+function megamorphicLoad(o) { return o.x; }
+%NeverOptimizeFunction(megamorphicLoad);
+for (var i = 0; i < 10; i++) {
+  var o = { x: i };
+  o["y" + i] = i;
+  assertEquals(i, megamorphicLoad(o));
+}
+
+var stats = %GetAndResetICStats();
+assertTrue(stats.indexOf("LoadIC in megamorphicLoad") >= 0);
+assertTrue(/megamorphicLoad[^\n]*N->N:\d+/.test(stats));
+
+// The statistics are reset after reading them.
+assertFalse(%GetAndResetICStats().indexOf("megamorphicLoad") >= 0);
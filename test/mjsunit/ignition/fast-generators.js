@@ -0,0 +1,75 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --ignition --ignition-fast-generators
+
+function assertIterator(expected, iterator) {
+  for (var i = 0; i < expected.length; i++) {
+    assertEquals({ value: expected[i], done: false }, iterator.next());
+  }
+  assertEquals({ value: undefined, done: true }, iterator.next());
+}
+
+// Temporaries and locals live across a yield.
+function* f1(a) {
+  var b = a + 1;
+  var c = a + (yield b) + b;
+  yield c;
+}
+var g = f1(1);
+assertEquals(2, g.next().value);
+assertEquals(13, g.next(10).value);
+assertEquals(true, g.next().done);
+
+// Yields in loops resume through the loop header dispatch.
+function* f2(n) {
+  for (var i = 0; i < n; i++) {
+    var sum = 0;
+    for (var j = 0; j < i; j++) sum += yield j;
+    yield sum;
+  }
+}
+g = f2(3);
+assertEquals(0, g.next().value);
+assertEquals(0, g.next().value);
+assertEquals(7, g.next(7).value);
+assertEquals(0, g.next().value);
+assertEquals(1, g.next(1).value);
+assertEquals(3, g.next(2).value);
+assertEquals(true, g.next().done);
+
+// Resume modes.
+function* f3() {
+  try {
+    yield 1;
+  } catch (e) {
+    yield e;
+  } finally {
+    yield "finally";
+  }
+}
+g = f3();
+assertEquals(1, g.next().value);
+assertEquals("boom", g.throw("boom").value);
+assertEquals("finally", g.next().value);
+assertEquals(true, g.next().done);
+g = f3();
+assertEquals(1, g.next().value);
+assertEquals("finally", g.return(5).value);
+assertEquals({ value: 5, done: true }, g.next());
+
+// Context allocated variables and closures.
+function* f4(x) {
+  var closure = function() { return x; };
+  x = yield closure();
+  yield closure();
+}
+assertIterator([1, 2], (function() {
+  var it = f4(1);
+  return { next: function() { return it.next(2); } };
+})());
+
+// Iterating with for-of and spreading.
+function* f5() { yield* [1, 2]; yield 3; }
+assertEquals([1, 2, 3], [...f5()]);
@@ -0,0 +1,57 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --ignition --ignition-fuse-bytecodes
+
+function eq(x) { return x == 3; }
+function ne(x) { return x != -3; }
+function eq_strict(x) { return x === 0; }
+function lt(x) { return x < 300; }
+function gt(x) { return x > -200; }
+function lte(x) { return x <= 100000; }
+function gte(x) { return x >= -100000; }
+
+var counter = 0;
+var tracked = { valueOf: function() { counter++; return 3; } };
+
+assertTrue(eq(3));
+assertTrue(eq("3"));
+assertTrue(eq(tracked));
+assertEquals(1, counter);
+assertFalse(eq(undefined));
+assertFalse(eq(NaN));
+
+assertTrue(ne(3));
+assertFalse(ne(-3));
+assertFalse(ne("-3"));
+
+assertTrue(eq_strict(0));
+assertTrue(eq_strict(-0));
+assertFalse(eq_strict("0"));
+assertFalse(eq_strict(false));
+
+assertTrue(lt(299));
+assertFalse(lt(300));
+assertTrue(lt("12"));
+assertFalse(lt(NaN));
+
+assertTrue(gt(-199));
+assertFalse(gt(-200));
+assertTrue(gt(tracked));
+assertEquals(2, counter);
+
+assertTrue(lte(100000));
+assertFalse(lte(100001));
+assertTrue(gte(-100000));
+assertFalse(gte(-100001));
+
+function loop() {
+  var sum = 0;
+  for (var i = 0; i < 10; i++) {
+    if (i === 5) continue;
+    sum += i;
+  }
+  return sum;
+}
+assertEquals(40, loop());
@@ -0,0 +1,47 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --ignition --ignition-lazy-feedback-allocation --allow-natives-syntax
+
+function load(o) { return o.x; }
+function keyed_load(o, k) { return o[k]; }
+function store(o, v) { o.x = v; }
+function keyed_store(o, k, v) { o[k] = v; }
+function global_access() {
+  g = (typeof g == "undefined") ? 1 : g + 1;
+  return g;
+}
+function for_in(o) {
+  var keys = "";
+  for (var k in o) keys += k;
+  return keys;
+}
+
+// Run against the dummy vector first.
+var o = { x: 1, y: 2 };
+assertEquals(1, load(o));
+assertEquals(2, keyed_load(o, "y"));
+store(o, 3);
+assertEquals(3, o.x);
+keyed_store(o, "y", 4);
+assertEquals(4, o.y);
+assertEquals(1, global_access());
+assertEquals("xy", for_in(o));
+assertEquals("xyz", for_in({ x: 0, y: 0, __proto__: { z: 0 } }));
+
+// Warm up until the feedback vectors get allocated.
+for (var i = 0; i < 100000; i++) {
+  assertEquals(3, load(o));
+  assertEquals(4, keyed_load(o, "y"));
+  store(o, 3);
+  keyed_store(o, "y", 4);
+}
+assertEquals(2, global_access());
+assertEquals("xy", for_in(o));
+
+// Optimizing allocates the vector in any case.
+function fresh(o) { return o.y; }
+assertEquals(4, fresh(o));
+%OptimizeFunctionOnNextCall(fresh);
+assertEquals(4, fresh(o));
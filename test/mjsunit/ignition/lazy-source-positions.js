@@ -0,0 +1,53 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --ignition --ignition-lazy-source-positions
+
+function topFrame(e) {
+  var old = Error.prepareStackTrace;
+  Error.prepareStackTrace = function(e, frames) { return frames; };
+  var frames = e.stack;
+  Error.prepareStackTrace = old;
+  return frames[0];
+}
+
+// Top-level code always records expression positions, functions below
+// recover them when the stack trace is captured.
+var expected;
+try {
+  var o = {}; o.x.y;
+} catch (e) {
+  expected = topFrame(e).getColumnNumber();
+}
+
+function load() {
+  var o = {}; o.x.y;
+}
+assertThrows(load, TypeError);
+try {
+  load();
+} catch (e) {
+  assertEquals("load", topFrame(e).getFunctionName());
+  assertEquals(expected, topFrame(e).getColumnNumber());
+}
+
+function outer() {
+  function inner() {
+  var o = {}; o.x.y;
+  }
+  return inner;
+}
+try {
+  outer()();
+} catch (e) {
+  assertEquals("inner", topFrame(e).getFunctionName());
+  assertEquals(expected, topFrame(e).getColumnNumber());
+}
+
+// The recovered positions are also used for the formatted stack.
+try {
+  load();
+} catch (e) {
+  assertTrue(e.stack.indexOf(":" + expected + ")") > 0);
+}
@@ -0,0 +1,54 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --ignition
+
+function load(o) { return o.x; }
+function store(o, v) { o.x = v; }
+
+// Monomorphic field loads and stores.
+var a = { x: 1 };
+for (var i = 0; i < 5; i++) {
+  assertEquals(i + 1, load(a));
+  store(a, i + 2);
+}
+
+// A different map misses and goes polymorphic.
+var b = { y: 0, x: "b" };
+assertEquals("b", load(b));
+store(b, "c");
+assertEquals("c", b.x);
+assertEquals(6, load(a));
+
+// Smi and primitive receivers always take the IC.
+Number.prototype.x = "number";
+assertEquals("number", load(1));
+assertEquals("number", load(1.5));
+assertEquals(undefined, load("str"));
+
+// Changes behind the receiver map are caught by the handler.
+function C() {}
+C.prototype.x = 10;
+var c = new C();
+assertEquals(10, load(c));
+assertEquals(10, load(c));
+C.prototype.x = 20;
+assertEquals(20, load(c));
+Object.defineProperty(C.prototype, "x", { get: function() { return 30; },
+                                          configurable: true });
+assertEquals(30, load(c));
+
+// Transitioning stores.
+function add(o) { o.z = 1; return o; }
+assertEquals(1, add({}).z);
+assertEquals(1, add({}).z);
+var frozen = Object.freeze({});
+add(frozen);
+assertEquals(undefined, frozen.z);
+
+// Setters.
+var s = { set x(v) { this.seen = v; } };
+store(s, 7);
+store(s, 8);
+assertEquals(8, s.seen);
@@ -0,0 +1,60 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --ignition --ignition-osr --turbo-from-bytecode --use-osr
+// Flags: --allow-natives-syntax
+
+function f1(n) {
+  var sum = 0;
+  for (var i = 0; i < n; i++) {
+    if (i == 5) %OptimizeOsr();
+    sum += i;
+  }
+  return sum;
+}
+assertEquals(45, f1(10));
+assertEquals(4950, f1(100));
+
+function f2(n) {
+  var sum = 0;
+  for (var i = 0; i < n; i++) {
+    for (var j = 0; j < n; j++) {
+      if (i == 2 && j == 3) %OptimizeOsr();
+      sum += i * j;
+    }
+  }
+  return sum;
+}
+assertEquals(2025, f2(10));
+
+function f3(o) {
+  var i = 0;
+  do {
+    if (i == 3) %OptimizeOsr();
+    o.x += i;
+  } while (++i < 10);
+  return o.x;
+}
+assertEquals(46, f3({ x: 1 }));
+
+function f4(a) {
+  var result = "";
+  for (var key in a) {
+    if (key == "c") %OptimizeOsr();
+    result += key + a[key];
+  }
+  return result;
+}
+assertEquals("a1b2c3d4", f4({ a: 1, b: 2, c: 3, d: 4 }));
+
+function f5(n) {
+  var context_allocated = 0;
+  var g = function() { return context_allocated; };
+  while (n-- > 0) {
+    if (n == 7) %OptimizeOsr();
+    context_allocated += n;
+  }
+  return g();
+}
+assertEquals(45, f5(10));
@@ -0,0 +1,65 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --ignition --ignition-reo
+
+function sum(a, b, c) { return a + b + c; }
+function call_with_temporaries(x, y) { return sum(x, y * 2, x - y); }
+assertEquals(4, call_with_temporaries(1, 2));
+assertEquals("a4NaN", call_with_temporaries("a", 2));
+
+function swap(a, b) {
+  var t = a;
+  a = b;
+  b = t;
+  return [a, b];
+}
+assertEquals([2, 1], swap(1, 2));
+
+function nested(o) { return o.x.y + o.x.z * o["x"].y; }
+assertEquals(7, nested({ x: { y: 1, z: 6 } }));
+
+function loop(n) {
+  var result = 0;
+  for (var i = 0; i < n; i++) {
+    var t = i * 2;
+    result += t + (t > 4 ? 1 : 0);
+  }
+  return result;
+}
+assertEquals(97, loop(10));
+
+function with_context(x) {
+  var f = function() { return x; };
+  {
+    let x = 10;
+    var g = function() { return x; };
+  }
+  return f() + g();
+}
+assertEquals(15, with_context(5));
+
+function try_finally(x) {
+  var r = 0;
+  try {
+    r = x + 1;
+    if (x > 0) throw r;
+  } catch (e) {
+    r = e * 2;
+  } finally {
+    r += 1;
+  }
+  return r;
+}
+assertEquals(1, try_finally(-1));
+assertEquals(5, try_finally(1));
+
+function* gen(x) {
+  var a = x + 1;
+  var b = yield a;
+  return a + b;
+}
+var g = gen(1);
+assertEquals(2, g.next().value);
+assertEquals(12, g.next(10).value);
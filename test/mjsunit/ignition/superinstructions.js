@@ -0,0 +1,43 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --ignition --ignition-superinstructions
+
+function add_smi(a) { return a + 1; }
+assertEquals(3, add_smi(2));
+assertEquals("a1", add_smi("a"));
+assertEquals(1.5, add_smi(0.5));
+
+function add_locals(a, b) {
+  var x = a;
+  var y = b;
+  return x + y;
+}
+assertEquals(7, add_locals(3, 4));
+assertEquals("34", add_locals("3", 4));
+
+function store_smi() {
+  var a = 1;
+  var b = 2;
+  return a * 10 + b;
+}
+assertEquals(12, store_smi());
+
+function loop(n) {
+  var sum = 0;
+  for (var i = 0; i < n; i++) {
+    sum = sum + i;
+  }
+  return sum;
+}
+assertEquals(45, loop(10));
+
+var count = 0;
+var o = { valueOf: function() { count++; return 5; } };
+function add_object(a) { return a + 1; }
+assertEquals(6, add_object(o));
+assertEquals(1, count);
+
+function add_throws(a) { return a + 1; }
+assertThrows(function() { add_throws(Symbol()); }, TypeError);
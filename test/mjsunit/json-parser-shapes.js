@@ -0,0 +1,44 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Objects of a few shapes sharing key prefixes, so that the maps along the
+// way have several transitions.
+var json = '[' +
+    '{"id":1,"name":"a","tags":[]},' +
+    '{"id":2,"value":1.5},' +
+    '{"id":3,"name":"b","tags":["x"]},' +
+    '{"id":4,"names":"c"},' +
+    '{"id":5,"value":2.5},' +
+    '{"id":6,"nam":"d"},' +
+    '{"i\\u0064":7,"name":"e","tags":[]},' +
+    '{"id":8,"name":"f","tags":[],"extra":true}' +
+    ']';
+var objects = JSON.parse(json);
+
+assertEquals(8, objects.length);
+for (var i = 0; i < objects.length; i++) {
+  assertEquals(i + 1, objects[i].id);
+}
+assertEquals(["id", "name", "tags"], Object.keys(objects[0]));
+assertEquals(["id", "value"], Object.keys(objects[1]));
+assertEquals(["id", "names"], Object.keys(objects[3]));
+assertEquals(["id", "nam"], Object.keys(objects[5]));
+assertEquals(["id", "name", "tags", "extra"], Object.keys(objects[7]));
+assertEquals("c", objects[3].names);
+assertEquals("d", objects[5].nam);
+assertEquals(["x"], objects[2].tags);
+
+assertTrue(%HaveSameMap(objects[0], objects[2]));
+assertTrue(%HaveSameMap(objects[0], objects[6]));
+assertTrue(%HaveSameMap(objects[1], objects[4]));
+assertFalse(%HaveSameMap(objects[0], objects[3]));
+assertFalse(%HaveSameMap(objects[3], objects[5]));
+
+// Parsing the same shapes again reuses the maps.
+var again = JSON.parse(json);
+for (var i = 0; i < objects.length; i++) {
+  assertTrue(%HaveSameMap(objects[i], again[i]));
+}
@@ -0,0 +1,32 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// String bodies of every length, with the special characters at every
+// offset, to cover the word-at-a-time scan and its unaligned head and tail.
+var body = "abcdefghijklmnopqrstuvwxyz0123456789";
+for (var length = 0; length <= body.length; length++) {
+  var s = body.substring(0, length);
+  assertEquals([s], JSON.parse('["' + s + '"]'));
+  assertEquals({v: s}, JSON.parse('{"v":"' + s + '"}'));
+  for (var i = 0; i <= length; i++) {
+    var head = s.substring(0, i);
+    var tail = s.substring(i);
+    assertEquals([head + '"' + tail],
+                 JSON.parse('["' + head + '\\"' + tail + '"]'));
+    assertEquals([head + "\\" + tail],
+                 JSON.parse('["' + head + '\\\\' + tail + '"]'));
+    assertEquals([head + "\n" + tail],
+                 JSON.parse('["' + head + '\\n' + tail + '"]'));
+    assertThrows(function() {
+      JSON.parse('["' + head + '\n' + tail + '"]');
+    }, SyntaxError);
+    assertThrows(function() {
+      JSON.parse('["' + head + '\x01' + tail + '"]');
+    }, SyntaxError);
+  }
+  assertThrows(function() { JSON.parse('["' + s); }, SyntaxError);
+}
+
+// Characters outside ASCII are not special.
+assertEquals(["café ÿ\u0080"], JSON.parse('["café ÿ\u0080"]'));
@@ -0,0 +1,34 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Escapes at every offset around word boundaries.
+var plain = "abcdefghijklmnopqrstuvwxyz0123456789";
+var specials = ['"', '\\', '\n', '\u0001', '\u001f', '\t'];
+var escaped = ['\\"', '\\\\', '\\n', '\\u0001', '\\u001f', '\\t'];
+for (var i = 0; i < 20; i++) {
+  for (var j = 0; j < specials.length; j++) {
+    var s = plain.substring(0, i) + specials[j] + plain.substring(i);
+    var expected =
+        '"' + plain.substring(0, i) + escaped[j] + plain.substring(i) + '"';
+    assertEquals(expected, JSON.stringify(s));
+    assertEquals(s, JSON.parse(JSON.stringify(s)));
+  }
+}
+
+// Characters that do not need escaping are copied unchanged.
+var latin1 = "";
+for (var c = 0x20; c < 0x100; c++) {
+  if (c != 0x22 && c != 0x5c) latin1 += String.fromCharCode(c);
+}
+assertEquals('"' + latin1 + '"', JSON.stringify(latin1));
+
+// Several escapes in a row and at both ends.
+assertEquals('"\\"\\"\\\\"', JSON.stringify('""\\'));
+assertEquals('"\\nabc\\n"', JSON.stringify("\nabc\n"));
+assertEquals('""', JSON.stringify(""));
+
+// Keys and values of objects, and strings in two-byte results.
+assertEquals('{"a\\"b":"c\\nd"}', JSON.stringify({'a"b': "c\nd"}));
+assertEquals('["\\u0002\u1234","x\\\\y"]',
+             JSON.stringify(["\u0002\u1234", "x\\y"]));
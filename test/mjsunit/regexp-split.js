@@ -0,0 +1,79 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Splitting at a regexp, compared against splitting with a sticky copy of
+// the same separator, which takes the generic exec loop.
+
+function StickySplit(subject, pattern, flags, limit) {
+  // A sticky regexp only matches at the search position, so emulate the
+  // unanchored search by trying every position in turn.
+  var separator = new RegExp(pattern, flags + "y");
+  var parts = [];
+  var part_start = 0;
+  if (limit === undefined) limit = 0xffffffff;
+  if (limit === 0) return parts;
+  if (subject.length === 0) {
+    return separator.exec(subject) === null ? [subject] : [];
+  }
+  for (var i = 0; i < subject.length; i++) {
+    separator.lastIndex = i;
+    var match = separator.exec(subject);
+    if (match === null) continue;
+    var end = i + match[0].length;
+    if (end === part_start) continue;
+    parts.push(subject.substring(part_start, i));
+    if (parts.length === limit) return parts;
+    for (var j = 1; j < match.length; j++) {
+      parts.push(match[j]);
+      if (parts.length === limit) return parts;
+    }
+    part_start = end;
+    if (end > i) i = end - 1;
+  }
+  parts.push(subject.substring(part_start));
+  return parts;
+}
+
+function Test(subject, pattern, flags, limit) {
+  var expected = StickySplit(subject, pattern, flags, limit);
+  assertEquals(expected, subject.split(new RegExp(pattern, flags), limit),
+               subject + " / " + pattern + " / " + limit);
+  assertEquals(expected,
+               subject.split(new RegExp(pattern, flags + "y"), limit));
+}
+
+var subjects = ["", "a", "a,b", "a, b,,c ,d", ",a,", "abc", "aXbxCx",
+                "one  two\tthree\n", "\u1234,\u5678,x"];
+var patterns = [",", ",\\s*", "\\s*,\\s*", "", "x", "(,)", "(,)|(x)",
+                "\\s+", "(?:)", "$", "^", "\\b", "[,\\s]", "(\\s)?"];
+for (var i = 0; i < subjects.length; i++) {
+  for (var j = 0; j < patterns.length; j++) {
+    Test(subjects[i], patterns[j], "");
+    Test(subjects[i], patterns[j], "i");
+    Test(subjects[i], patterns[j], "g");
+    Test(subjects[i], patterns[j], "", 2);
+    Test(subjects[i], patterns[j], "", 1);
+  }
+}
+
+Test("aXbxCx", "x", "i");
+Test("a\ud83d\ude00b", "(?:)", "");
+assertEquals(["a", "\ud83d\ude00", "b"], "a\ud83d\ude00b".split(/(?:)/u));
+
+// The last match info reflects the last separator found.
+"a1b2c".split(/(\d)/);
+assertEquals("2", RegExp.$1);
+assertEquals("2", RegExp.lastMatch);
+"a1b2c3".split(/(\d)/, 2);
+assertEquals("1", RegExp.$1);
+"abc".split(/x(y)?/);
+assertEquals("1", RegExp.$1);
+
+// Long subjects fetch matches in several batches.
+var long_subject = "";
+for (var i = 0; i < 1000; i++) long_subject += i + ", ";
+var parts = long_subject.split(/,\s*/);
+assertEquals(1001, parts.length);
+assertEquals("999", parts[999]);
+assertEquals("", parts[1000]);
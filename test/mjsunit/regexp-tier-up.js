@@ -0,0 +1,45 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --regexp-tier-up --regexp-tier-up-ticks=3
+
+// Results must not change when a regexp moves from the interpreter to
+// native code, whichever operation triggers the switch.
+function CheckExec(re, subject, expected) {
+  for (var i = 0; i < 6; i++) {
+    assertEquals(expected, re.exec(subject));
+    re.lastIndex = 0;
+  }
+}
+
+CheckExec(/a(b+)(c)?/, "xxabbbd", ["abbb", "bbb", undefined]);
+CheckExec(/(\d+)-(\d+)/, "on 2016-05", ["2016-05", "2016", "05"]);
+CheckExec(/^$/, "", [""]);
+assertNull(/x/.exec("abc"));
+
+// Two-byte subjects tier up separately from one-byte subjects.
+var re = /(\u03b1+)/;
+for (var i = 0; i < 6; i++) {
+  assertEquals("\u03b1\u03b1", re.exec("x\u03b1\u03b1y")[1]);
+  assertEquals(null, re.exec("xy"));
+}
+
+// Global operations that collect several matches per call.
+var global = /(\w)(\d)/g;
+for (var i = 0; i < 6; i++) {
+  assertEquals("1a2b3c", "a1b2c3".replace(global, "$2$1"));
+  assertEquals(["a1", "b2", "c3"], "a1b2c3".match(global));
+  assertEquals(["", "-", "-", ""], "a1-b2-c3".split(/\w\d/));
+}
+
+// Zero-length matches in global mode.
+for (var i = 0; i < 6; i++) {
+  assertEquals("-a-b-", "ab".replace(/x*/g, "-"));
+}
+
+// Backreferences and case-insensitive matching.
+for (var i = 0; i < 6; i++) {
+  assertTrue(/(a)\1/i.test("xAay"));
+  assertFalse(/(a)\1/.test("xAay"));
+}
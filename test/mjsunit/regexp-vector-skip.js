@@ -0,0 +1,52 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Matches that start at every offset around the vector size, with decoy
+// characters that are only equal to the searched one modulus 128.
+
+function Pad(length, filler) {
+  var result = "";
+  for (var i = 0; i < length; i++) result += filler;
+  return result;
+}
+
+function CheckPrefix(re, needle, filler) {
+  for (var before = 0; before < 40; before++) {
+    for (var after = 0; after < 20; after++) {
+      var subject = Pad(before, filler) + needle + Pad(after, filler);
+      assertEquals(before * filler.length, subject.search(re), subject);
+      assertEquals(-1, (Pad(before, filler) + Pad(after, filler)).search(re));
+    }
+  }
+}
+
+// One-byte subjects, '\xe6' is 'f' + 0x80.
+CheckPrefix(/foo/, "foo", "x");
+CheckPrefix(/foo/, "foo", "\xe6");
+CheckPrefix(/foo/, "foo", "fo\xe6");
+CheckPrefix(/ERROR: \d+/, "ERROR: 42", "-");
+CheckPrefix(/[ab]Z/, "bZ", "a");
+CheckPrefix(/q/i, "Q", "x");
+
+// Two-byte subjects, '\u0166' is 'f' + 0x100.
+CheckPrefix(/foo/, "foo", "\u2000");
+CheckPrefix(/foo/, "foo", "\u0166");
+CheckPrefix(/\u0166oo/, "\u0166oo", "f");
+CheckPrefix(/[ab] /, "a ", "\u0120");
+
+// Global matches resume the scan after the previous match.
+(function() {
+  var subject = Pad(37, "x") + "foo" + Pad(5, "x") + "foo" +
+                Pad(70, "\xe6") + "foo";
+  var re = /foo/g;
+  var indices = [];
+  var match;
+  while ((match = re.exec(subject)) !== null) indices.push(match.index);
+  assertEquals([37, 45, 118], indices);
+})();
+
+(function() {
+  var subject = Pad(37, "\u2000") + "foo" + Pad(70, "x") + "foo";
+  assertEquals(2, subject.match(/foo/g).length);
+})();
@@ -0,0 +1,38 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// An error class can override Error.stackTraceLimit for its instances.
+
+class NoStackError extends Error {}
+NoStackError.stackTraceLimit = 0;
+
+class ShallowError extends Error {}
+ShallowError.stackTraceLimit = 1;
+
+class DefaultError extends Error {}
+
+function outer(E) { return inner(E); }
+function inner(E) { return new E("message"); }
+
+function frames(error) {
+  return error.stack.split("\n").length - 1;
+}
+
+assertEquals(0, frames(outer(NoStackError)));
+assertEquals(1, frames(outer(ShallowError)));
+assertTrue(frames(outer(DefaultError)) >= 2);
+assertTrue(frames(outer(Error)) >= 2);
+
+// The global limit still applies to classes without a limit of their own.
+Error.stackTraceLimit = 1;
+assertEquals(1, frames(outer(DefaultError)));
+assertEquals(0, frames(outer(NoStackError)));
+Error.stackTraceLimit = 10;
+
+// Error.captureStackTrace honors the limit of the object's constructor.
+function LegacyError() { Error.captureStackTrace(this); }
+LegacyError.prototype = Object.create(Error.prototype);
+LegacyError.prototype.constructor = LegacyError;
+LegacyError.stackTraceLimit = 0;
+assertEquals(0, frames(outer(LegacyError)));
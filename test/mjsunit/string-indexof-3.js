@@ -0,0 +1,37 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Short patterns in one-byte subjects, at every offset around word
+// boundaries, with near misses on the first and last character.
+var filler = "xyxyxyxyxyxyxyxyxyxyxyxyxyxyxyxy";
+var patterns = ["ab", "abc", "aba", "aaaa", "a-b-c", "abcdef"];
+for (var p = 0; p < patterns.length; p++) {
+  var pattern = patterns[p];
+  var last = pattern[pattern.length - 1];
+  var near_miss = pattern.substring(0, pattern.length - 1) + "z";
+  for (var i = 0; i < 20; i++) {
+    var subject = filler.substring(0, i) + near_miss + "z" + pattern + filler;
+    var expected = i + near_miss.length + 1;
+    assertEquals(expected, subject.indexOf(pattern), pattern + " at " + i);
+    assertEquals(expected, subject.indexOf(pattern, i), pattern + " from " + i);
+    assertEquals(-1, subject.indexOf(pattern, expected + 1));
+    assertTrue(subject.includes(pattern));
+    assertFalse(filler.substring(0, i).includes(pattern));
+    // Match at the very end of the subject.
+    var at_end = filler.substring(0, i) + pattern;
+    assertEquals(i, at_end.indexOf(pattern));
+  }
+}
+
+// Repeated first and last characters.
+assertEquals(4, "aaaaab".indexOf("ab"));
+assertEquals(3, "aabaaba".indexOf("aaba"));
+assertEquals(-1, "aaaaaaaaaaaaaaaaaaaa".indexOf("ab"));
+assertEquals(0, "abababababababababab".indexOf("abab"));
+assertEquals(16, "abababababababababab".indexOf("abab", 15));
+assertEquals(-1, "abababababababababab".indexOf("abab", 17));
+
+// Latin1 characters above 0x7f.
+assertEquals(10, "\xff\xfe\xff\xfe\xff\xfe\xff\xfe\xff\xfe\xff\xff".indexOf(
+    "\xff\xff"));
@@ -0,0 +1,51 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Builds a rope of |count| pieces that are long enough to make cons strings.
+function MakeRope(piece, count) {
+  var rope = "";
+  for (var i = 0; i < count; i++) rope += piece + i + "|";
+  return rope;
+}
+
+// Single character searches walk the pieces of the rope.
+var piece = "abcdefghijklmnopqrstuvwxyz";
+assertEquals((piece + "0|").length - 1, MakeRope(piece, 20).indexOf("|"));
+assertEquals((piece + "0|" + piece).length,
+             MakeRope(piece, 20).indexOf("1", 40));
+assertEquals(-1, MakeRope(piece, 20).indexOf("#"));
+assertEquals(-1, MakeRope(piece, 20).indexOf("\u1234"));
+assertTrue(MakeRope(piece, 20).includes("9"));
+for (var start = 0; start < 100; start += 7) {
+  var rope = MakeRope(piece, 10);
+  var flat = rope.split("").join("");
+  assertEquals(flat.indexOf("z", start), rope.indexOf("z", start));
+  assertEquals(flat.indexOf("|", start), rope.indexOf("|", start));
+}
+
+// Two-byte pieces in a rope.
+var two_byte = MakeRope("\u03b1\u03b2\u03b3\u03b4\u03b5\u03b6\u03b7", 5) +
+               MakeRope(piece, 5);
+assertEquals(two_byte.split("").join("").indexOf("z"), two_byte.indexOf("z"));
+assertEquals(2, two_byte.indexOf("\u03b3"));
+assertEquals(two_byte.split("").join("").indexOf("\u03b3", 30),
+             two_byte.indexOf("\u03b3", 30));
+
+// Equality and comparison of ropes against flat strings and other ropes.
+var a = MakeRope(piece, 10);
+var b = MakeRope(piece, 10);
+var flat_a = a.split("").join("");
+assertTrue(a == b);
+assertTrue(a == flat_a);
+assertFalse(a == MakeRope(piece, 9) + piece + "9!");
+assertFalse(a < b);
+assertFalse(a > b);
+assertTrue(MakeRope(piece, 9) < a);
+assertTrue(a > MakeRope(piece, 9));
+assertTrue(MakeRope(piece, 10) < MakeRope(piece, 9) + piece + "9}");
+var sorted = [MakeRope(piece, 3) + "b", MakeRope(piece, 3) + "a",
+              MakeRope(piece, 2)].sort();
+assertEquals(MakeRope(piece, 2), sorted[0]);
+assertEquals(MakeRope(piece, 3) + "a", sorted[1]);
+assertEquals(MakeRope(piece, 3) + "b", sorted[2]);
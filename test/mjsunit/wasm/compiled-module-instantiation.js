@@ -0,0 +1,120 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --expose-wasm --expose-gc
+
+load("test/mjsunit/wasm/wasm-constants.js");
+load("test/mjsunit/wasm/wasm-module-builder.js");
+
+var kMemSize = 65536;
+
+function buildModule() {
+  var builder = new WasmModuleBuilder();
+
+  builder.addMemory(1, 1, true);
+  var sig_index = builder.addSignature(kSig_i_ii);
+  builder.addImport("combine", sig_index);
+  builder.addFunction("load", kSig_i_i)
+    .addBody([kExprGetLocal, 0, kExprI32LoadMem, 0, 0])
+    .exportFunc();
+  builder.addFunction("store", kSig_i_ii)
+    .addBody([kExprGetLocal, 0, kExprGetLocal, 1, kExprI32StoreMem, 0, 0])
+    .exportFunc();
+  builder.addFunction("combine", sig_index)
+    .addBody([
+      kExprGetLocal, 0, kExprGetLocal, 1, kExprCallImport, kArity2, 0
+    ])
+    .exportFunc();
+  builder.addFunction("sub", sig_index)
+    .addBody([kExprGetLocal, 0, kExprGetLocal, 1, kExprI32Sub]);
+  builder.addFunction("dispatch", kSig_i_iii)
+    .addBody([
+      kExprGetLocal, 0,
+      kExprGetLocal, 1,
+      kExprGetLocal, 2,
+      kExprCallIndirect, kArity2, sig_index
+    ])
+    .exportFunc();
+  builder.appendToFunctionTable([2, 3]);
+
+  return builder.toBuffer();
+}
+
+var compiled = Wasm.compileModule(buildModule());
+assertEquals("object", typeof compiled);
+
+function instantiate(combine, memory) {
+  var ffi = {combine: combine};
+  if (memory) return Wasm.instantiateModule(compiled, ffi, memory);
+  return Wasm.instantiateModule(compiled, ffi);
+}
+
+(function InstancesHaveTheirOwnMemory() {
+  var a = instantiate(function(x, y) { return x + y | 0; });
+  var b = instantiate(function(x, y) { return x * y | 0; });
+  assertFalse(a.exports.memory === b.exports.memory);
+
+  assertEquals(11, a.exports.store(16, 11));
+  assertEquals(22, b.exports.store(16, 22));
+  assertEquals(11, a.exports.load(16));
+  assertEquals(22, b.exports.load(16));
+  assertEquals(11, new Int32Array(a.exports.memory)[4]);
+  assertEquals(22, new Int32Array(b.exports.memory)[4]);
+
+  assertTraps(kTrapMemOutOfBounds, function() { a.exports.load(kMemSize); });
+  assertTraps(kTrapMemOutOfBounds,
+              function() { b.exports.store(kMemSize - 2, 1); });
+})();
+
+(function InstancesHaveTheirOwnImports() {
+  var a = instantiate(function(x, y) { return x + y | 0; });
+  var b = instantiate(function(x, y) { return x * y | 0; });
+  assertEquals(7, a.exports.combine(3, 4));
+  assertEquals(12, b.exports.combine(3, 4));
+})();
+
+(function InstancesHaveTheirOwnFunctionTable() {
+  var a = instantiate(function(x, y) { return x + y | 0; });
+  var b = instantiate(function(x, y) { return x * y | 0; });
+  assertEquals(7, a.exports.dispatch(0, 3, 4));
+  assertEquals(12, b.exports.dispatch(0, 3, 4));
+  assertEquals(-1, a.exports.dispatch(1, 3, 4));
+  assertEquals(-1, b.exports.dispatch(1, 3, 4));
+  assertTraps(kTrapFuncInvalid, function() { a.exports.dispatch(2, 3, 4); });
+})();
+
+(function InstantiateWithExternalMemory() {
+  var memory = new ArrayBuffer(kMemSize);
+  var a = instantiate(function(x, y) { return x - y | 0; }, memory);
+  assertEquals(memory, a.exports.memory);
+  assertEquals(33, a.exports.store(8, 33));
+  assertEquals(33, new Int32Array(memory)[2]);
+
+  // The code was compiled for one page, so it is compiled again for a larger
+  // memory.
+  var large = new ArrayBuffer(2 * kMemSize);
+  var b = instantiate(function(x, y) { return x - y | 0; }, large);
+  assertEquals(44, b.exports.store(kMemSize + 4, 44));
+  assertEquals(44, b.exports.load(kMemSize + 4));
+  assertTraps(kTrapMemOutOfBounds,
+              function() { b.exports.load(2 * kMemSize); });
+})();
+
+(function ManyInstances() {
+  var instances = [];
+  for (var i = 0; i < 20; i++) {
+    instances.push(instantiate(function(x, y) { return x + y | 0; }));
+    instances[i].exports.store(0, i);
+  }
+  gc();
+  for (var i = 0; i < 20; i++) {
+    assertEquals(i, instances[i].exports.load(0));
+    assertEquals(i + 1, instances[i].exports.combine(i, 1));
+  }
+})();
+
+(function CompileErrors() {
+  assertThrows(function() { Wasm.compileModule(); });
+  assertThrows(function() { Wasm.compileModule(new ArrayBuffer(8)); });
+})();
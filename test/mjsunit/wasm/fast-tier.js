@@ -0,0 +1,53 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --expose-wasm --wasm-fast-tier-body-size=16
+
+load("test/mjsunit/wasm/wasm-constants.js");
+load("test/mjsunit/wasm/wasm-module-builder.js");
+
+var kMemSize = 65536;
+
+// "scan" is large enough for the fast tier, "check" is not, so the two tiers
+// have to call each other.
+(function MixedTiersTest() {
+  var builder = new WasmModuleBuilder();
+
+  builder.addMemory(1, 1, true);
+  builder.addFunction("scan", kSig_i_i)
+    .addBody([
+    // while(i) { if(mem[i]) return -1; i -= 4; } return 0;
+      kExprLoop,
+        kExprGetLocal,0,
+        kExprIf,
+            kExprGetLocal,0,
+          kExprI32LoadMem,0,0,
+          kExprIf,
+            kExprI8Const,255,
+            kExprReturn, kArity1,
+          kExprEnd,
+              kExprGetLocal,0,
+              kExprI8Const,4,
+            kExprI32Sub,
+          kExprSetLocal,0,
+        kExprBr, kArity1, 1,
+        kExprEnd,
+      kExprEnd,
+      kExprI8Const,0
+    ])
+    .exportFunc();
+  builder.addFunction("check", kSig_i_i)
+    .addBody([kExprGetLocal, 0, kExprCallFunction, kArity1, 0])
+    .exportFunc();
+
+  var module = builder.instantiate();
+  var array = new Int32Array(module.exports.memory);
+  assertEquals(0, module.exports.check(kMemSize - 4));
+  array[100] = 1;
+  assertEquals(-1, module.exports.scan(kMemSize - 4));
+  assertEquals(-1, module.exports.check(kMemSize - 4));
+  assertEquals(0, module.exports.check(396));
+  assertEquals(-1, module.exports.check(400));
+  assertThrows(function() { module.exports.scan(kMemSize); });
+})();
@@ -0,0 +1,105 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --expose-wasm --expose-gc --wasm-lazy-compilation
+
+load("test/mjsunit/wasm/wasm-constants.js");
+load("test/mjsunit/wasm/wasm-module-builder.js");
+
+function buildModule() {
+  var builder = new WasmModuleBuilder();
+
+  builder.addMemory(1, 1, true);
+  var sig_index = builder.addSignature(kSig_i_ii);
+  builder.addImport("combine", sig_index);
+  builder.addFunction("load", kSig_i_i)
+    .addBody([kExprGetLocal, 0, kExprI32LoadMem, 0, 0])
+    .exportFunc();
+  builder.addFunction("store", kSig_i_ii)
+    .addBody([kExprGetLocal, 0, kExprGetLocal, 1, kExprI32StoreMem, 0, 0])
+    .exportFunc();
+  builder.addFunction("combine", sig_index)
+    .addBody([
+      kExprGetLocal, 0, kExprGetLocal, 1, kExprCallImport, kArity2, 0
+    ])
+    .exportFunc();
+  builder.addFunction("sub", sig_index)
+    .addBody([kExprGetLocal, 0, kExprGetLocal, 1, kExprI32Sub]);
+  builder.addFunction("dispatch", kSig_i_iii)
+    .addBody([
+      kExprGetLocal, 0,
+      kExprGetLocal, 1,
+      kExprGetLocal, 2,
+      kExprCallIndirect, kArity2, sig_index
+    ])
+    .exportFunc();
+  builder.addFunction("load_twice", kSig_i_i)
+    .addBody([
+      kExprGetLocal, 0, kExprCallFunction, kArity1, 0,
+      kExprGetLocal, 0, kExprCallFunction, kArity1, 0,
+      kExprI32Add
+    ])
+    .exportFunc();
+  builder.appendToFunctionTable([2, 3]);
+
+  return builder.toBuffer();
+}
+
+function add(x, y) { return x + y | 0; }
+function mul(x, y) { return x * y | 0; }
+
+(function CallsThroughAllEntries() {
+  var module = Wasm.instantiateModule(buildModule(), {combine: add});
+
+  // Through the function table, before and after the calls are patched.
+  assertEquals(7, module.exports.dispatch(1, 12, 5));
+  assertEquals(7, module.exports.dispatch(1, 12, 5));
+  assertEquals(17, module.exports.dispatch(0, 12, 5));
+  assertEquals(17, module.exports.combine(12, 5));
+  assertTraps(kTrapFuncInvalid, "module.exports.dispatch(2, 1, 2)");
+
+  // Through a direct call, before the callee is called from JavaScript.
+  assertEquals(3, module.exports.store(8, 3));
+  assertEquals(6, module.exports.load_twice(8));
+  assertEquals(3, module.exports.load(8));
+  assertEquals(6, module.exports.load_twice(8));
+  assertTraps(kTrapMemOutOfBounds, "module.exports.load(65536)");
+})();
+
+(function InstancesCompileTheirOwnCode() {
+  var compiled = Wasm.compileModule(buildModule());
+  var a = Wasm.instantiateModule(compiled, {combine: add});
+  var b = Wasm.instantiateModule(compiled, {combine: mul});
+
+  assertEquals(11, a.exports.store(16, 11));
+  assertEquals(22, b.exports.store(16, 22));
+  gc();
+  assertEquals(11, a.exports.load(16));
+  assertEquals(44, b.exports.load_twice(16));
+  assertEquals(22, b.exports.load(16));
+  assertEquals(9, a.exports.dispatch(0, 4, 5));
+  assertEquals(20, b.exports.dispatch(0, 4, 5));
+})();
+
+(function StartFunctionIsCompiledLazily() {
+  var builder = new WasmModuleBuilder();
+
+  builder.addMemory(1, 1, true);
+  builder.addFunction("store", kSig_v_v)
+    .addBody([kExprI8Const, 4, kExprI8Const, 77, kExprI32StoreMem, 0, 0]);
+  builder.addStart(0);
+
+  var module = builder.instantiate();
+  assertEquals(77, new Int32Array(module.exports.memory)[1]);
+})();
+
+(function InvalidBodiesFailAtInstantiation() {
+  var builder = new WasmModuleBuilder();
+
+  builder.addFunction("main", kSig_i_v)
+    .addBody([kExprI32Add])
+    .exportFunc();
+
+  assertThrows(function() { builder.instantiate(); });
+})();
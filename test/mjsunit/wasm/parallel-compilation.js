@@ -0,0 +1,67 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --expose-wasm --wasm-parallel-compilation --wasm-num-compilation-tasks=10
+
+load("test/mjsunit/wasm/wasm-constants.js");
+load("test/mjsunit/wasm/wasm-module-builder.js");
+
+(function CompileFunctionsTest() {
+  var builder = new WasmModuleBuilder();
+
+  // Each function adds one to the result of the previous one, so the direct
+  // calls between units compiled on different threads have to be linked.
+  builder.addFunction("f0", kSig_i_i)
+    .addBody([kExprGetLocal, 0])
+    .exportFunc();
+  var kNumFunctions = 100;
+  for (var i = 1; i < kNumFunctions; i++) {
+    builder.addFunction("f" + i, kSig_i_i)
+      .addBody([kExprGetLocal, 0,
+                kExprCallFunction, kArity1, i - 1,
+                kExprI32Const, 1,
+                kExprI32Add])
+      .exportFunc();
+  }
+
+  var module = builder.instantiate();
+  assertEquals(5, module.exports.f0(5));
+  var last = module.exports["f" + (kNumFunctions - 1)];
+  assertEquals(kNumFunctions - 1 + 5, last(5));
+})();
+
+(function CompileImportsAndTrapsTest() {
+  var builder = new WasmModuleBuilder();
+  var sig_index = builder.addSignature(kSig_i_i);
+  builder.addImport("add1", sig_index);
+  for (var i = 0; i < 20; i++) {
+    builder.addFunction("call" + i, sig_index)
+      .addBody([kExprGetLocal, 0, kExprCallImport, kArity1, 0])
+      .exportFunc();
+    builder.addFunction("trap" + i, sig_index)
+      .addBody([kExprUnreachable])
+      .exportFunc();
+  }
+
+  var module = builder.instantiate({add1: function(x) { return x + 1; }});
+  for (var i = 0; i < 20; i++) {
+    assertEquals(i + 1, module.exports["call" + i](i));
+    assertThrows(module.exports["trap" + i]);
+  }
+})();
+
+(function CompileErrorTest() {
+  var builder = new WasmModuleBuilder();
+  for (var i = 0; i < 20; i++) {
+    builder.addFunction("ok" + i, kSig_i_i)
+      .addBody([kExprGetLocal, 0])
+      .exportFunc();
+  }
+  // Reads a local that does not exist.
+  builder.addFunction("broken", kSig_i_i)
+    .addBody([kExprGetLocal, 7])
+    .exportFunc();
+
+  assertThrows(function() { builder.instantiate(); });
+})();
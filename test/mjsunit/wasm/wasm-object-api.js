@@ -8,6 +8,7 @@ assertFalse(undefined === Wasm);
 assertFalse(undefined == Wasm);
 assertEquals("function", typeof Wasm.verifyModule);
 assertEquals("function", typeof Wasm.verifyFunction);
+assertEquals("function", typeof Wasm.compileModule);
 assertEquals("function", typeof Wasm.instantiateModule);
 assertEquals("function", typeof Wasm.instantiateModuleFromAsm);
 assertFalse(undefined == Wasm.experimentalVersion);
@@ -0,0 +1,63 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/background-task-budget.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+TEST(BackgroundTaskBudget, GCUsesWholeBudget) {
+  BackgroundTaskBudget budget(4);
+  EXPECT_EQ(4, budget.limit());
+  EXPECT_EQ(0, budget.TryAcquire(BackgroundTaskBudget::kGC, 0));
+  EXPECT_EQ(3, budget.TryAcquire(BackgroundTaskBudget::kGC, 3));
+  EXPECT_EQ(1, budget.TryAcquire(BackgroundTaskBudget::kGC, 3));
+  EXPECT_EQ(0, budget.TryAcquire(BackgroundTaskBudget::kGC, 1));
+  EXPECT_EQ(4, budget.InUse(BackgroundTaskBudget::kGC));
+  budget.Release(BackgroundTaskBudget::kGC, 2);
+  EXPECT_EQ(2, budget.TryAcquire(BackgroundTaskBudget::kGC, 3));
+  budget.Release(BackgroundTaskBudget::kGC, 4);
+  EXPECT_EQ(0, budget.InUse(BackgroundTaskBudget::kGC));
+}
+
+
+TEST(BackgroundTaskBudget, CompilerUsesHalfOfBudget) {
+  BackgroundTaskBudget budget(4);
+  EXPECT_EQ(2, budget.TryAcquire(BackgroundTaskBudget::kCompiler, 3));
+  EXPECT_EQ(0, budget.TryAcquire(BackgroundTaskBudget::kCompiler, 1));
+  EXPECT_EQ(2, budget.TryAcquire(BackgroundTaskBudget::kGC, 3));
+  budget.Release(BackgroundTaskBudget::kCompiler, 2);
+  budget.Release(BackgroundTaskBudget::kGC, 2);
+}
+
+
+TEST(BackgroundTaskBudget, EachClientCanMakeProgress) {
+  BackgroundTaskBudget budget(2);
+  EXPECT_EQ(2, budget.TryAcquire(BackgroundTaskBudget::kGC, 2));
+  // The compiler gets one slot even though the GC holds the whole budget.
+  EXPECT_EQ(1, budget.TryAcquire(BackgroundTaskBudget::kCompiler, 2));
+  EXPECT_EQ(0, budget.TryAcquire(BackgroundTaskBudget::kCompiler, 1));
+  budget.Release(BackgroundTaskBudget::kGC, 2);
+  // The GC can use the budget that is left.
+  EXPECT_EQ(1, budget.TryAcquire(BackgroundTaskBudget::kGC, 2));
+  budget.Release(BackgroundTaskBudget::kCompiler, 1);
+  EXPECT_EQ(1, budget.TryAcquire(BackgroundTaskBudget::kGC, 2));
+  budget.Release(BackgroundTaskBudget::kGC, 2);
+}
+
+
+TEST(BackgroundTaskBudget, SetLimit) {
+  BackgroundTaskBudget budget(8);
+  budget.SetLimit(1);
+  EXPECT_EQ(1, budget.limit());
+  EXPECT_EQ(1, budget.TryAcquire(BackgroundTaskBudget::kCompiler, 2));
+  EXPECT_EQ(1, budget.TryAcquire(BackgroundTaskBudget::kGC, 2));
+  EXPECT_EQ(0, budget.TryAcquire(BackgroundTaskBudget::kGC, 1));
+  budget.Release(BackgroundTaskBudget::kCompiler, 1);
+  budget.Release(BackgroundTaskBudget::kGC, 1);
+}
+
+}  // namespace internal
+}  // namespace v8
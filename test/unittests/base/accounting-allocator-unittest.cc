@@ -0,0 +1,85 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/base/accounting-allocator.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace base {
+
+namespace {
+
+const size_t kPooledSize = AccountingAllocator::kMinPooledSize * 2;
+
+}  // namespace
+
+TEST(AccountingAllocatorTest, TracksMemoryUsage) {
+  AccountingAllocator allocator;
+  void* a = allocator.Allocate(100);
+  void* b = allocator.Allocate(200);
+  EXPECT_EQ(300u, allocator.GetCurrentMemoryUsage());
+  allocator.Free(a, 100);
+  EXPECT_EQ(200u, allocator.GetCurrentMemoryUsage());
+  allocator.Free(b, 200);
+  EXPECT_EQ(0u, allocator.GetCurrentMemoryUsage());
+  EXPECT_EQ(300u, allocator.GetMaxMemoryUsage());
+}
+
+TEST(AccountingAllocatorTest, PoolDisabledByDefault) {
+  AccountingAllocator allocator;
+  allocator.Free(allocator.Allocate(kPooledSize), kPooledSize);
+  EXPECT_EQ(0u, allocator.GetCurrentPoolSize());
+}
+
+TEST(AccountingAllocatorTest, PooledSegmentsAreReused) {
+  AccountingAllocator allocator;
+  allocator.ConfigureSegmentPool(4 * kPooledSize);
+  void* memory = allocator.Allocate(kPooledSize);
+  allocator.Free(memory, kPooledSize);
+  EXPECT_EQ(kPooledSize, allocator.GetCurrentPoolSize());
+  EXPECT_EQ(0u, allocator.GetCurrentMemoryUsage());
+  // A block of another size class does not come from the pool.
+  void* other = allocator.Allocate(2 * kPooledSize);
+  EXPECT_EQ(kPooledSize, allocator.GetCurrentPoolSize());
+  EXPECT_EQ(memory, allocator.Allocate(kPooledSize));
+  EXPECT_EQ(0u, allocator.GetCurrentPoolSize());
+  EXPECT_EQ(3 * kPooledSize, allocator.GetCurrentMemoryUsage());
+  allocator.Free(memory, kPooledSize);
+  allocator.Free(other, 2 * kPooledSize);
+  EXPECT_EQ(3 * kPooledSize, allocator.GetCurrentPoolSize());
+}
+
+TEST(AccountingAllocatorTest, OnlySegmentSizesArePooled) {
+  AccountingAllocator allocator;
+  allocator.ConfigureSegmentPool(4 * AccountingAllocator::kMaxPooledSize);
+  const size_t sizes[] = {AccountingAllocator::kMinPooledSize / 2,
+                          kPooledSize + 8,
+                          AccountingAllocator::kMaxPooledSize * 2};
+  for (size_t size : sizes) {
+    allocator.Free(allocator.Allocate(size), size);
+    EXPECT_EQ(0u, allocator.GetCurrentPoolSize());
+  }
+}
+
+TEST(AccountingAllocatorTest, PoolSizeIsLimited) {
+  AccountingAllocator allocator;
+  allocator.ConfigureSegmentPool(kPooledSize);
+  void* a = allocator.Allocate(kPooledSize);
+  void* b = allocator.Allocate(kPooledSize);
+  allocator.Free(a, kPooledSize);
+  allocator.Free(b, kPooledSize);
+  EXPECT_EQ(kPooledSize, allocator.GetCurrentPoolSize());
+}
+
+TEST(AccountingAllocatorTest, ReleasePoolFreesSegments) {
+  AccountingAllocator allocator;
+  allocator.ConfigureSegmentPool(4 * kPooledSize);
+  allocator.Free(allocator.Allocate(kPooledSize), kPooledSize);
+  EXPECT_EQ(kPooledSize, allocator.GetCurrentPoolSize());
+  allocator.ReleasePool();
+  EXPECT_EQ(0u, allocator.GetCurrentPoolSize());
+}
+
+}  // namespace base
+}  // namespace v8
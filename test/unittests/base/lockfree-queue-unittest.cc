@@ -0,0 +1,229 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/base/lockfree-queue.h"
+
+#include <stdio.h>
+
+#include <queue>
+#include <vector>
+
+#include "src/base/platform/elapsed-timer.h"
+#include "src/base/platform/platform.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace base {
+
+namespace {
+
+// Values encode the producer in the upper and a sequence number in the lower
+// bits.
+const int kSequenceBits = 20;
+
+intptr_t MakeValue(int producer, int sequence) {
+  return (static_cast<intptr_t>(producer) << kSequenceBits) | sequence;
+}
+
+int ProducerOf(intptr_t value) {
+  return static_cast<int>(value >> kSequenceBits);
+}
+
+int SequenceOf(intptr_t value) {
+  return static_cast<int>(value & ((1 << kSequenceBits) - 1));
+}
+
+// A mutex protected queue to compare against.
+class MutexQueue {
+ public:
+  void Enqueue(const intptr_t& value) {
+    LockGuard<Mutex> guard(&mutex_);
+    queue_.push(value);
+  }
+
+  bool Dequeue(intptr_t* value) {
+    LockGuard<Mutex> guard(&mutex_);
+    if (queue_.empty()) return false;
+    *value = queue_.front();
+    queue_.pop();
+    return true;
+  }
+
+ private:
+  Mutex mutex_;
+  std::queue<intptr_t> queue_;
+};
+
+template <typename Queue>
+class ProducerThread final : public Thread {
+ public:
+  ProducerThread(Queue* queue, int id, int count)
+      : Thread(Options("ProducerThread")), queue_(queue), id_(id),
+        count_(count) {}
+
+  void Run() override {
+    for (int i = 0; i < count_; i++) queue_->Enqueue(MakeValue(id_, i));
+  }
+
+ private:
+  Queue* queue_;
+  int id_;
+  int count_;
+};
+
+template <typename Queue>
+class ConsumerThread final : public Thread {
+ public:
+  ConsumerThread(Queue* queue, Atomic32* remaining)
+      : Thread(Options("ConsumerThread")), queue_(queue),
+        remaining_(remaining) {}
+
+  void Run() override {
+    while (NoBarrier_Load(remaining_) > 0) {
+      intptr_t value;
+      if (!queue_->Dequeue(&value)) continue;
+      NoBarrier_AtomicIncrement(remaining_, -1);
+      values_.push_back(value);
+    }
+  }
+
+  const std::vector<intptr_t>& values() const { return values_; }
+
+ private:
+  Queue* queue_;
+  Atomic32* remaining_;
+  std::vector<intptr_t> values_;
+};
+
+// Runs |producers| threads that each enqueue |count| values and |consumers|
+// threads that dequeue them. Returns the values seen by each consumer.
+template <typename Queue>
+std::vector<std::vector<intptr_t> > RunProducersAndConsumers(Queue* queue,
+                                                             int producers,
+                                                             int consumers,
+                                                             int count) {
+  Atomic32 remaining = producers * count;
+  std::vector<ConsumerThread<Queue>*> consumer_threads;
+  for (int i = 0; i < consumers; i++) {
+    consumer_threads.push_back(new ConsumerThread<Queue>(queue, &remaining));
+    consumer_threads.back()->Start();
+  }
+  std::vector<ProducerThread<Queue>*> producer_threads;
+  for (int i = 0; i < producers; i++) {
+    producer_threads.push_back(new ProducerThread<Queue>(queue, i, count));
+    producer_threads.back()->Start();
+  }
+  for (int i = 0; i < producers; i++) {
+    producer_threads[i]->Join();
+    delete producer_threads[i];
+  }
+  std::vector<std::vector<intptr_t> > result;
+  for (int i = 0; i < consumers; i++) {
+    consumer_threads[i]->Join();
+    result.push_back(consumer_threads[i]->values());
+    delete consumer_threads[i];
+  }
+  return result;
+}
+
+}  // namespace
+
+
+TEST(LockFreeQueue, EnqueueDequeue) {
+  LockFreeQueue<int> queue;
+  EXPECT_TRUE(queue.IsEmpty());
+  int value = 0;
+  EXPECT_FALSE(queue.Dequeue(&value));
+  queue.Enqueue(1);
+  queue.Enqueue(2);
+  EXPECT_FALSE(queue.IsEmpty());
+  EXPECT_TRUE(queue.Dequeue(&value));
+  EXPECT_EQ(1, value);
+  EXPECT_TRUE(queue.Dequeue(&value));
+  EXPECT_EQ(2, value);
+  EXPECT_TRUE(queue.IsEmpty());
+  EXPECT_FALSE(queue.Dequeue(&value));
+}
+
+
+TEST(LockFreeQueue, CapacityIsPowerOfTwo) {
+  EXPECT_EQ(LockFreeQueue<int>::kDefaultCapacity,
+            LockFreeQueue<int>().capacity());
+  EXPECT_EQ(8u, LockFreeQueue<int>(5).capacity());
+  EXPECT_EQ(2u, LockFreeQueue<int>(0).capacity());
+}
+
+
+TEST(LockFreeQueue, Overflow) {
+  LockFreeQueue<int> queue(4);
+  // Wrap around the ring buffer a few times, overflowing it each time.
+  for (int round = 0; round < 3; round++) {
+    for (int i = 0; i < 10; i++) queue.Enqueue(i);
+    // Values enqueued while the overflow list is not empty do not overtake
+    // it, even after the ring buffer has room again.
+    int value;
+    EXPECT_TRUE(queue.Dequeue(&value));
+    EXPECT_EQ(0, value);
+    queue.Enqueue(10);
+    for (int i = 1; i <= 10; i++) {
+      EXPECT_TRUE(queue.Dequeue(&value));
+      EXPECT_EQ(i, value);
+    }
+    EXPECT_TRUE(queue.IsEmpty());
+  }
+}
+
+
+TEST(LockFreeQueue, MultipleProducersAndConsumers) {
+  const int kProducers = 4;
+  const int kConsumers = 4;
+  const int kCount = 10000;
+  // A small ring buffer also exercises the overflow list.
+  LockFreeQueue<intptr_t> queue(16);
+  std::vector<std::vector<intptr_t> > values =
+      RunProducersAndConsumers(&queue, kProducers, kConsumers, kCount);
+  std::vector<int> seen(kProducers * kCount, 0);
+  for (size_t i = 0; i < values.size(); i++) {
+    // Each consumer sees the values of a producer in order.
+    std::vector<int> last(kProducers, -1);
+    for (intptr_t value : values[i]) {
+      int producer = ProducerOf(value);
+      int sequence = SequenceOf(value);
+      ASSERT_LE(0, producer);
+      ASSERT_LT(producer, kProducers);
+      EXPECT_LT(last[producer], sequence);
+      last[producer] = sequence;
+      seen[producer * kCount + sequence]++;
+    }
+  }
+  for (int count : seen) EXPECT_EQ(1, count);
+  EXPECT_TRUE(queue.IsEmpty());
+}
+
+
+// Compares the throughput with a mutex protected queue. Run with
+// --gtest_also_run_disabled_tests.
+TEST(LockFreeQueue, DISABLED_Benchmark) {
+  const int kCount = 200000;
+  for (int threads = 1; threads <= 4; threads *= 2) {
+    ElapsedTimer timer;
+    {
+      MutexQueue queue;
+      timer.Start();
+      RunProducersAndConsumers(&queue, threads, threads, kCount);
+    }
+    double mutex_ms = timer.Elapsed().InMillisecondsF();
+    {
+      LockFreeQueue<intptr_t> queue;
+      timer.Restart();
+      RunProducersAndConsumers(&queue, threads, threads, kCount);
+    }
+    double lock_free_ms = timer.Elapsed().InMillisecondsF();
+    printf("%d producers and consumers: mutex %.1f ms, lock-free %.1f ms\n",
+           threads, mutex_ms, lock_free_ms);
+  }
+}
+
+}  // namespace base
+}  // namespace v8
@@ -34,6 +34,33 @@ TEST(OS, GetCurrentProcessId) {
 }
 
 
+TEST(OS, MemoryMappedFileReadOnly) {
+  const char kFileName[] = "memory-mapped-file-read-only.bin";
+  char contents[] = "startup data";
+  OS::MemoryMappedFile* file =
+      OS::MemoryMappedFile::create(kFileName, sizeof(contents), contents);
+  ASSERT_TRUE(file != nullptr);
+  delete file;
+
+  file = OS::MemoryMappedFile::open(
+      kFileName, OS::MemoryMappedFile::FileMode::kReadOnly);
+  ASSERT_TRUE(file != nullptr);
+  EXPECT_EQ(sizeof(contents), file->size());
+  EXPECT_STREQ(contents, static_cast<const char*>(file->memory()));
+  delete file;
+  EXPECT_TRUE(OS::Remove(kFileName));
+}
+
+
+TEST(OS, NumaNodes) {
+  int node_count = OS::GetNumaNodeCount();
+  EXPECT_LE(1, node_count);
+  int node = OS::GetCurrentNumaNode();
+  EXPECT_LE(0, node);
+  EXPECT_LT(node, node_count);
+}
+
+
 namespace {
 
 class ThreadLocalStorageTest : public Thread, public ::testing::Test {
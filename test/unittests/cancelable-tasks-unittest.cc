@@ -214,5 +214,83 @@ TEST(CancelableTask, RemoveUnmanagedId) {
   EXPECT_FALSE(manager.TryAbort(3));
 }
 
+
+TEST(CancelableTask, TryAbortAll) {
+  CancelableTaskManager manager;
+  ResultType result1 = 0;
+  ResultType result2 = 0;
+  TestTask* task1 = new TestTask(&manager, &result1);
+  TestTask* task2 = new TestTask(&manager, &result2, TestTask::kCheckNotRun);
+  SequentialRunner runner1(task1);
+  SequentialRunner runner2(task2);
+  runner1.Run();
+  EXPECT_EQ(GetValue(&result1), 1);
+  EXPECT_TRUE(manager.TryAbortAll());
+  runner2.Run();
+  EXPECT_EQ(GetValue(&result2), 0);
+  manager.CancelAndWait();
+}
+
+
+TEST(CancelableTask, TryAbortAllWithRunningTask) {
+  CancelableTaskManager manager;
+  ResultType result1 = 0;
+  TestTask* task1 =
+      new TestTask(&manager, &result1, TestTask::kWaitTillCanceledAgain);
+  ThreadedRunner runner1(task1);
+  runner1.Start();
+  while (GetValue(&result1) == 0) {
+  }
+  // The running task cannot be aborted, but it is told so.
+  EXPECT_FALSE(manager.TryAbortAll());
+  runner1.Join();
+  EXPECT_TRUE(manager.TryAbortAll());
+  manager.CancelAndWait();
+}
+
+
+TEST(CancelableTask, GroupsHaveTheirOwnIds) {
+  CancelableTaskManager manager;
+  CancelableTaskManager group(&manager);
+  ResultType result1 = 0;
+  ResultType result2 = 0;
+  TestTask* task1 = new TestTask(&manager, &result1, TestTask::kCheckNotRun);
+  TestTask* task2 = new TestTask(&group, &result2, TestTask::kCheckNotRun);
+  SequentialRunner runner1(task1);
+  SequentialRunner runner2(task2);
+  EXPECT_EQ(task1->id(), 1u);
+  EXPECT_EQ(task2->id(), 1u);
+  // Aborting the group's tasks leaves the other tasks alone.
+  EXPECT_TRUE(group.TryAbortAll());
+  EXPECT_TRUE(manager.TryAbort(1));
+  runner1.Run();
+  runner2.Run();
+  group.CancelAndWait();
+  manager.CancelAndWait();
+}
+
+
+TEST(CancelableTask, CancelAndWaitCancelsGroups) {
+  CancelableTaskManager manager;
+  CancelableTaskManager group(&manager);
+  ResultType result1 = 0;
+  ResultType result2 = 0;
+  TestTask* task1 = new TestTask(&group, &result1, TestTask::kCheckNotRun);
+  TestTask* task2 =
+      new TestTask(&group, &result2, TestTask::kWaitTillCanceledAgain);
+  ThreadedRunner runner1(task1);
+  ThreadedRunner runner2(task2);
+  runner2.Start();
+  while (GetValue(&result2) == 0) {
+  }
+  // Cancels {task1} and waits for {task2} through the group.
+  manager.CancelAndWait();
+  runner1.Start();
+  runner1.Join();
+  runner2.Join();
+  EXPECT_EQ(GetValue(&result1), 0);
+  EXPECT_EQ(GetValue(&result2), 2);
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -0,0 +1,103 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/access-builder.h"
+#include "src/compiler/allocation-folding.h"
+#include "src/compiler/js-graph.h"
+#include "src/compiler/js-operator.h"
+#include "src/compiler/machine-operator.h"
+#include "src/compiler/simplified-operator.h"
+#include "test/unittests/compiler/graph-unittest.h"
+#include "test/unittests/compiler/node-test-utils.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class AllocationFoldingTest : public GraphTest {
+ public:
+  AllocationFoldingTest()
+      : GraphTest(3),
+        javascript_(zone()),
+        machine_(zone()),
+        simplified_(zone()),
+        jsgraph_(isolate(), graph(), common(), &javascript_, &simplified_,
+                 &machine_) {}
+  ~AllocationFoldingTest() override {}
+
+ protected:
+  Reduction Reduce(Node* node) {
+    // TODO(titzer): mock the GraphReducer here for better unit testing.
+    GraphReducer graph_reducer(zone(), graph());
+    AllocationFolding reducer(&graph_reducer, jsgraph());
+    return reducer.Reduce(node);
+  }
+
+  Matcher<Node*> IsIntPtrConstant(int value) {
+    return kPointerSize == 4 ? IsInt32Constant(value) : IsInt64Constant(value);
+  }
+
+  JSGraph* jsgraph() { return &jsgraph_; }
+  SimplifiedOperatorBuilder* simplified() { return &simplified_; }
+
+ private:
+  JSOperatorBuilder javascript_;
+  MachineOperatorBuilder machine_;
+  SimplifiedOperatorBuilder simplified_;
+  JSGraph jsgraph_;
+};
+
+
+TEST_F(AllocationFoldingTest, AllocateSeparatedByStoreField) {
+  Node* value = Parameter(0);
+  Node* effect = graph()->start();
+  Node* control = graph()->start();
+
+  Node* allocate1 = graph()->NewNode(simplified()->Allocate(),
+                                     NumberConstant(16), effect, control);
+  Node* store = graph()->NewNode(simplified()->StoreField(
+                                     AccessBuilder::ForMap()),
+                                 allocate1, value, allocate1, control);
+  Node* allocate2 = graph()->NewNode(simplified()->Allocate(),
+                                     NumberConstant(24), store, control);
+  Reduction r = Reduce(allocate2);
+  ASSERT_TRUE(r.Changed());
+  EXPECT_THAT(allocate1->InputAt(0), IsNumberConstant(40));
+  ASSERT_EQ(IrOpcode::kBitcastWordToTagged, r.replacement()->opcode());
+  Node* inner = r.replacement()->InputAt(0);
+  EXPECT_EQ(allocate1, inner->InputAt(0));
+  EXPECT_THAT(inner->InputAt(1), IsIntPtrConstant(16));
+}
+
+
+TEST_F(AllocationFoldingTest, AllocateWithDifferentPretenureFlags) {
+  Node* effect = graph()->start();
+  Node* control = graph()->start();
+
+  Node* allocate1 = graph()->NewNode(simplified()->Allocate(TENURED),
+                                     NumberConstant(16), effect, control);
+  Node* allocate2 = graph()->NewNode(simplified()->Allocate(NOT_TENURED),
+                                     NumberConstant(24), allocate1, control);
+  Reduction r = Reduce(allocate2);
+  ASSERT_FALSE(r.Changed());
+  EXPECT_THAT(allocate1->InputAt(0), IsNumberConstant(16));
+}
+
+
+TEST_F(AllocationFoldingTest, AllocateWithNonConstantSize) {
+  Node* size = Parameter(0);
+  Node* effect = graph()->start();
+  Node* control = graph()->start();
+
+  Node* allocate1 = graph()->NewNode(simplified()->Allocate(), size, effect,
+                                     control);
+  Node* allocate2 = graph()->NewNode(simplified()->Allocate(),
+                                     NumberConstant(24), allocate1, control);
+  Reduction r = Reduce(allocate2);
+  ASSERT_FALSE(r.Changed());
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
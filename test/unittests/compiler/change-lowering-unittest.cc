@@ -170,6 +170,84 @@ TARGET_TEST_P(ChangeLoweringCommonTest, StoreFieldTagged) {
 }
 
 
+TARGET_TEST_P(ChangeLoweringCommonTest, StoreFieldIntoNewAllocation) {
+  FieldAccess access = {kTaggedBase, JSObject::kPropertiesOffset,
+                        Handle<Name>::null(), Type::Any(),
+                        MachineType::AnyTagged()};
+  Node* p0 = Parameter(Type::Tagged());
+  Node* alloc = graph()->NewNode(simplified()->Allocate(NOT_TENURED),
+                                 NumberConstant(JSObject::kHeaderSize),
+                                 graph()->start(), graph()->start());
+  Node* store0 = graph()->NewNode(simplified()->StoreField(access), alloc, p0,
+                                  alloc, graph()->start());
+  Node* store1 = graph()->NewNode(simplified()->StoreField(access), alloc, p0,
+                                  store0, graph()->start());
+  Reduction r0 = Reduce(store0);
+  // The allocation is recognized before and after it is lowered.
+  ASSERT_TRUE(Reduce(alloc).Changed());
+  Reduction r1 = Reduce(store1);
+
+  ASSERT_TRUE(r0.Changed());
+  EXPECT_THAT(r0.replacement(),
+              IsStore(StoreRepresentation(MachineRepresentation::kTagged,
+                                          kNoWriteBarrier),
+                      alloc, IsIntPtrConstant(access.offset - access.tag()),
+                      p0, alloc, graph()->start()));
+  ASSERT_TRUE(r1.Changed());
+  EXPECT_THAT(r1.replacement(),
+              IsStore(StoreRepresentation(MachineRepresentation::kTagged,
+                                          kNoWriteBarrier),
+                      alloc, IsIntPtrConstant(access.offset - access.tag()),
+                      p0, store0, graph()->start()));
+}
+
+
+TARGET_TEST_P(ChangeLoweringCommonTest, StoreFieldIntoTenuredAllocation) {
+  FieldAccess access = {kTaggedBase, JSObject::kPropertiesOffset,
+                        Handle<Name>::null(), Type::Any(),
+                        MachineType::AnyTagged()};
+  Node* p0 = Parameter(Type::Tagged());
+  Node* alloc = graph()->NewNode(simplified()->Allocate(TENURED),
+                                 NumberConstant(JSObject::kHeaderSize),
+                                 graph()->start(), graph()->start());
+  Node* store = graph()->NewNode(simplified()->StoreField(access), alloc, p0,
+                                 alloc, graph()->start());
+  Reduction r = Reduce(store);
+
+  ASSERT_TRUE(r.Changed());
+  EXPECT_THAT(r.replacement(),
+              IsStore(StoreRepresentation(MachineRepresentation::kTagged,
+                                          kFullWriteBarrier),
+                      alloc, IsIntPtrConstant(access.offset - access.tag()),
+                      p0, alloc, graph()->start()));
+}
+
+
+TARGET_TEST_P(ChangeLoweringCommonTest, StoreFieldAfterAnotherAllocation) {
+  FieldAccess access = {kTaggedBase, JSObject::kPropertiesOffset,
+                        Handle<Name>::null(), Type::Any(),
+                        MachineType::AnyTagged()};
+  Node* alloc0 = graph()->NewNode(simplified()->Allocate(NOT_TENURED),
+                                  NumberConstant(JSObject::kHeaderSize),
+                                  graph()->start(), graph()->start());
+  Node* alloc1 = graph()->NewNode(simplified()->Allocate(NOT_TENURED),
+                                  NumberConstant(JSObject::kHeaderSize), alloc0,
+                                  graph()->start());
+  NodeProperties::SetType(alloc1, Type::TaggedPointer());
+  Node* store = graph()->NewNode(simplified()->StoreField(access), alloc0,
+                                 alloc1, alloc1, graph()->start());
+  Reduction r = Reduce(store);
+
+  // The second allocation may have caused alloc0 to be promoted or marked.
+  ASSERT_TRUE(r.Changed());
+  EXPECT_THAT(r.replacement(),
+              IsStore(StoreRepresentation(MachineRepresentation::kTagged,
+                                          kPointerWriteBarrier),
+                      alloc0, IsIntPtrConstant(access.offset - access.tag()),
+                      alloc1, alloc1, graph()->start()));
+}
+
+
 TARGET_TEST_P(ChangeLoweringCommonTest, LoadField) {
   FieldAccess access = {kTaggedBase, FixedArrayBase::kHeaderSize,
                         Handle<Name>::null(), Type::Any(),
@@ -507,6 +507,84 @@ TEST_F(EscapeAnalysisTest, DeoptReplacementIdentity) {
   ASSERT_EQ(object_state, object_state2);
 }
 
+
+TEST_F(EscapeAnalysisTest, PhiNonEscape) {
+  Node* object1 = Constant(1);
+  Node* object2 = Constant(2);
+  Node* effect0 = effect();
+  Branch();
+  Node* ifFalse = IfFalse();
+  Node* ifTrue = IfTrue();
+  BeginRegion(effect0);
+  Node* allocation1 = Allocate(Constant(kPointerSize), nullptr, ifFalse);
+  Store(FieldAccessAtIndex(0), allocation1, object1, nullptr, ifFalse);
+  Node* finish1 = FinishRegion(allocation1);
+  BeginRegion(effect0);
+  Node* allocation2 = Allocate(Constant(kPointerSize), nullptr, ifTrue);
+  Store(FieldAccessAtIndex(0), allocation2, object2, nullptr, ifTrue);
+  Node* finish2 = FinishRegion(allocation2);
+  Node* merge = Merge2(ifFalse, ifTrue);
+  Node* effect_phi =
+      graph()->NewNode(common()->EffectPhi(2), finish1, finish2, merge);
+  Node* phi = graph()->NewNode(common()->Phi(MachineRepresentation::kTagged, 2),
+                               finish1, finish2, merge);
+  Node* load = Load(FieldAccessAtIndex(0), phi, effect_phi, merge);
+  Node* result = Return(load, effect_phi, merge);
+  EndGraph();
+  graph()->end()->AppendInput(zone(), result);
+
+  Analysis();
+
+  ExpectVirtual(allocation1);
+  ExpectVirtual(allocation2);
+  ExpectReplacementPhi(load, object1, object2);
+  Node* replacement_phi = escape_analysis()->GetReplacement(load);
+
+  Transformation();
+
+  ASSERT_EQ(replacement_phi, NodeProperties::GetValueInput(result, 0));
+}
+
+
+TEST_F(EscapeAnalysisTest, PhiEscapeThroughFrameState) {
+  Node* object1 = Constant(1);
+  Node* object2 = Constant(2);
+  Node* effect0 = effect();
+  Branch();
+  Node* ifFalse = IfFalse();
+  Node* ifTrue = IfTrue();
+  BeginRegion(effect0);
+  Node* allocation1 = Allocate(Constant(kPointerSize), nullptr, ifFalse);
+  Store(FieldAccessAtIndex(0), allocation1, object1, nullptr, ifFalse);
+  Node* finish1 = FinishRegion(allocation1);
+  BeginRegion(effect0);
+  Node* allocation2 = Allocate(Constant(kPointerSize), nullptr, ifTrue);
+  Store(FieldAccessAtIndex(0), allocation2, object2, nullptr, ifTrue);
+  Node* finish2 = FinishRegion(allocation2);
+  Node* merge = Merge2(ifFalse, ifTrue);
+  Node* effect_phi =
+      graph()->NewNode(common()->EffectPhi(2), finish1, finish2, merge);
+  Node* phi = graph()->NewNode(common()->Phi(MachineRepresentation::kTagged, 2),
+                               finish1, finish2, merge);
+  Node* state_values1 = graph()->NewNode(common()->StateValues(1), phi);
+  Node* state_values2 = graph()->NewNode(common()->StateValues(0));
+  Node* state_values3 = graph()->NewNode(common()->StateValues(0));
+  Node* frame_state = graph()->NewNode(
+      common()->FrameState(BailoutId::None(), OutputFrameStateCombine::Ignore(),
+                           nullptr),
+      state_values1, state_values2, state_values3, UndefinedConstant(),
+      graph()->start(), graph()->start());
+  Node* deopt = graph()->NewNode(common()->Deoptimize(DeoptimizeKind::kEager),
+                                 frame_state, effect_phi, merge);
+  EndGraph();
+  graph()->end()->AppendInput(zone(), deopt);
+
+  Analysis();
+
+  ExpectEscaped(allocation1);
+  ExpectEscaped(allocation2);
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
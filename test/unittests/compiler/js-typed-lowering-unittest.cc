@@ -657,6 +657,46 @@ TEST_F(JSTypedLoweringTest, JSLoadPropertyFromExternalTypedArrayWithSafeKey) {
 }
 
 
+TEST_F(JSTypedLoweringTest,
+       JSLoadPropertyFromExternalTypedArrayWithDominatingCheck) {
+  const size_t kLength = 17;
+  double backing_store[kLength];
+  Handle<JSArrayBuffer> buffer =
+      NewArrayBuffer(backing_store, sizeof(backing_store));
+  VectorSlotPair feedback;
+  SimplifiedOperatorBuilder simplified(zone());
+  TRACED_FOREACH(ExternalArrayType, type, kExternalArrayTypes) {
+    Handle<JSTypedArray> array =
+        factory()->NewJSTypedArray(type, buffer, 0, kLength);
+    ElementAccess access = AccessBuilder::ForTypedArrayElement(type, true);
+
+    // The {key} alone may be out of bounds, but the access is guarded by
+    // {key < length}.
+    Node* key = Parameter(Type::Range(0, kLength, zone()));
+    Node* check = graph()->NewNode(simplified.NumberLessThan(), key,
+                                   NumberConstant(kLength));
+    Node* branch =
+        graph()->NewNode(common()->Branch(), check, graph()->start());
+    Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+    Node* base = HeapConstant(array);
+    Node* vector = UndefinedConstant();
+    Node* context = UndefinedConstant();
+    Node* effect = graph()->start();
+    Node* control = if_true;
+    Reduction r = Reduce(graph()->NewNode(
+        javascript()->LoadProperty(feedback), base, key, vector, context,
+        EmptyFrameState(), EmptyFrameState(), effect, control));
+
+    ASSERT_TRUE(r.Changed());
+    EXPECT_THAT(
+        r.replacement(),
+        IsLoadElement(access,
+                      IsIntPtrConstant(bit_cast<intptr_t>(&backing_store[0])),
+                      key, effect, control));
+  }
+}
+
+
 // -----------------------------------------------------------------------------
 // JSStoreProperty
 
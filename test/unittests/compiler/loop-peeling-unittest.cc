@@ -469,6 +469,45 @@ TEST_F(LoopPeelingTest, TwoExitLoop_nope) {
 }
 
 
+TEST_F(LoopPeelingTest, PeelInnerLoopsOfTree) {
+  Node* p0 = Parameter(0);
+  While outer = NewWhile(p0);
+  While inner = NewWhile(p0);
+  Nest(&inner, &outer);
+
+  Counter c = NewCounter(&outer, 0, 1);
+  InsertReturn(c.phi, start(), outer.exit);
+
+  LoopTree* loop_tree = GetLoopTree();
+  EXPECT_EQ(1, LoopPeeler::PeelInnerLoopsOfTree(graph(), common(), loop_tree,
+                                                zone()));
+
+  // Only the inner loop was peeled, its entry is now the peeled iteration
+  // and its exits are merged with the exits of the peeled iteration.
+  EXPECT_THAT(inner.loop, IsLoop(IsIfTrue(IsBranch(p0, outer.if_true)),
+                                 inner.if_true));
+  EXPECT_THAT(outer.loop,
+              IsLoop(start(), IsMerge(inner.exit,
+                                      IsIfFalse(IsBranch(p0, outer.if_true)))));
+}
+
+
+TEST_F(LoopPeelingTest, PeelInnerLoopsOfTree_TwoExitLoop_nope) {
+  Node* p0 = Parameter(0);
+  Node* loop = graph()->NewNode(common()->Loop(2), start(), start());
+  Branch b1 = NewBranch(p0, loop);
+  Branch b2 = NewBranch(p0, b1.if_true);
+
+  loop->ReplaceInput(1, b2.if_true);
+  Node* merge = graph()->NewNode(common()->Merge(2), b1.if_false, b2.if_false);
+  InsertReturn(p0, start(), merge);
+
+  LoopTree* loop_tree = GetLoopTree();
+  EXPECT_EQ(0, LoopPeeler::PeelInnerLoopsOfTree(graph(), common(), loop_tree,
+                                                zone()));
+  EXPECT_THAT(loop, IsLoop(start(), b2.if_true));
+}
+
 const Operator kMockCall(IrOpcode::kCall, Operator::kNoProperties, "MockCall",
                          0, 0, 1, 1, 1, 2);
 
@@ -264,6 +264,15 @@ const PureOperator kPureOperators[] = {
     PURE(Float64ExtractHighWord32, 1, 0, 1),  // --
     PURE(Float64InsertLowWord32, 2, 0, 1),    // --
     PURE(Float64InsertHighWord32, 2, 0, 1),   // --
+    PURE(Float32x4Splat, 1, 0, 1),            // --
+    PURE(Float32x4ExtractLane, 2, 0, 1),      // --
+    PURE(Float32x4Add, 2, 0, 1),              // --
+    PURE(Float32x4Sub, 2, 0, 1),              // --
+    PURE(Float32x4Mul, 2, 0, 1),              // --
+    PURE(Int32x4Splat, 1, 0, 1),              // --
+    PURE(Int32x4ExtractLane, 2, 0, 1),        // --
+    PURE(Int32x4Add, 2, 0, 1),                // --
+    PURE(Int32x4Sub, 2, 0, 1),                // --
 #undef PURE
 };
 
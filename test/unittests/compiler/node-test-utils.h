@@ -344,6 +344,9 @@ Matcher<Node*> IsFloat64Sqrt(const Matcher<Node*>& input_matcher);
 Matcher<Node*> IsFloat64RoundDown(const Matcher<Node*>& input_matcher);
 Matcher<Node*> IsFloat64RoundTruncate(const Matcher<Node*>& input_matcher);
 Matcher<Node*> IsFloat64RoundTiesAway(const Matcher<Node*>& input_matcher);
+Matcher<Node*> IsFloat64Sin(const Matcher<Node*>& input_matcher);
+Matcher<Node*> IsFloat64Cos(const Matcher<Node*>& input_matcher);
+Matcher<Node*> IsFloat64Tan(const Matcher<Node*>& input_matcher);
 Matcher<Node*> IsFloat64ExtractLowWord32(const Matcher<Node*>& input_matcher);
 Matcher<Node*> IsFloat64ExtractHighWord32(const Matcher<Node*>& input_matcher);
 Matcher<Node*> IsFloat64InsertLowWord32(const Matcher<Node*>& lhs_matcher,
@@ -86,6 +86,11 @@ class RegisterAllocatorTest : public InstructionSequenceTest {
     WireBlocks();
     Pipeline::AllocateRegistersForTesting(config(), sequence(), true);
   }
+
+  void AllocateFast() {
+    WireBlocks();
+    Pipeline::AllocateRegistersForTesting(config(), sequence(), true, true);
+  }
 };
 
 
@@ -644,6 +649,35 @@ TEST_F(RegisterAllocatorTest, SingleDeferredBlockSpill) {
 }
 
 
+TEST_F(RegisterAllocatorTest, SingleDeferredBlockSpillFastTier) {
+  StartBlock();  // B0
+  auto var = EmitOI(Reg(0));
+  EndBlock(Branch(Reg(var), 1, 2));
+
+  StartBlock();  // B1
+  EndBlock(Jump(2));
+
+  StartBlock(true);  // B2
+  EmitCall(Slot(-1), Slot(var));
+  EndBlock();
+
+  StartBlock();  // B3
+  EmitNop();
+  EndBlock();
+
+  StartBlock();  // B4
+  Return(Reg(var, 0));
+  EndBlock();
+
+  AllocateFast();
+
+  // Without splintering the range is spilled at its definition.
+  const int var_def_index = 1;
+  EXPECT_TRUE(IsParallelMovePresent(var_def_index, Instruction::START,
+                                    sequence(), Reg(0), Slot(0)));
+}
+
+
 TEST_F(RegisterAllocatorTest, MultipleDeferredBlockSpills) {
   if (!FLAG_turbo_preprocess_ranges) return;
 
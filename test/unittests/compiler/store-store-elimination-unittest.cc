@@ -0,0 +1,96 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/access-builder.h"
+#include "src/compiler/simplified-operator.h"
+#include "src/compiler/store-store-elimination.h"
+#include "test/unittests/compiler/graph-unittest.h"
+#include "test/unittests/compiler/node-test-utils.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class StoreStoreEliminationTest : public GraphTest {
+ public:
+  StoreStoreEliminationTest() : GraphTest(3), simplified_(zone()) {}
+  ~StoreStoreEliminationTest() override {}
+
+ protected:
+  Reduction Reduce(Node* node) {
+    // TODO(titzer): mock the GraphReducer here for better unit testing.
+    GraphReducer graph_reducer(zone(), graph());
+    StoreStoreElimination reducer(&graph_reducer);
+    return reducer.Reduce(node);
+  }
+
+  SimplifiedOperatorBuilder* simplified() { return &simplified_; }
+
+ private:
+  SimplifiedOperatorBuilder simplified_;
+};
+
+
+TEST_F(StoreStoreEliminationTest, StoreFieldOverwrittenByStoreField) {
+  Node* object = Parameter(0);
+  Node* value1 = Parameter(1);
+  Node* value2 = Parameter(2);
+  Node* effect = graph()->start();
+  Node* control = graph()->start();
+
+  FieldAccess const access = AccessBuilder::ForJSObjectProperties();
+  Node* store1 = graph()->NewNode(simplified()->StoreField(access), object,
+                                  value1, effect, control);
+  Node* store2 =
+      graph()->NewNode(simplified()->StoreField(AccessBuilder::ForMap()),
+                       object, value2, store1, control);
+  Node* store3 = graph()->NewNode(simplified()->StoreField(access), object,
+                                  value2, store2, control);
+  Reduction r1 = Reduce(store1);
+  ASSERT_TRUE(r1.Changed());
+  EXPECT_EQ(effect, r1.replacement());
+  Reduction r2 = Reduce(store2);
+  ASSERT_FALSE(r2.Changed());
+  Reduction r3 = Reduce(store3);
+  ASSERT_FALSE(r3.Changed());
+}
+
+
+TEST_F(StoreStoreEliminationTest, StoreFieldToDifferentObject) {
+  Node* object1 = Parameter(0);
+  Node* object2 = Parameter(1);
+  Node* value = Parameter(2);
+  Node* effect = graph()->start();
+  Node* control = graph()->start();
+
+  FieldAccess const access = AccessBuilder::ForJSObjectProperties();
+  Node* store1 = graph()->NewNode(simplified()->StoreField(access), object1,
+                                  value, effect, control);
+  graph()->NewNode(simplified()->StoreField(access), object2, value, store1,
+                   control);
+  Reduction r = Reduce(store1);
+  ASSERT_FALSE(r.Changed());
+}
+
+
+TEST_F(StoreStoreEliminationTest, StoreFieldObservedByLoadField) {
+  Node* object = Parameter(0);
+  Node* value = Parameter(1);
+  Node* effect = graph()->start();
+  Node* control = graph()->start();
+
+  FieldAccess const access = AccessBuilder::ForJSObjectProperties();
+  Node* store1 = graph()->NewNode(simplified()->StoreField(access), object,
+                                  value, effect, control);
+  Node* load = graph()->NewNode(simplified()->LoadField(access), object,
+                                store1, control);
+  graph()->NewNode(simplified()->StoreField(access), object, value, load,
+                   control);
+  Reduction r = Reduce(store1);
+  ASSERT_FALSE(r.Changed());
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -8,6 +8,7 @@
 #include "src/compiler/js-operator.h"
 #include "src/compiler/node-properties.h"
 #include "src/compiler/operator-properties.h"
+#include "src/compiler/simplified-operator.h"
 #include "test/cctest/types-fuzz.h"
 #include "test/unittests/compiler/graph-unittest.h"
 
@@ -368,6 +369,41 @@ TEST_BINARY_MONOTONICITY(Modulus)
 #undef TEST_BINARY_MONOTONICITY
 
 
+//------------------------------------------------------------------------------
+// Induction variables
+
+
+TEST_F(TyperTest, TypeInductionVariablePhi) {
+  SimplifiedOperatorBuilder simplified(zone());
+  Node* zero = graph()->NewNode(common()->NumberConstant(0));
+  Node* one = graph()->NewNode(common()->NumberConstant(1));
+  Node* bound = graph()->NewNode(common()->NumberConstant(100));
+  Node* loop = graph()->NewNode(common()->Loop(2), graph()->start(),
+                                graph()->start());
+  Node* phi = graph()->NewNode(
+      common()->Phi(MachineRepresentation::kTagged, 2), zero, zero, loop);
+  Node* cond = graph()->NewNode(simplified.NumberLessThan(), phi, bound);
+  Node* branch = graph()->NewNode(common()->Branch(), cond, loop);
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+  Node* increment = graph()->NewNode(simplified.NumberAdd(), phi, one);
+  phi->ReplaceInput(1, increment);
+  loop->ReplaceInput(1, if_true);
+  Node* ret = graph()->NewNode(common()->Return(), phi, graph()->start(),
+                               if_false);
+  graph()->end()->ReplaceInput(0, ret);
+
+  // Start from an untyped loop, like the graph builder produces it.
+  NodeProperties::RemoveType(phi);
+  NodeProperties::RemoveType(cond);
+  NodeProperties::RemoveType(increment);
+  typer()->Run();
+
+  EXPECT_TRUE(NodeProperties::GetType(phi)->Is(NewRange(0, 100)));
+  EXPECT_TRUE(NodeProperties::GetType(increment)->Is(NewRange(1, 101)));
+}
+
+
 //------------------------------------------------------------------------------
 // Regression tests
 
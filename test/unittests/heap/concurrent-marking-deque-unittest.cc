@@ -0,0 +1,115 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/base/platform/platform.h"
+#include "src/heap/concurrent-marking-deque.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+HeapObject* FakeObject(intptr_t i) {
+  return reinterpret_cast<HeapObject*>(i * kPointerSize + kHeapObjectTag);
+}
+
+}  // namespace
+
+TEST(ConcurrentMarkingDeque, Empty) {
+  ConcurrentMarkingDeque deque(1);
+  EXPECT_TRUE(deque.IsEmpty());
+  HeapObject* object = nullptr;
+  EXPECT_FALSE(deque.Pop(0, &object));
+}
+
+TEST(ConcurrentMarkingDeque, PushPopLocal) {
+  ConcurrentMarkingDeque deque(1);
+  const int kNumObjects = 3 * ConcurrentMarkingDeque::kSegmentCapacity + 1;
+  for (int i = 0; i < kNumObjects; i++) {
+    deque.Push(0, FakeObject(i));
+  }
+  EXPECT_FALSE(deque.IsEmpty());
+  HeapObject* object = nullptr;
+  int popped = 0;
+  while (deque.Pop(0, &object)) popped++;
+  EXPECT_EQ(kNumObjects, popped);
+  EXPECT_TRUE(deque.IsEmpty());
+}
+
+TEST(ConcurrentMarkingDeque, FlushAndSteal) {
+  ConcurrentMarkingDeque deque(2);
+  deque.Push(0, FakeObject(1));
+  HeapObject* object = nullptr;
+  EXPECT_FALSE(deque.Pop(1, &object));
+  deque.FlushToGlobal(0);
+  EXPECT_TRUE(deque.IsLocalEmpty(0));
+  EXPECT_FALSE(deque.IsGlobalPoolEmpty());
+  EXPECT_TRUE(deque.Pop(1, &object));
+  EXPECT_EQ(FakeObject(1), object);
+  EXPECT_TRUE(deque.IsEmpty());
+}
+
+TEST(ConcurrentMarkingDeque, Clear) {
+  ConcurrentMarkingDeque deque(2);
+  for (int i = 0; i < 2 * ConcurrentMarkingDeque::kSegmentCapacity; i++) {
+    deque.Push(0, FakeObject(i));
+    deque.Push(1, FakeObject(i));
+  }
+  deque.FlushToGlobal(1);
+  deque.Clear();
+  EXPECT_TRUE(deque.IsEmpty());
+  EXPECT_EQ(0, deque.GlobalPoolSize());
+}
+
+namespace {
+
+class StealingThread : public base::Thread {
+ public:
+  StealingThread(ConcurrentMarkingDeque* deque, int task_id)
+      : base::Thread(Options("StealingThread")),
+        deque_(deque),
+        task_id_(task_id),
+        popped_(0) {}
+
+  void Run() override {
+    HeapObject* object = nullptr;
+    while (deque_->Pop(task_id_, &object)) popped_++;
+  }
+
+  int popped() const { return popped_; }
+
+ private:
+  ConcurrentMarkingDeque* deque_;
+  int task_id_;
+  int popped_;
+};
+
+}  // namespace
+
+TEST(ConcurrentMarkingDeque, ConcurrentSteal) {
+  const int kNumThreads = 4;
+  const int kNumObjects = 100 * ConcurrentMarkingDeque::kSegmentCapacity;
+  ConcurrentMarkingDeque deque(kNumThreads);
+  for (int i = 0; i < kNumObjects; i++) {
+    deque.Push(0, FakeObject(i));
+  }
+  deque.FlushToGlobal(0);
+  StealingThread* threads[kNumThreads];
+  for (int i = 0; i < kNumThreads; i++) {
+    threads[i] = new StealingThread(&deque, i);
+    threads[i]->Start();
+  }
+  int popped = 0;
+  for (int i = 0; i < kNumThreads; i++) {
+    threads[i]->Join();
+    popped += threads[i]->popped();
+    delete threads[i];
+  }
+  EXPECT_EQ(kNumObjects, popped);
+  EXPECT_TRUE(deque.IsEmpty());
+}
+
+}  // namespace internal
+}  // namespace v8
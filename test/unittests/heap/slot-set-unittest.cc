@@ -167,5 +167,31 @@ TEST(TypedSlotSet, Iterate) {
   EXPECT_EQ(added / 2, iterated);
 }
 
+TEST(TypedSlotSet, IterateReleasesEmptyChunks) {
+  TypedSlotSet set(0);
+  // Enough slots to fill several chunks.
+  const int kSlots = 1000;
+  for (int i = 0; i < kSlots; i++) {
+    set.Insert(OBJECT_SLOT, i * kPointerSize);
+  }
+  // Keep only the slots of the most recently allocated chunk and a single
+  // slot of the first one.
+  const int kKept = kSlots - 50;
+  int kept = set.Iterate([kKept](SlotType type, Address addr) {
+    int i = static_cast<int>(reinterpret_cast<uintptr_t>(addr)) / kPointerSize;
+    return (i == 0 || i >= kKept) ? KEEP_SLOT : REMOVE_SLOT;
+  });
+  EXPECT_EQ(kSlots - kKept + 1, kept);
+  int iterated = set.Iterate([](SlotType type, Address addr) {
+    EXPECT_EQ(OBJECT_SLOT, type);
+    return KEEP_SLOT;
+  });
+  EXPECT_EQ(kept, iterated);
+  // The set can still be filled after chunks were released.
+  set.Insert(CODE_TARGET_SLOT, 0);
+  iterated = set.Iterate([](SlotType type, Address addr) { return KEEP_SLOT; });
+  EXPECT_EQ(kept + 1, iterated);
+}
+
 }  // namespace internal
 }  // namespace v8
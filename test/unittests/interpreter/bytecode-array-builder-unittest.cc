@@ -146,6 +146,40 @@ TEST_F(BytecodeArrayBuilderTest, AllBytecodesGenerated) {
       .CompareOperation(Token::Value::INSTANCEOF, reg)
       .CompareOperation(Token::Value::IN, reg);
 
+  // Emit compare-with-Smi operations, these are only generated by the
+  // peephole optimizer fusing a Smi load and a test operator.
+  bool old_fuse_bytecodes = FLAG_ignition_fuse_bytecodes;
+  FLAG_ignition_fuse_bytecodes = true;
+  builder.LoadLiteral(Smi::FromInt(1))
+      .CompareOperation(Token::Value::EQ, reg)
+      .LoadLiteral(Smi::FromInt(1))
+      .CompareOperation(Token::Value::NE, reg)
+      .LoadLiteral(Smi::FromInt(1))
+      .CompareOperation(Token::Value::EQ_STRICT, reg)
+      .LoadLiteral(Smi::FromInt(1))
+      .CompareOperation(Token::Value::LT, reg)
+      .LoadLiteral(Smi::FromInt(1))
+      .CompareOperation(Token::Value::GT, reg)
+      .LoadLiteral(Smi::FromInt(1))
+      .CompareOperation(Token::Value::LTE, reg)
+      .LoadLiteral(Smi::FromInt(1))
+      .CompareOperation(Token::Value::GTE, reg);
+  FLAG_ignition_fuse_bytecodes = old_fuse_bytecodes;
+
+  // Emit superinstructions, these are only generated by the peephole
+  // optimizer combining adjacent bytecode pairs.
+  bool old_superinstructions = FLAG_ignition_superinstructions;
+  FLAG_ignition_superinstructions = true;
+  builder.StoreAccumulatorInRegister(reg)
+      .LoadAccumulatorWithRegister(other)
+      .LoadAccumulatorWithRegister(other)
+      .BinaryOperation(Token::Value::ADD, reg)
+      .LoadLiteral(Smi::FromInt(1))
+      .BinaryOperation(Token::Value::ADD, reg)
+      .LoadLiteral(Smi::FromInt(1))
+      .StoreAccumulatorInRegister(other);
+  FLAG_ignition_superinstructions = old_superinstructions;
+
   // Emit cast operator invocations.
   builder.CastAccumulatorToNumber()
       .CastAccumulatorToJSObject()
@@ -210,6 +244,12 @@ TEST_F(BytecodeArrayBuilderTest, AllBytecodesGenerated) {
   // Emit stack check bytecode.
   builder.StackCheck(0);
 
+  // Emit an OSR poll bytecode.
+  builder.OsrPoll(1);
+
+  // Emit a block counter increment.
+  builder.IncBlockCounter(0, 0);
+
   // Emit throw and re-throw in it's own basic block so that the rest of the
   // code isn't omitted due to being dead.
   BytecodeLabel after_throw;
@@ -291,7 +331,9 @@ TEST_F(BytecodeArrayBuilderTest, AllBytecodesGenerated) {
 
   // Emit generator operations
   builder.SuspendGenerator(reg)
-      .ResumeGenerator(reg);
+      .ResumeGenerator(reg)
+      .SuspendGeneratorLive(reg, 1)
+      .ResumeGeneratorLive(reg, 1);
 
   // Intrinsics handled by the interpreter.
   builder.CallRuntime(Runtime::kInlineIsArray, reg, 1)
@@ -0,0 +1,392 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/v8.h"
+
+#include "src/factory.h"
+#include "src/interpreter/bytecode-peephole-optimizer.h"
+#include "src/interpreter/constant-array-builder.h"
+#include "src/objects-inl.h"
+#include "src/objects.h"
+#include "test/unittests/test-utils.h"
+
+namespace v8 {
+namespace internal {
+namespace interpreter {
+
+class BytecodePeepholeOptimizerTest : public BytecodePipelineStage,
+                                      public TestWithIsolateAndZone {
+ public:
+  BytecodePeepholeOptimizerTest()
+      : constant_array_builder_(isolate(), zone()),
+        peephole_optimizer_(&constant_array_builder_, this),
+        old_fuse_bytecodes_(FLAG_ignition_fuse_bytecodes),
+        old_superinstructions_(FLAG_ignition_superinstructions),
+        write_count_(0),
+        written_size_(0),
+        flush_basic_block_count_(0) {}
+  ~BytecodePeepholeOptimizerTest() override {
+    FLAG_ignition_fuse_bytecodes = old_fuse_bytecodes_;
+    FLAG_ignition_superinstructions = old_superinstructions_;
+  }
+
+  void Write(BytecodeNode* node) override {
+    write_count_++;
+    written_size_ += node->Size();
+    last_written_ = *node;
+  }
+
+  size_t FlushForOffset() override { return written_size_; }
+
+  void FlushBasicBlock() override { flush_basic_block_count_++; }
+
+  BytecodePeepholeOptimizer* optimizer() { return &peephole_optimizer_; }
+  ConstantArrayBuilder* constant_array() { return &constant_array_builder_; }
+
+  int write_count() const { return write_count_; }
+  int flush_basic_block_count() const { return flush_basic_block_count_; }
+  const BytecodeNode& last_written() const { return last_written_; }
+
+ private:
+  ConstantArrayBuilder constant_array_builder_;
+  BytecodePeepholeOptimizer peephole_optimizer_;
+  bool old_fuse_bytecodes_;
+  bool old_superinstructions_;
+
+  int write_count_;
+  size_t written_size_;
+  int flush_basic_block_count_;
+  BytecodeNode last_written_;
+};
+
+static uint32_t RegisterOperand(int index) {
+  return static_cast<uint32_t>(Register(index).ToOperand());
+}
+
+// Sanity tests.
+
+TEST_F(BytecodePeepholeOptimizerTest, FlushOnBasicBlock) {
+  CHECK_EQ(flush_basic_block_count(), 0);
+
+  BytecodeNode add(Bytecode::kAdd, RegisterOperand(0), OperandScale::kSingle);
+  optimizer()->Write(&add);
+  CHECK_EQ(write_count(), 0);
+
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(flush_basic_block_count(), 1);
+  CHECK_EQ(write_count(), 1);
+  CHECK_EQ(add, last_written());
+}
+
+TEST_F(BytecodePeepholeOptimizerTest, FlushForOffsetCountsBufferedBytecode) {
+  BytecodeNode add(Bytecode::kAdd, RegisterOperand(0), OperandScale::kSingle);
+  optimizer()->Write(&add);
+  CHECK_EQ(optimizer()->FlushForOffset(), add.Size());
+  CHECK_EQ(write_count(), 0);
+  CHECK_EQ(flush_basic_block_count(), 0);
+}
+
+TEST_F(BytecodePeepholeOptimizerTest, WriteOneFlushesPrevious) {
+  BytecodeNode add(Bytecode::kAdd, RegisterOperand(0), OperandScale::kSingle);
+  optimizer()->Write(&add);
+  CHECK_EQ(write_count(), 0);
+
+  BytecodeNode sub(Bytecode::kSub, RegisterOperand(0), OperandScale::kSingle);
+  optimizer()->Write(&sub);
+  CHECK_EQ(write_count(), 1);
+  CHECK_EQ(add, last_written());
+}
+
+// Tests covering the eliminations that are always performed.
+
+TEST_F(BytecodePeepholeOptimizerTest, ElideLdarAfterStar) {
+  BytecodeNode star(Bytecode::kStar, RegisterOperand(0), OperandScale::kSingle);
+  BytecodeNode ldar(Bytecode::kLdar, RegisterOperand(0), OperandScale::kSingle);
+  optimizer()->Write(&star);
+  optimizer()->Write(&ldar);
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(write_count(), 1);
+  CHECK_EQ(star, last_written());
+}
+
+TEST_F(BytecodePeepholeOptimizerTest, KeepLdarOfOtherRegister) {
+  BytecodeNode star(Bytecode::kStar, RegisterOperand(0), OperandScale::kSingle);
+  BytecodeNode ldar(Bytecode::kLdar, RegisterOperand(1), OperandScale::kSingle);
+  optimizer()->Write(&star);
+  optimizer()->Write(&ldar);
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(write_count(), 2);
+  CHECK_EQ(ldar, last_written());
+}
+
+TEST_F(BytecodePeepholeOptimizerTest, KeepLdarAcrossBasicBlocks) {
+  BytecodeNode star(Bytecode::kStar, RegisterOperand(0), OperandScale::kSingle);
+  BytecodeNode ldar(Bytecode::kLdar, RegisterOperand(0), OperandScale::kSingle);
+  optimizer()->Write(&star);
+  optimizer()->FlushBasicBlock();
+  optimizer()->Write(&ldar);
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(write_count(), 2);
+  CHECK_EQ(ldar, last_written());
+}
+
+TEST_F(BytecodePeepholeOptimizerTest, ElidedBytecodePassesOnSourcePosition) {
+  BytecodeNode star(Bytecode::kStar, RegisterOperand(0), OperandScale::kSingle);
+  BytecodeNode ldar(Bytecode::kLdar, RegisterOperand(0), OperandScale::kSingle);
+  ldar.source_info().Update(BytecodeSourceInfo(3, true));
+  BytecodeNode add(Bytecode::kAdd, RegisterOperand(1), OperandScale::kSingle);
+  optimizer()->Write(&star);
+  optimizer()->Write(&ldar);
+  optimizer()->Write(&add);
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(write_count(), 2);
+  CHECK_EQ(last_written().bytecode(), Bytecode::kAdd);
+  CHECK(last_written().source_info().is_statement());
+  CHECK_EQ(last_written().source_info().source_position(), 3);
+}
+
+TEST_F(BytecodePeepholeOptimizerTest, ElideToNameAfterLdaConstantName) {
+  Handle<Object> name = factory()->NewStringFromStaticChars("xyz");
+  size_t index = constant_array()->Insert(name);
+  BytecodeNode lda(Bytecode::kLdaConstant, static_cast<uint32_t>(index),
+                   OperandScale::kSingle);
+  BytecodeNode to_name(Bytecode::kToName);
+  optimizer()->Write(&lda);
+  optimizer()->Write(&to_name);
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(write_count(), 1);
+  CHECK_EQ(lda, last_written());
+}
+
+TEST_F(BytecodePeepholeOptimizerTest, KeepToNameAfterLdaConstantNumber) {
+  Handle<Object> number = factory()->NewNumber(3.14);
+  size_t index = constant_array()->Insert(number);
+  BytecodeNode lda(Bytecode::kLdaConstant, static_cast<uint32_t>(index),
+                   OperandScale::kSingle);
+  BytecodeNode to_name(Bytecode::kToName);
+  optimizer()->Write(&lda);
+  optimizer()->Write(&to_name);
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(write_count(), 2);
+  CHECK_EQ(to_name, last_written());
+}
+
+TEST_F(BytecodePeepholeOptimizerTest, JumpIfToBooleanAfterTest) {
+  BytecodeNode test(Bytecode::kTestEqual, RegisterOperand(0),
+                    OperandScale::kSingle);
+  BytecodeNode jump(Bytecode::kJumpIfToBooleanTrue, 0, OperandScale::kSingle);
+  optimizer()->Write(&test);
+  optimizer()->Write(&jump);
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(write_count(), 2);
+  CHECK_EQ(last_written().bytecode(), Bytecode::kJumpIfTrue);
+}
+
+TEST_F(BytecodePeepholeOptimizerTest, JumpIfToBooleanAfterAdd) {
+  BytecodeNode add(Bytecode::kAdd, RegisterOperand(0), OperandScale::kSingle);
+  BytecodeNode jump(Bytecode::kJumpIfToBooleanFalse, 0, OperandScale::kSingle);
+  optimizer()->Write(&add);
+  optimizer()->Write(&jump);
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(write_count(), 2);
+  CHECK_EQ(last_written().bytecode(), Bytecode::kJumpIfToBooleanFalse);
+}
+
+// Tests covering the fusions enabled by --ignition-fuse-bytecodes.
+
+TEST_F(BytecodePeepholeOptimizerTest, KeepDeadLoadWithoutFusion) {
+  FLAG_ignition_fuse_bytecodes = false;
+  BytecodeNode first(Bytecode::kLdaTrue);
+  BytecodeNode second(Bytecode::kLdaFalse);
+  optimizer()->Write(&first);
+  optimizer()->Write(&second);
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(write_count(), 2);
+}
+
+TEST_F(BytecodePeepholeOptimizerTest, ElideDeadLoad) {
+  FLAG_ignition_fuse_bytecodes = true;
+  BytecodeNode first(Bytecode::kLdaTrue);
+  BytecodeNode second(Bytecode::kLdaFalse);
+  optimizer()->Write(&first);
+  optimizer()->Write(&second);
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(write_count(), 1);
+  CHECK_EQ(second, last_written());
+}
+
+TEST_F(BytecodePeepholeOptimizerTest, KeepLoadReadByNextBytecode) {
+  FLAG_ignition_fuse_bytecodes = true;
+  BytecodeNode first(Bytecode::kLdaTrue);
+  BytecodeNode second(Bytecode::kStar, RegisterOperand(0),
+                      OperandScale::kSingle);
+  optimizer()->Write(&first);
+  optimizer()->Write(&second);
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(write_count(), 2);
+}
+
+TEST_F(BytecodePeepholeOptimizerTest, KeepLoadAfterFlushForOffset) {
+  FLAG_ignition_fuse_bytecodes = true;
+  BytecodeNode first(Bytecode::kLdaTrue);
+  BytecodeNode second(Bytecode::kLdaFalse);
+  optimizer()->Write(&first);
+  optimizer()->FlushForOffset();
+  optimizer()->Write(&second);
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(write_count(), 2);
+}
+
+TEST_F(BytecodePeepholeOptimizerTest, KeepLoadsWithSourcePositions) {
+  FLAG_ignition_fuse_bytecodes = true;
+  BytecodeNode first(Bytecode::kLdaTrue);
+  first.source_info().Update(BytecodeSourceInfo(3, true));
+  BytecodeNode second(Bytecode::kLdaFalse);
+  second.source_info().Update(BytecodeSourceInfo(7, false));
+  optimizer()->Write(&first);
+  optimizer()->Write(&second);
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(write_count(), 2);
+}
+
+TEST_F(BytecodePeepholeOptimizerTest, ElideDeadLoadKeepsSourcePosition) {
+  FLAG_ignition_fuse_bytecodes = true;
+  BytecodeNode first(Bytecode::kLdaTrue);
+  first.source_info().Update(BytecodeSourceInfo(3, true));
+  BytecodeNode second(Bytecode::kLdaFalse);
+  optimizer()->Write(&first);
+  optimizer()->Write(&second);
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(write_count(), 1);
+  CHECK_EQ(last_written().bytecode(), Bytecode::kLdaFalse);
+  CHECK(last_written().source_info().is_statement());
+  CHECK_EQ(last_written().source_info().source_position(), 3);
+}
+
+TEST_F(BytecodePeepholeOptimizerTest, FuseLdaSmiAndTest) {
+  FLAG_ignition_fuse_bytecodes = true;
+  BytecodeNode lda(Bytecode::kLdaSmi, 5, OperandScale::kSingle);
+  BytecodeNode test(Bytecode::kTestLessThan, RegisterOperand(0),
+                    OperandScale::kSingle);
+  test.source_info().Update(BytecodeSourceInfo(7, false));
+  optimizer()->Write(&lda);
+  optimizer()->Write(&test);
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(write_count(), 1);
+  BytecodeNode expected(Bytecode::kTestLessThanSmi, RegisterOperand(0), 5,
+                        OperandScale::kSingle);
+  expected.source_info().Update(BytecodeSourceInfo(7, false));
+  CHECK_EQ(expected, last_written());
+}
+
+TEST_F(BytecodePeepholeOptimizerTest, FuseLdaZeroAndTest) {
+  FLAG_ignition_fuse_bytecodes = true;
+  BytecodeNode lda(Bytecode::kLdaZero);
+  BytecodeNode test(Bytecode::kTestEqualStrict, RegisterOperand(0),
+                    OperandScale::kSingle);
+  optimizer()->Write(&lda);
+  optimizer()->Write(&test);
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(write_count(), 1);
+  BytecodeNode expected(Bytecode::kTestEqualStrictSmi, RegisterOperand(0), 0,
+                        OperandScale::kSingle);
+  CHECK_EQ(expected, last_written());
+}
+
+TEST_F(BytecodePeepholeOptimizerTest, FuseLdaSmiAndWideTest) {
+  FLAG_ignition_fuse_bytecodes = true;
+  // A negative byte immediate must be sign extended to the wider scale.
+  BytecodeNode lda(Bytecode::kLdaSmi, 0xff, OperandScale::kSingle);
+  BytecodeNode test(Bytecode::kTestGreaterThan, RegisterOperand(300),
+                    OperandScale::kDouble);
+  optimizer()->Write(&lda);
+  optimizer()->Write(&test);
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(write_count(), 1);
+  BytecodeNode expected(Bytecode::kTestGreaterThanSmi, RegisterOperand(300),
+                        0xffff, OperandScale::kDouble);
+  CHECK_EQ(expected, last_written());
+}
+
+TEST_F(BytecodePeepholeOptimizerTest, FusedTestFeedsBooleanJump) {
+  FLAG_ignition_fuse_bytecodes = true;
+  BytecodeNode lda(Bytecode::kLdaSmi, 5, OperandScale::kSingle);
+  BytecodeNode test(Bytecode::kTestEqual, RegisterOperand(0),
+                    OperandScale::kSingle);
+  BytecodeNode jump(Bytecode::kJumpIfToBooleanFalse, 0, OperandScale::kSingle);
+  optimizer()->Write(&lda);
+  optimizer()->Write(&test);
+  optimizer()->Write(&jump);
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(write_count(), 2);
+  CHECK_EQ(last_written().bytecode(), Bytecode::kJumpIfFalse);
+}
+
+// Tests covering superinstructions.
+
+TEST_F(BytecodePeepholeOptimizerTest, SuperinstructionsDisabled) {
+  FLAG_ignition_superinstructions = false;
+  BytecodeNode star(Bytecode::kStar, RegisterOperand(0), OperandScale::kSingle);
+  BytecodeNode ldar(Bytecode::kLdar, RegisterOperand(1), OperandScale::kSingle);
+  optimizer()->Write(&star);
+  optimizer()->Write(&ldar);
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(write_count(), 2);
+  CHECK_EQ(ldar, last_written());
+}
+
+TEST_F(BytecodePeepholeOptimizerTest, FuseStarAndLdar) {
+  FLAG_ignition_superinstructions = true;
+  BytecodeNode star(Bytecode::kStar, RegisterOperand(0), OperandScale::kSingle);
+  BytecodeNode ldar(Bytecode::kLdar, RegisterOperand(1), OperandScale::kSingle);
+  optimizer()->Write(&star);
+  optimizer()->Write(&ldar);
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(write_count(), 1);
+  BytecodeNode expected(Bytecode::kStarLdar, RegisterOperand(0),
+                        RegisterOperand(1), OperandScale::kSingle);
+  CHECK_EQ(expected, last_written());
+}
+
+TEST_F(BytecodePeepholeOptimizerTest, FuseLdaSmiAndAdd) {
+  FLAG_ignition_superinstructions = true;
+  BytecodeNode lda(Bytecode::kLdaSmi, 0xfe, OperandScale::kSingle);
+  BytecodeNode add(Bytecode::kAdd, RegisterOperand(2), OperandScale::kSingle);
+  optimizer()->Write(&lda);
+  optimizer()->Write(&add);
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(write_count(), 1);
+  BytecodeNode expected(Bytecode::kLdaSmiAdd, 0xfe, RegisterOperand(2),
+                        OperandScale::kSingle);
+  CHECK_EQ(expected, last_written());
+}
+
+TEST_F(BytecodePeepholeOptimizerTest, NoSuperinstructionForMixedScales) {
+  FLAG_ignition_superinstructions = true;
+  BytecodeNode lda(Bytecode::kLdaSmi, 1, OperandScale::kSingle);
+  BytecodeNode star(Bytecode::kStar, RegisterOperand(300),
+                    OperandScale::kDouble);
+  optimizer()->Write(&lda);
+  optimizer()->Write(&star);
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(write_count(), 2);
+  CHECK_EQ(star, last_written());
+}
+
+TEST_F(BytecodePeepholeOptimizerTest, NoSuperinstructionAfterOffsetFlush) {
+  FLAG_ignition_superinstructions = true;
+  BytecodeNode ldar(Bytecode::kLdar, RegisterOperand(0), OperandScale::kSingle);
+  BytecodeNode add(Bytecode::kAdd, RegisterOperand(1), OperandScale::kSingle);
+  optimizer()->Write(&ldar);
+  // The offset of the Ldar is observed, e.g. by binding a label.
+  optimizer()->FlushForOffset();
+  optimizer()->Write(&add);
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(write_count(), 2);
+  CHECK_EQ(add, last_written());
+}
+
+}  // namespace interpreter
+}  // namespace internal
+}  // namespace v8
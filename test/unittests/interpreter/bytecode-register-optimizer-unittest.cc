@@ -0,0 +1,218 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/v8.h"
+
+#include "src/interpreter/bytecode-register-optimizer.h"
+#include "test/unittests/test-utils.h"
+
+namespace v8 {
+namespace internal {
+namespace interpreter {
+
+class BytecodeRegisterOptimizerTest : public BytecodePipelineStage,
+                                      public TestWithIsolateAndZone {
+ public:
+  static const int kParameterCount = 3;
+  static const int kFixedRegisterCount = 2;
+
+  BytecodeRegisterOptimizerTest()
+      : allocator_(zone(), kFixedRegisterCount),
+        output_(zone()),
+        written_size_(0),
+        flush_basic_block_count_(0) {
+    register_optimizer_ = new (zone()) BytecodeRegisterOptimizer(
+        zone(), &allocator_, kParameterCount, this);
+  }
+  ~BytecodeRegisterOptimizerTest() override {}
+
+  void Write(BytecodeNode* node) override {
+    written_size_ += node->Size();
+    output_.push_back(*node);
+  }
+
+  size_t FlushForOffset() override { return written_size_; }
+
+  void FlushBasicBlock() override { flush_basic_block_count_++; }
+
+  BytecodeRegisterOptimizer* optimizer() { return register_optimizer_; }
+  TemporaryRegisterAllocator* allocator() { return &allocator_; }
+
+  int write_count() const { return static_cast<int>(output_.size()); }
+  int flush_basic_block_count() const { return flush_basic_block_count_; }
+  const BytecodeNode& output(size_t i) const { return output_.at(i); }
+
+ private:
+  TemporaryRegisterAllocator allocator_;
+  BytecodeRegisterOptimizer* register_optimizer_;
+
+  ZoneVector<BytecodeNode> output_;
+  size_t written_size_;
+  int flush_basic_block_count_;
+};
+
+static uint32_t RegisterOperand(int index) {
+  return static_cast<uint32_t>(Register(index).ToOperand());
+}
+
+// Sanity tests.
+
+TEST_F(BytecodeRegisterOptimizerTest, WriteStackCheck) {
+  BytecodeNode node(Bytecode::kStackCheck);
+  optimizer()->Write(&node);
+  CHECK_EQ(write_count(), 1);
+  CHECK_EQ(node, output(0));
+}
+
+TEST_F(BytecodeRegisterOptimizerTest, FlushBasicBlockForwarded) {
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(flush_basic_block_count(), 1);
+  CHECK_EQ(write_count(), 0);
+}
+
+// Tests covering lazy materialization of temporaries.
+
+TEST_F(BytecodeRegisterOptimizerTest, TemporaryMaterializedForFlush) {
+  Register temp = Register(allocator()->BorrowTemporaryRegister());
+  BytecodeNode star(Bytecode::kStar, RegisterOperand(temp.index()),
+                    OperandScale::kSingle);
+  optimizer()->Write(&star);
+  CHECK_EQ(write_count(), 0);
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(write_count(), 1);
+  CHECK_EQ(star, output(0));
+}
+
+TEST_F(BytecodeRegisterOptimizerTest, TemporaryMaterializedForJump) {
+  Register temp = Register(allocator()->BorrowTemporaryRegister());
+  BytecodeNode star(Bytecode::kStar, RegisterOperand(temp.index()),
+                    OperandScale::kSingle);
+  optimizer()->Write(&star);
+  CHECK_EQ(write_count(), 0);
+  BytecodeNode jump(Bytecode::kJump, 0, OperandScale::kSingle);
+  optimizer()->Write(&jump);
+  CHECK_EQ(write_count(), 2);
+  CHECK_EQ(star, output(0));
+  CHECK_EQ(jump, output(1));
+}
+
+TEST_F(BytecodeRegisterOptimizerTest, TemporaryMaterializedBeforeOverwrite) {
+  Register temp = Register(allocator()->BorrowTemporaryRegister());
+  BytecodeNode star(Bytecode::kStar, RegisterOperand(temp.index()),
+                    OperandScale::kSingle);
+  optimizer()->Write(&star);
+  BytecodeNode lda_zero(Bytecode::kLdaZero);
+  optimizer()->Write(&lda_zero);
+  CHECK_EQ(write_count(), 2);
+  CHECK_EQ(star, output(0));
+  CHECK_EQ(lda_zero, output(1));
+}
+
+TEST_F(BytecodeRegisterOptimizerTest, TemporaryNotMaterializedAfterFree) {
+  int temp = allocator()->BorrowTemporaryRegister();
+  BytecodeNode star(Bytecode::kStar, RegisterOperand(temp),
+                    OperandScale::kSingle);
+  optimizer()->Write(&star);
+  allocator()->ReturnTemporaryRegister(temp);
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(write_count(), 0);
+}
+
+TEST_F(BytecodeRegisterOptimizerTest, RedundantLdarOfTemporaryElided) {
+  Register temp = Register(allocator()->BorrowTemporaryRegister());
+  BytecodeNode star(Bytecode::kStar, RegisterOperand(temp.index()),
+                    OperandScale::kSingle);
+  BytecodeNode ldar(Bytecode::kLdar, RegisterOperand(temp.index()),
+                    OperandScale::kSingle);
+  optimizer()->Write(&star);
+  optimizer()->Write(&ldar);
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(write_count(), 1);
+  CHECK_EQ(star, output(0));
+}
+
+TEST_F(BytecodeRegisterOptimizerTest, StoreToLocalEmittedEagerly) {
+  BytecodeNode star(Bytecode::kStar, RegisterOperand(0), OperandScale::kSingle);
+  optimizer()->Write(&star);
+  CHECK_EQ(write_count(), 1);
+  CHECK_EQ(star, output(0));
+}
+
+TEST_F(BytecodeRegisterOptimizerTest, LoadOfLocalIntoLocalBecomesMov) {
+  BytecodeNode ldar(Bytecode::kLdar, RegisterOperand(0), OperandScale::kSingle);
+  BytecodeNode star(Bytecode::kStar, RegisterOperand(1), OperandScale::kSingle);
+  optimizer()->Write(&ldar);
+  optimizer()->Write(&star);
+  CHECK_EQ(write_count(), 1);
+  CHECK_EQ(output(0).bytecode(), Bytecode::kMov);
+  CHECK_EQ(output(0).operand(0), RegisterOperand(0));
+  CHECK_EQ(output(0).operand(1), RegisterOperand(1));
+
+  // The accumulator is loaded when it is read.
+  BytecodeNode ret(Bytecode::kReturn);
+  optimizer()->Write(&ret);
+  CHECK_EQ(write_count(), 3);
+  CHECK_EQ(output(1).bytecode(), Bytecode::kLdar);
+  CHECK_EQ(ret, output(2));
+}
+
+TEST_F(BytecodeRegisterOptimizerTest, TemporaryInputReadFromEquivalent) {
+  int temp = allocator()->BorrowTemporaryRegister();
+  BytecodeNode ldar(Bytecode::kLdar, RegisterOperand(0), OperandScale::kSingle);
+  BytecodeNode star(Bytecode::kStar, RegisterOperand(temp),
+                    OperandScale::kSingle);
+  BytecodeNode lda_zero(Bytecode::kLdaZero);
+  BytecodeNode add(Bytecode::kAdd, RegisterOperand(temp),
+                   OperandScale::kSingle);
+  optimizer()->Write(&ldar);
+  optimizer()->Write(&star);
+  optimizer()->Write(&lda_zero);
+  optimizer()->Write(&add);
+  allocator()->ReturnTemporaryRegister(temp);
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(write_count(), 2);
+  CHECK_EQ(lda_zero, output(0));
+  CHECK_EQ(output(1).bytecode(), Bytecode::kAdd);
+  CHECK_EQ(output(1).operand(0), RegisterOperand(0));
+}
+
+TEST_F(BytecodeRegisterOptimizerTest, RegisterRangeInputsMaterialized) {
+  int first = allocator()->PrepareForConsecutiveTemporaryRegisters(2);
+  allocator()->BorrowConsecutiveTemporaryRegister(first);
+  allocator()->BorrowConsecutiveTemporaryRegister(first + 1);
+  BytecodeNode ldar(Bytecode::kLdar, RegisterOperand(0), OperandScale::kSingle);
+  BytecodeNode star0(Bytecode::kStar, RegisterOperand(first),
+                     OperandScale::kSingle);
+  BytecodeNode star1(Bytecode::kStar, RegisterOperand(first + 1),
+                     OperandScale::kSingle);
+  BytecodeNode call(Bytecode::kCallRuntime, 0, RegisterOperand(first), 2,
+                    OperandScale::kSingle);
+  optimizer()->Write(&ldar);
+  optimizer()->Write(&star0);
+  optimizer()->Write(&star1);
+  CHECK_EQ(write_count(), 0);
+  optimizer()->Write(&call);
+  CHECK_EQ(write_count(), 3);
+  CHECK_EQ(output(0).bytecode(), Bytecode::kMov);
+  CHECK_EQ(output(0).operand(1), RegisterOperand(first));
+  CHECK_EQ(output(1).bytecode(), Bytecode::kMov);
+  CHECK_EQ(output(1).operand(1), RegisterOperand(first + 1));
+  CHECK_EQ(call, output(2));
+}
+
+TEST_F(BytecodeRegisterOptimizerTest, StateDiscardedAfterReturn) {
+  Register temp = Register(allocator()->BorrowTemporaryRegister());
+  BytecodeNode star(Bytecode::kStar, RegisterOperand(temp.index()),
+                    OperandScale::kSingle);
+  BytecodeNode ret(Bytecode::kReturn);
+  optimizer()->Write(&star);
+  optimizer()->Write(&ret);
+  optimizer()->FlushBasicBlock();
+  CHECK_EQ(write_count(), 1);
+  CHECK_EQ(ret, output(0));
+}
+
+}  // namespace interpreter
+}  // namespace internal
+}  // namespace v8
@@ -324,6 +324,36 @@ TEST(OperandScale, PrefixesRequired) {
         Bytecode::kExtraWide);
 }
 
+TEST(Bytecodes, SuperinstructionsConcatenateComponents) {
+#define CHECK_SUPERINSTRUCTION(Name, First, Second)                        \
+  {                                                                        \
+    Bytecode name = Bytecode::k##Name;                                     \
+    Bytecode first = Bytecode::k##First;                                   \
+    Bytecode second = Bytecode::k##Second;                                 \
+    CHECK(Bytecodes::IsSuperinstruction(name));                            \
+    CHECK_EQ(Bytecodes::GetSuperinstruction(first, second), name);         \
+    CHECK_EQ(Bytecodes::GetSuperinstructionComponent(name, 0), first);     \
+    CHECK_EQ(Bytecodes::GetSuperinstructionComponent(name, 1), second);    \
+    int first_count = Bytecodes::NumberOfOperands(first);                  \
+    CHECK_EQ(Bytecodes::NumberOfOperands(name),                            \
+             first_count + Bytecodes::NumberOfOperands(second));           \
+    for (int i = 0; i < first_count; i++) {                                \
+      CHECK_EQ(Bytecodes::GetOperandType(name, i),                         \
+               Bytecodes::GetOperandType(first, i));                       \
+    }                                                                      \
+    for (int i = 0; i < Bytecodes::NumberOfOperands(second); i++) {        \
+      CHECK_EQ(Bytecodes::GetOperandType(name, first_count + i),           \
+               Bytecodes::GetOperandType(second, i));                      \
+    }                                                                      \
+    CHECK(!Bytecodes::IsJump(first) && !Bytecodes::IsJump(second));        \
+  }
+  SUPERINSTRUCTION_LIST(CHECK_SUPERINSTRUCTION)
+#undef CHECK_SUPERINSTRUCTION
+  CHECK(!Bytecodes::IsSuperinstruction(Bytecode::kAdd));
+  CHECK_EQ(Bytecodes::GetSuperinstruction(Bytecode::kAdd, Bytecode::kAdd),
+           Bytecode::kIllegal);
+}
+
 TEST(AccumulatorUse, LogicalOperators) {
   CHECK_EQ(AccumulatorUse::kNone | AccumulatorUse::kRead,
            AccumulatorUse::kRead);
@@ -79,6 +79,29 @@ TEST_F(SourcePositionTableTest, EncodeAscending) {
   CHECK(!builder.ToSourcePositionTable().is_null());
 }
 
+TEST_F(SourcePositionTableTest, OmitExpressionPositions) {
+  SourcePositionTableBuilder builder(
+      isolate(), zone(), SourcePositionTableBuilder::OMIT_EXPRESSION_POSITIONS);
+  CHECK(builder.omits_expression_positions());
+  for (int i = 0; i < arraysize(offsets); i++) {
+    if (i % 2) {
+      builder.AddStatementPosition(offsets[i], offsets[i]);
+    } else {
+      builder.AddExpressionPosition(offsets[i], offsets[i]);
+    }
+  }
+  Handle<ByteArray> table = builder.ToSourcePositionTable();
+
+  int count = 0;
+  for (SourcePositionTableIterator it(*table); !it.done(); it.Advance()) {
+    CHECK(it.is_statement());
+    CHECK_EQ(offsets[2 * count + 1], it.bytecode_offset());
+    CHECK_EQ(offsets[2 * count + 1], it.source_position());
+    count++;
+  }
+  CHECK_EQ(static_cast<int>(arraysize(offsets) / 2), count);
+}
+
 }  // namespace interpreter
 }  // namespace internal
 }  // namespace v8
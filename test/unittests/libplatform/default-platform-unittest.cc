@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "src/libplatform/default-platform.h"
+#include "src/base/platform/semaphore.h"
 #include "testing/gmock/include/gmock/gmock.h"
 
 using testing::InSequence;
@@ -20,9 +21,27 @@ struct MockTask : public Task {
 };
 
 
+struct MockIdleTask : public IdleTask {
+  virtual ~MockIdleTask() { Die(); }
+  MOCK_METHOD1(Run, void(double deadline_in_seconds));
+  MOCK_METHOD0(Die, void());
+};
+
+
+class SignalingTask : public Task {
+ public:
+  explicit SignalingTask(base::Semaphore* semaphore) : semaphore_(semaphore) {}
+  void Run() override { semaphore_->Signal(); }
+
+ private:
+  base::Semaphore* semaphore_;
+};
+
+
 class DefaultPlatformWithMockTime : public DefaultPlatform {
  public:
-  DefaultPlatformWithMockTime() : time_(0) {}
+  DefaultPlatformWithMockTime()
+      : DefaultPlatform(IdleTaskSupport::kEnabled), time_(0) {}
   double MonotonicallyIncreasingTime() override { return time_; }
   void IncreaseTime(double seconds) { time_ += seconds; }
 
@@ -127,5 +146,80 @@ TEST(DefaultPlatformTest, PendingDelayedTasksAreDestroyedOnShutdown) {
 }
 
 
+TEST(DefaultPlatformTest, RunIdleTasks) {
+  InSequence s;
+
+  int dummy;
+  Isolate* isolate = reinterpret_cast<Isolate*>(&dummy);
+
+  DefaultPlatformWithMockTime platform;
+  EXPECT_TRUE(platform.IdleTasksEnabled(isolate));
+
+  StrictMock<MockIdleTask>* task1 = new StrictMock<MockIdleTask>;
+  StrictMock<MockIdleTask>* task2 = new StrictMock<MockIdleTask>;
+  platform.CallIdleOnForegroundThread(isolate, task1);
+  platform.CallIdleOnForegroundThread(isolate, task2);
+
+  // The first task uses up the whole idle time.
+  EXPECT_CALL(*task1, Run(42.0 + 23.0))
+      .WillOnce(testing::InvokeWithoutArgs([&platform]() {
+        platform.IncreaseTime(23.0);
+      }));
+  EXPECT_CALL(*task1, Die());
+  platform.IncreaseTime(42.0);
+  platform.RunIdleTasks(isolate, 23.0);
+
+  EXPECT_CALL(*task2, Run(65.0 + 10.0));
+  EXPECT_CALL(*task2, Die());
+  platform.RunIdleTasks(isolate, 10.0);
+}
+
+
+TEST(DefaultPlatformTest, PendingIdleTasksAreDestroyedOnShutdown) {
+  InSequence s;
+
+  int dummy;
+  Isolate* isolate = reinterpret_cast<Isolate*>(&dummy);
+
+  {
+    DefaultPlatformWithMockTime platform;
+    StrictMock<MockIdleTask>* task = new StrictMock<MockIdleTask>;
+    platform.CallIdleOnForegroundThread(isolate, task);
+    EXPECT_CALL(*task, Die());
+  }
+}
+
+
+TEST(DefaultPlatformTest, DelayedBackgroundTasks) {
+  int dummy;
+  Isolate* isolate = reinterpret_cast<Isolate*>(&dummy);
+
+  base::Semaphore semaphore(0);
+  DefaultPlatformWithMockTime platform;
+  platform.SetThreadPoolSize(1);
+  platform.CallDelayedOnBackgroundThread(new SignalingTask(&semaphore),
+                                         Platform::kShortRunningTask, 10);
+  EXPECT_FALSE(platform.PumpMessageLoop(isolate));
+  EXPECT_FALSE(semaphore.WaitFor(base::TimeDelta::FromMilliseconds(10)));
+
+  platform.IncreaseTime(11);
+  EXPECT_FALSE(platform.PumpMessageLoop(isolate));
+  semaphore.Wait();
+}
+
+
+TEST(DefaultPlatformTest, PendingDelayedBackgroundTasksAreDestroyedOnShutdown) {
+  InSequence s;
+
+  {
+    DefaultPlatformWithMockTime platform;
+    platform.SetThreadPoolSize(1);
+    StrictMock<MockTask>* task = new StrictMock<MockTask>;
+    platform.CallDelayedOnBackgroundThread(task, Platform::kShortRunningTask,
+                                           10);
+    EXPECT_CALL(*task, Die());
+  }
+}
+
 }  // namespace platform
 }  // namespace v8
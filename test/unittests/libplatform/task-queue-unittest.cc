@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <set>
+
 #include "include/v8-platform.h"
 #include "src/base/platform/platform.h"
 #include "src/libplatform/task-queue.h"
@@ -45,6 +47,82 @@ TEST(TaskQueueTest, Basic) {
 }
 
 
+TEST(TaskQueueTest, HighPriorityFirst) {
+  TaskQueue queue;
+  MockTask low1, low2, high;
+  queue.Append(&low1, TaskQueue::kLowPriority);
+  queue.Append(&low2, TaskQueue::kLowPriority);
+  queue.Append(&high, TaskQueue::kHighPriority);
+  EXPECT_EQ(&high, queue.GetNext());
+  EXPECT_EQ(&low1, queue.GetNext());
+  EXPECT_EQ(&low2, queue.GetNext());
+  queue.Terminate();
+  EXPECT_THAT(queue.GetNext(), IsNull());
+}
+
+
+TEST(TaskQueueTest, Stealing) {
+  TaskQueue queue(2);
+  MockTask task1, task2, task3;
+  // Tasks are distributed round-robin, so worker 0 gets task1 and task3.
+  queue.Append(&task1);
+  queue.Append(&task2);
+  queue.Append(&task3);
+  EXPECT_EQ(&task2, queue.GetNext(1));
+  // Worker 1 steals from the back of worker 0's deque.
+  EXPECT_EQ(&task3, queue.GetNext(1));
+  EXPECT_EQ(&task1, queue.GetNext(1));
+  queue.Terminate();
+  EXPECT_THAT(queue.GetNext(0), IsNull());
+  EXPECT_THAT(queue.GetNext(1), IsNull());
+}
+
+
+TEST(TaskQueueTest, StealingPrefersHighPriority) {
+  TaskQueue queue(2);
+  MockTask low, high;
+  queue.Append(&low, TaskQueue::kLowPriority);
+  queue.Append(&high, TaskQueue::kHighPriority);
+  // Worker 0 owns |low| but steals |high| from worker 1 first.
+  EXPECT_EQ(&high, queue.GetNext(0));
+  EXPECT_EQ(&low, queue.GetNext(0));
+  queue.Terminate();
+  EXPECT_THAT(queue.GetNext(0), IsNull());
+}
+
+
+TEST(TaskQueueTest, NumaNodes) {
+  // Workers 0 and 2 belong to node 0, workers 1 and 3 to node 1.
+  TaskQueue queue(4, 2);
+  EXPECT_EQ(2, queue.number_of_nodes());
+  EXPECT_EQ(1, queue.NodeOfWorker(3));
+  MockTask task1, task2, task3;
+  queue.Append(&task1, TaskQueue::kHighPriority, 1);
+  queue.Append(&task2, TaskQueue::kHighPriority, 1);
+  // Nodes beyond the number of nodes wrap around.
+  queue.Append(&task3, TaskQueue::kHighPriority, 3);
+  queue.Terminate();
+  // Workers of node 0 do not steal from node 1.
+  EXPECT_THAT(queue.GetNext(0), IsNull());
+  EXPECT_THAT(queue.GetNext(2), IsNull());
+  std::set<Task*> tasks;
+  tasks.insert(queue.GetNext(1));
+  tasks.insert(queue.GetNext(3));
+  tasks.insert(queue.GetNext(1));
+  EXPECT_EQ(3u, tasks.size());
+  EXPECT_EQ(0u, tasks.count(NULL));
+  EXPECT_THAT(queue.GetNext(1), IsNull());
+  EXPECT_THAT(queue.GetNext(3), IsNull());
+}
+
+
+TEST(TaskQueueTest, NumberOfNodesIsLimitedByWorkers) {
+  TaskQueue queue(2, 4);
+  EXPECT_EQ(2, queue.number_of_nodes());
+  queue.Terminate();
+}
+
+
 TEST(TaskQueueTest, TerminateMultipleReaders) {
   TaskQueue queue;
   TaskQueueThread thread1(&queue);
@@ -0,0 +1,187 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "base/trace_event/common/trace_event_common.h"
+#include "include/libplatform/v8-tracing.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace platform {
+namespace tracing {
+
+namespace {
+
+class MockTraceWriter : public TraceWriter {
+ public:
+  void AppendTraceEvent(TraceObject* trace_event) override {
+    events_.push_back(trace_event->name());
+  }
+
+  void Flush() override {}
+
+  const std::vector<std::string>& events() const { return events_; }
+
+ private:
+  std::vector<std::string> events_;
+};
+
+}  // namespace
+
+
+TEST(TracingTest, TraceObjectCopiesParameters) {
+  char name[] = "name";
+  char arg_name[] = "arg";
+  char arg_value[] = "value";
+  const char* arg_names[] = {arg_name};
+  const uint8_t arg_types[] = {TRACE_VALUE_TYPE_STRING};
+  const uint64_t arg_values[] = {static_cast<uint64_t>(
+      reinterpret_cast<uintptr_t>(arg_value))};
+  uint8_t category_enabled_flag = 0;
+
+  TraceObject trace_object;
+  trace_object.Initialize(TRACE_EVENT_PHASE_BEGIN, &category_enabled_flag,
+                          name, NULL, 0, 0, 1, arg_names, arg_types,
+                          arg_values, TRACE_EVENT_FLAG_COPY);
+  name[0] = arg_name[0] = arg_value[0] = 'X';
+  EXPECT_STREQ("name", trace_object.name());
+  EXPECT_STREQ("arg", trace_object.arg_names()[0]);
+  EXPECT_EQ(TRACE_VALUE_TYPE_COPY_STRING, trace_object.arg_types()[0]);
+  EXPECT_STREQ("value", trace_object.arg_values()[0].as_string);
+}
+
+
+TEST(TracingTest, TraceBufferRingBuffer) {
+  // Two chunks, the first of which is overwritten by the third one.
+  const size_t kMaxChunks = 2;
+  MockTraceWriter* writer = new MockTraceWriter();
+  TraceBuffer* buffer =
+      TraceBuffer::CreateTraceBufferRingBuffer(kMaxChunks, writer);
+  uint8_t category_enabled_flag = 0;
+  std::vector<std::string> names;
+  std::vector<uint64_t> handles;
+  for (size_t i = 0; i < 3 * TraceBufferChunk::kChunkSize; ++i) {
+    names.push_back(std::to_string(i));
+  }
+  for (size_t i = 0; i < names.size(); ++i) {
+    uint64_t handle;
+    TraceObject* trace_object = buffer->AddTraceEvent(&handle);
+    ASSERT_TRUE(trace_object != NULL);
+    trace_object->Initialize(TRACE_EVENT_PHASE_COMPLETE,
+                             &category_enabled_flag, names[i].c_str(), NULL, 0,
+                             0, 0, NULL, NULL, NULL, 0);
+    EXPECT_EQ(trace_object, buffer->GetEventByHandle(handle));
+    handles.push_back(handle);
+  }
+
+  // Events of the overwritten chunk are gone.
+  EXPECT_TRUE(buffer->GetEventByHandle(handles[0]) == NULL);
+  EXPECT_TRUE(buffer->GetEventByHandle(
+                  handles[TraceBufferChunk::kChunkSize - 1]) == NULL);
+  EXPECT_STREQ(names[TraceBufferChunk::kChunkSize].c_str(),
+               buffer->GetEventByHandle(
+                          handles[TraceBufferChunk::kChunkSize])->name());
+
+  // Flushing writes the remaining events in order and empties the buffer.
+  EXPECT_TRUE(buffer->Flush());
+  ASSERT_EQ(2 * TraceBufferChunk::kChunkSize, writer->events().size());
+  for (size_t i = 0; i < writer->events().size(); ++i) {
+    EXPECT_EQ(names[TraceBufferChunk::kChunkSize + i], writer->events()[i]);
+  }
+  EXPECT_TRUE(buffer->GetEventByHandle(handles.back()) == NULL);
+  delete buffer;
+}
+
+
+TEST(TracingTest, JSONTraceWriter) {
+  std::ostringstream stream;
+  TraceWriter* writer = TraceWriter::CreateJSONTraceWriter(stream);
+
+  TracingController tracing_controller;
+  tracing_controller.Initialize(
+      TraceBuffer::CreateTraceBufferRingBuffer(1, new MockTraceWriter()));
+  const uint8_t* category_enabled_flag =
+      tracing_controller.GetCategoryGroupEnabled("v8-json-test");
+  const char* arg_names[] = {"int", "str"};
+  const uint8_t arg_types[] = {TRACE_VALUE_TYPE_INT, TRACE_VALUE_TYPE_STRING};
+  const uint64_t arg_values[] = {static_cast<uint64_t>(-42),
+                                 static_cast<uint64_t>(
+                                     reinterpret_cast<uintptr_t>("a\"b"))};
+  TraceObject trace_object;
+  trace_object.Initialize(TRACE_EVENT_PHASE_INSTANT, category_enabled_flag,
+                          "event", NULL, 0, 0, 2, arg_names, arg_types,
+                          arg_values, 0);
+  writer->AppendTraceEvent(&trace_object);
+  writer->AppendTraceEvent(&trace_object);
+  delete writer;
+
+  std::ostringstream expected_event;
+  expected_event << "{\"pid\":" << trace_object.pid()
+                 << ",\"tid\":" << trace_object.tid()
+                 << ",\"ts\":" << trace_object.ts()
+                 << ",\"ph\":\"I\",\"cat\":\"v8-json-test\",\"name\":\"event\""
+                    ",\"args\":{\"int\":-42,\"str\":\"a\\\"b\"}}";
+  std::string expected = "{\"traceEvents\":[" + expected_event.str() + "," +
+                         expected_event.str() + "]}";
+  EXPECT_EQ(expected, stream.str());
+}
+
+
+TEST(TracingTest, TraceConfig) {
+  TraceConfig* default_config = TraceConfig::CreateDefaultTraceConfig();
+  EXPECT_TRUE(default_config->IsCategoryGroupEnabled("v8"));
+  EXPECT_FALSE(
+      default_config->IsCategoryGroupEnabled("disabled-by-default-v8.gc"));
+  delete default_config;
+
+  TraceConfig* config = TraceConfig::CreateTraceConfigFromCategoryList(
+      "v8, disabled-by-default-v8.gc,-v8.execute");
+  EXPECT_TRUE(config->IsCategoryGroupEnabled("v8"));
+  EXPECT_TRUE(config->IsCategoryGroupEnabled("disabled-by-default-v8.gc"));
+  EXPECT_FALSE(config->IsCategoryGroupEnabled("v8.execute"));
+  EXPECT_FALSE(config->IsCategoryGroupEnabled("devtools.timeline"));
+  EXPECT_TRUE(config->IsCategoryGroupEnabled("devtools.timeline,v8"));
+  delete config;
+
+  config = TraceConfig::CreateTraceConfigFromCategoryList("*,-v8");
+  EXPECT_FALSE(config->IsCategoryGroupEnabled("v8"));
+  EXPECT_TRUE(config->IsCategoryGroupEnabled("devtools.timeline"));
+  delete config;
+}
+
+
+TEST(TracingTest, TracingController) {
+  MockTraceWriter* writer = new MockTraceWriter();
+  TracingController tracing_controller;
+  tracing_controller.Initialize(TraceBuffer::CreateTraceBufferRingBuffer(
+      TraceBuffer::kRingBufferChunks, writer));
+
+  const uint8_t* enabled =
+      tracing_controller.GetCategoryGroupEnabled("v8-controller-test");
+  const uint8_t* disabled = tracing_controller.GetCategoryGroupEnabled(
+      "disabled-by-default-v8-controller-test");
+  EXPECT_STREQ("v8-controller-test",
+               TracingController::GetCategoryGroupName(enabled));
+  EXPECT_FALSE(*enabled);
+
+  tracing_controller.StartTracing(TraceConfig::CreateDefaultTraceConfig());
+  EXPECT_TRUE(*enabled);
+  EXPECT_FALSE(*disabled);
+  uint64_t handle = tracing_controller.AddTraceEvent(
+      TRACE_EVENT_PHASE_COMPLETE, enabled, "event", NULL, 0, 0, 0, NULL, NULL,
+      NULL, 0);
+  tracing_controller.UpdateTraceEventDuration(enabled, "event", handle);
+  tracing_controller.StopTracing();
+  EXPECT_FALSE(*enabled);
+
+  ASSERT_EQ(1u, writer->events().size());
+  EXPECT_EQ("event", writer->events()[0]);
+}
+
+}  // namespace tracing
+}  // namespace platform
+}  // namespace v8
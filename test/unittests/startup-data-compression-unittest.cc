@@ -0,0 +1,99 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/snapshot/startup-data-compression.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+Vector<const byte> ToConst(Vector<byte> data) {
+  return Vector<const byte>(data.start(), data.length());
+}
+
+void CheckRoundTrip(Vector<const byte> data) {
+  Vector<byte> compressed = StartupDataCompression::Compress(data);
+  EXPECT_TRUE(StartupDataCompression::IsCompressed(ToConst(compressed)));
+  Vector<byte> decompressed =
+      StartupDataCompression::Decompress(ToConst(compressed));
+  ASSERT_EQ(data.length(), decompressed.length());
+  EXPECT_EQ(0, memcmp(data.start(), decompressed.start(), data.length()));
+  compressed.Dispose();
+  decompressed.Dispose();
+}
+
+}  // namespace
+
+
+TEST(StartupDataCompression, RoundTripText) {
+  const char kText[] =
+      "function f(a, b) { return a + b; }\n"
+      "function g(a, b) { return a - b; }\n"
+      "function h(a, b) { return a * b; }\n";
+  CheckRoundTrip(
+      Vector<const byte>(reinterpret_cast<const byte*>(kText), sizeof(kText)));
+}
+
+
+TEST(StartupDataCompression, RoundTripShortInputs) {
+  byte data[16];
+  for (int i = 0; i < 16; i++) data[i] = static_cast<byte>(i);
+  for (int length = 1; length <= 16; length++) {
+    CheckRoundTrip(Vector<const byte>(data, length));
+  }
+}
+
+
+TEST(StartupDataCompression, RoundTripMultipleChunks) {
+  // A mix of runs, which compress into overlapping matches, and
+  // pseudo-random bytes, which do not compress at all.
+  int length = 2 * StartupDataCompression::kChunkSize + 1234;
+  Vector<byte> data = Vector<byte>::New(length);
+  uint32_t state = 42;
+  for (int i = 0; i < length; i++) {
+    state = state * 1103515245 + 12345;
+    data[i] = (i / 1000) % 2 == 0 ? static_cast<byte>(state >> 24)
+                                  : static_cast<byte>(i / 1000);
+  }
+  CheckRoundTrip(ToConst(data));
+  data.Dispose();
+}
+
+
+TEST(StartupDataCompression, UncompressedDataIsNotCompressed) {
+  const byte kData[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+  Vector<const byte> data(kData, arraysize(kData));
+  EXPECT_FALSE(StartupDataCompression::IsCompressed(data));
+  EXPECT_TRUE(StartupDataCompression::Decompress(data).is_empty());
+}
+
+
+TEST(StartupDataCompression, RejectsCorruptedData) {
+  const int kLength = 4096;
+  byte data[kLength];
+  for (int i = 0; i < kLength; i++) data[i] = static_cast<byte>(i % 61);
+  Vector<byte> compressed =
+      StartupDataCompression::Compress(Vector<const byte>(data, kLength));
+
+  // Truncated blobs do not match their header.
+  Vector<const byte> truncated(compressed.start(), compressed.length() - 1);
+  EXPECT_TRUE(StartupDataCompression::Decompress(truncated).is_empty());
+
+  // The first sequence consists of a token, a length byte and 61 literals,
+  // followed by the offset of a match. Offsets pointing before the start of
+  // the output are rejected.
+  int offset = 5 * kInt32Size + 2 + 61;
+  EXPECT_EQ(61, compressed[offset]);
+  compressed[offset] = 0xff;
+  compressed[offset + 1] = 0xff;
+  EXPECT_TRUE(
+      StartupDataCompression::Decompress(ToConst(compressed)).is_empty());
+  compressed.Dispose();
+}
+
+}  // namespace internal
+}  // namespace v8
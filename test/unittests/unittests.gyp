@@ -24,6 +24,8 @@
       ],
       'sources': [  ### gcmole(all) ###
         'atomic-utils-unittest.cc',
+        'background-task-budget-unittest.cc',
+        'base/accounting-allocator-unittest.cc',
         'base/bits-unittest.cc',
         'base/cpu-unittest.cc',
         'base/division-by-constant-unittest.cc',
@@ -31,6 +33,7 @@
         'base/functional-unittest.cc',
         'base/logging-unittest.cc',
         'base/iterator-unittest.cc',
+        'base/lockfree-queue-unittest.cc',
         'base/platform/condition-variable-unittest.cc',
         'base/platform/mutex-unittest.cc',
         'base/platform/platform-unittest.cc',
@@ -40,6 +43,7 @@
         'base/utils/random-number-generator-unittest.cc',
         'cancelable-tasks-unittest.cc',
         'char-predicates-unittest.cc',
+        'compiler/allocation-folding-unittest.cc',
         'compiler/branch-elimination-unittest.cc',
         'compiler/change-lowering-unittest.cc',
         'compiler/coalesced-live-ranges-unittest.cc',
@@ -89,6 +93,7 @@
         'compiler/simplified-operator-reducer-unittest.cc',
         'compiler/simplified-operator-unittest.cc',
         'compiler/state-values-utils-unittest.cc',
+        'compiler/store-store-elimination-unittest.cc',
         'compiler/tail-call-optimization-unittest.cc',
         'compiler/typer-unittest.cc',
         'compiler/value-numbering-reducer-unittest.cc',
@@ -97,15 +102,19 @@
         'interpreter/bytecodes-unittest.cc',
         'interpreter/bytecode-array-builder-unittest.cc',
         'interpreter/bytecode-array-iterator-unittest.cc',
+        'interpreter/bytecode-peephole-optimizer-unittest.cc',
         'interpreter/bytecode-register-allocator-unittest.cc',
+        'interpreter/bytecode-register-optimizer-unittest.cc',
         'interpreter/constant-array-builder-unittest.cc',
         'interpreter/interpreter-assembler-unittest.cc',
         'interpreter/interpreter-assembler-unittest.h',
         'interpreter/source-position-table-unittest.cc',
         'libplatform/default-platform-unittest.cc',
         'libplatform/task-queue-unittest.cc',
+        'libplatform/tracing-unittest.cc',
         'libplatform/worker-thread-unittest.cc',
         'heap/bitmap-unittest.cc',
+        'heap/concurrent-marking-deque-unittest.cc',
         'heap/gc-idle-time-handler-unittest.cc',
         'heap/gc-tracer-unittest.cc',
         'heap/memory-reducer-unittest.cc',
@@ -114,8 +123,10 @@
         'heap/slot-set-unittest.cc',
         'locked-queue-unittest.cc',
         'run-all-unittests.cc',
+        'startup-data-compression-unittest.cc',
         'test-utils.h',
         'test-utils.cc',
+        'value-serializer-unittest.cc',
         'wasm/ast-decoder-unittest.cc',
         'wasm/decoder-unittest.cc',
         'wasm/encoder-unittest.cc',
@@ -0,0 +1,481 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstring>
+#include <vector>
+
+#include "include/v8.h"
+#include "test/unittests/test-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace {
+
+class ValueSerializerTest : public TestWithIsolate {
+ protected:
+  ValueSerializerTest()
+      : serialization_context_(Context::New(isolate())),
+        deserialization_context_(Context::New(isolate())) {}
+
+  const Local<Context>& serialization_context() {
+    return serialization_context_;
+  }
+  const Local<Context>& deserialization_context() {
+    return deserialization_context_;
+  }
+
+  // Serializes the result of |source| in the serialization context, decodes
+  // it in the deserialization context and checks each of |checks| with the
+  // decoded value bound to |result|.
+  void RoundTripTest(const char* source,
+                     std::initializer_list<const char*> checks) {
+    std::vector<uint8_t> data;
+    ASSERT_TRUE(EncodeTest(EvaluateScriptForInput(source), &data));
+    Local<Value> result;
+    ASSERT_TRUE(DecodeTest(data, &result));
+    ExpectScriptsTrue(result, checks);
+  }
+
+  bool EncodeTest(Local<Value> input_value, std::vector<uint8_t>* data,
+                  ValueSerializer::Delegate* delegate = nullptr) {
+    Context::Scope scope(serialization_context());
+    TryCatch try_catch(isolate());
+    ValueSerializer serializer(isolate(), delegate);
+    BeforeEncode(&serializer);
+    serializer.WriteHeader();
+    if (!serializer.WriteValue(serialization_context(), input_value)
+             .FromMaybe(false)) {
+      EXPECT_TRUE(try_catch.HasCaught());
+      return false;
+    }
+    EXPECT_FALSE(try_catch.HasCaught());
+    *data = serializer.ReleaseBuffer();
+    return true;
+  }
+
+  bool DecodeTest(const std::vector<uint8_t>& data, Local<Value>* result,
+                  ValueDeserializer::Delegate* delegate = nullptr) {
+    Context::Scope scope(deserialization_context());
+    TryCatch try_catch(isolate());
+    ValueDeserializer deserializer(isolate(), data.data(), data.size(),
+                                   delegate);
+    BeforeDecode(&deserializer);
+    if (!deserializer.ReadHeader(deserialization_context())
+             .FromMaybe(false) ||
+        !deserializer.ReadValue(deserialization_context()).ToLocal(result)) {
+      EXPECT_TRUE(try_catch.HasCaught());
+      return false;
+    }
+    EXPECT_FALSE(try_catch.HasCaught());
+    return true;
+  }
+
+  void InvalidEncodeTest(const char* source) {
+    std::vector<uint8_t> data;
+    EXPECT_FALSE(EncodeTest(EvaluateScriptForInput(source), &data));
+  }
+
+  void InvalidDecodeTest(const std::vector<uint8_t>& data) {
+    Local<Value> result;
+    EXPECT_FALSE(DecodeTest(data, &result));
+  }
+
+  // Hooks for the fixtures below, called before the header is handled.
+  virtual void BeforeEncode(ValueSerializer*) {}
+  virtual void BeforeDecode(ValueDeserializer*) {}
+
+  Local<Value> EvaluateScriptForInput(const char* source) {
+    Context::Scope scope(serialization_context());
+    return RunScript(serialization_context(), source);
+  }
+
+  void ExpectScriptsTrue(Local<Value> result,
+                         std::initializer_list<const char*> checks) {
+    Context::Scope scope(deserialization_context());
+    Local<Object> global = deserialization_context()->Global();
+    ASSERT_TRUE(global
+                    ->Set(deserialization_context(), StringFromUtf8("result"),
+                          result)
+                    .FromMaybe(false));
+    for (const char* check : checks) {
+      EXPECT_TRUE(RunScript(deserialization_context(), check)
+                      ->BooleanValue(deserialization_context())
+                      .FromJust())
+          << check;
+    }
+  }
+
+  Local<Value> RunScript(Local<Context> context, const char* source) {
+    Local<Script> script =
+        Script::Compile(context, StringFromUtf8(source)).ToLocalChecked();
+    return script->Run(context).ToLocalChecked();
+  }
+
+  Local<String> StringFromUtf8(const char* source) {
+    return String::NewFromUtf8(isolate(), source, NewStringType::kNormal)
+        .ToLocalChecked();
+  }
+
+ private:
+  Local<Context> serialization_context_;
+  Local<Context> deserialization_context_;
+
+  DISALLOW_COPY_AND_ASSIGN(ValueSerializerTest);
+};
+
+TEST_F(ValueSerializerTest, DecodeInvalid) {
+  // Version tag but no content.
+  InvalidDecodeTest({0xff});
+  // Version too large.
+  InvalidDecodeTest({0xff, 0x7f, 0x5f});
+  // Nonsense tag.
+  InvalidDecodeTest({0xff, 0x01, 0xdd});
+  // Truncated string.
+  InvalidDecodeTest({0xff, 0x01, '"', 0x05, 'a', 'b'});
+  // Reference to an object that was never read.
+  InvalidDecodeTest({0xff, 0x01, '^', 0x00});
+  // Dense array that claims more elements than the data holds.
+  InvalidDecodeTest({0xff, 0x01, 'A', 0x7f, '$', 0x00, 0x00});
+}
+
+TEST_F(ValueSerializerTest, WireFormat) {
+  std::vector<uint8_t> data;
+  ASSERT_TRUE(EncodeTest(EvaluateScriptForInput("true"), &data));
+  EXPECT_EQ((std::vector<uint8_t>{0xff, 0x01, 'T'}), data);
+  ASSERT_TRUE(EncodeTest(EvaluateScriptForInput("-1"), &data));
+  EXPECT_EQ((std::vector<uint8_t>{0xff, 0x01, 'I', 0x01}), data);
+  ASSERT_TRUE(EncodeTest(EvaluateScriptForInput("'hi'"), &data));
+  EXPECT_EQ((std::vector<uint8_t>{0xff, 0x01, '"', 0x02, 'h', 'i'}), data);
+}
+
+TEST_F(ValueSerializerTest, RoundTripOddball) {
+  RoundTripTest("undefined", {"result === undefined"});
+  RoundTripTest("null", {"result === null"});
+  RoundTripTest("true", {"result === true"});
+  RoundTripTest("false", {"result === false"});
+}
+
+TEST_F(ValueSerializerTest, RoundTripNumber) {
+  RoundTripTest("42", {"result === 42"});
+  RoundTripTest("-31337", {"result === -31337"});
+  RoundTripTest("-0", {"Object.is(result, -0)"});
+  RoundTripTest("0.5", {"result === 0.5"});
+  RoundTripTest("Math.pow(2, 53)", {"result === Math.pow(2, 53)"});
+  RoundTripTest("NaN", {"Number.isNaN(result)"});
+  RoundTripTest("-Infinity", {"result === -Infinity"});
+}
+
+TEST_F(ValueSerializerTest, RoundTripString) {
+  RoundTripTest("''", {"result === ''"});
+  RoundTripTest("'Hello, world!'", {"result === 'Hello, world!'"});
+  RoundTripTest("'\\u00e9t\\u00e9'", {"result === '\\u00e9t\\u00e9'"});
+  RoundTripTest("'\\u2603\\ud83d\\ude00'",
+                {"result === '\\u2603\\ud83d\\ude00'", "result.length === 3"});
+  RoundTripTest("'abc'.repeat(1000)", {"result === 'abc'.repeat(1000)"});
+  // Cons strings are flattened.
+  RoundTripTest("var s = 'a'.repeat(20); s + s.toUpperCase()",
+                {"result === 'a'.repeat(20) + 'A'.repeat(20)"});
+}
+
+TEST_F(ValueSerializerTest, RoundTripObject) {
+  RoundTripTest("({})",
+                {"Object.getPrototypeOf(result) === Object.prototype",
+                 "Object.keys(result).length === 0"});
+  RoundTripTest("({ a: 1, b: 'two', c: null })",
+                {"result.a === 1", "result.b === 'two'", "result.c === null",
+                 "Object.keys(result).join() === 'a,b,c'"});
+  RoundTripTest("({ 42: 'a', 1e9: 'b', '-1': 'c' })",
+                {"result[42] === 'a'", "result[1e9] === 'b'",
+                 "result['-1'] === 'c'"});
+  RoundTripTest("({ a: { b: { c: [1, 2] } } })",
+                {"result.a.b.c[1] === 2"});
+  // Only own enumerable string-keyed properties are written.
+  RoundTripTest(
+      "var o = Object.create({ inherited: 1 });"
+      "Object.defineProperty(o, 'hidden', { value: 2, enumerable: false });"
+      "o[Symbol('s')] = 3; o.visible = 4; o",
+      {"!('inherited' in result)", "!('hidden' in result)",
+       "Object.getOwnPropertySymbols(result).length === 0",
+       "result.visible === 4"});
+  // Getters run and the value is stored as data.
+  RoundTripTest("({ get a() { return 5; } })",
+                {"Object.getOwnPropertyDescriptor(result, 'a').value === 5"});
+}
+
+TEST_F(ValueSerializerTest, RoundTripReferences) {
+  RoundTripTest("var o = {}; o.self = o; o", {"result.self === result"});
+  RoundTripTest("var a = []; a.push(a); a", {"result[0] === result"});
+  RoundTripTest("var x = {}; ({ a: x, b: x })", {"result.a === result.b"});
+  RoundTripTest("var x = [1]; [x, { y: x }]", {"result[0] === result[1].y"});
+}
+
+TEST_F(ValueSerializerTest, RoundTripArray) {
+  RoundTripTest("[]", {"Array.isArray(result)", "result.length === 0"});
+  RoundTripTest("[1, 'two', { three: 3 }]",
+                {"result.length === 3", "result[1] === 'two'",
+                 "result[2].three === 3"});
+  RoundTripTest("[1.5, 2.5]", {"result[0] === 1.5", "result[1] === 2.5"});
+  // Sparse arrays keep their holes and length.
+  RoundTripTest("var a = []; a[1000] = 'x'; a",
+                {"result.length === 1001", "!(0 in result)",
+                 "result[1000] === 'x'"});
+  RoundTripTest("[1, , 3]",
+                {"result.length === 3", "!(1 in result)", "result[2] === 3"});
+  RoundTripTest("var a = [1, 2]; a.foo = 'bar'; a",
+                {"result.length === 2", "result.foo === 'bar'"});
+}
+
+TEST_F(ValueSerializerTest, RoundTripDate) {
+  RoundTripTest("new Date(1e6)",
+                {"result instanceof Date", "result.valueOf() === 1e6"});
+  RoundTripTest("new Date(NaN)", {"Number.isNaN(result.valueOf())"});
+  RoundTripTest("var d = new Date(0); [d, d]", {"result[0] === result[1]"});
+}
+
+TEST_F(ValueSerializerTest, RoundTripArrayBuffer) {
+  RoundTripTest("new ArrayBuffer(0)",
+                {"result instanceof ArrayBuffer", "result.byteLength === 0"});
+  RoundTripTest("new Uint8Array([0, 128, 255]).buffer",
+                {"result.byteLength === 3",
+                 "new Uint8Array(result).join() === '0,128,255'"});
+}
+
+TEST_F(ValueSerializerTest, RoundTripArrayBufferView) {
+  RoundTripTest("new Uint8Array([1, 2, 3])",
+                {"result instanceof Uint8Array", "result.join() === '1,2,3'"});
+  RoundTripTest("new Int16Array([-1, 2]).subarray(1)",
+                {"result instanceof Int16Array", "result.byteOffset === 2",
+                 "result.length === 1", "result[0] === 2",
+                 "result.buffer.byteLength === 4"});
+  RoundTripTest("new Float64Array([0.5, -0.25])",
+                {"result[0] === 0.5", "result[1] === -0.25"});
+  RoundTripTest("new Uint8ClampedArray([300])", {"result[0] === 255"});
+  RoundTripTest("new DataView(new ArrayBuffer(8), 2, 4)",
+                {"result instanceof DataView", "result.byteOffset === 2",
+                 "result.byteLength === 4"});
+  // Views of the same buffer keep sharing it.
+  RoundTripTest(
+      "var b = new ArrayBuffer(4);"
+      "[new Uint8Array(b), new Uint16Array(b, 2)]",
+      {"result[0].buffer === result[1].buffer",
+       "(result[1][0] = 0x101, result[0][2] === 1)"});
+}
+
+TEST_F(ValueSerializerTest, EncodeUnsupported) {
+  InvalidEncodeTest("Symbol()");
+  InvalidEncodeTest("(function() {})");
+  InvalidEncodeTest("({ f: function() {} })");
+  InvalidEncodeTest("new Map()");
+  InvalidEncodeTest("new Proxy({}, {})");
+}
+
+TEST_F(ValueSerializerTest, EncodeNeuteredArrayBuffer) {
+  Local<ArrayBuffer> buffer;
+  {
+    Context::Scope scope(serialization_context());
+    buffer = ArrayBuffer::New(isolate(), 4);
+    buffer->Neuter();
+  }
+  std::vector<uint8_t> data;
+  EXPECT_FALSE(EncodeTest(buffer, &data));
+}
+
+TEST_F(ValueSerializerTest, EncodeErrorFromGetter) {
+  Context::Scope scope(serialization_context());
+  TryCatch try_catch(isolate());
+  ValueSerializer serializer(isolate());
+  serializer.WriteHeader();
+  Local<Value> input =
+      RunScript(serialization_context(),
+                "({ get a() { throw new RangeError('getter'); } })");
+  EXPECT_TRUE(
+      serializer.WriteValue(serialization_context(), input).IsNothing());
+  ASSERT_TRUE(try_catch.HasCaught());
+  EXPECT_TRUE(try_catch.Exception()->IsNativeError());
+}
+
+class ValueSerializerTestWithArrayBufferTransfer : public ValueSerializerTest {
+ protected:
+  ValueSerializerTestWithArrayBufferTransfer() {
+    memset(data_, 0, sizeof(data_));
+    {
+      Context::Scope scope(serialization_context());
+      input_buffer_ = ArrayBuffer::New(isolate(), data_, sizeof(data_));
+    }
+    {
+      Context::Scope scope(deserialization_context());
+      output_buffer_ = ArrayBuffer::New(isolate(), data_, sizeof(data_));
+    }
+  }
+
+  const Local<ArrayBuffer>& input_buffer() { return input_buffer_; }
+  const Local<ArrayBuffer>& output_buffer() { return output_buffer_; }
+
+  void BeforeEncode(ValueSerializer* serializer) override {
+    serializer->TransferArrayBuffer(0, input_buffer_);
+  }
+
+  void BeforeDecode(ValueDeserializer* deserializer) override {
+    deserializer->TransferArrayBuffer(0, output_buffer_);
+  }
+
+ private:
+  uint8_t data_[4];
+  Local<ArrayBuffer> input_buffer_;
+  Local<ArrayBuffer> output_buffer_;
+};
+
+TEST_F(ValueSerializerTestWithArrayBufferTransfer, RoundTripTransfer) {
+  std::vector<uint8_t> data;
+  {
+    Context::Scope scope(serialization_context());
+    ASSERT_TRUE(serialization_context()
+                    ->Global()
+                    ->Set(serialization_context(), StringFromUtf8("buffer"),
+                          input_buffer())
+                    .FromMaybe(false));
+  }
+  ASSERT_TRUE(EncodeTest(
+      EvaluateScriptForInput("[buffer, new Uint8Array(buffer, 1)]"), &data));
+  // Only the transfer ID is written, not the contents.
+  EXPECT_LT(data.size(), 20u);
+  Local<Value> result;
+  ASSERT_TRUE(DecodeTest(data, &result));
+  ExpectScriptsTrue(
+      result, {"result[0].byteLength === 4", "result[1].buffer === result[0]",
+               "(result[1][0] = 7, new Uint8Array(result[0])[1] === 7)"});
+  EXPECT_TRUE(result.As<Object>()
+                  ->Get(deserialization_context(), 0)
+                  .ToLocalChecked()
+                  ->StrictEquals(output_buffer()));
+}
+
+TEST_F(ValueSerializerTestWithArrayBufferTransfer, TransferMissingOnDecode) {
+  std::vector<uint8_t> data;
+  ASSERT_TRUE(EncodeTest(input_buffer(), &data));
+  Context::Scope scope(deserialization_context());
+  TryCatch try_catch(isolate());
+  ValueDeserializer deserializer(isolate(), data.data(), data.size());
+  ASSERT_TRUE(deserializer.ReadHeader(deserialization_context()).FromJust());
+  EXPECT_TRUE(deserializer.ReadValue(deserialization_context()).IsEmpty());
+  EXPECT_TRUE(try_catch.HasCaught());
+}
+
+class ValueSerializerTestWithHostObject : public ValueSerializerTest {
+ protected:
+  ValueSerializerTestWithHostObject()
+      : serializer_delegate_(this), deserializer_delegate_(this) {}
+
+  // The host object is an object with one internal field holding a uint32.
+  class SerializerDelegate : public ValueSerializer::Delegate {
+   public:
+    explicit SerializerDelegate(ValueSerializerTestWithHostObject* test)
+        : test_(test) {}
+    void ThrowDataCloneError(Local<String> message) override {
+      test_->isolate()->ThrowException(Exception::Error(message));
+    }
+    Maybe<bool> WriteHostObject(Isolate* isolate,
+                                Local<Object> object) override {
+      uint32_t value = static_cast<uint32_t>(
+          reinterpret_cast<uintptr_t>(
+              object->GetAlignedPointerFromInternalField(0)) >>
+          1);
+      test_->serializer_->WriteUint32(value);
+      return Just(true);
+    }
+
+   private:
+    ValueSerializerTestWithHostObject* test_;
+  };
+
+  class DeserializerDelegate : public ValueDeserializer::Delegate {
+   public:
+    explicit DeserializerDelegate(ValueSerializerTestWithHostObject* test)
+        : test_(test) {}
+    MaybeLocal<Object> ReadHostObject(Isolate* isolate) override {
+      uint32_t value;
+      if (!test_->deserializer_->ReadUint32(&value)) {
+        return MaybeLocal<Object>();
+      }
+      return test_->NewHostObject(test_->deserialization_context(), value);
+    }
+
+   private:
+    ValueSerializerTestWithHostObject* test_;
+  };
+
+  void BeforeEncode(ValueSerializer* serializer) override {
+    serializer_ = serializer;
+  }
+  void BeforeDecode(ValueDeserializer* deserializer) override {
+    deserializer_ = deserializer;
+  }
+
+  Local<Object> NewHostObject(Local<Context> context, uint32_t value) {
+    Local<ObjectTemplate> templ = ObjectTemplate::New(isolate());
+    templ->SetInternalFieldCount(1);
+    Local<Object> object = templ->NewInstance(context).ToLocalChecked();
+    object->SetAlignedPointerInInternalField(
+        0, reinterpret_cast<void*>(static_cast<uintptr_t>(value) << 1));
+    return object;
+  }
+
+  uint32_t HostObjectValue(Local<Value> value) {
+    return static_cast<uint32_t>(
+        reinterpret_cast<uintptr_t>(
+            value.As<Object>()->GetAlignedPointerFromInternalField(0)) >>
+        1);
+  }
+
+  SerializerDelegate serializer_delegate_;
+  DeserializerDelegate deserializer_delegate_;
+  ValueSerializer* serializer_ = nullptr;
+  ValueDeserializer* deserializer_ = nullptr;
+};
+
+TEST_F(ValueSerializerTestWithHostObject, RoundTripHostObject) {
+  Local<Object> host;
+  {
+    Context::Scope scope(serialization_context());
+    host = NewHostObject(serialization_context(), 0xabcd);
+  }
+  std::vector<uint8_t> data;
+  ASSERT_TRUE(EncodeTest(host, &data, &serializer_delegate_));
+  Local<Value> result;
+  ASSERT_TRUE(DecodeTest(data, &result, &deserializer_delegate_));
+  ASSERT_TRUE(result->IsObject());
+  EXPECT_EQ(0xabcdu, HostObjectValue(result));
+}
+
+TEST_F(ValueSerializerTestWithHostObject, HostObjectReferences) {
+  Local<Value> input;
+  {
+    Context::Scope scope(serialization_context());
+    Local<Object> host = NewHostObject(serialization_context(), 1);
+    Local<Array> array = Array::New(isolate(), 2);
+    ASSERT_TRUE(array->Set(serialization_context(), 0, host).FromJust());
+    ASSERT_TRUE(array->Set(serialization_context(), 1, host).FromJust());
+    input = array;
+  }
+  std::vector<uint8_t> data;
+  ASSERT_TRUE(EncodeTest(input, &data, &serializer_delegate_));
+  Local<Value> result;
+  ASSERT_TRUE(DecodeTest(data, &result, &deserializer_delegate_));
+  ExpectScriptsTrue(result, {"result[0] === result[1]"});
+}
+
+TEST_F(ValueSerializerTestWithHostObject, HostObjectWithoutDelegate) {
+  Local<Object> host;
+  {
+    Context::Scope scope(serialization_context());
+    host = NewHostObject(serialization_context(), 1);
+  }
+  std::vector<uint8_t> data;
+  EXPECT_FALSE(EncodeTest(host, &data));
+  ASSERT_TRUE(EncodeTest(host, &data, &serializer_delegate_));
+  InvalidDecodeTest(data);
+}
+
+}  // namespace
+}  // namespace v8
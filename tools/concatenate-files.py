@@ -36,14 +36,87 @@
 # us with an easy and uniform way of doing this on all platforms.
 
 import optparse
+import struct
 
 
-def Concatenate(filenames):
+# The format of compressed startup blobs, see
+# src/snapshot/startup-data-compression.h.
+COMPRESSION_MAGIC_NUMBER = 0x7a6c3856
+COMPRESSION_CHUNK_SIZE = 256 * 1024
+
+# Parameters of the LZ4 block format.
+MIN_MATCH = 4
+LAST_LITERALS = 5
+MATCH_FIND_LIMIT = 12
+MAX_OFFSET = 0xffff
+RUN_MASK = 0xf
+
+
+def EmitLength(out, length):
+  while length >= 0xff:
+    out.append(0xff)
+    length -= 0xff
+  out.append(length)
+
+
+def EmitSequence(out, data, start, literals, offset, match_length):
+  match_code = match_length - MIN_MATCH if match_length else 0
+  out.append((min(literals, RUN_MASK) << 4) | min(match_code, RUN_MASK))
+  if literals >= RUN_MASK:
+    EmitLength(out, literals - RUN_MASK)
+  out.extend(data[start:start + literals])
+  if match_length:
+    out.append(offset & 0xff)
+    out.append(offset >> 8)
+    if match_code >= RUN_MASK:
+      EmitLength(out, match_code - RUN_MASK)
+
+
+def CompressBlock(data):
+  """Compresses a bytearray into an LZ4 block."""
+  out = bytearray()
+  length = len(data)
+  anchor = 0
+  if length > MATCH_FIND_LIMIT:
+    table = {}
+    match_end_limit = length - LAST_LITERALS
+    pos = 0
+    while pos < length - MATCH_FIND_LIMIT:
+      sequence = bytes(data[pos:pos + MIN_MATCH])
+      candidate = table.get(sequence, -1)
+      table[sequence] = pos
+      if candidate < 0 or pos - candidate > MAX_OFFSET:
+        pos += 1
+        continue
+      match_length = MIN_MATCH
+      while (pos + match_length < match_end_limit and
+             data[candidate + match_length] == data[pos + match_length]):
+        match_length += 1
+      EmitSequence(out, data, anchor, pos - anchor, pos - candidate,
+                   match_length)
+      pos += match_length
+      anchor = pos
+  EmitSequence(out, data, anchor, length - anchor, 0, 0)
+  return out
+
+
+def Compress(data):
+  """Compresses a startup blob in independently decompressible chunks."""
+  chunks = [CompressBlock(data[i:i + COMPRESSION_CHUNK_SIZE])
+            for i in range(0, len(data), COMPRESSION_CHUNK_SIZE)]
+  header = struct.pack("<IIII", COMPRESSION_MAGIC_NUMBER, len(data),
+                       COMPRESSION_CHUNK_SIZE, len(chunks))
+  header += struct.pack("<%dI" % len(chunks), *[len(c) for c in chunks])
+  return bytearray(header) + bytearray().join(chunks)
+
+
+def Concatenate(filenames, compress=False):
   """Concatenate files.
 
   Args:
     files: Array of file names.
            The last name is the target; all earlier ones are sources.
+    compress: Whether to compress the result like a startup blob.
 
   Returns:
     True, if the operation was successful.
@@ -53,10 +126,14 @@ def Concatenate(filenames):
     return False
 
   try:
+    contents = bytearray()
+    for filename in filenames[:-1]:
+      with open(filename, "rb") as current:
+        contents.extend(current.read())
+    if compress:
+      contents = Compress(contents)
     with open(filenames[-1], "wb") as target:
-      for filename in filenames[:-1]:
-        with open(filename, "rb") as current:
-          target.write(current.read())
+      target.write(contents)
     return True
   except IOError as e:
     print "An error occured when writing %s:\n%s" % (filenames[-1], e)
@@ -65,10 +142,13 @@ def Concatenate(filenames):
 
 def main():
   parser = optparse.OptionParser()
+  parser.add_option("--compress",
+                    help="compress the result like a startup blob.",
+                    action="store_true", default=False)
   parser.set_usage("""Concatenate several files into one.
       Equivalent to: cat file1 ... > target.""")
   (options, args) = parser.parse_args()
-  exit(0 if Concatenate(args) else 1)
+  exit(0 if Concatenate(args, options.compress) else 1)
 
 
 if __name__ == "__main__":